@@ -0,0 +1,241 @@
+#include "bench.h"
+
+#include <furi_hal.h>
+#include <math.h>
+
+#define TAG "Bench"
+
+#define BENCH_CALIBRATION_PASSES (64U)
+
+struct BenchRun {
+    uint32_t warmup;
+    uint32_t repetitions;
+    uint32_t overhead;
+    uint32_t* samples;
+
+    uint32_t pass;
+    uint32_t pass_start;
+    uint32_t pause_start;
+    uint32_t paused_cycles;
+
+    size_t bytes;
+    const char* error;
+};
+
+struct BenchRunner {
+    BenchRun run;
+    bool json;
+    bool json_first;
+    const char* suite;
+};
+
+void bench_run_start(BenchRun* run) {
+    furi_check(run);
+
+    run->pass = 0;
+    run->bytes = 0;
+    run->error = NULL;
+}
+
+bool bench_run_next(BenchRun* run) {
+    const uint32_t now = DWT->CYCCNT;
+
+    if(run->pass > run->warmup) {
+        uint32_t cycles = now - run->pass_start - run->paused_cycles;
+        cycles = (cycles > run->overhead) ? (cycles - run->overhead) : 0;
+        run->samples[run->pass - run->warmup - 1] = cycles;
+    }
+
+    if(run->error || run->pass == run->warmup + run->repetitions) return false;
+
+    run->pass++;
+    run->paused_cycles = 0;
+    run->pass_start = DWT->CYCCNT;
+    return true;
+}
+
+void bench_run_pause(BenchRun* run) {
+    run->pause_start = DWT->CYCCNT;
+}
+
+void bench_run_resume(BenchRun* run) {
+    run->paused_cycles += DWT->CYCCNT - run->pause_start;
+}
+
+void bench_run_set_bytes(BenchRun* run, size_t bytes) {
+    furi_check(run);
+    run->bytes = bytes;
+}
+
+void bench_run_fail(BenchRun* run, const char* reason) {
+    furi_check(run);
+    furi_check(reason);
+    run->error = reason;
+}
+
+static int bench_sample_compare(const void* a, const void* b) {
+    const uint32_t sample_a = *(const uint32_t*)a;
+    const uint32_t sample_b = *(const uint32_t*)b;
+    return (sample_a > sample_b) - (sample_a < sample_b);
+}
+
+BenchRunner* bench_runner_alloc(uint32_t warmup, uint32_t repetitions, bool json) {
+    furi_check(repetitions > 0);
+
+    BenchRunner* runner = malloc(sizeof(BenchRunner));
+    runner->json = json;
+    runner->json_first = true;
+
+    const uint32_t samples_max = MAX(repetitions, BENCH_CALIBRATION_PASSES);
+    runner->run.samples = malloc(sizeof(uint32_t) * samples_max);
+
+    // Cost of an empty pass, subtracted from every sample
+    BenchRun* run = &runner->run;
+    run->warmup = 1;
+    run->repetitions = BENCH_CALIBRATION_PASSES;
+    run->overhead = 0;
+    BENCH_LOOP() {
+    }
+    qsort(run->samples, run->repetitions, sizeof(uint32_t), bench_sample_compare);
+    run->overhead = run->samples[0];
+
+    run->warmup = warmup;
+    run->repetitions = repetitions;
+
+    if(json) {
+        const Version* version = furi_hal_version_get_firmware_version();
+        printf(
+            "{\"firmware\":\"%s\",\"commit\":\"%s\",\"core_clock\":%lu,"
+            "\"warmup\":%lu,\"repetitions\":%lu,\"overhead\":%lu,\"results\":[",
+            version ? version_get_version(version) : "unknown",
+            version ? version_get_githash(version) : "unknown",
+            SystemCoreClock,
+            warmup,
+            repetitions,
+            run->overhead);
+    } else {
+        printf(
+            "Warmup %lu, repetitions %lu, loop overhead %lu cycles at %lu MHz\r\n",
+            warmup,
+            repetitions,
+            run->overhead,
+            SystemCoreClock / 1000000);
+        printf(
+            "%-14s %-24s %9s %9s %9s %9s %8s %10s\r\n",
+            "suite",
+            "case",
+            "min",
+            "median",
+            "mean",
+            "max",
+            "stddev",
+            "KiB/s");
+    }
+
+    return runner;
+}
+
+void bench_runner_free(BenchRunner* runner) {
+    furi_check(runner);
+
+    free(runner->run.samples);
+    free(runner);
+}
+
+void bench_runner_run_suite(BenchRunner* runner, const char* name, BenchSuite suite) {
+    furi_check(runner);
+    furi_check(name);
+    furi_check(suite);
+
+    runner->suite = name;
+    suite(runner);
+    runner->suite = NULL;
+}
+
+void bench_runner_run_case(BenchRunner* runner, const char* name, BenchCase bench_case) {
+    furi_check(runner);
+    BenchRun* run = &runner->run;
+
+    run->pass = 0;
+    run->error = NULL;
+    run->bytes = 0;
+    bench_case(run);
+
+    // Completed passes only, a failed case may stop early
+    const uint32_t count =
+        (run->pass > run->warmup) ? MIN(run->pass - run->warmup, run->repetitions) : 0;
+    if(!run->error && count < run->repetitions) run->error = "case has no BENCH_LOOP";
+
+    if(run->error) {
+        FURI_LOG_W(TAG, "%s.%s: %s", runner->suite, name, run->error);
+        if(runner->json) {
+            printf(
+                "%s{\"suite\":\"%s\",\"case\":\"%s\",\"error\":\"%s\"}",
+                runner->json_first ? "" : ",",
+                runner->suite,
+                name,
+                run->error);
+            runner->json_first = false;
+        } else {
+            printf("%-14s %-24s %s\r\n", runner->suite, name, run->error);
+        }
+        return;
+    }
+
+    qsort(run->samples, count, sizeof(uint32_t), bench_sample_compare);
+
+    uint64_t sum = 0;
+    for(size_t i = 0; i < count; i++) {
+        sum += run->samples[i];
+    }
+    const uint32_t mean = sum / count;
+
+    uint64_t variance = 0;
+    for(size_t i = 0; i < count; i++) {
+        const int64_t delta = (int64_t)run->samples[i] - mean;
+        variance += delta * delta;
+    }
+    const uint32_t stddev = sqrtf((float)(variance / count));
+
+    const uint32_t min = run->samples[0];
+    const uint32_t median = run->samples[count / 2];
+    const uint32_t max = run->samples[count - 1];
+    const uint32_t kib_per_second =
+        (run->bytes && median) ? (uint64_t)run->bytes * SystemCoreClock / median / 1024 : 0;
+
+    if(runner->json) {
+        printf(
+            "%s{\"suite\":\"%s\",\"case\":\"%s\",\"min\":%lu,\"median\":%lu,\"mean\":%lu,"
+            "\"max\":%lu,\"stddev\":%lu,\"bytes\":%zu,\"kib_per_s\":%lu}",
+            runner->json_first ? "" : ",",
+            runner->suite,
+            name,
+            min,
+            median,
+            mean,
+            max,
+            stddev,
+            run->bytes,
+            kib_per_second);
+        runner->json_first = false;
+    } else {
+        printf(
+            "%-14s %-24s %9lu %9lu %9lu %9lu %8lu %10lu\r\n",
+            runner->suite,
+            name,
+            min,
+            median,
+            mean,
+            max,
+            stddev,
+            kib_per_second);
+    }
+}
+
+void bench_runner_finish(BenchRunner* runner) {
+    furi_check(runner);
+
+    if(runner->json) {
+        printf("]}\r\n");
+    }
+}
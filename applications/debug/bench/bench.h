@@ -0,0 +1,78 @@
+/**
+ * @file bench.h
+ * Micro-benchmark framework
+ *
+ * Cases and suites are declared like minunit tests:
+ *
+ *     BENCH_CASE(string_cat) {
+ *         FuriString* string = furi_string_alloc();
+ *         BENCH_LOOP() {
+ *             furi_string_cat_str(string, "a");
+ *         }
+ *         furi_string_free(string);
+ *     }
+ *
+ *     BENCH_SUITE(furi_string) {
+ *         BENCH_RUN_CASE(string_cat);
+ *     }
+ *
+ * Every pass of the loop is one sample, timed with the DWT cycle counter.
+ * Warmup passes are not recorded and the cost of the loop itself is subtracted.
+ * Work that must not be measured goes between bench_run_pause and
+ * bench_run_resume.
+ */
+#pragma once
+
+#include <furi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct BenchRun BenchRun;
+typedef struct BenchRunner BenchRunner;
+
+typedef void (*BenchCase)(BenchRun* run);
+typedef void (*BenchSuite)(BenchRunner* runner);
+
+#define BENCH_CASE(name)     static void name(BenchRun* run)
+#define BENCH_LOOP()         for(bench_run_start(run); bench_run_next(run);)
+#define BENCH_SUITE(name)    void name(BenchRunner* runner)
+#define BENCH_RUN_CASE(name) bench_runner_run_case(runner, #name, name)
+
+/** Rewind the run to the first warmup pass */
+void bench_run_start(BenchRun* run);
+
+/** Record the pass that just ended, if any
+ *
+ * @return     true if one more pass is needed
+ */
+bool bench_run_next(BenchRun* run);
+
+/** Stop counting cycles of the current pass */
+void bench_run_pause(BenchRun* run);
+
+/** Continue counting cycles of the current pass */
+void bench_run_resume(BenchRun* run);
+
+/** Report throughput, each pass processes that many bytes */
+void bench_run_set_bytes(BenchRun* run, size_t bytes);
+
+/** Abort the case with a reason, the loop ends on the next pass */
+void bench_run_fail(BenchRun* run, const char* reason);
+
+BenchRunner* bench_runner_alloc(uint32_t warmup, uint32_t repetitions, bool json);
+
+void bench_runner_free(BenchRunner* runner);
+
+/** Run every case of the suite and print results as they come */
+void bench_runner_run_suite(BenchRunner* runner, const char* name, BenchSuite suite);
+
+void bench_runner_run_case(BenchRunner* runner, const char* name, BenchCase bench_case);
+
+/** Close the report, prints the JSON footer */
+void bench_runner_finish(BenchRunner* runner);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,99 @@
+#include "bench.h"
+#include "benchmarks/benchmarks.h"
+
+#include <furi.h>
+#include <cli/cli.h>
+#include <lib/toolbox/args.h>
+
+#define BENCH_WARMUP_DEFAULT      (10U)
+#define BENCH_REPETITIONS_DEFAULT (100U)
+#define BENCH_REPETITIONS_MAX     (10000U)
+
+typedef struct {
+    const char* name;
+    BenchSuite suite;
+} BenchSuiteEntry;
+
+static const BenchSuiteEntry bench_suites[] = {
+    {"memmgr", bench_memmgr},
+    {"furi_string", bench_furi_string},
+    {"message_queue", bench_message_queue},
+    {"event_loop", bench_event_loop},
+    {"storage", bench_storage},
+    {"canvas", bench_canvas},
+    {"crypto", bench_crypto},
+};
+
+static void bench_cli_print_usage(void) {
+    printf("Usage:\r\n");
+    printf("bench [json] [-n <repetitions>] [-w <warmup>] [list | <suite>]\r\n");
+    printf("\tjson\t - Print one JSON report instead of a table\r\n");
+    printf("\t-n\t - Recorded passes per case, %u by default\r\n", BENCH_REPETITIONS_DEFAULT);
+    printf("\t-w\t - Discarded passes per case, %u by default\r\n", BENCH_WARMUP_DEFAULT);
+    printf("\tlist\t - Show available suites\r\n");
+    printf("All suites are run when none is given\r\n");
+}
+
+static void bench_cli(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+
+    FuriString* word = furi_string_alloc();
+    const char* suite_name = NULL;
+    bool json = false;
+    int warmup = BENCH_WARMUP_DEFAULT;
+    int repetitions = BENCH_REPETITIONS_DEFAULT;
+    bool args_valid = true;
+
+    while(args_valid && args_read_string_and_trim(args, word)) {
+        if(furi_string_cmp_str(word, "json") == 0) {
+            json = true;
+        } else if(furi_string_cmp_str(word, "-n") == 0) {
+            args_valid = args_read_int_and_trim(args, &repetitions) && repetitions > 0 &&
+                         repetitions <= (int)BENCH_REPETITIONS_MAX;
+        } else if(furi_string_cmp_str(word, "-w") == 0) {
+            args_valid = args_read_int_and_trim(args, &warmup) && warmup >= 0;
+        } else if(furi_string_cmp_str(word, "list") == 0) {
+            for(size_t i = 0; i < COUNT_OF(bench_suites); i++) {
+                printf("%s\r\n", bench_suites[i].name);
+            }
+            furi_string_free(word);
+            return;
+        } else {
+            args_valid = false;
+            for(size_t i = 0; i < COUNT_OF(bench_suites); i++) {
+                if(furi_string_cmp_str(word, bench_suites[i].name) == 0) {
+                    suite_name = bench_suites[i].name;
+                    args_valid = true;
+                }
+            }
+        }
+    }
+
+    furi_string_free(word);
+
+    if(!args_valid) {
+        bench_cli_print_usage();
+        return;
+    }
+
+    BenchRunner* runner = bench_runner_alloc(warmup, repetitions, json);
+
+    for(size_t i = 0; i < COUNT_OF(bench_suites); i++) {
+        if(cli_cmd_interrupt_received(cli)) break;
+        if(suite_name && suite_name != bench_suites[i].name) continue;
+        bench_runner_run_suite(runner, bench_suites[i].name, bench_suites[i].suite);
+    }
+
+    bench_runner_finish(runner);
+    bench_runner_free(runner);
+}
+
+void bench_on_system_start(void) {
+#ifdef SRV_CLI
+    Cli* cli = furi_record_open(RECORD_CLI);
+    cli_add_command(cli, "bench", CliCommandFlagDefault, bench_cli, NULL);
+    furi_record_close(RECORD_CLI);
+#else
+    UNUSED(bench_cli);
+#endif
+}
@@ -0,0 +1,80 @@
+#include "benchmarks.h"
+
+#include <gui/gui.h>
+
+static void bench_canvas_draw_scene(Canvas* canvas, uint32_t counter) {
+    char buffer[16];
+
+    canvas_clear(canvas);
+    canvas_draw_frame(canvas, 0, 0, canvas_width(canvas), canvas_height(canvas));
+
+    canvas_set_font(canvas, FontPrimary);
+    canvas_draw_str_aligned(canvas, 64, 4, AlignCenter, AlignTop, "Benchmark");
+
+    canvas_set_font(canvas, FontSecondary);
+    snprintf(buffer, sizeof(buffer), "%lu", counter);
+    canvas_draw_str_aligned(canvas, 64, 20, AlignCenter, AlignTop, buffer);
+
+    canvas_draw_rbox(canvas, 8, 34, 112, 12, 3);
+    canvas_draw_line(canvas, 0, 52, 127, 52);
+    canvas_draw_circle(canvas, 16 + counter % 96, 58, 4);
+}
+
+static void bench_canvas_run(BenchRun* run, bool commit) {
+    Gui* gui = furi_record_open(RECORD_GUI);
+    Canvas* canvas = gui_direct_draw_acquire(gui);
+
+    uint32_t counter = 0;
+    BENCH_LOOP() {
+        bench_canvas_draw_scene(canvas, counter++);
+        if(commit) canvas_commit(canvas);
+    }
+
+    gui_direct_draw_release(gui);
+    furi_record_close(RECORD_GUI);
+}
+
+BENCH_CASE(draw) {
+    bench_canvas_run(run, false);
+}
+
+BENCH_CASE(draw_commit) {
+    bench_canvas_run(run, true);
+}
+
+static void bench_canvas_xbm_run(BenchRun* run, int32_t x, int32_t y) {
+    Gui* gui = furi_record_open(RECORD_GUI);
+    Canvas* canvas = gui_direct_draw_acquire(gui);
+
+    // Full screen frame, like animations and games push
+    const size_t width = canvas_width(canvas);
+    const size_t height = canvas_height(canvas);
+    uint8_t* bitmap = malloc((width + 7) / 8 * height);
+    for(size_t i = 0; i < (width + 7) / 8 * height; i++) {
+        bitmap[i] = i * 37U;
+    }
+
+    canvas_clear(canvas);
+    BENCH_LOOP() {
+        canvas_draw_xbm(canvas, x, y, width, height, bitmap);
+    }
+
+    free(bitmap);
+    gui_direct_draw_release(gui);
+    furi_record_close(RECORD_GUI);
+}
+
+BENCH_CASE(draw_xbm) {
+    bench_canvas_xbm_run(run, 0, 0);
+}
+
+BENCH_CASE(draw_xbm_unaligned) {
+    bench_canvas_xbm_run(run, -3, 5);
+}
+
+BENCH_SUITE(bench_canvas) {
+    BENCH_RUN_CASE(draw);
+    BENCH_RUN_CASE(draw_commit);
+    BENCH_RUN_CASE(draw_xbm);
+    BENCH_RUN_CASE(draw_xbm_unaligned);
+}
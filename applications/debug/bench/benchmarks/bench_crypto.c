@@ -0,0 +1,113 @@
+#include "benchmarks.h"
+
+#include <furi_hal_crypto.h>
+#include <furi_hal_pka.h>
+#include <furi_hal_random.h>
+#include <mbedtls/sha256.h>
+#include <mbedtls/ecdsa.h>
+
+#define BENCH_CRYPTO_KEY_SIZE (32U)
+#define BENCH_CRYPTO_IV_SIZE  (12U)
+
+static void bench_crypto_aes_ctr(BenchRun* run, size_t size) {
+    const uint8_t key[BENCH_CRYPTO_KEY_SIZE] = {0x42};
+    const uint8_t iv[BENCH_CRYPTO_IV_SIZE] = {0x24};
+    uint8_t* input = malloc(size);
+    uint8_t* output = malloc(size);
+    memset(input, 0x5A, size);
+
+    BENCH_LOOP() {
+        if(!furi_hal_crypto_ctr(key, iv, input, output, size)) {
+            bench_run_fail(run, "AES-CTR failed");
+        }
+    }
+    bench_run_set_bytes(run, size);
+
+    free(output);
+    free(input);
+}
+
+static void bench_crypto_sha256(BenchRun* run, size_t size) {
+    uint8_t* input = malloc(size);
+    uint8_t hash[32];
+    memset(input, 0x5A, size);
+
+    BENCH_LOOP() {
+        mbedtls_sha256(input, size, hash, 0);
+    }
+    bench_run_set_bytes(run, size);
+
+    free(input);
+}
+
+static int bench_crypto_random_cb(void* context, uint8_t* dest, size_t size) {
+    UNUSED(context);
+    furi_hal_random_fill_buf(dest, size);
+    return 0;
+}
+
+// Any scalar below the group order is a valid key
+static const uint8_t bench_crypto_p256_key[FURI_HAL_PKA_P256_SIZE] = {
+    0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42,
+    0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42,
+};
+
+BENCH_CASE(ecdsa_p256_sign_mbedtls) {
+    const uint8_t hash[FURI_HAL_PKA_P256_SIZE] = {0x5A};
+    mbedtls_ecp_group group;
+    mbedtls_mpi r, s, d;
+    mbedtls_ecp_group_init(&group);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    mbedtls_mpi_init(&d);
+    mbedtls_ecp_group_load(&group, MBEDTLS_ECP_DP_SECP256R1);
+    mbedtls_mpi_read_binary(&d, bench_crypto_p256_key, sizeof(bench_crypto_p256_key));
+
+    BENCH_LOOP() {
+        if(mbedtls_ecdsa_sign(
+               &group, &r, &s, &d, hash, sizeof(hash), bench_crypto_random_cb, NULL) != 0) {
+            bench_run_fail(run, "mbedtls sign failed");
+        }
+    }
+
+    mbedtls_mpi_free(&d);
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_ecp_group_free(&group);
+}
+
+BENCH_CASE(ecdsa_p256_sign_pka) {
+    const uint8_t hash[FURI_HAL_PKA_P256_SIZE] = {0x5A};
+    uint8_t signature[FURI_HAL_PKA_P256_SIZE * 2];
+
+    BENCH_LOOP() {
+        if(!furi_hal_pka_ecdsa_sign_p256(bench_crypto_p256_key, hash, signature)) {
+            bench_run_fail(run, "PKA busy or failed");
+        }
+    }
+}
+
+BENCH_CASE(aes_ctr_256) {
+    bench_crypto_aes_ctr(run, 256);
+}
+
+BENCH_CASE(aes_ctr_4096) {
+    bench_crypto_aes_ctr(run, 4096);
+}
+
+BENCH_CASE(sha256_256) {
+    bench_crypto_sha256(run, 256);
+}
+
+BENCH_CASE(sha256_4096) {
+    bench_crypto_sha256(run, 4096);
+}
+
+BENCH_SUITE(bench_crypto) {
+    BENCH_RUN_CASE(aes_ctr_256);
+    BENCH_RUN_CASE(aes_ctr_4096);
+    BENCH_RUN_CASE(sha256_256);
+    BENCH_RUN_CASE(sha256_4096);
+    BENCH_RUN_CASE(ecdsa_p256_sign_mbedtls);
+    BENCH_RUN_CASE(ecdsa_p256_sign_pka);
+}
@@ -0,0 +1,79 @@
+#include "benchmarks.h"
+
+#define BENCH_EVENT_LOOP_STOP UINT32_MAX
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriMessageQueue* request;
+    FuriMessageQueue* response;
+} BenchEventLoop;
+
+static void bench_event_loop_request_callback(FuriEventLoopObject* object, void* context) {
+    BenchEventLoop* instance = context;
+    furi_assert(object == instance->request);
+
+    uint32_t message;
+    furi_check(furi_message_queue_get(instance->request, &message, 0) == FuriStatusOk);
+    furi_check(
+        furi_message_queue_put(instance->response, &message, FuriWaitForever) == FuriStatusOk);
+
+    if(message == BENCH_EVENT_LOOP_STOP) {
+        furi_event_loop_stop(instance->event_loop);
+    }
+}
+
+static int32_t bench_event_loop_worker(void* context) {
+    BenchEventLoop* instance = context;
+
+    // Event loop belongs to the thread that runs it
+    instance->event_loop = furi_event_loop_alloc();
+    furi_event_loop_subscribe_message_queue(
+        instance->event_loop,
+        instance->request,
+        FuriEventLoopEventIn,
+        bench_event_loop_request_callback,
+        instance);
+
+    uint32_t ready = 0;
+    furi_message_queue_put(instance->response, &ready, FuriWaitForever);
+
+    furi_event_loop_run(instance->event_loop);
+
+    furi_event_loop_unsubscribe(instance->event_loop, instance->request);
+    furi_event_loop_free(instance->event_loop);
+
+    return 0;
+}
+
+BENCH_CASE(message_queue_dispatch) {
+    BenchEventLoop instance = {
+        .request = furi_message_queue_alloc(1, sizeof(uint32_t)),
+        .response = furi_message_queue_alloc(1, sizeof(uint32_t)),
+    };
+    FuriThread* thread =
+        furi_thread_alloc_ex("BenchEventLoop", 1024, bench_event_loop_worker, &instance);
+    furi_thread_start(thread);
+
+    uint32_t message;
+    furi_message_queue_get(instance.response, &message, FuriWaitForever);
+
+    message = 0;
+    BENCH_LOOP() {
+        furi_message_queue_put(instance.request, &message, FuriWaitForever);
+        furi_message_queue_get(instance.response, &message, FuriWaitForever);
+        message++;
+    }
+
+    message = BENCH_EVENT_LOOP_STOP;
+    furi_message_queue_put(instance.request, &message, FuriWaitForever);
+    furi_message_queue_get(instance.response, &message, FuriWaitForever);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    furi_message_queue_free(instance.response);
+    furi_message_queue_free(instance.request);
+}
+
+BENCH_SUITE(bench_event_loop) {
+    BENCH_RUN_CASE(message_queue_dispatch);
+}
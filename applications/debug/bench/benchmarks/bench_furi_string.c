@@ -0,0 +1,70 @@
+#include "benchmarks.h"
+
+#define BENCH_FURI_STRING_TEXT \
+    "Filetype: Flipper SubGhz Key File\nVersion: 1\nFrequency: 433920000\n"
+
+BENCH_CASE(alloc_set_free) {
+    BENCH_LOOP() {
+        FuriString* string = furi_string_alloc_set_str(BENCH_FURI_STRING_TEXT);
+        furi_string_free(string);
+    }
+}
+
+BENCH_CASE(cat_str) {
+    FuriString* string = furi_string_alloc();
+    furi_string_reserve(string, 64 * 8);
+
+    BENCH_LOOP() {
+        furi_string_reset(string);
+        for(size_t i = 0; i < 64; i++) {
+            furi_string_cat_str(string, "abcdefgh");
+        }
+    }
+
+    furi_string_free(string);
+}
+
+BENCH_CASE(cat_printf) {
+    FuriString* string = furi_string_alloc();
+
+    BENCH_LOOP() {
+        furi_string_printf(string, "Frequency: %lu\n", 433920000UL);
+        furi_string_cat_printf(string, "Key: %08lX%08lX\n", 0xDEADBEEFUL, 0xCAFEBABEUL);
+    }
+
+    furi_string_free(string);
+}
+
+BENCH_CASE(cmp) {
+    FuriString* string_a = furi_string_alloc_set_str(BENCH_FURI_STRING_TEXT);
+    FuriString* string_b = furi_string_alloc_set_str(BENCH_FURI_STRING_TEXT);
+    volatile int result = 0;
+
+    BENCH_LOOP() {
+        result += furi_string_cmp(string_a, string_b);
+    }
+
+    UNUSED(result);
+    furi_string_free(string_b);
+    furi_string_free(string_a);
+}
+
+BENCH_CASE(search_str) {
+    FuriString* string = furi_string_alloc_set_str(BENCH_FURI_STRING_TEXT);
+    volatile size_t result = 0;
+
+    BENCH_LOOP() {
+        result += furi_string_search_str(string, "433920000");
+    }
+
+    UNUSED(result);
+    furi_string_free(string);
+}
+
+BENCH_SUITE(bench_furi_string) {
+    BENCH_RUN_CASE(alloc_set_free);
+    BENCH_RUN_CASE(cat_str);
+    BENCH_RUN_CASE(cat_printf);
+    BENCH_RUN_CASE(cmp);
+    BENCH_RUN_CASE(search_str);
+}
@@ -0,0 +1,50 @@
+#include "benchmarks.h"
+
+#define BENCH_MEMMGR_BLOCKS (16U)
+
+static void bench_memmgr_alloc_free(BenchRun* run, size_t size) {
+    BENCH_LOOP() {
+        void* block = malloc(size);
+        free(block);
+    }
+}
+
+static void bench_memmgr_fragmented(BenchRun* run, size_t size) {
+    void* blocks[BENCH_MEMMGR_BLOCKS];
+
+    BENCH_LOOP() {
+        for(size_t i = 0; i < BENCH_MEMMGR_BLOCKS; i++) {
+            blocks[i] = malloc(size);
+        }
+        // Free every other block first to leave holes
+        for(size_t i = 0; i < BENCH_MEMMGR_BLOCKS; i += 2) {
+            free(blocks[i]);
+        }
+        for(size_t i = 1; i < BENCH_MEMMGR_BLOCKS; i += 2) {
+            free(blocks[i]);
+        }
+    }
+}
+
+BENCH_CASE(alloc_free_16) {
+    bench_memmgr_alloc_free(run, 16);
+}
+
+BENCH_CASE(alloc_free_256) {
+    bench_memmgr_alloc_free(run, 256);
+}
+
+BENCH_CASE(alloc_free_4096) {
+    bench_memmgr_alloc_free(run, 4096);
+}
+
+BENCH_CASE(fragmented_16x64) {
+    bench_memmgr_fragmented(run, 64);
+}
+
+BENCH_SUITE(bench_memmgr) {
+    BENCH_RUN_CASE(alloc_free_16);
+    BENCH_RUN_CASE(alloc_free_256);
+    BENCH_RUN_CASE(alloc_free_4096);
+    BENCH_RUN_CASE(fragmented_16x64);
+}
@@ -0,0 +1,65 @@
+#include "benchmarks.h"
+
+#define BENCH_MESSAGE_QUEUE_STOP UINT32_MAX
+
+typedef struct {
+    FuriMessageQueue* request;
+    FuriMessageQueue* response;
+} BenchMessageQueue;
+
+static int32_t bench_message_queue_echo(void* context) {
+    BenchMessageQueue* queues = context;
+
+    uint32_t message;
+    do {
+        furi_check(
+            furi_message_queue_get(queues->request, &message, FuriWaitForever) == FuriStatusOk);
+        furi_check(
+            furi_message_queue_put(queues->response, &message, FuriWaitForever) ==
+            FuriStatusOk);
+    } while(message != BENCH_MESSAGE_QUEUE_STOP);
+
+    return 0;
+}
+
+BENCH_CASE(put_get) {
+    FuriMessageQueue* queue = furi_message_queue_alloc(1, sizeof(uint32_t));
+    uint32_t message = 0;
+
+    BENCH_LOOP() {
+        furi_message_queue_put(queue, &message, 0);
+        furi_message_queue_get(queue, &message, 0);
+    }
+
+    furi_message_queue_free(queue);
+}
+
+BENCH_CASE(ping_pong) {
+    BenchMessageQueue queues = {
+        .request = furi_message_queue_alloc(1, sizeof(uint32_t)),
+        .response = furi_message_queue_alloc(1, sizeof(uint32_t)),
+    };
+    FuriThread* thread =
+        furi_thread_alloc_ex("BenchEcho", 1024, bench_message_queue_echo, &queues);
+    furi_thread_start(thread);
+
+    uint32_t message = 0;
+    BENCH_LOOP() {
+        furi_message_queue_put(queues.request, &message, FuriWaitForever);
+        furi_message_queue_get(queues.response, &message, FuriWaitForever);
+        message++;
+    }
+
+    message = BENCH_MESSAGE_QUEUE_STOP;
+    furi_message_queue_put(queues.request, &message, FuriWaitForever);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    furi_message_queue_free(queues.response);
+    furi_message_queue_free(queues.request);
+}
+
+BENCH_SUITE(bench_message_queue) {
+    BENCH_RUN_CASE(put_get);
+    BENCH_RUN_CASE(ping_pong);
+}
@@ -0,0 +1,93 @@
+#include "benchmarks.h"
+
+#include <storage/storage.h>
+
+#define BENCH_STORAGE_PATH      EXT_PATH(".tmp/bench_storage.bin")
+#define BENCH_STORAGE_FILE_SIZE (16U * 1024U)
+
+static void bench_storage_run(BenchRun* run, size_t chunk_size, bool write) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint8_t* chunk = malloc(chunk_size);
+    memset(chunk, 0xA5, chunk_size);
+
+    const size_t chunks = BENCH_STORAGE_FILE_SIZE / chunk_size;
+
+    do {
+        if(storage_sd_status(storage) != FSE_OK) {
+            bench_run_fail(run, "no SD card");
+            break;
+        }
+
+        storage_common_mkdir(storage, EXT_PATH(".tmp"));
+        if(!storage_file_open(file, BENCH_STORAGE_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+            bench_run_fail(run, "open failed");
+            break;
+        }
+
+        // Read case needs the whole file to exist before the first pass
+        for(size_t i = 0; i < chunks && !write; i++) {
+            storage_file_write(file, chunk, chunk_size);
+        }
+
+        BENCH_LOOP() {
+            bench_run_pause(run);
+            storage_file_seek(file, 0, true);
+            bench_run_resume(run);
+
+            for(size_t i = 0; i < chunks; i++) {
+                const size_t done = write ? storage_file_write(file, chunk, chunk_size) :
+                                            storage_file_read(file, chunk, chunk_size);
+                if(done != chunk_size) {
+                    bench_run_fail(run, write ? "write failed" : "read failed");
+                    break;
+                }
+            }
+
+            // Dirty data must reach the card inside the pass
+            if(write) storage_file_sync(file);
+        }
+        bench_run_set_bytes(run, chunks * chunk_size);
+
+        storage_file_close(file);
+    } while(false);
+
+    storage_simply_remove(storage, BENCH_STORAGE_PATH);
+
+    free(chunk);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+BENCH_CASE(write_64) {
+    bench_storage_run(run, 64, true);
+}
+
+BENCH_CASE(write_512) {
+    bench_storage_run(run, 512, true);
+}
+
+BENCH_CASE(write_4096) {
+    bench_storage_run(run, 4096, true);
+}
+
+BENCH_CASE(read_64) {
+    bench_storage_run(run, 64, false);
+}
+
+BENCH_CASE(read_512) {
+    bench_storage_run(run, 512, false);
+}
+
+BENCH_CASE(read_4096) {
+    bench_storage_run(run, 4096, false);
+}
+
+BENCH_SUITE(bench_storage) {
+    BENCH_RUN_CASE(write_64);
+    BENCH_RUN_CASE(write_512);
+    BENCH_RUN_CASE(write_4096);
+    BENCH_RUN_CASE(read_64);
+    BENCH_RUN_CASE(read_512);
+    BENCH_RUN_CASE(read_4096);
+}
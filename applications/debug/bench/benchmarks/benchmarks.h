@@ -0,0 +1,11 @@
+#pragma once
+
+#include "../bench.h"
+
+BENCH_SUITE(bench_memmgr);
+BENCH_SUITE(bench_furi_string);
+BENCH_SUITE(bench_message_queue);
+BENCH_SUITE(bench_event_loop);
+BENCH_SUITE(bench_storage);
+BENCH_SUITE(bench_canvas);
+BENCH_SUITE(bench_crypto);
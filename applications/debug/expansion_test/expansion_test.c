@@ -45,6 +45,9 @@
 #include <storage/storage.h>
 #include <expansion/expansion.h>
 #include <notification/notification_messages.h>
+
+// Extended mode is not used, keep frames small
+#define EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE (EXPANSION_PROTOCOL_MAX_DATA_SIZE)
 #include <expansion/expansion_protocol.h>
 
 #define TAG "ExpansionTest"
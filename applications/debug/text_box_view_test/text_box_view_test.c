@@ -3,13 +3,17 @@
 #include <gui/view_dispatcher.h>
 #include <gui/modules/text_box.h>
 #include <gui/view_stack.h>
+#include <toolbox/stream/string_stream.h>
 
 #define TAG "TextBoxViewTest"
 
+#define TEXT_BOX_VIEW_TEST_STREAM_LINES (300)
+
 typedef struct {
     TextBoxFont font;
     TextBoxFocus focus;
     const char* text;
+    bool stream; // Show generated text through stream instead
 } TextBoxViewTestContent;
 
 static const TextBoxViewTestContent text_box_view_test_content_arr[] = {
@@ -75,10 +79,21 @@ static const TextBoxViewTestContent text_box_view_test_content_arr[] = {
         .text =
             "0000 0000 0000 0000\n1111 1111 1111 1111\n2222 2222 2222 2222\n3333 3333 3333 3333\n4444 4444 4444 4444\n5555 5555 5555 5555\n6666 6666 6666 6666\n7777 7777 7777 7777\n8888 8888 8888 8888\n9999 9999 9999 9999\n0000 0000 0000 0000\n1111 1111 1111 1111\n2222 2222 2222 2222\n3333 3333 3333 3333\n4444 4444 4444 4444\n5555 5555 5555 5555\n6666 6666 6666 6666\n7777 7777 7777 7777\n8888 8888 8888 8888\n9999 9999 9999 9999\n0000 0000 0000 0000\n1111 1111 1111 1111\n2222 2222 2222 2222\n3333 3333 3333 3333\n4444 4444 4444 4444\n5555 5555 5555 5555\n6666 6666 6666 6666\n7777 7777 7777 7777\n8888 8888 8888 8888\n9999 9999 9999 9999\n0000 0000 0000 0000\n1111 1111 1111 1111\n2222 2222 2222 2222\n3333 3333 3333 3333\n4444 4444 4444 4444\n5555 5555 5555 5555\n6666 6666 6666 6666\n7777 7777 7777 7777\n8888 8888 8888 8888\n9999 9999 9999 9999\n0000 0000 0000 0000\n1111 1111 1111 1111\n2222 2222 2222 2222\n3333 3333 3333 3333\n4444 4444 4444 4444\n5555 5555 5555 5555\n6666 6666 6666 6666\n7777 7777 7777 7777\n8888 8888 8888 8888\n9999 9999 9999 9999\n0000 0000 0000 0000\n1111 1111 1111 1111\n2222 2222 2222 2222\n3333 3333 3333 3333\n4444 4444 4444 4444\n5555 5555 5555 5555\n6666 6666 6666 6666\n7777 7777 7777 7777\n8888 8888 8888 8888\n9999 9999 9999 9999\n0000 0000 0000 0000\n1111 1111 1111 1111\n2222 2222 2222 2222\n3333 3333 3333 3333\n4444 4444 4444 4444\n5555 5555 5555 5555\n6666 6666 6666 6666\n7777 7777 7777 7777\n8888 8888 8888 8888\n9999 9999 9999 9999\n0000 0000 0000 0000\n1111 1111 1111 1111\n2222 2222 2222 2222\n3333 3333 3333 3333\n4444 4444 4444 4444\n5555 5555 5555 5555\n6666 6666 6666 6666\n7777 7777 7777 7777\n8888 8888 8888 8888\n9999 9999 9999 9999\n0000 0000 0000 0000\n1111 1111 1111 1111\n2222 2222 2222 2222\n3333 3333 3333 3333\n4444 4444 4444 4444\n5555 5555 5555 5555\n6666 6666 6666 6666\n7777 7777 7777 7777\n8888 8888 8888 8888\n9999 9999 9999 9999\n0000 0000 0000 0000\n1111 1111 1111 1111\n2222 2222 2222 2222\n3333 3333 3333 3333\n4444 4444 4444 4444\n5555 5555 5555 5555\n6666 6666 6666 6666\n7777 7777 7777 7777\n8888 8888 8888 8888\n9999 9999 9999 9999\n0000 0000 0000 0000\n1111 1111 1111 1111\n2222 2222 2222 2222\n3333 3333 3333 3333\n4444 4444 4444 4444\n5555 5555 5555 5555\n6666 6666 6666 6666\n7777 7777 7777 7777\n8888 8888 8888 8888\n9999 9999 9999 9999",
     },
+    {
+        .font = TextBoxFontText,
+        .focus = TextBoxFocusStart,
+        .stream = true,
+    },
+    {
+        .font = TextBoxFontText,
+        .focus = TextBoxFocusEnd,
+        .stream = true,
+    },
 };
 
 typedef struct {
     TextBox* text_box;
+    Stream* stream;
     ViewDispatcher* view_dispatcher;
     size_t current_content_i;
 } TextBoxViewTest;
@@ -91,7 +106,11 @@ static void text_box_update_view(TextBoxViewTest* instance) {
         &text_box_view_test_content_arr[instance->current_content_i];
     text_box_set_font(instance->text_box, content->font);
     text_box_set_focus(instance->text_box, content->focus);
-    text_box_set_text(instance->text_box, content->text);
+    if(content->stream) {
+        text_box_set_stream(instance->text_box, instance->stream);
+    } else {
+        text_box_set_text(instance->text_box, content->text);
+    }
 }
 
 static bool text_box_switch_view_input_callback(InputEvent* event, void* context) {
@@ -129,10 +148,19 @@ int32_t text_box_view_test_app(void* p) {
 
     TextBoxViewTest instance = {
         .text_box = text_box_alloc(),
+        .stream = string_stream_alloc(),
         .current_content_i = 0,
         .view_dispatcher = view_dispatcher,
     };
 
+    for(size_t i = 0; i < TEXT_BOX_VIEW_TEST_STREAM_LINES; i++) {
+        stream_write_format(
+            instance.stream,
+            "Stream line %zu of %d, long enough to be wrapped by text box\n",
+            i + 1,
+            TEXT_BOX_VIEW_TEST_STREAM_LINES);
+    }
+
     text_box_update_view(&instance);
 
     View* text_box_switch_view = view_alloc();
@@ -153,6 +181,7 @@ int32_t text_box_view_test_app(void* p) {
     view_stack_free(view_stack);
     view_free(text_box_switch_view);
     text_box_free(instance.text_box);
+    stream_free(instance.stream);
 
     furi_record_close(RECORD_GUI);
 
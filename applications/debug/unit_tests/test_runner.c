@@ -19,6 +19,9 @@ extern const ElfApiInterface* const unit_tests_api_interface;
 
 #define PLUGINS_PATH "/ext/apps_data/unit_tests/plugins"
 
+// Only run when asked for by name, see `scripts/testops.py run_benchmark`
+#define BENCHMARK_PLUGIN_NAME "test_benchmark"
+
 struct TestRunner {
     Storage* storage;
     Loader* loader;
@@ -172,6 +175,8 @@ static void test_runner_run_internal(TestRunner* instance) {
                 } else {
                     printf("Skipping %s\r\n", file_basename_cstr);
                 }
+            } else if(strcmp(file_basename_cstr, BENCHMARK_PLUGIN_NAME) == 0) {
+                printf("Skipping %s\r\n", file_basename_cstr);
             } else {
                 result = test_runner_run_plugin(instance, furi_string_get_cstr(file_name));
             }
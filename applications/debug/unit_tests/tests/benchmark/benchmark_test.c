@@ -0,0 +1,438 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include "../test.h" // IWYU pragma: keep
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/protocols/protocol_items.h>
+#include <infrared.h>
+#include <toolbox/protocols/protocol_dict.h>
+#include <toolbox/pulse_protocols/pulse_glue.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+
+#define TAG "BenchmarkTest"
+
+#define BENCHMARK_SUBGHZ_CORPUS     EXT_PATH("unit_tests/subghz/test_random_raw.sub")
+#define BENCHMARK_SUBGHZ_ASSETS_DIR EXT_PATH("subghz/assets")
+#define BENCHMARK_INFRARED_DIR      EXT_PATH("unit_tests/infrared")
+#define BENCHMARK_INFRARED_PREFIX   "test_"
+#define BENCHMARK_INFRARED_SUFFIX   ".irtest"
+
+#define BENCHMARK_EDGES_MAX          8192
+#define BENCHMARK_BATCH_SIZE         64
+#define BENCHMARK_LOAD_TIMEOUT       10000
+#define BENCHMARK_LFRFID_EDGES       2048
+#define BENCHMARK_LFRFID_TIMING_MULT 8
+
+// Report rows are parsed by `scripts/testops.py run_benchmark`, keep columns in sync
+#define BENCHMARK_REPORT_HEADER \
+    "BENCH,suite,decoder,edges,cycles_per_edge,edges_per_s,decoded,heap_peak"
+
+typedef struct {
+    LevelDuration* edges;
+    size_t count;
+} BenchmarkCorpus;
+
+typedef struct {
+    size_t heap_start;
+    size_t heap_min;
+    uint32_t cycles;
+} BenchmarkMeter;
+
+static void benchmark_meter_start(BenchmarkMeter* meter) {
+    meter->heap_start = memmgr_get_free_heap();
+    meter->heap_min = meter->heap_start;
+    meter->cycles = 0;
+}
+
+static void benchmark_meter_sample_heap(BenchmarkMeter* meter) {
+    meter->heap_min = MIN(meter->heap_min, memmgr_get_free_heap());
+}
+
+static void benchmark_report(
+    const char* suite,
+    const char* decoder,
+    size_t edges,
+    const BenchmarkMeter* meter,
+    size_t decoded) {
+    const uint64_t cycles_per_second =
+        (uint64_t)furi_hal_cortex_instructions_per_microsecond() * 1000000;
+    const uint32_t edges_per_second =
+        meter->cycles ? (uint32_t)(edges * cycles_per_second / meter->cycles) : 0;
+
+    printf(
+        "BENCH,%s,%s,%zu,%lu,%lu,%zu,%zu\r\n",
+        suite,
+        decoder,
+        edges,
+        edges ? meter->cycles / edges : 0,
+        edges_per_second,
+        decoded,
+        meter->heap_start - meter->heap_min);
+}
+
+static BenchmarkCorpus* benchmark_corpus_alloc(void) {
+    BenchmarkCorpus* corpus = malloc(sizeof(BenchmarkCorpus));
+    corpus->edges = malloc(sizeof(LevelDuration) * BENCHMARK_EDGES_MAX);
+    corpus->count = 0;
+    return corpus;
+}
+
+static void benchmark_corpus_free(BenchmarkCorpus* corpus) {
+    free(corpus->edges);
+    free(corpus);
+}
+
+static bool benchmark_corpus_push(BenchmarkCorpus* corpus, bool level, uint32_t duration) {
+    if(corpus->count == BENCHMARK_EDGES_MAX) return false;
+    corpus->edges[corpus->count++] = level_duration_make(level, duration);
+    return true;
+}
+
+/* SubGhz: recorded RAW capture through the receiver, then through each decoder */
+
+static size_t benchmark_subghz_decoded;
+
+static void benchmark_subghz_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(decoder_base);
+    UNUSED(context);
+    subghz_receiver_reset(receiver);
+    benchmark_subghz_decoded++;
+}
+
+static void benchmark_subghz_decoder_callback(SubGhzProtocolDecoderBase* instance, void* context) {
+    UNUSED(instance);
+    UNUSED(context);
+    benchmark_subghz_decoded++;
+}
+
+static bool benchmark_subghz_load(BenchmarkCorpus* corpus, const char* path) {
+    uint32_t load_start = furi_get_tick();
+
+    SubGhzFileEncoderWorker* file_worker = subghz_file_encoder_worker_alloc();
+    if(subghz_file_encoder_worker_start(file_worker, path, NULL)) {
+        // the worker needs a file in order to open and read part of the file
+        furi_delay_ms(100);
+
+        while(furi_get_tick() - load_start < BENCHMARK_LOAD_TIMEOUT) {
+            LevelDuration level_duration =
+                subghz_file_encoder_worker_get_level_duration(file_worker);
+            if(level_duration_is_reset(level_duration)) {
+                break;
+            } else if(level_duration_is_wait(level_duration)) {
+                // Yield, to load data inside the worker
+                furi_thread_yield();
+            } else if(corpus->count < BENCHMARK_EDGES_MAX) {
+                corpus->edges[corpus->count++] = level_duration;
+            } else {
+                break;
+            }
+        }
+        if(subghz_file_encoder_worker_is_running(file_worker)) {
+            subghz_file_encoder_worker_stop(file_worker);
+        }
+    }
+    subghz_file_encoder_worker_free(file_worker);
+
+    return corpus->count != 0;
+}
+
+static bool benchmark_subghz(void) {
+    BenchmarkCorpus* corpus = benchmark_corpus_alloc();
+    if(!benchmark_subghz_load(corpus, BENCHMARK_SUBGHZ_CORPUS)) {
+        benchmark_corpus_free(corpus);
+        return false;
+    }
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_came_atomo_rainbow_table_file_name(
+        environment, BENCHMARK_SUBGHZ_ASSETS_DIR "/came_atomo");
+    subghz_environment_set_nice_flor_s_rainbow_table_file_name(
+        environment, BENCHMARK_SUBGHZ_ASSETS_DIR "/nice_flor_s");
+    subghz_environment_set_alutech_at_4n_rainbow_table_file_name(
+        environment, BENCHMARK_SUBGHZ_ASSETS_DIR "/alutech_at_4n");
+    subghz_environment_set_protocol_registry(environment, &subghz_protocol_registry);
+
+    // Whole receiver, all decodable protocols enabled
+    BenchmarkMeter meter;
+    benchmark_meter_start(&meter);
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(receiver, benchmark_subghz_rx_callback, NULL);
+    benchmark_subghz_decoded = 0;
+    for(size_t i = 0; i < corpus->count; i += BENCHMARK_BATCH_SIZE) {
+        size_t batch = MIN((size_t)BENCHMARK_BATCH_SIZE, corpus->count - i);
+        uint32_t start = DWT->CYCCNT;
+        subghz_receiver_decode_batch(receiver, &corpus->edges[i], batch);
+        meter.cycles += DWT->CYCCNT - start;
+        benchmark_meter_sample_heap(&meter);
+    }
+    subghz_receiver_free(receiver);
+    benchmark_report("subghz", "receiver", corpus->count, &meter, benchmark_subghz_decoded);
+
+    // Each decoder on its own
+    const SubGhzProtocolRegistry* registry = &subghz_protocol_registry;
+    for(size_t i = 0; i < subghz_protocol_registry_count(registry); i++) {
+        const SubGhzProtocol* protocol = subghz_protocol_registry_get_by_index(registry, i);
+        if(!(protocol->flag & SubGhzProtocolFlag_Decodable) || !protocol->decoder ||
+           !protocol->decoder->alloc) {
+            continue;
+        }
+
+        benchmark_meter_start(&meter);
+        SubGhzProtocolDecoderBase* decoder = protocol->decoder->alloc(environment);
+        decoder->callback = benchmark_subghz_decoder_callback;
+        decoder->context = NULL;
+        benchmark_subghz_decoded = 0;
+        for(size_t j = 0; j < corpus->count; j += BENCHMARK_BATCH_SIZE) {
+            size_t batch = MIN((size_t)BENCHMARK_BATCH_SIZE, corpus->count - j);
+            uint32_t start = DWT->CYCCNT;
+            for(size_t k = j; k < j + batch; k++) {
+                protocol->decoder->feed(
+                    decoder,
+                    level_duration_get_level(corpus->edges[k]),
+                    level_duration_get_duration(corpus->edges[k]));
+            }
+            meter.cycles += DWT->CYCCNT - start;
+            benchmark_meter_sample_heap(&meter);
+        }
+        protocol->decoder->free(decoder);
+
+        benchmark_report(
+            "subghz", protocol->name, corpus->count, &meter, benchmark_subghz_decoded);
+    }
+
+    subghz_environment_free(environment);
+    benchmark_corpus_free(corpus);
+    return true;
+}
+
+/* Infrared: decoder inputs of every protocol test file through infrared_decode */
+
+static bool benchmark_infrared_load(BenchmarkCorpus* corpus, FlipperFormat* ff) {
+    FuriString* buf = furi_string_alloc();
+    bool loaded = false;
+
+    do {
+        uint32_t format_version;
+        if(!flipper_format_read_header(ff, buf, &format_version)) break;
+        if(furi_string_cmp_str(buf, "IR tests file") || format_version != 1) break;
+
+        while(flipper_format_read_string(ff, "name", buf)) {
+            if(!furi_string_start_with_str(buf, "decoder_input")) continue;
+            if(!flipper_format_read_string(ff, "type", buf) || furi_string_cmp_str(buf, "raw"))
+                continue;
+
+            uint32_t timings_count = 0;
+            if(!flipper_format_get_value_count(ff, "data", &timings_count)) break;
+            if(!timings_count || corpus->count + timings_count > BENCHMARK_EDGES_MAX) continue;
+
+            uint32_t* timings = malloc(timings_count * sizeof(uint32_t));
+            if(flipper_format_read_uint32(ff, "data", timings, timings_count)) {
+                // Raw signals start with a low level, as in the decoder tests
+                for(size_t i = 0; i < timings_count; i++) {
+                    benchmark_corpus_push(corpus, i & 1, timings[i]);
+                }
+            }
+            free(timings);
+        }
+
+        loaded = corpus->count != 0;
+    } while(false);
+
+    furi_string_free(buf);
+    return loaded;
+}
+
+static void benchmark_infrared_run(const BenchmarkCorpus* corpus, const char* name) {
+    BenchmarkMeter meter;
+    benchmark_meter_start(&meter);
+    InfraredDecoderHandler* decoder = infrared_alloc_decoder();
+
+    size_t decoded = 0;
+    for(size_t i = 0; i < corpus->count; i += BENCHMARK_BATCH_SIZE) {
+        size_t batch = MIN((size_t)BENCHMARK_BATCH_SIZE, corpus->count - i);
+        uint32_t start = DWT->CYCCNT;
+        for(size_t k = i; k < i + batch; k++) {
+            if(infrared_decode(
+                   decoder,
+                   level_duration_get_level(corpus->edges[k]),
+                   level_duration_get_duration(corpus->edges[k]))) {
+                decoded++;
+            }
+        }
+        meter.cycles += DWT->CYCCNT - start;
+        benchmark_meter_sample_heap(&meter);
+    }
+    if(infrared_check_decoder_ready(decoder)) decoded++;
+
+    infrared_free_decoder(decoder);
+    benchmark_report("infrared", name, corpus->count, &meter, decoded);
+}
+
+static bool benchmark_infrared(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* dir = storage_file_alloc(storage);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    char name[64];
+    size_t corpora = 0;
+
+    if(storage_dir_open(dir, BENCHMARK_INFRARED_DIR)) {
+        while(storage_dir_read(dir, NULL, name, sizeof(name))) {
+            FuriString* protocol = furi_string_alloc_set_str(name);
+            if(furi_string_start_with_str(protocol, BENCHMARK_INFRARED_PREFIX) &&
+               furi_string_end_with_str(protocol, BENCHMARK_INFRARED_SUFFIX)) {
+                furi_string_printf(path, "%s/%s", BENCHMARK_INFRARED_DIR, name);
+                furi_string_right(protocol, strlen(BENCHMARK_INFRARED_PREFIX));
+                furi_string_left(
+                    protocol, furi_string_size(protocol) - strlen(BENCHMARK_INFRARED_SUFFIX));
+
+                BenchmarkCorpus* corpus = benchmark_corpus_alloc();
+                if(flipper_format_buffered_file_open_existing(ff, furi_string_get_cstr(path)) &&
+                   benchmark_infrared_load(corpus, ff)) {
+                    benchmark_infrared_run(corpus, furi_string_get_cstr(protocol));
+                    corpora++;
+                }
+                flipper_format_buffered_file_close(ff);
+                benchmark_corpus_free(corpus);
+            }
+            furi_string_free(protocol);
+        }
+    }
+    storage_dir_close(dir);
+
+    furi_string_free(path);
+    flipper_format_free(ff);
+    storage_file_free(dir);
+    furi_record_close(RECORD_STORAGE);
+
+    return corpora != 0;
+}
+
+/* LFRFID: there are no recorded captures, corpora are made by the protocol encoders */
+
+static void benchmark_lfrfid_load(BenchmarkCorpus* corpus, ProtocolDict* dict, size_t protocol) {
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+
+    for(size_t i = 0; i < BENCHMARK_LFRFID_EDGES; i++) {
+        LevelDuration level_duration = protocol_dict_encoder_yield(dict, protocol);
+        bool pulse_pop = pulse_glue_push(
+            pulse_glue,
+            level_duration_get_level(level_duration),
+            level_duration_get_duration(level_duration) * BENCHMARK_LFRFID_TIMING_MULT);
+
+        if(pulse_pop) {
+            uint32_t length, period;
+            pulse_glue_pop(pulse_glue, &length, &period);
+            if(!benchmark_corpus_push(corpus, true, period) ||
+               !benchmark_corpus_push(corpus, false, length - period))
+                break;
+        }
+    }
+
+    pulse_glue_free(pulse_glue);
+}
+
+static void benchmark_lfrfid_run(
+    const BenchmarkCorpus* corpus,
+    ProtocolDict* dict,
+    const char* name,
+    ProtocolId protocol) {
+    BenchmarkMeter meter;
+    benchmark_meter_start(&meter);
+    protocol_dict_decoders_start(dict);
+
+    size_t decoded = 0;
+    for(size_t i = 0; i < corpus->count; i += BENCHMARK_BATCH_SIZE) {
+        size_t batch = MIN((size_t)BENCHMARK_BATCH_SIZE, corpus->count - i);
+        uint32_t start = DWT->CYCCNT;
+        for(size_t k = i; k < i + batch; k++) {
+            bool level = level_duration_get_level(corpus->edges[k]);
+            uint32_t duration = level_duration_get_duration(corpus->edges[k]);
+            ProtocolId result = (protocol == PROTOCOL_NO) ?
+                                    protocol_dict_decoders_feed(dict, level, duration) :
+                                    protocol_dict_decoders_feed_by_id(
+                                        dict, protocol, level, duration);
+            if(result != PROTOCOL_NO) {
+                decoded++;
+                protocol_dict_decoders_start(dict);
+            }
+        }
+        meter.cycles += DWT->CYCCNT - start;
+        benchmark_meter_sample_heap(&meter);
+    }
+
+    benchmark_report("lfrfid", name, corpus->count, &meter, decoded);
+}
+
+static bool benchmark_lfrfid(void) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    const size_t data_size = protocol_dict_get_max_data_size(dict);
+    uint8_t* data = malloc(data_size);
+    memset(data, 0x5A, data_size);
+
+    // PSK tags are demodulated by the reader before the decoders, skip them
+    BenchmarkCorpus* corpus = benchmark_corpus_alloc();
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        if(protocol_dict_get_features(dict, i) & LFRFIDFeaturePSK) continue;
+
+        protocol_dict_set_data(dict, i, data, protocol_dict_get_data_size(dict, i));
+        if(!protocol_dict_encoder_start(dict, i)) continue;
+
+        BenchmarkCorpus* protocol_corpus = benchmark_corpus_alloc();
+        benchmark_lfrfid_load(protocol_corpus, dict, i);
+        benchmark_lfrfid_run(protocol_corpus, dict, protocol_dict_get_name(dict, i), PROTOCOL_NO);
+
+        size_t count = MIN(protocol_corpus->count, BENCHMARK_EDGES_MAX - corpus->count);
+        memcpy(
+            &corpus->edges[corpus->count],
+            protocol_corpus->edges,
+            count * sizeof(LevelDuration));
+        corpus->count += count;
+        benchmark_corpus_free(protocol_corpus);
+    }
+
+    // Mixed corpus through each decoder on its own
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        FuriString* name = furi_string_alloc_printf("%s_decoder", protocol_dict_get_name(dict, i));
+        benchmark_lfrfid_run(corpus, dict, furi_string_get_cstr(name), i);
+        furi_string_free(name);
+    }
+
+    bool result = corpus->count != 0;
+    benchmark_corpus_free(corpus);
+    free(data);
+    protocol_dict_free(dict);
+    return result;
+}
+
+MU_TEST(benchmark_subghz_test) {
+    mu_assert(benchmark_subghz(), "SubGhz corpus not found\r\n");
+}
+
+MU_TEST(benchmark_infrared_test) {
+    mu_assert(benchmark_infrared(), "Infrared corpus not found\r\n");
+}
+
+MU_TEST(benchmark_lfrfid_test) {
+    mu_assert(benchmark_lfrfid(), "LFRFID corpus is empty\r\n");
+}
+
+MU_TEST_SUITE(benchmark) {
+    printf("\r\n" BENCHMARK_REPORT_HEADER "\r\n");
+    MU_RUN_TEST(benchmark_subghz_test);
+    MU_RUN_TEST(benchmark_infrared_test);
+    MU_RUN_TEST(benchmark_lfrfid_test);
+}
+
+int run_minunit_test_benchmark(void) {
+    MU_RUN_SUITE(benchmark);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_benchmark)
@@ -482,6 +482,44 @@ MU_TEST(test_bit_lib_test_parity) {
     mu_check(!bit_lib_test_parity(data_always_even_parity, 12, 4, BitLibParityEven, 4));
 }
 
+MU_TEST(test_bit_lib_test_parity_blocks_32) {
+    // same nibbles as above, trailing bits of an incomplete block are ignored
+    mu_check(bit_lib_test_parity_blocks_32(0b111011101110, 12, BitLibParityAlways0, 4));
+    mu_check(bit_lib_test_parity_blocks_32(0b1110111011101, 13, BitLibParityAlways0, 4));
+    mu_check(!bit_lib_test_parity_blocks_32(0b1110111011101111, 16, BitLibParityAlways0, 4));
+    mu_check(bit_lib_test_parity_blocks_32(0b000100010001, 12, BitLibParityAlways1, 4));
+    mu_check(!bit_lib_test_parity_blocks_32(0b0001000100010000, 16, BitLibParityAlways1, 4));
+    mu_check(bit_lib_test_parity_blocks_32(0b000000111111, 12, BitLibParityOdd, 4));
+    mu_check(!bit_lib_test_parity_blocks_32(0b0000001111110111, 16, BitLibParityOdd, 4));
+    mu_check(bit_lib_test_parity_blocks_32(0b000101111011, 12, BitLibParityEven, 4));
+    mu_check(!bit_lib_test_parity_blocks_32(0b0001011110110011, 16, BitLibParityEven, 4));
+
+    mu_check(bit_lib_test_parity_blocks_32(0, 0, BitLibParityAlways1, 4));
+    mu_check(bit_lib_test_parity_blocks_32(0x80000000, 32, BitLibParityEven, 32));
+    mu_check(!bit_lib_test_parity_blocks_32(0x80000000, 32, BitLibParityOdd, 32));
+}
+
+MU_TEST(test_bit_lib_find_pattern) {
+    uint8_t data[8] = {0x00, 0x00, 0x01, 0xFF, 0x80, 0x00, 0x00, 0xA5};
+
+    // 10 ones starting at bit 23
+    mu_assert_int_eq(23, bit_lib_find_pattern(data, 0, 64, 0x3FF, 10));
+    mu_assert_int_eq(22, bit_lib_find_pattern(data, 0, 64, 0x1FF, 10));
+    mu_assert_int_eq(23, bit_lib_find_pattern(data, 23, 10, 0x3FF, 10));
+    mu_assert_int_eq(BIT_LIB_NOT_FOUND, bit_lib_find_pattern(data, 23, 9, 0x3FF, 10));
+    mu_assert_int_eq(BIT_LIB_NOT_FOUND, bit_lib_find_pattern(data, 24, 40, 0x3FF, 10));
+
+    // unaligned start and end
+    mu_assert_int_eq(56, bit_lib_find_pattern(data, 3, 61, 0xA5, 8));
+    mu_assert_int_eq(61, bit_lib_find_pattern(data, 57, 7, 0x5, 3));
+    mu_assert_int_eq(BIT_LIB_NOT_FOUND, bit_lib_find_pattern(data, 3, 60, 0xA5, 8));
+
+    // 32 bit pattern across bytes
+    mu_assert_int_eq(16, bit_lib_find_pattern(data, 0, 64, 0x01FF8000, 32));
+    mu_assert_int_eq(0, bit_lib_find_pattern(data, 0, 64, 0, 1));
+    mu_assert_int_eq(23, bit_lib_find_pattern(data, 0, 64, 1, 1));
+}
+
 MU_TEST(test_bit_lib_remove_bit_every_nth) {
     // TODO FL-3494: more tests
     uint8_t data_i[1] = {0b00001111};
@@ -542,6 +580,26 @@ MU_TEST(test_bit_lib_reverse_16_fast) {
     mu_assert_int_eq(0b0000100000001001, bit_lib_reverse_16_fast(0b1001000000010000));
 }
 
+MU_TEST(test_bit_lib_crc8) {
+    uint8_t data[9] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    uint8_t data_size = 9;
+
+    // Algorithm
+    // Check	Poly	Init	RefIn	RefOut	XorOut
+    // CRC-8
+    // 0xF4	0x07	0x00	false	false	0x00
+    mu_assert_int_eq(0xF4, bit_lib_crc8(data, data_size, 0x07, 0x00, false, false, 0x00));
+    // CRC-8/MAXIM
+    // 0xA1	0x31	0x00	true	true	0x00
+    mu_assert_int_eq(0xA1, bit_lib_crc8(data, data_size, 0x31, 0x00, true, true, 0x00));
+    // CRC-8/ITU
+    // 0xA1	0x07	0x00	false	false	0x55
+    mu_assert_int_eq(0xA1, bit_lib_crc8(data, data_size, 0x07, 0x00, false, false, 0x55));
+    // CRC-8/ROHC
+    // 0xD0	0x07	0xFF	true	true	0x00
+    mu_assert_int_eq(0xD0, bit_lib_crc8(data, data_size, 0x07, 0xFF, true, true, 0x00));
+}
+
 MU_TEST(test_bit_lib_crc16) {
     uint8_t data[9] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
     uint8_t data_size = 9;
@@ -721,11 +779,14 @@ MU_TEST_SUITE(test_bit_lib) {
     MU_RUN_TEST(test_bit_lib_get_bits_64);
     MU_RUN_TEST(test_bit_lib_test_parity_u32);
     MU_RUN_TEST(test_bit_lib_test_parity);
+    MU_RUN_TEST(test_bit_lib_test_parity_blocks_32);
+    MU_RUN_TEST(test_bit_lib_find_pattern);
     MU_RUN_TEST(test_bit_lib_remove_bit_every_nth);
     MU_RUN_TEST(test_bit_lib_copy_bits);
     MU_RUN_TEST(test_bit_lib_reverse_bits);
     MU_RUN_TEST(test_bit_lib_get_bit_count);
     MU_RUN_TEST(test_bit_lib_reverse_16_fast);
+    MU_RUN_TEST(test_bit_lib_crc8);
     MU_RUN_TEST(test_bit_lib_crc16);
     MU_RUN_TEST(test_bit_lib_num_to_bytes_be);
     MU_RUN_TEST(test_bit_lib_num_to_bytes_le);
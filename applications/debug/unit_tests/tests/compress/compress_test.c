@@ -239,6 +239,95 @@ static void compress_test_heatshrink_stream() {
     furi_record_close(RECORD_STORAGE);
 }
 
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    size_t position;
+} CompressTestBuffer;
+
+static int32_t compress_test_buffer_write(void* context, uint8_t* buffer, size_t size) {
+    CompressTestBuffer* instance = context;
+    if(instance->size + size > instance->capacity) return -1;
+    memcpy(&instance->data[instance->size], buffer, size);
+    instance->size += size;
+    return size;
+}
+
+static int32_t compress_test_buffer_read(void* context, uint8_t* buffer, size_t size) {
+    CompressTestBuffer* instance = context;
+    size = MIN(size, instance->size - instance->position);
+    memcpy(buffer, &instance->data[instance->position], size);
+    instance->position += size;
+    return size;
+}
+
+static bool compress_test_buffer_seek(void* context, size_t offset) {
+    CompressTestBuffer* instance = context;
+    if(offset > instance->size) return false;
+    instance->position = offset;
+    return true;
+}
+
+static void compress_test_heatshrink_blocks() {
+    static const size_t data_size = 4000;
+    static const size_t block_size = 512;
+
+    // Compressible data: random bytes repeated a few times
+    uint8_t* data = malloc(data_size);
+    furi_hal_random_fill_buf(data, 64);
+    for(size_t i = 64; i < data_size; i++) {
+        data[i] = data[i % 64] ^ (i / 256);
+    }
+
+    CompressTestBuffer stream = {
+        .data = malloc(data_size * 2),
+        .capacity = data_size * 2,
+    };
+    Compress* comp = compress_alloc(CompressTypeHeatshrink, &compress_config_heatshrink_default);
+    mu_assert(
+        compress_encode_blocks(
+            comp, block_size, data, data_size, compress_test_buffer_write, &stream),
+        "Block encoding failed");
+    compress_free(comp);
+
+    CompressStreamDecoder* decoder = compress_stream_decoder_alloc(
+        CompressTypeHeatshrink,
+        &compress_config_heatshrink_default,
+        compress_test_buffer_read,
+        &stream);
+    mu_assert(
+        compress_stream_decoder_load_index(decoder, compress_test_buffer_seek, stream.size),
+        "Failed to load block index");
+
+    uint8_t* decoded = malloc(data_size);
+    mu_assert(compress_stream_decoder_read(decoder, decoded, data_size), "Read failed");
+    mu_assert(memcmp(decoded, data, data_size) == 0, "Decoded data mismatch");
+    mu_assert(!compress_stream_decoder_read(decoder, decoded, 1), "Read past the end");
+
+    // Backward and forward seeks, across block boundaries
+    static const size_t seeks[][2] = {{1500, 100}, {10, 1000}, {3999, 1}, {511, 2}, {0, 4000}};
+    for(size_t i = 0; i < COUNT_OF(seeks); i++) {
+        const size_t position = seeks[i][0];
+        const size_t size = seeks[i][1];
+        mu_assert(compress_stream_decoder_seek(decoder, position), "Seek failed");
+        mu_assert_int_eq(position, compress_stream_decoder_tell(decoder));
+        mu_assert(compress_stream_decoder_read(decoder, decoded, size), "Read after seek failed");
+        mu_assert(memcmp(decoded, &data[position], size) == 0, "Data mismatch after seek");
+    }
+
+    // Footer is checked
+    stream.data[stream.size - 1] ^= 0xFF;
+    mu_assert(
+        !compress_stream_decoder_load_index(decoder, compress_test_buffer_seek, stream.size),
+        "Corrupted footer accepted");
+
+    compress_stream_decoder_free(decoder);
+    free(decoded);
+    free(stream.data);
+    free(data);
+}
+
 #define HS_TAR_PATH         COMPRESS_UNIT_TESTS_PATH("test.ths")
 #define HS_TAR_EXTRACT_PATH COMPRESS_UNIT_TESTS_PATH("tar_out")
 
@@ -262,13 +351,55 @@ dir/nested_dir/empty_file.txt:  d41d8cd98f00b204e9800998ecf8427e
 XOR of all MD5 sums:            92ed5729786d0e1176d047e35f52d376
 */
 
+/* XOR of MD5 sums of all files unpacked to HS_TAR_EXTRACT_PATH must match */
+static bool compress_test_tar_out_md5_check(Storage* api) {
+    FuriString* path = furi_string_alloc();
+    FileInfo fileinfo;
+    File* file = storage_file_alloc(api);
+
+    uint8_t md5_total[16] = {0}, md5_file[16];
+
+    DirWalk* dir_walk = dir_walk_alloc(api);
+    bool success = dir_walk_open(dir_walk, HS_TAR_EXTRACT_PATH);
+    while(success && dir_walk_read(dir_walk, path, &fileinfo) == DirWalkOK) {
+        if(file_info_is_dir(&fileinfo)) {
+            continue;
+        }
+        success = md5_calc_file(file, furi_string_get_cstr(path), md5_file, NULL);
+
+        for(size_t i = 0; i < 16; i++) {
+            md5_total[i] ^= md5_file[i];
+        }
+    }
+    dir_walk_free(dir_walk);
+
+    static const unsigned char expected_md5[16] = {
+        0x92,
+        0xed,
+        0x57,
+        0x29,
+        0x78,
+        0x6d,
+        0x0e,
+        0x11,
+        0x76,
+        0xd0,
+        0x47,
+        0xe3,
+        0x5f,
+        0x52,
+        0xd3,
+        0x76};
+
+    storage_file_free(file);
+    furi_string_free(path);
+    return success && memcmp(md5_total, expected_md5, sizeof(md5_total)) == 0;
+}
+
 static void compress_test_heatshrink_tar() {
     Storage* api = furi_record_open(RECORD_STORAGE);
 
     TarArchive* archive = tar_archive_alloc(api);
-    FuriString* path = furi_string_alloc();
-    FileInfo fileinfo;
-    File* file = storage_file_alloc(api);
 
     do {
         storage_simply_remove_recursive(api, HS_TAR_EXTRACT_PATH);
@@ -292,57 +423,67 @@ static void compress_test_heatshrink_tar() {
 
         mu_assert(n_entries == 9, "Invalid number of entries in heatshrink tar");
 
-        uint8_t md5_total[16] = {0}, md5_file[16];
-
-        DirWalk* dir_walk = dir_walk_alloc(api);
-        mu_assert(dir_walk_open(dir_walk, HS_TAR_EXTRACT_PATH), "Failed to open dirwalk");
-        while(dir_walk_read(dir_walk, path, &fileinfo) == DirWalkOK) {
-            if(file_info_is_dir(&fileinfo)) {
-                continue;
-            }
-            mu_assert(
-                md5_calc_file(file, furi_string_get_cstr(path), md5_file, NULL),
-                "Failed to calc md5");
-
-            for(size_t i = 0; i < 16; i++) {
-                md5_total[i] ^= md5_file[i];
-            }
-        }
-        dir_walk_free(dir_walk);
-
-        static const unsigned char expected_md5[16] = {
-            0x92,
-            0xed,
-            0x57,
-            0x29,
-            0x78,
-            0x6d,
-            0x0e,
-            0x11,
-            0x76,
-            0xd0,
-            0x47,
-            0xe3,
-            0x5f,
-            0x52,
-            0xd3,
-            0x76};
-        mu_assert(memcmp(md5_total, expected_md5, sizeof(md5_total)) == 0, "MD5 mismatch");
+        mu_assert(compress_test_tar_out_md5_check(api), "MD5 mismatch");
 
         storage_simply_remove_recursive(api, HS_TAR_EXTRACT_PATH);
     } while(false);
 
-    storage_file_free(file);
-    furi_string_free(path);
     tar_archive_free(archive);
     furi_record_close(RECORD_STORAGE);
 }
 
+static int32_t compress_test_tar_stream_read(void* context, uint8_t* buffer, size_t size) {
+    // Odd sized reads, like chunks coming from a transport
+    return storage_file_read(context, buffer, MIN(size, 100U));
+}
+
+static void compress_test_heatshrink_tar_stream() {
+    Storage* api = furi_record_open(RECORD_STORAGE);
+
+    TarArchive* archive = tar_archive_alloc(api);
+    File* file = storage_file_alloc(api);
+
+    do {
+        storage_simply_remove_recursive(api, HS_TAR_EXTRACT_PATH);
+
+        mu_assert(storage_simply_mkdir(api, HS_TAR_EXTRACT_PATH), "Failed to create extract dir");
+
+        mu_assert(
+            storage_file_open(file, HS_TAR_PATH, FSAM_READ, FSOM_OPEN_EXISTING),
+            "Failed to open heatshrink tar");
+
+        // Compression is detected from the stream header
+        mu_assert(
+            tar_archive_open_stream(
+                archive, TarOpenModeRead, compress_test_tar_stream_read, file),
+            "Failed to open heatshrink tar stream");
+
+        int32_t n_entries = 0;
+        tar_archive_set_file_callback(archive, file_counter, &n_entries);
+
+        mu_assert(
+            tar_archive_unpack_to(archive, HS_TAR_EXTRACT_PATH, NULL),
+            "Failed to unpack heatshrink tar stream");
+
+        mu_assert(n_entries == 9, "Invalid number of entries in heatshrink tar stream");
+
+        mu_assert(compress_test_tar_out_md5_check(api), "MD5 mismatch");
+
+        storage_simply_remove_recursive(api, HS_TAR_EXTRACT_PATH);
+    } while(false);
+
+    tar_archive_free(archive);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(test_compress) {
     MU_RUN_TEST(compress_test_random_comp_decomp);
     MU_RUN_TEST(compress_test_reference_comp_decomp);
     MU_RUN_TEST(compress_test_heatshrink_stream);
+    MU_RUN_TEST(compress_test_heatshrink_blocks);
     MU_RUN_TEST(compress_test_heatshrink_tar);
+    MU_RUN_TEST(compress_test_heatshrink_tar_stream);
 }
 
 int run_minunit_test_compress(void) {
@@ -4,7 +4,7 @@
 
 MU_TEST(test_dialog_file_browser_set_basic_options_should_init_all_fields) {
     mu_assert(
-        sizeof(DialogsFileBrowserOptions) == 28,
+        sizeof(DialogsFileBrowserOptions) == 36,
         "Changes to `DialogsFileBrowserOptions` should also be reflected in `dialog_file_browser_set_basic_options`");
 
     DialogsFileBrowserOptions options;
@@ -19,6 +19,8 @@ MU_TEST(test_dialog_file_browser_set_basic_options_should_init_all_fields) {
     mu_assert(options.hide_ext, "`hide_ext` should default to `true");
     mu_assert_null(options.item_loader_callback);
     mu_assert_null(options.item_loader_context);
+    mu_assert_null(options.item_highlight_callback);
+    mu_assert_null(options.item_highlight_context);
 }
 
 MU_TEST_SUITE(dialogs_file_browser_options) {
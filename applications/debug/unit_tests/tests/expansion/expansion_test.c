@@ -6,7 +6,7 @@
 #include <expansion/expansion_protocol.h>
 
 #define EXPANSION_TEST_GARBAGE_MAGIC      (0xB19AF)
-#define EXPANSION_TEST_GARBAGE_BUF_SIZE   (0x100U)
+#define EXPANSION_TEST_GARBAGE_BUF_SIZE   (0x400U)
 #define EXPANSION_TEST_GARBAGE_ITERATIONS (100U)
 
 MU_TEST(test_expansion_encoded_size) {
@@ -29,6 +29,15 @@ MU_TEST(test_expansion_encoded_size) {
         frame.content.data.size = i;
         mu_assert_int_eq(i + 2, expansion_frame_get_encoded_size(&frame));
     }
+
+    frame.header.type = ExpansionFrameTypeExtendedMode;
+    mu_assert_int_eq(4, expansion_frame_get_encoded_size(&frame));
+
+    frame.header.type = ExpansionFrameTypeExtendedData;
+    for(size_t i = 0; i <= EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE; ++i) {
+        frame.content.extended_data.size = i;
+        mu_assert_int_eq(i + 3, expansion_frame_get_encoded_size(&frame));
+    }
 }
 
 MU_TEST(test_expansion_remaining_size) {
@@ -90,6 +99,27 @@ MU_TEST(test_expansion_remaining_size) {
     }
     mu_check(expansion_frame_get_remaining_size(&frame, 100, &remaining_size));
     mu_assert_int_eq(0, remaining_size);
+
+    frame.header.type = ExpansionFrameTypeExtendedMode;
+    mu_check(expansion_frame_get_remaining_size(&frame, 1, &remaining_size));
+    mu_assert_int_eq(3, remaining_size);
+    mu_check(expansion_frame_get_remaining_size(&frame, 4, &remaining_size));
+    mu_assert_int_eq(0, remaining_size);
+
+    frame.header.type = ExpansionFrameTypeExtendedData;
+    frame.content.extended_data.size = EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE;
+    mu_check(expansion_frame_get_remaining_size(&frame, 1, &remaining_size));
+    mu_assert_int_eq(2, remaining_size);
+    mu_check(expansion_frame_get_remaining_size(&frame, 2, &remaining_size));
+    mu_assert_int_eq(1, remaining_size);
+    mu_check(expansion_frame_get_remaining_size(&frame, 3, &remaining_size));
+    mu_assert_int_eq(EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE, remaining_size);
+    mu_check(expansion_frame_get_remaining_size(
+        &frame, EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE + 3, &remaining_size));
+    mu_assert_int_eq(0, remaining_size);
+
+    frame.content.extended_data.size = EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE + 1;
+    mu_check(!expansion_frame_get_remaining_size(&frame, 3, &remaining_size));
 }
 
 typedef struct {
@@ -170,6 +200,56 @@ MU_TEST(test_expansion_encode_decode_frame) {
     mu_assert_mem_eq(&frame_in, &frame_out, encoded_size);
 }
 
+MU_TEST(test_expansion_encode_decode_extended_frame) {
+    ExpansionFrame* frame_in = malloc(sizeof(ExpansionFrame));
+    frame_in->header.type = ExpansionFrameTypeExtendedData;
+    frame_in->content.extended_data.size = EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE;
+    for(size_t i = 0; i < EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE; ++i) {
+        frame_in->content.extended_data.bytes[i] = i;
+    }
+
+    const size_t encoded_size = expansion_frame_get_encoded_size(frame_in);
+    uint8_t* encoded_data = malloc(encoded_size + sizeof(ExpansionFrameChecksum));
+
+    TestExpansionSendStream send_stream = {
+        .data_out = encoded_data,
+        .size_available = encoded_size + sizeof(ExpansionFrameChecksum),
+        .size_sent = 0,
+    };
+
+    mu_assert_int_eq(
+        expansion_protocol_encode(frame_in, test_expansion_send_callback, &send_stream),
+        ExpansionProtocolStatusOk);
+    mu_assert_int_eq(encoded_size + sizeof(ExpansionFrameChecksum), send_stream.size_sent);
+
+    TestExpansionReceiveStream stream = {
+        .data_in = encoded_data,
+        .size_available = send_stream.size_sent,
+        .size_received = 0,
+    };
+
+    ExpansionFrame* frame_out = malloc(sizeof(ExpansionFrame));
+
+    mu_assert_int_eq(
+        expansion_protocol_decode(frame_out, test_expansion_receive_callback, &stream),
+        ExpansionProtocolStatusOk);
+    mu_assert_int_eq(encoded_size + sizeof(ExpansionFrameChecksum), stream.size_received);
+    mu_assert_mem_eq(frame_in, frame_out, encoded_size);
+
+    // Single flipped bit must not go unnoticed
+    encoded_data[encoded_size / 2] ^= 0x01;
+    stream.size_available = send_stream.size_sent;
+    stream.size_received = 0;
+
+    mu_assert_int_eq(
+        expansion_protocol_decode(frame_out, test_expansion_receive_callback, &stream),
+        ExpansionProtocolStatusErrorChecksum);
+
+    free(frame_out);
+    free(encoded_data);
+    free(frame_in);
+}
+
 MU_TEST(test_expansion_garbage_input) {
     uint8_t garbage_data[EXPANSION_TEST_GARBAGE_BUF_SIZE];
     for(uint32_t i = 0; i < EXPANSION_TEST_GARBAGE_ITERATIONS; ++i) {
@@ -191,6 +271,7 @@ MU_TEST_SUITE(test_expansion_suite) {
     MU_RUN_TEST(test_expansion_encoded_size);
     MU_RUN_TEST(test_expansion_remaining_size);
     MU_RUN_TEST(test_expansion_encode_decode_frame);
+    MU_RUN_TEST(test_expansion_encode_decode_extended_frame);
     MU_RUN_TEST(test_expansion_garbage_input);
 }
 
@@ -456,6 +456,187 @@ static bool test_read_multikey(const char* file_name) {
     return result;
 }
 
+static bool test_binary_hex(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_binary_hex(file, true);
+
+    const char* binary_key = "Binary data";
+    uint8_t binary_data[100];
+    uint8_t binary_value[COUNT_OF(binary_data)];
+    for(size_t i = 0; i < COUNT_OF(binary_data); i++) {
+        binary_data[i] = i * 7;
+    }
+
+    FuriString* string_value;
+    string_value = furi_string_alloc();
+    uint8_t hex_value[COUNT_OF(test_hex_data)];
+    uint32_t uint32_value;
+
+    do {
+        if(!flipper_format_file_open_always(file, file_name)) break;
+        if(!flipper_format_write_hex(file, binary_key, binary_data, COUNT_OF(binary_data)))
+            break;
+        if(!flipper_format_write_hex(file, test_hex_key, test_hex_data, COUNT_OF(test_hex_data)))
+            break;
+        if(!flipper_format_file_close(file)) break;
+
+        // Binary values are read back by the same functions as hex text
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+        if(!flipper_format_read_string(file, binary_key, string_value)) break;
+        if(!furi_string_start_with_str(string_value, "Bin:")) break;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_get_value_count(file, binary_key, &uint32_value)) break;
+        if(uint32_value != COUNT_OF(binary_data)) break;
+        if(!flipper_format_read_hex(file, binary_key, binary_value, COUNT_OF(binary_value)))
+            break;
+        if(memcmp(binary_value, binary_data, sizeof(binary_value)) != 0) break;
+        if(!flipper_format_read_hex(file, test_hex_key, hex_value, COUNT_OF(hex_value))) break;
+        if(memcmp(hex_value, test_hex_data, sizeof(hex_value)) != 0) break;
+
+        if(!flipper_format_update_hex(file, binary_key, &binary_data[1], 40)) break;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_get_value_count(file, binary_key, &uint32_value)) break;
+        if(uint32_value != 40) break;
+        if(!flipper_format_read_hex(file, binary_key, binary_value, 40)) break;
+        if(memcmp(binary_value, &binary_data[1], 40) != 0) break;
+        if(!flipper_format_rewind(file)) break;
+        if(flipper_format_read_hex(file, binary_key, binary_value, 41)) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(string_value);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_read_array(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+
+    int32_t int_data[100];
+    uint8_t hex_data[100];
+    for(size_t i = 0; i < COUNT_OF(int_data); i++) {
+        int_data[i] = (i % 2) ? -(int32_t)i : (int32_t)i * 1000;
+        hex_data[i] = i * 3;
+    }
+
+    int32_t int_value[COUNT_OF(int_data) + 1];
+    uint8_t hex_value[COUNT_OF(hex_data) + 1];
+    size_t count;
+
+    do {
+        if(!flipper_format_file_open_always(file, file_name)) break;
+        if(!flipper_format_write_int32(file, test_int_key, int_data, COUNT_OF(int_data))) break;
+        if(!flipper_format_write_hex(file, test_hex_key, hex_data, COUNT_OF(hex_data))) break;
+        flipper_format_set_binary_hex(file, true);
+        if(!flipper_format_write_hex(file, "Binary data", hex_data, COUNT_OF(hex_data))) break;
+        if(!flipper_format_rewind(file)) break;
+
+        // Chunks of odd sizes, which don't match base64 groups either
+        size_t total = 0;
+        if(!flipper_format_read_array_start(file, test_int_key)) break;
+        while(flipper_format_read_array_int32(file, &int_value[total], 7, &count) && count) {
+            total += count;
+            if(total > COUNT_OF(int_data)) break;
+        }
+        if(total != COUNT_OF(int_data)) break;
+        if(memcmp(int_value, int_data, sizeof(int_data)) != 0) break;
+
+        bool error = false;
+        const char* hex_keys[] = {test_hex_key, "Binary data"};
+        for(size_t i = 0; i < COUNT_OF(hex_keys); i++) {
+            total = 0;
+            if(!flipper_format_read_array_start(file, hex_keys[i])) {
+                error = true;
+                break;
+            }
+            while(flipper_format_read_array_hex(file, &hex_value[total], 5, &count) && count) {
+                total += count;
+                if(total > COUNT_OF(hex_data)) break;
+            }
+            if(total != COUNT_OF(hex_data) || memcmp(hex_value, hex_data, sizeof(hex_data))) {
+                error = true;
+                break;
+            }
+        }
+        if(error) break;
+
+        result = true;
+    } while(false);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+static bool test_key_index(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_key_index(file, true);
+
+    FuriString* string_value;
+    string_value = furi_string_alloc();
+    uint8_t hex_value[COUNT_OF(test_hex_data)];
+    bool bool_value[COUNT_OF(test_bool_data)];
+    int32_t int_value[COUNT_OF(test_int_data)];
+    uint32_t uint32_value;
+
+    do {
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+
+        // Out of order reads
+        if(!flipper_format_read_hex(file, test_hex_key, hex_value, COUNT_OF(hex_value))) break;
+        if(memcmp(hex_value, test_hex_data, sizeof(hex_value)) != 0) break;
+        if(flipper_format_read_string(file, test_string_key, string_value)) break;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_bool(file, test_bool_key, bool_value, COUNT_OF(bool_value)))
+            break;
+        if(memcmp(bool_value, test_bool_data, sizeof(bool_value)) != 0) break;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_string(file, test_string_key, string_value)) break;
+        if(furi_string_cmp_str(string_value, test_string_data) != 0) break;
+
+        // Lines after the updated and deleted ones move
+        if(!flipper_format_update_string_cstr(file, test_string_key, test_string_updated_data))
+            break;
+        if(!flipper_format_delete_key(file, test_float_key)) break;
+        if(flipper_format_key_exist(file, test_float_key)) break;
+
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_hex(file, test_hex_key, hex_value, COUNT_OF(hex_value))) break;
+        if(memcmp(hex_value, test_hex_data, sizeof(hex_value)) != 0) break;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_int32(file, test_int_key, int_value, COUNT_OF(int_value)))
+            break;
+        if(memcmp(int_value, test_int_data, sizeof(int_value)) != 0) break;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_string(file, test_string_key, string_value)) break;
+        if(furi_string_cmp_str(string_value, test_string_updated_data) != 0) break;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_header(file, string_value, &uint32_value)) break;
+        if(furi_string_cmp_str(string_value, test_filetype) != 0) break;
+        if(uint32_value != test_version) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(string_value);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
 MU_TEST(flipper_format_write_test) {
     mu_assert(storage_write_string(test_file_linux, test_data_nix), "Write test error [Linux]");
     mu_assert(
@@ -522,6 +703,21 @@ MU_TEST(flipper_format_multikey_test) {
     mu_assert(test_read_multikey(TEST_DIR "ff_multiline.test"), "Multikey read test error");
 }
 
+MU_TEST(flipper_format_key_index_test) {
+    mu_assert(
+        storage_write_string(TEST_DIR "ff_key_index.test", test_data_nix),
+        "Write test error [Key index]");
+    mu_assert(test_key_index(TEST_DIR "ff_key_index.test"), "Key index test error");
+}
+
+MU_TEST(flipper_format_binary_hex_test) {
+    mu_assert(test_binary_hex(TEST_DIR "ff_binary.test"), "Binary hex test error");
+}
+
+MU_TEST(flipper_format_read_array_test) {
+    mu_assert(test_read_array(TEST_DIR "ff_array.test"), "Array read test error");
+}
+
 MU_TEST(flipper_format_oddities_test) {
     mu_assert(
         storage_write_string(test_file_oddities, test_data_odd), "Write test error [Oddities]");
@@ -541,6 +737,9 @@ MU_TEST_SUITE(flipper_format) {
     MU_RUN_TEST(flipper_format_update_2_test);
     MU_RUN_TEST(flipper_format_update_2_result_test);
     MU_RUN_TEST(flipper_format_multikey_test);
+    MU_RUN_TEST(flipper_format_key_index_test);
+    MU_RUN_TEST(flipper_format_binary_hex_test);
+    MU_RUN_TEST(flipper_format_read_array_test);
     MU_RUN_TEST(flipper_format_oddities_test);
     tests_teardown();
 }
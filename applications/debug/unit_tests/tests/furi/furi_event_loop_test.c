@@ -488,3 +488,76 @@ void test_furi_event_loop(void) {
     furi_event_flag_free(data.event_flag);
     furi_semaphore_free(data.semaphore);
 }
+
+#define SCALING_OBJECT_COUNT_MAX (64UL)
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    uint32_t remaining;
+} TestFuriEventLoopScaling;
+
+static void test_furi_event_loop_scaling_callback(FuriEventLoopObject* object, void* context) {
+    TestFuriEventLoopScaling* data = context;
+
+    uint32_t message;
+    furi_check(furi_message_queue_get(object, &message, 0) == FuriStatusOk);
+
+    if(--data->remaining == 0) {
+        furi_event_loop_stop(data->event_loop);
+    }
+}
+
+void test_furi_event_loop_scaling(void) {
+    FuriMessageQueue** queues = malloc(sizeof(FuriMessageQueue*) * SCALING_OBJECT_COUNT_MAX);
+
+    // Per object cost should stay flat as the subscription count grows
+    for(uint32_t count = 1; count <= SCALING_OBJECT_COUNT_MAX; count *= 4) {
+        TestFuriEventLoopScaling data = {
+            .event_loop = furi_event_loop_alloc(),
+            .remaining = count,
+        };
+
+        uint32_t start = DWT->CYCCNT;
+        for(uint32_t i = 0; i < count; i++) {
+            queues[i] = furi_message_queue_alloc(1, sizeof(uint32_t));
+            furi_event_loop_subscribe_message_queue(
+                data.event_loop,
+                queues[i],
+                FuriEventLoopEventIn,
+                test_furi_event_loop_scaling_callback,
+                &data);
+        }
+        const uint32_t subscribe_cycles = DWT->CYCCNT - start;
+
+        for(uint32_t i = 0; i < count; i++) {
+            furi_check(furi_message_queue_put(queues[i], &i, 0) == FuriStatusOk);
+        }
+
+        start = DWT->CYCCNT;
+        furi_event_loop_run(data.event_loop);
+        const uint32_t dispatch_cycles = DWT->CYCCNT - start;
+
+        mu_assert_int_eq(0, data.remaining);
+
+        start = DWT->CYCCNT;
+        for(uint32_t i = 0; i < count; i++) {
+            furi_event_loop_unsubscribe(data.event_loop, queues[i]);
+        }
+        const uint32_t unsubscribe_cycles = DWT->CYCCNT - start;
+
+        FURI_LOG_I(
+            TAG,
+            "%lu objects, cycles per object: subscribe %lu, dispatch %lu, unsubscribe %lu",
+            count,
+            subscribe_cycles / count,
+            dispatch_cycles / count,
+            unsubscribe_cycles / count);
+
+        for(uint32_t i = 0; i < count; i++) {
+            furi_message_queue_free(queues[i]);
+        }
+        furi_event_loop_free(data.event_loop);
+    }
+
+    free(queues);
+}
@@ -1,3 +1,4 @@
+#include <furi.h>
 #include "../test.h" // IWYU pragma: keep
 #include <stdlib.h>
 #include <string.h>
@@ -37,3 +38,228 @@ void test_furi_memmgr(void) {
     }
     free(ptr);
 }
+
+#define SLAB_TEST_OBJECT_COUNT (96U)
+#define SLAB_TEST_BLOCK_SIZE   (1024U)
+
+static int32_t test_furi_memmgr_slab_thread(void* context) {
+    UNUSED(context);
+
+    // Untraced thread is served from slabs
+    MemmgrSlabStats stats_before, stats;
+    memmgr_slab_get_stats(&stats_before);
+    void* object = memmgr_slab_alloc(16);
+    memmgr_slab_get_stats(&stats);
+    memmgr_slab_free(object);
+    if(stats.object_count <= stats_before.object_count) return 3;
+
+    // Cycle objects through per-thread cache
+    for(size_t i = 0; i < SLAB_TEST_OBJECT_COUNT; i++) {
+        FuriString* string = furi_string_alloc_set_str("slab");
+        void* ptr = memmgr_slab_alloc(i);
+        furi_string_free(string);
+        memmgr_slab_free(ptr);
+    }
+
+    // Big buffer is parked in the cache and handed out again zeroed
+    uint8_t* block = memmgr_slab_alloc(SLAB_TEST_BLOCK_SIZE);
+    memset(block, 0xA5, SLAB_TEST_BLOCK_SIZE);
+    memmgr_slab_free(block);
+    uint8_t* reused = memmgr_slab_alloc(SLAB_TEST_BLOCK_SIZE / 2U);
+    if(reused != block) return 1;
+    for(size_t i = 0; i < SLAB_TEST_BLOCK_SIZE / 2U; i++) {
+        if(reused[i]) return 2;
+    }
+    memmgr_slab_free(reused);
+
+    return 0;
+}
+
+static int32_t test_furi_memmgr_slab_traced_thread(void* context) {
+    // Leak object on purpose, allocation balance must see it
+    *(void**)context = memmgr_slab_alloc(16);
+    return 0;
+}
+
+void test_furi_memmgr_slab(void) {
+    void* ptrs[SLAB_TEST_OBJECT_COUNT];
+    for(size_t i = 0; i < SLAB_TEST_OBJECT_COUNT; i++) {
+        size_t size = (i * 7U) % 300U + 1U;
+        ptrs[i] = memmgr_slab_alloc(size);
+        mu_check(ptrs[i] != NULL);
+        // test that memory is zero-initialized after allocation
+        for(size_t j = 0; j < size; j++) {
+            mu_assert_int_eq(0, ((uint8_t*)ptrs[i])[j]);
+        }
+        memset(ptrs[i], (uint8_t)i, size);
+    }
+
+    MemmgrSlabStats stats;
+    memmgr_slab_get_stats(&stats);
+    mu_check(stats.total_size >= stats.used_size);
+
+    // test that objects do not overlap and survive growth
+    for(size_t i = 0; i < SLAB_TEST_OBJECT_COUNT; i++) {
+        size_t size = (i * 7U) % 300U + 1U;
+        ptrs[i] = memmgr_slab_realloc(ptrs[i], size * 2U);
+        for(size_t j = 0; j < size; j++) {
+            mu_assert_int_eq((uint8_t)i, ((uint8_t*)ptrs[i])[j]);
+        }
+    }
+
+    for(size_t i = 0; i < SLAB_TEST_OBJECT_COUNT; i++) {
+        memmgr_slab_free(ptrs[i]);
+    }
+
+    // heap pointers and NULL are accepted
+    memmgr_slab_free(malloc(16));
+    memmgr_slab_free(NULL);
+    mu_check(memmgr_slab_realloc(memmgr_slab_alloc(8), 0) == NULL);
+
+    FuriThread* thread =
+        furi_thread_alloc_ex("SlabTestWorker", 1024, test_furi_memmgr_slab_thread, NULL);
+    furi_thread_enable_slab_cache(thread);
+    furi_thread_disable_heap_trace(thread);
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+    mu_assert_int_eq(0, furi_thread_get_return_code(thread));
+    furi_thread_free(thread);
+
+    void* leaked = NULL;
+    thread = furi_thread_alloc_ex(
+        "SlabTestTraced", 1024, test_furi_memmgr_slab_traced_thread, &leaked);
+    furi_thread_enable_heap_trace(thread);
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+    mu_check(leaked != NULL);
+    mu_check(furi_thread_get_heap_size(thread) > 0);
+    furi_thread_free(thread);
+    memmgr_slab_free(leaked);
+}
+
+#define ARENA_TEST_CHUNK_SIZE   (1024U)
+#define ARENA_TEST_MAX_SIZE     (4096U)
+#define ARENA_TEST_OBJECT_COUNT (64U)
+
+static int32_t test_furi_memmgr_arena_thread(void* context) {
+    void** survivor = context;
+
+    // Mix of objects freed right away and left for bulk release
+    for(size_t i = 0; i < ARENA_TEST_OBJECT_COUNT; i++) {
+        void* ptr = malloc(i + 1U);
+        memset(ptr, 0x5A, i + 1U);
+        if(i % 2U) free(ptr);
+    }
+
+    // Handed over object must outlive the arena
+    *survivor = strdup("arena");
+
+    return 0;
+}
+
+void test_furi_memmgr_arena(void) {
+    MemmgrArena* arena = memmgr_arena_alloc(ARENA_TEST_CHUNK_SIZE, ARENA_TEST_MAX_SIZE);
+    mu_assert_int_eq(0, memmgr_arena_get_size(arena));
+
+    // direct allocation is zeroed, big objects are left to the heap
+    uint8_t* ptr = memmgr_arena_malloc(arena, 100);
+    mu_check(ptr != NULL);
+    for(int i = 0; i < 100; i++) {
+        mu_assert_int_eq(0, ptr[i]);
+    }
+    mu_check(memmgr_arena_malloc(arena, ARENA_TEST_CHUNK_SIZE) == NULL);
+
+    // reallocation keeps arena object content
+    memset(ptr, 66, 100);
+    ptr = realloc(ptr, 200);
+    for(int i = 0; i < 100; i++) {
+        mu_assert_int_eq(66, ptr[i]);
+    }
+    free(ptr);
+
+    void* survivor = NULL;
+    FuriThread* thread =
+        furi_thread_alloc_ex("ArenaTestWorker", 1024, test_furi_memmgr_arena_thread, &survivor);
+    furi_thread_set_arena(thread, arena);
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    mu_check(memmgr_arena_get_size(arena) <= ARENA_TEST_MAX_SIZE);
+    mu_check(memmgr_arena_get_used(arena) <= memmgr_arena_get_size(arena));
+
+    memmgr_arena_free(arena);
+
+    mu_check(survivor != NULL);
+    mu_assert_string_eq("arena", survivor);
+    free(survivor);
+}
+
+// Bigger than half of the loader arena chunk, always served by the heap
+#define HEAP_STATS_TEST_SIZE (4096U)
+
+void test_furi_memmgr_heap_stats(void) {
+    MemmgrHeapStats stats;
+    memmgr_heap_get_stats(&stats);
+    const uint32_t alloc_count = stats.alloc_count;
+    const uint32_t free_count = stats.free_count;
+
+    memmgr_heap_enable_callsite_trace();
+    void* ptr = malloc(HEAP_STATS_TEST_SIZE);
+    free(ptr);
+    memmgr_heap_disable_callsite_trace();
+
+    memmgr_heap_get_stats(&stats);
+    mu_check(stats.alloc_count > alloc_count);
+    mu_check(stats.free_count > free_count);
+    mu_check(stats.latency_p50 <= stats.latency_p90);
+    mu_check(stats.latency_p90 <= stats.latency_p99);
+    mu_check(stats.latency_p99 <= stats.latency_max);
+    mu_check(stats.max_free_block <= stats.free_size);
+    mu_check(stats.fragmentation <= 100);
+
+    MemmgrHeapCallsite callsites[4];
+    const size_t count = memmgr_heap_get_callsites(callsites, COUNT_OF(callsites));
+    mu_check(count > 0);
+    mu_check(count <= COUNT_OF(callsites));
+    for(size_t i = 0; i < count; i++) {
+        mu_check(callsites[i].count > 0);
+    }
+}
+
+#define POOL_TEST_SIZE (1000U)
+
+void test_furi_memmgr_pool(void) {
+    const size_t pool_free = memmgr_pool_get_free();
+    // Pool is not available in all boot modes
+    if(memmgr_pool_get_max_block() < POOL_TEST_SIZE * 2) return;
+
+    uint8_t* first = memmgr_alloc_from_pool(POOL_TEST_SIZE);
+    uint8_t* second = memmgr_alloc_from_pool(POOL_TEST_SIZE);
+    mu_check(first != NULL);
+    mu_check(second != NULL);
+    mu_check(((uintptr_t)first & 7) == 0);
+    mu_check(((uintptr_t)second & 7) == 0);
+    mu_check(memmgr_pool_get_free() < pool_free);
+
+    for(size_t i = 0; i < POOL_TEST_SIZE; i++) {
+        mu_assert_int_eq(0, first[i]);
+    }
+    memset(first, 0x55, POOL_TEST_SIZE);
+    memset(second, 0xAA, POOL_TEST_SIZE);
+
+    // Freed block is reused and zeroed again
+    free(first);
+    uint8_t* third = memmgr_alloc_from_pool(POOL_TEST_SIZE);
+    mu_check(third == first);
+    for(size_t i = 0; i < POOL_TEST_SIZE; i++) {
+        mu_assert_int_eq(0, third[i]);
+    }
+
+    // Neighbours are merged back into one block
+    const size_t max_block = memmgr_pool_get_max_block();
+    free(second);
+    free(third);
+    mu_assert_int_eq(pool_free, memmgr_pool_get_free());
+    mu_check(memmgr_pool_get_max_block() >= max_block + POOL_TEST_SIZE * 2);
+}
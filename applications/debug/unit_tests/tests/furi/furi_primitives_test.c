@@ -7,9 +7,14 @@
 #define STREAM_BUFFER_SIZE      (32U)
 #define STREAM_BUFFER_TRG_LEVEL (STREAM_BUFFER_SIZE / 2U)
 
+#define SPSC_RING_CAPACITY     (16U)
+#define SPSC_RING_ELEMENT_SIZE (sizeof(uint32_t))
+#define SPSC_RING_CHUNK_SIZE   (5U)
+
 typedef struct {
     FuriMessageQueue* message_queue;
     FuriStreamBuffer* stream_buffer;
+    FuriSpscRing* spsc_ring;
 } TestFuriPrimitivesData;
 
 static void test_furi_message_queue(TestFuriPrimitivesData* data) {
@@ -49,6 +54,32 @@ static void test_furi_message_queue(TestFuriPrimitivesData* data) {
     mu_assert_int_eq(MESSAGE_QUEUE_CAPACITY, furi_message_queue_get_space(message_queue));
 }
 
+static void test_furi_message_queue_many(TestFuriPrimitivesData* data) {
+    FuriMessageQueue* message_queue = data->message_queue;
+    uint32_t values[MESSAGE_QUEUE_CAPACITY + 4];
+
+    for(uint32_t i = 0; i < COUNT_OF(values); ++i) {
+        values[i] = i;
+    }
+
+    // Only what fits goes in
+    mu_assert_int_eq(
+        MESSAGE_QUEUE_CAPACITY,
+        furi_message_queue_put_many(message_queue, values, COUNT_OF(values), 0));
+    mu_assert_int_eq(0, furi_message_queue_get_space(message_queue));
+    mu_assert_int_eq(0, furi_message_queue_put_many(message_queue, values, 1, 1));
+
+    uint32_t read[MESSAGE_QUEUE_CAPACITY + 4] = {0};
+    mu_assert_int_eq(5, furi_message_queue_get_many(message_queue, read, 5, 0));
+    mu_assert_int_eq(
+        MESSAGE_QUEUE_CAPACITY - 5,
+        furi_message_queue_get_many(message_queue, read + 5, COUNT_OF(read) - 5, 0));
+    mu_assert_mem_eq(values, read, MESSAGE_QUEUE_CAPACITY * sizeof(uint32_t));
+
+    mu_assert_int_eq(0, furi_message_queue_get_many(message_queue, read, COUNT_OF(read), 1));
+    mu_assert_int_eq(MESSAGE_QUEUE_CAPACITY, furi_message_queue_get_space(message_queue));
+}
+
 static void test_furi_stream_buffer(TestFuriPrimitivesData* data) {
     FuriStreamBuffer* stream_buffer = data->stream_buffer;
 
@@ -87,17 +118,97 @@ static void test_furi_stream_buffer(TestFuriPrimitivesData* data) {
     }
 }
 
+static void test_furi_spsc_ring(TestFuriPrimitivesData* data) {
+    FuriSpscRing* spsc_ring = data->spsc_ring;
+
+    mu_assert_int_eq(0, furi_spsc_ring_get_count(spsc_ring));
+    mu_assert_int_eq(SPSC_RING_CAPACITY, furi_spsc_ring_get_space(spsc_ring));
+    mu_assert_int_eq(SPSC_RING_CAPACITY, furi_spsc_ring_get_capacity(spsc_ring));
+    mu_assert_int_eq(SPSC_RING_ELEMENT_SIZE, furi_spsc_ring_get_element_size(spsc_ring));
+
+    for(uint32_t i = 0;; ++i) {
+        mu_assert_int_eq(SPSC_RING_CAPACITY - i, furi_spsc_ring_get_space(spsc_ring));
+        mu_assert_int_eq(i, furi_spsc_ring_get_count(spsc_ring));
+
+        if(furi_spsc_ring_push(spsc_ring, &i, 1) != 1) {
+            break;
+        }
+    }
+
+    mu_assert_int_eq(0, furi_spsc_ring_get_space(spsc_ring));
+    mu_assert_int_eq(SPSC_RING_CAPACITY, furi_spsc_ring_get_count(spsc_ring));
+
+    for(uint32_t i = 0;; ++i) {
+        mu_assert_int_eq(i, furi_spsc_ring_get_space(spsc_ring));
+        mu_assert_int_eq(SPSC_RING_CAPACITY - i, furi_spsc_ring_get_count(spsc_ring));
+
+        uint32_t value;
+        if(furi_spsc_ring_pop(spsc_ring, &value, 1) != 1) {
+            break;
+        }
+
+        mu_assert_int_eq(i, value);
+    }
+
+    // Chunks that do not divide capacity exercise wrap around on both sides
+    uint32_t chunk[SPSC_RING_CHUNK_SIZE];
+    uint32_t pushed = 0;
+    uint32_t popped = 0;
+
+    for(size_t round = 0; round < SPSC_RING_CAPACITY * 2U; ++round) {
+        for(size_t i = 0; i < SPSC_RING_CHUNK_SIZE; ++i) {
+            chunk[i] = pushed + i;
+        }
+        pushed += furi_spsc_ring_push(spsc_ring, chunk, SPSC_RING_CHUNK_SIZE);
+
+        size_t count = furi_spsc_ring_pop(spsc_ring, chunk, SPSC_RING_CHUNK_SIZE - 1U);
+        for(size_t i = 0; i < count; ++i) {
+            mu_assert_int_eq(popped + i, chunk[i]);
+        }
+        popped += count;
+
+        mu_assert_int_eq(pushed - popped, furi_spsc_ring_get_count(spsc_ring));
+    }
+
+    furi_spsc_ring_reset(spsc_ring);
+    mu_assert_int_eq(0, furi_spsc_ring_get_count(spsc_ring));
+    mu_assert_int_eq(SPSC_RING_CAPACITY, furi_spsc_ring_get_space(spsc_ring));
+}
+
+static void test_furi_coalesce_tick(void) {
+    // No slack, no change
+    mu_assert_int_eq(1000, furi_kernel_coalesce_tick(1000, 0));
+
+    // Result stays inside window and is aligned
+    for(uint32_t deadline = 990; deadline < 1010; deadline++) {
+        const uint32_t tick = furi_kernel_coalesce_tick(deadline, 31);
+        mu_assert(tick >= deadline && tick <= deadline + 31, "tick out of window");
+        mu_assert_int_eq(0, tick % 16);
+    }
+
+    // Overlapping windows share a tick
+    mu_assert_int_eq(furi_kernel_coalesce_tick(1000, 50), furi_kernel_coalesce_tick(1010, 40));
+
+    // Wraps around with tick counter
+    mu_assert_int_eq(0, furi_kernel_coalesce_tick(UINT32_MAX - 10, 20) % 16);
+}
+
 // This is a stub that needs expanding
 void test_furi_primitives(void) {
     TestFuriPrimitivesData data = {
         .message_queue =
             furi_message_queue_alloc(MESSAGE_QUEUE_CAPACITY, MESSAGE_QUEUE_ELEMENT_SIZE),
         .stream_buffer = furi_stream_buffer_alloc(STREAM_BUFFER_SIZE, STREAM_BUFFER_TRG_LEVEL),
+        .spsc_ring = furi_spsc_ring_alloc(SPSC_RING_CAPACITY, SPSC_RING_ELEMENT_SIZE),
     };
 
     test_furi_message_queue(&data);
+    test_furi_message_queue_many(&data);
     test_furi_stream_buffer(&data);
+    test_furi_spsc_ring(&data);
+    test_furi_coalesce_tick();
 
     furi_message_queue_free(data.message_queue);
     furi_stream_buffer_free(data.stream_buffer);
+    furi_spsc_ring_free(data.spsc_ring);
 }
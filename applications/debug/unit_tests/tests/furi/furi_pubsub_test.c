@@ -43,3 +43,62 @@ void test_furi_pubsub(void) {
     // delete pubsub case
     furi_pubsub_free(test_pubsub);
 }
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    uint32_t received[2];
+    size_t received_count;
+} TestPubSubAsync;
+
+static bool test_pubsub_async_filter(const void* message, void* context) {
+    UNUSED(context);
+    return *(const uint32_t*)message != 0;
+}
+
+static void test_pubsub_async_handler(const void* message, void* context) {
+    TestPubSubAsync* data = context;
+    furi_check(data->received_count < COUNT_OF(data->received));
+
+    data->received[data->received_count++] = *(const uint32_t*)message;
+    if(data->received_count == COUNT_OF(data->received)) {
+        furi_event_loop_stop(data->event_loop);
+    }
+}
+
+void test_furi_pubsub_async(void) {
+    TestPubSubAsync data = {0};
+    data.event_loop = furi_event_loop_alloc();
+    FuriPubSub* test_pubsub = furi_pubsub_alloc();
+
+    FuriPubSubSubscription* test_pubsub_subscription = furi_pubsub_subscribe_async(
+        test_pubsub,
+        data.event_loop,
+        sizeof(uint32_t),
+        COUNT_OF(data.received),
+        test_pubsub_async_filter,
+        test_pubsub_async_handler,
+        &data);
+    mu_assert_pointers_not_eq(test_pubsub_subscription, NULL);
+
+    // Filtered, queued, queued, dropped
+    uint32_t values[] = {0, notify_value_0, notify_value_1, context_value};
+    for(size_t i = 0; i < COUNT_OF(values); i++) {
+        furi_pubsub_publish(test_pubsub, &values[i]);
+    }
+    // Not delivered in publisher context
+    mu_assert_int_eq(0, data.received_count);
+
+    furi_event_loop_run(data.event_loop);
+    mu_assert_int_eq(notify_value_0, data.received[0]);
+    mu_assert_int_eq(notify_value_1, data.received[1]);
+
+    FuriPubSubStats stats;
+    furi_pubsub_get_stats(test_pubsub, test_pubsub_subscription, &stats);
+    mu_assert_int_eq(2, stats.delivered);
+    mu_assert_int_eq(1, stats.filtered);
+    mu_assert_int_eq(1, stats.dropped);
+
+    furi_pubsub_unsubscribe(test_pubsub, test_pubsub_subscription);
+    furi_pubsub_free(test_pubsub);
+    furi_event_loop_free(data.event_loop);
+}
@@ -27,3 +27,33 @@ void test_furi_create_open(void) {
     // Test that record does not exist
     mu_check(furi_record_exists(TEST_RECORD_NAME) == false);
 }
+
+void test_furi_record_handle(void) {
+    FuriRecordHandle* handle = furi_record_get_handle(TEST_RECORD_NAME);
+
+    // Handle alone doesn't make record exist
+    mu_check(furi_record_exists(TEST_RECORD_NAME) == false);
+
+    uint8_t test_data = 0;
+    furi_record_create(TEST_RECORD_NAME, (void*)&test_data);
+    mu_check(furi_record_exists(TEST_RECORD_NAME) == true);
+
+    // Handle and name share holders
+    mu_assert_pointers_eq(furi_record_open_handle(handle), &test_data);
+    mu_assert_pointers_eq(furi_record_open(TEST_RECORD_NAME), &test_data);
+    furi_record_close_handle(handle);
+    mu_check(furi_record_destroy(TEST_RECORD_NAME) == false);
+    furi_record_close(TEST_RECORD_NAME);
+
+    mu_check(furi_record_destroy(TEST_RECORD_NAME) == true);
+    mu_check(furi_record_exists(TEST_RECORD_NAME) == false);
+
+    // Handle survives destroy and sees new record
+    uint8_t test_data_new = 0;
+    furi_record_create(TEST_RECORD_NAME, (void*)&test_data_new);
+    mu_assert_pointers_eq(furi_record_open_handle(handle), &test_data_new);
+    furi_record_close_handle(handle);
+
+    mu_check(furi_record_destroy(TEST_RECORD_NAME) == true);
+    mu_check(furi_record_exists(TEST_RECORD_NAME) == false);
+}
@@ -4,12 +4,20 @@
 
 // v2 tests
 void test_furi_create_open(void);
+void test_furi_record_handle(void);
 void test_furi_concurrent_access(void);
 void test_furi_pubsub(void);
+void test_furi_pubsub_async(void);
 void test_furi_memmgr(void);
+void test_furi_memmgr_slab(void);
+void test_furi_memmgr_arena(void);
+void test_furi_memmgr_heap_stats(void);
+void test_furi_memmgr_pool(void);
 void test_furi_event_loop(void);
+void test_furi_event_loop_scaling(void);
 void test_errno_saving(void);
 void test_furi_primitives(void);
+void test_furi_work_queue(void);
 
 static int foo = 0;
 
@@ -25,25 +33,112 @@ MU_TEST(test_check) {
     mu_check(foo != 6);
 }
 
+MU_TEST(test_boot_trace) {
+    // Firmware boot must have left its stages in the trace
+    const size_t count = furi_boot_trace_get_count();
+    mu_assert(count > 0, "boot trace is empty");
+
+    bool hal_found = false;
+    bool services_found = false;
+    for(size_t i = 0; i < count; i++) {
+        FuriBootTraceRecord record;
+        if(!furi_boot_trace_get(i, &record)) continue;
+
+        hal_found |= strcmp(record.stage, "hal") == 0;
+        services_found |= strcmp(record.stage, "services") == 0;
+    }
+
+    mu_assert(hal_found, "hal stage is missing");
+    mu_assert(services_found, "services stage is missing");
+}
+
+static int32_t test_stack_watermark_thread(void* context) {
+    UNUSED(context);
+    return 0;
+}
+
+static bool test_stack_watermark_find(const char* name, FuriStackWatermarkRecord* record) {
+    const size_t count = furi_stack_watermark_get_count();
+    for(size_t i = 0; i < count; i++) {
+        furi_stack_watermark_get(i, record);
+        if(strcmp(record->name, name) == 0) return true;
+    }
+    return false;
+}
+
+MU_TEST(test_stack_watermark) {
+    // Services are running, sampling must record them
+    furi_stack_watermark_sample();
+    FuriStackWatermarkRecord record;
+    mu_assert(test_stack_watermark_find("CliSrv", &record), "running thread is missing");
+    mu_assert(record.min_free < record.stack_size, "free stack is out of range");
+
+    // Exiting thread records itself
+    FuriThread* thread =
+        furi_thread_alloc_ex("TestStackWatermark", 1024, test_stack_watermark_thread, NULL);
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    mu_assert(test_stack_watermark_find("TestStackWatermark", &record), "thread is missing");
+    mu_assert_int_eq(1024, record.stack_size);
+    mu_assert(record.min_free > 0 && record.min_free < 1024, "free stack is out of range");
+
+    // Only lower values are kept
+    const uint32_t generation = furi_stack_watermark_get_generation();
+    furi_stack_watermark_update("TestStackWatermark", 1024, record.min_free + 1);
+    mu_assert_int_eq(generation, furi_stack_watermark_get_generation());
+    furi_stack_watermark_update("TestStackWatermark", 1024, record.min_free - 1);
+    mu_assert(generation != furi_stack_watermark_get_generation(), "update is lost");
+}
+
 // v2 tests
 MU_TEST(mu_test_furi_create_open) {
     test_furi_create_open();
 }
 
+MU_TEST(mu_test_furi_record_handle) {
+    test_furi_record_handle();
+}
+
 MU_TEST(mu_test_furi_pubsub) {
     test_furi_pubsub();
 }
 
+MU_TEST(mu_test_furi_pubsub_async) {
+    test_furi_pubsub_async();
+}
+
 MU_TEST(mu_test_furi_memmgr) {
     // this test is not accurate, but gives a basic understanding
     // that memory management is working fine
     test_furi_memmgr();
 }
 
+MU_TEST(mu_test_furi_memmgr_slab) {
+    test_furi_memmgr_slab();
+}
+
+MU_TEST(mu_test_furi_memmgr_arena) {
+    test_furi_memmgr_arena();
+}
+
+MU_TEST(mu_test_furi_memmgr_heap_stats) {
+    test_furi_memmgr_heap_stats();
+}
+
+MU_TEST(mu_test_furi_memmgr_pool) {
+    test_furi_memmgr_pool();
+}
+
 MU_TEST(mu_test_furi_event_loop) {
     test_furi_event_loop();
 }
 
+MU_TEST(mu_test_furi_event_loop_scaling) {
+    test_furi_event_loop_scaling();
+}
+
 MU_TEST(mu_test_errno_saving) {
     test_errno_saving();
 }
@@ -52,17 +147,31 @@ MU_TEST(mu_test_furi_primitives) {
     test_furi_primitives();
 }
 
+MU_TEST(mu_test_furi_work_queue) {
+    test_furi_work_queue();
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
     MU_RUN_TEST(test_check);
+    MU_RUN_TEST(test_boot_trace);
+    MU_RUN_TEST(test_stack_watermark);
 
     // v2 tests
     MU_RUN_TEST(mu_test_furi_create_open);
+    MU_RUN_TEST(mu_test_furi_record_handle);
     MU_RUN_TEST(mu_test_furi_pubsub);
+    MU_RUN_TEST(mu_test_furi_pubsub_async);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_memmgr_slab);
+    MU_RUN_TEST(mu_test_furi_memmgr_arena);
+    MU_RUN_TEST(mu_test_furi_memmgr_heap_stats);
+    MU_RUN_TEST(mu_test_furi_memmgr_pool);
     MU_RUN_TEST(mu_test_furi_event_loop);
+    MU_RUN_TEST(mu_test_furi_event_loop_scaling);
     MU_RUN_TEST(mu_test_errno_saving);
     MU_RUN_TEST(mu_test_furi_primitives);
+    MU_RUN_TEST(mu_test_furi_work_queue);
 }
 
 int run_minunit_test_furi(void) {
@@ -0,0 +1,137 @@
+#include "../test.h"
+#include <furi.h>
+
+#define TAG "TestFuriWorkQueue"
+
+#define JOB_COUNT (16UL)
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriWorkQueue* work_queue;
+    FuriThreadId owner_thread;
+    uint32_t job_count;
+    uint32_t done_count;
+    uint32_t cancelled_count;
+    FuriSemaphore* started;
+} TestFuriWorkQueueData;
+
+static void test_furi_work_queue_job(FuriWorkQueueJobId job_id, void* context) {
+    TestFuriWorkQueueData* data = context;
+    furi_check(furi_thread_get_current_id() != data->owner_thread);
+    furi_check(!furi_work_queue_is_cancelled(job_id));
+
+    FURI_CRITICAL_ENTER();
+    data->job_count++;
+    FURI_CRITICAL_EXIT();
+}
+
+static void test_furi_work_queue_long_job(FuriWorkQueueJobId job_id, void* context) {
+    TestFuriWorkQueueData* data = context;
+    furi_check(furi_semaphore_release(data->started) == FuriStatusOk);
+
+    while(!furi_work_queue_is_cancelled(job_id)) {
+        furi_delay_tick(1);
+    }
+}
+
+static void test_furi_work_queue_done(FuriWorkQueueJobId job_id, bool cancelled, void* context) {
+    UNUSED(job_id);
+    TestFuriWorkQueueData* data = context;
+    // Delivered through the event loop, in the owner thread
+    furi_check(furi_thread_get_current_id() == data->owner_thread);
+
+    data->done_count++;
+    if(cancelled) data->cancelled_count++;
+
+    if(data->done_count == JOB_COUNT) {
+        furi_event_loop_stop(data->event_loop);
+    }
+}
+
+static void
+    test_furi_work_queue_cancel_done(FuriWorkQueueJobId job_id, bool cancelled, void* context) {
+    UNUSED(job_id);
+    TestFuriWorkQueueData* data = context;
+    furi_check(furi_thread_get_current_id() == data->owner_thread);
+
+    data->done_count++;
+    if(cancelled) data->cancelled_count++;
+
+    if(data->done_count == 2) {
+        furi_event_loop_stop(data->event_loop);
+    }
+}
+
+static void test_furi_work_queue_setup(TestFuriWorkQueueData* data) {
+    memset(data, 0, sizeof(TestFuriWorkQueueData));
+    data->owner_thread = furi_thread_get_current_id();
+    data->event_loop = furi_event_loop_alloc();
+    data->work_queue = furi_work_queue_alloc(data->event_loop);
+}
+
+static void test_furi_work_queue_teardown(TestFuriWorkQueueData* data) {
+    furi_work_queue_free(data->work_queue);
+    furi_event_loop_free(data->event_loop);
+}
+
+static void test_furi_work_queue_completion(void) {
+    TestFuriWorkQueueData data;
+    test_furi_work_queue_setup(&data);
+
+    for(uint32_t i = 0; i < JOB_COUNT; i++) {
+        FuriWorkQueueJobId id = furi_work_queue_submit(
+            data.work_queue,
+            i % FuriWorkQueuePriorityCount,
+            test_furi_work_queue_job,
+            test_furi_work_queue_done,
+            &data);
+        mu_assert(id != 0, "invalid job id");
+    }
+
+    furi_event_loop_run(data.event_loop);
+
+    mu_assert_int_eq(JOB_COUNT, data.job_count);
+    mu_assert_int_eq(JOB_COUNT, data.done_count);
+    mu_assert_int_eq(0, data.cancelled_count);
+
+    test_furi_work_queue_teardown(&data);
+}
+
+static void test_furi_work_queue_cancellation(void) {
+    TestFuriWorkQueueData data;
+    test_furi_work_queue_setup(&data);
+    data.started = furi_semaphore_alloc(1, 0);
+
+    // Low priority pool has a single thread: first job blocks the second one
+    FuriWorkQueueJobId running = furi_work_queue_submit(
+        data.work_queue,
+        FuriWorkQueuePriorityLow,
+        test_furi_work_queue_long_job,
+        test_furi_work_queue_cancel_done,
+        &data);
+    FuriWorkQueueJobId pending = furi_work_queue_submit(
+        data.work_queue,
+        FuriWorkQueuePriorityLow,
+        test_furi_work_queue_job,
+        test_furi_work_queue_cancel_done,
+        &data);
+    mu_assert(furi_semaphore_acquire(data.started, 1000) == FuriStatusOk, "job not started");
+
+    mu_assert(furi_work_queue_cancel(data.work_queue, pending), "pending job not found");
+    mu_assert(furi_work_queue_cancel(data.work_queue, running), "running job not found");
+
+    furi_event_loop_run(data.event_loop);
+
+    mu_assert_int_eq(0, data.job_count);
+    mu_assert_int_eq(2, data.done_count);
+    mu_assert_int_eq(2, data.cancelled_count);
+    mu_assert(!furi_work_queue_cancel(data.work_queue, running), "finished job found");
+
+    furi_semaphore_free(data.started);
+    test_furi_work_queue_teardown(&data);
+}
+
+void test_furi_work_queue(void) {
+    test_furi_work_queue_completion();
+    test_furi_work_queue_cancellation();
+}
@@ -3,6 +3,7 @@
 #include <furi.h>
 #include <furi_hal.h>
 #include <lp5562_reg.h>
+#include <toolbox/crc32_calc.h>
 #include "../test.h" // IWYU pragma: keep
 
 #define DATA_SIZE             4
@@ -119,6 +120,64 @@ MU_TEST(furi_hal_i2c_int_1b_fail) {
     mu_assert(data_one != 0, "9 invalid data");
 }
 
+typedef struct {
+    FuriSemaphore* done;
+    bool success;
+} FuriHalI2cAsyncTestResult;
+
+static void furi_hal_i2c_async_test_callback(bool success, void* context) {
+    FuriHalI2cAsyncTestResult* result = context;
+    result->success = success;
+    furi_semaphore_release(result->done);
+}
+
+MU_TEST(furi_hal_i2c_int_async) {
+    uint8_t reg = LP5562_CHANNEL_BLUE_CURRENT_REGISTER;
+    uint8_t data[2] = {0};
+    FuriSemaphore* done = furi_semaphore_alloc(2, 0);
+    FuriHalI2cAsyncTestResult results[2] = {{.done = done}, {.done = done}};
+
+    // Register read with RESTART, then the same from a missing device
+    FuriHalI2cTransfer transfers[2];
+    for(size_t i = 0; i < COUNT_OF(transfers); i++) {
+        transfers[i] = (FuriHalI2cTransfer){
+            .address = LP5562_ADDRESS + (i ? 0x10 : 0),
+            .tx_data = &reg,
+            .tx_size = 1,
+            .rx_data = &data[i],
+            .rx_size = 1,
+            .callback = furi_hal_i2c_async_test_callback,
+            .context = &results[i],
+        };
+        furi_hal_i2c_transfer_async(&furi_hal_i2c_handle_power, &transfers[i]);
+    }
+
+    for(size_t i = 0; i < COUNT_OF(transfers); i++) {
+        mu_assert(
+            furi_semaphore_acquire(done, LP5562_I2C_TIMEOUT) == FuriStatusOk, "10 no callback");
+    }
+    furi_semaphore_free(done);
+
+    mu_assert(results[0].success, "10 async read failed");
+    mu_assert(data[0] != 0, "10 invalid data");
+    mu_assert(!results[1].success, "11 async read to missing device succeeded");
+    mu_assert(data[1] == 0, "11 invalid data");
+
+    // Synchronous wrapper reads the same register
+    uint8_t data_sync = 0;
+    FuriHalI2cTransfer transfer = {
+        .address = LP5562_ADDRESS,
+        .tx_data = &reg,
+        .tx_size = 1,
+        .rx_data = &data_sync,
+        .rx_size = 1,
+    };
+    mu_assert(
+        furi_hal_i2c_transfer(&furi_hal_i2c_handle_power, &transfer, LP5562_I2C_TIMEOUT),
+        "12 transfer failed");
+    mu_assert(data_sync == data[0], "12 invalid data");
+}
+
 MU_TEST(furi_hal_i2c_int_ext_3b) {
     bool ret = false;
     uint8_t data_many[DATA_SIZE] = {0};
@@ -220,6 +279,7 @@ MU_TEST_SUITE(furi_hal_i2c_int_suite) {
     MU_RUN_TEST(furi_hal_i2c_int_3b);
     MU_RUN_TEST(furi_hal_i2c_int_ext_3b);
     MU_RUN_TEST(furi_hal_i2c_int_1b_fail);
+    MU_RUN_TEST(furi_hal_i2c_int_async);
 }
 
 MU_TEST_SUITE(furi_hal_i2c_ext_suite) {
@@ -227,9 +287,45 @@ MU_TEST_SUITE(furi_hal_i2c_ext_suite) {
     MU_RUN_TEST(furi_hal_i2c_ext_eeprom);
 }
 
+#define CRC_TEST_DATA_SIZE  (1021U)
+#define CRC_TEST_CHUNK_SIZE (13U)
+
+MU_TEST(furi_hal_crc_crc32) {
+    const char check[] = "123456789";
+
+    mu_assert(furi_hal_crc_acquire(), "CRC unit is busy");
+    mu_assert(!furi_hal_crc_acquire(), "CRC unit acquired twice");
+    mu_assert_int_eq(0xCBF43926, furi_hal_crc_calc_crc32(0, check, strlen(check)));
+    mu_assert_int_eq(
+        0xCBF43926, furi_hal_crc_calc_crc32(furi_hal_crc_calc_crc32(0, check, 5), check + 5, 4));
+    furi_hal_crc_release();
+
+    // Odd size and offset: unaligned words and tail bytes in hardware path
+    uint8_t* data = malloc(CRC_TEST_DATA_SIZE + 1);
+    furi_hal_random_fill_buf(data, CRC_TEST_DATA_SIZE + 1);
+
+    const uint32_t hardware = crc32_calc_buffer(0, data + 1, CRC_TEST_DATA_SIZE);
+
+    // Small chunks are handled by software
+    uint32_t software = 0;
+    for(size_t offset = 0; offset < CRC_TEST_DATA_SIZE; offset += CRC_TEST_CHUNK_SIZE) {
+        software = crc32_calc_buffer(
+            software, data + 1 + offset, MIN(CRC_TEST_CHUNK_SIZE, CRC_TEST_DATA_SIZE - offset));
+    }
+
+    mu_assert_int_eq(hardware, software);
+
+    free(data);
+}
+
+MU_TEST_SUITE(furi_hal_crc_suite) {
+    MU_RUN_TEST(furi_hal_crc_crc32);
+}
+
 int run_minunit_test_furi_hal(void) {
     MU_RUN_SUITE(furi_hal_i2c_int_suite);
     MU_RUN_SUITE(furi_hal_i2c_ext_suite);
+    MU_RUN_SUITE(furi_hal_crc_suite);
     return MU_EXIT_CODE;
 }
 
@@ -1,5 +1,6 @@
 #include <furi.h>
 #include <furi_hal.h>
+#include <mbedtls/ecdsa.h>
 #include "../test.h" // IWYU pragma: keep
 
 static const uint8_t key_ctr_1[32] = {
@@ -465,6 +466,32 @@ MU_TEST(furi_hal_crypto_ctr_5) {
     //mu_assert_mem_eq(tv_ctr_ct_5, ct, sizeof(pt_ctr_5));
 }
 
+#define CRYPTO_BULK_SIZE (1024U)
+
+MU_TEST(furi_hal_crypto_ctr_bulk) {
+    // Large buffers go through DMA, result must match CPU processed test vector
+    uint8_t* pt = malloc(CRYPTO_BULK_SIZE);
+    uint8_t* ct = malloc(CRYPTO_BULK_SIZE);
+    uint8_t* dt = malloc(CRYPTO_BULK_SIZE);
+    memcpy(pt, pt_ctr_3, sizeof(pt_ctr_3));
+    for(size_t i = sizeof(pt_ctr_3); i < CRYPTO_BULK_SIZE; i++) {
+        pt[i] = i;
+    }
+
+    bool ret = furi_hal_crypto_ctr(key_ctr_3, iv_ctr_3, pt, ct, CRYPTO_BULK_SIZE);
+    mu_assert(ret, "CTR bulk encryption failed");
+    mu_assert_mem_eq(tv_ctr_ct_3, ct, sizeof(tv_ctr_ct_3));
+
+    // Odd tail exercises bulk and partial block paths together
+    ret = furi_hal_crypto_ctr(key_ctr_3, iv_ctr_3, ct, dt, CRYPTO_BULK_SIZE - 5);
+    mu_assert(ret, "CTR bulk decryption failed");
+    mu_assert_mem_eq(pt, dt, CRYPTO_BULK_SIZE - 5);
+
+    free(dt);
+    free(ct);
+    free(pt);
+}
+
 MU_TEST(furi_hal_crypto_gcm_1) {
     bool ret = false;
     uint8_t pt[sizeof(pt_gcm_1)];
@@ -577,6 +604,190 @@ MU_TEST(furi_hal_crypto_gcm_4) {
     mu_assert_mem_eq(tv_gcm_tag_4, tag_dec, 16);
 }
 
+MU_TEST(furi_hal_crypto_gcm_bulk) {
+    uint8_t* pt = malloc(CRYPTO_BULK_SIZE);
+    uint8_t* ct = malloc(CRYPTO_BULK_SIZE);
+    uint8_t* dt = malloc(CRYPTO_BULK_SIZE);
+    uint8_t tag_enc[16];
+    const size_t size = CRYPTO_BULK_SIZE - 3;
+    memcpy(pt, pt_gcm_3, sizeof(pt_gcm_3));
+
+    bool ret = furi_hal_crypto_gcm(
+        key_gcm_3, iv_gcm_3, aad_gcm_4, sizeof(aad_gcm_4), pt, ct, size, tag_enc, false);
+    mu_assert(ret, "GCM bulk encryption failed");
+    mu_assert_mem_eq(tv_gcm_ct_3, ct, sizeof(tv_gcm_ct_3));
+
+    FuriHalCryptoGCMState state = furi_hal_crypto_gcm_decrypt_and_verify(
+        key_gcm_3, iv_gcm_3, aad_gcm_4, sizeof(aad_gcm_4), ct, dt, size, tag_enc);
+    mu_assert(state == FuriHalCryptoGCMStateOk, "GCM bulk decryption failed");
+    mu_assert_mem_eq(pt, dt, size);
+
+    free(dt);
+    free(ct);
+    free(pt);
+}
+
+typedef struct {
+    FuriSemaphore* done;
+    bool success;
+} FuriHalCryptoTestAsync;
+
+static void furi_hal_crypto_test_async_callback(bool success, void* context) {
+    FuriHalCryptoTestAsync* async = context;
+    async->success = success;
+    furi_semaphore_release(async->done);
+}
+
+MU_TEST(furi_hal_crypto_cbc_async) {
+    uint8_t* pt = malloc(CRYPTO_BULK_SIZE);
+    uint8_t* ct_sync = malloc(CRYPTO_BULK_SIZE);
+    uint8_t* ct_async = malloc(CRYPTO_BULK_SIZE);
+    uint8_t* dt = malloc(CRYPTO_BULK_SIZE);
+    for(size_t i = 0; i < CRYPTO_BULK_SIZE; i++) {
+        pt[i] = i * 7;
+    }
+
+    // Reference: block by block, never reaches DMA
+    mu_assert(furi_hal_crypto_load_key(key_ctr_1, iv_ctr_1), "Key load failed");
+    for(size_t i = 0; i < CRYPTO_BULK_SIZE; i += 16) {
+        mu_assert(furi_hal_crypto_encrypt(&pt[i], &ct_sync[i], 16), "Encryption failed");
+    }
+    furi_hal_crypto_unload_key();
+
+    FuriHalCryptoTestAsync async = {.done = furi_semaphore_alloc(1, 0)};
+
+    // Two halves, chaining must continue into the second one
+    mu_assert(furi_hal_crypto_load_key(key_ctr_1, iv_ctr_1), "Key load failed");
+    for(size_t i = 0; i < CRYPTO_BULK_SIZE; i += CRYPTO_BULK_SIZE / 2) {
+        mu_assert(
+            furi_hal_crypto_encrypt_async(
+                &pt[i],
+                &ct_async[i],
+                CRYPTO_BULK_SIZE / 2,
+                furi_hal_crypto_test_async_callback,
+                &async),
+            "Async encryption start failed");
+        mu_assert(
+            furi_semaphore_acquire(async.done, 1000) == FuriStatusOk, "Async encryption timeout");
+        mu_assert(async.success, "Async encryption failed");
+    }
+    furi_hal_crypto_unload_key();
+    mu_assert_mem_eq(ct_sync, ct_async, CRYPTO_BULK_SIZE);
+
+    mu_assert(furi_hal_crypto_load_key(key_ctr_1, iv_ctr_1), "Key load failed");
+    mu_assert(
+        furi_hal_crypto_decrypt_async(
+            ct_async, dt, CRYPTO_BULK_SIZE, furi_hal_crypto_test_async_callback, &async),
+        "Async decryption start failed");
+    mu_assert(
+        furi_semaphore_acquire(async.done, 1000) == FuriStatusOk, "Async decryption timeout");
+    mu_assert(async.success, "Async decryption failed");
+    furi_hal_crypto_unload_key();
+    mu_assert_mem_eq(pt, dt, CRYPTO_BULK_SIZE);
+
+    furi_semaphore_free(async.done);
+    free(dt);
+    free(ct_async);
+    free(ct_sync);
+    free(pt);
+}
+
+static int furi_hal_pka_test_random_cb(void* context, uint8_t* dest, size_t size) {
+    UNUSED(context);
+    furi_hal_random_fill_buf(dest, size);
+    return 0;
+}
+
+MU_TEST(furi_hal_pka_ecdsa_sign_p256_verify) {
+    uint8_t key[FURI_HAL_PKA_P256_SIZE];
+    uint8_t hash[FURI_HAL_PKA_P256_SIZE];
+    uint8_t signature[FURI_HAL_PKA_P256_SIZE * 2];
+    furi_hal_random_fill_buf(hash, sizeof(hash));
+
+    mbedtls_ecp_group group;
+    mbedtls_ecp_point q;
+    mbedtls_mpi d, r, s;
+    mbedtls_ecp_group_init(&group);
+    mbedtls_ecp_point_init(&q);
+    mbedtls_mpi_init(&d);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+
+    mu_assert_int_eq(0, mbedtls_ecp_group_load(&group, MBEDTLS_ECP_DP_SECP256R1));
+    mu_assert_int_eq(0, mbedtls_ecp_gen_privkey(&group, &d, furi_hal_pka_test_random_cb, NULL));
+    mu_assert_int_eq(0, mbedtls_mpi_write_binary(&d, key, sizeof(key)));
+    mu_assert_int_eq(
+        0, mbedtls_ecp_mul(&group, &q, &d, &group.G, furi_hal_pka_test_random_cb, NULL));
+
+    mu_assert(furi_hal_pka_ecdsa_sign_p256(key, hash, signature), "PKA sign failed");
+
+    mu_assert_int_eq(0, mbedtls_mpi_read_binary(&r, signature, FURI_HAL_PKA_P256_SIZE));
+    mu_assert_int_eq(
+        0,
+        mbedtls_mpi_read_binary(
+            &s, signature + FURI_HAL_PKA_P256_SIZE, FURI_HAL_PKA_P256_SIZE));
+    mu_assert_int_eq(0, mbedtls_ecdsa_verify(&group, hash, sizeof(hash), &q, &r, &s));
+
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&d);
+    mbedtls_ecp_point_free(&q);
+    mbedtls_ecp_group_free(&group);
+}
+
+MU_TEST(furi_hal_pka_ecdsa_verify_p256_mbedtls_signature) {
+    uint8_t public_key[FURI_HAL_PKA_P256_SIZE * 2 + 1];
+    uint8_t hash[FURI_HAL_PKA_P256_SIZE];
+    uint8_t signature[FURI_HAL_PKA_P256_SIZE * 2];
+    size_t public_key_size;
+    furi_hal_random_fill_buf(hash, sizeof(hash));
+
+    mbedtls_ecp_group group;
+    mbedtls_ecp_point q;
+    mbedtls_mpi d, r, s;
+    mbedtls_ecp_group_init(&group);
+    mbedtls_ecp_point_init(&q);
+    mbedtls_mpi_init(&d);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+
+    mu_assert_int_eq(0, mbedtls_ecp_group_load(&group, MBEDTLS_ECP_DP_SECP256R1));
+    mu_assert_int_eq(0, mbedtls_ecp_gen_privkey(&group, &d, furi_hal_pka_test_random_cb, NULL));
+    mu_assert_int_eq(
+        0, mbedtls_ecp_mul(&group, &q, &d, &group.G, furi_hal_pka_test_random_cb, NULL));
+    mu_assert_int_eq(
+        0,
+        mbedtls_ecp_point_write_binary(
+            &group,
+            &q,
+            MBEDTLS_ECP_PF_UNCOMPRESSED,
+            &public_key_size,
+            public_key,
+            sizeof(public_key)));
+    mu_assert_int_eq(
+        0,
+        mbedtls_ecdsa_sign(
+            &group, &r, &s, &d, hash, sizeof(hash), furi_hal_pka_test_random_cb, NULL));
+    mu_assert_int_eq(0, mbedtls_mpi_write_binary(&r, signature, FURI_HAL_PKA_P256_SIZE));
+    mu_assert_int_eq(
+        0,
+        mbedtls_mpi_write_binary(
+            &s, signature + FURI_HAL_PKA_P256_SIZE, FURI_HAL_PKA_P256_SIZE));
+
+    // Skip uncompressed point prefix
+    mu_assert_int_eq(
+        FuriHalPkaStatusOk, furi_hal_pka_ecdsa_verify_p256(&public_key[1], hash, signature));
+    hash[0] ^= 0x01;
+    mu_assert_int_eq(
+        FuriHalPkaStatusError, furi_hal_pka_ecdsa_verify_p256(&public_key[1], hash, signature));
+
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&d);
+    mbedtls_ecp_point_free(&q);
+    mbedtls_ecp_group_free(&group);
+}
+
 MU_TEST_SUITE(furi_hal_crypto_ctr_test) {
     MU_SUITE_CONFIGURE(&furi_hal_crypto_ctr_setup, &furi_hal_crypto_ctr_teardown);
     MU_RUN_TEST(furi_hal_crypto_ctr_1);
@@ -584,6 +795,8 @@ MU_TEST_SUITE(furi_hal_crypto_ctr_test) {
     MU_RUN_TEST(furi_hal_crypto_ctr_3);
     MU_RUN_TEST(furi_hal_crypto_ctr_4);
     MU_RUN_TEST(furi_hal_crypto_ctr_5);
+    MU_RUN_TEST(furi_hal_crypto_ctr_bulk);
+    MU_RUN_TEST(furi_hal_crypto_cbc_async);
 }
 
 MU_TEST_SUITE(furi_hal_crypto_gcm_test) {
@@ -592,11 +805,18 @@ MU_TEST_SUITE(furi_hal_crypto_gcm_test) {
     MU_RUN_TEST(furi_hal_crypto_gcm_2);
     MU_RUN_TEST(furi_hal_crypto_gcm_3);
     MU_RUN_TEST(furi_hal_crypto_gcm_4);
+    MU_RUN_TEST(furi_hal_crypto_gcm_bulk);
+}
+
+MU_TEST_SUITE(furi_hal_pka_test) {
+    MU_RUN_TEST(furi_hal_pka_ecdsa_sign_p256_verify);
+    MU_RUN_TEST(furi_hal_pka_ecdsa_verify_p256_mbedtls_signature);
 }
 
 int run_minunit_test_furi_hal_crypto(void) {
     MU_RUN_SUITE(furi_hal_crypto_ctr_test);
     MU_RUN_SUITE(furi_hal_crypto_gcm_test);
+    MU_RUN_SUITE(furi_hal_pka_test);
     return MU_EXIT_CODE;
 }
 
@@ -208,6 +208,35 @@ MU_TEST(mu_test_furi_string_appends) {
     mu_assert_string_eq(
         "test!testmoretest 1 two 3 0x04test 4 five 6 0x07", furi_string_get_cstr(string));
 
+    // test integer appends against printf output
+    const int32_t values[] = {0, 7, -7, 10, 99, -100, 4294967, INT32_MAX, INT32_MIN};
+    for(size_t i = 0; i < COUNT_OF(values); i++) {
+        tmp = furi_string_alloc_printf("%ld|%lu", values[i], (uint32_t)values[i]);
+        furi_string_reset(string);
+        furi_string_cat_int32(string, values[i]);
+        furi_string_push_back(string, '|');
+        furi_string_cat_uint32(string, (uint32_t)values[i]);
+        mu_assert_string_eq(furi_string_get_cstr(tmp), furi_string_get_cstr(string));
+        furi_string_free(tmp);
+    }
+
+    // test furi_string_cat_hex, long enough to cross the internal chunk
+    uint8_t data[40];
+    tmp = furi_string_alloc();
+    for(size_t i = 0; i < COUNT_OF(data); i++) {
+        data[i] = (uint8_t)(i * 37U);
+        furi_string_cat_printf(tmp, i ? " %02X" : "%02X", data[i]);
+    }
+    furi_string_set(string, "hex:");
+    furi_string_cat_hex(string, data, COUNT_OF(data), ' ');
+    mu_assert_string_eq(furi_string_get_cstr(tmp), furi_string_get_cstr(string) + 4);
+    furi_string_reset(string);
+    furi_string_cat_hex(string, data, 3, '\0');
+    mu_assert_string_eq("00254A", furi_string_get_cstr(string));
+    furi_string_cat_hex(string, NULL, 0, ' ');
+    mu_assert_string_eq("00254A", furi_string_get_cstr(string));
+    furi_string_free(tmp);
+
     furi_string_free(string);
 }
 
@@ -445,6 +474,29 @@ MU_TEST(mu_test_furi_string_utf8) {
     furi_string_free(utf8_string);
 }
 
+MU_TEST(mu_test_furi_string_storage) {
+    // stack string
+    FURI_STRING_DECLARE(string);
+    mu_check(furi_string_empty(string));
+    furi_string_set(string, "short");
+    mu_assert_string_eq("short", furi_string_get_cstr(string));
+
+    // long content moves to the heap, released on deinit
+    furi_string_cat(string, " string that does not fit into the container");
+    mu_assert_string_eq(
+        "short string that does not fit into the container", furi_string_get_cstr(string));
+    furi_string_deinit(string);
+
+    // arena string
+    MemmgrArena* arena = memmgr_arena_alloc(256, 256);
+    string = furi_string_alloc_arena(arena);
+    mu_check(memmgr_arena_get_used(arena) > 0);
+    furi_string_printf(string, "%d %s", 1, "two");
+    mu_assert_string_eq("1 two", furi_string_get_cstr(string));
+    furi_string_free(string);
+    memmgr_arena_free(arena);
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -460,6 +512,7 @@ MU_TEST_SUITE(test_suite) {
     MU_RUN_TEST(mu_test_furi_string_start_end);
     MU_RUN_TEST(mu_test_furi_string_trim);
     MU_RUN_TEST(mu_test_furi_string_utf8);
+    MU_RUN_TEST(mu_test_furi_string_storage);
 }
 
 int run_minunit_test_furi_string(void) {
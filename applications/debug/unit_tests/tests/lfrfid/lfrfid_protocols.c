@@ -3,6 +3,8 @@
 #include <toolbox/protocols/protocol_dict.h>
 #include <lfrfid/protocols/lfrfid_protocols.h>
 #include <toolbox/pulse_protocols/pulse_glue.h>
+#include <toolbox/manchester_decoder.h>
+#include <bit_lib/bit_lib.h>
 
 #define LF_RFID_READ_TIMING_MULTIPLIER 8
 
@@ -526,6 +528,52 @@ MU_TEST(test_lfrfid_protocol_fdxb_read_simple) {
     protocol_dict_free(dict);
 }
 
+MU_TEST(test_lfrfid_manchester_batch) {
+    // Adjacent half bits of the same level form a long event
+    ManchesterEvent events[EM_TEST_EMULATION_TIMINGS_COUNT + 1];
+    size_t events_count = 0;
+    for(size_t i = 0; i < EM_TEST_EMULATION_TIMINGS_COUNT; events_count++) {
+        const bool level = em_test_timings[i] >= 0;
+        size_t length = 0;
+        while(i < EM_TEST_EMULATION_TIMINGS_COUNT && (em_test_timings[i] >= 0) == level) {
+            length++;
+            i++;
+        }
+        if(length == 1) {
+            events[events_count] = level ? ManchesterEventShortHigh : ManchesterEventShortLow;
+        } else {
+            events[events_count] = level ? ManchesterEventLongHigh : ManchesterEventLongLow;
+        }
+    }
+    events[events_count++] = ManchesterEventReset;
+
+    uint8_t expected[EM_TEST_EMULATION_TIMINGS_COUNT / 8 + 1] = {0};
+    size_t expected_count = 0;
+    ManchesterState state = ManchesterStateMid1;
+    for(size_t i = 0; i < events_count; i++) {
+        bool data;
+        if(manchester_advance(state, events[i], &state, &data)) {
+            bit_lib_set_bit(expected, expected_count++, data);
+        }
+    }
+    mu_assert_int_eq(ManchesterStateMid1, state);
+    mu_assert(expected_count > 0, "no bits decoded");
+
+    // Odd and even lengths use different tails
+    for(size_t split = 0; split < 2; split++) {
+        uint8_t received[sizeof(expected)] = {0};
+        ManchesterState batch_state = ManchesterStateMid1;
+        size_t received_count =
+            manchester_advance_batch(&batch_state, events, split + 1, received, 0);
+        received_count += manchester_advance_batch(
+            &batch_state, events + split + 1, events_count - split - 1, received, received_count);
+
+        mu_assert_int_eq(expected_count, received_count);
+        mu_assert_int_eq(state, batch_state);
+        mu_assert_mem_eq(expected, received, sizeof(expected));
+    }
+}
+
 MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_em_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_em_emulate_simple);
@@ -540,6 +588,8 @@ MU_TEST_SUITE(test_lfrfid_protocols_suite) {
 
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_emulate_simple);
+
+    MU_RUN_TEST(test_lfrfid_manchester_batch);
 }
 
 int run_minunit_test_lfrfid_protocols(void) {
@@ -15,6 +15,12 @@
 #include <nfc/protocols/felica/felica.h>
 #include <nfc/protocols/felica/felica_poller_sync.h>
 #include <nfc/protocols/mf_classic/mf_classic_poller.h>
+#include <nfc/protocols/mf_classic/mf_classic_image.h>
+#include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/iso14443_crc.h>
+#include <nfc/helpers/iso13239_crc.h>
+#include <nfc/helpers/felica_crc.h>
+#include <bit_lib/bit_lib.h>
 #include <nfc/protocols/iso15693_3/iso15693_3_poller.h>
 #include <nfc/protocols/slix/slix.h>
 #include <nfc/protocols/slix/slix_i.h>
@@ -30,11 +36,20 @@
 
 #define TAG "NfcTest"
 
-#define NFC_TEST_NFC_DEV_PATH                  EXT_PATH("unit_tests/nfc/nfc_device_test.nfc")
-#define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_dict.nfc")
+#define NFC_TEST_NFC_DEV_PATH                         EXT_PATH("unit_tests/nfc/nfc_device_test.nfc")
+#define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH        EXT_PATH("unit_tests/mf_dict.nfc")
+#define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_BINARY_PATH EXT_PATH("unit_tests/mf_dict.bin")
 
 #define NFC_TEST_FLAG_WORKER_DONE (1)
 
+#define NFC_TEST_PARITY_FRAME_BYTES (18U)
+#define NFC_TEST_PARITY_FRAME_BITS  (NFC_TEST_PARITY_FRAME_BYTES * 9U)
+
+#define NFC_TEST_CRC_BENCHMARK_SIZE   (256U)
+#define NFC_TEST_CRC_BENCHMARK_ROUNDS (100U)
+
+#define NFC_TEST_CRYPTO1_BENCHMARK_KEYS (10000)
+
 typedef enum {
     NfcTestMfClassicSendFrameTestStateAuth,
     NfcTestMfClassicSendFrameTestStateReadBlock,
@@ -95,6 +110,25 @@ static void nfc_test_save_and_load(NfcDevice* nfc_device_ref) {
         nfc_device_is_equal(nfc_device_ref, nfc_device_dut),
         "nfc_device_data_dut != nfc_device_data_ref\r\n");
 
+    NfcProtocol protocol = NfcProtocolInvalid;
+    uint8_t uid[NFC_DEVICE_UID_MAX_LEN];
+    size_t uid_len = 0;
+    mu_assert(
+        nfc_device_load_info(NFC_TEST_NFC_DEV_PATH, &protocol, uid, &uid_len),
+        "nfc_device_load_info() failed\r\n");
+    mu_assert(
+        protocol == nfc_device_get_protocol(nfc_device_ref),
+        "nfc_device_load_info() protocol mismatch\r\n");
+
+    size_t uid_len_ref = 0;
+    const uint8_t* uid_ref = nfc_device_get_uid(nfc_device_ref, &uid_len_ref);
+    mu_assert(uid_len == uid_len_ref, "nfc_device_load_info() uid length\r\n");
+    mu_assert(memcmp(uid, uid_ref, uid_len) == 0, "nfc_device_load_info() uid\r\n");
+
+    // Unmodified data is not written again
+    mu_assert(
+        nfc_device_save(nfc_device_dut, NFC_TEST_NFC_DEV_PATH), "nfc_device_save() failed\r\n");
+
     mu_assert(
         storage_simply_remove(nfc_test->storage, NFC_TEST_NFC_DEV_PATH),
         "storage_simply_remove() failed\r\n");
@@ -207,6 +241,35 @@ MU_TEST(mf_classic_4k_7b_file_test) {
     nfc_file_test_with_generator(NfcDataGeneratorTypeMfClassic4k_7b);
 }
 
+static void mf_classic_image_test_with_generator(NfcDataGeneratorType type) {
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(type, nfc_device);
+
+    const MfClassicData* mfc_data = nfc_device_get_data(nfc_device, NfcProtocolMfClassic);
+    MfClassicImage* image = mf_classic_image_alloc(mfc_data);
+    mu_assert(mf_classic_image_get_type(image) == mfc_data->type, "image type mismatch");
+
+    const size_t blocks_size =
+        mf_classic_get_total_block_num(mfc_data->type) * sizeof(MfClassicBlock);
+    mu_assert(
+        mf_classic_image_get_size(image) < blocks_size + sizeof(MfClassicData) / 8,
+        "image is not compact");
+
+    MfClassicData* restored = mf_classic_alloc();
+    mf_classic_image_restore(image, restored);
+    mu_assert(mf_classic_is_equal(restored, mfc_data), "restored data mismatch");
+
+    mf_classic_free(restored);
+    mf_classic_image_free(image);
+    nfc_device_free(nfc_device);
+}
+
+MU_TEST(mf_classic_image_test) {
+    mf_classic_image_test_with_generator(NfcDataGeneratorTypeMfClassicMini);
+    mf_classic_image_test_with_generator(NfcDataGeneratorTypeMfClassic1k_4b);
+    mf_classic_image_test_with_generator(NfcDataGeneratorTypeMfClassic4k_7b);
+}
+
 MU_TEST(iso14443_3a_reader) {
     Nfc* poller = nfc_alloc();
     Nfc* listener = nfc_alloc();
@@ -652,6 +715,198 @@ MU_TEST(mf_classic_dict_test) {
         "Remove test dict failed");
 }
 
+MU_TEST(mf_classic_dict_binary_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH);
+    storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_BINARY_PATH);
+
+    const uint32_t test_key_num = 300;
+    MfClassicKey* key_arr_ref = malloc(test_key_num * sizeof(MfClassicKey));
+
+    KeysDict* dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+    mu_assert(dict != NULL, "keys_dict_alloc() failed");
+    for(size_t i = 0; i < test_key_num; i++) {
+        furi_hal_random_fill_buf(key_arr_ref[i].data, sizeof(MfClassicKey));
+        mu_assert(
+            keys_dict_add_key(dict, key_arr_ref[i].data, sizeof(MfClassicKey)), "add key failed");
+    }
+    keys_dict_free(dict);
+
+    mu_assert(
+        keys_dict_binary_update(
+            NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH,
+            NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_BINARY_PATH,
+            sizeof(MfClassicKey)),
+        "keys_dict_binary_update() failed");
+
+    dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_BINARY_PATH,
+        KeysDictModeOpenExisting,
+        sizeof(MfClassicKey));
+    mu_assert(dict != NULL, "keys_dict_alloc() failed");
+    mu_assert(
+        keys_dict_get_total_keys(dict) == test_key_num, "keys_dict_get_total_keys() failed");
+
+    // Iterate twice to check rewind
+    for(size_t pass = 0; pass < 2; pass++) {
+        MfClassicKey key_dut = {};
+        size_t key_idx = 0;
+        while(keys_dict_get_next_key(dict, key_dut.data, sizeof(MfClassicKey))) {
+            mu_assert(key_idx < test_key_num, "Too many keys loaded");
+            mu_assert(
+                memcmp(key_arr_ref[key_idx].data, key_dut.data, sizeof(MfClassicKey)) == 0,
+                "Loaded key data mismatch");
+            key_idx++;
+        }
+        mu_assert(key_idx == test_key_num, "Not all keys loaded");
+        mu_assert(keys_dict_rewind(dict), "keys_dict_rewind() failed");
+    }
+
+    mu_assert(
+        keys_dict_is_key_present(dict, key_arr_ref[test_key_num / 2].data, sizeof(MfClassicKey)),
+        "keys_dict_is_key_present() failed");
+    mu_assert(
+        !keys_dict_add_key(dict, key_arr_ref[0].data, sizeof(MfClassicKey)),
+        "Binary dict must be read only");
+    keys_dict_free(dict);
+
+    // Unchanged source must not cause a rebuild, binary is still valid
+    mu_assert(
+        keys_dict_binary_update(
+            NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH,
+            NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_BINARY_PATH,
+            sizeof(MfClassicKey)),
+        "keys_dict_binary_update() failed");
+
+    // Damaged key data must not open as an empty binary list
+    File* file = storage_file_alloc(storage);
+    mu_assert(
+        storage_file_open(
+            file,
+            NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_BINARY_PATH,
+            FSAM_READ_WRITE,
+            FSOM_OPEN_EXISTING),
+        "Open binary dict failed");
+    uint8_t byte = 0;
+    mu_assert(storage_file_seek(file, storage_file_size(file) - 1, true), "Seek failed");
+    mu_assert(storage_file_read(file, &byte, 1) == 1, "Read failed");
+    byte ^= 0xFF;
+    mu_assert(storage_file_seek(file, storage_file_size(file) - 1, true), "Seek failed");
+    mu_assert(storage_file_write(file, &byte, 1) == 1, "Write failed");
+    storage_file_free(file);
+
+    dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_BINARY_PATH,
+        KeysDictModeOpenExisting,
+        sizeof(MfClassicKey));
+    mu_assert(keys_dict_get_total_keys(dict) == 0, "Damaged binary dict loaded");
+    MfClassicKey key_dut = {};
+    mu_assert(
+        !keys_dict_get_next_key(dict, key_dut.data, sizeof(MfClassicKey)),
+        "Damaged binary dict returned a key");
+    keys_dict_free(dict);
+
+    free(key_arr_ref);
+
+    mu_assert(
+        storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH),
+        "Remove test dict failed");
+    mu_assert(
+        storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_BINARY_PATH),
+        "Remove test binary dict failed");
+    furi_record_close(RECORD_STORAGE);
+}
+
+typedef struct {
+    uint64_t key;
+    uint32_t ks_first; // Keystream while feeding nt ^ cuid
+    uint32_t ks_second; // Keystream of the next word
+    uint32_t nt; // crypto1_decrypt_nt_enc() result
+} NfcTestCrypto1Vector;
+
+static const NfcTestCrypto1Vector nfc_test_crypto1_vectors[] = {
+    {0xFFFFFFFFFFFF, 0xffdf9d36, 0x6f0c2299, 0xa391661c},
+    {0xA0A1A2A3A4A5, 0x1ae30b9c, 0xb8297ca7, 0x0cefcee2},
+    {0x000000000000, 0x38494238, 0xc1e1cd55, 0x6c04390b},
+    {0xD3F7D3F7D3F7, 0xa9729314, 0xe14b53d6, 0xf5f6e8cb},
+};
+
+MU_TEST(crypto1_test) {
+    const uint32_t cuid = 0x7A3B09C4;
+    const uint32_t nt = 0x01200145;
+    const uint32_t nt_enc = 0x5C9E3D2A;
+
+    for(size_t i = 0; i < COUNT_OF(nfc_test_crypto1_vectors); i++) {
+        const NfcTestCrypto1Vector* vector = &nfc_test_crypto1_vectors[i];
+        MfClassicKey key = {};
+        bit_lib_num_to_bytes_be(vector->key, sizeof(MfClassicKey), key.data);
+
+        Crypto1 crypto = {};
+        crypto1_init(&crypto, vector->key);
+        mu_assert(crypto1_word(&crypto, nt ^ cuid, 0) == vector->ks_first, "Wrong keystream");
+        mu_assert(crypto1_word(&crypto, 0, 0) == vector->ks_second, "Wrong keystream");
+        mu_assert(
+            crypto1_decrypt_nt_enc(cuid, nt_enc, key) == vector->nt, "Wrong decrypted nonce");
+    }
+
+    // Word and byte stepping must match bit by bit stepping and rollback
+    for(size_t i = 0; i < 100; i++) {
+        uint64_t key = 0;
+        uint32_t in = 0;
+        furi_hal_random_fill_buf((uint8_t*)&key, sizeof(MfClassicKey));
+        furi_hal_random_fill_buf((uint8_t*)&in, sizeof(in));
+        int is_encrypted = i & 1;
+
+        Crypto1 crypto_word = {};
+        Crypto1 crypto_bit = {};
+        crypto1_init(&crypto_word, key);
+        crypto1_init(&crypto_bit, key);
+
+        uint32_t ks_word = crypto1_word(&crypto_word, in, is_encrypted);
+        uint32_t ks_bit = 0;
+        for(uint8_t bit = 0; bit < 32; bit++) {
+            ks_bit |= (uint32_t)crypto1_bit(&crypto_bit, FURI_BIT(in, bit ^ 24), is_encrypted)
+                      << (bit ^ 24);
+        }
+        mu_assert(ks_word == ks_bit, "Word keystream mismatch");
+        mu_assert(
+            crypto1_byte(&crypto_word, in, is_encrypted) ==
+                crypto1_byte(&crypto_bit, in, is_encrypted),
+            "Byte keystream mismatch");
+        mu_assert(
+            crypto_word.odd == crypto_bit.odd && crypto_word.even == crypto_bit.even,
+            "State mismatch");
+
+        Crypto1 crypto_init = {};
+        crypto1_init(&crypto_init, key);
+        crypto1_init(&crypto_word, key);
+        crypto1_word(&crypto_word, in, is_encrypted);
+        mu_assert(
+            crypto1_lfsr_rollback_word(&crypto_word, in, is_encrypted) == ks_word,
+            "Rollback keystream mismatch");
+        mu_assert(
+            (crypto_word.odd & 0xffffff) == crypto_init.odd && crypto_word.even == crypto_init.even,
+            "Rollback state mismatch");
+    }
+
+    // Nested dictionary attack cost per candidate key
+    MfClassicKey key = {};
+    uint32_t acc = 0;
+    uint32_t start = furi_get_tick();
+    for(uint32_t i = 0; i < NFC_TEST_CRYPTO1_BENCHMARK_KEYS; i++) {
+        bit_lib_num_to_bytes_be(i, sizeof(MfClassicKey), key.data);
+        acc ^= crypto1_decrypt_nt_enc(cuid, nt_enc, key);
+    }
+    uint32_t elapsed = furi_get_tick() - start;
+    FURI_LOG_I(
+        TAG,
+        "Crypto1: %u nt_enc decrypted in %lums, acc %08lx",
+        NFC_TEST_CRYPTO1_BENCHMARK_KEYS,
+        elapsed,
+        acc);
+}
+
 static FelicaError
     felica_do_request_response(FelicaData* felica_data, const FelicaCardKey* card_key) {
     NfcDeviceData* nfc_device = nfc_device_alloc();
@@ -679,6 +934,131 @@ static FelicaError
     return error;
 }
 
+MU_TEST(nfc_bit_buffer_parity_test) {
+    const size_t frame_bytes = NFC_TEST_PARITY_FRAME_BYTES;
+    const size_t frame_bits = NFC_TEST_PARITY_FRAME_BITS;
+    uint8_t raw[(NFC_TEST_PARITY_FRAME_BITS + 7) / 8];
+    furi_hal_random_fill_buf(raw, sizeof(raw));
+    raw[sizeof(raw) - 1] &= (1U << (frame_bits % 8)) - 1;
+
+    BitBuffer* buf = bit_buffer_alloc(frame_bytes);
+    bit_buffer_copy_bytes_with_parity(buf, raw, frame_bits);
+    mu_assert_int_eq(frame_bytes * 8, bit_buffer_get_size(buf));
+
+    // Every 9th bit on the air is the parity of the preceding byte
+    const uint8_t* parity = bit_buffer_get_parity(buf);
+    for(size_t i = 0; i < frame_bytes; i++) {
+        const size_t bit = i * 9;
+        uint8_t byte = 0;
+        for(size_t j = 0; j < 8; j++) {
+            byte |= FURI_BIT(raw[(bit + j) / 8], (bit + j) % 8) << j;
+        }
+        mu_assert_int_eq(byte, bit_buffer_get_byte(buf, i));
+
+        const size_t parity_bit = bit + 8;
+        mu_assert_int_eq(
+            FURI_BIT(raw[parity_bit / 8], parity_bit % 8), FURI_BIT(parity[i / 8], i % 8));
+    }
+
+    uint8_t stream[sizeof(raw)];
+    size_t bits_written = 0;
+    bit_buffer_write_bytes_with_parity(buf, stream, sizeof(stream), &bits_written);
+    mu_assert_int_eq(frame_bits, bits_written);
+    mu_assert_mem_eq(raw, stream, sizeof(raw));
+
+    // Bulk append at an odd offset, then read the same bits back
+    BitBuffer* bits = bit_buffer_alloc(frame_bytes + 1);
+    bit_buffer_reset(bits);
+    bit_buffer_append_bit(bits, true);
+    bit_buffer_append_bits(bits, raw, frame_bits % 64);
+    bit_buffer_append_bit(bits, true);
+    mu_assert_int_eq(frame_bits % 64 + 2, bit_buffer_get_size(bits));
+
+    uint8_t slice[sizeof(raw)];
+    bit_buffer_write_bits_mid(bits, slice, 1, frame_bits % 64);
+    mu_assert_mem_eq(raw, slice, (frame_bits % 64) / 8);
+
+    bit_buffer_free(bits);
+    bit_buffer_free(buf);
+}
+
+static void nfc_test_crc_log_cycles(const char* name, uint32_t cycles) {
+    FURI_LOG_I(
+        TAG,
+        "%-10s %lu cycles/byte",
+        name,
+        cycles / (NFC_TEST_CRC_BENCHMARK_SIZE * NFC_TEST_CRC_BENCHMARK_ROUNDS));
+}
+
+MU_TEST(nfc_crc_test) {
+    // Check values of the respective CRC-16 variants
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    mu_assert_int_eq(0xBF05, iso14443_crc_calculate(Iso14443CrcTypeA, check, sizeof(check)));
+    mu_assert_int_eq(0x906E, iso14443_crc_calculate(Iso14443CrcTypeB, check, sizeof(check)));
+    mu_assert_int_eq(0x906E, iso13239_crc_calculate(Iso13239CrcTypeDefault, check, sizeof(check)));
+    mu_assert_int_eq(0xC331, felica_crc_calculate(check, sizeof(check)));
+
+    // REQA answer of a 4 byte UID tag, CRC_A of 0x00 0x00 is 0xA0 0x1E on the air
+    const uint8_t zeroes[] = {0x00, 0x00};
+    mu_assert_int_eq(0x1EA0, iso14443_crc_calculate(Iso14443CrcTypeA, zeroes, sizeof(zeroes)));
+
+    // Static prefix kept unfinished must give the same result as a whole frame
+    uint8_t* data = malloc(NFC_TEST_CRC_BENCHMARK_SIZE);
+    furi_hal_random_fill_buf(data, NFC_TEST_CRC_BENCHMARK_SIZE);
+    for(size_t split = 0; split <= NFC_TEST_CRC_BENCHMARK_SIZE; split += 17) {
+        const size_t tail = NFC_TEST_CRC_BENCHMARK_SIZE - split;
+
+        uint16_t crc = iso14443_crc_update(iso14443_crc_start(Iso14443CrcTypeB), data, split);
+        crc = iso14443_crc_finish(Iso14443CrcTypeB, iso14443_crc_update(crc, data + split, tail));
+        mu_assert_int_eq(
+            iso14443_crc_calculate(Iso14443CrcTypeB, data, NFC_TEST_CRC_BENCHMARK_SIZE), crc);
+
+        crc = iso13239_crc_update(iso13239_crc_start(Iso13239CrcTypePicopass), data, split);
+        crc = iso13239_crc_finish(
+            Iso13239CrcTypePicopass, iso13239_crc_update(crc, data + split, tail));
+        mu_assert_int_eq(
+            iso13239_crc_calculate(Iso13239CrcTypePicopass, data, NFC_TEST_CRC_BENCHMARK_SIZE),
+            crc);
+
+        crc = felica_crc_update(felica_crc_start(), data, split);
+        crc = felica_crc_finish(felica_crc_update(crc, data + split, tail));
+        mu_assert_int_eq(felica_crc_calculate(data, NFC_TEST_CRC_BENCHMARK_SIZE), crc);
+    }
+
+    // Appended CRC must pass the check
+    BitBuffer* buf = bit_buffer_alloc(NFC_TEST_CRC_BENCHMARK_SIZE + ISO14443_CRC_SIZE);
+    bit_buffer_copy_bytes(buf, data, NFC_TEST_CRC_BENCHMARK_SIZE / 4);
+    iso14443_crc_append(Iso14443CrcTypeA, buf);
+    mu_assert(iso14443_crc_check(Iso14443CrcTypeA, buf), "Wrong CRC_A");
+    bit_buffer_copy_bytes(buf, data, NFC_TEST_CRC_BENCHMARK_SIZE / 4);
+    iso13239_crc_append(Iso13239CrcTypeDefault, buf);
+    mu_assert(iso13239_crc_check(Iso13239CrcTypeDefault, buf), "Wrong ISO13239 CRC");
+    bit_buffer_copy_bytes(buf, data, NFC_TEST_CRC_BENCHMARK_SIZE / 4);
+    felica_crc_append(buf);
+    mu_assert(felica_crc_check(buf), "Wrong FeliCa CRC");
+    bit_buffer_free(buf);
+
+    uint32_t start = DWT->CYCCNT;
+    for(size_t i = 0; i < NFC_TEST_CRC_BENCHMARK_ROUNDS; i++) {
+        iso14443_crc_calculate(Iso14443CrcTypeA, data, NFC_TEST_CRC_BENCHMARK_SIZE);
+    }
+    nfc_test_crc_log_cycles("ISO14443", DWT->CYCCNT - start);
+
+    start = DWT->CYCCNT;
+    for(size_t i = 0; i < NFC_TEST_CRC_BENCHMARK_ROUNDS; i++) {
+        iso13239_crc_calculate(Iso13239CrcTypeDefault, data, NFC_TEST_CRC_BENCHMARK_SIZE);
+    }
+    nfc_test_crc_log_cycles("ISO13239", DWT->CYCCNT - start);
+
+    start = DWT->CYCCNT;
+    for(size_t i = 0; i < NFC_TEST_CRC_BENCHMARK_ROUNDS; i++) {
+        felica_crc_calculate(data, NFC_TEST_CRC_BENCHMARK_SIZE);
+    }
+    nfc_test_crc_log_cycles("FeliCa", DWT->CYCCNT - start);
+
+    free(data);
+}
+
 MU_TEST(felica_read) {
     FelicaData* felica_data = felica_alloc();
     FelicaError error = felica_do_request_response(felica_data, NULL);
@@ -858,12 +1238,17 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_1k_7b_file_test);
     MU_RUN_TEST(mf_classic_4k_4b_file_test);
     MU_RUN_TEST(mf_classic_4k_7b_file_test);
+    MU_RUN_TEST(mf_classic_image_test);
 
     MU_RUN_TEST(mf_classic_reader);
     MU_RUN_TEST(mf_classic_write);
     MU_RUN_TEST(mf_classic_value_block);
     MU_RUN_TEST(mf_classic_send_frame_test);
     MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(mf_classic_dict_binary_test);
+    MU_RUN_TEST(crypto1_test);
+    MU_RUN_TEST(nfc_crc_test);
+    MU_RUN_TEST(nfc_bit_buffer_parity_test);
     MU_RUN_TEST(felica_read);
     MU_RUN_TEST(felica_read_auth);
 
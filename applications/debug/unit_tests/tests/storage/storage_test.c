@@ -1,6 +1,8 @@
 #include "../test.h" // IWYU pragma: keep
 #include <furi.h>
 #include <storage/storage.h>
+#include <toolbox/flash_kv.h>
+#include <toolbox/saved_struct.h>
 
 // DO NOT USE THIS IN PRODUCTION CODE
 // This is a hack to access internal storage functions and definitions
@@ -176,10 +178,180 @@ MU_TEST(storage_file_read_write_64k) {
     furi_record_close(RECORD_STORAGE);
 }
 
+MU_TEST(storage_file_batch_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    const char* path = UNIT_TESTS_PATH("batch.test");
+
+    char head[] = "0123";
+    char tail[] = "456789";
+    const StorageIoVec write_iov[] = {
+        {.buff = head, .size = 4},
+        {.buff = tail, .size = 6},
+    };
+
+    mu_check(storage_file_open(file, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(10, storage_file_writev(file, write_iov, COUNT_OF(write_iov)));
+
+    char data[4] = {0};
+    char rest[8] = {0};
+    StorageFileOp ops[] = {
+        {.type = StorageFileOpTell},
+        {.type = StorageFileOpSize},
+        {.type = StorageFileOpSeek, .offset = 2, .from_start = true},
+        {.type = StorageFileOpRead, .buff = data, .size = 3},
+        {.type = StorageFileOpEof},
+        {.type = StorageFileOpRead, .buff = rest, .size = sizeof(rest)},
+        {.type = StorageFileOpTell},
+    };
+    // Starts at the end of the file, stops at the short read
+    mu_assert_int_eq(5, storage_file_batch(file, ops, COUNT_OF(ops)));
+    mu_assert_int_eq(10, ops[0].result);
+    mu_assert_int_eq(10, ops[1].result);
+    mu_assert_int_eq(3, ops[3].result);
+    mu_assert_string_eq("234", data);
+    mu_check(!ops[4].result);
+    mu_assert_int_eq(5, ops[5].result);
+    mu_assert_int_eq(0, ops[6].result);
+
+    char first[2] = {0};
+    char second[16] = {0};
+    const StorageIoVec read_iov[] = {
+        {.buff = first, .size = 1},
+        {.buff = second, .size = sizeof(second) - 1},
+    };
+    mu_check(storage_file_seek(file, 0, true));
+    mu_assert_int_eq(10, storage_file_readv(file, read_iov, COUNT_OF(read_iov)));
+    mu_assert_string_eq("0", first);
+    mu_assert_string_eq("123456789", second);
+
+    mu_check(storage_file_close(file));
+    mu_check(storage_simply_remove(storage, path));
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_file_preallocate_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    const char* path = UNIT_TESTS_PATH("preallocate.test");
+
+    mu_check(storage_file_open(file, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    mu_check(storage_file_preallocate(file, 64 * 1024));
+    mu_assert_int_eq(0, storage_file_size(file));
+    mu_check(storage_file_eof(file));
+
+    mu_assert_int_eq(10, storage_file_write(file, "0123456789", 10));
+    mu_assert_int_eq(10, storage_file_size(file));
+
+    // Reads stop at the written data
+    char data[16] = {0};
+    mu_check(storage_file_seek(file, 4, true));
+    mu_assert_int_eq(6, storage_file_read(file, data, sizeof(data)));
+    mu_assert_string_eq("456789", data);
+    mu_check(storage_file_eof(file));
+
+    // Preallocating a non-empty file isn't possible
+    mu_check(!storage_file_preallocate(file, 64 * 1024));
+    mu_check(storage_file_close(file));
+
+    FileInfo fileinfo;
+    mu_assert_int_eq(FSE_OK, storage_common_stat(storage, path, &fileinfo));
+    mu_assert_int_eq(10, fileinfo.size);
+    mu_check(storage_simply_remove(storage, path));
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_file_stat_cache_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    const char* path = UNIT_TESTS_PATH("stat_cache.test");
+    FileInfo fileinfo;
+
+    // Negative lookups are cached too
+    storage_common_remove(storage, path);
+    mu_assert_int_eq(FSE_NOT_EXIST, storage_common_stat(storage, path, &fileinfo));
+    mu_assert_int_eq(FSE_NOT_EXIST, storage_common_stat(storage, path, &fileinfo));
+
+    // Cached size follows the file contents after sync and close
+    mu_check(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(FSE_OK, storage_common_stat(storage, path, &fileinfo));
+    mu_assert_int_eq(0, fileinfo.size);
+    mu_assert_int_eq(4, storage_file_write(file, "0123", 4));
+    mu_check(storage_file_sync(file));
+    mu_assert_int_eq(FSE_OK, storage_common_stat(storage, path, &fileinfo));
+    mu_assert_int_eq(4, fileinfo.size);
+    mu_assert_int_eq(4, storage_file_write(file, "4567", 4));
+    mu_check(storage_file_close(file));
+    mu_assert_int_eq(FSE_OK, storage_common_stat(storage, path, &fileinfo));
+    mu_assert_int_eq(8, fileinfo.size);
+
+    // Keys are case insensitive like FAT itself
+    FuriString* upper_path = furi_string_alloc_set(path);
+    furi_string_replace(upper_path, "stat_cache", "STAT_CACHE");
+    mu_check(storage_file_exists(storage, furi_string_get_cstr(upper_path)));
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, furi_string_get_cstr(upper_path)));
+    mu_check(!storage_file_exists(storage, path));
+    furi_string_free(upper_path);
+
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, path));
+    mu_check(storage_dir_exists(storage, path));
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, path));
+    mu_check(!storage_common_exists(storage, path));
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_file_async_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriMessageQueue* queue = furi_message_queue_alloc(4, sizeof(StorageAsyncCompletion));
+    const char* path = UNIT_TESTS_PATH("async.test");
+    StorageAsyncCompletion completion;
+
+    mu_check(storage_file_open(file, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    storage_file_write_async(file, "0123456789", 10, queue, file);
+    mu_assert_int_eq(FuriStatusOk, furi_message_queue_get(queue, &completion, 1000));
+    mu_check(completion.context == file);
+    mu_assert_int_eq(10, completion.size);
+    mu_assert_int_eq(FSE_OK, completion.error);
+
+    // Outstanding requests are processed in order, one after another
+    char first[5] = {0};
+    char second[8] = {0};
+    mu_check(storage_file_seek(file, 0, true));
+    storage_file_read_async(file, first, sizeof(first) - 1, queue, first);
+    storage_file_read_async(file, second, sizeof(second) - 1, queue, second);
+
+    mu_assert_int_eq(FuriStatusOk, furi_message_queue_get(queue, &completion, 1000));
+    mu_check(completion.context == first);
+    mu_assert_int_eq(4, completion.size);
+    mu_assert_int_eq(FuriStatusOk, furi_message_queue_get(queue, &completion, 1000));
+    mu_check(completion.context == second);
+    mu_assert_int_eq(6, completion.size);
+    mu_assert_string_eq("0123", first);
+    mu_assert_string_eq("456789", second);
+
+    mu_check(storage_file_close(file));
+    mu_check(storage_simply_remove(storage, path));
+
+    furi_message_queue_free(queue);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(storage_file) {
     storage_file_open_lock_setup();
     MU_RUN_TEST(storage_file_open_close);
     MU_RUN_TEST(storage_file_open_lock);
+    MU_RUN_TEST(storage_file_batch_test);
+    MU_RUN_TEST(storage_file_preallocate_test);
+    MU_RUN_TEST(storage_file_async_test);
+    MU_RUN_TEST(storage_file_stat_cache_test);
     storage_file_open_lock_teardown();
 }
 
@@ -259,10 +431,75 @@ MU_TEST(storage_dir_exists_test) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static size_t storage_dir_read_many_count(
+    Storage* storage,
+    StorageDirItem* items,
+    size_t skip,
+    const StorageDirFilter* filter) {
+    File* dir = storage_file_alloc(storage);
+    size_t count = 0;
+
+    if(storage_dir_open(dir, STORAGE_TEST_DIR)) {
+        if(storage_dir_read_many(dir, NULL, skip, filter) == skip) {
+            count = storage_dir_read_many(dir, items, 8, filter);
+            if(storage_file_get_error(dir) != FSE_NOT_EXIST) count = SIZE_MAX;
+        }
+    }
+
+    storage_dir_close(dir);
+    storage_file_free(dir);
+    return count;
+}
+
+MU_TEST(storage_dir_read_many_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    StorageDirItem* items = malloc(sizeof(StorageDirItem) * 8);
+
+    storage_simply_remove_recursive(storage, STORAGE_TEST_DIR);
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_TEST_DIR));
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_TEST_DIR "/assets"));
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_TEST_DIR "/sub"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/a.txt", "a"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/b.TXT", "b"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/c.bin", "c"));
+    mu_check(storage_file_create(storage, STORAGE_TEST_DIR "/.hidden.txt", "d"));
+
+    mu_assert_int_eq(6, storage_dir_read_many_count(storage, items, 0, NULL));
+    mu_assert_int_eq(2, storage_dir_read_many_count(storage, items, 4, NULL));
+
+    const StorageDirFilter browser_filter = {
+        .extension = ".txt",
+        .skip_dot_items = true,
+        .skip_dir_name = "assets",
+    };
+    mu_assert_int_eq(3, storage_dir_read_many_count(storage, items, 0, &browser_filter));
+    for(size_t i = 0; i < 3; i++) {
+        const char* name = items[i].name;
+        if(file_info_is_dir(&items[i].fileinfo)) {
+            mu_assert_string_eq("sub", name);
+        } else {
+            mu_check(strcmp(name, "a.txt") == 0 || strcmp(name, "b.TXT") == 0);
+            mu_assert_int_eq(1, items[i].fileinfo.size);
+        }
+    }
+
+    const StorageDirFilter files_filter = {.extension = ".bin|.txt", .skip_dirs = true};
+    mu_assert_int_eq(4, storage_dir_read_many_count(storage, items, 0, &files_filter));
+    mu_assert_int_eq(1, storage_dir_read_many_count(storage, items, 3, &files_filter));
+
+    const StorageDirFilter dirs_filter = {.skip_files = true};
+    mu_assert_int_eq(2, storage_dir_read_many_count(storage, items, 0, &dirs_filter));
+
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_TEST_DIR));
+    free(items);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(storage_dir) {
     MU_RUN_TEST(storage_dir_open_close);
     MU_RUN_TEST(storage_dir_open_lock);
     MU_RUN_TEST(storage_dir_exists_test);
+    MU_RUN_TEST(storage_dir_read_many_test);
 }
 
 static const char* const storage_copy_test_paths[] = {
@@ -412,6 +649,41 @@ MU_TEST(storage_dir_rename) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static bool storage_copy_test_callback(const StorageCopyProgress* progress, void* context) {
+    StorageCopyProgress* last = context;
+    *last = *progress;
+    last->path = NULL;
+    // Cancel while the second file is being copied
+    return progress->files_copied < 1;
+}
+
+MU_TEST(storage_dir_copy_ex) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    const char* old_path = UNIT_TESTS_PATH("copy.old");
+    const char* new_path = UNIT_TESTS_PATH("copy.new");
+    StorageCopyProgress progress = {0};
+
+    storage_dir_create(storage, old_path);
+    mu_assert_int_eq(FSE_OK, storage_common_copy_ex(storage, old_path, new_path, NULL, NULL));
+    mu_check(storage_dir_rename_check(storage, old_path));
+    mu_check(storage_dir_rename_check(storage, new_path));
+    storage_dir_remove(storage, new_path);
+
+    mu_assert_int_eq(
+        FSE_DENIED,
+        storage_common_copy_ex(
+            storage, old_path, new_path, storage_copy_test_callback, &progress));
+    mu_assert_int_eq(1, progress.files_copied);
+    mu_assert_int_eq(4, progress.file_size);
+    mu_assert_int_eq(8, progress.total_copied);
+    // Partially copied file is gone
+    mu_check(!storage_dir_rename_check(storage, new_path));
+
+    storage_dir_remove(storage, new_path);
+    storage_dir_remove(storage, old_path);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST(storage_equiv_and_subdir) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
 
@@ -449,6 +721,7 @@ MU_TEST(storage_equiv_and_subdir) {
 MU_TEST_SUITE(storage_rename) {
     MU_RUN_TEST(storage_file_rename);
     MU_RUN_TEST(storage_dir_rename);
+    MU_RUN_TEST(storage_dir_copy_ex);
     MU_RUN_TEST(storage_equiv_and_subdir);
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -738,6 +1011,143 @@ MU_TEST(test_md5_calc) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#include <lib/toolbox/hash_calc.h>
+
+MU_TEST(test_hash_calc) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    HashCalc* hash_calc = hash_calc_alloc(storage);
+    FuriString* output = furi_string_alloc();
+    FS_Error file_error;
+
+    const char* path = UNIT_TESTS_RESOURCES_PATH("storage/md5.txt");
+
+    mu_check(hash_calc_file_string(hash_calc, path, HashCalcTypeMd5, output, &file_error));
+    mu_assert_int_eq(FSE_OK, file_error);
+    mu_assert_string_eq("2a456fa43e75088fdde41c93159d62a2", furi_string_get_cstr(output));
+
+    // Second request is served from cache with the same result
+    mu_check(hash_calc_file_string(hash_calc, path, HashCalcTypeMd5, output, &file_error));
+    mu_assert_string_eq("2a456fa43e75088fdde41c93159d62a2", furi_string_get_cstr(output));
+
+    mu_check(hash_calc_file_string(hash_calc, path, HashCalcTypeSha256, output, &file_error));
+    mu_assert_string_eq(
+        "699ff8515c9b91197c38f16c7a4716729623639f053f7e861623577748abb8ea",
+        furi_string_get_cstr(output));
+
+    mu_check(!hash_calc_file_string(
+        hash_calc, UNIT_TESTS_PATH("missing.txt"), HashCalcTypeMd5, output, &file_error));
+    mu_assert_int_eq(FSE_NOT_EXIST, file_error);
+
+    furi_string_free(output);
+    hash_calc_free(hash_calc);
+    furi_record_close(RECORD_STORAGE);
+}
+
+#define STORAGE_INDEX_TEST_FILE UNIT_TESTS_PATH("index.test")
+
+MU_TEST(test_storage_index) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    const uint8_t md5[MD5_HASH_SIZE] = {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+    };
+    uint8_t md5_read[MD5_HASH_SIZE];
+    uint32_t timestamp;
+
+    storage_simply_remove(storage, STORAGE_INDEX_TEST_FILE);
+    mu_check(storage_file_create(storage, STORAGE_INDEX_TEST_FILE, "index"));
+    mu_assert_int_eq(
+        FSE_NOT_EXIST, storage_index_get_md5(storage, STORAGE_INDEX_TEST_FILE, md5_read));
+
+    mu_assert_int_eq(
+        FSE_OK, storage_common_timestamp(storage, STORAGE_INDEX_TEST_FILE, &timestamp));
+    mu_assert_int_eq(
+        FSE_OK, storage_index_set_md5(storage, STORAGE_INDEX_TEST_FILE, md5, timestamp));
+    mu_assert_int_eq(FSE_OK, storage_index_get_md5(storage, STORAGE_INDEX_TEST_FILE, md5_read));
+    mu_assert_mem_eq(md5, md5_read, MD5_HASH_SIZE);
+
+    // Opening for writing drops the record
+    File* file = storage_file_alloc(storage);
+    mu_check(storage_file_open(file, STORAGE_INDEX_TEST_FILE, FSAM_WRITE, FSOM_OPEN_APPEND));
+    mu_check(storage_file_close(file));
+    storage_file_free(file);
+    mu_assert_int_eq(
+        FSE_NOT_EXIST, storage_index_get_md5(storage, STORAGE_INDEX_TEST_FILE, md5_read));
+
+    // Digest calculated before the last write is refused
+    mu_assert_int_eq(
+        FSE_OK, storage_common_timestamp(storage, STORAGE_INDEX_TEST_FILE, &timestamp));
+    mu_assert_int_eq(
+        FSE_DENIED, storage_index_set_md5(storage, STORAGE_INDEX_TEST_FILE, md5, timestamp - 1));
+
+    mu_assert_int_eq(
+        FSE_OK, storage_index_set_md5(storage, STORAGE_INDEX_TEST_FILE, md5, timestamp));
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, STORAGE_INDEX_TEST_FILE));
+    mu_assert_int_eq(
+        FSE_NOT_EXIST, storage_index_get_md5(storage, STORAGE_INDEX_TEST_FILE, md5_read));
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+#define FLASH_KV_TEST_KEY INT_PATH(".unit_test_flash_kv")
+
+MU_TEST(test_flash_kv) {
+    const uint8_t value[] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+    const uint8_t value_other[] = {0xde, 0xad, 0xbe, 0xef};
+    uint8_t value_read[sizeof(value)];
+
+    mu_check(flash_kv_remove(FLASH_KV_TEST_KEY));
+    mu_assert_int_eq(0, flash_kv_read(FLASH_KV_TEST_KEY, value_read, sizeof(value_read)));
+
+    mu_check(flash_kv_write(FLASH_KV_TEST_KEY, value, sizeof(value)));
+    // Same value again is not written but still succeeds
+    mu_check(flash_kv_write(FLASH_KV_TEST_KEY, value, sizeof(value)));
+    mu_assert_int_eq(
+        sizeof(value), flash_kv_read(FLASH_KV_TEST_KEY, value_read, sizeof(value_read)));
+    mu_assert_mem_eq(value, value_read, sizeof(value));
+
+    // Short read still reports stored size
+    mu_check(flash_kv_write(FLASH_KV_TEST_KEY, value_other, sizeof(value_other)));
+    mu_assert_int_eq(sizeof(value_other), flash_kv_read(FLASH_KV_TEST_KEY, value_read, 2));
+    mu_assert_mem_eq(value_other, value_read, 2);
+
+    mu_check(flash_kv_remove(FLASH_KV_TEST_KEY));
+    mu_assert_int_eq(0, flash_kv_read(FLASH_KV_TEST_KEY, NULL, 0));
+}
+
+#define SAVED_STRUCT_TEST_FILE UNIT_TESTS_PATH("saved_struct.test")
+
+MU_TEST(test_saved_struct_write_behind) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    const uint32_t value = 0xC0FFEE;
+    const uint32_t value_new = 0xBADC0DE;
+    uint32_t value_read = 0;
+    size_t size = 0;
+
+    storage_simply_remove(storage, SAVED_STRUCT_TEST_FILE);
+    mu_check(saved_struct_save(SAVED_STRUCT_TEST_FILE, &value, sizeof(value), 0x42, 1));
+    mu_check(saved_struct_save(SAVED_STRUCT_TEST_FILE, &value_new, sizeof(value_new), 0x42, 1));
+
+    // Queued save is seen before it is written
+    mu_check(saved_struct_get_metadata(SAVED_STRUCT_TEST_FILE, NULL, NULL, &size));
+    mu_assert_int_eq(sizeof(value_new), size);
+    mu_check(saved_struct_load(SAVED_STRUCT_TEST_FILE, &value_read, sizeof(value_read), 0x42, 1));
+    mu_assert_int_eq(value_new, value_read);
+    mu_check(!saved_struct_load(SAVED_STRUCT_TEST_FILE, &value_read, sizeof(value_read), 0x42, 2));
+
+    // Only the last save reaches the file
+    saved_struct_flush();
+    FileInfo info;
+    mu_assert_int_eq(FSE_OK, storage_common_stat(storage, SAVED_STRUCT_TEST_FILE, &info));
+    mu_assert_int_eq(sizeof(value_new) + 8, info.size);
+    value_read = 0;
+    mu_check(saved_struct_load(SAVED_STRUCT_TEST_FILE, &value_read, sizeof(value_read), 0x42, 1));
+    mu_assert_int_eq(value_new, value_read);
+
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, SAVED_STRUCT_TEST_FILE));
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(test_data_path) {
     MU_RUN_TEST(test_storage_data_path);
     MU_RUN_TEST(test_storage_data_path_apps);
@@ -745,10 +1155,14 @@ MU_TEST_SUITE(test_data_path) {
 
 MU_TEST_SUITE(test_storage_common) {
     MU_RUN_TEST(test_storage_common_migrate);
+    MU_RUN_TEST(test_flash_kv);
+    MU_RUN_TEST(test_saved_struct_write_behind);
 }
 
 MU_TEST_SUITE(test_md5_calc_suite) {
     MU_RUN_TEST(test_md5_calc);
+    MU_RUN_TEST(test_hash_calc);
+    MU_RUN_TEST(test_storage_index);
 }
 
 int run_minunit_test_storage(void) {
@@ -517,12 +517,71 @@ MU_TEST(stream_buffered_large_file_test) {
     furi_string_free(output_data);
 }
 
+MU_TEST(stream_buffered_read_ahead_test) {
+    FuriString* input_data;
+    FuriString* output_data;
+    input_data = furi_string_alloc();
+    output_data = furi_string_alloc();
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    // lines of different length, so they cross cache boundaries at all positions
+    const size_t data_size = 16384;
+    for(size_t i = 0; furi_string_size(input_data) < data_size; ++i) {
+        furi_string_cat_printf(input_data, "%zu: %s\r\n", i, stream_test_data + (i % 7));
+    }
+
+    // cache grows up to 8 KB while the file is read through
+    Stream* stream = buffered_file_stream_alloc_ex(storage, 8192);
+    mu_check(
+        buffered_file_stream_open(stream, FILESTREAM_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(furi_string_size(input_data), stream_write_string(stream, input_data));
+
+    // read the whole file by lines, CR is dropped
+    mu_check(stream_rewind(stream));
+    FuriString* tmp;
+    tmp = furi_string_alloc();
+    while(stream_read_line(stream, tmp)) {
+        furi_string_cat(output_data, tmp);
+    }
+    mu_check(stream_eof(stream));
+    furi_string_replace_all_str(input_data, "\r", "");
+    mu_check(furi_string_equal(input_data, output_data));
+
+    // read in chunks and check the position on the way
+    mu_check(stream_rewind(stream));
+    furi_string_reset(output_data);
+    uint8_t buf[100];
+    size_t was_read;
+    while((was_read = stream_read(stream, buf, sizeof(buf))) > 0) {
+        for(size_t i = 0; i < was_read; i++) {
+            if(buf[i] != '\r') furi_string_push_back(output_data, buf[i]);
+        }
+    }
+    mu_assert_int_eq(stream_size(stream), stream_tell(stream));
+    mu_check(furi_string_equal(input_data, output_data));
+
+    // random access after the cache has grown
+    mu_check(stream_seek(stream, 5, StreamOffsetFromStart));
+    mu_assert_int_eq(5, stream_tell(stream));
+    mu_check(stream_read_line(stream, tmp));
+    mu_check(furi_string_end_with_str(tmp, "\n"));
+
+    furi_string_free(tmp);
+    stream_free(stream);
+
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(input_data);
+    furi_string_free(output_data);
+}
+
 MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_write_read_save_load_test);
     MU_RUN_TEST(stream_composite_test);
     MU_RUN_TEST(stream_split_test);
     MU_RUN_TEST(stream_buffered_write_after_read_test);
     MU_RUN_TEST(stream_buffered_large_file_test);
+    MU_RUN_TEST(stream_buffered_read_ahead_test);
 }
 
 int run_minunit_test_stream(void) {
@@ -4,11 +4,13 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
+#include <lib/subghz/protocols/keeloq_common.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
+#include <lib/subghz/subghz_setting.h>
 
 #define TAG "SubGhzTest"
 
@@ -20,6 +22,11 @@
 #define TEST_RANDOM_COUNT_PARSE 329
 #define TEST_TIMEOUT            10000
 
+#define TEST_BENCHMARK_PULSES_MAX 8192
+
+#define TEST_SETTING_PATH       EXT_PATH(".tmp/unit_tests/subghz_setting")
+#define TEST_SETTING_CACHE_PATH EXT_PATH(".tmp/unit_tests/subghz_setting.cache")
+
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
 //static SubGhzTransmitter* transmitter_handler;
@@ -149,6 +156,36 @@ static bool subghz_decode_random_test(const char* path) {
     }
 }
 
+static size_t subghz_test_load_raw(const char* path, LevelDuration* pulses, size_t pulses_max) {
+    size_t count = 0;
+    uint32_t test_start = furi_get_tick();
+
+    file_worker_encoder_handler = subghz_file_encoder_worker_alloc();
+    if(subghz_file_encoder_worker_start(file_worker_encoder_handler, path, NULL)) {
+        // the worker needs a file in order to open and read part of the file
+        furi_delay_ms(100);
+
+        while((count < pulses_max) && (furi_get_tick() - test_start < TEST_TIMEOUT)) {
+            LevelDuration level_duration =
+                subghz_file_encoder_worker_get_level_duration(file_worker_encoder_handler);
+            if(level_duration_is_reset(level_duration)) {
+                break;
+            } else if(level_duration_is_wait(level_duration)) {
+                // Yield, to load data inside the worker
+                furi_thread_yield();
+            } else {
+                pulses[count++] = level_duration;
+            }
+        }
+        if(subghz_file_encoder_worker_is_running(file_worker_encoder_handler)) {
+            subghz_file_encoder_worker_stop(file_worker_encoder_handler);
+        }
+    }
+    subghz_file_encoder_worker_free(file_worker_encoder_handler);
+
+    return count;
+}
+
 static bool subghz_encoder_test(const char* path) {
     subghz_test_decoder_count = 0;
     uint32_t test_start = furi_get_tick();
@@ -215,6 +252,147 @@ MU_TEST(subghz_keystore_test) {
     mu_assert(
         subghz_environment_load_keystore(environment_handler, KEYSTORE_DIR_NAME),
         "Test keystore error");
+
+    // Name lookup must agree with linear scan: first key in file order wins
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(environment_handler);
+    size_t count = 0;
+    for
+        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
+            const SubGhzKey* found = subghz_keystore_find(keystore, manufacture_code->name);
+            mu_assert(found, "Keystore lookup failed");
+            mu_assert(found <= manufacture_code, "Keystore lookup order error");
+            mu_assert_string_eq(manufacture_code->name, found->name);
+            count++;
+        }
+    mu_assert(count, "Keystore is empty");
+    mu_assert(!subghz_keystore_find(keystore, "Unit Test Missing"), "Keystore lookup error");
+}
+
+MU_TEST(subghz_keeloq_batch_test) {
+    uint64_t keys[KEELOQ_BATCH_SIZE];
+    uint32_t output[KEELOQ_BATCH_SIZE];
+    uint64_t key = 0x0123456789ABCDEFULL;
+    uint32_t data = 0xC0FFEE42;
+
+    // Partial batches must not depend on the unused lanes
+    for(size_t count = 1; count <= KEELOQ_BATCH_SIZE; count += 7) {
+        for(size_t i = 0; i < count; i++) {
+            key = key * 6364136223846793005ULL + 1442695040888963407ULL;
+            keys[i] = key;
+        }
+        data = data * 1103515245U + 12345U;
+
+        subghz_protocol_keeloq_common_decrypt_batch(data, keys, output, count);
+        for(size_t i = 0; i < count; i++) {
+            mu_assert_int_eq(subghz_protocol_keeloq_common_decrypt(data, keys[i]), output[i]);
+            mu_assert_int_eq(data, subghz_protocol_keeloq_common_encrypt(output[i], keys[i]));
+        }
+    }
+}
+
+static bool subghz_setting_test_write(size_t hopper_count) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
+    const uint32_t frequencies[] = {315000000, 433920000};
+    const uint8_t preset_data[] = {0x02, 0x0D, 0x03, 0x07, 0x00, 0x00, 0xC0, 0x00};
+    bool temp_bool = false;
+    bool success = false;
+
+    do {
+        if(!flipper_format_file_open_always(fff_data_file, TEST_SETTING_PATH)) break;
+        if(!flipper_format_write_header_cstr(fff_data_file, "Flipper SubGhz Setting File", 1))
+            break;
+        if(!flipper_format_write_bool(fff_data_file, "Add_standard_frequencies", &temp_bool, 1))
+            break;
+        if(!flipper_format_write_uint32(fff_data_file, "Frequency", &frequencies[0], 1)) break;
+        if(!flipper_format_write_uint32(fff_data_file, "Frequency", &frequencies[1], 1)) break;
+        size_t hopper = 0;
+        for(; hopper < hopper_count; hopper++) {
+            if(!flipper_format_write_uint32(
+                   fff_data_file, "Hopper_frequency", &frequencies[hopper % 2], 1))
+                break;
+        }
+        if(hopper < hopper_count) break;
+        if(!flipper_format_write_uint32(fff_data_file, "Default_frequency", &frequencies[1], 1))
+            break;
+        if(!flipper_format_write_string_cstr(fff_data_file, "Custom_preset_name", "UnitTest"))
+            break;
+        if(!flipper_format_write_hex(
+               fff_data_file, "Custom_preset_data", preset_data, sizeof(preset_data)))
+            break;
+        success = true;
+    } while(false);
+
+    flipper_format_free(fff_data_file);
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+static void subghz_setting_test_compare(SubGhzSetting* expected, SubGhzSetting* actual) {
+    mu_assert_int_eq(
+        subghz_setting_get_frequency_count(expected), subghz_setting_get_frequency_count(actual));
+    for(size_t i = 0; i < subghz_setting_get_frequency_count(expected); i++) {
+        mu_assert_int_eq(
+            subghz_setting_get_frequency(expected, i), subghz_setting_get_frequency(actual, i));
+    }
+    mu_assert_int_eq(
+        subghz_setting_get_hopper_frequency_count(expected),
+        subghz_setting_get_hopper_frequency_count(actual));
+    for(size_t i = 0; i < subghz_setting_get_hopper_frequency_count(expected); i++) {
+        mu_assert_int_eq(
+            subghz_setting_get_hopper_frequency(expected, i),
+            subghz_setting_get_hopper_frequency(actual, i));
+    }
+    mu_assert_int_eq(
+        subghz_setting_get_frequency_default_index(expected),
+        subghz_setting_get_frequency_default_index(actual));
+    mu_assert_int_eq(
+        subghz_setting_get_preset_count(expected), subghz_setting_get_preset_count(actual));
+    for(size_t i = 0; i < subghz_setting_get_preset_count(expected); i++) {
+        mu_assert_string_eq(
+            subghz_setting_get_preset_name(expected, i),
+            subghz_setting_get_preset_name(actual, i));
+        const size_t size = subghz_setting_get_preset_data_size(expected, i);
+        mu_assert_int_eq(size, subghz_setting_get_preset_data_size(actual, i));
+        mu_assert_mem_eq(
+            subghz_setting_get_preset_data(expected, i),
+            subghz_setting_get_preset_data(actual, i),
+            size);
+    }
+}
+
+MU_TEST(subghz_setting_cache_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_common_remove(storage, TEST_SETTING_CACHE_PATH);
+    mu_assert(subghz_setting_test_write(1), "Setting file write error");
+
+    // First load parses the file and stores the cache
+    SubGhzSetting* parsed = subghz_setting_alloc();
+    subghz_setting_load(parsed, TEST_SETTING_PATH);
+    mu_assert(storage_file_exists(storage, TEST_SETTING_CACHE_PATH), "Cache is not written");
+    mu_assert_int_eq(2, subghz_setting_get_frequency_count(parsed));
+    mu_assert_int_eq(433920000, subghz_setting_get_default_frequency(parsed));
+    mu_assert_int_eq(
+        SUBGHZ_SETTING_DEFAULT_PRESET_COUNT + 1, subghz_setting_get_preset_count(parsed));
+
+    // Second load must give the same result from the cache
+    SubGhzSetting* cached = subghz_setting_alloc();
+    subghz_setting_load(cached, TEST_SETTING_PATH);
+    subghz_setting_test_compare(parsed, cached);
+    subghz_setting_free(cached);
+
+    // Changed source invalidates the cache
+    mu_assert(subghz_setting_test_write(2), "Setting file write error");
+    cached = subghz_setting_alloc();
+    subghz_setting_load(cached, TEST_SETTING_PATH);
+    mu_assert_int_eq(2, subghz_setting_get_hopper_frequency_count(cached));
+    mu_assert_int_eq(433920000, subghz_setting_get_hopper_frequency(cached, 1));
+    subghz_setting_free(cached);
+
+    subghz_setting_free(parsed);
+    storage_common_remove(storage, TEST_SETTING_PATH);
+    storage_common_remove(storage, TEST_SETTING_CACHE_PATH);
+    furi_record_close(RECORD_STORAGE);
 }
 
 typedef enum {
@@ -691,6 +869,12 @@ MU_TEST(subghz_encoder_came_twee_test) {
         "Test encoder " SUBGHZ_PROTOCOL_CAME_TWEE_NAME " error\r\n");
 }
 
+MU_TEST(subghz_encoder_hormann_hsm_test) {
+    mu_assert(
+        subghz_encoder_test(EXT_PATH("unit_tests/subghz/hormann_hsm.sub")),
+        "Test encoder " SUBGHZ_PROTOCOL_HORMANN_HSM_NAME " error\r\n");
+}
+
 MU_TEST(subghz_encoder_gate_tx_test) {
     mu_assert(
         subghz_encoder_test(EXT_PATH("unit_tests/subghz/gate_tx.sub")),
@@ -842,6 +1026,8 @@ MU_TEST(subghz_random_test) {
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keeloq_batch_test);
+    MU_RUN_TEST(subghz_setting_cache_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
@@ -891,6 +1077,7 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_princeton_test);
     MU_RUN_TEST(subghz_encoder_came_test);
     MU_RUN_TEST(subghz_encoder_came_twee_test);
+    MU_RUN_TEST(subghz_encoder_hormann_hsm_test);
     MU_RUN_TEST(subghz_encoder_gate_tx_test);
     MU_RUN_TEST(subghz_encoder_nice_flo_test);
     MU_RUN_TEST(subghz_encoder_keeloq_test);
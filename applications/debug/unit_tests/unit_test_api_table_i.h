@@ -8,6 +8,9 @@
 #include <rpc/rpc_i.h>
 #include <flipper.pb.h>
 #include <applications/system/js_app/js_thread.h>
+#include <lib/subghz/subghz_keystore.h>
+#include <lib/subghz/protocols/keeloq_common.h>
+#include <nfc/helpers/felica_crc.h>
 
 static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_alloc, ResourceManifestReader*, (Storage*)),
@@ -38,4 +41,16 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
         JsThread*,
         (const char* script_path, JsThreadCallback callback, void* context)),
     API_METHOD(js_thread_stop, void, (JsThread * worker)),
+    API_METHOD(subghz_keystore_get_data, SubGhzKeyArray_t*, (SubGhzKeystore*)),
+    API_METHOD(subghz_keystore_find, const SubGhzKey*, (SubGhzKeystore*, const char*)),
+    API_METHOD(subghz_protocol_keeloq_common_encrypt, uint32_t, (const uint32_t, const uint64_t)),
+    API_METHOD(subghz_protocol_keeloq_common_decrypt, uint32_t, (const uint32_t, const uint64_t)),
+    API_METHOD(
+        subghz_protocol_keeloq_common_decrypt_batch,
+        void,
+        (const uint32_t, const uint64_t*, uint32_t*, size_t)),
+    API_METHOD(felica_crc_start, uint16_t, ()),
+    API_METHOD(felica_crc_update, uint16_t, (uint16_t, const uint8_t*, size_t)),
+    API_METHOD(felica_crc_finish, uint16_t, (uint16_t)),
+    API_METHOD(felica_crc_calculate, uint16_t, (const uint8_t*, size_t)),
     API_VARIABLE(PB_Main_msg, PB_Main_msg_t)));
@@ -38,6 +38,8 @@
 #define SUBGHZ_DEVICE_CC1101_EXT_ASYNC_TX_BUFFER_HALF \
     (SUBGHZ_DEVICE_CC1101_EXT_ASYNC_TX_BUFFER_FULL / 2)
 #define SUBGHZ_DEVICE_CC1101_EXT_ASYNC_TX_GUARD_TIME (999u >> 1)
+#define SUBGHZ_DEVICE_CC1101_EXT_ASYNC_RX_BUFFER_FULL (256u)
+#define SUBGHZ_DEVICE_CC1101_EXT_ASYNC_RX_BATCH_SIZE  (32u)
 
 /** SubGhz state */
 typedef enum {
@@ -79,6 +81,15 @@ typedef struct {
     uint32_t capture_delta_duration;
     SubGhzDeviceCC1101ExtCaptureCallback capture_callback;
     void* capture_callback_context;
+
+    // DMA capture: TIM17 counter sampled on every G0 edge
+    SubGhzDeviceCC1101ExtCaptureBatchCallback batch_callback;
+    void* batch_callback_context;
+    uint16_t* buffer;
+    size_t read;
+    uint16_t last_stamp;
+    bool level; /**< Level of the pulse the next edge ends */
+    bool edges; /**< Edges seen since the last timer update */
 } SubGhzDeviceCC1101ExtAsyncRx;
 
 typedef struct {
@@ -89,6 +100,7 @@ typedef struct {
     const GpioPin* g0_pin;
     SubGhzDeviceCC1101ExtAsyncTx async_tx;
     SubGhzDeviceCC1101ExtAsyncRx async_rx;
+    CC1101CalibrationCache calibration_cache;
 } SubGhzDeviceCC1101Ext;
 
 static SubGhzDeviceCC1101Ext* subghz_device_cc1101_ext = NULL;
@@ -216,6 +228,7 @@ bool subghz_device_cc1101_ext_alloc(void) {
     subghz_device_cc1101_ext->g0_pin = SUBGHZ_DEVICE_CC1101_EXT_TX_GPIO;
 
     subghz_device_cc1101_ext->async_rx.capture_delta_duration = 0;
+    cc1101_calibration_cache_reset(&subghz_device_cc1101_ext->calibration_cache);
 
     furi_hal_spi_bus_handle_init(subghz_device_cc1101_ext->spi_bus_handle);
     return subghz_device_cc1101_ext_check_init();
@@ -479,14 +492,11 @@ uint32_t subghz_device_cc1101_ext_set_frequency(uint32_t value) {
     }
 
     furi_hal_spi_acquire(subghz_device_cc1101_ext->spi_bus_handle);
-    uint32_t real_frequency =
-        cc1101_set_frequency(subghz_device_cc1101_ext->spi_bus_handle, value);
-    cc1101_calibrate(subghz_device_cc1101_ext->spi_bus_handle);
-
-    while(true) {
-        CC1101Status status = cc1101_get_status(subghz_device_cc1101_ext->spi_bus_handle);
-        if(status.STATE == CC1101StateIDLE) break;
-    }
+    uint32_t real_frequency = cc1101_set_frequency_calibrated(
+        subghz_device_cc1101_ext->spi_bus_handle,
+        &subghz_device_cc1101_ext->calibration_cache,
+        value);
+    furi_check(real_frequency);
 
     furi_hal_spi_release(subghz_device_cc1101_ext->spi_bus_handle);
     return real_frequency;
@@ -566,7 +576,10 @@ void subghz_device_cc1101_ext_start_async_rx(
     LL_TIM_DisableIT_TRIG(TIM17);
 
     furi_hal_gpio_init(
-        subghz_device_cc1101_ext->g0_pin, GpioModeInterruptRiseFall, GpioPullUp, GpioSpeedVeryHigh);
+        subghz_device_cc1101_ext->g0_pin,
+        GpioModeInterruptRiseFall,
+        GpioPullUp,
+        GpioSpeedVeryHigh);
     furi_hal_gpio_remove_int_callback(subghz_device_cc1101_ext->g0_pin);
     furi_hal_gpio_add_int_callback(
         subghz_device_cc1101_ext->g0_pin,
@@ -587,6 +600,150 @@ void subghz_device_cc1101_ext_start_async_rx(
     subghz_device_cc1101_ext->async_rx.capture_delta_duration = 0;
 }
 
+// Turns edge timestamps written by DMA into pulses for the batch callback
+static void subghz_device_cc1101_ext_async_rx_dma_drain(void) {
+    SubGhzDeviceCC1101ExtAsyncRx* rx = &subghz_device_cc1101_ext->async_rx;
+    const size_t size = SUBGHZ_DEVICE_CC1101_EXT_ASYNC_RX_BUFFER_FULL;
+    const size_t write =
+        (size - LL_DMA_GetDataLength(SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_DEF)) % size;
+
+    LevelDuration pulses[SUBGHZ_DEVICE_CC1101_EXT_ASYNC_RX_BATCH_SIZE];
+    size_t count = 0;
+
+    while(rx->read != write) {
+        const uint16_t stamp = rx->buffer[rx->read];
+        rx->read = (rx->read + 1) % size;
+
+        // Timer resolution is 2 us
+        const uint32_t duration = (uint32_t)(uint16_t)(stamp - rx->last_stamp) << 1;
+        rx->last_stamp = stamp;
+        if(duration) {
+            pulses[count++] = level_duration_make(rx->level, duration);
+        }
+        rx->level = !rx->level;
+        rx->edges = true;
+
+        if(count == SUBGHZ_DEVICE_CC1101_EXT_ASYNC_RX_BATCH_SIZE) {
+            rx->batch_callback(pulses, count, rx->batch_callback_context);
+            count = 0;
+        }
+    }
+
+    if(count) {
+        rx->batch_callback(pulses, count, rx->batch_callback_context);
+    }
+}
+
+static void subghz_device_cc1101_ext_async_rx_dma_isr(void* context) {
+    UNUSED(context);
+
+#if SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_CHANNEL == LL_DMA_CHANNEL_3
+    if(LL_DMA_IsActiveFlag_HT3(SUBGHZ_DEVICE_CC1101_EXT_DMA)) {
+        LL_DMA_ClearFlag_HT3(SUBGHZ_DEVICE_CC1101_EXT_DMA);
+    }
+    if(LL_DMA_IsActiveFlag_TC3(SUBGHZ_DEVICE_CC1101_EXT_DMA)) {
+        LL_DMA_ClearFlag_TC3(SUBGHZ_DEVICE_CC1101_EXT_DMA);
+    }
+#else
+#error Update this code. Would you kindly?
+#endif
+
+    subghz_device_cc1101_ext_async_rx_dma_drain();
+}
+
+// Counter wraps every 131 ms: flush partial batches, resync the level when quiet
+static void subghz_device_cc1101_ext_async_rx_timer_isr(void* context) {
+    UNUSED(context);
+    SubGhzDeviceCC1101ExtAsyncRx* rx = &subghz_device_cc1101_ext->async_rx;
+
+    if(LL_TIM_IsActiveFlag_UPDATE(TIM17)) {
+        LL_TIM_ClearFlag_UPDATE(TIM17);
+        subghz_device_cc1101_ext_async_rx_dma_drain();
+        if(!rx->edges) {
+            rx->level = furi_hal_gpio_read(subghz_device_cc1101_ext->g0_pin);
+        }
+        rx->edges = false;
+    }
+}
+
+void subghz_device_cc1101_ext_start_async_rx_batch(
+    SubGhzDeviceCC1101ExtCaptureBatchCallback callback,
+    void* context) {
+    furi_check(callback);
+    furi_assert(subghz_device_cc1101_ext->state == SubGhzDeviceCC1101ExtStateIdle);
+    subghz_device_cc1101_ext->state = SubGhzDeviceCC1101ExtStateAsyncRx;
+
+    SubGhzDeviceCC1101ExtAsyncRx* rx = &subghz_device_cc1101_ext->async_rx;
+    rx->batch_callback = callback;
+    rx->batch_callback_context = context;
+    rx->buffer = malloc(SUBGHZ_DEVICE_CC1101_EXT_ASYNC_RX_BUFFER_FULL * sizeof(uint16_t));
+    rx->read = 0;
+    rx->last_stamp = 0;
+    rx->edges = false;
+
+    furi_hal_bus_enable(FuriHalBusTIM17);
+
+    // Configure TIM
+    //Set the timer resolution to 2 us
+    LL_TIM_SetPrescaler(TIM17, (64 << 1) - 1);
+    LL_TIM_SetCounterMode(TIM17, LL_TIM_COUNTERMODE_UP);
+    LL_TIM_SetAutoReload(TIM17, 0xFFFF);
+    LL_TIM_SetClockDivision(TIM17, LL_TIM_CLOCKDIVISION_DIV1);
+
+    // Timer: advanced
+    LL_TIM_SetClockSource(TIM17, LL_TIM_CLOCKSOURCE_INTERNAL);
+    LL_TIM_DisableARRPreload(TIM17);
+    LL_TIM_DisableDMAReq_TRIG(TIM17);
+    LL_TIM_DisableIT_TRIG(TIM17);
+
+    /* We need the EXTI to be configured as interrupt generating line, but no ISR registered */
+    furi_hal_gpio_init(
+        subghz_device_cc1101_ext->g0_pin,
+        GpioModeInterruptRiseFall,
+        GpioPullUp,
+        GpioSpeedVeryHigh);
+    furi_hal_gpio_remove_int_callback(subghz_device_cc1101_ext->g0_pin);
+    furi_hal_gpio_enable_int_callback(subghz_device_cc1101_ext->g0_pin);
+
+    // Every G0 edge makes DMA copy the counter, EXTI lines 0-15 map to signal IDs 0-15
+    LL_DMAMUX_SetRequestSignalID(
+        DMAMUX1,
+        LL_DMAMUX_REQ_GEN_0,
+        LL_DMAMUX_REQ_GEN_EXTI_LINE0 + __builtin_ctz(subghz_device_cc1101_ext->g0_pin->pin));
+    LL_DMAMUX_SetRequestGenPolarity(DMAMUX1, LL_DMAMUX_REQ_GEN_0, LL_DMAMUX_REQ_GEN_POL_RISING);
+    LL_DMAMUX_SetGenRequestNb(DMAMUX1, LL_DMAMUX_REQ_GEN_0, 1);
+
+    LL_DMA_SetMemoryAddress(SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_DEF, (uint32_t)rx->buffer);
+    LL_DMA_SetPeriphAddress(SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_DEF, (uint32_t) & (TIM17->CNT));
+    LL_DMA_ConfigTransfer(
+        SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_DEF,
+        LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_MODE_CIRCULAR | LL_DMA_PERIPH_NOINCREMENT |
+            LL_DMA_MEMORY_INCREMENT | LL_DMA_PDATAALIGN_HALFWORD | LL_DMA_MDATAALIGN_HALFWORD |
+            LL_DMA_PRIORITY_VERYHIGH);
+    LL_DMA_SetDataLength(
+        SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_DEF, SUBGHZ_DEVICE_CC1101_EXT_ASYNC_RX_BUFFER_FULL);
+    LL_DMA_SetPeriphRequest(SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_DEF, LL_DMAMUX_REQ_GENERATOR0);
+
+    furi_hal_interrupt_set_isr(
+        SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_IRQ, subghz_device_cc1101_ext_async_rx_dma_isr, NULL);
+    LL_DMA_EnableIT_TC(SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_DEF);
+    LL_DMA_EnableIT_HT(SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_DEF);
+    LL_DMA_EnableChannel(SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_DEF);
+
+    furi_hal_interrupt_set_isr(
+        FuriHalInterruptIdTim1TrgComTim17, subghz_device_cc1101_ext_async_rx_timer_isr, NULL);
+    LL_TIM_EnableIT_UPDATE(TIM17);
+
+    // Switch to RX
+    subghz_device_cc1101_ext_rx();
+
+    // Start timer
+    rx->level = furi_hal_gpio_read(subghz_device_cc1101_ext->g0_pin);
+    LL_TIM_SetCounter(TIM17, 0);
+    LL_TIM_EnableCounter(TIM17);
+    LL_DMAMUX_EnableRequestGen(DMAMUX1, LL_DMAMUX_REQ_GEN_0);
+}
+
 void subghz_device_cc1101_ext_stop_async_rx(void) {
     furi_assert(subghz_device_cc1101_ext->state == SubGhzDeviceCC1101ExtStateAsyncRx);
     subghz_device_cc1101_ext->state = SubGhzDeviceCC1101ExtStateIdle;
@@ -603,6 +760,16 @@ void subghz_device_cc1101_ext_stop_async_rx(void) {
     FURI_CRITICAL_EXIT();
     furi_hal_gpio_remove_int_callback(subghz_device_cc1101_ext->g0_pin);
     furi_hal_gpio_init(subghz_device_cc1101_ext->g0_pin, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
+
+    // Deinitialize DMA capture, edges not reported yet are dropped
+    if(subghz_device_cc1101_ext->async_rx.buffer) {
+        LL_DMAMUX_DisableRequestGen(DMAMUX1, LL_DMAMUX_REQ_GEN_0);
+        LL_DMA_DeInit(SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_DEF);
+        furi_hal_interrupt_set_isr(SUBGHZ_DEVICE_CC1101_EXT_DMA_CH3_IRQ, NULL, NULL);
+        furi_hal_interrupt_set_isr(FuriHalInterruptIdTim1TrgComTim17, NULL, NULL);
+        free(subghz_device_cc1101_ext->async_rx.buffer);
+        subghz_device_cc1101_ext->async_rx.buffer = NULL;
+    }
 }
 
 void subghz_device_cc1101_ext_async_tx_middleware_idle(
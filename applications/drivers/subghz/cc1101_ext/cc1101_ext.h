@@ -172,6 +172,26 @@ void subghz_device_cc1101_ext_start_async_rx(
     SubGhzDeviceCC1101ExtCaptureCallback callback,
     void* context);
 
+/** Signal Timings Capture batch callback, called from interrupt */
+typedef void (*SubGhzDeviceCC1101ExtCaptureBatchCallback)(
+    const LevelDuration* pulses,
+    size_t count,
+    void* context);
+
+/** Enable signal timings capture with DMA
+ *
+ * Every G0 edge makes DMA copy the TIM17 counter into a ring buffer, so edge
+ * timing doesn't depend on interrupt latency. Pulses are delivered at half
+ * and full transfer, and on every counter wrap (131 ms). The async mirror pin
+ * is not driven in this mode. Stop with subghz_device_cc1101_ext_stop_async_rx.
+ *
+ * @param      callback  SubGhzDeviceCC1101ExtCaptureBatchCallback
+ * @param      context   callback context
+ */
+void subghz_device_cc1101_ext_start_async_rx_batch(
+    SubGhzDeviceCC1101ExtCaptureBatchCallback callback,
+    void* context);
+
 /** Disable signal timings capture Resets GPIO and TIM2
  */
 void subghz_device_cc1101_ext_stop_async_rx(void);
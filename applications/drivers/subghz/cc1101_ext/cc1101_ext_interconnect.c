@@ -27,6 +27,12 @@ static void subghz_device_cc1101_ext_interconnect_start_async_rx(void* callback,
         (SubGhzDeviceCC1101ExtCaptureCallback)callback, context);
 }
 
+static void
+    subghz_device_cc1101_ext_interconnect_start_async_rx_batch(void* callback, void* context) {
+    subghz_device_cc1101_ext_start_async_rx_batch(
+        (SubGhzDeviceCC1101ExtCaptureBatchCallback)callback, context);
+}
+
 static void subghz_device_cc1101_ext_interconnect_load_preset(
     FuriHalSubGhzPreset preset,
     uint8_t* preset_data) {
@@ -92,6 +98,8 @@ const SubGhzDeviceInterconnect subghz_device_cc1101_ext_interconnect = {
     .is_rx_data_crc_valid = subghz_device_cc1101_ext_is_rx_data_crc_valid,
     .read_packet = subghz_device_cc1101_ext_read_packet,
     .write_packet = subghz_device_cc1101_ext_write_packet,
+
+    .start_async_rx_batch = subghz_device_cc1101_ext_interconnect_start_async_rx_batch,
 };
 
 const SubGhzDevice subghz_device_cc1101_ext = {
@@ -395,16 +395,6 @@ void archive_add_app_item(ArchiveBrowserView* browser, const char* name) {
     ArchiveFile_t_clear(&item);
 }
 
-static bool archive_get_fap_meta(FuriString* file_path, FuriString* fap_name, uint8_t** icon_ptr) {
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    bool success = false;
-    if(flipper_application_load_name_and_icon(file_path, storage, icon_ptr, fap_name)) {
-        success = true;
-    }
-    furi_record_close(RECORD_STORAGE);
-    return success;
-}
-
 void archive_add_file_item(ArchiveBrowserView* browser, bool is_folder, const char* name) {
     furi_assert(browser);
     furi_assert(name);
@@ -416,7 +406,8 @@ void archive_add_file_item(ArchiveBrowserView* browser, bool is_folder, const ch
     archive_set_file_type(&item, furi_string_get_cstr(browser->path), is_folder, false);
     if(item.type == ArchiveFileTypeApplication) {
         item.custom_icon_data = malloc(FAP_MANIFEST_MAX_ICON_SIZE);
-        if(!archive_get_fap_meta(item.path, item.custom_name, &item.custom_icon_data)) {
+        if(!flipper_application_catalog_load_name_and_icon(
+               browser->catalog, item.path, &item.custom_icon_data, item.custom_name)) {
             free(item.custom_icon_data);
             item.custom_icon_data = NULL;
         }
@@ -197,6 +197,14 @@ bool archive_scene_browser_on_event(void* context, SceneManagerEvent event) {
             archive_file_array_load(archive->browser, 1);
             consumed = true;
             break;
+        case ArchiveBrowserEventItemHighlight:
+            if(selected && selected->type == ArchiveFileTypeApplication) {
+                loader_preload_hint(archive->loader, furi_string_get_cstr(selected->path));
+            } else {
+                loader_preload_hint(archive->loader, NULL);
+            }
+            consumed = true;
+            break;
         case ArchiveBrowserEventListRefresh:
             if(!favorites) {
                 archive_refresh_dir(browser);
@@ -216,6 +224,7 @@ bool archive_scene_browser_on_event(void* context, SceneManagerEvent event) {
                     archive->loader_stop_subscription = NULL;
                 }
 
+                loader_preload_hint(archive->loader, NULL);
                 view_dispatcher_stop(archive->view_dispatcher);
             }
             consumed = true;
@@ -230,6 +239,7 @@ bool archive_scene_browser_on_event(void* context, SceneManagerEvent event) {
 
 void archive_scene_browser_on_exit(void* context) {
     ArchiveApp* archive = (ArchiveApp*)context;
+    loader_preload_hint(archive->loader, NULL);
     if(archive->loader_stop_subscription) {
         furi_pubsub_unsubscribe(
             loader_get_pubsub(archive->loader), archive->loader_stop_subscription);
@@ -9,6 +9,7 @@
 #include <gui/elements.h>
 #include <gui/modules/file_browser_worker.h>
 #include <storage/storage.h>
+#include <flipper_application/application_catalog.h>
 #include <furi.h>
 
 #define MAX_LEN_PX   110
@@ -50,6 +51,7 @@ typedef enum {
 
     ArchiveBrowserEventLoadPrevItems,
     ArchiveBrowserEventLoadNextItems,
+    ArchiveBrowserEventItemHighlight,
 
     ArchiveBrowserEventListRefresh,
 
@@ -83,6 +85,7 @@ struct ArchiveBrowserView {
     InputKey last_tab_switch_dir;
     bool is_root;
     FuriTimer* scroll_timer;
+    FlipperApplicationCatalog* catalog;
 };
 
 typedef struct {
@@ -13,9 +13,15 @@
 
 #define WORKER_TAG TAG "Worker"
 
+#define BAD_USB_CODE_DIR  EXT_PATH(".tmp")
+#define BAD_USB_CODE_PATH BAD_USB_CODE_DIR "/bad_usb.code"
+
 #define BADUSB_ASCII_TO_KEY(script, x) \
     (((uint8_t)x < 128) ? (script->layout[(uint8_t)x]) : HID_KEYBOARD_NONE)
 
+// Keys handed to HID layer at once in turbo mode
+#define DUCKY_TURBO_CHUNK_LEN 32
+
 typedef enum {
     WorkerEvtStartStop = (1 << 0),
     WorkerEvtPauseResume = (1 << 1),
@@ -51,16 +57,21 @@ bool ducky_is_line_end(const char chr) {
     return (chr == ' ') || (chr == '\0') || (chr == '\r') || (chr == '\n');
 }
 
-uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept_chars) {
+void ducky_compile_keycode(const char* param, DuckyInstruction* instruction) {
     uint16_t keycode = ducky_get_keycode_by_name(param);
     if(keycode != HID_KEYBOARD_NONE) {
-        return keycode;
+        instruction->key |= keycode;
+    } else {
+        instruction->key_char = param[0];
     }
+}
 
-    if((accept_chars) && (strlen(param) > 0)) {
-        return BADUSB_ASCII_TO_KEY(bad_usb, param[0]) & 0xFF;
+uint16_t ducky_resolve_keycode(BadUsbScript* bad_usb, const DuckyInstruction* instruction) {
+    uint16_t keycode = instruction->key;
+    if(instruction->key_char != '\0') {
+        keycode |= BADUSB_ASCII_TO_KEY(bad_usb, instruction->key_char) & 0xFF;
     }
-    return 0;
+    return keycode;
 }
 
 bool ducky_get_number(const char* param, uint32_t* val) {
@@ -135,9 +146,35 @@ int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...) {
     return SCRIPT_STATE_ERROR;
 }
 
+static void ducky_string_turbo(BadUsbScript* bad_usb, const char* param) {
+    uint16_t keycodes[DUCKY_TURBO_CHUNK_LEN];
+    size_t count = 0;
+
+    for(uint32_t i = 0; param[i] != '\0'; i++) {
+        uint16_t keycode = (param[i] == '\n') ? HID_KEYBOARD_RETURN :
+                                                 BADUSB_ASCII_TO_KEY(bad_usb, param[i]);
+        if(keycode != HID_KEYBOARD_NONE) {
+            keycodes[count++] = keycode;
+        }
+        if(count == COUNT_OF(keycodes)) {
+            bad_usb->hid->kb_type(bad_usb->hid_inst, keycodes, count);
+            count = 0;
+        }
+    }
+    if(count > 0) {
+        bad_usb->hid->kb_type(bad_usb->hid_inst, keycodes, count);
+    }
+}
+
 bool ducky_string(BadUsbScript* bad_usb, const char* param) {
     uint32_t i = 0;
 
+    if(bad_usb->turbo) {
+        ducky_string_turbo(bad_usb, param);
+        bad_usb->stringdelay = 0;
+        return true;
+    }
+
     while(param[i] != '\0') {
         if(param[i] != '\n') {
             uint16_t keycode = BADUSB_ASCII_TO_KEY(bad_usb, param[i]);
@@ -178,36 +215,108 @@ static bool ducky_string_next(BadUsbScript* bad_usb) {
     return false;
 }
 
-static int32_t ducky_parse_line(BadUsbScript* bad_usb, FuriString* line) {
+static int32_t
+    ducky_compile_line(BadUsbScript* bad_usb, FuriString* line, DuckyInstruction* instruction) {
     uint32_t line_len = furi_string_size(line);
     const char* line_tmp = furi_string_get_cstr(line);
 
+    instruction->op = DuckyOpEmpty;
+    instruction->key_char = '\0';
+    instruction->key = HID_KEYBOARD_NONE;
+    instruction->value = 0;
+    furi_string_reset(instruction->text);
+
     if(line_len == 0) {
-        return SCRIPT_STATE_NEXT_LINE; // Skip empty lines
+        return 0; // Empty lines are skipped on execution
     }
-    FURI_LOG_D(WORKER_TAG, "line:%s", line_tmp);
 
     // Ducky Lang Functions
-    int32_t cmd_result = ducky_execute_cmd(bad_usb, line_tmp);
+    int32_t cmd_result = ducky_compile_cmd(bad_usb, line_tmp, instruction);
     if(cmd_result != SCRIPT_STATE_CMD_UNKNOWN) {
         return cmd_result;
     }
 
     // Special keys + modifiers
-    uint16_t key = ducky_get_keycode(bad_usb, line_tmp, false);
+    uint16_t key = ducky_get_keycode_by_name(line_tmp);
     if(key == HID_KEYBOARD_NONE) {
         return ducky_error(bad_usb, "No keycode defined for %s", line_tmp);
     }
+    instruction->key = key;
     if((key & 0xFF00) != 0) {
         // It's a modifier key
         line_tmp = &line_tmp[ducky_get_command_len(line_tmp) + 1];
-        key |= ducky_get_keycode(bad_usb, line_tmp, true);
+        ducky_compile_keycode(line_tmp, instruction);
     }
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
-    bad_usb->hid->kb_release(bad_usb->hid_inst, key);
+    instruction->op = DuckyOpKey;
     return 0;
 }
 
+static bool ducky_code_write(File* code_file, const DuckyInstruction* instruction) {
+    DuckyCodeHeader header = {
+        .op = instruction->op,
+        .key_char = instruction->key_char,
+        .key = instruction->key,
+        .value = instruction->value,
+        .text_len = furi_string_size(instruction->text),
+    };
+
+    if(storage_file_write(code_file, &header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+    return storage_file_write(
+               code_file, furi_string_get_cstr(instruction->text), header.text_len) ==
+           header.text_len;
+}
+
+static void ducky_code_rewind(BadUsbScript* bad_usb, File* code_file) {
+    storage_file_seek(code_file, 0, true);
+    bad_usb->code_pos = 0;
+    bad_usb->code_len = 0;
+    bad_usb->code_cur = &bad_usb->code[0];
+    bad_usb->code_prev = &bad_usb->code[1];
+    bad_usb->code_cur->op = DuckyOpEmpty;
+    bad_usb->code_prev->op = DuckyOpEmpty;
+}
+
+static bool ducky_code_fill(BadUsbScript* bad_usb, File* code_file) {
+    if(bad_usb->code_pos == bad_usb->code_len) {
+        bad_usb->code_pos = 0;
+        bad_usb->code_len = storage_file_read(code_file, bad_usb->code_buf, CODE_BUFFER_LEN);
+    }
+    return bad_usb->code_len > 0;
+}
+
+static bool
+    ducky_code_read(BadUsbScript* bad_usb, File* code_file, DuckyInstruction* instruction) {
+    DuckyCodeHeader header;
+    uint8_t* header_ptr = (uint8_t*)&header;
+
+    for(size_t read = 0; read < sizeof(header);) {
+        if(!ducky_code_fill(bad_usb, code_file)) return false;
+        size_t len = MIN(sizeof(header) - read, bad_usb->code_len - bad_usb->code_pos);
+        memcpy(&header_ptr[read], &bad_usb->code_buf[bad_usb->code_pos], len);
+        bad_usb->code_pos += len;
+        read += len;
+    }
+
+    instruction->op = header.op;
+    instruction->key_char = header.key_char;
+    instruction->key = header.key;
+    instruction->value = header.value;
+    furi_string_reset(instruction->text);
+
+    for(size_t read = 0; read < header.text_len;) {
+        if(!ducky_code_fill(bad_usb, code_file)) return false;
+        size_t len = MIN(header.text_len - read, bad_usb->code_len - bad_usb->code_pos);
+        furi_string_cat_printf(
+            instruction->text, "%.*s", (int)len, (char*)&bad_usb->code_buf[bad_usb->code_pos]);
+        bad_usb->code_pos += len;
+        read += len;
+    }
+
+    return true;
+}
+
 static bool ducky_set_usb_id(BadUsbScript* bad_usb, const char* line) {
     if(sscanf(line, "%lX:%lX", &bad_usb->hid_cfg.vid, &bad_usb->hid_cfg.pid) == 2) {
         bad_usb->hid_cfg.manuf[0] = '\0';
@@ -244,38 +353,58 @@ static void bad_usb_hid_state_callback(bool state, void* context) {
     }
 }
 
-static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file) {
-    uint8_t ret = 0;
-    uint32_t line_len = 0;
+static bool ducky_script_compile_line(BadUsbScript* bad_usb, File* code_file, bool* id_set) {
+    furi_string_trim(bad_usb->line);
+    bad_usb->st.line_nb++;
+
+    const char* line_tmp = furi_string_get_cstr(bad_usb->line);
+    FURI_LOG_D(WORKER_TAG, "line:%s", line_tmp);
+
+    // Looking for ID command at first line
+    if((bad_usb->st.line_nb == 1) &&
+       (strncmp(line_tmp, ducky_cmd_id, strlen(ducky_cmd_id)) == 0)) {
+        *id_set = ducky_set_usb_id(bad_usb, &line_tmp[strlen(ducky_cmd_id) + 1]);
+    }
+
+    if(ducky_compile_line(bad_usb, bad_usb->line, bad_usb->code_cur) < 0) {
+        bad_usb->st.error_line = bad_usb->st.line_nb;
+        FURI_LOG_E(WORKER_TAG, "Script error at line %zu", bad_usb->st.line_nb);
+        return false;
+    }
+    furi_string_reset(bad_usb->line);
+
+    if(!ducky_code_write(code_file, bad_usb->code_cur)) {
+        FURI_LOG_E(WORKER_TAG, "Code write error");
+        ducky_error(bad_usb, "Can't write bytecode");
+        return false;
+    }
+
+    return true;
+}
+
+static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file, File* code_file) {
+    size_t ret = 0;
+    bool id_set = false;
+    bool success = true;
 
     furi_string_reset(bad_usb->line);
 
+    // Whole script is checked and compiled once, execution only reads prepared instructions
     do {
-        ret = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
-        for(uint16_t i = 0; i < ret; i++) {
-            if(bad_usb->file_buf[i] == '\n' && line_len > 0) {
-                bad_usb->st.line_nb++;
-                line_len = 0;
+        ret = storage_file_read(script_file, bad_usb->code_buf, CODE_BUFFER_LEN);
+        for(size_t i = 0; (i < ret) && success; i++) {
+            if(bad_usb->code_buf[i] == '\n' && furi_string_size(bad_usb->line) > 0) {
+                success = ducky_script_compile_line(bad_usb, code_file, &id_set);
             } else {
-                if(bad_usb->st.line_nb == 0) { // Save first line
-                    furi_string_push_back(bad_usb->line, bad_usb->file_buf[i]);
-                }
-                line_len++;
+                furi_string_push_back(bad_usb->line, bad_usb->code_buf[i]);
             }
         }
-        if(storage_file_eof(script_file)) {
-            if(line_len > 0) {
-                bad_usb->st.line_nb++;
-                break;
-            }
-        }
-    } while(ret > 0);
+    } while(success && (ret > 0));
 
-    const char* line_tmp = furi_string_get_cstr(bad_usb->line);
-    bool id_set = false; // Looking for ID command at first line
-    if(strncmp(line_tmp, ducky_cmd_id, strlen(ducky_cmd_id)) == 0) {
-        id_set = ducky_set_usb_id(bad_usb, &line_tmp[strlen(ducky_cmd_id) + 1]);
+    if(success && (furi_string_size(bad_usb->line) > 0)) { // Last line without newline
+        success = ducky_script_compile_line(bad_usb, code_file, &id_set);
     }
+    furi_string_reset(bad_usb->line);
 
     if(id_set) {
         bad_usb->hid_inst = bad_usb->hid->init(&bad_usb->hid_cfg);
@@ -284,79 +413,53 @@ static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file) {
     }
     bad_usb->hid->set_state_callback(bad_usb->hid_inst, bad_usb_hid_state_callback, bad_usb);
 
-    storage_file_seek(script_file, 0, true);
-    furi_string_reset(bad_usb->line);
+    return success;
+}
 
-    return true;
+static int32_t ducky_script_result(BadUsbScript* bad_usb, int32_t delay_val, size_t line) {
+    if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
+        return 0;
+    } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
+        return delay_val;
+    } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
+        return delay_val;
+    } else if(delay_val < 0) { // Script error
+        bad_usb->st.error_line = line;
+        FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", line);
+        return SCRIPT_STATE_ERROR;
+    } else {
+        return delay_val + bad_usb->defdelay;
+    }
 }
 
-static int32_t ducky_script_execute_next(BadUsbScript* bad_usb, File* script_file) {
+static int32_t ducky_script_execute_next(BadUsbScript* bad_usb, File* code_file) {
     int32_t delay_val = 0;
 
     if(bad_usb->repeat_cnt > 0) {
         bad_usb->repeat_cnt--;
-        delay_val = ducky_parse_line(bad_usb, bad_usb->line_prev);
-        if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
-            return 0;
-        } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
-            return delay_val;
-        } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
-            return delay_val;
-        } else if(delay_val < 0) { // Script error
-            bad_usb->st.error_line = bad_usb->st.line_cur - 1;
-            FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", bad_usb->st.line_cur - 1U);
-            return SCRIPT_STATE_ERROR;
-        } else {
-            return delay_val + bad_usb->defdelay;
-        }
+        delay_val = ducky_execute_instruction(bad_usb, bad_usb->code_prev);
+        return ducky_script_result(bad_usb, delay_val, bad_usb->st.line_cur - 1);
     }
 
-    furi_string_set(bad_usb->line_prev, bad_usb->line);
-    furi_string_reset(bad_usb->line);
-
-    while(1) {
-        if(bad_usb->buf_len == 0) {
-            bad_usb->buf_len = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
-            if(storage_file_eof(script_file)) {
-                if((bad_usb->buf_len < FILE_BUFFER_LEN) && (bad_usb->file_end == false)) {
-                    bad_usb->file_buf[bad_usb->buf_len] = '\n';
-                    bad_usb->buf_len++;
-                    bad_usb->file_end = true;
-                }
-            }
+    if(bad_usb->st.line_cur >= bad_usb->st.line_nb) {
+        return SCRIPT_STATE_END;
+    }
 
-            bad_usb->buf_start = 0;
-            if(bad_usb->buf_len == 0) return SCRIPT_STATE_END;
-        }
-        for(uint8_t i = bad_usb->buf_start; i < (bad_usb->buf_start + bad_usb->buf_len); i++) {
-            if(bad_usb->file_buf[i] == '\n' && furi_string_size(bad_usb->line) > 0) {
-                bad_usb->st.line_cur++;
-                bad_usb->buf_len = bad_usb->buf_len + bad_usb->buf_start - (i + 1);
-                bad_usb->buf_start = i + 1;
-                furi_string_trim(bad_usb->line);
-                delay_val = ducky_parse_line(bad_usb, bad_usb->line);
-                if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
-                    return 0;
-                } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
-                    return delay_val;
-                } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
-                    return delay_val;
-                } else if(delay_val < 0) {
-                    bad_usb->st.error_line = bad_usb->st.line_cur;
-                    FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", bad_usb->st.line_cur);
-                    return SCRIPT_STATE_ERROR;
-                } else {
-                    return delay_val + bad_usb->defdelay;
-                }
-            } else {
-                furi_string_push_back(bad_usb->line, bad_usb->file_buf[i]);
-            }
-        }
-        bad_usb->buf_len = 0;
-        if(bad_usb->file_end) return SCRIPT_STATE_END;
+    // Keep previous instruction for REPEAT
+    DuckyInstruction* instruction = bad_usb->code_prev;
+    bad_usb->code_prev = bad_usb->code_cur;
+    bad_usb->code_cur = instruction;
+
+    bad_usb->st.line_cur++;
+    if(!ducky_code_read(bad_usb, code_file, instruction)) {
+        bad_usb->st.error_line = bad_usb->st.line_cur;
+        FURI_LOG_E(WORKER_TAG, "Code read error");
+        ducky_error(bad_usb, "Can't read bytecode");
+        return SCRIPT_STATE_ERROR;
     }
 
-    return 0;
+    delay_val = ducky_execute_instruction(bad_usb, instruction);
+    return ducky_script_result(bad_usb, delay_val, bad_usb->st.line_cur);
 }
 
 static uint32_t bad_usb_flags_get(uint32_t flags_mask, uint32_t timeout) {
@@ -380,19 +483,30 @@ static int32_t bad_usb_worker(void* context) {
     int32_t delay_val = 0;
 
     FURI_LOG_I(WORKER_TAG, "Init");
-    File* script_file = storage_file_alloc(furi_record_open(RECORD_STORAGE));
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* script_file = storage_file_alloc(storage);
+    File* code_file = storage_file_alloc(storage);
     bad_usb->line = furi_string_alloc();
-    bad_usb->line_prev = furi_string_alloc();
     bad_usb->string_print = furi_string_alloc();
+    for(size_t i = 0; i < COUNT_OF(bad_usb->code); i++) {
+        bad_usb->code[i].text = furi_string_alloc();
+    }
+    bad_usb->code_cur = &bad_usb->code[0];
+    bad_usb->code_prev = &bad_usb->code[1];
 
     while(1) {
         if(worker_state == BadUsbStateInit) { // State: initialization
+            storage_simply_mkdir(storage, BAD_USB_CODE_DIR);
             if(storage_file_open(
                    script_file,
                    furi_string_get_cstr(bad_usb->file_path),
                    FSAM_READ,
-                   FSOM_OPEN_EXISTING)) {
-                if((ducky_script_preload(bad_usb, script_file)) && (bad_usb->st.line_nb > 0)) {
+                   FSOM_OPEN_EXISTING) &&
+               storage_file_open(
+                   code_file, BAD_USB_CODE_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+                bool preloaded = ducky_script_preload(bad_usb, script_file, code_file);
+                storage_file_close(script_file);
+                if(preloaded && (bad_usb->st.line_nb > 0)) {
                     if(bad_usb->hid->is_connected(bad_usb->hid_inst)) {
                         worker_state = BadUsbStateIdle; // Ready to run
                     } else {
@@ -430,15 +544,14 @@ static int32_t bad_usb_worker(void* context) {
             } else if(flags & WorkerEvtStartStop) { // Start executing script
                 dolphin_deed(DolphinDeedBadUsbPlayScript);
                 delay_val = 0;
-                bad_usb->buf_len = 0;
                 bad_usb->st.line_cur = 0;
                 bad_usb->defdelay = 0;
                 bad_usb->stringdelay = 0;
                 bad_usb->defstringdelay = 0;
                 bad_usb->repeat_cnt = 0;
+                bad_usb->turbo = false;
                 bad_usb->key_hold_nb = 0;
-                bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
+                ducky_code_rewind(bad_usb, code_file);
                 worker_state = BadUsbStateRunning;
             } else if(flags & WorkerEvtDisconnect) {
                 worker_state = BadUsbStateNotConnected; // USB disconnected
@@ -454,14 +567,13 @@ static int32_t bad_usb_worker(void* context) {
             } else if(flags & WorkerEvtConnect) { // Start executing script
                 dolphin_deed(DolphinDeedBadUsbPlayScript);
                 delay_val = 0;
-                bad_usb->buf_len = 0;
                 bad_usb->st.line_cur = 0;
                 bad_usb->defdelay = 0;
                 bad_usb->stringdelay = 0;
                 bad_usb->defstringdelay = 0;
                 bad_usb->repeat_cnt = 0;
-                bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
+                bad_usb->turbo = false;
+                ducky_code_rewind(bad_usb, code_file);
                 // extra time for PC to recognize Flipper as keyboard
                 flags = furi_thread_flags_wait(
                     WorkerEvtEnd | WorkerEvtDisconnect | WorkerEvtStartStop,
@@ -510,7 +622,7 @@ static int32_t bad_usb_worker(void* context) {
                     continue;
                 }
                 bad_usb->st.state = BadUsbStateRunning;
-                delay_val = ducky_script_execute_next(bad_usb, script_file);
+                delay_val = ducky_script_execute_next(bad_usb, code_file);
                 if(delay_val == SCRIPT_STATE_ERROR) { // Script error
                     delay_val = 0;
                     worker_state = BadUsbStateScriptError;
@@ -635,9 +747,15 @@ static int32_t bad_usb_worker(void* context) {
 
     storage_file_close(script_file);
     storage_file_free(script_file);
+    storage_file_close(code_file);
+    storage_file_free(code_file);
+    storage_simply_remove(storage, BAD_USB_CODE_PATH);
+    furi_record_close(RECORD_STORAGE);
     furi_string_free(bad_usb->line);
-    furi_string_free(bad_usb->line_prev);
     furi_string_free(bad_usb->string_print);
+    for(size_t i = 0; i < COUNT_OF(bad_usb->code); i++) {
+        furi_string_free(bad_usb->code[i].text);
+    }
 
     FURI_LOG_I(WORKER_TAG, "End");
 
@@ -2,7 +2,11 @@
 #include "ducky_script.h"
 #include "ducky_script_i.h"
 
-typedef int32_t (*DuckyCmdCallback)(BadUsbScript* bad_usb, const char* line, int32_t param);
+typedef int32_t (*DuckyCmdCallback)(
+    BadUsbScript* bad_usb,
+    const char* line,
+    DuckyInstruction* instruction,
+    int32_t param);
 
 typedef struct {
     char* name;
@@ -10,151 +14,70 @@ typedef struct {
     int32_t param;
 } DuckyCmd;
 
-static int32_t ducky_fnc_delay(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
-    line = &line[ducky_get_command_len(line) + 1];
-    uint32_t delay_val = 0;
-    bool state = ducky_get_number(line, &delay_val);
-    if((state) && (delay_val > 0)) {
-        return (int32_t)delay_val;
-    }
-
-    return ducky_error(bad_usb, "Invalid number %s", line);
-}
-
-static int32_t ducky_fnc_defdelay(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
-    line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->defdelay);
-    if(!state) {
-        return ducky_error(bad_usb, "Invalid number %s", line);
-    }
-    return 0;
-}
-
-static int32_t ducky_fnc_strdelay(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
+static int32_t ducky_fnc_number(
+    BadUsbScript* bad_usb,
+    const char* line,
+    DuckyInstruction* instruction,
+    int32_t param) {
     line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->stringdelay);
-    if(!state) {
+    bool state = ducky_get_number(line, &instruction->value);
+    // DELAY and REPEAT make no sense without a positive number
+    bool zero_allowed = (param != DuckyOpDelay) && (param != DuckyOpRepeat);
+    if((!state) || ((instruction->value == 0) && !zero_allowed)) {
         return ducky_error(bad_usb, "Invalid number %s", line);
     }
+    instruction->op = param;
     return 0;
 }
 
-static int32_t ducky_fnc_defstrdelay(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
-    line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->defstringdelay);
-    if(!state) {
-        return ducky_error(bad_usb, "Invalid number %s", line);
-    }
-    return 0;
-}
+static int32_t ducky_fnc_string(
+    BadUsbScript* bad_usb,
+    const char* line,
+    DuckyInstruction* instruction,
+    int32_t param) {
+    UNUSED(bad_usb);
 
-static int32_t ducky_fnc_string(BadUsbScript* bad_usb, const char* line, int32_t param) {
     line = &line[ducky_get_command_len(line) + 1];
-    furi_string_set_str(bad_usb->string_print, line);
+    furi_string_set_str(instruction->text, line);
     if(param == 1) {
-        furi_string_cat(bad_usb->string_print, "\n");
-    }
-
-    if(bad_usb->stringdelay == 0 &&
-       bad_usb->defstringdelay == 0) { // stringdelay not set - run command immediately
-        bool state = ducky_string(bad_usb, furi_string_get_cstr(bad_usb->string_print));
-        if(!state) {
-            return ducky_error(bad_usb, "Invalid string %s", line);
-        }
-    } else { // stringdelay is set - run command in thread to keep handling external events
-        return SCRIPT_STATE_STRING_START;
-    }
-
-    return 0;
-}
-
-static int32_t ducky_fnc_repeat(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
-    line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->repeat_cnt);
-    if((!state) || (bad_usb->repeat_cnt == 0)) {
-        return ducky_error(bad_usb, "Invalid number %s", line);
-    }
-    return 0;
-}
-
-static int32_t ducky_fnc_sysrq(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
-    line = &line[ducky_get_command_len(line) + 1];
-    uint16_t key = ducky_get_keycode(bad_usb, line, true);
-    bad_usb->hid->kb_press(bad_usb->hid_inst, KEY_MOD_LEFT_ALT | HID_KEYBOARD_PRINT_SCREEN);
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
-    bad_usb->hid->release_all(bad_usb->hid_inst);
-    return 0;
-}
-
-static int32_t ducky_fnc_altchar(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
-    line = &line[ducky_get_command_len(line) + 1];
-    ducky_numlock_on(bad_usb);
-    bool state = ducky_altchar(bad_usb, line);
-    if(!state) {
-        return ducky_error(bad_usb, "Invalid altchar %s", line);
+        furi_string_cat(instruction->text, "\n");
     }
+    instruction->op = DuckyOpString;
     return 0;
 }
 
-static int32_t ducky_fnc_altstring(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
+static int32_t ducky_fnc_text(
+    BadUsbScript* bad_usb,
+    const char* line,
+    DuckyInstruction* instruction,
+    int32_t param) {
+    UNUSED(bad_usb);
 
     line = &line[ducky_get_command_len(line) + 1];
-    ducky_numlock_on(bad_usb);
-    bool state = ducky_altstring(bad_usb, line);
-    if(!state) {
-        return ducky_error(bad_usb, "Invalid altstring %s", line);
-    }
+    furi_string_set_str(instruction->text, line);
+    instruction->op = param;
     return 0;
 }
 
-static int32_t ducky_fnc_hold(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
+static int32_t ducky_fnc_key(
+    BadUsbScript* bad_usb,
+    const char* line,
+    DuckyInstruction* instruction,
+    int32_t param) {
+    UNUSED(bad_usb);
 
     line = &line[ducky_get_command_len(line) + 1];
-    uint16_t key = ducky_get_keycode(bad_usb, line, true);
-    if(key == HID_KEYBOARD_NONE) {
-        return ducky_error(bad_usb, "No keycode defined for %s", line);
-    }
-    bad_usb->key_hold_nb++;
-    if(bad_usb->key_hold_nb > (HID_KB_MAX_KEYS - 1)) {
-        return ducky_error(bad_usb, "Too many keys are hold");
-    }
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
+    furi_string_set_str(instruction->text, line);
+    ducky_compile_keycode(line, instruction);
+    instruction->op = param;
     return 0;
 }
 
-static int32_t ducky_fnc_release(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
-    line = &line[ducky_get_command_len(line) + 1];
-    uint16_t key = ducky_get_keycode(bad_usb, line, true);
-    if(key == HID_KEYBOARD_NONE) {
-        return ducky_error(bad_usb, "No keycode defined for %s", line);
-    }
-    if(bad_usb->key_hold_nb == 0) {
-        return ducky_error(bad_usb, "No keys are hold");
-    }
-    bad_usb->key_hold_nb--;
-    bad_usb->hid->kb_release(bad_usb->hid_inst, key);
-    return 0;
-}
-
-static int32_t ducky_fnc_media(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t ducky_fnc_media(
+    BadUsbScript* bad_usb,
+    const char* line,
+    DuckyInstruction* instruction,
+    int32_t param) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
@@ -162,64 +85,60 @@ static int32_t ducky_fnc_media(BadUsbScript* bad_usb, const char* line, int32_t
     if(key == HID_CONSUMER_UNASSIGNED) {
         return ducky_error(bad_usb, "No keycode defined for %s", line);
     }
-    bad_usb->hid->consumer_press(bad_usb->hid_inst, key);
-    bad_usb->hid->consumer_release(bad_usb->hid_inst, key);
+    instruction->key = key;
+    instruction->op = DuckyOpMedia;
     return 0;
 }
 
-static int32_t ducky_fnc_globe(BadUsbScript* bad_usb, const char* line, int32_t param) {
+static int32_t ducky_fnc_turbo(
+    BadUsbScript* bad_usb,
+    const char* line,
+    DuckyInstruction* instruction,
+    int32_t param) {
     UNUSED(param);
 
     line = &line[ducky_get_command_len(line) + 1];
-    uint16_t key = ducky_get_keycode(bad_usb, line, true);
-    if(key == HID_KEYBOARD_NONE) {
-        return ducky_error(bad_usb, "No keycode defined for %s", line);
+    if(strcmp(line, "ON") == 0) {
+        instruction->value = 1;
+    } else if(strcmp(line, "OFF") == 0) {
+        instruction->value = 0;
+    } else {
+        return ducky_error(bad_usb, "Invalid turbo mode %s", line);
     }
-
-    bad_usb->hid->consumer_press(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
-    bad_usb->hid->kb_release(bad_usb->hid_inst, key);
-    bad_usb->hid->consumer_release(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
+    instruction->op = DuckyOpTurbo;
     return 0;
 }
 
-static int32_t ducky_fnc_waitforbutton(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-    UNUSED(bad_usb);
-    UNUSED(line);
-
-    return SCRIPT_STATE_WAIT_FOR_BTN;
-}
-
 static const DuckyCmd ducky_commands[] = {
     {"REM", NULL, -1},
     {"ID", NULL, -1},
-    {"DELAY", ducky_fnc_delay, -1},
+    {"DELAY", ducky_fnc_number, DuckyOpDelay},
     {"STRING", ducky_fnc_string, 0},
     {"STRINGLN", ducky_fnc_string, 1},
-    {"DEFAULT_DELAY", ducky_fnc_defdelay, -1},
-    {"DEFAULTDELAY", ducky_fnc_defdelay, -1},
-    {"STRINGDELAY", ducky_fnc_strdelay, -1},
-    {"STRING_DELAY", ducky_fnc_strdelay, -1},
-    {"DEFAULT_STRING_DELAY", ducky_fnc_defstrdelay, -1},
-    {"DEFAULTSTRINGDELAY", ducky_fnc_defstrdelay, -1},
-    {"REPEAT", ducky_fnc_repeat, -1},
-    {"SYSRQ", ducky_fnc_sysrq, -1},
-    {"ALTCHAR", ducky_fnc_altchar, -1},
-    {"ALTSTRING", ducky_fnc_altstring, -1},
-    {"ALTCODE", ducky_fnc_altstring, -1},
-    {"HOLD", ducky_fnc_hold, -1},
-    {"RELEASE", ducky_fnc_release, -1},
-    {"WAIT_FOR_BUTTON_PRESS", ducky_fnc_waitforbutton, -1},
+    {"DEFAULT_DELAY", ducky_fnc_number, DuckyOpDefaultDelay},
+    {"DEFAULTDELAY", ducky_fnc_number, DuckyOpDefaultDelay},
+    {"STRINGDELAY", ducky_fnc_number, DuckyOpStringDelay},
+    {"STRING_DELAY", ducky_fnc_number, DuckyOpStringDelay},
+    {"DEFAULT_STRING_DELAY", ducky_fnc_number, DuckyOpDefaultStringDelay},
+    {"DEFAULTSTRINGDELAY", ducky_fnc_number, DuckyOpDefaultStringDelay},
+    {"REPEAT", ducky_fnc_number, DuckyOpRepeat},
+    {"SYSRQ", ducky_fnc_key, DuckyOpSysrq},
+    {"ALTCHAR", ducky_fnc_text, DuckyOpAltchar},
+    {"ALTSTRING", ducky_fnc_text, DuckyOpAltstring},
+    {"ALTCODE", ducky_fnc_text, DuckyOpAltstring},
+    {"HOLD", ducky_fnc_key, DuckyOpHold},
+    {"RELEASE", ducky_fnc_key, DuckyOpRelease},
+    {"WAIT_FOR_BUTTON_PRESS", NULL, DuckyOpWaitForButton},
     {"MEDIA", ducky_fnc_media, -1},
-    {"GLOBE", ducky_fnc_globe, -1},
+    {"GLOBE", ducky_fnc_key, DuckyOpGlobe},
+    {"TURBO", ducky_fnc_turbo, -1},
 };
 
 #define TAG "BadUsb"
 
 #define WORKER_TAG TAG "Worker"
 
-int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line) {
+int32_t ducky_compile_cmd(BadUsbScript* bad_usb, const char* line, DuckyInstruction* instruction) {
     size_t cmd_word_len = strcspn(line, " ");
     for(size_t i = 0; i < COUNT_OF(ducky_commands); i++) {
         size_t cmd_compare_len = strlen(ducky_commands[i].name);
@@ -230,12 +149,113 @@ int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line) {
 
         if(strncmp(line, ducky_commands[i].name, cmd_compare_len) == 0) {
             if(ducky_commands[i].callback == NULL) {
+                instruction->op = (ducky_commands[i].param < 0) ? DuckyOpNop :
+                                                                   ducky_commands[i].param;
                 return 0;
             } else {
-                return (ducky_commands[i].callback)(bad_usb, line, ducky_commands[i].param);
+                return (ducky_commands[i].callback)(
+                    bad_usb, line, instruction, ducky_commands[i].param);
             }
         }
     }
 
     return SCRIPT_STATE_CMD_UNKNOWN;
 }
+
+int32_t ducky_execute_instruction(BadUsbScript* bad_usb, const DuckyInstruction* instruction) {
+    const char* text = furi_string_get_cstr(instruction->text);
+    uint16_t key = ducky_resolve_keycode(bad_usb, instruction);
+
+    switch(instruction->op) {
+    case DuckyOpEmpty:
+        return SCRIPT_STATE_NEXT_LINE;
+    case DuckyOpNop:
+        return 0;
+    case DuckyOpKey:
+        bad_usb->hid->kb_press(bad_usb->hid_inst, key);
+        bad_usb->hid->kb_release(bad_usb->hid_inst, key);
+        return 0;
+    case DuckyOpDelay:
+        return (int32_t)instruction->value;
+    case DuckyOpDefaultDelay:
+        bad_usb->defdelay = instruction->value;
+        return 0;
+    case DuckyOpStringDelay:
+        bad_usb->stringdelay = instruction->value;
+        return 0;
+    case DuckyOpDefaultStringDelay:
+        bad_usb->defstringdelay = instruction->value;
+        return 0;
+    case DuckyOpString:
+        if(bad_usb->stringdelay == 0 &&
+           bad_usb->defstringdelay == 0) { // stringdelay not set - run command immediately
+            if(!ducky_string(bad_usb, text)) {
+                return ducky_error(bad_usb, "Invalid string %s", text);
+            }
+        } else { // stringdelay is set - run command in thread to keep handling external events
+            furi_string_set(bad_usb->string_print, instruction->text);
+            return SCRIPT_STATE_STRING_START;
+        }
+        return 0;
+    case DuckyOpRepeat:
+        bad_usb->repeat_cnt = instruction->value;
+        return 0;
+    case DuckyOpSysrq:
+        bad_usb->hid->kb_press(bad_usb->hid_inst, KEY_MOD_LEFT_ALT | HID_KEYBOARD_PRINT_SCREEN);
+        bad_usb->hid->kb_press(bad_usb->hid_inst, key);
+        bad_usb->hid->release_all(bad_usb->hid_inst);
+        return 0;
+    case DuckyOpAltchar:
+        ducky_numlock_on(bad_usb);
+        if(!ducky_altchar(bad_usb, text)) {
+            return ducky_error(bad_usb, "Invalid altchar %s", text);
+        }
+        return 0;
+    case DuckyOpAltstring:
+        ducky_numlock_on(bad_usb);
+        if(!ducky_altstring(bad_usb, text)) {
+            return ducky_error(bad_usb, "Invalid altstring %s", text);
+        }
+        return 0;
+    case DuckyOpHold:
+        if(key == HID_KEYBOARD_NONE) {
+            return ducky_error(bad_usb, "No keycode defined for %s", text);
+        }
+        bad_usb->key_hold_nb++;
+        if(bad_usb->key_hold_nb > (HID_KB_MAX_KEYS - 1)) {
+            return ducky_error(bad_usb, "Too many keys are hold");
+        }
+        bad_usb->hid->kb_press(bad_usb->hid_inst, key);
+        return 0;
+    case DuckyOpRelease:
+        if(key == HID_KEYBOARD_NONE) {
+            return ducky_error(bad_usb, "No keycode defined for %s", text);
+        }
+        if(bad_usb->key_hold_nb == 0) {
+            return ducky_error(bad_usb, "No keys are hold");
+        }
+        bad_usb->key_hold_nb--;
+        bad_usb->hid->kb_release(bad_usb->hid_inst, key);
+        return 0;
+    case DuckyOpMedia:
+        bad_usb->hid->consumer_press(bad_usb->hid_inst, instruction->key);
+        bad_usb->hid->consumer_release(bad_usb->hid_inst, instruction->key);
+        return 0;
+    case DuckyOpGlobe:
+        if(key == HID_KEYBOARD_NONE) {
+            return ducky_error(bad_usb, "No keycode defined for %s", text);
+        }
+        bad_usb->hid->consumer_press(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
+        bad_usb->hid->kb_press(bad_usb->hid_inst, key);
+        bad_usb->hid->kb_release(bad_usb->hid_inst, key);
+        bad_usb->hid->consumer_release(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
+        return 0;
+    case DuckyOpWaitForButton:
+        return SCRIPT_STATE_WAIT_FOR_BTN;
+    case DuckyOpTurbo:
+        bad_usb->turbo = (instruction->value != 0);
+        return 0;
+    default:
+        return ducky_error(bad_usb, "Invalid instruction %u", instruction->op);
+    }
+}
@@ -16,7 +16,47 @@ extern "C" {
 #define SCRIPT_STATE_STRING_START (-5)
 #define SCRIPT_STATE_WAIT_FOR_BTN (-6)
 
-#define FILE_BUFFER_LEN 16
+#define CODE_BUFFER_LEN 256
+
+/** Compiled script line */
+typedef enum {
+    DuckyOpEmpty,
+    DuckyOpNop,
+    DuckyOpKey,
+    DuckyOpDelay,
+    DuckyOpDefaultDelay,
+    DuckyOpStringDelay,
+    DuckyOpDefaultStringDelay,
+    DuckyOpString,
+    DuckyOpRepeat,
+    DuckyOpSysrq,
+    DuckyOpAltchar,
+    DuckyOpAltstring,
+    DuckyOpHold,
+    DuckyOpRelease,
+    DuckyOpMedia,
+    DuckyOpGlobe,
+    DuckyOpWaitForButton,
+    DuckyOpTurbo,
+} DuckyOp;
+
+typedef struct {
+    uint8_t op;
+    // Char is mapped to key on execution, so layout can be changed after load
+    char key_char;
+    uint16_t key;
+    uint32_t value;
+    // Followed by text_len bytes of text
+    uint32_t text_len;
+} DuckyCodeHeader;
+
+typedef struct {
+    uint8_t op;
+    char key_char;
+    uint16_t key;
+    uint32_t value;
+    FuriString* text;
+} DuckyInstruction;
 
 struct BadUsbScript {
     FuriHalUsbHidConfig hid_cfg;
@@ -26,18 +66,20 @@ struct BadUsbScript {
     BadUsbState st;
 
     FuriString* file_path;
-    uint8_t file_buf[FILE_BUFFER_LEN + 1];
-    uint8_t buf_start;
-    uint8_t buf_len;
-    bool file_end;
+    uint8_t code_buf[CODE_BUFFER_LEN];
+    size_t code_pos;
+    size_t code_len;
 
     uint32_t defdelay;
     uint32_t stringdelay;
     uint32_t defstringdelay;
+    bool turbo;
     uint16_t layout[128];
 
     FuriString* line;
-    FuriString* line_prev;
+    DuckyInstruction code[2];
+    DuckyInstruction* code_cur;
+    DuckyInstruction* code_prev;
     uint32_t repeat_cnt;
     uint8_t key_hold_nb;
 
@@ -45,7 +87,9 @@ struct BadUsbScript {
     size_t string_print_pos;
 };
 
-uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept_chars);
+void ducky_compile_keycode(const char* param, DuckyInstruction* instruction);
+
+uint16_t ducky_resolve_keycode(BadUsbScript* bad_usb, const DuckyInstruction* instruction);
 
 uint32_t ducky_get_command_len(const char* line);
 
@@ -67,7 +111,9 @@ bool ducky_altstring(BadUsbScript* bad_usb, const char* param);
 
 bool ducky_string(BadUsbScript* bad_usb, const char* param);
 
-int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line);
+int32_t ducky_compile_cmd(BadUsbScript* bad_usb, const char* line, DuckyInstruction* instruction);
+
+int32_t ducky_execute_instruction(BadUsbScript* bad_usb, const DuckyInstruction* instruction);
 
 int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...);
 
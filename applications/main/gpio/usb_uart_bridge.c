@@ -10,8 +10,14 @@
 #include <stm32wbxx_ll_lpuart.h>
 #include <stm32wbxx_ll_usart.h>
 
-#define USB_CDC_PKT_LEN      CDC_DATA_SZ
-#define USB_UART_RX_BUF_SIZE (USB_CDC_PKT_LEN * 5)
+#define USB_CDC_PKT_LEN       CDC_DATA_SZ
+#define USB_UART_RX_BUF_SIZE  (USB_CDC_PKT_LEN * 64)
+#define USB_UART_RX_BUF_MASK  (USB_UART_RX_BUF_SIZE - 1)
+#define USB_UART_TX_BUF_COUNT (4U)
+
+// RTS is deasserted above the high mark and asserted again below the low one
+#define USB_UART_RX_THROTTLE_HIGH (USB_UART_RX_BUF_SIZE * 3 / 4)
+#define USB_UART_RX_THROTTLE_LOW  (USB_UART_RX_BUF_SIZE / 4)
 
 #define USB_CDC_BIT_DTR     (1 << 0)
 #define USB_CDC_BIT_RTS     (1 << 1)
@@ -36,12 +42,14 @@ typedef enum {
     WorkerEvtLineCfgSet = (1 << 6),
     WorkerEvtCtrlLineSet = (1 << 7),
 
+    WorkerEvtTxDone = (1 << 8),
+
 } WorkerEvtFlags;
 
 #define WORKER_ALL_RX_EVENTS                                                      \
     (WorkerEvtStop | WorkerEvtRxDone | WorkerEvtCfgChange | WorkerEvtLineCfgSet | \
      WorkerEvtCtrlLineSet | WorkerEvtCdcTxComplete)
-#define WORKER_ALL_TX_EVENTS (WorkerEvtTxStop | WorkerEvtCdcRx)
+#define WORKER_ALL_TX_EVENTS (WorkerEvtTxStop | WorkerEvtCdcRx | WorkerEvtTxDone)
 
 struct UsbUartBridge {
     UsbUartConfig cfg;
@@ -50,18 +58,26 @@ struct UsbUartBridge {
     FuriThread* thread;
     FuriThread* tx_thread;
 
-    FuriStreamBuffer* rx_stream;
     FuriHalSerialHandle* serial_handle;
 
     FuriMutex* usb_mutex;
 
     FuriSemaphore* tx_sem;
+    FuriSemaphore* tx_buf_sem;
 
     UsbUartState st;
 
     FuriApiLock cfg_lock;
 
-    uint8_t rx_buf[USB_CDC_PKT_LEN];
+    // Serial RX is copied straight in here and CDC packets are sent from here
+    uint8_t rx_buf[USB_UART_RX_BUF_SIZE];
+    volatile size_t rx_head; // Written by serial RX interrupt only
+    volatile size_t rx_tail; // Written by worker only
+    bool rx_throttled;
+
+    // Serial DMA reads from these, so they outlive tx thread stack
+    uint8_t tx_buf[USB_UART_TX_BUF_COUNT][USB_CDC_PKT_LEN];
+    size_t tx_buf_index;
 };
 
 static void vcp_on_cdc_tx_complete(void* context);
@@ -89,16 +105,30 @@ static void usb_uart_on_irq_rx_dma_cb(
     void* context) {
     UsbUartBridge* usb_uart = (UsbUartBridge*)context;
 
+    if(ev & FuriHalSerialRxEventOverrunError) {
+        usb_uart->st.rx_overrun_cnt++;
+    }
+
     if(ev & (FuriHalSerialRxEventData | FuriHalSerialRxEventIdle)) {
-        uint8_t data[FURI_HAL_SERIAL_DMA_BUFFER_SIZE] = {0};
+        size_t head = usb_uart->rx_head;
         while(size) {
-            size_t ret = furi_hal_serial_dma_rx(
-                handle,
-                data,
-                (size > FURI_HAL_SERIAL_DMA_BUFFER_SIZE) ? FURI_HAL_SERIAL_DMA_BUFFER_SIZE : size);
-            furi_stream_buffer_send(usb_uart->rx_stream, data, ret, 0);
+            const size_t space = USB_UART_RX_BUF_SIZE - (head - usb_uart->rx_tail);
+            if(space == 0) {
+                // Nowhere to put it, but serial DMA buffer must be drained anyway
+                uint8_t data[USB_CDC_PKT_LEN];
+                size_t ret = furi_hal_serial_dma_rx(handle, data, MIN(size, sizeof(data)));
+                usb_uart->st.rx_lost_cnt += ret;
+                size -= ret;
+                continue;
+            }
+
+            const size_t offset = head & USB_UART_RX_BUF_MASK;
+            const size_t len = MIN(MIN(size, space), USB_UART_RX_BUF_SIZE - offset);
+            size_t ret = furi_hal_serial_dma_rx(handle, &usb_uart->rx_buf[offset], len);
+            head += ret;
             size -= ret;
         };
+        usb_uart->rx_head = head;
         furi_thread_flags_set(furi_thread_get_id(usb_uart->thread), WorkerEvtRxDone);
     }
 }
@@ -137,7 +167,7 @@ static void usb_uart_serial_init(UsbUartBridge* usb_uart, uint8_t uart_ch) {
 
     furi_hal_serial_init(usb_uart->serial_handle, 115200);
     furi_hal_serial_dma_rx_start(
-        usb_uart->serial_handle, usb_uart_on_irq_rx_dma_cb, usb_uart, false);
+        usb_uart->serial_handle, usb_uart_on_irq_rx_dma_cb, usb_uart, true);
 }
 
 static void usb_uart_serial_deinit(UsbUartBridge* usb_uart) {
@@ -166,20 +196,57 @@ static void usb_uart_update_ctrl_lines(UsbUartBridge* usb_uart) {
     if(usb_uart->cfg.flow_pins != 0) {
         furi_assert((size_t)(usb_uart->cfg.flow_pins - 1) < COUNT_OF(flow_pins));
         uint8_t state = furi_hal_cdc_get_ctrl_line_state(usb_uart->cfg.vcp_ch);
+        bool rts = (state & USB_CDC_BIT_RTS) && !usb_uart->rx_throttled;
 
-        furi_hal_gpio_write(flow_pins[usb_uart->cfg.flow_pins - 1][0], !(state & USB_CDC_BIT_RTS));
+        furi_hal_gpio_write(flow_pins[usb_uart->cfg.flow_pins - 1][0], !rts);
         furi_hal_gpio_write(flow_pins[usb_uart->cfg.flow_pins - 1][1], !(state & USB_CDC_BIT_DTR));
     }
 }
 
+static void usb_uart_rx_send(UsbUartBridge* usb_uart) {
+    const size_t tail = usb_uart->rx_tail;
+    const size_t used = usb_uart->rx_head - tail;
+    if(used == 0) return;
+
+    if(furi_semaphore_acquire(usb_uart->tx_sem, 100) == FuriStatusOk) {
+        // Packet never wraps, the rest goes with the next one
+        const size_t offset = tail & USB_UART_RX_BUF_MASK;
+        const size_t len = MIN(MIN(used, USB_CDC_PKT_LEN), USB_UART_RX_BUF_SIZE - offset);
+        usb_uart->st.rx_cnt += len;
+        furi_check(furi_mutex_acquire(usb_uart->usb_mutex, FuriWaitForever) == FuriStatusOk);
+        furi_hal_cdc_send(usb_uart->cfg.vcp_ch, &usb_uart->rx_buf[offset], len);
+        furi_check(furi_mutex_release(usb_uart->usb_mutex) == FuriStatusOk);
+        usb_uart->rx_tail = tail + len;
+    } else {
+        // Nobody reads the port, stale data is dropped
+        usb_uart->st.rx_lost_cnt += used;
+        usb_uart->rx_tail = tail + used;
+    }
+}
+
+static void usb_uart_rx_throttle_update(UsbUartBridge* usb_uart) {
+    const size_t used = usb_uart->rx_head - usb_uart->rx_tail;
+
+    bool throttled = usb_uart->rx_throttled;
+    if(used >= USB_UART_RX_THROTTLE_HIGH) {
+        throttled = true;
+    } else if(used <= USB_UART_RX_THROTTLE_LOW) {
+        throttled = false;
+    }
+
+    if(throttled != usb_uart->rx_throttled) {
+        usb_uart->rx_throttled = throttled;
+        usb_uart_update_ctrl_lines(usb_uart);
+    }
+}
+
 static int32_t usb_uart_worker(void* context) {
     UsbUartBridge* usb_uart = (UsbUartBridge*)context;
 
     memcpy(&usb_uart->cfg, &usb_uart->cfg_new, sizeof(UsbUartConfig));
 
-    usb_uart->rx_stream = furi_stream_buffer_alloc(USB_UART_RX_BUF_SIZE, 1);
-
     usb_uart->tx_sem = furi_semaphore_alloc(1, 1);
+    usb_uart->tx_buf_sem = furi_semaphore_alloc(USB_UART_TX_BUF_COUNT, USB_UART_TX_BUF_COUNT);
     usb_uart->usb_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
 
     usb_uart->tx_thread =
@@ -207,19 +274,8 @@ static int32_t usb_uart_worker(void* context) {
         furi_check(!(events & FuriFlagError));
         if(events & WorkerEvtStop) break;
         if(events & (WorkerEvtRxDone | WorkerEvtCdcTxComplete)) {
-            size_t len = furi_stream_buffer_receive(
-                usb_uart->rx_stream, usb_uart->rx_buf, USB_CDC_PKT_LEN, 0);
-            if(len > 0) {
-                if(furi_semaphore_acquire(usb_uart->tx_sem, 100) == FuriStatusOk) {
-                    usb_uart->st.rx_cnt += len;
-                    furi_check(
-                        furi_mutex_acquire(usb_uart->usb_mutex, FuriWaitForever) == FuriStatusOk);
-                    furi_hal_cdc_send(usb_uart->cfg.vcp_ch, usb_uart->rx_buf, len);
-                    furi_check(furi_mutex_release(usb_uart->usb_mutex) == FuriStatusOk);
-                } else {
-                    furi_stream_buffer_reset(usb_uart->rx_stream);
-                }
-            }
+            usb_uart_rx_send(usb_uart);
+            usb_uart_rx_throttle_update(usb_uart);
         }
         if(events & WorkerEvtCfgChange) {
             if(usb_uart->cfg.vcp_ch != usb_uart->cfg_new.vcp_ch) {
@@ -302,9 +358,9 @@ static int32_t usb_uart_worker(void* context) {
     furi_thread_join(usb_uart->tx_thread);
     furi_thread_free(usb_uart->tx_thread);
 
-    furi_stream_buffer_free(usb_uart->rx_stream);
     furi_mutex_free(usb_uart->usb_mutex);
     furi_semaphore_free(usb_uart->tx_sem);
+    furi_semaphore_free(usb_uart->tx_buf_sem);
 
     furi_hal_usb_unlock();
     furi_check(furi_hal_usb_set_config(&usb_cdc_single, NULL) == true);
@@ -315,35 +371,62 @@ static int32_t usb_uart_worker(void* context) {
     return 0;
 }
 
+static void usb_uart_on_dma_tx_cb(FuriHalSerialHandle* handle, void* context) {
+    UNUSED(handle);
+    UsbUartBridge* usb_uart = (UsbUartBridge*)context;
+    furi_semaphore_release(usb_uart->tx_buf_sem);
+    furi_thread_flags_set(furi_thread_get_id(usb_uart->tx_thread), WorkerEvtTxDone);
+}
+
 static int32_t usb_uart_tx_thread(void* context) {
     UsbUartBridge* usb_uart = (UsbUartBridge*)context;
 
-    uint8_t data[USB_CDC_PKT_LEN];
     while(1) {
         uint32_t events =
             furi_thread_flags_wait(WORKER_ALL_TX_EVENTS, FuriFlagWaitAny, FuriWaitForever);
         furi_check(!(events & FuriFlagError));
         if(events & WorkerEvtTxStop) break;
-        if(events & WorkerEvtCdcRx) {
-            furi_check(furi_mutex_acquire(usb_uart->usb_mutex, FuriWaitForever) == FuriStatusOk);
-            size_t len = furi_hal_cdc_receive(usb_uart->cfg.vcp_ch, data, USB_CDC_PKT_LEN);
-            furi_check(furi_mutex_release(usb_uart->usb_mutex) == FuriStatusOk);
+        if(events & (WorkerEvtCdcRx | WorkerEvtTxDone)) {
+            // Buffers are completed in order, acquired one is never in flight
+            while(furi_semaphore_acquire(usb_uart->tx_buf_sem, 0) == FuriStatusOk) {
+                uint8_t* data = usb_uart->tx_buf[usb_uart->tx_buf_index];
+
+                furi_check(
+                    furi_mutex_acquire(usb_uart->usb_mutex, FuriWaitForever) == FuriStatusOk);
+                size_t len = furi_hal_cdc_receive(usb_uart->cfg.vcp_ch, data, USB_CDC_PKT_LEN);
+                furi_check(furi_mutex_release(usb_uart->usb_mutex) == FuriStatusOk);
+
+                if(len == 0) {
+                    furi_semaphore_release(usb_uart->tx_buf_sem);
+                    break;
+                }
 
-            if(len > 0) {
                 usb_uart->st.tx_cnt += len;
 
-                if(usb_uart->cfg.software_de_re != 0)
-                    furi_hal_gpio_write(USB_USART_DE_RE_PIN, false);
-
-                furi_hal_serial_tx(usb_uart->serial_handle, data, len);
-
                 if(usb_uart->cfg.software_de_re != 0) {
+                    furi_hal_gpio_write(USB_USART_DE_RE_PIN, false);
+                    furi_hal_serial_tx(usb_uart->serial_handle, data, len);
                     furi_hal_serial_tx_wait_complete(usb_uart->serial_handle);
                     furi_hal_gpio_write(USB_USART_DE_RE_PIN, true);
+                    furi_semaphore_release(usb_uart->tx_buf_sem);
+                } else if(furi_hal_serial_dma_tx(
+                              usb_uart->serial_handle,
+                              data,
+                              len,
+                              usb_uart_on_dma_tx_cb,
+                              usb_uart)) {
+                    usb_uart->tx_buf_index = (usb_uart->tx_buf_index + 1) % USB_UART_TX_BUF_COUNT;
+                } else {
+                    furi_hal_serial_tx(usb_uart->serial_handle, data, len);
+                    furi_semaphore_release(usb_uart->tx_buf_sem);
                 }
             }
         }
     }
+
+    // Return in-flight buffers before serial or thread is restarted
+    furi_hal_serial_tx_wait_complete(usb_uart->serial_handle);
+
     return 0;
 }
 
@@ -18,6 +18,8 @@ typedef struct {
     uint32_t rx_cnt;
     uint32_t tx_cnt;
     uint32_t baudrate_cur;
+    uint32_t rx_lost_cnt; // Bytes dropped, buffer was full or host did not read
+    uint32_t rx_overrun_cnt; // UART overrun errors
 } UsbUartState;
 
 UsbUartBridge* usb_uart_enable(UsbUartConfig* cfg);
@@ -14,6 +14,8 @@ typedef struct {
     uint32_t baudrate;
     uint32_t tx_cnt;
     uint32_t rx_cnt;
+    uint32_t rx_lost_cnt;
+    uint32_t rx_overrun_cnt;
     uint8_t vcp_port;
     uint8_t tx_pin;
     uint8_t rx_pin;
@@ -75,6 +77,20 @@ static void gpio_usb_uart_draw_callback(Canvas* canvas, void* _model) {
         canvas_draw_str_aligned(canvas, 111, 41, AlignRight, AlignBottom, temp_str);
     }
 
+    canvas_set_font(canvas, FontSecondary);
+    if(model->rx_lost_cnt > 0) {
+        // Arrow icon is right next to it, keep it short
+        if(model->rx_lost_cnt < 10000)
+            snprintf(temp_str, 18, "Lost:%lu", model->rx_lost_cnt);
+        else
+            snprintf(temp_str, 18, "Lost:%luK", model->rx_lost_cnt / 1000);
+        canvas_draw_str(canvas, 3, 51, temp_str);
+    }
+    if(model->rx_overrun_cnt > 0) {
+        snprintf(temp_str, 18, "Ovr:%lu", model->rx_overrun_cnt);
+        canvas_draw_str_aligned(canvas, 127, 51, AlignRight, AlignBottom, temp_str);
+    }
+
     if(model->tx_active)
         canvas_draw_icon(canvas, 48, 14, &I_ArrowUpFilled_14x15);
     else
@@ -157,6 +173,8 @@ void gpio_usb_uart_update_state(GpioUsbUart* instance, UsbUartConfig* cfg, UsbUa
             model->rx_active = (model->rx_cnt != st->rx_cnt);
             model->tx_cnt = st->tx_cnt;
             model->rx_cnt = st->rx_cnt;
+            model->rx_lost_cnt = st->rx_lost_cnt;
+            model->rx_overrun_cnt = st->rx_overrun_cnt;
         },
         true);
 }
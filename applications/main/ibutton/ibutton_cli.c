@@ -8,6 +8,13 @@
 #include <ibutton/ibutton_worker.h>
 #include <ibutton/ibutton_protocols.h>
 
+#include <storage/storage.h>
+
+#define IBUTTON_CLI_SEQUENCE_KEYS_MAX  32
+#define IBUTTON_CLI_SEQUENCE_DWELL_MS  2000
+#define IBUTTON_CLI_FILE_NAME_SIZE     256
+#define IBUTTON_CLI_FILENAME_EXTENSION ".ibtn"
+
 static void ibutton_cli(Cli* cli, FuriString* args, void* context);
 
 // app cli function
@@ -25,6 +32,7 @@ static void ibutton_cli_print_usage(void) {
     printf("Usage:\r\n");
     printf("ikey read\r\n");
     printf("ikey emulate <key_type> <key_data>\r\n");
+    printf("ikey emulate_dir <folder> <optional: dwell_ms>\r\n");
     printf("ikey write Dallas <key_data>\r\n");
     printf("\t<key_type> choose from:\r\n");
     printf("\tDallas (8 bytes key_data)\r\n");
@@ -228,6 +236,124 @@ void ibutton_cli_emulate(Cli* cli, FuriString* args) {
     ibutton_protocols_free(protocols);
 }
 
+static size_t ibutton_cli_load_keys(
+    iButtonProtocols* protocols,
+    const char* folder,
+    iButtonKey** keys,
+    FuriString** names) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* dir = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    size_t count = 0;
+
+    if(storage_dir_open(dir, folder)) {
+        FileInfo file_info;
+        char file_name[IBUTTON_CLI_FILE_NAME_SIZE];
+
+        while((count < IBUTTON_CLI_SEQUENCE_KEYS_MAX) &&
+              storage_dir_read(dir, &file_info, file_name, sizeof(file_name))) {
+            if(file_info.flags & FSF_DIRECTORY) continue;
+
+            char* file_ext = strstr(file_name, IBUTTON_CLI_FILENAME_EXTENSION);
+            if((file_ext == NULL) || (strcmp(file_ext, IBUTTON_CLI_FILENAME_EXTENSION) != 0)) {
+                continue;
+            }
+
+            furi_string_printf(path, "%s/%s", folder, file_name);
+            if(!ibutton_protocols_load(protocols, keys[count], furi_string_get_cstr(path)) ||
+               !ibutton_protocols_is_valid(protocols, keys[count])) {
+                printf("Skipping %s: invalid key\r\n", file_name);
+                continue;
+            }
+
+            *file_ext = '\0';
+            furi_string_set(names[count], file_name);
+            count++;
+        }
+    }
+
+    storage_dir_close(dir);
+    furi_string_free(path);
+    storage_file_free(dir);
+    furi_record_close(RECORD_STORAGE);
+
+    return count;
+}
+
+void ibutton_cli_emulate_dir(Cli* cli, FuriString* args) {
+    iButtonProtocols* protocols = ibutton_protocols_alloc();
+    iButtonWorker* worker = ibutton_worker_alloc(protocols);
+    const size_t max_data_size = ibutton_protocols_get_max_data_size(protocols);
+
+    iButtonKey* keys[IBUTTON_CLI_SEQUENCE_KEYS_MAX];
+    FuriString* names[IBUTTON_CLI_SEQUENCE_KEYS_MAX];
+    uint32_t hits[IBUTTON_CLI_SEQUENCE_KEYS_MAX] = {0};
+
+    for(size_t i = 0; i < IBUTTON_CLI_SEQUENCE_KEYS_MAX; i++) {
+        keys[i] = ibutton_key_alloc(max_data_size);
+        names[i] = furi_string_alloc();
+    }
+
+    FuriString* folder = furi_string_alloc();
+
+    ibutton_worker_start_thread(worker);
+
+    do {
+        if(!args_read_probably_quoted_string_and_trim(args, folder)) {
+            ibutton_cli_print_usage();
+            break;
+        }
+
+        int dwell_ms = IBUTTON_CLI_SEQUENCE_DWELL_MS;
+        if(furi_string_size(args) && (!args_read_int_and_trim(args, &dwell_ms) || dwell_ms <= 0)) {
+            ibutton_cli_print_usage();
+            break;
+        }
+
+        // All keys are loaded upfront, so there is no gap between them
+        const size_t count =
+            ibutton_cli_load_keys(protocols, furi_string_get_cstr(folder), keys, names);
+        if(count == 0) {
+            printf("No keys found\r\n");
+            break;
+        }
+
+        printf("Emulating %zu keys, %dms each\r\n", count, dwell_ms);
+        printf("Press Ctrl+C to abort\r\n");
+
+        ibutton_worker_emulate_sequence_start(worker, keys, count, dwell_ms, hits);
+
+        size_t last_index = SIZE_MAX;
+        while(!cli_cmd_interrupt_received(cli)) {
+            const size_t index = ibutton_worker_emulate_sequence_get_index(worker);
+            if(index != last_index) {
+                printf("%s ", furi_string_get_cstr(names[index]));
+                ibutton_cli_print_key(protocols, keys[index]);
+                last_index = index;
+            }
+            furi_delay_ms(100);
+        }
+
+        ibutton_worker_stop(worker);
+
+        printf("Reader hits:\r\n");
+        for(size_t i = 0; i < count; i++) {
+            printf("%s: %lu\r\n", furi_string_get_cstr(names[i]), hits[i]);
+        }
+    } while(false);
+
+    ibutton_worker_stop_thread(worker);
+
+    for(size_t i = 0; i < IBUTTON_CLI_SEQUENCE_KEYS_MAX; i++) {
+        ibutton_key_free(keys[i]);
+        furi_string_free(names[i]);
+    }
+
+    furi_string_free(folder);
+    ibutton_worker_free(worker);
+    ibutton_protocols_free(protocols);
+}
+
 void ibutton_cli(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
     UNUSED(context);
@@ -246,6 +372,8 @@ void ibutton_cli(Cli* cli, FuriString* args, void* context) {
         ibutton_cli_write(cli, args);
     } else if(furi_string_cmp_str(cmd, "emulate") == 0) {
         ibutton_cli_emulate(cli, args);
+    } else if(furi_string_cmp_str(cmd, "emulate_dir") == 0) {
+        ibutton_cli_emulate_dir(cli, args);
     } else {
         ibutton_cli_print_usage();
     }
@@ -3,12 +3,33 @@
 #include <stdlib.h>
 #include <m-dict.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/buffered_file_stream.h>
+#include <infrared_transmit.h>
 
 #include "infrared_signal.h"
 
+// Signal offsets cache, stored next to the database
+#define INFRARED_BRUTE_FORCE_INDEX_EXT     ".idx"
+#define INFRARED_BRUTE_FORCE_INDEX_MAGIC   (0x58445249UL) // "IRDX"
+#define INFRARED_BRUTE_FORCE_INDEX_VERSION (1UL)
+
+// Enough for a single transmission of any supported protocol
+#define INFRARED_BRUTE_FORCE_TIMINGS_SIZE (512U)
+#define INFRARED_BRUTE_FORCE_SLOT_COUNT   (2U)
+
+// Followed by entries: uint32_t offset, uint8_t name size, name without terminator
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t db_size;
+    uint32_t db_timestamp;
+} InfraredBruteForceIndexHeader;
+
 typedef struct {
     uint32_t index;
     uint32_t count;
+    uint32_t* offsets; // Signal positions in database file
 } InfraredBruteForceRecord;
 
 DICT_DEF2(
@@ -18,20 +39,176 @@ DICT_DEF2(
     InfraredBruteForceRecord,
     M_POD_OPLIST);
 
+// Signal read from database and ready to be sent
+typedef struct {
+    InfraredSignal* signal;
+    uint32_t* timings; // Rendered message, raw signals are sent as is
+    size_t timings_count;
+    bool is_ready;
+} InfraredBruteForceSlot;
+
 struct InfraredBruteForce {
     FlipperFormat* ff;
     const char* db_filename;
     FuriString* current_record_name;
-    InfraredSignal* current_signal;
+    InfraredBruteForceSlot slots[INFRARED_BRUTE_FORCE_SLOT_COUNT];
+    uint32_t current_slot;
+    const InfraredBruteForceRecord* current_record;
+    uint32_t current_position;
     InfraredBruteForceRecordDict_t records;
     bool is_started;
 };
 
+static void infrared_brute_force_record_add_offset(
+    InfraredBruteForceRecord* record,
+    uint32_t offset) {
+    // Capacity doubles each time count reaches a power of two
+    if((record->count & (record->count - 1)) == 0) {
+        const size_t capacity = record->count ? record->count * 2 : 1;
+        record->offsets = realloc(record->offsets, capacity * sizeof(uint32_t)); //-V701
+    }
+    record->offsets[record->count++] = offset;
+}
+
+static void infrared_brute_force_clear_offsets(InfraredBruteForce* brute_force) {
+    InfraredBruteForceRecordDict_it_t it;
+    for(InfraredBruteForceRecordDict_it(it, brute_force->records);
+        !InfraredBruteForceRecordDict_end_p(it);
+        InfraredBruteForceRecordDict_next(it)) {
+        InfraredBruteForceRecord* record = &InfraredBruteForceRecordDict_ref(it)->value;
+        free(record->offsets);
+        record->offsets = NULL;
+        record->count = 0;
+    }
+}
+
+static bool infrared_brute_force_load_index(
+    InfraredBruteForce* brute_force,
+    Stream* stream,
+    const char* index_path,
+    const InfraredBruteForceIndexHeader* expected) {
+    FuriString* signal_name = furi_string_alloc();
+    char* name = malloc(UINT8_MAX + 1);
+    bool success = false;
+
+    do {
+        if(!buffered_file_stream_open(stream, index_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        InfraredBruteForceIndexHeader header;
+        if(stream_read(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+        if(memcmp(&header, expected, sizeof(header)) != 0) break;
+
+        while(true) {
+            uint32_t offset;
+            uint8_t name_size;
+
+            const size_t read = stream_read(stream, (uint8_t*)&offset, sizeof(offset));
+            if(read == 0) {
+                success = true;
+                break;
+            }
+
+            if(read != sizeof(offset)) break;
+            if(stream_read(stream, &name_size, sizeof(name_size)) != sizeof(name_size)) break;
+            if(stream_read(stream, (uint8_t*)name, name_size) != name_size) break;
+
+            name[name_size] = '\0';
+            furi_string_set(signal_name, name);
+
+            InfraredBruteForceRecord* record =
+                InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
+            if(record) {
+                infrared_brute_force_record_add_offset(record, offset);
+            }
+        }
+    } while(false);
+
+    buffered_file_stream_close(stream);
+    free(name);
+    furi_string_free(signal_name);
+
+    return success;
+}
+
+static bool infrared_brute_force_write_index_entry(
+    Stream* stream,
+    uint32_t offset,
+    const FuriString* signal_name) {
+    const size_t name_size = furi_string_size(signal_name);
+    if(name_size > UINT8_MAX) return false;
+
+    const uint8_t name_size_byte = name_size;
+    return stream_write(stream, (const uint8_t*)&offset, sizeof(offset)) == sizeof(offset) &&
+           stream_write(stream, &name_size_byte, sizeof(name_size_byte)) ==
+               sizeof(name_size_byte) &&
+           stream_write(stream, (const uint8_t*)furi_string_get_cstr(signal_name), name_size) ==
+               name_size;
+}
+
+static InfraredErrorCode infrared_brute_force_parse_db(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    Stream* index_stream,
+    const char* index_path,
+    const InfraredBruteForceIndexHeader* header) {
+    InfraredErrorCode error = InfraredErrorCodeNone;
+
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* signal_name = furi_string_alloc();
+    InfraredSignal* signal = infrared_signal_alloc();
+
+    // Index is a cache, database is still usable if it can't be written
+    bool index_valid =
+        buffered_file_stream_open(index_stream, index_path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+        stream_write(index_stream, (const uint8_t*)header, sizeof(*header)) == sizeof(*header);
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, brute_force->db_filename)) {
+            error = InfraredErrorCodeFileOperationFailed;
+            break;
+        }
+
+        Stream* db_stream = flipper_format_get_raw_stream(ff);
+
+        bool signals_valid = false;
+        uint32_t offset = stream_tell(db_stream);
+        while(infrared_signal_read_name(ff, signal_name) == InfraredErrorCodeNone) {
+            error = infrared_signal_read_body(signal, ff);
+            signals_valid = (!INFRARED_ERROR_PRESENT(error)) && infrared_signal_is_valid(signal);
+            if(!signals_valid) break;
+
+            InfraredBruteForceRecord* record =
+                InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
+            if(record) { //-V547
+                infrared_brute_force_record_add_offset(record, offset);
+            }
+
+            if(index_valid) {
+                index_valid =
+                    infrared_brute_force_write_index_entry(index_stream, offset, signal_name);
+            }
+
+            offset = stream_tell(db_stream);
+        }
+        if(!signals_valid) break;
+    } while(false);
+
+    index_valid = buffered_file_stream_close(index_stream) && index_valid;
+    if(INFRARED_ERROR_PRESENT(error) || !index_valid) {
+        storage_common_remove(storage, index_path);
+    }
+
+    infrared_signal_free(signal);
+    furi_string_free(signal_name);
+    flipper_format_free(ff);
+
+    return error;
+}
+
 InfraredBruteForce* infrared_brute_force_alloc(void) {
     InfraredBruteForce* brute_force = malloc(sizeof(InfraredBruteForce));
     brute_force->ff = NULL;
     brute_force->db_filename = NULL;
-    brute_force->current_signal = NULL;
     brute_force->is_started = false;
     brute_force->current_record_name = furi_string_alloc();
     InfraredBruteForceRecordDict_init(brute_force->records);
@@ -40,6 +217,7 @@ InfraredBruteForce* infrared_brute_force_alloc(void) {
 
 void infrared_brute_force_free(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
+    infrared_brute_force_clear_offsets(brute_force);
     InfraredBruteForceRecordDict_clear(brute_force->records);
     furi_string_free(brute_force->current_record_name);
     free(brute_force);
@@ -56,35 +234,40 @@ InfraredErrorCode infrared_brute_force_calculate_messages(InfraredBruteForce* br
     InfraredErrorCode error = InfraredErrorCodeNone;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
-    FuriString* signal_name = furi_string_alloc();
-    InfraredSignal* signal = infrared_signal_alloc();
+    Stream* index_stream = buffered_file_stream_alloc(storage);
+    FuriString* index_path =
+        furi_string_alloc_printf("%s%s", brute_force->db_filename, INFRARED_BRUTE_FORCE_INDEX_EXT);
+
+    infrared_brute_force_clear_offsets(brute_force);
 
     do {
-        if(!flipper_format_buffered_file_open_existing(ff, brute_force->db_filename)) {
+        FileInfo db_info;
+        InfraredBruteForceIndexHeader header = {
+            .magic = INFRARED_BRUTE_FORCE_INDEX_MAGIC,
+            .version = INFRARED_BRUTE_FORCE_INDEX_VERSION,
+        };
+
+        if(storage_common_stat(storage, brute_force->db_filename, &db_info) != FSE_OK ||
+           storage_common_timestamp(storage, brute_force->db_filename, &header.db_timestamp) !=
+               FSE_OK) {
             error = InfraredErrorCodeFileOperationFailed;
             break;
         }
+        header.db_size = db_info.size;
 
-        bool signals_valid = false;
-        while(infrared_signal_read_name(ff, signal_name) == InfraredErrorCodeNone) {
-            error = infrared_signal_read_body(signal, ff);
-            signals_valid = (!INFRARED_ERROR_PRESENT(error)) && infrared_signal_is_valid(signal);
-            if(!signals_valid) break;
-
-            InfraredBruteForceRecord* record =
-                InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
-            if(record) { //-V547
-                ++(record->count);
-            }
+        // Index matches database: no need to parse it
+        if(infrared_brute_force_load_index(
+               brute_force, index_stream, furi_string_get_cstr(index_path), &header)) {
+            break;
         }
-        if(!signals_valid) break;
-    } while(false);
 
-    infrared_signal_free(signal);
-    furi_string_free(signal_name);
+        infrared_brute_force_clear_offsets(brute_force);
+        error = infrared_brute_force_parse_db(
+            brute_force, storage, index_stream, furi_string_get_cstr(index_path), &header);
+    } while(false);
 
-    flipper_format_free(ff);
+    furi_string_free(index_path);
+    stream_free(index_stream);
     furi_record_close(RECORD_STORAGE);
     return error;
 }
@@ -106,6 +289,8 @@ bool infrared_brute_force_start(
             *record_count = record->value.count;
             if(*record_count) {
                 furi_string_set(brute_force->current_record_name, record->key);
+                brute_force->current_record = &record->value;
+                brute_force->current_position = 0;
             }
             break;
         }
@@ -114,7 +299,13 @@ bool infrared_brute_force_start(
     if(*record_count) {
         Storage* storage = furi_record_open(RECORD_STORAGE);
         brute_force->ff = flipper_format_buffered_file_alloc(storage);
-        brute_force->current_signal = infrared_signal_alloc();
+        for(size_t i = 0; i < INFRARED_BRUTE_FORCE_SLOT_COUNT; i++) {
+            InfraredBruteForceSlot* slot = &brute_force->slots[i];
+            slot->signal = infrared_signal_alloc();
+            slot->timings = malloc(INFRARED_BRUTE_FORCE_TIMINGS_SIZE * sizeof(uint32_t));
+            slot->is_ready = false;
+        }
+        brute_force->current_slot = 0;
         brute_force->is_started = true;
         success =
             flipper_format_buffered_file_open_existing(brute_force->ff, brute_force->db_filename);
@@ -130,33 +321,97 @@ bool infrared_brute_force_is_started(const InfraredBruteForce* brute_force) {
 void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
     furi_string_reset(brute_force->current_record_name);
-    infrared_signal_free(brute_force->current_signal);
+    brute_force->current_record = NULL;
+    for(size_t i = 0; i < INFRARED_BRUTE_FORCE_SLOT_COUNT; i++) {
+        InfraredBruteForceSlot* slot = &brute_force->slots[i];
+        infrared_signal_free(slot->signal);
+        free(slot->timings);
+        slot->signal = NULL;
+        slot->timings = NULL;
+    }
     flipper_format_free(brute_force->ff);
-    brute_force->current_signal = NULL;
     brute_force->ff = NULL;
     brute_force->is_started = false;
     furi_record_close(RECORD_STORAGE);
 }
 
-bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
-    furi_assert(brute_force->is_started);
+static bool infrared_brute_force_prepare_next(
+    InfraredBruteForce* brute_force,
+    InfraredBruteForceSlot* slot) {
+    const InfraredBruteForceRecord* record = brute_force->current_record;
+    if(brute_force->current_position >= record->count) return false;
+
+    // Jump straight to the signal instead of searching for it by name
+    const uint32_t offset = record->offsets[brute_force->current_position];
+    Stream* stream = flipper_format_get_raw_stream(brute_force->ff);
 
-    const bool success = infrared_signal_search_by_name_and_read(
-                             brute_force->current_signal,
-                             brute_force->ff,
-                             furi_string_get_cstr(brute_force->current_record_name)) ==
+    slot->is_ready = stream_seek(stream, offset, StreamOffsetFromStart) &&
+                     infrared_signal_search_by_name_and_read(
+                         slot->signal,
+                         brute_force->ff,
+                         furi_string_get_cstr(brute_force->current_record_name)) ==
                          InfraredErrorCodeNone;
-    if(success) {
-        infrared_signal_transmit(brute_force->current_signal);
+
+    if(slot->is_ready) {
+        brute_force->current_position++;
+        // Run the encoder now, not from the transmission interrupt
+        slot->timings_count =
+            infrared_signal_is_raw(slot->signal) ?
+                0 :
+                infrared_render(
+                    infrared_signal_get_message(slot->signal),
+                    slot->timings,
+                    INFRARED_BRUTE_FORCE_TIMINGS_SIZE);
     }
-    return success;
+
+    return slot->is_ready;
+}
+
+// Returns false if signal was sent synchronously
+static bool infrared_brute_force_send_start(const InfraredBruteForceSlot* slot) {
+    if(infrared_signal_is_raw(slot->signal)) {
+        const InfraredRawSignal* raw = infrared_signal_get_raw_signal(slot->signal);
+        infrared_send_raw_ext_async(
+            raw->timings, raw->timings_size, true, raw->frequency, raw->duty_cycle);
+    } else if(slot->timings_count) {
+        const InfraredMessage* message = infrared_signal_get_message(slot->signal);
+        infrared_send_rendered_async(
+            slot->timings,
+            slot->timings_count,
+            infrared_get_protocol_frequency(message->protocol),
+            infrared_get_protocol_duty_cycle(message->protocol));
+    } else {
+        // Didn't fit into the buffer, encode on the fly
+        infrared_signal_transmit(slot->signal);
+        return false;
+    }
+
+    return true;
+}
+
+bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
+    furi_assert(brute_force->is_started);
+
+    InfraredBruteForceSlot* slot = &brute_force->slots[brute_force->current_slot];
+    if(!slot->is_ready && !infrared_brute_force_prepare_next(brute_force, slot)) return false;
+
+    slot->is_ready = false;
+    const bool is_async = infrared_brute_force_send_start(slot);
+
+    // Read the next signal while the current one is being transmitted
+    brute_force->current_slot = (brute_force->current_slot + 1) % INFRARED_BRUTE_FORCE_SLOT_COUNT;
+    infrared_brute_force_prepare_next(brute_force, &brute_force->slots[brute_force->current_slot]);
+
+    if(is_async) infrared_send_wait();
+
+    return true;
 }
 
 void infrared_brute_force_add_record(
     InfraredBruteForce* brute_force,
     uint32_t index,
     const char* name) {
-    InfraredBruteForceRecord value = {.index = index, .count = 0};
+    InfraredBruteForceRecord value = {.index = index, .count = 0, .offsets = NULL};
     FuriString* key;
     key = furi_string_alloc_set(name);
     InfraredBruteForceRecordDict_set_at(brute_force->records, key, value);
@@ -165,5 +420,6 @@ void infrared_brute_force_add_record(
 
 void infrared_brute_force_reset(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
+    infrared_brute_force_clear_offsets(brute_force);
     InfraredBruteForceRecordDict_reset(brute_force->records);
 }
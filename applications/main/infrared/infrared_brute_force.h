@@ -45,6 +45,9 @@ void infrared_brute_force_set_db_filename(InfraredBruteForce* brute_force, const
  * This function must be called each time after setting the database via
  * a infrared_brute_force_set_db_filename() call.
  *
+ * Signal positions are cached in a binary index file next to the database,
+ * so the database is only parsed again when its size or timestamp changes.
+ *
  * @param[in,out] brute_force pointer to the instance to be updated.
  * @returns InfraredErrorCodeNone on success, otherwise error code.
  */
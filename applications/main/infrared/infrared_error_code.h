@@ -32,6 +32,10 @@ typedef enum {
     InfraredErrorCodeSignalMessageUnableToWriteProtocol = 0x80001300,
     InfraredErrorCodeSignalMessageUnableToWriteAddress = 0x80001400,
     InfraredErrorCodeSignalMessageUnableToWriteCommand = 0x80001500,
+
+    //Packed raw signal errors
+    InfraredErrorCodeSignalRawUnableToReadSymbols = 0x80001600,
+    InfraredErrorCodeSignalRawUnableToWriteSymbols = 0x80001700,
 } InfraredErrorCode;
 
 #define INFRARED_ERROR_CODE_MASK  (0xFFFFFF00)
@@ -13,14 +13,35 @@
 #define INFRARED_SIGNAL_TYPE_KEY "type"
 
 // Type key values
-#define INFRARED_SIGNAL_TYPE_RAW    "raw"
-#define INFRARED_SIGNAL_TYPE_PARSED "parsed"
+#define INFRARED_SIGNAL_TYPE_RAW        "raw"
+#define INFRARED_SIGNAL_TYPE_RAW_PACKED "raw_packed"
+#define INFRARED_SIGNAL_TYPE_PARSED     "parsed"
 
 // Raw signal keys
 #define INFRARED_SIGNAL_DATA_KEY       "data"
 #define INFRARED_SIGNAL_FREQUENCY_KEY  "frequency"
 #define INFRARED_SIGNAL_DUTY_CYCLE_KEY "duty_cycle"
 
+// Raw data is read in chunks of this many values
+#define INFRARED_SIGNAL_READ_CHUNK_SIZE (64U)
+
+// Packed raw signal keys, data holds two symbol indices per byte, high nibble first
+#define INFRARED_SIGNAL_SYMBOLS_KEY "symbols"
+
+// Shorter signals are not worth packing
+#define INFRARED_SIGNAL_PACK_TIMINGS_MIN (64U)
+// Last nibble value pads odd timings count
+#define INFRARED_SIGNAL_PACK_SYMBOLS_MAX (15U)
+#define INFRARED_SIGNAL_PACK_PADDING     (0xFU)
+// Timing is quantized to symbol if it differs by no more than 1/8 of it
+#define INFRARED_SIGNAL_PACK_TOLERANCE_SHIFT (3U)
+#define INFRARED_SIGNAL_PACK_TOLERANCE_MIN   (50U)
+
+typedef struct {
+    uint32_t durations[INFRARED_SIGNAL_PACK_SYMBOLS_MAX];
+    size_t count;
+} InfraredSignalSymbols;
+
 // Parsed signal keys
 #define INFRARED_SIGNAL_PROTOCOL_KEY "protocol"
 #define INFRARED_SIGNAL_ADDRESS_KEY  "address"
@@ -134,14 +155,100 @@ static inline InfraredErrorCode
     return error;
 }
 
+static inline bool infrared_signal_symbol_match(uint32_t symbol, uint32_t timing) {
+    const uint32_t tolerance =
+        MAX(symbol >> INFRARED_SIGNAL_PACK_TOLERANCE_SHIFT, INFRARED_SIGNAL_PACK_TOLERANCE_MIN);
+    return (timing > symbol ? timing - symbol : symbol - timing) <= tolerance;
+}
+
+static size_t
+    infrared_signal_symbol_find(const InfraredSignalSymbols* symbols, uint32_t timing) {
+    size_t index = symbols->count;
+    uint32_t best_diff = UINT32_MAX;
+
+    for(size_t i = 0; i < symbols->count; ++i) {
+        const uint32_t symbol = symbols->durations[i];
+        const uint32_t diff = timing > symbol ? timing - symbol : symbol - timing;
+        if(infrared_signal_symbol_match(symbol, timing) && (diff < best_diff)) {
+            index = i;
+            best_diff = diff;
+        }
+    }
+
+    return index;
+}
+
+// Returns false if timings don't quantize to a small alphabet, raw data is saved as is then
+static bool
+    infrared_signal_learn_symbols(const InfraredRawSignal* raw, InfraredSignalSymbols* symbols) {
+    uint64_t sums[INFRARED_SIGNAL_PACK_SYMBOLS_MAX] = {0};
+    uint32_t counts[INFRARED_SIGNAL_PACK_SYMBOLS_MAX] = {0};
+    symbols->count = 0;
+
+    // Cluster timings around running averages
+    for(size_t i = 0; i < raw->timings_size; ++i) {
+        const uint32_t timing = raw->timings[i];
+        size_t index = infrared_signal_symbol_find(symbols, timing);
+
+        if(index == symbols->count) {
+            if(symbols->count == INFRARED_SIGNAL_PACK_SYMBOLS_MAX) return false;
+            ++symbols->count;
+        }
+
+        sums[index] += timing;
+        counts[index]++;
+        symbols->durations[index] = (sums[index] + counts[index] / 2) / counts[index];
+    }
+
+    // Averages have moved, every timing must still be close to its symbol
+    for(size_t i = 0; i < raw->timings_size; ++i) {
+        if(infrared_signal_symbol_find(symbols, raw->timings[i]) == symbols->count) return false;
+    }
+
+    return true;
+}
+
+static inline InfraredErrorCode infrared_signal_save_raw_packed(
+    const InfraredRawSignal* raw,
+    const InfraredSignalSymbols* symbols,
+    FlipperFormat* ff) {
+    const size_t packed_size = (raw->timings_size + 1) / 2;
+    uint8_t* packed = malloc(packed_size);
+
+    for(size_t i = 0; i < raw->timings_size; ++i) {
+        const uint8_t index = infrared_signal_symbol_find(symbols, raw->timings[i]);
+        packed[i / 2] |= (i % 2) ? index : (index << 4);
+    }
+    if(raw->timings_size % 2) {
+        packed[packed_size - 1] |= INFRARED_SIGNAL_PACK_PADDING;
+    }
+
+    InfraredErrorCode error = InfraredErrorCodeNone;
+    if(!flipper_format_write_uint32(
+           ff, INFRARED_SIGNAL_SYMBOLS_KEY, symbols->durations, symbols->count)) {
+        error = InfraredErrorCodeSignalRawUnableToWriteSymbols;
+    } else if(!flipper_format_write_hex(ff, INFRARED_SIGNAL_DATA_KEY, packed, packed_size)) {
+        error = InfraredErrorCodeSignalRawUnableToWriteData;
+    }
+
+    free(packed);
+    return error;
+}
+
 static inline InfraredErrorCode
     infrared_signal_save_raw(const InfraredRawSignal* raw, FlipperFormat* ff) {
     furi_assert(raw->timings_size <= MAX_TIMINGS_AMOUNT);
 
+    InfraredSignalSymbols symbols;
+    const bool is_packed = (raw->timings_size >= INFRARED_SIGNAL_PACK_TIMINGS_MIN) &&
+                           infrared_signal_learn_symbols(raw, &symbols);
+
     InfraredErrorCode error = InfraredErrorCodeNone;
     do {
         if(!flipper_format_write_string_cstr(
-               ff, INFRARED_SIGNAL_TYPE_KEY, INFRARED_SIGNAL_TYPE_RAW)) {
+               ff,
+               INFRARED_SIGNAL_TYPE_KEY,
+               is_packed ? INFRARED_SIGNAL_TYPE_RAW_PACKED : INFRARED_SIGNAL_TYPE_RAW)) {
             error = InfraredErrorCodeSignalUnableToWriteType;
             break;
         }
@@ -156,8 +263,10 @@ static inline InfraredErrorCode
             break;
         }
 
-        if(!flipper_format_write_uint32(
-               ff, INFRARED_SIGNAL_DATA_KEY, raw->timings, raw->timings_size)) {
+        if(is_packed) {
+            error = infrared_signal_save_raw_packed(raw, &symbols, ff);
+        } else if(!flipper_format_write_uint32(
+                      ff, INFRARED_SIGNAL_DATA_KEY, raw->timings, raw->timings_size)) {
             error = InfraredErrorCodeSignalRawUnableToWriteData;
             break;
         }
@@ -203,8 +312,74 @@ static inline InfraredErrorCode
     return error;
 }
 
+static bool infrared_signal_read_raw_packed_timings(
+    FlipperFormat* ff,
+    uint32_t* timings,
+    uint32_t* timings_size,
+    InfraredErrorCode* error) {
+    InfraredSignalSymbols symbols;
+    bool success = false;
+
+    do {
+        uint32_t symbols_count;
+        if(!flipper_format_get_value_count(ff, INFRARED_SIGNAL_SYMBOLS_KEY, &symbols_count) ||
+           (symbols_count == 0) || (symbols_count > INFRARED_SIGNAL_PACK_SYMBOLS_MAX) ||
+           !flipper_format_read_uint32(
+               ff, INFRARED_SIGNAL_SYMBOLS_KEY, symbols.durations, symbols_count)) {
+            *error = InfraredErrorCodeSignalRawUnableToReadSymbols;
+            break;
+        }
+        symbols.count = symbols_count;
+
+        if(!flipper_format_read_array_start(ff, INFRARED_SIGNAL_DATA_KEY)) {
+            *error = InfraredErrorCodeSignalRawUnableToReadTimingsSize;
+            break;
+        }
+
+        // Data is unpacked as it is read, without buffering all of it
+        uint8_t packed[INFRARED_SIGNAL_READ_CHUNK_SIZE];
+        size_t packed_size = 0;
+        size_t count = 0;
+        bool padded = false;
+        *error = InfraredErrorCodeNone;
+
+        while(*error == InfraredErrorCodeNone) {
+            if(!flipper_format_read_array_hex(ff, packed, sizeof(packed), &packed_size)) {
+                *error = InfraredErrorCodeSignalRawUnableToReadData;
+            } else if(packed_size == 0) {
+                break;
+            }
+
+            for(size_t i = 0; (*error == InfraredErrorCodeNone) && (i < packed_size * 2); ++i) {
+                const uint8_t index = (i % 2) ? (packed[i / 2] & 0xF) : (packed[i / 2] >> 4);
+                if(padded) {
+                    // Only the very last nibble can be padding
+                    *error = InfraredErrorCodeSignalRawUnableToReadData;
+                } else if(index >= symbols.count) {
+                    padded = true;
+                } else if(count == MAX_TIMINGS_AMOUNT) {
+                    *error = InfraredErrorCodeSignalRawUnableToReadTooLongData;
+                } else {
+                    timings[count++] = symbols.durations[index];
+                }
+            }
+        }
+
+        if(*error != InfraredErrorCodeNone) break;
+        if(count == 0) {
+            *error = InfraredErrorCodeSignalRawUnableToReadData;
+            break;
+        }
+
+        *timings_size = count;
+        success = true;
+    } while(false);
+
+    return success;
+}
+
 static inline InfraredErrorCode
-    infrared_signal_read_raw(InfraredSignal* signal, FlipperFormat* ff) {
+    infrared_signal_read_raw(InfraredSignal* signal, FlipperFormat* ff, bool is_packed) {
     InfraredErrorCode error = InfraredErrorCodeNone;
 
     do {
@@ -221,19 +396,51 @@ static inline InfraredErrorCode
         }
 
         uint32_t timings_size;
-        if(!flipper_format_get_value_count(ff, INFRARED_SIGNAL_DATA_KEY, &timings_size)) {
-            error = InfraredErrorCodeSignalRawUnableToReadTimingsSize;
+        if(is_packed) {
+            uint32_t* timings = malloc(sizeof(uint32_t) * (MAX_TIMINGS_AMOUNT + 1));
+            if(infrared_signal_read_raw_packed_timings(ff, timings, &timings_size, &error)) {
+                infrared_signal_set_raw_signal(
+                    signal, timings, timings_size, frequency, duty_cycle);
+            }
+            free(timings);
             break;
         }
 
-        if(timings_size > MAX_TIMINGS_AMOUNT) {
-            error = InfraredErrorCodeSignalRawUnableToReadTooLongData;
+        if(!flipper_format_read_array_start(ff, INFRARED_SIGNAL_DATA_KEY)) {
+            error = InfraredErrorCodeSignalRawUnableToReadTimingsSize;
             break;
         }
 
-        uint32_t* timings = malloc(sizeof(uint32_t) * timings_size);
-        if(!flipper_format_read_uint32(ff, INFRARED_SIGNAL_DATA_KEY, timings, timings_size)) {
+        // Timings are read in a single pass, buffer grows as needed
+        size_t capacity = 0;
+        uint32_t* timings = NULL;
+        timings_size = 0;
+        while(true) {
+            if(timings_size == capacity) {
+                if(capacity > MAX_TIMINGS_AMOUNT) {
+                    error = InfraredErrorCodeSignalRawUnableToReadTooLongData;
+                    break;
+                }
+                capacity = MIN(
+                    MAX(capacity * 2, (size_t)INFRARED_SIGNAL_READ_CHUNK_SIZE),
+                    (size_t)MAX_TIMINGS_AMOUNT + 1);
+                timings = realloc(timings, sizeof(uint32_t) * capacity); //-V701
+            }
+
+            size_t count;
+            if(!flipper_format_read_array_uint32(
+                   ff, &timings[timings_size], capacity - timings_size, &count)) {
+                error = InfraredErrorCodeSignalRawUnableToReadData;
+                break;
+            }
+            if(count == 0) break;
+            timings_size += count;
+        }
+
+        if(error == InfraredErrorCodeNone && timings_size == 0) {
             error = InfraredErrorCodeSignalRawUnableToReadData;
+        }
+        if(error != InfraredErrorCodeNone) {
             free(timings);
             break;
         }
@@ -259,7 +466,9 @@ InfraredErrorCode infrared_signal_read_body(InfraredSignal* signal, FlipperForma
         }
 
         if(furi_string_equal(tmp, INFRARED_SIGNAL_TYPE_RAW)) {
-            error = infrared_signal_read_raw(signal, ff);
+            error = infrared_signal_read_raw(signal, ff, false);
+        } else if(furi_string_equal(tmp, INFRARED_SIGNAL_TYPE_RAW_PACKED)) {
+            error = infrared_signal_read_raw(signal, ff, true);
         } else if(furi_string_equal(tmp, INFRARED_SIGNAL_TYPE_PARSED)) {
             error = infrared_signal_read_message(signal, ff);
         } else {
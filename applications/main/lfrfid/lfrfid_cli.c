@@ -27,7 +27,8 @@ static void lfrfid_cli_print_usage(void) {
     printf("Usage:\r\n");
     printf("rfid read <optional: normal | indala>         - read in ASK/PSK mode\r\n");
     printf("rfid <write | emulate> <key_type> <key_data>  - write or emulate a card\r\n");
-    printf("rfid raw_read <ask | psk> <filename>          - read and save raw data to a file\r\n");
+    printf(
+        "rfid raw_read <ask | psk> <filename> <optional: delta> - read and save raw data to a file\r\n");
     printf(
         "rfid raw_emulate <filename>                   - emulate raw data (not very useful, but helps debug protocols)\r\n");
     printf(
@@ -399,6 +400,7 @@ static void lfrfid_cli_raw_read(Cli* cli, FuriString* args) {
     filepath = furi_string_alloc();
     type_string = furi_string_alloc();
     LFRFIDWorkerReadType type = LFRFIDWorkerReadTypeAuto;
+    LFRFIDRawFileEncoding encoding = LFRFIDRawFileEncodingVarint;
 
     do {
         if(args_read_string_and_trim(args, type_string)) {
@@ -422,6 +424,15 @@ static void lfrfid_cli_raw_read(Cli* cli, FuriString* args) {
             break;
         }
 
+        if(args_read_string_and_trim(args, type_string)) {
+            if(furi_string_cmp_str(type_string, "delta") == 0) {
+                encoding = LFRFIDRawFileEncodingDelta;
+            } else {
+                lfrfid_cli_print_usage();
+                break;
+            }
+        }
+
         ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
         LFRFIDWorker* worker = lfrfid_worker_alloc(dict);
         FuriEventFlag* event = furi_event_flag_alloc();
@@ -433,8 +444,13 @@ static void lfrfid_cli_raw_read(Cli* cli, FuriString* args) {
         const uint32_t available_flags = (1 << LFRFIDWorkerReadRawFileError) |
                                          (1 << LFRFIDWorkerReadRawOverrun);
 
-        lfrfid_worker_read_raw_start(
-            worker, furi_string_get_cstr(filepath), type, lfrfid_cli_raw_read_callback, event);
+        lfrfid_worker_read_raw_start_ex(
+            worker,
+            furi_string_get_cstr(filepath),
+            type,
+            encoding,
+            lfrfid_cli_raw_read_callback,
+            event);
         while(true) {
             uint32_t flags = furi_event_flag_wait(event, available_flags, FuriFlagWaitAny, 100);
 
@@ -1,10 +1,16 @@
 #include "mf_classic_key_cache.h"
+#include "mf_classic_key_rank.h"
 
 #include <furi/furi.h>
 #include <storage/storage.h>
 
 #define NFC_APP_KEYS_EXTENSION   ".keys"
 #define NFC_APP_KEY_CACHE_FOLDER "/ext/nfc/.cache"
+#define NFC_APP_KEY_STATS_PATH   NFC_APP_KEY_CACHE_FOLDER "/.key_stats"
+
+// Keys shared by cards are remembered with the number of cards they opened
+#define MF_CLASSIC_KEY_CACHE_STATS_SIZE     (32U)
+#define MF_CLASSIC_KEY_CACHE_STATS_HITS_MIN (2U)
 
 static const char* mf_classic_key_cache_file_header = "Flipper NFC keys";
 static const uint32_t mf_classic_key_cache_file_version = 1;
@@ -35,6 +41,30 @@ void mf_classic_key_cache_free(MfClassicKeyCache* instance) {
     free(instance);
 }
 
+static void mf_classic_key_cache_stats_update(const MfClassicData* data) {
+    MfClassicKeyRank* stats =
+        mf_classic_key_rank_alloc(NFC_APP_KEY_STATS_PATH, MF_CLASSIC_KEY_CACHE_STATS_SIZE);
+    mf_classic_key_rank_add_card(stats, data);
+    mf_classic_key_rank_save(stats);
+    mf_classic_key_rank_free(stats);
+}
+
+size_t mf_classic_key_cache_get_frequent_keys(
+    MfClassicKeyCache* instance,
+    MfClassicKey* keys,
+    size_t keys_max) {
+    UNUSED(instance);
+    furi_assert(keys);
+
+    MfClassicKeyRank* stats =
+        mf_classic_key_rank_alloc(NFC_APP_KEY_STATS_PATH, MF_CLASSIC_KEY_CACHE_STATS_SIZE);
+    size_t keys_num =
+        mf_classic_key_rank_get_keys(stats, keys, keys_max, MF_CLASSIC_KEY_CACHE_STATS_HITS_MIN);
+    mf_classic_key_rank_free(stats);
+
+    return keys_num;
+}
+
 bool mf_classic_key_cache_save(MfClassicKeyCache* instance, const MfClassicData* data) {
     UNUSED(instance);
     furi_assert(data);
@@ -83,6 +113,9 @@ bool mf_classic_key_cache_save(MfClassicKeyCache* instance, const MfClassicData*
     } while(false);
 
     flipper_format_free(ff);
+    if(save_success) {
+        mf_classic_key_cache_stats_update(data);
+    }
     furi_string_free(temp_str);
     furi_string_free(file_path);
     furi_record_close(RECORD_STORAGE);
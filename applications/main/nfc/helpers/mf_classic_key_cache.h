@@ -24,6 +24,12 @@ bool mf_classic_key_cache_get_next_key(
 
 bool mf_classic_key_cache_save(MfClassicKeyCache* instance, const MfClassicData* data);
 
+// Keys that opened several saved cards, most used first
+size_t mf_classic_key_cache_get_frequent_keys(
+    MfClassicKeyCache* instance,
+    MfClassicKey* keys,
+    size_t keys_max);
+
 void mf_classic_key_cache_reset(MfClassicKeyCache* instance);
 
 #ifdef __cplusplus
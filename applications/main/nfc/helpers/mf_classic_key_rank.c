@@ -0,0 +1,190 @@
+#include "mf_classic_key_rank.h"
+
+#include <furi/furi.h>
+#include <storage/storage.h>
+
+#define MF_CLASSIC_KEY_RANK_MAGIC   (0x524B464DUL) // "MFKR"
+#define MF_CLASSIC_KEY_RANK_VERSION (1U)
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+} MfClassicKeyRankHeader;
+
+typedef struct {
+    MfClassicKey key;
+    uint32_t hits;
+} MfClassicKeyRankRecord;
+
+#pragma pack(pop)
+
+struct MfClassicKeyRank {
+    FuriString* path;
+    MfClassicKeyRankRecord* records;
+    size_t capacity;
+    size_t count;
+    bool changed;
+};
+
+static void mf_classic_key_rank_load(MfClassicKeyRank* instance) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(instance->path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        MfClassicKeyRankHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != MF_CLASSIC_KEY_RANK_MAGIC ||
+           header.version != MF_CLASSIC_KEY_RANK_VERSION)
+            break;
+
+        const size_t count = MIN((size_t)header.count, instance->capacity);
+        const size_t records_size = count * sizeof(MfClassicKeyRankRecord);
+        if(storage_file_read(file, instance->records, records_size) != records_size) break;
+
+        instance->count = count;
+    } while(false);
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MfClassicKeyRank* mf_classic_key_rank_alloc(const char* path, size_t capacity) {
+    furi_check(path);
+    furi_check(capacity > 0 && capacity <= UINT16_MAX);
+
+    MfClassicKeyRank* instance = malloc(sizeof(MfClassicKeyRank));
+    instance->path = furi_string_alloc_set_str(path);
+    instance->records = malloc(capacity * sizeof(MfClassicKeyRankRecord));
+    instance->capacity = capacity;
+
+    mf_classic_key_rank_load(instance);
+
+    return instance;
+}
+
+void mf_classic_key_rank_free(MfClassicKeyRank* instance) {
+    furi_assert(instance);
+
+    free(instance->records);
+    furi_string_free(instance->path);
+    free(instance);
+}
+
+static void mf_classic_key_rank_add_key(MfClassicKeyRank* instance, const MfClassicKey* key) {
+    MfClassicKeyRankRecord* records = instance->records;
+
+    size_t index = 0;
+    while(index < instance->count &&
+          memcmp(records[index].key.data, key->data, sizeof(MfClassicKey)) != 0) {
+        index++;
+    }
+
+    if(index < instance->count) {
+        if(records[index].hits < UINT32_MAX) records[index].hits++;
+    } else {
+        // Records are sorted, the least used key makes room
+        index = MIN(instance->count, instance->capacity - 1);
+        instance->count = index + 1;
+        records[index].key = *key;
+        records[index].hits = 1;
+    }
+
+    // Bubble up to keep descending order of hits
+    while(index > 0 && records[index - 1].hits < records[index].hits) {
+        MfClassicKeyRankRecord record = records[index - 1];
+        records[index - 1] = records[index];
+        records[index] = record;
+        index--;
+    }
+
+    instance->changed = true;
+}
+
+void mf_classic_key_rank_add_card(MfClassicKeyRank* instance, const MfClassicData* data) {
+    furi_assert(instance);
+    furi_assert(data);
+
+    // Every key counts once per card, however many sectors it opens
+    MfClassicKey card_keys[MF_CLASSIC_TOTAL_SECTORS_MAX * 2];
+    size_t card_keys_num = 0;
+    uint8_t sector_num = mf_classic_get_total_sectors_num(data->type);
+    for(size_t i = 0; i < sector_num; i++) {
+        MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(data, i);
+        const MfClassicKey* sector_keys[] = {
+            FURI_BIT(data->key_a_mask, i) ? &sec_tr->key_a : NULL,
+            FURI_BIT(data->key_b_mask, i) ? &sec_tr->key_b : NULL,
+        };
+        for(size_t j = 0; j < COUNT_OF(sector_keys); j++) {
+            const MfClassicKey* key = sector_keys[j];
+            if(key == NULL) continue;
+            bool is_new = true;
+            for(size_t k = 0; is_new && k < card_keys_num; k++) {
+                is_new = memcmp(card_keys[k].data, key->data, sizeof(MfClassicKey)) != 0;
+            }
+            if(is_new) card_keys[card_keys_num++] = *key;
+        }
+    }
+
+    for(size_t i = 0; i < card_keys_num; i++) {
+        mf_classic_key_rank_add_key(instance, &card_keys[i]);
+    }
+}
+
+size_t mf_classic_key_rank_get_keys(
+    MfClassicKeyRank* instance,
+    MfClassicKey* keys,
+    size_t keys_max,
+    uint32_t hits_min) {
+    furi_assert(instance);
+    furi_assert(keys);
+
+    size_t keys_num = 0;
+    while(keys_num < keys_max && keys_num < instance->count &&
+          instance->records[keys_num].hits >= hits_min) {
+        keys[keys_num] = instance->records[keys_num].key;
+        keys_num++;
+    }
+
+    return keys_num;
+}
+
+bool mf_classic_key_rank_save(MfClassicKeyRank* instance) {
+    furi_assert(instance);
+
+    if(!instance->changed) return true;
+
+    MfClassicKeyRankHeader header = {
+        .magic = MF_CLASSIC_KEY_RANK_MAGIC,
+        .version = MF_CLASSIC_KEY_RANK_VERSION,
+        .count = instance->count,
+    };
+    const size_t records_size = instance->count * sizeof(MfClassicKeyRankRecord);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    const char* path = furi_string_get_cstr(instance->path);
+
+    bool saved = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                 storage_file_write(file, &header, sizeof(header)) == sizeof(header) &&
+                 storage_file_write(file, instance->records, records_size) == records_size;
+
+    storage_file_free(file);
+
+    // Header count must match the records, truncated file is not kept
+    if(!saved) {
+        storage_simply_remove(storage, path);
+    } else {
+        instance->changed = false;
+    }
+
+    furi_record_close(RECORD_STORAGE);
+
+    return saved;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct MfClassicKeyRank MfClassicKeyRank;
+
+// Keys with the number of cards they opened, kept sorted by that number
+MfClassicKeyRank* mf_classic_key_rank_alloc(const char* path, size_t capacity);
+
+void mf_classic_key_rank_free(MfClassicKeyRank* instance);
+
+void mf_classic_key_rank_add_card(MfClassicKeyRank* instance, const MfClassicData* data);
+
+size_t mf_classic_key_rank_get_keys(
+    MfClassicKeyRank* instance,
+    MfClassicKey* keys,
+    size_t keys_max,
+    uint32_t hits_min);
+
+bool mf_classic_key_rank_save(MfClassicKeyRank* instance);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,48 +1,193 @@
 #include "mfkey32_logger.h"
 
 #include <m-array.h>
+#include <m-dict.h>
 
 #include <bit_lib/bit_lib.h>
 #include <stream/stream.h>
 #include <stream/buffered_file_stream.h>
 
+#define TAG "Mfkey32Logger"
+
 #define MFKEY32_LOGGER_MAX_NONCES_SAVED (100)
 
+// First halves of nonce pairs waiting for the second one, oldest are replaced
+#define MFKEY32_LOGGER_WINDOW_SIZE (8U)
+// Completed pairs waiting to be flushed to the journal
+#define MFKEY32_LOGGER_WRITE_BUFFER_SIZE (8U)
+
+#define MFKEY32_LOGGER_JOURNAL_MAGIC   (0x4A32464DUL) // "MF2J"
+#define MFKEY32_LOGGER_JOURNAL_VERSION (1U)
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+} Mfkey32LoggerJournalHeader;
+
 typedef struct {
-    bool is_filled;
     uint32_t cuid;
     uint8_t sector_num;
-    MfClassicKeyType key_type;
+    uint8_t key_type;
     uint32_t nt0;
     uint32_t nr0;
     uint32_t ar0;
     uint32_t nt1;
     uint32_t nr1;
     uint32_t ar1;
-} Mfkey32LoggerParams;
+} Mfkey32LoggerRecord;
 
-ARRAY_DEF(Mfkey32LoggerParams, Mfkey32LoggerParams, M_POD_OPLIST);
+#pragma pack(pop)
+
+typedef struct {
+    bool is_used;
+    uint8_t sector_num;
+    MfClassicKeyType key_type;
+    uint32_t nt0;
+    uint32_t nr0;
+    uint32_t ar0;
+} Mfkey32LoggerPendingParams;
+
+typedef struct {
+    uint8_t sector_num;
+    MfClassicKeyType key_type;
+} Mfkey32LoggerSector;
+
+ARRAY_DEF(Mfkey32LoggerSectors, Mfkey32LoggerSector, M_POD_OPLIST);
+DICT_SET_DEF(Mfkey32LoggerNonceSet, uint64_t, M_BASIC_OPLIST);
 
 struct Mfkey32Logger {
     uint32_t cuid;
-    Mfkey32LoggerParams_t params_arr;
+    FuriMutex* mutex;
+    Storage* storage;
+    File* journal;
+    FuriString* journal_path;
+    bool journal_ok;
+
+    Mfkey32LoggerPendingParams window[MFKEY32_LOGGER_WINDOW_SIZE];
+    size_t window_next;
+    Mfkey32LoggerRecord write_buffer[MFKEY32_LOGGER_WRITE_BUFFER_SIZE];
+    size_t write_buffer_count;
+
+    Mfkey32LoggerNonceSet_t nonces_seen;
+    Mfkey32LoggerSectors_t sectors;
     size_t nonces_saves;
     size_t params_collected;
 };
 
-Mfkey32Logger* mfkey32_logger_alloc(uint32_t cuid) {
+static uint64_t
+    mfkey32_logger_nonce_key(uint8_t sector_num, MfClassicKeyType key_type, uint32_t nt) {
+    // Logger handles a single cuid, so it is not part of the key
+    return ((uint64_t)key_type << 40) | ((uint64_t)sector_num << 32) | nt;
+}
+
+static void
+    mfkey32_logger_record_added(Mfkey32Logger* instance, const Mfkey32LoggerRecord* record) {
+    Mfkey32LoggerSector sector = {
+        .sector_num = record->sector_num,
+        .key_type = record->key_type,
+    };
+    Mfkey32LoggerSectors_push_back(instance->sectors, sector);
+
+    if(record->cuid == instance->cuid) {
+        Mfkey32LoggerNonceSet_push(
+            instance->nonces_seen,
+            mfkey32_logger_nonce_key(record->sector_num, record->key_type, record->nt0));
+        Mfkey32LoggerNonceSet_push(
+            instance->nonces_seen,
+            mfkey32_logger_nonce_key(record->sector_num, record->key_type, record->nt1));
+    }
+
+    instance->params_collected++;
+}
+
+static bool mfkey32_logger_journal_open(Mfkey32Logger* instance) {
+    bool success = false;
+    Mfkey32LoggerJournalHeader header = {
+        .magic = MFKEY32_LOGGER_JOURNAL_MAGIC,
+        .version = MFKEY32_LOGGER_JOURNAL_VERSION,
+    };
+
+    do {
+        if(!storage_file_open(
+               instance->journal,
+               furi_string_get_cstr(instance->journal_path),
+               FSAM_READ_WRITE,
+               FSOM_OPEN_ALWAYS))
+            break;
+
+        // Records left by an interrupted session are resumed
+        Mfkey32LoggerJournalHeader file_header;
+        if(storage_file_read(instance->journal, &file_header, sizeof(file_header)) ==
+               sizeof(file_header) &&
+           memcmp(&file_header, &header, sizeof(header)) == 0) {
+            Mfkey32LoggerRecord record;
+            while(storage_file_read(instance->journal, &record, sizeof(record)) ==
+                  sizeof(record)) {
+                mfkey32_logger_record_added(instance, &record);
+            }
+            if(instance->params_collected) {
+                FURI_LOG_I(TAG, "Resumed %zu nonce pairs", instance->params_collected);
+            }
+        } else {
+            if(!storage_file_seek(instance->journal, 0, true)) break;
+            if(storage_file_write(instance->journal, &header, sizeof(header)) != sizeof(header))
+                break;
+        }
+
+        // Drop a record cut by power loss, appends must stay aligned
+        const size_t records_count = Mfkey32LoggerSectors_size(instance->sectors);
+        const uint64_t journal_size =
+            sizeof(header) + records_count * sizeof(Mfkey32LoggerRecord);
+        if(!storage_file_seek(instance->journal, journal_size, true)) break;
+        if(!storage_file_truncate(instance->journal)) break;
+
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+Mfkey32Logger* mfkey32_logger_alloc(uint32_t cuid, const char* journal_path) {
+    furi_check(journal_path);
+
     Mfkey32Logger* instance = malloc(sizeof(Mfkey32Logger));
     instance->cuid = cuid;
-    Mfkey32LoggerParams_init(instance->params_arr);
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    Mfkey32LoggerNonceSet_init(instance->nonces_seen);
+    Mfkey32LoggerSectors_init(instance->sectors);
+
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->journal = storage_file_alloc(instance->storage);
+    instance->journal_path = furi_string_alloc_set_str(journal_path);
+    instance->journal_ok = mfkey32_logger_journal_open(instance);
+    if(!instance->journal_ok) {
+        FURI_LOG_E(TAG, "Journal is not available");
+        // Nothing resumed from a broken journal is trusted
+        instance->params_collected = 0;
+        Mfkey32LoggerSectors_reset(instance->sectors);
+        Mfkey32LoggerNonceSet_reset(instance->nonces_seen);
+    }
 
     return instance;
 }
 
 void mfkey32_logger_free(Mfkey32Logger* instance) {
     furi_assert(instance);
-    furi_assert(instance->params_arr);
 
-    Mfkey32LoggerParams_clear(instance->params_arr);
+    // Journal only outlives the logger if the session was interrupted
+    if(storage_file_is_open(instance->journal)) {
+        storage_file_close(instance->journal);
+    }
+    storage_file_free(instance->journal);
+    storage_common_remove(instance->storage, furi_string_get_cstr(instance->journal_path));
+    furi_string_free(instance->journal_path);
+    furi_record_close(RECORD_STORAGE);
+
+    Mfkey32LoggerSectors_clear(instance->sectors);
+    Mfkey32LoggerNonceSet_clear(instance->nonces_seen);
+    furi_mutex_free(instance->mutex);
     free(instance);
 }
 
@@ -50,30 +195,37 @@ static bool mfkey32_logger_add_nonce_to_existing_params(
     Mfkey32Logger* instance,
     MfClassicAuthContext* auth_context) {
     bool nonce_added = false;
-    do {
-        if(Mfkey32LoggerParams_size(instance->params_arr) == 0) break;
-
-        Mfkey32LoggerParams_it_t it;
-        for(Mfkey32LoggerParams_it(it, instance->params_arr); !Mfkey32LoggerParams_end_p(it);
-            Mfkey32LoggerParams_next(it)) {
-            Mfkey32LoggerParams* params = Mfkey32LoggerParams_ref(it);
-            if(params->is_filled) continue;
-
-            uint8_t sector_num = mf_classic_get_sector_by_block(auth_context->block_num);
-            if(params->sector_num != sector_num) continue;
-            if(params->key_type != auth_context->key_type) continue;
+    uint8_t sector_num = mf_classic_get_sector_by_block(auth_context->block_num);
 
-            params->nt1 = bit_lib_bytes_to_num_be(auth_context->nt.data, sizeof(MfClassicNt));
-            params->nr1 = bit_lib_bytes_to_num_be(auth_context->nr.data, sizeof(MfClassicNr));
-            params->ar1 = bit_lib_bytes_to_num_be(auth_context->ar.data, sizeof(MfClassicAr));
-            params->is_filled = true;
+    for(size_t i = 0; i < MFKEY32_LOGGER_WINDOW_SIZE; i++) {
+        Mfkey32LoggerPendingParams* params = &instance->window[i];
+        if(!params->is_used) continue;
+        if(params->sector_num != sector_num) continue;
+        if(params->key_type != auth_context->key_type) continue;
 
-            instance->params_collected++;
-            nonce_added = true;
+        if(instance->write_buffer_count == MFKEY32_LOGGER_WRITE_BUFFER_SIZE) {
+            FURI_LOG_W(TAG, "Write buffer is full");
             break;
         }
 
-    } while(false);
+        Mfkey32LoggerRecord* record = &instance->write_buffer[instance->write_buffer_count++];
+        *record = (Mfkey32LoggerRecord){
+            .cuid = instance->cuid,
+            .sector_num = params->sector_num,
+            .key_type = params->key_type,
+            .nt0 = params->nt0,
+            .nr0 = params->nr0,
+            .ar0 = params->ar0,
+            .nt1 = bit_lib_bytes_to_num_be(auth_context->nt.data, sizeof(MfClassicNt)),
+            .nr1 = bit_lib_bytes_to_num_be(auth_context->nr.data, sizeof(MfClassicNr)),
+            .ar1 = bit_lib_bytes_to_num_be(auth_context->ar.data, sizeof(MfClassicAr)),
+        };
+        params->is_used = false;
+
+        mfkey32_logger_record_added(instance, record);
+        nonce_added = true;
+        break;
+    }
 
     return nonce_added;
 }
@@ -82,75 +234,142 @@ void mfkey32_logger_add_nonce(Mfkey32Logger* instance, MfClassicAuthContext* aut
     furi_assert(instance);
     furi_assert(auth_context);
 
-    bool nonce_added = mfkey32_logger_add_nonce_to_existing_params(instance, auth_context);
-    if(!nonce_added && (instance->nonces_saves < MFKEY32_LOGGER_MAX_NONCES_SAVED)) {
-        uint8_t sector_num = mf_classic_get_sector_by_block(auth_context->block_num);
-        Mfkey32LoggerParams params = {
-            .is_filled = false,
-            .cuid = instance->cuid,
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    do {
+        // Reader repeating an authentication gives nothing new to mfkey32
+        const uint8_t sector_num = mf_classic_get_sector_by_block(auth_context->block_num);
+        const uint32_t nt = bit_lib_bytes_to_num_be(auth_context->nt.data, sizeof(MfClassicNt));
+        const uint64_t nonce_key =
+            mfkey32_logger_nonce_key(sector_num, auth_context->key_type, nt);
+        if(Mfkey32LoggerNonceSet_get(instance->nonces_seen, nonce_key)) break;
+
+        if(mfkey32_logger_add_nonce_to_existing_params(instance, auth_context)) break;
+        if(instance->nonces_saves >= MFKEY32_LOGGER_MAX_NONCES_SAVED) break;
+
+        instance->window[instance->window_next] = (Mfkey32LoggerPendingParams){
+            .is_used = true,
             .sector_num = sector_num,
             .key_type = auth_context->key_type,
-            .nt0 = bit_lib_bytes_to_num_be(auth_context->nt.data, sizeof(MfClassicNt)),
+            .nt0 = nt,
             .nr0 = bit_lib_bytes_to_num_be(auth_context->nr.data, sizeof(MfClassicNr)),
             .ar0 = bit_lib_bytes_to_num_be(auth_context->ar.data, sizeof(MfClassicAr)),
         };
-        Mfkey32LoggerParams_push_back(instance->params_arr, params);
+        instance->window_next = (instance->window_next + 1) % MFKEY32_LOGGER_WINDOW_SIZE;
+        Mfkey32LoggerNonceSet_push(instance->nonces_seen, nonce_key);
         instance->nonces_saves++;
+    } while(false);
+
+    furi_mutex_release(instance->mutex);
+}
+
+bool mfkey32_logger_flush(Mfkey32Logger* instance) {
+    furi_assert(instance);
+
+    if(!instance->journal_ok) return false;
+
+    // Storage is slow, listener must not wait for it
+    Mfkey32LoggerRecord records[MFKEY32_LOGGER_WRITE_BUFFER_SIZE];
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const size_t records_count = instance->write_buffer_count;
+    memcpy(records, instance->write_buffer, records_count * sizeof(Mfkey32LoggerRecord));
+    furi_mutex_release(instance->mutex);
+
+    if(records_count == 0) return true;
+
+    const size_t records_size = records_count * sizeof(Mfkey32LoggerRecord);
+    bool success = storage_file_write(instance->journal, records, records_size) ==
+                       records_size &&
+                   storage_file_sync(instance->journal);
+
+    if(success) {
+        // Listener may have appended more records meanwhile
+        furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+        instance->write_buffer_count -= records_count;
+        memmove(
+            instance->write_buffer,
+            &instance->write_buffer[records_count],
+            instance->write_buffer_count * sizeof(Mfkey32LoggerRecord));
+        furi_mutex_release(instance->mutex);
+    } else {
+        FURI_LOG_E(TAG, "Journal write failed");
     }
+
+    return success;
 }
 
 size_t mfkey32_logger_get_params_num(Mfkey32Logger* instance) {
     furi_assert(instance);
 
-    return instance->params_collected;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    size_t params_collected = instance->params_collected;
+    furi_mutex_release(instance->mutex);
+
+    return params_collected;
+}
+
+static bool mfkey32_logger_write_record(
+    Stream* stream,
+    FuriString* temp_str,
+    const Mfkey32LoggerRecord* record) {
+    furi_string_printf(
+        temp_str,
+        "Sec %d key %c cuid %08lx nt0 %08lx nr0 %08lx ar0 %08lx nt1 %08lx nr1 %08lx ar1 %08lx\n",
+        record->sector_num,
+        record->key_type == MfClassicKeyTypeA ? 'A' : 'B',
+        record->cuid,
+        record->nt0,
+        record->nr0,
+        record->ar0,
+        record->nt1,
+        record->nr1,
+        record->ar1);
+    return stream_write_string(stream, temp_str);
 }
 
 bool mfkey32_logger_save_params(Mfkey32Logger* instance, const char* path) {
     furi_assert(instance);
     furi_assert(path);
     furi_assert(instance->params_collected > 0);
-    furi_assert(instance->params_arr);
+
+    // Records not in the journal are taken from the write buffer
+    mfkey32_logger_flush(instance);
 
     bool params_saved = false;
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    Stream* stream = buffered_file_stream_alloc(storage);
+    Stream* stream = buffered_file_stream_alloc(instance->storage);
     FuriString* temp_str = furi_string_alloc();
 
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
     do {
         if(!buffered_file_stream_open(stream, path, FSAM_WRITE, FSOM_OPEN_APPEND)) break;
 
         bool params_write_success = true;
-        Mfkey32LoggerParams_it_t it;
-        for(Mfkey32LoggerParams_it(it, instance->params_arr); !Mfkey32LoggerParams_end_p(it);
-            Mfkey32LoggerParams_next(it)) {
-            Mfkey32LoggerParams* params = Mfkey32LoggerParams_ref(it);
-            if(!params->is_filled) continue;
-            furi_string_printf(
-                temp_str,
-                "Sec %d key %c cuid %08lx nt0 %08lx nr0 %08lx ar0 %08lx nt1 %08lx nr1 %08lx ar1 %08lx\n",
-                params->sector_num,
-                params->key_type == MfClassicKeyTypeA ? 'A' : 'B',
-                params->cuid,
-                params->nt0,
-                params->nr0,
-                params->ar0,
-                params->nt1,
-                params->nr1,
-                params->ar1);
-            if(!stream_write_string(stream, temp_str)) {
-                params_write_success = false;
+        if(instance->journal_ok) {
+            if(!storage_file_seek(instance->journal, sizeof(Mfkey32LoggerJournalHeader), true))
                 break;
+
+            Mfkey32LoggerRecord record;
+            while(params_write_success &&
+                  storage_file_read(instance->journal, &record, sizeof(record)) ==
+                      sizeof(record)) {
+                params_write_success = mfkey32_logger_write_record(stream, temp_str, &record);
             }
         }
+        for(size_t i = 0; params_write_success && i < instance->write_buffer_count; i++) {
+            params_write_success =
+                mfkey32_logger_write_record(stream, temp_str, &instance->write_buffer[i]);
+        }
         if(!params_write_success) break;
 
         params_saved = true;
     } while(false);
 
+    furi_mutex_release(instance->mutex);
+
     furi_string_free(temp_str);
     buffered_file_stream_close(stream);
     stream_free(stream);
-    furi_record_close(RECORD_STORAGE);
 
     return params_saved;
 }
@@ -161,13 +380,16 @@ void mfkey32_logger_get_params_data(Mfkey32Logger* instance, FuriString* str) {
     furi_assert(instance->params_collected > 0);
 
     furi_string_reset(str);
-    Mfkey32LoggerParams_it_t it;
-    for(Mfkey32LoggerParams_it(it, instance->params_arr); !Mfkey32LoggerParams_end_p(it);
-        Mfkey32LoggerParams_next(it)) {
-        Mfkey32LoggerParams* params = Mfkey32LoggerParams_ref(it);
-        if(!params->is_filled) continue;
-
-        char key_char = params->key_type == MfClassicKeyTypeA ? 'A' : 'B';
-        furi_string_cat_printf(str, "Sector %d, key %c\n", params->sector_num, key_char);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    Mfkey32LoggerSectors_it_t it;
+    for(Mfkey32LoggerSectors_it(it, instance->sectors); !Mfkey32LoggerSectors_end_p(it);
+        Mfkey32LoggerSectors_next(it)) {
+        const Mfkey32LoggerSector* sector = Mfkey32LoggerSectors_cref(it);
+        char key_char = sector->key_type == MfClassicKeyTypeA ? 'A' : 'B';
+        furi_string_cat_printf(str, "Sector %d, key %c\n", sector->sector_num, key_char);
     }
+
+    furi_mutex_release(instance->mutex);
 }
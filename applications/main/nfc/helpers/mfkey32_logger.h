@@ -8,12 +8,29 @@ extern "C" {
 
 typedef struct Mfkey32Logger Mfkey32Logger;
 
-Mfkey32Logger* mfkey32_logger_alloc(uint32_t cuid);
+/**
+ * @brief Allocate logger, resuming nonces left in the journal by an interrupted session.
+ *
+ * @param cuid card uid to be logged with nonces.
+ * @param journal_path path to the binary journal, removed when logger is freed.
+ * @return Mfkey32Logger*
+ */
+Mfkey32Logger* mfkey32_logger_alloc(uint32_t cuid, const char* journal_path);
 
 void mfkey32_logger_free(Mfkey32Logger* instance);
 
 void mfkey32_logger_add_nonce(Mfkey32Logger* instance, MfClassicAuthContext* auth_context);
 
+/**
+ * @brief Write buffered nonce pairs to the journal.
+ *
+ * mfkey32_logger_add_nonce() does not touch storage, call this from the application thread.
+ *
+ * @param instance Mfkey32Logger instance.
+ * @return true if the journal is up to date.
+ */
+bool mfkey32_logger_flush(Mfkey32Logger* instance);
+
 size_t mfkey32_logger_get_params_num(Mfkey32Logger* instance);
 
 bool mfkey32_logger_save_params(Mfkey32Logger* instance, const char* path);
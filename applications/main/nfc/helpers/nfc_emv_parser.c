@@ -4,7 +4,176 @@
 static const char* nfc_resources_header = "Flipper EMV resources";
 static const uint32_t nfc_resources_file_version = 1;
 
-static bool nfc_emv_parser_search_data(
+// Sorted index built next to each resource file by the assets pipeline,
+// see scripts/flipper/assets/emv.py
+#define NFC_EMV_INDEX_SUFFIX       ".idx"
+#define NFC_EMV_INDEX_MAGIC        (0x49564D45UL) // "EMVI"
+#define NFC_EMV_INDEX_VERSION      (1U)
+#define NFC_EMV_INDEX_KEY_SIZE_MAX (16U)
+
+#define NFC_EMV_CACHE_SIZE       (4U)
+#define NFC_EMV_CACHE_VALUE_SIZE (48U)
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t key_size;
+    uint16_t count;
+    // Resource file size at build time, edited files are not indexed
+    uint32_t source_size;
+} NfcEmvIndexHeader;
+
+typedef struct {
+    uint8_t key_length;
+    uint8_t value_size;
+    uint16_t value_offset;
+} NfcEmvIndexRecordTail;
+
+#pragma pack(pop)
+
+typedef enum {
+    NfcEmvIndexResultFound,
+    NfcEmvIndexResultNotFound,
+    NfcEmvIndexResultUnavailable,
+} NfcEmvIndexResult;
+
+typedef struct {
+    const char* file_name;
+    uint8_t key[NFC_EMV_INDEX_KEY_SIZE_MAX];
+    uint8_t key_length;
+    char value[NFC_EMV_CACHE_VALUE_SIZE];
+    uint32_t last_used;
+} NfcEmvCacheEntry;
+
+// Card info screens ask for the same few names on every redraw
+static NfcEmvCacheEntry nfc_emv_cache[NFC_EMV_CACHE_SIZE];
+static uint32_t nfc_emv_cache_counter;
+
+static bool nfc_emv_parser_cache_get(
+    const char* file_name,
+    const uint8_t* key,
+    uint8_t key_length,
+    FuriString* data) {
+    bool found = false;
+
+    FURI_CRITICAL_ENTER();
+    for(size_t i = 0; i < NFC_EMV_CACHE_SIZE; i++) {
+        NfcEmvCacheEntry* entry = &nfc_emv_cache[i];
+        if(entry->file_name && entry->key_length == key_length &&
+           strcmp(entry->file_name, file_name) == 0 && memcmp(entry->key, key, key_length) == 0) {
+            entry->last_used = ++nfc_emv_cache_counter;
+            furi_string_set_str(data, entry->value);
+            found = true;
+            break;
+        }
+    }
+    FURI_CRITICAL_EXIT();
+
+    return found;
+}
+
+static void nfc_emv_parser_cache_put(
+    const char* file_name,
+    const uint8_t* key,
+    uint8_t key_length,
+    const FuriString* data) {
+    if(furi_string_size(data) >= NFC_EMV_CACHE_VALUE_SIZE) return;
+
+    FURI_CRITICAL_ENTER();
+    NfcEmvCacheEntry* entry = &nfc_emv_cache[0];
+    for(size_t i = 1; i < NFC_EMV_CACHE_SIZE; i++) {
+        if(nfc_emv_cache[i].last_used < entry->last_used) {
+            entry = &nfc_emv_cache[i];
+        }
+    }
+
+    entry->file_name = file_name;
+    memcpy(entry->key, key, key_length);
+    entry->key_length = key_length;
+    strlcpy(entry->value, furi_string_get_cstr(data), NFC_EMV_CACHE_VALUE_SIZE);
+    entry->last_used = ++nfc_emv_cache_counter;
+    FURI_CRITICAL_EXIT();
+}
+
+static NfcEmvIndexResult nfc_emv_parser_search_index(
+    Storage* storage,
+    const char* file_name,
+    const uint8_t* key,
+    uint8_t key_length,
+    FuriString* data) {
+    NfcEmvIndexResult result = NfcEmvIndexResultUnavailable;
+    FuriString* index_path = furi_string_alloc_printf("%s" NFC_EMV_INDEX_SUFFIX, file_name);
+    File* file = storage_file_alloc(storage);
+
+    do {
+        FileInfo file_info;
+        if(storage_common_stat(storage, file_name, &file_info) != FSE_OK) break;
+        if(!storage_file_open(
+               file, furi_string_get_cstr(index_path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        NfcEmvIndexHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != NFC_EMV_INDEX_MAGIC || header.version != NFC_EMV_INDEX_VERSION ||
+           header.key_size == 0 || header.key_size > NFC_EMV_INDEX_KEY_SIZE_MAX ||
+           header.source_size != file_info.size)
+            break;
+
+        result = NfcEmvIndexResultNotFound;
+        if(key_length > header.key_size) break;
+
+        // Records compare as zero padded key, then key length
+        uint8_t padded_key[NFC_EMV_INDEX_KEY_SIZE_MAX] = {0};
+        memcpy(padded_key, key, key_length);
+
+        const size_t record_size = header.key_size + sizeof(NfcEmvIndexRecordTail);
+        uint8_t record[NFC_EMV_INDEX_KEY_SIZE_MAX + sizeof(NfcEmvIndexRecordTail)];
+        NfcEmvIndexRecordTail tail;
+        size_t low = 0;
+        size_t high = header.count;
+
+        while(low < high) {
+            const size_t middle = low + (high - low) / 2;
+            if(!storage_file_seek(file, sizeof(header) + middle * record_size, true) ||
+               storage_file_read(file, record, record_size) != record_size) {
+                result = NfcEmvIndexResultUnavailable;
+                break;
+            }
+
+            memcpy(&tail, &record[header.key_size], sizeof(tail));
+            int compare = memcmp(record, padded_key, header.key_size);
+            if(compare == 0) compare = (int)tail.key_length - key_length;
+
+            if(compare < 0) {
+                low = middle + 1;
+            } else if(compare > 0) {
+                high = middle;
+            } else {
+                result = NfcEmvIndexResultFound;
+                break;
+            }
+        }
+
+        if(result != NfcEmvIndexResultFound) break;
+
+        char value[UINT8_MAX];
+        const size_t pool_offset = sizeof(header) + header.count * record_size;
+        if(!storage_file_seek(file, pool_offset + tail.value_offset, true) ||
+           storage_file_read(file, value, tail.value_size) != tail.value_size) {
+            result = NfcEmvIndexResultUnavailable;
+            break;
+        }
+        furi_string_set_strn(data, value, tail.value_size);
+    } while(false);
+
+    storage_file_free(file);
+    furi_string_free(index_path);
+    return result;
+}
+
+static bool nfc_emv_parser_search_file(
     Storage* storage,
     const char* file_name,
     FuriString* key,
@@ -32,51 +201,60 @@ static bool nfc_emv_parser_search_data(
     return parsed;
 }
 
+static bool nfc_emv_parser_search_data(
+    Storage* storage,
+    const char* file_name,
+    const uint8_t* key,
+    uint8_t key_length,
+    FuriString* data) {
+    if(key_length <= NFC_EMV_INDEX_KEY_SIZE_MAX) {
+        if(nfc_emv_parser_cache_get(file_name, key, key_length, data)) return true;
+
+        NfcEmvIndexResult result =
+            nfc_emv_parser_search_index(storage, file_name, key, key_length, data);
+        if(result == NfcEmvIndexResultFound) {
+            nfc_emv_parser_cache_put(file_name, key, key_length, data);
+            return true;
+        } else if(result == NfcEmvIndexResultNotFound) {
+            return false;
+        }
+    }
+
+    // No usable index, scan resource file itself
+    FuriString* key_str = furi_string_alloc();
+    for(uint8_t i = 0; i < key_length; i++) {
+        furi_string_cat_printf(key_str, "%02X", key[i]);
+    }
+    bool parsed = nfc_emv_parser_search_file(storage, file_name, key_str, data);
+    furi_string_free(key_str);
+
+    return parsed;
+}
+
 bool nfc_emv_parser_get_aid_name(
     Storage* storage,
     uint8_t* aid,
     uint8_t aid_len,
     FuriString* aid_name) {
     furi_assert(storage);
-    bool parsed = false;
-    FuriString* key;
-    key = furi_string_alloc();
-    for(uint8_t i = 0; i < aid_len; i++) {
-        furi_string_cat_printf(key, "%02X", aid[i]);
-    }
-    if(nfc_emv_parser_search_data(storage, EXT_PATH("nfc/assets/aid.nfc"), key, aid_name)) {
-        parsed = true;
-    }
-    furi_string_free(key);
-    return parsed;
+    return nfc_emv_parser_search_data(
+        storage, EXT_PATH("nfc/assets/aid.nfc"), aid, aid_len, aid_name);
 }
 
 bool nfc_emv_parser_get_country_name(
     Storage* storage,
     uint16_t country_code,
     FuriString* country_name) {
-    bool parsed = false;
-    FuriString* key;
-    key = furi_string_alloc_printf("%04X", country_code);
-    if(nfc_emv_parser_search_data(
-           storage, EXT_PATH("nfc/assets/country_code.nfc"), key, country_name)) {
-        parsed = true;
-    }
-    furi_string_free(key);
-    return parsed;
+    const uint8_t key[] = {country_code >> 8, country_code & 0xFF};
+    return nfc_emv_parser_search_data(
+        storage, EXT_PATH("nfc/assets/country_code.nfc"), key, sizeof(key), country_name);
 }
 
 bool nfc_emv_parser_get_currency_name(
     Storage* storage,
     uint16_t currency_code,
     FuriString* currency_name) {
-    bool parsed = false;
-    FuriString* key;
-    key = furi_string_alloc_printf("%04X", currency_code);
-    if(nfc_emv_parser_search_data(
-           storage, EXT_PATH("nfc/assets/currency_code.nfc"), key, currency_name)) {
-        parsed = true;
-    }
-    furi_string_free(key);
-    return parsed;
+    const uint8_t key[] = {currency_code >> 8, currency_code & 0xFF};
+    return nfc_emv_parser_search_data(
+        storage, EXT_PATH("nfc/assets/currency_code.nfc"), key, sizeof(key), currency_name);
 }
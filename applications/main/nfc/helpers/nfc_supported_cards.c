@@ -6,7 +6,9 @@
 #include <flipper_application/flipper_application.h>
 #include <flipper_application/plugins/plugin_manager.h>
 #include <flipper_application/plugins/composite_resolver.h>
+#include <flipper_format/flipper_format.h>
 #include <loader/firmware_api/firmware_api.h>
+#include <toolbox/crc32_calc.h>
 
 #include <furi.h>
 #include <path.h>
@@ -16,6 +18,18 @@
 
 #define NFC_SUPPORTED_CARDS_PLUGINS_PATH  APP_DATA_PATH("plugins")
 #define NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX "_parser.fal"
+#define NFC_SUPPORTED_CARDS_CACHE_PATH    APP_DATA_PATH(".plugins.cache")
+
+// One record per UID with the text of the last parse
+#define NFC_SUPPORTED_CARDS_PARSE_CACHE_PATH      APP_DATA_PATH(".parsed")
+#define NFC_SUPPORTED_CARDS_PARSE_CACHE_EXTENSION ".bin"
+#define NFC_SUPPORTED_CARDS_PARSE_CACHE_MAGIC     (0x4350464EUL) // "NFPC"
+#define NFC_SUPPORTED_CARDS_PARSE_CACHE_NONE      (UINT16_MAX)
+
+#define NFC_SUPPORTED_CARDS_PLUGIN_INDEX_NONE (SIZE_MAX)
+
+static const char* nfc_supported_cards_cache_file_header = "Flipper NFC plugins cache";
+static const uint32_t nfc_supported_cards_cache_file_version = 1;
 
 typedef enum {
     NfcSupportedCardsPluginFeatureHasVerify = (1U << 0),
@@ -26,11 +40,27 @@ typedef enum {
 typedef struct {
     FuriString* name;
     NfcProtocol protocol;
-    NfcSupportedCardsPluginFeature feature;
+    NfcSupportedCardsPluginFeature feature; // None for files that failed to load as a plugin
+    uint32_t size;
+    uint32_t timestamp;
 } NfcSupportedCardsPluginCache;
 
 ARRAY_DEF(NfcSupportedCardsPluginCache, NfcSupportedCardsPluginCache, M_POD_OPLIST);
 
+#pragma pack(push, 1)
+
+typedef struct {
+    uint32_t magic;
+    // Any plugin change invalidates every record
+    uint32_t plugins_signature;
+    uint32_t data_hash;
+    uint16_t plugin_index; // NFC_SUPPORTED_CARDS_PARSE_CACHE_NONE if no plugin parsed the card
+    uint8_t protocol;
+    uint16_t text_size;
+} NfcSupportedCardsParseCacheHeader;
+
+#pragma pack(pop)
+
 typedef enum {
     NfcSupportedCardsLoadStateIdle,
     NfcSupportedCardsLoadStateInProgress,
@@ -43,6 +73,8 @@ typedef struct {
     File* directory;
     char file_name[256];
     FlipperApplication* app;
+    FuriString* app_name;
+    const NfcSupportedCardsPlugin* app_plugin;
 } NfcSupportedCardsLoadContext;
 
 struct NfcSupportedCards {
@@ -50,58 +82,77 @@ struct NfcSupportedCards {
     NfcSupportedCardsPluginCache_t plugins_cache_arr;
     NfcSupportedCardsLoadState load_state;
     NfcSupportedCardsLoadContext* load_context;
+    size_t resident_index; // Plugin that handled the last card, stays loaded and goes first
+    uint32_t plugins_signature;
 };
 
-NfcSupportedCards* nfc_supported_cards_alloc(void) {
-    NfcSupportedCards* instance = malloc(sizeof(NfcSupportedCards));
-
-    instance->api_resolver = composite_api_resolver_alloc();
-    composite_api_resolver_add(instance->api_resolver, firmware_api_interface);
-    composite_api_resolver_add(instance->api_resolver, nfc_application_api_interface);
+static NfcSupportedCardsLoadContext* nfc_supported_cards_load_context_alloc(void) {
+    NfcSupportedCardsLoadContext* instance = malloc(sizeof(NfcSupportedCardsLoadContext));
 
-    NfcSupportedCardsPluginCache_init(instance->plugins_cache_arr);
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->directory = storage_file_alloc(instance->storage);
+    instance->app_name = furi_string_alloc();
 
     return instance;
 }
 
-void nfc_supported_cards_free(NfcSupportedCards* instance) {
-    furi_assert(instance);
+static void nfc_supported_cards_unload_plugin(NfcSupportedCardsLoadContext* instance) {
+    if(instance->app) {
+        flipper_application_free(instance->app);
+        instance->app = NULL;
+    }
+
+    furi_string_reset(instance->app_name);
+    instance->app_plugin = NULL;
+}
 
+static void nfc_supported_cards_load_context_free(NfcSupportedCardsLoadContext* instance) {
+    nfc_supported_cards_unload_plugin(instance);
+
+    storage_dir_close(instance->directory);
+    storage_file_free(instance->directory);
+    furi_string_free(instance->app_name);
+
+    furi_record_close(RECORD_STORAGE);
+    free(instance);
+}
+
+static void
+    nfc_supported_cards_plugins_cache_reset(NfcSupportedCardsPluginCache_t plugins_cache_arr) {
     NfcSupportedCardsPluginCache_it_t iter;
-    for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
+    for(NfcSupportedCardsPluginCache_it(iter, plugins_cache_arr);
         !NfcSupportedCardsPluginCache_end_p(iter);
         NfcSupportedCardsPluginCache_next(iter)) {
         NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
         furi_string_free(plugin_cache->name);
     }
-    NfcSupportedCardsPluginCache_clear(instance->plugins_cache_arr);
-
-    composite_api_resolver_free(instance->api_resolver);
-    free(instance);
+    NfcSupportedCardsPluginCache_reset(plugins_cache_arr);
 }
 
-static NfcSupportedCardsLoadContext* nfc_supported_cards_load_context_alloc(void) {
-    NfcSupportedCardsLoadContext* instance = malloc(sizeof(NfcSupportedCardsLoadContext));
+NfcSupportedCards* nfc_supported_cards_alloc(void) {
+    NfcSupportedCards* instance = malloc(sizeof(NfcSupportedCards));
 
-    instance->storage = furi_record_open(RECORD_STORAGE);
-    instance->directory = storage_file_alloc(instance->storage);
+    instance->api_resolver = composite_api_resolver_alloc();
+    composite_api_resolver_add(instance->api_resolver, firmware_api_interface);
+    composite_api_resolver_add(instance->api_resolver, nfc_application_api_interface);
 
-    if(!storage_dir_open(instance->directory, NFC_SUPPORTED_CARDS_PLUGINS_PATH)) {
-        FURI_LOG_D(TAG, "Failed to open directory: %s", NFC_SUPPORTED_CARDS_PLUGINS_PATH);
-    }
+    NfcSupportedCardsPluginCache_init(instance->plugins_cache_arr);
+    instance->resident_index = NFC_SUPPORTED_CARDS_PLUGIN_INDEX_NONE;
 
     return instance;
 }
 
-static void nfc_supported_cards_load_context_free(NfcSupportedCardsLoadContext* instance) {
-    if(instance->app) {
-        flipper_application_free(instance->app);
+void nfc_supported_cards_free(NfcSupportedCards* instance) {
+    furi_assert(instance);
+
+    if(instance->load_context) {
+        nfc_supported_cards_load_context_free(instance->load_context);
     }
 
-    storage_dir_close(instance->directory);
-    storage_file_free(instance->directory);
+    nfc_supported_cards_plugins_cache_reset(instance->plugins_cache_arr);
+    NfcSupportedCardsPluginCache_clear(instance->plugins_cache_arr);
 
-    furi_record_close(RECORD_STORAGE);
+    composite_api_resolver_free(instance->api_resolver);
     free(instance);
 }
 
@@ -112,11 +163,15 @@ static const NfcSupportedCardsPlugin* nfc_supported_cards_get_plugin(
     furi_assert(instance);
     furi_assert(name);
 
+    if(instance->app && furi_string_equal_str(instance->app_name, name)) {
+        return instance->app_plugin;
+    }
+
     const NfcSupportedCardsPlugin* plugin = NULL;
     FuriString* plugin_path = furi_string_alloc_printf(
         "%s/%s%s", NFC_SUPPORTED_CARDS_PLUGINS_PATH, name, NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX);
     do {
-        if(instance->app) flipper_application_free(instance->app);
+        nfc_supported_cards_unload_plugin(instance);
         instance->app = flipper_application_alloc(instance->storage, api_interface);
 
         if(flipper_application_preload(instance->app, furi_string_get_cstr(plugin_path)) !=
@@ -134,41 +189,152 @@ static const NfcSupportedCardsPlugin* nfc_supported_cards_get_plugin(
         if(descriptor->ep_api_version != NFC_SUPPORTED_CARD_PLUGIN_API_VERSION) break;
 
         plugin = descriptor->entry_point;
+        furi_string_set_str(instance->app_name, name);
+        instance->app_plugin = plugin;
     } while(false);
     furi_string_free(plugin_path);
 
+    if(plugin == NULL) {
+        nfc_supported_cards_unload_plugin(instance);
+    }
+
     return plugin;
 }
 
-static const NfcSupportedCardsPlugin* nfc_supported_cards_get_next_plugin(
+static bool nfc_supported_cards_get_next_plugin_file(
     NfcSupportedCardsLoadContext* instance,
-    const ElfApiInterface* api_interface) {
-    const NfcSupportedCardsPlugin* plugin = NULL;
+    FileInfo* file_info) {
+    const size_t suffix_len = strlen(NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX);
 
-    do {
-        if(!storage_file_is_open(instance->directory)) break;
-        if(!storage_dir_read(
-               instance->directory, NULL, instance->file_name, sizeof(instance->file_name)))
-            break;
+    while(storage_dir_read(
+        instance->directory, file_info, instance->file_name, sizeof(instance->file_name))) {
+        if(file_info_is_dir(file_info)) continue;
 
-        const size_t suffix_len = strlen(NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX);
         const size_t file_name_len = strlen(instance->file_name);
-        if(file_name_len <= suffix_len) break;
+        if(file_name_len <= suffix_len) continue;
 
         size_t suffix_start_pos = file_name_len - suffix_len;
         if(memcmp(
                &instance->file_name[suffix_start_pos],
                NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX,
                suffix_len) != 0) //-V1051
-            break;
+            continue;
 
         // Trim suffix from file_name to save memory. The suffix will be concatenated on plugin load.
         instance->file_name[suffix_start_pos] = '\0';
 
-        plugin = nfc_supported_cards_get_plugin(instance, instance->file_name, api_interface);
-    } while(plugin == NULL); //-V654
+        return true;
+    }
+
+    return false;
+}
 
-    return plugin;
+static uint32_t nfc_supported_cards_get_api_version(void) {
+    // Plugins are rejected or behave differently on another firmware API
+    return (firmware_api_interface->api_version_major << 16) |
+           firmware_api_interface->api_version_minor;
+}
+
+static void nfc_supported_cards_cache_load(
+    NfcSupportedCardsPluginCache_t plugins_cache_arr,
+    Storage* storage) {
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, NFC_SUPPORTED_CARDS_CACHE_PATH)) break;
+
+        uint32_t version = 0;
+        if(!flipper_format_read_header(ff, temp_str, &version)) break;
+        if(furi_string_cmp_str(temp_str, nfc_supported_cards_cache_file_header)) break;
+        if(version != nfc_supported_cards_cache_file_version) break;
+
+        uint32_t api_version = 0;
+        if(!flipper_format_read_uint32(ff, "API version", &api_version, 1)) break;
+        if(api_version != nfc_supported_cards_get_api_version()) break;
+
+        while(flipper_format_read_string(ff, "Plugin", temp_str)) {
+            NfcSupportedCardsPluginCache plugin_cache = {};
+            uint32_t protocol = 0;
+            uint32_t feature = 0;
+
+            if(!flipper_format_read_uint32(ff, "Size", &plugin_cache.size, 1)) break;
+            if(!flipper_format_read_uint32(ff, "Timestamp", &plugin_cache.timestamp, 1)) break;
+            if(!flipper_format_read_uint32(ff, "Protocol", &protocol, 1)) break;
+            if(!flipper_format_read_uint32(ff, "Feature", &feature, 1)) break;
+
+            plugin_cache.name = furi_string_alloc_set(temp_str);
+            plugin_cache.protocol = protocol;
+            plugin_cache.feature = feature;
+            NfcSupportedCardsPluginCache_push_back(plugins_cache_arr, plugin_cache);
+        }
+    } while(false);
+
+    furi_string_free(temp_str);
+    flipper_format_free(ff);
+}
+
+static void nfc_supported_cards_cache_save(
+    NfcSupportedCardsPluginCache_t plugins_cache_arr,
+    Storage* storage) {
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    bool saved = false;
+
+    do {
+        if(!flipper_format_buffered_file_open_always(ff, NFC_SUPPORTED_CARDS_CACHE_PATH)) break;
+        if(!flipper_format_write_header_cstr(
+               ff, nfc_supported_cards_cache_file_header, nfc_supported_cards_cache_file_version))
+            break;
+
+        uint32_t api_version = nfc_supported_cards_get_api_version();
+        if(!flipper_format_write_uint32(ff, "API version", &api_version, 1)) break;
+
+        bool plugins_saved = true;
+        NfcSupportedCardsPluginCache_it_t iter;
+        for(NfcSupportedCardsPluginCache_it(iter, plugins_cache_arr);
+            plugins_saved && !NfcSupportedCardsPluginCache_end_p(iter);
+            NfcSupportedCardsPluginCache_next(iter)) {
+            const NfcSupportedCardsPluginCache* plugin_cache =
+                NfcSupportedCardsPluginCache_cref(iter);
+            uint32_t protocol = plugin_cache->protocol;
+            uint32_t feature = plugin_cache->feature;
+
+            plugins_saved =
+                flipper_format_write_string(ff, "Plugin", plugin_cache->name) &&
+                flipper_format_write_uint32(ff, "Size", &plugin_cache->size, 1) &&
+                flipper_format_write_uint32(ff, "Timestamp", &plugin_cache->timestamp, 1) &&
+                flipper_format_write_uint32(ff, "Protocol", &protocol, 1) &&
+                flipper_format_write_uint32(ff, "Feature", &feature, 1);
+        }
+        saved = plugins_saved;
+    } while(false);
+
+    flipper_format_free(ff);
+
+    // Broken cache would be trusted on the next start
+    if(!saved) {
+        FURI_LOG_W(TAG, "Failed to save plugins cache");
+        storage_simply_remove(storage, NFC_SUPPORTED_CARDS_CACHE_PATH);
+    }
+}
+
+static const NfcSupportedCardsPluginCache* nfc_supported_cards_cache_find(
+    NfcSupportedCardsPluginCache_t plugins_cache_arr,
+    const char* name,
+    uint32_t size,
+    uint32_t timestamp) {
+    NfcSupportedCardsPluginCache_it_t iter;
+    for(NfcSupportedCardsPluginCache_it(iter, plugins_cache_arr);
+        !NfcSupportedCardsPluginCache_end_p(iter);
+        NfcSupportedCardsPluginCache_next(iter)) {
+        const NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_cref(iter);
+        if(plugin_cache->size == size && plugin_cache->timestamp == timestamp &&
+           furi_string_equal_str(plugin_cache->name, name)) {
+            return plugin_cache;
+        }
+    }
+
+    return NULL;
 }
 
 void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
@@ -179,33 +345,98 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
            (instance->load_state == NfcSupportedCardsLoadStateFail))
             break;
 
-        instance->load_context = nfc_supported_cards_load_context_alloc();
+        NfcSupportedCardsLoadContext* load_context = nfc_supported_cards_load_context_alloc();
 
-        while(true) {
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin =
-                nfc_supported_cards_get_next_plugin(instance->load_context, api_interface);
-            if(plugin == NULL) break; //-V547
+        // Only new and changed plugins are loaded, the rest is described by the stored cache
+        NfcSupportedCardsPluginCache_t stored_cache_arr;
+        NfcSupportedCardsPluginCache_init(stored_cache_arr);
+        nfc_supported_cards_cache_load(stored_cache_arr, load_context->storage);
+        bool cache_changed = false;
 
-            NfcSupportedCardsPluginCache plugin_cache = {}; //-V779
-            plugin_cache.name = furi_string_alloc_set(instance->load_context->file_name);
-            plugin_cache.protocol = plugin->protocol;
-            if(plugin->verify) {
-                plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasVerify;
-            }
-            if(plugin->read) {
-                plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasRead;
-            }
-            if(plugin->parse) {
-                plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasParse;
+        if(!storage_dir_open(load_context->directory, NFC_SUPPORTED_CARDS_PLUGINS_PATH)) {
+            FURI_LOG_D(TAG, "Failed to open directory: %s", NFC_SUPPORTED_CARDS_PLUGINS_PATH);
+        }
+
+        FuriString* plugin_path = furi_string_alloc();
+        FileInfo file_info;
+        while(nfc_supported_cards_get_next_plugin_file(load_context, &file_info)) {
+            furi_string_printf(
+                plugin_path,
+                "%s/%s%s",
+                NFC_SUPPORTED_CARDS_PLUGINS_PATH,
+                load_context->file_name,
+                NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX);
+
+            uint32_t timestamp = 0;
+            storage_common_timestamp(
+                load_context->storage, furi_string_get_cstr(plugin_path), &timestamp);
+
+            NfcSupportedCardsPluginCache plugin_cache = {};
+            const NfcSupportedCardsPluginCache* stored_cache = nfc_supported_cards_cache_find(
+                stored_cache_arr, load_context->file_name, file_info.size, timestamp);
+
+            if(stored_cache) {
+                plugin_cache = *stored_cache;
+            } else {
+                plugin_cache.size = file_info.size;
+                plugin_cache.timestamp = timestamp;
+                plugin_cache.protocol = NfcProtocolInvalid;
+
+                const ElfApiInterface* api_interface =
+                    composite_api_resolver_get(instance->api_resolver);
+                const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
+                    load_context, load_context->file_name, api_interface);
+                if(plugin) {
+                    plugin_cache.protocol = plugin->protocol;
+                    if(plugin->verify) {
+                        plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasVerify;
+                    }
+                    if(plugin->read) {
+                        plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasRead;
+                    }
+                    if(plugin->parse) {
+                        plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasParse;
+                    }
+                }
+                cache_changed = true;
             }
+
+            plugin_cache.name = furi_string_alloc_set(load_context->file_name);
             NfcSupportedCardsPluginCache_push_back(instance->plugins_cache_arr, plugin_cache);
         }
+        furi_string_free(plugin_path);
 
-        nfc_supported_cards_load_context_free(instance->load_context);
+        // Removed plugins leave the cache too
+        if(cache_changed || NfcSupportedCardsPluginCache_size(stored_cache_arr) !=
+                                NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr)) {
+            nfc_supported_cards_cache_save(instance->plugins_cache_arr, load_context->storage);
+        }
+
+        nfc_supported_cards_plugins_cache_reset(stored_cache_arr);
+        NfcSupportedCardsPluginCache_clear(stored_cache_arr);
+        nfc_supported_cards_load_context_free(load_context);
+
+        size_t plugins_loaded = 0;
+        uint32_t plugins_signature = nfc_supported_cards_get_api_version();
+        NfcSupportedCardsPluginCache_it_t iter;
+        for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
+            !NfcSupportedCardsPluginCache_end_p(iter);
+            NfcSupportedCardsPluginCache_next(iter)) {
+            const NfcSupportedCardsPluginCache* plugin_cache =
+                NfcSupportedCardsPluginCache_cref(iter);
+            if(plugin_cache->feature) plugins_loaded++;
+
+            plugins_signature = crc32_calc_buffer(
+                plugins_signature,
+                furi_string_get_cstr(plugin_cache->name),
+                furi_string_size(plugin_cache->name));
+            plugins_signature =
+                crc32_calc_buffer(plugins_signature, &plugin_cache->size, sizeof(uint32_t));
+            plugins_signature =
+                crc32_calc_buffer(plugins_signature, &plugin_cache->timestamp, sizeof(uint32_t));
+        }
+        instance->plugins_signature = plugins_signature;
 
-        size_t plugins_loaded = NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
         if(plugins_loaded == 0) {
             FURI_LOG_D(TAG, "Plugins not found");
             instance->load_state = NfcSupportedCardsLoadStateFail;
@@ -217,6 +448,36 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
     } while(false);
 }
 
+static size_t nfc_supported_cards_get_plugin_index(NfcSupportedCards* instance, size_t i) {
+    const size_t resident_index = instance->resident_index;
+
+    // Resident plugin goes first, the rest keep their order
+    if(resident_index == NFC_SUPPORTED_CARDS_PLUGIN_INDEX_NONE) return i;
+    if(i == 0) return resident_index;
+    return (i <= resident_index) ? i - 1 : i;
+}
+
+static const NfcSupportedCardsPlugin* nfc_supported_cards_get_cached_plugin(
+    NfcSupportedCards* instance,
+    const NfcSupportedCardsPluginCache* plugin_cache) {
+    if(instance->load_context == NULL) {
+        instance->load_context = nfc_supported_cards_load_context_alloc();
+    }
+
+    const ElfApiInterface* api_interface = composite_api_resolver_get(instance->api_resolver);
+    return nfc_supported_cards_get_plugin(
+        instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
+}
+
+static void nfc_supported_cards_set_resident(NfcSupportedCards* instance, size_t index) {
+    instance->resident_index = index;
+
+    // Nothing worth keeping in memory after a miss
+    if(index == NFC_SUPPORTED_CARDS_PLUGIN_INDEX_NONE && instance->load_context) {
+        nfc_supported_cards_unload_plugin(instance->load_context);
+    }
+}
+
 bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nfc* nfc) {
     furi_assert(instance);
     furi_assert(device);
@@ -228,20 +489,17 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
     do {
         if(instance->load_state != NfcSupportedCardsLoadStateSuccess) break;
 
-        instance->load_context = nfc_supported_cards_load_context_alloc();
-
-        NfcSupportedCardsPluginCache_it_t iter;
-        for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
-            !NfcSupportedCardsPluginCache_end_p(iter);
-            NfcSupportedCardsPluginCache_next(iter)) {
-            NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
+        size_t plugin_index = NFC_SUPPORTED_CARDS_PLUGIN_INDEX_NONE;
+        const size_t plugins_num = NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
+        for(size_t i = 0; i < plugins_num; i++) {
+            const size_t index = nfc_supported_cards_get_plugin_index(instance, i);
+            const NfcSupportedCardsPluginCache* plugin_cache =
+                NfcSupportedCardsPluginCache_cget(instance->plugins_cache_arr, index);
             if(plugin_cache->protocol != protocol) continue;
             if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasRead) == 0) continue;
 
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
-                instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
+            const NfcSupportedCardsPlugin* plugin =
+                nfc_supported_cards_get_cached_plugin(instance, plugin_cache);
             if(plugin == NULL) continue;
 
             if(plugin->verify) {
@@ -250,18 +508,126 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
 
             if(plugin->read) {
                 if(plugin->read(nfc, device)) {
+                    plugin_index = index;
                     card_read = true;
                     break;
                 }
             }
         }
 
-        nfc_supported_cards_load_context_free(instance->load_context);
+        nfc_supported_cards_set_resident(instance, plugin_index);
     } while(false);
 
     return card_read;
 }
 
+static void nfc_supported_cards_parse_cache_get_path(const NfcDevice* device, FuriString* path) {
+    size_t uid_len = 0;
+    const uint8_t* uid = nfc_device_get_uid(device, &uid_len);
+
+    furi_string_set_str(path, NFC_SUPPORTED_CARDS_PARSE_CACHE_PATH "/");
+    for(size_t i = 0; i < uid_len; i++) {
+        furi_string_cat_printf(path, "%02X", uid[i]);
+    }
+    furi_string_cat_str(path, NFC_SUPPORTED_CARDS_PARSE_CACHE_EXTENSION);
+}
+
+static bool nfc_supported_cards_parse_cache_load(
+    NfcSupportedCards* instance,
+    const FuriString* path,
+    NfcProtocol protocol,
+    uint32_t data_hash,
+    size_t* plugin_index,
+    FuriString* parsed_data) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool loaded = false;
+
+    do {
+        if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        NfcSupportedCardsParseCacheHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != NFC_SUPPORTED_CARDS_PARSE_CACHE_MAGIC ||
+           header.plugins_signature != instance->plugins_signature ||
+           header.data_hash != data_hash || header.protocol != protocol)
+            break;
+
+        if(header.plugin_index == NFC_SUPPORTED_CARDS_PARSE_CACHE_NONE) {
+            *plugin_index = NFC_SUPPORTED_CARDS_PLUGIN_INDEX_NONE;
+        } else if(
+            header.plugin_index < NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr)) {
+            *plugin_index = header.plugin_index;
+        } else {
+            break;
+        }
+
+        if(header.text_size == 0) {
+            loaded = true;
+            break;
+        }
+
+        char* text = malloc(header.text_size);
+        if(storage_file_read(file, text, header.text_size) == header.text_size) {
+            furi_string_set_strn(parsed_data, text, header.text_size);
+            loaded = true;
+        }
+        free(text);
+    } while(false);
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return loaded;
+}
+
+static void nfc_supported_cards_parse_cache_save(
+    NfcSupportedCards* instance,
+    const FuriString* path,
+    NfcProtocol protocol,
+    uint32_t data_hash,
+    size_t plugin_index,
+    const FuriString* parsed_data) {
+    const bool has_text = (plugin_index != NFC_SUPPORTED_CARDS_PLUGIN_INDEX_NONE);
+    const size_t text_size = has_text ? furi_string_size(parsed_data) : 0;
+    if(text_size > UINT16_MAX) return;
+
+    NfcSupportedCardsParseCacheHeader header = {
+        .magic = NFC_SUPPORTED_CARDS_PARSE_CACHE_MAGIC,
+        .plugins_signature = instance->plugins_signature,
+        .data_hash = data_hash,
+        .plugin_index = (plugin_index == NFC_SUPPORTED_CARDS_PLUGIN_INDEX_NONE) ?
+                            NFC_SUPPORTED_CARDS_PARSE_CACHE_NONE :
+                            plugin_index,
+        .protocol = protocol,
+        .text_size = text_size,
+    };
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool saved = false;
+
+    do {
+        storage_simply_mkdir(storage, NFC_SUPPORTED_CARDS_PARSE_CACHE_PATH);
+        if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(storage_file_write(file, furi_string_get_cstr(parsed_data), text_size) != text_size)
+            break;
+        saved = true;
+    } while(false);
+
+    storage_file_free(file);
+
+    // Record is checked as a whole on load, but a partial one is not worth keeping
+    if(!saved) {
+        storage_simply_remove(storage, furi_string_get_cstr(path));
+    }
+
+    furi_record_close(RECORD_STORAGE);
+}
+
 bool nfc_supported_cards_parse(
     NfcSupportedCards* instance,
     NfcDevice* device,
@@ -272,36 +638,56 @@ bool nfc_supported_cards_parse(
 
     bool card_parsed = false;
     NfcProtocol protocol = nfc_device_get_protocol(device);
+    FuriString* cache_path = furi_string_alloc();
 
     do {
         if(instance->load_state != NfcSupportedCardsLoadStateSuccess) break;
 
-        instance->load_context = nfc_supported_cards_load_context_alloc();
+        size_t plugin_index = NFC_SUPPORTED_CARDS_PLUGIN_INDEX_NONE;
+
+        // Saved cards reopened from the archive skip plugin loading altogether
+        uint32_t data_hash = 0;
+        const bool cache_enabled = nfc_device_get_data_hash(device, &data_hash);
+        if(cache_enabled) {
+            nfc_supported_cards_parse_cache_get_path(device, cache_path);
+            if(nfc_supported_cards_parse_cache_load(
+                   instance, cache_path, protocol, data_hash, &plugin_index, parsed_data)) {
+                card_parsed = (plugin_index != NFC_SUPPORTED_CARDS_PLUGIN_INDEX_NONE);
+                nfc_supported_cards_set_resident(instance, plugin_index);
+                break;
+            }
+        }
 
-        NfcSupportedCardsPluginCache_it_t iter;
-        for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
-            !NfcSupportedCardsPluginCache_end_p(iter);
-            NfcSupportedCardsPluginCache_next(iter)) {
-            NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
+        const size_t plugins_num = NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
+        for(size_t i = 0; i < plugins_num; i++) {
+            const size_t index = nfc_supported_cards_get_plugin_index(instance, i);
+            const NfcSupportedCardsPluginCache* plugin_cache =
+                NfcSupportedCardsPluginCache_cget(instance->plugins_cache_arr, index);
             if(plugin_cache->protocol != protocol) continue;
             if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasParse) == 0) continue;
 
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
-                instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
+            const NfcSupportedCardsPlugin* plugin =
+                nfc_supported_cards_get_cached_plugin(instance, plugin_cache);
             if(plugin == NULL) continue;
 
             if(plugin->parse) {
                 if(plugin->parse(device, parsed_data)) {
+                    plugin_index = index;
                     card_parsed = true;
                     break;
                 }
             }
         }
 
-        nfc_supported_cards_load_context_free(instance->load_context);
+        nfc_supported_cards_set_resident(instance, plugin_index);
+
+        if(cache_enabled) {
+            nfc_supported_cards_parse_cache_save(
+                instance, cache_path, protocol, data_hash, plugin_index, parsed_data);
+        }
     } while(false);
 
+    furi_string_free(cache_path);
+
     return card_parsed;
 }
@@ -32,6 +32,7 @@
 #include "helpers/mf_user_dict.h"
 #include "helpers/mfkey32_logger.h"
 #include "helpers/mf_classic_key_cache.h"
+#include "helpers/mf_classic_key_rank.h"
 #include "helpers/nfc_supported_cards.h"
 #include "helpers/felica_auth.h"
 #include "helpers/slix_unlock.h"
@@ -71,8 +72,9 @@
 #define NFC_APP_SHADOW_EXTENSION  ".shd"
 #define NFC_APP_FILENAME_PREFIX   "NFC"
 
-#define NFC_APP_MFKEY32_LOGS_FILE_NAME ".mfkey32.log"
-#define NFC_APP_MFKEY32_LOGS_FILE_PATH (NFC_APP_FOLDER "/" NFC_APP_MFKEY32_LOGS_FILE_NAME)
+#define NFC_APP_MFKEY32_LOGS_FILE_NAME    ".mfkey32.log"
+#define NFC_APP_MFKEY32_LOGS_FILE_PATH    (NFC_APP_FOLDER "/" NFC_APP_MFKEY32_LOGS_FILE_NAME)
+#define NFC_APP_MFKEY32_JOURNAL_FILE_PATH (NFC_APP_FOLDER "/.mfkey32.journal")
 
 #define NFC_APP_MF_CLASSIC_DICT_USER_PATH (NFC_APP_FOLDER "/assets/mf_classic_dict_user.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_USER_NESTED_PATH \
@@ -80,14 +82,27 @@
 #define NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH (NFC_APP_FOLDER "/assets/mf_classic_dict.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_SYSTEM_NESTED_PATH \
     (NFC_APP_FOLDER "/assets/mf_classic_dict_nested.nfc")
+#define NFC_APP_MF_CLASSIC_DICT_SYSTEM_BINARY_PATH \
+    (NFC_APP_FOLDER "/assets/.mf_classic_dict.bin")
 
 typedef enum {
     NfcRpcStateIdle,
     NfcRpcStateEmulating,
 } NfcRpcState;
 
+#define NFC_APP_MF_CLASSIC_FREQUENT_KEYS_MAX (8U)
+#define NFC_APP_MF_CLASSIC_RANKED_KEYS_MAX   (32U)
+#define NFC_APP_MF_CLASSIC_DICT_RANK_SIZE    (256U)
+#define NFC_APP_MF_CLASSIC_DICT_RANK_PATH    APP_DATA_PATH(".mf_classic_dict_rank")
+
 typedef struct {
     KeysDict* dict;
+    MfClassicKeyRank* dict_rank;
+    MfClassicKey ranked_keys[NFC_APP_MF_CLASSIC_RANKED_KEYS_MAX];
+    // Same keys as numbers in ascending order, skipped when met in dictionary
+    uint64_t ranked_keys_sorted[NFC_APP_MF_CLASSIC_RANKED_KEYS_MAX];
+    size_t ranked_keys_num;
+    size_t ranked_keys_pos;
     uint8_t sectors_total;
     uint8_t sectors_read;
     uint8_t current_sector;
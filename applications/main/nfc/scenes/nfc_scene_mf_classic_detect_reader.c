@@ -68,7 +68,7 @@ void nfc_scene_mf_classic_detect_reader_on_enter(void* context) {
         nfc_device_get_data(instance->nfc_device, NfcProtocolIso14443_3a);
     uint32_t cuid = iso14443_3a_get_cuid(iso3_data);
 
-    instance->mfkey32_logger = mfkey32_logger_alloc(cuid);
+    instance->mfkey32_logger = mfkey32_logger_alloc(cuid, NFC_APP_MFKEY32_JOURNAL_FILE_PATH);
     instance->timer =
         furi_timer_alloc(nfc_scene_mf_classic_timer_callback, FuriTimerTypeOnce, instance);
 
@@ -96,6 +96,7 @@ bool nfc_scene_mf_classic_detect_reader_on_event(void* context, SceneManagerEven
         if(event.event == NfcCustomEventWorkerUpdate) {
             furi_timer_stop(instance->timer);
             notification_message(instance->notifications, &sequence_blink_start_cyan);
+            mfkey32_logger_flush(instance->mfkey32_logger);
 
             size_t nonces_pairs = 2 * mfkey32_logger_get_params_num(instance->mfkey32_logger);
             detect_reader_set_state(instance->detect_reader, DetectReaderStateReaderDetected);
@@ -14,6 +14,89 @@ typedef enum {
     DictAttackStateSystemDictInProgress,
 } DictAttackState;
 
+static bool nfc_dict_attack_is_ranked_key(
+    const NfcMfClassicDictAttackContext* dict_context,
+    const MfClassicKey* key) {
+    const uint64_t key_num = bit_lib_bytes_to_num_be(key->data, sizeof(MfClassicKey));
+    size_t low = 0;
+    size_t high = dict_context->ranked_keys_num;
+
+    while(low < high) {
+        const size_t middle = low + (high - low) / 2;
+        if(dict_context->ranked_keys_sorted[middle] < key_num) {
+            low = middle + 1;
+        } else if(dict_context->ranked_keys_sorted[middle] > key_num) {
+            high = middle;
+        } else {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void nfc_dict_attack_add_ranked_key(
+    NfcMfClassicDictAttackContext* dict_context,
+    const MfClassicKey* key) {
+    if(dict_context->ranked_keys_num >= NFC_APP_MF_CLASSIC_RANKED_KEYS_MAX) return;
+    if(nfc_dict_attack_is_ranked_key(dict_context, key)) return;
+
+    dict_context->ranked_keys[dict_context->ranked_keys_num] = *key;
+
+    const uint64_t key_num = bit_lib_bytes_to_num_be(key->data, sizeof(MfClassicKey));
+    size_t index = dict_context->ranked_keys_num++;
+    while(index > 0 && dict_context->ranked_keys_sorted[index - 1] > key_num) {
+        dict_context->ranked_keys_sorted[index] = dict_context->ranked_keys_sorted[index - 1];
+        index--;
+    }
+    dict_context->ranked_keys_sorted[index] = key_num;
+}
+
+static void nfc_dict_attack_load_ranked_keys(NfcApp* instance) {
+    NfcMfClassicDictAttackContext* dict_context = &instance->nfc_dict_context;
+    MfClassicKey keys[NFC_APP_MF_CLASSIC_RANKED_KEYS_MAX];
+
+    dict_context->ranked_keys_num = 0;
+    dict_context->ranked_keys_pos = 0;
+
+    // Keys shared by saved cards first, then keys that opened cards read before
+    size_t keys_num = mf_classic_key_cache_get_frequent_keys(
+        instance->mfc_key_cache, keys, NFC_APP_MF_CLASSIC_FREQUENT_KEYS_MAX);
+    for(size_t i = 0; i < keys_num; i++) {
+        nfc_dict_attack_add_ranked_key(dict_context, &keys[i]);
+    }
+
+    keys_num = mf_classic_key_rank_get_keys(
+        dict_context->dict_rank, keys, NFC_APP_MF_CLASSIC_RANKED_KEYS_MAX, 1);
+    for(size_t i = 0; i < keys_num; i++) {
+        nfc_dict_attack_add_ranked_key(dict_context, &keys[i]);
+    }
+}
+
+static bool nfc_dict_attack_get_next_key(
+    NfcMfClassicDictAttackContext* dict_context,
+    MfClassicKey* key) {
+    // Ranked keys go before the dictionary, which then skips them
+    if(dict_context->ranked_keys_pos < dict_context->ranked_keys_num) {
+        *key = dict_context->ranked_keys[dict_context->ranked_keys_pos++];
+        return true;
+    }
+
+    while(keys_dict_get_next_key(dict_context->dict, key->data, sizeof(MfClassicKey))) {
+        if(!nfc_dict_attack_is_ranked_key(dict_context, key)) return true;
+        // Keep progress in line with dictionary size
+        dict_context->dict_keys_current++;
+    }
+
+    return false;
+}
+
+static void nfc_dict_attack_rewind(NfcMfClassicDictAttackContext* dict_context) {
+    keys_dict_rewind(dict_context->dict);
+    dict_context->ranked_keys_pos = 0;
+    dict_context->dict_keys_current = 0;
+}
+
 NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context) {
     furi_assert(context);
     furi_assert(event.event_data);
@@ -37,6 +120,7 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
                                                 MfClassicPollerModeDictAttackEnhanced :
                                                 MfClassicPollerModeDictAttackStandard;
         mfc_event->data->poller_mode.data = mfc_data;
+        mfc_event->data->poller_mode.key_batch = true;
         instance->nfc_dict_context.sectors_total =
             mf_classic_get_total_sectors_num(mfc_data->type);
         mf_classic_get_read_sectors_and_keys(
@@ -47,8 +131,7 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
         MfClassicKey key = {};
-        if(keys_dict_get_next_key(
-               instance->nfc_dict_context.dict, key.data, sizeof(MfClassicKey))) {
+        if(nfc_dict_attack_get_next_key(&instance->nfc_dict_context, &key)) {
             mfc_event->data->key_request_data.key = key;
             mfc_event->data->key_request_data.key_provided = true;
             instance->nfc_dict_context.dict_keys_current++;
@@ -59,6 +142,19 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         } else {
             mfc_event->data->key_request_data.key_provided = false;
         }
+    } else if(mfc_event->type == MfClassicPollerEventTypeRequestKeyBatch) {
+        MfClassicPollerEventDataKeyBatchRequest* batch = &mfc_event->data->key_batch_request_data;
+        batch->keys_num = 0;
+        while(batch->keys_num < batch->keys_max &&
+              nfc_dict_attack_get_next_key(
+                  &instance->nfc_dict_context, &batch->keys[batch->keys_num])) {
+            batch->keys_num++;
+        }
+        if(batch->keys_num) {
+            instance->nfc_dict_context.dict_keys_current += batch->keys_num;
+            view_dispatcher_send_custom_event(
+                instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
+        }
     } else if(mfc_event->type == MfClassicPollerEventTypeDataUpdate) {
         MfClassicPollerEventDataUpdate* data_update = &mfc_event->data->data_update;
         instance->nfc_dict_context.sectors_read = data_update->sectors_read;
@@ -72,8 +168,7 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeNextSector) {
-        keys_dict_rewind(instance->nfc_dict_context.dict);
-        instance->nfc_dict_context.dict_keys_current = 0;
+        nfc_dict_attack_rewind(&instance->nfc_dict_context);
         instance->nfc_dict_context.current_sector =
             mfc_event->data->next_sector_data.current_sector;
         view_dispatcher_send_custom_event(
@@ -91,9 +186,8 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) {
-        keys_dict_rewind(instance->nfc_dict_context.dict);
+        nfc_dict_attack_rewind(&instance->nfc_dict_context);
         instance->nfc_dict_context.is_key_attack = false;
-        instance->nfc_dict_context.dict_keys_current = 0;
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeSuccess) {
@@ -209,13 +303,34 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
         } while(false);
     }
     if(state == DictAttackStateSystemDictInProgress) {
-        instance->nfc_dict_context.dict = keys_dict_alloc(
-            NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH, KeysDictModeOpenExisting, sizeof(MfClassicKey));
+        // Binary copy is iterated without parsing text, fall back to text if it can't be made
+        const char* dict_path = NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH;
+        if(keys_dict_binary_update(
+               NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH,
+               NFC_APP_MF_CLASSIC_DICT_SYSTEM_BINARY_PATH,
+               sizeof(MfClassicKey))) {
+            dict_path = NFC_APP_MF_CLASSIC_DICT_SYSTEM_BINARY_PATH;
+        }
+        instance->nfc_dict_context.dict =
+            keys_dict_alloc(dict_path, KeysDictModeOpenExisting, sizeof(MfClassicKey));
+        if((dict_path != NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH) &&
+           (keys_dict_get_total_keys(instance->nfc_dict_context.dict) == 0)) {
+            // Damaged binary copy: drop it so it's rebuilt next time, use text list now
+            keys_dict_free(instance->nfc_dict_context.dict);
+            storage_simply_remove(instance->storage, NFC_APP_MF_CLASSIC_DICT_SYSTEM_BINARY_PATH);
+            instance->nfc_dict_context.dict = keys_dict_alloc(
+                NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH,
+                KeysDictModeOpenExisting,
+                sizeof(MfClassicKey));
+        }
         dict_attack_set_header(instance->dict_attack, "MF Classic System Dictionary");
     }
 
+    nfc_dict_attack_load_ranked_keys(instance);
+
     instance->nfc_dict_context.dict_keys_total =
-        keys_dict_get_total_keys(instance->nfc_dict_context.dict);
+        keys_dict_get_total_keys(instance->nfc_dict_context.dict) +
+        instance->nfc_dict_context.ranked_keys_num;
     dict_attack_set_total_dict_keys(
         instance->dict_attack, instance->nfc_dict_context.dict_keys_total);
     instance->nfc_dict_context.dict_keys_current = 0;
@@ -230,6 +345,9 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
 void nfc_scene_mf_classic_dict_attack_on_enter(void* context) {
     NfcApp* instance = context;
 
+    instance->nfc_dict_context.dict_rank = mf_classic_key_rank_alloc(
+        NFC_APP_MF_CLASSIC_DICT_RANK_PATH, NFC_APP_MF_CLASSIC_DICT_RANK_SIZE);
+
     scene_manager_set_scene_state(
         instance->scene_manager, NfcSceneMfClassicDictAttack, DictAttackStateCUIDDictInProgress);
     nfc_scene_mf_classic_dict_attack_prepare_view(instance);
@@ -359,6 +477,14 @@ void nfc_scene_mf_classic_dict_attack_on_exit(void* context) {
     NfcApp* instance = context;
 
     nfc_poller_stop(instance->poller);
+
+    // Keys found on this card move up for the next cards
+    const MfClassicData* mfc_data = nfc_poller_get_data(instance->poller);
+    mf_classic_key_rank_add_card(instance->nfc_dict_context.dict_rank, mfc_data);
+    mf_classic_key_rank_save(instance->nfc_dict_context.dict_rank);
+    mf_classic_key_rank_free(instance->nfc_dict_context.dict_rank);
+    instance->nfc_dict_context.dict_rank = NULL;
+
     nfc_poller_free(instance->poller);
 
     dict_attack_reset(instance->dict_attack);
@@ -6,6 +6,10 @@
 
 #define TAG "SubghzFrequencyAnalyzerWorker"
 
+// PLL settles in under 100us, RSSI follows quickly with wide filter. Narrow one needs more
+#define SUBGHZ_FREQUENCY_ANALYZER_COARSE_DWELL_MS (1U)
+#define SUBGHZ_FREQUENCY_ANALYZER_FINE_DWELL_MS   (2U)
+
 static const uint8_t subghz_preset_ook_58khz[][2] = {
     {CC1101_MDMCFG4, 0b11110111}, // Rx BW filter is 58.035714kHz
     /* End  */
@@ -28,8 +32,15 @@ struct SubGhzFrequencyAnalyzerWorker {
 
     float filVal;
 
+    uint32_t* channels;
+    SubGhzFrequencyAnalyzerSample* samples;
+    size_t channel_count;
+    CC1101CalibrationCache calibration_cache; // Coarse channels only
+
     SubGhzFrequencyAnalyzerWorkerPairCallback pair_callback;
     void* context;
+    SubGhzFrequencyAnalyzerWorkerFrameCallback frame_callback;
+    void* frame_context;
 };
 
 static void subghz_frequency_analyzer_worker_load_registers(const uint8_t data[][2]) {
@@ -42,6 +53,67 @@ static void subghz_frequency_analyzer_worker_load_registers(const uint8_t data[]
     furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
 }
 
+/** Tune to frequency and start RX
+ *
+ * Coarse channels are the same on every sweep, so they keep synthesizer calibration
+ * and only the first sweep pays for it.
+ *
+ * @param instance SubGhzFrequencyAnalyzerWorker instance
+ * @param frequency frequency in Hz
+ * @param cached use calibration cache
+ * @return synthesized frequency
+ */
+static uint32_t subghz_frequency_analyzer_worker_tune(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    uint32_t frequency,
+    bool cached) {
+    FuriHalSpiBusHandle* handle = &furi_hal_spi_bus_handle_subghz;
+
+    furi_hal_spi_acquire(handle);
+    cc1101_switch_to_idle(handle);
+
+    if(cached) {
+        frequency =
+            cc1101_set_frequency_calibrated(handle, &instance->calibration_cache, frequency);
+        furi_check(frequency);
+    } else {
+        frequency = cc1101_set_frequency(handle, frequency);
+        cc1101_calibrate(handle);
+        furi_check(cc1101_wait_status_state(handle, CC1101StateIDLE, 10000));
+    }
+
+    cc1101_switch_to_rx(handle);
+    furi_hal_spi_release(handle);
+
+    return frequency;
+}
+
+static void subghz_frequency_analyzer_worker_channels_alloc(
+    SubGhzFrequencyAnalyzerWorker* instance) {
+    const size_t frequency_count = subghz_setting_get_frequency_count(instance->setting);
+    instance->channels = malloc(sizeof(uint32_t) * frequency_count);
+    instance->samples = malloc(sizeof(SubGhzFrequencyAnalyzerSample) * frequency_count);
+    instance->channel_count = 0;
+
+    for(size_t i = 0; i < frequency_count; i++) {
+        const uint32_t frequency = subghz_setting_get_frequency(instance->setting, i);
+        if(furi_hal_subghz_is_frequency_valid(frequency)) {
+            instance->channels[instance->channel_count++] = frequency;
+        }
+    }
+
+    cc1101_calibration_cache_reset(&instance->calibration_cache);
+}
+
+static void subghz_frequency_analyzer_worker_channels_free(
+    SubGhzFrequencyAnalyzerWorker* instance) {
+    free(instance->channels);
+    free(instance->samples);
+    instance->channels = NULL;
+    instance->samples = NULL;
+    instance->channel_count = 0;
+}
+
 // running average with adaptive coefficient
 static uint32_t subghz_frequency_analyzer_worker_expRunningAverageAdaptive(
     SubGhzFrequencyAnalyzerWorker* instance,
@@ -73,6 +145,8 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
     float rssi_temp = -127.0f;
     uint32_t frequency_temp = 0;
 
+    subghz_frequency_analyzer_worker_channels_alloc(instance);
+
     //Start CC1101
     furi_hal_subghz_reset();
 
@@ -112,39 +186,36 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
         subghz_frequency_analyzer_worker_load_registers(subghz_preset_ook_650khz);
 
         // First stage: coarse scan
-        for(size_t i = 0; i < subghz_setting_get_frequency_count(instance->setting); i++) {
-            if(furi_hal_subghz_is_frequency_valid(
-                   subghz_setting_get_frequency(instance->setting, i))) {
-                furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
-                cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
-                frequency = cc1101_set_frequency(
-                    &furi_hal_spi_bus_handle_subghz,
-                    subghz_setting_get_frequency(instance->setting, i));
-
-                cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
+        for(size_t i = 0; i < instance->channel_count; i++) {
+            frequency =
+                subghz_frequency_analyzer_worker_tune(instance, instance->channels[i], true);
 
-                furi_check(cc1101_wait_status_state(
-                    &furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
+            furi_delay_ms(SUBGHZ_FREQUENCY_ANALYZER_COARSE_DWELL_MS);
 
-                cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
-                furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
+            rssi = furi_hal_subghz_get_rssi();
 
-                furi_delay_ms(2);
+            instance->samples[i].frequency = frequency;
+            instance->samples[i].rssi = rssi;
 
-                rssi = furi_hal_subghz_get_rssi();
+            rssi_avg += rssi;
+            rssi_avg_samples++;
 
-                rssi_avg += rssi;
-                rssi_avg_samples++;
+            if(rssi < rssi_min) rssi_min = rssi;
 
-                if(rssi < rssi_min) rssi_min = rssi;
-
-                if(frequency_rssi.rssi_coarse < rssi) {
-                    frequency_rssi.rssi_coarse = rssi;
-                    frequency_rssi.frequency_coarse = frequency;
-                }
+            if(frequency_rssi.rssi_coarse < rssi) {
+                frequency_rssi.rssi_coarse = rssi;
+                frequency_rssi.frequency_coarse = frequency;
             }
         }
 
+        if(instance->frame_callback) {
+            const SubGhzFrequencyAnalyzerFrame frame = {
+                .samples = instance->samples,
+                .count = instance->channel_count,
+            };
+            instance->frame_callback(instance->frame_context, &frame);
+        }
+
         FURI_LOG_T(
             TAG,
             "RSSI: avg %f, max %f at %lu, min %f",
@@ -162,19 +233,9 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
                 i < frequency_rssi.frequency_coarse + 300000;
                 i += 20000) {
                 if(furi_hal_subghz_is_frequency_valid(i)) {
-                    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
-                    cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
-                    frequency = cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, i);
-
-                    cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
-
-                    furi_check(cc1101_wait_status_state(
-                        &furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
+                    frequency = subghz_frequency_analyzer_worker_tune(instance, i, false);
 
-                    cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
-                    furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
-
-                    furi_delay_ms(2);
+                    furi_delay_ms(SUBGHZ_FREQUENCY_ANALYZER_FINE_DWELL_MS);
 
                     rssi = furi_hal_subghz_get_rssi();
 
@@ -250,6 +311,8 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
     furi_hal_subghz_idle();
     furi_hal_subghz_sleep();
 
+    subghz_frequency_analyzer_worker_channels_free(instance);
+
     return 0;
 }
 
@@ -281,6 +344,15 @@ void subghz_frequency_analyzer_worker_set_pair_callback(
     instance->context = context;
 }
 
+void subghz_frequency_analyzer_worker_set_frame_callback(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    SubGhzFrequencyAnalyzerWorkerFrameCallback callback,
+    void* context) {
+    furi_assert(instance);
+    instance->frame_callback = callback;
+    instance->frame_context = context;
+}
+
 void subghz_frequency_analyzer_worker_start(SubGhzFrequencyAnalyzerWorker* instance) {
     furi_assert(instance);
     furi_assert(!instance->worker_running);
@@ -13,6 +13,24 @@ typedef void (*SubGhzFrequencyAnalyzerWorkerPairCallback)(
     float rssi,
     bool signal);
 
+typedef struct {
+    uint32_t frequency;
+    float rssi;
+} SubGhzFrequencyAnalyzerSample;
+
+/** Spectrum frame, one sample per coarse channel
+ *
+ * Samples are owned by worker and valid only during callback
+ */
+typedef struct {
+    const SubGhzFrequencyAnalyzerSample* samples;
+    size_t count;
+} SubGhzFrequencyAnalyzerFrame;
+
+typedef void (*SubGhzFrequencyAnalyzerWorkerFrameCallback)(
+    void* context,
+    const SubGhzFrequencyAnalyzerFrame* frame);
+
 typedef struct {
     uint32_t frequency_coarse;
     float rssi_coarse;
@@ -44,6 +62,17 @@ void subghz_frequency_analyzer_worker_set_pair_callback(
     SubGhzFrequencyAnalyzerWorkerPairCallback callback,
     void* context);
 
+/** Frame callback SubGhzFrequencyAnalyzerWorker, called from worker thread after each sweep
+ * 
+ * @param instance SubGhzFrequencyAnalyzerWorker instance
+ * @param callback SubGhzFrequencyAnalyzerWorkerFrameCallback callback
+ * @param context 
+ */
+void subghz_frequency_analyzer_worker_set_frame_callback(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    SubGhzFrequencyAnalyzerWorkerFrameCallback callback,
+    void* context);
+
 /** Start SubGhzFrequencyAnalyzerWorker
  * 
  * @param instance SubGhzFrequencyAnalyzerWorker instance
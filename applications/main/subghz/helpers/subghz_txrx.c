@@ -6,6 +6,11 @@
 
 #define TAG "SubGhz"
 
+#define SUBGHZ_HOPPER_RSSI_MIN        (-90.0f)
+#define SUBGHZ_HOPPER_DWELL_TICKS     (10U) // Hold after the last RSSI hit
+#define SUBGHZ_HOPPER_DWELL_MAX_TICKS (50U) // Long transmissions must not starve other channels
+#define SUBGHZ_HOPPER_ACTIVITY_HIT    (64U)
+
 static void subghz_txrx_radio_device_power_on(SubGhzTxRx* instance) {
     UNUSED(instance);
     uint8_t attempts = 5;
@@ -27,6 +32,27 @@ static void subghz_txrx_radio_device_power_off(SubGhzTxRx* instance) {
     if(furi_hal_power_is_otg_enabled()) furi_hal_power_disable_otg();
 }
 
+static void subghz_txrx_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    SubGhzTxRx* instance = context;
+
+    furi_check(furi_mutex_acquire(instance->rx_mutex, FuriWaitForever) == FuriStatusOk);
+    if(instance->rx_callback) {
+        instance->rx_callback(receiver, decoder_base, instance->rx_callback_context);
+    }
+    furi_mutex_release(instance->rx_mutex);
+}
+
+static void subghz_txrx_worker_set_receiver(SubGhzWorker* worker, SubGhzReceiver* receiver) {
+    subghz_worker_set_overrun_callback(worker, (SubGhzWorkerOverrunCallback)subghz_receiver_reset);
+    subghz_worker_set_pair_callback(worker, (SubGhzWorkerPairCallback)subghz_receiver_decode);
+    subghz_worker_set_pair_batch_callback(
+        worker, (SubGhzWorkerPairBatchCallback)subghz_receiver_decode_batch);
+    subghz_worker_set_context(worker, receiver);
+}
+
 SubGhzTxRx* subghz_txrx_alloc(void) {
     SubGhzTxRx* instance = malloc(sizeof(SubGhzTxRx));
     instance->setting = subghz_setting_alloc();
@@ -37,9 +63,15 @@ SubGhzTxRx* subghz_txrx_alloc(void) {
     subghz_txrx_set_preset(
         instance, "AM650", subghz_setting_get_default_frequency(instance->setting), NULL, 0);
 
+    instance->secondary.preset = malloc(sizeof(SubGhzRadioPreset));
+    instance->secondary.preset->name = furi_string_alloc_set("AM650");
+
     instance->txrx_state = SubGhzTxRxStateSleep;
 
     subghz_txrx_hopper_set_state(instance, SubGhzHopperStateOFF);
+    instance->hopper_channel_count = subghz_setting_get_hopper_frequency_count(instance->setting);
+    instance->hopper_channels =
+        malloc(MAX(instance->hopper_channel_count, 1U) * sizeof(SubGhzTxRxHopperChannel));
     subghz_txrx_speaker_set_state(instance, SubGhzSpeakerStateDisable);
 
     instance->worker = subghz_worker_alloc();
@@ -58,12 +90,11 @@ SubGhzTxRx* subghz_txrx_alloc(void) {
     subghz_environment_set_protocol_registry(
         instance->environment, (void*)&subghz_protocol_registry);
     instance->receiver = subghz_receiver_alloc_init(instance->environment);
+    instance->filter = SubGhzProtocolFlag_Decodable;
+    instance->rx_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    subghz_receiver_set_rx_callback(instance->receiver, subghz_txrx_rx_callback, instance);
 
-    subghz_worker_set_overrun_callback(
-        instance->worker, (SubGhzWorkerOverrunCallback)subghz_receiver_reset);
-    subghz_worker_set_pair_callback(
-        instance->worker, (SubGhzWorkerPairCallback)subghz_receiver_decode);
-    subghz_worker_set_context(instance->worker, instance->receiver);
+    subghz_txrx_worker_set_receiver(instance->worker, instance->receiver);
 
     //set default device External
     subghz_devices_init();
@@ -84,13 +115,18 @@ void subghz_txrx_free(SubGhzTxRx* instance) {
 
     subghz_devices_deinit();
 
+    furi_assert(!instance->secondary.worker);
     subghz_worker_free(instance->worker);
     subghz_receiver_free(instance->receiver);
+    furi_mutex_free(instance->rx_mutex);
     subghz_environment_free(instance->environment);
     flipper_format_free(instance->fff_data);
     furi_string_free(instance->preset->name);
     subghz_setting_free(instance->setting);
 
+    furi_string_free(instance->secondary.preset->name);
+    free(instance->secondary.preset);
+    free(instance->hopper_channels);
     free(instance->preset);
     free(instance);
 }
@@ -176,8 +212,13 @@ static uint32_t subghz_txrx_rx(SubGhzTxRx* instance, uint32_t frequency) {
     subghz_devices_flush_rx(instance->radio_device);
     subghz_txrx_speaker_on(instance);
 
-    subghz_devices_start_async_rx(
-        instance->radio_device, subghz_worker_rx_callback, instance->worker);
+    // Mirroring to the speaker needs an interrupt per edge
+    if(instance->speaker_state == SubGhzSpeakerStateEnable ||
+       !subghz_devices_start_async_rx_batch(
+           instance->radio_device, subghz_worker_rx_batch_callback, instance->worker)) {
+        subghz_devices_start_async_rx(
+            instance->radio_device, subghz_worker_rx_callback, instance->worker);
+    }
     subghz_worker_start(instance->worker);
     instance->txrx_state = SubGhzTxRxStateRx;
     return value;
@@ -300,6 +341,62 @@ SubGhzTxRxStartTxState subghz_txrx_tx_start(SubGhzTxRx* instance, FlipperFormat*
     return ret;
 }
 
+static void subghz_txrx_secondary_rx_start(SubGhzTxRx* instance) {
+    SubGhzTxRxSecondary* secondary = &instance->secondary;
+    furi_assert(!secondary->worker);
+
+    // RAW recording stays on a single radio
+    if(!subghz_txrx_secondary_is_available(instance) || !secondary->preset->frequency ||
+       !(instance->filter & SubGhzProtocolFlag_Decodable)) {
+        return;
+    }
+
+    secondary->radio_device = subghz_devices_get_by_name(SUBGHZ_DEVICE_CC1101_INT_NAME);
+    if(!subghz_devices_is_frequency_valid(secondary->radio_device, secondary->preset->frequency)) {
+        FURI_LOG_W(TAG, "Second radio: invalid frequency %lu", secondary->preset->frequency);
+        return;
+    }
+
+    // Own decoders, they keep state between pulses. Keystores are shared.
+    secondary->receiver = subghz_receiver_alloc_init(instance->environment);
+    subghz_receiver_set_filter(secondary->receiver, instance->filter);
+    subghz_receiver_set_rx_callback(secondary->receiver, subghz_txrx_rx_callback, instance);
+    secondary->worker = subghz_worker_alloc();
+    subghz_txrx_worker_set_receiver(secondary->worker, secondary->receiver);
+
+    subghz_devices_reset(secondary->radio_device);
+    subghz_devices_idle(secondary->radio_device);
+    subghz_devices_load_preset(
+        secondary->radio_device,
+        FuriHalSubGhzPresetCustom,
+        subghz_setting_get_preset_data_by_name(
+            instance->setting, furi_string_get_cstr(secondary->preset->name)));
+    subghz_devices_set_frequency(secondary->radio_device, secondary->preset->frequency);
+    subghz_devices_flush_rx(secondary->radio_device);
+
+    if(!subghz_devices_start_async_rx_batch(
+           secondary->radio_device, subghz_worker_rx_batch_callback, secondary->worker)) {
+        subghz_devices_start_async_rx(
+            secondary->radio_device, subghz_worker_rx_callback, secondary->worker);
+    }
+    subghz_worker_start(secondary->worker);
+}
+
+static void subghz_txrx_secondary_rx_stop(SubGhzTxRx* instance) {
+    SubGhzTxRxSecondary* secondary = &instance->secondary;
+    if(!secondary->worker) return;
+
+    subghz_worker_stop(secondary->worker);
+    subghz_devices_stop_async_rx(secondary->radio_device);
+    subghz_devices_idle(secondary->radio_device);
+    subghz_devices_sleep(secondary->radio_device);
+
+    subghz_worker_free(secondary->worker);
+    subghz_receiver_free(secondary->receiver);
+    secondary->worker = NULL;
+    secondary->receiver = NULL;
+}
+
 void subghz_txrx_rx_start(SubGhzTxRx* instance) {
     furi_assert(instance);
     subghz_txrx_stop(instance);
@@ -308,6 +405,7 @@ void subghz_txrx_rx_start(SubGhzTxRx* instance) {
         subghz_setting_get_preset_data_by_name(
             subghz_txrx_get_setting(instance), furi_string_get_cstr(instance->preset->name)));
     subghz_txrx_rx(instance, instance->preset->frequency);
+    subghz_txrx_secondary_rx_start(instance);
 }
 
 void subghz_txrx_set_need_save_callback(
@@ -350,6 +448,8 @@ SubGhzSetting* subghz_txrx_get_setting(SubGhzTxRx* instance) {
 void subghz_txrx_stop(SubGhzTxRx* instance) {
     furi_assert(instance);
 
+    subghz_txrx_secondary_rx_stop(instance);
+
     switch(instance->txrx_state) {
     case SubGhzTxRxStateTx:
         subghz_txrx_tx_stop(instance);
@@ -365,43 +465,71 @@ void subghz_txrx_stop(SubGhzTxRx* instance) {
     }
 }
 
-void subghz_txrx_hopper_update(SubGhzTxRx* instance) {
+static uint8_t subghz_txrx_hopper_select(SubGhzTxRx* instance) {
+    const size_t count = instance->hopper_channel_count;
+    const size_t current = instance->hopper_idx_frequency;
+    size_t next = (current + 1) % count;
+    uint32_t next_priority = 0;
+
+    // Longest unvisited goes first, recent activity makes a channel wait less.
+    // Quiet band gives plain round robin, ties are resolved in hopping order.
+    for(size_t i = 1; i < count; i++) {
+        const size_t idx = (current + i) % count;
+        const SubGhzTxRxHopperChannel* channel = &instance->hopper_channels[idx];
+        const uint32_t priority = (uint32_t)channel->age * (1U + channel->activity / 32U);
+        if(priority > next_priority) {
+            next = idx;
+            next_priority = priority;
+        }
+    }
+
+    return next;
+}
+
+void subghz_txrx_hopper_update(SubGhzTxRx* instance, float rssi_threshold) {
     furi_assert(instance);
 
-    switch(instance->hopper_state) {
-    case SubGhzHopperStateOFF:
-    case SubGhzHopperStatePause:
+    if(instance->hopper_state == SubGhzHopperStateOFF ||
+       instance->hopper_state == SubGhzHopperStatePause || !instance->hopper_channel_count) {
         return;
-    case SubGhzHopperStateRSSITimeOut:
-        if(instance->hopper_timeout != 0) {
-            instance->hopper_timeout--;
-            return;
+    }
+
+    for(size_t i = 0; i < instance->hopper_channel_count; i++) {
+        SubGhzTxRxHopperChannel* channel = &instance->hopper_channels[i];
+        if(channel->age < UINT16_MAX) channel->age++;
+    }
+
+    SubGhzTxRxHopperChannel* channel = &instance->hopper_channels[instance->hopper_idx_frequency];
+
+    // See RSSI Calculation timings in CC1101 17.3 RSSI
+    const float rssi = subghz_devices_get_rssi(instance->radio_device);
+
+    // Stay while RSSI is high enough
+    if(rssi > MAX(rssi_threshold, SUBGHZ_HOPPER_RSSI_MIN) &&
+       instance->hopper_dwell < SUBGHZ_HOPPER_DWELL_MAX_TICKS) {
+        if(instance->hopper_state != SubGhzHopperStateRSSITimeOut) {
+            channel->activity = MIN(channel->activity + SUBGHZ_HOPPER_ACTIVITY_HIT, UINT8_MAX);
         }
-        break;
-    default:
-        break;
+        instance->hopper_timeout = SUBGHZ_HOPPER_DWELL_TICKS;
+        instance->hopper_state = SubGhzHopperStateRSSITimeOut;
     }
-    float rssi = -127.0f;
-    if(instance->hopper_state != SubGhzHopperStateRSSITimeOut) {
-        // See RSSI Calculation timings in CC1101 17.3 RSSI
-        rssi = subghz_devices_get_rssi(instance->radio_device);
 
-        // Stay if RSSI is high enough
-        if(rssi > -90.0f) {
-            instance->hopper_timeout = 10;
-            instance->hopper_state = SubGhzHopperStateRSSITimeOut;
+    if(instance->hopper_state == SubGhzHopperStateRSSITimeOut) {
+        if(instance->hopper_timeout != 0) {
+            instance->hopper_timeout--;
+            instance->hopper_dwell++;
             return;
         }
-    } else {
         instance->hopper_state = SubGhzHopperStateRunnig;
     }
+
+    // Quiet visit, channel slowly loses its priority
+    if(!instance->hopper_dwell) channel->activity -= channel->activity / 8U;
+    instance->hopper_dwell = 0;
+
     // Select next frequency
-    if(instance->hopper_idx_frequency <
-       subghz_setting_get_hopper_frequency_count(instance->setting) - 1) {
-        instance->hopper_idx_frequency++;
-    } else {
-        instance->hopper_idx_frequency = 0;
-    }
+    instance->hopper_idx_frequency = subghz_txrx_hopper_select(instance);
+    instance->hopper_channels[instance->hopper_idx_frequency].age = 0;
 
     if(instance->txrx_state == SubGhzTxRxStateRx) {
         subghz_txrx_rx_end(instance);
@@ -525,14 +653,50 @@ bool subghz_txrx_protocol_is_transmittable(SubGhzTxRx* instance, bool check_type
 
 void subghz_txrx_receiver_set_filter(SubGhzTxRx* instance, SubGhzProtocolFlag filter) {
     furi_assert(instance);
+    instance->filter = filter;
     subghz_receiver_set_filter(instance->receiver, filter);
+    if(instance->secondary.receiver) {
+        subghz_receiver_set_filter(instance->secondary.receiver, filter);
+    }
 }
 
 void subghz_txrx_set_rx_calback(
     SubGhzTxRx* instance,
     SubGhzReceiverCallback callback,
     void* context) {
-    subghz_receiver_set_rx_callback(instance->receiver, callback, context);
+    furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->rx_mutex, FuriWaitForever) == FuriStatusOk);
+    instance->rx_callback = callback;
+    instance->rx_callback_context = context;
+    furi_mutex_release(instance->rx_mutex);
+}
+
+SubGhzRadioPreset subghz_txrx_get_receiver_preset(SubGhzTxRx* instance, SubGhzReceiver* receiver) {
+    furi_assert(instance);
+    if(receiver && receiver == instance->secondary.receiver) {
+        return *instance->secondary.preset;
+    }
+    return *instance->preset;
+}
+
+void subghz_txrx_secondary_set_preset(
+    SubGhzTxRx* instance,
+    const char* preset_name,
+    uint32_t frequency) {
+    furi_assert(instance);
+    furi_assert(preset_name);
+    furi_string_set(instance->secondary.preset->name, preset_name);
+    instance->secondary.preset->frequency = frequency;
+}
+
+SubGhzRadioPreset subghz_txrx_secondary_get_preset(SubGhzTxRx* instance) {
+    furi_assert(instance);
+    return *instance->secondary.preset;
+}
+
+bool subghz_txrx_secondary_is_available(SubGhzTxRx* instance) {
+    furi_assert(instance);
+    return instance->radio_device_type == SubGhzRadioDeviceTypeExternalCC1101;
 }
 
 void subghz_txrx_set_raw_file_encoder_worker_callback_end(
@@ -569,6 +733,7 @@ bool subghz_txrx_radio_device_is_external_connected(SubGhzTxRx* instance, const
 SubGhzRadioDeviceType
     subghz_txrx_radio_device_set(SubGhzTxRx* instance, SubGhzRadioDeviceType radio_device_type) {
     furi_assert(instance);
+    subghz_txrx_secondary_rx_stop(instance);
 
     if(radio_device_type == SubGhzRadioDeviceTypeExternalCC1101 &&
        subghz_txrx_radio_device_is_external_connected(instance, SUBGHZ_DEVICE_CC1101_EXT_NAME)) {
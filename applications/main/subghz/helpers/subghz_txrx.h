@@ -119,9 +119,13 @@ void subghz_txrx_sleep(SubGhzTxRx* instance);
 /**
  * Update frequency CC1101 in automatic mode (hopper)
  * 
+ * Hopper stays on a channel while RSSI is above the threshold, and visits
+ * channels that had activity recently more often
+ * 
  * @param instance Pointer to a SubGhzTxRx
+ * @param rssi_threshold RSSI threshold to stay on channel, values below -90 dBm are ignored
  */
-void subghz_txrx_hopper_update(SubGhzTxRx* instance);
+void subghz_txrx_hopper_update(SubGhzTxRx* instance, float rssi_threshold);
 
 /**
  * Get state hopper
@@ -278,6 +282,47 @@ void subghz_txrx_set_rx_calback(
     SubGhzReceiverCallback callback,
     void* context);
 
+/**
+ * Get preset of the radio that the receiver listens to
+ * 
+ * @param instance Pointer to a SubGhzTxRx
+ * @param receiver Receiver passed to the receive data callback
+ * @return SubGhzRadioPreset Preset
+ */
+SubGhzRadioPreset subghz_txrx_get_receiver_preset(SubGhzTxRx* instance, SubGhzReceiver* receiver);
+
+/**
+ * Set preset of the second radio
+ * 
+ * With the external radio selected, the internal one can receive at the same
+ * time, decoded data of both goes to the receive data callback. Applied on the
+ * next subghz_txrx_rx_start, not used for RAW recording and by the hopper.
+ * 
+ * @param instance Pointer to a SubGhzTxRx
+ * @param preset_name Name of preset
+ * @param frequency Frequency in Hz, 0 to turn the second radio off
+ */
+void subghz_txrx_secondary_set_preset(
+    SubGhzTxRx* instance,
+    const char* preset_name,
+    uint32_t frequency);
+
+/**
+ * Get preset of the second radio
+ * 
+ * @param instance Pointer to a SubGhzTxRx
+ * @return SubGhzRadioPreset Preset
+ */
+SubGhzRadioPreset subghz_txrx_secondary_get_preset(SubGhzTxRx* instance);
+
+/**
+ * Check if the second radio can be used
+ * 
+ * @param instance Pointer to a SubGhzTxRx
+ * @return bool True if the external radio is selected
+ */
+bool subghz_txrx_secondary_is_available(SubGhzTxRx* instance);
+
 /**
  * Set callback for Raw decoder, end of data transfer  
  * 
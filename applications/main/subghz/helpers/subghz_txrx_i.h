@@ -2,11 +2,26 @@
 
 #include "subghz_txrx.h"
 
+typedef struct {
+    uint16_t age; // Hopper updates since last visit
+    uint8_t activity; // Decaying score of RSSI hits
+} SubGhzTxRxHopperChannel;
+
+// Internal radio receiving next to the external one
+typedef struct {
+    SubGhzWorker* worker;
+    SubGhzReceiver* receiver;
+    SubGhzRadioPreset* preset; // Zero frequency: not used
+    const SubGhzDevice* radio_device;
+} SubGhzTxRxSecondary;
+
 struct SubGhzTxRx {
     SubGhzWorker* worker;
 
     SubGhzEnvironment* environment;
     SubGhzReceiver* receiver;
+    SubGhzTxRxSecondary secondary;
+    SubGhzProtocolFlag filter;
     SubGhzTransmitter* transmitter;
     SubGhzProtocolDecoderBase* decoder_result;
     FlipperFormat* fff_data;
@@ -15,7 +30,10 @@ struct SubGhzTxRx {
     SubGhzSetting* setting;
 
     uint8_t hopper_timeout;
+    uint8_t hopper_dwell;
     uint8_t hopper_idx_frequency;
+    SubGhzTxRxHopperChannel* hopper_channels;
+    size_t hopper_channel_count;
     bool is_database_loaded;
     SubGhzHopperState hopper_state;
 
@@ -24,6 +42,11 @@ struct SubGhzTxRx {
     const SubGhzDevice* radio_device;
     SubGhzRadioDeviceType radio_device_type;
 
+    // Both workers decode in their own threads, callbacks are serialized
+    FuriMutex* rx_mutex;
+    SubGhzReceiverCallback rx_callback;
+    void* rx_callback_context;
+
     SubGhzTxRxNeedSaveCallback need_save_callback;
     void* need_save_context;
 };
@@ -76,7 +76,7 @@ static void subghz_scene_add_to_history_callback(
     SubGhzHistory* history = subghz->history;
     FuriString* str_buff = furi_string_alloc();
 
-    SubGhzRadioPreset preset = subghz_txrx_get_preset(subghz->txrx);
+    SubGhzRadioPreset preset = subghz_txrx_get_receiver_preset(subghz->txrx, receiver);
 
     if(subghz_history_add_to_history(history, decoder_base, &preset)) {
         furi_string_reset(str_buff);
@@ -113,7 +113,7 @@ void subghz_scene_receiver_on_enter(void* context) {
 
     //Load history to receiver
     subghz_view_receiver_exit(subghz->subghz_receiver);
-    for(uint8_t i = 0; i < subghz_history_get_item(history); i++) {
+    for(uint16_t i = 0; i < subghz_history_get_item(history); i++) {
         furi_string_reset(str_buff);
         subghz_history_get_text_item_menu(history, str_buff, i);
         subghz_view_receiver_add_item_to_menu(
@@ -190,7 +190,8 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
         }
     } else if(event.type == SceneManagerEventTypeTick) {
         if(subghz_txrx_hopper_get_state(subghz->txrx) != SubGhzHopperStateOFF) {
-            subghz_txrx_hopper_update(subghz->txrx);
+            subghz_txrx_hopper_update(
+                subghz->txrx, subghz_threshold_rssi_get(subghz->threshold_rssi));
             subghz_scene_receiver_update_statusbar(subghz);
         }
 
@@ -8,6 +8,8 @@ enum SubGhzSettingIndex {
     SubGhzSettingIndexBinRAW,
     SubGhzSettingIndexSound,
     SubGhzSettingIndexLock,
+    SubGhzSettingIndexSecondFrequency,
+    SubGhzSettingIndexSecondModulation,
     SubGhzSettingIndexRAWThesholdRSSI,
 };
 
@@ -206,6 +208,41 @@ static void subghz_scene_receiver_config_set_hopping_running(VariableItem* item)
     subghz_txrx_hopper_set_state(subghz->txrx, hopping_value[index]);
 }
 
+// Index 0 turns the second radio off, frequencies follow
+static void subghz_scene_receiver_config_set_second_frequency(VariableItem* item) {
+    SubGhz* subghz = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    SubGhzSetting* setting = subghz_txrx_get_setting(subghz->txrx);
+    SubGhzRadioPreset preset = subghz_txrx_secondary_get_preset(subghz->txrx);
+
+    uint32_t frequency = 0;
+    if(index == 0) {
+        variable_item_set_current_value_text(item, "OFF");
+    } else {
+        char text_buf[10] = {0};
+        frequency = subghz_setting_get_frequency(setting, index - 1);
+        snprintf(
+            text_buf,
+            sizeof(text_buf),
+            "%lu.%02lu",
+            frequency / 1000000,
+            (frequency % 1000000) / 10000);
+        variable_item_set_current_value_text(item, text_buf);
+    }
+    subghz_txrx_secondary_set_preset(subghz->txrx, furi_string_get_cstr(preset.name), frequency);
+}
+
+static void subghz_scene_receiver_config_set_second_preset(VariableItem* item) {
+    SubGhz* subghz = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    SubGhzSetting* setting = subghz_txrx_get_setting(subghz->txrx);
+    SubGhzRadioPreset preset = subghz_txrx_secondary_get_preset(subghz->txrx);
+
+    variable_item_set_current_value_text(item, subghz_setting_get_preset_name(setting, index));
+    subghz_txrx_secondary_set_preset(
+        subghz->txrx, subghz_setting_get_preset_name(setting, index), preset.frequency);
+}
+
 static void subghz_scene_receiver_config_set_speaker(VariableItem* item) {
     SubGhz* subghz = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
@@ -324,6 +361,38 @@ void subghz_scene_receiver_config_on_enter(void* context) {
             subghz->variable_item_list,
             subghz_scene_receiver_config_var_list_enter_callback,
             subghz);
+
+        if(subghz_txrx_secondary_is_available(subghz->txrx)) {
+            SubGhzRadioPreset second = subghz_txrx_secondary_get_preset(subghz->txrx);
+
+            item = variable_item_list_add(
+                subghz->variable_item_list,
+                "Int. Radio:",
+                subghz_setting_get_frequency_count(setting) + 1,
+                subghz_scene_receiver_config_set_second_frequency,
+                subghz);
+            value_index = 0;
+            for(uint8_t i = 0; i < subghz_setting_get_frequency_count(setting); i++) {
+                if(second.frequency == subghz_setting_get_frequency(setting, i)) {
+                    value_index = i + 1;
+                    break;
+                }
+            }
+            variable_item_set_current_value_index(item, value_index);
+            subghz_scene_receiver_config_set_second_frequency(item);
+
+            item = variable_item_list_add(
+                subghz->variable_item_list,
+                "Int. Modulation:",
+                subghz_setting_get_preset_count(setting),
+                subghz_scene_receiver_config_set_second_preset,
+                subghz);
+            value_index = subghz_scene_receiver_config_next_preset(
+                furi_string_get_cstr(second.name), subghz);
+            variable_item_set_current_value_index(item, value_index);
+            variable_item_set_current_value_text(
+                item, subghz_setting_get_preset_name(setting, value_index));
+        }
     }
     if(scene_manager_get_scene_state(subghz->scene_manager, SubGhzSceneReadRAW) ==
        SubGhzCustomEventManagerSet) {
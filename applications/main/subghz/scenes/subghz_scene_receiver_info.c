@@ -120,7 +120,8 @@ bool subghz_scene_receiver_info_on_event(void* context, SceneManagerEvent event)
 
     } else if(event.type == SceneManagerEventTypeTick) {
         if(subghz_txrx_hopper_get_state(subghz->txrx) != SubGhzHopperStateOFF) {
-            subghz_txrx_hopper_update(subghz->txrx);
+            subghz_txrx_hopper_update(
+                subghz->txrx, subghz_threshold_rssi_get(subghz->threshold_rssi));
         }
         switch(subghz->state_notifications) {
         case SubGhzNotificationStateTx:
@@ -27,6 +27,8 @@
 
 #define TAG "SubGhzCli"
 
+#define SUBGHZ_CLI_DECODE_BATCH_SIZE 64
+
 static void subghz_cli_radio_device_power_on(void) {
     uint8_t attempts = 5;
     while(--attempts > 0) {
@@ -354,20 +356,23 @@ void subghz_cli_command_rx(Cli* cli, FuriString* args, void* context) {
         "Listening at frequency: %lu device: %lu. Press CTRL+C to stop\r\n",
         frequency,
         device_ind);
-    LevelDuration level_duration;
+    LevelDuration level_duration[SUBGHZ_CLI_DECODE_BATCH_SIZE];
     while(!cli_cmd_interrupt_received(cli)) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
-            if(level_duration_is_reset(level_duration)) {
+        size_t ret = furi_stream_buffer_receive(
+            instance->stream, level_duration, sizeof(level_duration), 10);
+        size_t count = ret / sizeof(LevelDuration);
+        size_t batch_start = 0;
+        for(size_t i = 0; i < count; i++) {
+            if(level_duration_is_reset(level_duration[i])) {
+                subghz_receiver_decode_batch(
+                    receiver, &level_duration[batch_start], i - batch_start);
+                batch_start = i + 1;
                 printf(".");
                 subghz_receiver_reset(receiver);
-            } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-                subghz_receiver_decode(receiver, level, duration);
             }
         }
+        subghz_receiver_decode_batch(
+            receiver, &level_duration[batch_start], count - batch_start);
     }
 
     // Shutdown radio
@@ -531,16 +536,23 @@ void subghz_cli_command_decode_raw(Cli* cli, FuriString* args, void* context) {
             "Listening at \033[0;33m%s\033[0m.\r\n\r\nPress CTRL+C to stop\r\n\r\n",
             furi_string_get_cstr(file_name));
 
-        LevelDuration level_duration;
-        while(!cli_cmd_interrupt_received(cli)) {
-            furi_delay_us(500); //you need to have time to read from the file from the SD card
-            level_duration = subghz_file_encoder_worker_get_level_duration(file_worker_encoder);
-            if(!level_duration_is_reset(level_duration)) {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-                subghz_receiver_decode(receiver, level, duration);
-            } else {
-                break;
+        LevelDuration level_duration[SUBGHZ_CLI_DECODE_BATCH_SIZE];
+        size_t count = 0;
+        bool is_end = false;
+        while(!is_end && !cli_cmd_interrupt_received(cli)) {
+            LevelDuration pulse =
+                subghz_file_encoder_worker_get_level_duration(file_worker_encoder);
+            is_end = level_duration_is_reset(pulse);
+            bool is_wait = level_duration_is_wait(pulse);
+            if(!is_end && !is_wait) {
+                level_duration[count++] = pulse;
+            }
+            if(is_end || is_wait || count == SUBGHZ_CLI_DECODE_BATCH_SIZE) {
+                subghz_receiver_decode_batch(receiver, level_duration, count);
+                count = 0;
+            }
+            if(is_wait) {
+                furi_delay_us(500); //you need to have time to read from the file from the SD card
             }
         }
 
@@ -1,35 +1,61 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/protocols/came.h>
+#include <toolbox/stream/file_stream.h>
 
 #include <furi.h>
 
-#define SUBGHZ_HISTORY_MAX       50
+#define SUBGHZ_HISTORY_MAX       250
 #define SUBGHZ_HISTORY_FREE_HEAP 20480
 
+/* Newest records keep serialized data in RAM, older ones are moved to SD card */
+#define SUBGHZ_HISTORY_RAM_WINDOW 20
+/* Records kept in RAM when SD card can not take them */
+#define SUBGHZ_HISTORY_RAM_MAX    50
+#define SUBGHZ_HISTORY_SPILL_PATH EXT_PATH(".tmp/subghz_history.tmp")
+
 #define TAG "SubGhzHistory"
 
 typedef struct {
     FuriString* item_str;
+    // NULL once spilled to SD card, data is at spill_offset then
     FlipperFormat* flipper_string;
+    const char* protocol_name;
+    uint32_t frequency;
+    uint32_t spill_offset;
+    uint16_t spill_size;
     uint8_t type;
-    SubGhzRadioPreset* preset;
+    uint8_t preset_index;
 } SubGhzHistoryItem;
 
 ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
 
 #define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
 
+// Few distinct presets are used in a session, records refer to them by index
+ARRAY_DEF(SubGhzHistoryPresetArray, SubGhzRadioPreset, M_POD_OPLIST)
+
+#define M_OPL_SubGhzHistoryPresetArray_t() ARRAY_OPLIST(SubGhzHistoryPresetArray, M_POD_OPLIST)
+
 typedef struct {
     SubGhzHistoryItemArray_t data;
+    SubGhzHistoryPresetArray_t presets;
 } SubGhzHistoryStruct;
 
 struct SubGhzHistory {
     uint32_t last_update_timestamp;
     uint16_t last_index_write;
+    uint16_t ram_index;
     uint8_t code_last_hash_data;
     FuriString* tmp_string;
     SubGhzHistoryStruct* history;
+
+    Storage* storage;
+    Stream* spill;
+    bool spill_failed;
+    int32_t loaded_index;
+    FlipperFormat* loaded;
+    SubGhzRadioPreset preset;
 };
 
 SubGhzHistory* subghz_history_alloc(void) {
@@ -37,55 +63,79 @@ SubGhzHistory* subghz_history_alloc(void) {
     instance->tmp_string = furi_string_alloc();
     instance->history = malloc(sizeof(SubGhzHistoryStruct));
     SubGhzHistoryItemArray_init(instance->history->data);
+    SubGhzHistoryPresetArray_init(instance->history->presets);
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->loaded_index = -1;
+    instance->loaded = flipper_format_string_alloc();
     return instance;
 }
 
-void subghz_history_free(SubGhzHistory* instance) {
-    furi_assert(instance);
-    furi_string_free(instance->tmp_string);
+static void subghz_history_clear_items(SubGhzHistory* instance) {
     for
         M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
             furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
+            if(item->flipper_string) flipper_format_free(item->flipper_string);
             item->type = 0;
         }
+    for
+        M_EACH(preset, instance->history->presets, SubGhzHistoryPresetArray_t) {
+            furi_string_free(preset->name);
+        }
+
+    if(instance->spill) {
+        file_stream_close(instance->spill);
+        stream_free(instance->spill);
+        instance->spill = NULL;
+        storage_common_remove(instance->storage, SUBGHZ_HISTORY_SPILL_PATH);
+    }
+    instance->spill_failed = false;
+    instance->loaded_index = -1;
+    instance->ram_index = 0;
+}
+
+void subghz_history_free(SubGhzHistory* instance) {
+    furi_assert(instance);
+    furi_string_free(instance->tmp_string);
+    subghz_history_clear_items(instance);
     SubGhzHistoryItemArray_clear(instance->history->data);
+    SubGhzHistoryPresetArray_clear(instance->history->presets);
+    flipper_format_free(instance->loaded);
+    furi_record_close(RECORD_STORAGE);
     free(instance->history);
     free(instance);
 }
 
+static SubGhzRadioPreset*
+    subghz_history_get_item_preset(SubGhzHistory* instance, const SubGhzHistoryItem* item) {
+    return SubGhzHistoryPresetArray_get(instance->history->presets, item->preset_index);
+}
+
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    return item->frequency;
 }
 
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    instance->preset = *subghz_history_get_item_preset(instance, item);
+    instance->preset.frequency = item->frequency;
+    return &instance->preset;
 }
 
 const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    return furi_string_get_cstr(subghz_history_get_item_preset(instance, item)->name);
 }
 
 void subghz_history_reset(SubGhzHistory* instance) {
     furi_assert(instance);
     furi_string_reset(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
+    subghz_history_clear_items(instance);
     SubGhzHistoryItemArray_reset(instance->history->data);
+    SubGhzHistoryPresetArray_reset(instance->history->presets);
     instance->last_index_write = 0;
     instance->code_last_hash_data = 0;
 }
@@ -104,12 +154,7 @@ uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx)
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
-    }
-    return furi_string_get_cstr(instance->tmp_string);
+    return item->protocol_name;
 }
 
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
@@ -117,22 +162,90 @@ FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
     if(item->flipper_string) {
         return item->flipper_string;
-    } else {
-        return NULL;
     }
+
+    // Spilled record, the same one is usually asked for several times in a row
+    if(instance->loaded_index != idx) {
+        Stream* loaded = flipper_format_get_raw_stream(instance->loaded);
+        stream_clean(loaded);
+        instance->loaded_index = -1;
+
+        if(!stream_seek(instance->spill, item->spill_offset, StreamOffsetFromStart) ||
+           stream_copy(instance->spill, loaded, item->spill_size) != item->spill_size) {
+            FURI_LOG_E(TAG, "Failed to load record %u", idx);
+            return NULL;
+        }
+        instance->loaded_index = idx;
+    }
+
+    flipper_format_rewind(instance->loaded);
+    return instance->loaded;
 }
+
+static bool subghz_history_spill(SubGhzHistory* instance, SubGhzHistoryItem* item) {
+    if(!instance->spill) {
+        storage_simply_mkdir(instance->storage, EXT_PATH(".tmp"));
+        instance->spill = file_stream_alloc(instance->storage);
+        if(!file_stream_open(
+               instance->spill, SUBGHZ_HISTORY_SPILL_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Failed to open spill file");
+            stream_free(instance->spill);
+            instance->spill = NULL;
+            return false;
+        }
+    }
+
+    Stream* data = flipper_format_get_raw_stream(item->flipper_string);
+    const size_t size = stream_size(data);
+    if(size > UINT16_MAX || !stream_seek(instance->spill, 0, StreamOffsetFromEnd)) return false;
+
+    const size_t offset = stream_tell(instance->spill);
+    stream_rewind(data);
+    if(stream_copy(data, instance->spill, size) != size) {
+        FURI_LOG_E(TAG, "Failed to spill record");
+        return false;
+    }
+
+    item->spill_offset = offset;
+    item->spill_size = size;
+    flipper_format_free(item->flipper_string);
+    item->flipper_string = NULL;
+
+    return true;
+}
+
+static void subghz_history_spill_old(SubGhzHistory* instance) {
+    // Once SD card fails records stay in RAM and the RAM limit applies again
+    while(!instance->spill_failed &&
+          instance->last_index_write - instance->ram_index > SUBGHZ_HISTORY_RAM_WINDOW) {
+        SubGhzHistoryItem* item =
+            SubGhzHistoryItemArray_get(instance->history->data, instance->ram_index);
+        if(subghz_history_spill(instance, item)) {
+            instance->ram_index++;
+        } else {
+            instance->spill_failed = true;
+        }
+    }
+}
+
+static uint16_t subghz_history_get_max(SubGhzHistory* instance) {
+    if(!instance->spill_failed) return SUBGHZ_HISTORY_MAX;
+    return MIN(SUBGHZ_HISTORY_MAX, instance->ram_index + SUBGHZ_HISTORY_RAM_MAX);
+}
+
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, FuriString* output) {
     furi_assert(instance);
+    const uint16_t history_max = subghz_history_get_max(instance);
     if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) {
         if(output != NULL) furi_string_printf(output, "    Free heap LOW");
         return true;
     }
-    if(instance->last_index_write == SUBGHZ_HISTORY_MAX) {
+    if(instance->last_index_write >= history_max) {
         if(output != NULL) furi_string_printf(output, "   Memory is FULL");
         return true;
     }
     if(output != NULL)
-        furi_string_printf(output, "%02u/%02u", instance->last_index_write, SUBGHZ_HISTORY_MAX);
+        furi_string_printf(output, "%02u/%02u", instance->last_index_write, history_max);
     return false;
 }
 
@@ -141,6 +254,27 @@ void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* outp
     furi_string_set(output, item->item_str);
 }
 
+static uint8_t
+    subghz_history_get_preset_index(SubGhzHistory* instance, SubGhzRadioPreset* preset) {
+    size_t index = 0;
+    for
+        M_EACH(known, instance->history->presets, SubGhzHistoryPresetArray_t) {
+            if(known->data == preset->data && furi_string_equal(known->name, preset->name)) {
+                return index;
+            }
+            index++;
+        }
+
+    furi_check(index <= UINT8_MAX);
+    SubGhzRadioPreset* known = SubGhzHistoryPresetArray_push_raw(instance->history->presets);
+    known->name = furi_string_alloc_set(preset->name);
+    known->frequency = 0;
+    known->data = preset->data;
+    known->data_size = preset->data_size;
+
+    return index;
+}
+
 bool subghz_history_add_to_history(
     SubGhzHistory* instance,
     void* context,
@@ -149,7 +283,7 @@ bool subghz_history_add_to_history(
     furi_assert(context);
 
     if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) return false;
-    if(instance->last_index_write >= SUBGHZ_HISTORY_MAX) return false;
+    if(instance->last_index_write >= subghz_history_get_max(instance)) return false;
 
     SubGhzProtocolDecoderBase* decoder_base = context;
     if((instance->code_last_hash_data ==
@@ -164,14 +298,14 @@ bool subghz_history_add_to_history(
 
     FuriString* text;
     text = furi_string_alloc();
+    const uint8_t preset_index = subghz_history_get_preset_index(instance, preset);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
     item->type = decoder_base->protocol->type;
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
+    item->protocol_name = decoder_base->protocol->name;
+    item->frequency = preset->frequency;
+    item->preset_index = preset_index;
+    item->spill_offset = 0;
+    item->spill_size = 0;
 
     item->item_str = furi_string_alloc();
     item->flipper_string = flipper_format_string_alloc();
@@ -182,18 +316,15 @@ bool subghz_history_add_to_history(
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-            FURI_LOG_E(TAG, "Missing Protocol");
-            break;
-        }
-        if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
+        furi_string_set(instance->tmp_string, item->protocol_name);
+        if(!strcmp(item->protocol_name, "KeeLoq")) {
             furi_string_set(instance->tmp_string, "KL ");
             if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
             furi_string_cat(instance->tmp_string, text);
-        } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
+        } else if(!strcmp(item->protocol_name, "Star Line")) {
             furi_string_set(instance->tmp_string, "SL ");
             if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
@@ -236,5 +367,6 @@ bool subghz_history_add_to_history(
 
     furi_string_free(text);
     instance->last_index_write++;
+    subghz_history_spill_old(instance);
     return true;
 }
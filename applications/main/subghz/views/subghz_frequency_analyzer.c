@@ -12,6 +12,8 @@
 #include <float_tools.h>
 
 #define LOG_FREQUENCY_MAX_ITEMS 60 // uint8_t (limited by 'seq' of SubGhzFrequencyAnalyzerLogItem)
+#define SPECTRUM_MAX_CHANNELS   64 // 2px per channel at least
+#define SPECTRUM_HEIGHT         28
 
 #define SNPRINTF_FREQUENCY(buff, freq) \
     snprintf(buff, sizeof(buff), "%03ld.%03ld", freq / 1000000 % 1000, freq / 1000 % 1000);
@@ -23,6 +25,7 @@ typedef enum {
 typedef enum {
     SubGhzFrequencyAnalyzerFragmentBottomTypeMain,
     SubGhzFrequencyAnalyzerFragmentBottomTypeLog,
+    SubGhzFrequencyAnalyzerFragmentBottomTypeSpectrum,
 } SubGhzFrequencyAnalyzerFragmentBottomType;
 
 struct SubGhzFrequencyAnalyzer {
@@ -43,6 +46,9 @@ typedef struct {
     SubGhzFrequencyAnalyzerFragmentBottomType fragment_bottom_type;
     SubGhzFrequencyAnalyzerLogOrderBy log_frequency_order_by;
     uint8_t log_frequency_scroll_offset;
+    uint8_t spectrum[SPECTRUM_MAX_CHANNELS];
+    uint8_t spectrum_peak[SPECTRUM_MAX_CHANNELS];
+    uint8_t spectrum_count;
 } SubGhzFrequencyAnalyzerModel;
 
 static inline uint8_t rssi_sanitize(float rssi) {
@@ -153,6 +159,28 @@ static void subghz_frequency_analyzer_history_frequency_draw(
     canvas_set_font(canvas, FontSecondary);
 }
 
+static void subghz_frequency_analyzer_spectrum_draw(
+    Canvas* canvas,
+    SubGhzFrequencyAnalyzerModel* model) {
+    if(!model->spectrum_count) return;
+
+    // Channels are spread over the full width, peak hold is drawn as a dot above the bar
+    const uint8_t width = 128 / model->spectrum_count;
+    const uint8_t offset_x = (128 - width * model->spectrum_count) / 2;
+    const uint8_t bar_width = width > 2 ? width - 1 : width;
+    for(uint8_t i = 0; i < model->spectrum_count; i++) {
+        const uint8_t x = offset_x + i * width;
+        const uint8_t height = MIN(model->spectrum[i] / 2, SPECTRUM_HEIGHT);
+        const uint8_t peak = MIN(model->spectrum_peak[i] / 2, SPECTRUM_HEIGHT);
+        if(height) {
+            canvas_draw_box(canvas, x, 64 - height, bar_width, height);
+        }
+        if(peak > height) {
+            canvas_draw_line(canvas, x, 64 - peak, x + bar_width - 1, 64 - peak);
+        }
+    }
+}
+
 void subghz_frequency_analyzer_draw(Canvas* canvas, SubGhzFrequencyAnalyzerModel* model) {
     furi_assert(canvas);
     furi_assert(model);
@@ -173,6 +201,10 @@ void subghz_frequency_analyzer_draw(Canvas* canvas, SubGhzFrequencyAnalyzerModel
             canvas_draw_str(canvas, 2, 8, buffer);
         }
         subghz_frequency_analyzer_log_frequency_draw(canvas, model);
+    } else if(model->fragment_bottom_type == SubGhzFrequencyAnalyzerFragmentBottomTypeSpectrum) {
+        canvas_draw_str(canvas, 0, 8, "Spectrum");
+        canvas_draw_icon(canvas, 109, 0, &I_Internal_ant_1_9x11);
+        subghz_frequency_analyzer_spectrum_draw(canvas, model);
     } else {
         canvas_draw_str(canvas, 0, 8, "Frequency Analyzer");
         canvas_draw_icon(canvas, 109, 0, &I_Internal_ant_1_9x11);
@@ -216,13 +248,14 @@ bool subghz_frequency_analyzer_input(InputEvent* event, void* context) {
             {
                 if(event->key == InputKeyLeft) {
                     if(model->fragment_bottom_type == 0) {
-                        model->fragment_bottom_type = SubGhzFrequencyAnalyzerFragmentBottomTypeLog;
+                        model->fragment_bottom_type =
+                            SubGhzFrequencyAnalyzerFragmentBottomTypeSpectrum;
                     } else {
                         --model->fragment_bottom_type;
                     }
                 } else if(event->key == InputKeyRight) {
                     if(model->fragment_bottom_type ==
-                       SubGhzFrequencyAnalyzerFragmentBottomTypeLog) {
+                       SubGhzFrequencyAnalyzerFragmentBottomTypeSpectrum) {
                         model->fragment_bottom_type = 0;
                     } else {
                         ++model->fragment_bottom_type;
@@ -374,6 +407,37 @@ void subghz_frequency_analyzer_pair_callback(
         true);
 }
 
+static void subghz_frequency_analyzer_frame_callback(
+    void* context,
+    const SubGhzFrequencyAnalyzerFrame* frame) {
+    SubGhzFrequencyAnalyzer* instance = context;
+    bool visible = false;
+
+    with_view_model(
+        instance->view,
+        SubGhzFrequencyAnalyzerModel * model,
+        {
+            const uint8_t count = MIN(frame->count, SPECTRUM_MAX_CHANNELS);
+            if(model->spectrum_count != count) {
+                memset(model->spectrum_peak, 0, sizeof(model->spectrum_peak));
+                model->spectrum_count = count;
+            }
+            for(uint8_t i = 0; i < count; i++) {
+                const float rssi =
+                    MAX(frame->samples[i].rssi, SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD);
+                model->spectrum[i] = rssi_sanitize(rssi);
+                // Slow decay keeps short bursts visible for a while
+                if(model->spectrum_peak[i]) model->spectrum_peak[i]--;
+                if(model->spectrum_peak[i] < model->spectrum[i]) {
+                    model->spectrum_peak[i] = model->spectrum[i];
+                }
+            }
+            visible =
+                model->fragment_bottom_type == SubGhzFrequencyAnalyzerFragmentBottomTypeSpectrum;
+        },
+        visible);
+}
+
 void subghz_frequency_analyzer_enter(void* context) {
     furi_assert(context);
     SubGhzFrequencyAnalyzer* instance = context;
@@ -385,6 +449,8 @@ void subghz_frequency_analyzer_enter(void* context) {
         instance->worker,
         (SubGhzFrequencyAnalyzerWorkerPairCallback)subghz_frequency_analyzer_pair_callback,
         instance);
+    subghz_frequency_analyzer_worker_set_frame_callback(
+        instance->worker, subghz_frequency_analyzer_frame_callback, instance);
 
     subghz_frequency_analyzer_worker_start(instance->worker);
 
@@ -399,6 +465,7 @@ void subghz_frequency_analyzer_enter(void* context) {
             model->log_frequency_scroll_offset = 0;
             model->history_frequency[0] = model->history_frequency[1] =
                 model->history_frequency[2] = 0;
+            model->spectrum_count = 0;
             SubGhzFrequencyAnalyzerLogItemArray_init(model->log_frequency);
         },
         true);
@@ -195,6 +195,9 @@ static uint8_t u2f_der_encode_signature(uint8_t* der, uint8_t* sig) {
 
 static void
     u2f_ecc_sign(mbedtls_ecp_group* grp, const uint8_t* key, uint8_t* hash, uint8_t* signature) {
+    // Hardware first, it is shared with core2 and may be busy
+    if(furi_hal_pka_ecdsa_sign_p256(key, hash, signature)) return;
+
     mbedtls_mpi r, s, d;
 
     mbedtls_mpi_init(&r);
@@ -6,6 +6,7 @@
 typedef enum {
     FlipperInternalApplicationFlagDefault = 0,
     FlipperInternalApplicationFlagInsomniaSafe = (1 << 0),
+    FlipperInternalApplicationFlagStaticAllocation = (1 << 1), /**< Service lives in .bss */
 } FlipperInternalApplicationFlag;
 
 typedef struct {
@@ -15,6 +16,8 @@ typedef struct {
     const size_t stack_size;
     const Icon* icon;
     const FlipperInternalApplicationFlag flags;
+    FuriThreadStatic* const thread_storage;
+    void* const stack;
 } FlipperInternalApplication;
 
 typedef struct {
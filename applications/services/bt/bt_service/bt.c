@@ -15,6 +15,10 @@
 #define BT_RPC_EVENT_DISCONNECTED (1UL << 1)
 #define BT_RPC_EVENT_ALL          (BT_RPC_EVENT_BUFF_SENT | BT_RPC_EVENT_DISCONNECTED)
 
+// RPC link falls back to low power connection parameters after this much silence, ms
+#define BT_RPC_IDLE_TIMEOUT      3000
+#define BT_RPC_IDLE_CHECK_PERIOD 1000
+
 #define ICON_SPACER 2
 
 static void bt_draw_statusbar_callback(Canvas* canvas, void* context) {
@@ -148,6 +152,23 @@ static void bt_battery_level_changed_callback(const void* _event, void* context)
     }
 }
 
+// Called from Timer thread
+static void bt_rpc_idle_timer_callback(void* context) {
+    furi_assert(context);
+    Bt* bt = context;
+    uint32_t idle_ticks = furi_get_tick() - bt->rpc_activity_tick;
+    if(bt->rpc_high_throughput && idle_ticks > furi_ms_to_ticks(BT_RPC_IDLE_TIMEOUT)) {
+        bt->rpc_high_throughput = !gap_set_high_throughput(false);
+    }
+}
+
+static void bt_rpc_activity(Bt* bt) {
+    bt->rpc_activity_tick = furi_get_tick();
+    if(!bt->rpc_high_throughput) {
+        bt->rpc_high_throughput = gap_set_high_throughput(true);
+    }
+}
+
 Bt* bt_alloc(void) {
     Bt* bt = malloc(sizeof(Bt));
     // Init default maximum packet size
@@ -177,6 +198,7 @@ Bt* bt_alloc(void) {
     // RPC
     bt->rpc = furi_record_open(RECORD_RPC);
     bt->rpc_event = furi_event_flag_alloc();
+    bt->rpc_idle_timer = furi_timer_alloc(bt_rpc_idle_timer_callback, FuriTimerTypePeriodic, bt);
 
     // API evnent
     bt->api_event = furi_event_flag_alloc();
@@ -191,6 +213,7 @@ static uint16_t bt_serial_event_callback(SerialServiceEvent event, void* context
     uint16_t ret = 0;
 
     if(event.event == SerialServiceEventTypeDataReceived) {
+        bt_rpc_activity(bt);
         size_t bytes_processed =
             rpc_session_feed(bt->rpc_session, event.data.buffer, event.data.size, 1000);
         if(bytes_processed != event.data.size) {
@@ -222,17 +245,16 @@ static void bt_rpc_send_bytes_callback(void* context, uint8_t* bytes, size_t byt
         // Early stop from sending if we're already disconnected
         return;
     }
+    bt_rpc_activity(bt);
     furi_event_flag_clear(bt->rpc_event, BT_RPC_EVENT_ALL & (~BT_RPC_EVENT_DISCONNECTED));
     size_t bytes_sent = 0;
     while(bytes_sent < bytes_len) {
-        size_t bytes_remain = bytes_len - bytes_sent;
-        if(bytes_remain > bt->max_packet_size) {
-            ble_profile_serial_tx(bt->current_profile, &bytes[bytes_sent], bt->max_packet_size);
-            bytes_sent += bt->max_packet_size;
-        } else {
-            ble_profile_serial_tx(bt->current_profile, &bytes[bytes_sent], bytes_remain);
-            bytes_sent += bytes_remain;
+        size_t packet_size = MIN(bytes_len - bytes_sent, bt->max_packet_size);
+        if(ble_profile_serial_tx(bt->current_profile, &bytes[bytes_sent], packet_size)) {
+            bytes_sent += packet_size;
+            continue;
         }
+        // TX queue is full, wait for the next confirmed packet
         // We want BT_RPC_EVENT_DISCONNECTED to stick, so don't clear
         uint32_t event_flag = furi_event_flag_wait(
             bt->rpc_event, BT_RPC_EVENT_ALL, FuriFlagWaitAny | FuriFlagNoClear, FuriWaitForever);
@@ -281,6 +303,10 @@ static bool bt_on_gap_event_callback(GapEvent event, void* context) {
                     bt->current_profile, RPC_BUFFER_SIZE, bt_serial_event_callback, bt);
                 ble_profile_serial_set_rpc_active(
                     bt->current_profile, FuriHalBtSerialRpcStatusActive);
+                // GAP starts every connection in high throughput mode
+                bt->rpc_high_throughput = true;
+                bt->rpc_activity_tick = furi_get_tick();
+                furi_timer_start(bt->rpc_idle_timer, furi_ms_to_ticks(BT_RPC_IDLE_CHECK_PERIOD));
             } else {
                 FURI_LOG_W(TAG, "RPC is busy, failed to open new session");
             }
@@ -297,6 +323,7 @@ static bool bt_on_gap_event_callback(GapEvent event, void* context) {
     } else if(event.type == GapEventTypeDisconnected) {
         if(current_profile_is_serial && bt->rpc_session) {
             FURI_LOG_I(TAG, "Close RPC connection");
+            furi_timer_stop(bt->rpc_idle_timer);
             ble_profile_serial_set_rpc_active(
                 bt->current_profile, FuriHalBtSerialRpcStatusNotActive);
             furi_event_flag_set(bt->rpc_event, BT_RPC_EVENT_DISCONNECTED);
@@ -385,6 +412,7 @@ static void bt_close_rpc_connection(Bt* bt) {
     if(furi_hal_bt_check_profile_type(bt->current_profile, ble_profile_serial) &&
        bt->rpc_session) {
         FURI_LOG_I(TAG, "Close RPC connection");
+        furi_timer_stop(bt->rpc_idle_timer);
         furi_event_flag_set(bt->rpc_event, BT_RPC_EVENT_DISCONNECTED);
         rpc_session_close(bt->rpc_session);
         ble_profile_serial_set_event_callback(bt->current_profile, 0, NULL, NULL);
@@ -85,6 +85,9 @@ struct Bt {
     Rpc* rpc;
     RpcSession* rpc_session;
     FuriEventFlag* rpc_event;
+    FuriTimer* rpc_idle_timer;
+    uint32_t rpc_activity_tick;
+    bool rpc_high_throughput;
     FuriEventFlag* api_event;
     BtStatusChangedCallback status_changed_cb;
     void* status_changed_ctx;
@@ -68,12 +68,9 @@ void bt_keys_storage_set_ram_params(BtKeysStorage* instance, uint8_t* buff, uint
 }
 
 static bool bt_keys_storage_file_exists(const char* file_path) {
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    FileInfo file_info;
-    const bool ret = storage_common_stat(storage, file_path, &file_info) == FSE_OK &&
-                     file_info.size != 0;
-    furi_record_close(RECORD_STORAGE);
-    return ret;
+    // Saves are written behind, file may not be there yet
+    size_t payload_size;
+    return saved_struct_get_metadata(file_path, NULL, NULL, &payload_size) && payload_size != 0;
 }
 
 static bool bt_keys_storage_validate_file(const char* file_path, size_t* payload_size) {
@@ -72,6 +72,15 @@ size_t cli_read_timeout(Cli* cli, uint8_t* buffer, size_t size, uint32_t timeout
     }
 }
 
+size_t cli_read_available(Cli* cli, uint8_t* buffer, size_t size, uint32_t timeout) {
+    furi_check(cli);
+    if(cli->session != NULL) {
+        return cli->session->rx_available(buffer, size, timeout);
+    } else {
+        return 0;
+    }
+}
+
 bool cli_is_connected(Cli* cli) {
     furi_check(cli);
     if(cli->session != NULL) {
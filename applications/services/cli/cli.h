@@ -95,6 +95,20 @@ size_t cli_read(Cli* cli, uint8_t* buffer, size_t size);
  */
 size_t cli_read_timeout(Cli* cli, uint8_t* buffer, size_t size, uint32_t timeout);
 
+/** Read whatever is available from terminal
+ *
+ * Unlike cli_read_timeout, returns as soon as some data is received instead of
+ * waiting for the whole buffer to be filled. Meant for bulk binary transfers.
+ *
+ * @param      cli     Cli instance
+ * @param      buffer  pointer to buffer
+ * @param      size    size of buffer in bytes
+ * @param      timeout time to wait for the first byte in ms
+ *
+ * @return     bytes read
+ */
+size_t cli_read_available(Cli* cli, uint8_t* buffer, size_t size, uint32_t timeout);
+
 /** Non-blocking check for interrupt command received
  *
  * @param      cli   Cli instance
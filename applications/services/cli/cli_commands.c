@@ -11,6 +11,7 @@
 #include <loader/loader.h>
 #include <lib/toolbox/args.h>
 #include <lib/toolbox/strint.h>
+#include <lib/toolbox/profiler.h>
 
 // Close to ISO, `date +'%Y-%m-%d %H:%M:%S %u'`
 #define CLI_DATE_FORMAT "%.4d-%.2d-%.2d %.2d:%.2d:%.2d %d"
@@ -177,6 +178,13 @@ void cli_command_log_tx_callback(const uint8_t* buffer, size_t size, void* conte
     furi_stream_buffer_send(context, buffer, size, 0);
 }
 
+void cli_command_log_binary_tx_callback(const uint8_t* buffer, size_t size, void* context) {
+    // Partial record would break the stream, drop it whole
+    if(furi_stream_buffer_spaces_available(context) >= size) {
+        furi_stream_buffer_send(context, buffer, size, 0);
+    }
+}
+
 bool cli_command_log_level_set_from_string(FuriString* level) {
     FuriLogLevel log_level;
     if(furi_log_level_from_string(furi_string_get_cstr(level), &log_level)) {
@@ -192,6 +200,8 @@ bool cli_command_log_level_set_from_string(FuriString* level) {
             "<log debug> — debug information including <log info> (may impact system performance)\r\n");
         printf(
             "<log trace> — system traces including <log debug> (may impact system performance)\r\n");
+        printf(
+            "<log binary [level]> — binary records for scripts/logdecode.py, no formatting on device\r\n");
     }
     return false;
 }
@@ -202,6 +212,13 @@ void cli_command_log(Cli* cli, FuriString* args, void* context) {
     uint8_t buffer[CLI_COMMAND_LOG_BUFFER_SIZE];
     FuriLogLevel previous_level = furi_log_get_level();
     bool restore_log_level = false;
+    bool binary = false;
+
+    if(furi_string_start_with_str(args, "binary")) {
+        furi_string_right(args, strlen("binary"));
+        furi_string_trim(args);
+        binary = true;
+    }
 
     if(furi_string_size(args) > 0) {
         if(!cli_command_log_level_set_from_string(args)) {
@@ -216,11 +233,15 @@ void cli_command_log(Cli* cli, FuriString* args, void* context) {
     printf("Current log level: %s\r\n", current_level);
 
     FuriLogHandler log_handler = {
-        .callback = cli_command_log_tx_callback,
+        .callback = binary ? cli_command_log_binary_tx_callback : cli_command_log_tx_callback,
         .context = ring,
     };
 
-    furi_log_add_handler(log_handler);
+    if(binary) {
+        furi_log_add_binary_handler(log_handler);
+    } else {
+        furi_log_add_handler(log_handler);
+    }
 
     printf("Use <log ?> to list available log levels\r\n");
     printf("Press CTRL+C to stop...\r\n");
@@ -229,7 +250,11 @@ void cli_command_log(Cli* cli, FuriString* args, void* context) {
         cli_write(cli, buffer, ret);
     }
 
-    furi_log_remove_handler(log_handler);
+    if(binary) {
+        furi_log_remove_binary_handler(log_handler);
+    } else {
+        furi_log_remove_handler(log_handler);
+    }
 
     if(restore_log_level) {
         // There will be strange behaviour if log level is set from settings while log command is running
@@ -275,6 +300,20 @@ void cli_command_sysctl_heap_track(Cli* cli, FuriString* args, void* context) {
     }
 }
 
+void cli_command_sysctl_log_deferred(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    if(!furi_string_cmp(args, "0")) {
+        furi_log_set_deferred(false);
+        printf("Deferred logging disabled, %lu records dropped", furi_log_get_dropped());
+    } else if(!furi_string_cmp(args, "1")) {
+        furi_log_set_deferred(true);
+        printf("Deferred logging enabled");
+    } else {
+        cli_print_usage("sysctl log_deferred", "<1|0>", furi_string_get_cstr(args));
+    }
+}
+
 void cli_command_sysctl_print_usage(void) {
     printf("Usage:\r\n");
     printf("sysctl <cmd> <args>\r\n");
@@ -286,6 +325,7 @@ void cli_command_sysctl_print_usage(void) {
 #else
     printf("\theap_track <none|main>\t - Set heap allocation tracking mode\r\n");
 #endif
+    printf("\tlog_deferred <0|1>\t - Format log records in caller, send them from log thread\r\n");
 }
 
 void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
@@ -308,6 +348,11 @@ void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "log_deferred") == 0) {
+            cli_command_sysctl_log_deferred(cli, args, context);
+            break;
+        }
+
         cli_command_sysctl_print_usage();
     } while(false);
 
@@ -403,6 +448,12 @@ static void cli_command_top(Cli* cli, FuriString* args, void* context) {
     int interval = 1000;
     args_read_int_and_trim(args, &interval);
 
+    // Counters are free running, first frame shows values since boot
+    uint32_t tick_previous = 0;
+    uint32_t context_switches_previous = 0;
+    uint32_t latency_previous[FURI_EVENT_LOOP_LATENCY_BUCKET_COUNT] = {0};
+    FuriHalInterruptStats isr_previous[FuriHalInterruptStatsIdMax] = {0};
+
     FuriThreadList* thread_list = furi_thread_list_alloc();
     while(!cli_cmd_interrupt_received(cli)) {
         uint32_t tick = furi_get_tick();
@@ -426,6 +477,27 @@ static void cli_command_top(Cli* cli, FuriString* args, void* context) {
             memmgr_get_minimum_free_heap(),
             memmgr_heap_get_max_free_block());
 
+        const uint32_t context_switches = furi_thread_get_context_switch_count();
+        uint32_t latency[FURI_EVENT_LOOP_LATENCY_BUCKET_COUNT];
+        furi_event_loop_get_latency_histogram(latency);
+        for(size_t i = 0; i < FURI_EVENT_LOOP_LATENCY_BUCKET_COUNT; i++) {
+            const uint32_t current = latency[i];
+            latency[i] -= latency_previous[i];
+            latency_previous[i] = current;
+        }
+
+        printf(
+            "Context switches: %lu, Event loop wakeups: <10us %lu, <100us %lu, <1ms %lu, "
+            "<10ms %lu, <100ms %lu, slower %lu\r\n\r\n",
+            context_switches - context_switches_previous,
+            latency[0],
+            latency[1],
+            latency[2],
+            latency[3],
+            latency[4],
+            latency[5]);
+        context_switches_previous = context_switches;
+
         printf(
             "%-17s %-20s %-10s %5s %12s %6s %10s %7s %5s\r\n",
             "AppID",
@@ -453,6 +525,29 @@ static void cli_command_top(Cli* cli, FuriString* args, void* context) {
                 (double)item->cpu);
         }
 
+        // Time spent in accounted ISRs since previous frame
+        const float cycles = (float)(tick - tick_previous) /
+                             (float)furi_kernel_get_tick_frequency() * 1000000.0f *
+                             (float)furi_hal_cortex_instructions_per_microsecond();
+        tick_previous = tick;
+
+        printf("\r\n%-17s %10s %5s\r\n", "ISR", "Calls", "CPU");
+        for(size_t i = 0; i < FuriHalInterruptStatsIdMax; i++) {
+            FuriHalInterruptStats stats;
+            furi_hal_interrupt_get_stats(i, &stats);
+            const uint32_t count = stats.count - isr_previous[i].count;
+            const uint32_t time = stats.time - isr_previous[i].time;
+            isr_previous[i] = stats;
+            if(!count) continue;
+
+            const char* name = furi_hal_interrupt_get_id_name(i);
+            printf(
+                "%-17s %10lu %5.1f\r\n",
+                name ? name : "Unknown",
+                count,
+                cycles > 0.0f ? (double)((float)time / cycles * 100.0f) : 0.0);
+        }
+
         if(interval > 0) {
             furi_delay_ms(interval);
         } else {
@@ -474,14 +569,229 @@ void cli_command_free(Cli* cli, FuriString* args, void* context) {
 
     printf("Pool free: %zu\r\n", memmgr_pool_get_free());
     printf("Maximum pool block: %zu\r\n", memmgr_pool_get_max_block());
+
+    MemmgrSlabStats slab_stats;
+    memmgr_slab_get_stats(&slab_stats);
+    printf("Slab heap size: %zu\r\n", slab_stats.total_size);
+    printf("Slab used size: %zu\r\n", slab_stats.used_size);
+    printf("Slab objects: %zu\r\n", slab_stats.object_count);
 }
 
-void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
+#define CLI_COMMAND_FREE_BLOCKS_CALLSITES 16
+
+static void cli_command_isr(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+
+    if(furi_string_cmp_str(args, "reset") == 0) {
+        furi_hal_interrupt_reset_stats();
+        return;
+    } else if(!furi_string_empty(args)) {
+        printf("Usage:\r\n");
+        printf("isr [reset]\r\n");
+        return;
+    }
+
+    const uint32_t now = DWT->CYCCNT;
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
+    printf(
+        "%-17s %10s %12s %10s %8s %12s\r\n",
+        "ISR",
+        "Calls",
+        "Total, us",
+        "Max, us",
+        "Nested",
+        "Last, us ago");
+
+    for(size_t i = 0; i < FuriHalInterruptStatsIdMax; i++) {
+        FuriHalInterruptStats stats;
+        furi_hal_interrupt_get_stats(i, &stats);
+        if(!stats.count) continue;
+
+        // Cycle counter wraps, time since last call is only valid within its period
+        const char* name = furi_hal_interrupt_get_id_name(i);
+        printf(
+            "%-17s %10lu %12lu %10lu %8lu %12lu\r\n",
+            name ? name : "Unknown",
+            stats.count,
+            stats.time / cycles_per_us,
+            stats.max / cycles_per_us,
+            stats.nested,
+            (now - stats.last) / cycles_per_us);
+    }
+}
+
+static void cli_command_boot_profile(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
     UNUSED(args);
     UNUSED(context);
 
-    memmgr_heap_printf_free_blocks();
+    printf("%-20s %12s %12s\r\n", "Stage", "Time, us", "Delta, us");
+
+    uint32_t time_prev = 0;
+    const size_t count = furi_boot_trace_get_count();
+    for(size_t i = 0; i < count; i++) {
+        FuriBootTraceRecord record;
+        if(!furi_boot_trace_get(i, &record)) continue;
+
+        printf(
+            "%-20s %12lu %12lu\r\n", record.stage, record.time_us, record.time_us - time_prev);
+        time_prev = record.time_us;
+    }
+}
+
+static void cli_command_free_blocks_print_usage(void) {
+    printf("Usage:\r\n");
+    printf("free_blocks [<cmd>]\r\n");
+    printf("Cmd list:\r\n");
+    printf("\t<none>\t - Print free blocks\r\n");
+    printf("\tstats\t - Print allocation statistics and call sites\r\n");
+    printf("\treset\t - Reset allocation statistics\r\n");
+    printf("\ttrace <on|off>\t - Enable or disable call site tracing\r\n");
+}
+
+static void cli_command_free_blocks_stats(void) {
+    MemmgrHeapStats stats;
+    memmgr_heap_get_stats(&stats);
+
+    printf("Allocations: %lu\r\n", stats.alloc_count);
+    printf("Releases: %lu\r\n", stats.free_count);
+    printf("Size histogram:\r\n");
+    for(size_t i = 0; i < MEMMGR_HEAP_HISTOGRAM_SIZE; i++) {
+        if(i < MEMMGR_HEAP_HISTOGRAM_SIZE - 1) {
+            printf("\t<= %u: %lu\r\n", 8U << i, stats.size_histogram[i]);
+        } else {
+            printf("\t> %u: %lu\r\n", 8U << (i - 1), stats.size_histogram[i]);
+        }
+    }
+    printf(
+        "Latency, cycles: p50 %lu, p90 %lu, p99 %lu, max %lu\r\n",
+        stats.latency_p50,
+        stats.latency_p90,
+        stats.latency_p99,
+        stats.latency_max);
+    printf("Free size: %zu\r\n", stats.free_size);
+    printf("Free blocks: %zu\r\n", stats.free_block_count);
+    printf("Maximum free block: %zu\r\n", stats.max_free_block);
+    printf("Fragmentation: %u%%\r\n", stats.fragmentation);
+
+    MemmgrHeapCallsite* callsites =
+        malloc(sizeof(MemmgrHeapCallsite) * CLI_COMMAND_FREE_BLOCKS_CALLSITES);
+    size_t count = memmgr_heap_get_callsites(callsites, CLI_COMMAND_FREE_BLOCKS_CALLSITES);
+    if(count) {
+        printf("Call sites:\r\n");
+        for(size_t i = 0; i < count; i++) {
+            printf(
+                "\t0x%08lX: %lu allocations, %zu bytes\r\n",
+                (uint32_t)callsites[i].pc,
+                callsites[i].count,
+                callsites[i].size);
+        }
+    }
+    free(callsites);
+}
+
+void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+
+    FuriString* cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            memmgr_heap_printf_free_blocks();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "stats") == 0) {
+            cli_command_free_blocks_stats();
+        } else if(furi_string_cmp_str(cmd, "reset") == 0) {
+            memmgr_heap_reset_stats();
+        } else if(furi_string_cmp_str(cmd, "trace") == 0) {
+            if(furi_string_cmp_str(args, "on") == 0) {
+                memmgr_heap_enable_callsite_trace();
+            } else if(furi_string_cmp_str(args, "off") == 0) {
+                memmgr_heap_disable_callsite_trace();
+            } else {
+                cli_command_free_blocks_print_usage();
+            }
+        } else {
+            cli_command_free_blocks_print_usage();
+        }
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
+#define CLI_COMMAND_PROFILER_CAPACITY_DEFAULT 1024
+#define CLI_COMMAND_PROFILER_BUFFER_SIZE      512
+
+static void cli_command_profiler_print_usage(void) {
+    printf("Usage:\r\n");
+    printf("profiler <cmd>\r\n");
+    printf("Cmd list:\r\n");
+    printf("\tprobes\t - List probes\r\n");
+    printf(
+        "\tstream [<capacity>]\t - Stream probe events in binary format until CTRL+C, "
+        "capacity is a power of two, default %u\r\n",
+        CLI_COMMAND_PROFILER_CAPACITY_DEFAULT);
+}
+
+static void cli_command_profiler_stream(Cli* cli, FuriString* args) {
+    int capacity = CLI_COMMAND_PROFILER_CAPACITY_DEFAULT;
+    if(furi_string_size(args) && !args_read_int_and_trim(args, &capacity)) {
+        cli_command_profiler_print_usage();
+        return;
+    }
+
+    if(capacity <= 0 || (capacity & (capacity - 1))) {
+        printf("Capacity must be a power of two\r\n");
+        return;
+    }
+
+    if(!profiler_stream_start(capacity)) {
+        printf("Profiler stream is already running\r\n");
+        return;
+    }
+
+    uint8_t* buffer = malloc(CLI_COMMAND_PROFILER_BUFFER_SIZE);
+    while(!cli_cmd_interrupt_received(cli)) {
+        size_t length = profiler_stream_read(buffer, CLI_COMMAND_PROFILER_BUFFER_SIZE);
+        if(length) {
+            cli_write(cli, buffer, length);
+        } else {
+            furi_delay_ms(10);
+        }
+    }
+
+    profiler_stream_stop();
+    free(buffer);
+}
+
+void cli_command_profiler(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+
+    FuriString* cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            cli_command_profiler_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "probes") == 0) {
+            for(size_t i = 0; i < ProfilerProbeNum; i++) {
+                printf("%zu: %s\r\n", i, profiler_probe_get_name(i));
+            }
+        } else if(furi_string_cmp_str(cmd, "stream") == 0) {
+            cli_command_profiler_stream(cli, args);
+        } else {
+            cli_command_profiler_print_usage();
+        }
+    } while(false);
+
+    furi_string_free(cmd);
 }
 
 void cli_command_i2c(Cli* cli, FuriString* args, void* context) {
@@ -520,8 +830,12 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "log", CliCommandFlagParallelSafe, cli_command_log, NULL);
     cli_add_command(cli, "sysctl", CliCommandFlagDefault, cli_command_sysctl, NULL);
     cli_add_command(cli, "top", CliCommandFlagParallelSafe, cli_command_top, NULL);
+    cli_add_command(cli, "isr", CliCommandFlagParallelSafe, cli_command_isr, NULL);
+    cli_add_command(
+        cli, "boot_profile", CliCommandFlagParallelSafe, cli_command_boot_profile, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_add_command(cli, "profiler", CliCommandFlagParallelSafe, cli_command_profiler, NULL);
 
     cli_add_command(cli, "vibro", CliCommandFlagDefault, cli_command_vibro, NULL);
     cli_add_command(cli, "led", CliCommandFlagDefault, cli_command_led, NULL);
@@ -6,8 +6,9 @@
 #define TAG "CliVcp"
 
 #define USB_CDC_PKT_LEN CDC_DATA_SZ
-#define VCP_RX_BUF_SIZE (USB_CDC_PKT_LEN * 3)
-#define VCP_TX_BUF_SIZE (USB_CDC_PKT_LEN * 3)
+// Enough to keep bulk transfers (RPC) going while consumer is busy
+#define VCP_RX_BUF_SIZE (USB_CDC_PKT_LEN * 16)
+#define VCP_TX_BUF_SIZE (USB_CDC_PKT_LEN * 16)
 
 #define VCP_IF_NUM 0
 
@@ -242,6 +243,26 @@ static size_t cli_vcp_rx(uint8_t* buffer, size_t size, uint32_t timeout) {
     return rx_cnt;
 }
 
+static size_t cli_vcp_rx_available(uint8_t* buffer, size_t size, uint32_t timeout) {
+    furi_assert(vcp);
+    furi_assert(buffer);
+
+    if(vcp->running == false) {
+        return 0;
+    }
+
+    if(size > VCP_RX_BUF_SIZE) size = VCP_RX_BUF_SIZE;
+
+    size_t len = furi_stream_buffer_receive(vcp->rx_stream, buffer, size, timeout);
+    VCP_DEBUG("rx available %u", len);
+
+    if(len > 0) {
+        furi_thread_flags_set(furi_thread_get_id(vcp->thread), VcpEvtStreamRx);
+    }
+
+    return len;
+}
+
 static void cli_vcp_tx(const uint8_t* buffer, size_t size) {
     furi_assert(vcp);
     furi_assert(buffer);
@@ -310,6 +331,7 @@ CliSession cli_vcp = {
     cli_vcp_init,
     cli_vcp_deinit,
     cli_vcp_rx,
+    cli_vcp_rx_available,
     cli_vcp_tx,
     cli_vcp_tx_stdout,
     cli_vcp_is_connected,
@@ -0,0 +1,275 @@
+#include "animation_frame_stream.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <toolbox/compress.h>
+
+#define TAG "AnimationFrameStream"
+
+// Prefetched frames and the one on screen
+#define ANIMATION_FRAME_STREAM_SLOTS (ANIMATION_FRAME_STREAM_PREFETCH + 1U)
+
+#define ANIMATION_FRAME_STREAM_STACK_SIZE (1024U)
+
+typedef enum {
+    WorkerEventStop = (1 << 0),
+    WorkerEventPrefetch = (1 << 1),
+} WorkerEvent;
+
+#define WORKER_EVENTS_MASK (WorkerEventStop | WorkerEventPrefetch)
+
+typedef enum {
+    AnimationFrameSlotEmpty,
+    AnimationFrameSlotLoading,
+    AnimationFrameSlotReady,
+    AnimationFrameSlotFailed,
+} AnimationFrameSlotState;
+
+typedef struct {
+    AnimationFrameSlotState state;
+    uint8_t frame;
+    // Uncompressed icon format: zero header followed by raw bitmap
+    uint8_t* data;
+} AnimationFrameSlot;
+
+struct AnimationFrameStream {
+    FuriThread* thread;
+    FuriMutex* mutex;
+    Storage* storage;
+    File* file;
+    CompressStreamDecoder* decoder;
+    FuriString* directory;
+    FuriString* path;
+    size_t bitmap_size;
+
+    AnimationFrameSlot slots[ANIMATION_FRAME_STREAM_SLOTS];
+    uint8_t wanted[ANIMATION_FRAME_STREAM_PREFETCH];
+    size_t wanted_count;
+    uint8_t shown;
+    bool shown_valid;
+};
+
+static int32_t animation_frame_stream_read_callback(void* context, uint8_t* buffer, size_t size) {
+    AnimationFrameStream* stream = context;
+    return storage_file_read(stream->file, buffer, size);
+}
+
+static bool animation_frame_stream_is_wanted(AnimationFrameStream* stream, uint8_t frame) {
+    for(size_t i = 0; i < stream->wanted_count; i++) {
+        if(stream->wanted[i] == frame) return true;
+    }
+    return false;
+}
+
+static AnimationFrameSlot* animation_frame_stream_find(AnimationFrameStream* stream, uint8_t frame) {
+    for(size_t i = 0; i < ANIMATION_FRAME_STREAM_SLOTS; i++) {
+        AnimationFrameSlot* slot = &stream->slots[i];
+        if(slot->state != AnimationFrameSlotEmpty && slot->frame == frame) return slot;
+    }
+    return NULL;
+}
+
+static bool
+    animation_frame_stream_decode(AnimationFrameStream* stream, uint8_t frame, uint8_t* data) {
+    furi_string_printf(
+        stream->path, "%s/frame_%u.bm", furi_string_get_cstr(stream->directory), frame);
+
+    bool success = false;
+
+    do {
+        if(!storage_file_open(
+               stream->file, furi_string_get_cstr(stream->path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        uint8_t is_compressed = 0;
+        if(storage_file_read(stream->file, &is_compressed, 1) != 1) break;
+
+        if(is_compressed) {
+            // Reserved byte and compressed size, decoder stops on its own
+            uint8_t header_rest[3];
+            if(storage_file_read(stream->file, header_rest, sizeof(header_rest)) !=
+               sizeof(header_rest))
+                break;
+            compress_stream_decoder_rewind(stream->decoder);
+            if(!compress_stream_decoder_read(stream->decoder, &data[1], stream->bitmap_size))
+                break;
+        } else {
+            if(storage_file_read(stream->file, &data[1], stream->bitmap_size) !=
+               stream->bitmap_size)
+                break;
+        }
+
+        data[0] = 0;
+        success = true;
+    } while(false);
+
+    storage_file_close(stream->file);
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Load failed: \'%s\'", furi_string_get_cstr(stream->path));
+    }
+
+    return success;
+}
+
+static bool animation_frame_stream_load_next(AnimationFrameStream* stream) {
+    AnimationFrameSlot* slot = NULL;
+    uint8_t frame = 0;
+
+    furi_check(furi_mutex_acquire(stream->mutex, FuriWaitForever) == FuriStatusOk);
+
+    // Nearest missing frame first
+    size_t i = 0;
+    for(; i < stream->wanted_count; i++) {
+        if(!animation_frame_stream_find(stream, stream->wanted[i])) break;
+    }
+
+    if(i < stream->wanted_count) {
+        frame = stream->wanted[i];
+        for(size_t j = 0; j < ANIMATION_FRAME_STREAM_SLOTS; j++) {
+            AnimationFrameSlot* it = &stream->slots[j];
+            if(it->state == AnimationFrameSlotEmpty) {
+                slot = it;
+                break;
+            }
+            // Frame on screen is kept until the next one is ready
+            if(animation_frame_stream_is_wanted(stream, it->frame)) continue;
+            if(stream->shown_valid && it->frame == stream->shown) continue;
+            slot = it;
+        }
+    }
+
+    if(slot) {
+        slot->state = AnimationFrameSlotLoading;
+        slot->frame = frame;
+    }
+
+    furi_mutex_release(stream->mutex);
+
+    if(!slot) return false;
+
+    // Slot is not visible to readers while loading, buffer is ours
+    const bool success = animation_frame_stream_decode(stream, frame, slot->data);
+
+    furi_check(furi_mutex_acquire(stream->mutex, FuriWaitForever) == FuriStatusOk);
+    // Failed frame is not retried until evicted
+    slot->state = success ? AnimationFrameSlotReady : AnimationFrameSlotFailed;
+    furi_mutex_release(stream->mutex);
+
+    return true;
+}
+
+static int32_t animation_frame_stream_worker(void* context) {
+    AnimationFrameStream* stream = context;
+
+    for(;;) {
+        uint32_t flags =
+            furi_thread_flags_wait(WORKER_EVENTS_MASK, FuriFlagWaitAny, FuriWaitForever);
+        furi_check((flags & FuriFlagError) == 0);
+
+        if(flags & WorkerEventStop) break;
+
+        while(animation_frame_stream_load_next(stream)) {
+            if(furi_thread_flags_get() & WorkerEventStop) break;
+        }
+    }
+
+    return 0;
+}
+
+AnimationFrameStream*
+    animation_frame_stream_alloc(const char* directory, uint8_t width, uint8_t height) {
+    furi_check(directory);
+
+    AnimationFrameStream* stream = malloc(sizeof(AnimationFrameStream));
+    stream->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    stream->storage = furi_record_open(RECORD_STORAGE);
+    stream->file = storage_file_alloc(stream->storage);
+    stream->decoder = compress_stream_decoder_alloc(
+        CompressTypeHeatshrink,
+        &compress_config_heatshrink_default,
+        animation_frame_stream_read_callback,
+        stream);
+    stream->directory = furi_string_alloc_set(directory);
+    stream->path = furi_string_alloc();
+    stream->bitmap_size = ROUND_UP_TO(width, 8) / 8 * height;
+
+    for(size_t i = 0; i < ANIMATION_FRAME_STREAM_SLOTS; i++) {
+        stream->slots[i].data = malloc(stream->bitmap_size + 1);
+    }
+
+    stream->thread = furi_thread_alloc_ex(
+        TAG, ANIMATION_FRAME_STREAM_STACK_SIZE, animation_frame_stream_worker, stream);
+    furi_thread_set_priority(stream->thread, FuriThreadPriorityLow);
+    furi_thread_start(stream->thread);
+
+    return stream;
+}
+
+void animation_frame_stream_free(AnimationFrameStream* stream) {
+    furi_check(stream);
+
+    furi_thread_flags_set(furi_thread_get_id(stream->thread), WorkerEventStop);
+    furi_thread_join(stream->thread);
+    furi_thread_free(stream->thread);
+
+    for(size_t i = 0; i < ANIMATION_FRAME_STREAM_SLOTS; i++) {
+        free(stream->slots[i].data);
+    }
+
+    furi_string_free(stream->path);
+    furi_string_free(stream->directory);
+    compress_stream_decoder_free(stream->decoder);
+    storage_file_free(stream->file);
+    furi_record_close(RECORD_STORAGE);
+    furi_mutex_free(stream->mutex);
+    free(stream);
+}
+
+void animation_frame_stream_prefetch(
+    AnimationFrameStream* stream,
+    const uint8_t* frames,
+    size_t count) {
+    furi_check(stream);
+    furi_check(frames);
+    furi_check(count <= ANIMATION_FRAME_STREAM_PREFETCH);
+
+    bool changed = false;
+
+    furi_check(furi_mutex_acquire(stream->mutex, FuriWaitForever) == FuriStatusOk);
+    if(count != stream->wanted_count || memcmp(stream->wanted, frames, count)) {
+        memcpy(stream->wanted, frames, count);
+        stream->wanted_count = count;
+        changed = true;
+    }
+    furi_mutex_release(stream->mutex);
+
+    if(changed) {
+        furi_thread_flags_set(furi_thread_get_id(stream->thread), WorkerEventPrefetch);
+    }
+}
+
+const uint8_t* animation_frame_stream_acquire(AnimationFrameStream* stream, uint8_t frame) {
+    furi_check(stream);
+    furi_check(furi_mutex_acquire(stream->mutex, FuriWaitForever) == FuriStatusOk);
+
+    AnimationFrameSlot* slot = animation_frame_stream_find(stream, frame);
+    if(slot && slot->state == AnimationFrameSlotReady) {
+        stream->shown = frame;
+        stream->shown_valid = true;
+    } else if(stream->shown_valid) {
+        // Loader is late, keep previous frame on screen
+        slot = animation_frame_stream_find(stream, stream->shown);
+    }
+
+    if(slot && slot->state == AnimationFrameSlotReady) {
+        return slot->data;
+    } else {
+        return NULL;
+    }
+}
+
+void animation_frame_stream_release(AnimationFrameStream* stream) {
+    furi_check(stream);
+    furi_mutex_release(stream->mutex);
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Frames requested ahead of playback, current one included */
+#define ANIMATION_FRAME_STREAM_PREFETCH (3U)
+
+/** Frame stream.
+ * Keeps a small ring of decoded frames of external animation,
+ * loading them from SD-card on low priority thread ahead of playback,
+ * instead of keeping all compressed frames in RAM. */
+typedef struct AnimationFrameStream AnimationFrameStream;
+
+/**
+ * Allocate frame stream and start loader thread.
+ *
+ * @directory   animation directory with frame_N.bm files
+ * @width       frame width
+ * @height      frame height
+ * @return      frame stream instance
+ */
+AnimationFrameStream*
+    animation_frame_stream_alloc(const char* directory, uint8_t width, uint8_t height);
+
+/**
+ * Stop loader thread and free frame stream.
+ *
+ * @stream      instance
+ */
+void animation_frame_stream_free(AnimationFrameStream* stream);
+
+/**
+ * Tell the loader which frames are going to be shown next.
+ * Frames not in the list may be evicted, the first one is loaded first.
+ *
+ * @stream      instance
+ * @frames      frame indexes in playback order
+ * @count       frames count, up to ANIMATION_FRAME_STREAM_PREFETCH
+ */
+void animation_frame_stream_prefetch(
+    AnimationFrameStream* stream,
+    const uint8_t* frames,
+    size_t count);
+
+/**
+ * Get decoded frame, ready for canvas_draw_bitmap().
+ * Stream is locked until animation_frame_stream_release() call,
+ * which has to be done regardless of result.
+ * If requested frame is not loaded yet, previously shown one is returned.
+ *
+ * @stream      instance
+ * @frame       frame index
+ * @return      bitmap, NULL if nothing to show
+ */
+const uint8_t* animation_frame_stream_acquire(AnimationFrameStream* stream, uint8_t frame);
+
+/**
+ * Unlock stream after animation_frame_stream_acquire().
+ *
+ * @stream      instance
+ */
+void animation_frame_stream_release(AnimationFrameStream* stream);
+
+#ifdef __cplusplus
+}
+#endif
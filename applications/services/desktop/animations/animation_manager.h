@@ -4,6 +4,7 @@
 #include <gui/icon_i.h>
 #include <stdint.h>
 #include <dolphin/dolphin.h>
+#include "animation_frame_stream.h"
 
 typedef struct AnimationManager AnimationManager;
 
@@ -32,6 +33,8 @@ typedef struct {
     uint8_t active_cycles;
     uint16_t duration;
     uint16_t active_cooldown;
+    /* External animations only, frames other than first one are streamed from SD-card */
+    AnimationFrameStream* frame_stream;
 } BubbleAnimation;
 
 typedef void (*AnimationManagerSetNewIdleAnimationCallback)(void* context);
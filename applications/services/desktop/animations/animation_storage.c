@@ -202,6 +202,9 @@ static void animation_storage_free_animation(BubbleAnimation** animation) {
     furi_assert(animation);
 
     if(*animation) {
+        if((*animation)->frame_stream) {
+            animation_frame_stream_free((*animation)->frame_stream);
+        }
         animation_storage_free_bubbles(*animation);
         animation_storage_free_frames(*animation);
         if((*animation)->frame_order) {
@@ -257,6 +260,7 @@ static void animation_storage_free_frames(BubbleAnimation* animation) {
     }
 
     free((void*)icon->frames);
+    FURI_CONST_ASSIGN_PTR(icon->frames, NULL);
 }
 
 static bool animation_storage_load_frames(
@@ -314,10 +318,15 @@ static bool animation_storage_load_frames(
             break;
         }
 
-        FURI_CONST_ASSIGN_PTR(icon->frames[i], malloc(file_info.size));
-        if(storage_file_read(file, (void*)icon->frames[i], file_info.size) != file_info.size) {
-            FURI_LOG_E(TAG, "Read failed: \'%s\'", furi_string_get_cstr(filename));
-            break;
+        /* Only first frame stays in RAM: it is shown on freeze and while stream catches up,
+         * the rest are checked here and streamed during playback */
+        if(i == 0) {
+            FURI_CONST_ASSIGN_PTR(icon->frames[i], malloc(file_info.size));
+            if(storage_file_read(file, (void*)icon->frames[i], file_info.size) !=
+               file_info.size) {
+                FURI_LOG_E(TAG, "Read failed: \'%s\'", furi_string_get_cstr(filename));
+                break;
+            }
         }
         storage_file_close(file);
         frames_ok = true;
@@ -334,9 +343,11 @@ static bool animation_storage_load_frames(
         animation_storage_free_frames(animation);
     } else {
         furi_check(animation->icon_animation.frames);
-        for(int i = 0; i < animation->icon_animation.frame_count; ++i) {
-            furi_check(animation->icon_animation.frames[i]);
-        }
+        furi_check(animation->icon_animation.frames[0]);
+
+        furi_string_printf(filename, ANIMATION_DIR "/%s", name);
+        animation->frame_stream =
+            animation_frame_stream_alloc(furi_string_get_cstr(filename), width, height);
     }
 
     storage_file_free(file);
@@ -496,6 +507,12 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
     }
 
     if(!success) { //-V547
+        if(animation->frame_stream) {
+            animation_frame_stream_free(animation->frame_stream);
+        }
+        if(animation->icon_animation.frames) {
+            animation_storage_free_frames(animation);
+        }
         if(animation->frame_order) {
             free((void*)animation->frame_order);
         }
@@ -36,23 +36,74 @@ struct BubbleAnimationView {
 static void bubble_animation_activate(BubbleAnimationView* view, bool force);
 static void bubble_animation_activate_right_now(BubbleAnimationView* view);
 
-static uint8_t bubble_animation_get_frame_index(BubbleAnimationViewModel* model) {
-    furi_assert(model);
+static uint8_t
+    bubble_animation_get_frame_index_at(const BubbleAnimation* animation, uint8_t current_frame) {
+    furi_assert(animation);
     uint8_t icon_index = 0;
-    const BubbleAnimation* animation = model->current;
 
-    if(model->current_frame < animation->passive_frames) {
-        icon_index = model->current_frame;
+    if(current_frame < animation->passive_frames) {
+        icon_index = current_frame;
     } else {
-        icon_index =
-            (model->current_frame - animation->passive_frames) % animation->active_frames +
-            animation->passive_frames;
+        icon_index = (current_frame - animation->passive_frames) % animation->active_frames +
+                     animation->passive_frames;
     }
     furi_assert(icon_index < (animation->passive_frames + animation->active_frames));
 
     return animation->frame_order[icon_index];
 }
 
+static uint8_t bubble_animation_get_frame_index(BubbleAnimationViewModel* model) {
+    furi_assert(model);
+    return bubble_animation_get_frame_index_at(model->current, model->current_frame);
+}
+
+/* Advance frame counters, returns true when active part is over */
+static bool bubble_animation_advance(
+    const BubbleAnimation* animation,
+    uint8_t* current_frame,
+    uint8_t* active_cycle) {
+    if(*current_frame < animation->passive_frames) {
+        *current_frame = (*current_frame + 1) % animation->passive_frames;
+    } else {
+        ++*current_frame;
+        *active_cycle +=
+            !((*current_frame - animation->passive_frames) % animation->active_frames);
+        if(*active_cycle >= animation->active_cycles) {
+            *active_cycle = 0;
+            *current_frame = 0;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Tell frame stream what is going to be played next, following the same steps as timer */
+static void bubble_animation_prefetch(BubbleAnimationViewModel* model) {
+    furi_assert(model);
+    const BubbleAnimation* animation = model->current;
+
+    if(!animation || !animation->frame_stream) {
+        return;
+    }
+
+    uint8_t frames[ANIMATION_FRAME_STREAM_PREFETCH];
+    uint8_t current_frame = model->current_frame;
+    uint8_t active_cycle = model->active_cycle;
+    uint8_t active_shift = model->active_shift;
+    for(size_t i = 0; i < COUNT_OF(frames); i++) {
+        frames[i] = bubble_animation_get_frame_index_at(animation, current_frame);
+        const bool activate = active_shift && !--active_shift;
+        if(!activate) {
+            bubble_animation_advance(animation, &current_frame, &active_cycle);
+        } else if(animation->active_frames) {
+            current_frame = animation->passive_frames;
+        }
+    }
+
+    animation_frame_stream_prefetch(animation->frame_stream, frames, COUNT_OF(frames));
+}
+
 static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     furi_assert(model_);
     furi_assert(canvas);
@@ -76,8 +127,17 @@ static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     uint8_t width = icon_get_width(&animation->icon_animation);
     uint8_t height = icon_get_height(&animation->icon_animation);
     uint8_t y_offset = canvas_height(canvas) - height;
-    canvas_draw_bitmap(
-        canvas, 0, y_offset, width, height, animation->icon_animation.frames[index]);
+    if(animation->frame_stream) {
+        const uint8_t* bitmap = animation_frame_stream_acquire(animation->frame_stream, index);
+        if(!bitmap) {
+            bitmap = animation->icon_animation.frames[0];
+        }
+        canvas_draw_bitmap(canvas, 0, y_offset, width, height, bitmap);
+        animation_frame_stream_release(animation->frame_stream);
+    } else {
+        canvas_draw_bitmap(
+            canvas, 0, y_offset, width, height, animation->icon_animation.frames[index]);
+    }
 
     const FrameBubble* bubble = model->current_bubble;
     if(bubble) {
@@ -187,6 +247,7 @@ static void bubble_animation_activate_right_now(BubbleAnimationView* view) {
         model->current_frame = model->current->passive_frames;
         model->current_bubble = bubble_animation_pick_bubble(model, true);
         frame_rate = model->current->icon_animation.frame_rate;
+        bubble_animation_prefetch(model);
     }
     view_commit_model(view->view, true);
 
@@ -203,16 +264,11 @@ static void bubble_animation_next_frame(BubbleAnimationViewModel* model) {
     }
 
     if(model->current_frame < model->current->passive_frames) {
-        model->current_frame = (model->current_frame + 1) % model->current->passive_frames;
+        bubble_animation_advance(model->current, &model->current_frame, &model->active_cycle);
     } else {
-        ++model->current_frame;
-        model->active_cycle +=
-            !((model->current_frame - model->current->passive_frames) %
-              model->current->active_frames);
-        if(model->active_cycle >= model->current->active_cycles) {
+        if(bubble_animation_advance(
+               model->current, &model->current_frame, &model->active_cycle)) {
             // switch to passive
-            model->active_cycle = 0;
-            model->current_frame = 0;
             model->current_bubble = bubble_animation_pick_bubble(model, false);
             model->active_ended_at = furi_get_tick();
         }
@@ -239,6 +295,7 @@ static void bubble_animation_timer_callback(void* context) {
     if(!model->freeze_frame && !activate) {
         bubble_animation_next_frame(model);
     }
+    bubble_animation_prefetch(model);
 
     view_commit_model(view->view, !activate);
 
@@ -369,6 +426,7 @@ void bubble_animation_view_set_animation(
     model->current_bubble = bubble_animation_pick_bubble(model, false);
     model->current_frame = 0;
     model->active_cycle = 0;
+    bubble_animation_prefetch(model);
     view_commit_model(view->view, true);
 
     furi_timer_start(view->timer, 1000 / new_animation->icon_animation.frame_rate);
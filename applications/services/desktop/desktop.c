@@ -555,6 +555,8 @@ int32_t desktop_srv(void* p) {
         animation_manager_unload_and_stall_animation(desktop->animation_manager);
     }
 
+    // First frame is drawn as soon as view dispatcher starts processing events
+    furi_boot_trace_mark("desktop");
     view_dispatcher_run(desktop->view_dispatcher);
 
     // Should never get here (a service thread will crash automatically if it returns)
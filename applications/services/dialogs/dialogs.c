@@ -16,6 +16,8 @@ void dialog_file_browser_set_basic_options(
     options->hide_ext = true;
     options->item_loader_callback = NULL;
     options->item_loader_context = NULL;
+    options->item_highlight_callback = NULL;
+    options->item_highlight_context = NULL;
 }
 
 static DialogsApp* dialogs_app_alloc(void) {
@@ -26,6 +26,8 @@ typedef struct DialogsApp DialogsApp;
  * @param hide_ext true - hide extensions for files
  * @param item_loader_callback callback function for providing custom icon & entry name
  * @param hide_ext callback context
+ * @param item_highlight_callback callback function called when highlighted item changes
+ * @param item_highlight_context callback context
  */
 typedef struct {
     const char* extension;
@@ -36,6 +38,8 @@ typedef struct {
     bool hide_ext;
     FileBrowserLoadItemCallback item_loader_callback;
     void* item_loader_context;
+    FileBrowserHighlightCallback item_highlight_callback;
+    void* item_highlight_context;
 } DialogsFileBrowserOptions;
 
 /**
@@ -40,6 +40,8 @@ bool dialog_file_browser_show(
             .preselected_filename = path,
             .item_callback = options ? options->item_loader_callback : NULL,
             .item_callback_context = options ? options->item_loader_context : NULL,
+            .highlight_callback = options ? options->item_highlight_callback : NULL,
+            .highlight_callback_context = options ? options->item_highlight_context : NULL,
             .base_path = furi_string_get_cstr(base_path),
         }};
 
@@ -17,6 +17,8 @@ typedef struct {
     FuriString* preselected_filename;
     FileBrowserLoadItemCallback item_callback;
     void* item_callback_context;
+    FileBrowserHighlightCallback highlight_callback;
+    void* highlight_callback_context;
     const char* base_path;
 } DialogsAppMessageDataFileBrowser;
 
@@ -29,6 +29,21 @@ extern "C" {
  */
 #define EXPANSION_PROTOCOL_MAX_DATA_SIZE (64U)
 
+/**
+ * @brief Maximum data size per extended data frame, in bytes.
+ *
+ * Modules with little memory MAY define a smaller value (but not less than
+ * EXPANSION_PROTOCOL_MAX_DATA_SIZE) and request it during extended mode negotiation.
+ */
+#ifndef EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE
+#define EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE (512U)
+#endif
+
+/**
+ * @brief Maximum number of unconfirmed data frames in extended mode.
+ */
+#define EXPANSION_PROTOCOL_EXTENDED_MAX_WINDOW_SIZE (4U)
+
 /**
  * @brief Maximum allowed inactivity period, in milliseconds.
  */
@@ -48,6 +63,8 @@ typedef enum {
     ExpansionFrameTypeBaudRate = 3, /**< Baud rate negotiation frame. */
     ExpansionFrameTypeControl = 4, /**< Control frame. */
     ExpansionFrameTypeData = 5, /**< Data frame. */
+    ExpansionFrameTypeExtendedMode = 6, /**< Extended mode negotiation frame. */
+    ExpansionFrameTypeExtendedData = 7, /**< Extended data frame. */
     ExpansionFrameTypeReserved, /**< Special value. */
 } ExpansionFrameType;
 
@@ -135,6 +152,26 @@ typedef struct {
     uint8_t bytes[EXPANSION_PROTOCOL_MAX_DATA_SIZE];
 } ExpansionFrameData;
 
+/**
+ * @brief Extended mode frame contents.
+ */
+typedef struct {
+    /** Maximum extended data size, up to EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE. */
+    uint16_t max_data_size;
+    /** Unconfirmed data frames allowed, up to EXPANSION_PROTOCOL_EXTENDED_MAX_WINDOW_SIZE. */
+    uint8_t window_size;
+} ExpansionFrameExtendedMode;
+
+/**
+ * @brief Extended data frame contents.
+ */
+typedef struct {
+    /** Size of the data. Must not exceed ExpansionFrameExtendedMode::max_data_size. */
+    uint16_t size;
+    /** Data bytes. Valid only up to ExpansionFrameExtendedData::size bytes. */
+    uint8_t bytes[EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE];
+} ExpansionFrameExtendedData;
+
 /**
  * @brief Expansion protocol frame structure.
  */
@@ -146,6 +183,8 @@ typedef struct {
         ExpansionFrameBaudRate baud_rate; /**< Baud rate frame contents. */
         ExpansionFrameControl control; /**< Control frame contents. */
         ExpansionFrameData data; /**< Data frame contents. */
+        ExpansionFrameExtendedMode extended_mode; /**< Extended mode frame contents. */
+        ExpansionFrameExtendedData extended_data; /**< Extended data frame contents. */
     } content; /**< Contents of the frame. */
 } ExpansionFrame;
 
@@ -200,6 +239,11 @@ static inline size_t expansion_frame_get_encoded_size(const ExpansionFrame* fram
         return sizeof(frame->header) + sizeof(frame->content.control);
     case ExpansionFrameTypeData:
         return sizeof(frame->header) + sizeof(frame->content.data.size) + frame->content.data.size;
+    case ExpansionFrameTypeExtendedMode:
+        return sizeof(frame->header) + sizeof(frame->content.extended_mode);
+    case ExpansionFrameTypeExtendedData:
+        return sizeof(frame->header) + sizeof(frame->content.extended_data.size) +
+               frame->content.extended_data.size;
     default:
         return 0;
     }
@@ -253,6 +297,21 @@ static inline bool expansion_frame_get_remaining_size(
             content_size = sizeof(frame->content.data.size) + frame->content.data.size;
         }
         break;
+    case ExpansionFrameTypeExtendedMode:
+        content_size = sizeof(frame->content.extended_mode);
+        break;
+    case ExpansionFrameTypeExtendedData:
+        if(received_content_size < sizeof(frame->content.extended_data.size)) {
+            // Data size is unknown as of now
+            content_size = sizeof(frame->content.extended_data.size);
+        } else if(frame->content.extended_data.size > sizeof(frame->content.extended_data.bytes)) {
+            // Malformed frame or garbage input
+            return false;
+        } else {
+            content_size =
+                sizeof(frame->content.extended_data.size) + frame->content.extended_data.size;
+        }
+        break;
     default:
         return false;
     }
@@ -12,7 +12,9 @@
 #define TAG "ExpansionSrv"
 
 #define EXPANSION_WORKER_STACK_SZIE  (768UL)
-#define EXPANSION_WORKER_BUFFER_SIZE (sizeof(ExpansionFrame) + sizeof(ExpansionFrameChecksum))
+#define EXPANSION_WORKER_FRAME_SIZE(content_size) \
+    (sizeof(ExpansionFrameHeader) + (content_size) + sizeof(ExpansionFrameChecksum))
+#define EXPANSION_WORKER_BUFFER_SIZE EXPANSION_WORKER_FRAME_SIZE(sizeof(ExpansionFrameData))
 
 typedef enum {
     ExpansionWorkerStateHandShake,
@@ -39,10 +41,20 @@ struct ExpansionWorker {
     FuriThread* thread;
     FuriStreamBuffer* rx_buf;
     FuriSemaphore* tx_semaphore;
+    FuriSemaphore* tx_done;
+    FuriMutex* tx_mutex;
 
     FuriHalSerialId serial_id;
     FuriHalSerialHandle* serial_handle;
 
+    // Negotiated in extended mode, legacy values otherwise
+    bool extended;
+    size_t max_data_size;
+    size_t window_size;
+
+    ExpansionFrame rx_frame;
+    ExpansionFrame tx_frame; // Guarded by tx_mutex, sent from worker and Rpc threads
+
     RpcSession* rpc_session;
 
     ExpansionWorkerState state;
@@ -51,10 +63,11 @@ struct ExpansionWorker {
     void* cb_context;
 };
 
-// Called in UART IRQ context
+// Called in UART DMA IRQ context
 static void expansion_worker_serial_rx_callback(
     FuriHalSerialHandle* handle,
     FuriHalSerialRxEvent event,
+    size_t data_len,
     void* context) {
     furi_assert(handle);
     furi_assert(context);
@@ -64,15 +77,24 @@ static void expansion_worker_serial_rx_callback(
     if(event & (FuriHalSerialRxEventNoiseError | FuriHalSerialRxEventFrameError |
                 FuriHalSerialRxEventOverrunError)) {
         furi_thread_flags_set(furi_thread_get_id(instance->thread), ExpansionWorkerFlagError);
-    } else if(event & FuriHalSerialRxEventData) {
-        while(furi_hal_serial_async_rx_available(handle)) {
-            const uint8_t data = furi_hal_serial_async_rx(handle);
-            furi_stream_buffer_send(instance->rx_buf, &data, sizeof(data), 0);
+    } else if(event & (FuriHalSerialRxEventData | FuriHalSerialRxEventIdle)) {
+        uint8_t data[FURI_HAL_SERIAL_DMA_BUFFER_SIZE];
+        while(data_len) {
+            const size_t size = furi_hal_serial_dma_rx(handle, data, MIN(data_len, sizeof(data)));
+            furi_stream_buffer_send(instance->rx_buf, data, size, 0);
+            data_len -= size;
         }
         furi_thread_flags_set(furi_thread_get_id(instance->thread), ExpansionWorkerFlagData);
     }
 }
 
+// Called in UART DMA IRQ context
+static void expansion_worker_serial_tx_callback(FuriHalSerialHandle* handle, void* context) {
+    UNUSED(handle);
+    ExpansionWorker* instance = context;
+    furi_semaphore_release(instance->tx_done);
+}
+
 static size_t expansion_worker_receive_callback(uint8_t* data, size_t data_size, void* context) {
     ExpansionWorker* instance = context;
 
@@ -122,49 +144,82 @@ static inline bool
 static size_t
     expansion_worker_send_callback(const uint8_t* data, size_t data_size, void* context) {
     ExpansionWorker* instance = context;
-    furi_hal_serial_tx(instance->serial_handle, data, data_size);
+
+    if(furi_hal_serial_dma_tx(
+           instance->serial_handle,
+           data,
+           data_size,
+           expansion_worker_serial_tx_callback,
+           instance)) {
+        // Data must stay untouched until DMA is done, sleep instead of spinning
+        furi_check(furi_semaphore_acquire(instance->tx_done, FuriWaitForever) == FuriStatusOk);
+    } else {
+        furi_hal_serial_tx(instance->serial_handle, data, data_size);
+    }
+
     furi_hal_serial_tx_wait_complete(instance->serial_handle);
     return data_size;
 }
 
-static inline bool
-    expansion_worker_send_frame(ExpansionWorker* instance, const ExpansionFrame* frame) {
-    return expansion_protocol_encode(frame, expansion_worker_send_callback, instance) ==
-           ExpansionProtocolStatusOk;
+// Frames are built in the shared buffer, it is too big for the worker and Rpc thread stacks
+static ExpansionFrame* expansion_worker_acquire_tx_frame(ExpansionWorker* instance) {
+    furi_check(furi_mutex_acquire(instance->tx_mutex, FuriWaitForever) == FuriStatusOk);
+    return &instance->tx_frame;
+}
+
+static bool expansion_worker_send_tx_frame(ExpansionWorker* instance) {
+    const bool success = expansion_protocol_encode(
+                             &instance->tx_frame, expansion_worker_send_callback, instance) ==
+                         ExpansionProtocolStatusOk;
+    furi_check(furi_mutex_release(instance->tx_mutex) == FuriStatusOk);
+
+    return success;
 }
 
 static bool expansion_worker_send_heartbeat(ExpansionWorker* instance) {
-    const ExpansionFrame frame = {
-        .header.type = ExpansionFrameTypeHeartbeat,
-        .content.heartbeat = {},
-    };
+    ExpansionFrame* frame = expansion_worker_acquire_tx_frame(instance);
+    frame->header.type = ExpansionFrameTypeHeartbeat;
 
-    return expansion_worker_send_frame(instance, &frame);
+    return expansion_worker_send_tx_frame(instance);
 }
 
 static bool
     expansion_worker_send_status_response(ExpansionWorker* instance, ExpansionFrameError error) {
-    const ExpansionFrame frame = {
-        .header.type = ExpansionFrameTypeStatus,
-        .content.status.error = error,
-    };
+    ExpansionFrame* frame = expansion_worker_acquire_tx_frame(instance);
+    frame->header.type = ExpansionFrameTypeStatus;
+    frame->content.status.error = error;
+
+    return expansion_worker_send_tx_frame(instance);
+}
+
+static bool expansion_worker_send_extended_mode_response(ExpansionWorker* instance) {
+    ExpansionFrame* frame = expansion_worker_acquire_tx_frame(instance);
+    frame->header.type = ExpansionFrameTypeExtendedMode;
+    frame->content.extended_mode.max_data_size = instance->max_data_size;
+    frame->content.extended_mode.window_size = instance->window_size;
 
-    return expansion_worker_send_frame(instance, &frame);
+    return expansion_worker_send_tx_frame(instance);
 }
 
 static bool expansion_worker_send_data_response(
     ExpansionWorker* instance,
     const uint8_t* data,
     size_t data_size) {
-    furi_assert(data_size <= EXPANSION_PROTOCOL_MAX_DATA_SIZE);
-
-    ExpansionFrame frame = {
-        .header.type = ExpansionFrameTypeData,
-        .content.data.size = data_size,
-    };
+    furi_assert(data_size <= instance->max_data_size);
+
+    ExpansionFrame* frame = expansion_worker_acquire_tx_frame(instance);
+
+    if(instance->extended) {
+        frame->header.type = ExpansionFrameTypeExtendedData;
+        frame->content.extended_data.size = data_size;
+        memcpy(frame->content.extended_data.bytes, data, data_size);
+    } else {
+        frame->header.type = ExpansionFrameTypeData;
+        frame->content.data.size = data_size;
+        memcpy(frame->content.data.bytes, data, data_size);
+    }
 
-    memcpy(frame.content.data.bytes, data, data_size);
-    return expansion_worker_send_frame(instance, &frame);
+    return expansion_worker_send_tx_frame(instance);
 }
 
 // Called in Rpc session thread context
@@ -179,8 +234,7 @@ static void expansion_worker_rpc_send_callback(void* context, uint8_t* data, siz
             break;
         }
 
-        const size_t current_data_size =
-            MIN(data_size - sent_data_size, EXPANSION_PROTOCOL_MAX_DATA_SIZE);
+        const size_t current_data_size = MIN(data_size - sent_data_size, instance->max_data_size);
         if(!expansion_worker_send_data_response(instance, data + sent_data_size, current_data_size))
             break;
         sent_data_size += current_data_size;
@@ -192,7 +246,9 @@ static bool expansion_worker_rpc_session_open(ExpansionWorker* instance) {
     instance->rpc_session = rpc_session_open(rpc, RpcOwnerUart);
 
     if(instance->rpc_session) {
-        instance->tx_semaphore = furi_semaphore_alloc(1, 1);
+        // Up to window size data frames may wait for confirmation
+        instance->tx_semaphore =
+            furi_semaphore_alloc(instance->window_size, instance->window_size);
         rpc_session_set_context(instance->rpc_session, instance);
         rpc_session_set_send_bytes_callback(
             instance->rpc_session, expansion_worker_rpc_send_callback);
@@ -238,6 +294,41 @@ static bool expansion_worker_handle_state_handshake(
     return success;
 }
 
+static bool expansion_worker_handle_extended_mode(
+    ExpansionWorker* instance,
+    const ExpansionFrame* rx_frame) {
+    const ExpansionFrameExtendedMode* request = &rx_frame->content.extended_mode;
+
+    if(instance->extended || request->max_data_size < EXPANSION_PROTOCOL_MAX_DATA_SIZE ||
+       request->window_size == 0) {
+        return expansion_worker_send_status_response(instance, ExpansionFrameErrorUnknown);
+    }
+
+    instance->extended = true;
+    instance->max_data_size =
+        MIN(request->max_data_size, EXPANSION_PROTOCOL_EXTENDED_MAX_DATA_SIZE);
+    instance->window_size = MIN(request->window_size, EXPANSION_PROTOCOL_EXTENDED_MAX_WINDOW_SIZE);
+
+    FURI_LOG_D(
+        TAG,
+        "Extended mode: %zu bytes, window %zu",
+        instance->max_data_size,
+        instance->window_size);
+
+    // Module waits for the response, nothing is lost while receiver is restarted
+    furi_hal_serial_dma_rx_stop(instance->serial_handle);
+    furi_stream_buffer_free(instance->rx_buf);
+    const size_t frame_size = EXPANSION_WORKER_FRAME_SIZE(
+        offsetof(ExpansionFrameExtendedData, bytes) + instance->max_data_size);
+    // Room for a full window and some control frames
+    instance->rx_buf = furi_stream_buffer_alloc(
+        instance->window_size * frame_size + EXPANSION_WORKER_BUFFER_SIZE, 1);
+    furi_hal_serial_dma_rx_start(
+        instance->serial_handle, expansion_worker_serial_rx_callback, instance, true);
+
+    return expansion_worker_send_extended_mode_response(instance);
+}
+
 static bool expansion_worker_handle_state_connected(
     ExpansionWorker* instance,
     const ExpansionFrame* rx_frame) {
@@ -259,6 +350,9 @@ static bool expansion_worker_handle_state_connected(
 
             if(!expansion_worker_send_status_response(instance, ExpansionFrameErrorNone)) break;
 
+        } else if(rx_frame->header.type == ExpansionFrameTypeExtendedMode) {
+            if(!expansion_worker_handle_extended_mode(instance, rx_frame)) break;
+
         } else if(rx_frame->header.type == ExpansionFrameTypeHeartbeat) {
             if(!expansion_worker_send_heartbeat(instance)) break;
 
@@ -271,6 +365,15 @@ static bool expansion_worker_handle_state_connected(
     return success;
 }
 
+static bool
+    expansion_worker_handle_data(ExpansionWorker* instance, const uint8_t* data, size_t size) {
+    if(!expansion_worker_send_status_response(instance, ExpansionFrameErrorNone)) return false;
+
+    const size_t size_consumed =
+        rpc_session_feed(instance->rpc_session, data, size, EXPANSION_PROTOCOL_TIMEOUT_MS);
+    return size_consumed == size;
+}
+
 static bool expansion_worker_handle_state_rpc_active(
     ExpansionWorker* instance,
     const ExpansionFrame* rx_frame) {
@@ -278,14 +381,13 @@ static bool expansion_worker_handle_state_rpc_active(
 
     do {
         if(rx_frame->header.type == ExpansionFrameTypeData) {
-            if(!expansion_worker_send_status_response(instance, ExpansionFrameErrorNone)) break;
+            const ExpansionFrameData* data = &rx_frame->content.data;
+            if(!expansion_worker_handle_data(instance, data->bytes, data->size)) break;
 
-            const size_t size_consumed = rpc_session_feed(
-                instance->rpc_session,
-                rx_frame->content.data.bytes,
-                rx_frame->content.data.size,
-                EXPANSION_PROTOCOL_TIMEOUT_MS);
-            if(size_consumed != rx_frame->content.data.size) break;
+        } else if(rx_frame->header.type == ExpansionFrameTypeExtendedData) {
+            const ExpansionFrameExtendedData* data = &rx_frame->content.extended_data;
+            if(!instance->extended || data->size > instance->max_data_size) break;
+            if(!expansion_worker_handle_data(instance, data->bytes, data->size)) break;
 
         } else if(rx_frame->header.type == ExpansionFrameTypeControl) {
             const uint8_t command = rx_frame->content.control.command;
@@ -323,11 +425,9 @@ static const ExpansionWorkerStateHandler expansion_handlers[] = {
 };
 
 static inline void expansion_worker_state_machine(ExpansionWorker* instance) {
-    ExpansionFrame rx_frame;
-
     while(true) {
-        if(!expansion_worker_receive_frame(instance, &rx_frame)) break;
-        if(!expansion_handlers[instance->state](instance, &rx_frame)) break;
+        if(!expansion_worker_receive_frame(instance, &instance->rx_frame)) break;
+        if(!expansion_handlers[instance->state](instance, &instance->rx_frame)) break;
     }
 }
 
@@ -345,9 +445,13 @@ static int32_t expansion_worker(void* context) {
     instance->state = ExpansionWorkerStateHandShake;
     instance->exit_reason = ExpansionWorkerExitReasonUnknown;
 
+    instance->extended = false;
+    instance->max_data_size = EXPANSION_PROTOCOL_MAX_DATA_SIZE;
+    instance->window_size = 1;
+
     furi_hal_serial_init(instance->serial_handle, EXPANSION_PROTOCOL_DEFAULT_BAUD_RATE);
 
-    furi_hal_serial_async_rx_start(
+    furi_hal_serial_dma_rx_start(
         instance->serial_handle, expansion_worker_serial_rx_callback, instance, true);
 
     if(expansion_worker_send_heartbeat(instance)) {
@@ -377,6 +481,8 @@ ExpansionWorker* expansion_worker_alloc(FuriHalSerialId serial_id) {
     instance->thread = furi_thread_alloc_ex(
         TAG "Worker", EXPANSION_WORKER_STACK_SZIE, expansion_worker, instance);
     instance->rx_buf = furi_stream_buffer_alloc(EXPANSION_WORKER_BUFFER_SIZE, 1);
+    instance->tx_done = furi_semaphore_alloc(1, 0);
+    instance->tx_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     instance->serial_id = serial_id;
 
     // Improves responsiveness in heavy games at the expense of dropped frames
@@ -387,6 +493,8 @@ ExpansionWorker* expansion_worker_alloc(FuriHalSerialId serial_id) {
 
 void expansion_worker_free(ExpansionWorker* instance) {
     furi_stream_buffer_free(instance->rx_buf);
+    furi_semaphore_free(instance->tx_done);
+    furi_mutex_free(instance->tx_mutex);
     furi_thread_join(instance->thread);
     furi_thread_free(instance->thread);
     free(instance);
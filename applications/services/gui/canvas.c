@@ -6,6 +6,15 @@
 #include <stdint.h>
 #include <u8g2_glue.h>
 
+// Display RAM is rewritten completely from time to time, in case it was corrupted by ESD
+#define CANVAS_DISPLAY_REFRESH_INTERVAL_MS (1000U)
+
+// Decoded icon frames kept between redraws, fits a full screen frame and a few small icons
+#define CANVAS_ICON_CACHE_SIZE (2048U)
+
+#define CANVAS_GLYPH_FLAG_CACHED (1U << 0)
+#define CANVAS_GLYPH_FLAG_EXISTS (1U << 1)
+
 const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
     [FontPrimary] = {.leading_default = 12, .leading_min = 11, .height = 8, .descender = 2},
     [FontSecondary] = {.leading_default = 11, .leading_min = 9, .height = 7, .descender = 2},
@@ -16,6 +25,7 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
 Canvas* canvas_init(void) {
     Canvas* canvas = malloc(sizeof(Canvas));
     canvas->compress_icon = compress_icon_alloc(ICON_DECOMPRESSOR_BUFFER_SIZE);
+    compress_icon_set_cache_size(canvas->compress_icon, CANVAS_ICON_CACHE_SIZE);
 
     // Initialize mutex
     canvas->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
@@ -30,6 +40,7 @@ Canvas* canvas_init(void) {
     u8g2_InitDisplay(&canvas->fb);
     // Wake up display
     u8g2_SetPowerSave(&canvas->fb, 0);
+    canvas->display_buffer = memmgr_alloc_from_pool(canvas_get_buffer_size(canvas));
 
     // Clear buffer and send to device
     canvas_clear(canvas);
@@ -43,9 +54,21 @@ void canvas_free(Canvas* canvas) {
     compress_icon_free(canvas->compress_icon);
     CanvasCallbackPairArray_clear(canvas->canvas_callback_pair);
     furi_mutex_free(canvas->mutex);
+    free(canvas->display_buffer);
     free(canvas);
 }
 
+static void canvas_icon_decode(Canvas* canvas, const uint8_t* icon_data, uint8_t** output) {
+    // Firmware image never changes, icons of FAPs and other RAM data may be gone on the next frame
+    const uint8_t* firmware_start = (const uint8_t*)furi_hal_flash_get_base();
+    const uint8_t* firmware_end = furi_hal_flash_get_free_start_address();
+    if(icon_data >= firmware_start && icon_data < firmware_end) {
+        compress_icon_decode_cached(canvas->compress_icon, icon_data, output);
+    } else {
+        compress_icon_decode(canvas->compress_icon, icon_data, output);
+    }
+}
+
 static void canvas_lock(Canvas* canvas) {
     furi_assert(canvas);
     furi_check(furi_mutex_acquire(canvas->mutex, FuriWaitForever) == FuriStatusOk);
@@ -66,9 +89,54 @@ void canvas_reset(Canvas* canvas) {
     canvas_set_font_direction(canvas, CanvasDirectionLeftToRight);
 }
 
+static void canvas_send_buffer(Canvas* canvas) {
+    u8g2_t* fb = &canvas->fb;
+    const uint8_t* buffer = u8g2_GetBufferPtr(fb);
+    const size_t tile_width = u8g2_GetBufferTileWidth(fb);
+    const size_t tile_height = u8g2_GetBufferTileHeight(fb);
+    const size_t page_size = tile_width * 8;
+
+    const uint32_t tick = furi_get_tick();
+    if(!canvas->display_synced ||
+       tick - canvas->display_refresh_tick >=
+           furi_ms_to_ticks(CANVAS_DISPLAY_REFRESH_INTERVAL_MS)) {
+        canvas->display_synced = true;
+        canvas->display_refresh_tick = tick;
+        u8g2_SendBuffer(fb);
+        memcpy(canvas->display_buffer, buffer, page_size * tile_height);
+        return;
+    }
+
+    bool is_dirty = false;
+
+    // Send changed span of every page, display does it in tiles of 8x8 pixels
+    for(size_t ty = 0; ty < tile_height; ty++) {
+        const uint8_t* page = &buffer[ty * page_size];
+        uint8_t* display_page = &canvas->display_buffer[ty * page_size];
+
+        size_t first = tile_width;
+        size_t last = 0;
+        for(size_t tx = 0; tx < tile_width; tx++) {
+            if(memcmp(&page[tx * 8], &display_page[tx * 8], 8) != 0) {
+                if(first == tile_width) first = tx;
+                last = tx;
+            }
+        }
+
+        if(first < tile_width) {
+            const size_t count = last - first + 1;
+            u8g2_UpdateDisplayArea(fb, first, ty, count, 1);
+            memcpy(&display_page[first * 8], &page[first * 8], count * 8);
+            is_dirty = true;
+        }
+    }
+
+    if(is_dirty) u8x8_RefreshDisplay(u8g2_GetU8x8(fb));
+}
+
 void canvas_commit(Canvas* canvas) {
     furi_check(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+    canvas_send_buffer(canvas);
 
     // Iterate over callbacks
     canvas_lock(canvas);
@@ -174,6 +242,94 @@ void canvas_set_custom_u8g2_font(Canvas* canvas, const uint8_t* font) {
     u8g2_SetFont(&canvas->fb, font);
 }
 
+static CanvasGlyphCache* canvas_glyph_cache_get(Canvas* canvas) {
+    const uint8_t* font = canvas->fb.font;
+    CanvasGlyphCache* cache = canvas->glyph_cache_current;
+    if(cache && cache->font == font) return cache;
+
+    cache = NULL;
+    for(size_t i = 0; i < CANVAS_GLYPH_CACHE_FONT_COUNT; i++) {
+        if(canvas->glyph_cache[i].font == font) {
+            cache = &canvas->glyph_cache[i];
+            break;
+        }
+    }
+
+    if(!cache) {
+        cache = &canvas->glyph_cache[canvas->glyph_cache_next];
+        canvas->glyph_cache_next = (canvas->glyph_cache_next + 1) % CANVAS_GLYPH_CACHE_FONT_COUNT;
+        memset(cache->glyphs, 0, sizeof(cache->glyphs));
+        cache->font = font;
+    }
+
+    canvas->glyph_cache_current = cache;
+    return cache;
+}
+
+static void canvas_glyph_metrics_load(Canvas* canvas, uint16_t encoding, CanvasGlyphMetrics* m) {
+    m->flags = CANVAS_GLYPH_FLAG_CACHED;
+    if(u8g2_IsGlyph(&canvas->fb, encoding)) {
+        m->flags |= CANVAS_GLYPH_FLAG_EXISTS;
+        m->delta_x = u8g2_GetGlyphWidth(&canvas->fb, encoding);
+        // Side effects of u8g2_GetGlyphWidth
+        m->width = canvas->fb.font_decode.glyph_width;
+        m->offset_x = canvas->fb.glyph_x_offset;
+    } else {
+        m->delta_x = 0;
+        m->width = 0;
+        m->offset_x = 0;
+    }
+}
+
+static const CanvasGlyphMetrics* canvas_glyph_metrics_get(
+    Canvas* canvas,
+    CanvasGlyphCache* cache,
+    uint16_t encoding,
+    CanvasGlyphMetrics* scratch) {
+    CanvasGlyphMetrics* m = scratch;
+    if(encoding >= CANVAS_GLYPH_CACHE_FIRST &&
+       encoding < CANVAS_GLYPH_CACHE_FIRST + CANVAS_GLYPH_CACHE_COUNT) {
+        m = &cache->glyphs[encoding - CANVAS_GLYPH_CACHE_FIRST];
+        if(m->flags & CANVAS_GLYPH_FLAG_CACHED) return m;
+    }
+
+    canvas_glyph_metrics_load(canvas, encoding, m);
+    return m;
+}
+
+// Same result as u8g2_GetUTF8Width, without decoding font data for every glyph
+static uint16_t canvas_utf8_width(Canvas* canvas, const char* str) {
+    CanvasGlyphCache* cache = canvas_glyph_cache_get(canvas);
+    CanvasGlyphMetrics scratch;
+    u8x8_t* u8x8 = u8g2_GetU8x8(&canvas->fb);
+
+    int32_t width = 0;
+    int8_t delta_x = 0;
+    uint8_t glyph_width = 0;
+    int8_t offset_x = 0;
+
+    u8x8_utf8_init(u8x8);
+    for(;;) {
+        const uint16_t encoding = u8x8_utf8_next(u8x8, (uint8_t)*str);
+        if(encoding == 0xFFFF) break;
+        str++;
+        if(encoding == 0xFFFE) continue;
+
+        const CanvasGlyphMetrics* m = canvas_glyph_metrics_get(canvas, cache, encoding, &scratch);
+        delta_x = m->delta_x;
+        width += delta_x;
+        if(m->flags & CANVAS_GLYPH_FLAG_EXISTS) {
+            glyph_width = m->width;
+            offset_x = m->offset_x;
+        }
+    }
+
+    // Last glyph takes its real pixel width instead of advance
+    if(glyph_width) width += glyph_width + offset_x - delta_x;
+
+    return width;
+}
+
 void canvas_draw_str(Canvas* canvas, int32_t x, int32_t y, const char* str) {
     furi_check(canvas);
     if(!str) return;
@@ -198,10 +354,10 @@ void canvas_draw_str_aligned(
     case AlignLeft:
         break;
     case AlignRight:
-        x -= u8g2_GetUTF8Width(&canvas->fb, str);
+        x -= canvas_utf8_width(canvas, str);
         break;
     case AlignCenter:
-        x -= (u8g2_GetUTF8Width(&canvas->fb, str) / 2);
+        x -= (canvas_utf8_width(canvas, str) / 2);
         break;
     default:
         furi_crash();
@@ -228,12 +384,14 @@ void canvas_draw_str_aligned(
 uint16_t canvas_string_width(Canvas* canvas, const char* str) {
     furi_check(canvas);
     if(!str) return 0;
-    return u8g2_GetUTF8Width(&canvas->fb, str);
+    return canvas_utf8_width(canvas, str);
 }
 
 size_t canvas_glyph_width(Canvas* canvas, uint16_t symbol) {
     furi_check(canvas);
-    return u8g2_GetGlyphWidth(&canvas->fb, symbol);
+    CanvasGlyphCache* cache = canvas_glyph_cache_get(canvas);
+    CanvasGlyphMetrics scratch;
+    return canvas_glyph_metrics_get(canvas, cache, symbol, &scratch)->delta_x;
 }
 
 void canvas_draw_bitmap(
@@ -248,7 +406,7 @@ void canvas_draw_bitmap(
     x += canvas->offset_x;
     y += canvas->offset_y;
     uint8_t* bitmap_data = NULL;
-    compress_icon_decode(canvas->compress_icon, compressed_bitmap_data, &bitmap_data);
+    canvas_icon_decode(canvas, compressed_bitmap_data, &bitmap_data);
     canvas_draw_u8g2_bitmap(&canvas->fb, x, y, width, height, bitmap_data, IconRotation0);
 }
 
@@ -263,8 +421,7 @@ void canvas_draw_icon_animation(
     x += canvas->offset_x;
     y += canvas->offset_y;
     uint8_t* icon_data = NULL;
-    compress_icon_decode(
-        canvas->compress_icon, icon_animation_get_data(icon_animation), &icon_data);
+    canvas_icon_decode(canvas, icon_animation_get_data(icon_animation), &icon_data);
     canvas_draw_u8g2_bitmap(
         &canvas->fb,
         x,
@@ -348,6 +505,94 @@ static void canvas_draw_u8g2_bitmap_int(
     }
 }
 
+/* Same as u8g2 low level hvline: color 0 clears, 1 sets, 2 inverts pixels */
+static inline uint8_t canvas_blit_apply(uint8_t dst, uint8_t pixels, uint8_t color) {
+    if(color <= 1) dst |= pixels;
+    if(color != 1) dst ^= pixels;
+    return dst;
+}
+
+/* 8 columns of bitmap row starting at column, bits past the row end are garbage */
+static inline uint8_t canvas_blit_fetch(const uint8_t* row, size_t row_size, size_t column) {
+    const size_t index = column >> 3;
+    const uint8_t shift = column & 7U;
+
+    uint8_t value = row[index] >> shift;
+    if(shift && index + 1U < row_size) value |= row[index + 1U] << (8U - shift);
+
+    return value;
+}
+
+/* 8x8 bit matrix transpose: bit 8 * row + column goes to 8 * column + row */
+static inline uint64_t canvas_blit_transpose(uint64_t value) {
+    uint64_t t;
+    t = (value ^ (value >> 7)) & 0x00AA00AA00AA00AAULL;
+    value ^= t ^ (t << 7);
+    t = (value ^ (value >> 14)) & 0x0000CCCC0000CCCCULL;
+    value ^= t ^ (t << 14);
+    t = (value ^ (value >> 28)) & 0x00000000F0F0F0F0ULL;
+    value ^= t ^ (t << 28);
+    return value;
+}
+
+/* Unrotated bitmap straight into the page buffer
+ *
+ * Display memory is made of pages: one byte holds 8 vertical pixels of a
+ * column. Up to 8x8 bitmap blocks are transposed into column bytes and
+ * written whole, with per-page masks for the clipped first and last page.
+ */
+static void canvas_draw_u8g2_bitmap_fast(
+    u8g2_t* u8g2,
+    int32_t x,
+    int32_t y,
+    size_t w,
+    size_t h,
+    const uint8_t* bitmap) {
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+    if(u8g2->is_page_clip_window_intersection == 0) return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+
+    const int32_t x0 = MAX(x, (int32_t)u8g2->user_x0);
+    const int32_t x1 = MIN(x + (int32_t)w, (int32_t)u8g2->user_x1);
+    const int32_t y0 = MAX(y, (int32_t)u8g2->user_y0);
+    const int32_t y1 = MIN(y + (int32_t)h, (int32_t)u8g2->user_y1);
+    if(x0 >= x1 || y0 >= y1) return;
+
+    const size_t row_size = (w + 7U) >> 3;
+    const uint8_t color = u8g2->draw_color;
+    const uint8_t ncolor = (color == 0 ? 1 : 0);
+    const bool opaque = (u8g2->bitmap_transparency == 0);
+    const int32_t buffer_y0 = u8g2->pixel_curr_row;
+
+    for(int32_t page_y = (y0 - buffer_y0) & ~7; page_y + buffer_y0 < y1; page_y += 8) {
+        // Rows of this page covered by the bitmap, in page bit positions
+        const int32_t bit_start = MAX(y0 - buffer_y0 - page_y, 0);
+        const int32_t bit_end = MIN(y1 - buffer_y0 - page_y, 8);
+        const uint8_t mask = (0xFFU << bit_start) & (0xFFU >> (8 - bit_end));
+
+        uint8_t* page = u8g2->tile_buf_ptr + (page_y >> 3) * u8g2->pixel_buf_width;
+        const int32_t row_y = page_y + buffer_y0 - y;
+
+        for(int32_t column = x0 - x; column < x1 - x; column += 8) {
+            uint64_t block = 0;
+            for(int32_t bit = bit_start; bit < bit_end; bit++) {
+                const uint8_t* row = bitmap + (row_y + bit) * (int32_t)row_size;
+                block |= (uint64_t)canvas_blit_fetch(row, row_size, column) << (bit * 8);
+            }
+            block = canvas_blit_transpose(block);
+
+            uint8_t* dst = page + x + column;
+            const int32_t count = MIN(x1 - x - column, 8);
+            for(int32_t i = 0; i < count; i++) {
+                const uint8_t pixels = (block >> (i * 8)) & mask;
+                uint8_t value = canvas_blit_apply(dst[i], pixels, color);
+                if(opaque) value = canvas_blit_apply(value, ~pixels & mask, ncolor);
+                dst[i] = value;
+            }
+        }
+    }
+}
+
 void canvas_draw_u8g2_bitmap(
     u8g2_t* u8g2,
     int32_t x,
@@ -362,7 +607,11 @@ void canvas_draw_u8g2_bitmap(
 
     switch(rotation) {
     case IconRotation0:
-        canvas_draw_u8g2_bitmap_int(u8g2, x, y, width, height, 0, 0, bitmap);
+        if(u8g2->cb == U8G2_R0) {
+            canvas_draw_u8g2_bitmap_fast(u8g2, x, y, width, height, bitmap);
+        } else {
+            canvas_draw_u8g2_bitmap_int(u8g2, x, y, width, height, 0, 0, bitmap);
+        }
         break;
     case IconRotation90:
         canvas_draw_u8g2_bitmap_int(u8g2, x, y, width, height, 0, 1, bitmap);
@@ -390,7 +639,7 @@ void canvas_draw_icon_ex(
     x += canvas->offset_x;
     y += canvas->offset_y;
     uint8_t* icon_data = NULL;
-    compress_icon_decode(canvas->compress_icon, icon_get_frame_data(icon, 0), &icon_data);
+    canvas_icon_decode(canvas, icon_get_frame_data(icon, 0), &icon_data);
     canvas_draw_u8g2_bitmap(
         &canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), icon_data, rotation);
 }
@@ -402,7 +651,7 @@ void canvas_draw_icon(Canvas* canvas, int32_t x, int32_t y, const Icon* icon) {
     x += canvas->offset_x;
     y += canvas->offset_y;
     uint8_t* icon_data = NULL;
-    compress_icon_decode(canvas->compress_icon, icon_get_frame_data(icon, 0), &icon_data);
+    canvas_icon_decode(canvas, icon_get_frame_data(icon, 0), &icon_data);
     canvas_draw_u8g2_bitmap(
         &canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), icon_data, IconRotation0);
 }
@@ -35,6 +35,23 @@ ARRAY_DEF(CanvasCallbackPairArray, CanvasCallbackPair, M_POD_OPLIST);
 
 ALGO_DEF(CanvasCallbackPairArray, CanvasCallbackPairArray_t);
 
+#define CANVAS_GLYPH_CACHE_FONT_COUNT (4U)
+#define CANVAS_GLYPH_CACHE_FIRST      (0x20U)
+#define CANVAS_GLYPH_CACHE_COUNT      (0x5FU) // Printable ASCII
+
+/** Glyph metrics, as u8g2 decodes them from font data */
+typedef struct {
+    int8_t delta_x;
+    uint8_t width;
+    int8_t offset_x;
+    uint8_t flags;
+} CanvasGlyphMetrics;
+
+typedef struct {
+    const uint8_t* font;
+    CanvasGlyphMetrics glyphs[CANVAS_GLYPH_CACHE_COUNT];
+} CanvasGlyphCache;
+
 /** Canvas structure
  */
 struct Canvas {
@@ -47,6 +64,12 @@ struct Canvas {
     CompressIcon* compress_icon;
     CanvasCallbackPairArray_t canvas_callback_pair;
     FuriMutex* mutex;
+    uint8_t* display_buffer; // What display shows, only changed tiles are sent
+    bool display_synced;
+    uint32_t display_refresh_tick;
+    CanvasGlyphCache glyph_cache[CANVAS_GLYPH_CACHE_FONT_COUNT];
+    CanvasGlyphCache* glyph_cache_current;
+    uint8_t glyph_cache_next; // Slot to evict, round robin
 };
 
 /** Allocate memory and initialize canvas
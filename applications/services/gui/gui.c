@@ -1,5 +1,6 @@
 #include "gui_i.h"
 #include <assets_icons.h>
+#include <furi_hal.h>
 
 #define TAG "GuiSrv"
 
@@ -247,6 +248,8 @@ static void gui_redraw(Gui* gui) {
     do {
         if(gui->direct_draw) break;
 
+        const uint32_t start = DWT->CYCCNT;
+
         canvas_reset(gui->canvas);
 
         if(gui->lockdown) {
@@ -265,6 +268,18 @@ static void gui_redraw(Gui* gui) {
         }
 
         canvas_commit(gui->canvas);
+
+        const uint32_t time_us =
+            (DWT->CYCCNT - start) / furi_hal_cortex_instructions_per_microsecond();
+        GuiRenderStats* stats = &gui->render_stats;
+        if(stats->frame_count) {
+            stats->average_time_us = (stats->average_time_us * 7U + time_us) / 8U;
+        } else {
+            stats->average_time_us = time_us;
+        }
+        stats->last_time_us = time_us;
+        stats->max_time_us = MAX(stats->max_time_us, time_us);
+        stats->frame_count++;
     } while(false);
 
     gui_unlock(gui);
@@ -495,6 +510,26 @@ void gui_set_lockdown(Gui* gui, bool lockdown) {
     gui_update(gui);
 }
 
+void gui_set_max_fps(Gui* gui, uint32_t fps) {
+    furi_check(gui);
+
+    gui_lock(gui);
+    gui->redraw_interval = fps ? furi_ms_to_ticks(1000U / fps) : 0;
+    gui_unlock(gui);
+
+    // Pending frame may be due already
+    gui_update(gui);
+}
+
+void gui_get_render_stats(Gui* gui, GuiRenderStats* stats) {
+    furi_check(gui);
+    furi_check(stats);
+
+    gui_lock(gui);
+    *stats = gui->render_stats;
+    gui_unlock(gui);
+}
+
 Canvas* gui_direct_draw_acquire(Gui* gui) {
     furi_check(gui);
 
@@ -537,6 +572,7 @@ Gui* gui_alloc(void) {
 
     // Drawing canvas
     gui->canvas = canvas_init();
+    gui->redraw_interval = furi_ms_to_ticks(1000U / GUI_MAX_FPS_DEFAULT);
 
     // Input
     gui->input_queue = furi_message_queue_alloc(8, sizeof(InputEvent));
@@ -554,8 +590,15 @@ int32_t gui_srv(void* p) {
     furi_record_create(RECORD_GUI, gui);
 
     while(1) {
-        uint32_t flags =
-            furi_thread_flags_wait(GUI_THREAD_FLAG_ALL, FuriFlagWaitAny, FuriWaitForever);
+        uint32_t timeout = FuriWaitForever;
+        if(gui->redraw_pending) {
+            const uint32_t elapsed = furi_get_tick() - gui->redraw_tick;
+            timeout = elapsed < gui->redraw_interval ? gui->redraw_interval - elapsed : 0;
+        }
+
+        uint32_t flags = furi_thread_flags_wait(GUI_THREAD_FLAG_ALL, FuriFlagWaitAny, timeout);
+        // Timeout: pending frame is due
+        if(flags & FuriFlagError) flags = 0;
         // Process and dispatch input
         if(flags & GUI_THREAD_FLAG_INPUT) {
             // Process till queue become empty
@@ -568,6 +611,13 @@ int32_t gui_srv(void* p) {
         if(flags & GUI_THREAD_FLAG_DRAW) {
             // Clear flags that arrived on input step
             furi_thread_flags_clear(GUI_THREAD_FLAG_DRAW);
+            if(gui->redraw_pending) gui->render_stats.coalesced_count++;
+            gui->redraw_pending = true;
+        }
+        // Requests that came within frame interval are served by one redraw
+        if(gui->redraw_pending && furi_get_tick() - gui->redraw_tick >= gui->redraw_interval) {
+            gui->redraw_pending = false;
+            gui->redraw_tick = furi_get_tick();
             gui_redraw(gui);
         }
     }
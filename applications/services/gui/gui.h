@@ -110,6 +110,32 @@ size_t gui_get_framebuffer_size(const Gui* gui);
  */
 void gui_set_lockdown(Gui* gui, bool lockdown);
 
+/** Gui render statistics */
+typedef struct {
+    uint32_t frame_count; /**< Frames rendered */
+    uint32_t coalesced_count; /**< Redraw requests merged into already pending frame */
+    uint32_t last_time_us; /**< Render time of the last frame */
+    uint32_t average_time_us; /**< Running average of render time */
+    uint32_t max_time_us; /**< Longest render time */
+} GuiRenderStats;
+
+/** Set maximum frame rate
+ *
+ * Redraw requests coming faster than that are merged into one frame,
+ * input dispatch is not delayed.
+ *
+ * @param      gui   Gui instance
+ * @param      fps   frames per second, 0 to disable the limit
+ */
+void gui_set_max_fps(Gui* gui, uint32_t fps);
+
+/** Get render statistics
+ *
+ * @param      gui    Gui instance
+ * @param      stats  GuiRenderStats to fill
+ */
+void gui_get_render_stats(Gui* gui, GuiRenderStats* stats);
+
 /** Acquire Direct Draw lock and get Canvas instance
  *
  * This method return Canvas instance for use in monopoly mode. Direct draw lock
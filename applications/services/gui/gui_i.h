@@ -41,6 +41,8 @@
 #define GUI_THREAD_FLAG_INPUT (1 << 1)
 #define GUI_THREAD_FLAG_ALL   (GUI_THREAD_FLAG_DRAW | GUI_THREAD_FLAG_INPUT)
 
+#define GUI_MAX_FPS_DEFAULT (60U)
+
 ARRAY_DEF(ViewPortArray, ViewPort*, M_PTR_OPLIST);
 
 /** Gui structure */
@@ -55,6 +57,12 @@ struct Gui {
     ViewPortArray_t layers[GuiLayerMAX];
     Canvas* canvas;
 
+    // Frame rate governor
+    uint32_t redraw_interval; // In ticks, 0 - no limit
+    uint32_t redraw_tick;
+    bool redraw_pending;
+    GuiRenderStats render_stats;
+
     // Input
     FuriMessageQueue* input_queue;
     FuriPubSub* input_events;
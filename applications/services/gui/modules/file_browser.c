@@ -100,6 +100,9 @@ struct FileBrowser {
     FileBrowserLoadItemCallback item_callback;
     void* item_context;
 
+    FileBrowserHighlightCallback highlight_callback;
+    void* highlight_context;
+
     FuriString* result_path;
     FuriTimer* scroll_timer;
 };
@@ -131,6 +134,7 @@ static const Icon* BrowserItemIcons[] = {
 
 static void file_browser_view_draw_callback(Canvas* canvas, void* _model);
 static bool file_browser_view_input_callback(InputEvent* event, void* context);
+static void browser_highlight_notify(FileBrowser* browser);
 
 static void
     browser_folder_open_cb(void* context, uint32_t item_cnt, int32_t file_idx, bool is_root);
@@ -174,6 +178,8 @@ FileBrowser* file_browser_alloc(FuriString* result_path) {
         furi_timer_alloc(file_browser_scroll_timer_callback, FuriTimerTypePeriodic, browser);
 
     browser->result_path = result_path;
+    browser->highlight_callback = NULL;
+    browser->highlight_context = NULL;
 
     with_view_model(
         browser->view, FileBrowserModel * model, { items_array_init(model->items); }, false);
@@ -271,6 +277,16 @@ void file_browser_set_item_callback(
     browser->item_callback = callback;
 }
 
+void file_browser_set_highlight_callback(
+    FileBrowser* browser,
+    FileBrowserHighlightCallback callback,
+    void* context) {
+    furi_check(browser);
+
+    browser->highlight_context = context;
+    browser->highlight_callback = callback;
+}
+
 static bool browser_is_item_in_array(FileBrowserModel* model, uint32_t idx) {
     size_t array_size = items_array_size(model->items);
 
@@ -281,6 +297,29 @@ static bool browser_is_item_in_array(FileBrowserModel* model, uint32_t idx) {
     return true;
 }
 
+static void browser_highlight_notify(FileBrowser* browser) {
+    if(!browser->highlight_callback) return;
+
+    FuriString* path = NULL;
+    with_view_model(
+        browser->view,
+        FileBrowserModel * model,
+        {
+            if(browser_is_item_in_array(model, model->item_idx)) {
+                BrowserItem_t* item =
+                    items_array_get(model->items, model->item_idx - model->array_offset);
+                if(item->type == BrowserItemTypeFile) {
+                    path = furi_string_alloc_set(item->path);
+                }
+            }
+        },
+        false);
+
+    // Called without model lock, callback is free to take its time
+    browser->highlight_callback(path, browser->highlight_context);
+    if(path) furi_string_free(path);
+}
+
 static bool browser_is_list_load_required(FileBrowserModel* model) {
     size_t array_size = items_array_size(model->items);
     if((array_size > 0) && (!model->is_root) && (model->array_offset == 0)) {
@@ -461,6 +500,7 @@ static void
                 }
             },
             true);
+        browser_highlight_notify(browser);
     }
 }
 
@@ -668,6 +708,7 @@ static bool file_browser_view_input_callback(InputEvent* event, void* context) {
                 },
                 true);
             browser_update_offset(browser);
+            browser_highlight_notify(browser);
             consumed = true;
         } else if(event->type == InputTypeRelease) {
             with_view_model(
@@ -20,6 +20,9 @@ typedef bool (*FileBrowserLoadItemCallback)(
     uint8_t** icon,
     FuriString* item_name);
 
+/** Highlighted item callback, path is NULL if highlighted item is not a file */
+typedef void (*FileBrowserHighlightCallback)(FuriString* path, void* context);
+
 FileBrowser* file_browser_alloc(FuriString* result_path);
 
 void file_browser_free(FileBrowser* browser);
@@ -46,6 +49,11 @@ void file_browser_set_item_callback(
     FileBrowserLoadItemCallback callback,
     void* context);
 
+void file_browser_set_highlight_callback(
+    FileBrowser* browser,
+    FileBrowserHighlightCallback callback,
+    void* context);
+
 #ifdef __cplusplus
 }
 #endif
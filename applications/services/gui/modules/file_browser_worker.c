@@ -4,6 +4,7 @@
 #include <storage/storage.h>
 
 #include <toolbox/path.h>
+#include <toolbox/stream/buffered_file_stream.h>
 #include <core/check.h>
 #include <core/common_defines.h>
 #include <furi.h>
@@ -18,6 +19,11 @@
 #define BROWSER_ROOT        STORAGE_EXT_PATH_PREFIX
 #define FILE_NAME_LEN_MAX   256
 #define LONG_LOAD_THRESHOLD 100
+#define READ_BATCH_SIZE     8
+
+// Folder listing is kept on SD, so windows are served without rereading the directory
+#define BROWSER_INDEX_DIR             EXT_PATH(".tmp")
+#define BROWSER_INDEX_CHECKPOINT_STEP 32
 
 typedef enum {
     WorkerEvtStop = (1 << 0),
@@ -33,7 +39,7 @@ typedef enum {
      WorkerEvtFolderRefresh | WorkerEvtConfigChange)
 
 ARRAY_DEF(IdxLastArray, int32_t)
-ARRAY_DEF(ExtFilterArray, FuriString*, FURI_STRING_OPLIST)
+ARRAY_DEF(IndexCheckpointArray, uint32_t, M_POD_OPLIST)
 
 struct BrowserWorker {
     FuriThread* thread;
@@ -44,10 +50,18 @@ struct BrowserWorker {
     int32_t item_sel_idx;
     uint32_t load_offset;
     uint32_t load_count;
-    bool skip_assets;
-    bool hide_dot_files;
     IdxLastArray_t idx_last;
-    ExtFilterArray_t ext_filter;
+    // Evaluated by storage, extension points to ext_filter
+    FuriString* ext_filter;
+    StorageDirFilter filter;
+
+    // Listing of index_folder, valid while storage timestamp is unchanged
+    FuriString* index_path;
+    FuriString* index_folder;
+    bool index_valid;
+    uint32_t index_timestamp;
+    uint32_t index_count;
+    IndexCheckpointArray_t index_checkpoints; // Record offsets, one per checkpoint step
 
     void* cb_ctx;
     BrowserWorkerFolderOpenCallback folder_cb;
@@ -79,67 +93,17 @@ static bool browser_path_trim(FuriString* path) {
     }
     return is_root;
 }
-static void browser_parse_ext_filter(ExtFilterArray_t ext_filter, const char* filter_str) {
-    ExtFilterArray_reset(ext_filter);
-    if(!filter_str) {
-        return;
-    }
-
-    size_t len = strlen(filter_str);
-    if(len == 0) {
-        return;
-    }
-
-    size_t str_offset = 0;
-    FuriString* ext_temp = furi_string_alloc();
-    while(1) {
-        size_t ext_len = strcspn(&filter_str[str_offset], "|");
-
-        furi_string_set_strn(ext_temp, &filter_str[str_offset], ext_len);
-        ExtFilterArray_push_back(ext_filter, ext_temp);
-
-        str_offset += ext_len + 1;
-        if(str_offset >= len) {
-            break;
-        }
-    }
-    furi_string_free(ext_temp);
-}
-
-static bool browser_filter_by_name(BrowserWorker* browser, FuriString* name, bool is_folder) {
-    // Skip dot files if enabled
-    if(browser->hide_dot_files) {
-        if(furi_string_start_with_str(name, ".")) {
-            return false;
-        }
-    }
-
-    if(is_folder) {
-        // Skip assets folders (if enabled)
-        if(browser->skip_assets) {
-            return (furi_string_cmp_str(name, ASSETS_DIR) == 0) ? (false) : (true);
-        } else {
-            return true;
-        }
-    } else {
-        // Filter files by extension
-        if(ExtFilterArray_size(browser->ext_filter) == 0) {
-            return true;
-        }
-
-        ExtFilterArray_it_t it;
-        for(ExtFilterArray_it(it, browser->ext_filter); !ExtFilterArray_end_p(it);
-            ExtFilterArray_next(it)) {
-            FuriString* ext = *ExtFilterArray_cref(it);
-            if((furi_string_empty(ext)) || (furi_string_cmp_str(ext, "*") == 0)) {
-                return true;
-            }
-            if(furi_string_end_withi(name, ext)) {
-                return true;
-            }
-        }
-    }
-    return false;
+static void browser_set_filter(
+    BrowserWorker* browser,
+    const char* ext_filter,
+    bool skip_assets,
+    bool hide_dot_files) {
+    furi_string_set(browser->ext_filter, ext_filter ? ext_filter : "");
+    browser->filter = (StorageDirFilter){
+        .extension = furi_string_get_cstr(browser->ext_filter),
+        .skip_dot_items = hide_dot_files,
+        .skip_dir_name = skip_assets ? ASSETS_DIR : NULL,
+    };
 }
 
 static bool browser_folder_check_and_switch(FuriString* path) {
@@ -167,6 +131,81 @@ static bool browser_folder_check_and_switch(FuriString* path) {
     return is_root;
 }
 
+static bool browser_index_is_current(BrowserWorker* browser, Storage* storage, FuriString* path) {
+    if(!browser->index_valid || furi_string_cmp(browser->index_folder, path) != 0) {
+        return false;
+    }
+
+    uint32_t timestamp = 0;
+    if(storage_common_timestamp(storage, furi_string_get_cstr(browser->index_path), &timestamp) !=
+       FSE_OK) {
+        return false;
+    }
+
+    return timestamp == browser->index_timestamp;
+}
+
+static bool browser_index_write_record(
+    BrowserWorker* browser,
+    Stream* index,
+    const char* name,
+    bool is_dir) {
+    if(browser->index_count % BROWSER_INDEX_CHECKPOINT_STEP == 0) {
+        IndexCheckpointArray_push_back(browser->index_checkpoints, stream_tell(index));
+    }
+    browser->index_count++;
+
+    const size_t name_len = strlen(name);
+    const uint8_t header[2] = {is_dir, name_len};
+    return stream_write(index, header, sizeof(header)) == sizeof(header) &&
+           stream_write(index, (const uint8_t*)name, name_len) == name_len;
+}
+
+static bool browser_index_read_record(Stream* index, char* name, bool* is_dir) {
+    uint8_t header[2];
+    if(stream_read(index, header, sizeof(header)) != sizeof(header)) return false;
+    if(stream_read(index, (uint8_t*)name, header[1]) != header[1]) return false;
+
+    name[header[1]] = '\0';
+    *is_dir = header[0];
+    return true;
+}
+
+static bool browser_index_folder_init(
+    BrowserWorker* browser,
+    Storage* storage,
+    FuriString* filename,
+    uint32_t* item_cnt,
+    int32_t* file_idx) {
+    *item_cnt = browser->index_count;
+    *file_idx = -1;
+    if(furi_string_empty(filename)) return true;
+
+    Stream* index = buffered_file_stream_alloc(storage);
+    char name_temp[FILE_NAME_LEN_MAX];
+    bool is_dir;
+    bool state = false;
+
+    if(buffered_file_stream_open(
+           index, furi_string_get_cstr(browser->index_path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        state = true;
+        for(uint32_t i = 0; i < browser->index_count; i++) {
+            if(!browser_index_read_record(index, name_temp, &is_dir)) {
+                state = false;
+                break;
+            }
+            if(furi_string_cmp_str(filename, name_temp) == 0) {
+                *file_idx = i;
+                break;
+            }
+        }
+    }
+
+    stream_free(index);
+
+    return state;
+}
+
 static bool browser_folder_init(
     BrowserWorker* browser,
     FuriString* path,
@@ -174,66 +213,160 @@ static bool browser_folder_init(
     uint32_t* item_cnt,
     int32_t* file_idx) {
     bool state = false;
-    FileInfo file_info;
-    uint32_t total_files_cnt = 0;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
 
-    char name_temp[FILE_NAME_LEN_MAX];
-    FuriString* name_str;
-    name_str = furi_string_alloc();
+    // Nothing was written since the folder was listed
+    if(browser_index_is_current(browser, storage, path) &&
+       browser_index_folder_init(browser, storage, filename, item_cnt, file_idx)) {
+        furi_record_close(RECORD_STORAGE);
+        return true;
+    }
+
+    File* directory = storage_file_alloc(storage);
+    StorageDirItem* items = malloc(sizeof(StorageDirItem) * READ_BATCH_SIZE);
 
     *item_cnt = 0;
     *file_idx = -1;
 
+    browser->index_valid = false;
+    browser->index_count = 0;
+    IndexCheckpointArray_reset(browser->index_checkpoints);
+    storage_simply_mkdir(storage, BROWSER_INDEX_DIR);
+    Stream* index = buffered_file_stream_alloc(storage);
+    bool index_state = buffered_file_stream_open(
+        index, furi_string_get_cstr(browser->index_path), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
+    // Index itself must not show up when its folder is browsed
+    const char* index_name = NULL;
+    if(furi_string_cmp_str(path, BROWSER_INDEX_DIR) == 0) {
+        index_name = strrchr(furi_string_get_cstr(browser->index_path), '/') + 1;
+    }
+
     if(storage_dir_open(directory, furi_string_get_cstr(path))) {
         state = true;
-        while(1) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
-                break;
-            }
-            if((storage_file_get_error(directory) == FSE_OK) && (name_temp[0] != '\0')) {
-                total_files_cnt++;
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    if(!furi_string_empty(filename)) {
-                        if(furi_string_cmp(name_str, filename) == 0) {
-                            *file_idx = *item_cnt;
-                        }
+        size_t read_cnt = 0;
+        do {
+            // Filtered by storage, only matching items come back
+            read_cnt =
+                storage_dir_read_many(directory, items, READ_BATCH_SIZE, &browser->filter);
+            for(size_t i = 0; i < read_cnt; i++) {
+                const StorageDirItem* item = &items[i];
+                if(index_name && strcmp(index_name, item->name) == 0) {
+                    continue;
+                }
+                if(!furi_string_empty(filename)) {
+                    if(furi_string_cmp_str(filename, item->name) == 0) {
+                        *file_idx = *item_cnt;
                     }
-                    (*item_cnt)++;
                 }
-                if(total_files_cnt == LONG_LOAD_THRESHOLD) {
+                (*item_cnt)++;
+                if(index_state) {
+                    index_state = browser_index_write_record(
+                        browser, index, item->name, file_info_is_dir(&item->fileinfo));
+                }
+                if(*item_cnt == LONG_LOAD_THRESHOLD) {
                     // There are too many files in folder and counting them will take some time - send callback to app
                     if(browser->long_load_cb) {
                         browser->long_load_cb(browser->cb_ctx);
                     }
                 }
             }
-        }
+        } while(read_cnt == READ_BATCH_SIZE);
     }
 
-    furi_string_free(name_str);
+    free(items);
 
     storage_dir_close(directory);
     storage_file_free(directory);
 
+    index_state &= buffered_file_stream_close(index);
+    stream_free(index);
+
+    // Timestamp is taken after own writes, any later write makes the index stale
+    if(state && index_state &&
+       storage_common_timestamp(
+           storage, furi_string_get_cstr(browser->index_path), &browser->index_timestamp) ==
+           FSE_OK) {
+        furi_string_set(browser->index_folder, path);
+        browser->index_valid = true;
+    }
+
     furi_record_close(RECORD_STORAGE);
 
     return state;
 }
 
+static bool browser_index_folder_load(
+    BrowserWorker* browser,
+    Storage* storage,
+    FuriString* path,
+    uint32_t offset,
+    uint32_t count) {
+    Stream* index = buffered_file_stream_alloc(storage);
+    char name_temp[FILE_NAME_LEN_MAX];
+    FuriString* name_str = furi_string_alloc();
+    bool is_dir;
+    uint32_t items_cnt = 0;
+
+    do {
+        if(offset > browser->index_count) break;
+        if(!buffered_file_stream_open(
+               index, furi_string_get_cstr(browser->index_path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            break;
+        }
+
+        // Jump to the closest checkpoint, then skip the rest record by record
+        const size_t checkpoint = offset / BROWSER_INDEX_CHECKPOINT_STEP;
+        if(checkpoint < IndexCheckpointArray_size(browser->index_checkpoints)) {
+            if(!stream_seek(
+                   index,
+                   *IndexCheckpointArray_get(browser->index_checkpoints, checkpoint),
+                   StreamOffsetFromStart)) {
+                break;
+            }
+        }
+        uint32_t skip = offset % BROWSER_INDEX_CHECKPOINT_STEP;
+        while(skip && browser_index_read_record(index, name_temp, &is_dir)) {
+            skip--;
+        }
+        if(skip) break;
+
+        if(browser->list_load_cb) {
+            browser->list_load_cb(browser->cb_ctx, offset);
+        }
+
+        while(items_cnt < count && offset + items_cnt < browser->index_count) {
+            if(!browser_index_read_record(index, name_temp, &is_dir)) break;
+            furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
+            if(browser->list_item_cb) {
+                browser->list_item_cb(browser->cb_ctx, name_str, is_dir, false);
+            }
+            items_cnt++;
+        }
+        if(browser->list_item_cb) {
+            browser->list_item_cb(browser->cb_ctx, NULL, false, true);
+        }
+    } while(0);
+
+    furi_string_free(name_str);
+    stream_free(index);
+
+    return items_cnt == count;
+}
+
 static bool
     browser_folder_load(BrowserWorker* browser, FuriString* path, uint32_t offset, uint32_t count) {
-    FileInfo file_info;
-
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
 
-    char name_temp[FILE_NAME_LEN_MAX];
-    FuriString* name_str;
-    name_str = furi_string_alloc();
+    if(browser_index_is_current(browser, storage, path)) {
+        const bool state = browser_index_folder_load(browser, storage, path, offset, count);
+        furi_record_close(RECORD_STORAGE);
+        return state;
+    }
+
+    File* directory = storage_file_alloc(storage);
+    StorageDirItem* items = malloc(sizeof(StorageDirItem) * READ_BATCH_SIZE);
+    FuriString* name_str = furi_string_alloc();
 
     uint32_t items_cnt = 0;
 
@@ -242,21 +375,8 @@ static bool
             break;
         }
 
-        items_cnt = 0;
-        while(items_cnt < offset) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
-                break;
-            }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    items_cnt++;
-                }
-            } else {
-                break;
-            }
-        }
-        if(items_cnt != offset) {
+        // Items before the window are only counted by storage
+        if(storage_dir_read_many(directory, NULL, offset, &browser->filter) != offset) {
             break;
         }
 
@@ -264,30 +384,27 @@ static bool
             browser->list_load_cb(browser->cb_ctx, offset);
         }
 
-        items_cnt = 0;
         while(items_cnt < count) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
-                break;
-            }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
-                    if(browser->list_item_cb) {
-                        browser->list_item_cb(
-                            browser->cb_ctx, name_str, file_info_is_dir(&file_info), false);
-                    }
-                    items_cnt++;
+            const size_t batch_cnt = MIN(count - items_cnt, (uint32_t)READ_BATCH_SIZE);
+            const size_t read_cnt =
+                storage_dir_read_many(directory, items, batch_cnt, &browser->filter);
+            for(size_t i = 0; i < read_cnt; i++) {
+                const StorageDirItem* item = &items[i];
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), item->name);
+                if(browser->list_item_cb) {
+                    browser->list_item_cb(
+                        browser->cb_ctx, name_str, file_info_is_dir(&item->fileinfo), false);
                 }
-            } else {
-                break;
+                items_cnt++;
             }
+            if(read_cnt != batch_cnt) break;
         }
         if(browser->list_item_cb) {
             browser->list_item_cb(browser->cb_ctx, NULL, false, true);
         }
     } while(0);
 
+    free(items);
     furi_string_free(name_str);
 
     storage_dir_close(directory);
@@ -324,6 +441,8 @@ static int32_t browser_worker(void* context) {
                 path_extract_filename(browser->path_next, filename, false);
             }
             IdxLastArray_reset(browser->idx_last);
+            // Filter may be different
+            browser->index_valid = false;
 
             furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtFolderEnter);
         }
@@ -403,6 +522,10 @@ static int32_t browser_worker(void* context) {
     furi_string_free(filename);
     furi_string_free(path);
 
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, furi_string_get_cstr(browser->index_path));
+    furi_record_close(RECORD_STORAGE);
+
     FURI_LOG_D(TAG, "End");
     return 0;
 }
@@ -416,11 +539,15 @@ BrowserWorker* file_browser_worker_alloc(
     BrowserWorker* browser = malloc(sizeof(BrowserWorker));
 
     IdxLastArray_init(browser->idx_last);
-    ExtFilterArray_init(browser->ext_filter);
+    browser->ext_filter = furi_string_alloc();
+    IndexCheckpointArray_init(browser->index_checkpoints);
+
+    // Several browsers may be open at the same time
+    browser->index_path = furi_string_alloc_printf(
+        "%s/browser_%08lX.idx", BROWSER_INDEX_DIR, (uint32_t)(uintptr_t)browser);
+    browser->index_folder = furi_string_alloc();
 
-    browser_parse_ext_filter(browser->ext_filter, ext_filter);
-    browser->skip_assets = skip_assets;
-    browser->hide_dot_files = hide_dot_files;
+    browser_set_filter(browser, ext_filter, skip_assets, hide_dot_files);
 
     browser->path_current = furi_string_alloc_set(path);
     browser->path_next = furi_string_alloc_set(path);
@@ -448,7 +575,10 @@ void file_browser_worker_free(BrowserWorker* browser) {
     furi_string_free(browser->path_start);
 
     IdxLastArray_clear(browser->idx_last);
-    ExtFilterArray_clear(browser->ext_filter);
+    furi_string_free(browser->ext_filter);
+    IndexCheckpointArray_clear(browser->index_checkpoints);
+    furi_string_free(browser->index_path);
+    furi_string_free(browser->index_folder);
 
     free(browser);
 }
@@ -494,9 +624,7 @@ void file_browser_worker_set_config(
     bool hide_dot_files) {
     furi_check(browser);
     furi_string_set(browser->path_next, path);
-    browser_parse_ext_filter(browser->ext_filter, ext_filter);
-    browser->skip_assets = skip_assets;
-    browser->hide_dot_files = hide_dot_files;
+    browser_set_filter(browser, ext_filter, skip_assets, hide_dot_files);
     furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtConfigChange);
 }
 
@@ -53,8 +53,19 @@ typedef struct {
     FuriString* header;
     size_t position;
     size_t window_position;
+
+    // Virtual mode: items are not stored, labels are requested for visible rows
+    size_t virtual_count;
+    SubmenuItemLabelCallback virtual_label_callback;
+    SubmenuItemCallback virtual_callback;
+    void* virtual_context;
 } SubmenuModel;
 
+static size_t submenu_items_size(const SubmenuModel* model) {
+    if(model->virtual_label_callback) return model->virtual_count;
+    return SubmenuItemArray_size(model->items);
+}
+
 static void submenu_process_up(Submenu* submenu);
 static void submenu_process_down(Submenu* submenu);
 static void submenu_process_ok(Submenu* submenu);
@@ -74,45 +85,47 @@ static void submenu_view_draw_callback(Canvas* canvas, void* _model) {
 
     canvas_set_font(canvas, FontSecondary);
 
-    size_t position = 0;
-    SubmenuItemArray_it_t it;
-    for(SubmenuItemArray_it(it, model->items); !SubmenuItemArray_end_p(it);
-        SubmenuItemArray_next(it)) {
-        const size_t item_position = position - model->window_position;
-        const size_t items_on_screen = furi_string_empty(model->header) ? 4 : 3;
-        uint8_t y_offset = furi_string_empty(model->header) ? 0 : 16;
-
-        if(item_position < items_on_screen) {
-            if(position == model->position) {
-                canvas_set_color(canvas, ColorBlack);
-                elements_slightly_rounded_box(
-                    canvas,
-                    0,
-                    y_offset + (item_position * item_height) + 1,
-                    item_width,
-                    item_height - 2);
-                canvas_set_color(canvas, ColorWhite);
-            } else {
-                canvas_set_color(canvas, ColorBlack);
-            }
+    const size_t items_size = submenu_items_size(model);
+    const size_t items_on_screen = furi_string_empty(model->header) ? 4 : 3;
+    uint8_t y_offset = furi_string_empty(model->header) ? 0 : 16;
+    FuriString* disp_str = furi_string_alloc();
 
-            FuriString* disp_str;
-            disp_str = furi_string_alloc_set(SubmenuItemArray_cref(it)->label);
-            elements_string_fit_width(canvas, disp_str, item_width - (6 * 2));
+    // Only visible rows are touched, list size doesn't matter
+    for(size_t item_position = 0; item_position < items_on_screen; item_position++) {
+        const size_t position = model->window_position + item_position;
+        if(position >= items_size) break;
 
-            canvas_draw_str(
+        if(position == model->position) {
+            canvas_set_color(canvas, ColorBlack);
+            elements_slightly_rounded_box(
                 canvas,
-                6,
-                y_offset + (item_position * item_height) + item_height - 4,
-                furi_string_get_cstr(disp_str));
+                0,
+                y_offset + (item_position * item_height) + 1,
+                item_width,
+                item_height - 2);
+            canvas_set_color(canvas, ColorWhite);
+        } else {
+            canvas_set_color(canvas, ColorBlack);
+        }
 
-            furi_string_free(disp_str);
+        if(model->virtual_label_callback) {
+            furi_string_reset(disp_str);
+            model->virtual_label_callback(model->virtual_context, position, disp_str);
+        } else {
+            furi_string_set(disp_str, SubmenuItemArray_cget(model->items, position)->label);
         }
+        elements_string_fit_width(canvas, disp_str, item_width - (6 * 2));
 
-        position++;
+        canvas_draw_str(
+            canvas,
+            6,
+            y_offset + (item_position * item_height) + item_height - 4,
+            furi_string_get_cstr(disp_str));
     }
 
-    elements_scrollbar(canvas, model->position, SubmenuItemArray_size(model->items));
+    furi_string_free(disp_str);
+
+    elements_scrollbar(canvas, model->position, items_size);
 }
 
 static bool submenu_view_input_callback(InputEvent* event, void* context) {
@@ -206,6 +219,7 @@ void submenu_add_item(
         submenu->view,
         SubmenuModel * model,
         {
+            furi_check(!model->virtual_label_callback);
             item = SubmenuItemArray_push_new(model->items);
             furi_string_set_str(item->label, label);
             item->index = index;
@@ -215,6 +229,33 @@ void submenu_add_item(
         true);
 }
 
+void submenu_set_virtual_items(
+    Submenu* submenu,
+    uint32_t count,
+    SubmenuItemLabelCallback label_callback,
+    SubmenuItemCallback callback,
+    void* context) {
+    furi_check(submenu);
+    furi_check(label_callback);
+
+    with_view_model(
+        submenu->view,
+        SubmenuModel * model,
+        {
+            SubmenuItemArray_reset(model->items);
+            model->virtual_count = count;
+            model->virtual_label_callback = label_callback;
+            model->virtual_callback = callback;
+            model->virtual_context = context;
+
+            if(model->position >= count) {
+                model->position = 0;
+                model->window_position = 0;
+            }
+        },
+        true);
+}
+
 void submenu_change_item_label(Submenu* submenu, uint32_t index, const char* label) {
     furi_check(submenu);
     furi_check(label);
@@ -246,6 +287,10 @@ void submenu_reset(Submenu* submenu) {
             model->position = 0;
             model->window_position = 0;
             furi_string_reset(model->header);
+            model->virtual_count = 0;
+            model->virtual_label_callback = NULL;
+            model->virtual_callback = NULL;
+            model->virtual_context = NULL;
         },
         true);
 }
@@ -259,7 +304,9 @@ uint32_t submenu_get_selected_item(Submenu* submenu) {
         submenu->view,
         SubmenuModel * model,
         {
-            if(model->position < SubmenuItemArray_size(model->items)) {
+            if(model->virtual_label_callback) {
+                selected_item_index = model->position;
+            } else if(model->position < SubmenuItemArray_size(model->items)) {
                 const SubmenuItem* item = SubmenuItemArray_cget(model->items, model->position);
                 selected_item_index = item->index;
             }
@@ -276,16 +323,20 @@ void submenu_set_selected_item(Submenu* submenu, uint32_t index) {
         SubmenuModel * model,
         {
             size_t position = 0;
-            SubmenuItemArray_it_t it;
-            for(SubmenuItemArray_it(it, model->items); !SubmenuItemArray_end_p(it);
-                SubmenuItemArray_next(it)) {
-                if(index == SubmenuItemArray_cref(it)->index) {
-                    break;
+            if(model->virtual_label_callback) {
+                position = index;
+            } else {
+                SubmenuItemArray_it_t it;
+                for(SubmenuItemArray_it(it, model->items); !SubmenuItemArray_end_p(it);
+                    SubmenuItemArray_next(it)) {
+                    if(index == SubmenuItemArray_cref(it)->index) {
+                        break;
+                    }
+                    position++;
                 }
-                position++;
             }
 
-            const size_t items_size = SubmenuItemArray_size(model->items);
+            const size_t items_size = submenu_items_size(model);
 
             if(position >= items_size) {
                 position = 0;
@@ -318,7 +369,7 @@ void submenu_process_up(Submenu* submenu) {
         SubmenuModel * model,
         {
             const size_t items_on_screen = furi_string_empty(model->header) ? 4 : 3;
-            const size_t items_size = SubmenuItemArray_size(model->items);
+            const size_t items_size = submenu_items_size(model);
 
             if(model->position > 0) {
                 model->position--;
@@ -341,7 +392,7 @@ void submenu_process_down(Submenu* submenu) {
         SubmenuModel * model,
         {
             const size_t items_on_screen = furi_string_empty(model->header) ? 4 : 3;
-            const size_t items_size = SubmenuItemArray_size(model->items);
+            const size_t items_size = submenu_items_size(model);
 
             if(model->position < items_size - 1) {
                 model->position++;
@@ -358,21 +409,31 @@ void submenu_process_down(Submenu* submenu) {
 }
 
 void submenu_process_ok(Submenu* submenu) {
-    SubmenuItem* item = NULL;
+    SubmenuItemCallback callback = NULL;
+    void* callback_context = NULL;
+    uint32_t index = 0;
 
     with_view_model(
         submenu->view,
         SubmenuModel * model,
         {
-            const size_t items_size = SubmenuItemArray_size(model->items);
-            if(model->position < items_size) {
-                item = SubmenuItemArray_get(model->items, model->position);
+            if(model->position < submenu_items_size(model)) {
+                if(model->virtual_label_callback) {
+                    callback = model->virtual_callback;
+                    callback_context = model->virtual_context;
+                    index = model->position;
+                } else {
+                    const SubmenuItem* item = SubmenuItemArray_cget(model->items, model->position);
+                    callback = item->callback;
+                    callback_context = item->callback_context;
+                    index = item->index;
+                }
             }
         },
         true);
 
-    if(item && item->callback) {
-        item->callback(item->callback_context, item->index);
+    if(callback) {
+        callback(callback_context, index);
     }
 }
 
@@ -14,6 +14,7 @@ extern "C" {
 /** Submenu anonymous structure */
 typedef struct Submenu Submenu;
 typedef void (*SubmenuItemCallback)(void* context, uint32_t index);
+typedef void (*SubmenuItemLabelCallback)(void* context, uint32_t index, FuriString* label);
 
 /** Allocate and initialize submenu 
  * 
@@ -53,6 +54,29 @@ void submenu_add_item(
     SubmenuItemCallback callback,
     void* callback_context);
 
+/** Switch submenu to virtual mode
+ *
+ * Items are not stored: labels are requested for visible rows only, so memory
+ * use and setup time don't depend on item count. Item index is its position.
+ * Added items are removed, submenu_reset returns to regular mode. Call again
+ * to change item count, selection is kept if it is still in range.
+ *
+ * @warning    label_callback is called from GUI thread with view model locked,
+ *             it must not call submenu API
+ *
+ * @param      submenu         Submenu instance
+ * @param      count           item count
+ * @param      label_callback  callback filling label for given index
+ * @param      callback        item callback
+ * @param      context         context for both callbacks
+ */
+void submenu_set_virtual_items(
+    Submenu* submenu,
+    uint32_t count,
+    SubmenuItemLabelCallback label_callback,
+    SubmenuItemCallback callback,
+    void* context);
+
 /** Change label of an existing item
  * 
  * @param      submenu  Submenu instance
@@ -12,6 +12,10 @@
 #define TEXT_BOX_LINES_SCROLL_SPEED_FAST       (5)
 #define TEXT_BOX_LINES_SCROLL_SPEED_SATURATION (9)
 
+#define TEXT_BOX_STREAM_WINDOW_SIZE (256)
+// Backward search for paragraph start is bounded, wrapping restarts from there
+#define TEXT_BOX_STREAM_PARAGRAPH_MAX (1024)
+
 struct TextBox {
     View* view;
 
@@ -23,6 +27,13 @@ typedef struct {
     TextBoxFocus focus;
     const char* text;
 
+    // Stream mode: only a window around the current position is kept in memory
+    Stream* stream;
+    int32_t stream_size;
+    int32_t window_offset;
+    int32_t window_size;
+    uint8_t* window;
+
     int32_t scroll_pos;
     int32_t scroll_num;
     int32_t lines_on_screen;
@@ -40,7 +51,10 @@ static void text_box_process_down(TextBox* text_box, uint8_t lines) {
         text_box->view,
         TextBoxModel * model,
         {
-            if(model->scroll_pos + lines < model->scroll_num) {
+            if(model->stream) {
+                // Line count is unknown, draw callback stops at the end of text
+                model->scroll_pos += lines;
+            } else if(model->scroll_pos + lines < model->scroll_num) {
                 model->scroll_pos += lines;
             } else {
                 if(model->scroll_num > 0) {
@@ -56,7 +70,7 @@ static void text_box_process_up(TextBox* text_box, uint8_t lines) {
         text_box->view,
         TextBoxModel * model,
         {
-            if(model->scroll_pos - lines > 0) {
+            if(model->stream || model->scroll_pos - lines > 0) {
                 model->scroll_pos -= lines;
             } else {
                 model->scroll_pos = 0;
@@ -101,7 +115,27 @@ static bool text_box_view_input_callback(InputEvent* event, void* context) {
     return consumed;
 }
 
+static char text_box_get_char(TextBoxModel* model, int32_t offset) {
+    if(!model->stream) return model->text[offset];
+    if(offset >= model->stream_size) return '\0';
+
+    if(offset < model->window_offset || offset >= model->window_offset + model->window_size) {
+        // Keep some text behind, so scrolling back does not reload the window right away
+        const int32_t window_offset = MAX(offset - TEXT_BOX_STREAM_WINDOW_SIZE / 4, 0);
+        model->window_offset = window_offset;
+        model->window_size = 0;
+        if(stream_seek(model->stream, window_offset, StreamOffsetFromStart)) {
+            model->window_size =
+                stream_read(model->stream, model->window, TEXT_BOX_STREAM_WINDOW_SIZE);
+        }
+        if(offset >= model->window_offset + model->window_size) return '\0';
+    }
+
+    return model->window[offset - model->window_offset];
+}
+
 static bool text_box_end_of_text_reached(TextBoxModel* model) {
+    if(model->stream) return model->text_offset >= model->stream_size;
     return model->text[model->text_offset] == '\0';
 }
 
@@ -113,7 +147,7 @@ static void text_box_seek_next_line(Canvas* canvas, TextBoxModel* model) {
     size_t line_width = 0;
 
     while(!text_box_end_of_text_reached(model)) {
-        char symb = model->text[model->text_offset];
+        char symb = text_box_get_char(model, model->text_offset);
         if(symb == '\n') {
             model->text_offset++;
             break;
@@ -133,15 +167,18 @@ static void text_box_seek_end_of_prev_line(TextBoxModel* model) {
         if(text_box_start_of_text_reached(model)) break;
         model->text_offset--;
         if(text_box_start_of_text_reached(model)) break;
-        if(model->text[model->text_offset] == '\n') {
+        if(text_box_get_char(model, model->text_offset) == '\n') {
             model->text_offset--;
         }
     } while(false);
 }
 
 static void text_box_seek_prev_paragraph(TextBoxModel* model) {
-    while(!text_box_start_of_text_reached(model)) {
-        if(model->text[model->text_offset] == '\n') {
+    int32_t limit = 0;
+    if(model->stream) limit = MAX(model->text_offset - TEXT_BOX_STREAM_PARAGRAPH_MAX, 0);
+
+    while(model->text_offset > limit) {
+        if(text_box_get_char(model, model->text_offset) == '\n') {
             model->text_offset++;
             break;
         }
@@ -158,7 +195,8 @@ static void text_box_seek_prev_line(Canvas* canvas, TextBoxModel* model) {
     int32_t current_text_offset = model->text_offset;
     while(true) {
         text_box_seek_next_line(canvas, model);
-        if(model->text_offset == start_text_offset) {
+        // Wrapping from truncated paragraph may step over the start
+        if(model->text_offset >= start_text_offset) {
             break;
         }
         current_text_offset = model->text_offset;
@@ -188,12 +226,20 @@ static void text_box_update_screen_text(Canvas* canvas, TextBoxModel* model) {
         int32_t current_line_text_offset = model->text_offset;
         text_box_seek_next_line(canvas, model);
         int32_t next_line_text_offset = model->text_offset;
-        furi_string_set_strn(
-            model->text_line,
-            &model->text[current_line_text_offset],
-            next_line_text_offset - current_line_text_offset);
+        if(model->stream) {
+            furi_string_reset(model->text_line);
+            for(int32_t j = current_line_text_offset; j < next_line_text_offset; j++) {
+                const char symb = text_box_get_char(model, j);
+                furi_string_push_back(model->text_line, symb ? symb : ' ');
+            }
+        } else {
+            furi_string_set_strn(
+                model->text_line,
+                &model->text[current_line_text_offset],
+                next_line_text_offset - current_line_text_offset);
+        }
         size_t str_len = furi_string_size(model->text_line);
-        if(furi_string_get_char(model->text_line, str_len - 1) != '\n') {
+        if(!str_len || furi_string_get_char(model->text_line, str_len - 1) != '\n') {
             furi_string_push_back(model->text_line, '\n');
         }
         furi_string_cat(model->text_on_screen, model->text_line);
@@ -205,6 +251,45 @@ static void text_box_update_screen_text(Canvas* canvas, TextBoxModel* model) {
     model->text_offset = start_text_offset;
 }
 
+static void text_box_update_stream_on_screen(Canvas* canvas, TextBoxModel* model) {
+    int32_t line_offset = model->scroll_pos - model->line_offset;
+    for(; line_offset > 0; line_offset--) {
+        const int32_t text_offset = model->text_offset;
+        text_box_seek_next_line(canvas, model);
+        // Last line stays on screen
+        if(text_box_end_of_text_reached(model)) {
+            model->text_offset = text_offset;
+            break;
+        }
+    }
+    for(; line_offset < 0; line_offset++) {
+        text_box_seek_prev_line(canvas, model);
+    }
+    text_box_update_screen_text(canvas, model);
+    model->scroll_pos = 0;
+    model->line_offset = 0;
+}
+
+static void text_box_prepare_stream_model(Canvas* canvas, TextBoxModel* model) {
+    model->text_offset = 0;
+    model->scroll_num = 0;
+    model->scroll_pos = 0;
+    model->line_offset = 0;
+    model->lines_on_screen = TEXT_BOX_TEXT_HEIGHT / canvas_current_font_height(canvas);
+    model->stream_size = stream_size(model->stream);
+    model->window_offset = 0;
+    model->window_size = 0;
+
+    if(model->focus == TextBoxFocusEnd) {
+        model->text_offset = model->stream_size;
+        for(int32_t i = 0; i < model->lines_on_screen; i++) {
+            text_box_seek_prev_line(canvas, model);
+        }
+    }
+
+    text_box_update_screen_text(canvas, model);
+}
+
 static void text_box_update_text_on_screen(Canvas* canvas, TextBoxModel* model) {
     int32_t line_offset = model->scroll_pos - model->line_offset;
     text_box_move_line_offset(canvas, model, line_offset);
@@ -248,7 +333,7 @@ static void text_box_prepare_model(Canvas* canvas, TextBoxModel* model) {
 static void text_box_view_draw_callback(Canvas* canvas, void* _model) {
     TextBoxModel* model = _model;
 
-    if(!model->text) {
+    if(!model->text && !model->stream) {
         return;
     }
 
@@ -260,15 +345,26 @@ static void text_box_view_draw_callback(Canvas* canvas, void* _model) {
     }
 
     if(!model->formatted) {
-        text_box_prepare_model(canvas, model);
+        if(model->stream) {
+            text_box_prepare_stream_model(canvas, model);
+        } else {
+            text_box_prepare_model(canvas, model);
+        }
         model->formatted = true;
     }
 
     elements_slightly_rounded_frame(canvas, 0, 0, 124, 64);
-    elements_scrollbar(canvas, model->scroll_pos, model->scroll_num);
 
-    if(model->line_offset != model->scroll_pos) {
-        text_box_update_text_on_screen(canvas, model);
+    if(model->stream) {
+        if(model->line_offset != model->scroll_pos) {
+            text_box_update_stream_on_screen(canvas, model);
+        }
+        elements_scrollbar(canvas, model->text_offset, model->stream_size);
+    } else {
+        elements_scrollbar(canvas, model->scroll_pos, model->scroll_num);
+        if(model->line_offset != model->scroll_pos) {
+            text_box_update_text_on_screen(canvas, model);
+        }
     }
     elements_multiline_text(canvas, 3, 11, furi_string_get_cstr(model->text_on_screen));
 }
@@ -305,6 +401,7 @@ void text_box_free(TextBox* text_box) {
         {
             furi_string_free(model->text_on_screen);
             furi_string_free(model->text_line);
+            free(model->window);
         },
         true);
     view_free(text_box->view);
@@ -324,6 +421,7 @@ void text_box_reset(TextBox* text_box) {
         TextBoxModel * model,
         {
             model->text = NULL;
+            model->stream = NULL;
             model->font = TextBoxFontText;
             model->focus = TextBoxFocusStart;
             furi_string_reset(model->text_line);
@@ -347,6 +445,23 @@ void text_box_set_text(TextBox* text_box, const char* text) {
         TextBoxModel * model,
         {
             model->text = text;
+            model->stream = NULL;
+            model->formatted = false;
+        },
+        true);
+}
+
+void text_box_set_stream(TextBox* text_box, Stream* stream) {
+    furi_check(text_box);
+    furi_check(stream);
+
+    with_view_model(
+        text_box->view,
+        TextBoxModel * model,
+        {
+            if(!model->window) model->window = malloc(TEXT_BOX_STREAM_WINDOW_SIZE);
+            model->text = NULL;
+            model->stream = stream;
             model->formatted = false;
         },
         true);
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <gui/view.h>
+#include <toolbox/stream/stream.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -57,6 +58,19 @@ void text_box_reset(TextBox* text_box);
  */
 void text_box_set_text(TextBox* text_box, const char* text);
 
+/** Set stream as text source for text_box
+ *
+ * Text is read and wrapped lazily around the visible part, so the stream can
+ * be much bigger than available memory. Scroll bar shows position in bytes.
+ *
+ * @warning    Stream is read from GUI thread, it must stay valid and unchanged
+ *             until text_box is reset or other text is set.
+ *
+ * @param      text_box  TextBox instance
+ * @param      stream    Stream instance
+ */
+void text_box_set_stream(TextBox* text_box, Stream* stream);
+
 /** Set TextBox font
  *
  * @param      text_box  TextBox instance
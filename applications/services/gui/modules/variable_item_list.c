@@ -42,52 +42,48 @@ static void variable_item_list_draw_callback(Canvas* canvas, void* _model) {
 
     canvas_clear(canvas);
 
-    uint8_t position = 0;
-    VariableItemArray_it_t it;
+    const size_t items_size = VariableItemArray_size(model->items);
+    const uint8_t items_on_screen = 4;
+    const uint8_t y_offset = 0;
 
     canvas_set_font(canvas, FontSecondary);
-    for(VariableItemArray_it(it, model->items); !VariableItemArray_end_p(it);
-        VariableItemArray_next(it)) {
-        uint8_t item_position = position - model->window_position;
-        uint8_t items_on_screen = 4;
-        uint8_t y_offset = 0;
-
-        if(item_position < items_on_screen) {
-            const VariableItem* item = VariableItemArray_cref(it);
-            uint8_t item_y = y_offset + (item_position * item_height);
-            uint8_t item_text_y = item_y + item_height - 4;
-
-            if(position == model->position) {
-                canvas_set_color(canvas, ColorBlack);
-                elements_slightly_rounded_box(canvas, 0, item_y + 1, item_width, item_height - 2);
-                canvas_set_color(canvas, ColorWhite);
-            } else {
-                canvas_set_color(canvas, ColorBlack);
-            }
+    // Only visible rows are touched
+    for(uint8_t item_position = 0; item_position < items_on_screen; item_position++) {
+        const size_t position = model->window_position + item_position;
+        if(position >= items_size) break;
 
-            canvas_draw_str(canvas, 6, item_text_y, item->label);
+        const VariableItem* item = VariableItemArray_cget(model->items, position);
+        uint8_t item_y = y_offset + (item_position * item_height);
+        uint8_t item_text_y = item_y + item_height - 4;
 
-            if(item->current_value_index > 0) {
-                canvas_draw_str(canvas, 73, item_text_y, "<");
-            }
+        if(position == model->position) {
+            canvas_set_color(canvas, ColorBlack);
+            elements_slightly_rounded_box(canvas, 0, item_y + 1, item_width, item_height - 2);
+            canvas_set_color(canvas, ColorWhite);
+        } else {
+            canvas_set_color(canvas, ColorBlack);
+        }
 
-            canvas_draw_str_aligned(
-                canvas,
-                (115 + 73) / 2 + 1,
-                item_text_y,
-                AlignCenter,
-                AlignBottom,
-                furi_string_get_cstr(item->current_value_text));
+        canvas_draw_str(canvas, 6, item_text_y, item->label);
 
-            if(item->current_value_index < (item->values_count - 1)) {
-                canvas_draw_str(canvas, 115, item_text_y, ">");
-            }
+        if(item->current_value_index > 0) {
+            canvas_draw_str(canvas, 73, item_text_y, "<");
         }
 
-        position++;
+        canvas_draw_str_aligned(
+            canvas,
+            (115 + 73) / 2 + 1,
+            item_text_y,
+            AlignCenter,
+            AlignBottom,
+            furi_string_get_cstr(item->current_value_text));
+
+        if(item->current_value_index < (item->values_count - 1)) {
+            canvas_draw_str(canvas, 115, item_text_y, ">");
+        }
     }
 
-    elements_scrollbar(canvas, model->position, VariableItemArray_size(model->items));
+    elements_scrollbar(canvas, model->position, items_size);
 }
 
 void variable_item_list_set_selected_item(VariableItemList* variable_item_list, uint8_t index) {
@@ -10,6 +10,38 @@ ViewDispatcher* view_dispatcher_alloc(void) {
     return dispatcher;
 }
 
+static void view_dispatcher_queues_alloc(
+    ViewDispatcher* view_dispatcher,
+    size_t input_depth,
+    size_t event_depth) {
+    view_dispatcher->input_queue = furi_message_queue_alloc(input_depth, sizeof(InputEvent));
+    furi_event_loop_subscribe_message_queue(
+        view_dispatcher->event_loop,
+        view_dispatcher->input_queue,
+        FuriEventLoopEventIn,
+        view_dispatcher_run_input_callback,
+        view_dispatcher);
+
+    view_dispatcher->event_queue = furi_message_queue_alloc(event_depth, sizeof(uint32_t));
+    furi_event_loop_subscribe_message_queue(
+        view_dispatcher->event_loop,
+        view_dispatcher->event_queue,
+        FuriEventLoopEventIn,
+        view_dispatcher_run_event_callback,
+        view_dispatcher);
+
+    view_dispatcher->stats.input_depth = input_depth;
+    view_dispatcher->stats.event_depth = event_depth;
+}
+
+static void view_dispatcher_queues_free(ViewDispatcher* view_dispatcher) {
+    furi_event_loop_unsubscribe(view_dispatcher->event_loop, view_dispatcher->input_queue);
+    furi_event_loop_unsubscribe(view_dispatcher->event_loop, view_dispatcher->event_queue);
+
+    furi_message_queue_free(view_dispatcher->input_queue);
+    furi_message_queue_free(view_dispatcher->event_queue);
+}
+
 ViewDispatcher* view_dispatcher_alloc_ex(FuriEventLoop* loop) {
     ViewDispatcher* view_dispatcher = malloc(sizeof(ViewDispatcher));
 
@@ -24,23 +56,8 @@ ViewDispatcher* view_dispatcher_alloc_ex(FuriEventLoop* loop) {
 
     view_dispatcher->event_loop = loop;
 
-    view_dispatcher->input_queue =
-        furi_message_queue_alloc(VIEW_DISPATCHER_QUEUE_LEN, sizeof(InputEvent));
-    furi_event_loop_subscribe_message_queue(
-        view_dispatcher->event_loop,
-        view_dispatcher->input_queue,
-        FuriEventLoopEventIn,
-        view_dispatcher_run_input_callback,
-        view_dispatcher);
-
-    view_dispatcher->event_queue =
-        furi_message_queue_alloc(VIEW_DISPATCHER_QUEUE_LEN, sizeof(uint32_t));
-    furi_event_loop_subscribe_message_queue(
-        view_dispatcher->event_loop,
-        view_dispatcher->event_queue,
-        FuriEventLoopEventIn,
-        view_dispatcher_run_event_callback,
-        view_dispatcher);
+    view_dispatcher_queues_alloc(
+        view_dispatcher, VIEW_DISPATCHER_QUEUE_LEN, VIEW_DISPATCHER_QUEUE_LEN);
 
     return view_dispatcher;
 }
@@ -57,11 +74,7 @@ void view_dispatcher_free(ViewDispatcher* view_dispatcher) {
     // Free ViewPort
     view_port_free(view_dispatcher->view_port);
     // Free internal queue
-    furi_event_loop_unsubscribe(view_dispatcher->event_loop, view_dispatcher->input_queue);
-    furi_event_loop_unsubscribe(view_dispatcher->event_loop, view_dispatcher->event_queue);
-
-    furi_message_queue_free(view_dispatcher->input_queue);
-    furi_message_queue_free(view_dispatcher->event_queue);
+    view_dispatcher_queues_free(view_dispatcher);
 
     if(view_dispatcher->is_event_loop_owned) furi_event_loop_free(view_dispatcher->event_loop);
     // Free dispatcher
@@ -72,6 +85,31 @@ void view_dispatcher_enable_queue(ViewDispatcher* view_dispatcher) {
     UNUSED(view_dispatcher);
 }
 
+void view_dispatcher_set_queue_depth(
+    ViewDispatcher* view_dispatcher,
+    size_t input_depth,
+    size_t event_depth) {
+    furi_check(view_dispatcher);
+    furi_check(input_depth > 0);
+    furi_check(event_depth > 0);
+    furi_check(furi_message_queue_get_count(view_dispatcher->input_queue) == 0);
+    furi_check(furi_message_queue_get_count(view_dispatcher->event_queue) == 0);
+
+    view_dispatcher_queues_free(view_dispatcher);
+    view_dispatcher_queues_alloc(view_dispatcher, input_depth, event_depth);
+}
+
+void view_dispatcher_get_queue_stats(
+    ViewDispatcher* view_dispatcher,
+    ViewDispatcherQueueStats* stats) {
+    furi_check(view_dispatcher);
+    furi_check(stats);
+
+    FURI_CRITICAL_ENTER();
+    *stats = view_dispatcher->stats;
+    FURI_CRITICAL_EXIT();
+}
+
 void view_dispatcher_set_navigation_event_callback(
     ViewDispatcher* view_dispatcher,
     ViewDispatcherNavigationEventCallback callback) {
@@ -113,6 +151,8 @@ void view_dispatcher_run(ViewDispatcher* view_dispatcher) {
     uint32_t tick_period = view_dispatcher->tick_period == 0 ? FuriWaitForever :
                                                                view_dispatcher->tick_period;
 
+    view_dispatcher->is_stopping = false;
+
     if(view_dispatcher->is_event_loop_owned)
         furi_event_loop_tick_set(
             view_dispatcher->event_loop,
@@ -131,12 +171,17 @@ void view_dispatcher_run(ViewDispatcher* view_dispatcher) {
             view_dispatcher->ongoing_input |= key_bit;
         } else if(input.type == InputTypeRelease) {
             view_dispatcher->ongoing_input &= ~key_bit;
+        } else if(input.type == InputTypeRepeat) {
+            FURI_CRITICAL_ENTER();
+            view_dispatcher->repeat_pending &= ~key_bit;
+            FURI_CRITICAL_EXIT();
         }
     }
 }
 
 void view_dispatcher_stop(ViewDispatcher* view_dispatcher) {
     furi_check(view_dispatcher);
+    view_dispatcher->is_stopping = true;
     furi_event_loop_stop(view_dispatcher->event_loop);
 }
 
@@ -242,11 +287,33 @@ void view_dispatcher_draw_callback(Canvas* canvas, void* context) {
     }
 }
 
+static void view_dispatcher_update_high_water(FuriMessageQueue* queue, size_t* high_water) {
+    const size_t count = furi_message_queue_get_count(queue);
+    FURI_CRITICAL_ENTER();
+    if(count > *high_water) *high_water = count;
+    FURI_CRITICAL_EXIT();
+}
+
 void view_dispatcher_input_callback(InputEvent* event, void* context) {
     ViewDispatcher* view_dispatcher = context;
+
+    // Repeat is only a reminder that the key is still held, one waiting is enough
+    if(event->type == InputTypeRepeat) {
+        const uint8_t key_bit = (1 << event->key);
+        bool is_pending;
+        FURI_CRITICAL_ENTER();
+        is_pending = view_dispatcher->repeat_pending & key_bit;
+        view_dispatcher->repeat_pending |= key_bit;
+        if(is_pending) view_dispatcher->stats.coalesced++;
+        FURI_CRITICAL_EXIT();
+        if(is_pending) return;
+    }
+
     furi_check(
         furi_message_queue_put(view_dispatcher->input_queue, event, FuriWaitForever) ==
         FuriStatusOk);
+    view_dispatcher_update_high_water(
+        view_dispatcher->input_queue, &view_dispatcher->stats.input_high_water);
 }
 
 void view_dispatcher_handle_input(ViewDispatcher* view_dispatcher, InputEvent* event) {
@@ -330,6 +397,42 @@ void view_dispatcher_send_custom_event(ViewDispatcher* view_dispatcher, uint32_t
     furi_check(
         furi_message_queue_put(view_dispatcher->event_queue, &event, FuriWaitForever) ==
         FuriStatusOk);
+    view_dispatcher_update_high_water(
+        view_dispatcher->event_queue, &view_dispatcher->stats.event_high_water);
+}
+
+void view_dispatcher_send_custom_event_coalesced(ViewDispatcher* view_dispatcher, uint32_t event) {
+    furi_check(view_dispatcher);
+
+    bool is_pending = false;
+    FURI_CRITICAL_ENTER();
+    for(size_t i = 0; i < view_dispatcher->coalesce_pending_count; i++) {
+        if(view_dispatcher->coalesce_pending[i] == event) {
+            is_pending = true;
+            break;
+        }
+    }
+    if(is_pending) {
+        view_dispatcher->stats.coalesced++;
+    } else if(view_dispatcher->coalesce_pending_count < VIEW_DISPATCHER_COALESCE_MAX) {
+        // Set is full: event is still sent, just not merged with later ones
+        view_dispatcher->coalesce_pending[view_dispatcher->coalesce_pending_count++] = event;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(!is_pending) view_dispatcher_send_custom_event(view_dispatcher, event);
+}
+
+static void view_dispatcher_coalesce_release(ViewDispatcher* view_dispatcher, uint32_t event) {
+    FURI_CRITICAL_ENTER();
+    for(size_t i = 0; i < view_dispatcher->coalesce_pending_count; i++) {
+        if(view_dispatcher->coalesce_pending[i] == event) {
+            view_dispatcher->coalesce_pending[i] =
+                view_dispatcher->coalesce_pending[--view_dispatcher->coalesce_pending_count];
+            break;
+        }
+    }
+    FURI_CRITICAL_EXIT();
 }
 
 static const ViewPortOrientation view_dispatcher_view_port_orientation_table[] = {
@@ -381,9 +484,15 @@ void view_dispatcher_run_event_callback(FuriEventLoopObject* object, void* conte
     ViewDispatcher* instance = context;
     furi_assert(instance->event_queue == object);
 
+    // Drain what is already queued in one wakeup, newer events wait for the next one
+    size_t count = furi_message_queue_get_count(instance->event_queue);
     uint32_t event;
-    furi_check(furi_message_queue_get(instance->event_queue, &event, 0) == FuriStatusOk);
-    view_dispatcher_handle_custom_event(instance, event);
+    while(count-- && !instance->is_stopping &&
+          furi_message_queue_get(instance->event_queue, &event, 0) == FuriStatusOk) {
+        // Released before handling, so the handler may send it again
+        view_dispatcher_coalesce_release(instance, event);
+        view_dispatcher_handle_custom_event(instance, event);
+    }
 }
 
 void view_dispatcher_run_input_callback(FuriEventLoopObject* object, void* context) {
@@ -391,7 +500,15 @@ void view_dispatcher_run_input_callback(FuriEventLoopObject* object, void* conte
     ViewDispatcher* instance = context;
     furi_assert(instance->input_queue == object);
 
+    size_t count = furi_message_queue_get_count(instance->input_queue);
     InputEvent input;
-    furi_check(furi_message_queue_get(instance->input_queue, &input, 0) == FuriStatusOk);
-    view_dispatcher_handle_input(instance, &input);
+    while(count-- && !instance->is_stopping &&
+          furi_message_queue_get(instance->input_queue, &input, 0) == FuriStatusOk) {
+        if(input.type == InputTypeRepeat) {
+            FURI_CRITICAL_ENTER();
+            instance->repeat_pending &= ~(1 << input.key);
+            FURI_CRITICAL_EXIT();
+        }
+        view_dispatcher_handle_input(instance, &input);
+    }
 }
@@ -41,6 +41,15 @@ typedef bool (*ViewDispatcherNavigationEventCallback)(void* context);
 /** Prototype for tick event callback */
 typedef void (*ViewDispatcherTickEventCallback)(void* context);
 
+/** Queue statistics, for tuning queue depth */
+typedef struct {
+    size_t input_depth; /**< Input queue length */
+    size_t input_high_water; /**< Most input events ever waiting at once */
+    size_t event_depth; /**< Custom event queue length */
+    size_t event_high_water; /**< Most custom events ever waiting at once */
+    uint32_t coalesced; /**< Repeat inputs and custom events merged with pending ones */
+} ViewDispatcherQueueStats;
+
 /** Allocate ViewDispatcher instance
  *
  * @return     pointer to ViewDispatcher instance
@@ -75,6 +84,29 @@ void view_dispatcher_free(ViewDispatcher* view_dispatcher);
  */
 FURI_DEPRECATED void view_dispatcher_enable_queue(ViewDispatcher* view_dispatcher);
 
+/** Set queue depth
+ *
+ * Must be called before view_dispatcher_run, while the queues are empty.
+ * Default depth is 16 for both queues.
+ *
+ * @param      view_dispatcher  ViewDispatcher instance
+ * @param      input_depth      Input queue length
+ * @param      event_depth      Custom event queue length
+ */
+void view_dispatcher_set_queue_depth(
+    ViewDispatcher* view_dispatcher,
+    size_t input_depth,
+    size_t event_depth);
+
+/** Get queue statistics
+ *
+ * @param      view_dispatcher  ViewDispatcher instance
+ * @param[out] stats            The statistics
+ */
+void view_dispatcher_get_queue_stats(
+    ViewDispatcher* view_dispatcher,
+    ViewDispatcherQueueStats* stats);
+
 /** Send custom event
  *
  * @param      view_dispatcher  ViewDispatcher instance
@@ -82,6 +114,16 @@ FURI_DEPRECATED void view_dispatcher_enable_queue(ViewDispatcher* view_dispatche
  */
 void view_dispatcher_send_custom_event(ViewDispatcher* view_dispatcher, uint32_t event);
 
+/** Send custom event unless the same event is already waiting in the queue
+ *
+ * Use for events that only mean "something changed", like redraw or data
+ * ready notifications sent at high rate from worker threads.
+ *
+ * @param      view_dispatcher  ViewDispatcher instance
+ * @param[in]  event            The event
+ */
+void view_dispatcher_send_custom_event_coalesced(ViewDispatcher* view_dispatcher, uint32_t event);
+
 /** Set custom event handler
  *
  * Called on Custom Event, if it is not consumed by view
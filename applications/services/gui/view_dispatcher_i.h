@@ -13,12 +13,22 @@
 
 DICT_DEF2(ViewDict, uint32_t, M_DEFAULT_OPLIST, View*, M_PTR_OPLIST) // NOLINT
 
+#define VIEW_DISPATCHER_COALESCE_MAX (8U)
+
 struct ViewDispatcher {
     bool is_event_loop_owned;
+    bool is_stopping;
     FuriEventLoop* event_loop;
     FuriMessageQueue* input_queue;
     FuriMessageQueue* event_queue;
 
+    // Keys with a repeat event waiting in input queue
+    volatile uint8_t repeat_pending;
+    // Coalesced custom events waiting in event queue
+    uint32_t coalesce_pending[VIEW_DISPATCHER_COALESCE_MAX];
+    size_t coalesce_pending_count;
+    ViewDispatcherQueueStats stats;
+
     Gui* gui;
     ViewPort* view_port;
     ViewDict_t views;
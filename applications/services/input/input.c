@@ -6,8 +6,8 @@
 #include <furi.h>
 #include <cli/cli.h>
 #include <furi_hal_gpio.h>
+#include <furi_hal_cortex.h>
 
-#define INPUT_DEBOUNCE_TICKS_HALF (INPUT_DEBOUNCE_TICKS / 2)
 #define INPUT_PRESS_TICKS         150
 #define INPUT_LONG_PRESS_COUNTS   2
 #define INPUT_THREAD_FLAG_ISR     0x00000001
@@ -18,12 +18,24 @@ typedef struct {
     // State
     volatile bool state;
     volatile uint8_t debounce;
+    volatile bool edge_pending;
+    volatile uint32_t edge_timestamp;
+    FuriThreadId thread_id;
     FuriTimer* press_timer;
     FuriPubSub* event_pubsub;
     volatile uint8_t press_counter;
     volatile uint32_t counter;
 } InputPinState;
 
+/** Direct input callback slot */
+typedef struct {
+    FuriMutex* mutex;
+    InputDirectCallback callback;
+    void* context;
+} InputDirect;
+
+static InputDirect input_direct = {0};
+
 /** Input CLI command handler */
 void input_cli(Cli* cli, FuriString* args, void* context);
 
@@ -31,26 +43,56 @@ void input_cli(Cli* cli, FuriString* args, void* context);
 
 #define GPIO_Read(input_pin) (furi_hal_gpio_read(input_pin.pin->gpio) ^ (input_pin.pin->inverted))
 
+static void input_publish(FuriPubSub* event_pubsub, const InputEvent* event) {
+    bool consumed = false;
+
+    furi_check(furi_mutex_acquire(input_direct.mutex, FuriWaitForever) == FuriStatusOk);
+    if(input_direct.callback) {
+        consumed = input_direct.callback(event, input_direct.context);
+    }
+    furi_check(furi_mutex_release(input_direct.mutex) == FuriStatusOk);
+
+    if(!consumed) {
+        furi_pubsub_publish(event_pubsub, (void*)event);
+    }
+}
+
 void input_press_timer_callback(void* arg) {
     InputPinState* input_pin = arg;
     InputEvent event;
     event.sequence_source = INPUT_SEQUENCE_SOURCE_HARDWARE;
     event.sequence_counter = input_pin->counter;
     event.key = input_pin->pin->key;
+    event.timestamp = furi_hal_cortex_get_timestamp_us();
     input_pin->press_counter++;
     if(input_pin->press_counter == INPUT_LONG_PRESS_COUNTS) {
         event.type = InputTypeLong;
-        furi_pubsub_publish(input_pin->event_pubsub, &event);
+        input_publish(input_pin->event_pubsub, &event);
     } else if(input_pin->press_counter > INPUT_LONG_PRESS_COUNTS) {
         input_pin->press_counter--;
         event.type = InputTypeRepeat;
-        furi_pubsub_publish(input_pin->event_pubsub, &event);
+        input_publish(input_pin->event_pubsub, &event);
     }
 }
 
 void input_isr(void* _ctx) {
-    FuriThreadId thread_id = (FuriThreadId)_ctx;
-    furi_thread_flags_set(thread_id, INPUT_THREAD_FLAG_ISR);
+    InputPinState* input_pin = _ctx;
+    // First edge of a series is the moment the key was actually touched
+    if(!input_pin->edge_pending) {
+        input_pin->edge_timestamp = furi_hal_cortex_get_timestamp_us();
+        input_pin->edge_pending = true;
+    }
+    furi_thread_flags_set(input_pin->thread_id, INPUT_THREAD_FLAG_ISR);
+}
+
+void input_set_direct_callback(InputDirectCallback callback, void* context) {
+    furi_check(input_direct.mutex);
+
+    furi_check(furi_mutex_acquire(input_direct.mutex, FuriWaitForever) == FuriStatusOk);
+    furi_check(callback == NULL || input_direct.callback == NULL);
+    input_direct.callback = callback;
+    input_direct.context = context;
+    furi_check(furi_mutex_release(input_direct.mutex) == FuriStatusOk);
 }
 
 const char* input_get_key_name(InputKey key) {
@@ -85,6 +127,7 @@ int32_t input_srv(void* p) {
     const FuriThreadId thread_id = furi_thread_get_current_id();
     FuriPubSub* event_pubsub = furi_pubsub_alloc();
     uint32_t counter = 1;
+    input_direct.mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     furi_record_create(RECORD_INPUT_EVENTS, event_pubsub);
 
 #ifdef INPUT_DEBUG
@@ -99,35 +142,41 @@ int32_t input_srv(void* p) {
     InputPinState pin_states[input_pins_count];
 
     for(size_t i = 0; i < input_pins_count; i++) {
-        furi_hal_gpio_add_int_callback(input_pins[i].gpio, input_isr, thread_id);
         pin_states[i].pin = &input_pins[i];
         pin_states[i].state = GPIO_Read(pin_states[i]);
-        pin_states[i].debounce = INPUT_DEBOUNCE_TICKS_HALF;
+        pin_states[i].debounce = 0;
+        pin_states[i].edge_pending = false;
+        pin_states[i].thread_id = thread_id;
         pin_states[i].press_timer =
             furi_timer_alloc(input_press_timer_callback, FuriTimerTypePeriodic, &pin_states[i]);
         pin_states[i].event_pubsub = event_pubsub;
         pin_states[i].press_counter = 0;
+        furi_hal_gpio_add_int_callback(input_pins[i].gpio, input_isr, &pin_states[i]);
     }
 
     while(1) {
         bool is_changing = false;
         for(size_t i = 0; i < input_pins_count; i++) {
             bool state = GPIO_Read(pin_states[i]);
-            if(state) {
-                if(pin_states[i].debounce < INPUT_DEBOUNCE_TICKS) pin_states[i].debounce += 1;
-            } else {
-                if(pin_states[i].debounce > 0) pin_states[i].debounce -= 1;
-            }
 
-            if(pin_states[i].debounce > 0 && pin_states[i].debounce < INPUT_DEBOUNCE_TICKS) {
+            // Leading edge debounce: report the change right away, then ignore
+            // contact bounce for INPUT_DEBOUNCE_TICKS
+            if(pin_states[i].debounce > 0) {
+                pin_states[i].debounce--;
+                if(pin_states[i].debounce == 0) pin_states[i].edge_pending = false;
                 is_changing = true;
             } else if(pin_states[i].state != state) {
                 pin_states[i].state = state;
+                pin_states[i].debounce = INPUT_DEBOUNCE_TICKS;
+                is_changing = true;
 
                 // Common state info
                 InputEvent event;
                 event.sequence_source = INPUT_SEQUENCE_SOURCE_HARDWARE;
                 event.key = pin_states[i].pin->key;
+                event.timestamp = pin_states[i].edge_pending ?
+                                      pin_states[i].edge_timestamp :
+                                      furi_hal_cortex_get_timestamp_us();
 
                 // Short / Long / Repeat timer routine
                 if(state) {
@@ -141,14 +190,14 @@ int32_t input_srv(void* p) {
                         furi_delay_tick(1);
                     if(pin_states[i].press_counter < INPUT_LONG_PRESS_COUNTS) {
                         event.type = InputTypeShort;
-                        furi_pubsub_publish(event_pubsub, &event);
+                        input_publish(event_pubsub, &event);
                     }
                     pin_states[i].press_counter = 0;
                 }
 
                 // Send Press/Release event
                 event.type = pin_states[i].state ? InputTypePress : InputTypeRelease;
-                furi_pubsub_publish(event_pubsub, &event);
+                input_publish(event_pubsub, &event);
             }
         }
 
@@ -38,8 +38,21 @@ typedef struct {
     };
     InputKey key;
     InputType type;
+    uint32_t timestamp; /**< Hardware events only: edge time, furi_hal_cortex_get_timestamp_us */
 } InputEvent;
 
+/** Direct input callback
+ *
+ * Called from the input service thread or the press timer thread, before the
+ * event is published to RECORD_INPUT_EVENTS. Must be quick and must not block.
+ *
+ * @param      event    The hardware input event
+ * @param      context  The context
+ *
+ * @return     true if event is consumed and must not be published
+ */
+typedef bool (*InputDirectCallback)(const InputEvent* event, void* context);
+
 /** Get human readable input key name
  * @param key - InputKey
  * @return string
@@ -52,6 +65,18 @@ const char* input_get_key_name(InputKey key);
  */
 const char* input_get_type_name(InputType type);
 
+/** Set direct input callback
+ *
+ * Low latency channel for the foreground application: hardware events reach
+ * the callback without the pubsub fan-out and GUI queues. Only one callback
+ * can be set at a time, events not consumed by it go to RECORD_INPUT_EVENTS
+ * as usual. Callback is not called anymore once this function returns.
+ *
+ * @param      callback  The callback, NULL to clear
+ * @param      context   The context
+ */
+void input_set_direct_callback(InputDirectCallback callback, void* context);
+
 #ifdef __cplusplus
 }
 #endif
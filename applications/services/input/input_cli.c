@@ -30,9 +30,10 @@ static void input_cli_dump(Cli* cli, FuriString* args, FuriPubSub* event_pubsub)
     while(!cli_cmd_interrupt_received(cli)) {
         if(furi_message_queue_get(input_queue, &input_event, 100) == FuriStatusOk) {
             printf(
-                "key: %s type: %s\r\n",
+                "key: %s type: %s timestamp: %lu\r\n",
                 input_get_key_name(input_event.key),
-                input_get_type_name(input_event.type));
+                input_get_type_name(input_event.type),
+                input_event.timestamp);
         }
     }
 
@@ -49,7 +50,7 @@ static void input_cli_send_print_usage(void) {
 
 static void input_cli_send(Cli* cli, FuriString* args, FuriPubSub* event_pubsub) {
     UNUSED(cli);
-    InputEvent event;
+    InputEvent event = {0};
     FuriString* key_str;
     key_str = furi_string_alloc();
     bool parsed = false;
@@ -10,14 +10,19 @@
 
 static_assert(!has_hash_collisions(elf_api_table), "Detected API method hash collision!");
 
-constexpr HashtableApiInterface elf_api_interface{
+constexpr auto elf_api_table_index = hashtable_bucket_index(elf_api_table);
+
+constexpr HashtableIndexedApiInterface elf_api_interface{
     {
-        .api_version_major = (elf_api_version >> 16),
-        .api_version_minor = (elf_api_version & 0xFFFF),
-        .resolver_callback = &elf_resolve_from_hashtable,
+        {
+            .api_version_major = (elf_api_version >> 16),
+            .api_version_minor = (elf_api_version & 0xFFFF),
+            .resolver_callback = &elf_resolve_from_indexed_hashtable,
+        },
+        elf_api_table.cbegin(),
+        elf_api_table.cend(),
     },
-    elf_api_table.cbegin(),
-    elf_api_table.cend(),
+    elf_api_table_index.data(),
 };
 const ElfApiInterface* const firmware_api_interface = &elf_api_interface;
 
@@ -14,6 +14,9 @@
 
 #define LOADER_MAGIC_THREAD_VALUE 0xDEADBEEF
 
+#define LOADER_ARENA_CHUNK_SIZE (4096U)
+#define LOADER_ARENA_MAX_SIZE   (16384U)
+
 // helpers
 
 static const char* loader_find_external_application_by_name(const char* app_name) {
@@ -292,6 +295,12 @@ bool loader_get_application_name(Loader* loader, FuriString* name) {
     return result.value;
 }
 
+void loader_preload_hint(Loader* loader, const char* path) {
+    furi_check(loader);
+    // Preload slot has its own lock, no need to bother the loader thread
+    loader_preload_set(loader->preload, path);
+}
+
 // callbacks
 
 static void loader_menu_closed_callback(void* context) {
@@ -330,6 +339,7 @@ static Loader* loader_alloc(void) {
     loader->queue = furi_message_queue_alloc(1, sizeof(LoaderMessage));
     loader->loader_menu = NULL;
     loader->loader_applications = NULL;
+    loader->preload = loader_preload_alloc();
     loader->app.args = NULL;
     loader->app.thread = NULL;
     loader->app.insomniac = false;
@@ -379,6 +389,14 @@ static void loader_start_app_thread(Loader* loader, FlipperInternalApplicationFl
         furi_thread_disable_heap_trace(loader->app.thread);
     }
 
+    // setup arena: app allocations are returned in one go on exit,
+    // not used with heap trace since arena chunks would show up as leaks
+    furi_assert(loader->app.arena == NULL);
+    if(mode == FuriHalRtcHeapTrackModeNone) {
+        loader->app.arena = memmgr_arena_alloc(LOADER_ARENA_CHUNK_SIZE, LOADER_ARENA_MAX_SIZE);
+        furi_thread_set_arena(loader->app.thread, loader->app.arena);
+    }
+
     // setup insomnia
     if(!(flags & FlipperInternalApplicationFlagInsomniaSafe)) {
         furi_hal_power_insomnia_enter();
@@ -495,32 +513,45 @@ static LoaderMessageLoaderStatusResult loader_start_external_app(
     furi_pubsub_publish(loader->pubsub, &event);
 
     do {
-        loader->app.fap = flipper_application_alloc(storage, firmware_api_interface);
-        size_t start = furi_get_tick();
+        loader->app.fap = loader_preload_take(loader->preload, path);
+        if(loader->app.fap) {
+            FURI_LOG_I(TAG, "Using preloaded %s", path);
+        } else {
+            loader->app.fap = flipper_application_alloc(storage, firmware_api_interface);
+            size_t start = furi_get_tick();
 
-        FURI_LOG_I(TAG, "Loading %s", path);
+            FURI_LOG_I(TAG, "Loading %s", path);
 
-        FlipperApplicationPreloadStatus preload_res =
-            flipper_application_preload(loader->app.fap, path);
-        if(preload_res != FlipperApplicationPreloadStatusSuccess) {
-            const char* err_msg = flipper_application_preload_status_to_string(preload_res);
-            result.value = loader_make_status_error(
-                LoaderStatusErrorInternal, error_message, "Preload failed, %s: %s", path, err_msg);
-            result.error = loader_status_error_from_preload_status(preload_res);
-            break;
-        }
+            FlipperApplicationPreloadStatus preload_res =
+                flipper_application_preload(loader->app.fap, path);
+            if(preload_res != FlipperApplicationPreloadStatusSuccess) {
+                const char* err_msg = flipper_application_preload_status_to_string(preload_res);
+                result.value = loader_make_status_error(
+                    LoaderStatusErrorInternal,
+                    error_message,
+                    "Preload failed, %s: %s",
+                    path,
+                    err_msg);
+                result.error = loader_status_error_from_preload_status(preload_res);
+                break;
+            }
 
-        FlipperApplicationLoadStatus load_status =
-            flipper_application_map_to_memory(loader->app.fap);
-        if(load_status != FlipperApplicationLoadStatusSuccess) {
-            const char* err_msg = flipper_application_load_status_to_string(load_status);
-            result.value = loader_make_status_error(
-                LoaderStatusErrorInternal, error_message, "Load failed, %s: %s", path, err_msg);
-            result.error = loader_status_error_from_load_status(load_status);
-            break;
-        }
+            FlipperApplicationLoadStatus load_status =
+                flipper_application_map_to_memory(loader->app.fap);
+            if(load_status != FlipperApplicationLoadStatusSuccess) {
+                const char* err_msg = flipper_application_load_status_to_string(load_status);
+                result.value = loader_make_status_error(
+                    LoaderStatusErrorInternal,
+                    error_message,
+                    "Load failed, %s: %s",
+                    path,
+                    err_msg);
+                result.error = loader_status_error_from_load_status(load_status);
+                break;
+            }
 
-        FURI_LOG_I(TAG, "Loaded in %zums", (size_t)(furi_get_tick() - start));
+            FURI_LOG_I(TAG, "Loaded in %zums", (size_t)(furi_get_tick() - start));
+        }
 
         if(flipper_application_is_plugin(loader->app.fap)) {
             result.value = loader_make_status_error(
@@ -620,6 +651,8 @@ static LoaderMessageLoaderStatusResult loader_do_start_by_name(
         {
             const FlipperInternalApplication* app = loader_find_application_by_name(name);
             if(app) {
+                // Preloaded FAP would only hold memory from now on
+                loader_preload_take(loader->preload, NULL);
                 loader_start_internal_app(loader, app, args);
                 status.value = loader_make_success_status(error_message);
                 break;
@@ -697,6 +730,12 @@ static void loader_do_app_closed(Loader* loader) {
         loader->app.thread = NULL;
     }
 
+    if(loader->app.arena) {
+        FURI_LOG_I(TAG, "Arena used: %zu", memmgr_arena_get_used(loader->app.arena));
+        memmgr_arena_free(loader->app.arena);
+        loader->app.arena = NULL;
+    }
+
     FURI_LOG_I(TAG, "Application stopped. Free heap: %zu", memmgr_get_free_heap());
 
     LoaderEvent event;
@@ -108,6 +108,19 @@ bool loader_signal(Loader* instance, uint32_t signal, void* arg);
  */
 bool loader_get_application_name(Loader* instance, FuriString* name);
 
+/**
+ * @brief Hint the application that is likely to be started next
+ *
+ * After a short dwell on the same path the FAP is loaded and relocated in the
+ * background, so that starting it only has to run the entry point. The preload
+ * is dropped when another application starts or when memory runs low.
+ * Paths that are not FAPs are treated as NULL. Does not block.
+ *
+ * @param[in] instance pointer to the loader instance
+ * @param[in] path FAP path under the cursor, NULL to release the preload
+ */
+void loader_preload_hint(Loader* instance, const char* path);
+
 #ifdef __cplusplus
 }
 #endif
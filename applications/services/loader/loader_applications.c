@@ -2,6 +2,7 @@
 #include "loader_applications.h"
 #include <dialogs/dialogs.h>
 #include <flipper_application/flipper_application.h>
+#include <flipper_application/application_catalog.h>
 #include <assets_icons.h>
 #include <gui/gui.h>
 #include <gui/view_holder.h>
@@ -42,6 +43,7 @@ typedef struct {
     FuriString* file_path;
     DialogsApp* dialogs;
     Storage* storage;
+    FlipperApplicationCatalog* catalog;
     Loader* loader;
 
     Gui* gui;
@@ -54,6 +56,7 @@ static LoaderApplicationsApp* loader_applications_app_alloc(void) {
     app->file_path = furi_string_alloc_set(EXT_PATH("apps"));
     app->dialogs = furi_record_open(RECORD_DIALOGS);
     app->storage = furi_record_open(RECORD_STORAGE);
+    app->catalog = flipper_application_catalog_alloc(app->storage);
     app->loader = furi_record_open(RECORD_LOADER);
 
     app->gui = furi_record_open(RECORD_GUI);
@@ -74,6 +77,7 @@ static void loader_applications_app_free(LoaderApplicationsApp* app) {
 
     furi_record_close(RECORD_LOADER);
     furi_record_close(RECORD_DIALOGS);
+    flipper_application_catalog_free(app->catalog);
     furi_record_close(RECORD_STORAGE);
     furi_string_free(app->file_path);
     free(app);
@@ -87,8 +91,8 @@ static bool loader_applications_item_callback(
     LoaderApplicationsApp* loader_applications_app = context;
     furi_assert(loader_applications_app);
     if(furi_string_end_with(path, ".fap")) {
-        return flipper_application_load_name_and_icon(
-            path, loader_applications_app->storage, icon_ptr, item_name);
+        return flipper_application_catalog_load_name_and_icon(
+            loader_applications_app->catalog, path, icon_ptr, item_name);
     } else {
         path_extract_filename(path, item_name, false);
         memcpy(*icon_ptr, icon_get_frame_data(&I_js_script_10px, 0), FAP_MANIFEST_MAX_ICON_SIZE);
@@ -96,6 +100,12 @@ static bool loader_applications_item_callback(
     }
 }
 
+static void loader_applications_highlight_callback(FuriString* path, void* context) {
+    LoaderApplicationsApp* loader_applications_app = context;
+    furi_assert(loader_applications_app);
+    loader_preload_hint(loader_applications_app->loader, path ? furi_string_get_cstr(path) : NULL);
+}
+
 static bool loader_applications_select_app(LoaderApplicationsApp* loader_applications_app) {
     const DialogsFileBrowserOptions browser_options = {
         .extension = ".fap|.js",
@@ -104,6 +114,8 @@ static bool loader_applications_select_app(LoaderApplicationsApp* loader_applica
         .hide_ext = true,
         .item_loader_callback = loader_applications_item_callback,
         .item_loader_context = loader_applications_app,
+        .item_highlight_callback = loader_applications_highlight_callback,
+        .item_highlight_context = loader_applications_app,
         .base_path = EXT_PATH("apps"),
     };
 
@@ -159,6 +171,9 @@ static int32_t loader_applications_thread(void* p) {
         }
     }
 
+    // nothing is going to be started from here
+    loader_preload_hint(app->loader, NULL);
+
     // stop loading animation
     view_holder_set_view(app->view_holder, NULL);
 
@@ -5,12 +5,14 @@
 #include "loader.h"
 #include "loader_menu.h"
 #include "loader_applications.h"
+#include "loader_preload.h"
 
 typedef struct {
     char* args;
     FuriThread* thread;
     bool insomniac;
     FlipperApplication* fap;
+    MemmgrArena* arena;
 } LoaderAppData;
 
 struct Loader {
@@ -18,6 +20,7 @@ struct Loader {
     FuriMessageQueue* queue;
     LoaderMenu* loader_menu;
     LoaderApplications* loader_applications;
+    LoaderPreload* preload;
     LoaderAppData app;
 };
 
@@ -0,0 +1,246 @@
+#include "loader_preload.h"
+#include <storage/storage.h>
+#include <loader/firmware_api/firmware_api.h>
+
+#define TAG "LoaderPreload"
+
+/** Time the cursor has to stay on an application before it is preloaded */
+#define LOADER_PRELOAD_DWELL_MS (400U)
+/** Free heap required to start a preload */
+#define LOADER_PRELOAD_HEAP_MIN (64U * 1024U)
+/** Preloaded application is dropped if less heap than this is left */
+#define LOADER_PRELOAD_HEAP_RESERVE (24U * 1024U)
+
+#define LOADER_PRELOAD_FLAG_DONE (1U << 0)
+
+typedef enum {
+    LoaderPreloadStateIdle,
+    LoaderPreloadStateLoading,
+    LoaderPreloadStateReady,
+} LoaderPreloadState;
+
+struct LoaderPreload {
+    FuriMutex* mutex;
+    FuriEventFlag* event;
+    FuriTimer* timer;
+    FuriWorkQueue* work_queue;
+
+    LoaderPreloadState state;
+    bool busy;
+    bool rerun;
+    FuriString* hint;
+
+    FuriString* path;
+    uint32_t timestamp;
+    FlipperApplication* fap;
+};
+
+static bool loader_preload_is_fap(const char* path) {
+    const size_t length = strlen(path);
+    const size_t ext_length = strlen(".fap");
+    return length > ext_length && strcmp(path + length - ext_length, ".fap") == 0;
+}
+
+// Must be called with mutex held and slot not loading, returned app is freed by caller
+static FlipperApplication* loader_preload_release(LoaderPreload* preload) {
+    FlipperApplication* fap = preload->fap;
+    preload->fap = NULL;
+    preload->state = LoaderPreloadStateIdle;
+    furi_string_reset(preload->path);
+    return fap;
+}
+
+static FlipperApplication* loader_preload_load(const char* path, uint32_t* timestamp) {
+    if(memmgr_get_free_heap() < LOADER_PRELOAD_HEAP_MIN) {
+        FURI_LOG_D(TAG, "Not enough memory to preload %s", path);
+        return NULL;
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperApplication* fap = flipper_application_alloc(storage, firmware_api_interface);
+    const uint32_t start = furi_get_tick();
+    bool loaded = false;
+
+    // Errors are not reported here, launch will load the app again and show them
+    do {
+        if(storage_common_timestamp(storage, path, timestamp) != FSE_OK) break;
+        if(flipper_application_preload(fap, path) != FlipperApplicationPreloadStatusSuccess)
+            break;
+        if(flipper_application_map_to_memory(fap) != FlipperApplicationLoadStatusSuccess) break;
+        if(flipper_application_is_plugin(fap)) break;
+        if(memmgr_get_free_heap() < LOADER_PRELOAD_HEAP_RESERVE) break;
+        loaded = true;
+    } while(false);
+
+    if(loaded) {
+        FURI_LOG_I(TAG, "Preloaded %s in %lums", path, furi_get_tick() - start);
+    } else {
+        flipper_application_free(fap);
+        fap = NULL;
+    }
+
+    furi_record_close(RECORD_STORAGE);
+    return fap;
+}
+
+static void loader_preload_job(FuriWorkQueueJobId job_id, void* context) {
+    UNUSED(job_id);
+    LoaderPreload* preload = context;
+    FuriString* path = furi_string_alloc();
+
+    while(true) {
+        FlipperApplication* stale = NULL;
+
+        furi_check(furi_mutex_acquire(preload->mutex, FuriWaitForever) == FuriStatusOk);
+        // Cleared under the same lock as rerun is checked, so no request is lost
+        if(!preload->rerun) {
+            preload->busy = false;
+            furi_mutex_release(preload->mutex);
+            break;
+        }
+        preload->rerun = false;
+
+        const bool low_memory = memmgr_get_free_heap() < LOADER_PRELOAD_HEAP_RESERVE;
+        const bool hit = !furi_string_empty(preload->hint) &&
+                         furi_string_equal(preload->hint, preload->path);
+        if(preload->state == LoaderPreloadStateReady && (low_memory || !hit)) {
+            stale = loader_preload_release(preload);
+        }
+
+        const bool load = preload->state == LoaderPreloadStateIdle &&
+                          !furi_string_empty(preload->hint) && !low_memory;
+        if(load) {
+            preload->state = LoaderPreloadStateLoading;
+            furi_string_set(preload->path, preload->hint);
+            furi_string_set(path, preload->hint);
+        }
+        furi_mutex_release(preload->mutex);
+
+        if(stale) {
+            FURI_LOG_D(TAG, low_memory ? "Dropped on low memory" : "Dropped");
+            flipper_application_free(stale);
+        }
+
+        if(!load) continue;
+
+        uint32_t timestamp = 0;
+        FlipperApplication* fap = loader_preload_load(furi_string_get_cstr(path), &timestamp);
+
+        furi_check(furi_mutex_acquire(preload->mutex, FuriWaitForever) == FuriStatusOk);
+        // Cursor moved away while loading: the timer will ask for the new one
+        if(fap && furi_string_equal(preload->hint, preload->path)) {
+            preload->state = LoaderPreloadStateReady;
+            preload->timestamp = timestamp;
+            preload->fap = fap;
+            fap = NULL;
+        } else {
+            preload->state = LoaderPreloadStateIdle;
+            furi_string_reset(preload->path);
+        }
+        furi_mutex_release(preload->mutex);
+        furi_event_flag_set(preload->event, LOADER_PRELOAD_FLAG_DONE);
+
+        if(fap) flipper_application_free(fap);
+    }
+
+    furi_string_free(path);
+}
+
+static void loader_preload_schedule(LoaderPreload* preload) {
+    bool submit = false;
+
+    furi_check(furi_mutex_acquire(preload->mutex, FuriWaitForever) == FuriStatusOk);
+    preload->rerun = true;
+    if(!preload->busy) {
+        preload->busy = true;
+        submit = true;
+    }
+    furi_mutex_release(preload->mutex);
+
+    if(submit) {
+        furi_work_queue_submit(
+            preload->work_queue, FuriWorkQueuePriorityLow, loader_preload_job, NULL, preload);
+    }
+}
+
+static void loader_preload_timer_callback(void* context) {
+    loader_preload_schedule(context);
+}
+
+LoaderPreload* loader_preload_alloc(void) {
+    LoaderPreload* preload = malloc(sizeof(LoaderPreload));
+    preload->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    preload->event = furi_event_flag_alloc();
+    preload->timer =
+        furi_timer_alloc(loader_preload_timer_callback, FuriTimerTypeOnce, preload);
+    preload->work_queue = furi_work_queue_alloc(NULL);
+    preload->state = LoaderPreloadStateIdle;
+    preload->busy = false;
+    preload->rerun = false;
+    preload->hint = furi_string_alloc();
+    preload->path = furi_string_alloc();
+    preload->timestamp = 0;
+    preload->fap = NULL;
+    return preload;
+}
+
+void loader_preload_set(LoaderPreload* preload, const char* path) {
+    furi_check(preload);
+
+    if(path && !loader_preload_is_fap(path)) {
+        path = NULL;
+    }
+
+    furi_check(furi_mutex_acquire(preload->mutex, FuriWaitForever) == FuriStatusOk);
+    if(path) {
+        furi_string_set(preload->hint, path);
+    } else {
+        furi_string_reset(preload->hint);
+    }
+    furi_mutex_release(preload->mutex);
+
+    // Timer is driven outside of the lock: its callback takes it too
+    if(path) {
+        furi_timer_start(preload->timer, furi_ms_to_ticks(LOADER_PRELOAD_DWELL_MS));
+    } else {
+        furi_timer_stop(preload->timer);
+        loader_preload_schedule(preload);
+    }
+}
+
+FlipperApplication* loader_preload_take(LoaderPreload* preload, const char* path) {
+    furi_check(preload);
+
+    furi_check(furi_mutex_acquire(preload->mutex, FuriWaitForever) == FuriStatusOk);
+    while(preload->state == LoaderPreloadStateLoading) {
+        furi_event_flag_clear(preload->event, LOADER_PRELOAD_FLAG_DONE);
+        furi_mutex_release(preload->mutex);
+        furi_event_flag_wait(
+            preload->event, LOADER_PRELOAD_FLAG_DONE, FuriFlagWaitAny, FuriWaitForever);
+        furi_check(furi_mutex_acquire(preload->mutex, FuriWaitForever) == FuriStatusOk);
+    }
+
+    // Nothing is loaded after this point until the next hint
+    furi_string_reset(preload->hint);
+    const bool hit = path && furi_string_equal(preload->path, path);
+    const uint32_t timestamp = preload->timestamp;
+    FlipperApplication* fap = loader_preload_release(preload);
+    furi_mutex_release(preload->mutex);
+
+    if(fap && hit) {
+        // File was replaced since it was preloaded
+        uint32_t current = 0;
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        if(storage_common_timestamp(storage, path, &current) != FSE_OK || current != timestamp) {
+            FURI_LOG_W(TAG, "%s changed after preload", path);
+            flipper_application_free(fap);
+            fap = NULL;
+        }
+        furi_record_close(RECORD_STORAGE);
+    } else if(fap) {
+        flipper_application_free(fap);
+        fap = NULL;
+    }
+
+    return fap;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <furi.h>
+#include <flipper_application/flipper_application.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct LoaderPreload LoaderPreload;
+
+LoaderPreload* loader_preload_alloc(void);
+
+/** Set application under the cursor, NULL releases everything
+ *
+ * Safe to call from any thread, never blocks on the load itself.
+ */
+void loader_preload_set(LoaderPreload* preload, const char* path);
+
+/** Get preloaded application
+ *
+ * Waits for the load in progress. Anything else that was preloaded is freed, so
+ * this must be called before any application start, with NULL path for those
+ * that are not FAPs.
+ *
+ * @return     mapped application for path, ownership is passed to the caller, or
+ *             NULL if it has to be loaded from scratch
+ */
+FlipperApplication* loader_preload_take(LoaderPreload* preload, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,7 @@
 #include <gui/gui_i.h>
 #include <u8g2_glue.h>
 #include <lib/toolbox/float_tools.h>
+#include <lib/toolbox/flash_kv.h>
 #include "notification.h"
 #include "notification_messages.h"
 #include "notification_app.h"
@@ -189,25 +190,55 @@ static void notification_display_timer(void* ctx) {
 }
 
 // message processing
-static void notification_process_notification_message(
-    NotificationApp* app,
-    NotificationAppMessage* message) {
-    uint32_t notification_message_index = 0;
-    bool force_volume = false;
-    bool force_vibro = false;
-    const NotificationMessage* notification_message;
-    notification_message = (*message->sequence)[notification_message_index];
+static void notification_playback_schedule(NotificationPlayback* playback, uint32_t delay_ms) {
+    playback->deadline += furi_ms_to_ticks(delay_ms);
+}
+
+static void notification_playback_apply_leds(NotificationApp* app) {
+    NotificationPlayback* playback = &app->playback;
 
-    bool led_active = false;
-    uint8_t led_values[NOTIFICATION_LED_COUNT] = {0x00, 0x00, 0x00};
-    bool reset_notifications = true;
-    float speaker_volume_setting = app->settings.speaker_volume;
-    bool vibro_setting = app->settings.vibro_on;
-    float display_brightness_setting = app->settings.display_brightness;
+    playback->led_active = false;
+
+    notification_apply_notification_leds(app, playback->led_values);
+    playback->reset_mask |= reset_red_mask;
+    playback->reset_mask |= reset_green_mask;
+    playback->reset_mask |= reset_blue_mask;
+}
+
+static void notification_playback_finish(NotificationApp* app) {
+    NotificationPlayback* playback = &app->playback;
+
+    if(playback->reset_notifications) {
+        notification_reset_notification_layer(
+            app, playback->reset_mask, playback->display_brightness_setting);
+    }
+
+    playback->active = false;
+    if(playback->message.back_event != NULL) {
+        furi_event_flag_set(playback->message.back_event, NOTIFICATION_EVENT_COMPLETE);
+    }
+}
 
-    uint8_t reset_mask = 0;
+// runs messages up to the next delay, or to the end of the sequence
+static void notification_playback_run(NotificationApp* app) {
+    NotificationPlayback* playback = &app->playback;
+
+    if(playback->stage == NotificationPlaybackStageFinish) {
+        notification_playback_finish(app);
+        return;
+    } else if(playback->stage == NotificationPlaybackStageLedRestore) {
+        playback->stage = NotificationPlaybackStageRun;
+        notification_playback_apply_leds(app);
+        notification_playback_schedule(playback, playback->delay);
+        return;
+    }
+
+    const NotificationMessage* notification_message;
+    notification_message = (*playback->message.sequence)[playback->index];
 
     while(notification_message != NULL) {
+        playback->index++;
+
         switch(notification_message->type) {
         case NotificationMessageTypeLedDisplayBacklight:
             // if on - switch on and start timer
@@ -216,10 +247,10 @@ static void notification_process_notification_message(
             if(notification_message->data.led.value > 0x00) {
                 notification_apply_notification_led_layer(
                     &app->display,
-                    notification_message->data.led.value * display_brightness_setting);
-                reset_mask |= reset_display_mask;
+                    notification_message->data.led.value * playback->display_brightness_setting);
+                playback->reset_mask |= reset_display_mask;
             } else {
-                reset_mask &= ~reset_display_mask;
+                playback->reset_mask &= ~reset_display_mask;
                 notification_reset_notification_led_layer(&app->display);
                 if(furi_timer_is_running(app->display_timer)) {
                     furi_timer_stop(app->display_timer);
@@ -232,7 +263,7 @@ static void notification_process_notification_message(
             if(app->display_led_lock == 1) {
                 notification_apply_internal_led_layer(
                     &app->display,
-                    notification_message->data.led.value * display_brightness_setting);
+                    notification_message->data.led.value * playback->display_brightness_setting);
             }
             break;
         case NotificationMessageTypeLedDisplayBacklightEnforceAuto:
@@ -241,7 +272,8 @@ static void notification_process_notification_message(
                 if(app->display_led_lock == 0) {
                     notification_apply_internal_led_layer(
                         &app->display,
-                        notification_message->data.led.value * display_brightness_setting);
+                        notification_message->data.led.value *
+                            playback->display_brightness_setting);
                 }
             } else {
                 FURI_LOG_E(TAG, "Incorrect BacklightEnforce use");
@@ -249,138 +281,158 @@ static void notification_process_notification_message(
             break;
         case NotificationMessageTypeLedRed:
             // store and send on delay or after seq
-            led_active = true;
-            led_values[0] = notification_message->data.led.value;
-            app->led[0].value_last[LayerNotification] = led_values[0];
-            reset_mask |= reset_red_mask;
+            playback->led_active = true;
+            playback->led_values[0] = notification_message->data.led.value;
+            app->led[0].value_last[LayerNotification] = playback->led_values[0];
+            playback->reset_mask |= reset_red_mask;
             break;
         case NotificationMessageTypeLedGreen:
             // store and send on delay or after seq
-            led_active = true;
-            led_values[1] = notification_message->data.led.value;
-            app->led[1].value_last[LayerNotification] = led_values[1];
-            reset_mask |= reset_green_mask;
+            playback->led_active = true;
+            playback->led_values[1] = notification_message->data.led.value;
+            app->led[1].value_last[LayerNotification] = playback->led_values[1];
+            playback->reset_mask |= reset_green_mask;
             break;
         case NotificationMessageTypeLedBlue:
             // store and send on delay or after seq
-            led_active = true;
-            led_values[2] = notification_message->data.led.value;
-            app->led[2].value_last[LayerNotification] = led_values[2];
-            reset_mask |= reset_blue_mask;
+            playback->led_active = true;
+            playback->led_values[2] = notification_message->data.led.value;
+            app->led[2].value_last[LayerNotification] = playback->led_values[2];
+            playback->reset_mask |= reset_blue_mask;
             break;
         case NotificationMessageTypeLedBlinkStart:
             // store and send on delay or after seq
-            led_active = true;
+            playback->led_active = true;
             furi_hal_light_blink_start(
                 notification_message->data.led_blink.color,
                 app->settings.led_brightness * 255,
                 notification_message->data.led_blink.on_time,
                 notification_message->data.led_blink.period);
-            reset_mask |= reset_blink_mask;
-            reset_mask |= reset_red_mask;
-            reset_mask |= reset_green_mask;
-            reset_mask |= reset_blue_mask;
+            playback->reset_mask |= reset_blink_mask;
+            playback->reset_mask |= reset_red_mask;
+            playback->reset_mask |= reset_green_mask;
+            playback->reset_mask |= reset_blue_mask;
             break;
         case NotificationMessageTypeLedBlinkColor:
-            led_active = true;
+            playback->led_active = true;
             furi_hal_light_blink_set_color(notification_message->data.led_blink.color);
             break;
         case NotificationMessageTypeLedBlinkStop:
             furi_hal_light_blink_stop();
-            reset_mask &= ~reset_blink_mask;
-            reset_mask |= reset_red_mask;
-            reset_mask |= reset_green_mask;
-            reset_mask |= reset_blue_mask;
+            playback->reset_mask &= ~reset_blink_mask;
+            playback->reset_mask |= reset_red_mask;
+            playback->reset_mask |= reset_green_mask;
+            playback->reset_mask |= reset_blue_mask;
             break;
         case NotificationMessageTypeVibro:
             if(notification_message->data.vibro.on) {
-                if(vibro_setting) notification_vibro_on(force_vibro);
+                if(playback->vibro_setting) notification_vibro_on(playback->force_vibro);
             } else {
                 notification_vibro_off();
             }
-            reset_mask |= reset_vibro_mask;
+            playback->reset_mask |= reset_vibro_mask;
             break;
         case NotificationMessageTypeSoundOn:
             notification_sound_on(
                 notification_message->data.sound.frequency,
-                notification_message->data.sound.volume * speaker_volume_setting,
-                force_volume);
-            reset_mask |= reset_sound_mask;
+                notification_message->data.sound.volume * playback->speaker_volume_setting,
+                playback->force_volume);
+            playback->reset_mask |= reset_sound_mask;
             break;
         case NotificationMessageTypeSoundOff:
             notification_sound_off();
-            reset_mask |= reset_sound_mask;
+            playback->reset_mask |= reset_sound_mask;
             break;
         case NotificationMessageTypeDelay:
-            if(led_active) {
+            if(playback->led_active) {
                 if(notification_is_any_led_layer_internal_and_not_empty(app)) {
                     notification_apply_notification_leds(app, led_off_values);
-                    furi_delay_ms(minimal_delay);
+                    playback->stage = NotificationPlaybackStageLedRestore;
+                    playback->delay = notification_message->data.delay.length;
+                    notification_playback_schedule(playback, minimal_delay);
+                    return;
                 }
 
-                led_active = false;
-
-                notification_apply_notification_leds(app, led_values);
-                reset_mask |= reset_red_mask;
-                reset_mask |= reset_green_mask;
-                reset_mask |= reset_blue_mask;
+                notification_playback_apply_leds(app);
             }
 
-            furi_delay_ms(notification_message->data.delay.length);
-            break;
+            notification_playback_schedule(playback, notification_message->data.delay.length);
+            return;
         case NotificationMessageTypeDoNotReset:
-            reset_notifications = false;
+            playback->reset_notifications = false;
             break;
         case NotificationMessageTypeForceSpeakerVolumeSetting:
-            speaker_volume_setting = notification_message->data.forced_settings.speaker_volume;
-            force_volume = true;
+            playback->speaker_volume_setting =
+                notification_message->data.forced_settings.speaker_volume;
+            playback->force_volume = true;
             break;
         case NotificationMessageTypeForceVibroSetting:
-            vibro_setting = notification_message->data.forced_settings.vibro;
-            force_vibro = true;
+            playback->vibro_setting = notification_message->data.forced_settings.vibro;
+            playback->force_vibro = true;
             break;
         case NotificationMessageTypeForceDisplayBrightnessSetting:
-            display_brightness_setting =
+            playback->display_brightness_setting =
                 notification_message->data.forced_settings.display_brightness;
             break;
         case NotificationMessageTypeLedBrightnessSettingApply:
-            led_active = true;
+            playback->led_active = true;
             for(uint8_t i = 0; i < NOTIFICATION_LED_COUNT; i++) {
-                led_values[i] = app->led[i].value_last[LayerNotification];
+                playback->led_values[i] = app->led[i].value_last[LayerNotification];
             }
-            reset_mask |= reset_red_mask;
-            reset_mask |= reset_green_mask;
-            reset_mask |= reset_blue_mask;
+            playback->reset_mask |= reset_red_mask;
+            playback->reset_mask |= reset_green_mask;
+            playback->reset_mask |= reset_blue_mask;
             break;
         case NotificationMessageTypeLcdContrastUpdate:
             notification_apply_lcd_contrast(app);
             break;
         }
-        notification_message_index++;
-        notification_message = (*message->sequence)[notification_message_index];
+        notification_message = (*playback->message.sequence)[playback->index];
     };
 
     // send and do minimal delay
-    if(led_active) {
+    if(playback->led_active) {
         bool need_minimal_delay = false;
         if(notification_is_any_led_layer_internal_and_not_empty(app)) {
             need_minimal_delay = true;
         }
 
-        notification_apply_notification_leds(app, led_values);
-        reset_mask |= reset_red_mask;
-        reset_mask |= reset_green_mask;
-        reset_mask |= reset_blue_mask;
+        notification_playback_apply_leds(app);
 
-        if((need_minimal_delay) && (reset_notifications)) {
+        if((need_minimal_delay) && (playback->reset_notifications)) {
             notification_apply_notification_leds(app, led_off_values);
-            furi_delay_ms(minimal_delay);
+            playback->stage = NotificationPlaybackStageFinish;
+            notification_playback_schedule(playback, minimal_delay);
+            return;
         }
     }
 
-    if(reset_notifications) {
-        notification_reset_notification_layer(app, reset_mask, display_brightness_setting);
-    }
+    notification_playback_finish(app);
+}
+
+static void notification_process_notification_message(
+    NotificationApp* app,
+    NotificationAppMessage* message) {
+    NotificationPlayback* playback = &app->playback;
+    furi_check(!playback->active);
+
+    playback->message = *message;
+    playback->stage = NotificationPlaybackStageRun;
+    playback->active = true;
+    playback->index = 0;
+    playback->deadline = furi_get_tick();
+
+    playback->force_volume = false;
+    playback->force_vibro = false;
+    playback->led_active = false;
+    memset(playback->led_values, 0x00, sizeof(playback->led_values));
+    playback->reset_notifications = true;
+    playback->speaker_volume_setting = app->settings.speaker_volume;
+    playback->vibro_setting = app->settings.vibro_on;
+    playback->display_brightness_setting = app->settings.display_brightness;
+    playback->reset_mask = 0;
+
+    notification_playback_run(app);
 }
 
 static void
@@ -435,9 +487,19 @@ static void
 
 static bool notification_load_settings(NotificationApp* app) {
     NotificationSettings settings;
-    File* file = storage_file_alloc(furi_record_open(RECORD_STORAGE));
     const size_t settings_size = sizeof(NotificationSettings);
 
+    // Copy in internal flash is there without waiting for SD card
+    if(flash_kv_read(NOTIFICATION_SETTINGS_PATH, &settings, settings_size) == settings_size &&
+       settings.version == NOTIFICATION_SETTINGS_VERSION) {
+        furi_kernel_lock();
+        memcpy(&app->settings, &settings, settings_size);
+        furi_kernel_unlock();
+        return true;
+    }
+
+    File* file = storage_file_alloc(furi_record_open(RECORD_STORAGE));
+
     FURI_LOG_I(TAG, "Loading \"%s\"", NOTIFICATION_SETTINGS_PATH);
     bool fs_result =
         storage_file_open(file, NOTIFICATION_SETTINGS_PATH, FSAM_READ, FSOM_OPEN_EXISTING);
@@ -458,6 +520,7 @@ static bool notification_load_settings(NotificationApp* app) {
             furi_kernel_lock();
             memcpy(&app->settings, &settings, settings_size);
             furi_kernel_unlock();
+            flash_kv_write(NOTIFICATION_SETTINGS_PATH, &settings, settings_size);
         }
     } else {
         FURI_LOG_E(TAG, "Load failed, %s", storage_file_get_error_desc(file));
@@ -481,6 +544,10 @@ static bool notification_save_settings(NotificationApp* app) {
     memcpy(&settings, &app->settings, settings_size);
     furi_kernel_unlock();
 
+    if(!flash_kv_write(NOTIFICATION_SETTINGS_PATH, &settings, settings_size)) {
+        flash_kv_remove(NOTIFICATION_SETTINGS_PATH);
+    }
+
     bool fs_result =
         storage_file_open(file, NOTIFICATION_SETTINGS_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS);
 
@@ -515,6 +582,7 @@ static void input_event_callback(const void* value, void* context) {
 static NotificationApp* notification_app_alloc(void) {
     NotificationApp* app = malloc(sizeof(NotificationApp));
     app->queue = furi_message_queue_alloc(8, sizeof(NotificationAppMessage));
+    app->pending = furi_message_queue_alloc(8, sizeof(NotificationAppMessage));
     app->display_timer = furi_timer_alloc(notification_display_timer, FuriTimerTypeOnce, app);
 
     app->settings.speaker_volume = 1.0f;
@@ -587,6 +655,55 @@ static void notification_init_settings(NotificationApp* app) {
     notification_apply_settings(app);
 }
 
+static void notification_process_message(NotificationApp* app, NotificationAppMessage* message) {
+    switch(message->type) {
+    case NotificationLayerMessage:
+        if(app->playback.active) {
+            // played in order once the current sequence is over
+            furi_check(furi_message_queue_put(app->pending, message, 0) == FuriStatusOk);
+        } else {
+            notification_process_notification_message(app, message);
+        }
+        // completion is reported by the playback
+        return;
+    case InternalLayerMessage:
+        notification_process_internal_message(app, message);
+        break;
+    case SaveSettingsMessage:
+        notification_save_settings(app);
+        break;
+    case LoadSettingsMessage:
+        notification_load_settings(app);
+        break;
+    }
+
+    if(message->back_event != NULL) {
+        furi_event_flag_set(message->back_event, NOTIFICATION_EVENT_COMPLETE);
+    }
+}
+
+static bool notification_get_message(NotificationApp* app, NotificationAppMessage* message) {
+    if(!app->playback.active) {
+        if(furi_message_queue_get(app->pending, message, 0) == FuriStatusOk) {
+            return true;
+        }
+        furi_check(furi_message_queue_get(app->queue, message, FuriWaitForever) == FuriStatusOk);
+        return true;
+    }
+
+    const int32_t timeout = app->playback.deadline - furi_get_tick();
+    const uint32_t ticks = (timeout > 0) ? (uint32_t)timeout : 0;
+
+    if(furi_message_queue_get_count(app->pending) ==
+       furi_message_queue_get_capacity(app->pending)) {
+        // no room to defer notifications, leave them in the queue
+        furi_delay_tick(ticks);
+        return false;
+    }
+
+    return furi_message_queue_get(app->queue, message, ticks) == FuriStatusOk;
+}
+
 // App
 int32_t notification_srv(void* p) {
     UNUSED(p);
@@ -605,25 +722,12 @@ int32_t notification_srv(void* p) {
 
     NotificationAppMessage message;
     while(1) {
-        furi_check(furi_message_queue_get(app->queue, &message, FuriWaitForever) == FuriStatusOk);
-
-        switch(message.type) {
-        case NotificationLayerMessage:
-            notification_process_notification_message(app, &message);
-            break;
-        case InternalLayerMessage:
-            notification_process_internal_message(app, &message);
-            break;
-        case SaveSettingsMessage:
-            notification_save_settings(app);
-            break;
-        case LoadSettingsMessage:
-            notification_load_settings(app);
-            break;
+        if(notification_get_message(app, &message)) {
+            notification_process_message(app, &message);
         }
 
-        if(message.back_event != NULL) {
-            furi_event_flag_set(message.back_event, NOTIFICATION_EVENT_COMPLETE);
+        if(app->playback.active && (int32_t)(furi_get_tick() - app->playback.deadline) >= 0) {
+            notification_playback_run(app);
         }
     }
 
@@ -46,6 +46,37 @@ typedef struct {
     bool vibro_on;
 } NotificationSettings;
 
+typedef enum {
+    NotificationPlaybackStageRun, /**< Interpreting messages */
+    NotificationPlaybackStageLedRestore, /**< LEDs blanked, values go out at the deadline */
+    NotificationPlaybackStageFinish, /**< Sequence done, layer reset at the deadline */
+} NotificationPlaybackStage;
+
+/** Notification layer sequence being played
+ *
+ * Delays are not slept in place: the step sets an absolute deadline and the
+ * service thread keeps serving its queue until then. Deadlines add up from the
+ * sequence start, so time spent driving the hardware does not accumulate.
+ */
+typedef struct {
+    NotificationAppMessage message;
+    NotificationPlaybackStage stage;
+    bool active;
+    uint32_t index;
+    uint32_t deadline;
+    uint32_t delay;
+
+    bool force_volume;
+    bool force_vibro;
+    bool led_active;
+    uint8_t led_values[NOTIFICATION_LED_COUNT];
+    bool reset_notifications;
+    float speaker_volume_setting;
+    bool vibro_setting;
+    float display_brightness_setting;
+    uint8_t reset_mask;
+} NotificationPlayback;
+
 struct NotificationApp {
     FuriMessageQueue* queue;
     FuriPubSub* event_record;
@@ -56,6 +87,9 @@ struct NotificationApp {
     uint8_t display_led_lock;
 
     NotificationSettings settings;
+
+    NotificationPlayback playback;
+    FuriMessageQueue* pending;
 };
 
 void notification_message_save_settings(NotificationApp* app);
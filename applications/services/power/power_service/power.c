@@ -4,6 +4,7 @@
 #include <furi_hal.h>
 
 #include <update_util/update_operation.h>
+#include <toolbox/saved_struct.h>
 #include <notification/notification_messages.h>
 
 #define TAG "Power"
@@ -168,6 +169,8 @@ static void power_check_battery_level_change(Power* power) {
 }
 
 static void power_handle_shutdown(Power* power) {
+    // Settings are written behind, write them before SD cache is flushed
+    saved_struct_flush();
     furi_hal_power_off();
     // Notify user if USB is plugged
     view_holder_send_to_front(power->view_holder);
@@ -188,6 +191,9 @@ static void power_handle_reboot(PowerBootMode mode) {
         furi_crash();
     }
 
+    // Don't lose data held by saved_struct queue and SD write back cache
+    saved_struct_flush();
+    furi_hal_sd_flush();
     furi_hal_power_reset();
 }
 
@@ -21,10 +21,22 @@
 typedef enum {
     RpcEvtNewData = (1 << 0),
     RpcEvtDisconnect = (1 << 1),
+    RpcEvtBackgroundDone = (1 << 2),
 } RpcEvtFlags;
 
 #define RPC_ALL_EVENTS (RpcEvtNewData | RpcEvtDisconnect)
 
+/* Outgoing messages are encoded in place into this buffer and passed
+ * to transport every time it's full, no per-message heap allocations */
+#define RPC_SEND_BUFFER_SIZE (1024)
+
+/* Background handlers run on their own thread so long storage operations
+ * don't hold up the rest of the session. Decoded messages cycle through
+ * a small pool: one being decoded, one queued and one in the worker */
+#define RPC_BACKGROUND_QUEUE_SIZE (1)
+#define RPC_MESSAGE_POOL_SIZE     (RPC_BACKGROUND_QUEUE_SIZE + 2)
+#define RPC_SESSION_WORKER_STACK  (3072)
+
 DICT_DEF2(RpcHandlerDict, pb_size_t, M_DEFAULT_OPLIST, RpcHandler, M_POD_OPLIST)
 
 typedef struct {
@@ -71,12 +83,17 @@ struct RpcSession {
 
     RpcHandlerDict_t handlers;
     FuriStreamBuffer* stream;
-    PB_Main* decoded_message;
+    PB_Main* messages;
+    FuriMessageQueue* message_pool;
+    FuriThread* background_thread;
+    FuriMessageQueue* background_queue;
     bool terminate;
     void** system_contexts;
     bool decode_error;
 
     FuriMutex* callbacks_mutex;
+    uint8_t* send_buffer;
+    size_t send_buffer_used;
     RpcSendBytesCallback send_bytes_callback;
     RpcBufferIsEmptyCallback buffer_is_empty_callback;
     RpcSessionClosedCallback closed_callback;
@@ -87,6 +104,7 @@ struct RpcSession {
 
 struct Rpc {
     FuriMutex* busy_mutex;
+    FuriMutex* background_mutex;
 };
 
 RpcOwner rpc_session_get_owner(RpcSession* session) {
@@ -94,12 +112,22 @@ RpcOwner rpc_session_get_owner(RpcSession* session) {
     return session->owner;
 }
 
+/* Wait until every queued background message is handled, session thread only */
+static void rpc_session_background_wait(RpcSession* session) {
+    while(furi_message_queue_get_count(session->message_pool) < RPC_MESSAGE_POOL_SIZE - 1) {
+        furi_thread_flags_wait(RpcEvtBackgroundDone, FuriFlagWaitAny, FuriWaitForever);
+    }
+}
+
 static void rpc_close_session_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
 
     RpcSession* session = (RpcSession*)context;
 
+    // Responses to everything sent before stop go out first
+    rpc_session_background_wait(session);
+
     rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
     furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
     if(session->closed_callback) {
@@ -250,14 +278,48 @@ static bool rpc_pb_content_callback(pb_istream_t* stream, const pb_field_t* fiel
     return true;
 }
 
+static int32_t rpc_session_background_worker(void* context) {
+    furi_assert(context);
+    RpcSession* session = (RpcSession*)context;
+    Rpc* rpc = session->rpc;
+    PB_Main* message;
+
+    while(1) {
+        furi_check(
+            furi_message_queue_get(session->background_queue, &message, FuriWaitForever) ==
+            FuriStatusOk);
+        if(!message) break;
+
+        // Handlers are registered before session start, safe to look up from here
+        RpcHandler* handler = RpcHandlerDict_get(session->handlers, message->which_content);
+        furi_check(furi_mutex_acquire(rpc->background_mutex, FuriWaitForever) == FuriStatusOk);
+        handler->message_handler(message, handler->context);
+        furi_check(furi_mutex_release(rpc->background_mutex) == FuriStatusOk);
+
+        // Released by session thread on reuse, so decoder allocations stay on one thread
+        furi_check(furi_message_queue_put(session->message_pool, &message, 0) == FuriStatusOk);
+        furi_thread_flags_set(furi_thread_get_id(session->thread), RpcEvtBackgroundDone);
+    }
+
+    return 0;
+}
+
 static int32_t rpc_session_worker(void* context) {
     furi_assert(context);
     RpcSession* session = (RpcSession*)context;
     Rpc* rpc = session->rpc;
+    PB_Main* message;
 
     FURI_LOG_D(TAG, "Session started");
 
+    furi_thread_start(session->background_thread);
+
     while(1) {
+        furi_check(
+            furi_message_queue_get(session->message_pool, &message, FuriWaitForever) ==
+            FuriStatusOk);
+        pb_release(&PB_Main_msg, message);
+
         pb_istream_t istream = {
             .callback = rpc_pb_stream_read,
             .state = session,
@@ -267,19 +329,24 @@ static int32_t rpc_session_worker(void* context) {
 
         bool message_decode_failed = false;
 
-        if(pb_decode_ex(&istream, &PB_Main_msg, session->decoded_message, PB_DECODE_DELIMITED)) {
+        if(pb_decode_ex(&istream, &PB_Main_msg, message, PB_DECODE_DELIMITED)) {
 #ifdef SRV_RPC_DEBUG
             FURI_LOG_I(TAG, "INPUT:");
-            rpc_debug_print_message(session->decoded_message);
+            rpc_debug_print_message(message);
 #endif
-            RpcHandler* handler =
-                RpcHandlerDict_get(session->handlers, session->decoded_message->which_content);
-
-            if(handler && handler->message_handler) {
+            RpcHandler* handler = RpcHandlerDict_get(session->handlers, message->which_content);
+
+            if(handler && handler->message_handler && handler->background) {
+                // Blocks when background lane is full, throttling the host
+                furi_check(
+                    furi_message_queue_put(session->background_queue, &message, FuriWaitForever) ==
+                    FuriStatusOk);
+                message = NULL;
+            } else if(handler && handler->message_handler) {
                 furi_check(furi_mutex_acquire(rpc->busy_mutex, FuriWaitForever) == FuriStatusOk);
-                handler->message_handler(session->decoded_message, handler->context);
+                handler->message_handler(message, handler->context);
                 furi_check(furi_mutex_release(rpc->busy_mutex) == FuriStatusOk);
-            } else if(session->decoded_message->which_content == 0) {
+            } else if(message->which_content == 0) {
                 /* Receiving zeroes means message is 0-length, which
                  * is valid for proto3: all fields are filled with default values.
                  * 0 - is default value for which_content field.
@@ -289,13 +356,9 @@ static int32_t rpc_session_worker(void* context) {
                 message_decode_failed = true;
             } else if(!handler && !session->terminate) {
                 FURI_LOG_E(
-                    TAG,
-                    "Message(%d) decoded, but not implemented",
-                    session->decoded_message->which_content);
+                    TAG, "Message(%d) decoded, but not implemented", message->which_content);
                 rpc_send_and_release_empty(
-                    session,
-                    session->decoded_message->command_id,
-                    PB_CommandStatus_ERROR_NOT_IMPLEMENTED);
+                    session, message->command_id, PB_CommandStatus_ERROR_NOT_IMPLEMENTED);
             }
         } else {
             message_decode_failed = true;
@@ -336,7 +399,9 @@ static int32_t rpc_session_worker(void* context) {
             }
         }
 
-        pb_release(&PB_Main_msg, session->decoded_message);
+        if(message) {
+            furi_check(furi_message_queue_put(session->message_pool, &message, 0) == FuriStatusOk);
+        }
 
         if(session->terminate) {
             FURI_LOG_D(TAG, "Session terminated");
@@ -344,6 +409,12 @@ static int32_t rpc_session_worker(void* context) {
         }
     }
 
+    message = NULL;
+    furi_check(
+        furi_message_queue_put(session->background_queue, &message, FuriWaitForever) ==
+        FuriStatusOk);
+    furi_thread_join(session->background_thread);
+
     return 0;
 }
 
@@ -357,7 +428,14 @@ static void rpc_session_thread_pending_callback(void* context, uint32_t arg) {
         }
     }
     free(session->system_contexts);
-    free(session->decoded_message);
+    for(size_t i = 0; i < RPC_MESSAGE_POOL_SIZE; i++) {
+        pb_release(&PB_Main_msg, &session->messages[i]);
+    }
+    free(session->messages);
+    furi_message_queue_free(session->message_pool);
+    furi_message_queue_free(session->background_queue);
+    furi_thread_free(session->background_thread);
+    free(session->send_buffer);
     RpcHandlerDict_clear(session->handlers);
     furi_stream_buffer_free(session->stream);
 
@@ -386,6 +464,7 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
 
     RpcSession* session = malloc(sizeof(RpcSession));
     session->callbacks_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    session->send_buffer = malloc(RPC_SEND_BUFFER_SIZE);
     session->stream = furi_stream_buffer_alloc(RPC_BUFFER_SIZE, 1);
     session->rpc = rpc;
     session->terminate = false;
@@ -393,9 +472,16 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
     session->owner = owner;
     RpcHandlerDict_init(session->handlers);
 
-    session->decoded_message = malloc(sizeof(PB_Main));
-    session->decoded_message->cb_content.funcs.decode = rpc_pb_content_callback;
-    session->decoded_message->cb_content.arg = session;
+    session->messages = malloc(sizeof(PB_Main) * RPC_MESSAGE_POOL_SIZE);
+    session->message_pool = furi_message_queue_alloc(RPC_MESSAGE_POOL_SIZE, sizeof(PB_Main*));
+    for(size_t i = 0; i < RPC_MESSAGE_POOL_SIZE; i++) {
+        PB_Main* message = &session->messages[i];
+        message->cb_content.funcs.decode = rpc_pb_content_callback;
+        message->cb_content.arg = session;
+        furi_check(furi_message_queue_put(session->message_pool, &message, 0) == FuriStatusOk);
+    }
+    session->background_queue =
+        furi_message_queue_alloc(RPC_BACKGROUND_QUEUE_SIZE, sizeof(PB_Main*));
 
     session->system_contexts = malloc(COUNT_OF(rpc_systems) * sizeof(void*));
     for(size_t i = 0; i < COUNT_OF(rpc_systems); ++i) {
@@ -409,11 +495,17 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
     };
     rpc_add_handler(session, PB_Main_stop_session_tag, &rpc_handler);
 
-    session->thread = furi_thread_alloc_ex("RpcSessionWorker", 3072, rpc_session_worker, session);
+    session->thread = furi_thread_alloc_ex(
+        "RpcSessionWorker", RPC_SESSION_WORKER_STACK, rpc_session_worker, session);
+    // Decoded messages are built from short lived slab objects
+    furi_thread_enable_slab_cache(session->thread);
 
     furi_thread_set_state_context(session->thread, session);
     furi_thread_set_state_callback(session->thread, rpc_session_thread_state_callback);
 
+    session->background_thread = furi_thread_alloc_ex(
+        "RpcSessionBgWorker", RPC_SESSION_WORKER_STACK, rpc_session_background_worker, session);
+
     furi_thread_start(session->thread);
 
     return session;
@@ -434,6 +526,7 @@ void rpc_on_system_start(void* p) {
     Rpc* rpc = malloc(sizeof(Rpc));
 
     rpc->busy_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    rpc->background_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
 
     Cli* cli = furi_record_open(RECORD_CLI);
     cli_add_command(
@@ -448,36 +541,64 @@ void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* han
     RpcHandlerDict_set_at(session->handlers, message_tag, *handler);
 }
 
+/* Must be called with callbacks_mutex taken */
+static void rpc_send_buffer_flush(RpcSession* session) {
+    if(session->send_buffer_used == 0) return;
+
+#ifdef SRV_RPC_DEBUG
+    rpc_debug_print_data("OUTPUT", session->send_buffer, session->send_buffer_used);
+#endif
+
+    if(session->send_bytes_callback) {
+        session->send_bytes_callback(
+            session->context, session->send_buffer, session->send_buffer_used);
+    }
+
+    session->send_buffer_used = 0;
+}
+
+static bool rpc_pb_stream_write(pb_ostream_t* ostream, const pb_byte_t* buf, size_t count) {
+    RpcSession* session = ostream->state;
+
+    while(count) {
+        size_t chunk_size = MIN(count, RPC_SEND_BUFFER_SIZE - session->send_buffer_used);
+        memcpy(&session->send_buffer[session->send_buffer_used], buf, chunk_size);
+        session->send_buffer_used += chunk_size;
+        buf += chunk_size;
+        count -= chunk_size;
+
+        if(session->send_buffer_used == RPC_SEND_BUFFER_SIZE) {
+            rpc_send_buffer_flush(session);
+        }
+    }
+
+    return true;
+}
+
 void rpc_send(RpcSession* session, PB_Main* message) {
     furi_assert(session);
     furi_assert(message);
 
-    pb_ostream_t ostream = PB_OSTREAM_SIZING;
-
 #ifdef SRV_RPC_DEBUG
     FURI_LOG_I(TAG, "OUTPUT:");
     rpc_debug_print_message(message);
 #endif
 
-    bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
-    furi_check(result && ostream.bytes_written);
-
-    uint8_t* buffer = malloc(ostream.bytes_written);
-    ostream = pb_ostream_from_buffer(buffer, ostream.bytes_written);
+    pb_ostream_t ostream = {
+        .callback = rpc_pb_stream_write,
+        .state = session,
+        .max_size = SIZE_MAX,
+        .bytes_written = 0,
+    };
 
-    pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+    // Whole message goes out under the lock, so messages from different threads don't mix
+    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
 
-#ifdef SRV_RPC_DEBUG
-    rpc_debug_print_data("OUTPUT", buffer, ostream.bytes_written);
-#endif
+    bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+    furi_check(result && ostream.bytes_written);
+    rpc_send_buffer_flush(session);
 
-    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
-    if(session->send_bytes_callback) {
-        session->send_bytes_callback(session->context, buffer, ostream.bytes_written);
-    }
     furi_mutex_release(session->callbacks_mutex);
-
-    free(buffer);
 }
 
 void rpc_send_and_release(RpcSession* session, PB_Main* message) {
@@ -11,7 +11,7 @@ typedef struct {
     FuriSemaphore* terminate_semaphore;
 } CliRpc;
 
-#define CLI_READ_BUFFER_SIZE 64
+#define CLI_READ_BUFFER_SIZE 512
 
 static void rpc_cli_send_bytes_callback(void* context, uint8_t* bytes, size_t bytes_len) {
     furi_assert(context);
@@ -64,7 +64,7 @@ void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
     size_t size_received = 0;
 
     while(1) {
-        size_received = cli_read_timeout(cli_rpc.cli, buffer, CLI_READ_BUFFER_SIZE, 50);
+        size_received = cli_read_available(cli_rpc.cli, buffer, CLI_READ_BUFFER_SIZE, 50);
         if(!cli_is_connected(cli_rpc.cli) || cli_rpc.session_close_request) {
             break;
         }
@@ -51,6 +51,9 @@ typedef enum {
 
 #define RPC_GUI_INPUT_RESET (0u)
 
+// BLE link is saturated by full speed stream, making control laggy
+#define RPC_GUI_FRAME_INTERVAL_BLE_MS (100u)
+
 typedef struct {
     RpcSession* session;
     Gui* gui;
@@ -64,6 +67,10 @@ typedef struct {
     // Transmit
     PB_Main* transmit_frame;
     FuriThread* transmit_thread;
+    uint32_t transmit_interval;
+    bool transmit_busy; // Frame is being sent or waits for rate limit, guarded by critical section
+    bool transmit_skipped; // Frame came while busy, redraw is requested once done
+    bool transmit_sent;
 
     bool virtual_display_not_empty;
     bool is_streaming;
@@ -90,14 +97,33 @@ static void rpc_system_gui_screen_stream_frame_callback(
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
-    uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
+    PB_Gui_ScreenFrame* frame = &rpc_gui->transmit_frame->content.gui_screen_frame;
+    uint8_t* buffer = frame->data->bytes;
 
-    furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
+    furi_assert(size == frame->data->size);
 
-    memcpy(buffer, data, size);
-    rpc_gui->transmit_frame->content.gui_screen_frame.orientation =
+    // Transmit buffer is not touched while in flight, newer frame is redrawn later
+    bool busy;
+    FURI_CRITICAL_ENTER();
+    busy = rpc_gui->transmit_busy;
+    rpc_gui->transmit_skipped |= busy;
+    FURI_CRITICAL_EXIT();
+    if(busy) return;
+
+    const PB_Gui_ScreenOrientation pb_orientation =
         rpc_system_gui_screen_orientation_map[orientation];
 
+    // Unchanged frames are not sent again
+    if(rpc_gui->transmit_sent && frame->orientation == pb_orientation &&
+       memcmp(buffer, data, size) == 0) {
+        return;
+    }
+
+    memcpy(buffer, data, size);
+    frame->orientation = pb_orientation;
+    rpc_gui->transmit_sent = true;
+    rpc_gui->transmit_busy = true;
+
     furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
 }
 
@@ -119,7 +145,21 @@ static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context)
             // Guaranteed bandwidth reserve
             uint32_t extra_delay = transmit_time / 20;
             if(extra_delay > 500) extra_delay = 500;
+            // Frame rate cap
+            if(transmit_time + extra_delay < rpc_gui->transmit_interval) {
+                extra_delay = rpc_gui->transmit_interval - transmit_time;
+            }
             if(extra_delay) furi_delay_tick(extra_delay);
+
+            bool skipped;
+            FURI_CRITICAL_ENTER();
+            skipped = rpc_gui->transmit_skipped;
+            rpc_gui->transmit_skipped = false;
+            rpc_gui->transmit_busy = false;
+            FURI_CRITICAL_EXIT();
+
+            // Catch up with the frames dropped in the meantime
+            if(skipped) gui_update(rpc_gui->gui);
         }
 
         if(flags & RpcGuiWorkerFlagExit) {
@@ -155,6 +195,12 @@ static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, v
         rpc_gui->transmit_frame->content.gui_screen_frame.data =
             malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(framebuffer_size));
         rpc_gui->transmit_frame->content.gui_screen_frame.data->size = framebuffer_size;
+        rpc_gui->transmit_busy = false;
+        rpc_gui->transmit_skipped = false;
+        rpc_gui->transmit_sent = false;
+        rpc_gui->transmit_interval = rpc_session_get_owner(session) == RpcOwnerBle ?
+                                         furi_ms_to_ticks(RPC_GUI_FRAME_INTERVAL_BLE_MS) :
+                                         0;
         // Transmission thread for async TX
         rpc_gui->transmit_thread = furi_thread_alloc_ex(
             "GuiRpcWorker", 1024, rpc_system_gui_screen_stream_frame_transmit_thread, rpc_gui);
@@ -19,6 +19,9 @@ typedef struct {
     bool (*decode_submessage)(pb_istream_t* stream, const pb_field_t* field, void** arg);
     PBMessageHandler message_handler;
     void* context;
+    /* Long running handler: runs in order with other background handlers
+     * of the session, but doesn't hold up the rest */
+    bool background;
 } RpcHandler;
 
 void rpc_send(RpcSession* session, PB_Main* main_message);
@@ -1,11 +1,14 @@
 #include <core/common_defines.h>
 #include <core/memmgr.h>
+#include <core/message_queue.h>
 #include <core/record.h>
+#include <core/thread.h>
 #include <rpc/rpc.h>
 #include <rpc/rpc_i.h>
 #include <storage/filesystem_api_defines.h>
 #include <storage/storage.h>
-#include <lib/toolbox/md5_calc.h>
+#include <lib/toolbox/hash_calc.h>
+#include <lib/toolbox/flash_kv.h>
 #include <lib/toolbox/path.h>
 #include <update_util/int_backup.h>
 #include <toolbox/tar/tar_archive.h>
@@ -19,20 +22,221 @@
 #define MAX_NAME_LENGTH 255
 
 static const size_t MAX_DATA_SIZE = 512;
+/* Wired transport has no packet size limits, bigger chunks mean less per-message overhead */
+static const size_t MAX_DATA_SIZE_USB = 4096;
+
+/* Write chunks that may be decoded ahead of the storage worker */
+#define RPC_STORAGE_WRITE_WINDOW       (4)
+/* Chunk buffers: full window, one in the worker and one being filled */
+#define RPC_STORAGE_WRITE_POOL_SIZE    (RPC_STORAGE_WRITE_WINDOW + 2)
+#define RPC_STORAGE_WRITE_WORKER_STACK (1024)
+/* Tar parser and nested storage calls when the write stream is unpacked */
+#define RPC_STORAGE_EXTRACT_WORKER_STACK (3 * 1024)
 
 typedef enum {
     RpcStorageStateIdle = 0,
     RpcStorageStateWriting,
 } RpcStorageState;
 
+typedef struct {
+    uint8_t* data; // NULL stops writer
+    size_t size;
+    bool pooled; // Data is borrowed from write pool, heap otherwise
+} RpcStorageWriteChunk;
+
 typedef struct {
     RpcSession* session;
     Storage* api;
     File* file;
     RpcStorageState state;
     uint32_t current_command_id;
+
+    FuriThread* write_thread;
+    FuriMessageQueue* write_queue;
+    // Chunk buffers taken once per write, not per chunk
+    uint8_t* write_pool;
+    size_t write_pool_chunk_size;
+    FuriMessageQueue* write_pool_queue;
+    bool write_thread_running;
+    volatile bool write_failed;
+
+    // Write to a directory: stream is a tar archive unpacked on the fly
+    FuriString* extract_path;
+    RpcStorageWriteChunk extract_chunk;
+    size_t extract_offset;
+    bool extract_eof;
 } RpcStorageSystem;
 
+static size_t rpc_system_storage_get_chunk_size(RpcSession* session) {
+    return rpc_session_get_owner(session) == RpcOwnerUsb ? MAX_DATA_SIZE_USB : MAX_DATA_SIZE;
+}
+
+static void rpc_system_storage_write_chunk_release(
+    RpcStorageSystem* rpc_storage,
+    RpcStorageWriteChunk* chunk) {
+    if(chunk->pooled) {
+        furi_check(
+            furi_message_queue_put(rpc_storage->write_pool_queue, &chunk->data, 0) ==
+            FuriStatusOk);
+    } else {
+        free(chunk->data);
+    }
+    chunk->data = NULL;
+}
+
+/* Tar stream source, pulls chunks queued by the session thread */
+static int32_t rpc_system_storage_extract_read(void* context, uint8_t* buffer, size_t size) {
+    RpcStorageSystem* rpc_storage = context;
+    RpcStorageWriteChunk* chunk = &rpc_storage->extract_chunk;
+    size_t done = 0;
+
+    while(done < size && !rpc_storage->extract_eof) {
+        if(rpc_storage->extract_offset == chunk->size) {
+            rpc_system_storage_write_chunk_release(rpc_storage, chunk);
+            furi_check(
+                furi_message_queue_get(rpc_storage->write_queue, chunk, FuriWaitForever) ==
+                FuriStatusOk);
+            rpc_storage->extract_offset = 0;
+            if(!chunk->data) {
+                chunk->size = 0;
+                rpc_storage->extract_eof = true;
+                break;
+            }
+        }
+
+        const size_t copy_size = MIN(size - done, chunk->size - rpc_storage->extract_offset);
+        memcpy(buffer + done, chunk->data + rpc_storage->extract_offset, copy_size);
+        rpc_storage->extract_offset += copy_size;
+        done += copy_size;
+    }
+
+    return done;
+}
+
+static void rpc_system_storage_extract_worker(RpcStorageSystem* rpc_storage) {
+    rpc_storage->extract_chunk.data = NULL;
+    rpc_storage->extract_chunk.size = 0;
+    rpc_storage->extract_chunk.pooled = false;
+    rpc_storage->extract_offset = 0;
+    rpc_storage->extract_eof = false;
+
+    TarArchive* archive = tar_archive_alloc(rpc_storage->api);
+    rpc_storage->write_failed =
+        !tar_archive_open_stream(
+            archive, TarOpenModeRead, rpc_system_storage_extract_read, rpc_storage) ||
+        !tar_archive_unpack_to(archive, furi_string_get_cstr(rpc_storage->extract_path), NULL);
+    tar_archive_free(archive);
+
+    // Drain the rest: end of archive padding, or everything after a failure
+    uint8_t skip_buffer[64];
+    while(rpc_system_storage_extract_read(rpc_storage, skip_buffer, sizeof(skip_buffer)))
+        ;
+    rpc_system_storage_write_chunk_release(rpc_storage, &rpc_storage->extract_chunk);
+}
+
+static int32_t rpc_system_storage_write_worker(void* context) {
+    RpcStorageSystem* rpc_storage = context;
+    RpcStorageWriteChunk chunk;
+
+    if(!furi_string_empty(rpc_storage->extract_path)) {
+        rpc_system_storage_extract_worker(rpc_storage);
+        return 0;
+    }
+
+    while(true) {
+        furi_check(
+            furi_message_queue_get(rpc_storage->write_queue, &chunk, FuriWaitForever) ==
+            FuriStatusOk);
+        if(!chunk.data) break;
+
+        // Drain remaining chunks after failure, error is reported by session thread
+        if(!rpc_storage->write_failed) {
+            size_t written_size = storage_file_write(rpc_storage->file, chunk.data, chunk.size);
+            rpc_storage->write_failed = (written_size != chunk.size);
+        }
+
+        rpc_system_storage_write_chunk_release(rpc_storage, &chunk);
+    }
+
+    return 0;
+}
+
+static void rpc_system_storage_write_worker_start(RpcStorageSystem* rpc_storage) {
+    furi_assert(!rpc_storage->write_thread_running);
+
+    furi_thread_set_stack_size(
+        rpc_storage->write_thread,
+        furi_string_empty(rpc_storage->extract_path) ? RPC_STORAGE_WRITE_WORKER_STACK :
+                                                       RPC_STORAGE_EXTRACT_WORKER_STACK);
+
+    const size_t chunk_size = rpc_system_storage_get_chunk_size(rpc_storage->session);
+    rpc_storage->write_pool_chunk_size = chunk_size;
+    rpc_storage->write_pool = malloc(chunk_size * RPC_STORAGE_WRITE_POOL_SIZE);
+    for(size_t i = 0; i < RPC_STORAGE_WRITE_POOL_SIZE; i++) {
+        uint8_t* data = &rpc_storage->write_pool[chunk_size * i];
+        furi_check(
+            furi_message_queue_put(rpc_storage->write_pool_queue, &data, 0) == FuriStatusOk);
+    }
+
+    rpc_storage->write_failed = false;
+    rpc_storage->write_thread_running = true;
+    furi_thread_start(rpc_storage->write_thread);
+}
+
+static void rpc_system_storage_write_worker_push(
+    RpcStorageSystem* rpc_storage,
+    const uint8_t* data,
+    size_t size) {
+    furi_assert(rpc_storage->write_thread_running);
+
+    // Copy, decoded request is released right after handler returns
+    RpcStorageWriteChunk chunk = {
+        .data = NULL,
+        .size = size,
+        .pooled = size <= rpc_storage->write_pool_chunk_size,
+    };
+    if(chunk.pooled) {
+        // Always available: buffers in flight are bounded by the window
+        furi_check(
+            furi_message_queue_get(rpc_storage->write_pool_queue, &chunk.data, FuriWaitForever) ==
+            FuriStatusOk);
+    } else {
+        // Host is free to send bigger chunks than we do
+        chunk.data = malloc(size);
+    }
+    memcpy(chunk.data, data, size);
+
+    // Blocks when window is full, so the host is throttled by the transport
+    furi_check(
+        furi_message_queue_put(rpc_storage->write_queue, &chunk, FuriWaitForever) ==
+        FuriStatusOk);
+}
+
+/* Wait until all queued chunks are written, returns false if any of them failed */
+static bool rpc_system_storage_write_worker_stop(RpcStorageSystem* rpc_storage) {
+    if(rpc_storage->write_thread_running) {
+        RpcStorageWriteChunk chunk = {
+            .data = NULL,
+            .size = 0,
+        };
+        furi_check(
+            furi_message_queue_put(rpc_storage->write_queue, &chunk, FuriWaitForever) ==
+            FuriStatusOk);
+        furi_thread_join(rpc_storage->write_thread);
+        rpc_storage->write_thread_running = false;
+
+        // Worker is gone, every chunk buffer is back in the pool
+        furi_check(
+            furi_message_queue_get_count(rpc_storage->write_pool_queue) ==
+            RPC_STORAGE_WRITE_POOL_SIZE);
+        furi_check(furi_message_queue_reset(rpc_storage->write_pool_queue) == FuriStatusOk);
+        free(rpc_storage->write_pool);
+        rpc_storage->write_pool = NULL;
+    }
+
+    return !rpc_storage->write_failed;
+}
+
 static void rpc_system_storage_reset_state(
     RpcStorageSystem* rpc_storage,
     RpcSession* session,
@@ -49,8 +253,10 @@ static void rpc_system_storage_reset_state(
         }
 
         if(rpc_storage->state == RpcStorageStateWriting) {
+            rpc_system_storage_write_worker_stop(rpc_storage);
             storage_file_close(rpc_storage->file);
             storage_file_free(rpc_storage->file);
+            furi_string_reset(rpc_storage->extract_path);
         }
 
         rpc_storage->state = RpcStorageStateIdle;
@@ -282,7 +488,7 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     bool include_md5 = list_request->include_md5;
     FuriString* md5 = furi_string_alloc();
     FuriString* md5_path = furi_string_alloc();
-    File* file = storage_file_alloc(rpc_storage->api);
+    HashCalc* hash_calc = include_md5 ? hash_calc_alloc(rpc_storage->api) : NULL;
 
     bool finish = false;
     int i = 0;
@@ -293,52 +499,127 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
         finish = true;
     }
 
+    // One storage request per response worth of items
+    StorageDirItem* items = finish ? NULL : malloc(sizeof(StorageDirItem) * COUNT_OF(list->file));
+
     while(!finish) {
-        FileInfo fileinfo;
-        char* name = malloc(MAX_NAME_LENGTH + 1);
-        if(storage_dir_read(dir, &fileinfo, name, MAX_NAME_LENGTH)) {
-            if(rpc_system_storage_list_filter(list_request, &fileinfo, name)) {
-                if(i == COUNT_OF(list->file)) {
-                    list->file_count = i;
-                    response.has_next = true;
-                    rpc_send_and_release(session, &response);
-                    i = 0;
-                }
-                list->file[i].type = file_info_is_dir(&fileinfo) ? PB_Storage_File_FileType_DIR :
-                                                                   PB_Storage_File_FileType_FILE;
-                list->file[i].size = fileinfo.size;
-                list->file[i].data = NULL;
-                list->file[i].name = name;
-
-                if(include_md5 && !file_info_is_dir(&fileinfo)) {
-                    furi_string_printf(md5_path, "%s/%s", list_request->path, name); //-V576
-
-                    if(md5_string_calc_file(file, furi_string_get_cstr(md5_path), md5, NULL)) {
-                        char* md5sum = list->file[i].md5sum;
-                        size_t md5sum_size = sizeof(list->file[i].md5sum);
-                        snprintf(md5sum, md5sum_size, "%s", furi_string_get_cstr(md5));
-                    }
-                }
+        const size_t read_count = storage_dir_read_many(dir, items, COUNT_OF(list->file), NULL);
+        for(size_t j = 0; j < read_count; j++) {
+            const StorageDirItem* item = &items[j];
+            if(!rpc_system_storage_list_filter(list_request, &item->fileinfo, item->name)) {
+                continue;
+            }
 
-                ++i;
-            } else {
-                free(name);
+            if(i == COUNT_OF(list->file)) {
+                list->file_count = i;
+                response.has_next = true;
+                rpc_send_and_release(session, &response);
+                i = 0;
             }
-        } else {
+            const bool is_dir = file_info_is_dir(&item->fileinfo);
+            list->file[i].type = is_dir ? PB_Storage_File_FileType_DIR :
+                                          PB_Storage_File_FileType_FILE;
+            list->file[i].size = item->fileinfo.size;
+            list->file[i].data = NULL;
+            list->file[i].name = strdup(item->name);
+
+            if(include_md5 && !is_dir) {
+                furi_string_printf(md5_path, "%s/%s", list_request->path, item->name); //-V576
+
+                if(hash_calc_file_string(
+                       hash_calc, furi_string_get_cstr(md5_path), HashCalcTypeMd5, md5, NULL)) {
+                    char* md5sum = list->file[i].md5sum;
+                    size_t md5sum_size = sizeof(list->file[i].md5sum);
+                    snprintf(md5sum, md5sum_size, "%s", furi_string_get_cstr(md5));
+                }
+            }
+
+            ++i;
+        }
+
+        if(read_count < COUNT_OF(list->file)) {
             list->file_count = i;
             finish = true;
-            free(name);
         }
     }
 
+    free(items);
+
     response.has_next = false;
     rpc_send_and_release(session, &response);
 
     furi_string_free(md5);
     furi_string_free(md5_path);
+    if(hash_calc) hash_calc_free(hash_calc);
     storage_dir_close(dir);
     storage_file_free(dir);
-    storage_file_free(file);
+}
+
+typedef struct {
+    RpcSession* session;
+    PB_Main* response;
+    size_t chunk_size;
+} RpcStorageTarPacker;
+
+/* Tar stream sink, every full chunk goes out as a read response */
+static int32_t rpc_system_storage_tar_write(void* context, uint8_t* buffer, size_t size) {
+    RpcStorageTarPacker* packer = context;
+    pb_bytes_array_t* data = packer->response->content.storage_read_response.file.data;
+    size_t done = 0;
+
+    while(done < size) {
+        const size_t copy_size = MIN(size - done, packer->chunk_size - data->size);
+        memcpy(data->bytes + data->size, buffer + done, copy_size);
+        data->size += copy_size;
+        done += copy_size;
+
+        if(data->size == packer->chunk_size) {
+            packer->response->has_next = true;
+            rpc_send(packer->session, packer->response);
+            data->size = 0;
+        }
+    }
+
+    return done;
+}
+
+/* Read of a directory: directory is packed into a tar archive on the fly */
+static void rpc_system_storage_read_dir_process(
+    RpcStorageSystem* rpc_storage,
+    const PB_Main* request,
+    const char* path) {
+    RpcSession* session = rpc_storage->session;
+
+    RpcStorageTarPacker packer = {
+        .session = session,
+        .response = malloc(sizeof(PB_Main)),
+        .chunk_size = rpc_system_storage_get_chunk_size(session),
+    };
+    pb_bytes_array_t* data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(packer.chunk_size));
+    data->size = 0;
+
+    packer.response->command_id = request->command_id;
+    packer.response->which_content = PB_Main_storage_read_response_tag;
+    packer.response->command_status = PB_CommandStatus_OK;
+    packer.response->content.storage_read_response.has_file = true;
+    packer.response->content.storage_read_response.file.data = data;
+
+    TarArchive* archive = tar_archive_alloc(rpc_storage->api);
+    bool success = tar_archive_open_stream(
+                       archive, TarOpenModeWrite, rpc_system_storage_tar_write, &packer) &&
+                   tar_archive_add_dir(archive, path, "") && tar_archive_finalize(archive);
+    tar_archive_free(archive);
+
+    if(success) {
+        packer.response->has_next = false;
+        rpc_send(session, packer.response);
+    } else {
+        rpc_send_and_release_empty(
+            session, request->command_id, PB_CommandStatus_ERROR_STORAGE_INTERNAL);
+    }
+
+    free(data);
+    free(packer.response);
 }
 
 static void rpc_system_storage_read_process(const PB_Main* request, void* context) {
@@ -354,48 +635,50 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
-    /* use same message memory to send response */
-    PB_Main* response = malloc(sizeof(PB_Main));
     const char* path = request->content.storage_read_request.path;
+    if(storage_dir_exists(rpc_storage->api, path)) {
+        rpc_system_storage_read_dir_process(rpc_storage, request, path);
+        return;
+    }
+
+    /* use same message and data memory to send all chunks */
+    PB_Main* response = malloc(sizeof(PB_Main));
     File* file = storage_file_alloc(rpc_storage->api);
     bool fs_operation_success = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
 
     if(fs_operation_success) {
+        // Bulk transfer, read chunks directly from this thread
+        storage_file_lease_acquire(file);
         size_t size_left = storage_file_size(file);
+        const size_t chunk_size = rpc_system_storage_get_chunk_size(session);
+        pb_bytes_array_t* data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MIN(size_left, chunk_size)));
+
         do {
             response->command_id = request->command_id;
             response->which_content = PB_Main_storage_read_response_tag;
             response->command_status = PB_CommandStatus_OK;
+            response->content.storage_read_response.has_file = true;
+            response->content.storage_read_response.file.data = data;
 
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
+            size_t read_size = MIN(size_left, chunk_size);
             if(read_size) {
-                response->content.storage_read_response.has_file = true;
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_size));
-                uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
-                uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-
-                *read_size_msg = storage_file_read(file, buffer, read_size);
-                size_left -= *read_size_msg;
-                fs_operation_success = (*read_size_msg == read_size);
+                data->size = storage_file_read(file, data->bytes, read_size);
+                size_left -= data->size;
+                fs_operation_success = (data->size == read_size);
 
                 response->has_next = fs_operation_success && (size_left > 0);
             } else {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Warray-bounds"
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(0));
-                response->content.storage_read_response.file.data->size = 0;
-#pragma GCC diagnostic pop
-                response->content.storage_read_response.has_file = true;
+                data->size = 0;
                 response->has_next = false;
                 fs_operation_success = true;
             }
 
             if(fs_operation_success) {
-                rpc_send_and_release(session, response);
+                rpc_send(session, response);
             }
         } while((size_left != 0) && fs_operation_success);
+
+        free(data);
     }
 
     if(!fs_operation_success) {
@@ -439,8 +722,24 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
         const char* path = request->content.storage_write_request.path;
-        fs_operation_success =
-            storage_file_open(rpc_storage->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+        // Settings cached in internal flash must not shadow the written files
+        const bool int_path =
+            strncmp(path, STORAGE_INT_PATH_PREFIX, strlen(STORAGE_INT_PATH_PREFIX)) == 0;
+        if(storage_dir_exists(rpc_storage->api, path)) {
+            if(int_path) flash_kv_format();
+            // Tar archive is unpacked into the directory as it comes
+            furi_string_set(rpc_storage->extract_path, path);
+            rpc_system_storage_write_worker_start(rpc_storage);
+        } else {
+            if(int_path) flash_kv_remove(path);
+            fs_operation_success =
+                storage_file_open(rpc_storage->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+            if(fs_operation_success) {
+                // Bulk transfer, write chunks directly from the worker thread
+                storage_file_lease_acquire(rpc_storage->file);
+                rpc_system_storage_write_worker_start(rpc_storage);
+            }
+        }
     }
 
     File* file = rpc_storage->file;
@@ -452,16 +751,24 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
            request->content.storage_write_request.file.data->size) {
             uint8_t* buffer = request->content.storage_write_request.file.data->bytes;
             size_t buffer_size = request->content.storage_write_request.file.data->size;
-            size_t written_size = storage_file_write(file, buffer, buffer_size);
-            fs_operation_success = (written_size == buffer_size);
+            rpc_system_storage_write_worker_push(rpc_storage, buffer, buffer_size);
         }
 
-        send_response = !request->has_next;
+        if(request->has_next) {
+            // Report failure as soon as worker detects it
+            fs_operation_success = !rpc_storage->write_failed;
+        } else {
+            // Single acknowledgement for the whole file, after all chunks are on storage
+            fs_operation_success = rpc_system_storage_write_worker_stop(rpc_storage);
+            send_response = true;
+        }
     }
 
     PB_CommandStatus command_status = PB_CommandStatus_OK;
     if(!fs_operation_success) {
         send_response = true;
+        // Worker may still be using the file, error is only stable once it is gone
+        rpc_system_storage_write_worker_stop(rpc_storage);
         command_status = rpc_system_storage_get_file_error(file);
         if(command_status == PB_CommandStatus_OK) {
             // Report errors not handled by underlying APIs
@@ -588,11 +895,11 @@ static void rpc_system_storage_md5sum_process(const PB_Main* request, void* cont
         return;
     }
 
-    File* file = storage_file_alloc(rpc_storage->api);
+    HashCalc* hash_calc = hash_calc_alloc(rpc_storage->api);
     FuriString* md5 = furi_string_alloc();
     FS_Error file_error;
 
-    if(md5_string_calc_file(file, filename, md5, &file_error)) {
+    if(hash_calc_file_string(hash_calc, filename, HashCalcTypeMd5, md5, &file_error)) {
         PB_Main response = {
             .command_id = request->command_id,
             .command_status = PB_CommandStatus_OK,
@@ -611,7 +918,7 @@ static void rpc_system_storage_md5sum_process(const PB_Main* request, void* cont
     }
 
     furi_string_free(md5);
-    storage_file_free(file);
+    hash_calc_free(hash_calc);
 }
 
 static void rpc_system_storage_rename_process(const PB_Main* request, void* context) {
@@ -731,11 +1038,24 @@ void* rpc_system_storage_alloc(RpcSession* session) {
     rpc_storage->api = furi_record_open(RECORD_STORAGE);
     rpc_storage->session = session;
     rpc_storage->state = RpcStorageStateIdle;
+    rpc_storage->extract_path = furi_string_alloc();
+
+    rpc_storage->write_queue =
+        furi_message_queue_alloc(RPC_STORAGE_WRITE_WINDOW, sizeof(RpcStorageWriteChunk));
+    rpc_storage->write_pool_queue =
+        furi_message_queue_alloc(RPC_STORAGE_WRITE_POOL_SIZE, sizeof(uint8_t*));
+    rpc_storage->write_thread = furi_thread_alloc_ex(
+        "RpcStorageWriter",
+        RPC_STORAGE_WRITE_WORKER_STACK,
+        rpc_system_storage_write_worker,
+        rpc_storage);
 
     RpcHandler rpc_handler = {
         .message_handler = NULL,
         .decode_submessage = NULL,
         .context = rpc_storage,
+        // File transfers and listings take long, keep them off the session thread
+        .background = true,
     };
 
     rpc_handler.message_handler = rpc_system_storage_info_process;
@@ -788,6 +1108,11 @@ void rpc_system_storage_free(void* context) {
 
     rpc_system_storage_reset_state(rpc_storage, session, false);
 
+    furi_thread_free(rpc_storage->write_thread);
+    furi_message_queue_free(rpc_storage->write_queue);
+    furi_message_queue_free(rpc_storage->write_pool_queue);
+    furi_string_free(rpc_storage->extract_path);
+
     furi_record_close(RECORD_STORAGE);
     rpc_storage->api = NULL;
     free(rpc_storage);
@@ -9,6 +9,8 @@
 
 #define TAG "RpcSystem"
 
+#define RPC_SYSTEM_HEAP_INFO_CALLSITES 8
+
 typedef struct {
     RpcSession* session;
     PB_Main* response;
@@ -93,6 +95,101 @@ static void rpc_system_system_device_info_callback(
     rpc_send_and_release(ctx->session, ctx->response);
 }
 
+static void rpc_system_system_device_info_hal_callback(
+    const char* key,
+    const char* value,
+    bool last,
+    void* context) {
+    UNUSED(last);
+    // Heap info follows
+    rpc_system_system_device_info_callback(key, value, false, context);
+}
+
+static void rpc_system_heap_info_get(PropertyValueCallback out, char sep, void* context) {
+    FuriString* key = furi_string_alloc();
+    FuriString* value = furi_string_alloc();
+
+    PropertyValueContext property_context = {
+        .key = key, .value = value, .out = out, .sep = sep, .last = false, .context = context};
+
+    MemmgrHeapStats stats;
+    memmgr_heap_get_stats(&stats);
+
+    property_value_out(&property_context, "%lu", 3, "heap", "alloc", "count", stats.alloc_count);
+    property_value_out(&property_context, "%lu", 3, "heap", "free", "count", stats.free_count);
+
+    char bucket[12];
+    for(size_t i = 0; i < MEMMGR_HEAP_HISTOGRAM_SIZE; i++) {
+        if(i < MEMMGR_HEAP_HISTOGRAM_SIZE - 1) {
+            snprintf(bucket, sizeof(bucket), "%u", 8U << i);
+        } else {
+            snprintf(bucket, sizeof(bucket), "max");
+        }
+        property_value_out(
+            &property_context, "%lu", 3, "heap", "size", bucket, stats.size_histogram[i]);
+    }
+
+    property_value_out(&property_context, "%lu", 3, "heap", "latency", "p50", stats.latency_p50);
+    property_value_out(&property_context, "%lu", 3, "heap", "latency", "p90", stats.latency_p90);
+    property_value_out(&property_context, "%lu", 3, "heap", "latency", "p99", stats.latency_p99);
+    property_value_out(&property_context, "%lu", 3, "heap", "latency", "max", stats.latency_max);
+
+    MemmgrHeapCallsite* callsites =
+        malloc(sizeof(MemmgrHeapCallsite) * RPC_SYSTEM_HEAP_INFO_CALLSITES);
+    size_t count = memmgr_heap_get_callsites(callsites, RPC_SYSTEM_HEAP_INFO_CALLSITES);
+    for(size_t i = 0; i < count; i++) {
+        snprintf(bucket, sizeof(bucket), "%zu", i);
+        property_value_out(
+            &property_context,
+            "0x%08lX",
+            4,
+            "heap",
+            "callsite",
+            bucket,
+            "pc",
+            (uint32_t)callsites[i].pc);
+        property_value_out(
+            &property_context, "%lu", 4, "heap", "callsite", bucket, "count", callsites[i].count);
+        property_value_out(
+            &property_context, "%zu", 4, "heap", "callsite", bucket, "size", callsites[i].size);
+    }
+    free(callsites);
+
+    property_value_out(&property_context, "%zu", 3, "heap", "free", "size", stats.free_size);
+    property_value_out(
+        &property_context, "%zu", 3, "heap", "free", "blocks", stats.free_block_count);
+    property_value_out(&property_context, "%zu", 3, "heap", "free", "max", stats.max_free_block);
+    property_value_out(&property_context, "%u", 2, "heap", "fragmentation", stats.fragmentation);
+
+    furi_string_free(key);
+    furi_string_free(value);
+}
+
+static void rpc_system_boot_info_get(PropertyValueCallback out, char sep, void* context) {
+    FuriString* key = furi_string_alloc();
+    FuriString* value = furi_string_alloc();
+
+    PropertyValueContext property_context = {
+        .key = key, .value = value, .out = out, .sep = sep, .last = false, .context = context};
+
+    char index[12];
+    const size_t count = furi_boot_trace_get_count();
+    for(size_t i = 0; i < count; i++) {
+        FuriBootTraceRecord record;
+        if(!furi_boot_trace_get(i, &record)) continue;
+
+        snprintf(index, sizeof(index), "%zu", i);
+        property_value_out(&property_context, "%s", 3, "boot", index, "stage", record.stage);
+        property_value_out(&property_context, "%lu", 3, "boot", index, "us", record.time_us);
+    }
+
+    property_context.last = true;
+    property_value_out(&property_context, "%zu", 2, "boot", "count", count);
+
+    furi_string_free(key);
+    furi_string_free(value);
+}
+
 static void rpc_system_system_device_info_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(request->which_content == PB_Main_system_device_info_request_tag);
@@ -111,7 +208,9 @@ static void rpc_system_system_device_info_process(const PB_Main* request, void*
         .session = session,
         .response = response,
     };
-    furi_hal_info_get(rpc_system_system_device_info_callback, '_', &device_info_context);
+    furi_hal_info_get(rpc_system_system_device_info_hal_callback, '_', &device_info_context);
+    rpc_system_heap_info_get(rpc_system_system_device_info_callback, '_', &device_info_context);
+    rpc_system_boot_info_get(rpc_system_system_device_info_callback, '_', &device_info_context);
 
     free(response);
 }
@@ -0,0 +1,134 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+
+#define TAG "StackWatermarkSrv"
+
+#define STACK_WATERMARK_PATH           INT_PATH(".stack_watermark")
+#define STACK_WATERMARK_FILE_TYPE      "Flipper stack watermarks"
+#define STACK_WATERMARK_FILE_VERSION   (1U)
+#define STACK_WATERMARK_SAVE_PERIOD_MS (5UL * 60UL * 1000UL)
+
+typedef struct {
+    FuriWorkQueue* work_queue;
+    FuriTimer* timer;
+    uint32_t saved_generation;
+    volatile bool busy;
+} StackWatermark;
+
+static void stack_watermark_load(Storage* storage) {
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+    size_t count = 0;
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, STACK_WATERMARK_PATH)) break;
+
+        uint32_t version = 0;
+        if(!flipper_format_read_header(ff, temp_str, &version)) break;
+        if(furi_string_cmp_str(temp_str, STACK_WATERMARK_FILE_TYPE)) break;
+        if(version != STACK_WATERMARK_FILE_VERSION) break;
+
+        while(flipper_format_read_string(ff, "Thread", temp_str)) {
+            uint32_t stack_size, min_free;
+            if(!flipper_format_read_uint32(ff, "Stack", &stack_size, 1)) break;
+            if(!flipper_format_read_uint32(ff, "Free", &min_free, 1)) break;
+
+            furi_stack_watermark_update(furi_string_get_cstr(temp_str), stack_size, min_free);
+            count++;
+        }
+    } while(false);
+
+    furi_string_free(temp_str);
+    flipper_format_free(ff);
+
+    FURI_LOG_D(TAG, "Loaded %zu records", count);
+}
+
+static bool stack_watermark_save(Storage* storage) {
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    bool saved = false;
+
+    do {
+        if(!flipper_format_buffered_file_open_always(ff, STACK_WATERMARK_PATH)) break;
+        if(!flipper_format_write_header_cstr(
+               ff, STACK_WATERMARK_FILE_TYPE, STACK_WATERMARK_FILE_VERSION))
+            break;
+
+        bool records_saved = true;
+        const size_t count = furi_stack_watermark_get_count();
+        for(size_t i = 0; records_saved && i < count; i++) {
+            FuriStackWatermarkRecord record;
+            furi_stack_watermark_get(i, &record);
+            records_saved = flipper_format_write_string_cstr(ff, "Thread", record.name) &&
+                            flipper_format_write_uint32(ff, "Stack", &record.stack_size, 1) &&
+                            flipper_format_write_uint32(ff, "Free", &record.min_free, 1);
+        }
+        saved = records_saved;
+    } while(false);
+
+    flipper_format_free(ff);
+
+    if(!saved) {
+        FURI_LOG_E(TAG, "Failed to save");
+        storage_simply_remove(storage, STACK_WATERMARK_PATH);
+    }
+
+    return saved;
+}
+
+static void stack_watermark_job(FuriWorkQueueJobId job_id, void* context) {
+    UNUSED(job_id);
+    StackWatermark* instance = context;
+
+    furi_stack_watermark_sample();
+
+    // Generation is taken before the save: changes made while saving go to the next one
+    const uint32_t generation = furi_stack_watermark_get_generation();
+    if(generation == instance->saved_generation) return;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(stack_watermark_save(storage)) {
+        instance->saved_generation = generation;
+    }
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void stack_watermark_job_done(FuriWorkQueueJobId job_id, bool cancelled, void* context) {
+    UNUSED(job_id);
+    UNUSED(cancelled);
+    StackWatermark* instance = context;
+
+    instance->busy = false;
+}
+
+static void stack_watermark_timer_callback(void* context) {
+    StackWatermark* instance = context;
+
+    // Skip the tick if storage is so slow that the previous save is still running
+    if(instance->busy) return;
+    instance->busy = true;
+
+    furi_work_queue_submit(
+        instance->work_queue,
+        FuriWorkQueuePriorityLow,
+        stack_watermark_job,
+        stack_watermark_job_done,
+        instance);
+}
+
+void stack_watermark_on_system_start(void) {
+    StackWatermark* instance = malloc(sizeof(StackWatermark));
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    stack_watermark_load(storage);
+    furi_record_close(RECORD_STORAGE);
+
+    // Loaded records do not need to be saved back
+    instance->saved_generation = furi_stack_watermark_get_generation();
+
+    instance->work_queue = furi_work_queue_alloc(NULL);
+    instance->timer =
+        furi_timer_alloc(stack_watermark_timer_callback, FuriTimerTypePeriodic, instance);
+    furi_timer_start(instance->timer, STACK_WATERMARK_SAVE_PERIOD_MS);
+}
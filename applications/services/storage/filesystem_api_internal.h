@@ -20,6 +20,7 @@ struct File {
     FS_Error error_id; /**< Standard API error from FS_Error enum */
     int32_t internal_error_id; /**< Internal API error value */
     void* storage;
+    void* lease; /**< Direct access data, set while the file is leased */
 };
 
 /** File api structure
@@ -81,6 +82,12 @@ struct File {
  *      @brief Checks that the r/w pointer is at the end of the file
  *      @param file pointer to file object
  *      @return end of file flag
+ *
+ *  @var FS_File_Api::preallocate
+ *      @brief Allocates contiguous space for an empty file
+ *      @param file pointer to file object
+ *      @param size space size, in bytes
+ *      @return success flag
  */
 typedef struct {
     bool (*const open)(
@@ -98,6 +105,7 @@ typedef struct {
     uint64_t (*size)(void* context, File* file);
     bool (*const sync)(void* context, File* file);
     bool (*const eof)(void* context, File* file);
+    bool (*const preallocate)(void* context, File* file, uint64_t size);
 } FS_File_Api;
 
 /** Dir api structure
@@ -159,6 +167,13 @@ typedef struct {
  *      @param path path to new directory
  *      @return FS_Error error info
  * 
+ *  @var FS_Common_Api::rename
+ *      @brief Rename or move file/directory within the storage,
+ *          new path must not exist
+ *      @param old_path path to file/directory
+ *      @param new_path new path to file/directory
+ *      @return FS_Error error info
+ * 
  *  @var FS_Common_Api::fs_info
  *      @brief Get total and free space storage values
  *      @param fs_path path of fs
@@ -177,6 +192,7 @@ typedef struct {
     FS_Error (*const stat)(void* context, const char* path, FileInfo* fileinfo);
     FS_Error (*const remove)(void* context, const char* path);
     FS_Error (*const mkdir)(void* context, const char* path);
+    FS_Error (*const rename)(void* context, const char* old_path, const char* new_path);
     FS_Error (*const fs_info)(
         void* context,
         const char* fs_path,
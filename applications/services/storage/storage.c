@@ -102,6 +102,10 @@ int32_t storage_srv(void* p) {
     Storage* app = storage_app_alloc();
     furi_record_create(RECORD_STORAGE, app);
 
+    // Card is mounted after the record is published: services that only keep
+    // the handle don't wait for it, requests are served once the card is mounted
+    storage_ext_start(&app->storage[ST_EXT]);
+
     StorageMessage message;
     while(1) {
         if(furi_message_queue_get(app->message_queue, &message, STORAGE_TICK) == FuriStatusOk) {
@@ -185,6 +185,196 @@ bool storage_file_sync(File* file);
  */
 bool storage_file_eof(File* file);
 
+/**
+ * @brief Allocate contiguous space for a file that is going to be written.
+ *
+ * Appending to a file makes the filesystem allocate clusters one by one,
+ * updating the allocation table each time. Preallocating the space first lets
+ * a recorder write into it without that overhead.
+ *
+ * The file must be open for writing and empty. Its size and end of file
+ * position account only for the data written so far. The unused space is
+ * released when the file is closed or truncated. Writing past the preallocated
+ * space works as usual.
+ *
+ * @param file pointer to the file instance in question.
+ * @param size space to allocate, in bytes.
+ * @return true if the space was allocated, false otherwise (the file can still be written).
+ */
+bool storage_file_preallocate(File* file, uint64_t size);
+
+/**
+ * @brief Enumeration of operations that can be submitted with storage_file_batch().
+ */
+typedef enum {
+    StorageFileOpRead, /**< Read `size` bytes into `buff`. */
+    StorageFileOpWrite, /**< Write `size` bytes from `buff`. */
+    StorageFileOpSeek, /**< Change the access position, see storage_file_seek(). */
+    StorageFileOpTell, /**< Get the current access position. */
+    StorageFileOpSize, /**< Get the file size. */
+    StorageFileOpEof, /**< Check whether the access position is at the end of the file. */
+    StorageFileOpDirRead, /**< Read the next directory item, see storage_dir_read(). */
+} StorageFileOpType;
+
+/**
+ * @brief Single operation of a batch request.
+ */
+typedef struct {
+    StorageFileOpType type; /**< Operation type. */
+    void* buff; /**< Read, Write: data buffer. DirRead: name buffer, may be NULL. */
+    size_t size; /**< Read, Write: number of bytes. DirRead: name buffer capacity. */
+    uint32_t offset; /**< Seek: access position offset. */
+    bool from_start; /**< Seek: offset is relative to the file start. */
+    FileInfo* fileinfo; /**< DirRead: item information, may be NULL. */
+    /** Read, Write: bytes processed. Tell, Size: the value. Seek, Eof, DirRead: the flag. */
+    uint64_t result;
+} StorageFileOp;
+
+/**
+ * @brief Buffer description for storage_file_readv() and storage_file_writev().
+ */
+typedef struct {
+    void* buff; /**< pointer to the data buffer. */
+    size_t size; /**< size of the data buffer, in bytes. */
+} StorageIoVec;
+
+/**
+ * @brief Execute several operations on a file in a single storage request.
+ *
+ * Every call of the file API is a round trip to the storage thread. A batch
+ * does all of its operations in one, and no other request is processed until
+ * it is finished.
+ *
+ * Operations are executed in order. The batch stops at the first operation that
+ * fails: sets an error, reads or writes fewer bytes than requested, or returns
+ * false (except for Eof). The results of the failed operation are still valid,
+ * the following operations are left untouched.
+ *
+ * @param file pointer to the file instance in question.
+ * @param ops pointer to an array of operations, receives their results.
+ * @param count number of operations in the array.
+ * @return number of operations that succeeded, count if the whole batch did.
+ */
+size_t storage_file_batch(File* file, StorageFileOp* ops, size_t count);
+
+/**
+ * @brief Read bytes from a file into several buffers.
+ *
+ * Buffers are filled in order, as if with consequent storage_file_read() calls.
+ *
+ * @param file pointer to the file instance to read from.
+ * @param iov pointer to an array of buffers.
+ * @param count number of buffers in the array.
+ * @return actual total number of bytes read (may be fewer than requested).
+ */
+size_t storage_file_readv(File* file, const StorageIoVec* iov, size_t count);
+
+/**
+ * @brief Write bytes from several buffers to a file.
+ *
+ * Buffers are written in order, as if with consequent storage_file_write() calls.
+ *
+ * @param file pointer to the file instance to write into.
+ * @param iov pointer to an array of buffers.
+ * @param count number of buffers in the array.
+ * @return actual total number of bytes written (may be fewer than requested).
+ */
+size_t storage_file_writev(File* file, const StorageIoVec* iov, size_t count);
+
+/**
+ * @brief Completion of an asynchronous request.
+ *
+ * Completion queues passed to storage_file_read_async() and
+ * storage_file_write_async() must be allocated with this item size.
+ */
+typedef struct {
+    void* context; /**< context passed with the request. */
+    size_t size; /**< actual number of bytes read or written. */
+    FS_Error error; /**< error of the request, FSE_OK on success. */
+} StorageAsyncCompletion;
+
+/**
+ * @brief Start reading bytes from a file without waiting for the result.
+ *
+ * The request is queued to the storage thread and the function returns right
+ * away. When the data is read, a StorageAsyncCompletion is put into the
+ * completion queue, which can be subscribed to with
+ * furi_event_loop_subscribe_message_queue().
+ *
+ * Several requests may be outstanding at once, they are processed in order,
+ * each one starting where the previous one has ended. Synchronous calls made
+ * on the same file are processed after all the requests submitted before them.
+ *
+ * @warning The buffer must stay valid until the completion is received. The
+ * completion queue must have room for all outstanding requests.
+ *
+ * @param file pointer to the file instance to read from.
+ * @param buff pointer to the buffer to be filled with read data.
+ * @param bytes_to_read number of bytes to read.
+ * @param completion_queue pointer to a queue of StorageAsyncCompletion items.
+ * @param context pointer to pass with the completion.
+ */
+void storage_file_read_async(
+    File* file,
+    void* buff,
+    size_t bytes_to_read,
+    FuriMessageQueue* completion_queue,
+    void* context);
+
+/**
+ * @brief Start writing bytes to a file without waiting for the result.
+ *
+ * Works the same way as storage_file_read_async().
+ *
+ * @param file pointer to the file instance to write into.
+ * @param buff pointer to the buffer containing the data to be written.
+ * @param bytes_to_write number of bytes to write.
+ * @param completion_queue pointer to a queue of StorageAsyncCompletion items.
+ * @param context pointer to pass with the completion.
+ */
+void storage_file_write_async(
+    File* file,
+    const void* buff,
+    size_t bytes_to_write,
+    FuriMessageQueue* completion_queue,
+    void* context);
+
+/**
+ * @brief Take a lease on an open file for direct access.
+ *
+ * While the file is leased, storage_file_read() and storage_file_write() access
+ * the SD card right from the calling thread instead of going through the
+ * storage thread, which removes a message round trip from every call. Other
+ * operations, including on this file, are still done by the storage thread.
+ *
+ * Unmounting or formatting the SD card revokes the lease: they only wait for
+ * a direct call that is already running, later calls go through the storage
+ * thread again. It's meant for bulk transfers by trusted services. Only files
+ * on the SD card can be leased.
+ *
+ * The lease is released automatically when the file is closed.
+ *
+ * @param file pointer to an open file instance.
+ * @return true if the lease was taken, false otherwise (the file can still be
+ *         accessed as usual).
+ */
+bool storage_file_lease_acquire(File* file);
+
+/**
+ * @brief Release a lease taken with storage_file_lease_acquire().
+ *
+ * @param file pointer to a leased file instance.
+ */
+void storage_file_lease_release(File* file);
+
+/**
+ * @brief Check whether a file is leased.
+ *
+ * @param file pointer to the file instance in question.
+ * @return true if the file is leased, false otherwise.
+ */
+bool storage_file_is_leased(File* file);
+
 /**
  * @brief Check whether a file exists.
  * 
@@ -246,6 +436,53 @@ bool storage_dir_close(File* file);
  */
 bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length);
 
+/** Name buffer size of StorageDirItem, enough for any item name. */
+#define STORAGE_DIR_ITEM_NAME_SIZE (256U)
+
+/**
+ * @brief Directory item returned by storage_dir_read_many().
+ */
+typedef struct {
+    FileInfo fileinfo; /**< Item information. */
+    char name[STORAGE_DIR_ITEM_NAME_SIZE]; /**< Zero-terminated item name. */
+} StorageDirItem;
+
+/**
+ * @brief Directory item filter for storage_dir_read_many().
+ *
+ * Zero-initialized filter lets every item through.
+ */
+typedef struct {
+    /** Files to keep, "|" separated case-insensitive name endings, NULL, "" or "*" for all. */
+    const char* extension;
+    bool skip_files; /**< Skip all files. */
+    bool skip_dirs; /**< Skip all directories. */
+    bool skip_dot_items; /**< Skip items whose names start with a dot. */
+    const char* skip_dir_name; /**< Skip directories with exactly this name, may be NULL. */
+} StorageDirFilter;
+
+/**
+ * @brief Get several next items in the directory in a single storage request.
+ *
+ * Filtering is done on the storage side, items that do not pass it are not
+ * returned and not counted. With items set to NULL the items are only
+ * counted, which is the way to skip a number of them.
+ *
+ * Fewer items than requested are returned only if the directory end was reached,
+ * in which case the file error id is set to FSE_NOT_EXIST, or on error.
+ *
+ * @param file pointer to a file instance representing the directory in question.
+ * @param items pointer to an array to contain the items (may be NULL).
+ * @param count number of items to read.
+ * @param filter pointer to the filter to apply (may be NULL).
+ * @return number of items read.
+ */
+size_t storage_dir_read_many(
+    File* file,
+    StorageDirItem* items,
+    size_t count,
+    const StorageDirFilter* filter);
+
 /**
  * @brief Change the access position to first item in the directory.
  *
@@ -285,6 +522,23 @@ FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t*
  */
 FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo);
 
+/**
+ * @brief Get information about a file or a directory along with its modification time.
+ *
+ * Only the SD card keeps modification times, FSE_NOT_IMPLEMENTED is returned for other storages.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param path pointer to a zero-terminated string containing the path of the item in question.
+ * @param fileinfo pointer to the FileInfo structure to contain the info (may be NULL).
+ * @param modified pointer to a value to contain the FAT modification date and time.
+ * @return FSE_OK if the info has been successfully received, any other error code on failure.
+ */
+FS_Error storage_common_stat_modified(
+    Storage* storage,
+    const char* path,
+    FileInfo* fileinfo,
+    uint32_t* modified);
+
 /**
  * @brief Remove a file or a directory.
  *
@@ -306,6 +560,8 @@ FS_Error storage_common_remove(Storage* storage, const char* path);
  * Renaming a regular file to itself does nothing and always succeeds.
  * Renaming a directory to itself or to a subdirectory of itself always fails.
  *
+ * Within a single storage only the directory entry is moved, otherwise the data is copied.
+ *
  * @param storage pointer to a storage API instance.
  * @param old_path pointer to a zero-terminated string containing the source path.
  * @param new_path pointer to a zero-terminated string containing the destination path.
@@ -325,6 +581,48 @@ FS_Error storage_common_rename(Storage* storage, const char* old_path, const cha
  */
 FS_Error storage_common_copy(Storage* storage, const char* old_path, const char* new_path);
 
+/**
+ * @brief Copy progress, see storage_common_copy_ex().
+ */
+typedef struct {
+    const char* path; /**< Source path of the file being copied. */
+    uint64_t file_size; /**< Size of that file, in bytes. */
+    uint64_t file_copied; /**< Bytes of that file copied so far. */
+    uint64_t total_copied; /**< Bytes copied since the operation started. */
+    uint32_t files_copied; /**< Files completed since the operation started. */
+} StorageCopyProgress;
+
+/**
+ * @brief Copy progress callback, see storage_common_copy_ex().
+ *
+ * @param progress pointer to the current progress.
+ * @param context pointer to a user-specified context.
+ * @return true to continue copying, false to cancel.
+ */
+typedef bool (*StorageCopyCallback)(const StorageCopyProgress* progress, void* context);
+
+/**
+ * @brief Copy a file or a directory with its contents to a new location, reporting progress.
+ *
+ * Same as storage_common_copy(), the callback is invoked after every copied chunk
+ * and at least once per file. On cancellation the partially copied file is removed,
+ * while the files and directories completed so far are kept.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param old_path pointer to a zero-terminated string containing the source path.
+ * @param new_path pointer to a zero-terminated string containing the destination path.
+ * @param callback pointer to a callback function, can be NULL.
+ * @param context pointer to a user-specified context (will be passed to the callback).
+ * @return FSE_OK if everything has been copied, FSE_DENIED if cancelled by the callback,
+ *         any other error code on failure.
+ */
+FS_Error storage_common_copy_ex(
+    Storage* storage,
+    const char* old_path,
+    const char* new_path,
+    StorageCopyCallback callback,
+    void* context);
+
 /**
  * @brief Copy the contents of one directory into another and rename all conflicting files.
  *
@@ -422,6 +720,38 @@ bool storage_common_equivalent_path(Storage* storage, const char* path1, const c
  */
 bool storage_common_is_subdir(Storage* storage, const char* parent, const char* child);
 
+/******************* Index Functions *******************/
+
+/**
+ * @brief Get the file MD5 digest from the storage index.
+ *
+ * The index lives on the SD card at EXT_PATH(".index"). Records are dropped when a file is
+ * opened for writing or removed, and are checked against the file size and modification
+ * time, so files changed on another device are not reported with a stale digest.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param path pointer to a zero-terminated string containing the path of the file in question.
+ * @param md5 pointer to a 16 byte buffer to contain the digest.
+ * @return FSE_OK if the digest was found, FSE_NOT_EXIST if there is no valid record,
+ *         any other error code on failure.
+ */
+FS_Error storage_index_get_md5(Storage* storage, const char* path, uint8_t* md5);
+
+/**
+ * @brief Put the file MD5 digest into the storage index.
+ *
+ * The index is created on first use. The record is refused with FSE_DENIED if the
+ * storage was modified after `timestamp` (see storage_common_timestamp()) was taken.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param path pointer to a zero-terminated string containing the path of the file in question.
+ * @param md5 pointer to a 16 byte buffer containing the digest.
+ * @param timestamp storage timestamp taken before the digest calculation was started.
+ * @return FSE_OK if the digest was stored, any other error code on failure.
+ */
+FS_Error
+    storage_index_set_md5(Storage* storage, const char* path, const uint8_t* md5, uint32_t timestamp);
+
 /******************* Error Functions *******************/
 
 /**
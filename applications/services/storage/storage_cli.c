@@ -4,11 +4,12 @@
 #include <cli/cli.h>
 #include <lib/toolbox/args.h>
 #include <lib/toolbox/dir_walk.h>
-#include <lib/toolbox/md5_calc.h>
+#include <lib/toolbox/hash_calc.h>
 #include <lib/toolbox/strint.h>
 #include <lib/toolbox/tar/tar_archive.h>
 #include <storage/storage.h>
 #include <storage/storage_sd_api.h>
+#include <sector_cache.h>
 #include <power/power_service/power.h>
 
 #define MAX_NAME_LENGTH 255
@@ -61,6 +62,18 @@ static void storage_cli_info(Cli* cli, FuriString* path, FuriString* args) {
                 sd_info.product_serial_number,
                 sd_info.manufacturing_month,
                 sd_info.manufacturing_year);
+
+            SectorCacheStats cache_stats;
+            sector_cache_get_stats(&cache_stats);
+            printf(
+                "Cache: %lu hits, %lu misses, %lu evictions, %lu pinned\r\n"
+                "Write back: %s, %lu dirty\r\n",
+                cache_stats.hits,
+                cache_stats.misses,
+                cache_stats.evictions,
+                cache_stats.pinned,
+                furi_hal_sd_is_write_back_enabled() ? "on" : "off",
+                cache_stats.dirty);
         }
     } else {
         storage_cli_print_usage();
@@ -464,27 +477,36 @@ static void storage_cli_mkdir(Cli* cli, FuriString* path, FuriString* args) {
     furi_record_close(RECORD_STORAGE);
 }
 
-static void storage_cli_md5(Cli* cli, FuriString* path, FuriString* args) {
-    UNUSED(cli);
-    UNUSED(args);
+static void storage_cli_hash(FuriString* path, HashCalcType type) {
     Storage* api = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(api);
-    FuriString* md5 = furi_string_alloc();
+    HashCalc* hash_calc = hash_calc_alloc(api);
+    FuriString* digest = furi_string_alloc();
     FS_Error file_error;
 
-    if(md5_string_calc_file(file, furi_string_get_cstr(path), md5, &file_error)) {
-        printf("%s\r\n", furi_string_get_cstr(md5));
+    if(hash_calc_file_string(hash_calc, furi_string_get_cstr(path), type, digest, &file_error)) {
+        printf("%s\r\n", furi_string_get_cstr(digest));
     } else {
         storage_cli_print_error(file_error);
     }
 
-    furi_string_free(md5);
-    storage_file_close(file);
-    storage_file_free(file);
+    furi_string_free(digest);
+    hash_calc_free(hash_calc);
 
     furi_record_close(RECORD_STORAGE);
 }
 
+static void storage_cli_md5(Cli* cli, FuriString* path, FuriString* args) {
+    UNUSED(cli);
+    UNUSED(args);
+    storage_cli_hash(path, HashCalcTypeMd5);
+}
+
+static void storage_cli_sha256(Cli* cli, FuriString* path, FuriString* args) {
+    UNUSED(cli);
+    UNUSED(args);
+    storage_cli_hash(path, HashCalcTypeSha256);
+}
+
 static bool tar_extract_file_callback(const char* name, bool is_directory, void* context) {
     UNUSED(context);
     printf("\t%s %s\r\n", is_directory ? "D" : "F", name);
@@ -555,6 +577,11 @@ static const StorageCliCommand storage_cli_commands[] = {
         "md5 hash of the file",
         &storage_cli_md5,
     },
+    {
+        "sha256",
+        "sha256 hash of the file",
+        &storage_cli_sha256,
+    },
     {
         "stat",
         "info about file or dir",
@@ -3,13 +3,19 @@
 #include "storage.h"
 #include "storage_i.h" // IWYU pragma: keep
 #include "storage_message.h"
-#include <toolbox/stream/file_stream.h>
+#include "storages/storage_ext.h"
 #include <toolbox/dir_walk.h>
+#include <toolbox/flash_kv.h>
 #include "toolbox/path.h"
 
-#define MAX_NAME_LENGTH  256
-#define MAX_EXT_LEN      16
-#define FILE_BUFFER_SIZE 512
+#define MAX_NAME_LENGTH 256
+#define MAX_EXT_LEN     16
+
+// Whole sectors, so that FatFs can transfer them straight to the card in multi-block commands
+#define STORAGE_COPY_BUFFER_SIZE (8U * 512U)
+
+// Number of buffers submitted in a single request by readv/writev
+#define STORAGE_FILE_VECTOR_BATCH_SIZE 8
 
 #define TAG "StorageApi"
 
@@ -44,6 +50,7 @@
 #define S_RETURN_BOOL    (return_data.bool_value);
 #define S_RETURN_UINT16  (return_data.uint16_value);
 #define S_RETURN_UINT64  (return_data.uint64_value);
+#define S_RETURN_SIZE    (return_data.size_value);
 #define S_RETURN_ERROR   (return_data.error_value);
 #define S_RETURN_CSTRING (return_data.cstring_value);
 
@@ -126,6 +133,11 @@ bool storage_file_open(
 
 bool storage_file_close(File* file) {
     S_FILE_API_PROLOGUE;
+
+    if(file->lease) {
+        storage_file_lease_release(file);
+    }
+
     S_API_PROLOGUE;
 
     S_API_DATA_FILE;
@@ -183,13 +195,61 @@ static uint16_t
     return S_RETURN_UINT16;
 }
 
+// Marks a direct call as active, fails if the lease was revoked by unmount or format
+static bool storage_file_lease_enter(File* file) {
+    StorageFileLease* lease = file->lease;
+    StorageData* storage = lease->storage;
+
+    __atomic_fetch_add(&storage->lease_active, 1, __ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&storage->lease_generation, __ATOMIC_SEQ_CST) == lease->generation) {
+        return true;
+    }
+    __atomic_fetch_sub(&storage->lease_active, 1, __ATOMIC_SEQ_CST);
+
+    // Revoked: the file continues through the storage thread
+    storage_file_lease_release(file);
+    return false;
+}
+
+static void storage_file_lease_exit(StorageData* storage) {
+    __atomic_fetch_sub(&storage->lease_active, 1, __ATOMIC_SEQ_CST);
+}
+
+static uint16_t storage_file_read_leased(File* file, void* buff, uint16_t bytes_to_read) {
+    if(!storage_file_lease_enter(file)) {
+        return storage_file_read_underlying(file, buff, bytes_to_read);
+    }
+
+    const StorageFileLease* lease = file->lease;
+    uint16_t read = storage_ext_file_data_read(file, lease->file_data, buff, bytes_to_read);
+    storage_file_lease_exit(lease->storage);
+    return read;
+}
+
+static uint16_t
+    storage_file_write_leased(File* file, const void* buff, uint16_t bytes_to_write) {
+    if(!storage_file_lease_enter(file)) {
+        return storage_file_write_underlying(file, buff, bytes_to_write);
+    }
+
+    const StorageFileLease* lease = file->lease;
+    storage_data_timestamp(lease->storage);
+    uint16_t written =
+        storage_ext_file_data_write(file, lease->file_data, buff, bytes_to_write);
+    storage_file_lease_exit(lease->storage);
+    return written;
+}
+
 size_t storage_file_read(File* file, void* buff, size_t to_read) {
+    furi_check(file);
+
     size_t total = 0;
 
     const size_t max_chunk = UINT16_MAX;
     do {
         const size_t chunk = MIN((to_read - total), max_chunk);
-        size_t read = storage_file_read_underlying(file, buff + total, chunk);
+        size_t read = file->lease ? storage_file_read_leased(file, buff + total, chunk) :
+                                    storage_file_read_underlying(file, buff + total, chunk);
         total += read;
 
         if(storage_file_get_error(file) != FSE_OK || read != chunk) {
@@ -208,7 +268,9 @@ size_t storage_file_write(File* file, const void* buff, size_t to_write) {
     const size_t max_chunk = UINT16_MAX;
     do {
         const size_t chunk = MIN((to_write - total), max_chunk);
-        size_t written = storage_file_write_underlying(file, buff + total, chunk);
+        size_t written = file->lease ?
+                             storage_file_write_leased(file, buff + total, chunk) :
+                             storage_file_write_underlying(file, buff + total, chunk);
         total += written;
 
         if(storage_file_get_error(file) != FSE_OK || written != chunk) {
@@ -219,6 +281,44 @@ size_t storage_file_write(File* file, const void* buff, size_t to_write) {
     return total;
 }
 
+bool storage_file_preallocate(File* file, uint64_t size) {
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .fpreallocate = {
+            .file = file,
+            .size = size,
+        }};
+
+    S_API_MESSAGE(StorageCommandFilePreallocate);
+    S_API_EPILOGUE;
+    return S_RETURN_BOOL;
+}
+
+bool storage_file_lease_acquire(File* file) {
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+    S_API_DATA_FILE;
+    S_API_MESSAGE(StorageCommandFileLease);
+    S_API_EPILOGUE;
+    return S_RETURN_BOOL;
+}
+
+void storage_file_lease_release(File* file) {
+    furi_check(file);
+    furi_check(file->lease);
+
+    StorageFileLease* lease = file->lease;
+    file->lease = NULL;
+    free(lease);
+}
+
+bool storage_file_is_leased(File* file) {
+    furi_check(file);
+    return file->lease != NULL;
+}
+
 bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
@@ -280,6 +380,155 @@ bool storage_file_eof(File* file) {
     return S_RETURN_BOOL;
 }
 
+size_t storage_file_batch(File* file, StorageFileOp* ops, size_t count) {
+    if(count == 0) {
+        return 0;
+    }
+
+    furi_check(ops);
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .fbatch = {
+            .file = file,
+            .ops = ops,
+            .count = count,
+        }};
+
+    S_API_MESSAGE(StorageCommandFileBatch);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
+static size_t storage_file_vector_io(
+    File* file,
+    const StorageIoVec* iov,
+    size_t count,
+    StorageFileOpType type) {
+    furi_check(iov || count == 0);
+
+    StorageFileOp ops[STORAGE_FILE_VECTOR_BATCH_SIZE];
+    size_t total = 0;
+
+    for(size_t i = 0; i < count;) {
+        const size_t batch_count = MIN(count - i, (size_t)STORAGE_FILE_VECTOR_BATCH_SIZE);
+        for(size_t j = 0; j < batch_count; j++) {
+            ops[j] = (StorageFileOp){
+                .type = type,
+                .buff = iov[i + j].buff,
+                .size = iov[i + j].size,
+            };
+        }
+
+        const size_t done = storage_file_batch(file, ops, batch_count);
+        // Operations after the failed one are left with zero result
+        for(size_t j = 0; j < batch_count; j++) {
+            total += ops[j].result;
+        }
+
+        if(done != batch_count) break;
+        i += batch_count;
+    }
+
+    return total;
+}
+
+size_t storage_file_readv(File* file, const StorageIoVec* iov, size_t count) {
+    return storage_file_vector_io(file, iov, count, StorageFileOpRead);
+}
+
+size_t storage_file_writev(File* file, const StorageIoVec* iov, size_t count) {
+    return storage_file_vector_io(file, iov, count, StorageFileOpWrite);
+}
+
+typedef struct {
+    SAData data;
+    SAReturn return_data;
+    StorageFileOp op;
+    File* file;
+    FuriMessageQueue* completion_queue;
+    void* context;
+} StorageAsyncRequest;
+
+// Runs on the storage thread
+static void storage_file_async_complete(void* context) {
+    StorageAsyncRequest* request = context;
+    StorageAsyncCompletion completion = {
+        .context = request->context,
+        .size = request->op.result,
+        .error = request->file->error_id,
+    };
+
+    // Storage thread can't wait for the app, queue must fit all outstanding requests
+    furi_check(
+        furi_message_queue_put(request->completion_queue, &completion, 0) == FuriStatusOk);
+    free(request);
+}
+
+static void storage_file_async_submit(
+    File* file,
+    StorageFileOpType type,
+    void* buff,
+    size_t size,
+    FuriMessageQueue* completion_queue,
+    void* context) {
+    S_FILE_API_PROLOGUE;
+    furi_check(buff || size == 0);
+    furi_check(completion_queue);
+    furi_check(
+        furi_message_queue_get_message_size(completion_queue) == sizeof(StorageAsyncCompletion));
+
+    StorageAsyncRequest* request = malloc(sizeof(StorageAsyncRequest));
+    request->op = (StorageFileOp){
+        .type = type,
+        .buff = buff,
+        .size = size,
+    };
+    request->file = file;
+    request->completion_queue = completion_queue;
+    request->context = context;
+    request->data.fbatch = (SADataFBatch){
+        .file = file,
+        .ops = &request->op,
+        .count = 1,
+    };
+
+    // One shot batch, processed after all requests queued before it
+    StorageMessage message = {
+        .command = StorageCommandFileBatch,
+        .data = &request->data,
+        .return_data = &request->return_data,
+        .complete = storage_file_async_complete,
+        .complete_context = request,
+    };
+
+    furi_check(
+        furi_message_queue_put(storage->message_queue, &message, FuriWaitForever) ==
+        FuriStatusOk);
+}
+
+void storage_file_read_async(
+    File* file,
+    void* buff,
+    size_t bytes_to_read,
+    FuriMessageQueue* completion_queue,
+    void* context) {
+    storage_file_async_submit(
+        file, StorageFileOpRead, buff, bytes_to_read, completion_queue, context);
+}
+
+void storage_file_write_async(
+    File* file,
+    const void* buff,
+    size_t bytes_to_write,
+    FuriMessageQueue* completion_queue,
+    void* context) {
+    // Buffer is only read from
+    storage_file_async_submit(
+        file, StorageFileOpWrite, (void*)buff, bytes_to_write, completion_queue, context);
+}
+
 bool storage_file_exists(Storage* storage, const char* path) {
     furi_check(storage);
 
@@ -298,10 +547,10 @@ bool storage_file_copy_to_file(File* source, File* destination, size_t size) {
     furi_check(source);
     furi_check(destination);
 
-    uint8_t* buffer = malloc(FILE_BUFFER_SIZE);
+    uint8_t* buffer = malloc(STORAGE_COPY_BUFFER_SIZE);
 
     while(size) {
-        uint32_t read_size = size > FILE_BUFFER_SIZE ? FILE_BUFFER_SIZE : size;
+        uint32_t read_size = size > STORAGE_COPY_BUFFER_SIZE ? STORAGE_COPY_BUFFER_SIZE : size;
         if(storage_file_read(source, buffer, read_size) != read_size) {
             break;
         }
@@ -404,6 +653,31 @@ bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_
     return S_RETURN_BOOL;
 }
 
+size_t storage_dir_read_many(
+    File* file,
+    StorageDirItem* items,
+    size_t count,
+    const StorageDirFilter* filter) {
+    if(count == 0) {
+        return 0;
+    }
+
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .dread_many = {
+            .file = file,
+            .items = items,
+            .count = count,
+            .filter = filter,
+        }};
+
+    S_API_MESSAGE(StorageCommandDirReadMany);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
 bool storage_dir_rewind(File* file) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
@@ -452,6 +726,29 @@ FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* filei
         .cstat = {
             .path = path,
             .fileinfo = fileinfo,
+            .modified = NULL,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonStat);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
+FS_Error storage_common_stat_modified(
+    Storage* storage,
+    const char* path,
+    FileInfo* fileinfo,
+    uint32_t* modified) {
+    furi_check(storage);
+    furi_check(modified);
+
+    S_API_PROLOGUE;
+    SAData data = {
+        .cstat = {
+            .path = path,
+            .fileinfo = fileinfo,
+            .modified = modified,
             .thread_id = furi_thread_get_current_id(),
         }};
 
@@ -463,6 +760,11 @@ FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* filei
 FS_Error storage_common_remove(Storage* storage, const char* path) {
     furi_check(storage);
 
+    // Value cached in internal flash would outlive the file
+    if(strncmp(path, STORAGE_INT_PATH_PREFIX "/", strlen(STORAGE_INT_PATH_PREFIX "/")) == 0) {
+        flash_kv_remove(path);
+    }
+
     S_API_PROLOGUE;
     SAData data = {
         .path = {
@@ -475,6 +777,22 @@ FS_Error storage_common_remove(Storage* storage, const char* path) {
     return S_RETURN_ERROR;
 }
 
+static FS_Error
+    storage_common_rename_internal(Storage* storage, const char* old_path, const char* new_path) {
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .crename = {
+            .old_path = old_path,
+            .new_path = new_path,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandCommonRename);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
 FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path) {
     furi_check(storage);
     FS_Error error;
@@ -508,6 +826,12 @@ FS_Error storage_common_rename(Storage* storage, const char* old_path, const cha
             storage_common_remove(storage, new_path);
         }
 
+        // Same storage moves only relink the directory entry
+        error = storage_common_rename_internal(storage, old_path, new_path);
+        if(error != FSE_NOT_IMPLEMENTED) {
+            break;
+        }
+
         error = storage_common_copy(storage, old_path, new_path);
         if(error != FSE_OK) {
             break;
@@ -521,8 +845,103 @@ FS_Error storage_common_rename(Storage* storage, const char* old_path, const cha
     return error;
 }
 
+typedef struct {
+    Storage* storage;
+    StorageCopyCallback callback;
+    void* context;
+    StorageCopyProgress progress;
+    File* source;
+    File* destination;
+    uint8_t* buffer;
+} StorageCopy;
+
+static FS_Error storage_copy_file_data(StorageCopy* copy) {
+    StorageCopyProgress* progress = &copy->progress;
+    FS_Error error = FSE_OK;
+
+    // Empty files are reported once too, so that cancellation is never delayed for long
+    do {
+        const size_t chunk_size =
+            MIN(progress->file_size - progress->file_copied, STORAGE_COPY_BUFFER_SIZE);
+
+        if(chunk_size) {
+            if(storage_file_read(copy->source, copy->buffer, chunk_size) != chunk_size) {
+                error = storage_file_get_error(copy->source);
+                break;
+            }
+
+            if(storage_file_write(copy->destination, copy->buffer, chunk_size) != chunk_size) {
+                error = storage_file_get_error(copy->destination);
+                break;
+            }
+
+            progress->file_copied += chunk_size;
+            progress->total_copied += chunk_size;
+        }
+
+        if(copy->callback && !copy->callback(progress, copy->context)) {
+            error = FSE_DENIED;
+            break;
+        }
+    } while(progress->file_copied < progress->file_size);
+
+    // Short transfer without an error, the file has changed under our feet
+    if(error == FSE_OK && progress->file_copied != progress->file_size) {
+        error = FSE_INTERNAL;
+    }
+
+    return error;
+}
+
+static FS_Error storage_copy_file(StorageCopy* copy, const char* old_path, const char* new_path) {
+    FS_Error error = FSE_OK;
+    bool created = false;
+
+    do {
+        if(!storage_file_open(copy->source, old_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            error = storage_file_get_error(copy->source);
+            break;
+        }
+
+        if(!storage_file_open(copy->destination, new_path, FSAM_WRITE, FSOM_CREATE_NEW)) {
+            error = storage_file_get_error(copy->destination);
+            break;
+        }
+        created = true;
+
+        copy->progress.path = old_path;
+        copy->progress.file_size = storage_file_size(copy->source);
+        copy->progress.file_copied = 0;
+
+        // Contiguous clusters spare the FAT lookups while writing, small files don't need it
+        if(copy->progress.file_size > STORAGE_COPY_BUFFER_SIZE) {
+            storage_file_preallocate(copy->destination, copy->progress.file_size);
+        }
+
+        error = storage_copy_file_data(copy);
+    } while(false);
+
+    if(storage_file_is_open(copy->source)) {
+        storage_file_close(copy->source);
+    }
+
+    if(storage_file_is_open(copy->destination) && !storage_file_close(copy->destination) &&
+       error == FSE_OK && created) {
+        error = storage_file_get_error(copy->destination);
+    }
+
+    if(error == FSE_OK) {
+        copy->progress.files_copied++;
+    } else if(created) {
+        storage_common_remove(copy->storage, new_path);
+    }
+
+    return error;
+}
+
 static FS_Error
-    storage_copy_recursive(Storage* storage, const char* old_path, const char* new_path) {
+    storage_copy_recursive(StorageCopy* copy, const char* old_path, const char* new_path) {
+    Storage* storage = copy->storage;
     FS_Error error = storage_common_mkdir(storage, new_path);
     DirWalk* dir_walk = dir_walk_alloc(storage);
     FuriString* path;
@@ -557,8 +976,8 @@ static FS_Error
                 if(file_info_is_dir(&fileinfo)) {
                     error = storage_common_mkdir(storage, furi_string_get_cstr(tmp_new_path));
                 } else {
-                    error = storage_common_copy(
-                        storage,
+                    error = storage_copy_file(
+                        copy,
                         furi_string_get_cstr(tmp_old_path),
                         furi_string_get_cstr(tmp_new_path));
                 }
@@ -576,7 +995,12 @@ static FS_Error
     return error;
 }
 
-FS_Error storage_common_copy(Storage* storage, const char* old_path, const char* new_path) {
+FS_Error storage_common_copy_ex(
+    Storage* storage,
+    const char* old_path,
+    const char* new_path,
+    StorageCopyCallback callback,
+    void* context) {
     furi_check(storage);
 
     FS_Error error;
@@ -585,31 +1009,33 @@ FS_Error storage_common_copy(Storage* storage, const char* old_path, const char*
     error = storage_common_stat(storage, old_path, &fileinfo);
 
     if(error == FSE_OK) {
+        StorageCopy* copy = malloc(sizeof(StorageCopy));
+        copy->storage = storage;
+        copy->callback = callback;
+        copy->context = context;
+        copy->source = storage_file_alloc(storage);
+        copy->destination = storage_file_alloc(storage);
+        copy->buffer = malloc(STORAGE_COPY_BUFFER_SIZE);
+
         if(file_info_is_dir(&fileinfo)) {
-            error = storage_copy_recursive(storage, old_path, new_path);
+            error = storage_copy_recursive(copy, old_path, new_path);
         } else {
-            Stream* stream_from = file_stream_alloc(storage);
-            Stream* stream_to = file_stream_alloc(storage);
-
-            do {
-                if(!file_stream_open(stream_from, old_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
-                if(!file_stream_open(stream_to, new_path, FSAM_WRITE, FSOM_CREATE_NEW)) break;
-                stream_copy_full(stream_from, stream_to);
-            } while(false);
-
-            error = file_stream_get_error(stream_from);
-            if(error == FSE_OK) {
-                error = file_stream_get_error(stream_to);
-            }
-
-            stream_free(stream_from);
-            stream_free(stream_to);
+            error = storage_copy_file(copy, old_path, new_path);
         }
+
+        free(copy->buffer);
+        storage_file_free(copy->destination);
+        storage_file_free(copy->source);
+        free(copy);
     }
 
     return error;
 }
 
+FS_Error storage_common_copy(Storage* storage, const char* old_path, const char* new_path) {
+    return storage_common_copy_ex(storage, old_path, new_path, NULL, NULL);
+}
+
 static FS_Error
     storage_merge_recursive(Storage* storage, const char* old_path, const char* new_path) {
     FS_Error error = FSE_OK;
@@ -717,22 +1143,7 @@ FS_Error storage_common_merge(Storage* storage, const char* old_path, const char
             } else {
                 new_path_tmp = new_path;
             }
-            Stream* stream_from = file_stream_alloc(storage);
-            Stream* stream_to = file_stream_alloc(storage);
-
-            do {
-                if(!file_stream_open(stream_from, old_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
-                if(!file_stream_open(stream_to, new_path_tmp, FSAM_WRITE, FSOM_CREATE_NEW)) break;
-                stream_copy_full(stream_from, stream_to);
-            } while(false);
-
-            error = file_stream_get_error(stream_from);
-            if(error == FSE_OK) {
-                error = file_stream_get_error(stream_to);
-            }
-
-            stream_free(stream_from);
-            stream_free(stream_to);
+            error = storage_common_copy(storage, old_path, new_path_tmp);
         }
     }
 
@@ -847,6 +1258,49 @@ bool storage_common_is_subdir(Storage* storage, const char* parent, const char*
     return storage_internal_equivalent_path(storage, parent, child, true);
 }
 
+/****************** INDEX ******************/
+
+FS_Error storage_index_get_md5(Storage* storage, const char* path, uint8_t* md5) {
+    furi_check(storage);
+    furi_check(path);
+    furi_check(md5);
+
+    S_API_PROLOGUE;
+    SAData data = {
+        .index_get = {
+            .path = path,
+            .md5 = md5,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandIndexGet);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
+FS_Error storage_index_set_md5(
+    Storage* storage,
+    const char* path,
+    const uint8_t* md5,
+    uint32_t timestamp) {
+    furi_check(storage);
+    furi_check(path);
+    furi_check(md5);
+
+    S_API_PROLOGUE;
+    SAData data = {
+        .index_set = {
+            .path = path,
+            .md5 = md5,
+            .timestamp = timestamp,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandIndexSet);
+    S_API_EPILOGUE;
+    return S_RETURN_ERROR;
+}
+
 /****************** ERROR ******************/
 
 const char* storage_error_get_desc(FS_Error error_id) {
@@ -929,6 +1383,7 @@ File* storage_file_alloc(Storage* storage) {
     File* file = malloc(sizeof(File));
     file->type = FileTypeClosed;
     file->storage = storage;
+    file->lease = NULL;
 
     FURI_LOG_T(TAG, "File/Dir %p alloc", (void*)((uint32_t)file - SRAM_BASE));
 
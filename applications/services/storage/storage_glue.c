@@ -32,6 +32,9 @@ void storage_file_clear(StorageFile* obj) {
 void storage_data_init(StorageData* storage) {
     storage->data = NULL;
     storage->status = StorageStatusNotReady;
+    storage->lease_generation = 0;
+    storage->lease_active = 0;
+    storage_stat_cache_init(&storage->stat_cache);
     StorageFileList_init(storage->files);
 }
 
@@ -73,6 +76,15 @@ uint32_t storage_data_get_timestamp(StorageData* storage) {
     return storage->timestamp;
 }
 
+void storage_data_lease_revoke(StorageData* storage) {
+    // Leases taken so far are invalid from now on, no new direct call starts
+    __atomic_fetch_add(&storage->lease_generation, 1, __ATOMIC_SEQ_CST);
+    // Only calls already inside FatFs are waited for, each is a single chunk
+    while(__atomic_load_n(&storage->lease_active, __ATOMIC_SEQ_CST)) {
+        furi_delay_tick(1);
+    }
+}
+
 /****************** storage glue ******************/
 
 static StorageFile* storage_get_file(const File* file, StorageData* storage) {
@@ -114,6 +126,28 @@ bool storage_path_already_open(FuriString* path, StorageData* storage) {
     return open;
 }
 
+bool storage_path_in_use(FuriString* path, StorageData* storage) {
+    bool in_use = false;
+    const size_t path_size = furi_string_size(path);
+
+    StorageFileList_it_t it;
+
+    for(StorageFileList_it(it, storage->files); !StorageFileList_end_p(it);
+        StorageFileList_next(it)) {
+        const StorageFile* storage_file = StorageFileList_cref(it);
+        const char* open_path = furi_string_get_cstr(storage_file->path);
+
+        // The path itself or anything below it
+        if(strncasecmp(open_path, furi_string_get_cstr(path), path_size) == 0 &&
+           (open_path[path_size] == '\0' || open_path[path_size] == '/')) {
+            in_use = true;
+            break;
+        }
+    }
+
+    return in_use;
+}
+
 void storage_set_storage_file_data(const File* file, void* file_data, StorageData* storage) {
     StorageFile* storage_file_ref = storage_get_file(file, storage);
     furi_check(storage_file_ref != NULL);
@@ -126,6 +160,12 @@ void* storage_get_storage_file_data(const File* file, StorageData* storage) {
     return storage_file_ref->file_data;
 }
 
+const char* storage_get_storage_file_path(const File* file, StorageData* storage) {
+    StorageFile* storage_file_ref = storage_get_file(file, storage);
+    furi_check(storage_file_ref != NULL);
+    return furi_string_get_cstr(storage_file_ref->path);
+}
+
 void storage_push_storage_file(File* file, FuriString* path, StorageData* storage) {
     StorageFile* storage_file = StorageFileList_push_new(storage->files);
     file->file_id = (uint32_t)storage_file;
@@ -2,6 +2,7 @@
 
 #include <furi.h>
 #include "filesystem_api_internal.h"
+#include "storage_stat_cache.h"
 #include <m-list.h>
 
 #ifdef __cplusplus
@@ -46,6 +47,7 @@ StorageStatus storage_data_status(StorageData* storage);
 const char* storage_data_status_text(StorageData* storage);
 void storage_data_timestamp(StorageData* storage);
 uint32_t storage_data_get_timestamp(StorageData* storage);
+void storage_data_lease_revoke(StorageData* storage);
 
 LIST_DEF(
     StorageFileList,
@@ -62,13 +64,18 @@ struct StorageData {
     StorageStatus status;
     StorageFileList_t files;
     uint32_t timestamp;
+    uint32_t lease_generation;
+    uint32_t lease_active;
+    StorageStatCache stat_cache;
 };
 
 bool storage_has_file(const File* file, StorageData* storage_data);
 bool storage_path_already_open(FuriString* path, StorageData* storage_data);
+bool storage_path_in_use(FuriString* path, StorageData* storage_data);
 
 void storage_set_storage_file_data(const File* file, void* file_data, StorageData* storage);
 void* storage_get_storage_file_data(const File* file, StorageData* storage);
+const char* storage_get_storage_file_path(const File* file, StorageData* storage);
 
 void storage_push_storage_file(File* file, FuriString* path, StorageData* storage);
 bool storage_pop_storage_file(File* file, StorageData* storage);
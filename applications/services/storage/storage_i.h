@@ -15,6 +15,12 @@ extern "C" {
 #define APPS_DATA_PATH   EXT_PATH("apps_data")
 #define APPS_ASSETS_PATH EXT_PATH("apps_assets")
 
+typedef struct {
+    StorageData* storage;
+    void* file_data;
+    uint32_t generation;
+} StorageFileLease;
+
 typedef struct {
     ViewPort* view_port;
     bool enabled;
@@ -0,0 +1,272 @@
+#include "storage_index.h"
+#include "storage.h"
+#include "storages/storage_ext.h"
+
+#include <ctype.h>
+#include <toolbox/crc32_calc.h>
+
+#define TAG "StorageIndex"
+
+#define STORAGE_INDEX_MAGIC   (0x58495A46UL) // "FZIX"
+#define STORAGE_INDEX_VERSION (1U)
+
+#define STORAGE_INDEX_BUCKET_COUNT (2048U)
+#define STORAGE_INDEX_PROBE_COUNT  (8U)
+// Probe windows never wrap, last bucket gets its own tail
+#define STORAGE_INDEX_RECORD_COUNT (STORAGE_INDEX_BUCKET_COUNT + STORAGE_INDEX_PROBE_COUNT)
+
+#define STORAGE_INDEX_MD5_SIZE (16U)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t bucket_count;
+} StorageIndexHeader;
+
+typedef struct {
+    // Paths are not kept, CRC with length, size and modification time make false match improbable
+    uint32_t path_crc;
+    uint16_t path_length; // 0 marks free record
+    uint16_t reserved;
+    uint32_t size;
+    uint32_t modified; // FAT date and time
+    uint8_t md5[STORAGE_INDEX_MD5_SIZE];
+} StorageIndexRecord;
+
+_Static_assert(sizeof(StorageIndexRecord) == 32, "Index record size mismatch");
+
+typedef struct {
+    StorageData* storage;
+    File file;
+    uint32_t path_crc;
+    uint16_t path_length;
+    size_t bucket;
+    StorageIndexRecord window[STORAGE_INDEX_PROBE_COUNT];
+} StorageIndex;
+
+static void storage_index_key(StorageIndex* index, const char* path) {
+    // FAT is case insensitive, and so are the keys
+    char chunk[32];
+    size_t chunk_size = 0;
+    size_t length = 0;
+    uint32_t crc = 0;
+
+    for(; *path; path++, length++) {
+        chunk[chunk_size++] = tolower((unsigned char)*path);
+        if(chunk_size == sizeof(chunk)) {
+            crc = crc32_calc_buffer(crc, chunk, chunk_size);
+            chunk_size = 0;
+        }
+    }
+    crc = crc32_calc_buffer(crc, chunk, chunk_size);
+
+    index->path_crc = crc;
+    index->path_length = MIN(length, UINT16_MAX);
+    index->bucket = crc % STORAGE_INDEX_BUCKET_COUNT;
+}
+
+static bool storage_index_seek(StorageIndex* index, size_t record) {
+    const uint32_t offset = sizeof(StorageIndexHeader) + record * sizeof(StorageIndexRecord);
+    return index->storage->fs_api->file.seek(index->storage, &index->file, offset, true);
+}
+
+static bool storage_index_write(StorageIndex* index, const void* data, size_t size) {
+    return index->storage->fs_api->file.write(index->storage, &index->file, data, size) == size;
+}
+
+static bool storage_index_format(StorageIndex* index) {
+    const FS_File_Api* api = &index->storage->fs_api->file;
+    const StorageIndexHeader header = {
+        .magic = STORAGE_INDEX_MAGIC,
+        .version = STORAGE_INDEX_VERSION,
+        .bucket_count = STORAGE_INDEX_BUCKET_COUNT,
+    };
+
+    bool result = false;
+
+    do {
+        if(!api->seek(index->storage, &index->file, 0, true)) break;
+        if(!api->truncate(index->storage, &index->file)) break;
+        if(!storage_index_write(index, &header, sizeof(header))) break;
+
+        // Expanded part of a FAT file is undefined, records are zeroed explicitly
+        memset(index->window, 0, sizeof(index->window));
+        size_t written = 0;
+        while(written < STORAGE_INDEX_RECORD_COUNT &&
+              storage_index_write(index, index->window, sizeof(index->window))) {
+            written += STORAGE_INDEX_PROBE_COUNT;
+        }
+
+        result = written >= STORAGE_INDEX_RECORD_COUNT;
+    } while(false);
+
+    return result;
+}
+
+static bool storage_index_open(StorageIndex* index, bool create) {
+    const FS_File_Api* api = &index->storage->fs_api->file;
+    FuriString* path = furi_string_alloc_set(EXT_PATH(STORAGE_INDEX_NAME));
+    bool result = false;
+
+    do {
+        // Index is being read or restored by someone else
+        if(storage_path_already_open(path, index->storage)) break;
+
+        storage_stat_cache_invalidate(&index->storage->stat_cache, "/" STORAGE_INDEX_NAME);
+        storage_push_storage_file(&index->file, path, index->storage);
+        if(!api->open(
+               index->storage,
+               &index->file,
+               "/" STORAGE_INDEX_NAME,
+               FSAM_READ_WRITE,
+               create ? FSOM_OPEN_ALWAYS : FSOM_OPEN_EXISTING)) {
+            storage_pop_storage_file(&index->file, index->storage);
+            break;
+        }
+
+        StorageIndexHeader header = {0};
+        const size_t size = api->read(index->storage, &index->file, &header, sizeof(header));
+        result = size == sizeof(header) && header.magic == STORAGE_INDEX_MAGIC &&
+                 header.version == STORAGE_INDEX_VERSION &&
+                 header.bucket_count == STORAGE_INDEX_BUCKET_COUNT;
+
+        if(!result && create) {
+            FURI_LOG_I(TAG, "Creating index");
+            result = storage_index_format(index);
+        }
+
+        if(!result) {
+            api->close(index->storage, &index->file);
+            storage_pop_storage_file(&index->file, index->storage);
+        }
+    } while(false);
+
+    furi_string_free(path);
+
+    return result;
+}
+
+static void storage_index_close(StorageIndex* index) {
+    index->storage->fs_api->file.close(index->storage, &index->file);
+    storage_pop_storage_file(&index->file, index->storage);
+    storage_stat_cache_invalidate(&index->storage->stat_cache, "/" STORAGE_INDEX_NAME);
+}
+
+static bool storage_index_read_window(StorageIndex* index) {
+    if(!storage_index_seek(index, index->bucket)) return false;
+
+    const size_t size = index->storage->fs_api->file.read(
+        index->storage, &index->file, index->window, sizeof(index->window));
+
+    return size == sizeof(index->window);
+}
+
+static bool storage_index_write_record(StorageIndex* index, size_t slot) {
+    return storage_index_seek(index, index->bucket + slot) &&
+           storage_index_write(index, &index->window[slot], sizeof(StorageIndexRecord));
+}
+
+static size_t storage_index_find(StorageIndex* index) {
+    for(size_t i = 0; i < STORAGE_INDEX_PROBE_COUNT; i++) {
+        const StorageIndexRecord* record = &index->window[i];
+        if(record->path_length == index->path_length && record->path_crc == index->path_crc) {
+            return i;
+        }
+    }
+
+    return STORAGE_INDEX_PROBE_COUNT;
+}
+
+static StorageIndex* storage_index_alloc(StorageData* storage, const char* path) {
+    StorageIndex* index = malloc(sizeof(StorageIndex));
+    index->storage = storage;
+    storage_index_key(index, path);
+    return index;
+}
+
+FS_Error storage_index_get(StorageData* storage, const char* path, uint8_t* md5) {
+    FileInfo fileinfo;
+    uint32_t modified;
+    FS_Error error = sd_file_stat(storage, path, &fileinfo, &modified);
+    if(error != FSE_OK) return error;
+    if(file_info_is_dir(&fileinfo)) return FSE_INVALID_PARAMETER;
+
+    StorageIndex* index = storage_index_alloc(storage, path);
+    error = FSE_NOT_EXIST;
+
+    if(storage_index_open(index, false)) {
+        if(storage_index_read_window(index)) {
+            const size_t slot = storage_index_find(index);
+            const StorageIndexRecord* record = &index->window[slot];
+
+            // Files changed outside of Flipper are caught here
+            if(slot < STORAGE_INDEX_PROBE_COUNT && record->size == fileinfo.size &&
+               record->modified == modified) {
+                memcpy(md5, record->md5, STORAGE_INDEX_MD5_SIZE);
+                error = FSE_OK;
+            }
+        }
+        storage_index_close(index);
+    }
+
+    free(index);
+
+    return error;
+}
+
+FS_Error storage_index_set(StorageData* storage, const char* path, const uint8_t* md5) {
+    FileInfo fileinfo;
+    uint32_t modified;
+    FS_Error error = sd_file_stat(storage, path, &fileinfo, &modified);
+    if(error != FSE_OK) return error;
+    if(file_info_is_dir(&fileinfo) || fileinfo.size > UINT32_MAX) return FSE_INVALID_PARAMETER;
+
+    StorageIndex* index = storage_index_alloc(storage, path);
+    error = FSE_INTERNAL;
+
+    if(storage_index_open(index, true)) {
+        if(storage_index_read_window(index)) {
+            size_t slot = storage_index_find(index);
+
+            // Reuse free record, evict the home one if the window is full
+            for(size_t i = 0; slot == STORAGE_INDEX_PROBE_COUNT && i < STORAGE_INDEX_PROBE_COUNT;
+                i++) {
+                if(!index->window[i].path_length) slot = i;
+            }
+            if(slot == STORAGE_INDEX_PROBE_COUNT) slot = 0;
+
+            StorageIndexRecord* record = &index->window[slot];
+            record->path_crc = index->path_crc;
+            record->path_length = index->path_length;
+            record->reserved = 0;
+            record->size = fileinfo.size;
+            record->modified = modified;
+            memcpy(record->md5, md5, STORAGE_INDEX_MD5_SIZE);
+
+            if(storage_index_write_record(index, slot)) error = FSE_OK;
+        }
+        storage_index_close(index);
+    }
+
+    free(index);
+
+    return error;
+}
+
+void storage_index_invalidate(StorageData* storage, const char* path) {
+    StorageIndex* index = storage_index_alloc(storage, path);
+
+    // Nothing to do until someone asks for a digest and creates the index
+    if(storage_index_open(index, false)) {
+        if(storage_index_read_window(index)) {
+            const size_t slot = storage_index_find(index);
+            if(slot < STORAGE_INDEX_PROBE_COUNT) {
+                memset(&index->window[slot], 0, sizeof(StorageIndexRecord));
+                storage_index_write_record(index, slot);
+            }
+        }
+        storage_index_close(index);
+    }
+
+    free(index);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <furi.h>
+#include "storage_glue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STORAGE_INDEX_NAME ".index"
+
+/* Index functions run in storage thread, paths are given without vfs prefix */
+
+FS_Error storage_index_get(StorageData* storage, const char* path, uint8_t* md5);
+FS_Error storage_index_set(StorageData* storage, const char* path, const uint8_t* md5);
+void storage_index_invalidate(StorageData* storage, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
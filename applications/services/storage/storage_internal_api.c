@@ -1,6 +1,7 @@
 #include <core/record.h>
 #include "storage.h"
 #include <toolbox/tar/tar_archive.h>
+#include <toolbox/flash_kv.h>
 
 FS_Error storage_int_backup(Storage* storage, const char* dstname) {
     furi_check(storage);
@@ -21,5 +22,7 @@ FS_Error
     bool success = tar_archive_open(archive, srcname, TarOpenModeRead) &&
                    tar_archive_unpack_to(archive, STORAGE_INT_PATH_PREFIX, converter);
     tar_archive_free(archive);
+    // Restored files replace whatever was cached in internal flash
+    flash_kv_format();
     return success ? FSE_OK : FSE_INTERNAL;
 }
@@ -32,6 +32,17 @@ typedef struct {
     bool from_start;
 } SADataFSeek;
 
+typedef struct {
+    File* file;
+    StorageFileOp* ops;
+    size_t count;
+} SADataFBatch;
+
+typedef struct {
+    File* file;
+    uint64_t size;
+} SADataFPreallocate;
+
 typedef struct {
     File* file;
     const char* path;
@@ -45,6 +56,13 @@ typedef struct {
     uint16_t name_length;
 } SADataDRead;
 
+typedef struct {
+    File* file;
+    StorageDirItem* items;
+    size_t count;
+    const StorageDirFilter* filter;
+} SADataDReadMany;
+
 typedef struct {
     const char* path;
     uint32_t* timestamp;
@@ -54,6 +72,7 @@ typedef struct {
 typedef struct {
     const char* path;
     FileInfo* fileinfo;
+    uint32_t* modified;
     FuriThreadId thread_id;
 } SADataCStat;
 
@@ -76,6 +95,25 @@ typedef struct {
     FuriThreadId thread_id;
 } SADataCEquivPath;
 
+typedef struct {
+    const char* old_path;
+    const char* new_path;
+    FuriThreadId thread_id;
+} SADataCRename;
+
+typedef struct {
+    const char* path;
+    uint8_t* md5;
+    FuriThreadId thread_id;
+} SADataIndexGet;
+
+typedef struct {
+    const char* path;
+    const uint8_t* md5;
+    uint32_t timestamp;
+    FuriThreadId thread_id;
+} SADataIndexSet;
+
 typedef struct {
     uint32_t id;
 } SADataError;
@@ -98,15 +136,22 @@ typedef union {
     SADataFRead fread;
     SADataFWrite fwrite;
     SADataFSeek fseek;
+    SADataFBatch fbatch;
+    SADataFPreallocate fpreallocate;
 
     SADataDOpen dopen;
     SADataDRead dread;
+    SADataDReadMany dread_many;
 
     SADataCTimestamp ctimestamp;
     SADataCStat cstat;
     SADataCFSInfo cfsinfo;
     SADataCResolvePath cresolvepath;
     SADataCEquivPath cequivpath;
+    SADataCRename crename;
+
+    SADataIndexGet index_get;
+    SADataIndexSet index_set;
 
     SADataError error;
 
@@ -120,6 +165,7 @@ typedef union {
     bool bool_value;
     uint16_t uint16_value;
     uint64_t uint64_value;
+    size_t size_value;
     FS_Error error_value;
     const char* cstring_value;
 } SAReturn;
@@ -151,13 +197,25 @@ typedef enum {
     StorageCommandCommonResolvePath,
     StorageCommandSDMount,
     StorageCommandCommonEquivalentPath,
+    StorageCommandIndexGet,
+    StorageCommandIndexSet,
+    StorageCommandFileBatch,
+    StorageCommandFileLease,
+    StorageCommandFilePreallocate,
+    StorageCommandCommonRename,
+    StorageCommandDirReadMany,
 } StorageCommand;
 
+typedef void (*StorageMessageCompleteCallback)(void* context);
+
 typedef struct {
     FuriApiLock lock;
     StorageCommand command;
     SAData* data;
     SAReturn* return_data;
+    // Asynchronous requests have no lock, this is called on completion instead
+    StorageMessageCompleteCallback complete;
+    void* complete_context;
 } StorageMessage;
 
 #ifdef __cplusplus
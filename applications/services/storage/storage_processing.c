@@ -3,6 +3,7 @@
 
 #include "storage_processing.h"
 #include "storage_internal_dirname_i.h"
+#include "storage_index.h"
 
 #define TAG "Storage"
 
@@ -93,6 +94,12 @@ static FS_Error storage_get_data(Storage* app, FuriString* path, StorageData** s
     }
 }
 
+static void storage_stat_cache_invalidate_file(StorageData* storage, File* file) {
+    // Directory entry of a file changes when it is created, synced or closed after writing
+    const char* path = storage_get_storage_file_path(file, storage) + STORAGE_PATH_PREFIX_LEN;
+    storage_stat_cache_invalidate(&storage->stat_cache, path);
+}
+
 static void storage_path_trim_trailing_slashes(FuriString* path) {
     while(furi_string_end_with(path, "/")) {
         furi_string_left(path, furi_string_size(path) - 1);
@@ -117,6 +124,9 @@ bool storage_process_file_open(
         } else {
             if(access_mode & FSAM_WRITE) {
                 storage_data_timestamp(storage);
+                storage_index_invalidate(storage, cstr_path_without_vfs_prefix(path));
+                storage_stat_cache_invalidate(
+                    &storage->stat_cache, cstr_path_without_vfs_prefix(path));
             }
             storage_push_storage_file(file, path, storage);
 
@@ -136,6 +146,7 @@ bool storage_process_file_close(Storage* app, File* file) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
         FS_CALL(storage, file.close(storage, file));
+        storage_stat_cache_invalidate_file(storage, file);
         storage_pop_storage_file(file, storage);
 
         StorageEvent event = {.type = StorageEventTypeFileClose};
@@ -230,6 +241,7 @@ static bool storage_process_file_sync(Storage* app, File* file) {
     } else {
         storage_data_timestamp(storage);
         FS_CALL(storage, file.sync(storage, file));
+        storage_stat_cache_invalidate_file(storage, file);
     }
 
     return ret;
@@ -261,6 +273,44 @@ static bool storage_process_file_eof(Storage* app, File* file) {
     return ret;
 }
 
+static bool storage_process_file_preallocate(Storage* app, File* file, const uint64_t size) {
+    bool ret = false;
+    StorageData* storage = get_storage_by_file(file, app->storage);
+
+    if(storage == NULL) {
+        file->error_id = FSE_INVALID_PARAMETER;
+    } else {
+        storage_data_timestamp(storage);
+        FS_CALL(storage, file.preallocate(storage, file, size));
+    }
+
+    return ret;
+}
+
+static bool storage_process_file_lease(Storage* app, File* file) {
+    bool ret = false;
+    StorageData* storage = get_storage_by_file(file, app->storage);
+
+    if(storage == NULL || file->type != FileTypeOpenFile || file->lease) {
+        file->error_id = FSE_INVALID_PARAMETER;
+    } else if(storage != &app->storage[ST_EXT]) {
+        file->error_id = FSE_NOT_IMPLEMENTED;
+    } else if(storage_data_status(storage) != StorageStatusOK) {
+        file->error_id = FSE_NOT_READY;
+    } else {
+        StorageFileLease* lease = malloc(sizeof(StorageFileLease));
+        lease->storage = storage;
+        lease->file_data = storage_get_storage_file_data(file, storage);
+        // Acquired on the storage thread, so it can't race with a revoke
+        lease->generation = storage->lease_generation;
+        file->lease = lease;
+        file->error_id = FSE_OK;
+        ret = true;
+    }
+
+    return ret;
+}
+
 /******************* Dir Functions *******************/
 
 bool storage_process_dir_open(Storage* app, File* file, FuriString* path) {
@@ -315,6 +365,65 @@ bool storage_process_dir_read(
     return ret;
 }
 
+static bool storage_dir_filter_extension(const char* extension, const char* name) {
+    if(!extension || extension[0] == '\0') return true;
+
+    const size_t name_len = strlen(name);
+    while(true) {
+        const size_t ext_len = strcspn(extension, "|");
+        if(ext_len == 0 || (ext_len == 1 && extension[0] == '*')) return true;
+        if(ext_len <= name_len &&
+           strncasecmp(name + name_len - ext_len, extension, ext_len) == 0) {
+            return true;
+        }
+
+        if(extension[ext_len] == '\0' || extension[ext_len + 1] == '\0') return false;
+        extension += ext_len + 1;
+    }
+}
+
+static bool storage_dir_filter(const StorageDirFilter* filter, const StorageDirItem* item) {
+    if(item->name[0] == '\0') return false;
+    if(!filter) return true;
+
+    if(filter->skip_dot_items && item->name[0] == '.') return false;
+
+    if(file_info_is_dir(&item->fileinfo)) {
+        if(filter->skip_dirs) return false;
+        return !filter->skip_dir_name || strcmp(item->name, filter->skip_dir_name) != 0;
+    } else {
+        if(filter->skip_files) return false;
+        return storage_dir_filter_extension(filter->extension, item->name);
+    }
+}
+
+static size_t storage_process_dir_read_many(
+    Storage* app,
+    File* file,
+    StorageDirItem* items,
+    size_t count,
+    const StorageDirFilter* filter) {
+    // Counting only: items are read into a scratch one
+    StorageDirItem* scratch = items ? NULL : malloc(sizeof(StorageDirItem));
+    size_t done = 0;
+
+    while(done < count) {
+        StorageDirItem* item = items ? &items[done] : scratch;
+        if(!storage_process_dir_read(
+               app, file, &item->fileinfo, item->name, STORAGE_DIR_ITEM_NAME_SIZE)) {
+            break;
+        }
+        if(file->error_id != FSE_OK) break;
+
+        if(storage_dir_filter(filter, item)) {
+            done++;
+        }
+    }
+
+    free(scratch);
+    return done;
+}
+
 bool storage_process_dir_rewind(Storage* app, File* file) {
     bool ret = false;
     StorageData* storage = get_storage_by_file(file, app->storage);
@@ -328,6 +437,68 @@ bool storage_process_dir_rewind(Storage* app, File* file) {
     return ret;
 }
 
+/******************* Batch Functions *******************/
+
+static size_t storage_process_file_batch_io(Storage* app, File* file, StorageFileOp* op) {
+    size_t total = 0;
+
+    while(total < op->size) {
+        const uint16_t chunk = MIN(op->size - total, (size_t)UINT16_MAX);
+        uint8_t* buff = (uint8_t*)op->buff + total;
+        const uint16_t done = (op->type == StorageFileOpRead) ?
+                                  storage_process_file_read(app, file, buff, chunk) :
+                                  storage_process_file_write(app, file, buff, chunk);
+        total += done;
+
+        if(file->error_id != FSE_OK || done != chunk) break;
+    }
+
+    return total;
+}
+
+static size_t
+    storage_process_file_batch(Storage* app, File* file, StorageFileOp* ops, size_t count) {
+    size_t done = 0;
+
+    for(; done < count; done++) {
+        StorageFileOp* op = &ops[done];
+        bool success = true;
+
+        switch(op->type) {
+        case StorageFileOpRead:
+        case StorageFileOpWrite:
+            op->result = storage_process_file_batch_io(app, file, op);
+            success = (op->result == op->size);
+            break;
+        case StorageFileOpSeek:
+            op->result = storage_process_file_seek(app, file, op->offset, op->from_start);
+            success = op->result;
+            break;
+        case StorageFileOpTell:
+            op->result = storage_process_file_tell(app, file);
+            break;
+        case StorageFileOpSize:
+            op->result = storage_process_file_size(app, file);
+            break;
+        case StorageFileOpEof:
+            op->result = storage_process_file_eof(app, file);
+            break;
+        case StorageFileOpDirRead:
+            op->result = storage_process_dir_read(
+                app, file, op->fileinfo, op->buff, MIN(op->size, (size_t)UINT16_MAX));
+            success = op->result;
+            break;
+        default:
+            file->error_id = FSE_INVALID_PARAMETER;
+            break;
+        }
+
+        if(!success || file->error_id != FSE_OK) break;
+    }
+
+    return done;
+}
+
 /******************* Common FS Functions *******************/
 
 static FS_Error
@@ -347,7 +518,16 @@ static FS_Error storage_process_common_stat(Storage* app, FuriString* path, File
     FS_Error ret = storage_get_data(app, path, &storage);
 
     if(ret == FSE_OK) {
-        FS_CALL(storage, common.stat(storage, cstr_path_without_vfs_prefix(path), fileinfo));
+        const char* path_cstr_no_vfs = cstr_path_without_vfs_prefix(path);
+
+        // Probes for settings, assets and manifests repeat a lot, spare the directory walks
+        if(!storage_stat_cache_get(&storage->stat_cache, path_cstr_no_vfs, fileinfo, &ret)) {
+            FileInfo stat_fileinfo;
+            FS_CALL(storage, common.stat(storage, path_cstr_no_vfs, &stat_fileinfo));
+            storage_stat_cache_put(&storage->stat_cache, path_cstr_no_vfs, &stat_fileinfo, ret);
+
+            if(fileinfo != NULL) *fileinfo = stat_fileinfo;
+        }
     }
 
     return ret;
@@ -367,6 +547,9 @@ static FS_Error storage_process_common_remove(Storage* app, FuriString* path) {
 
         storage_data_timestamp(storage);
         FS_CALL(storage, common.remove(storage, cstr_path_without_vfs_prefix(path)));
+        storage_stat_cache_invalidate(&storage->stat_cache, cstr_path_without_vfs_prefix(path));
+
+        if(ret == FSE_OK) storage_index_invalidate(storage, cstr_path_without_vfs_prefix(path));
     } while(false);
 
     return ret;
@@ -379,11 +562,49 @@ static FS_Error storage_process_common_mkdir(Storage* app, FuriString* path) {
     if(ret == FSE_OK) {
         storage_data_timestamp(storage);
         FS_CALL(storage, common.mkdir(storage, cstr_path_without_vfs_prefix(path)));
+        storage_stat_cache_invalidate(&storage->stat_cache, cstr_path_without_vfs_prefix(path));
     }
 
     return ret;
 }
 
+static FS_Error
+    storage_process_common_rename(Storage* app, FuriString* old_path, FuriString* new_path) {
+    StorageData* storage;
+    FS_Error ret = storage_get_data(app, old_path, &storage);
+
+    do {
+        if(ret != FSE_OK) break;
+
+        // Moves between storages have to copy the data
+        if(storage_get_type_by_path(old_path) != storage_get_type_by_path(new_path)) {
+            ret = FSE_NOT_IMPLEMENTED;
+            break;
+        }
+
+        if(storage_path_in_use(old_path, storage) || storage_path_in_use(new_path, storage)) {
+            ret = FSE_ALREADY_OPEN;
+            break;
+        }
+
+        storage_data_timestamp(storage);
+        FS_CALL(
+            storage,
+            common.rename(
+                storage,
+                cstr_path_without_vfs_prefix(old_path),
+                cstr_path_without_vfs_prefix(new_path)));
+
+        if(ret == FSE_OK) {
+            storage_index_invalidate(storage, cstr_path_without_vfs_prefix(old_path));
+            // Entries below a moved directory are stale as well
+            storage_stat_cache_reset(&storage->stat_cache);
+        }
+    } while(false);
+
+    return ret;
+}
+
 static FS_Error storage_process_common_fs_info(
     Storage* app,
     FuriString* path,
@@ -426,10 +647,73 @@ static bool
     return ret;
 }
 
+/******************* Index Functions *******************/
+
+static FS_Error storage_process_index_get(Storage* app, FuriString* path, uint8_t* md5) {
+    StorageData* storage;
+    FS_Error ret = storage_get_data(app, path, &storage);
+
+    if(ret == FSE_OK) {
+        ret = storage_index_get(storage, cstr_path_without_vfs_prefix(path), md5);
+    }
+
+    return ret;
+}
+
+static FS_Error storage_process_index_set(
+    Storage* app,
+    FuriString* path,
+    const uint8_t* md5,
+    uint32_t timestamp) {
+    StorageData* storage;
+    FS_Error ret = storage_get_data(app, path, &storage);
+
+    do {
+        if(ret != FSE_OK) break;
+
+        // Digest may belong to contents that are already gone
+        if(storage_data_get_timestamp(storage) != timestamp) {
+            ret = FSE_DENIED;
+            break;
+        }
+
+        if(storage_path_already_open(path, storage)) {
+            ret = FSE_ALREADY_OPEN;
+            break;
+        }
+
+        ret = storage_index_set(storage, cstr_path_without_vfs_prefix(path), md5);
+    } while(false);
+
+    return ret;
+}
+
 /****************** Raw SD API ******************/
 // TODO FL-3521: think about implementing a custom storage API to split that kind of api linkage
 #include "storages/storage_ext.h"
 
+static FS_Error storage_process_common_stat_modified(
+    Storage* app,
+    FuriString* path,
+    FileInfo* fileinfo,
+    uint32_t* modified) {
+    StorageData* storage;
+    FS_Error ret = storage_get_data(app, path, &storage);
+
+    // Internal storage keeps no modification time
+    if(ret == FSE_OK && storage != &app->storage[ST_EXT]) {
+        ret = FSE_NOT_IMPLEMENTED;
+    }
+
+    if(ret == FSE_OK) {
+        FileInfo stat_fileinfo;
+        ret = sd_file_stat(storage, cstr_path_without_vfs_prefix(path), &stat_fileinfo, modified);
+        if(ret == FSE_OK && fileinfo != NULL) *fileinfo = stat_fileinfo;
+    }
+
+    return ret;
+}
+
 static FS_Error storage_process_sd_format(Storage* app) {
     FS_Error ret = FSE_OK;
 
@@ -652,6 +936,29 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         message->return_data->bool_value =
             storage_process_dir_rewind(app, message->data->file.file);
         break;
+    case StorageCommandFilePreallocate:
+        message->return_data->bool_value = storage_process_file_preallocate(
+            app, message->data->fpreallocate.file, message->data->fpreallocate.size);
+        break;
+    case StorageCommandFileLease:
+        message->return_data->bool_value =
+            storage_process_file_lease(app, message->data->file.file);
+        break;
+    case StorageCommandDirReadMany:
+        message->return_data->size_value = storage_process_dir_read_many(
+            app,
+            message->data->dread_many.file,
+            message->data->dread_many.items,
+            message->data->dread_many.count,
+            message->data->dread_many.filter);
+        break;
+    case StorageCommandFileBatch:
+        message->return_data->size_value = storage_process_file_batch(
+            app,
+            message->data->fbatch.file,
+            message->data->fbatch.ops,
+            message->data->fbatch.count);
+        break;
 
     // Common operations
     case StorageCommandCommonTimestamp:
@@ -664,7 +971,10 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         path = furi_string_alloc_set(message->data->cstat.path);
         storage_process_alias(app, path, message->data->cstat.thread_id, false);
         message->return_data->error_value =
-            storage_process_common_stat(app, path, message->data->cstat.fileinfo);
+            message->data->cstat.modified ?
+                storage_process_common_stat_modified(
+                    app, path, message->data->cstat.fileinfo, message->data->cstat.modified) :
+                storage_process_common_stat(app, path, message->data->cstat.fileinfo);
         break;
     case StorageCommandCommonRemove:
         path = furi_string_alloc_set(message->data->path.path);
@@ -720,6 +1030,34 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         break;
     }
 
+    case StorageCommandCommonRename: {
+        FuriString* old_path = furi_string_alloc_set(message->data->crename.old_path);
+        FuriString* new_path = furi_string_alloc_set(message->data->crename.new_path);
+        storage_path_trim_trailing_slashes(old_path);
+        storage_path_trim_trailing_slashes(new_path);
+        storage_process_alias(app, old_path, message->data->crename.thread_id, false);
+        storage_process_alias(app, new_path, message->data->crename.thread_id, true);
+        message->return_data->error_value =
+            storage_process_common_rename(app, old_path, new_path);
+        furi_string_free(old_path);
+        furi_string_free(new_path);
+        break;
+    }
+
+    // Index operations
+    case StorageCommandIndexGet:
+        path = furi_string_alloc_set(message->data->index_get.path);
+        storage_process_alias(app, path, message->data->index_get.thread_id, false);
+        message->return_data->error_value =
+            storage_process_index_get(app, path, message->data->index_get.md5);
+        break;
+    case StorageCommandIndexSet:
+        path = furi_string_alloc_set(message->data->index_set.path);
+        storage_process_alias(app, path, message->data->index_set.thread_id, false);
+        message->return_data->error_value = storage_process_index_set(
+            app, path, message->data->index_set.md5, message->data->index_set.timestamp);
+        break;
+
     // SD operations
     case StorageCommandSDFormat:
         message->return_data->error_value = storage_process_sd_format(app);
@@ -743,7 +1081,11 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         furi_string_free(path);
     }
 
-    api_lock_unlock(message->lock);
+    if(message->complete) {
+        message->complete(message->complete_context);
+    } else {
+        api_lock_unlock(message->lock);
+    }
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
@@ -0,0 +1,122 @@
+#include "storage_stat_cache.h"
+
+#include <ctype.h>
+#include <toolbox/crc32_calc.h>
+
+static bool storage_stat_cache_key(StorageStatCache* cache, const char* path) {
+    // FAT is case insensitive and ignores repeated and trailing slashes, and so are the keys
+    FuriString* key = cache->key;
+    furi_string_reset(key);
+
+    while(*path) {
+        while(*path == '/')
+            path++;
+        if(!*path) break;
+
+        const char* segment = path;
+        while(*path && *path != '/')
+            path++;
+
+        // Dot segments alias other paths, lookups through them are not cached
+        const size_t length = path - segment;
+        if(segment[0] == '.' && (length == 1 || (length == 2 && segment[1] == '.'))) {
+            return false;
+        }
+
+        furi_string_push_back(key, '/');
+        for(; segment != path; segment++) {
+            furi_string_push_back(key, tolower((unsigned char)*segment));
+        }
+    }
+
+    cache->key_crc = crc32_calc_buffer(0, furi_string_get_cstr(key), furi_string_size(key));
+    return true;
+}
+
+static StorageStatCacheEntry* storage_stat_cache_find(StorageStatCache* cache) {
+    for(size_t i = 0; i < STORAGE_STAT_CACHE_SIZE; i++) {
+        StorageStatCacheEntry* entry = &cache->entries[i];
+        if(entry->key && entry->key_crc == cache->key_crc &&
+           furi_string_equal(entry->key, cache->key)) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+void storage_stat_cache_init(StorageStatCache* cache) {
+    memset(cache->entries, 0, sizeof(cache->entries));
+    cache->next = 0;
+    cache->key = furi_string_alloc();
+    cache->key_crc = 0;
+}
+
+bool storage_stat_cache_get(
+    StorageStatCache* cache,
+    const char* path,
+    FileInfo* fileinfo,
+    FS_Error* error) {
+    if(!storage_stat_cache_key(cache, path)) return false;
+
+    const StorageStatCacheEntry* entry = storage_stat_cache_find(cache);
+    if(!entry) return false;
+
+    if(fileinfo) *fileinfo = entry->fileinfo;
+    *error = entry->error;
+
+    return true;
+}
+
+void storage_stat_cache_put(
+    StorageStatCache* cache,
+    const char* path,
+    const FileInfo* fileinfo,
+    FS_Error error) {
+    // Anything else may be a transient card error
+    if(error != FSE_OK && error != FSE_NOT_EXIST) return;
+    if(!storage_stat_cache_key(cache, path)) return;
+
+    StorageStatCacheEntry* entry = storage_stat_cache_find(cache);
+    if(!entry) {
+        // Round robin replacement, probes are usually not repeated in any particular order
+        entry = &cache->entries[cache->next];
+        cache->next = (cache->next + 1) % STORAGE_STAT_CACHE_SIZE;
+
+        if(entry->key) {
+            furi_string_set(entry->key, cache->key);
+        } else {
+            entry->key = furi_string_alloc_set(cache->key);
+        }
+        entry->key_crc = cache->key_crc;
+    }
+
+    entry->error = error;
+    entry->fileinfo = error == FSE_OK ? *fileinfo : (FileInfo){0};
+}
+
+void storage_stat_cache_invalidate(StorageStatCache* cache, const char* path) {
+    if(!storage_stat_cache_key(cache, path)) {
+        // Path cannot be matched against the keys, drop everything
+        storage_stat_cache_reset(cache);
+        return;
+    }
+
+    StorageStatCacheEntry* entry = storage_stat_cache_find(cache);
+    if(entry) {
+        furi_string_free(entry->key);
+        entry->key = NULL;
+    }
+}
+
+void storage_stat_cache_reset(StorageStatCache* cache) {
+    for(size_t i = 0; i < STORAGE_STAT_CACHE_SIZE; i++) {
+        StorageStatCacheEntry* entry = &cache->entries[i];
+        if(entry->key) {
+            furi_string_free(entry->key);
+            entry->key = NULL;
+        }
+    }
+
+    cache->next = 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <furi.h>
+#include "filesystem_api_defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STORAGE_STAT_CACHE_SIZE (16U)
+
+typedef struct {
+    FuriString* key; // NULL marks free entry
+    uint32_t key_crc;
+    FS_Error error;
+    FileInfo fileinfo;
+} StorageStatCacheEntry;
+
+typedef struct {
+    StorageStatCacheEntry entries[STORAGE_STAT_CACHE_SIZE];
+    size_t next;
+    FuriString* key;
+    uint32_t key_crc;
+} StorageStatCache;
+
+/* Stat cache functions run in storage thread, paths are given without vfs prefix */
+
+void storage_stat_cache_init(StorageStatCache* cache);
+bool storage_stat_cache_get(
+    StorageStatCache* cache,
+    const char* path,
+    FileInfo* fileinfo,
+    FS_Error* error);
+void storage_stat_cache_put(
+    StorageStatCache* cache,
+    const char* path,
+    const FileInfo* fileinfo,
+    FS_Error error);
+void storage_stat_cache_invalidate(StorageStatCache* cache, const char* path);
+void storage_stat_cache_reset(StorageStatCache* cache);
+
+#ifdef __cplusplus
+}
+#endif
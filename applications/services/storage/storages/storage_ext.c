@@ -1,6 +1,8 @@
 #include <fatfs.h>
 #include <furi_hal.h>
 #include <furi_hal_sd.h>
+#include <sector_cache.h>
+#include <toolbox/flash_kv.h>
 
 #include "sd_notify.h"
 #include "storage_ext.h"
@@ -8,7 +10,11 @@
 #include "../filesystem_api_internal.h"
 #include "../storage_internal_dirname_i.h"
 
-typedef FIL SDFile;
+typedef struct {
+    FIL fil;
+    bool preallocated; /**< Clusters are allocated past the data written so far */
+    FSIZE_t data_size; /**< Size of the written data while preallocated */
+} SDFile;
 typedef DIR SDDir;
 typedef FILINFO SDFileInfo;
 typedef FRESULT SDError;
@@ -21,12 +27,20 @@ typedef struct {
     FATFS* fs;
     const char* path;
     bool sd_was_present;
+    bool free_scan_pending; /**< Free space is not counted yet since mount */
 } SDData;
 
 static FS_Error storage_ext_parse_error(SDError error);
 
 /******************* Core Functions *******************/
 
+static void sd_pin_metadata_sectors(FATFS* fs) {
+    // FAT region and, for FAT12/16, fixed root directory lie between fatbase and database
+    if(fs->database > fs->fatbase) {
+        sector_cache_pin_range(fs->fatbase, fs->database - 1);
+    }
+}
+
 static bool sd_mount_card_internal(StorageData* storage, bool notify) {
     bool result = false;
     uint8_t counter = furi_hal_sd_max_mount_retry_count();
@@ -54,23 +68,17 @@ static bool sd_mount_card_internal(StorageData* storage, bool notify) {
             SDError status = f_mount(sd_data->fs, sd_data->path, 1);
 
             if(status == FR_OK || status == FR_NO_FILESYSTEM) {
-#ifndef FURI_RAM_EXEC
-                FATFS* fs;
-                uint32_t free_clusters;
-
-                status = f_getfree(sd_data->path, &free_clusters, &fs);
-#endif
-
-                if(status == FR_OK || status == FR_NO_FILESYSTEM) {
-                    result = true;
-                }
+                result = true;
 
                 if(status == FR_OK) {
                     storage->status = StorageStatusOK;
-                } else if(status == FR_NO_FILESYSTEM) {
-                    storage->status = StorageStatusNoFS;
+                    sd_pin_metadata_sectors(sd_data->fs);
+#ifndef FURI_RAM_EXEC
+                    // Free space count reads the whole FAT or allocation bitmap, done when idle
+                    sd_data->free_scan_pending = true;
+#endif
                 } else {
-                    storage->status = StorageStatusNotAccessible;
+                    storage->status = StorageStatusNoFS;
                 }
             } else {
                 storage->status = StorageStatusNotMounted;
@@ -160,14 +168,22 @@ FS_Error sd_unmount_card(StorageData* storage) {
 
     storage->status = StorageStatusNotReady;
     error = FR_DISK_ERR;
+    storage_stat_cache_reset(&storage->stat_cache);
+
+    // Leased files are accessed without the storage thread
+    storage_data_lease_revoke(storage);
 
     // TODO FL-3522: do i need to close the files?
+    furi_hal_sd_flush();
     f_mount(0, sd_data->path, 0);
+    sector_cache_pin_range(0, 0);
 
     return storage_ext_parse_error(error);
 }
 
 FS_Error sd_mount_card(StorageData* storage, bool notify) {
+    // A different card may have been inserted
+    storage_stat_cache_reset(&storage->stat_cache);
     sd_mount_card_internal(storage, notify);
     FS_Error error;
 
@@ -177,11 +193,17 @@ FS_Error sd_mount_card(StorageData* storage, bool notify) {
 
     } else {
         FURI_LOG_I(TAG, "card mounted");
+        static bool boot_traced = false;
+        if(!boot_traced) {
+            furi_boot_trace_mark("sd_mount");
+            boot_traced = true;
+        }
 
 #ifndef FURI_RAM_EXEC
         if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagStorageFormatInternal)) {
             FURI_LOG_I(TAG, "deleting internal storage directory");
             error = sd_remove_recursive(STORAGE_INTERNAL_DIR_NAME) ? FSE_OK : FSE_INTERNAL;
+            flash_kv_format();
         } else {
             error = FSE_OK;
         }
@@ -213,6 +235,9 @@ FS_Error sd_format_card(StorageData* storage) {
     SDData* sd_data = storage->data;
     SDError error;
 
+    storage_data_lease_revoke(storage);
+    storage_stat_cache_reset(&storage->stat_cache);
+
     work_area = malloc(_MAX_SS);
     error = f_mkfs(sd_data->path, FM_ANY, 0, work_area, _MAX_SS);
     free(work_area);
@@ -227,6 +252,7 @@ FS_Error sd_format_card(StorageData* storage) {
         error = f_mount(sd_data->fs, sd_data->path, 1);
         if(error != FR_OK) break;
         storage->status = StorageStatusOK;
+        sd_pin_metadata_sectors(sd_data->fs);
     } while(false);
 
     return storage_ext_parse_error(error);
@@ -314,6 +340,24 @@ FS_Error sd_card_info(StorageData* storage, SDInfo* sd_info) {
     return storage_ext_parse_error(error);
 }
 
+FS_Error
+    sd_file_stat(StorageData* storage, const char* path, FileInfo* fileinfo, uint32_t* modified) {
+    UNUSED(storage);
+    SDFileInfo _fileinfo;
+    SDError result = f_stat(path, &_fileinfo);
+
+    if(result == FR_OK) {
+        fileinfo->size = _fileinfo.fsize;
+        fileinfo->flags = 0;
+
+        if(_fileinfo.fattrib & AM_DIR) fileinfo->flags |= FSF_DIRECTORY;
+
+        *modified = (uint32_t)_fileinfo.fdate << 16 | _fileinfo.ftime;
+    }
+
+    return storage_ext_parse_error(result);
+}
+
 static void storage_ext_tick_internal(StorageData* storage, bool notify) {
     SDData* sd_data = storage->data;
 
@@ -344,8 +388,37 @@ static void storage_ext_tick_internal(StorageData* storage, bool notify) {
     }
 }
 
+#ifndef FURI_RAM_EXEC
+static void storage_ext_scan_free_space(StorageData* storage) {
+    SDData* sd_data = storage->data;
+    FATFS* fs;
+    DWORD free_clusters;
+
+    sd_data->free_scan_pending = false;
+    SDError status = f_getfree(sd_data->path, &free_clusters, &fs);
+    if(status == FR_OK) {
+        FURI_LOG_I(TAG, "free space counted: %lu clusters", free_clusters);
+    } else {
+        FURI_LOG_E(TAG, "free space scan failed: %d", status);
+        storage->status = StorageStatusNotAccessible;
+    }
+}
+#endif
+
 static void storage_ext_tick(StorageData* storage) {
     storage_ext_tick_internal(storage, true);
+
+#ifndef FURI_RAM_EXEC
+    SDData* sd_data = storage->data;
+    if(storage->status == StorageStatusOK && sd_data->free_scan_pending) {
+        storage_ext_scan_free_space(storage);
+    }
+#endif
+
+    // Storage is idle, good time to write back deferred sectors
+    if(storage->status == StorageStatusOK && furi_hal_sd_is_write_back_enabled()) {
+        furi_hal_sd_flush();
+    }
 }
 
 /****************** Common Functions ******************/
@@ -387,6 +460,16 @@ static FS_Error storage_ext_parse_error(SDError error) {
 
 /******************* File Functions *******************/
 
+static void storage_ext_file_trim_preallocated(SDFile* file_data) {
+    if(file_data->preallocated) {
+        // Give back the clusters that were never written
+        if(f_lseek(&file_data->fil, file_data->data_size) == FR_OK) {
+            f_truncate(&file_data->fil);
+        }
+        file_data->preallocated = false;
+    }
+}
+
 static bool storage_ext_file_open(
     void* ctx,
     File* file,
@@ -405,9 +488,10 @@ static bool storage_ext_file_open(
     if(open_mode & FSOM_CREATE_ALWAYS) _mode |= FA_CREATE_ALWAYS;
 
     SDFile* file_data = malloc(sizeof(SDFile));
+    file_data->preallocated = false;
     storage_set_storage_file_data(file, file_data, storage);
 
-    file->internal_error_id = f_open(file_data, path, _mode);
+    file->internal_error_id = f_open(&file_data->fil, path, _mode);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return file->error_id == FSE_OK;
 }
@@ -415,52 +499,82 @@ static bool storage_ext_file_open(
 static bool storage_ext_file_close(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
-    file->internal_error_id = f_close(file_data);
+    storage_ext_file_trim_preallocated(file_data);
+    file->internal_error_id = f_close(&file_data->fil);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     free(file_data);
     storage_set_storage_file_data(file, NULL, storage);
     return file->error_id == FSE_OK;
 }
 
-static uint16_t
-    storage_ext_file_read(void* ctx, File* file, void* buff, uint16_t const bytes_to_read) {
-    StorageData* storage = ctx;
-    SDFile* file_data = storage_get_storage_file_data(file, storage);
+uint16_t storage_ext_file_data_read(
+    File* file,
+    void* file_data,
+    void* buff,
+    uint16_t const bytes_to_read) {
+    SDFile* sd_file = file_data;
     uint16_t bytes_read = 0;
-    file->internal_error_id = f_read(file_data, buff, bytes_to_read, &bytes_read);
+    uint16_t bytes_available = bytes_to_read;
+    if(sd_file->preallocated) {
+        // Don't read the garbage past the written data
+        const FSIZE_t position = f_tell(&sd_file->fil);
+        bytes_available = (position < sd_file->data_size) ?
+                              MIN(sd_file->data_size - position, (FSIZE_t)bytes_to_read) :
+                              0;
+    }
+    file->internal_error_id = f_read(&sd_file->fil, buff, bytes_available, &bytes_read);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return bytes_read;
 }
 
-static uint16_t
-    storage_ext_file_write(void* ctx, File* file, const void* buff, uint16_t const bytes_to_write) {
+uint16_t storage_ext_file_data_write(
+    File* file,
+    void* file_data,
+    const void* buff,
+    uint16_t const bytes_to_write) {
 #ifdef FURI_RAM_EXEC
-    UNUSED(ctx);
     UNUSED(file);
+    UNUSED(file_data);
     UNUSED(buff);
     UNUSED(bytes_to_write);
     return FSE_NOT_READY;
 #else
-    StorageData* storage = ctx;
-    SDFile* file_data = storage_get_storage_file_data(file, storage);
+    SDFile* sd_file = file_data;
     uint16_t bytes_written = 0;
-    file->internal_error_id = f_write(file_data, buff, bytes_to_write, &bytes_written);
+    file->internal_error_id = f_write(&sd_file->fil, buff, bytes_to_write, &bytes_written);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
+    if(sd_file->preallocated) {
+        sd_file->data_size = MAX(sd_file->data_size, f_tell(&sd_file->fil));
+    }
     return bytes_written;
 #endif
 }
 
+static uint16_t
+    storage_ext_file_read(void* ctx, File* file, void* buff, uint16_t const bytes_to_read) {
+    StorageData* storage = ctx;
+    SDFile* file_data = storage_get_storage_file_data(file, storage);
+    return storage_ext_file_data_read(file, file_data, buff, bytes_to_read);
+}
+
+static uint16_t
+    storage_ext_file_write(void* ctx, File* file, const void* buff, uint16_t const bytes_to_write) {
+    StorageData* storage = ctx;
+    SDFile* file_data = storage_get_storage_file_data(file, storage);
+    return storage_ext_file_data_write(file, file_data, buff, bytes_to_write);
+}
+
 static bool
     storage_ext_file_seek(void* ctx, File* file, const uint32_t offset, const bool from_start) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
     if(from_start) {
-        file->internal_error_id = f_lseek(file_data, offset);
+        file->internal_error_id = f_lseek(&file_data->fil, offset);
     } else {
-        uint64_t position = f_tell(file_data);
+        uint64_t position = f_tell(&file_data->fil);
         position += offset;
-        file->internal_error_id = f_lseek(file_data, position);
+        file->internal_error_id = f_lseek(&file_data->fil, position);
     }
 
     file->error_id = storage_ext_parse_error(file->internal_error_id);
@@ -472,7 +586,7 @@ static uint64_t storage_ext_file_tell(void* ctx, File* file) {
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
     uint64_t position = 0;
-    position = f_tell(file_data);
+    position = f_tell(&file_data->fil);
     file->error_id = FSE_OK;
     return position;
 }
@@ -486,8 +600,12 @@ static bool storage_ext_file_truncate(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
-    file->internal_error_id = f_truncate(file_data);
+    file->internal_error_id = f_truncate(&file_data->fil);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
+    if(file->error_id == FSE_OK) {
+        // Everything past the access position is gone, including the preallocated clusters
+        file_data->preallocated = false;
+    }
     return file->error_id == FSE_OK;
 #endif
 }
@@ -501,18 +619,44 @@ static bool storage_ext_file_sync(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
-    file->internal_error_id = f_sync(file_data);
+    file->internal_error_id = f_sync(&file_data->fil);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return file->error_id == FSE_OK;
 #endif
 }
 
+static bool storage_ext_file_preallocate(void* ctx, File* file, const uint64_t size) {
+#ifdef FURI_RAM_EXEC
+    UNUSED(ctx);
+    UNUSED(file);
+    UNUSED(size);
+    return false;
+#else
+    StorageData* storage = ctx;
+    SDFile* file_data = storage_get_storage_file_data(file, storage);
+
+    if((FSIZE_t)size != size) {
+        file->internal_error_id = FR_INVALID_PARAMETER;
+    } else {
+        // Fails unless the file is empty and a contiguous free area is found
+        file->internal_error_id = f_expand(&file_data->fil, size, 1);
+    }
+
+    file->error_id = storage_ext_parse_error(file->internal_error_id);
+    if(file->error_id == FSE_OK) {
+        file_data->preallocated = true;
+        file_data->data_size = 0;
+    }
+    return file->error_id == FSE_OK;
+#endif
+}
+
 static uint64_t storage_ext_file_size(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
     uint64_t size = 0;
-    size = f_size(file_data);
+    size = file_data->preallocated ? file_data->data_size : f_size(&file_data->fil);
     file->error_id = FSE_OK;
     return size;
 }
@@ -521,7 +665,8 @@ static bool storage_ext_file_eof(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
 
-    bool eof = f_eof(file_data);
+    bool eof = file_data->preallocated ? f_tell(&file_data->fil) >= file_data->data_size :
+                                         f_eof(&file_data->fil);
     file->internal_error_id = 0;
     file->error_id = FSE_OK;
     return eof;
@@ -627,6 +772,18 @@ static FS_Error storage_ext_common_mkdir(void* ctx, const char* path) {
 #endif
 }
 
+static FS_Error storage_ext_common_rename(void* ctx, const char* old_path, const char* new_path) {
+    UNUSED(ctx);
+#ifdef FURI_RAM_EXEC
+    UNUSED(old_path);
+    UNUSED(new_path);
+    return FSE_NOT_READY;
+#else
+    SDError result = f_rename(old_path, new_path);
+    return storage_ext_parse_error(result);
+#endif
+}
+
 static FS_Error storage_ext_common_fs_info(
     void* ctx,
     const char* fs_path,
@@ -692,6 +849,7 @@ static const FS_Api fs_api = {
             .size = storage_ext_file_size,
             .sync = storage_ext_file_sync,
             .eof = storage_ext_file_eof,
+            .preallocate = storage_ext_file_preallocate,
         },
     .dir =
         {
@@ -705,6 +863,7 @@ static const FS_Api fs_api = {
             .stat = storage_ext_common_stat,
             .mkdir = storage_ext_common_mkdir,
             .remove = storage_ext_common_remove,
+            .rename = storage_ext_common_rename,
             .fs_info = storage_ext_common_fs_info,
             .equivalent_path = storage_ext_common_equivalent_path,
         },
@@ -717,13 +876,16 @@ void storage_ext_init(StorageData* storage) {
     sd_data->fs = &fatfs_object;
     sd_data->path = "0:/";
     sd_data->sd_was_present = true;
+    sd_data->free_scan_pending = false;
 
     storage->data = sd_data;
     storage->api.tick = storage_ext_tick;
     storage->fs_api = &fs_api;
 
     furi_hal_sd_presence_init();
+}
 
+void storage_ext_start(StorageData* storage) {
     // do not notify on first launch, notifications app is waiting for our thread to read settings
     storage_ext_tick_internal(storage, false);
 #ifndef FURI_RAM_EXEC
@@ -8,10 +8,26 @@ extern "C" {
 #endif
 
 void storage_ext_init(StorageData* storage);
+/* Initial card mount, must run in storage thread before any request is served */
+void storage_ext_start(StorageData* storage);
 FS_Error sd_mount_card(StorageData* storage, bool notify);
 FS_Error sd_unmount_card(StorageData* storage);
 FS_Error sd_format_card(StorageData* storage);
 FS_Error sd_card_info(StorageData* storage, SDInfo* sd_info);
+FS_Error
+    sd_file_stat(StorageData* storage, const char* path, FileInfo* fileinfo, uint32_t* modified);
+
+/* Direct access to an open file, bypassing the storage file list */
+uint16_t storage_ext_file_data_read(
+    File* file,
+    void* file_data,
+    void* buff,
+    uint16_t const bytes_to_read);
+uint16_t storage_ext_file_data_write(
+    File* file,
+    void* file_data,
+    const void* buff,
+    uint16_t const bytes_to_write);
 #ifdef __cplusplus
 }
 #endif
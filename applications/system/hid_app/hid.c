@@ -168,6 +168,11 @@ void hid_free(Hid* app) {
     free(app);
 }
 
+// Short connection interval while app is running, default profile is restored on exit
+static const BleProfileHidParams ble_hid_params = {
+    .low_latency = true,
+};
+
 int32_t hid_usb_app(void* p) {
     UNUSED(p);
     Hid* app = hid_alloc();
@@ -176,7 +181,9 @@ int32_t hid_usb_app(void* p) {
 
     FuriHalUsbInterface* usb_mode_prev = furi_hal_usb_get_config();
     furi_hal_usb_unlock();
-    furi_check(furi_hal_usb_set_config(&usb_hid, NULL) == true);
+    // Fastest polling for smooth pointer movement
+    FuriHalUsbHidConfig usb_hid_cfg = {.interval = 1};
+    furi_check(furi_hal_usb_set_config(&usb_hid, &usb_hid_cfg) == true);
 
     dolphin_deed(DolphinDeedPluginStart);
 
@@ -214,7 +221,7 @@ int32_t hid_ble_app(void* p) {
 
     furi_record_close(RECORD_STORAGE);
 
-    app->ble_hid_profile = bt_profile_start(app->bt, ble_profile_hid, NULL);
+    app->ble_hid_profile = bt_profile_start(app->bt, ble_profile_hid, (void*)&ble_hid_params);
 
     furi_check(app->ble_hid_profile);
 
@@ -0,0 +1,17 @@
+let bytes = require("bytes");
+
+let frame = bytes.fromHex("30 04");
+print("frame:", bytes.toHex(frame));
+print("crc16 iso14443a:", bytes.crc16(frame, "iso14443a"));
+print("crc32:", bytes.crc32(frame));
+
+let packed = bytes.pack(">BHi", [1, 0x0203, -4]);
+print("packed:", bytes.toHex(packed));
+let fields = bytes.unpack(">BHi", packed);
+print("unpacked:", fields[0], fields[1], fields[2]);
+
+print("indexOf 0x03:", bytes.indexOf(packed, 0x03));
+print("bits 8..16:", bytes.getBits(packed, 8, 8));
+
+bytes.xor(packed, bytes.fromHex("FF"));
+print("xor:", bytes.toHex(packed));
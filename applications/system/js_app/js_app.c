@@ -162,6 +162,10 @@ static void js_cli_callback(JsThreadEvent event, const char* msg, void* context)
         js_cli_print(ctx, msg);
         js_cli_print(ctx, "\r\n");
         break;
+    case JsThreadEventGcStats:
+        js_cli_print(ctx, msg);
+        js_cli_print(ctx, "\r\n");
+        break;
     case JsThreadEventDone:
         js_cli_print(ctx, "Script done!\r\n");
 
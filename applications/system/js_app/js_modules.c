@@ -16,9 +16,14 @@
 
 typedef struct {
     FuriString* name;
-    const JsModuleConstructor create;
-    const JsModuleDestructor destroy;
+    JsModuleConstructor create;
+    JsModuleDestructor destroy;
     void* context;
+    JsModules* owner;
+    // External module that is required, but not loaded yet
+    bool pending;
+    // Module loaded before its lazy object was accessed, owned until taken over
+    mjs_val_t object;
 } JsModuleData;
 
 // not using:
@@ -27,7 +32,8 @@ typedef struct {
 //   - an rbtree because i deemed it more tedious to implement, and with the
 //     amount of modules in use (under 10 in the overwhelming majority of cases)
 //     i bet it's going to be slower than a plain array
-ARRAY_DEF(JsModuleArray, JsModuleData, M_POD_OPLIST);
+// entries are allocated one by one, so that pending modules can point to them
+ARRAY_DEF(JsModuleArray, JsModuleData*, M_PTR_OPLIST);
 #define M_OPL_JsModuleArray_t() ARRAY_OPLIST(JsModuleArray)
 
 static const JsModuleDescriptor modules_builtin[] = {
@@ -39,9 +45,11 @@ static const JsModuleDescriptor modules_builtin[] = {
 
 struct JsModules {
     struct mjs* mjs;
+    // In require order
     JsModuleArray_t modules;
     PluginManager* plugin_manager;
     CompositeApiResolver* resolver;
+    Storage* storage;
 };
 
 JsModules* js_modules_create(struct mjs* mjs, CompositeApiResolver* resolver) {
@@ -53,30 +61,148 @@ JsModules* js_modules_create(struct mjs* mjs, CompositeApiResolver* resolver) {
         PLUGIN_APP_ID, PLUGIN_API_VERSION, composite_api_resolver_get(resolver));
 
     modules->resolver = resolver;
+    modules->storage = furi_record_open(RECORD_STORAGE);
 
     return modules;
 }
 
 void js_modules_destroy(JsModules* instance) {
-    for
-        M_EACH(module, instance->modules, JsModuleArray_t) {
-            FURI_LOG_T(TAG, "Tearing down %s", furi_string_get_cstr(module->name));
-            if(module->destroy) module->destroy(module->context);
-            furi_string_free(module->name);
-        }
+    // Reverse require order: modules are torn down before the ones they depend on
+    for(size_t i = JsModuleArray_size(instance->modules); i-- > 0;) {
+        JsModuleData* module = *JsModuleArray_get(instance->modules, i);
+        FURI_LOG_T(TAG, "Tearing down %s", furi_string_get_cstr(module->name));
+        if(module->destroy) module->destroy(module->context);
+        furi_string_free(module->name);
+        free(module);
+    }
     plugin_manager_free(instance->plugin_manager);
     JsModuleArray_clear(instance->modules);
+    furi_record_close(RECORD_STORAGE);
     free(instance);
 }
 
 JsModuleData* js_find_loaded_module(JsModules* instance, const char* name) {
     for
         M_EACH(module, instance->modules, JsModuleArray_t) {
-            if(furi_string_cmp_str(module->name, name) == 0) return module;
+            if(furi_string_cmp_str((*module)->name, name) == 0) return *module;
         }
     return NULL;
 }
 
+static void
+    js_module_get_path(FuriString* module_path, FuriString* deslashed_name, const char* name) {
+    furi_string_set_str(deslashed_name, name);
+    furi_string_replace_all_str(deslashed_name, "/", "__");
+    furi_string_printf(
+        module_path, "%s/js_%s.fal", MODULES_PATH, furi_string_get_cstr(deslashed_name));
+}
+
+static bool js_module_load_external(JsModuleData* module) {
+    JsModules* modules = module->owner;
+    const char* name = furi_string_get_cstr(module->name);
+    bool loaded = false;
+
+    FuriString* deslashed_name = furi_string_alloc();
+    FuriString* module_path = furi_string_alloc();
+    js_module_get_path(module_path, deslashed_name, name);
+    FURI_LOG_I(TAG, "Loading external module %s from %s", name, furi_string_get_cstr(module_path));
+    do {
+        uint32_t plugin_cnt_last = plugin_manager_get_count(modules->plugin_manager);
+        PluginManagerError load_error = plugin_manager_load_single(
+            modules->plugin_manager, furi_string_get_cstr(module_path));
+        if(load_error != PluginManagerErrorNone) {
+            FURI_LOG_E(
+                TAG,
+                "Module %s load error. It may depend on other modules that are not yet loaded.",
+                name);
+            break;
+        }
+        const JsModuleDescriptor* plugin =
+            plugin_manager_get_ep(modules->plugin_manager, plugin_cnt_last);
+        furi_assert(plugin);
+
+        if(furi_string_cmp_str(deslashed_name, plugin->name) != 0) {
+            FURI_LOG_E(TAG, "Module name mismatch %s", plugin->name);
+            break;
+        }
+        module->create = plugin->create;
+        module->destroy = plugin->destroy;
+
+        if(plugin->api_interface) {
+            FURI_LOG_I(TAG, "Added module API to composite resolver: %s", plugin->name);
+            composite_api_resolver_add(modules->resolver, plugin->api_interface);
+        }
+
+        loaded = true;
+    } while(0);
+    furi_string_free(module_path);
+    furi_string_free(deslashed_name);
+
+    return loaded;
+}
+
+static mjs_val_t js_module_instantiate(JsModuleData* module) {
+    mjs_val_t module_object = MJS_UNDEFINED;
+    if(module->create) {
+        module->context = module->create(module->owner->mjs, &module_object, module->owner);
+    }
+    return module_object;
+}
+
+static mjs_val_t js_module_load_pending(JsModuleData* module);
+
+/**
+ * @brief Loads a pending module before its lazy object is accessed
+ *
+ * Module object is kept alive until the lazy object takes it over.
+ */
+static mjs_val_t js_module_load_ahead(JsModuleData* module) {
+    module->object = js_module_load_pending(module);
+    mjs_own(module->owner->mjs, &module->object);
+    return module->object;
+}
+
+/**
+ * @brief Loads a pending module and runs its constructor
+ *
+ * Modules required before it are loaded first, in require order: module ELF
+ * and constructor may use API and contexts of the modules required earlier.
+ */
+static mjs_val_t js_module_load_pending(JsModuleData* module) {
+    JsModules* modules = module->owner;
+    struct mjs* mjs = modules->mjs;
+
+    for
+        M_EACH(earlier, modules->modules, JsModuleArray_t) {
+            if(*earlier == module) break;
+            if(!(*earlier)->pending) continue;
+            if(js_module_load_ahead(*earlier) == MJS_UNDEFINED) return MJS_UNDEFINED;
+        }
+
+    module->pending = false;
+    mjs_val_t module_object = MJS_UNDEFINED;
+    if(js_module_load_external(module)) {
+        module_object = js_module_instantiate(module);
+    }
+    if(module_object == MJS_UNDEFINED) {
+        const char* name = furi_string_get_cstr(module->name);
+        mjs_prepend_errorf(mjs, MJS_BAD_ARGS_ERROR, "\"%s\" module load fail", name);
+    }
+
+    return module_object;
+}
+
+static mjs_val_t js_module_lazy_loader(struct mjs* mjs, void* context) {
+    JsModuleData* module = context;
+    if(module->pending) return js_module_load_pending(module);
+
+    // Loaded ahead, by a module required later or through js_module_get()
+    mjs_val_t module_object = module->object;
+    mjs_disown(mjs, &module->object);
+    module->object = MJS_UNDEFINED;
+    return module_object;
+}
+
 mjs_val_t js_module_require(JsModules* modules, const char* name, size_t name_len) {
     // Ignore the initial part of the module name
     const char* optional_module_prefix = "@" JS_SDK_VENDOR "/fz-sdk/";
@@ -92,6 +218,11 @@ mjs_val_t js_module_require(JsModules* modules, const char* name, size_t name_le
         return MJS_UNDEFINED;
     }
 
+    module_inst = malloc(sizeof(JsModuleData));
+    module_inst->name = furi_string_alloc_set_str(name);
+    module_inst->owner = modules;
+    module_inst->object = MJS_UNDEFINED;
+
     bool module_found = false;
     // Check built-in modules
     for(size_t i = 0; i < COUNT_OF(modules_builtin); i++) { //-V1008
@@ -102,72 +233,34 @@ mjs_val_t js_module_require(JsModules* modules, const char* name, size_t name_le
         }
 
         if(strncmp(name, modules_builtin[i].name, name_compare_len) == 0) {
-            JsModuleData module = {
-                .create = modules_builtin[i].create,
-                .destroy = modules_builtin[i].destroy,
-                .name = furi_string_alloc_set_str(name),
-            };
-            JsModuleArray_push_at(modules->modules, 0, module);
+            module_inst->create = modules_builtin[i].create;
+            module_inst->destroy = modules_builtin[i].destroy;
             module_found = true;
             FURI_LOG_I(TAG, "Using built-in module %s", name);
             break;
         }
     }
 
-    // External module load
-    if(!module_found) {
-        FuriString* deslashed_name = furi_string_alloc_set_str(name);
-        furi_string_replace_all_str(deslashed_name, "/", "__");
-        FuriString* module_path = furi_string_alloc();
-        furi_string_printf(
-            module_path, "%s/js_%s.fal", MODULES_PATH, furi_string_get_cstr(deslashed_name));
-        FURI_LOG_I(
-            TAG, "Loading external module %s from %s", name, furi_string_get_cstr(module_path));
-        do {
-            uint32_t plugin_cnt_last = plugin_manager_get_count(modules->plugin_manager);
-            PluginManagerError load_error = plugin_manager_load_single(
-                modules->plugin_manager, furi_string_get_cstr(module_path));
-            if(load_error != PluginManagerErrorNone) {
-                FURI_LOG_E(
-                    TAG,
-                    "Module %s load error. It may depend on other modules that are not yet loaded.",
-                    name);
-                break;
-            }
-            const JsModuleDescriptor* plugin =
-                plugin_manager_get_ep(modules->plugin_manager, plugin_cnt_last);
-            furi_assert(plugin);
-
-            if(furi_string_cmp_str(deslashed_name, plugin->name) != 0) {
-                FURI_LOG_E(TAG, "Module name mismatch %s", plugin->name);
-                break;
-            }
-            JsModuleData module = {
-                .create = plugin->create,
-                .destroy = plugin->destroy,
-                .name = furi_string_alloc_set_str(name),
-            };
-            JsModuleArray_push_at(modules->modules, 0, module);
-
-            if(plugin->api_interface) {
-                FURI_LOG_I(TAG, "Added module API to composite resolver: %s", plugin->name);
-                composite_api_resolver_add(modules->resolver, plugin->api_interface);
-            }
-
-            module_found = true;
-        } while(0);
-        furi_string_free(module_path);
-        furi_string_free(deslashed_name);
-    }
-
-    // Run module constructor
     mjs_val_t module_object = MJS_UNDEFINED;
     if(module_found) {
-        module_inst = js_find_loaded_module(modules, name);
-        furi_assert(module_inst);
-        if(module_inst->create) { //-V779
-            module_inst->context = module_inst->create(modules->mjs, &module_object, modules);
+        JsModuleArray_push_back(modules->modules, module_inst);
+        module_object = js_module_instantiate(module_inst);
+    } else {
+        // External module is loaded on first property access, only its file is checked here
+        FuriString* deslashed_name = furi_string_alloc();
+        FuriString* module_path = furi_string_alloc();
+        js_module_get_path(module_path, deslashed_name, name);
+        if(storage_file_exists(modules->storage, furi_string_get_cstr(module_path))) {
+            module_inst->pending = true;
+            JsModuleArray_push_back(modules->modules, module_inst);
+            module_object = mjs_mk_lazy_object(modules->mjs, js_module_lazy_loader, module_inst);
+        } else {
+            FURI_LOG_E(TAG, "Module %s not found", name);
+            furi_string_free(module_inst->name);
+            free(module_inst);
         }
+        furi_string_free(module_path);
+        furi_string_free(deslashed_name);
     }
 
     if(module_object == MJS_UNDEFINED) { //-V547
@@ -178,9 +271,10 @@ mjs_val_t js_module_require(JsModules* modules, const char* name, size_t name_le
 }
 
 void* js_module_get(JsModules* modules, const char* name) {
-    FuriString* module_name = furi_string_alloc_set_str(name);
     JsModuleData* module_inst = js_find_loaded_module(modules, name);
-    furi_string_free(module_name);
+    if(module_inst && module_inst->pending) {
+        js_module_load_ahead(module_inst);
+    }
     return module_inst ? module_inst->context : NULL;
 }
 
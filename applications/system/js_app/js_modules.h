@@ -11,7 +11,7 @@
 
 #define JS_SDK_VENDOR "flipperdevices"
 #define JS_SDK_MAJOR  0
-#define JS_SDK_MINOR  1
+#define JS_SDK_MINOR  2
 
 /**
  * @brief Returns the foreign pointer in `obj["_"]`
@@ -159,6 +159,47 @@ static void js_delay(struct mjs* mjs) {
     mjs_return(mjs, MJS_UNDEFINED);
 }
 
+static void js_gc_stats(struct mjs* mjs) {
+    struct mjs_gc_stats stats;
+    mjs_get_gc_stats(mjs, &stats);
+
+    mjs_val_t result = mjs_mk_object(mjs);
+    JS_ASSIGN_MULTI(mjs, result) {
+        JS_FIELD("count", mjs_mk_number(mjs, stats.count));
+        JS_FIELD("lastPauseUs", mjs_mk_number(mjs, stats.last_pause_us));
+        JS_FIELD("maxPauseUs", mjs_mk_number(mjs, stats.max_pause_us));
+        JS_FIELD("totalPauseUs", mjs_mk_number(mjs, stats.total_pause_us));
+        JS_FIELD("objectsUsed", mjs_mk_number(mjs, stats.objects_used));
+        JS_FIELD("objectsTotal", mjs_mk_number(mjs, stats.objects_total));
+        JS_FIELD("propertiesUsed", mjs_mk_number(mjs, stats.properties_used));
+        JS_FIELD("propertiesTotal", mjs_mk_number(mjs, stats.properties_total));
+        JS_FIELD("stringsUsed", mjs_mk_number(mjs, stats.strings_used));
+        JS_FIELD("stringsSize", mjs_mk_number(mjs, stats.strings_size));
+    }
+    mjs_return(mjs, result);
+}
+
+static void js_gc_stats_report(JsThread* worker, struct mjs* mjs) {
+    struct mjs_gc_stats stats;
+    mjs_get_gc_stats(mjs, &stats);
+
+    FuriString* report = furi_string_alloc_printf(
+        "GC: %lu runs, pause max %lu us, total %lu us; "
+        "objects %zu/%zu, properties %zu/%zu, strings %zu/%zu bytes",
+        stats.count,
+        stats.max_pause_us,
+        (uint32_t)stats.total_pause_us,
+        stats.objects_used,
+        stats.objects_total,
+        stats.properties_used,
+        stats.properties_total,
+        stats.strings_used,
+        stats.strings_size);
+    FURI_LOG_I(TAG, "%s", furi_string_get_cstr(report));
+    worker->app_callback(JsThreadEventGcStats, furi_string_get_cstr(report), worker->context);
+    furi_string_free(report);
+}
+
 static void* js_dlsym(void* handle, const char* name) {
     CompositeApiResolver* resolver = handle;
     Elf32_Addr addr = 0;
@@ -268,6 +309,7 @@ static int32_t js_thread(void* arg) {
     JS_ASSIGN_MULTI(mjs, global) {
         JS_FIELD("print", MJS_MK_FN(js_print));
         JS_FIELD("delay", MJS_MK_FN(js_delay));
+        JS_FIELD("gcStats", MJS_MK_FN(js_gc_stats));
         JS_FIELD("parseInt", MJS_MK_FN(js_parse_int));
         JS_FIELD("ffi_address", MJS_MK_FN(js_ffi_address));
         JS_FIELD("require", MJS_MK_FN(js_require));
@@ -291,8 +333,15 @@ static int32_t js_thread(void* arg) {
 
     mjs_set_exec_flags_poller(mjs, js_exit_flag_poll);
 
+    // Keep parsed scripts as .jsc next to them, so that unchanged ones start without parsing
+    mjs_set_generate_jsc(mjs, 1);
+
     mjs_err_t err = mjs_exec_file(mjs, furi_string_get_cstr(worker->path), NULL);
 
+    if(worker->app_callback) {
+        js_gc_stats_report(worker, mjs);
+    }
+
 #ifdef JS_DEBUG
     if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
         FuriString* dump_path = furi_string_alloc_set(worker->path);
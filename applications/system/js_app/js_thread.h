@@ -11,6 +11,7 @@ typedef enum {
     JsThreadEventError,
     JsThreadEventPrint,
     JsThreadEventErrorTrace,
+    JsThreadEventGcStats,
 } JsThreadEvent;
 
 typedef void (*JsThreadCallback)(JsThreadEvent event, const char* msg, void* context);
@@ -0,0 +1,505 @@
+#include "../js_modules.h" // IWYU pragma: keep
+#include <bit_lib/bit_lib.h>
+#include <toolbox/crc32_calc.h>
+#include <toolbox/hex.h>
+
+#define TAG "JsBytes"
+
+// Upper bound of a single repeat count in pack/unpack format strings
+#define JS_BYTES_FORMAT_COUNT_MAX (0xFFFFU)
+
+typedef struct {
+    uint8_t* data;
+    size_t len;
+} JsBytesBuf;
+
+static void js_bytes_to_buf(struct mjs* mjs, mjs_val_t* in, void* out, const void* extra) {
+    UNUSED(extra);
+    JsBytesBuf* buf = out;
+    buf->data = (uint8_t*)mjs_typed_array_get_ptr(mjs, *in, &buf->len);
+}
+#define JS_ARG_BUF(out) \
+    ((_js_arg_decl){out, mjs_is_typed_array, js_bytes_to_buf, "ArrayBuffer", NULL, NULL})
+
+// ---=== hex ===---
+
+static void js_bytes_to_hex(struct mjs* mjs) {
+    JsBytesBuf buf;
+    JS_FETCH_ARGS_OR_RETURN(mjs, JS_EXACTLY, JS_ARG_BUF(&buf));
+
+    // Two chars per byte, one temporary copy instead of a string concatenation per byte
+    char* hex = malloc(buf.len * 2 + 1);
+    uint8_to_hex_chars(buf.data, (uint8_t*)hex, buf.len * 2);
+    mjs_val_t result = mjs_mk_string(mjs, hex, buf.len * 2, true);
+    free(hex);
+
+    mjs_return(mjs, result);
+}
+
+static void js_bytes_from_hex(struct mjs* mjs) {
+    const char* str;
+    JS_FETCH_ARGS_OR_RETURN(mjs, JS_EXACTLY, JS_ARG_STR(&str));
+
+    size_t digits = 0;
+    for(const char* c = str; *c; c++) {
+        if(*c != ' ' && *c != ':') digits++;
+    }
+    if(digits % 2) {
+        JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "odd number of hex digits");
+    }
+
+    // Strings are not kept with array buffers, str stays valid
+    mjs_val_t result = mjs_mk_array_buf(mjs, NULL, digits / 2);
+    uint8_t* out = (uint8_t*)mjs_array_buf_get_ptr(mjs, result, NULL);
+
+    char hi = '\0';
+    for(const char* c = str; *c; c++) {
+        if(*c == ' ' || *c == ':') continue;
+        if(hi == '\0') {
+            hi = *c;
+        } else {
+            if(!hex_char_to_uint8(hi, *c, out++)) {
+                JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "invalid hex digit");
+            }
+            hi = '\0';
+        }
+    }
+
+    mjs_return(mjs, result);
+}
+
+// ---=== crc ===---
+
+static void js_bytes_crc32(struct mjs* mjs) {
+    JsBytesBuf buf;
+    JS_FETCH_ARGS_OR_RETURN(mjs, JS_EXACTLY, JS_ARG_BUF(&buf));
+    mjs_return(mjs, mjs_mk_number(mjs, crc32_calc_buffer(0, buf.data, buf.len)));
+}
+
+typedef struct {
+    uint16_t polynom;
+    uint16_t init;
+    bool reflect;
+    uint16_t xor_out;
+} JsBytesCrc16Params;
+
+typedef enum {
+    JsBytesCrc16Iso14443a,
+    JsBytesCrc16Iso14443b,
+    JsBytesCrc16Iso13239,
+    JsBytesCrc16Picopass,
+    JsBytesCrc16Felica,
+    JsBytesCrc16Modbus,
+} JsBytesCrc16Preset;
+
+// Same results as lib/nfc/helpers CRCs, which can't be used here: they work on BitBuffer
+// and are not available on all targets
+static const JsBytesCrc16Params js_bytes_crc16_params[] = {
+    [JsBytesCrc16Iso14443a] = {0x1021, 0xC6C6, true, 0x0000},
+    [JsBytesCrc16Iso14443b] = {0x1021, 0xFFFF, true, 0xFFFF},
+    [JsBytesCrc16Iso13239] = {0x1021, 0xFFFF, true, 0xFFFF},
+    [JsBytesCrc16Picopass] = {0x1021, 0x4807, true, 0x0000},
+    [JsBytesCrc16Felica] = {0x1021, 0x0000, false, 0x0000},
+    [JsBytesCrc16Modbus] = {0x8005, 0xFFFF, true, 0x0000},
+};
+
+static void js_bytes_crc16(struct mjs* mjs) {
+    JsBytesBuf buf;
+    JsBytesCrc16Preset preset;
+    JS_ENUM_MAP(
+        preset,
+        {"iso14443a", JsBytesCrc16Iso14443a},
+        {"iso14443b", JsBytesCrc16Iso14443b},
+        {"iso13239", JsBytesCrc16Iso13239},
+        {"picopass", JsBytesCrc16Picopass},
+        {"felica", JsBytesCrc16Felica},
+        {"modbus", JsBytesCrc16Modbus});
+    JS_FETCH_ARGS_OR_RETURN(
+        mjs, JS_EXACTLY, JS_ARG_BUF(&buf), JS_ARG_ENUM(preset, "Crc16Preset"));
+
+    const JsBytesCrc16Params* params = &js_bytes_crc16_params[preset];
+    uint16_t crc = bit_lib_crc16(
+        buf.data,
+        buf.len,
+        params->polynom,
+        params->init,
+        params->reflect,
+        params->reflect,
+        params->xor_out);
+
+    mjs_return(mjs, mjs_mk_number(mjs, crc));
+}
+
+static void js_bytes_crc_custom(struct mjs* mjs) {
+    JsBytesBuf buf;
+    int32_t width, polynom, init, xor_out;
+    bool ref_in, ref_out;
+    JS_FETCH_ARGS_OR_RETURN(
+        mjs,
+        JS_EXACTLY,
+        JS_ARG_BUF(&buf),
+        JS_ARG_INT32(&width),
+        JS_ARG_INT32(&polynom),
+        JS_ARG_INT32(&init),
+        JS_ARG_BOOL(&ref_in),
+        JS_ARG_BOOL(&ref_out),
+        JS_ARG_INT32(&xor_out));
+
+    uint16_t crc;
+    if(width == 8) {
+        crc = bit_lib_crc8(buf.data, buf.len, polynom, init, ref_in, ref_out, xor_out);
+    } else if(width == 16) {
+        crc = bit_lib_crc16(buf.data, buf.len, polynom, init, ref_in, ref_out, xor_out);
+    } else {
+        JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "width must be 8 or 16");
+    }
+
+    mjs_return(mjs, mjs_mk_number(mjs, crc));
+}
+
+// ---=== buffer ops ===---
+
+static void js_bytes_xor(struct mjs* mjs) {
+    JsBytesBuf buf, key;
+    JS_FETCH_ARGS_OR_RETURN(mjs, JS_EXACTLY, JS_ARG_BUF(&buf), JS_ARG_BUF(&key));
+    if(key.len == 0) {
+        JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "empty key");
+    }
+
+    for(size_t i = 0, k = 0; i < buf.len; i++) {
+        buf.data[i] ^= key.data[k];
+        if(++k == key.len) k = 0;
+    }
+
+    mjs_return(mjs, MJS_UNDEFINED);
+}
+
+static void js_bytes_compare(struct mjs* mjs) {
+    JsBytesBuf a, b;
+    JS_FETCH_ARGS_OR_RETURN(mjs, JS_EXACTLY, JS_ARG_BUF(&a), JS_ARG_BUF(&b));
+
+    int result = memcmp(a.data, b.data, MIN(a.len, b.len));
+    if(result == 0) result = (a.len > b.len) - (a.len < b.len);
+
+    mjs_return(mjs, mjs_mk_number(mjs, (result > 0) - (result < 0)));
+}
+
+static void js_bytes_index_of(struct mjs* mjs) {
+    JsBytesBuf buf;
+    mjs_val_t needle_arg;
+    JS_FETCH_ARGS_OR_RETURN(mjs, JS_AT_LEAST, JS_ARG_BUF(&buf), JS_ARG_ANY(&needle_arg));
+
+    int32_t from = 0;
+    if(mjs_nargs(mjs) > 2) {
+        mjs_val_t from_arg = mjs_arg(mjs, 2);
+        if(!mjs_is_number(from_arg)) {
+            JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "argument 2: expected number");
+        }
+        from = mjs_get_int32(mjs, from_arg);
+        if(from < 0) from = 0;
+    }
+
+    uint8_t byte;
+    JsBytesBuf needle;
+    if(mjs_is_number(needle_arg)) {
+        byte = mjs_get_int32(mjs, needle_arg);
+        needle.data = &byte;
+        needle.len = 1;
+    } else if(mjs_is_typed_array(needle_arg)) {
+        js_bytes_to_buf(mjs, &needle_arg, &needle, NULL);
+    } else {
+        JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "argument 1: expected number or ArrayBuffer");
+    }
+
+    int32_t index = -1;
+    if(needle.len && (size_t)from < buf.len && needle.len <= buf.len - from) {
+        const uint8_t* last = buf.data + buf.len - needle.len;
+        for(const uint8_t* p = buf.data + from; p <= last; p++) {
+            p = memchr(p, needle.data[0], last - p + 1);
+            if(!p) break;
+            if(memcmp(p, needle.data, needle.len) == 0) {
+                index = p - buf.data;
+                break;
+            }
+        }
+    }
+
+    mjs_return(mjs, mjs_mk_number(mjs, index));
+}
+
+// ---=== bits ===---
+
+static bool js_bytes_check_bits(
+    struct mjs* mjs,
+    const JsBytesBuf* buf,
+    int32_t position,
+    int32_t length) {
+    if(length < 1 || length > 32) {
+        mjs_prepend_errorf(mjs, MJS_BAD_ARGS_ERROR, "length must be 1 to 32");
+        return false;
+    }
+    if(position < 0 || (size_t)position + length > buf->len * 8) {
+        mjs_prepend_errorf(mjs, MJS_BAD_ARGS_ERROR, "bits out of buffer bounds");
+        return false;
+    }
+    return true;
+}
+
+static void js_bytes_get_bits(struct mjs* mjs) {
+    JsBytesBuf buf;
+    int32_t position, length;
+    JS_FETCH_ARGS_OR_RETURN(
+        mjs, JS_EXACTLY, JS_ARG_BUF(&buf), JS_ARG_INT32(&position), JS_ARG_INT32(&length));
+    if(!js_bytes_check_bits(mjs, &buf, position, length)) {
+        mjs_return(mjs, MJS_UNDEFINED);
+        return;
+    }
+
+    // bit_lib_get_bits_32() may read a byte past the last bit, go bit by bit
+    uint32_t value = 0;
+    for(int32_t i = 0; i < length; i++) {
+        value = (value << 1) | bit_lib_get_bit(buf.data, position + i);
+    }
+
+    mjs_return(mjs, mjs_mk_number(mjs, value));
+}
+
+static void js_bytes_set_bits(struct mjs* mjs) {
+    JsBytesBuf buf;
+    int32_t position, length;
+    mjs_val_t value_arg;
+    JS_FETCH_ARGS_OR_RETURN(
+        mjs,
+        JS_EXACTLY,
+        JS_ARG_BUF(&buf),
+        JS_ARG_INT32(&position),
+        JS_ARG_INT32(&length),
+        JS_ARG_ANY(&value_arg));
+    if(!mjs_is_number(value_arg)) {
+        JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "argument 3: expected number");
+    }
+    if(!js_bytes_check_bits(mjs, &buf, position, length)) {
+        mjs_return(mjs, MJS_UNDEFINED);
+        return;
+    }
+
+    uint32_t value = (int64_t)mjs_get_double(mjs, value_arg);
+    for(int32_t i = 0; i < length; i++) {
+        bit_lib_set_bit(buf.data, position + i, (value >> (length - 1 - i)) & 1);
+    }
+
+    mjs_return(mjs, MJS_UNDEFINED);
+}
+
+// ---=== pack ===---
+
+typedef struct {
+    const char* fmt;
+    bool big_endian;
+    size_t repeat;
+    char code;
+} JsBytesFormat;
+
+static uint8_t js_bytes_format_code_size(char code) {
+    switch(code) {
+    case 'x':
+    case 'b':
+    case 'B':
+        return 1;
+    case 'h':
+    case 'H':
+        return 2;
+    case 'i':
+    case 'I':
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+static void js_bytes_format_init(JsBytesFormat* format, const char* fmt) {
+    format->big_endian = (fmt[0] == '>');
+    if(fmt[0] == '<' || fmt[0] == '>') fmt++;
+    format->fmt = fmt;
+    format->repeat = 0;
+}
+
+/**
+ * @brief Gets the next field of a validated format string
+ * @returns false at the end of the format string
+ */
+static bool js_bytes_format_next(JsBytesFormat* format, char* code) {
+    while(format->repeat == 0) {
+        if(*format->fmt == '\0') return false;
+        bool has_count = false;
+        size_t count = 0;
+        while(*format->fmt >= '0' && *format->fmt <= '9') {
+            count = count * 10 + (*format->fmt++ - '0');
+            has_count = true;
+        }
+        format->code = *format->fmt++;
+        format->repeat = has_count ? count : 1;
+    }
+    format->repeat--;
+    *code = format->code;
+    return true;
+}
+
+/**
+ * @brief Validates a format string
+ * @returns false if the format string is invalid
+ */
+static bool js_bytes_format_validate(const char* fmt, size_t* size, size_t* value_count) {
+    if(*fmt == '<' || *fmt == '>') fmt++;
+    *size = 0;
+    *value_count = 0;
+
+    while(*fmt) {
+        bool has_count = false;
+        size_t count = 0;
+        while(*fmt >= '0' && *fmt <= '9') {
+            count = count * 10 + (*fmt++ - '0');
+            if(count > JS_BYTES_FORMAT_COUNT_MAX) return false;
+            has_count = true;
+        }
+        if(!has_count) count = 1;
+
+        uint8_t code_size = js_bytes_format_code_size(*fmt);
+        if(code_size == 0) return false;
+        *size += count * code_size;
+        if(*fmt != 'x') *value_count += count;
+        fmt++;
+    }
+
+    return true;
+}
+
+static void js_bytes_pack(struct mjs* mjs) {
+    const char* fmt;
+    mjs_val_t values;
+    JS_FETCH_ARGS_OR_RETURN(mjs, JS_EXACTLY, JS_ARG_STR(&fmt), JS_ARG_ARR(&values));
+
+    size_t size, value_count;
+    if(!js_bytes_format_validate(fmt, &size, &value_count)) {
+        JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "invalid format");
+    }
+    if(value_count != mjs_array_length(mjs, values)) {
+        JS_ERROR_AND_RETURN(
+            mjs,
+            MJS_BAD_ARGS_ERROR,
+            "format needs %zu values, got %lu",
+            value_count,
+            mjs_array_length(mjs, values));
+    }
+    // Strings are not kept with array buffers, fmt stays valid
+    mjs_val_t result = mjs_mk_array_buf(mjs, NULL, size);
+    uint8_t* out = (uint8_t*)mjs_array_buf_get_ptr(mjs, result, NULL);
+
+    JsBytesFormat format;
+    js_bytes_format_init(&format, fmt);
+    size_t value_index = 0;
+    char code;
+    while(js_bytes_format_next(&format, &code)) {
+        uint8_t code_size = js_bytes_format_code_size(code);
+        if(code != 'x') {
+            mjs_val_t value = mjs_array_get(mjs, values, value_index);
+            if(!mjs_is_number(value)) {
+                JS_ERROR_AND_RETURN(
+                    mjs, MJS_BAD_ARGS_ERROR, "value %zu: expected number", value_index);
+            }
+            uint64_t raw = (int64_t)mjs_get_double(mjs, value);
+            if(format.big_endian) {
+                bit_lib_num_to_bytes_be(raw, code_size, out);
+            } else {
+                bit_lib_num_to_bytes_le(raw, code_size, out);
+            }
+            value_index++;
+        }
+        out += code_size;
+    }
+
+    mjs_return(mjs, result);
+}
+
+static void js_bytes_unpack(struct mjs* mjs) {
+    const char* fmt;
+    JsBytesBuf buf;
+    JS_FETCH_ARGS_OR_RETURN(mjs, JS_AT_LEAST, JS_ARG_STR(&fmt), JS_ARG_BUF(&buf));
+
+    int32_t offset = 0;
+    if(mjs_nargs(mjs) > 2) {
+        mjs_val_t offset_arg = mjs_arg(mjs, 2);
+        if(!mjs_is_number(offset_arg)) {
+            JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "argument 2: expected number");
+        }
+        offset = mjs_get_int32(mjs, offset_arg);
+    }
+
+    size_t size, value_count;
+    if(!js_bytes_format_validate(fmt, &size, &value_count)) {
+        JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "invalid format");
+    }
+    if(offset < 0 || (size_t)offset > buf.len || size > buf.len - offset) {
+        JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "format exceeds buffer bounds");
+    }
+
+    mjs_val_t result = mjs_mk_array(mjs);
+    JsBytesFormat format;
+    js_bytes_format_init(&format, fmt);
+    size_t position = offset;
+    char code;
+    while(js_bytes_format_next(&format, &code)) {
+        uint8_t code_size = js_bytes_format_code_size(code);
+        if(code != 'x') {
+            // Buffer pointer can't move here: numbers don't take array buffer memory
+            const uint8_t* data = buf.data + position;
+            uint64_t raw = format.big_endian ? bit_lib_bytes_to_num_be(data, code_size) :
+                                               bit_lib_bytes_to_num_le(data, code_size);
+            int64_t value = raw;
+            uint64_t sign_bit = 1ULL << (code_size * 8 - 1);
+            if(code >= 'a' && (raw & sign_bit)) value -= (int64_t)(sign_bit << 1);
+            mjs_array_push(mjs, result, mjs_mk_number(mjs, value));
+        }
+        position += code_size;
+    }
+
+    mjs_return(mjs, result);
+}
+
+static void* js_bytes_create(struct mjs* mjs, mjs_val_t* object, JsModules* modules) {
+    UNUSED(modules);
+    mjs_val_t bytes_obj = mjs_mk_object(mjs);
+    JS_ASSIGN_MULTI(mjs, bytes_obj) {
+        JS_FIELD("toHex", MJS_MK_FN(js_bytes_to_hex));
+        JS_FIELD("fromHex", MJS_MK_FN(js_bytes_from_hex));
+        JS_FIELD("crc32", MJS_MK_FN(js_bytes_crc32));
+        JS_FIELD("crc16", MJS_MK_FN(js_bytes_crc16));
+        JS_FIELD("crcCustom", MJS_MK_FN(js_bytes_crc_custom));
+        JS_FIELD("xor", MJS_MK_FN(js_bytes_xor));
+        JS_FIELD("compare", MJS_MK_FN(js_bytes_compare));
+        JS_FIELD("indexOf", MJS_MK_FN(js_bytes_index_of));
+        JS_FIELD("getBits", MJS_MK_FN(js_bytes_get_bits));
+        JS_FIELD("setBits", MJS_MK_FN(js_bytes_set_bits));
+        JS_FIELD("pack", MJS_MK_FN(js_bytes_pack));
+        JS_FIELD("unpack", MJS_MK_FN(js_bytes_unpack));
+    }
+    *object = bytes_obj;
+    return (void*)1;
+}
+
+static const JsModuleDescriptor js_bytes_desc = {
+    "bytes",
+    js_bytes_create,
+    NULL,
+    NULL,
+};
+
+static const FlipperAppPluginDescriptor plugin_descriptor = {
+    .appid = PLUGIN_APP_ID,
+    .ep_api_version = PLUGIN_API_VERSION,
+    .entry_point = &js_bytes_desc,
+};
+
+const FlipperAppPluginDescriptor* js_bytes_ep(void) {
+    return &plugin_descriptor;
+}
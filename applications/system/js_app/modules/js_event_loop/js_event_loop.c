@@ -342,7 +342,10 @@ static void js_event_loop_tick(void* param) {
     if(flags & ThreadEventStop) {
         furi_event_loop_stop(context->loop);
         mjs_exit(context->mjs);
+        return;
     }
+    // Nothing to handle for a whole tick: collect garbage now rather than amid next events
+    mjs_gc_idle(context->mjs);
 }
 
 static void* js_event_loop_create(struct mjs* mjs, mjs_val_t* object, JsModules* modules) {
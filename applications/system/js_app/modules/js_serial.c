@@ -431,6 +431,53 @@ static void js_serial_read_any(struct mjs* mjs) {
     free(read_buf);
 }
 
+static void js_serial_read_into(struct mjs* mjs) {
+    mjs_val_t obj_inst = mjs_get(mjs, mjs_get_this(mjs), INST_PROP_NAME, ~0);
+    JsSerialInst* serial = mjs_get_ptr(mjs, obj_inst);
+    furi_assert(serial);
+    if(!serial->setup_done) {
+        mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Serial is not configured");
+        mjs_return(mjs, MJS_UNDEFINED);
+        return;
+    }
+
+    char* buf = NULL;
+    size_t buf_len = 0;
+    uint32_t timeout = FuriWaitForever;
+
+    do {
+        size_t num_args = mjs_nargs(mjs);
+        if((num_args == 0) || (num_args > 2)) break;
+        buf = mjs_typed_array_get_ptr(mjs, mjs_arg(mjs, 0), &buf_len);
+        if(num_args == 2) {
+            mjs_val_t timeout_arg = mjs_arg(mjs, 1);
+            if(!mjs_is_number(timeout_arg)) {
+                buf = NULL;
+                break;
+            }
+            timeout = mjs_get_int32(mjs, timeout_arg);
+        }
+    } while(0);
+
+    if((buf == NULL) || (buf_len == 0)) {
+        mjs_prepend_errorf(mjs, MJS_BAD_ARGS_ERROR, "");
+        mjs_return(mjs, MJS_UNDEFINED);
+        return;
+    }
+
+    // Received right into the buffer: nothing is allocated, so polling in a loop is cheap
+    size_t bytes_read = 0;
+    uint32_t flags = ThreadEventCustomDataRx;
+    if(furi_stream_buffer_is_empty(serial->rx_stream)) {
+        flags = js_flags_wait(serial->mjs, ThreadEventCustomDataRx, timeout);
+    }
+    if(flags & ThreadEventCustomDataRx) {
+        bytes_read = furi_stream_buffer_receive(serial->rx_stream, buf, buf_len, 0);
+    }
+
+    mjs_return(mjs, mjs_mk_number(mjs, bytes_read));
+}
+
 static bool
     js_serial_expect_parse_string(struct mjs* mjs, mjs_val_t arg, PatternArray_t patterns) {
     size_t str_len = 0;
@@ -671,6 +718,7 @@ static void* js_serial_create(struct mjs* mjs, mjs_val_t* object, JsModules* mod
     mjs_set(mjs, serial_obj, "readln", ~0, MJS_MK_FN(js_serial_readln));
     mjs_set(mjs, serial_obj, "readBytes", ~0, MJS_MK_FN(js_serial_read_bytes));
     mjs_set(mjs, serial_obj, "readAny", ~0, MJS_MK_FN(js_serial_read_any));
+    mjs_set(mjs, serial_obj, "readInto", ~0, MJS_MK_FN(js_serial_read_into));
     mjs_set(mjs, serial_obj, "expect", ~0, MJS_MK_FN(js_serial_expect));
     *object = serial_obj;
 
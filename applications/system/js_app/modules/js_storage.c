@@ -34,6 +34,19 @@ static void js_storage_file_read(struct mjs* mjs) {
     }
 }
 
+static void js_storage_file_read_into(struct mjs* mjs) {
+    mjs_val_t buffer;
+    JS_FETCH_ARGS_OR_RETURN(mjs, JS_EXACTLY, JS_ARG_ANY(&buffer));
+    size_t len;
+    char* buf = mjs_typed_array_get_ptr(mjs, buffer, &len);
+    if(!buf) {
+        JS_ERROR_AND_RETURN(
+            mjs, MJS_BAD_ARGS_ERROR, "argument 0: expected ArrayBuffer or TypedArray");
+    }
+    File* file = JS_GET_CONTEXT(mjs);
+    mjs_return(mjs, mjs_mk_number(mjs, storage_file_read(file, buf, len)));
+}
+
 static void js_storage_file_write(struct mjs* mjs) {
     mjs_val_t data;
     JS_FETCH_ARGS_OR_RETURN(mjs, JS_EXACTLY, JS_ARG_ANY(&data));
@@ -138,6 +151,7 @@ static void js_storage_open_file(struct mjs* mjs) {
         JS_FIELD("close", MJS_MK_FN(js_storage_file_close));
         JS_FIELD("isOpen", MJS_MK_FN(js_storage_file_is_open));
         JS_FIELD("read", MJS_MK_FN(js_storage_file_read));
+        JS_FIELD("readInto", MJS_MK_FN(js_storage_file_read_into));
         JS_FIELD("write", MJS_MK_FN(js_storage_file_write));
         JS_FIELD("seekRelative", MJS_MK_FN(js_storage_file_seek_relative));
         JS_FIELD("seekAbsolute", MJS_MK_FN(js_storage_file_seek_absolute));
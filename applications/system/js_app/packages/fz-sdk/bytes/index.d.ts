@@ -0,0 +1,138 @@
+/**
+ * Native operations over byte buffers
+ *
+ * Every function works on a whole buffer in one native call, so parsing and
+ * building protocol frames doesn't need a per-byte loop in JS.
+ *
+ * Wherever a buffer is expected, both an `ArrayBuffer` and a `TypedArray` are
+ * accepted.
+ *
+ * @version Added in JS SDK 0.2
+ * @module
+ */
+
+type Buffer = ArrayBuffer | TypedArray<ElementType>;
+
+/**
+ * @brief CRC-16 variant
+ *
+ * - `"iso14443a"`: ISO 14443-3 Type A (NFC-A)
+ * - `"iso14443b"`: ISO 14443-3 Type B (NFC-B)
+ * - `"iso13239"`: ISO 13239, also used by ISO 15693 (NFC-V)
+ * - `"picopass"`: iClass / Picopass
+ * - `"felica"`: FeliCa
+ * - `"modbus"`: Modbus RTU
+ *
+ * @version Added in JS SDK 0.2
+ */
+export type Crc16Preset = "iso14443a" | "iso14443b" | "iso13239" | "picopass" | "felica" | "modbus";
+
+/**
+ * @brief Encodes a buffer as uppercase hex digits
+ * @example toHex(Uint8Array([0xDE, 0xAD])) // "DEAD"
+ * @version Added in JS SDK 0.2
+ */
+export declare function toHex(data: Buffer): string;
+
+/**
+ * @brief Decodes hex digits into a new buffer
+ * @param hex Hex digits, optionally separated with spaces or colons
+ * @example fromHex("04:A2 3F") // ArrayBuffer of 3 bytes
+ * @version Added in JS SDK 0.2
+ */
+export declare function fromHex(hex: string): ArrayBuffer;
+
+/**
+ * @brief Calculates the standard (zlib) CRC-32 of a buffer
+ * @version Added in JS SDK 0.2
+ */
+export declare function crc32(data: Buffer): number;
+
+/**
+ * @brief Calculates a CRC-16 of a buffer
+ *
+ * The NFC presets match the CRCs used by the Flipper NFC stack. Frames carry
+ * their CRC in little-endian byte order, except for FeliCa, which uses
+ * big-endian.
+ *
+ * @version Added in JS SDK 0.2
+ */
+export declare function crc16(data: Buffer, preset: Crc16Preset): number;
+
+/**
+ * @brief Calculates an arbitrary CRC-8 or CRC-16 of a buffer
+ * @param width CRC width in bits, 8 or 16
+ * @param polynom CRC polynomial, non-reflected
+ * @param init Initial value, non-reflected
+ * @param refIn `true` to process input bytes starting from the lowest bit
+ * @param refOut `true` to reflect the result before the final XOR
+ * @param xorOut Value to XOR the result with
+ * @version Added in JS SDK 0.2
+ */
+export declare function crcCustom(data: Buffer, width: 8 | 16, polynom: number, init: number, refIn: boolean, refOut: boolean, xorOut: number): number;
+
+/**
+ * @brief XORs a buffer in place with a key, repeating the key as needed
+ * @version Added in JS SDK 0.2
+ */
+export declare function xor(data: Buffer, key: Buffer): void;
+
+/**
+ * @brief Compares two buffers byte by byte
+ * @returns -1, 0 or 1 if `a` is respectively less than, equal to or greater
+ *          than `b`
+ * @version Added in JS SDK 0.2
+ */
+export declare function compare(a: Buffer, b: Buffer): number;
+
+/**
+ * @brief Finds the first occurrence of a byte or a byte sequence
+ * @param needle A single byte value or a sequence of bytes
+ * @param from The index to start searching at
+ * @returns The index of the first occurrence, or -1 if not found
+ * @version Added in JS SDK 0.2
+ */
+export declare function indexOf(data: Buffer, needle: number | Buffer, from?: number): number;
+
+/**
+ * @brief Reads a bit field, most significant bit first
+ * @param position Field start position, in bits from the buffer start
+ * @param length Field length in bits, 1 to 32
+ * @version Added in JS SDK 0.2
+ */
+export declare function getBits(data: Buffer, position: number, length: number): number;
+
+/**
+ * @brief Writes a bit field, most significant bit first
+ * @param position Field start position, in bits from the buffer start
+ * @param length Field length in bits, 1 to 32
+ * @param value The value to write, its lowest `length` bits are used
+ * @version Added in JS SDK 0.2
+ */
+export declare function setBits(data: Buffer, position: number, length: number, value: number): void;
+
+/**
+ * @brief Packs numbers into a new buffer
+ *
+ * The format string optionally starts with a byte order: `<` for little-endian
+ * (default) or `>` for big-endian. It is followed by fields, each one being a
+ * type code optionally prefixed with a repeat count:
+ *   - `b`/`B`: signed/unsigned 8-bit integer
+ *   - `h`/`H`: signed/unsigned 16-bit integer
+ *   - `i`/`I`: signed/unsigned 32-bit integer
+ *   - `x`: padding byte, takes no value
+ *
+ * @example pack(">BH2x", [1, 0x0203]) // 01 02 03 00 00
+ * @param values One number for every non-padding field
+ * @version Added in JS SDK 0.2
+ */
+export declare function pack(format: string, values: number[]): ArrayBuffer;
+
+/**
+ * @brief Unpacks numbers from a buffer
+ * @param format Format string, see `pack`
+ * @param offset Position in the buffer to start at, in bytes
+ * @returns One number for every non-padding field
+ * @version Added in JS SDK 0.2
+ */
+export declare function unpack(format: string, data: Buffer, offset?: number): number[];
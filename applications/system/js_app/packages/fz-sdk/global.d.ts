@@ -143,6 +143,43 @@ declare function checkSdkFeatures(features: string[]): void | never;
  */
 declare function delay(ms: number): void;
 
+/**
+ * @brief Garbage collector statistics
+ * @version Added in JS SDK 0.2
+ */
+declare type GcStats = {
+    /** Number of collections performed */
+    count: number,
+    /** Duration of the last collection, microseconds */
+    lastPauseUs: number,
+    /** Duration of the longest collection, microseconds */
+    maxPauseUs: number,
+    /** Total duration of all collections, microseconds */
+    totalPauseUs: number,
+    /** Object cells in use */
+    objectsUsed: number,
+    /** Object cells allocated */
+    objectsTotal: number,
+    /** Property cells in use */
+    propertiesUsed: number,
+    /** Property cells allocated */
+    propertiesTotal: number,
+    /** Bytes of string storage in use */
+    stringsUsed: number,
+    /** Bytes of string storage allocated */
+    stringsSize: number,
+};
+
+/**
+ * @brief Returns garbage collector statistics
+ * 
+ * Garbage is collected automatically when memory runs low, and while the
+ * event loop has been idle for a while.
+ * 
+ * @version Added in JS SDK 0.2
+ */
+declare function gcStats(): GcStats;
+
 /**
  * @brief Prints to the GUI console view
  * @param args The arguments are converted to strings, concatenated without any
@@ -197,6 +234,11 @@ declare function chr(n: number): string | null;
 
 /**
  * @brief Loads a natively implemented module
+ * 
+ * External modules are loaded on first use of the returned object, together
+ * with the modules required before them. Until then, only the presence of the
+ * module file is checked.
+ * 
  * @param module The name of the module to load
  * @version Added in JS SDK 0.1
  */
@@ -81,6 +81,21 @@ export declare function readAny(timeout?: number): string | undefined;
  */
 export declare function readBytes(length: number, timeout?: number): ArrayBuffer;
 
+/**
+ * @brief Reads data from the serial port into an existing buffer
+ * 
+ * Receives straight into the buffer without allocating a new one, reuse the
+ * same buffer in a loop to read a continuous stream of data.
+ * 
+ * @param buffer The buffer to fill. Up to `buffer.byteLength` bytes are read.
+ * @param timeout The number of time, in milliseconds, after which this function
+ *                will give up and return 0. If unset, the function will wait
+ *                forever.
+ * @returns The number of bytes that were read
+ * @version Added in JS SDK 0.2
+ */
+export declare function readInto<E extends ElementType>(buffer: ArrayBuffer | TypedArray<E>, timeout?: number): number;
+
 /**
  * @brief Reads data from the serial port, trying to match it to a pattern
  * @param patterns A single pattern or an array of patterns:
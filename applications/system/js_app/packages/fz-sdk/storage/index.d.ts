@@ -105,6 +105,15 @@ export declare class File {
      * @version Added in JS SDK 0.1
      */
     read<T extends ArrayBuffer | string>(mode: T extends ArrayBuffer ? "binary" : "ascii", bytes: number): T;
+    /**
+     * Reads bytes from a file opened in read-only or read-write mode into an
+     * existing buffer, without allocating a new one
+     * @param buffer The buffer to fill. Up to `buffer.byteLength` bytes are
+     *               read.
+     * @returns The number of bytes that was actually read
+     * @version Added in JS SDK 0.2
+     */
+    readInto<E extends ElementType>(buffer: ArrayBuffer | TypedArray<E>): number;
     /**
      * Writes bytes to a file opened in write-only or read-write mode
      * @param data The data to write: a string that will be ASCII-encoded, or an
@@ -0,0 +1,171 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <gui/gui.h>
+#include <input/input.h>
+#include <storage/storage.h>
+
+#define TAG "MassStorage"
+
+/* How often card presence is checked, ms */
+#define MASS_STORAGE_POLL_PERIOD 250
+
+typedef enum {
+    EventTypeInput,
+    EventTypeEject,
+} EventType;
+
+typedef struct {
+    union {
+        InputEvent input;
+    };
+    EventType type;
+} MassStorageEvent;
+
+typedef struct {
+    FuriMessageQueue* event_queue;
+    uint32_t block_count;
+    const char* status;
+} MassStorageApp;
+
+static bool mass_storage_read(uint8_t* buffer, uint32_t lba, uint32_t count, void* context) {
+    UNUSED(context);
+    return furi_hal_sd_read_blocks((uint32_t*)buffer, lba, count) == FuriStatusOk;
+}
+
+static bool
+    mass_storage_write(const uint8_t* buffer, uint32_t lba, uint32_t count, void* context) {
+    UNUSED(context);
+    return furi_hal_sd_write_blocks((const uint32_t*)buffer, lba, count) == FuriStatusOk;
+}
+
+static uint32_t mass_storage_block_count(void* context) {
+    MassStorageApp* app = context;
+    return furi_hal_sd_is_present() ? app->block_count : 0;
+}
+
+static void mass_storage_eject(void* context) {
+    MassStorageApp* app = context;
+    MassStorageEvent event = {.type = EventTypeEject};
+    furi_message_queue_put(app->event_queue, &event, FuriWaitForever);
+}
+
+static MscCallbacks mass_storage_callbacks = {
+    .read = mass_storage_read,
+    .write = mass_storage_write,
+    .block_count = mass_storage_block_count,
+    .eject = mass_storage_eject,
+};
+
+static void mass_storage_render_callback(Canvas* canvas, void* ctx) {
+    MassStorageApp* app = ctx;
+    canvas_clear(canvas);
+
+    canvas_set_font(canvas, FontPrimary);
+    canvas_draw_str(canvas, 0, 10, "USB Mass Storage");
+
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str(canvas, 0, 30, app->status);
+    canvas_draw_str(canvas, 0, 63, "Hold [back] to eject");
+}
+
+static void mass_storage_input_callback(InputEvent* input_event, void* ctx) {
+    MassStorageApp* app = ctx;
+
+    MassStorageEvent event;
+    event.type = EventTypeInput;
+    event.input = *input_event;
+    furi_message_queue_put(app->event_queue, &event, FuriWaitForever);
+}
+
+static void mass_storage_run(MassStorageApp* app, ViewPort* view_port) {
+    FuriHalSdInfo sd_info;
+    if(furi_hal_sd_info(&sd_info) != FuriStatusOk ||
+       sd_info.logical_block_size != FURI_HAL_USB_MSC_BLOCK_SIZE) {
+        app->status = "SD card is not supported";
+        return;
+    }
+    app->block_count = sd_info.logical_block_count;
+
+    // Host writes must reach the card before it can be mounted again
+    bool write_back = furi_hal_sd_is_write_back_enabled();
+    furi_hal_sd_set_write_back(false);
+
+    FuriHalUsbInterface* usb_mode_prev = furi_hal_usb_get_config();
+    furi_hal_usb_unlock();
+    furi_check(furi_hal_usb_set_config(&usb_msc, NULL) == true);
+    furi_hal_usb_msc_set_callbacks(&mass_storage_callbacks, app);
+
+    app->status = "Connected to USB";
+    view_port_update(view_port);
+
+    MassStorageEvent event;
+    while(1) {
+        FuriStatus event_status =
+            furi_message_queue_get(app->event_queue, &event, MASS_STORAGE_POLL_PERIOD);
+
+        if(!furi_hal_sd_is_present()) {
+            FURI_LOG_W(TAG, "Card removed");
+            break;
+        }
+
+        if(event_status == FuriStatusOk) {
+            if(event.type == EventTypeEject) {
+                FURI_LOG_I(TAG, "Ejected by host");
+                break;
+            }
+
+            if(event.type == EventTypeInput && event.input.type == InputTypeLong &&
+               event.input.key == InputKeyBack) {
+                break;
+            }
+        }
+    }
+
+    // Worker is stopped by the mode change, no block requests after that
+    furi_hal_usb_set_config(usb_mode_prev, NULL);
+
+    furi_hal_sd_set_write_back(write_back);
+}
+
+int32_t mass_storage_app(void* p) {
+    UNUSED(p);
+    MassStorageApp app = {
+        .event_queue = furi_message_queue_alloc(8, sizeof(MassStorageEvent)),
+        .status = "Unmounting SD card",
+    };
+    ViewPort* view_port = view_port_alloc();
+
+    view_port_draw_callback_set(view_port, mass_storage_render_callback, &app);
+    view_port_input_callback_set(view_port, mass_storage_input_callback, &app);
+
+    // Open GUI and register view_port
+    Gui* gui = furi_record_open(RECORD_GUI);
+    gui_add_view_port(gui, view_port, GuiLayerFullscreen);
+
+    // Storage service must not touch the card while the host owns it
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FS_Error error = storage_sd_unmount(storage);
+    if(error == FSE_OK) {
+        mass_storage_run(&app, view_port);
+        storage_sd_mount(storage);
+    } else {
+        FURI_LOG_E(TAG, "Unmount failed: %s", storage_error_get_desc(error));
+        app.status = (error == FSE_DENIED) ? "SD card is in use" : "No SD card";
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    if(error != FSE_OK || app.block_count == 0) {
+        view_port_update(view_port);
+        MassStorageEvent event;
+        while(furi_message_queue_get(app.event_queue, &event, FuriWaitForever) == FuriStatusOk) {
+            if(event.type == EventTypeInput && event.input.key == InputKeyBack) break;
+        }
+    }
+
+    // remove & free all stuff created by app
+    gui_remove_view_port(gui, view_port);
+    view_port_free(view_port);
+    furi_message_queue_free(app.event_queue);
+
+    return 0;
+}
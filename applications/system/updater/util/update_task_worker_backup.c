@@ -12,9 +12,12 @@
 #include <update_util/resources/manifest.h>
 #include <toolbox/tar/tar_archive.h>
 #include <toolbox/crc32_calc.h>
+#include <toolbox/hash_calc.h>
 
 #define TAG "UpdWorkerBackup"
 
+#define RESOURCE_MANIFEST_PATH EXT_PATH("Manifest")
+
 static bool update_task_pre_update(UpdateTask* update_task) {
     bool success = false;
     FuriString* backup_file_path;
@@ -38,24 +41,152 @@ static bool update_task_pre_update(UpdateTask* update_task) {
 typedef struct {
     UpdateTask* update_task;
     TarArchive* archive;
+    /* Delta unpack, NULL when every file is written */
+    ResourceManifestReader* manifest;
+    HashCalc* hash_calc;
+    FuriString* path;
+    /* Digest of the last written file, indexed once it is closed */
+    bool index_pending;
+    uint8_t index_md5[16];
 } TarUnpackProgress;
 
+static void update_task_resource_index_flush(TarUnpackProgress* unpack_progress) {
+    if(!unpack_progress->index_pending) return;
+    unpack_progress->index_pending = false;
+
+    // Next update finds the digest without reading the file back
+    Storage* storage = unpack_progress->update_task->storage;
+    const char* path = furi_string_get_cstr(unpack_progress->path);
+    uint32_t timestamp;
+    if(storage_common_timestamp(storage, path, &timestamp) == FSE_OK) {
+        storage_index_set_md5(storage, path, unpack_progress->index_md5, timestamp);
+    }
+}
+
+static void update_task_resource_delta_stop(TarUnpackProgress* unpack_progress) {
+    resource_manifest_reader_free(unpack_progress->manifest);
+    unpack_progress->manifest = NULL;
+}
+
+static bool
+    update_task_resource_is_unchanged(TarUnpackProgress* unpack_progress, const char* name) {
+    ResourceManifestEntry* entry;
+
+    // Manifest follows the archive order, files are matched in lockstep
+    do {
+        entry = resource_manifest_reader_next(unpack_progress->manifest);
+    } while(entry && entry->type != ResourceManifestEntryTypeFile);
+
+    if(!entry || furi_string_cmp_str(entry->name, name) != 0) {
+        FURI_LOG_W(TAG, "Manifest out of sync at %s, unpacking all", name);
+        update_task_resource_delta_stop(unpack_progress);
+        return false;
+    }
+
+    path_concat(STORAGE_EXT_PATH_PREFIX, name, unpack_progress->path);
+
+    uint8_t md5[sizeof(entry->hash)];
+    if(hash_calc_file(
+           unpack_progress->hash_calc,
+           furi_string_get_cstr(unpack_progress->path),
+           HashCalcTypeMd5,
+           md5,
+           NULL) &&
+       memcmp(md5, entry->hash, sizeof(md5)) == 0) {
+        return true;
+    }
+
+    unpack_progress->index_pending = true;
+    memcpy(unpack_progress->index_md5, entry->hash, sizeof(md5));
+    return false;
+}
+
 static bool update_task_resource_unpack_cb(const char* name, bool is_directory, void* context) {
-    UNUSED(name);
-    UNUSED(is_directory);
     TarUnpackProgress* unpack_progress = context;
     int32_t progress = 0, total = 0;
     tar_archive_get_read_progress(unpack_progress->archive, &progress, &total);
     update_task_set_progress(
         unpack_progress->update_task, UpdateTaskStageProgress, (progress * 100) / (total + 1));
-    return true;
+
+    bool unpack = true;
+    if(unpack_progress->manifest) {
+        update_task_resource_index_flush(unpack_progress);
+        if(!is_directory && update_task_resource_is_unchanged(unpack_progress, name)) {
+            FURI_LOG_D(TAG, "Unchanged %s", name);
+            unpack = false;
+        }
+    }
+
+    return unpack;
+}
+
+static int update_task_resource_crc_cmp(const void* a, const void* b) {
+    const uint32_t crc_a = *(const uint32_t*)a;
+    const uint32_t crc_b = *(const uint32_t*)b;
+    return (crc_a > crc_b) - (crc_a < crc_b);
+}
+
+static uint32_t update_task_resource_name_crc(const FuriString* name) {
+    return crc32_calc_buffer(0, furi_string_get_cstr(name), furi_string_size(name));
 }
 
-static void update_task_cleanup_resources(UpdateTask* update_task) {
+/* Sorted name CRCs of the new manifest entries, NULL if there is no manifest.
+ * A collision only keeps a stale file on the card. */
+static uint32_t*
+    update_task_resource_load_names(ResourceManifestReader* manifest_reader, size_t* count) {
+    ResourceManifestEntry* entry_ptr = NULL;
+    *count = 0;
+    while((entry_ptr = resource_manifest_reader_next(manifest_reader))) {
+        if(entry_ptr->type == ResourceManifestEntryTypeFile ||
+           entry_ptr->type == ResourceManifestEntryTypeDirectory) {
+            (*count)++;
+        }
+    }
+
+    uint32_t* names = malloc(MAX(*count, 1U) * sizeof(uint32_t));
+    size_t n_names = 0;
+    if(resource_manifest_rewind(manifest_reader)) {
+        while((entry_ptr = resource_manifest_reader_next(manifest_reader)) &&
+              n_names < *count) {
+            if(entry_ptr->type == ResourceManifestEntryTypeFile ||
+               entry_ptr->type == ResourceManifestEntryTypeDirectory) {
+                names[n_names++] = update_task_resource_name_crc(entry_ptr->name);
+            }
+        }
+    }
+
+    if(n_names != *count || !resource_manifest_rewind(manifest_reader)) {
+        FURI_LOG_W(TAG, "Failed to load resources manifest");
+        free(names);
+        names = NULL;
+    } else {
+        qsort(names, n_names, sizeof(uint32_t), update_task_resource_crc_cmp);
+        FURI_LOG_I(TAG, "Delta unpack, %zu entries", n_names);
+    }
+
+    return names;
+}
+
+static bool update_task_resource_is_kept(
+    const ResourceManifestEntry* entry,
+    const uint32_t* keep_names,
+    size_t keep_count) {
+    if(!keep_names) return false;
+
+    const uint32_t crc = update_task_resource_name_crc(entry->name);
+    return bsearch(&crc, keep_names, keep_count, sizeof(uint32_t), update_task_resource_crc_cmp) !=
+           NULL;
+}
+
+/* Entries listed in keep_names are left alone, they are compared while unpacking */
+static void update_task_cleanup_resources(
+    UpdateTask* update_task,
+    const uint32_t* keep_names,
+    size_t keep_count) {
     ResourceManifestReader* manifest_reader = resource_manifest_reader_alloc(update_task->storage);
     do {
         FURI_LOG_D(TAG, "Cleaning up old manifest");
-        if(!resource_manifest_reader_open(manifest_reader, EXT_PATH("Manifest"))) {
+        if(!resource_manifest_reader_open(manifest_reader, RESOURCE_MANIFEST_PATH)) {
             FURI_LOG_W(TAG, "No existing manifest");
             break;
         }
@@ -81,6 +212,10 @@ static void update_task_cleanup_resources(UpdateTask* update_task) {
                     UpdateTaskStageProgress,
                     (n_processed_file_entries++ * 100) / n_file_entries);
 
+                if(update_task_resource_is_kept(entry_ptr, keep_names, keep_count)) {
+                    continue;
+                }
+
                 FuriString* file_path = furi_string_alloc();
                 path_concat(
                     STORAGE_EXT_PATH_PREFIX, furi_string_get_cstr(entry_ptr->name), file_path);
@@ -108,6 +243,10 @@ static void update_task_cleanup_resources(UpdateTask* update_task) {
                     UpdateTaskStageProgress,
                     (n_processed_dir_entries++ * 100) / n_dir_entries);
 
+                if(update_task_resource_is_kept(entry_ptr, keep_names, keep_count)) {
+                    continue;
+                }
+
                 FuriString* folder_path = furi_string_alloc();
 
                 do {
@@ -166,11 +305,50 @@ static bool update_task_post_update(UpdateTask* update_task) {
             CHECK_RESULT(tar_archive_open(
                 archive, furi_string_get_cstr(file_path), TarOpenModeReadHeatshrink));
 
-            update_task_cleanup_resources(update_task);
+            // Packages with per-file digests only get changed files written
+            uint32_t* keep_names = NULL;
+            size_t keep_count = 0;
+            if(!furi_string_empty(update_task->manifest->resource_manifest)) {
+                path_concat(
+                    furi_string_get_cstr(update_task->update_path),
+                    furi_string_get_cstr(update_task->manifest->resource_manifest),
+                    file_path);
+
+                progress.manifest = resource_manifest_reader_alloc(update_task->storage);
+                if(resource_manifest_reader_open(
+                       progress.manifest, furi_string_get_cstr(file_path))) {
+                    keep_names = update_task_resource_load_names(progress.manifest, &keep_count);
+                }
+
+                if(!keep_names) {
+                    update_task_resource_delta_stop(&progress);
+                }
+            }
+
+            update_task_cleanup_resources(update_task, keep_names, keep_count);
+            free(keep_names);
+
+            if(progress.manifest) {
+                progress.hash_calc = hash_calc_alloc(update_task->storage);
+                progress.path = furi_string_alloc();
+            }
 
             update_task_set_progress(update_task, UpdateTaskStageResourcesFileUnpack, 0);
             tar_archive_set_file_callback(archive, update_task_resource_unpack_cb, &progress);
-            CHECK_RESULT(tar_archive_unpack_to(archive, STORAGE_EXT_PATH_PREFIX, NULL));
+            bool unpacked = tar_archive_unpack_to(archive, STORAGE_EXT_PATH_PREFIX, NULL);
+
+            if(progress.hash_calc) {
+                if(unpacked && progress.manifest) {
+                    update_task_resource_index_flush(&progress);
+                }
+                hash_calc_free(progress.hash_calc);
+                furi_string_free(progress.path);
+            }
+            if(progress.manifest) {
+                update_task_resource_delta_stop(&progress);
+            }
+
+            CHECK_RESULT(unpacked);
         }
 
         if(update_task->state.groups & UpdateTaskStageGroupSplashscreen) {
@@ -30,12 +30,20 @@ static void update_task_file_progress(const uint8_t progress, void* context) {
     update_task_set_progress(update_task, UpdateTaskStageProgress, progress);
 }
 
-static bool page_task_compare_flash(
-    const uint8_t i_page,
-    const uint8_t* update_block,
-    uint16_t update_block_len) {
-    const size_t page_addr = furi_hal_flash_get_base() + furi_hal_flash_get_page_size() * i_page;
-    return memcmp(update_block, (void*)page_addr, update_block_len) == 0;
+typedef struct {
+    uint32_t crc;
+    uint16_t size;
+} UpdateTaskFlashPage;
+
+typedef struct {
+    UpdateTask* update_task;
+    UpdateTaskFlashPage* pages;
+    size_t pages_count;
+} UpdateTaskFlashState;
+
+static void update_task_flash_progress(const uint8_t progress, void* context) {
+    UpdateTaskFlashState* state = context;
+    update_task_set_progress(state->update_task, UpdateTaskStageProgress, progress);
 }
 
 /* Verifies a flash operation address for fitting into writable memory
@@ -49,17 +57,62 @@ static bool check_address_boundaries(const size_t address) {
 static bool update_task_flash_program_page(
     const uint8_t i_page,
     const uint8_t* update_block,
-    uint16_t update_block_len) {
-    furi_hal_flash_program_page(i_page, update_block, update_block_len);
+    uint16_t update_block_len,
+    void* context) {
+    UpdateTaskFlashState* state = context;
+    if(i_page >= state->pages_count) {
+        return false;
+    }
+
+    const size_t page_size = furi_hal_flash_get_page_size();
+    const void* page_addr = (const void*)(furi_hal_flash_get_base() + page_size * i_page);
+
+    /* Erase and program cycle is the slow part, full pages already in place are left alone */
+    if((update_block_len != page_size) || memcmp(update_block, page_addr, page_size) != 0) {
+        furi_hal_flash_program_page(i_page, update_block, update_block_len);
+    }
+
+    /* Remembered for validation, so image doesn't have to be read from SD again */
+    state->pages[i_page].crc = crc32_calc_buffer(0, update_block, update_block_len);
+    state->pages[i_page].size = update_block_len;
+    return true;
+}
+
+static bool update_task_validate_flash(UpdateTaskFlashState* state) {
+    const size_t page_size = furi_hal_flash_get_page_size();
+    for(size_t i_page = 0; i_page < state->pages_count; i_page++) {
+        const UpdateTaskFlashPage* page = &state->pages[i_page];
+        if(page->size == 0) {
+            continue;
+        }
+
+        const void* page_addr = (const void*)(furi_hal_flash_get_base() + page_size * i_page);
+        if(crc32_calc_buffer(0, page_addr, page->size) != page->crc) {
+            FURI_LOG_E(TAG, "Page %zu mismatch", i_page);
+            return false;
+        }
+
+        update_task_set_progress(
+            state->update_task, UpdateTaskStageProgress, (i_page + 1) * 100 / state->pages_count);
+    }
+
     return true;
 }
 
 static bool update_task_write_dfu(UpdateTask* update_task) {
+    const size_t flash_size =
+        (size_t)furi_hal_flash_get_free_end_address() - furi_hal_flash_get_base();
+    UpdateTaskFlashState state = {
+        .update_task = update_task,
+        .pages_count = flash_size / furi_hal_flash_get_page_size(),
+    };
+    state.pages = malloc(sizeof(UpdateTaskFlashPage) * state.pages_count);
+
     DfuUpdateTask page_task = {
         .address_cb = &check_address_boundaries,
-        .progress_cb = &update_task_file_progress,
+        .progress_cb = &update_task_flash_progress,
         .task_cb = &update_task_flash_program_page,
-        .context = update_task,
+        .context = &state,
     };
 
     bool success = false;
@@ -79,13 +132,12 @@ static bool update_task_write_dfu(UpdateTask* update_task) {
         update_task_set_progress(update_task, UpdateTaskStageFlashWrite, 0);
         CHECK_RESULT(dfu_file_process_targets(&page_task, update_task->file, valid_targets));
 
-        page_task.task_cb = &page_task_compare_flash;
-
         update_task_set_progress(update_task, UpdateTaskStageFlashValidate, 0);
-        CHECK_RESULT(dfu_file_process_targets(&page_task, update_task->file, valid_targets));
+        CHECK_RESULT(update_task_validate_flash(&state));
         success = true;
     } while(false);
 
+    free(state.pages);
     return success;
 }
 
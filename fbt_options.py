@@ -75,6 +75,7 @@ FIRMWARE_APPS = {
         "updater_app",
         "radio_device_cc1101_ext",
         "unit_tests",
+        "bench",
         "js_app",
     ],
 }
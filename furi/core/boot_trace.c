@@ -0,0 +1,39 @@
+#include "boot_trace.h"
+#include "check.h"
+#include "common_defines.h"
+
+#include <furi_hal_cortex.h>
+#include <stm32wbxx.h>
+
+static FuriBootTraceRecord furi_boot_trace[FURI_BOOT_TRACE_SIZE];
+static size_t furi_boot_trace_count = 0;
+
+void furi_boot_trace_mark(const char* stage) {
+    furi_check(stage);
+
+    const uint32_t time_us = DWT->CYCCNT / furi_hal_cortex_instructions_per_microsecond();
+    const size_t index = __atomic_fetch_add(&furi_boot_trace_count, 1, __ATOMIC_RELAXED);
+    if(index >= FURI_BOOT_TRACE_SIZE) {
+        // Keep counter from running away if somebody marks in a loop
+        __atomic_store_n(&furi_boot_trace_count, FURI_BOOT_TRACE_SIZE, __ATOMIC_RELAXED);
+        return;
+    }
+
+    furi_boot_trace[index].time_us = time_us;
+    // Stage pointer published last: record is complete once it is set
+    __atomic_store_n(&furi_boot_trace[index].stage, stage, __ATOMIC_RELEASE);
+}
+
+size_t furi_boot_trace_get_count(void) {
+    return MIN(__atomic_load_n(&furi_boot_trace_count, __ATOMIC_RELAXED), FURI_BOOT_TRACE_SIZE);
+}
+
+bool furi_boot_trace_get(size_t index, FuriBootTraceRecord* record) {
+    furi_check(record);
+    furi_check(index < FURI_BOOT_TRACE_SIZE);
+
+    record->stage = __atomic_load_n(&furi_boot_trace[index].stage, __ATOMIC_ACQUIRE);
+    record->time_us = furi_boot_trace[index].time_us;
+
+    return record->stage != NULL;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file boot_trace.h
+ * Furi boot trace: timestamps of startup stages.
+ *
+ * Stages are recorded into a static buffer from the first moment cycle
+ * counter is running till the desktop is ready. Timestamps are counted from
+ * cycle counter start and are valid for the first minute after reset, when
+ * the counter wraps.
+ */
+#pragma once
+
+#include "base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of recorded stages, later marks are dropped */
+#define FURI_BOOT_TRACE_SIZE (40U)
+
+typedef struct {
+    const char* stage; /**< stage name */
+    uint32_t time_us; /**< time since cycle counter start, us */
+} FuriBootTraceRecord;
+
+/** Record end of a boot stage
+ *
+ * Lock-free, safe to call from any thread and before the kernel started.
+ *
+ * @param[in]  stage  stage name, must stay valid forever (string literal)
+ */
+void furi_boot_trace_mark(const char* stage);
+
+/** Get number of recorded stages
+ *
+ * @return     recorded stage count
+ */
+size_t furi_boot_trace_get_count(void);
+
+/** Get recorded stage
+ *
+ * @param[in]   index   stage index, less than furi_boot_trace_get_count()
+ * @param[out]  record  pointer to FuriBootTraceRecord to fill
+ *
+ * @return     true if record is complete
+ */
+bool furi_boot_trace_get(size_t index, FuriBootTraceRecord* record);
+
+#ifdef __cplusplus
+}
+#endif
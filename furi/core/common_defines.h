@@ -67,6 +67,11 @@ void __furi_critical_exit(__FuriCriticalInfo info);
 #define FURI_CHECK_RETURN __attribute__((__warn_unused_result__))
 #endif
 
+#ifndef FURI_RAMFUNC
+/** Run function from SRAM1: no flash wait states, no ART cache misses */
+#define FURI_RAMFUNC __attribute__((section(".ramfunc"), noinline))
+#endif
+
 #ifndef FURI_NAKED
 #define FURI_NAKED __attribute__((naked))
 #endif
@@ -9,6 +9,8 @@
 
 #define TAG "FuriEventLoop"
 
+static uint32_t furi_event_loop_latency[FURI_EVENT_LOOP_LATENCY_BUCKET_COUNT] = {0};
+
 /*
  * Private functions
  */
@@ -32,6 +34,100 @@ static void furi_event_loop_item_notify(FuriEventLoopItem* instance);
 
 static bool furi_event_loop_item_is_waiting(FuriEventLoopItem* instance);
 
+/*
+ * Item table: lookup by object in O(1), dispatch itself goes through object links
+ */
+
+static inline size_t furi_event_loop_item_table_get_mask(const FuriEventLoopItemTable* table) {
+    return (1UL << table->bits) - 1U;
+}
+
+static inline size_t furi_event_loop_item_table_get_home(
+    const FuriEventLoopItemTable* table,
+    const FuriEventLoopObject* object) {
+    // Fibonacci hashing, upper bits of the product are well mixed
+    const uint32_t hash = (uint32_t)(uintptr_t)object * 2654435761UL;
+    return hash >> (32U - table->bits);
+}
+
+static void furi_event_loop_item_table_init(FuriEventLoopItemTable* table, size_t bits) {
+    table->slots = malloc(sizeof(FuriEventLoopItem*) << bits);
+    table->bits = bits;
+    table->count = 0;
+}
+
+static void furi_event_loop_item_table_clear(FuriEventLoopItemTable* table) {
+    free(table->slots);
+    table->slots = NULL;
+}
+
+// Returns slot holding object or empty slot where object belongs
+static size_t furi_event_loop_item_table_find(
+    const FuriEventLoopItemTable* table,
+    const FuriEventLoopObject* object) {
+    const size_t mask = furi_event_loop_item_table_get_mask(table);
+    size_t index = furi_event_loop_item_table_get_home(table, object);
+
+    while(table->slots[index] && table->slots[index]->object != object) {
+        index = (index + 1U) & mask;
+    }
+
+    return index;
+}
+
+static FuriEventLoopItem*
+    furi_event_loop_item_table_get(const FuriEventLoopItemTable* table, const void* object) {
+    return table->slots[furi_event_loop_item_table_find(table, object)];
+}
+
+static void
+    furi_event_loop_item_table_add(FuriEventLoopItemTable* table, FuriEventLoopItem* item) {
+    // Keep load factor under 1/2, probe sequences stay short
+    if((table->count + 1U) * 2U > (1UL << table->bits)) {
+        FuriEventLoopItemTable grown;
+        furi_event_loop_item_table_init(&grown, table->bits + 1U);
+
+        for(size_t i = 0; i <= furi_event_loop_item_table_get_mask(table); i++) {
+            if(table->slots[i]) {
+                grown.slots[furi_event_loop_item_table_find(&grown, table->slots[i]->object)] =
+                    table->slots[i];
+                grown.count++;
+            }
+        }
+
+        furi_event_loop_item_table_clear(table);
+        *table = grown;
+    }
+
+    const size_t index = furi_event_loop_item_table_find(table, item->object);
+    furi_check(table->slots[index] == NULL);
+    table->slots[index] = item;
+    table->count++;
+}
+
+static FuriEventLoopItem*
+    furi_event_loop_item_table_pop(FuriEventLoopItemTable* table, const void* object) {
+    const size_t mask = furi_event_loop_item_table_get_mask(table);
+    size_t index = furi_event_loop_item_table_find(table, object);
+
+    FuriEventLoopItem* item = table->slots[index];
+    if(!item) return NULL;
+
+    // Backward shift deletion: pull up items whose probe sequence runs through the hole
+    for(size_t next = (index + 1U) & mask; table->slots[next]; next = (next + 1U) & mask) {
+        const size_t home = furi_event_loop_item_table_get_home(table, table->slots[next]->object);
+        if(((next - home) & mask) >= ((next - index) & mask)) {
+            table->slots[index] = table->slots[next];
+            index = next;
+        }
+    }
+
+    table->slots[index] = NULL;
+    table->count--;
+
+    return item;
+}
+
 static void furi_event_loop_process_pending_callbacks(FuriEventLoop* instance) {
     for(; !PendingQueue_empty_p(instance->pending_queue);
         PendingQueue_pop_back(NULL, instance->pending_queue)) {
@@ -64,7 +160,7 @@ FuriEventLoop* furi_event_loop_alloc(void) {
 
     instance->thread_id = furi_thread_get_current_id();
 
-    FuriEventLoopTree_init(instance->tree);
+    furi_event_loop_item_table_init(&instance->item_table, FURI_EVENT_LOOP_ITEM_TABLE_BITS_MIN);
     WaitingList_init(instance->waiting_list);
     TimerList_init(instance->timer_list);
     TimerQueue_init(instance->timer_queue);
@@ -87,7 +183,7 @@ void furi_event_loop_free(FuriEventLoop* instance) {
     furi_check(TimerList_empty_p(instance->timer_list));
     furi_check(WaitingList_empty_p(instance->waiting_list));
 
-    FuriEventLoopTree_clear(instance->tree);
+    furi_event_loop_item_table_clear(&instance->item_table);
     PendingQueue_clear(instance->pending_queue);
 
     uint32_t flags = 0;
@@ -110,16 +206,21 @@ static inline FuriEventLoopProcessStatus
 
 static inline FuriEventLoopProcessStatus
     furi_event_loop_process_level_event(FuriEventLoopItem* item) {
-    FuriEventLoopProcessStatus status = FuriEventLoopProcessStatusComplete;
-    if(item->contract->get_level(item->object, item->event)) {
+    // Burst in a queue is drained in batches, not one trip through the waiting list per message
+    for(size_t i = 0; i < FURI_EVENT_LOOP_LEVEL_BATCH_SIZE; i++) {
+        if(!item->contract->get_level(item->object, item->event)) {
+            return FuriEventLoopProcessStatusComplete;
+        }
+
         item->callback(item->object, item->callback_context);
 
-        if(item->contract->get_level(item->object, item->event)) {
-            status = FuriEventLoopProcessStatusIncomplete;
-        }
+        // Unsubscribed from inside the callback
+        if(item->owner == NULL) return FuriEventLoopProcessStatusComplete;
     }
 
-    return status;
+    return item->contract->get_level(item->object, item->event) ?
+               FuriEventLoopProcessStatusIncomplete :
+               FuriEventLoopProcessStatusComplete;
 }
 
 static inline FuriEventLoopProcessStatus
@@ -151,6 +252,7 @@ static inline FuriEventLoopItem* furi_event_loop_get_waiting_item(FuriEventLoop*
     if(!WaitingList_empty_p(instance->waiting_list)) {
         item = WaitingList_pop_front(instance->waiting_list);
         WaitingList_init_field(item);
+        instance->waiting_count--;
     }
 
     FURI_CRITICAL_EXIT();
@@ -172,22 +274,39 @@ static inline void furi_event_loop_sync_flags(FuriEventLoop* instance) {
     FURI_CRITICAL_EXIT();
 }
 
+static inline bool furi_event_loop_is_stop_requested(FuriEventLoop* instance) {
+    // Peek at notification value, clear mask 0 leaves it intact
+    const uint32_t flags = ulTaskNotifyValueClearIndexed(
+        (TaskHandle_t)instance->thread_id, FURI_EVENT_LOOP_FLAG_NOTIFY_INDEX, 0);
+    return flags & FuriEventLoopFlagStop;
+}
+
 static void furi_event_loop_process_waiting_list(FuriEventLoop* instance) {
-    FuriEventLoopItem* item = furi_event_loop_get_waiting_item(instance);
-    if(!item) return;
-
-    FuriEventLoopProcessStatus status = furi_event_loop_process_event(instance, item);
-
-    if(status == FuriEventLoopProcessStatusComplete) {
-        // Event processing complete, do nothing
-    } else if(status == FuriEventLoopProcessStatusIncomplete) {
-        // Event processing incomplete, put item back in waiting list
-        furi_event_loop_item_notify(item);
-    } else if(status == FuriEventLoopProcessStatusFreeLater) { //-V547
-        // Unsubscribed from inside the callback, delete item
-        furi_event_loop_item_free(item);
-    } else {
-        furi_crash();
+    // Process everything that was waiting on wakeup in one go. Items notified during
+    // processing, including incomplete level items, are left for the next round.
+    FURI_CRITICAL_ENTER();
+    size_t count = instance->waiting_count;
+    FURI_CRITICAL_EXIT();
+
+    for(; count > 0; count--) {
+        FuriEventLoopItem* item = furi_event_loop_get_waiting_item(instance);
+        if(!item) break;
+
+        FuriEventLoopProcessStatus status = furi_event_loop_process_event(instance, item);
+
+        if(status == FuriEventLoopProcessStatusComplete) {
+            // Event processing complete, do nothing
+        } else if(status == FuriEventLoopProcessStatusIncomplete) {
+            // Event processing incomplete, put item back in waiting list
+            furi_event_loop_item_notify(item);
+        } else if(status == FuriEventLoopProcessStatusFreeLater) { //-V547
+            // Unsubscribed from inside the callback, delete item
+            furi_event_loop_item_free(item);
+        } else {
+            furi_crash();
+        }
+
+        if(furi_event_loop_is_stop_requested(instance)) break;
     }
 
     furi_event_loop_sync_flags(instance);
@@ -200,6 +319,21 @@ static void furi_event_loop_restore_flags(FuriEventLoop* instance, uint32_t flag
     }
 }
 
+static void furi_event_loop_account_latency(FuriEventLoop* instance) {
+    const uint32_t notify_time = __atomic_exchange_n(&instance->notify_time, 0, __ATOMIC_RELAXED);
+    if(!notify_time) return;
+
+    const uint32_t latency_us =
+        (portGET_RUN_TIME_COUNTER_VALUE() - notify_time) / (configCPU_CLOCK_HZ / 1000000U);
+
+    size_t bucket = 0;
+    for(uint32_t limit = 10; latency_us >= limit; limit *= 10) {
+        if(++bucket == FURI_EVENT_LOOP_LATENCY_BUCKET_COUNT - 1) break;
+    }
+
+    __atomic_fetch_add(&furi_event_loop_latency[bucket], 1, __ATOMIC_RELAXED);
+}
+
 void furi_event_loop_run(FuriEventLoop* instance) {
     furi_check(instance);
     furi_check(instance->thread_id == furi_thread_get_current_id());
@@ -227,6 +361,8 @@ void furi_event_loop_run(FuriEventLoop* instance) {
         instance->state = FuriEventLoopStateProcessing;
 
         if(ret == pdTRUE) {
+            furi_event_loop_account_latency(instance);
+
             if(flags & FuriEventLoopFlagStop) {
                 instance->state = FuriEventLoopStateStopped;
                 break;
@@ -258,6 +394,16 @@ void furi_event_loop_run(FuriEventLoop* instance) {
 }
 
 static void furi_event_loop_notify(FuriEventLoop* instance, FuriEventLoopFlag flag) {
+    // Only the first notification starts latency measurement, 0 is reserved for none
+    uint32_t notify_time = 0;
+    __atomic_compare_exchange_n(
+        &instance->notify_time,
+        &notify_time,
+        portGET_RUN_TIME_COUNTER_VALUE() | 1U,
+        false,
+        __ATOMIC_RELAXED,
+        __ATOMIC_RELAXED);
+
     if(FURI_IS_IRQ_MODE()) {
         BaseType_t yield = pdFALSE;
 
@@ -276,6 +422,14 @@ static void furi_event_loop_notify(FuriEventLoop* instance, FuriEventLoopFlag fl
     }
 }
 
+void furi_event_loop_get_latency_histogram(uint32_t* histogram) {
+    furi_check(histogram);
+
+    for(size_t i = 0; i < FURI_EVENT_LOOP_LATENCY_BUCKET_COUNT; i++) {
+        histogram[i] = __atomic_load_n(&furi_event_loop_latency[i], __ATOMIC_RELAXED);
+    }
+}
+
 void furi_event_loop_stop(FuriEventLoop* instance) {
     furi_check(instance);
     furi_event_loop_notify(instance, FuriEventLoopFlagStop);
@@ -322,13 +476,13 @@ static void furi_event_loop_object_subscribe(
 
     FURI_CRITICAL_ENTER();
 
-    furi_check(FuriEventLoopTree_get(instance->tree, object) == NULL);
+    furi_check(furi_event_loop_item_table_get(&instance->item_table, object) == NULL);
 
     // Allocate and setup item
     FuriEventLoopItem* item = furi_event_loop_item_alloc(instance, contract, object, event);
     furi_event_loop_item_set_callback(item, callback, context);
 
-    FuriEventLoopTree_set_at(instance->tree, object, item);
+    furi_event_loop_item_table_add(&instance->item_table, item);
 
     FuriEventLoopLink* link = item->contract->get_link(object);
     FuriEventLoopEvent event_noflags = item->event & FuriEventLoopEventMask;
@@ -391,6 +545,18 @@ void furi_event_loop_subscribe_stream_buffer(
         instance, stream_buffer, &furi_stream_buffer_event_loop_contract, event, callback, context);
 }
 
+void furi_event_loop_subscribe_spsc_ring(
+    FuriEventLoop* instance,
+    FuriSpscRing* spsc_ring,
+    FuriEventLoopEvent event,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    extern const FuriEventLoopContract furi_spsc_ring_event_loop_contract;
+
+    furi_event_loop_object_subscribe(
+        instance, spsc_ring, &furi_spsc_ring_event_loop_contract, event, callback, context);
+}
+
 void furi_event_loop_subscribe_semaphore(
     FuriEventLoop* instance,
     FuriSemaphore* semaphore,
@@ -425,8 +591,7 @@ void furi_event_loop_unsubscribe(FuriEventLoop* instance, FuriEventLoopObject* o
 
     FURI_CRITICAL_ENTER();
 
-    FuriEventLoopItem* item = NULL;
-    furi_check(FuriEventLoopTree_pop_at(&item, instance->tree, object));
+    FuriEventLoopItem* item = furi_event_loop_item_table_pop(&instance->item_table, object);
 
     furi_check(item);
     furi_check(item->owner == instance);
@@ -446,6 +611,7 @@ void furi_event_loop_unsubscribe(FuriEventLoop* instance, FuriEventLoopObject* o
 
     if(furi_event_loop_item_is_waiting(item)) {
         WaitingList_unlink(item);
+        instance->waiting_count--;
     }
 
     if(instance->state == FuriEventLoopStateProcessing) {
@@ -462,8 +628,7 @@ bool furi_event_loop_is_subscribed(FuriEventLoop* instance, FuriEventLoopObject*
     furi_check(instance->thread_id == furi_thread_get_current_id());
     FURI_CRITICAL_ENTER();
 
-    FuriEventLoopItem* const* item = FuriEventLoopTree_cget(instance->tree, object);
-    bool result = !!item;
+    bool result = furi_event_loop_item_table_get(&instance->item_table, object) != NULL;
 
     FURI_CRITICAL_EXIT();
     return result;
@@ -526,6 +691,7 @@ static void furi_event_loop_item_notify(FuriEventLoopItem* instance) {
 
     if(!furi_event_loop_item_is_waiting(instance)) {
         WaitingList_push_back(owner->waiting_list, instance);
+        owner->waiting_count++;
     }
 
     FURI_CRITICAL_EXIT();
@@ -12,6 +12,11 @@
  *             programming concepts are the same, except some runtime
  *             limitations from our side.
  *
+ *             Notifications reach the subscription directly through the object,
+ *             lookups by object on (un)subscription go through a hash table:
+ *             both are O(1) regardless of the subscription count. All items
+ *             that are ready on wakeup are processed in one batch.
+ *
  * @warning Only ONE instance of FuriEventLoop per thread is possible. ALL FuriEventLoop
  * funcitons MUST be called from the same thread that the instance was created in.
  */
@@ -264,6 +269,26 @@ void furi_event_loop_subscribe_stream_buffer(
     FuriEventLoopEventCallback callback,
     void* context);
 
+/** Opaque SPSC ring type */
+typedef struct FuriSpscRing FuriSpscRing;
+
+/** Subscribe to SPSC ring events
+ *
+ * @warning you can only have one subscription for one event type.
+ *
+ * @param      instance       The Event Loop instance
+ * @param      spsc_ring      The SPSC ring to add
+ * @param[in]  event          The Event Loop event to trigger on
+ * @param[in]  callback       The callback to call on event
+ * @param      context        The context for callback
+ */
+void furi_event_loop_subscribe_spsc_ring(
+    FuriEventLoop* instance,
+    FuriSpscRing* spsc_ring,
+    FuriEventLoopEvent event,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
 /** Opaque semaphore type */
 typedef struct FuriSemaphore FuriSemaphore;
 
@@ -319,6 +344,20 @@ void furi_event_loop_unsubscribe(FuriEventLoop* instance, FuriEventLoopObject* o
  */
 bool furi_event_loop_is_subscribed(FuriEventLoop* instance, FuriEventLoopObject* object);
 
+/** Number of buckets in event loop wakeup latency histogram */
+#define FURI_EVENT_LOOP_LATENCY_BUCKET_COUNT (6U)
+
+/**
+ * @brief Get wakeup latency histogram of all event loops
+ *
+ * Latency is the time from the first notification of a sleeping event loop
+ * till its thread runs. Bucket N counts wakeups faster than 10^(N+1)
+ * microseconds, the last one counts the rest. Counters are free running.
+ *
+ * @param[out] histogram      FURI_EVENT_LOOP_LATENCY_BUCKET_COUNT counters
+ */
+void furi_event_loop_get_latency_histogram(uint32_t* histogram);
+
 /**
  * @brief Convenience function for `if(is_subscribed()) unsubscribe()`
  */
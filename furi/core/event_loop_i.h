@@ -6,7 +6,6 @@
 #include "event_loop_tick_i.h"
 
 #include <m-list.h>
-#include <m-bptree.h>
 #include <m-i-list.h>
 
 #include "thread.h"
@@ -30,21 +29,20 @@ struct FuriEventLoopItem {
 
 ILIST_DEF(WaitingList, FuriEventLoopItem, M_POD_OPLIST)
 
-/* Event Loop RB tree */
-#define FURI_EVENT_LOOP_TREE_RANK (4)
+/* Event Loop item table: open addressing, keyed by tracked object */
+#define FURI_EVENT_LOOP_ITEM_TABLE_BITS_MIN (3U)
 
-BPTREE_DEF2( // NOLINT
-    FuriEventLoopTree,
-    FURI_EVENT_LOOP_TREE_RANK,
-    FuriEventLoopObject*, /* pointer to object we track */
-    M_PTR_OPLIST,
-    FuriEventLoopItem*, /* pointer to the FuriEventLoopItem */
-    M_PTR_OPLIST)
-
-#define M_OPL_FuriEventLoopTree_t() BPTREE_OPLIST(FuriEventLoopTree, M_POD_OPLIST)
+typedef struct {
+    FuriEventLoopItem** slots; /* 1 << bits slots, NULL slot is empty */
+    size_t bits;
+    size_t count;
+} FuriEventLoopItemTable;
 
 #define FURI_EVENT_LOOP_FLAG_NOTIFY_INDEX (2)
 
+/* Level item callbacks per processing round */
+#define FURI_EVENT_LOOP_LEVEL_BATCH_SIZE (8U)
+
 typedef enum {
     FuriEventLoopFlagEvent = (1 << 0),
     FuriEventLoopFlagStop = (1 << 1),
@@ -83,8 +81,9 @@ struct FuriEventLoop {
     volatile FuriEventLoopState state;
 
     // Event handling
-    FuriEventLoopTree_t tree;
+    FuriEventLoopItemTable item_table;
     WaitingList_t waiting_list;
+    size_t waiting_count;
 
     // Active timer list
     TimerList_t timer_list;
@@ -94,4 +93,6 @@ struct FuriEventLoop {
     PendingQueue_t pending_queue;
     // Tick event
     FuriEventLoopTick tick;
+    // Cycle counter value of first notification since wakeup, 0 if none
+    uint32_t notify_time;
 };
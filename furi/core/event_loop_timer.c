@@ -77,10 +77,19 @@ static void furi_event_loop_timer_enqueue_request(
 
 uint32_t furi_event_loop_get_timer_wait_time(const FuriEventLoop* instance) {
     uint32_t wait_time = FuriWaitForever;
+    const uint32_t now = xTaskGetTickCount();
 
-    if(!TimerList_empty_p(instance->timer_list)) {
-        FuriEventLoopTimer* timer = TimerList_front(instance->timer_list);
-        wait_time = furi_event_loop_timer_get_remaining_time_private(timer);
+    // Timers are sorted by deadline, latest wakeup of each one is deadline plus slack
+    TimerList_it_t it;
+    for(TimerList_it(it, instance->timer_list); !TimerList_end_p(it); TimerList_next(it)) {
+        const FuriEventLoopTimer* timer = TimerList_cref(it);
+        const uint32_t remaining_time = furi_event_loop_timer_get_remaining_time_private(timer);
+        if(remaining_time >= wait_time) break;
+
+        const uint32_t wakeup =
+            furi_kernel_coalesce_tick(timer->start_time + timer->interval, timer->slack);
+        const int32_t timer_wait_time = (int32_t)(wakeup - now);
+        wait_time = MIN(wait_time, (uint32_t)MAX(timer_wait_time, 0));
     }
 
     return wait_time;
@@ -186,6 +195,14 @@ void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval) {
     furi_event_loop_timer_enqueue_request(timer, FuriEventLoopTimerRequestStart);
 }
 
+void furi_event_loop_timer_set_slack(FuriEventLoopTimer* timer, uint32_t slack) {
+    furi_check(timer);
+    furi_check(timer->owner->thread_id == furi_thread_get_current_id());
+    furi_check(slack < FuriWaitForever);
+
+    timer->slack = slack;
+}
+
 void furi_event_loop_timer_restart(FuriEventLoopTimer* timer) {
     furi_check(timer);
     furi_check(timer->owner->thread_id == furi_thread_get_current_id());
@@ -73,6 +73,17 @@ void furi_event_loop_timer_free(FuriEventLoopTimer* timer);
  */
 void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval);
 
+/**
+ * @brief Set the timer slack.
+ *
+ * Timer is allowed to fire up to slack ticks late, so that it shares a
+ * wakeup with other timers. Takes effect from the next expiry.
+ *
+ * @param[in,out] timer pointer to the timer instance
+ * @param[in] slack allowed delay in ticks, 0 to disable
+ */
+void furi_event_loop_timer_set_slack(FuriEventLoopTimer* timer, uint32_t slack);
+
 /**
  * @brief Restart a timer with the previously set interval.
  *
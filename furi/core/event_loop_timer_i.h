@@ -20,6 +20,7 @@ struct FuriEventLoopTimer {
     uint32_t interval;
     uint32_t start_time;
     uint32_t next_interval;
+    uint32_t slack;
 
     // Interface for the active timer list
     ILIST_INTERFACE(TimerList, FuriEventLoopTimer);
@@ -127,6 +127,15 @@ uint32_t furi_kernel_get_tick_frequency(void) {
     return configTICK_RATE_HZ_RAW;
 }
 
+uint32_t furi_kernel_coalesce_tick(uint32_t deadline, uint32_t slack) {
+    furi_check(slack < FuriWaitForever);
+    if(slack == 0) return deadline;
+
+    // Biggest alignment that still has a multiple inside the window
+    const uint32_t alignment = 1UL << (31 - __builtin_clz(slack + 1));
+    return (deadline + slack) & ~(alignment - 1);
+}
+
 void furi_delay_tick(uint32_t ticks) {
     furi_check(!furi_kernel_is_irq_or_masked());
     furi_check(furi_thread_get_current_id() != xTaskGetIdleTaskHandle());
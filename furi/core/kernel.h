@@ -65,6 +65,19 @@ int32_t furi_kernel_restore_lock(int32_t lock);
  */
 uint32_t furi_kernel_get_tick_frequency(void);
 
+/** Coalesce timer deadline
+ *
+ * Picks the tick in [deadline, deadline + slack] that is a multiple of the
+ * biggest possible power of two. Timers with overlapping windows land on the
+ * same tick and are serviced in a single wakeup.
+ *
+ * @param[in]  deadline  The tick timer is due at
+ * @param[in]  slack     The ticks timer is allowed to be late
+ *
+ * @return     tick to wake up at
+ */
+uint32_t furi_kernel_coalesce_tick(uint32_t deadline, uint32_t slack);
+
 /** Delay execution
  *
  * @warning This should never be called in interrupt request context.
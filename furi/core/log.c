@@ -1,17 +1,61 @@
 #include "log.h"
 #include "check.h"
 #include "mutex.h"
+#include "thread.h"
 #include <furi_hal.h>
 #include <m-list.h>
+#include <ctype.h>
 
 LIST_DEF(FuriLogHandlersList, FuriLogHandler, M_POD_OPLIST)
 
 #define FURI_LOG_LEVEL_DEFAULT FuriLogLevelInfo
 
+#define FURI_LOG_DEFERRED_CAPACITY    (32U) // Power of two
+#define FURI_LOG_DEFERRED_RECORD_SIZE (128U)
+#define FURI_LOG_DEFERRED_TAG_SIZE    (32U) // Longer tags are truncated
+#define FURI_LOG_DEFERRED_STACK_SIZE  (1024U)
+#define FURI_LOG_DEFERRED_FLAG        (1U << 0)
+
+typedef struct {
+    volatile uint32_t sequence;
+    uint32_t tick;
+    uint8_t level;
+    uint8_t tag_size;
+    // Tag and message, both null-terminated
+    char text[FURI_LOG_DEFERRED_RECORD_SIZE - 10U];
+} FuriLogRecord;
+
+_Static_assert(sizeof(FuriLogRecord) == FURI_LOG_DEFERRED_RECORD_SIZE, "Log record size mismatch");
+
+// Bounded multi-producer queue: producers claim a record by moving tail, then publish it
+// through record sequence, so no lock is taken and ISR can log too
+typedef struct {
+    FuriThread* thread;
+    volatile uint32_t tail;
+    uint32_t head;
+    volatile uint32_t dropped;
+    uint32_t dropped_reported;
+    FuriLogRecord records[FURI_LOG_DEFERRED_CAPACITY];
+} FuriLogDeferred;
+
+#define FURI_LOG_BINARY_RECORD_SIZE_MAX (128U)
+
+typedef struct {
+    uint8_t* data;
+    size_t position;
+    bool truncated;
+} FuriLogBinaryWriter;
+
 typedef struct {
     FuriLogLevel log_level;
     FuriMutex* mutex;
     FuriLogHandlersList_t tx_handlers;
+    FuriLogHandlersList_t binary_handlers;
+    // Checked without lock, to skip record encoding nobody listens to
+    volatile size_t tx_handlers_count;
+    volatile size_t binary_handlers_count;
+    FuriLogDeferred* deferred;
+    volatile bool deferred_enabled;
 } FuriLogParams;
 
 static FuriLogParams furi_log = {0};
@@ -36,9 +80,13 @@ void furi_log_init(void) {
     furi_log.log_level = FURI_LOG_LEVEL_DEFAULT;
     furi_log.mutex = furi_mutex_alloc(FuriMutexTypeRecursive);
     FuriLogHandlersList_init(furi_log.tx_handlers);
+    FuriLogHandlersList_init(furi_log.binary_handlers);
 }
 
-bool furi_log_add_handler(FuriLogHandler handler) {
+static bool furi_log_handlers_add(
+    FuriLogHandlersList_t handlers,
+    volatile size_t* count,
+    FuriLogHandler handler) {
     furi_check(handler.callback);
 
     bool ret = true;
@@ -46,17 +94,19 @@ bool furi_log_add_handler(FuriLogHandler handler) {
     furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
 
     FuriLogHandlersList_it_t it;
-    FuriLogHandlersList_it(it, furi_log.tx_handlers);
+    FuriLogHandlersList_it(it, handlers);
     while(!FuriLogHandlersList_end_p(it)) {
         if(memcmp(FuriLogHandlersList_ref(it), &handler, sizeof(FuriLogHandler)) == 0) {
             ret = false;
+            break;
         } else {
             FuriLogHandlersList_next(it);
         }
     }
 
     if(ret) {
-        FuriLogHandlersList_push_back(furi_log.tx_handlers, handler);
+        FuriLogHandlersList_push_back(handlers, handler);
+        (*count)++;
     }
 
     furi_mutex_release(furi_log.mutex);
@@ -64,16 +114,20 @@ bool furi_log_add_handler(FuriLogHandler handler) {
     return ret;
 }
 
-bool furi_log_remove_handler(FuriLogHandler handler) {
+static bool furi_log_handlers_remove(
+    FuriLogHandlersList_t handlers,
+    volatile size_t* count,
+    FuriLogHandler handler) {
     bool ret = false;
 
     furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
 
     FuriLogHandlersList_it_t it;
-    FuriLogHandlersList_it(it, furi_log.tx_handlers);
+    FuriLogHandlersList_it(it, handlers);
     while(!FuriLogHandlersList_end_p(it)) {
         if(memcmp(FuriLogHandlersList_ref(it), &handler, sizeof(FuriLogHandler)) == 0) {
-            FuriLogHandlersList_remove(furi_log.tx_handlers, it);
+            FuriLogHandlersList_remove(handlers, it);
+            (*count)--;
             ret = true;
         } else {
             FuriLogHandlersList_next(it);
@@ -85,6 +139,24 @@ bool furi_log_remove_handler(FuriLogHandler handler) {
     return ret;
 }
 
+bool furi_log_add_handler(FuriLogHandler handler) {
+    return furi_log_handlers_add(furi_log.tx_handlers, &furi_log.tx_handlers_count, handler);
+}
+
+bool furi_log_remove_handler(FuriLogHandler handler) {
+    return furi_log_handlers_remove(furi_log.tx_handlers, &furi_log.tx_handlers_count, handler);
+}
+
+bool furi_log_add_binary_handler(FuriLogHandler handler) {
+    return furi_log_handlers_add(
+        furi_log.binary_handlers, &furi_log.binary_handlers_count, handler);
+}
+
+bool furi_log_remove_binary_handler(FuriLogHandler handler) {
+    return furi_log_handlers_remove(
+        furi_log.binary_handlers, &furi_log.binary_handlers_count, handler);
+}
+
 void furi_log_tx(const uint8_t* data, size_t size) {
     if(!FURI_IS_ISR()) {
         furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
@@ -107,46 +179,377 @@ void furi_log_puts(const char* data) {
     furi_log_tx((const uint8_t*)data, strlen(data));
 }
 
-void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
-    do {
-        if(level > furi_log.log_level) {
-            break;
+static void
+    furi_log_level_get_prefix(FuriLogLevel level, const char** color, const char** letter) {
+    *color = _FURI_LOG_CLR_RESET;
+    *letter = " ";
+    switch(level) {
+    case FuriLogLevelError:
+        *color = _FURI_LOG_CLR_E;
+        *letter = "E";
+        break;
+    case FuriLogLevelWarn:
+        *color = _FURI_LOG_CLR_W;
+        *letter = "W";
+        break;
+    case FuriLogLevelInfo:
+        *color = _FURI_LOG_CLR_I;
+        *letter = "I";
+        break;
+    case FuriLogLevelDebug:
+        *color = _FURI_LOG_CLR_D;
+        *letter = "D";
+        break;
+    case FuriLogLevelTrace:
+        *color = _FURI_LOG_CLR_T;
+        *letter = "T";
+        break;
+    default:
+        break;
+    }
+}
+
+static bool furi_log_deferred_push(
+    FuriLogDeferred* deferred,
+    FuriLogLevel level,
+    const char* tag,
+    const char* format,
+    va_list args) {
+    uint32_t position = __atomic_load_n(&deferred->tail, __ATOMIC_RELAXED);
+    FuriLogRecord* record;
+
+    for(;;) {
+        record = &deferred->records[position % FURI_LOG_DEFERRED_CAPACITY];
+        const uint32_t sequence = __atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE);
+        const int32_t diff = (int32_t)(sequence - position);
+
+        if(diff == 0) {
+            // On failure position is reloaded with current tail
+            if(__atomic_compare_exchange_n(
+                   &deferred->tail,
+                   &position,
+                   position + 1,
+                   true,
+                   __ATOMIC_RELAXED,
+                   __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if(diff < 0) {
+            // Consumer is behind, record is still in use
+            __atomic_add_fetch(&deferred->dropped, 1, __ATOMIC_RELAXED);
+            return false;
+        } else {
+            position = __atomic_load_n(&deferred->tail, __ATOMIC_RELAXED);
         }
+    }
 
-        if(furi_mutex_acquire(furi_log.mutex, furi_kernel_is_running() ? FuriWaitForever : 0) !=
-           FuriStatusOk) {
-            break;
+    // Arguments may point to short living data, so formatting is done right away
+    record->tick = furi_get_tick();
+    record->level = level;
+    const size_t tag_size = MIN(
+        strlcpy(record->text, tag, FURI_LOG_DEFERRED_TAG_SIZE) + 1U, FURI_LOG_DEFERRED_TAG_SIZE);
+    record->tag_size = tag_size;
+    vsnprintf(&record->text[tag_size], sizeof(record->text) - tag_size, format, args);
+
+    __atomic_store_n(&record->sequence, position + 1, __ATOMIC_RELEASE);
+    furi_thread_flags_set(furi_thread_get_id(deferred->thread), FURI_LOG_DEFERRED_FLAG);
+
+    return true;
+}
+
+static void furi_log_deferred_emit(const FuriLogRecord* record) {
+    char header[48];
+    const char* color;
+    const char* log_letter;
+    furi_log_level_get_prefix(record->level, &color, &log_letter);
+
+    snprintf(header, sizeof(header), "%lu %s[%s][", record->tick, color, log_letter);
+    furi_log_puts(header);
+    furi_log_puts(record->text);
+    furi_log_puts("] " _FURI_LOG_CLR_RESET);
+    furi_log_puts(&record->text[record->tag_size]);
+    furi_log_puts("\r\n");
+}
+
+static int32_t furi_log_deferred_worker(void* context) {
+    FuriLogDeferred* deferred = context;
+
+    for(;;) {
+        furi_thread_flags_wait(FURI_LOG_DEFERRED_FLAG, FuriFlagWaitAny, FuriWaitForever);
+
+        furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+
+        for(;;) {
+            FuriLogRecord* record =
+                &deferred->records[deferred->head % FURI_LOG_DEFERRED_CAPACITY];
+            const uint32_t sequence = __atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE);
+            // Not published yet, producer will set the flag again
+            if(sequence != deferred->head + 1) break;
+
+            furi_log_deferred_emit(record);
+
+            __atomic_store_n(
+                &record->sequence, deferred->head + FURI_LOG_DEFERRED_CAPACITY, __ATOMIC_RELEASE);
+            deferred->head++;
+        }
+
+        const uint32_t dropped = __atomic_load_n(&deferred->dropped, __ATOMIC_RELAXED);
+        if(dropped != deferred->dropped_reported) {
+            char message[48];
+            snprintf(
+                message,
+                sizeof(message),
+                "Log: %lu records dropped\r\n",
+                dropped - deferred->dropped_reported);
+            furi_log_puts(message);
+            deferred->dropped_reported = dropped;
         }
 
-        FuriString* string = furi_string_alloc();
+        furi_mutex_release(furi_log.mutex);
+    }
+
+    return 0;
+}
+
+static void furi_log_binary_put(FuriLogBinaryWriter* writer, const void* data, size_t size) {
+    if(writer->truncated) return;
+
+    if(writer->position + size > FURI_LOG_BINARY_RECORD_SIZE_MAX) {
+        writer->truncated = true;
+    } else {
+        memcpy(&writer->data[writer->position], data, size);
+        writer->position += size;
+    }
+}
+
+static void furi_log_binary_put_string(FuriLogBinaryWriter* writer, const char* str) {
+    if(writer->truncated || writer->position >= FURI_LOG_BINARY_RECORD_SIZE_MAX) return;
+
+    if(!str) str = "(null)";
+
+    // Strings are cut to fit, terminator is always kept
+    const size_t space = FURI_LOG_BINARY_RECORD_SIZE_MAX - writer->position;
+    const size_t length = strnlen(str, space - 1U);
+    memcpy(&writer->data[writer->position], str, length);
+    writer->data[writer->position + length] = '\0';
+    writer->position += length + 1U;
+    writer->truncated = str[length] != '\0';
+}
+
+static void furi_log_binary_put_integer(FuriLogBinaryWriter* writer, size_t size, va_list* args) {
+    if(size == sizeof(uint64_t)) {
+        const uint64_t value = va_arg(*args, uint64_t);
+        furi_log_binary_put(writer, &value, sizeof(value));
+    } else {
+        const uint32_t value = va_arg(*args, uint32_t);
+        furi_log_binary_put(writer, &value, sizeof(value));
+    }
+}
 
-        const char* color = _FURI_LOG_CLR_RESET;
-        const char* log_letter = " ";
-        switch(level) {
-        case FuriLogLevelError:
-            color = _FURI_LOG_CLR_E;
-            log_letter = "E";
+// Arguments are taken the same way printf does, but stored as is
+static void
+    furi_log_binary_put_args(FuriLogBinaryWriter* writer, const char* format, va_list* args) {
+    for(const char* p = format; *p && !writer->truncated; p++) {
+        if(*p != '%') continue;
+        if(*++p == '%') continue;
+
+        while(*p && strchr("-+ #0", *p)) {
+            p++;
+        }
+
+        for(; *p && (isdigit((unsigned char)*p) || *p == '.' || *p == '*'); p++) {
+            if(*p == '*') furi_log_binary_put_integer(writer, sizeof(int), args);
+        }
+
+        size_t size = sizeof(int);
+        size_t long_count = 0;
+        for(; *p && strchr("hlLqjzt", *p); p++) {
+            if(*p == 'l') {
+                size = (++long_count > 1) ? sizeof(long long) : sizeof(long);
+            } else if(*p == 'q' || *p == 'L') {
+                size = sizeof(long long);
+            } else if(*p == 'j') {
+                size = sizeof(intmax_t);
+            } else if(*p == 'z') {
+                size = sizeof(size_t);
+            } else if(*p == 't') {
+                size = sizeof(ptrdiff_t);
+            }
+        }
+
+        switch(*p) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            furi_log_binary_put_integer(writer, size, args);
             break;
-        case FuriLogLevelWarn:
-            color = _FURI_LOG_CLR_W;
-            log_letter = "W";
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A': {
+            const double value = va_arg(*args, double);
+            furi_log_binary_put(writer, &value, sizeof(value));
             break;
-        case FuriLogLevelInfo:
-            color = _FURI_LOG_CLR_I;
-            log_letter = "I";
+        }
+        case 's':
+            furi_log_binary_put_string(writer, va_arg(*args, const char*));
             break;
-        case FuriLogLevelDebug:
-            color = _FURI_LOG_CLR_D;
-            log_letter = "D";
+        case 'p': {
+            const uint32_t value = (uintptr_t)va_arg(*args, void*);
+            furi_log_binary_put(writer, &value, sizeof(value));
             break;
-        case FuriLogLevelTrace:
-            color = _FURI_LOG_CLR_T;
-            log_letter = "T";
+        }
+        case 'n':
+            (void)va_arg(*args, void*);
             break;
         default:
+            // Unknown conversion, the rest of arguments can't be located
+            writer->truncated = true;
+            return;
+        }
+    }
+}
+
+static uint32_t furi_log_binary_hash(const char* str) {
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    for(; *str; str++) {
+        hash = (hash ^ (uint8_t)*str) * 16777619UL;
+    }
+    return hash;
+}
+
+static void furi_log_binary_print(
+    FuriLogLevel level,
+    const char* tag,
+    const char* format,
+    va_list args) {
+    uint8_t data[FURI_LOG_BINARY_RECORD_SIZE_MAX];
+    FuriLogBinaryWriter writer = {.data = data};
+
+    const uintptr_t format_address = (uintptr_t)format;
+    // Firmware strings are resolved from ELF, application ones are sent as is
+    const bool format_inline =
+        format_address < furi_hal_flash_get_base() ||
+        format_address >= (uintptr_t)furi_hal_flash_get_free_start_address();
+
+    FuriLogBinaryHeader header = {
+        .sync = FURI_LOG_BINARY_SYNC,
+        .level = level,
+        .timestamp = DWT->CYCCNT,
+        .thread_id = FURI_IS_ISR() ? 0 : (uintptr_t)furi_thread_get_current_id(),
+        .tag_hash = furi_log_binary_hash(tag),
+        .format = format_inline ? 0 : format_address,
+    };
+    furi_log_binary_put(&writer, &header, sizeof(header));
+
+    if(format_inline) {
+        header.flags |= FuriLogBinaryFlagFormatInline;
+        furi_log_binary_put_string(&writer, format);
+    }
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+    furi_log_binary_put_args(&writer, format, &args_copy);
+    va_end(args_copy);
+
+    if(writer.truncated) header.flags |= FuriLogBinaryFlagTruncated;
+    header.size = writer.position;
+    memcpy(data, &header, sizeof(header));
+
+    if(!FURI_IS_ISR()) {
+        furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+    } else {
+        if(furi_mutex_get_owner(furi_log.mutex)) return;
+    }
+
+    FuriLogHandlersList_it_t it;
+    FuriLogHandlersList_it(it, furi_log.binary_handlers);
+    while(!FuriLogHandlersList_end_p(it)) {
+        FuriLogHandlersList_ref(it)->callback(
+            data, writer.position, FuriLogHandlersList_ref(it)->context);
+        FuriLogHandlersList_next(it);
+    }
+
+    if(!FURI_IS_ISR()) furi_mutex_release(furi_log.mutex);
+}
+
+void furi_log_set_deferred(bool deferred) {
+    furi_check(furi_kernel_is_running());
+    furi_check(!FURI_IS_ISR());
+
+    // Queue and thread stay once created: producers may be inside the queue at any moment
+    if(deferred && !furi_log.deferred) {
+        FuriLogDeferred* instance = malloc(sizeof(FuriLogDeferred));
+        for(size_t i = 0; i < FURI_LOG_DEFERRED_CAPACITY; i++) {
+            instance->records[i].sequence = i;
+        }
+
+        instance->thread = furi_thread_alloc_ex(
+            "LogDeferred", FURI_LOG_DEFERRED_STACK_SIZE, furi_log_deferred_worker, instance);
+        furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+        furi_thread_start(instance->thread);
+
+        __atomic_store_n(&furi_log.deferred, instance, __ATOMIC_RELEASE);
+    }
+
+    furi_log.deferred_enabled = deferred;
+}
+
+bool furi_log_get_deferred(void) {
+    return furi_log.deferred_enabled;
+}
+
+uint32_t furi_log_get_dropped(void) {
+    FuriLogDeferred* deferred = __atomic_load_n(&furi_log.deferred, __ATOMIC_ACQUIRE);
+    return deferred ? __atomic_load_n(&deferred->dropped, __ATOMIC_RELAXED) : 0;
+}
+
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
+    do {
+        if(level > furi_log.log_level) {
+            break;
+        }
+
+        if(furi_log.binary_handlers_count) {
+            va_list args;
+            va_start(args, format);
+            furi_log_binary_print(level, tag, format, args);
+            va_end(args);
+        }
+
+        if(!furi_log.tx_handlers_count) {
+            break;
+        }
+
+        if(furi_log.deferred_enabled) {
+            FuriLogDeferred* deferred = __atomic_load_n(&furi_log.deferred, __ATOMIC_ACQUIRE);
+            va_list args;
+            va_start(args, format);
+            furi_log_deferred_push(deferred, level, tag, format, args);
+            va_end(args);
+            break;
+        }
+
+        if(furi_mutex_acquire(furi_log.mutex, furi_kernel_is_running() ? FuriWaitForever : 0) !=
+           FuriStatusOk) {
             break;
         }
 
+        FURI_STRING_DECLARE(string);
+
+        const char* color;
+        const char* log_letter;
+        furi_log_level_get_prefix(level, &color, &log_letter);
+
         // Timestamp
         furi_string_printf(
             string, "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, furi_get_tick(), color, log_letter, tag);
@@ -159,7 +562,7 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
         va_end(args);
 
         furi_log_puts(furi_string_get_cstr(string));
-        furi_string_free(string);
+        furi_string_deinit(string);
 
         furi_log_puts("\r\n");
 
@@ -170,15 +573,14 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
 void furi_log_print_raw_format(FuriLogLevel level, const char* format, ...) {
     if(level <= furi_log.log_level &&
        furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
-        FuriString* string;
-        string = furi_string_alloc();
+        FURI_STRING_DECLARE(string);
         va_list args;
         va_start(args, format);
         furi_string_vprintf(string, format, args);
         va_end(args);
 
         furi_log_puts(furi_string_get_cstr(string));
-        furi_string_free(string);
+        furi_string_deinit(string);
 
         furi_mutex_release(furi_log.mutex);
     }
@@ -46,6 +46,34 @@ typedef struct {
     void* context;
 } FuriLogHandler;
 
+/** Binary log record sync byte */
+#define FURI_LOG_BINARY_SYNC (0xA5U)
+
+typedef enum {
+    FuriLogBinaryFlagFormatInline = (1 << 0), /**< Format string follows header */
+    FuriLogBinaryFlagTruncated = (1 << 1), /**< Not all arguments fit the record */
+} FuriLogBinaryFlag;
+
+/** Binary log record header
+ *
+ * Header is followed by null-terminated format string, if it is not a part of
+ * firmware image, and by arguments in printf order. Integers and pointers are
+ * stored as they are passed on target: 4 bytes, or 8 for (l)l/j modifiers,
+ * floating point values take 8 bytes, strings are stored null-terminated.
+ * All values are little endian. Format and tag strings are resolved by host
+ * from firmware ELF, see scripts/logdecode.py.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t sync; /**< FURI_LOG_BINARY_SYNC */
+    uint8_t size; /**< Record size, header included */
+    uint8_t level; /**< FuriLogLevel */
+    uint8_t flags; /**< FuriLogBinaryFlag */
+    uint32_t timestamp; /**< DWT cycle counter */
+    uint32_t thread_id; /**< FuriThreadId, 0 for ISR */
+    uint32_t tag_hash; /**< FNV-1a hash of tag */
+    uint32_t format; /**< Format string address, 0 if inline */
+} FuriLogBinaryHeader;
+
 /** Initialize logging */
 void furi_log_init(void);
 
@@ -65,6 +93,25 @@ bool furi_log_add_handler(FuriLogHandler handler);
  */
 bool furi_log_remove_handler(FuriLogHandler handler);
 
+/** Add binary log callback
+ *
+ * Callback receives whole FuriLogBinaryHeader prefixed records produced by
+ * FURI_LOG_x calls, no text formatting is done for them.
+ *
+ * @param[in]  handler  The callback and its context
+ *
+ * @return     true on success, false otherwise
+ */
+bool furi_log_add_binary_handler(FuriLogHandler handler);
+
+/** Remove binary log callback
+ *
+ * @param[in]  handler  The callback and its context
+ *
+ * @return     true on success, false otherwise
+ */
+bool furi_log_remove_binary_handler(FuriLogHandler handler);
+
 /** Transmit data through log IO callbacks
  *
  * @param[in]  data  The data
@@ -97,6 +144,31 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
 void furi_log_print_raw_format(FuriLogLevel level, const char* format, ...)
     _ATTRIBUTE((__format__(__printf__, 2, 3)));
 
+/** Enable or disable deferred logging
+ *
+ * In deferred mode log records are formatted into a fixed size queue without
+ * taking any locks, and then sent to handlers by low priority thread. Records
+ * that don't fit the queue are dropped and counted. Raw records and
+ * furi_log_puts are not affected.
+ *
+ * @warning    must be called from thread, after kernel start
+ *
+ * @param[in]  deferred  true to enable deferred logging
+ */
+void furi_log_set_deferred(bool deferred);
+
+/** Get deferred logging state
+ *
+ * @return     true if deferred logging is enabled
+ */
+bool furi_log_get_deferred(void);
+
+/** Get count of deferred log records dropped because of queue overflow
+ *
+ * @return     dropped record count since deferred logging was first enabled
+ */
+uint32_t furi_log_get_dropped(void);
+
 /** Set log level
  *
  * @param[in]  level  The level
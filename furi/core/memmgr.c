@@ -1,4 +1,6 @@
 #include "memmgr.h"
+#include "memmgr_arena_i.h"
+#include "memmgr_heap_i.h"
 #include <string.h>
 #include <furi_hal_memory.h>
 
@@ -8,31 +10,49 @@ extern size_t xPortGetFreeHeapSize(void);
 extern size_t xPortGetTotalHeapSize(void);
 extern size_t xPortGetMinimumEverFreeHeapSize(void);
 
-void* malloc(size_t size) {
-    return pvPortMalloc(size);
-}
+static void* memmgr_malloc(size_t size, const void* caller) {
+    memmgr_heap_callsite_record(caller, size);
 
-void free(void* ptr) {
-    vPortFree(ptr);
+    // Threads with arena attached are served from it first
+    void* p = memmgr_arena_malloc_current(size);
+    if(p == NULL) p = pvPortMalloc(size);
+
+    return p;
 }
 
-void* realloc(void* ptr, size_t size) {
+static void* memmgr_realloc(void* ptr, size_t size, const void* caller) {
     if(size == 0) {
-        vPortFree(ptr);
+        free(ptr);
         return NULL;
     }
 
-    void* p = pvPortMalloc(size);
+    void* p = memmgr_malloc(size, caller);
     if(ptr != NULL) {
-        memcpy(p, ptr, size);
-        vPortFree(ptr);
+        // Arena knows object size, heap blocks keep old behavior
+        size_t arena_size = memmgr_arena_get_object_size(ptr);
+        memcpy(p, ptr, (arena_size && arena_size < size) ? arena_size : size);
+        free(ptr);
     }
 
     return p;
 }
 
+void* malloc(size_t size) {
+    return memmgr_malloc(size, __builtin_return_address(0));
+}
+
+void free(void* ptr) {
+    if(!memmgr_arena_release(ptr) && !furi_hal_memory_free(ptr)) {
+        vPortFree(ptr);
+    }
+}
+
+void* realloc(void* ptr, size_t size) {
+    return memmgr_realloc(ptr, size, __builtin_return_address(0));
+}
+
 void* calloc(size_t count, size_t size) {
-    return pvPortMalloc(count * size);
+    return memmgr_malloc(count * size, __builtin_return_address(0));
 }
 
 char* strdup(const char* s) {
@@ -40,7 +60,7 @@ char* strdup(const char* s) {
     furi_check(((uint32_t)s << 2) != 0);
 
     size_t siz = strlen(s) + 1;
-    char* y = pvPortMalloc(siz);
+    char* y = memmgr_malloc(siz, __builtin_return_address(0));
     memcpy(y, s, siz);
 
     return y;
@@ -60,22 +80,22 @@ size_t memmgr_get_minimum_free_heap(void) {
 
 void* __wrap__malloc_r(struct _reent* r, size_t size) {
     UNUSED(r);
-    return pvPortMalloc(size);
+    return memmgr_malloc(size, __builtin_return_address(0));
 }
 
 void __wrap__free_r(struct _reent* r, void* ptr) {
     UNUSED(r);
-    vPortFree(ptr);
+    free(ptr);
 }
 
 void* __wrap__calloc_r(struct _reent* r, size_t count, size_t size) {
     UNUSED(r);
-    return calloc(count, size);
+    return memmgr_malloc(count * size, __builtin_return_address(0));
 }
 
 void* __wrap__realloc_r(struct _reent* r, void* ptr, size_t size) {
     UNUSED(r);
-    return realloc(ptr, size);
+    return memmgr_realloc(ptr, size, __builtin_return_address(0));
 }
 
 void* memmgr_alloc_from_pool(size_t size) {
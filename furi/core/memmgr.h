@@ -51,7 +51,11 @@ void* aligned_malloc(size_t size, size_t alignment);
 void aligned_free(void* p);
 
 /**
- * @brief Allocate memory from separate memory pool. That memory can't be freed.
+ * @brief Allocate memory from separate memory pool.
+ *
+ * Pool is meant for large long-lived buffers, it takes pressure off the main
+ * heap. Falls back to the main heap when the pool is exhausted. Memory is
+ * zeroed and 8 byte aligned, release it with free().
  * 
  * @param size 
  * @return void* 
@@ -0,0 +1,166 @@
+#include "memmgr_arena_i.h"
+#include "memmgr.h"
+#include "thread_i.h"
+#include "check.h"
+#include "common_defines.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define MEMMGR_ARENA_ALIGN(x) (((x) + 7U) & ~(size_t)7U)
+
+#define MEMMGR_ARENA_CHUNK_TAG  (1U)
+#define MEMMGR_ARENA_FREED_SIZE (SIZE_MAX)
+
+typedef struct MemmgrArenaChunk {
+    struct MemmgrArenaChunk* next;
+    size_t size;
+    size_t used;
+    size_t live; // Objects not freed yet
+    bool detached; // Arena was released, chunk goes away with its last object
+    uint8_t data[] __attribute__((aligned(8)));
+} MemmgrArenaChunk;
+
+// Placed in front of every object, same layout as heap block header:
+// heap keeps NULL in the first word of allocated blocks, arena keeps tagged chunk pointer
+typedef struct {
+    uintptr_t chunk;
+    size_t size;
+} MemmgrArenaHeader;
+
+struct MemmgrArena {
+    MemmgrArenaChunk* chunks; // Newest first, only the first one is bumped
+    size_t chunk_size;
+    size_t max_size;
+    size_t size;
+    size_t used;
+};
+
+static inline MemmgrArenaHeader* memmgr_arena_get_header(const void* ptr) {
+    return (MemmgrArenaHeader*)ptr - 1;
+}
+
+static inline MemmgrArenaChunk* memmgr_arena_get_chunk(const void* ptr) {
+    const uintptr_t chunk = memmgr_arena_get_header(ptr)->chunk;
+    if(chunk & MEMMGR_ARENA_CHUNK_TAG) {
+        return (MemmgrArenaChunk*)(chunk & ~(uintptr_t)MEMMGR_ARENA_CHUNK_TAG);
+    } else {
+        return NULL;
+    }
+}
+
+MemmgrArena* memmgr_arena_alloc(size_t chunk_size, size_t max_size) {
+    furi_check(chunk_size >= sizeof(MemmgrArenaHeader) * 2U);
+    furi_check(!max_size || max_size >= chunk_size);
+
+    MemmgrArena* arena = malloc(sizeof(MemmgrArena));
+    arena->chunk_size = MEMMGR_ARENA_ALIGN(chunk_size);
+    arena->max_size = max_size;
+
+    return arena;
+}
+
+void memmgr_arena_free(MemmgrArena* arena) {
+    furi_check(arena);
+
+    MemmgrArenaChunk* chunk = arena->chunks;
+    while(chunk) {
+        MemmgrArenaChunk* next = chunk->next;
+
+        vTaskSuspendAll();
+        chunk->detached = true;
+        const bool chunk_free = !chunk->live;
+        (void)xTaskResumeAll();
+
+        if(chunk_free) vPortFree(chunk);
+        chunk = next;
+    }
+
+    free(arena);
+}
+
+void* memmgr_arena_malloc(MemmgrArena* arena, size_t size) {
+    furi_check(arena);
+
+    // Big buffers would eat the arena in no time, leave them to the heap
+    const size_t block_size = sizeof(MemmgrArenaHeader) + MEMMGR_ARENA_ALIGN(size);
+    if(size == 0 || block_size > arena->chunk_size / 2U) return NULL;
+
+    void* ptr = NULL;
+
+    vTaskSuspendAll();
+    MemmgrArenaChunk* chunk = arena->chunks;
+    if(!chunk || chunk->size - chunk->used < block_size) {
+        if(!arena->max_size || arena->size + arena->chunk_size <= arena->max_size) {
+            // Chunks are zeroed by the heap and never reused
+            chunk = pvPortMalloc(sizeof(MemmgrArenaChunk) + arena->chunk_size);
+            chunk->size = arena->chunk_size;
+            chunk->next = arena->chunks;
+            arena->chunks = chunk;
+            arena->size += arena->chunk_size;
+        } else {
+            chunk = NULL;
+        }
+    }
+
+    if(chunk) {
+        MemmgrArenaHeader* header = (MemmgrArenaHeader*)&chunk->data[chunk->used];
+        header->chunk = (uintptr_t)chunk | MEMMGR_ARENA_CHUNK_TAG;
+        header->size = size;
+        chunk->used += block_size;
+        chunk->live++;
+        arena->used += block_size;
+        ptr = header + 1;
+    }
+    (void)xTaskResumeAll();
+
+    return ptr;
+}
+
+size_t memmgr_arena_get_size(MemmgrArena* arena) {
+    furi_check(arena);
+    return arena->size;
+}
+
+size_t memmgr_arena_get_used(MemmgrArena* arena) {
+    furi_check(arena);
+    return arena->used;
+}
+
+void* memmgr_arena_malloc_current(size_t size) {
+    // TLS is not available before scheduler start, heap will deal with ISR
+    if(FURI_IS_IRQ_MODE() || xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        return NULL;
+    }
+
+    FuriThread* thread = furi_thread_get_current();
+    MemmgrArena* arena = thread ? furi_thread_get_arena(thread) : NULL;
+
+    return arena ? memmgr_arena_malloc(arena, size) : NULL;
+}
+
+size_t memmgr_arena_get_object_size(const void* ptr) {
+    if(!ptr || !memmgr_arena_get_chunk(ptr)) return 0;
+    return memmgr_arena_get_header(ptr)->size;
+}
+
+bool memmgr_arena_release(void* ptr) {
+    if(!ptr) return false;
+
+    MemmgrArenaChunk* chunk = memmgr_arena_get_chunk(ptr);
+    if(!chunk) return false;
+
+    MemmgrArenaHeader* header = memmgr_arena_get_header(ptr);
+    furi_check(header->size != MEMMGR_ARENA_FREED_SIZE, "Arena double free");
+
+    vTaskSuspendAll();
+    header->size = MEMMGR_ARENA_FREED_SIZE;
+    furi_check(chunk->live);
+    chunk->live--;
+    const bool chunk_free = chunk->detached && !chunk->live;
+    (void)xTaskResumeAll();
+
+    if(chunk_free) vPortFree(chunk);
+
+    return true;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file memmgr_arena.h
+ * Furi: bump allocation arena
+ *
+ * Arena serves allocations from big heap chunks by bumping a pointer, chunks
+ * are added on demand up to the arena size limit. Attached to a thread with
+ * furi_thread_set_arena, it serves all malloc calls made by that thread.
+ *
+ * Arena objects may be released with free as usual, the memory is not reused
+ * by the arena though. Releasing the arena returns all chunks to the heap in
+ * one go, chunks that still have live objects (for example ones handed over
+ * to other threads) are returned once their last object is freed.
+ */
+#pragma once
+
+#include "base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct MemmgrArena MemmgrArena;
+
+/** Allocate arena
+ *
+ * No memory is taken from the heap until the first allocation.
+ *
+ * @param[in]  chunk_size  heap chunk size in bytes
+ * @param[in]  max_size    arena size limit in bytes, 0 for no limit
+ *
+ * @return     pointer to MemmgrArena instance
+ */
+MemmgrArena* memmgr_arena_alloc(size_t chunk_size, size_t max_size);
+
+/** Free arena
+ *
+ * Arena MUST NOT be attached to a running thread.
+ *
+ * @param      arena  pointer to MemmgrArena instance
+ */
+void memmgr_arena_free(MemmgrArena* arena);
+
+/** Allocate zero initialized object from arena
+ *
+ * Objects bigger than half of a chunk are not served by the arena.
+ *
+ * @param      arena  pointer to MemmgrArena instance
+ * @param[in]  size   object size in bytes
+ *
+ * @return     pointer to object, NULL if arena can't serve the request
+ */
+void* memmgr_arena_malloc(MemmgrArena* arena, size_t size);
+
+/** Get heap size held by arena
+ *
+ * @param      arena  pointer to MemmgrArena instance
+ *
+ * @return     size in bytes
+ */
+size_t memmgr_arena_get_size(MemmgrArena* arena);
+
+/** Get arena size handed out to objects
+ *
+ * @param      arena  pointer to MemmgrArena instance
+ *
+ * @return     size in bytes
+ */
+size_t memmgr_arena_get_used(MemmgrArena* arena);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "memmgr_arena.h"
+
+/** Allocate from arena attached to current thread
+ *
+ * @return     pointer to object, NULL if there is no arena or it can't serve the request
+ */
+void* memmgr_arena_malloc_current(size_t size);
+
+/** Get arena object size
+ *
+ * @return     object size in bytes, 0 if ptr is not an arena object
+ */
+size_t memmgr_arena_get_object_size(const void* ptr);
+
+/** Release arena object
+ *
+ * @return     true if ptr is an arena object
+ */
+bool memmgr_arena_release(void* ptr);
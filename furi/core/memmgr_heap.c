@@ -35,6 +35,7 @@
  */
 
 #include "memmgr_heap.h"
+#include "memmgr_heap_i.h"
 #include "check.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -156,6 +157,26 @@ void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
     (void)xTaskResumeAll();
 }
 
+void memmgr_heap_thread_trace_suspend(void) {
+    memmgr_heap_thread_trace_depth++;
+}
+
+void memmgr_heap_thread_trace_resume(void) {
+    furi_check(memmgr_heap_thread_trace_depth);
+    memmgr_heap_thread_trace_depth--;
+}
+
+size_t memmgr_heap_get_block_size(const void* ptr) {
+    const uint8_t* puc = ptr;
+    if(!pxEnd || puc < ucHeap + xHeapStructSize || puc >= (uint8_t*)pxEnd) return 0;
+
+    // Allocated heap blocks keep NULL in the first header word, arena objects don't
+    const BlockLink_t* pxLink = (const BlockLink_t*)(puc - xHeapStructSize);
+    if(pxLink->pxNextFreeBlock != NULL || !(pxLink->xBlockSize & xBlockAllocatedBit)) return 0;
+
+    return (pxLink->xBlockSize & ~xBlockAllocatedBit) - xHeapStructSize;
+}
+
 size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
     size_t leftovers = MEMMGR_HEAP_UNKNOWN;
     vTaskSuspendAll();
@@ -250,6 +271,164 @@ void memmgr_heap_printf_free_blocks(void) {
     //xTaskResumeAll();
 }
 
+/* Heap statistics */
+#define MEMMGR_HEAP_LATENCY_BUCKETS 32
+#define MEMMGR_HEAP_CALLSITE_COUNT  32
+
+typedef struct {
+    uint32_t alloc_count;
+    uint32_t free_count;
+    uint32_t size_histogram[MEMMGR_HEAP_HISTOGRAM_SIZE];
+    uint32_t latency_histogram[MEMMGR_HEAP_LATENCY_BUCKETS];
+    uint32_t latency_max;
+} MemmgrHeapCounters;
+
+static MemmgrHeapCounters memmgr_heap_counters = {0};
+static MemmgrHeapCallsite memmgr_heap_callsites[MEMMGR_HEAP_CALLSITE_COUNT] = {0};
+static volatile bool memmgr_heap_callsite_trace_enabled = false;
+
+static inline size_t memmgr_heap_log2_ceil(uint32_t value) {
+    return value > 1U ? 32U - __builtin_clz(value - 1U) : 0U;
+}
+
+/* Must be called with scheduler suspended */
+static inline void memmgr_heap_stats_alloc(size_t size, uint32_t cycles) {
+    memmgr_heap_counters.alloc_count++;
+
+    size_t size_bucket = size > 8U ? memmgr_heap_log2_ceil(size) - 3U : 0U;
+    memmgr_heap_counters.size_histogram[MIN(size_bucket, MEMMGR_HEAP_HISTOGRAM_SIZE - 1U)]++;
+
+    size_t latency_bucket = memmgr_heap_log2_ceil(cycles);
+    latency_bucket = MIN(latency_bucket, MEMMGR_HEAP_LATENCY_BUCKETS - 1U);
+    memmgr_heap_counters.latency_histogram[latency_bucket]++;
+    memmgr_heap_counters.latency_max = MAX(memmgr_heap_counters.latency_max, cycles);
+}
+
+/* Must be called with scheduler suspended */
+static uint32_t memmgr_heap_latency_percentile(uint32_t percent) {
+    uint32_t total = 0;
+    for(size_t i = 0; i < MEMMGR_HEAP_LATENCY_BUCKETS; i++) {
+        total += memmgr_heap_counters.latency_histogram[i];
+    }
+
+    const uint32_t target = (uint32_t)(((uint64_t)total * percent + 99U) / 100U);
+    uint32_t accumulated = 0;
+    for(size_t i = 0; i < MEMMGR_HEAP_LATENCY_BUCKETS; i++) {
+        accumulated += memmgr_heap_counters.latency_histogram[i];
+        if(accumulated && accumulated >= target) {
+            return MIN((uint32_t)(1UL << i), memmgr_heap_counters.latency_max);
+        }
+    }
+
+    return 0;
+}
+
+void memmgr_heap_get_stats(MemmgrHeapStats* stats) {
+    furi_check(stats);
+    memset(stats, 0, sizeof(MemmgrHeapStats));
+
+    vTaskSuspendAll();
+    {
+        stats->alloc_count = memmgr_heap_counters.alloc_count;
+        stats->free_count = memmgr_heap_counters.free_count;
+        memcpy(
+            stats->size_histogram,
+            memmgr_heap_counters.size_histogram,
+            sizeof(stats->size_histogram));
+
+        stats->latency_p50 = memmgr_heap_latency_percentile(50);
+        stats->latency_p90 = memmgr_heap_latency_percentile(90);
+        stats->latency_p99 = memmgr_heap_latency_percentile(99);
+        stats->latency_max = memmgr_heap_counters.latency_max;
+
+        BlockLink_t* pxBlock = xStart.pxNextFreeBlock;
+        while(pxBlock->pxNextFreeBlock != NULL) {
+            stats->free_block_count++;
+            stats->max_free_block = MAX(stats->max_free_block, pxBlock->xBlockSize);
+            pxBlock = pxBlock->pxNextFreeBlock;
+        }
+        stats->free_size = xFreeBytesRemaining;
+    }
+    (void)xTaskResumeAll();
+
+    if(stats->free_size) {
+        stats->fragmentation = 100U - (stats->max_free_block * 100U) / stats->free_size;
+    }
+}
+
+void memmgr_heap_reset_stats(void) {
+    vTaskSuspendAll();
+    memset(&memmgr_heap_counters, 0, sizeof(MemmgrHeapCounters));
+    (void)xTaskResumeAll();
+}
+
+void memmgr_heap_enable_callsite_trace(void) {
+    vTaskSuspendAll();
+    memset(memmgr_heap_callsites, 0, sizeof(memmgr_heap_callsites));
+    memmgr_heap_callsite_trace_enabled = true;
+    (void)xTaskResumeAll();
+}
+
+void memmgr_heap_disable_callsite_trace(void) {
+    memmgr_heap_callsite_trace_enabled = false;
+}
+
+void memmgr_heap_callsite_record(const void* pc, size_t size) {
+    if(!memmgr_heap_callsite_trace_enabled || FURI_IS_IRQ_MODE()) return;
+
+    vTaskSuspendAll();
+    {
+        MemmgrHeapCallsite* callsite = NULL;
+        MemmgrHeapCallsite* least_active = &memmgr_heap_callsites[0];
+        for(size_t i = 0; i < MEMMGR_HEAP_CALLSITE_COUNT; i++) {
+            if(memmgr_heap_callsites[i].pc == (uintptr_t)pc) {
+                callsite = &memmgr_heap_callsites[i];
+                break;
+            } else if(memmgr_heap_callsites[i].count < least_active->count) {
+                least_active = &memmgr_heap_callsites[i];
+            }
+        }
+
+        // Table is full: evict the least active one, keep its counters as the error bound
+        if(!callsite) {
+            callsite = least_active;
+            callsite->pc = (uintptr_t)pc;
+        }
+
+        callsite->count++;
+        callsite->size += size;
+    }
+    (void)xTaskResumeAll();
+}
+
+size_t memmgr_heap_get_callsites(MemmgrHeapCallsite* callsites, size_t count) {
+    furi_check(callsites || !count);
+
+    size_t filled = 0;
+    vTaskSuspendAll();
+    {
+        // Insertion sort into caller array, most active first
+        for(size_t i = 0; i < MEMMGR_HEAP_CALLSITE_COUNT; i++) {
+            const MemmgrHeapCallsite* callsite = &memmgr_heap_callsites[i];
+            if(!callsite->count) continue;
+
+            size_t position = filled;
+            while(position > 0 && callsites[position - 1].count < callsite->count) {
+                if(position < count) callsites[position] = callsites[position - 1];
+                position--;
+            }
+
+            if(position < count) {
+                callsites[position] = *callsite;
+                if(filled < count) filled++;
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return filled;
+}
+
 #ifdef HEAP_PRINT_DEBUG
 char* ultoa(unsigned long num, char* str, int radix) {
     char temp[33]; // at radix 2 the string is at most 32 + 1 null long.
@@ -368,6 +547,8 @@ void* pvPortMalloc(size_t xWantedSize) {
 
     vTaskSuspendAll();
     {
+        const uint32_t cycles_start = DWT->CYCCNT;
+
         /* Check the requested block size is not so large that the top bit is
         set.  The top bit of the block size member of the BlockLink_t structure
         is used to determine who owns the block - the application or the
@@ -461,6 +642,10 @@ void* pvPortMalloc(size_t xWantedSize) {
         }
 
         traceMALLOC(pvReturn, xWantedSize);
+
+        if(pvReturn) {
+            memmgr_heap_stats_alloc(to_wipe, DWT->CYCCNT - cycles_start);
+        }
     }
     (void)xTaskResumeAll();
 
@@ -526,6 +711,7 @@ void vPortFree(void* pv) {
 
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
+                    memmgr_heap_counters.free_count++;
                     traceFREE(pv, pxLink->xBlockSize);
                     memset(pv, 0, pxLink->xBlockSize - xHeapStructSize);
                     prvInsertBlockIntoFreeList((BlockLink_t*)pxLink);
@@ -14,6 +14,33 @@ extern "C" {
 
 #define MEMMGR_HEAP_UNKNOWN 0xFFFFFFFF
 
+/** Allocation size histogram bucket count, bucket N counts sizes up to 8 << N
+ * bytes, the last one counts everything bigger
+ */
+#define MEMMGR_HEAP_HISTOGRAM_SIZE 12
+
+/** Heap statistics */
+typedef struct {
+    uint32_t alloc_count; /**< Allocations since boot or last reset */
+    uint32_t free_count; /**< Releases since boot or last reset */
+    uint32_t size_histogram[MEMMGR_HEAP_HISTOGRAM_SIZE]; /**< Allocation count by size */
+    uint32_t latency_p50; /**< Allocation latency median, CPU cycles */
+    uint32_t latency_p90; /**< Allocation latency 90th percentile, CPU cycles */
+    uint32_t latency_p99; /**< Allocation latency 99th percentile, CPU cycles */
+    uint32_t latency_max; /**< Allocation latency maximum, CPU cycles */
+    size_t free_size; /**< Free heap size, bytes */
+    size_t free_block_count; /**< Free block count */
+    size_t max_free_block; /**< Largest free block size, bytes */
+    uint8_t fragmentation; /**< Share of free heap outside of the largest free block, percent */
+} MemmgrHeapStats;
+
+/** Allocation call site counters */
+typedef struct {
+    uintptr_t pc; /**< Caller address */
+    uint32_t count; /**< Allocation count */
+    size_t size; /**< Allocated bytes */
+} MemmgrHeapCallsite;
+
 /** Memmgr heap enable thread allocation tracking
  *
  * @param      thread_id  - thread id to track
@@ -44,6 +71,38 @@ size_t memmgr_heap_get_max_free_block(void);
  */
 void memmgr_heap_printf_free_blocks(void);
 
+/** Memmgr heap get statistics
+ *
+ * Latency percentiles are upper bounds of power of two buckets.
+ *
+ * @param[out] stats  pointer to MemmgrHeapStats to fill
+ */
+void memmgr_heap_get_stats(MemmgrHeapStats* stats);
+
+/** Memmgr heap reset allocation counters, histogram and latency statistics
+ */
+void memmgr_heap_reset_stats(void);
+
+/** Memmgr heap enable allocation call site tracing
+ *
+ * Call site counters are reset on enable. Only the most active call sites
+ * are kept.
+ */
+void memmgr_heap_enable_callsite_trace(void);
+
+/** Memmgr heap disable allocation call site tracing
+ */
+void memmgr_heap_disable_callsite_trace(void);
+
+/** Memmgr heap get allocation call sites
+ *
+ * @param[out] callsites  array to fill, most active first
+ * @param[in]  count      array size
+ *
+ * @return     filled entry count
+ */
+size_t memmgr_heap_get_callsites(MemmgrHeapCallsite* callsites, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
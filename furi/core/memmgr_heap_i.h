@@ -0,0 +1,18 @@
+#pragma once
+
+/** Exclude heap operations from thread allocation tracing
+ *
+ * Scheduler MUST be suspended between suspend and resume calls.
+ */
+void memmgr_heap_thread_trace_suspend(void);
+
+void memmgr_heap_thread_trace_resume(void);
+
+/** Account allocation to the caller, no-op unless call site trace is enabled */
+void memmgr_heap_callsite_record(const void* pc, size_t size);
+
+/** Get usable size of heap block
+ *
+ * @return     block size in bytes, 0 if ptr is not an allocated heap block
+ */
+size_t memmgr_heap_get_block_size(const void* ptr);
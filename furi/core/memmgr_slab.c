@@ -0,0 +1,326 @@
+#include "memmgr_slab_i.h"
+#include "memmgr.h"
+#include "memmgr_heap_i.h"
+#include "thread_i.h"
+#include "check.h"
+#include "common_defines.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define MEMMGR_SLAB_DATA_SHIFT (10U)
+#define MEMMGR_SLAB_DATA_SIZE  (1UL << MEMMGR_SLAB_DATA_SHIFT)
+// Slabs live in one heap block, so owner lookup is address arithmetic
+#define MEMMGR_SLAB_REGION_SLABS (12U)
+#define MEMMGR_SLAB_REGION_SIZE  (MEMMGR_SLAB_REGION_SLABS * MEMMGR_SLAB_DATA_SIZE)
+
+#define MEMMGR_SLAB_CLASS_SHIFT_MIN (4U) // 16 bytes
+#define MEMMGR_SLAB_CLASS_COUNT     (5U) // Up to 256 bytes
+#define MEMMGR_SLAB_OBJECT_SIZE_MAX \
+    (1UL << (MEMMGR_SLAB_CLASS_SHIFT_MIN + MEMMGR_SLAB_CLASS_COUNT - 1U))
+
+#define MEMMGR_SLAB_CACHE_DEPTH (8U)
+// Largest heap block parked in per-thread cache, fits USB RPC storage chunk
+#define MEMMGR_SLAB_CACHE_BLOCK_SIZE_MAX (8192U)
+
+typedef struct MemmgrSlabObject {
+    struct MemmgrSlabObject* next;
+} MemmgrSlabObject;
+
+typedef struct MemmgrSlab {
+    struct MemmgrSlab* next;
+    MemmgrSlabObject* free_list;
+    uint16_t used; // Objects handed out, including ones parked in thread caches
+    uint8_t class_index;
+} MemmgrSlab;
+
+typedef struct {
+    MemmgrSlab* slabs;
+    size_t slab_count;
+    size_t empty_count;
+    size_t used;
+} MemmgrSlabClass;
+
+struct MemmgrSlabCache {
+    MemmgrSlabObject* objects[MEMMGR_SLAB_CLASS_COUNT];
+    uint8_t count[MEMMGR_SLAB_CLASS_COUNT];
+    // One recently freed heap block, bigger than any size class
+    void* block;
+    size_t block_size;
+};
+
+static MemmgrSlabClass memmgr_slab_classes[MEMMGR_SLAB_CLASS_COUNT] = {0};
+static MemmgrSlab memmgr_slab_headers[MEMMGR_SLAB_REGION_SLABS] = {0};
+static uint8_t* memmgr_slab_region = NULL;
+static MemmgrSlab* memmgr_slab_spare = NULL;
+
+static inline size_t memmgr_slab_class_get_size(size_t class_index) {
+    return 1UL << (MEMMGR_SLAB_CLASS_SHIFT_MIN + class_index);
+}
+
+static inline size_t memmgr_slab_class_get_index(size_t size) {
+    if(size <= memmgr_slab_class_get_size(0)) return 0;
+    return (32U - __builtin_clz(size - 1U)) - MEMMGR_SLAB_CLASS_SHIFT_MIN;
+}
+
+static MemmgrSlabCache* memmgr_slab_get_cache(void) {
+    // TLS is not available before scheduler start
+    if(xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) return NULL;
+
+    FuriThread* thread = furi_thread_get_current();
+    return thread ? furi_thread_get_slab_cache(thread) : NULL;
+}
+
+static bool memmgr_slab_is_traced(void) {
+    if(xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) return false;
+
+    FuriThread* thread = furi_thread_get_current();
+    return thread ? furi_thread_is_heap_trace_enabled(thread) : false;
+}
+
+static inline uint8_t* memmgr_slab_get_data(const MemmgrSlab* slab) {
+    return memmgr_slab_region + (size_t)(slab - memmgr_slab_headers) * MEMMGR_SLAB_DATA_SIZE;
+}
+
+static MemmgrSlab* memmgr_slab_find(const void* ptr) {
+    if(!memmgr_slab_region) return NULL;
+
+    const uintptr_t offset = (uintptr_t)ptr - (uintptr_t)memmgr_slab_region;
+    if(offset >= MEMMGR_SLAB_REGION_SIZE) return NULL;
+
+    return &memmgr_slab_headers[offset >> MEMMGR_SLAB_DATA_SHIFT];
+}
+
+// Called with scheduler suspended
+static MemmgrSlab* memmgr_slab_spare_take(void) {
+    if(!memmgr_slab_region) {
+        // Region is shared by all threads, keep it out of thread arena and heap balance
+        memmgr_heap_thread_trace_suspend();
+        memmgr_slab_region = pvPortMalloc(MEMMGR_SLAB_REGION_SIZE);
+        memmgr_heap_thread_trace_resume();
+
+        for(size_t i = MEMMGR_SLAB_REGION_SLABS; i > 0; i--) {
+            memmgr_slab_headers[i - 1].next = memmgr_slab_spare;
+            memmgr_slab_spare = &memmgr_slab_headers[i - 1];
+        }
+    }
+
+    MemmgrSlab* slab = memmgr_slab_spare;
+    if(slab) memmgr_slab_spare = slab->next;
+
+    return slab;
+}
+
+// Called with scheduler suspended
+static void* memmgr_slab_take(size_t class_index) {
+    MemmgrSlabClass* slab_class = &memmgr_slab_classes[class_index];
+    MemmgrSlab* slab = NULL;
+
+    // Prefer partially used slabs, so the spare empty one stays empty
+    for(MemmgrSlab* it = slab_class->slabs; it; it = it->next) {
+        if(it->free_list) {
+            slab = it;
+            if(it->used) break;
+        }
+    }
+
+    if(!slab) {
+        // Region exhausted, caller falls back to the heap
+        slab = memmgr_slab_spare_take();
+        if(!slab) return NULL;
+        slab->class_index = class_index;
+        slab->free_list = NULL;
+
+        // Build free list in address order
+        uint8_t* data = memmgr_slab_get_data(slab);
+        const size_t object_size = memmgr_slab_class_get_size(class_index);
+        for(size_t offset = MEMMGR_SLAB_DATA_SIZE; offset > 0;) {
+            offset -= object_size;
+            MemmgrSlabObject* object = (MemmgrSlabObject*)&data[offset];
+            object->next = slab->free_list;
+            slab->free_list = object;
+        }
+
+        slab->next = slab_class->slabs;
+        slab_class->slabs = slab;
+        slab_class->slab_count++;
+        slab_class->empty_count++;
+    }
+
+    if(!slab->used) slab_class->empty_count--;
+
+    MemmgrSlabObject* object = slab->free_list;
+    slab->free_list = object->next;
+    slab->used++;
+    slab_class->used++;
+
+    return object;
+}
+
+// Called with scheduler suspended
+static void memmgr_slab_give(MemmgrSlab* slab, void* ptr) {
+    MemmgrSlabClass* slab_class = &memmgr_slab_classes[slab->class_index];
+
+    MemmgrSlabObject* object = ptr;
+    object->next = slab->free_list;
+    slab->free_list = object;
+    slab->used--;
+    slab_class->used--;
+
+    if(slab->used) return;
+
+    if(slab_class->empty_count) {
+        // Keep only one empty slab per class, return the rest to the region
+        MemmgrSlab** it = &slab_class->slabs;
+        while(*it != slab) {
+            it = &(*it)->next;
+        }
+        *it = slab->next;
+        slab_class->slab_count--;
+
+        slab->next = memmgr_slab_spare;
+        memmgr_slab_spare = slab;
+    } else {
+        slab_class->empty_count++;
+    }
+}
+
+void* memmgr_slab_alloc(size_t size) {
+    furi_check(!FURI_IS_IRQ_MODE());
+
+    // Traced threads allocate from the heap, so their leaks show up in allocation balance
+    if(memmgr_slab_is_traced()) return malloc(size);
+
+    MemmgrSlabCache* cache = memmgr_slab_get_cache();
+
+    if(size > MEMMGR_SLAB_OBJECT_SIZE_MAX) {
+        // Same sized buffers come and go in streams, reuse the last one
+        if(cache && cache->block && cache->block_size >= size) {
+            void* ptr = cache->block;
+            cache->block = NULL;
+            memset(ptr, 0, size);
+            return ptr;
+        }
+        return malloc(size);
+    }
+
+    const size_t class_index = memmgr_slab_class_get_index(size);
+    void* ptr;
+
+    if(cache && cache->objects[class_index]) {
+        // Cache is owned by current thread, no locking required
+        MemmgrSlabObject* object = cache->objects[class_index];
+        cache->objects[class_index] = object->next;
+        cache->count[class_index]--;
+        ptr = object;
+    } else {
+        vTaskSuspendAll();
+        ptr = memmgr_slab_take(class_index);
+        (void)xTaskResumeAll();
+        if(!ptr) return malloc(size);
+    }
+
+    memset(ptr, 0, memmgr_slab_class_get_size(class_index));
+
+    return ptr;
+}
+
+void memmgr_slab_free(void* ptr) {
+    if(!ptr) return;
+
+    furi_check(!FURI_IS_IRQ_MODE());
+
+    MemmgrSlabCache* cache = memmgr_slab_get_cache();
+
+    vTaskSuspendAll();
+    MemmgrSlab* slab = memmgr_slab_find(ptr);
+    if(slab) {
+        const size_t class_index = slab->class_index;
+        if(cache && cache->count[class_index] < MEMMGR_SLAB_CACHE_DEPTH) {
+            MemmgrSlabObject* object = ptr;
+            object->next = cache->objects[class_index];
+            cache->objects[class_index] = object;
+            cache->count[class_index]++;
+        } else {
+            memmgr_slab_give(slab, ptr);
+        }
+    }
+    (void)xTaskResumeAll();
+
+    if(slab) return;
+
+    // Not ours, came from the heap
+    if(cache && !cache->block) {
+        const size_t block_size = memmgr_heap_get_block_size(ptr);
+        if(block_size > MEMMGR_SLAB_OBJECT_SIZE_MAX &&
+           block_size <= MEMMGR_SLAB_CACHE_BLOCK_SIZE_MAX) {
+            cache->block = ptr;
+            cache->block_size = block_size;
+            return;
+        }
+    }
+
+    free(ptr);
+}
+
+void* memmgr_slab_realloc(void* ptr, size_t size) {
+    if(!ptr) return memmgr_slab_alloc(size);
+
+    if(size == 0) {
+        memmgr_slab_free(ptr);
+        return NULL;
+    }
+
+    // Class of a live object does not change, no locking required
+    MemmgrSlab* slab = memmgr_slab_find(ptr);
+    const size_t object_size = slab ? memmgr_slab_class_get_size(slab->class_index) : 0;
+
+    if(!slab) return realloc(ptr, size);
+    if(size <= object_size) return ptr;
+
+    void* new_ptr = memmgr_slab_alloc(size);
+    memcpy(new_ptr, ptr, object_size);
+    memmgr_slab_free(ptr);
+
+    return new_ptr;
+}
+
+void memmgr_slab_get_stats(MemmgrSlabStats* stats) {
+    furi_check(stats);
+
+    memset(stats, 0, sizeof(MemmgrSlabStats));
+
+    vTaskSuspendAll();
+    for(size_t i = 0; i < MEMMGR_SLAB_CLASS_COUNT; i++) {
+        const MemmgrSlabClass* slab_class = &memmgr_slab_classes[i];
+        stats->slab_count += slab_class->slab_count;
+        stats->total_size += slab_class->slab_count * MEMMGR_SLAB_DATA_SIZE;
+        stats->used_size += slab_class->used * memmgr_slab_class_get_size(i);
+        stats->object_count += slab_class->used;
+    }
+    (void)xTaskResumeAll();
+}
+
+MemmgrSlabCache* memmgr_slab_cache_alloc(void) {
+    return malloc(sizeof(MemmgrSlabCache));
+}
+
+void memmgr_slab_cache_free(MemmgrSlabCache* cache) {
+    furi_check(cache);
+
+    vTaskSuspendAll();
+    for(size_t i = 0; i < MEMMGR_SLAB_CLASS_COUNT; i++) {
+        MemmgrSlabObject* object = cache->objects[i];
+        while(object) {
+            MemmgrSlabObject* next = object->next;
+            MemmgrSlab* slab = memmgr_slab_find(object);
+            furi_check(slab);
+            memmgr_slab_give(slab, object);
+            object = next;
+        }
+    }
+    (void)xTaskResumeAll();
+
+    free(cache->block);
+    free(cache);
+}
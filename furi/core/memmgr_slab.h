@@ -0,0 +1,68 @@
+/**
+ * @file memmgr_slab.h
+ * Furi: fixed size object slabs layered on top of the heap
+ *
+ * Small objects are carved out of slabs, one set of slabs per size class, so
+ * that frequent alloc/free cycles of short lived objects do not fragment the
+ * heap. All slabs share one region taken from the heap on first use, once it
+ * is exhausted objects come from malloc. Requests bigger than the largest size
+ * class are passed to malloc as is. Threads with heap trace enabled always use
+ * malloc, so their objects are accounted in the thread allocation balance.
+ *
+ * Threads may opt into a per-thread cache of recently freed objects with
+ * furi_thread_enable_slab_cache, allocations served from the cache do not
+ * suspend the scheduler. The cache also keeps the last freed heap block of up
+ * to 8 KiB, so streams of big same sized buffers do not churn the heap.
+ */
+#pragma once
+
+#include "base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Slab allocator statistics */
+typedef struct {
+    size_t slab_count; /**< Slabs assigned to size classes */
+    size_t total_size; /**< Bytes held by assigned slabs */
+    size_t used_size; /**< Bytes of slab space handed out, including per-thread caches */
+    size_t object_count; /**< Objects handed out, including per-thread caches */
+} MemmgrSlabStats;
+
+/** Allocate zero initialized object
+ *
+ * @param[in]  size  object size in bytes
+ *
+ * @return     pointer to object, never NULL
+ */
+void* memmgr_slab_alloc(size_t size);
+
+/** Free object
+ *
+ * Accepts NULL and pointers obtained from malloc.
+ *
+ * @param      ptr   pointer to object
+ */
+void memmgr_slab_free(void* ptr);
+
+/** Resize object, realloc semantics
+ *
+ * Accepts NULL and pointers obtained from malloc.
+ *
+ * @param      ptr   pointer to object
+ * @param[in]  size  new object size in bytes
+ *
+ * @return     pointer to resized object, NULL if size is 0
+ */
+void* memmgr_slab_realloc(void* ptr, size_t size);
+
+/** Get slab allocator statistics
+ *
+ * @param[out] stats  pointer to MemmgrSlabStats to fill
+ */
+void memmgr_slab_get_stats(MemmgrSlabStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
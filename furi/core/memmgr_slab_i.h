@@ -0,0 +1,10 @@
+#pragma once
+
+#include "memmgr_slab.h"
+
+typedef struct MemmgrSlabCache MemmgrSlabCache;
+
+MemmgrSlabCache* memmgr_slab_cache_alloc(void);
+
+/** Return cached objects to their slabs and free the cache */
+void memmgr_slab_cache_free(MemmgrSlabCache* cache);
@@ -2,6 +2,7 @@
 
 #include <FreeRTOS.h>
 #include <queue.h>
+#include <task.h>
 
 #include "kernel.h"
 #include "check.h"
@@ -140,6 +141,139 @@ FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uin
     return stat;
 }
 
+static uint32_t furi_message_queue_put_batch_from_isr(
+    QueueHandle_t hQueue,
+    const uint8_t* msgs,
+    uint32_t count,
+    uint32_t msg_size) {
+    uint32_t sent = 0;
+    BaseType_t yield = pdFALSE;
+
+    for(; sent < count; sent++) {
+        if(xQueueSendToBackFromISR(hQueue, msgs + sent * msg_size, &yield) != pdTRUE) break;
+    }
+
+    portYIELD_FROM_ISR(yield);
+    return sent;
+}
+
+static uint32_t furi_message_queue_put_batch(
+    QueueHandle_t hQueue,
+    const uint8_t* msgs,
+    uint32_t count,
+    uint32_t msg_size) {
+    uint32_t sent = 0;
+
+    // Woken receiver is only switched to once the whole batch is in
+    vTaskSuspendAll();
+    for(; sent < count; sent++) {
+        if(xQueueSendToBack(hQueue, msgs + sent * msg_size, 0) != pdPASS) break;
+    }
+    (void)xTaskResumeAll();
+
+    return sent;
+}
+
+uint32_t furi_message_queue_put_many(
+    FuriMessageQueue* instance,
+    const void* msgs,
+    uint32_t count,
+    uint32_t timeout) {
+    furi_check(instance);
+    furi_check(msgs || !count);
+
+    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    const uint32_t msg_size = instance->container.uxItemSize;
+    const uint8_t* msg = msgs;
+    uint32_t sent = 0;
+
+    if(furi_kernel_is_irq_or_masked() != 0U) {
+        furi_check(timeout == 0U);
+        sent = furi_message_queue_put_batch_from_isr(hQueue, msg, count, msg_size);
+    } else {
+        sent = furi_message_queue_put_batch(hQueue, msg, count, msg_size);
+
+        // Queue was full: wait for the first one to fit, then batch the rest
+        if(sent == 0 && count && timeout != 0U &&
+           xQueueSendToBack(hQueue, msg, (TickType_t)timeout) == pdPASS) {
+            sent = 1 + furi_message_queue_put_batch(hQueue, msg + msg_size, count - 1, msg_size);
+        }
+    }
+
+    if(sent) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventIn);
+    }
+
+    return sent;
+}
+
+static uint32_t furi_message_queue_get_batch_from_isr(
+    QueueHandle_t hQueue,
+    uint8_t* msgs,
+    uint32_t count,
+    uint32_t msg_size) {
+    uint32_t received = 0;
+    BaseType_t yield = pdFALSE;
+
+    for(; received < count; received++) {
+        if(xQueueReceiveFromISR(hQueue, msgs + received * msg_size, &yield) != pdPASS) break;
+    }
+
+    portYIELD_FROM_ISR(yield);
+    return received;
+}
+
+static uint32_t furi_message_queue_get_batch(
+    QueueHandle_t hQueue,
+    uint8_t* msgs,
+    uint32_t count,
+    uint32_t msg_size) {
+    uint32_t received = 0;
+
+    // Woken sender is only switched to once the whole batch is out
+    vTaskSuspendAll();
+    for(; received < count; received++) {
+        if(xQueueReceive(hQueue, msgs + received * msg_size, 0) != pdPASS) break;
+    }
+    (void)xTaskResumeAll();
+
+    return received;
+}
+
+uint32_t furi_message_queue_get_many(
+    FuriMessageQueue* instance,
+    void* msgs,
+    uint32_t count,
+    uint32_t timeout) {
+    furi_check(instance);
+    furi_check(msgs || !count);
+
+    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    const uint32_t msg_size = instance->container.uxItemSize;
+    uint8_t* msg = msgs;
+    uint32_t received = 0;
+
+    if(furi_kernel_is_irq_or_masked() != 0U) {
+        furi_check(timeout == 0U);
+        received = furi_message_queue_get_batch_from_isr(hQueue, msg, count, msg_size);
+    } else {
+        received = furi_message_queue_get_batch(hQueue, msg, count, msg_size);
+
+        // Queue was empty: wait for the first one, then batch the rest
+        if(received == 0 && count && timeout != 0U &&
+           xQueueReceive(hQueue, msg, (TickType_t)timeout) == pdPASS) {
+            received =
+                1 + furi_message_queue_get_batch(hQueue, msg + msg_size, count - 1, msg_size);
+        }
+    }
+
+    if(received) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+    }
+
+    return received;
+}
+
 uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
     furi_check(instance);
 
@@ -48,6 +48,43 @@ FuriStatus
  */
 FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout);
 
+/** Put several messages into queue
+ *
+ * Messages that fit are put at once: scheduler is locked for the whole batch
+ * and waiting receiver is woken up once. If the queue is full, waits up to
+ * timeout for the first message to fit, and then puts the rest that fit.
+ *
+ * @param      instance  pointer to FuriMessageQueue instance
+ * @param[in]  msgs      array of count messages
+ * @param[in]  count     number of messages
+ * @param[in]  timeout   The timeout, must be 0 in ISR
+ *
+ * @return     number of messages put, less than count if queue got full
+ */
+uint32_t furi_message_queue_put_many(
+    FuriMessageQueue* instance,
+    const void* msgs,
+    uint32_t count,
+    uint32_t timeout);
+
+/** Get several messages from queue
+ *
+ * Batched like furi_message_queue_put_many(). If the queue is empty, waits up
+ * to timeout for the first message.
+ *
+ * @param      instance  pointer to FuriMessageQueue instance
+ * @param[out] msgs      array with room for count messages
+ * @param[in]  count     maximum number of messages
+ * @param[in]  timeout   The timeout, must be 0 in ISR
+ *
+ * @return     number of messages taken
+ */
+uint32_t furi_message_queue_get_many(
+    FuriMessageQueue* instance,
+    void* msgs,
+    uint32_t count,
+    uint32_t timeout);
+
 /** Get queue capacity
  *
  * @param      instance  pointer to FuriMessageQueue instance
@@ -1,12 +1,29 @@
 #include "pubsub.h"
 #include "check.h"
+#include "kernel.h"
+#include "message_queue.h"
 #include "mutex.h"
 
 #include <m-list.h>
+#include <string.h>
+
+typedef struct {
+    uint32_t timestamp;
+    uint8_t message[];
+} FuriPubSubQueueItem;
 
 struct FuriPubSubSubscription {
     FuriPubSubCallback callback;
     void* callback_context;
+    FuriPubSubStats stats;
+    // Asynchronous subscription only
+    FuriPubSub* pubsub;
+    FuriPubSubFilterCallback filter;
+    FuriEventLoop* event_loop;
+    FuriMessageQueue* queue;
+    FuriPubSubQueueItem* tx; // Staging buffer, under pubsub mutex
+    FuriPubSubQueueItem* rx; // Event loop thread buffer
+    size_t message_size;
 };
 
 LIST_DEF(FuriPubSubSubscriptionList, FuriPubSubSubscription, M_POD_OPLIST);
@@ -48,6 +65,7 @@ FuriPubSubSubscription*
     FuriPubSubSubscription* item = FuriPubSubSubscriptionList_push_raw(pubsub->items);
 
     // initialize item
+    memset(item, 0, sizeof(FuriPubSubSubscription));
     item->callback = callback;
     item->callback_context = callback_context;
 
@@ -56,6 +74,68 @@ FuriPubSubSubscription*
     return item;
 }
 
+static void furi_pubsub_stats_add_latency(FuriPubSubStats* stats, uint32_t latency) {
+    stats->delivered++;
+    stats->latency_total += latency;
+    if(latency > stats->latency_max) stats->latency_max = latency;
+}
+
+static void furi_pubsub_queue_callback(FuriEventLoopObject* object, void* context) {
+    FuriPubSubSubscription* item = context;
+    furi_assert(object == item->queue);
+
+    while(furi_message_queue_get(item->queue, item->rx, 0) == FuriStatusOk) {
+        const uint32_t latency = furi_get_tick() - item->rx->timestamp;
+
+        furi_check(furi_mutex_acquire(item->pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+        furi_pubsub_stats_add_latency(&item->stats, latency);
+        furi_check(furi_mutex_release(item->pubsub->mutex) == FuriStatusOk);
+
+        item->callback(item->rx->message, item->callback_context);
+    }
+}
+
+FuriPubSubSubscription* furi_pubsub_subscribe_async(
+    FuriPubSub* pubsub,
+    FuriEventLoop* event_loop,
+    size_t message_size,
+    size_t queue_size,
+    FuriPubSubFilterCallback filter,
+    FuriPubSubCallback callback,
+    void* callback_context) {
+    furi_check(pubsub);
+    furi_check(event_loop);
+    furi_check(message_size);
+    furi_check(queue_size);
+    furi_check(callback);
+
+    const size_t item_size = sizeof(FuriPubSubQueueItem) + message_size;
+    FuriMessageQueue* queue = furi_message_queue_alloc(queue_size, item_size);
+    FuriPubSubQueueItem* tx = malloc(item_size);
+    FuriPubSubQueueItem* rx = malloc(item_size);
+
+    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+    FuriPubSubSubscription* item = FuriPubSubSubscriptionList_push_raw(pubsub->items);
+    memset(item, 0, sizeof(FuriPubSubSubscription));
+
+    item->callback = callback;
+    item->callback_context = callback_context;
+    item->pubsub = pubsub;
+    item->filter = filter;
+    item->event_loop = event_loop;
+    item->queue = queue;
+    item->tx = tx;
+    item->rx = rx;
+    item->message_size = message_size;
+
+    furi_event_loop_subscribe_message_queue(
+        event_loop, queue, FuriEventLoopEventIn, furi_pubsub_queue_callback, item);
+
+    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+
+    return item;
+}
+
 void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_subscription) {
     furi_assert(pubsub);
     furi_assert(pubsub_subscription);
@@ -63,6 +143,11 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
     furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
     bool result = false;
 
+    FuriEventLoop* event_loop = NULL;
+    FuriMessageQueue* queue = NULL;
+    FuriPubSubQueueItem* tx = NULL;
+    FuriPubSubQueueItem* rx = NULL;
+
     // iterate over items
     FuriPubSubSubscriptionList_it_t it;
     for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
@@ -71,6 +156,10 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
 
         // if the iterator is equal to our element
         if(item == pubsub_subscription) {
+            event_loop = item->event_loop;
+            queue = item->queue;
+            tx = item->tx;
+            rx = item->rx;
             FuriPubSubSubscriptionList_remove(pubsub->items, it);
             result = true;
             break;
@@ -79,6 +168,40 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
 
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
     furi_check(result);
+
+    // Removed from the list, publisher can't reach the queue anymore
+    if(queue) {
+        furi_event_loop_unsubscribe(event_loop, queue);
+        furi_message_queue_free(queue);
+        free(tx);
+        free(rx);
+    }
+}
+
+void furi_pubsub_get_stats(
+    FuriPubSub* pubsub,
+    FuriPubSubSubscription* pubsub_subscription,
+    FuriPubSubStats* stats) {
+    furi_check(pubsub);
+    furi_check(pubsub_subscription);
+    furi_check(stats);
+
+    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+    *stats = pubsub_subscription->stats;
+    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+}
+
+static void furi_pubsub_enqueue(FuriPubSubSubscription* item, const void* message) {
+    if(item->filter && !item->filter(message, item->callback_context)) {
+        item->stats.filtered++;
+        return;
+    }
+
+    item->tx->timestamp = furi_get_tick();
+    memcpy(item->tx->message, message, item->message_size);
+    if(furi_message_queue_put(item->queue, item->tx, 0) != FuriStatusOk) {
+        item->stats.dropped++;
+    }
 }
 
 void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
@@ -90,8 +213,14 @@ void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
     FuriPubSubSubscriptionList_it_t it;
     for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
         FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
-        item->callback(message, item->callback_context);
+        FuriPubSubSubscription* item = FuriPubSubSubscriptionList_ref(it);
+        if(item->queue) {
+            furi_pubsub_enqueue(item, message);
+        } else {
+            const uint32_t start = furi_get_tick();
+            item->callback(message, item->callback_context);
+            furi_pubsub_stats_add_latency(&item->stats, furi_get_tick() - start);
+        }
     }
 
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
@@ -4,6 +4,9 @@
  */
 #pragma once
 
+#include "base.h"
+#include "event_loop.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -11,6 +14,27 @@ extern "C" {
 /** FuriPubSub Callback type */
 typedef void (*FuriPubSubCallback)(const void* message, void* context);
 
+/** FuriPubSub Filter callback type
+ *
+ * Called in publisher context, keep it short.
+ *
+ * @return     true to deliver message to subscriber
+ */
+typedef bool (*FuriPubSubFilterCallback)(const void* message, void* context);
+
+/** FuriPubSub subscription statistics
+ *
+ * Latency is the callback run time for synchronous subscriptions and the time
+ * message spent in queue for asynchronous ones.
+ */
+typedef struct {
+    uint32_t delivered; /**< Messages passed to callback */
+    uint32_t filtered; /**< Messages rejected by filter */
+    uint32_t dropped; /**< Messages lost to full queue */
+    uint32_t latency_max; /**< Maximum latency, in ticks */
+    uint32_t latency_total; /**< Sum of latencies, in ticks */
+} FuriPubSubStats;
+
 /** FuriPubSub type */
 typedef struct FuriPubSub FuriPubSub;
 
@@ -44,16 +68,57 @@ void furi_pubsub_free(FuriPubSub* pubsub);
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context);
 
+/** Subscribe to FuriPubSub asynchronously
+ *
+ * Messages are copied to a bounded queue serviced by the event loop, so the
+ * callback runs in event loop thread and never stalls the publisher. When
+ * the queue is full, new messages are dropped and counted.
+ *
+ * Threadsafe, Reentrable. Must be called from the event loop thread.
+ *
+ * @param      pubsub            pointer to FuriPubSub instance
+ * @param      event_loop        event loop to run callback in
+ * @param      message_size      size of messages published to this pubsub
+ * @param      queue_size        maximum number of queued messages
+ * @param[in]  filter            filter callback, NULL to accept all messages
+ * @param[in]  callback          The callback
+ * @param      callback_context  The callback and filter context
+ *
+ * @return     pointer to FuriPubSubSubscription instance
+ */
+FuriPubSubSubscription* furi_pubsub_subscribe_async(
+    FuriPubSub* pubsub,
+    FuriEventLoop* event_loop,
+    size_t message_size,
+    size_t queue_size,
+    FuriPubSubFilterCallback filter,
+    FuriPubSubCallback callback,
+    void* callback_context);
+
 /** Unsubscribe from FuriPubSub
  * 
  * No use of `pubsub_subscription` allowed after call of this method
- * Threadsafe, Reentrable.
+ * Threadsafe, Reentrable. Asynchronous subscription must be unsubscribed from
+ * its event loop thread, pending messages are discarded.
  *
  * @param      pubsub               pointer to FuriPubSub instance
  * @param      pubsub_subscription  pointer to FuriPubSubSubscription instance
  */
 void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_subscription);
 
+/** Get FuriPubSub subscription statistics
+ *
+ * Threadsafe, Reentrable.
+ *
+ * @param      pubsub               pointer to FuriPubSub instance
+ * @param      pubsub_subscription  pointer to FuriPubSubSubscription instance
+ * @param[out] stats                statistics snapshot
+ */
+void furi_pubsub_get_stats(
+    FuriPubSub* pubsub,
+    FuriPubSubSubscription* pubsub_subscription,
+    FuriPubSubStats* stats);
+
 /** Publish message to FuriPubSub
  *
  * Threadsafe, Reentrable.
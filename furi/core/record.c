@@ -8,13 +8,23 @@
 
 #define FURI_RECORD_FLAG_READY (0x1)
 
-typedef struct {
+// Set in holders count while record is destroyed, sends handle openers to locked path
+#define FURI_RECORD_HOLDERS_LOCKED (1UL << 31)
+
+struct FuriRecordHandle {
     FuriEventFlag* flags;
     void* data;
-    size_t holders_count;
-} FuriRecordData;
-
-DICT_DEF2(FuriRecordDataDict, const char*, M_CSTR_DUP_OPLIST, FuriRecordData, M_POD_OPLIST)
+    uint32_t holders_count;
+    // Handle was given out: record is never freed, only emptied on destroy
+    bool pinned;
+};
+
+DICT_DEF2(
+    FuriRecordDataDict,
+    const char*,
+    M_CSTR_DUP_OPLIST,
+    FuriRecordHandle*,
+    M_PTR_OPLIST)
 
 typedef struct {
     FuriMutex* mutex;
@@ -23,16 +33,18 @@ typedef struct {
 
 static FuriRecord* furi_record = NULL;
 
-static FuriRecordData* furi_record_get(const char* name) {
-    return FuriRecordDataDict_get(furi_record->records, name);
+static FuriRecordHandle* furi_record_get(const char* name) {
+    FuriRecordHandle** record_data = FuriRecordDataDict_get(furi_record->records, name);
+    return record_data ? *record_data : NULL;
 }
 
-static void furi_record_put(const char* name, FuriRecordData* record_data) {
-    FuriRecordDataDict_set_at(furi_record->records, name, *record_data);
+static void furi_record_put(const char* name, FuriRecordHandle* record_data) {
+    FuriRecordDataDict_set_at(furi_record->records, name, record_data);
 }
 
-static void furi_record_erase(const char* name, FuriRecordData* record_data) {
+static void furi_record_erase(const char* name, FuriRecordHandle* record_data) {
     furi_event_flag_free(record_data->flags);
+    free(record_data);
     FuriRecordDataDict_erase(furi_record->records, name);
 }
 
@@ -42,16 +54,13 @@ void furi_record_init(void) {
     FuriRecordDataDict_init(furi_record->records);
 }
 
-static FuriRecordData* furi_record_data_get_or_create(const char* name) {
+static FuriRecordHandle* furi_record_data_get_or_create(const char* name) {
     furi_check(furi_record);
-    FuriRecordData* record_data = furi_record_get(name);
+    FuriRecordHandle* record_data = furi_record_get(name);
     if(!record_data) {
-        FuriRecordData new_record;
-        new_record.flags = furi_event_flag_alloc();
-        new_record.data = NULL;
-        new_record.holders_count = 0;
-        furi_record_put(name, &new_record);
-        record_data = furi_record_get(name);
+        record_data = malloc(sizeof(FuriRecordHandle));
+        record_data->flags = furi_event_flag_alloc();
+        furi_record_put(name, record_data);
     }
     return record_data;
 }
@@ -64,6 +73,21 @@ static void furi_record_unlock(void) {
     furi_check(furi_mutex_release(furi_record->mutex) == FuriStatusOk);
 }
 
+static void* furi_record_wait_ready(FuriRecordHandle* record_data) {
+    void* data = __atomic_load_n(&record_data->data, __ATOMIC_ACQUIRE);
+    if(data) return data;
+
+    // Wait for record to become ready
+    furi_check(
+        furi_event_flag_wait(
+            record_data->flags,
+            FURI_RECORD_FLAG_READY,
+            FuriFlagWaitAny | FuriFlagNoClear,
+            FuriWaitForever) == FURI_RECORD_FLAG_READY);
+
+    return __atomic_load_n(&record_data->data, __ATOMIC_ACQUIRE);
+}
+
 bool furi_record_exists(const char* name) {
     furi_check(furi_record);
     furi_check(name);
@@ -71,7 +95,10 @@ bool furi_record_exists(const char* name) {
     bool ret = false;
 
     furi_record_lock();
-    ret = (furi_record_get(name) != NULL);
+    FuriRecordHandle* record_data = furi_record_get(name);
+    // Pinned record stays in storage after destroy
+    ret = record_data && (!record_data->pinned || record_data->data ||
+                          record_data->holders_count);
     furi_record_unlock();
 
     return ret;
@@ -84,9 +111,9 @@ void furi_record_create(const char* name, void* data) {
     furi_record_lock();
 
     // Get record data and fill it
-    FuriRecordData* record_data = furi_record_data_get_or_create(name);
+    FuriRecordHandle* record_data = furi_record_data_get_or_create(name);
     furi_check(record_data->data == NULL);
-    record_data->data = data;
+    __atomic_store_n(&record_data->data, data, __ATOMIC_RELEASE);
     furi_event_flag_set(record_data->flags, FURI_RECORD_FLAG_READY);
 
     furi_record_unlock();
@@ -100,10 +127,25 @@ bool furi_record_destroy(const char* name) {
 
     furi_record_lock();
 
-    FuriRecordData* record_data = furi_record_get(name);
+    FuriRecordHandle* record_data = furi_record_get(name);
     furi_check(record_data);
-    if(record_data->holders_count == 0) {
-        furi_record_erase(name, record_data);
+
+    // Handle openers don't take the lock, make them wait while record is torn down
+    uint32_t holders_count = 0;
+    if(__atomic_compare_exchange_n(
+           &record_data->holders_count,
+           &holders_count,
+           FURI_RECORD_HOLDERS_LOCKED,
+           false,
+           __ATOMIC_ACQ_REL,
+           __ATOMIC_RELAXED)) {
+        if(record_data->pinned) {
+            __atomic_store_n(&record_data->data, NULL, __ATOMIC_RELEASE);
+            furi_event_flag_clear(record_data->flags, FURI_RECORD_FLAG_READY);
+            __atomic_store_n(&record_data->holders_count, 0, __ATOMIC_RELEASE);
+        } else {
+            furi_record_erase(name, record_data);
+        }
         ret = true;
     }
 
@@ -118,20 +160,12 @@ void* furi_record_open(const char* name) {
 
     furi_record_lock();
 
-    FuriRecordData* record_data = furi_record_data_get_or_create(name);
-    record_data->holders_count++;
+    FuriRecordHandle* record_data = furi_record_data_get_or_create(name);
+    __atomic_fetch_add(&record_data->holders_count, 1, __ATOMIC_ACQ_REL);
 
     furi_record_unlock();
 
-    // Wait for record to become ready
-    furi_check(
-        furi_event_flag_wait(
-            record_data->flags,
-            FURI_RECORD_FLAG_READY,
-            FuriFlagWaitAny | FuriFlagNoClear,
-            FuriWaitForever) == FURI_RECORD_FLAG_READY);
-
-    return record_data->data;
+    return furi_record_wait_ready(record_data);
 }
 
 void furi_record_close(const char* name) {
@@ -140,9 +174,54 @@ void furi_record_close(const char* name) {
 
     furi_record_lock();
 
-    FuriRecordData* record_data = furi_record_get(name);
+    FuriRecordHandle* record_data = furi_record_get(name);
     furi_check(record_data);
-    record_data->holders_count--;
+    furi_check(__atomic_fetch_sub(&record_data->holders_count, 1, __ATOMIC_ACQ_REL) > 0);
+
+    furi_record_unlock();
+}
+
+FuriRecordHandle* furi_record_get_handle(const char* name) {
+    furi_check(furi_record);
+    furi_check(name);
+
+    furi_record_lock();
+
+    FuriRecordHandle* record_data = furi_record_data_get_or_create(name);
+    record_data->pinned = true;
 
     furi_record_unlock();
+
+    return record_data;
+}
+
+void* furi_record_open_handle(FuriRecordHandle* handle) {
+    furi_check(handle);
+
+    uint32_t holders_count = __atomic_load_n(&handle->holders_count, __ATOMIC_RELAXED);
+    while(true) {
+        if(holders_count & FURI_RECORD_HOLDERS_LOCKED) {
+            // Destroy holds the lock until record is consistent again
+            furi_record_lock();
+            __atomic_fetch_add(&handle->holders_count, 1, __ATOMIC_ACQ_REL);
+            furi_record_unlock();
+            break;
+        }
+        if(__atomic_compare_exchange_n(
+               &handle->holders_count,
+               &holders_count,
+               holders_count + 1,
+               true,
+               __ATOMIC_ACQ_REL,
+               __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    return furi_record_wait_ready(handle);
+}
+
+void furi_record_close_handle(FuriRecordHandle* handle) {
+    furi_check(handle);
+    furi_check(__atomic_fetch_sub(&handle->holders_count, 1, __ATOMIC_ACQ_REL) > 0);
 }
@@ -12,6 +12,9 @@
 extern "C" {
 #endif
 
+/** Record handle, resolved once by name */
+typedef struct FuriRecordHandle FuriRecordHandle;
+
 /** Initialize record storage For internal use only.
  */
 void furi_record_init(void);
@@ -62,6 +65,37 @@ FURI_RETURNS_NONNULL void* furi_record_open(const char* name);
  */
 void furi_record_close(const char* name);
 
+/** Get record handle
+ *
+ * Handle is resolved by name once and stays valid forever, even across
+ * record destroy and create. Opening and closing it doesn't take the
+ * record storage lock, use it for records opened often.
+ *
+ * @param      name  record name
+ *
+ * @return     record handle
+ * @note       Thread safe.
+ */
+FURI_RETURNS_NONNULL FuriRecordHandle* furi_record_get_handle(const char* name);
+
+/** Open record by handle
+ *
+ * @param      handle  record handle
+ *
+ * @return     pointer to the record
+ * @note       Thread safe. Open and close must be executed from the same
+ *             thread. Suspends caller thread till record is available
+ */
+FURI_RETURNS_NONNULL void* furi_record_open_handle(FuriRecordHandle* handle);
+
+/** Close record by handle
+ *
+ * @param      handle  record handle
+ * @note       Thread safe. Open and close must be executed from the same
+ *             thread.
+ */
+void furi_record_close_handle(FuriRecordHandle* handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,159 @@
+#include "spsc_ring.h"
+
+#include "check.h"
+#include "common_defines.h"
+#include "memmgr.h"
+
+#include "event_loop_link_i.h"
+
+struct FuriSpscRing {
+    // Free running indexes, wrapped with mask on access
+    uint32_t head; // Written by producer only
+    uint32_t tail; // Written by consumer only
+    size_t mask;
+    size_t element_size;
+    FuriEventLoopLink event_loop_link;
+    uint8_t buffer[];
+};
+
+FuriSpscRing* furi_spsc_ring_alloc(size_t capacity, size_t element_size) {
+    // Capacity must be a power of two and fit free running uint32_t indexes
+    furi_check(capacity > 0U && (capacity & (capacity - 1U)) == 0U && capacity <= (1UL << 31));
+    furi_check(element_size > 0U);
+
+    FuriSpscRing* instance = malloc(sizeof(FuriSpscRing) + capacity * element_size);
+    instance->mask = capacity - 1U;
+    instance->element_size = element_size;
+
+    return instance;
+}
+
+void furi_spsc_ring_free(FuriSpscRing* instance) {
+    furi_check(instance);
+
+    // Event Loop must be disconnected
+    furi_check(!instance->event_loop_link.item_in);
+    furi_check(!instance->event_loop_link.item_out);
+
+    free(instance);
+}
+
+size_t furi_spsc_ring_push(FuriSpscRing* instance, const void* data, size_t count) {
+    furi_check(instance);
+    furi_check(data || !count);
+
+    const uint32_t head = instance->head;
+    const uint32_t tail = __atomic_load_n(&instance->tail, __ATOMIC_ACQUIRE);
+    const size_t capacity = instance->mask + 1U;
+
+    count = MIN(count, capacity - (head - tail));
+    if(count) {
+        const size_t index = head & instance->mask;
+        const size_t first = MIN(count, capacity - index);
+        const size_t element_size = instance->element_size;
+
+        memcpy(&instance->buffer[index * element_size], data, first * element_size);
+        memcpy(
+            instance->buffer,
+            (const uint8_t*)data + first * element_size,
+            (count - first) * element_size);
+
+        // Publish elements only after they are copied
+        __atomic_store_n(&instance->head, head + count, __ATOMIC_RELEASE);
+
+        // Skip event loop critical section when nobody is subscribed
+        if(instance->event_loop_link.item_in) {
+            furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventIn);
+        }
+    }
+
+    return count;
+}
+
+size_t furi_spsc_ring_pop(FuriSpscRing* instance, void* data, size_t count) {
+    furi_check(instance);
+    furi_check(data || !count);
+
+    const uint32_t tail = instance->tail;
+    const uint32_t head = __atomic_load_n(&instance->head, __ATOMIC_ACQUIRE);
+    const size_t capacity = instance->mask + 1U;
+
+    count = MIN(count, (size_t)(head - tail));
+    if(count) {
+        const size_t index = tail & instance->mask;
+        const size_t first = MIN(count, capacity - index);
+        const size_t element_size = instance->element_size;
+
+        memcpy(data, &instance->buffer[index * element_size], first * element_size);
+        memcpy(
+            (uint8_t*)data + first * element_size,
+            instance->buffer,
+            (count - first) * element_size);
+
+        // Release space only after elements are copied out
+        __atomic_store_n(&instance->tail, tail + count, __ATOMIC_RELEASE);
+
+        if(instance->event_loop_link.item_out) {
+            furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+        }
+    }
+
+    return count;
+}
+
+size_t furi_spsc_ring_get_capacity(FuriSpscRing* instance) {
+    furi_check(instance);
+    return instance->mask + 1U;
+}
+
+size_t furi_spsc_ring_get_element_size(FuriSpscRing* instance) {
+    furi_check(instance);
+    return instance->element_size;
+}
+
+size_t furi_spsc_ring_get_count(FuriSpscRing* instance) {
+    furi_check(instance);
+
+    const uint32_t tail = __atomic_load_n(&instance->tail, __ATOMIC_ACQUIRE);
+    const uint32_t head = __atomic_load_n(&instance->head, __ATOMIC_ACQUIRE);
+    return head - tail;
+}
+
+size_t furi_spsc_ring_get_space(FuriSpscRing* instance) {
+    furi_check(instance);
+    return instance->mask + 1U - furi_spsc_ring_get_count(instance);
+}
+
+void furi_spsc_ring_reset(FuriSpscRing* instance) {
+    furi_check(instance);
+
+    instance->head = 0;
+    instance->tail = 0;
+
+    furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+}
+
+static FuriEventLoopLink* furi_spsc_ring_event_loop_get_link(FuriEventLoopObject* object) {
+    FuriSpscRing* instance = object;
+    furi_assert(instance);
+    return &instance->event_loop_link;
+}
+
+static bool
+    furi_spsc_ring_event_loop_get_level(FuriEventLoopObject* object, FuriEventLoopEvent event) {
+    FuriSpscRing* instance = object;
+    furi_assert(instance);
+
+    if(event == FuriEventLoopEventIn) {
+        return furi_spsc_ring_get_count(instance);
+    } else if(event == FuriEventLoopEventOut) {
+        return furi_spsc_ring_get_space(instance);
+    } else {
+        furi_crash();
+    }
+}
+
+const FuriEventLoopContract furi_spsc_ring_event_loop_contract = {
+    .get_link = furi_spsc_ring_event_loop_get_link,
+    .get_level = furi_spsc_ring_event_loop_get_level,
+};
@@ -0,0 +1,103 @@
+/**
+ * @file spsc_ring.h
+ * Furi lock-free single producer single consumer ring buffer.
+ *
+ * Fixed size elements, power of two capacity. Push and pop never block and
+ * never enter a critical section, which makes the ring suitable for
+ * streaming samples from an interrupt to a thread.
+ *
+ * ***NOTE***: only one task or interrupt may push (the producer), and only
+ * one task or interrupt may pop (the consumer).
+ */
+#pragma once
+
+#include "base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriSpscRing FuriSpscRing;
+
+/** Allocate ring
+ *
+ * @param[in]  capacity      Element count, must be a power of two
+ * @param[in]  element_size  Element size in bytes
+ *
+ * @return     pointer to FuriSpscRing instance
+ */
+FuriSpscRing* furi_spsc_ring_alloc(size_t capacity, size_t element_size);
+
+/** Free ring
+ *
+ * @param      instance  pointer to FuriSpscRing instance
+ */
+void furi_spsc_ring_free(FuriSpscRing* instance);
+
+/** Push elements, producer side
+ *
+ * Copies as many elements as there is space for.
+ *
+ * @param      instance  pointer to FuriSpscRing instance
+ * @param[in]  data      pointer to elements
+ * @param[in]  count     element count
+ *
+ * @return     pushed element count
+ */
+size_t furi_spsc_ring_push(FuriSpscRing* instance, const void* data, size_t count);
+
+/** Pop elements, consumer side
+ *
+ * Copies as many elements as available, up to count.
+ *
+ * @param      instance  pointer to FuriSpscRing instance
+ * @param      data      pointer to element storage
+ * @param[in]  count     max element count
+ *
+ * @return     popped element count
+ */
+size_t furi_spsc_ring_pop(FuriSpscRing* instance, void* data, size_t count);
+
+/** Get ring capacity
+ *
+ * @param      instance  pointer to FuriSpscRing instance
+ *
+ * @return     capacity in element count
+ */
+size_t furi_spsc_ring_get_capacity(FuriSpscRing* instance);
+
+/** Get element size
+ *
+ * @param      instance  pointer to FuriSpscRing instance
+ *
+ * @return     element size in bytes
+ */
+size_t furi_spsc_ring_get_element_size(FuriSpscRing* instance);
+
+/** Get element count in ring
+ *
+ * @param      instance  pointer to FuriSpscRing instance
+ *
+ * @return     element count
+ */
+size_t furi_spsc_ring_get_count(FuriSpscRing* instance);
+
+/** Get ring available space
+ *
+ * @param      instance  pointer to FuriSpscRing instance
+ *
+ * @return     element count
+ */
+size_t furi_spsc_ring_get_space(FuriSpscRing* instance);
+
+/** Reset ring
+ *
+ * Must not be called while producer or consumer are active.
+ *
+ * @param      instance  pointer to FuriSpscRing instance
+ */
+void furi_spsc_ring_reset(FuriSpscRing* instance);
+
+#ifdef __cplusplus
+}
+#endif
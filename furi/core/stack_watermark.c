@@ -0,0 +1,86 @@
+#include "stack_watermark.h"
+#include "check.h"
+#include "common_defines.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <string.h>
+
+#include <task_control_block.h>
+
+static FuriStackWatermarkRecord furi_stack_watermark[FURI_STACK_WATERMARK_SIZE];
+static size_t furi_stack_watermark_count = 0;
+static uint32_t furi_stack_watermark_generation = 0;
+
+void furi_stack_watermark_update(const char* name, uint32_t stack_size, uint32_t min_free) {
+    furi_check(!FURI_IS_IRQ_MODE());
+    if(!name || !name[0]) return;
+
+    FURI_CRITICAL_ENTER();
+    size_t index = 0;
+    for(; index < furi_stack_watermark_count; index++) {
+        if(furi_stack_watermark[index].stack_size == stack_size &&
+           strncmp(furi_stack_watermark[index].name, name, FURI_STACK_WATERMARK_NAME_SIZE - 1) ==
+               0) {
+            break;
+        }
+    }
+
+    if(index < furi_stack_watermark_count) {
+        if(min_free < furi_stack_watermark[index].min_free) {
+            furi_stack_watermark[index].min_free = min_free;
+            furi_stack_watermark_generation++;
+        }
+    } else if(index < FURI_STACK_WATERMARK_SIZE) {
+        FuriStackWatermarkRecord* record = &furi_stack_watermark[index];
+        strlcpy(record->name, name, FURI_STACK_WATERMARK_NAME_SIZE);
+        record->stack_size = stack_size;
+        record->min_free = min_free;
+        furi_stack_watermark_count++;
+        furi_stack_watermark_generation++;
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_stack_watermark_sample(void) {
+    furi_check(!FURI_IS_IRQ_MODE());
+
+    vTaskSuspendAll();
+    do {
+        uint32_t count = uxTaskGetNumberOfTasks();
+        TaskStatus_t* task = pvPortMalloc(count * sizeof(TaskStatus_t));
+        if(!task) break;
+
+        count = uxTaskGetSystemState(task, count, NULL);
+        for(uint32_t i = 0U; i < count; i++) {
+            TaskControlBlock* tcb = (TaskControlBlock*)task[i].xHandle;
+            furi_stack_watermark_update(
+                task[i].pcTaskName,
+                (tcb->pxEndOfStack - tcb->pxStack + 1) * sizeof(StackType_t),
+                task[i].usStackHighWaterMark * sizeof(StackType_t));
+        }
+
+        vPortFree(task);
+    } while(false);
+    (void)xTaskResumeAll();
+}
+
+size_t furi_stack_watermark_get_count(void) {
+    FURI_CRITICAL_ENTER();
+    const size_t count = furi_stack_watermark_count;
+    FURI_CRITICAL_EXIT();
+    return count;
+}
+
+void furi_stack_watermark_get(size_t index, FuriStackWatermarkRecord* record) {
+    furi_check(record);
+
+    FURI_CRITICAL_ENTER();
+    furi_check(index < furi_stack_watermark_count);
+    *record = furi_stack_watermark[index];
+    FURI_CRITICAL_EXIT();
+}
+
+uint32_t furi_stack_watermark_get_generation(void) {
+    return __atomic_load_n(&furi_stack_watermark_generation, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,69 @@
+/**
+ * @file stack_watermark.h
+ * Furi stack watermarks: smallest free stack seen per thread.
+ *
+ * Every named thread is recorded when it exits, running threads are recorded
+ * on furi_stack_watermark_sample(). Records are keyed by thread name and
+ * stack size, so the same worker started with a different stack is a
+ * separate record. Table is kept in RAM, persisting it across boots is up
+ * to the caller.
+ */
+#pragma once
+
+#include "base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of records, new threads are dropped once it is full */
+#define FURI_STACK_WATERMARK_SIZE (40U)
+
+/** Thread name storage size, longer names are truncated */
+#define FURI_STACK_WATERMARK_NAME_SIZE (24U)
+
+typedef struct {
+    char name[FURI_STACK_WATERMARK_NAME_SIZE]; /**< thread name */
+    uint32_t stack_size; /**< stack size, bytes */
+    uint32_t min_free; /**< smallest free stack seen, bytes */
+} FuriStackWatermarkRecord;
+
+/** Record free stack of a thread
+ *
+ * Record is only changed if min_free is lower than the stored one.
+ * Safe to call from any thread, not from ISR.
+ *
+ * @param[in]  name        thread name, NULL is ignored
+ * @param[in]  stack_size  thread stack size, bytes
+ * @param[in]  min_free    free stack, bytes
+ */
+void furi_stack_watermark_update(const char* name, uint32_t stack_size, uint32_t min_free);
+
+/** Record free stack of all running threads */
+void furi_stack_watermark_sample(void);
+
+/** Get number of records
+ *
+ * @return     record count
+ */
+size_t furi_stack_watermark_get_count(void);
+
+/** Get record
+ *
+ * @param[in]   index   record index, less than furi_stack_watermark_get_count()
+ * @param[out]  record  pointer to FuriStackWatermarkRecord to fill
+ */
+void furi_stack_watermark_get(size_t index, FuriStackWatermarkRecord* record);
+
+/** Get change counter
+ *
+ * Incremented every time a record is added or lowered, compare it with the
+ * one from the last save to know if the table has to be saved again.
+ *
+ * @return     change counter
+ */
+uint32_t furi_stack_watermark_get_generation(void);
+
+#ifdef __cplusplus
+}
+#endif
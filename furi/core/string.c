@@ -1,10 +1,17 @@
 #include "string.h"
+#include "memmgr_slab.h"
+#include "check.h"
 #include <m-string.h>
 
 struct FuriString {
     string_t string;
 };
 
+_Static_assert(sizeof(FuriString) <= sizeof(FuriStringStorage), "FuriStringStorage is too small");
+_Static_assert(
+    _Alignof(FuriString) <= _Alignof(FuriStringStorage),
+    "FuriStringStorage alignment mismatch");
+
 #undef furi_string_alloc_set
 #undef furi_string_set
 #undef furi_string_cmp
@@ -24,19 +31,19 @@ struct FuriString {
 #undef furi_string_cat
 
 FuriString* furi_string_alloc(void) {
-    FuriString* string = malloc(sizeof(FuriString));
+    FuriString* string = memmgr_slab_alloc(sizeof(FuriString));
     string_init(string->string);
     return string;
 }
 
 FuriString* furi_string_alloc_set(const FuriString* s) {
-    FuriString* string = malloc(sizeof(FuriString)); //-V799
+    FuriString* string = memmgr_slab_alloc(sizeof(FuriString)); //-V799
     string_init_set(string->string, s->string);
     return string;
 } //-V773
 
 FuriString* furi_string_alloc_set_str(const char cstr[]) {
-    FuriString* string = malloc(sizeof(FuriString)); //-V799
+    FuriString* string = memmgr_slab_alloc(sizeof(FuriString)); //-V799
     string_init_set(string->string, cstr);
     return string;
 } //-V773
@@ -50,21 +57,41 @@ FuriString* furi_string_alloc_printf(const char format[], ...) {
 }
 
 FuriString* furi_string_alloc_vprintf(const char format[], va_list args) {
-    FuriString* string = malloc(sizeof(FuriString));
+    FuriString* string = memmgr_slab_alloc(sizeof(FuriString));
     string_init_vprintf(string->string, format, args);
     return string;
 }
 
 FuriString* furi_string_alloc_move(FuriString* s) {
-    FuriString* string = malloc(sizeof(FuriString));
+    FuriString* string = memmgr_slab_alloc(sizeof(FuriString));
     string_init_move(string->string, s->string);
-    free(s);
+    memmgr_slab_free(s);
+    return string;
+}
+
+FuriString* furi_string_init(FuriStringStorage* storage) {
+    furi_check(storage);
+    FuriString* string = (FuriString*)storage;
+    string_init(string->string);
+    return string;
+}
+
+FuriString* furi_string_alloc_arena(MemmgrArena* arena) {
+    furi_check(arena);
+    FuriString* string = memmgr_arena_malloc(arena, sizeof(FuriString));
+    // Slab free passes arena objects on to free, so both kinds are released the same way
+    if(!string) string = memmgr_slab_alloc(sizeof(FuriString));
+    string_init(string->string);
     return string;
 }
 
 void furi_string_free(FuriString* s) {
     string_clear(s->string);
-    free(s);
+    memmgr_slab_free(s);
+}
+
+void furi_string_deinit(FuriString* s) {
+    string_clear(s->string);
 }
 
 void furi_string_reserve(FuriString* s, size_t alloc) {
@@ -83,7 +110,7 @@ void furi_string_swap(FuriString* v1, FuriString* v2) {
 void furi_string_move(FuriString* v1, FuriString* v2) {
     string_clear(v1->string);
     string_init_move(v1->string, v2->string);
-    free(v2);
+    memmgr_slab_free(v2);
 }
 
 size_t furi_string_hash(const FuriString* v) {
@@ -273,6 +300,48 @@ void furi_string_cat_str(FuriString* v, const char str[]) {
     string_cat(v->string, str);
 }
 
+void furi_string_cat_uint32(FuriString* v, uint32_t value) {
+    char buffer[11];
+    size_t pos = sizeof(buffer) - 1;
+    buffer[pos] = '\0';
+    do {
+        buffer[--pos] = (char)('0' + value % 10U);
+        value /= 10U;
+    } while(value);
+    string_cat(v->string, &buffer[pos]);
+}
+
+void furi_string_cat_int32(FuriString* v, int32_t value) {
+    if(value < 0) {
+        string_push_back(v->string, '-');
+        furi_string_cat_uint32(v, 0U - (uint32_t)value);
+    } else {
+        furi_string_cat_uint32(v, (uint32_t)value);
+    }
+}
+
+void furi_string_cat_hex(FuriString* v, const uint8_t* data, size_t size, char separator) {
+    furi_check(data || !size);
+
+    static const char hex[] = "0123456789ABCDEF";
+    const size_t item_size = separator ? 3 : 2;
+    char buffer[48 + 1];
+    size_t pos = 0;
+
+    for(size_t i = 0; i < size; i++) {
+        if(separator && i) buffer[pos++] = separator;
+        buffer[pos++] = hex[data[i] >> 4];
+        buffer[pos++] = hex[data[i] & 0x0F];
+        if(pos > sizeof(buffer) - 1 - item_size) {
+            buffer[pos] = '\0';
+            string_cat(v->string, buffer);
+            pos = 0;
+        }
+    }
+    buffer[pos] = '\0';
+    string_cat(v->string, buffer);
+}
+
 void furi_string_set_n(FuriString* v, const FuriString* ref, size_t offset, size_t length) {
     string_set_n(v->string, ref->string, offset, length);
 }
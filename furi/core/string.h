@@ -12,6 +12,7 @@
 #include <stddef.h>
 #include <stdarg.h>
 #include <m-core.h>
+#include "memmgr_arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,6 +24,26 @@ extern "C" {
 /** Furi string primitive. */
 typedef struct FuriString FuriString;
 
+/** Caller provided FuriString storage.
+ *
+ * Big enough to hold FuriString container, use with furi_string_init.
+ */
+typedef struct {
+    void* storage[4];
+} FuriStringStorage;
+
+/** Declare FuriString living on the stack.
+ *
+ * Container does not touch the heap, and neither does the content while it
+ * fits into the small string buffer kept inside of the container. Must be
+ * released with furi_string_deinit.
+ *
+ * @param      name  variable name, storage is declared as name_storage
+ */
+#define FURI_STRING_DECLARE(name) \
+    FuriStringStorage name##_storage; \
+    FuriString* name = furi_string_init(&name##_storage)
+
 //---------------------------------------------------------------------------
 //                               Constructors
 //---------------------------------------------------------------------------
@@ -86,6 +107,30 @@ FuriString* furi_string_alloc_vprintf(const char format[], va_list args);
  */
 FuriString* furi_string_alloc_move(FuriString* source);
 
+/** Initialize FuriString in caller provided storage.
+ *
+ * Storage may live on the stack, inside of another object or in an arena.
+ * Short strings are kept inside of the container, longer ones are moved to
+ * the heap.
+ *
+ * @param      storage  pointer to FuriStringStorage, must outlive the string
+ *
+ * @return     pointer to the new instance of FuriString
+ */
+FuriString* furi_string_init(FuriStringStorage* storage);
+
+/** Allocate new FuriString from arena.
+ *
+ * Container is taken from the arena, or from the heap if the arena is
+ * exhausted. Longer content is allocated with malloc, so it is served by the
+ * arena too when the arena is attached to the calling thread.
+ *
+ * @param      arena  pointer to MemmgrArena instance
+ *
+ * @return     pointer to the new instance of FuriString, release with furi_string_free
+ */
+FuriString* furi_string_alloc_arena(MemmgrArena* arena);
+
 //---------------------------------------------------------------------------
 //                               Destructors
 //---------------------------------------------------------------------------
@@ -96,6 +141,14 @@ FuriString* furi_string_alloc_move(FuriString* source);
  */
 void furi_string_free(FuriString* string);
 
+/** Deinitialize FuriString created with furi_string_init.
+ *
+ * Content is released, storage itself is left to the caller.
+ *
+ * @param      string  The FuriString instance to deinitialize
+ */
+void furi_string_deinit(FuriString* string);
+
 //---------------------------------------------------------------------------
 //                         String memory management
 //---------------------------------------------------------------------------
@@ -280,6 +333,35 @@ void furi_string_cat(FuriString* string_1, const FuriString* string_2);
  */
 void furi_string_cat_str(FuriString* string_1, const char cstring_2[]);
 
+/** Append decimal representation of an unsigned integer to the string.
+ *
+ * Same output as `"%lu"` without parsing a format string.
+ *
+ * @param      string  The FuriString instance
+ * @param      value   The value
+ */
+void furi_string_cat_uint32(FuriString* string, uint32_t value);
+
+/** Append decimal representation of a signed integer to the string.
+ *
+ * Same output as `"%ld"` without parsing a format string.
+ *
+ * @param      string  The FuriString instance
+ * @param      value   The value
+ */
+void furi_string_cat_int32(FuriString* string, int32_t value);
+
+/** Append bytes as upper case hex to the string.
+ *
+ * Same output as `"%02X"` for every byte, with the separator in between.
+ *
+ * @param      string     The FuriString instance
+ * @param      data       The bytes
+ * @param      size       The bytes count
+ * @param      separator  The character put between bytes, '\0' for none
+ */
+void furi_string_cat_hex(FuriString* string, const uint8_t* data, size_t size, char separator);
+
 /** Append to the string the formatted string of the given printf format.
  *
  * @param      string     The string
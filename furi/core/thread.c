@@ -5,6 +5,7 @@
 #include "memmgr.h"
 #include "memmgr_heap.h"
 #include "check.h"
+#include "stack_watermark.h"
 #include "common_defines.h"
 #include "string.h"
 
@@ -56,20 +57,29 @@ struct FuriThread {
 
     FuriThreadStdout output;
 
+    MemmgrSlabCache* slab_cache;
+    MemmgrArena* arena;
+
     // Keep all non-alignable byte types in one place,
     // this ensures that the size of this structure is minimal
     bool is_service;
     bool heap_trace_enabled;
+    bool slab_cache_enabled;
 };
 
 // IMPORTANT: container MUST be the FIRST struct member
 static_assert(offsetof(FuriThread, container) == 0);
 
+static_assert(sizeof(FuriThread) <= sizeof(FuriThreadStatic));
+
 // Our idle priority should be equal to the one from FreeRTOS
 static_assert(FuriThreadPriorityIdle == tskIDLE_PRIORITY);
 
 static FuriMessageQueue* furi_thread_scrub_message_queue = NULL;
 
+// Incremented by traceTASK_SWITCHED_IN hook, see FreeRTOSConfig.h
+volatile uint32_t furi_thread_context_switch_counter = 0;
+
 static size_t __furi_thread_stdout_write(FuriThread* thread, const char* data, size_t size);
 static int32_t __furi_thread_stdout_flush(FuriThread* thread);
 
@@ -101,6 +111,11 @@ static void furi_thread_body(void* context) {
     furi_check(thread->state == FuriThreadStateStarting);
     furi_thread_set_state(thread, FuriThreadStateRunning);
 
+    // Allocated outside of heap trace to keep allocation balance accurate
+    if(thread->slab_cache_enabled == true) {
+        thread->slab_cache = memmgr_slab_cache_alloc();
+    }
+
     if(thread->heap_trace_enabled == true) {
         memmgr_heap_enable_thread_trace((FuriThreadId)thread);
     }
@@ -109,6 +124,17 @@ static void furi_thread_body(void* context) {
 
     furi_check(!thread->is_service, "Service threads MUST NOT return");
 
+    furi_stack_watermark_update(
+        thread->name,
+        thread->stack_size,
+        furi_thread_get_stack_space(furi_thread_get_current_id()));
+
+    if(thread->slab_cache) {
+        MemmgrSlabCache* slab_cache = thread->slab_cache;
+        thread->slab_cache = NULL;
+        memmgr_slab_cache_free(slab_cache);
+    }
+
     if(thread->heap_trace_enabled == true) {
         furi_delay_ms(33);
         thread->heap_size = memmgr_heap_get_thread_memory((FuriThreadId)thread);
@@ -217,6 +243,34 @@ FuriThread* furi_thread_alloc_service(
     return thread;
 }
 
+FuriThread* furi_thread_alloc_service_static(
+    const char* name,
+    FuriThreadStatic* storage,
+    void* stack,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context) {
+    furi_check(storage);
+    furi_check(stack);
+    furi_check(((uintptr_t)stack % 8) == 0);
+    furi_check(stack_size >= sizeof(StackType_t) && stack_size <= THREAD_MAX_STACK_SIZE);
+
+    FuriThread* thread = (FuriThread*)storage;
+    memset(thread, 0, sizeof(FuriThread));
+
+    furi_thread_init_common(thread);
+
+    thread->stack_buffer = stack;
+    thread->stack_size = stack_size;
+    thread->is_service = true;
+
+    furi_thread_set_name(thread, name);
+    furi_thread_set_callback(thread, callback);
+    furi_thread_set_context(thread, context);
+
+    return thread;
+}
+
 FuriThread* furi_thread_alloc_ex(
     const char* name,
     uint32_t stack_size,
@@ -423,6 +477,39 @@ void furi_thread_disable_heap_trace(FuriThread* thread) {
     thread->heap_trace_enabled = false;
 }
 
+void furi_thread_enable_slab_cache(FuriThread* thread) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    thread->slab_cache_enabled = true;
+}
+
+void furi_thread_disable_slab_cache(FuriThread* thread) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    thread->slab_cache_enabled = false;
+}
+
+MemmgrSlabCache* furi_thread_get_slab_cache(FuriThread* thread) {
+    furi_check(thread);
+    return thread->slab_cache;
+}
+
+bool furi_thread_is_heap_trace_enabled(FuriThread* thread) {
+    furi_check(thread);
+    return thread->heap_trace_enabled;
+}
+
+void furi_thread_set_arena(FuriThread* thread, MemmgrArena* arena) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    thread->arena = arena;
+}
+
+MemmgrArena* furi_thread_get_arena(FuriThread* thread) {
+    furi_check(thread);
+    return thread->arena;
+}
+
 size_t furi_thread_get_heap_size(FuriThread* thread) {
     furi_check(thread);
     furi_check(thread->heap_trace_enabled == true);
@@ -600,6 +687,10 @@ uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeo
     return rflags;
 }
 
+uint32_t furi_thread_get_context_switch_count(void) {
+    return furi_thread_context_switch_counter;
+}
+
 static const char* furi_thread_state_name(eTaskState state) {
     switch(state) {
     case eRunning:
@@ -7,6 +7,7 @@
 
 #include "base.h"
 #include "common_defines.h"
+#include "memmgr_arena.h"
 
 #include <stdint.h>
 #include <stddef.h>
@@ -47,6 +48,17 @@ typedef enum {
  */
 typedef struct FuriThread FuriThread;
 
+#define FURI_THREAD_STATIC_SIZE (320U)
+
+/**
+ * @brief Storage for a FuriThread instance that is not allocated from heap.
+ *
+ * Big enough to hold FuriThread together with its task control block.
+ */
+typedef struct {
+    uint8_t storage[FURI_THREAD_STATIC_SIZE];
+} __attribute__((aligned(8))) FuriThreadStatic;
+
 /** FuriThreadList type */
 typedef struct FuriThreadList FuriThreadList;
 
@@ -131,6 +143,28 @@ FuriThread* furi_thread_alloc_service(
     FuriThreadCallback callback,
     void* context);
 
+/**
+ * @brief Create a FuriThread instance (service mode) in caller-provided memory.
+ *
+ * Same as furi_thread_alloc_service, but neither the instance nor its stack
+ * come from heap: both are usually statically allocated.
+ *
+ * @param[in] name human-readable thread name (can be NULL)
+ * @param[in] storage pointer to the instance storage, must outlive the thread
+ * @param[in] stack pointer to the stack buffer, 8-byte aligned
+ * @param[in] stack_size stack buffer size in bytes
+ * @param[in] callback pointer to a function to be executed in this thread
+ * @param[in] context pointer to a user-specified object (will be passed to the callback)
+ * @return pointer to the created FuriThread instance
+ */
+FuriThread* furi_thread_alloc_service_static(
+    const char* name,
+    FuriThreadStatic* storage,
+    void* stack,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context);
+
 /**
  * @brief Create a FuriThread instance w/ extra parameters.
  * 
@@ -350,6 +384,41 @@ void furi_thread_enable_heap_trace(FuriThread* thread);
  */
 void furi_thread_disable_heap_trace(FuriThread* thread);
 
+/**
+ * @brief Enable per-thread slab cache for a FuriThread.
+ *
+ * Objects released by the thread through memmgr_slab_free are kept in a small
+ * per-thread cache and reused by its next memmgr_slab_alloc calls. The cache
+ * is flushed when the thread callback returns.
+ *
+ * The thread MUST be stopped when calling this function.
+ *
+ * @param[in,out] thread pointer to the FuriThread instance to be modified
+ */
+void furi_thread_enable_slab_cache(FuriThread* thread);
+
+/**
+ * @brief Disable per-thread slab cache for a FuriThread.
+ *
+ * The thread MUST be stopped when calling this function.
+ *
+ * @param[in,out] thread pointer to the FuriThread instance to be modified
+ */
+void furi_thread_disable_slab_cache(FuriThread* thread);
+
+/**
+ * @brief Attach memory arena to a FuriThread.
+ *
+ * All malloc calls made by the thread are served from the arena while it has
+ * space left. Arena MUST outlive the thread run, pass NULL to detach it.
+ *
+ * The thread MUST be stopped when calling this function.
+ *
+ * @param[in,out] thread pointer to the FuriThread instance to be modified
+ * @param[in] arena pointer to the MemmgrArena instance or NULL
+ */
+void furi_thread_set_arena(FuriThread* thread, MemmgrArena* arena);
+
 /**
  * @brief Get heap usage by a FuriThread instance.
  *
@@ -437,6 +506,15 @@ uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeo
  */
 bool furi_thread_enumerate(FuriThreadList* thread_list);
 
+/**
+ * @brief      Get number of times the scheduler switched threads in.
+ *
+ * Counter is free running and wraps around.
+ *
+ * @return     context switch counter
+ */
+uint32_t furi_thread_get_context_switch_count(void);
+
 /**
  * @brief Get the name of a thread based on its unique identifier.
  * 
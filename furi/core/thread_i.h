@@ -1,7 +1,14 @@
 #pragma once
 
 #include "thread.h"
+#include "memmgr_slab_i.h"
 
 void furi_thread_init(void);
 
 void furi_thread_scrub(void);
+
+MemmgrSlabCache* furi_thread_get_slab_cache(FuriThread* thread);
+
+bool furi_thread_is_heap_trace_enabled(FuriThread* thread);
+
+MemmgrArena* furi_thread_get_arena(FuriThread* thread);
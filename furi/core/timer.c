@@ -10,6 +10,11 @@ struct FuriTimer {
     StaticTimer_t container;
     FuriTimerCallback cb_func;
     void* cb_context;
+    bool periodic;
+    uint32_t slack;
+    // Period to switch to after coalesced first expiry
+    uint32_t period;
+    volatile bool period_pending;
 };
 
 // IMPORTANT: container MUST be the FIRST struct member
@@ -20,6 +25,13 @@ static_assert(offsetof(FuriTimer, container) == 0);
 static void furi_timer_callback(TimerHandle_t hTimer) {
     FuriTimer* instance = pvTimerGetTimerID(hTimer);
     furi_check(instance);
+
+    // Timer service can't block, retry on next expiry if its queue is full
+    if(instance->period_pending &&
+       xTimerChangePeriod(hTimer, instance->period, 0) == pdPASS) {
+        instance->period_pending = false;
+    }
+
     instance->cb_func(instance->cb_context);
 }
 
@@ -42,6 +54,7 @@ FuriTimer* furi_timer_alloc(FuriTimerCallback func, FuriTimerType type, void* co
 
     instance->cb_func = func;
     instance->cb_context = context;
+    instance->periodic = (type == FuriTimerTypePeriodic);
 
     const UBaseType_t reload = (type == FuriTimerTypeOnce ? pdFALSE : pdTRUE);
     const TimerHandle_t hTimer = xTimerCreateStatic(
@@ -64,6 +77,28 @@ void furi_timer_free(FuriTimer* instance) {
     free(instance);
 }
 
+void furi_timer_set_slack(FuriTimer* instance, uint32_t slack) {
+    furi_check(instance);
+    furi_check(slack < portMAX_DELAY);
+
+    instance->slack = slack;
+}
+
+// Only the first expiry can move, FreeRTOS reloads periodic timers relative to it
+static uint32_t furi_timer_get_first_period(FuriTimer* instance, uint32_t ticks) {
+    instance->period_pending = false;
+    if(!instance->slack) return ticks;
+
+    const uint32_t now = xTaskGetTickCount();
+    const uint32_t first = furi_kernel_coalesce_tick(now + ticks, instance->slack) - now;
+    if(instance->periodic && first != ticks) {
+        instance->period = ticks;
+        instance->period_pending = true;
+    }
+
+    return first;
+}
+
 void furi_timer_flush(void) {
     StaticEventGroup_t event_container = {};
     EventGroupHandle_t hEvent = xEventGroupCreateStatic(&event_container);
@@ -84,6 +119,8 @@ FuriStatus furi_timer_start(FuriTimer* instance, uint32_t ticks) {
     TimerHandle_t hTimer = (TimerHandle_t)instance;
     FuriStatus stat;
 
+    ticks = furi_timer_get_first_period(instance, ticks);
+
     if(xTimerChangePeriod(hTimer, ticks, portMAX_DELAY) == pdPASS) {
         stat = FuriStatusOk;
     } else {
@@ -101,6 +138,8 @@ FuriStatus furi_timer_restart(FuriTimer* instance, uint32_t ticks) {
     TimerHandle_t hTimer = (TimerHandle_t)instance;
     FuriStatus stat;
 
+    ticks = furi_timer_get_first_period(instance, ticks);
+
     if(xTimerChangePeriod(hTimer, ticks, portMAX_DELAY) == pdPASS &&
        xTimerReset(hTimer, portMAX_DELAY) == pdPASS) {
         stat = FuriStatusOk;
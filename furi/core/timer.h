@@ -53,6 +53,17 @@ void furi_timer_flush(void);
  */
 FuriStatus furi_timer_start(FuriTimer* instance, uint32_t ticks);
 
+/** Set timer slack
+ *
+ * Timer is allowed to fire up to slack ticks late, so it can share a wakeup
+ * with other timers. For periodic timer only the first expiry is moved, the
+ * following ones keep the requested interval. Applied on next start.
+ *
+ * @param      instance  The pointer to FuriTimer instance
+ * @param[in]  slack     The allowed delay in ticks, 0 to disable
+ */
+void furi_timer_set_slack(FuriTimer* instance, uint32_t slack);
+
 /** Restart timer with previous timeout value
  *
  * @warning    This is asynchronous call, real operation will happen as soon as
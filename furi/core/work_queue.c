@@ -0,0 +1,356 @@
+#include "work_queue.h"
+
+#include "check.h"
+#include "kernel.h"
+#include "log.h"
+#include "memmgr.h"
+#include "mutex.h"
+#include "semaphore.h"
+#include "thread.h"
+
+#define TAG "FuriWorkQueue"
+
+// Pool semaphore only counts wake ups, jobs themselves are in the list
+#define FURI_WORK_QUEUE_WAKEUP_MAX (0xFFFFUL)
+
+#define FURI_WORK_QUEUE_THREADS_MAX (2U)
+
+typedef struct FuriWorkQueueJob FuriWorkQueueJob;
+
+struct FuriWorkQueueJob {
+    FuriWorkQueueJob* next;
+    FuriWorkQueue* owner;
+    FuriWorkQueueJobId id;
+    FuriWorkQueueJobCallback callback;
+    FuriWorkQueueDoneCallback done;
+    void* context;
+    bool cancelled;
+};
+
+typedef struct {
+    FuriWorkQueueJob* head;
+    FuriWorkQueueJob* tail;
+} FuriWorkQueueList;
+
+typedef struct {
+    const char* name;
+    FuriThreadPriority thread_priority;
+    size_t thread_count;
+} FuriWorkQueuePoolConfig;
+
+static const FuriWorkQueuePoolConfig furi_work_queue_pool_config[FuriWorkQueuePriorityCount] = {
+    [FuriWorkQueuePriorityLow] = {"WorkQueueLow", FuriThreadPriorityLow, 1},
+    [FuriWorkQueuePriorityNormal] = {"WorkQueue", FuriThreadPriorityNormal, 2},
+    [FuriWorkQueuePriorityHigh] = {"WorkQueueHigh", FuriThreadPriorityHigh, 1},
+};
+
+typedef struct {
+    FuriWorkQueueList pending;
+    FuriSemaphore* wakeup;
+    FuriThread* threads[FURI_WORK_QUEUE_THREADS_MAX];
+    FuriWorkQueueJob* running[FURI_WORK_QUEUE_THREADS_MAX];
+} FuriWorkQueuePool;
+
+struct FuriWorkQueue {
+    FuriEventLoop* event_loop;
+    FuriSemaphore* done_signal;
+    FuriWorkQueueList done;
+    size_t running_count;
+};
+
+// Everything, except job callbacks and FuriWorkQueue fields set on alloc, is under mutex
+static struct {
+    FuriMutex* mutex;
+    FuriWorkQueueJobId last_id;
+    FuriWorkQueuePool pools[FuriWorkQueuePriorityCount];
+} furi_work_queue_state = {0};
+
+static void furi_work_queue_lock(void) {
+    furi_check(furi_mutex_acquire(furi_work_queue_state.mutex, FuriWaitForever) == FuriStatusOk);
+}
+
+static void furi_work_queue_unlock(void) {
+    furi_check(furi_mutex_release(furi_work_queue_state.mutex) == FuriStatusOk);
+}
+
+static void furi_work_queue_list_push(FuriWorkQueueList* list, FuriWorkQueueJob* job) {
+    job->next = NULL;
+    if(list->tail) {
+        list->tail->next = job;
+    } else {
+        list->head = job;
+    }
+    list->tail = job;
+}
+
+static FuriWorkQueueJob* furi_work_queue_list_pop(FuriWorkQueueList* list) {
+    FuriWorkQueueJob* job = list->head;
+    if(job) {
+        list->head = job->next;
+        if(!list->head) list->tail = NULL;
+    }
+    return job;
+}
+
+static FuriWorkQueueJob* furi_work_queue_list_remove(
+    FuriWorkQueueList* list,
+    FuriWorkQueue* owner,
+    FuriWorkQueueJobId id) {
+    FuriWorkQueueJob* prev = NULL;
+    for(FuriWorkQueueJob* job = list->head; job; prev = job, job = job->next) {
+        if(job->owner != owner) continue;
+        if(id && job->id != id) continue;
+
+        if(prev) {
+            prev->next = job->next;
+        } else {
+            list->head = job->next;
+        }
+        if(list->tail == job) list->tail = prev;
+        return job;
+    }
+    return NULL;
+}
+
+// Called with lock held, job is not in any list anymore
+static void furi_work_queue_post_done(FuriWorkQueueJob* job) {
+    FuriWorkQueue* owner = job->owner;
+    furi_work_queue_list_push(&owner->done, job);
+    // Already signalled is fine, callback takes all done jobs at once
+    furi_semaphore_release(owner->done_signal);
+}
+
+static FuriWorkQueueJob* furi_work_queue_find_running(FuriWorkQueueJobId id) {
+    for(size_t i = 0; i < FuriWorkQueuePriorityCount; i++) {
+        FuriWorkQueuePool* pool = &furi_work_queue_state.pools[i];
+        for(size_t j = 0; j < FURI_WORK_QUEUE_THREADS_MAX; j++) {
+            if(pool->running[j] && pool->running[j]->id == id) return pool->running[j];
+        }
+    }
+    return NULL;
+}
+
+static int32_t furi_work_queue_worker(void* context) {
+    const size_t index = (size_t)context;
+    FuriWorkQueuePool* pool = &furi_work_queue_state.pools[index / FURI_WORK_QUEUE_THREADS_MAX];
+    const size_t slot = index % FURI_WORK_QUEUE_THREADS_MAX;
+
+    while(true) {
+        furi_check(furi_semaphore_acquire(pool->wakeup, FuriWaitForever) == FuriStatusOk);
+
+        furi_work_queue_lock();
+        FuriWorkQueueJob* job = furi_work_queue_list_pop(&pool->pending);
+        if(job) {
+            pool->running[slot] = job;
+            job->owner->running_count++;
+        }
+        furi_work_queue_unlock();
+
+        // Cancelled before start
+        if(!job) continue;
+
+        job->callback(job->id, job->context);
+
+        FuriWorkQueue* owner = job->owner;
+        if(!owner->event_loop && job->done) {
+            furi_work_queue_lock();
+            const bool cancelled = job->cancelled;
+            furi_work_queue_unlock();
+            job->done(job->id, cancelled, job->context);
+        }
+
+        furi_work_queue_lock();
+        pool->running[slot] = NULL;
+        owner->running_count--;
+        if(owner->event_loop) {
+            furi_work_queue_post_done(job);
+            job = NULL;
+        }
+        furi_work_queue_unlock();
+
+        free(job);
+    }
+
+    return 0;
+}
+
+static void furi_work_queue_pool_start(FuriWorkQueuePriority priority) {
+    FuriWorkQueuePool* pool = &furi_work_queue_state.pools[priority];
+    const FuriWorkQueuePoolConfig* config = &furi_work_queue_pool_config[priority];
+    furi_assert(config->thread_count <= FURI_WORK_QUEUE_THREADS_MAX);
+
+    if(pool->threads[0]) return;
+
+    FURI_LOG_D(TAG, "Starting %s", config->name);
+
+    pool->wakeup = furi_semaphore_alloc(FURI_WORK_QUEUE_WAKEUP_MAX, 0);
+    for(size_t i = 0; i < config->thread_count; i++) {
+        pool->threads[i] = furi_thread_alloc_service(
+            config->name,
+            FURI_WORK_QUEUE_STACK_SIZE,
+            furi_work_queue_worker,
+            (void*)(priority * FURI_WORK_QUEUE_THREADS_MAX + i));
+        furi_thread_set_priority(pool->threads[i], config->thread_priority);
+        furi_thread_start(pool->threads[i]);
+    }
+}
+
+static void furi_work_queue_done_callback(FuriEventLoopObject* object, void* context) {
+    furi_assert(context);
+    FuriWorkQueue* instance = context;
+    furi_assert(object == instance->done_signal);
+
+    furi_check(furi_semaphore_acquire(instance->done_signal, 0) == FuriStatusOk);
+
+    while(true) {
+        furi_work_queue_lock();
+        FuriWorkQueueJob* job = furi_work_queue_list_pop(&instance->done);
+        furi_work_queue_unlock();
+
+        if(!job) break;
+
+        if(job->done) job->done(job->id, job->cancelled, job->context);
+        free(job);
+    }
+}
+
+void furi_work_queue_init(void) {
+    furi_work_queue_state.mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+}
+
+FuriWorkQueue* furi_work_queue_alloc(FuriEventLoop* event_loop) {
+    FuriWorkQueue* instance = malloc(sizeof(FuriWorkQueue));
+
+    instance->event_loop = event_loop;
+    if(event_loop) {
+        instance->done_signal = furi_semaphore_alloc(1, 0);
+        furi_event_loop_subscribe_semaphore(
+            event_loop,
+            instance->done_signal,
+            FuriEventLoopEventIn,
+            furi_work_queue_done_callback,
+            instance);
+    }
+
+    return instance;
+}
+
+void furi_work_queue_free(FuriWorkQueue* instance) {
+    furi_check(instance);
+
+    furi_work_queue_lock();
+    for(size_t i = 0; i < FuriWorkQueuePriorityCount; i++) {
+        FuriWorkQueuePool* pool = &furi_work_queue_state.pools[i];
+        FuriWorkQueueJob* job;
+        while((job = furi_work_queue_list_remove(&pool->pending, instance, 0))) {
+            free(job);
+        }
+        for(size_t j = 0; j < FURI_WORK_QUEUE_THREADS_MAX; j++) {
+            if(pool->running[j] && pool->running[j]->owner == instance) {
+                pool->running[j]->cancelled = true;
+            }
+        }
+    }
+    furi_work_queue_unlock();
+
+    // Running jobs only touch the instance until they are accounted as finished
+    while(true) {
+        furi_work_queue_lock();
+        const size_t running_count = instance->running_count;
+        furi_work_queue_unlock();
+        if(running_count == 0) break;
+        furi_delay_tick(1);
+    }
+
+    if(instance->event_loop) {
+        furi_event_loop_unsubscribe(instance->event_loop, instance->done_signal);
+        furi_semaphore_free(instance->done_signal);
+
+        FuriWorkQueueJob* job;
+        while((job = furi_work_queue_list_pop(&instance->done))) {
+            free(job);
+        }
+    }
+
+    free(instance);
+}
+
+FuriWorkQueueJobId furi_work_queue_submit(
+    FuriWorkQueue* instance,
+    FuriWorkQueuePriority priority,
+    FuriWorkQueueJobCallback job,
+    FuriWorkQueueDoneCallback done,
+    void* context) {
+    furi_check(instance);
+    furi_check(priority < FuriWorkQueuePriorityCount);
+    furi_check(job);
+
+    FuriWorkQueueJob* item = malloc(sizeof(FuriWorkQueueJob));
+    item->owner = instance;
+    item->callback = job;
+    item->done = done;
+    item->context = context;
+
+    furi_work_queue_lock();
+    furi_work_queue_pool_start(priority);
+
+    if(++furi_work_queue_state.last_id == 0) ++furi_work_queue_state.last_id;
+    // Job may be done and freed as soon as lock is released
+    const FuriWorkQueueJobId id = furi_work_queue_state.last_id;
+    item->id = id;
+
+    FuriWorkQueuePool* pool = &furi_work_queue_state.pools[priority];
+    furi_work_queue_list_push(&pool->pending, item);
+    furi_work_queue_unlock();
+
+    furi_check(furi_semaphore_release(pool->wakeup) == FuriStatusOk);
+
+    return id;
+}
+
+bool furi_work_queue_cancel(FuriWorkQueue* instance, FuriWorkQueueJobId job_id) {
+    furi_check(instance);
+
+    FuriWorkQueueJob* dropped = NULL;
+    bool found = false;
+
+    furi_work_queue_lock();
+    for(size_t i = 0; (i < FuriWorkQueuePriorityCount) && !dropped; i++) {
+        if(job_id == 0) break;
+        dropped =
+            furi_work_queue_list_remove(&furi_work_queue_state.pools[i].pending, instance, job_id);
+    }
+
+    if(dropped) {
+        dropped->cancelled = true;
+        found = true;
+        if(instance->event_loop) {
+            furi_work_queue_post_done(dropped);
+            dropped = NULL;
+        }
+    } else {
+        FuriWorkQueueJob* running = furi_work_queue_find_running(job_id);
+        if(running && running->owner == instance) {
+            running->cancelled = true;
+            found = true;
+        }
+    }
+    furi_work_queue_unlock();
+
+    // No event loop to deliver to, report right here
+    if(dropped) {
+        if(dropped->done) dropped->done(dropped->id, true, dropped->context);
+        free(dropped);
+    }
+
+    return found;
+}
+
+bool furi_work_queue_is_cancelled(FuriWorkQueueJobId job_id) {
+    furi_work_queue_lock();
+    FuriWorkQueueJob* running = furi_work_queue_find_running(job_id);
+    const bool cancelled = running ? running->cancelled : true;
+    furi_work_queue_unlock();
+
+    return cancelled;
+}
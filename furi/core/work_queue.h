@@ -0,0 +1,131 @@
+/**
+ * @file work_queue.h
+ * Furi shared work queue.
+ *
+ * Runs short jobs on a small pool of worker threads shared by all users,
+ * instead of every app spawning its own thread with its own stack.
+ * There is one pool per priority class, its threads are started on first use
+ * and are kept running afterwards.
+ *
+ * Job completion is reported to the event loop the queue was bound to,
+ * so the done callback runs in the submitting thread.
+ */
+#pragma once
+
+#include "base.h"
+#include "event_loop.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Worker thread stack size, keep jobs within it */
+#define FURI_WORK_QUEUE_STACK_SIZE (2048UL)
+
+/** Worker pool priority class */
+typedef enum {
+    FuriWorkQueuePriorityLow, /**< Background jobs, run below Normal thread priority */
+    FuriWorkQueuePriorityNormal, /**< Regular jobs */
+    FuriWorkQueuePriorityHigh, /**< Latency sensitive jobs */
+    FuriWorkQueuePriorityCount, /**< Special value, don't use it */
+} FuriWorkQueuePriority;
+
+/** Work queue, binds submitted jobs to their owner */
+typedef struct FuriWorkQueue FuriWorkQueue;
+
+/** Job identifier, never 0 */
+typedef uint32_t FuriWorkQueueJobId;
+
+/** Job callback, runs on worker thread
+ *
+ * Long jobs should poll furi_work_queue_is_cancelled() and return early.
+ *
+ * @param      job_id   job identifier
+ * @param      context  context passed to furi_work_queue_submit()
+ */
+typedef void (*FuriWorkQueueJobCallback)(FuriWorkQueueJobId job_id, void* context);
+
+/** Done callback
+ *
+ * Runs on event loop thread. If queue has no event loop, it runs on worker
+ * thread, or in furi_work_queue_cancel() for jobs cancelled before start.
+ * Called exactly once for every submitted job, unless the queue is freed first.
+ *
+ * @param      job_id     job identifier
+ * @param      cancelled  true if job was cancelled
+ * @param      context    context passed to furi_work_queue_submit()
+ */
+typedef void (*FuriWorkQueueDoneCallback)(
+    FuriWorkQueueJobId job_id,
+    bool cancelled,
+    void* context);
+
+/** Initialize work queue pools
+ *
+ * For internal use only, called by furi_init().
+ */
+void furi_work_queue_init(void);
+
+/** Allocate work queue
+ *
+ * Must be called from the thread running the event loop.
+ *
+ * @param      event_loop  event loop to deliver done callbacks to, NULL to
+ *                         call them on worker thread
+ *
+ * @return     pointer to FuriWorkQueue instance
+ */
+FuriWorkQueue* furi_work_queue_alloc(FuriEventLoop* event_loop);
+
+/** Free work queue
+ *
+ * Pending jobs are dropped and running ones are cancelled and waited for.
+ * No done callbacks are called after this function starts.
+ * Must be called from the event loop thread, not from a done callback.
+ *
+ * @param      instance  pointer to FuriWorkQueue instance
+ */
+void furi_work_queue_free(FuriWorkQueue* instance);
+
+/** Submit job
+ *
+ * Jobs of the same priority class start in submission order.
+ *
+ * @param      instance  pointer to FuriWorkQueue instance
+ * @param      priority  pool to run the job on
+ * @param      job       job callback
+ * @param      done      done callback, can be NULL
+ * @param      context   context for both callbacks
+ *
+ * @return     job identifier
+ */
+FuriWorkQueueJobId furi_work_queue_submit(
+    FuriWorkQueue* instance,
+    FuriWorkQueuePriority priority,
+    FuriWorkQueueJobCallback job,
+    FuriWorkQueueDoneCallback done,
+    void* context);
+
+/** Cancel job
+ *
+ * Job that has not started yet is dropped, running job is asked to stop.
+ * Either way done callback is called with cancelled flag set.
+ *
+ * @param      instance  pointer to FuriWorkQueue instance
+ * @param      job_id    job identifier
+ *
+ * @return     true if job was found pending or running
+ */
+bool furi_work_queue_cancel(FuriWorkQueue* instance, FuriWorkQueueJobId job_id);
+
+/** Check if job was cancelled, to be called from job callback
+ *
+ * @param      job_id  job identifier
+ *
+ * @return     true if job should stop
+ */
+bool furi_work_queue_is_cancelled(FuriWorkQueueJobId job_id);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,7 +4,9 @@
 #include <furi_hal_version.h>
 #include <furi_hal_memory.h>
 #include <furi_hal_rtc.h>
+#include <furi_hal_cortex.h>
 
+#include <stm32wbxx.h>
 #include <FreeRTOS.h>
 
 #define TAG "Flipper"
@@ -34,20 +36,45 @@ void flipper_init(void) {
 
     FURI_LOG_I(TAG, "Boot mode %d, starting services", furi_hal_rtc_get_boot_mode());
 
+    // Services are sorted by fbt so that every one starts after the services it requires
+    const uint32_t startup_tick = furi_get_tick();
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
     for(size_t i = 0; i < FLIPPER_SERVICES_COUNT; i++) {
         FURI_LOG_D(TAG, "Starting service %s", FLIPPER_SERVICES[i].name);
+        const uint32_t cycles_start = DWT->CYCCNT;
 
-        FuriThread* thread = furi_thread_alloc_service(
-            FLIPPER_SERVICES[i].name,
-            FLIPPER_SERVICES[i].stack_size,
-            FLIPPER_SERVICES[i].app,
-            NULL);
+        FuriThread* thread;
+        if(FLIPPER_SERVICES[i].flags & FlipperInternalApplicationFlagStaticAllocation) {
+            thread = furi_thread_alloc_service_static(
+                FLIPPER_SERVICES[i].name,
+                FLIPPER_SERVICES[i].thread_storage,
+                FLIPPER_SERVICES[i].stack,
+                FLIPPER_SERVICES[i].stack_size,
+                FLIPPER_SERVICES[i].app,
+                NULL);
+        } else {
+            thread = furi_thread_alloc_service(
+                FLIPPER_SERVICES[i].name,
+                FLIPPER_SERVICES[i].stack_size,
+                FLIPPER_SERVICES[i].app,
+                NULL);
+        }
         furi_thread_set_appid(thread, FLIPPER_SERVICES[i].appid);
 
         furi_thread_start(thread);
+
+        // Init thread has the lowest priority: we get here once the service is done or blocked
+        FURI_LOG_D(
+            TAG,
+            "Service %s took %luus",
+            FLIPPER_SERVICES[i].name,
+            (DWT->CYCCNT - cycles_start) / cycles_per_us);
+        furi_boot_trace_mark(FLIPPER_SERVICES[i].name);
     }
+    furi_boot_trace_mark("services");
 
-    FURI_LOG_I(TAG, "Startup complete");
+    FURI_LOG_I(TAG, "Startup complete in %lums", furi_get_tick() - startup_tick);
 }
 
 void vApplicationGetIdleTaskMemory(
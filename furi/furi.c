@@ -12,6 +12,7 @@ void furi_init(void) {
     furi_thread_init();
     furi_log_init();
     furi_record_init();
+    furi_work_queue_init();
 }
 
 void furi_run(void) {
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "core/common_defines.h"
+#include "core/boot_trace.h"
 #include "core/check.h"
 #include "core/event_loop.h"
 #include "core/event_loop_timer.h"
@@ -10,15 +11,20 @@
 #include "core/kernel.h"
 #include "core/log.h"
 #include "core/memmgr.h"
+#include "core/memmgr_arena.h"
 #include "core/memmgr_heap.h"
+#include "core/memmgr_slab.h"
 #include "core/message_queue.h"
 #include "core/mutex.h"
 #include "core/pubsub.h"
 #include "core/record.h"
 #include "core/semaphore.h"
+#include "core/spsc_ring.h"
+#include "core/stack_watermark.h"
 #include "core/thread.h"
 #include "core/thread_list.h"
 #include "core/timer.h"
+#include "core/work_queue.h"
 #include "core/string.h"
 #include "core/stream_buffer.h"
 
@@ -33,100 +33,84 @@ bool bit_lib_get_bit(const uint8_t* data, size_t position) {
     return (data[position / 8] >> (7 - (position % 8))) & 1;
 }
 
-uint8_t bit_lib_get_bits(const uint8_t* data, size_t position, uint8_t length) {
-    uint8_t shift = position % 8;
-    if(shift == 0) {
-        return data[position / 8] >> (8 - length);
-    } else {
-        // TODO FL-3534: fix read out of bounds
-        uint8_t value = (data[position / 8] << (shift));
-        value |= data[position / 8 + 1] >> (8 - shift);
-        value = value >> (8 - length);
-        return value;
+// Reads only the bytes covering the requested bits, length up to 32
+static inline uint32_t
+    bit_lib_get_bits_word(const uint8_t* data, size_t position, uint8_t length) {
+    const uint8_t* bytes = &data[position / 8];
+    const uint8_t shift = position % 8;
+    const uint8_t bytes_count = (shift + length + 7) / 8;
+
+    uint64_t value = 0;
+    for(uint8_t i = 0; i < bytes_count; ++i) {
+        value = (value << 8) | bytes[i];
     }
+
+    value >>= bytes_count * 8 - shift - length;
+    return value & ((1ULL << length) - 1);
+}
+
+uint8_t bit_lib_get_bits(const uint8_t* data, size_t position, uint8_t length) {
+    return bit_lib_get_bits_word(data, position, length);
 }
 
 uint16_t bit_lib_get_bits_16(const uint8_t* data, size_t position, uint8_t length) {
-    uint16_t value = 0;
-    if(length <= 8) {
-        value = bit_lib_get_bits(data, position, length);
-    } else {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, length - 8);
-    }
-    return value;
+    return bit_lib_get_bits_word(data, position, length);
 }
 
 uint32_t bit_lib_get_bits_32(const uint8_t* data, size_t position, uint8_t length) {
-    uint32_t value = 0;
-    if(length <= 8) {
-        value = bit_lib_get_bits(data, position, length);
-    } else if(length <= 16) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, length - 8);
-    } else if(length <= 24) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= bit_lib_get_bits(data, position + 16, length - 16);
-    } else {
-        value = (uint32_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint32_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint32_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= bit_lib_get_bits(data, position + 24, length - 24);
+    return bit_lib_get_bits_word(data, position, length);
+}
+
+uint64_t bit_lib_get_bits_64(const uint8_t* data, size_t position, uint8_t length) {
+    if(length <= 32) {
+        return bit_lib_get_bits_word(data, position, length);
     }
 
+    uint64_t value = (uint64_t)bit_lib_get_bits_word(data, position, length - 32) << 32;
+    value |= bit_lib_get_bits_word(data, position + length - 32, 32);
     return value;
 }
 
-uint64_t bit_lib_get_bits_64(const uint8_t* data, size_t position, uint8_t length) {
-    uint64_t value = 0;
-    if(length <= 8) {
-        value = bit_lib_get_bits(data, position, length);
-    } else if(length <= 16) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, length - 8);
-    } else if(length <= 24) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= bit_lib_get_bits(data, position + 16, length - 16);
-    } else if(length <= 32) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= bit_lib_get_bits(data, position + 24, length - 24);
-    } else if(length <= 40) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= bit_lib_get_bits(data, position + 32, length - 32);
-    } else if(length <= 48) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 32, 8) << (length - 40);
-        value |= bit_lib_get_bits(data, position + 40, length - 40);
-    } else if(length <= 56) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 32, 8) << (length - 40);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 40, 8) << (length - 48);
-        value |= bit_lib_get_bits(data, position + 48, length - 48);
-    } else {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 32, 8) << (length - 40);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 40, 8) << (length - 48);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 48, 8) << (length - 56);
-        value |= bit_lib_get_bits(data, position + 56, length - 56);
+size_t bit_lib_find_pattern(
+    const uint8_t* data,
+    size_t position,
+    size_t length,
+    uint32_t pattern,
+    uint8_t pattern_length) {
+    furi_check(data);
+    furi_check(pattern_length > 0 && pattern_length <= 32);
+
+    const uint64_t mask = (1ULL << pattern_length) - 1;
+    const size_t end = position + length;
+    pattern &= mask;
+
+    // Window holds the last loaded bits, newest in LSB
+    uint64_t window = 0;
+    size_t loaded = 0;
+    size_t bit = position;
+
+    while(bit < end) {
+        if(bit % 8 == 0 && end - bit >= 8) {
+            // Whole byte at once, then every match ending inside it, earliest first
+            window = (window << 8) | data[bit / 8];
+            loaded += 8;
+            bit += 8;
+            for(uint8_t k = 8; k-- > 0;) {
+                if(loaded - k >= pattern_length && ((window >> k) & mask) == pattern) {
+                    return bit - k - pattern_length;
+                }
+            }
+        } else {
+            window = (window << 1) | bit_lib_get_bit(data, bit);
+            loaded++;
+            bit++;
+            if(loaded >= pattern_length && (window & mask) == pattern) {
+                return bit - pattern_length;
+            }
+        }
     }
 
-    return value;
+    return BIT_LIB_NOT_FOUND;
 }
 
 bool bit_lib_test_parity_32(uint32_t bits, BitLibParity parity) {
@@ -144,40 +128,60 @@ bool bit_lib_test_parity_32(uint32_t bits, BitLibParity parity) {
 #endif
 }
 
-bool bit_lib_test_parity(
-    const uint8_t* bits,
-    size_t position,
+bool bit_lib_test_parity_blocks_32(
+    uint32_t bits,
     uint8_t length,
     BitLibParity parity,
     uint8_t parity_length) {
-    uint32_t parity_block;
-    bool result = true;
-    const size_t parity_blocks_count = length / parity_length;
+    furi_check(length <= 32);
+    furi_check(parity_length > 0 && parity_length <= 32);
+
+    const uint32_t block_mask = (1ULL << parity_length) - 1;
+
+    for(uint8_t offset = length; offset >= parity_length; offset -= parity_length) {
+        const uint32_t block = (bits >> (offset - parity_length)) & block_mask;
 
-    for(size_t i = 0; i < parity_blocks_count; ++i) {
         switch(parity) {
         case BitLibParityEven:
         case BitLibParityOdd:
-            parity_block = bit_lib_get_bits_32(bits, position + i * parity_length, parity_length);
-            if(!bit_lib_test_parity_32(parity_block, parity)) {
-                result = false;
-            }
+            if(!bit_lib_test_parity_32(block, parity)) return false;
             break;
         case BitLibParityAlways0:
-            if(bit_lib_get_bit(bits, position + i * parity_length + parity_length - 1)) {
-                result = false;
-            }
+            if(block & 1) return false;
             break;
         case BitLibParityAlways1:
-            if(!bit_lib_get_bit(bits, position + i * parity_length + parity_length - 1)) {
-                result = false;
-            }
+            if(!(block & 1)) return false;
             break;
         }
+    }
 
-        if(!result) break;
+    return true;
+}
+
+bool bit_lib_test_parity(
+    const uint8_t* bits,
+    size_t position,
+    uint8_t length,
+    BitLibParity parity,
+    uint8_t parity_length) {
+    furi_check(parity_length > 0 && parity_length <= 32);
+
+    const size_t parity_blocks_count = length / parity_length;
+    const size_t word_blocks_count = 32 / parity_length;
+
+    // As many whole blocks as fit in a word are tested per read
+    for(size_t i = 0; i < parity_blocks_count; i += word_blocks_count) {
+        const uint8_t blocks_count = MIN(word_blocks_count, parity_blocks_count - i);
+        const uint8_t bits_count = blocks_count * parity_length;
+        const uint32_t word =
+            bit_lib_get_bits_word(bits, position + i * parity_length, bits_count);
+
+        if(!bit_lib_test_parity_blocks_32(word, bits_count, parity, parity_length)) {
+            return false;
+        }
     }
-    return result;
+
+    return true;
 }
 
 size_t bit_lib_add_parity(
@@ -371,7 +375,7 @@ uint16_t bit_lib_crc8(
 
     for(size_t i = 0; i < data_size; ++i) {
         uint8_t byte = data[i];
-        if(ref_in) bit_lib_reverse_bits(&byte, 0, 8);
+        if(ref_in) byte = bit_lib_reverse_8_fast(byte);
         crc ^= byte;
 
         for(size_t j = 8; j > 0; --j) {
@@ -383,7 +387,7 @@ uint16_t bit_lib_crc8(
         }
     }
 
-    if(ref_out) bit_lib_reverse_bits(&crc, 0, 8);
+    if(ref_out) crc = bit_lib_reverse_8_fast(crc);
     crc ^= xor_out;
 
     return crc;
@@ -401,13 +405,15 @@ uint16_t bit_lib_crc16(
 
     for(size_t i = 0; i < data_size; ++i) {
         uint8_t byte = data[i];
-        if(ref_in) byte = bit_lib_reverse_16_fast(byte) >> 8;
+        if(ref_in) byte = bit_lib_reverse_8_fast(byte);
+        crc ^= (uint16_t)byte << 8;
 
-        for(size_t j = 0; j < 8; ++j) {
-            bool c15 = (crc >> 15 & 1);
-            bool bit = (byte >> (7 - j) & 1);
-            crc <<= 1;
-            if(c15 ^ bit) crc ^= polynom;
+        for(size_t j = 8; j > 0; --j) {
+            if(crc & TOPBIT(16)) {
+                crc = (crc << 1) ^ polynom;
+            } else {
+                crc = (crc << 1);
+            }
         }
     }
 
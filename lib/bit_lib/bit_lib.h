@@ -9,6 +9,8 @@ extern "C" {
 
 #define TOPBIT(X) (1 << ((X) - 1))
 
+#define BIT_LIB_NOT_FOUND SIZE_MAX
+
 typedef enum {
     BitLibParityEven,
     BitLibParityOdd,
@@ -99,6 +101,24 @@ uint32_t bit_lib_get_bits_32(const uint8_t* data, size_t position, uint8_t lengt
  */
 uint64_t bit_lib_get_bits_64(const uint8_t* data, size_t position, uint8_t length);
 
+/**
+ * @brief Find the first occurrence of a bit pattern.
+ * Data is scanned a byte at a time through a shifting window, so preambles
+ * can be searched over a whole buffer in one pass.
+ * @param data The data to search in.
+ * @param position The position of the first bit to search from.
+ * @param length Count of bits to search in, the match must fit entirely.
+ * @param pattern The pattern, right aligned.
+ * @param pattern_length The pattern length, 1 to 32 bits.
+ * @return The position of the first pattern bit, or BIT_LIB_NOT_FOUND.
+ */
+size_t bit_lib_find_pattern(
+    const uint8_t* data,
+    size_t position,
+    size_t length,
+    uint32_t pattern,
+    uint8_t pattern_length);
+
 /**
  * @brief Test parity of given bits
  * @param bits Bits to test parity of
@@ -107,6 +127,21 @@ uint64_t bit_lib_get_bits_64(const uint8_t* data, size_t position, uint8_t lengt
  */
 bool bit_lib_test_parity_32(uint32_t bits, BitLibParity parity);
 
+/**
+ * @brief Test parity of every parity_length block packed in a word, starting from MSB
+ * 
+ * @param bits Right aligned bits to test
+ * @param length Bit count, up to 32. Trailing bits of an incomplete block are ignored
+ * @param parity Parity to test against
+ * @param parity_length Parity block length, up to 32
+ * @return true if parity of every block is correct, false otherwise
+ */
+bool bit_lib_test_parity_blocks_32(
+    uint32_t bits,
+    uint8_t length,
+    BitLibParity parity,
+    uint8_t parity_length);
+
 /**
  * @brief Test parity of bit array, check parity for every parity_length block from start
  * 
@@ -235,7 +270,7 @@ uint16_t bit_lib_reverse_16_fast(uint16_t data);
 uint8_t bit_lib_reverse_8_fast(uint8_t byte);
 
 /**
- * @brief Slow, but generic CRC8 implementation
+ * @brief Generic bitwise CRC8 implementation
  * 
  * @param data 
  * @param data_size 
@@ -256,7 +291,7 @@ uint16_t bit_lib_crc8(
     uint8_t xor_out);
 
 /**
- * @brief Slow, but generic CRC16 implementation
+ * @brief Generic bitwise CRC16 implementation
  * 
  * @param data 
  * @param data_size 
@@ -243,6 +243,63 @@ bool ble_profile_hid_kb_release_all(FuriHalBleProfileBase* profile) {
         sizeof(FuriHalBtHidKbReport));
 }
 
+bool ble_profile_hid_kb_type(
+    FuriHalBleProfileBase* profile,
+    const uint16_t* buttons,
+    size_t count) {
+    furi_check(profile);
+    furi_check(profile->config == ble_profile_hid);
+    furi_check(buttons || (count == 0));
+
+    BleProfileHid* hid_profile = (BleProfileHid*)profile;
+    FuriHalBtHidKbReport* kb_report = hid_profile->kb_report;
+    const FuriHalBtHidKbReport held_report = *kb_report;
+
+    bool state = true;
+    size_t button_nb = 0;
+    while((button_nb < count) && state) {
+        const uint8_t mods = buttons[button_nb] >> 8;
+        size_t group_size = 0;
+
+        for(; button_nb < count; button_nb++) {
+            const uint8_t key = buttons[button_nb] & 0xFF;
+            if((buttons[button_nb] >> 8) != mods) break;
+
+            uint8_t free_nb = BLE_PROFILE_HID_KB_MAX_KEYS;
+            bool conflict = false;
+            for(uint8_t i = 0; i < BLE_PROFILE_HID_KB_MAX_KEYS; i++) {
+                if((key != 0) && (kb_report->key[i] == key)) conflict = true;
+                if((kb_report->key[i] == 0) && (free_nb == BLE_PROFILE_HID_KB_MAX_KEYS))
+                    free_nb = i;
+            }
+            // First key of group is always sent, like ble_profile_hid_kb_press() does
+            if((group_size > 0) &&
+               (conflict || ((key != 0) && (free_nb == BLE_PROFILE_HID_KB_MAX_KEYS))))
+                break;
+            if((key != 0) && (free_nb < BLE_PROFILE_HID_KB_MAX_KEYS)) {
+                kb_report->key[free_nb] = key;
+            }
+            group_size++;
+        }
+
+        kb_report->mods = held_report.mods | mods;
+        state &= ble_svc_hid_update_input_report(
+            hid_profile->hid_svc,
+            ReportNumberKeyboard,
+            (uint8_t*)kb_report,
+            sizeof(FuriHalBtHidKbReport));
+
+        *kb_report = held_report;
+        state &= ble_svc_hid_update_input_report(
+            hid_profile->hid_svc,
+            ReportNumberKeyboard,
+            (uint8_t*)kb_report,
+            sizeof(FuriHalBtHidKbReport));
+    }
+
+    return state;
+}
+
 bool ble_profile_hid_consumer_key_press(FuriHalBleProfileBase* profile, uint16_t button) {
     furi_check(profile);
     furi_check(profile->config == ble_profile_hid);
@@ -378,6 +435,8 @@ bool ble_profile_hid_mouse_scroll(FuriHalBleProfileBase* profile, int8_t delta)
 #define CONNECTION_INTERVAL_MIN (0x0006)
 // Up to 45 ms
 #define CONNECTION_INTERVAL_MAX (0x24)
+// Up to 15 ms, for pointer and gamepad use
+#define CONNECTION_INTERVAL_LOW_LATENCY_MAX (0x0C)
 
 static GapConfig template_config = {
     .adv_service_uuid = HUMAN_INTERFACE_DEVICE_SERVICE_UUID,
@@ -406,6 +465,9 @@ static void ble_profile_hid_get_config(GapConfig* config, FuriHalBleProfileParam
     if(hid_profile_params) {
         config->mac_address[0] ^= hid_profile_params->mac_xor;
         config->mac_address[1] ^= hid_profile_params->mac_xor >> 8;
+        if(hid_profile_params->low_latency) {
+            config->conn_param.conn_int_max = CONNECTION_INTERVAL_LOW_LATENCY_MAX;
+        }
     }
 
     // Set advertise name
@@ -13,6 +13,7 @@ extern "C" {
 typedef struct {
     const char* device_name_prefix; /**< Prefix for device name. Length must be less than 8 */
     uint16_t mac_xor; /**< XOR mask for device address, for uniqueness */
+    bool low_latency; /**< Ask host for connection interval of 15 ms at most */
 } BleProfileHidParams;
 
 /** Hid Keyboard Profile descriptor */
@@ -43,6 +44,22 @@ bool ble_profile_hid_kb_release(FuriHalBleProfileBase* profile, uint16_t button)
  */
 bool ble_profile_hid_kb_release_all(FuriHalBleProfileBase* profile);
 
+/** Type key sequence: press and release every key in order
+ *
+ * Consecutive keys with the same modifiers are sent in one notification,
+ * up to 6 keys each. A key repeated within a group starts the next one.
+ *
+ * @param profile   profile instance
+ * @param buttons   button codes from HID specification
+ * @param count     button codes count
+ *
+ * @return          true on success
+ */
+bool ble_profile_hid_kb_type(
+    FuriHalBleProfileBase* profile,
+    const uint16_t* buttons,
+    size_t count);
+
 /** Set the following consumer key to pressed state and send HID report
  *
  * @param profile   profile instance
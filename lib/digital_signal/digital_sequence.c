@@ -171,9 +171,8 @@ static void digital_sequence_stop_timer(void) {
     furi_hal_bus_disable(FuriHalBusTIM2);
 }
 
-static inline void digital_sequence_init_gpio_buffer(
-    DigitalSequence* sequence,
-    const DigitalSignal* first_signal) {
+static inline void
+    digital_sequence_init_gpio_buffer(DigitalSequence* sequence, bool start_level) {
     const uint32_t bit_set = sequence->gpio->pin << GPIO_BSRR_BS0_Pos
 #ifdef DIGITAL_SIGNAL_DEBUG_OUTPUT_PIN
                              | DIGITAL_SIGNAL_DEBUG_OUTPUT_PIN.pin << GPIO_BSRR_BS0_Pos
@@ -186,7 +185,7 @@ static inline void digital_sequence_init_gpio_buffer(
 #endif
         ;
 
-    if(first_signal->start_level) {
+    if(start_level) {
         sequence->gpio_buf[0] = bit_set;
         sequence->gpio_buf[1] = bit_reset;
     } else {
@@ -280,7 +279,7 @@ static inline void digital_sequence_timer_buffer_reset(DigitalSequence* sequence
     sequence->timer_buf.write_pos = 0;
 }
 
-void digital_sequence_transmit(DigitalSequence* sequence) {
+FURI_RAMFUNC void digital_sequence_transmit(DigitalSequence* sequence) {
     furi_check(sequence);
     furi_check(sequence->size);
     furi_check(sequence->state == DigitalSequenceStateIdle);
@@ -295,7 +294,7 @@ void digital_sequence_transmit(DigitalSequence* sequence) {
 
     const DigitalSignal* signal_current = sequence->signals[sequence->data[0]];
 
-    digital_sequence_init_gpio_buffer(sequence, signal_current);
+    digital_sequence_init_gpio_buffer(sequence, signal_current->start_level);
 
     int32_t remainder_ticks = 0;
     uint32_t reload_value_carry = 0;
@@ -380,3 +379,204 @@ void digital_sequence_clear(DigitalSequence* sequence) {
 
     sequence->size = 0;
 }
+
+struct DigitalSequenceTemplate {
+    bool start_level;
+    uint32_t size;
+    uint32_t max_size;
+    /* Total length in timer ticks, bounds the wait for transmission end. */
+    uint64_t duration;
+
+    uint32_t signal_count;
+    uint32_t max_signals;
+    /* Per sequence position: the signal and index of its first period in data. Adjacent equal
+     * levels are merged by adding periods together, so signal periods always take consecutive
+     * entries starting from the offset. */
+    const DigitalSignal** signals;
+    uint32_t* offsets;
+
+    /* Timer values terminated with DIGITAL_SEQUENCE_TIMER_MAX, same as in the ring buffer. */
+    uint32_t data[];
+};
+
+DigitalSequenceTemplate*
+    digital_sequence_template_alloc(uint32_t max_periods, uint32_t max_signals) {
+    furi_check(max_periods);
+    furi_check(max_signals);
+
+    DigitalSequenceTemplate* template =
+        malloc(sizeof(DigitalSequenceTemplate) + sizeof(uint32_t) * (max_periods + 1));
+
+    template->max_size = max_periods;
+    template->max_signals = max_signals;
+    template->signals = malloc(sizeof(const DigitalSignal*) * max_signals);
+    template->offsets = malloc(sizeof(uint32_t) * max_signals);
+
+    return template;
+}
+
+void digital_sequence_template_free(DigitalSequenceTemplate* template) {
+    furi_check(template);
+
+    free(template->signals);
+    free(template->offsets);
+    free(template);
+}
+
+bool digital_sequence_template_build(
+    DigitalSequenceTemplate* template,
+    const DigitalSequence* sequence) {
+    furi_check(template);
+    furi_check(sequence);
+    furi_check(sequence->size);
+
+    if(sequence->size > template->max_signals) return false;
+
+    template->size = 0;
+    template->duration = 0;
+    template->signal_count = sequence->size;
+
+    const DigitalSignal* signal_current = sequence->signals[sequence->data[0]];
+    template->start_level = signal_current->start_level;
+
+    int32_t remainder_ticks = 0;
+    uint32_t reload_value_carry = 0;
+
+    /* Same period merging and rounding as in digital_sequence_transmit() */
+    for(uint32_t position = 0; position < sequence->size; position++) {
+        const DigitalSignal* signal_next = (position + 1 < sequence->size) ?
+                                               sequence->signals[sequence->data[position + 1]] :
+                                               NULL;
+
+        template->signals[position] = signal_current;
+        template->offsets[position] = template->size;
+
+        for(uint32_t i = 0; i < signal_current->size; i++) {
+            const bool is_last_value = (i == signal_current->size - 1);
+            const uint32_t reload_value = signal_current->data[i] + reload_value_carry;
+
+            reload_value_carry = 0;
+
+            if(is_last_value) {
+                if(signal_next != NULL) {
+                    const bool end_level = signal_current->start_level ^
+                                           ((signal_current->size % 2) == 0);
+                    if(end_level == signal_next->start_level) {
+                        reload_value_carry = reload_value;
+                    }
+                } else {
+                    /* Last period is held indefinitely */
+                    reload_value_carry = 1;
+                }
+            }
+
+            if(reload_value_carry == 0) {
+                if(template->size >= template->max_size) return false;
+                template->data[template->size++] = reload_value;
+                template->duration += reload_value;
+            }
+        }
+
+        if(signal_next == NULL) break;
+
+        remainder_ticks += signal_current->remainder;
+        if(remainder_ticks >= DIGITAL_SIGNAL_T_TIM_DIV2) {
+            remainder_ticks -= DIGITAL_SIGNAL_T_TIM;
+            reload_value_carry += 1;
+        }
+
+        signal_current = signal_next;
+    }
+
+    template->data[template->size] = DIGITAL_SEQUENCE_TIMER_MAX;
+
+    return true;
+}
+
+void digital_sequence_template_set_signal(
+    DigitalSequenceTemplate* template,
+    uint32_t position,
+    const DigitalSignal* signal) {
+    furi_check(template);
+    furi_check(signal);
+    furi_check(position < template->signal_count);
+
+    const DigitalSignal* signal_old = template->signals[position];
+    furi_check(signal->size == signal_old->size);
+    furi_check(signal->start_level == signal_old->start_level);
+
+    const uint32_t offset = template->offsets[position];
+
+    for(uint32_t i = 0; i < signal->size; i++) {
+        /* Last period of the last signal is not stored */
+        if(offset + i >= template->size) break;
+
+        const uint32_t delta = signal->data[i] - signal_old->data[i];
+        template->data[offset + i] += delta;
+        template->duration += (int32_t)delta;
+    }
+
+    template->signals[position] = signal;
+}
+
+void digital_sequence_transmit_template(
+    DigitalSequence* sequence,
+    const DigitalSequenceTemplate* template) {
+    furi_check(sequence);
+    furi_check(template);
+    furi_check(template->signal_count);
+    furi_check(sequence->state == DigitalSequenceStateIdle);
+
+    LL_DMA_InitTypeDef dma_config_timer = sequence->dma_config_timer;
+    dma_config_timer.MemoryOrM2MDstAddress = (uint32_t)template->data;
+    dma_config_timer.Mode = LL_DMA_MODE_NORMAL;
+    dma_config_timer.NbData = template->size + 1;
+
+    FURI_CRITICAL_ENTER();
+
+    furi_hal_gpio_init(sequence->gpio, GpioModeOutputPushPull, GpioPullNo, GpioSpeedVeryHigh);
+#ifdef DIGITAL_SIGNAL_DEBUG_OUTPUT_PIN
+    furi_hal_gpio_init(
+        &DIGITAL_SIGNAL_DEBUG_OUTPUT_PIN, GpioModeOutputPushPull, GpioPullNo, GpioSpeedVeryHigh);
+#endif
+
+    digital_sequence_init_gpio_buffer(sequence, template->start_level);
+
+    LL_DMA_Init(DMA1, LL_DMA_CHANNEL_1, &sequence->dma_config_gpio);
+    LL_DMA_Init(DMA1, LL_DMA_CHANNEL_2, &dma_config_timer);
+    LL_DMA_EnableChannel(DMA1, LL_DMA_CHANNEL_1);
+    LL_DMA_EnableChannel(DMA1, LL_DMA_CHANNEL_2);
+
+    digital_sequence_start_timer();
+
+    FURI_CRITICAL_EXIT();
+
+    sequence->state = DigitalSequenceStateActive;
+
+    /* DMA only needs the bus, so just wait for it to load the final value */
+    const uint64_t wait_ticks = template->duration + DIGITAL_SEQUENCE_LOCK_WAIT_TICKS;
+    const uint32_t prev_timer = DWT->CYCCNT;
+    uint64_t elapsed_ticks = 0;
+    uint32_t last_timer = prev_timer;
+
+    while(TIM2->ARR != DIGITAL_SEQUENCE_TIMER_MAX ||
+          LL_DMA_GetDataLength(DMA1, LL_DMA_CHANNEL_2) != 0) {
+        const uint32_t timer = DWT->CYCCNT;
+        elapsed_ticks += timer - last_timer;
+        last_timer = timer;
+
+        if(elapsed_ticks > wait_ticks) {
+            FURI_LOG_D(
+                TAG,
+                "[TPL] hung in transmit (ARR 0x%08lx, left %lu)",
+                TIM2->ARR,
+                LL_DMA_GetDataLength(DMA1, LL_DMA_CHANNEL_2));
+            break;
+        }
+    }
+
+    digital_sequence_stop_timer();
+    digital_sequence_stop_dma();
+
+    sequence->state = DigitalSequenceStateIdle;
+}
@@ -27,6 +27,10 @@
  *
  * This way, only the order in which the signals are sent is stored, while the signals themselves
  * are not duplicated.
+ *
+ * A sequence that is sent often, e.g. a protocol response, can be built once into a
+ * DigitalSequenceTemplate. It holds ready-made timer values, so transmitting it takes no
+ * preparation time, and individual signals in it can be replaced in place.
  */
 #pragma once
 
@@ -40,6 +44,8 @@ extern "C" {
 
 typedef struct DigitalSequence DigitalSequence;
 
+typedef struct DigitalSequenceTemplate DigitalSequenceTemplate;
+
 /**
  * @brief Allocate a DigitalSequence instance of a given size which will operate on a set GPIO pin.
  *
@@ -107,6 +113,64 @@ void digital_sequence_transmit(DigitalSequence* sequence);
  */
 void digital_sequence_clear(DigitalSequence* sequence);
 
+/**
+ * @brief Allocate a DigitalSequenceTemplate instance.
+ *
+ * @param[in] max_periods maximum number of timer periods, roughly the sum of signal sizes.
+ * @param[in] max_signals maximum number of signal indices in the source sequence.
+ * @returns pointer to the allocated DigitalSequenceTemplate instance.
+ */
+DigitalSequenceTemplate*
+    digital_sequence_template_alloc(uint32_t max_periods, uint32_t max_signals);
+
+/**
+ * @brief Delete a previously allocated DigitalSequenceTemplate instance.
+ *
+ * @param[in,out] template pointer to the instance to be deleted.
+ */
+void digital_sequence_template_free(DigitalSequenceTemplate* template);
+
+/**
+ * @brief Build the sequence contained in the DigitalSequence instance into a template.
+ *
+ * The template keeps referencing the signals, their lifetime must be no less than its own.
+ *
+ * @param[out] template pointer to the template to be built.
+ * @param[in] sequence pointer to the sequence, must contain at least one signal index.
+ * @returns true on success, false if the sequence does not fit into the template.
+ */
+bool digital_sequence_template_build(
+    DigitalSequenceTemplate* template,
+    const DigitalSequence* sequence);
+
+/**
+ * @brief Replace a signal at a given position in a built template.
+ *
+ * Only the timer values of this signal are updated, so the new signal must have the same
+ * size and start level as the one it replaces, e.g. "Zero" and "One" bit signals.
+ *
+ * @param[in,out] template pointer to the template to be modified.
+ * @param[in] position index of the signal within the source sequence.
+ * @param[in] signal pointer to the DigitalSignal to be put at this position.
+ */
+void digital_sequence_template_set_signal(
+    DigitalSequenceTemplate* template,
+    uint32_t position,
+    const DigitalSignal* signal);
+
+/**
+ * @brief Transmit a built template on the GPIO pin of a DigitalSequence instance.
+ *
+ * Timer values are fed by DMA directly from the template, interrupts stay enabled during
+ * the transmission. Same GPIO notes apply as for digital_sequence_transmit().
+ *
+ * @param[in] sequence pointer to the sequence which GPIO pin is to be used.
+ * @param[in] template pointer to the template to be transmitted.
+ */
+void digital_sequence_transmit_template(
+    DigitalSequence* sequence,
+    const DigitalSequenceTemplate* template);
+
 #ifdef __cplusplus
 }
 #endif
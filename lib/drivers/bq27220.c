@@ -575,3 +575,42 @@ uint16_t bq27220_get_state_of_charge(FuriHalI2cBusHandle* handle) {
 uint16_t bq27220_get_state_of_health(FuriHalI2cBusHandle* handle) {
     return bq27220_read_word(handle, CommandStateOfHealth);
 }
+
+// Temperature to StateOfHealth is one contiguous block of standard commands
+#define BQ27220_SNAPSHOT_BLOCK_SIZE (CommandStateOfHealth + 2 - CommandTemperature)
+// OperationStatus is followed by DesignCapacity
+#define BQ27220_SNAPSHOT_STATUS_SIZE (4U)
+
+static inline uint16_t bq27220_get_block_word(const uint8_t* block, uint8_t command) {
+    const uint8_t* word = &block[command - CommandTemperature];
+    return word[0] | (word[1] << 8);
+}
+
+bool bq27220_get_snapshot(FuriHalI2cBusHandle* handle, Bq27220Snapshot* snapshot) {
+    uint8_t block[BQ27220_SNAPSHOT_BLOCK_SIZE];
+    uint8_t status[BQ27220_SNAPSHOT_STATUS_SIZE];
+
+    memset(snapshot, 0, sizeof(Bq27220Snapshot));
+
+    if(!bq27220_read_reg(handle, CommandTemperature, block, sizeof(block)) ||
+       !bq27220_read_reg(handle, CommandOperationStatus, status, sizeof(status))) {
+        FURI_LOG_E(TAG, "bq27220_get_snapshot failed");
+        return false;
+    }
+
+    snapshot->temperature = bq27220_get_block_word(block, CommandTemperature);
+    snapshot->voltage = bq27220_get_block_word(block, CommandVoltage);
+    memcpy(
+        &snapshot->battery_status,
+        &block[CommandBatteryStatus - CommandTemperature],
+        sizeof(Bq27220BatteryStatus));
+    snapshot->current = (int16_t)bq27220_get_block_word(block, CommandCurrent);
+    snapshot->remaining_capacity = bq27220_get_block_word(block, CommandRemainingCapacity);
+    snapshot->full_charge_capacity = bq27220_get_block_word(block, CommandFullChargeCapacity);
+    snapshot->state_of_charge = bq27220_get_block_word(block, CommandStateOfCharge);
+    snapshot->state_of_health = bq27220_get_block_word(block, CommandStateOfHealth);
+    memcpy(&snapshot->operation_status, &status[0], sizeof(Bq27220OperationStatus));
+    snapshot->design_capacity = status[2] | (status[3] << 8);
+
+    return true;
+}
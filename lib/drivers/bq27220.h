@@ -117,6 +117,20 @@ typedef struct {
 
 _Static_assert(sizeof(Bq27220GaugingStatus) == 2, "Incorrect Bq27220GaugingStatus structure size");
 
+/** Gauge state read in a couple of bus transactions */
+typedef struct {
+    uint16_t temperature; /**< Temperature in units of 0.1K */
+    uint16_t voltage; /**< Voltage in mV */
+    Bq27220BatteryStatus battery_status;
+    int16_t current; /**< Current in mA */
+    uint16_t remaining_capacity; /**< Remaining capacity in mAh */
+    uint16_t full_charge_capacity; /**< Full charge capacity in mAh */
+    uint16_t state_of_charge; /**< State of charge in percents */
+    uint16_t state_of_health; /**< State of health in percents */
+    Bq27220OperationStatus operation_status;
+    uint16_t design_capacity; /**< Design capacity in mAh */
+} Bq27220Snapshot;
+
 typedef struct BQ27220DMData BQ27220DMData;
 
 /** Initialize Driver
@@ -273,3 +287,12 @@ uint16_t bq27220_get_state_of_charge(FuriHalI2cBusHandle* handle);
  * @return     state of health in percents or BQ27220_ERROR
  */
 uint16_t bq27220_get_state_of_health(FuriHalI2cBusHandle* handle);
+
+/** Get gauge state with burst reads of standard command registers
+ *
+ * @param      handle    The I2C Bus handle
+ * @param[out] snapshot  Gauge state, zeroed on failure
+ *
+ * @return     true on success, false otherwise
+ */
+bool bq27220_get_snapshot(FuriHalI2cBusHandle* handle, Bq27220Snapshot* snapshot);
@@ -2,6 +2,7 @@
 #include <assert.h>
 #include <string.h>
 #include <furi_hal_cortex.h>
+#include <furi.h>
 
 static bool cc1101_spi_trx(FuriHalSpiBusHandle* handle, uint8_t* tx, uint8_t* rx, uint8_t size) {
     FuriHalCortexTimer timer = furi_hal_cortex_timer_get(CC1101_TIMEOUT * 1000);
@@ -52,6 +53,42 @@ CC1101Status cc1101_read_reg(FuriHalSpiBusHandle* handle, uint8_t reg, uint8_t*
     return rx[0];
 }
 
+CC1101Status cc1101_write_regs(
+    FuriHalSpiBusHandle* handle,
+    uint8_t reg,
+    const uint8_t* data,
+    uint8_t size) {
+    assert(size && size <= CC1101_BURST_SIZE_MAX);
+    uint8_t tx[CC1101_BURST_SIZE_MAX + 1] = {reg | CC1101_BURST};
+    CC1101Status rx[CC1101_BURST_SIZE_MAX + 1] = {0};
+    rx[0].CHIP_RDYn = 1;
+    rx[size].CHIP_RDYn = 1;
+
+    memcpy(&tx[1], data, size);
+
+    cc1101_spi_trx(handle, tx, (uint8_t*)rx, size + 1);
+
+    assert((rx[0].CHIP_RDYn | rx[size].CHIP_RDYn) == 0);
+    return rx[size];
+}
+
+CC1101Status cc1101_read_regs(
+    FuriHalSpiBusHandle* handle,
+    uint8_t reg,
+    uint8_t* data,
+    uint8_t size) {
+    assert(size && size <= CC1101_BURST_SIZE_MAX);
+    uint8_t tx[CC1101_BURST_SIZE_MAX + 1] = {reg | CC1101_READ | CC1101_BURST};
+    CC1101Status rx[CC1101_BURST_SIZE_MAX + 1] = {0};
+    rx[0].CHIP_RDYn = 1;
+
+    cc1101_spi_trx(handle, tx, (uint8_t*)rx, size + 1);
+
+    assert(rx[0].CHIP_RDYn == 0);
+    memcpy(data, &rx[1], size);
+    return rx[0];
+}
+
 uint8_t cc1101_get_partnumber(FuriHalSpiBusHandle* handle) {
     uint8_t partnumber = 0;
     cc1101_read_reg(handle, CC1101_STATUS_PARTNUM | CC1101_BURST, &partnumber);
@@ -135,6 +172,53 @@ uint32_t cc1101_set_frequency(FuriHalSpiBusHandle* handle, uint32_t value) {
     return (uint32_t)real_frequency;
 }
 
+uint32_t cc1101_set_frequency_calibrated(
+    FuriHalSpiBusHandle* handle,
+    CC1101CalibrationCache* cache,
+    uint32_t value) {
+    const uint32_t word = (uint64_t)value * CC1101_FDIV / CC1101_QUARTZ;
+    assert((word & CC1101_FMASK) == word);
+
+    const uint32_t now = furi_get_tick();
+    const uint32_t timeout = furi_ms_to_ticks(CC1101_CALIBRATION_CACHE_TIMEOUT_MS);
+    CC1101CalibrationEntry* entry = NULL;
+    CC1101CalibrationEntry* victim = &cache->entries[0];
+
+    for(size_t i = 0; i < CC1101_CALIBRATION_CACHE_SIZE; i++) {
+        CC1101CalibrationEntry* it = &cache->entries[i];
+        if(it->word == word) {
+            entry = it;
+            break;
+        }
+        // Replace the first empty entry or the oldest one
+        if(!victim->word) continue;
+        if(!it->word || (int32_t)(it->timestamp - victim->timestamp) < 0) victim = it;
+    }
+
+    if(entry && now - entry->timestamp < timeout) {
+        const uint8_t freq[3] = {(word >> 16) & 0xFF, (word >> 8) & 0xFF, (word >> 0) & 0xFF};
+        cc1101_write_regs(handle, CC1101_FREQ2, freq, sizeof(freq));
+        cc1101_write_regs(handle, CC1101_FSCAL3, entry->fscal, sizeof(entry->fscal));
+    } else {
+        if(!entry) entry = victim;
+        entry->word = 0;
+
+        cc1101_set_frequency(handle, value);
+        cc1101_calibrate(handle);
+        if(!cc1101_wait_status_state(handle, CC1101StateIDLE, 10000)) return 0;
+
+        cc1101_read_regs(handle, CC1101_FSCAL3, entry->fscal, sizeof(entry->fscal));
+        entry->word = word;
+        entry->timestamp = now;
+    }
+
+    return (uint64_t)word * CC1101_QUARTZ / CC1101_FDIV;
+}
+
+void cc1101_calibration_cache_reset(CC1101CalibrationCache* cache) {
+    memset(cache, 0, sizeof(CC1101CalibrationCache));
+}
+
 uint32_t cc1101_set_intermediate_frequency(FuriHalSpiBusHandle* handle, uint32_t value) {
     uint64_t real_value = value * CC1101_IFDIV / CC1101_QUARTZ;
     assert((real_value & 0xFF) == real_value);
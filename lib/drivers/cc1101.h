@@ -10,6 +10,22 @@
 extern "C" {
 #endif
 
+#define CC1101_BURST_SIZE_MAX (0x2FU) // Configuration registers space
+
+#define CC1101_CALIBRATION_CACHE_SIZE       (48U)
+#define CC1101_CALIBRATION_CACHE_TIMEOUT_MS (30000U) // Synthesizer drifts with temperature
+
+typedef struct {
+    uint32_t word; // FREQ2..FREQ0 value, 0 marks empty entry
+    uint32_t timestamp; // Calibration tick
+    uint8_t fscal[3]; // FSCAL3..FSCAL1
+} CC1101CalibrationEntry;
+
+/** Synthesizer calibration results per frequency, one per chip */
+typedef struct {
+    CC1101CalibrationEntry entries[CC1101_CALIBRATION_CACHE_SIZE];
+} CC1101CalibrationCache;
+
 /* Low level API */
 
 /** Strobe command to the device
@@ -41,6 +57,36 @@ CC1101Status cc1101_write_reg(FuriHalSpiBusHandle* handle, uint8_t reg, uint8_t
  */
 CC1101Status cc1101_read_reg(FuriHalSpiBusHandle* handle, uint8_t reg, uint8_t* data);
 
+/** Write consecutive device registers in one burst
+ *
+ * @param      handle  - pointer to FuriHalSpiHandle
+ * @param      reg     - first register
+ * @param      data    - data to write
+ * @param      size    - registers count, up to CC1101_BURST_SIZE_MAX
+ *
+ * @return     device status
+ */
+CC1101Status cc1101_write_regs(
+    FuriHalSpiBusHandle* handle,
+    uint8_t reg,
+    const uint8_t* data,
+    uint8_t size);
+
+/** Read consecutive device registers in one burst
+ *
+ * @param      handle  - pointer to FuriHalSpiHandle
+ * @param      reg     - first register
+ * @param[out] data    - pointer to data
+ * @param      size    - registers count, up to CC1101_BURST_SIZE_MAX
+ *
+ * @return     device status
+ */
+CC1101Status cc1101_read_regs(
+    FuriHalSpiBusHandle* handle,
+    uint8_t reg,
+    uint8_t* data,
+    uint8_t size);
+
 /* High level API */
 
 /** Reset
@@ -154,6 +200,29 @@ CC1101Status cc1101_flush_tx(FuriHalSpiBusHandle* handle);
  */
 uint32_t cc1101_set_frequency(FuriHalSpiBusHandle* handle, uint32_t value);
 
+/** Set Frequency and calibrate synthesizer, reusing cached calibration
+ *
+ * First use of frequency runs full calibration and stores FSCAL3..FSCAL1,
+ * following ones restore them with a burst write. Entries expire after
+ * CC1101_CALIBRATION_CACHE_TIMEOUT_MS. Chip must be in IDLE state.
+ *
+ * @param      handle  - pointer to FuriHalSpiHandle
+ * @param      cache   - calibration cache of this chip
+ * @param      value   - frequency in herz
+ *
+ * @return     real frequency that were synthesized, 0 if calibration timed out
+ */
+uint32_t cc1101_set_frequency_calibrated(
+    FuriHalSpiBusHandle* handle,
+    CC1101CalibrationCache* cache,
+    uint32_t value);
+
+/** Drop all cached calibration results
+ *
+ * @param      cache   - calibration cache
+ */
+void cc1101_calibration_cache_reset(CC1101CalibrationCache* cache);
+
 /** Set Intermediate Frequency
  *
  * @param      handle  - pointer to FuriHalSpiHandle
@@ -1138,6 +1138,11 @@ FRESULT put_fat (	/* FR_OK(0):succeeded, !=0:error */
 /* exFAT: Accessing FAT and Allocation Bitmap                            */
 /*-----------------------------------------------------------------------*/
 
+#if _FS_EXFAT_BM_SUMMARY
+#define BM_GROUP_BITS(fs) ((fs)->bm_gsect * SS(fs) * 8)	/* Number of clusters covered by a summary group */
+#define BM_GROUP(fs, sect) (((sect) - (fs)->database) / (fs)->bm_gsect)	/* Summary group of a bitmap sector */
+#endif
+
 /*--------------------------------------*/
 /* Find a contiguous free cluster block */
 /*--------------------------------------*/
@@ -1158,6 +1163,17 @@ DWORD find_bitmap (	/* 0:Not found, 2..:Cluster block found, 0xFFFFFFFF:Disk err
 	if (clst >= fs->n_fatent - 2) clst = 0;
 	scl = val = clst; ctr = 0;
 	for (;;) {
+#if _FS_EXFAT_BM_SUMMARY
+		if (fs->bm_gsect && fs->bm_free[val / BM_GROUP_BITS(fs)] == 0) {	/* Is the whole group in use? */
+			DWORD end = (val / BM_GROUP_BITS(fs) + 1) * BM_GROUP_BITS(fs);
+			if (end > fs->n_fatent - 2) end = fs->n_fatent - 2;
+			if (clst > val && clst < end) return 0;	/* All cluster scanned? */
+			val = (end == fs->n_fatent - 2) ? 0 : end;	/* Skip the group (with wrap-around) */
+			scl = val; ctr = 0;
+			if (val == clst) return 0;
+			continue;
+		}
+#endif
 		if (move_window(fs, fs->database + val / 8 / SS(fs)) != FR_OK) return 0xFFFFFFFF;	/* (assuming bitmap is located top of the cluster heap) */
 		i = val / 8 % SS(fs); bm = 1 << (val % 8);
 		do {
@@ -1206,6 +1222,11 @@ FRESULT change_bitmap (
 				if (bv == (int)((fs->win[i] & bm) != 0)) return FR_INT_ERR;	/* Is the bit expected value? */
 				fs->win[i] ^= bm;	/* Flip the bit */
 				fs->wflag = 1;
+#if _FS_EXFAT_BM_SUMMARY
+				if (fs->bm_gsect) {	/* Keep the summary in sync */
+					if (bv) fs->bm_free[BM_GROUP(fs, sect - 1)]--; else fs->bm_free[BM_GROUP(fs, sect - 1)]++;
+				}
+#endif
 				if (--ncl == 0) return FR_OK;	/* All bits processed? */
 			} while (bm <<= 1);		/* Next bit */
 			bm = 1;
@@ -3108,6 +3129,9 @@ FRESULT find_volume (	/* FR_OK(0): successful, !=0: any error occurred */
 		if (i == SS(fs)) return FR_NO_FILESYSTEM;
 #if !_FS_READONLY
 		fs->last_clst = fs->free_clst = 0xFFFFFFFF;		/* Initialize cluster allocation information */
+#if _FS_EXFAT_BM_SUMMARY
+		fs->bm_gsect = 0;		/* Bitmap summary is built by f_getfree() */
+#endif
 #endif
 		fmt = FS_EXFAT;			/* FAT sub-type */
 	} else
@@ -4426,14 +4450,27 @@ FRESULT f_getfree (
 					clst = fs->n_fatent - 2;
 					sect = fs->database;
 					i = 0;
+#if _FS_EXFAT_BM_SUMMARY
+					fs->bm_gsect = ((clst + 7) / 8 + SS(fs) - 1) / SS(fs);	/* Number of bitmap sectors */
+					fs->bm_gsect = (fs->bm_gsect + _FS_EXFAT_BM_SUMMARY - 1) / _FS_EXFAT_BM_SUMMARY;
+					mem_set(fs->bm_free, 0, sizeof fs->bm_free);
+#endif
 					do {
 						if (i == 0 && (res = move_window(fs, sect++)) != FR_OK) break;
 						for (b = 8, bm = fs->win[i]; b && clst; b--, clst--) {
-							if (!(bm & 1)) nfree++;
+							if (!(bm & 1)) {
+								nfree++;
+#if _FS_EXFAT_BM_SUMMARY
+								fs->bm_free[BM_GROUP(fs, sect - 1)]++;
+#endif
+							}
 							bm >>= 1;
 						}
 						i = (i + 1) % SS(fs);
 					} while (clst);
+#if _FS_EXFAT_BM_SUMMARY
+					if (res != FR_OK) fs->bm_gsect = 0;	/* Summary is incomplete */
+#endif
 				} else
 #endif
 				{	/* FAT16/32: Sector alighed FAT entries */
@@ -32,6 +32,10 @@ extern "C" {
 #error Wrong configuration file (ffconf.h).
 #endif
 
+#ifndef _FS_EXFAT_BM_SUMMARY
+#define _FS_EXFAT_BM_SUMMARY 0
+#endif
+
 
 
 /* Definitions of volume management */
@@ -107,6 +111,10 @@ typedef struct {
 	DWORD	last_clst;		/* Last allocated cluster */
 	DWORD	free_clst;		/* Number of free clusters */
 #endif
+#if _FS_EXFAT && !_FS_READONLY && _FS_EXFAT_BM_SUMMARY
+	DWORD	bm_gsect;		/* Bitmap sectors per summary group (0:summary is not valid) */
+	DWORD	bm_free[_FS_EXFAT_BM_SUMMARY];	/* Number of free clusters in each group */
+#endif
 #if _FS_RPATH != 0
 	DWORD	cdir;			/* Current directory start cluster (0:root) */
 #if _FS_EXFAT
@@ -36,6 +36,38 @@ bool elf_resolve_from_hashtable(
     return result;
 }
 
+bool elf_resolve_from_indexed_hashtable(
+    const ElfApiInterface* interface,
+    uint32_t hash,
+    Elf32_Addr* address) {
+    furi_check(interface);
+    furi_check(address);
+
+    const HashtableIndexedApiInterface* hashtable_interface =
+        static_cast<const HashtableIndexedApiInterface*>(interface);
+
+    const uint32_t bucket = hashtable_bucket_of(hash);
+    const sym_entry* bucket_cbegin =
+        hashtable_interface->table_cbegin + hashtable_interface->bucket_index[bucket];
+    const sym_entry* bucket_cend =
+        hashtable_interface->table_cbegin + hashtable_interface->bucket_index[bucket + 1];
+
+    sym_entry key = {
+        .hash = hash,
+        .address = 0,
+    };
+
+    auto find_res = std::lower_bound(bucket_cbegin, bucket_cend, key);
+    if(find_res == bucket_cend || find_res->hash != hash) {
+        FURI_LOG_T(
+            TAG, "Can't find symbol with hash %lx @ %p!", hash, hashtable_interface->table_cbegin);
+        return false;
+    }
+
+    *address = find_res->address;
+    return true;
+}
+
 uint32_t elf_symbolname_hash(const char* s) {
     furi_check(s);
     return elf_gnu_hash(s);
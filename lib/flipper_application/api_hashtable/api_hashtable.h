@@ -28,6 +28,18 @@ bool elf_resolve_from_hashtable(
     uint32_t hash,
     Elf32_Addr* address);
 
+/**
+ * @brief Resolver for API entries using a pre-sorted table with hashes and bucket index
+ * @param interface pointer to HashtableIndexedApiInterface
+ * @param hash gnu hash of function name
+ * @param address output for function address
+ * @return true if the table contains a function
+ */
+bool elf_resolve_from_indexed_hashtable(
+    const ElfApiInterface* interface,
+    uint32_t hash,
+    Elf32_Addr* address);
+
 uint32_t elf_symbolname_hash(const char* s);
 
 #ifdef __cplusplus
@@ -45,6 +57,22 @@ struct HashtableApiInterface : public ElfApiInterface {
     const sym_entry *table_cbegin, *table_cend;
 };
 
+#define API_HASHTABLE_INDEX_BITS    (8U)
+#define API_HASHTABLE_INDEX_BUCKETS (1U << API_HASHTABLE_INDEX_BITS)
+
+/**
+ * @brief  HashtableIndexedApiInterface narrows down the search to a bucket
+ * of entries sharing the top API_HASHTABLE_INDEX_BITS bits of the hash.
+ * bucket_index is built at compile time with hashtable_bucket_index()
+ */
+struct HashtableIndexedApiInterface : public HashtableApiInterface {
+    const uint16_t* bucket_index;
+};
+
+constexpr uint32_t hashtable_bucket_of(uint32_t hash) {
+    return hash >> (32U - API_HASHTABLE_INDEX_BITS);
+}
+
 #define API_METHOD(x, ret_type, args_type)                                                     \
     sym_entry {                                                                                \
         .hash = elf_gnu_hash(#x), .address = (uint32_t)(static_cast<ret_type(*) args_type>(x)) \
@@ -86,4 +114,24 @@ constexpr bool has_hash_collisions(const std::array<sym_entry, N>& api_methods)
     return false;
 }
 
+/* Compile-time bucket index for sorted API table.
+ * Entry b holds position of the first symbol in bucket b or higher, the last one holds N.
+ */
+template <std::size_t N>
+constexpr std::array<uint16_t, API_HASHTABLE_INDEX_BUCKETS + 1>
+    hashtable_bucket_index(const std::array<sym_entry, N>& api_methods) {
+    static_assert(N <= UINT16_MAX, "API table is too big for bucket index");
+
+    std::array<uint16_t, API_HASHTABLE_INDEX_BUCKETS + 1> index{};
+    std::size_t position = 0;
+    for(std::size_t bucket = 0; bucket <= API_HASHTABLE_INDEX_BUCKETS; ++bucket) {
+        while(position < N && hashtable_bucket_of(api_methods[position].hash) < bucket) {
+            ++position;
+        }
+        index[bucket] = position;
+    }
+
+    return index;
+}
+
 #endif
\ No newline at end of file
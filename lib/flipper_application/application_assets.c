@@ -1,6 +1,8 @@
 #include "application_assets.h"
 #include <toolbox/path.h>
 #include <storage/storage_i.h>
+#include <flipper_format/flipper_format.h>
+#include <m-array.h>
 
 // #define ELF_ASSETS_DEBUG_LOG 1
 
@@ -15,6 +17,10 @@
 #define FLIPPER_APPLICATION_ASSETS_VERSION 1
 #define FLIPPER_APPLICATION_ASSETS_SIGNATURE_FILENAME ".assets.signature"
 
+// Apps with assets already in place, lives next to them so wiping assets drops it too
+#define FLIPPER_APPLICATION_ASSETS_CACHE_PATH           APPS_ASSETS_PATH "/.assets.cache"
+#define FLIPPER_APPLICATION_ASSETS_CACHE_SIGNATURE_SIZE (16U) // MD5, see fapassets.py
+
 #define BUFFER_SIZE 512
 
 #define TAG "FapAssets"
@@ -26,6 +32,21 @@ typedef struct FURI_PACKED {
     uint32_t files_count;
 } FlipperApplicationAssetsHeader;
 
+typedef struct {
+    FuriString* app_name;
+    uint8_t signature[FLIPPER_APPLICATION_ASSETS_CACHE_SIGNATURE_SIZE];
+} FlipperApplicationAssetsCacheEntry;
+
+ARRAY_DEF(FlipperApplicationAssetsCache, FlipperApplicationAssetsCacheEntry, M_POD_OPLIST);
+
+static const char* flipper_application_assets_cache_file_header = "Flipper app assets cache";
+static const uint32_t flipper_application_assets_cache_file_version = 1;
+
+// Loaded from SD once and kept for the whole uptime, assets may be loaded from any thread
+static FuriMutex* flipper_application_assets_cache_mutex = NULL;
+static bool flipper_application_assets_cache_loaded = false;
+static FlipperApplicationAssetsCache_t flipper_application_assets_cache;
+
 typedef enum {
     AssetsSignatureResultEqual,
     AssetsSignatureResultNotEqual,
@@ -192,6 +213,175 @@ static bool flipper_application_assets_process_dirs(
     return success;
 }
 
+static void flipper_application_assets_cache_lock(void) {
+    if(!flipper_application_assets_cache_mutex) {
+        FuriMutex* mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+        FuriMutex* expected = NULL;
+        if(!__atomic_compare_exchange_n(
+               &flipper_application_assets_cache_mutex,
+               &expected,
+               mutex,
+               false,
+               __ATOMIC_ACQ_REL,
+               __ATOMIC_ACQUIRE)) {
+            furi_mutex_free(mutex);
+        }
+    }
+
+    furi_check(
+        furi_mutex_acquire(flipper_application_assets_cache_mutex, FuriWaitForever) ==
+        FuriStatusOk);
+}
+
+static void flipper_application_assets_cache_unlock(void) {
+    furi_check(furi_mutex_release(flipper_application_assets_cache_mutex) == FuriStatusOk);
+}
+
+/* Called with cache locked */
+static void flipper_application_assets_cache_load(Storage* storage) {
+    if(flipper_application_assets_cache_loaded) return;
+    flipper_application_assets_cache_loaded = true;
+    FlipperApplicationAssetsCache_init(flipper_application_assets_cache);
+
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, FLIPPER_APPLICATION_ASSETS_CACHE_PATH))
+            break;
+
+        uint32_t version = 0;
+        if(!flipper_format_read_header(ff, temp_str, &version)) break;
+        if(furi_string_cmp_str(temp_str, flipper_application_assets_cache_file_header)) break;
+        if(version != flipper_application_assets_cache_file_version) break;
+
+        while(flipper_format_read_string(ff, "App", temp_str)) {
+            FlipperApplicationAssetsCacheEntry entry = {};
+            if(!flipper_format_read_hex(ff, "Signature", entry.signature, sizeof(entry.signature)))
+                break;
+
+            entry.app_name = furi_string_alloc_set(temp_str);
+            FlipperApplicationAssetsCache_push_back(flipper_application_assets_cache, entry);
+        }
+    } while(false);
+
+    furi_string_free(temp_str);
+    flipper_format_free(ff);
+
+    FURI_LOG_D(
+        TAG,
+        "Cache loaded, %zu apps",
+        FlipperApplicationAssetsCache_size(flipper_application_assets_cache));
+}
+
+/* Called with cache locked */
+static void flipper_application_assets_cache_save(Storage* storage) {
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    bool saved = false;
+
+    do {
+        if(!flipper_format_buffered_file_open_always(ff, FLIPPER_APPLICATION_ASSETS_CACHE_PATH))
+            break;
+        if(!flipper_format_write_header_cstr(
+               ff,
+               flipper_application_assets_cache_file_header,
+               flipper_application_assets_cache_file_version))
+            break;
+
+        bool entries_saved = true;
+        FlipperApplicationAssetsCache_it_t it;
+        for(FlipperApplicationAssetsCache_it(it, flipper_application_assets_cache);
+            entries_saved && !FlipperApplicationAssetsCache_end_p(it);
+            FlipperApplicationAssetsCache_next(it)) {
+            const FlipperApplicationAssetsCacheEntry* entry =
+                FlipperApplicationAssetsCache_cref(it);
+            entries_saved =
+                flipper_format_write_string(ff, "App", entry->app_name) &&
+                flipper_format_write_hex(
+                    ff, "Signature", entry->signature, sizeof(entry->signature));
+        }
+        saved = entries_saved;
+    } while(false);
+
+    flipper_format_free(ff);
+
+    // Broken cache would be trusted on the next start
+    if(!saved) {
+        FURI_LOG_E(TAG, "Failed to save cache");
+        storage_simply_remove(storage, FLIPPER_APPLICATION_ASSETS_CACHE_PATH);
+    }
+}
+
+/* Called with cache locked */
+static FlipperApplicationAssetsCacheEntry* flipper_application_assets_cache_find(
+    FuriString* app_name) {
+    FlipperApplicationAssetsCache_it_t it;
+    for(FlipperApplicationAssetsCache_it(it, flipper_application_assets_cache);
+        !FlipperApplicationAssetsCache_end_p(it);
+        FlipperApplicationAssetsCache_next(it)) {
+        FlipperApplicationAssetsCacheEntry* entry = FlipperApplicationAssetsCache_ref(it);
+        if(furi_string_equal(entry->app_name, app_name)) return entry;
+    }
+
+    return NULL;
+}
+
+/* True if assets with this signature were unpacked before */
+static bool flipper_application_assets_cache_check(
+    Storage* storage,
+    FuriString* app_name,
+    const uint8_t* signature,
+    size_t signature_size) {
+    if(signature_size != FLIPPER_APPLICATION_ASSETS_CACHE_SIGNATURE_SIZE) return false;
+
+    flipper_application_assets_cache_lock();
+    flipper_application_assets_cache_load(storage);
+    FlipperApplicationAssetsCacheEntry* entry = flipper_application_assets_cache_find(app_name);
+    const bool hit = entry && memcmp(entry->signature, signature, signature_size) == 0;
+    flipper_application_assets_cache_unlock();
+
+    return hit;
+}
+
+/* Record unpacked assets, or forget them if signature is NULL */
+static void flipper_application_assets_cache_update(
+    Storage* storage,
+    FuriString* app_name,
+    const uint8_t* signature,
+    size_t signature_size) {
+    if(signature && signature_size != FLIPPER_APPLICATION_ASSETS_CACHE_SIGNATURE_SIZE) {
+        signature = NULL;
+    }
+
+    flipper_application_assets_cache_lock();
+    flipper_application_assets_cache_load(storage);
+
+    FlipperApplicationAssetsCacheEntry* entry = flipper_application_assets_cache_find(app_name);
+    if(signature) {
+        if(entry) {
+            memcpy(entry->signature, signature, signature_size);
+        } else {
+            FlipperApplicationAssetsCacheEntry new_entry = {
+                .app_name = furi_string_alloc_set(app_name),
+            };
+            memcpy(new_entry.signature, signature, signature_size);
+            FlipperApplicationAssetsCache_push_back(flipper_application_assets_cache, new_entry);
+        }
+        flipper_application_assets_cache_save(storage);
+    } else if(entry) {
+        furi_string_free(entry->app_name);
+        FlipperApplicationAssetsCache_it_t it;
+        FlipperApplicationAssetsCache_it(it, flipper_application_assets_cache);
+        while(FlipperApplicationAssetsCache_ref(it) != entry) {
+            FlipperApplicationAssetsCache_next(it);
+        }
+        FlipperApplicationAssetsCache_remove(flipper_application_assets_cache, it);
+        flipper_application_assets_cache_save(storage);
+    }
+
+    flipper_application_assets_cache_unlock();
+}
+
 static AssetsSignatureResult flipper_application_assets_process_signature(
     Storage* storage,
     File* file,
@@ -219,6 +409,13 @@ static AssetsSignatureResult flipper_application_assets_process_signature(
             break;
         }
 
+        // Unpacked before: skip signature file, nothing on SD is touched
+        if(flipper_application_assets_cache_check(
+               storage, app_name, *signature_data, *signature_data_size)) {
+            result = AssetsSignatureResultEqual;
+            break;
+        }
+
         result = AssetsSignatureResultNotEqual;
 
         if(!storage_file_open(
@@ -239,9 +436,13 @@ static AssetsSignatureResult flipper_application_assets_process_signature(
             break;
         }
 
-        if(memcmp(*signature_data, signature_file_data, signature_size) == 0) {
+        if(signature_size == *signature_data_size &&
+           memcmp(*signature_data, signature_file_data, signature_size) == 0) {
             FURI_LOG_D(TAG, "Assets signature is equal");
             result = AssetsSignatureResultEqual;
+            // Unpacked by firmware without cache
+            flipper_application_assets_cache_update(
+                storage, app_name, *signature_data, *signature_data_size);
         }
 
         free(signature_file_data);
@@ -301,6 +502,9 @@ bool flipper_application_assets_load(File* file, const char* elf_path, size_t of
         } else {
             FURI_LOG_D(TAG, "Assets signature not equal, loading");
 
+            // Stale record must not outlive a half done unpack
+            flipper_application_assets_cache_update(storage, app_name, NULL, 0);
+
             // remove old assets
             FuriString* full_path = flipper_application_assets_alloc_app_full_path(app_name);
             storage_simply_remove_recursive(storage, furi_string_get_cstr(full_path));
@@ -345,6 +549,9 @@ bool flipper_application_assets_load(File* file, const char* elf_path, size_t of
         storage_file_free(signature_file);
         furi_string_free(signature_file_path);
 
+        flipper_application_assets_cache_update(
+            storage, app_name, signature_data, signature_data_size);
+
         result = true;
     } while(false);
 
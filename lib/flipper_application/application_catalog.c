@@ -0,0 +1,295 @@
+#include "application_catalog.h"
+#include "flipper_application.h"
+#include <loader/firmware_api/firmware_api.h>
+
+#include <m-dict.h>
+
+#define TAG "FapCatalog"
+
+#define FLIPPER_APPLICATION_CATALOG_PATH    EXT_PATH(".catalog")
+#define FLIPPER_APPLICATION_CATALOG_MAGIC   (0x54434146UL) // "FACT"
+#define FLIPPER_APPLICATION_CATALOG_VERSION (1U)
+
+// Records of applications not seen in a while are dropped above this count
+#define FLIPPER_APPLICATION_CATALOG_MAX_RECORDS (512U)
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    // Preload result depends on firmware API, catalog is rebuilt after update
+    uint16_t api_version_major;
+    uint16_t api_version_minor;
+} FlipperApplicationCatalogHeader;
+
+typedef struct {
+    uint32_t size;
+    uint32_t modified;
+    uint8_t has_icon;
+    char name[FAP_MANIFEST_MAX_APP_NAME_LENGTH];
+    uint8_t icon[FAP_MANIFEST_MAX_ICON_SIZE];
+} FlipperApplicationCatalogEntry;
+
+#pragma pack(pop)
+
+typedef struct {
+    FlipperApplicationCatalogEntry entry;
+    bool used;
+} FlipperApplicationCatalogRecord;
+
+DICT_DEF2(
+    FlipperApplicationCatalogDict,
+    FuriString*,
+    FURI_STRING_OPLIST,
+    FlipperApplicationCatalogRecord,
+    M_POD_OPLIST)
+
+struct FlipperApplicationCatalog {
+    Storage* storage;
+    FuriMutex* mutex;
+    FlipperApplicationCatalogDict_t records;
+    bool loaded;
+    bool changed;
+};
+
+FlipperApplicationCatalog* flipper_application_catalog_alloc(Storage* storage) {
+    furi_check(storage);
+
+    FlipperApplicationCatalog* catalog = malloc(sizeof(FlipperApplicationCatalog));
+    catalog->storage = storage;
+    catalog->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    FlipperApplicationCatalogDict_init(catalog->records);
+    catalog->loaded = false;
+    catalog->changed = false;
+
+    return catalog;
+}
+
+static bool
+    flipper_application_catalog_header_is_valid(const FlipperApplicationCatalogHeader* header) {
+    return header->magic == FLIPPER_APPLICATION_CATALOG_MAGIC &&
+           header->version == FLIPPER_APPLICATION_CATALOG_VERSION &&
+           header->api_version_major == firmware_api_interface->api_version_major &&
+           header->api_version_minor == firmware_api_interface->api_version_minor;
+}
+
+static void flipper_application_catalog_read(FlipperApplicationCatalog* catalog) {
+    File* file = storage_file_alloc(catalog->storage);
+    FuriString* path = furi_string_alloc();
+
+    do {
+        if(!storage_file_open(
+               file, FLIPPER_APPLICATION_CATALOG_PATH, FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        FlipperApplicationCatalogHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(!flipper_application_catalog_header_is_valid(&header)) {
+            FURI_LOG_I(TAG, "Outdated catalog");
+            break;
+        }
+
+        bool success = true;
+        for(size_t i = 0; success && i < header.count; i++) {
+            FlipperApplicationCatalogRecord record = {.used = false};
+            uint8_t path_length = 0;
+            char path_buffer[UINT8_MAX + 1];
+
+            success = storage_file_read(file, &record.entry, sizeof(record.entry)) ==
+                          sizeof(record.entry) &&
+                      storage_file_read(file, &path_length, sizeof(path_length)) ==
+                          sizeof(path_length) &&
+                      storage_file_read(file, path_buffer, path_length) == path_length;
+
+            if(success) {
+                path_buffer[path_length] = '\0';
+                record.entry.name[FAP_MANIFEST_MAX_APP_NAME_LENGTH - 1] = '\0';
+                furi_string_set(path, path_buffer);
+                FlipperApplicationCatalogDict_set_at(catalog->records, path, record);
+            }
+        }
+
+        // Truncated catalog is not trusted at all
+        if(!success) {
+            FURI_LOG_W(TAG, "Broken catalog");
+            FlipperApplicationCatalogDict_reset(catalog->records);
+        }
+    } while(false);
+
+    furi_string_free(path);
+    storage_file_free(file);
+}
+
+static bool flipper_application_catalog_write_record(
+    File* file,
+    const FuriString* path,
+    const FlipperApplicationCatalogRecord* record) {
+    const uint8_t path_length = furi_string_size(path);
+    return storage_file_write(file, &record->entry, sizeof(record->entry)) ==
+               sizeof(record->entry) &&
+           storage_file_write(file, &path_length, sizeof(path_length)) == sizeof(path_length) &&
+           storage_file_write(file, furi_string_get_cstr(path), path_length) == path_length;
+}
+
+static void flipper_application_catalog_write(FlipperApplicationCatalog* catalog) {
+    // Records used in this session go first, so they survive the limit
+    size_t used_count = 0;
+    FlipperApplicationCatalogDict_it_t it;
+    for(FlipperApplicationCatalogDict_it(it, catalog->records);
+        !FlipperApplicationCatalogDict_end_p(it);
+        FlipperApplicationCatalogDict_next(it)) {
+        if(FlipperApplicationCatalogDict_cref(it)->value.used) used_count++;
+    }
+
+    const size_t count =
+        MIN(FlipperApplicationCatalogDict_size(catalog->records),
+            FLIPPER_APPLICATION_CATALOG_MAX_RECORDS);
+    const size_t unused_count = count - MIN(used_count, count);
+
+    FlipperApplicationCatalogHeader header = {
+        .magic = FLIPPER_APPLICATION_CATALOG_MAGIC,
+        .version = FLIPPER_APPLICATION_CATALOG_VERSION,
+        .count = count,
+        .api_version_major = firmware_api_interface->api_version_major,
+        .api_version_minor = firmware_api_interface->api_version_minor,
+    };
+
+    File* file = storage_file_alloc(catalog->storage);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(
+               file, FLIPPER_APPLICATION_CATALOG_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        size_t written = 0;
+        size_t unused_written = 0;
+        success = true;
+        for(size_t pass = 0; success && pass < 2; pass++) {
+            for(FlipperApplicationCatalogDict_it(it, catalog->records);
+                success && written < count && !FlipperApplicationCatalogDict_end_p(it);
+                FlipperApplicationCatalogDict_next(it)) {
+                const FlipperApplicationCatalogDict_itref_t* item =
+                    FlipperApplicationCatalogDict_cref(it);
+                if(item->value.used != (pass == 0)) continue;
+                if(!item->value.used && unused_written == unused_count) continue;
+
+                success = flipper_application_catalog_write_record(file, item->key, &item->value);
+                written++;
+                if(!item->value.used) unused_written++;
+            }
+        }
+    } while(false);
+
+    storage_file_free(file);
+
+    // Catalog is read as a whole, partial one is removed
+    if(!success) {
+        FURI_LOG_W(TAG, "Failed to write catalog");
+        storage_common_remove(catalog->storage, FLIPPER_APPLICATION_CATALOG_PATH);
+    }
+}
+
+void flipper_application_catalog_free(FlipperApplicationCatalog* catalog) {
+    furi_check(catalog);
+
+    if(catalog->changed) {
+        flipper_application_catalog_write(catalog);
+    }
+
+    FlipperApplicationCatalogDict_clear(catalog->records);
+    furi_mutex_free(catalog->mutex);
+    free(catalog);
+}
+
+static bool flipper_application_catalog_preload(
+    FlipperApplicationCatalog* catalog,
+    FuriString* path,
+    FlipperApplicationCatalogEntry* entry) {
+    FlipperApplication* app = flipper_application_alloc(catalog->storage, firmware_api_interface);
+
+    FlipperApplicationPreloadStatus preload_res =
+        flipper_application_preload_manifest(app, furi_string_get_cstr(path));
+
+    bool load_success = false;
+
+    if(preload_res == FlipperApplicationPreloadStatusSuccess) {
+        const FlipperApplicationManifest* manifest = flipper_application_get_manifest(app);
+        entry->has_icon = manifest->has_icon;
+        memcpy(entry->icon, manifest->icon, FAP_MANIFEST_MAX_ICON_SIZE);
+        strlcpy(entry->name, manifest->name, FAP_MANIFEST_MAX_APP_NAME_LENGTH);
+        load_success = true;
+    } else {
+        FURI_LOG_E(TAG, "Failed to preload %s", furi_string_get_cstr(path));
+    }
+
+    flipper_application_free(app);
+    return load_success;
+}
+
+bool flipper_application_catalog_load_name_and_icon(
+    FlipperApplicationCatalog* catalog,
+    FuriString* path,
+    uint8_t** icon_ptr,
+    FuriString* item_name) {
+    furi_check(catalog);
+    furi_check(path);
+    furi_check(icon_ptr);
+    furi_check(item_name);
+
+    // Records keep path length in a byte, longer paths are loaded directly
+    if(furi_string_size(path) > UINT8_MAX) {
+        return flipper_application_load_name_and_icon(
+            path, catalog->storage, icon_ptr, item_name);
+    }
+
+    FileInfo fileinfo;
+    uint32_t modified;
+    if(storage_common_stat_modified(
+           catalog->storage, furi_string_get_cstr(path), &fileinfo, &modified) != FSE_OK) {
+        return false;
+    }
+
+    furi_check(furi_mutex_acquire(catalog->mutex, FuriWaitForever) == FuriStatusOk);
+
+    if(!catalog->loaded) {
+        flipper_application_catalog_read(catalog);
+        catalog->loaded = true;
+    }
+
+    FlipperApplicationCatalogRecord* record =
+        FlipperApplicationCatalogDict_get(catalog->records, path);
+
+    // FAP replaced on another device is caught here
+    if(record && (record->entry.size != fileinfo.size || record->entry.modified != modified)) {
+        FlipperApplicationCatalogDict_erase(catalog->records, path);
+        record = NULL;
+        catalog->changed = true;
+    }
+
+    if(!record) {
+        FlipperApplicationCatalogRecord new_record = {
+            .entry = {.size = fileinfo.size, .modified = modified},
+        };
+        if(flipper_application_catalog_preload(catalog, path, &new_record.entry)) {
+            FlipperApplicationCatalogDict_set_at(catalog->records, path, new_record);
+            record = FlipperApplicationCatalogDict_get(catalog->records, path);
+            catalog->changed = true;
+        }
+    }
+
+    if(record) {
+        if(record->entry.has_icon) {
+            memcpy(*icon_ptr, record->entry.icon, FAP_MANIFEST_MAX_ICON_SIZE);
+        }
+        furi_string_set(item_name, record->entry.name);
+        record->used = true;
+    }
+
+    furi_mutex_release(catalog->mutex);
+
+    return record != NULL;
+}
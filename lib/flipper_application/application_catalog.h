@@ -0,0 +1,57 @@
+/**
+ * @file application_catalog.h
+ * Flipper application catalog
+ *
+ * Persistent cache of application names and icons, so application lists
+ * do not have to parse every FAP manifest each time they are shown.
+ */
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FlipperApplicationCatalog FlipperApplicationCatalog;
+
+/**
+ * @brief Allocate catalog instance
+ *
+ * Catalog file is read on first lookup.
+ *
+ * @param storage Storage instance
+ * @return FlipperApplicationCatalog*
+ */
+FlipperApplicationCatalog* flipper_application_catalog_alloc(Storage* storage);
+
+/**
+ * @brief Free catalog instance, writing changes back to the catalog file
+ *
+ * @param catalog FlipperApplicationCatalog instance
+ */
+void flipper_application_catalog_free(FlipperApplicationCatalog* catalog);
+
+/**
+ * @brief Load name and icon from FAP file, using catalog when possible.
+ *
+ * Record is used only if file size and modification time match, otherwise
+ * manifest is preloaded and the record is updated.
+ * Thread safe.
+ *
+ * @param catalog FlipperApplicationCatalog instance
+ * @param path Path to FAP file.
+ * @param icon_ptr Icon pointer, not touched if application has no icon.
+ * @param item_name Application name.
+ * @return true if icon and name were loaded successfully.
+ */
+bool flipper_application_catalog_load_name_and_icon(
+    FlipperApplicationCatalog* catalog,
+    FuriString* path,
+    uint8_t** icon_ptr,
+    FuriString* item_name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -13,6 +13,7 @@
 #define IS_FLAGS_SET(v, m) (((v) & (m)) == (m))
 #define RESOLVER_THREAD_YIELD_STEP 30
 #define FAST_RELOCATION_VERSION 1
+#define SECTION_TABLE_CACHE_MAX 8192
 
 // #define ELF_DEBUG_LOG 1
 
@@ -59,7 +60,43 @@ static void address_cache_put(AddressCache_t cache, int symEntry, Elf32_Addr sym
 /********************************************** ELF ***********************************************/
 /**************************************************************************************************/
 
+static void elf_file_release_section_table(ELFFile* elf) {
+    free(elf->section_headers);
+    elf->section_headers = NULL;
+    free(elf->section_names);
+    elf->section_names = NULL;
+    elf->section_names_size = 0;
+}
+
+static void elf_file_cache_section_table(ELFFile* elf, const Elf32_Shdr* strings_header) {
+    const size_t headers_size = elf->sections_count * sizeof(Elf32_Shdr);
+    const size_t names_size = strings_header->sh_size;
+
+    elf_file_release_section_table(elf);
+
+    // Table is read again and again by preload, manifest and assets lookup, one read is enough
+    if(!headers_size || headers_size + names_size > SECTION_TABLE_CACHE_MAX) return;
+
+    Elf32_Shdr* headers = malloc(headers_size);
+    char* names = malloc(names_size + 1);
+
+    if(storage_file_seek(elf->fd, elf->section_table, true) &&
+       storage_file_read(elf->fd, headers, headers_size) == headers_size &&
+       storage_file_seek(elf->fd, elf->section_table_strings, true) &&
+       storage_file_read(elf->fd, names, names_size) == names_size) {
+        names[names_size] = '\0';
+        elf->section_headers = headers;
+        elf->section_names = names;
+        elf->section_names_size = names_size;
+    } else {
+        free(headers);
+        free(names);
+    }
+}
+
 static void elf_file_maybe_release_fd(ELFFile* elf) {
+    elf_file_release_section_table(elf);
+
     if(elf->fd) {
         storage_file_free(elf->fd);
         elf->fd = NULL;
@@ -119,6 +156,12 @@ static bool elf_read_string_from_offset(ELFFile* elf, off_t offset, FuriString*
 }
 
 static bool elf_read_section_name(ELFFile* elf, off_t offset, FuriString* name) {
+    if(elf->section_names) {
+        if((size_t)offset >= elf->section_names_size) return false;
+        furi_string_cat(name, &elf->section_names[offset]);
+        return true;
+    }
+
     return elf_read_string_from_offset(elf, elf->section_table_strings + offset, name);
 }
 
@@ -127,6 +170,12 @@ static bool elf_read_symbol_name(ELFFile* elf, off_t offset, FuriString* name) {
 }
 
 static bool elf_read_section_header(ELFFile* elf, size_t section_idx, Elf32_Shdr* section_header) {
+    if(elf->section_headers) {
+        if(section_idx >= elf->sections_count) return false;
+        *section_header = elf->section_headers[section_idx];
+        return true;
+    }
+
     off_t offset = SECTION_OFFSET(elf, section_idx);
     return storage_file_seek(elf->fd, offset, true) &&
            storage_file_read(elf->fd, section_header, sizeof(Elf32_Shdr)) == sizeof(Elf32_Shdr);
@@ -879,6 +928,7 @@ bool elf_file_open(ELFFile* elf, const char* path) {
     elf->sections_count = h.e_shnum;
     elf->section_table = h.e_shoff;
     elf->section_table_strings = sH.sh_offset;
+    elf_file_cache_section_table(elf, &sH);
     return true;
 }
 
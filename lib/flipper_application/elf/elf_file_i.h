@@ -43,6 +43,11 @@ struct ELFFile {
     AddressCache_t trampoline_cache;
 
     File* fd;
+    // Section headers and their names, kept in RAM until fd is released
+    Elf32_Shdr* section_headers;
+    char* section_names;
+    size_t section_names_size;
+
     const ElfApiInterface* api_interface;
     ELFDebugLinkInfo debug_link_info;
 
@@ -1,4 +1,5 @@
 #include <core/check.h>
+#include <core/common_defines.h>
 #include <toolbox/stream/stream.h>
 #include <toolbox/stream/string_stream.h>
 #include <toolbox/stream/file_stream.h>
@@ -9,9 +10,33 @@
 #include "flipper_format_stream_i.h"
 
 /********************************** Private **********************************/
+/* Key lines of an opened file can be indexed by key hash, so reads don't scan
+ * the file from the current position. Index is dropped and lookups fall back
+ * to file scan if the file has more keys than this. */
+#define FLIPPER_FORMAT_KEY_INDEX_COUNT_MAX        (512)
+#define FLIPPER_FORMAT_KEY_INDEX_CAPACITY_INITIAL (16)
+
+/* Hex arrays shorter than this stay in text form even with binary hex enabled,
+ * they are mostly read by humans (UID, ATQA...) and don't take up much space */
+#define FLIPPER_FORMAT_BINARY_HEX_SIZE_MIN (16)
+
+typedef struct {
+    uint32_t hash;
+    uint32_t offset; // Start of the key line
+} FlipperFormatKeyIndexEntry;
+
 struct FlipperFormat {
     Stream* stream;
     bool strict_mode;
+    bool binary_hex;
+
+    FlipperStreamArrayState array_state;
+
+    bool key_index_enabled;
+    // Sorted by offset, NULL if there is no valid index
+    FlipperFormatKeyIndexEntry* key_index;
+    size_t key_index_count;
+    size_t key_index_capacity;
 };
 
 static const char* const flipper_format_filetype_key = "Filetype";
@@ -21,12 +46,223 @@ Stream* flipper_format_get_raw_stream(FlipperFormat* flipper_format) {
     return flipper_format->stream;
 }
 
+static uint32_t flipper_format_key_hash(const char* key) {
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    for(; *key; key++) {
+        hash = (hash ^ (uint8_t)*key) * 16777619UL;
+    }
+    return hash;
+}
+
+static void flipper_format_key_index_free(FlipperFormat* flipper_format) {
+    free(flipper_format->key_index);
+    flipper_format->key_index = NULL;
+    flipper_format->key_index_count = 0;
+    flipper_format->key_index_capacity = 0;
+}
+
+static void flipper_format_key_index_append(
+    FlipperFormat* flipper_format,
+    const char* key,
+    size_t offset) {
+    if(flipper_format->key_index_count == flipper_format->key_index_capacity) {
+        if(flipper_format->key_index_capacity == FLIPPER_FORMAT_KEY_INDEX_COUNT_MAX) {
+            flipper_format_key_index_free(flipper_format);
+            return;
+        }
+
+        flipper_format->key_index_capacity = MIN(
+            MAX(flipper_format->key_index_capacity * 2,
+                (size_t)FLIPPER_FORMAT_KEY_INDEX_CAPACITY_INITIAL),
+            (size_t)FLIPPER_FORMAT_KEY_INDEX_COUNT_MAX);
+        flipper_format->key_index = realloc( //-V701
+            flipper_format->key_index,
+            flipper_format->key_index_capacity * sizeof(FlipperFormatKeyIndexEntry));
+    }
+
+    FlipperFormatKeyIndexEntry* entry =
+        &flipper_format->key_index[flipper_format->key_index_count++];
+    entry->hash = flipper_format_key_hash(key);
+    entry->offset = offset;
+}
+
+static void flipper_format_key_index_build(FlipperFormat* flipper_format) {
+    flipper_format_key_index_free(flipper_format);
+    if(!flipper_format->key_index_enabled) return;
+
+    Stream* stream = flipper_format->stream;
+    FuriString* key = furi_string_alloc();
+
+    // Empty index is still valid, allocate it explicitly
+    flipper_format->key_index_capacity = FLIPPER_FORMAT_KEY_INDEX_CAPACITY_INITIAL;
+    flipper_format->key_index =
+        malloc(flipper_format->key_index_capacity * sizeof(FlipperFormatKeyIndexEntry));
+
+    stream_rewind(stream);
+    while(flipper_format->key_index && flipper_format_stream_read_valid_key(stream, key)) {
+        flipper_format_key_index_append(
+            flipper_format,
+            furi_string_get_cstr(key),
+            stream_tell(stream) - furi_string_size(key));
+    }
+    if(!stream_rewind(stream)) flipper_format_key_index_free(flipper_format);
+
+    furi_string_free(key);
+}
+
+/* Returns position of the first entry with offset not less than given */
+static size_t flipper_format_key_index_lower_bound(FlipperFormat* flipper_format, size_t offset) {
+    size_t low = 0;
+    size_t high = flipper_format->key_index_count;
+
+    while(low < high) {
+        size_t mid = low + (high - low) / 2;
+        if(flipper_format->key_index[mid].offset < offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/* Moves stream to the first line after the current position which may hold the key.
+ * Hashes can collide, so the key itself is still matched by the following scan, and
+ * a colliding line only makes the scan start earlier. Without a candidate the stream
+ * is moved to the end, where the scan would also finish. */
+static void flipper_format_key_index_seek(FlipperFormat* flipper_format, const char* key) {
+    if(!flipper_format->key_index || flipper_format->strict_mode) return;
+
+    uint32_t hash = flipper_format_key_hash(key);
+    size_t pos = flipper_format_key_index_lower_bound(
+        flipper_format, stream_tell(flipper_format->stream));
+
+    for(; pos < flipper_format->key_index_count; pos++) {
+        if(flipper_format->key_index[pos].hash == hash) {
+            stream_seek(
+                flipper_format->stream,
+                flipper_format->key_index[pos].offset,
+                StreamOffsetFromStart);
+            return;
+        }
+    }
+
+    stream_seek(flipper_format->stream, 0, StreamOffsetFromEnd);
+}
+
+/* Finds the entry of the first line holding the key, stream position is preserved */
+static bool flipper_format_key_index_find(
+    FlipperFormat* flipper_format,
+    const char* key,
+    size_t* index) {
+    Stream* stream = flipper_format->stream;
+    size_t position = stream_tell(stream);
+    uint32_t hash = flipper_format_key_hash(key);
+    FuriString* read_key = furi_string_alloc();
+    bool found = false;
+
+    for(size_t i = 0; i < flipper_format->key_index_count; i++) {
+        if(flipper_format->key_index[i].hash != hash) continue;
+        if(!stream_seek(stream, flipper_format->key_index[i].offset, StreamOffsetFromStart)) {
+            break;
+        }
+        if(flipper_format_stream_read_valid_key(stream, read_key) &&
+           furi_string_cmp_str(read_key, key) == 0) {
+            *index = i;
+            found = true;
+            break;
+        }
+    }
+
+    furi_string_free(read_key);
+    stream_seek(stream, position, StreamOffsetFromStart);
+
+    return found;
+}
+
+static FlipperStreamValue flipper_format_hex_type(FlipperFormat* flipper_format, size_t size) {
+    return (flipper_format->binary_hex && size >= FLIPPER_FORMAT_BINARY_HEX_SIZE_MIN) ?
+               FlipperStreamValueBinary :
+               FlipperStreamValueHex;
+}
+
+static bool flipper_format_write_value_line(
+    FlipperFormat* flipper_format,
+    FlipperStreamWriteData* write_data) {
+    Stream* stream = flipper_format->stream;
+    size_t position = 0;
+    bool append = false;
+    if(flipper_format->key_index) {
+        position = stream_tell(stream);
+        append = position == stream_size(stream);
+    }
+
+    bool result = flipper_format_stream_write_value_line(stream, write_data);
+
+    if(flipper_format->key_index) {
+        if(result && append) {
+            flipper_format_key_index_append(flipper_format, write_data->key, position);
+        } else {
+            // Lines were overwritten
+            flipper_format_key_index_free(flipper_format);
+        }
+    }
+
+    return result;
+}
+
+static bool flipper_format_delete_key_and_write(
+    FlipperFormat* flipper_format,
+    FlipperStreamWriteData* write_data) {
+    Stream* stream = flipper_format->stream;
+    size_t index = 0;
+    size_t size = 0;
+    bool indexed = false;
+    if(flipper_format->key_index) {
+        // Look the line up before it is deleted
+        indexed = flipper_format_key_index_find(flipper_format, write_data->key, &index);
+        size = stream_size(stream);
+    }
+
+    bool result = flipper_format_stream_delete_key_and_write(
+        stream, write_data, flipper_format->strict_mode);
+
+    if(flipper_format->key_index) {
+        if(result && indexed) {
+            // Line stays at the same place, shift the lines after it
+            size_t new_size = stream_size(stream);
+            for(size_t i = index + 1; i < flipper_format->key_index_count; i++) {
+                flipper_format->key_index[i].offset += new_size - size;
+            }
+            if(write_data->type == FlipperStreamValueIgnore) {
+                flipper_format->key_index_count--;
+                memmove(
+                    &flipper_format->key_index[index],
+                    &flipper_format->key_index[index + 1],
+                    (flipper_format->key_index_count - index) *
+                        sizeof(FlipperFormatKeyIndexEntry));
+            }
+        } else if(result || indexed) {
+            // Index is out of sync with the file
+            flipper_format_key_index_free(flipper_format);
+        }
+    }
+
+    return result;
+}
+
 /********************************** Public **********************************/
 
 FlipperFormat* flipper_format_string_alloc(void) {
     FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
     flipper_format->stream = string_stream_alloc();
     flipper_format->strict_mode = false;
+    flipper_format->binary_hex = false;
+    flipper_format->array_state.last = true;
+    flipper_format->key_index_enabled = false;
+    flipper_format->key_index = NULL;
     return flipper_format;
 }
 
@@ -34,6 +270,10 @@ FlipperFormat* flipper_format_file_alloc(Storage* storage) {
     FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
     flipper_format->stream = file_stream_alloc(storage);
     flipper_format->strict_mode = false;
+    flipper_format->binary_hex = false;
+    flipper_format->array_state.last = true;
+    flipper_format->key_index_enabled = false;
+    flipper_format->key_index = NULL;
     return flipper_format;
 }
 
@@ -41,18 +281,40 @@ FlipperFormat* flipper_format_buffered_file_alloc(Storage* storage) {
     FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
     flipper_format->stream = buffered_file_stream_alloc(storage);
     flipper_format->strict_mode = false;
+    flipper_format->binary_hex = false;
+    flipper_format->array_state.last = true;
+    flipper_format->key_index_enabled = false;
+    flipper_format->key_index = NULL;
+    return flipper_format;
+}
+
+FlipperFormat* flipper_format_buffered_file_alloc_ex(Storage* storage, size_t cache_size) {
+    FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
+    flipper_format->stream = buffered_file_stream_alloc_ex(storage, cache_size);
+    flipper_format->strict_mode = false;
+    flipper_format->binary_hex = false;
+    flipper_format->array_state.last = true;
+    flipper_format->key_index_enabled = false;
+    flipper_format->key_index = NULL;
     return flipper_format;
 }
 
 bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
-    return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
+    bool result =
+        file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
+    flipper_format_key_index_free(flipper_format);
+    if(result) flipper_format_key_index_build(flipper_format);
+    return result;
 }
 
 bool flipper_format_buffered_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
-    return buffered_file_stream_open(
+    bool result = buffered_file_stream_open(
         flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
+    flipper_format_key_index_free(flipper_format);
+    if(result) flipper_format_key_index_build(flipper_format);
+    return result;
 }
 
 bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char* path) {
@@ -60,6 +322,7 @@ bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char*
 
     bool result =
         file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_APPEND);
+    flipper_format_key_index_free(flipper_format);
 
     // Add EOL if it is not there
     if(stream_size(flipper_format->stream) >= 1) {
@@ -88,32 +351,38 @@ bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char*
 
 bool flipper_format_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_key_index_free(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
 }
 
 bool flipper_format_buffered_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_key_index_free(flipper_format);
     return buffered_file_stream_open(
         flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
 }
 
 bool flipper_format_file_open_new(FlipperFormat* flipper_format, const char* path) {
     furi_check(flipper_format);
+    flipper_format_key_index_free(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_NEW);
 }
 
 bool flipper_format_file_close(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
+    flipper_format_key_index_free(flipper_format);
     return file_stream_close(flipper_format->stream);
 }
 
 bool flipper_format_buffered_file_close(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
+    flipper_format_key_index_free(flipper_format);
     return buffered_file_stream_close(flipper_format->stream);
 }
 
 void flipper_format_free(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
+    flipper_format_key_index_free(flipper_format);
     stream_free(flipper_format->stream);
     free(flipper_format);
 }
@@ -122,6 +391,17 @@ void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_m
     flipper_format->strict_mode = strict_mode;
 }
 
+void flipper_format_set_binary_hex(FlipperFormat* flipper_format, bool binary_hex) {
+    furi_check(flipper_format);
+    flipper_format->binary_hex = binary_hex;
+}
+
+void flipper_format_set_key_index(FlipperFormat* flipper_format, bool key_index) {
+    furi_check(flipper_format);
+    flipper_format->key_index_enabled = key_index;
+    if(!key_index) flipper_format_key_index_free(flipper_format);
+}
+
 bool flipper_format_rewind(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
     return stream_rewind(flipper_format->stream);
@@ -135,6 +415,7 @@ bool flipper_format_seek_to_end(FlipperFormat* flipper_format) {
 bool flipper_format_key_exist(FlipperFormat* flipper_format, const char* key) {
     size_t pos = stream_tell(flipper_format->stream);
     stream_seek(flipper_format->stream, 0, StreamOffsetFromStart);
+    flipper_format_key_index_seek(flipper_format, key);
     bool result = flipper_format_stream_seek_to_key(flipper_format->stream, key, false);
     stream_seek(flipper_format->stream, pos, StreamOffsetFromStart);
 
@@ -174,12 +455,14 @@ bool flipper_format_get_value_count(
     const char* key,
     uint32_t* count) {
     furi_check(flipper_format);
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_get_value_count(
         flipper_format->stream, key, count, flipper_format->strict_mode);
 }
 
 bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
     furi_check(flipper_format);
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream, key, FlipperStreamValueStr, data, 1, flipper_format->strict_mode);
 }
@@ -192,7 +475,7 @@ bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key,
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -207,7 +490,7 @@ bool flipper_format_write_string_cstr(
         .data = data,
         .data_size = 1,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -217,6 +500,7 @@ bool flipper_format_read_hex_uint64(
     uint64_t* data,
     const uint16_t data_size) {
     furi_check(flipper_format);
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -238,7 +522,7 @@ bool flipper_format_write_hex_uint64(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -248,6 +532,7 @@ bool flipper_format_read_uint32(
     uint32_t* data,
     const uint16_t data_size) {
     furi_check(flipper_format);
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -269,7 +554,7 @@ bool flipper_format_write_uint32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -278,6 +563,7 @@ bool flipper_format_read_int32(
     const char* key,
     int32_t* data,
     const uint16_t data_size) {
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -299,7 +585,7 @@ bool flipper_format_write_int32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -308,6 +594,7 @@ bool flipper_format_read_bool(
     const char* key,
     bool* data,
     const uint16_t data_size) {
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -329,7 +616,7 @@ bool flipper_format_write_bool(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -338,6 +625,7 @@ bool flipper_format_read_float(
     const char* key,
     float* data,
     const uint16_t data_size) {
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -359,7 +647,7 @@ bool flipper_format_write_float(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
@@ -368,6 +656,7 @@ bool flipper_format_read_hex(
     const char* key,
     uint8_t* data,
     const uint16_t data_size) {
+    flipper_format_key_index_seek(flipper_format, key);
     return flipper_format_stream_read_value_line(
         flipper_format->stream,
         key,
@@ -385,14 +674,69 @@ bool flipper_format_write_hex(
     furi_check(flipper_format);
     FlipperStreamWriteData write_data = {
         .key = key,
-        .type = FlipperStreamValueHex,
+        .type = flipper_format_hex_type(flipper_format, data_size),
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_write_value_line(flipper_format, &write_data);
     return result;
 }
 
+bool flipper_format_read_array_start(FlipperFormat* flipper_format, const char* key) {
+    furi_check(flipper_format);
+    flipper_format_key_index_seek(flipper_format, key);
+    return flipper_format_stream_read_array_start(
+        flipper_format->stream, key, flipper_format->strict_mode, &flipper_format->array_state);
+}
+
+bool flipper_format_read_array_uint32(
+    FlipperFormat* flipper_format,
+    uint32_t* data,
+    size_t size,
+    size_t* count) {
+    furi_check(flipper_format);
+    furi_check(count);
+    return flipper_format_stream_read_array(
+        flipper_format->stream,
+        FlipperStreamValueUint32,
+        data,
+        size,
+        count,
+        &flipper_format->array_state);
+}
+
+bool flipper_format_read_array_int32(
+    FlipperFormat* flipper_format,
+    int32_t* data,
+    size_t size,
+    size_t* count) {
+    furi_check(flipper_format);
+    furi_check(count);
+    return flipper_format_stream_read_array(
+        flipper_format->stream,
+        FlipperStreamValueInt32,
+        data,
+        size,
+        count,
+        &flipper_format->array_state);
+}
+
+bool flipper_format_read_array_hex(
+    FlipperFormat* flipper_format,
+    uint8_t* data,
+    size_t size,
+    size_t* count) {
+    furi_check(flipper_format);
+    furi_check(count);
+    return flipper_format_stream_read_array(
+        flipper_format->stream,
+        FlipperStreamValueHex,
+        data,
+        size,
+        count,
+        &flipper_format->array_state);
+}
+
 bool flipper_format_write_comment(FlipperFormat* flipper_format, FuriString* data) {
     furi_check(flipper_format);
     return flipper_format_write_comment_cstr(flipper_format, furi_string_get_cstr(data));
@@ -400,6 +744,11 @@ bool flipper_format_write_comment(FlipperFormat* flipper_format, FuriString* dat
 
 bool flipper_format_write_comment_cstr(FlipperFormat* flipper_format, const char* data) {
     furi_check(flipper_format);
+    if(flipper_format->key_index &&
+       stream_tell(flipper_format->stream) != stream_size(flipper_format->stream)) {
+        // Lines are going to be overwritten
+        flipper_format_key_index_free(flipper_format);
+    }
     return flipper_format_stream_write_comment_cstr(flipper_format->stream, data);
 }
 
@@ -411,8 +760,7 @@ bool flipper_format_delete_key(FlipperFormat* flipper_format, const char* key) {
         .data = NULL,
         .data_size = 0,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -424,8 +772,7 @@ bool flipper_format_update_string(FlipperFormat* flipper_format, const char* key
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -440,8 +787,7 @@ bool flipper_format_update_string_cstr(
         .data = data,
         .data_size = 1,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -457,8 +803,7 @@ bool flipper_format_update_uint32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -473,8 +818,7 @@ bool flipper_format_update_int32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -489,8 +833,7 @@ bool flipper_format_update_bool(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -505,8 +848,7 @@ bool flipper_format_update_float(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -517,12 +859,11 @@ bool flipper_format_update_hex(
     const uint16_t data_size) {
     FlipperStreamWriteData write_data = {
         .key = key,
-        .type = FlipperStreamValueHex,
+        .type = flipper_format_hex_type(flipper_format, data_size),
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_delete_key_and_write(flipper_format, &write_data);
     return result;
 }
 
@@ -116,6 +116,18 @@ FlipperFormat* flipper_format_file_alloc(Storage* storage);
  */
 FlipperFormat* flipper_format_buffered_file_alloc(Storage* storage);
 
+/** Allocate FlipperFormat as file, buffered mode with a custom cache size.
+ *
+ * Cache grows up to the given size while the file is read sequentially, use
+ * it for large files which are read through.
+ *
+ * @param      storage     The storage
+ * @param      cache_size  Maximum cache size in bytes
+ *
+ * @return     FlipperFormat* pointer to a FlipperFormat instance
+ */
+FlipperFormat* flipper_format_buffered_file_alloc_ex(Storage* storage, size_t cache_size);
+
 /** Open existing file. Use only if FlipperFormat allocated as a file.
  *
  * @param      flipper_format  Pointer to a FlipperFormat instance
@@ -208,6 +220,36 @@ void flipper_format_free(FlipperFormat* flipper_format);
  */
 void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_mode);
 
+/** Set FlipperFormat hex arrays encoding.
+ *
+ * With binary hex enabled, flipper_format_write_hex() and
+ * flipper_format_update_hex() store arrays of 16 bytes and more as base64
+ * with a "Bin:" prefix, which takes less than half the space of hex text and
+ * is decoded a group of 4 characters at a time. flipper_format_read_hex() and
+ * flipper_format_get_value_count() accept both forms regardless of this
+ * setting. Older firmware and external tools can't read such values.
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ * @param      binary_hex      True to write long hex arrays as binary. False
+ *                             by default.
+ */
+void flipper_format_set_binary_hex(FlipperFormat* flipper_format, bool binary_hex);
+
+/** Set FlipperFormat key index mode.
+ *
+ * With key index enabled, opening an existing file with
+ * flipper_format_file_open_existing() or
+ * flipper_format_buffered_file_open_existing() reads it once and remembers
+ * where every key is, so reading keys in any order doesn't rescan the file.
+ * Index is kept in sync by appends, updates and deletes. It is not used in
+ * strict mode, and it is dropped if the file has too many keys or is
+ * overwritten in the middle, lookups fall back to file scan then.
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ * @param      key_index       True to index keys on open. False by default.
+ */
+void flipper_format_set_key_index(FlipperFormat* flipper_format, bool key_index);
+
 /** Rewind the RW pointer.
  *
  * @param      flipper_format  Pointer to a FlipperFormat instance
@@ -500,6 +542,66 @@ bool flipper_format_write_hex(
     const uint8_t* data,
     const uint16_t data_size);
 
+/** Start reading array values by key one chunk at a time
+ *
+ * Values are then read with flipper_format_read_array_uint32(),
+ * flipper_format_read_array_int32() or flipper_format_read_array_hex() into
+ * a buffer of any size, so long arrays neither need
+ * flipper_format_get_value_count() nor a buffer for the whole array. Don't
+ * mix chunk reads with other reads and writes until the array is read.
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ * @param      key             Key
+ *
+ * @return     True if the key is found
+ */
+bool flipper_format_read_array_start(FlipperFormat* flipper_format, const char* key);
+
+/** Read next chunk of uint32 array values
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ * @param      data            Buffer for values
+ * @param      size            Buffer capacity in values
+ * @param      count           Values read, 0 if there are no values left
+ *
+ * @return     True on success, false on parse error
+ */
+bool flipper_format_read_array_uint32(
+    FlipperFormat* flipper_format,
+    uint32_t* data,
+    size_t size,
+    size_t* count);
+
+/** Read next chunk of int32 array values
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ * @param      data            Buffer for values
+ * @param      size            Buffer capacity in values
+ * @param      count           Values read, 0 if there are no values left
+ *
+ * @return     True on success, false on parse error
+ */
+bool flipper_format_read_array_int32(
+    FlipperFormat* flipper_format,
+    int32_t* data,
+    size_t size,
+    size_t* count);
+
+/** Read next chunk of hex-formatted array bytes, binary form is accepted too
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ * @param      data            Buffer for bytes
+ * @param      size            Buffer capacity in bytes
+ * @param      count           Bytes read, 0 if there are no bytes left
+ *
+ * @return     True on success, false on parse error
+ */
+bool flipper_format_read_array_hex(
+    FlipperFormat* flipper_format,
+    uint8_t* data,
+    size_t size,
+    size_t* count);
+
 /** Write comment
  *
  * @param      flipper_format  Pointer to a FlipperFormat instance
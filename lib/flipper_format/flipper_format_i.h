@@ -9,6 +9,7 @@ extern "C" {
 /**
  * Returns the underlying stream instance.
  * Use only if you know what you are doing.
+ * Writing to the stream directly leaves the key index out of sync, see flipper_format_set_key_index().
  * @param flipper_format 
  * @return Stream* 
  */
@@ -2,9 +2,79 @@
 #include <toolbox/hex.h>
 #include <toolbox/strint.h>
 #include <core/check.h>
+#include <core/common_defines.h>
 #include "flipper_format_stream.h"
 #include "flipper_format_stream_i.h"
 
+#define FLIPPER_FORMAT_BINARY_CHUNK_SIZE (48)
+/** Array values are formatted into one buffer and written to the stream in chunks of this size */
+#define FLIPPER_FORMAT_WRITE_CHUNK_SIZE (64)
+
+static const char flipper_format_binary_prefix[] = "Bin:";
+#define FLIPPER_FORMAT_BINARY_PREFIX_SIZE (sizeof(flipper_format_binary_prefix) - 1)
+
+static const char flipper_format_base64_alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char flipper_format_base64_pad = '=';
+
+// Base64 character values, 0xFF for characters out of the alphabet
+static const uint8_t flipper_format_base64_values[128] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12,
+    0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24,
+    0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30,
+    0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+static inline uint8_t flipper_format_base64_value(uint8_t c) {
+    return (c < COUNT_OF(flipper_format_base64_values)) ? flipper_format_base64_values[c] : 0xFF;
+}
+
+/* Encodes up to 3 bytes into a group of 4 characters */
+static void flipper_format_base64_encode_group(const uint8_t* data, size_t size, char* group) {
+    uint32_t word = (uint32_t)data[0] << 16;
+    if(size > 1) word |= (uint32_t)data[1] << 8;
+    if(size > 2) word |= data[2];
+
+    group[0] = flipper_format_base64_alphabet[(word >> 18) & 0x3F];
+    group[1] = flipper_format_base64_alphabet[(word >> 12) & 0x3F];
+    group[2] = (size > 1) ? flipper_format_base64_alphabet[(word >> 6) & 0x3F] :
+                            flipper_format_base64_pad;
+    group[3] = (size > 2) ? flipper_format_base64_alphabet[word & 0x3F] :
+                            flipper_format_base64_pad;
+}
+
+/* Decodes a group of 4 characters, returns the number of bytes or 0 if the group is invalid */
+static size_t flipper_format_base64_decode_group(const uint8_t* group, uint8_t* data) {
+    size_t size = 3;
+    if(group[3] == flipper_format_base64_pad) {
+        size = (group[2] == flipper_format_base64_pad) ? 1 : 2;
+    }
+
+    // Whole group is combined into a word, invalid characters set the high bits
+    uint8_t values[4] = {
+        flipper_format_base64_value(group[0]),
+        flipper_format_base64_value(group[1]),
+        (size > 1) ? flipper_format_base64_value(group[2]) : 0,
+        (size > 2) ? flipper_format_base64_value(group[3]) : 0,
+    };
+    if((values[0] | values[1] | values[2] | values[3]) & 0xC0) return 0;
+
+    uint32_t word = (uint32_t)values[0] << 18 | (uint32_t)values[1] << 12 |
+                    (uint32_t)values[2] << 6 | values[3];
+    data[0] = word >> 16;
+    if(size > 1) data[1] = word >> 8;
+    if(size > 2) data[2] = word;
+
+    return size;
+}
+
 static inline bool flipper_format_stream_is_space(char c) {
     return c == ' ' || c == '\t' || c == flipper_format_eolr;
 }
@@ -31,7 +101,7 @@ bool flipper_format_stream_write_eol(Stream* stream) {
     return flipper_format_stream_write(stream, &flipper_format_eoln, 1);
 }
 
-static bool flipper_format_stream_read_valid_key(Stream* stream, FuriString* key) {
+bool flipper_format_stream_read_valid_key(Stream* stream, FuriString* key) {
     furi_string_reset(key);
     const size_t buffer_size = 32;
     uint8_t buffer[buffer_size];
@@ -266,6 +336,90 @@ static bool flipper_format_stream_seek_to_next_line(Stream* stream) {
     return result;
 }
 
+static bool flipper_format_stream_write_binary(Stream* stream, const uint8_t* data, size_t size) {
+    if(!flipper_format_stream_write(
+           stream, flipper_format_binary_prefix, FLIPPER_FORMAT_BINARY_PREFIX_SIZE)) {
+        return false;
+    }
+
+    char buffer[FLIPPER_FORMAT_BINARY_CHUNK_SIZE / 3 * 4];
+    for(size_t pos = 0; pos < size; pos += FLIPPER_FORMAT_BINARY_CHUNK_SIZE) {
+        size_t chunk_size = MIN(size - pos, (size_t)FLIPPER_FORMAT_BINARY_CHUNK_SIZE);
+        size_t buffer_size = 0;
+        for(size_t i = 0; i < chunk_size; i += 3) {
+            flipper_format_base64_encode_group(
+                &data[pos + i], MIN(chunk_size - i, (size_t)3), &buffer[buffer_size]);
+            buffer_size += 4;
+        }
+        if(!flipper_format_stream_write(stream, buffer, buffer_size)) return false;
+    }
+
+    return true;
+}
+
+/* Moves past the binary value prefix if it is there, otherwise the position is kept */
+static bool flipper_format_stream_seek_binary_prefix(Stream* stream) {
+    char prefix[FLIPPER_FORMAT_BINARY_PREFIX_SIZE];
+    size_t was_read = stream_read(stream, (uint8_t*)prefix, sizeof(prefix));
+    if(was_read == sizeof(prefix) && memcmp(prefix, flipper_format_binary_prefix, was_read) == 0) {
+        return true;
+    }
+
+    stream_seek(stream, -(int32_t)was_read, StreamOffsetFromCurrent);
+    return false;
+}
+
+static bool flipper_format_stream_read_binary(Stream* stream, uint8_t* data, size_t size) {
+    uint8_t buffer[FLIPPER_FORMAT_BINARY_CHUNK_SIZE / 3 * 4];
+    size_t pos = 0;
+
+    while(pos < size) {
+        // Read only the groups holding the requested data
+        size_t buffer_size = MIN((size - pos + 2) / 3 * 4, sizeof(buffer));
+        if(stream_read(stream, buffer, buffer_size) != buffer_size) return false;
+
+        for(size_t i = 0; i < buffer_size; i += 4) {
+            uint8_t group_data[3];
+            size_t group_size = flipper_format_base64_decode_group(&buffer[i], group_data);
+            // Padded group can only be the last one
+            if(group_size == 0 || (group_size < 3 && pos + group_size < size)) return false;
+
+            group_size = MIN(group_size, size - pos);
+            memcpy(&data[pos], group_data, group_size);
+            pos += group_size;
+        }
+    }
+
+    return true;
+}
+
+static bool flipper_format_stream_get_binary_size(Stream* stream, uint32_t* size) {
+    const size_t buffer_size = 32;
+    uint8_t buffer[buffer_size];
+    size_t length = 0;
+    size_t padding = 0;
+    bool end = false;
+
+    while(!end) {
+        size_t was_read = stream_read(stream, buffer, buffer_size);
+        if(was_read == 0) break;
+
+        for(size_t i = 0; i < was_read; i++) {
+            if(buffer[i] == flipper_format_eoln || flipper_format_stream_is_space(buffer[i])) {
+                end = true;
+                break;
+            }
+            if(buffer[i] == flipper_format_base64_pad) padding++;
+            length++;
+        }
+    }
+
+    if(length == 0 || length % 4 != 0 || padding > 2) return false;
+
+    *size = length / 4 * 3 - padding;
+    return true;
+}
+
 bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteData* write_data) {
     bool result = false;
 
@@ -278,6 +432,15 @@ bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteDa
         do {
             if(!flipper_format_stream_write_key(stream, write_data->key)) break;
 
+            if(write_data->type == FlipperStreamValueBinary) {
+                if(flipper_format_stream_write_binary(
+                       stream, write_data->data, write_data->data_size) &&
+                   flipper_format_stream_write_eol(stream)) {
+                    result = true;
+                }
+                break;
+            }
+
             if(write_data->type == FlipperStreamValueStr) write_data->data_size = 1;
 
             bool cycle_error = false;
@@ -285,47 +448,51 @@ bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteDa
                 switch(write_data->type) {
                 case FlipperStreamValueStr: {
                     const char* data = write_data->data;
-                    furi_string_printf(value, "%s", data);
+                    furi_string_cat_str(value, data);
                 }; break;
                 case FlipperStreamValueHex: {
                     const uint8_t* data = write_data->data;
-                    furi_string_printf(value, "%02X", data[i]);
+                    furi_string_cat_hex(value, &data[i], 1, '\0');
                 }; break;
 #ifndef FLIPPER_STREAM_LITE
                 case FlipperStreamValueFloat: {
                     const float* data = write_data->data;
-                    furi_string_printf(value, "%f", (double)data[i]);
+                    furi_string_cat_printf(value, "%f", (double)data[i]);
                 }; break;
 #endif
                 case FlipperStreamValueInt32: {
                     const int32_t* data = write_data->data;
-                    furi_string_printf(value, "%" PRIi32, data[i]);
+                    furi_string_cat_int32(value, data[i]);
                 }; break;
                 case FlipperStreamValueUint32: {
                     const uint32_t* data = write_data->data;
-                    furi_string_printf(value, "%" PRIu32, data[i]);
+                    furi_string_cat_uint32(value, data[i]);
                 }; break;
                 case FlipperStreamValueHexUint64: {
                     const uint64_t* data = write_data->data;
-                    furi_string_printf(
+                    furi_string_cat_printf(
                         value, "%08lX%08lX", (uint32_t)(data[i] >> 32), (uint32_t)data[i]);
                 }; break;
                 case FlipperStreamValueBool: {
                     const bool* data = write_data->data;
-                    furi_string_printf(value, data[i] ? "true" : "false");
+                    furi_string_cat_str(value, data[i] ? "true" : "false");
                 }; break;
                 default:
                     furi_crash("Unknown FF type");
                 }
 
-                if(((size_t)i + 1) < write_data->data_size) {
-                    furi_string_cat(value, " ");
+                const bool last = ((size_t)i + 1) >= write_data->data_size;
+                if(!last) {
+                    furi_string_push_back(value, ' ');
                 }
 
-                if(!flipper_format_stream_write(
-                       stream, furi_string_get_cstr(value), furi_string_size(value))) {
-                    cycle_error = true;
-                    break;
+                if(last || furi_string_size(value) >= FLIPPER_FORMAT_WRITE_CHUNK_SIZE) {
+                    if(!flipper_format_stream_write(
+                           stream, furi_string_get_cstr(value), furi_string_size(value))) {
+                        cycle_error = true;
+                        break;
+                    }
+                    furi_string_reset(value);
                 }
             }
             if(cycle_error) break;
@@ -340,6 +507,61 @@ bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteDa
     return result;
 }
 
+static bool flipper_format_stream_parse_value(
+    FlipperStreamValue type,
+    FuriString* value,
+    void* _data,
+    size_t index) {
+    bool result = false;
+
+    switch(type) {
+    case FlipperStreamValueHex: {
+        uint8_t* data = _data;
+        if(furi_string_size(value) >= 2) {
+            // sscanf "%02X" does not work here
+            result = hex_char_to_uint8(
+                furi_string_get_char(value, 0), furi_string_get_char(value, 1), &data[index]);
+        }
+    }; break;
+#ifndef FLIPPER_STREAM_LITE
+    case FlipperStreamValueFloat: {
+        float* data = _data;
+        // newlib-nano does not have sscanf for floats
+        // scan_values = sscanf(furi_string_get_cstr(value), "%f", &data[i]);
+        char* end_char;
+        data[index] = strtof(furi_string_get_cstr(value), &end_char);
+        // most likely ok
+        result = (*end_char == 0);
+    }; break;
+#endif
+    case FlipperStreamValueInt32: {
+        int32_t* data = _data;
+        result = strint_to_int32(furi_string_get_cstr(value), NULL, &data[index], 10) ==
+                 StrintParseNoError;
+    }; break;
+    case FlipperStreamValueUint32: {
+        uint32_t* data = _data;
+        result = strint_to_uint32(furi_string_get_cstr(value), NULL, &data[index], 10) ==
+                 StrintParseNoError;
+    }; break;
+    case FlipperStreamValueHexUint64: {
+        uint64_t* data = _data;
+        if(furi_string_size(value) >= 16) {
+            result = hex_chars_to_uint64(furi_string_get_cstr(value), &data[index]);
+        }
+    }; break;
+    case FlipperStreamValueBool: {
+        bool* data = _data;
+        data[index] = !furi_string_cmpi(value, "true");
+        result = true;
+    }; break;
+    default:
+        furi_crash("Unknown FF type");
+    }
+
+    return result;
+}
+
 bool flipper_format_stream_read_value_line(
     Stream* stream,
     const char* key,
@@ -358,81 +580,23 @@ bool flipper_format_stream_read_value_line(
                 result = true;
                 break;
             }
+        } else if(
+            (type == FlipperStreamValueHex || type == FlipperStreamValueBinary) &&
+            flipper_format_stream_seek_binary_prefix(stream)) {
+            result = flipper_format_stream_read_binary(stream, _data, data_size);
         } else {
+            // Binary values are read as hex arrays in text form
+            if(type == FlipperStreamValueBinary) type = FlipperStreamValueHex;
+
             result = true;
             FuriString* value;
             value = furi_string_alloc();
 
             for(size_t i = 0; i < data_size; i++) {
                 bool last = false;
-                result = flipper_format_stream_read_value(stream, value, &last);
-                if(result) {
-                    int scan_values = 0;
-
-                    switch(type) {
-                    case FlipperStreamValueHex: {
-                        uint8_t* data = _data;
-                        if(furi_string_size(value) >= 2) {
-                            // sscanf "%02X" does not work here
-                            if(hex_char_to_uint8(
-                                   furi_string_get_char(value, 0),
-                                   furi_string_get_char(value, 1),
-                                   &data[i])) {
-                                scan_values = 1;
-                            }
-                        }
-                    }; break;
-#ifndef FLIPPER_STREAM_LITE
-                    case FlipperStreamValueFloat: {
-                        float* data = _data;
-                        // newlib-nano does not have sscanf for floats
-                        // scan_values = sscanf(furi_string_get_cstr(value), "%f", &data[i]);
-                        char* end_char;
-                        data[i] = strtof(furi_string_get_cstr(value), &end_char);
-                        if(*end_char == 0) {
-                            // most likely ok
-                            scan_values = 1;
-                        }
-                    }; break;
-#endif
-                    case FlipperStreamValueInt32: {
-                        int32_t* data = _data;
-                        if(strint_to_int32(furi_string_get_cstr(value), NULL, &data[i], 10) ==
-                           StrintParseNoError) {
-                            scan_values = 1;
-                        }
-                    }; break;
-                    case FlipperStreamValueUint32: {
-                        uint32_t* data = _data;
-                        if(strint_to_uint32(furi_string_get_cstr(value), NULL, &data[i], 10) ==
-                           StrintParseNoError) {
-                            scan_values = 1;
-                        }
-                    }; break;
-                    case FlipperStreamValueHexUint64: {
-                        uint64_t* data = _data;
-                        if(furi_string_size(value) >= 16) {
-                            if(hex_chars_to_uint64(furi_string_get_cstr(value), &data[i])) {
-                                scan_values = 1;
-                            }
-                        }
-                    }; break;
-                    case FlipperStreamValueBool: {
-                        bool* data = _data;
-                        data[i] = !furi_string_cmpi(value, "true");
-                        scan_values = 1;
-                    }; break;
-                    default:
-                        furi_crash("Unknown FF type");
-                    }
-
-                    if(scan_values != 1) {
-                        result = false;
-                        break;
-                    }
-                } else {
-                    break;
-                }
+                result = flipper_format_stream_read_value(stream, value, &last) &&
+                         flipper_format_stream_parse_value(type, value, _data, i);
+                if(!result) break;
 
                 if(last && ((i + 1) != data_size)) {
                     result = false;
@@ -447,6 +611,111 @@ bool flipper_format_stream_read_value_line(
     return result;
 }
 
+bool flipper_format_stream_read_array_start(
+    Stream* stream,
+    const char* key,
+    bool strict_mode,
+    FlipperStreamArrayState* state) {
+    memset(state, 0, sizeof(FlipperStreamArrayState));
+    if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) {
+        state->last = true;
+        return false;
+    }
+
+    state->binary = flipper_format_stream_seek_binary_prefix(stream);
+    return true;
+}
+
+static bool flipper_format_stream_read_array_binary(
+    Stream* stream,
+    uint8_t* data,
+    size_t size,
+    size_t* count,
+    FlipperStreamArrayState* state) {
+    uint8_t buffer[FLIPPER_FORMAT_BINARY_CHUNK_SIZE / 3 * 4];
+
+    // Bytes left from the last group of the previous chunk go first
+    size_t carry_size = MIN(size, (size_t)state->carry_size);
+    memcpy(data, state->carry, carry_size);
+    memmove(state->carry, &state->carry[carry_size], state->carry_size - carry_size);
+    state->carry_size -= carry_size;
+    *count = carry_size;
+
+    while(*count < size && !state->last) {
+        size_t buffer_size = MIN((size - *count + 2) / 3 * 4, sizeof(buffer));
+        size_t was_read = stream_read(stream, buffer, buffer_size);
+
+        for(size_t i = 0; i < was_read; i += 4) {
+            if(buffer[i] == flipper_format_eoln || flipper_format_stream_is_space(buffer[i])) {
+                // Value ends here, leave the rest of the line
+                if(!stream_seek(stream, (int32_t)i - (int32_t)was_read, StreamOffsetFromCurrent))
+                    return false;
+                state->last = true;
+                break;
+            }
+
+            uint8_t group_data[3];
+            size_t group_size = (was_read - i < 4) ?
+                                    0 :
+                                    flipper_format_base64_decode_group(&buffer[i], group_data);
+            if(group_size == 0) return false;
+
+            size_t copy_size = MIN(group_size, size - *count);
+            memcpy(&data[*count], group_data, copy_size);
+            *count += copy_size;
+            if(copy_size < group_size) {
+                state->carry_size = group_size - copy_size;
+                memcpy(state->carry, &group_data[copy_size], state->carry_size);
+            }
+
+            // Padded group is the last one
+            if(group_size < 3) {
+                if(!stream_seek(
+                       stream, (int32_t)(i + 4) - (int32_t)was_read, StreamOffsetFromCurrent))
+                    return false;
+                state->last = true;
+                break;
+            }
+        }
+
+        if(was_read < buffer_size) state->last = true;
+    }
+
+    return true;
+}
+
+bool flipper_format_stream_read_array(
+    Stream* stream,
+    FlipperStreamValue type,
+    void* data,
+    size_t size,
+    size_t* count,
+    FlipperStreamArrayState* state) {
+    if(state->binary && (type == FlipperStreamValueHex || type == FlipperStreamValueBinary)) {
+        return flipper_format_stream_read_array_binary(stream, data, size, count, state);
+    }
+    if(state->binary) return false;
+    if(type == FlipperStreamValueBinary) type = FlipperStreamValueHex;
+
+    bool result = true;
+    FuriString* value = furi_string_alloc();
+
+    *count = 0;
+    while(*count < size && !state->last) {
+        bool last = false;
+        if(!flipper_format_stream_read_value(stream, value, &last) ||
+           !flipper_format_stream_parse_value(type, value, data, *count)) {
+            result = false;
+            break;
+        }
+        *count += 1;
+        state->last = last;
+    }
+
+    furi_string_free(value);
+    return result;
+}
+
 bool flipper_format_stream_get_value_count(
     Stream* stream,
     const char* key,
@@ -463,6 +732,11 @@ bool flipper_format_stream_get_value_count(
         if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
         *count = 0;
 
+        if(flipper_format_stream_seek_binary_prefix(stream)) {
+            result = flipper_format_stream_get_binary_size(stream, count);
+            break;
+        }
+
         result = true;
         while(true) {
             if(!flipper_format_stream_read_value(stream, value, &last)) {
@@ -16,6 +16,7 @@ typedef enum {
     FlipperStreamValueUint32,
     FlipperStreamValueHexUint64,
     FlipperStreamValueBool,
+    FlipperStreamValueBinary, /**< Base64 byte array with "Bin:" prefix, also read as Hex */
 } FlipperStreamValue;
 
 typedef struct {
@@ -29,6 +29,59 @@ bool flipper_format_stream_write_eol(Stream* stream);
  */
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode);
 
+/**
+ * Read the next valid key from the current position of the stream.
+ * Position will be at the delimiter following the key, if the key is found, or at the end of the stream.
+ * Since the key is read from the beginning of its line, the line starts at the position minus the key length.
+ * @param stream 
+ * @param key 
+ * @return true key is found
+ * @return false key is not found
+ */
+bool flipper_format_stream_read_valid_key(Stream* stream, FuriString* key);
+
+/** State of an array which is read one chunk at a time */
+typedef struct {
+    bool last; /**< No values left */
+    bool binary; /**< Value is in binary form */
+    uint8_t carry[2]; /**< Decoded binary bytes which didn't fit in the previous chunk */
+    uint8_t carry_size;
+} FlipperStreamArrayState;
+
+/**
+ * Seek to the key from the current position of the stream and start reading its values in chunks.
+ * @param stream 
+ * @param key 
+ * @param strict_mode 
+ * @param state 
+ * @return true key is found
+ * @return false key is not found
+ */
+bool flipper_format_stream_read_array_start(
+    Stream* stream,
+    const char* key,
+    bool strict_mode,
+    FlipperStreamArrayState* state);
+
+/**
+ * Read the next chunk of values of the key the array was started at.
+ * @param stream 
+ * @param type 
+ * @param data 
+ * @param size capacity of data in values
+ * @param count number of values read, 0 if there are no values left
+ * @param state 
+ * @return true 
+ * @return false parse error
+ */
+bool flipper_format_stream_read_array(
+    Stream* stream,
+    FlipperStreamValue type,
+    void* data,
+    size_t size,
+    size_t* count,
+    FlipperStreamArrayState* state);
+
 #ifdef __cplusplus
 }
 #endif
@@ -204,6 +204,20 @@ void ibutton_protocols_emulate_stop(iButtonProtocols* protocols, iButtonKey* key
     GROUP_BASE->emulate_stop(GROUP_DATA, data, PROTOCOL_ID);
 }
 
+void ibutton_protocols_emulate_set_callback(
+    iButtonProtocols* protocols,
+    iButtonProtocolEmulateCallback callback,
+    void* context) {
+    furi_check(protocols);
+
+    for(iButtonProtocolGroupId i = 0; i < iButtonProtocolGroupMax; ++i) {
+        if(ibutton_protocol_groups[i]->set_emulate_callback) {
+            ibutton_protocol_groups[i]->set_emulate_callback(
+                protocols->group_datas[i], callback, context);
+        }
+    }
+}
+
 bool ibutton_protocols_save(
     iButtonProtocols* protocols,
     const iButtonKey* key,
@@ -112,6 +112,18 @@ void ibutton_protocols_emulate_start(iButtonProtocols* protocols, iButtonKey* ke
  */
 void ibutton_protocols_emulate_stop(iButtonProtocols* protocols, iButtonKey* key);
 
+/**
+ * Set a callback to report reader activity during emulation
+ * Applies to emulation started afterwards. Not all protocols support it.
+ * @param [in] protocols pointer to an iButtonProtocols object
+ * @param [in] callback pointer to a callback function, called from interrupt, can be NULL
+ * @param [in] context additional parameter to be passed to the callback
+ */
+void ibutton_protocols_emulate_set_callback(
+    iButtonProtocols* protocols,
+    iButtonProtocolEmulateCallback callback,
+    void* context);
+
 /**
  * Save the key data to a file.
  * @param [in] protocols pointer to an iButtonProtocols object
@@ -10,6 +10,7 @@ typedef enum {
     iButtonMessageWriteId,
     iButtonMessageWriteCopy,
     iButtonMessageEmulate,
+    iButtonMessageEmulateSequence,
     iButtonMessageNotifyEmulate,
 } iButtonMessageType;
 
@@ -107,6 +108,35 @@ void ibutton_worker_emulate_start(iButtonWorker* worker, iButtonKey* key) {
         furi_message_queue_put(worker->messages, &message, FuriWaitForever) == FuriStatusOk);
 }
 
+void ibutton_worker_emulate_sequence_start(
+    iButtonWorker* worker,
+    iButtonKey* const* keys,
+    size_t key_count,
+    uint32_t dwell_ms,
+    uint32_t* hits) {
+    furi_check(worker);
+    furi_check(keys);
+    furi_check(key_count);
+    furi_check(worker->mode_index == iButtonWorkerModeIdle);
+
+    // Keys are ready to go, switching to next one takes no file access
+    worker->sequence.keys = keys;
+    worker->sequence.count = key_count;
+    worker->sequence.dwell_ms = dwell_ms;
+    worker->sequence.hits = hits;
+    worker->sequence.index = 0;
+
+    iButtonMessage message = {.type = iButtonMessageEmulateSequence, .data.key = keys[0]};
+
+    furi_check(
+        furi_message_queue_put(worker->messages, &message, FuriWaitForever) == FuriStatusOk);
+}
+
+size_t ibutton_worker_emulate_sequence_get_index(iButtonWorker* worker) {
+    furi_check(worker);
+    return worker->sequence.index;
+}
+
 void ibutton_worker_stop(iButtonWorker* worker) {
     furi_check(worker);
 
@@ -197,7 +227,15 @@ static int32_t ibutton_worker_thread(void* thread_context) {
                 ibutton_worker_set_key_p(worker, message.data.key);
                 ibutton_worker_switch_mode(worker, iButtonWorkerModeEmulate);
                 break;
+            case iButtonMessageEmulateSequence:
+                ibutton_worker_set_key_p(worker, message.data.key);
+                ibutton_worker_switch_mode(worker, iButtonWorkerModeEmulateSequence);
+                break;
             case iButtonMessageNotifyEmulate:
+                if(worker->mode_index == iButtonWorkerModeEmulateSequence &&
+                   worker->sequence.hits) {
+                    worker->sequence.hits[worker->sequence.index]++;
+                }
                 if(worker->emulate_cb) {
                     worker->emulate_cb(worker->cb_ctx, true);
                 }
@@ -111,6 +111,31 @@ void ibutton_worker_emulate_set_callback(
  */
 void ibutton_worker_emulate_start(iButtonWorker* worker, iButtonKey* key);
 
+/**
+ * Start emulate sequence mode
+ * Keys are emulated one after another in a loop, each for dwell_ms.
+ * Emulate callback is called and key hit counter is incremented every time
+ * reader talks to emulated key, for protocols that allow to tell so.
+ * @param worker 
+ * @param keys keys to emulate, must stay valid until worker is stopped
+ * @param key_count number of keys
+ * @param dwell_ms time each key is emulated for
+ * @param hits key_count hit counters, can be NULL
+ */
+void ibutton_worker_emulate_sequence_start(
+    iButtonWorker* worker,
+    iButtonKey* const* keys,
+    size_t key_count,
+    uint32_t dwell_ms,
+    uint32_t* hits);
+
+/**
+ * Get index of key being emulated in emulate sequence mode
+ * @param worker 
+ * @return size_t 
+ */
+size_t ibutton_worker_emulate_sequence_get_index(iButtonWorker* worker);
+
 /**
  * Stop all modes
  * @param worker 
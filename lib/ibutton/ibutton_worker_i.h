@@ -28,8 +28,18 @@ typedef enum {
     iButtonWorkerModeWriteId,
     iButtonWorkerModeWriteCopy,
     iButtonWorkerModeEmulate,
+    iButtonWorkerModeEmulateSequence,
 } iButtonWorkerMode;
 
+typedef struct {
+    iButtonKey* const* keys;
+    size_t count;
+    uint32_t dwell_ms;
+    uint32_t* hits;
+    volatile size_t index;
+    uint32_t switch_tick;
+} iButtonWorkerSequence;
+
 struct iButtonWorker {
     iButtonKey* key;
     iButtonProtocols* protocols;
@@ -42,6 +52,8 @@ struct iButtonWorker {
     iButtonWorkerEmulateCallback emulate_cb;
 
     void* cb_ctx;
+
+    iButtonWorkerSequence sequence;
 };
 
 extern const iButtonWorkerModeType ibutton_worker_modes[];
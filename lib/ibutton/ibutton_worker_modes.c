@@ -1,6 +1,7 @@
 #include "ibutton_worker_i.h"
 
 #include <core/check.h>
+#include <core/kernel.h>
 
 #include <furi_hal_rfid.h>
 #include <furi_hal_power.h>
@@ -15,6 +16,10 @@ static void ibutton_worker_mode_emulate_start(iButtonWorker* worker);
 static void ibutton_worker_mode_emulate_tick(iButtonWorker* worker);
 static void ibutton_worker_mode_emulate_stop(iButtonWorker* worker);
 
+static void ibutton_worker_mode_emulate_sequence_start(iButtonWorker* worker);
+static void ibutton_worker_mode_emulate_sequence_tick(iButtonWorker* worker);
+static void ibutton_worker_mode_emulate_sequence_stop(iButtonWorker* worker);
+
 static void ibutton_worker_mode_read_start(iButtonWorker* worker);
 static void ibutton_worker_mode_read_tick(iButtonWorker* worker);
 static void ibutton_worker_mode_read_stop(iButtonWorker* worker);
@@ -55,6 +60,12 @@ const iButtonWorkerModeType ibutton_worker_modes[] = {
         .tick = ibutton_worker_mode_emulate_tick,
         .stop = ibutton_worker_mode_emulate_stop,
     },
+    {
+        .quant = 10,
+        .start = ibutton_worker_mode_emulate_sequence_start,
+        .tick = ibutton_worker_mode_emulate_sequence_tick,
+        .stop = ibutton_worker_mode_emulate_sequence_stop,
+    },
 };
 
 /*********************** IDLE ***********************/
@@ -116,6 +127,39 @@ void ibutton_worker_mode_emulate_stop(iButtonWorker* worker) {
     furi_hal_rfid_pins_reset();
 }
 
+/*********************** EMULATE SEQUENCE ***********************/
+
+static void ibutton_worker_emulate_sequence_callback(void* context) {
+    iButtonWorker* worker = context;
+    ibutton_worker_notify_emulate(worker);
+}
+
+void ibutton_worker_mode_emulate_sequence_start(iButtonWorker* worker) {
+    ibutton_protocols_emulate_set_callback(
+        worker->protocols, ibutton_worker_emulate_sequence_callback, worker);
+    ibutton_worker_mode_emulate_start(worker);
+    worker->sequence.switch_tick = furi_get_tick();
+}
+
+void ibutton_worker_mode_emulate_sequence_tick(iButtonWorker* worker) {
+    iButtonWorkerSequence* sequence = &worker->sequence;
+    if(sequence->count < 2) return;
+    if(furi_get_tick() - sequence->switch_tick < sequence->dwell_ms) return;
+
+    ibutton_protocols_emulate_stop(worker->protocols, worker->key);
+
+    sequence->index = (sequence->index + 1) % sequence->count;
+    worker->key = sequence->keys[sequence->index];
+
+    ibutton_protocols_emulate_start(worker->protocols, worker->key);
+    sequence->switch_tick = furi_get_tick();
+}
+
+void ibutton_worker_mode_emulate_sequence_stop(iButtonWorker* worker) {
+    ibutton_worker_mode_emulate_stop(worker);
+    ibutton_protocols_emulate_set_callback(worker->protocols, NULL, NULL);
+}
+
 /*********************** WRITE ***********************/
 
 void ibutton_worker_mode_write_common_start(iButtonWorker* worker) { //-V524
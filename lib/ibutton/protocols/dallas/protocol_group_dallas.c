@@ -9,6 +9,8 @@
 typedef struct {
     OneWireHost* host;
     OneWireSlave* bus;
+    iButtonProtocolEmulateCallback emulate_callback;
+    void* emulate_context;
 } iButtonProtocolGroupDallas;
 
 static iButtonProtocolGroupDallas* ibutton_protocol_group_dallas_alloc(void) {
@@ -112,8 +114,7 @@ static bool ibutton_protocol_group_dallas_read(
     onewire_host_start(host);
     furi_delay_ms(100);
 
-    FURI_CRITICAL_ENTER();
-
+    // Host keeps interrupts disabled only within time slots
     if(onewire_host_search(host, rom_data, OneWireHostSearchModeNormal)) {
         /* Considering any found 1-Wire device a success.
          * It can be checked later with ibutton_key_is_valid(). */
@@ -128,8 +129,6 @@ static bool ibutton_protocol_group_dallas_read(
     onewire_host_reset_search(host);
     onewire_host_stop(host);
 
-    FURI_CRITICAL_EXIT();
-
     return success;
 }
 
@@ -185,6 +184,7 @@ static void ibutton_protocol_group_dallas_emulate_start(
     furi_assert(id < iButtonProtocolDSMax);
     OneWireSlave* bus = group->bus;
     ibutton_protocols_dallas[id]->emulate(bus, data);
+    onewire_slave_set_result_callback(bus, group->emulate_callback, group->emulate_context);
     onewire_slave_start(bus);
 }
 
@@ -197,6 +197,14 @@ static void ibutton_protocol_group_dallas_emulate_stop(
     onewire_slave_stop(group->bus);
 }
 
+static void ibutton_protocol_group_dallas_set_emulate_callback(
+    iButtonProtocolGroupDallas* group,
+    iButtonProtocolEmulateCallback callback,
+    void* context) {
+    group->emulate_callback = callback;
+    group->emulate_context = context;
+}
+
 static bool ibutton_protocol_group_dallas_save(
     iButtonProtocolGroupDallas* group,
     const iButtonProtocolData* data,
@@ -312,6 +320,8 @@ const iButtonProtocolGroupBase ibutton_protocol_group_dallas = {
 
     .emulate_start = (iButtonProtocolGroupApplyFunc)ibutton_protocol_group_dallas_emulate_start,
     .emulate_stop = (iButtonProtocolGroupApplyFunc)ibutton_protocol_group_dallas_emulate_stop,
+    .set_emulate_callback =
+        (iButtonProtocolGroupSetCallbackFunc)ibutton_protocol_group_dallas_set_emulate_callback,
 
     .save = (iButtonProtocolGroupSaveFunc)ibutton_protocol_group_dallas_save,
     .load = (iButtonProtocolGroupLoadFunc)ibutton_protocol_group_dallas_load,
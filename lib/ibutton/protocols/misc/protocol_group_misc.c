@@ -289,6 +289,7 @@ const iButtonProtocolGroupBase ibutton_protocol_group_misc = {
 
     .emulate_start = (iButtonProtocolGroupApplyFunc)ibutton_protocol_group_misc_emulate_start,
     .emulate_stop = (iButtonProtocolGroupApplyFunc)ibutton_protocol_group_misc_emulate_stop,
+    .set_emulate_callback = NULL, /* Reader activity is not visible, key only transmits */
 
     .save = (iButtonProtocolGroupSaveFunc)ibutton_protocol_group_misc_save,
     .load = (iButtonProtocolGroupLoadFunc)ibutton_protocol_group_misc_load,
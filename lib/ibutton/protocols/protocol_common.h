@@ -19,3 +19,6 @@ typedef struct {
     uint8_t* ptr;
     size_t size;
 } iButtonEditableData;
+
+/** Called from interrupt when reader has talked to the emulated key */
+typedef void (*iButtonProtocolEmulateCallback)(void* context);
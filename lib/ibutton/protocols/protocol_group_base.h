@@ -34,6 +34,11 @@ typedef void (*iButtonProtocolGroupApplyFunc)(
     iButtonProtocolData*,
     iButtonProtocolLocalId);
 
+typedef void (*iButtonProtocolGroupSetCallbackFunc)(
+    iButtonProtocolGroupData*,
+    iButtonProtocolEmulateCallback,
+    void*);
+
 typedef size_t (*iButtonProtocolGropuGetSizeFunc)(iButtonProtocolGroupData*);
 
 typedef uint32_t (
@@ -89,6 +94,8 @@ typedef struct {
 
     iButtonProtocolGroupApplyFunc emulate_start;
     iButtonProtocolGroupApplyFunc emulate_stop;
+    // Can be NULL if group has no way to tell reader activity
+    iButtonProtocolGroupSetCallbackFunc set_emulate_callback;
 
     iButtonProtocolGroupSaveFunc save;
     iButtonProtocolGroupLoadFunc load;
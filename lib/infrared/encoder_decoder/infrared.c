@@ -6,13 +6,25 @@
 #include <core/common_defines.h>
 
 #include "nec/infrared_protocol_nec.h"
+#include "nec/infrared_protocol_nec_i.h"
 #include "samsung/infrared_protocol_samsung.h"
+#include "samsung/infrared_protocol_samsung_i.h"
 #include "rc5/infrared_protocol_rc5.h"
+#include "rc5/infrared_protocol_rc5_i.h"
 #include "rc6/infrared_protocol_rc6.h"
+#include "rc6/infrared_protocol_rc6_i.h"
 #include "sirc/infrared_protocol_sirc.h"
+#include "sirc/infrared_protocol_sirc_i.h"
 #include "kaseikyo/infrared_protocol_kaseikyo.h"
+#include "kaseikyo/infrared_protocol_kaseikyo_i.h"
 #include "rca/infrared_protocol_rca.h"
+#include "rca/infrared_protocol_rca_i.h"
 #include "pioneer/infrared_protocol_pioneer.h"
+#include "pioneer/infrared_protocol_pioneer_i.h"
+
+/* Longer than any space inside a frame of protocols with preamble,
+ * first mark and space after it are checked against decoders preambles */
+#define INFRARED_DECODER_FRAME_SPLIT_TIME 5000
 
 typedef struct {
     InfraredAlloc alloc;
@@ -20,6 +32,8 @@ typedef struct {
     InfraredDecoderReset reset;
     InfraredFree free;
     InfraredDecoderCheckReady check_ready;
+    const InfraredTimings* timings; /* decoder is only fed with frames matching preamble */
+    uint16_t repeat_space; /* repeat preamble space, if it differs from preamble one */
 } InfraredDecoders;
 
 typedef struct {
@@ -31,6 +45,9 @@ typedef struct {
 
 struct InfraredDecoderHandler {
     void** ctx;
+    uint32_t enabled; /* decoders fed with pulses, one bit per decoder */
+    uint32_t mark; /* last mark duration, 0 if already checked */
+    bool frame_start; /* last space was long enough to split frames */
 };
 
 struct InfraredEncoderHandler {
@@ -51,7 +68,9 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_nec_decode,
              .reset = infrared_decoder_nec_reset,
              .check_ready = infrared_decoder_nec_check_ready,
-             .free = infrared_decoder_nec_free},
+             .free = infrared_decoder_nec_free,
+             .timings = &infrared_protocol_nec.timings,
+             .repeat_space = INFRARED_NEC_REPEAT_SPACE},
         .encoder =
             {.alloc = infrared_encoder_nec_alloc,
              .encode = infrared_encoder_nec_encode,
@@ -65,7 +84,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_samsung32_decode,
              .reset = infrared_decoder_samsung32_reset,
              .check_ready = infrared_decoder_samsung32_check_ready,
-             .free = infrared_decoder_samsung32_free},
+             .free = infrared_decoder_samsung32_free,
+             .timings = &infrared_protocol_samsung32.timings},
         .encoder =
             {.alloc = infrared_encoder_samsung32_alloc,
              .encode = infrared_encoder_samsung32_encode,
@@ -79,7 +99,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc5_decode,
              .reset = infrared_decoder_rc5_reset,
              .check_ready = infrared_decoder_rc5_check_ready,
-             .free = infrared_decoder_rc5_free},
+             .free = infrared_decoder_rc5_free,
+             .timings = &infrared_protocol_rc5.timings},
         .encoder =
             {.alloc = infrared_encoder_rc5_alloc,
              .encode = infrared_encoder_rc5_encode,
@@ -93,7 +114,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc6_decode,
              .reset = infrared_decoder_rc6_reset,
              .check_ready = infrared_decoder_rc6_check_ready,
-             .free = infrared_decoder_rc6_free},
+             .free = infrared_decoder_rc6_free,
+             .timings = &infrared_protocol_rc6.timings},
         .encoder =
             {.alloc = infrared_encoder_rc6_alloc,
              .encode = infrared_encoder_rc6_encode,
@@ -107,7 +129,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_sirc_decode,
              .reset = infrared_decoder_sirc_reset,
              .check_ready = infrared_decoder_sirc_check_ready,
-             .free = infrared_decoder_sirc_free},
+             .free = infrared_decoder_sirc_free,
+             .timings = &infrared_protocol_sirc.timings},
         .encoder =
             {.alloc = infrared_encoder_sirc_alloc,
              .encode = infrared_encoder_sirc_encode,
@@ -121,7 +144,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_pioneer_decode,
              .reset = infrared_decoder_pioneer_reset,
              .check_ready = infrared_decoder_pioneer_check_ready,
-             .free = infrared_decoder_pioneer_free},
+             .free = infrared_decoder_pioneer_free,
+             .timings = &infrared_protocol_pioneer.timings},
         .encoder =
             {.alloc = infrared_encoder_pioneer_alloc,
              .encode = infrared_encoder_pioneer_encode,
@@ -135,7 +159,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_kaseikyo_decode,
              .reset = infrared_decoder_kaseikyo_reset,
              .check_ready = infrared_decoder_kaseikyo_check_ready,
-             .free = infrared_decoder_kaseikyo_free},
+             .free = infrared_decoder_kaseikyo_free,
+             .timings = &infrared_protocol_kaseikyo.timings},
         .encoder =
             {.alloc = infrared_encoder_kaseikyo_alloc,
              .encode = infrared_encoder_kaseikyo_encode,
@@ -149,7 +174,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rca_decode,
              .reset = infrared_decoder_rca_reset,
              .check_ready = infrared_decoder_rca_check_ready,
-             .free = infrared_decoder_rca_free},
+             .free = infrared_decoder_rca_free,
+             .timings = &infrared_protocol_rca.timings},
         .encoder =
             {.alloc = infrared_encoder_rca_alloc,
              .encode = infrared_encoder_rca_encode,
@@ -159,18 +185,36 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
     },
 };
 
+_Static_assert(COUNT_OF(infrared_encoder_decoder) < 32, "Decoder masks must be extended");
+
 static int infrared_find_index_by_protocol(InfraredProtocol protocol);
 static const InfraredProtocolVariant* infrared_get_variant_by_protocol(InfraredProtocol protocol);
 
-const InfraredMessage*
-    infrared_decode(InfraredDecoderHandler* handler, bool level, uint32_t duration) {
-    furi_check(handler);
+static bool infrared_decoder_preamble_match(
+    const InfraredDecoders* decoder,
+    uint32_t mark,
+    uint32_t space) {
+    const InfraredTimings* timings = decoder->timings;
+    /* nothing to check against, decoder is fed with everything */
+    if(!timings || !timings->preamble_mark) return true;
+
+    const uint32_t tolerance = timings->preamble_tolerance;
+    if(!MATCH_TIMING(mark, timings->preamble_mark, tolerance)) return false;
 
+    return MATCH_TIMING(space, timings->preamble_space, tolerance) ||
+           (decoder->repeat_space && MATCH_TIMING(space, decoder->repeat_space, tolerance));
+}
+
+static InfraredMessage* infrared_decode_selected(
+    InfraredDecoderHandler* handler,
+    uint32_t selected,
+    bool level,
+    uint32_t duration) {
     InfraredMessage* message = NULL;
     InfraredMessage* result = NULL;
 
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
-        if(infrared_encoder_decoder[i].decoder.decode) {
+        if((selected & (1UL << i)) && infrared_encoder_decoder[i].decoder.decode) {
             message = infrared_encoder_decoder[i].decoder.decode(handler->ctx[i], level, duration);
             if(!result && message) {
                 result = message;
@@ -181,6 +225,48 @@ const InfraredMessage*
     return result;
 }
 
+const InfraredMessage*
+    infrared_decode(InfraredDecoderHandler* handler, bool level, uint32_t duration) {
+    furi_check(handler);
+
+    InfraredMessage* result = infrared_decode_selected(handler, handler->enabled, level, duration);
+
+    if(level) {
+        handler->mark = duration;
+    } else {
+        if(handler->mark) {
+            uint32_t matching = 0;
+            for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+                if(infrared_decoder_preamble_match(
+                       &infrared_encoder_decoder[i].decoder, handler->mark, duration)) {
+                    matching |= 1UL << i;
+                }
+            }
+
+            /* disabled decoders only wait for preamble, catch them up with it */
+            const uint32_t resumed = matching & ~handler->enabled;
+            if(resumed) {
+                InfraredMessage* message =
+                    infrared_decode_selected(handler, resumed, true, handler->mark);
+                if(!result) result = message;
+                message = infrared_decode_selected(handler, resumed, false, duration);
+                if(!result) result = message;
+            }
+
+            /* new frame: stop feeding decoders which can't match it */
+            if(handler->frame_start) {
+                handler->enabled = matching;
+            } else {
+                handler->enabled |= matching;
+            }
+            handler->mark = 0;
+        }
+        handler->frame_start = duration > INFRARED_DECODER_FRAME_SPLIT_TIME;
+    }
+
+    return result;
+}
+
 InfraredDecoderHandler* infrared_alloc_decoder(void) {
     InfraredDecoderHandler* handler = malloc(sizeof(InfraredDecoderHandler));
     handler->ctx = malloc(sizeof(void*) * COUNT_OF(infrared_encoder_decoder));
@@ -211,6 +297,10 @@ void infrared_free_decoder(InfraredDecoderHandler* handler) {
 void infrared_reset_decoder(InfraredDecoderHandler* handler) {
     furi_check(handler);
 
+    handler->enabled = (1UL << COUNT_OF(infrared_encoder_decoder)) - 1;
+    handler->mark = 0;
+    handler->frame_start = true;
+
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
         if(infrared_encoder_decoder[i].decoder.reset)
             infrared_encoder_decoder[i].decoder.reset(handler->ctx[i]);
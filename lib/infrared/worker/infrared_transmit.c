@@ -36,10 +36,11 @@ FuriHalInfraredTxGetDataState
     return state;
 }
 
-void infrared_send_raw_ext(
+static void infrared_send_raw_start(
     const uint32_t timings[],
     uint32_t timings_cnt,
     bool start_from_mark,
+    bool add_silence,
     uint32_t frequency,
     float duty_cycle) {
     furi_check(timings);
@@ -47,10 +48,41 @@ void infrared_send_raw_ext(
     infrared_tx_raw_start_from_mark = start_from_mark;
     infrared_tx_raw_timings_index = 0;
     infrared_tx_raw_timings_number = timings_cnt;
-    infrared_tx_raw_add_silence = start_from_mark;
+    infrared_tx_raw_add_silence = add_silence;
     furi_hal_infrared_async_tx_set_data_isr_callback(
         infrared_get_raw_data_callback, (void*)timings);
     furi_hal_infrared_async_tx_start(frequency, duty_cycle);
+}
+
+void infrared_send_raw_ext_async(
+    const uint32_t timings[],
+    uint32_t timings_cnt,
+    bool start_from_mark,
+    uint32_t frequency,
+    float duty_cycle) {
+    infrared_send_raw_start(
+        timings, timings_cnt, start_from_mark, start_from_mark, frequency, duty_cycle);
+}
+
+void infrared_send_raw_ext(
+    const uint32_t timings[],
+    uint32_t timings_cnt,
+    bool start_from_mark,
+    uint32_t frequency,
+    float duty_cycle) {
+    infrared_send_raw_ext_async(timings, timings_cnt, start_from_mark, frequency, duty_cycle);
+    infrared_send_wait();
+}
+
+void infrared_send_rendered_async(
+    const uint32_t timings[],
+    uint32_t timings_cnt,
+    uint32_t frequency,
+    float duty_cycle) {
+    infrared_send_raw_start(timings, timings_cnt, true, false, frequency, duty_cycle);
+}
+
+void infrared_send_wait(void) {
     furi_hal_infrared_async_tx_wait_termination();
 
     furi_check(!furi_hal_infrared_is_busy());
@@ -115,3 +147,46 @@ void infrared_send(const InfraredMessage* message, int times) {
 
     furi_check(!furi_hal_infrared_is_busy());
 }
+
+size_t infrared_render(const InfraredMessage* message, uint32_t timings[], size_t timings_size) {
+    furi_check(message);
+    furi_check(timings);
+    furi_check(infrared_is_protocol_valid(message->protocol));
+
+    InfraredEncoderHandler* handler = infrared_alloc_encoder();
+    infrared_reset_encoder(handler, message);
+    size_t transmissions = MAX(infrared_get_protocol_min_repeat_count(message->protocol), 1U);
+
+    size_t count = 0;
+    bool last_level = false;
+
+    while(transmissions) {
+        uint32_t duration;
+        bool level;
+        const InfraredStatus status = infrared_encode(handler, &duration, &level);
+
+        if(status == InfraredStatusError) {
+            count = 0;
+            break;
+        } else if(status == InfraredStatusDone) {
+            --transmissions;
+        }
+
+        // Line is idle before the first mark, same level durations are merged
+        if((count == 0 && !level) || duration == 0) {
+            continue;
+        } else if(count && (level == last_level)) {
+            timings[count - 1] += duration;
+        } else if(count < timings_size) {
+            timings[count++] = duration;
+            last_level = level;
+        } else {
+            count = 0;
+            break;
+        }
+    }
+
+    infrared_free_encoder(handler);
+
+    return count;
+}
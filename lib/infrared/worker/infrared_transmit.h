@@ -43,6 +43,54 @@ void infrared_send_raw_ext(
     uint32_t frequency,
     float duty_cycle);
 
+/**
+ * Start sending raw data through infrared port, without waiting for completion.
+ *
+ * Same as infrared_send_raw_ext(), call infrared_send_wait() before next send.
+ * Timings array must stay valid until then.
+ */
+void infrared_send_raw_ext_async(
+    const uint32_t timings[],
+    uint32_t timings_cnt,
+    bool start_from_mark,
+    uint32_t frequency,
+    float duty_cycle);
+
+/**
+ * Render message into raw timings, as infrared_send() would transmit it once.
+ *
+ * Rendered timings start from mark and are sent with
+ * infrared_send_rendered_async() without running the encoder.
+ *
+ * \param[in]   message - message to render.
+ * \param[out]  timings - array to render to.
+ * \param[in]   timings_size - timings array size.
+ * \return      number of timings rendered, 0 if message doesn't fit
+ */
+size_t infrared_render(const InfraredMessage* message, uint32_t timings[], size_t timings_size);
+
+/**
+ * Start sending rendered timings, without waiting for completion.
+ *
+ * Call infrared_send_wait() before next send, timings array must stay valid
+ * until then.
+ *
+ * \param[in]   timings - array of timings from infrared_render().
+ * \param[in]   timings_cnt - timings array size.
+ * \param[in]   frequency - frequency to generate on PWM
+ * \param[in]   duty_cycle - duty cycle to generate on PWM
+ */
+void infrared_send_rendered_async(
+    const uint32_t timings[],
+    uint32_t timings_cnt,
+    uint32_t frequency,
+    float duty_cycle);
+
+/**
+ * Wait for asynchronous send to complete.
+ */
+void infrared_send_wait(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -114,6 +114,18 @@ static void infrared_worker_rx_callback(void* context, bool level, uint32_t dura
     furi_check(flags_set & events);
 }
 
+static void
+    infrared_worker_rx_batch_callback(void* context, const LevelDuration* pulses, size_t count) {
+    InfraredWorker* instance = context;
+
+    const size_t size = count * sizeof(LevelDuration);
+    size_t ret = furi_stream_buffer_send(instance->stream, pulses, size, 0);
+    uint32_t events = (ret == size) ? INFRARED_WORKER_RX_RECEIVED : INFRARED_WORKER_OVERRUN;
+
+    uint32_t flags_set = furi_thread_flags_set(furi_thread_get_id(instance->thread), events);
+    furi_check(flags_set & events);
+}
+
 static void infrared_worker_process_timeout(InfraredWorker* instance) {
     if(instance->signal.timings_cnt < 2) return;
 
@@ -265,6 +277,8 @@ void infrared_worker_rx_start(InfraredWorker* instance) {
     furi_thread_start(instance->thread);
 
     furi_hal_infrared_async_rx_set_capture_isr_callback(infrared_worker_rx_callback, instance);
+    furi_hal_infrared_async_rx_set_capture_batch_isr_callback(
+        infrared_worker_rx_batch_callback, instance);
     furi_hal_infrared_async_rx_set_timeout_isr_callback(
         infrared_worker_rx_timeout_callback, instance);
     furi_hal_infrared_async_rx_start();
@@ -280,6 +294,7 @@ void infrared_worker_rx_stop(InfraredWorker* instance) {
 
     furi_hal_infrared_async_rx_set_timeout_isr_callback(NULL, NULL);
     furi_hal_infrared_async_rx_set_capture_isr_callback(NULL, NULL);
+    furi_hal_infrared_async_rx_set_capture_batch_isr_callback(NULL, NULL);
     furi_hal_infrared_async_rx_stop();
 
     furi_thread_flags_set(furi_thread_get_id(instance->thread), INFRARED_WORKER_EXIT);
@@ -5,9 +5,14 @@
 
 #define LFRFID_RAW_FILE_MAGIC   0x4C464952
 #define LFRFID_RAW_FILE_VERSION 1
+// Version 2 header carries encoding
+#define LFRFID_RAW_FILE_VERSION_EX 2
 
 #define TAG "LfRfidRawFile"
 
+// Contiguous space reserved for a capture, FAT isn't updated while it's filled
+#define LFRFID_RAW_FILE_PREALLOCATE_SIZE (64 * 1024)
+
 typedef struct {
     uint32_t magic;
     uint32_t version;
@@ -16,15 +21,27 @@ typedef struct {
     uint32_t max_buffer_size;
 } LFRFIDRawFileHeader;
 
+typedef struct {
+    uint32_t encoding;
+} LFRFIDRawFileHeaderEx;
+
 struct LFRFIDRawFile {
     Stream* stream;
     uint32_t max_buffer_size;
+    LFRFIDRawFileEncoding encoding;
 
     uint8_t* buffer;
     uint32_t buffer_size;
     size_t buffer_counter;
+
+    // delta encoding restarts on every buffer
+    uint32_t last_pulse;
+    uint32_t last_duration;
 };
 
+// Delta of small values may take one more byte than the value itself
+#define LFRFID_RAW_FILE_DELTA_BUFFER_SIZE(size) ((size) * 2)
+
 LFRFIDRawFile* lfrfid_raw_file_alloc(Storage* storage) {
     furi_check(storage);
 
@@ -46,7 +63,13 @@ bool lfrfid_raw_file_open_write(LFRFIDRawFile* file, const char* file_path) {
     furi_check(file);
     furi_check(file_path);
 
-    return file_stream_open(file->stream, file_path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
+    bool result = file_stream_open(file->stream, file_path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
+    if(result) {
+        // Optional, capture can be written without it
+        file_stream_preallocate(file->stream, LFRFID_RAW_FILE_PREALLOCATE_SIZE);
+    }
+
+    return result;
 }
 
 bool lfrfid_raw_file_open_read(LFRFIDRawFile* file, const char* file_path) {
@@ -61,17 +84,73 @@ bool lfrfid_raw_file_write_header(
     float frequency,
     float duty_cycle,
     uint32_t max_buffer_size) {
+    return lfrfid_raw_file_write_header_ex(
+        file, frequency, duty_cycle, max_buffer_size, LFRFIDRawFileEncodingVarint);
+}
+
+bool lfrfid_raw_file_write_header_ex(
+    LFRFIDRawFile* file,
+    float frequency,
+    float duty_cycle,
+    uint32_t max_buffer_size,
+    LFRFIDRawFileEncoding encoding) {
     furi_check(file);
+    furi_check(encoding < LFRFIDRawFileEncodingCount);
 
+    const bool is_ex = encoding != LFRFIDRawFileEncodingVarint;
     LFRFIDRawFileHeader header = {
         .magic = LFRFID_RAW_FILE_MAGIC,
-        .version = LFRFID_RAW_FILE_VERSION,
+        .version = is_ex ? LFRFID_RAW_FILE_VERSION_EX : LFRFID_RAW_FILE_VERSION,
         .frequency = frequency,
         .duty_cycle = duty_cycle,
-        .max_buffer_size = max_buffer_size};
+        .max_buffer_size = is_ex ? LFRFID_RAW_FILE_DELTA_BUFFER_SIZE(max_buffer_size) :
+                                   max_buffer_size};
 
     size_t size = stream_write(file->stream, (uint8_t*)&header, sizeof(LFRFIDRawFileHeader));
-    return size == sizeof(LFRFIDRawFileHeader);
+    if(size != sizeof(LFRFIDRawFileHeader)) return false;
+
+    file->encoding = encoding;
+    if(is_ex) {
+        LFRFIDRawFileHeaderEx header_ex = {.encoding = encoding};
+        size = stream_write(file->stream, (uint8_t*)&header_ex, sizeof(LFRFIDRawFileHeaderEx));
+        if(size != sizeof(LFRFIDRawFileHeaderEx)) return false;
+
+        // transcoding buffer
+        if(file->buffer) free(file->buffer);
+        file->max_buffer_size = header.max_buffer_size;
+        file->buffer = malloc(file->max_buffer_size);
+    }
+
+    return true;
+}
+
+static size_t lfrfid_raw_file_delta_encode(
+    LFRFIDRawFile* file,
+    const uint8_t* buffer_data,
+    size_t buffer_size) {
+    uint32_t last_pulse = 0;
+    uint32_t last_duration = 0;
+    size_t index = 0;
+    size_t size = 0;
+
+    while(index < buffer_size) {
+        uint32_t pulse;
+        uint32_t duration;
+        size_t length;
+        if(!varint_pair_unpack(
+               (uint8_t*)&buffer_data[index], buffer_size - index, &pulse, &duration, &length)) {
+            break;
+        }
+        index += length;
+
+        // pair never grows past twice its size, see LFRFID_RAW_FILE_DELTA_BUFFER_SIZE
+        size += varint_int32_pack((int32_t)(pulse - last_pulse), &file->buffer[size]);
+        size += varint_int32_pack((int32_t)(duration - last_duration), &file->buffer[size]);
+        last_pulse = pulse;
+        last_duration = duration;
+    }
+
+    return size;
 }
 
 bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, size_t buffer_size) {
@@ -79,6 +158,13 @@ bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, siz
     furi_check(buffer_data);
     furi_check(buffer_size);
 
+    if(file->encoding == LFRFIDRawFileEncodingDelta) {
+        furi_check(LFRFID_RAW_FILE_DELTA_BUFFER_SIZE(buffer_size) <= file->max_buffer_size);
+        buffer_size = lfrfid_raw_file_delta_encode(file, buffer_data, buffer_size);
+        if(buffer_size == 0) return true;
+        buffer_data = file->buffer;
+    }
+
     size_t size;
     size = stream_write(file->stream, (uint8_t*)&buffer_size, sizeof(size_t));
     if(size != sizeof(size_t)) return false;
@@ -97,10 +183,22 @@ bool lfrfid_raw_file_read_header(LFRFIDRawFile* file, float* frequency, float* d
     LFRFIDRawFileHeader header;
     size_t size = stream_read(file->stream, (uint8_t*)&header, sizeof(LFRFIDRawFileHeader));
     if(size == sizeof(LFRFIDRawFileHeader)) {
-        if(header.magic == LFRFID_RAW_FILE_MAGIC && header.version == LFRFID_RAW_FILE_VERSION) {
+        file->encoding = LFRFIDRawFileEncodingVarint;
+        if(header.magic == LFRFID_RAW_FILE_MAGIC && header.version == LFRFID_RAW_FILE_VERSION_EX) {
+            LFRFIDRawFileHeaderEx header_ex;
+            size = stream_read(file->stream, (uint8_t*)&header_ex, sizeof(LFRFIDRawFileHeaderEx));
+            if(size != sizeof(LFRFIDRawFileHeaderEx)) return false;
+            if(header_ex.encoding >= LFRFIDRawFileEncodingCount) return false;
+            file->encoding = header_ex.encoding;
+        } else if(header.version != LFRFID_RAW_FILE_VERSION) {
+            return false;
+        }
+
+        if(header.magic == LFRFID_RAW_FILE_MAGIC) {
             *frequency = header.frequency;
             *duty_cycle = header.duty_cycle;
             file->max_buffer_size = header.max_buffer_size;
+            if(file->buffer) free(file->buffer);
             file->buffer = malloc(file->max_buffer_size);
             file->buffer_size = 0;
             file->buffer_counter = 0;
@@ -113,6 +211,30 @@ bool lfrfid_raw_file_read_header(LFRFIDRawFile* file, float* frequency, float* d
     }
 }
 
+static bool
+    lfrfid_raw_file_read_delta_pair(LFRFIDRawFile* file, uint32_t* duration, uint32_t* pulse) {
+    const uint8_t* data = &file->buffer[file->buffer_counter];
+    const size_t data_size = file->buffer_size - file->buffer_counter;
+    int32_t pulse_delta;
+    int32_t duration_delta;
+
+    size_t size = varint_int32_unpack(&pulse_delta, data, data_size);
+    if(size >= data_size) {
+        FURI_LOG_E(TAG, "read pair: buffer is too small");
+        return false;
+    }
+    size += varint_int32_unpack(&duration_delta, &data[size], data_size - size);
+
+    file->last_pulse += pulse_delta;
+    file->last_duration += duration_delta;
+    file->buffer_counter += size;
+
+    *pulse = file->last_pulse;
+    *duration = file->last_duration;
+
+    return true;
+}
+
 bool lfrfid_raw_file_read_pair(
     LFRFIDRawFile* file,
     uint32_t* duration,
@@ -126,7 +248,11 @@ bool lfrfid_raw_file_read_pair(
     if(file->buffer_counter >= file->buffer_size) {
         if(stream_eof(file->stream)) {
             // rewind stream and pass header
-            stream_seek(file->stream, sizeof(LFRFIDRawFileHeader), StreamOffsetFromStart);
+            size_t header_size = sizeof(LFRFIDRawFileHeader);
+            if(file->encoding != LFRFIDRawFileEncodingVarint) {
+                header_size += sizeof(LFRFIDRawFileHeaderEx);
+            }
+            stream_seek(file->stream, header_size, StreamOffsetFromStart);
             if(pass_end) *pass_end = true;
         }
 
@@ -148,6 +274,12 @@ bool lfrfid_raw_file_read_pair(
         }
 
         file->buffer_counter = 0;
+        file->last_pulse = 0;
+        file->last_duration = 0;
+    }
+
+    if(file->encoding == LFRFIDRawFileEncodingDelta) {
+        return lfrfid_raw_file_read_delta_pair(file, duration, pulse);
     }
 
     size_t size = 0;
@@ -8,6 +8,12 @@ extern "C" {
 
 typedef struct LFRFIDRawFile LFRFIDRawFile;
 
+typedef enum {
+    LFRFIDRawFileEncodingVarint, /**< Varint pulse and duration pairs */
+    LFRFIDRawFileEncodingDelta, /**< Varint deltas from previous pair, smaller on periodic data */
+    LFRFIDRawFileEncodingCount, /**< Special value, don't use it */
+} LFRFIDRawFileEncoding;
+
 /**
  * @brief Allocate a new LFRFIDRawFile instance
  * 
@@ -55,6 +61,25 @@ bool lfrfid_raw_file_write_header(
     float duty_cycle,
     uint32_t max_buffer_size);
 
+/**
+ * @brief Write RAW file header with given data encoding
+ * 
+ * Varint encoding produces a file readable by older firmware.
+ * 
+ * @param file 
+ * @param frequency 
+ * @param duty_cycle 
+ * @param max_buffer_size biggest buffer passed to lfrfid_raw_file_write_buffer
+ * @param encoding 
+ * @return bool 
+ */
+bool lfrfid_raw_file_write_header_ex(
+    LFRFIDRawFile* file,
+    float frequency,
+    float duty_cycle,
+    uint32_t max_buffer_size,
+    LFRFIDRawFileEncoding encoding);
+
 /**
  * @brief Write data to RAW file
  * 
@@ -10,7 +10,11 @@
 #define RFID_DATA_BUFFER_SIZE  2048
 #define READ_DATA_BUFFER_COUNT 4
 
+// Buffers gathered for one SD write, while other block is being written
+#define READ_WRITE_BLOCK_BUFFERS 2
+
 #define TAG_EMULATE "RawEmulate"
+#define TAG_READ    "RawRead"
 
 // emulate mode
 typedef struct {
@@ -32,9 +36,24 @@ typedef enum {
 // read mode
 #define READ_TEMP_DATA_SIZE 10
 
+typedef struct {
+    uint8_t data[RFID_DATA_BUFFER_SIZE * READ_WRITE_BLOCK_BUFFERS];
+    size_t sizes[READ_WRITE_BLOCK_BUFFERS];
+    size_t count;
+} LFRFIDRawWorkerWriteBlock;
+
 typedef struct {
     BufferStream* stream;
     VarintPair* pair;
+
+    LFRFIDRawFile* file;
+    FuriWorkQueue* work_queue;
+    // Taken while block write is in flight
+    FuriSemaphore* write_idle;
+    LFRFIDRawWorkerWriteBlock blocks[2];
+    size_t fill_index;
+    bool write_valid;
+    size_t write_overrun_count;
 } LFRFIDRawWorkerReadData;
 
 // main worker
@@ -49,6 +68,7 @@ struct LFRFIDRawWorker {
 
     float frequency;
     float duty_cycle;
+    LFRFIDRawFileEncoding encoding;
 };
 
 typedef enum {
@@ -85,14 +105,28 @@ void lfrfid_raw_worker_start_read(
     float duty_cycle,
     LFRFIDWorkerReadRawCallback callback,
     void* context) {
+    lfrfid_raw_worker_start_read_ex(
+        worker, file_path, freq, duty_cycle, LFRFIDRawFileEncodingVarint, callback, context);
+}
+
+void lfrfid_raw_worker_start_read_ex(
+    LFRFIDRawWorker* worker,
+    const char* file_path,
+    float freq,
+    float duty_cycle,
+    LFRFIDRawFileEncoding encoding,
+    LFRFIDWorkerReadRawCallback callback,
+    void* context) {
     furi_check(worker);
     furi_check(file_path);
+    furi_check(encoding < LFRFIDRawFileEncodingCount);
     furi_check(furi_thread_get_state(worker->thread) == FuriThreadStateStopped);
 
     furi_string_set(worker->file_path, file_path);
 
     worker->frequency = freq;
     worker->duty_cycle = duty_cycle;
+    worker->encoding = encoding;
     worker->read_callback = callback;
     worker->context = context;
 
@@ -139,6 +173,61 @@ static void lfrfid_raw_worker_capture(bool level, uint32_t duration, void* conte
     }
 }
 
+static void lfrfid_raw_worker_write_job(FuriWorkQueueJobId job_id, void* context) {
+    UNUSED(job_id);
+    LFRFIDRawWorkerReadData* data = context;
+    // Fill index is only changed by read thread while no write is in flight
+    LFRFIDRawWorkerWriteBlock* block = &data->blocks[data->fill_index ^ 1];
+
+    uint8_t* buffer_data = block->data;
+    for(size_t i = 0; (i < block->count) && data->write_valid; i++) {
+        data->write_valid = lfrfid_raw_file_write_buffer(data->file, buffer_data, block->sizes[i]);
+        buffer_data += block->sizes[i];
+    }
+    block->count = 0;
+
+    furi_check(furi_semaphore_release(data->write_idle) == FuriStatusOk);
+}
+
+// Pass filled block to the writer if it is idle, returns false on write error
+static bool lfrfid_raw_worker_flush(LFRFIDRawWorkerReadData* data, uint32_t timeout) {
+    LFRFIDRawWorkerWriteBlock* block = &data->blocks[data->fill_index];
+    if(block->count == 0) return data->write_valid;
+    if(furi_semaphore_acquire(data->write_idle, timeout) != FuriStatusOk) return true;
+
+    if(data->write_valid) {
+        data->fill_index ^= 1;
+        furi_work_queue_submit(
+            data->work_queue,
+            FuriWorkQueuePriorityNormal,
+            lfrfid_raw_worker_write_job,
+            NULL,
+            data);
+    } else {
+        furi_check(furi_semaphore_release(data->write_idle) == FuriStatusOk);
+    }
+
+    return data->write_valid;
+}
+
+static void lfrfid_raw_worker_push(LFRFIDRawWorkerReadData* data, Buffer* buffer) {
+    LFRFIDRawWorkerWriteBlock* block = &data->blocks[data->fill_index];
+    if(block->count >= READ_WRITE_BLOCK_BUFFERS) {
+        // both blocks are busy, SD card is not keeping up
+        data->write_overrun_count++;
+        return;
+    }
+
+    size_t offset = 0;
+    for(size_t i = 0; i < block->count; i++) {
+        offset += block->sizes[i];
+    }
+
+    const size_t size = buffer_get_size(buffer);
+    memcpy(&block->data[offset], buffer_get_data(buffer), size);
+    block->sizes[block->count++] = size;
+}
+
 static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
     LFRFIDRawWorker* worker = (LFRFIDRawWorker*)thread_context;
 
@@ -151,11 +240,15 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
 
     data->stream = buffer_stream_alloc(RFID_DATA_BUFFER_SIZE, READ_DATA_BUFFER_COUNT);
     data->pair = varint_pair_alloc();
+    data->file = file;
+    data->work_queue = furi_work_queue_alloc(NULL);
+    data->write_idle = furi_semaphore_alloc(1, 1);
+    data->write_valid = true;
 
     if(file_valid) {
         // write header
-        file_valid = lfrfid_raw_file_write_header(
-            file, worker->frequency, worker->duty_cycle, RFID_DATA_BUFFER_SIZE);
+        file_valid = lfrfid_raw_file_write_header_ex(
+            file, worker->frequency, worker->duty_cycle, RFID_DATA_BUFFER_SIZE, worker->encoding);
     }
 
     if(file_valid) {
@@ -171,10 +264,12 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
         while(1) {
             Buffer* buffer = buffer_stream_receive(data->stream, 100);
 
+            file_valid = lfrfid_raw_worker_flush(data, 0);
+
             if(buffer != NULL) {
-                file_valid = lfrfid_raw_file_write_buffer(
-                    file, buffer_get_data(buffer), buffer_get_size(buffer));
+                lfrfid_raw_worker_push(data, buffer);
                 buffer_reset(buffer);
+                if(file_valid) file_valid = lfrfid_raw_worker_flush(data, 0);
             }
 
             if(!file_valid) {
@@ -185,7 +280,8 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
                 break;
             }
 
-            if(buffer_stream_get_overrun_count(data->stream) > 0 &&
+            if((buffer_stream_get_overrun_count(data->stream) > 0 ||
+                data->write_overrun_count > 0) &&
                worker->read_callback != NULL) {
                 // message overrun to worker
                 worker->read_callback(LFRFIDWorkerReadRawOverrun, worker->context);
@@ -199,6 +295,17 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
 
         furi_hal_rfid_tim_read_capture_stop();
         furi_hal_rfid_tim_read_stop();
+
+        // write out what is left
+        if(file_valid) file_valid = lfrfid_raw_worker_flush(data, FuriWaitForever);
+
+        if(buffer_stream_get_overrun_count(data->stream) > 0 || data->write_overrun_count > 0) {
+            FURI_LOG_E(
+                TAG_READ,
+                "overruns: capture %zu, write %zu",
+                buffer_stream_get_overrun_count(data->stream),
+                data->write_overrun_count);
+        }
     } else {
         if(worker->read_callback != NULL) {
             // message file_error to worker
@@ -218,6 +325,11 @@ static int32_t lfrfid_raw_read_worker_thread(void* thread_context) {
         }
     }
 
+    // wait for write in flight
+    furi_check(furi_semaphore_acquire(data->write_idle, FuriWaitForever) == FuriStatusOk);
+    furi_work_queue_free(data->work_queue);
+    furi_semaphore_free(data->write_idle);
+
     varint_pair_free(data->pair);
     buffer_stream_free(data->stream);
     lfrfid_raw_file_free(file);
@@ -1,6 +1,7 @@
 #pragma once
 #include <furi.h>
 #include "lfrfid_worker.h"
+#include "lfrfid_raw_file.h"
 #include <toolbox/protocols/protocol_dict.h>
 #include "protocols/lfrfid_protocols.h"
 
@@ -42,6 +43,29 @@ void lfrfid_raw_worker_start_read(
     LFRFIDWorkerReadRawCallback callback,
     void* context);
 
+/**
+ * @brief Start reading with given file encoding
+ * 
+ * Capture is written to the file asynchronously, overruns are reported with
+ * LFRFIDWorkerReadRawOverrun when SD card can't keep up.
+ * 
+ * @param worker LFRFIDRawWorker instance
+ * @param file_path path where file will be saved
+ * @param frequency HW frequency
+ * @param duty_cycle HW duty cycle
+ * @param encoding file data encoding
+ * @param callback callback for read event
+ * @param context context for callback
+ */
+void lfrfid_raw_worker_start_read_ex(
+    LFRFIDRawWorker* worker,
+    const char* file_path,
+    float frequency,
+    float duty_cycle,
+    LFRFIDRawFileEncoding encoding,
+    LFRFIDWorkerReadRawCallback callback,
+    void* context);
+
 /**
  * @brief Start emulate
  * 
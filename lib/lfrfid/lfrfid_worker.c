@@ -95,10 +95,22 @@ void lfrfid_worker_read_raw_start(
     LFRFIDWorkerReadType type,
     LFRFIDWorkerReadRawCallback callback,
     void* context) {
+    lfrfid_worker_read_raw_start_ex(
+        worker, filename, type, LFRFIDRawFileEncodingVarint, callback, context);
+}
+
+void lfrfid_worker_read_raw_start_ex(
+    LFRFIDWorker* worker,
+    const char* filename,
+    LFRFIDWorkerReadType type,
+    LFRFIDRawFileEncoding encoding,
+    LFRFIDWorkerReadRawCallback callback,
+    void* context) {
     furi_check(worker);
     furi_check(worker->mode_index == LFRFIDWorkerIdle);
 
     worker->read_type = type;
+    worker->raw_encoding = encoding;
     worker->read_raw_cb = callback;
     worker->cb_ctx = context;
     lfrfid_worker_set_filename(worker, filename);
@@ -6,6 +6,7 @@
 #pragma once
 #include <toolbox/protocols/protocol_dict.h>
 #include "protocols/lfrfid_protocols.h"
+#include "lfrfid_raw_file.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -124,6 +125,23 @@ void lfrfid_worker_read_raw_start(
     LFRFIDWorkerReadRawCallback callback,
     void* context);
 
+/** Start raw read mode with given file encoding
+ *
+ * @param      worker    The worker
+ * @param      filename  The filename
+ * @param      type      The type
+ * @param      encoding  The file data encoding
+ * @param      callback  The callback
+ * @param      context   The context
+ */
+void lfrfid_worker_read_raw_start_ex(
+    LFRFIDWorker* worker,
+    const char* filename,
+    LFRFIDWorkerReadType type,
+    LFRFIDRawFileEncoding encoding,
+    LFRFIDWorkerReadRawCallback callback,
+    void* context);
+
 /** Emulate raw read mode
  *
  * @param      worker    The worker
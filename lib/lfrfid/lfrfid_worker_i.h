@@ -37,6 +37,7 @@ struct LFRFIDWorker {
     FuriThread* thread;
 
     LFRFIDWorkerReadType read_type;
+    LFRFIDRawFileEncoding raw_encoding;
 
     LFRFIDWorkerReadCallback read_cb;
     LFRFIDWorkerWriteCallback write_cb;
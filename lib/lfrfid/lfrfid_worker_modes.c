@@ -28,6 +28,10 @@
 #define LFRFID_WORKER_READ_STABILIZE_TIME_MS 450
 #define LFRFID_WORKER_READ_SWITCH_TIME_MS    2000
 
+// Carrier is switched without restarting read, decoders of the other modulation can't be fed
+#define LFRFID_WORKER_READ_SLICE_TIME_MS  500
+#define LFRFID_WORKER_READ_SETTLE_TIME_MS 50
+
 #define LFRFID_WORKER_WRITE_VERIFY_TIME_MS   2000
 #define LFRFID_WORKER_WRITE_DROP_TIME_MS     50
 #define LFRFID_WORKER_WRITE_TOO_LONG_TIME_MS 10000
@@ -37,6 +41,9 @@
 #define LFRFID_WORKER_READ_BUFFER_SIZE  512
 #define LFRFID_WORKER_READ_BUFFER_COUNT 16
 
+// FSK subcarrier periods are 64 and 80us, ASK bit periods start from 128us (RF/16)
+#define LFRFID_WORKER_READ_FSK_PERIOD_MAX_US 100
+
 #define LFRFID_WORKER_EMULATE_BUFFER_SIZE 1024
 
 #define LFRFID_WORKER_DELAY_QUANT 50
@@ -88,6 +95,27 @@ static void lfrfid_worker_read_capture(bool level, uint32_t duration, void* cont
     }
 }
 
+// Only feed decoders of the modulation buffer looks like, both if it's unclear
+static uint32_t lfrfid_worker_read_route(uint32_t feature, size_t fsk_count, size_t count) {
+    uint32_t route = feature;
+
+    if(fsk_count * 4 >= count * 3) {
+        route &= ~LFRFIDFeatureASK;
+    } else if(fsk_count * 4 <= count) {
+        route &= ~LFRFIDFeatureFSK;
+    }
+
+    return route ? route : feature;
+}
+
+static void lfrfid_worker_read_carrier_notify(LFRFIDWorker* worker, bool psk) {
+    FURI_LOG_D(TAG, psk ? "Start PSK" : "Start ASK");
+    if(worker->read_cb) {
+        LFRFIDWorkerReadResult result = psk ? LFRFIDWorkerReadStartPSK : LFRFIDWorkerReadStartASK;
+        worker->read_cb(result, PROTOCOL_NO, worker->cb_ctx);
+    }
+}
+
 typedef enum {
     LFRFIDWorkerReadOK,
     LFRFIDWorkerReadExit,
@@ -96,24 +124,23 @@ typedef enum {
 
 static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     LFRFIDWorker* worker,
-    LFRFIDFeature feature,
+    uint32_t feature,
     uint32_t timeout,
     ProtocolId* result_protocol) {
     LFRFIDWorkerReadState state = LFRFIDWorkerReadTimeout;
 
-    if(feature & LFRFIDFeatureASK) {
-        furi_hal_rfid_tim_read_start(125000, 0.5);
-        FURI_LOG_D(TAG, "Start ASK");
-        if(worker->read_cb) {
-            worker->read_cb(LFRFIDWorkerReadStartASK, PROTOCOL_NO, worker->cb_ctx);
-        }
-    } else {
+    const uint32_t feature_ask = feature & (LFRFIDFeatureASK | LFRFIDFeatureFSK);
+    const uint32_t feature_psk = feature & LFRFIDFeaturePSK;
+    // Both modulations requested: one read session, carrier alternates in slices
+    const bool interleave = feature_ask && feature_psk;
+    bool psk = !feature_ask;
+
+    if(psk) {
         furi_hal_rfid_tim_read_start(62500, 0.25);
-        FURI_LOG_D(TAG, "Start PSK");
-        if(worker->read_cb) {
-            worker->read_cb(LFRFIDWorkerReadStartPSK, PROTOCOL_NO, worker->cb_ctx);
-        }
+    } else {
+        furi_hal_rfid_tim_read_start(125000, 0.5);
     }
+    lfrfid_worker_read_carrier_notify(worker, psk);
 
     // stabilize detector
     lfrfid_worker_delay(worker, LFRFID_WORKER_READ_STABILIZE_TIME_MS);
@@ -141,7 +168,12 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     uint8_t* protocol_data = malloc(last_size);
     size_t last_read_count = 0;
 
+    // Every varint pair takes at least 2 bytes and gives 2 level durations
+    LevelDuration* level_durations =
+        malloc(sizeof(LevelDuration) * LFRFID_WORKER_READ_BUFFER_SIZE);
+
     uint32_t switch_os_tick_last = furi_get_tick();
+    uint32_t slice_os_tick_last = switch_os_tick_last;
 
     uint32_t average_duration = 0;
     uint32_t average_pulse = 0;
@@ -180,6 +212,8 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
         size_t size = buffer_get_size(buffer);
         uint8_t* data = buffer_get_data(buffer);
         size_t index = 0;
+        size_t count = 0;
+        size_t fsk_count = 0;
 
         while(index < size) {
             uint32_t duration;
@@ -218,70 +252,82 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
                     }
                 }
 
-                ProtocolId protocol = PROTOCOL_NO;
-
-                protocol = protocol_dict_decoders_feed_by_feature(
-                    worker->protocols, feature, true, pulse);
-                if(protocol == PROTOCOL_NO) {
-                    protocol = protocol_dict_decoders_feed_by_feature(
-                        worker->protocols, feature, false, duration - pulse);
+                if(duration < LFRFID_WORKER_READ_FSK_PERIOD_MAX_US) {
+                    fsk_count++;
                 }
 
-                if(protocol != PROTOCOL_NO) {
-                    // reset switch timer
-                    switch_os_tick_last = furi_get_tick();
-
-                    size_t protocol_data_size =
-                        protocol_dict_get_data_size(worker->protocols, protocol);
-                    protocol_dict_get_data(
-                        worker->protocols, protocol, protocol_data, protocol_data_size);
-
-                    // validate protocol
-                    if(protocol == last_protocol &&
-                       memcmp(last_data, protocol_data, protocol_data_size) == 0) {
-                        last_read_count = last_read_count + 1;
-
-                        size_t validation_count =
-                            protocol_dict_get_validate_count(worker->protocols, protocol);
-
-                        if(last_read_count >= validation_count) {
-                            state = LFRFIDWorkerReadOK;
-                            *result_protocol = protocol;
-                            break;
-                        }
-                    } else {
-                        if(last_protocol == PROTOCOL_NO && worker->read_cb) {
-                            worker->read_cb(
-                                LFRFIDWorkerReadSenseCardStart, protocol, worker->cb_ctx);
-                        }
+                level_durations[count++] = level_duration_make(true, pulse);
+                level_durations[count++] = level_duration_make(false, duration - pulse);
+            }
+        }
 
-                        last_protocol = protocol;
-                        memcpy(last_data, protocol_data, protocol_data_size);
-                        last_read_count = 0;
+        const uint32_t route =
+            psk ? feature_psk : lfrfid_worker_read_route(feature_ask, fsk_count, count / 2);
+        size_t fed = 0;
+
+        while(fed < count) {
+            size_t consumed;
+            ProtocolId protocol = protocol_dict_decoders_feed_by_feature_batch(
+                worker->protocols, route, &level_durations[fed], count - fed, &consumed);
+            fed += consumed;
+
+            if(protocol != PROTOCOL_NO) {
+                // pair remainder is not fed after decoder got ready on pulse
+                if(fed % 2) fed++;
+
+                // reset switch timer, stay on this carrier while tag is being read
+                switch_os_tick_last = furi_get_tick();
+                slice_os_tick_last = switch_os_tick_last;
+
+                size_t protocol_data_size =
+                    protocol_dict_get_data_size(worker->protocols, protocol);
+                protocol_dict_get_data(
+                    worker->protocols, protocol, protocol_data, protocol_data_size);
+
+                // validate protocol
+                if(protocol == last_protocol &&
+                   memcmp(last_data, protocol_data, protocol_data_size) == 0) {
+                    last_read_count = last_read_count + 1;
+
+                    size_t validation_count =
+                        protocol_dict_get_validate_count(worker->protocols, protocol);
+
+                    if(last_read_count >= validation_count) {
+                        state = LFRFIDWorkerReadOK;
+                        *result_protocol = protocol;
+                        break;
+                    }
+                } else {
+                    if(last_protocol == PROTOCOL_NO && worker->read_cb) {
+                        worker->read_cb(LFRFIDWorkerReadSenseCardStart, protocol, worker->cb_ctx);
                     }
 
-                    if(furi_log_get_level() >= FuriLogLevelDebug) {
-                        FuriString* string_info;
-                        string_info = furi_string_alloc();
-                        for(uint8_t i = 0; i < protocol_data_size; i++) {
-                            if(i != 0) {
-                                furi_string_cat_printf(string_info, " ");
-                            }
+                    last_protocol = protocol;
+                    memcpy(last_data, protocol_data, protocol_data_size);
+                    last_read_count = 0;
+                }
 
-                            furi_string_cat_printf(string_info, "%02X", protocol_data[i]);
+                if(furi_log_get_level() >= FuriLogLevelDebug) {
+                    FuriString* string_info;
+                    string_info = furi_string_alloc();
+                    for(uint8_t i = 0; i < protocol_data_size; i++) {
+                        if(i != 0) {
+                            furi_string_cat_printf(string_info, " ");
                         }
 
-                        FURI_LOG_D(
-                            TAG,
-                            "%s, %zu, [%s]",
-                            protocol_dict_get_name(worker->protocols, protocol),
-                            last_read_count,
-                            furi_string_get_cstr(string_info));
-                        furi_string_free(string_info);
+                        furi_string_cat_printf(string_info, "%02X", protocol_data[i]);
                     }
 
-                    protocol_dict_decoders_start(worker->protocols);
+                    FURI_LOG_D(
+                        TAG,
+                        "%s, %zu, [%s]",
+                        protocol_dict_get_name(worker->protocols, protocol),
+                        last_read_count,
+                        furi_string_get_cstr(string_info));
+                    furi_string_free(string_info);
                 }
+
+                protocol_dict_decoders_start(worker->protocols);
             }
         }
 
@@ -299,6 +345,23 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
             state = LFRFIDWorkerReadTimeout;
             break;
         }
+
+        if(interleave &&
+           (furi_get_tick() - slice_os_tick_last) > LFRFID_WORKER_READ_SLICE_TIME_MS) {
+            psk = !psk;
+            if(psk) {
+                furi_hal_rfid_tim_read_set_carrier(62500, 0.25);
+            } else {
+                furi_hal_rfid_tim_read_set_carrier(125000, 0.5);
+            }
+            lfrfid_worker_read_carrier_notify(worker, psk);
+
+            // drop edges of the previous carrier and of the transient
+            lfrfid_worker_delay(worker, LFRFID_WORKER_READ_SETTLE_TIME_MS);
+            buffer_stream_reset(ctx.stream);
+            protocol_dict_decoders_start(worker->protocols);
+            slice_os_tick_last = furi_get_tick();
+        }
     }
 
     FURI_LOG_D(TAG, "Read stopped");
@@ -319,6 +382,7 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     buffer_stream_free(ctx.stream);
 
     free(protocol_data);
+    free(level_durations);
     free(last_data);
 
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
@@ -334,48 +398,29 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
 static void lfrfid_worker_mode_read_process(LFRFIDWorker* worker) {
     ProtocolId read_result = PROTOCOL_NO;
     LFRFIDWorkerReadState state;
-    LFRFIDFeature feature;
+    uint32_t feature;
 
     if(worker->read_type == LFRFIDWorkerReadTypePSKOnly) {
         feature = LFRFIDFeaturePSK;
+    } else if(worker->read_type == LFRFIDWorkerReadTypeASKOnly) {
+        feature = LFRFIDFeatureASK | LFRFIDFeatureFSK;
     } else {
-        feature = LFRFIDFeatureASK;
+        feature = LFRFIDFeatureASK | LFRFIDFeatureFSK | LFRFIDFeaturePSK;
     }
 
-    if(worker->read_type == LFRFIDWorkerReadTypeAuto) {
-        while(1) {
-            // read for a while
+    while(1) {
+        if(worker->read_type == LFRFIDWorkerReadTypePSKOnly) {
             state = lfrfid_worker_read_internal(
                 worker, feature, LFRFID_WORKER_READ_SWITCH_TIME_MS, &read_result);
-
-            if(state == LFRFIDWorkerReadOK || state == LFRFIDWorkerReadExit) {
-                break;
-            }
-
-            // switch to next feature
-            if(feature == LFRFIDFeatureASK) {
-                feature = LFRFIDFeaturePSK;
-            } else {
-                feature = LFRFIDFeatureASK;
-            }
-
-            lfrfid_worker_delay(worker, LFRFID_WORKER_READ_DROP_TIME_MS);
+        } else {
+            state = lfrfid_worker_read_internal(worker, feature, UINT32_MAX, &read_result);
         }
-    } else {
-        while(1) {
-            if(worker->read_type == LFRFIDWorkerReadTypeASKOnly) {
-                state = lfrfid_worker_read_internal(worker, feature, UINT32_MAX, &read_result);
-            } else {
-                state = lfrfid_worker_read_internal(
-                    worker, feature, LFRFID_WORKER_READ_SWITCH_TIME_MS, &read_result);
-            }
-
-            if(state == LFRFIDWorkerReadOK || state == LFRFIDWorkerReadExit) {
-                break;
-            }
 
-            lfrfid_worker_delay(worker, LFRFID_WORKER_READ_DROP_TIME_MS);
+        if(state == LFRFIDWorkerReadOK || state == LFRFIDWorkerReadExit) {
+            break;
         }
+
+        lfrfid_worker_delay(worker, LFRFID_WORKER_READ_DROP_TIME_MS);
     }
 
     if(state == LFRFIDWorkerReadOK && worker->read_cb) {
@@ -583,12 +628,24 @@ static void lfrfid_worker_mode_read_raw_process(LFRFIDWorker* worker) {
 
     switch(worker->read_type) {
     case LFRFIDWorkerReadTypePSKOnly:
-        lfrfid_raw_worker_start_read(
-            raw_worker, worker->raw_filename, 62500, 0.25, worker->read_raw_cb, worker->cb_ctx);
+        lfrfid_raw_worker_start_read_ex(
+            raw_worker,
+            worker->raw_filename,
+            62500,
+            0.25,
+            worker->raw_encoding,
+            worker->read_raw_cb,
+            worker->cb_ctx);
         break;
     case LFRFIDWorkerReadTypeASKOnly:
-        lfrfid_raw_worker_start_read(
-            raw_worker, worker->raw_filename, 125000, 0.5, worker->read_raw_cb, worker->cb_ctx);
+        lfrfid_raw_worker_start_read_ex(
+            raw_worker,
+            worker->raw_filename,
+            125000,
+            0.5,
+            worker->raw_encoding,
+            worker->read_raw_cb,
+            worker->cb_ctx);
         break;
     default:
         furi_crash("RAW can be only PSK or ASK");
@@ -5,6 +5,7 @@
 typedef enum {
     LFRFIDFeatureASK = 1 << 0, /** ASK Demodulation */
     LFRFIDFeaturePSK = 1 << 1, /** PSK Demodulation */
+    LFRFIDFeatureFSK = 1 << 2, /** FSK Demodulation, captured in ASK mode */
 } LFRFIDFeature;
 
 typedef enum {
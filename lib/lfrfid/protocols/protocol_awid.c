@@ -245,7 +245,7 @@ const ProtocolBase protocol_awid = {
     .name = "AWID",
     .manufacturer = "AWID",
     .data_size = AWID_DECODED_DATA_SIZE,
-    .features = LFRFIDFeatureASK,
+    .features = LFRFIDFeatureFSK,
     .validate_count = 3,
     .alloc = (ProtocolAlloc)protocol_awid_alloc,
     .free = (ProtocolFree)protocol_awid_free,
@@ -267,7 +267,7 @@ const ProtocolBase protocol_hid_generic = {
     .name = "HIDProx",
     .manufacturer = "Generic",
     .data_size = HID_DECODED_DATA_SIZE,
-    .features = LFRFIDFeatureASK,
+    .features = LFRFIDFeatureFSK,
     .validate_count = 6,
     .alloc = (ProtocolAlloc)protocol_hid_generic_alloc,
     .free = (ProtocolFree)protocol_hid_generic_free,
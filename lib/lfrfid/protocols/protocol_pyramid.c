@@ -262,7 +262,7 @@ const ProtocolBase protocol_pyramid = {
     .name = "Pyramid",
     .manufacturer = "Farpointe",
     .data_size = PYRAMID_DECODED_DATA_SIZE,
-    .features = LFRFIDFeatureASK,
+    .features = LFRFIDFeatureFSK,
     .validate_count = 3,
     .alloc = (ProtocolAlloc)protocol_pyramid_alloc,
     .free = (ProtocolFree)protocol_pyramid_free,
@@ -0,0 +1,143 @@
+/**
+ * ECDSA verification with PKA
+ *
+ * Replaces mbedtls_ecdsa_verify when MBEDTLS_ECDSA_VERIFY_ALT is set in
+ * mbedtls_cfg.h. NIST P-256 goes to the hardware, other curves and the case
+ * of PKA being busy with core2 are handled in software with mbedTLS bignum.
+ */
+#include <mbedtls/ecdsa.h>
+#include <mbedtls/bignum.h>
+#include <mbedtls/error.h>
+
+#include <furi_hal_pka.h>
+
+#if defined(MBEDTLS_ECDSA_VERIFY_ALT)
+
+/* Hash to integer conversion, SEC1 4.1.4 step 3 and 5 */
+static int ecdsa_alt_derive_mpi(
+    const mbedtls_ecp_group* grp,
+    mbedtls_mpi* x,
+    const unsigned char* buf,
+    size_t blen) {
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    const size_t n_size = (grp->nbits + 7) / 8;
+    const size_t use_size = blen > n_size ? n_size : blen;
+
+    MBEDTLS_MPI_CHK(mbedtls_mpi_read_binary(x, buf, use_size));
+    if(use_size * 8 > grp->nbits) {
+        MBEDTLS_MPI_CHK(mbedtls_mpi_shift_r(x, use_size * 8 - grp->nbits));
+    }
+    if(mbedtls_mpi_cmp_mpi(x, &grp->N) >= 0) {
+        MBEDTLS_MPI_CHK(mbedtls_mpi_sub_mpi(x, x, &grp->N));
+    }
+
+cleanup:
+    return ret;
+}
+
+static int ecdsa_alt_verify_pka(
+    mbedtls_ecp_group* grp,
+    const mbedtls_mpi* e,
+    const mbedtls_ecp_point* Q,
+    const mbedtls_mpi* r,
+    const mbedtls_mpi* s,
+    FuriHalPkaStatus* status) {
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    uint8_t public_key[FURI_HAL_PKA_P256_SIZE * 2];
+    uint8_t hash[FURI_HAL_PKA_P256_SIZE];
+    uint8_t signature[FURI_HAL_PKA_P256_SIZE * 2];
+
+    MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(&Q->X, public_key, FURI_HAL_PKA_P256_SIZE));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(
+        &Q->Y, public_key + FURI_HAL_PKA_P256_SIZE, FURI_HAL_PKA_P256_SIZE));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(e, hash, sizeof(hash)));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(r, signature, FURI_HAL_PKA_P256_SIZE));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_write_binary(
+        s, signature + FURI_HAL_PKA_P256_SIZE, FURI_HAL_PKA_P256_SIZE));
+
+    *status = furi_hal_pka_ecdsa_verify_p256(public_key, hash, signature);
+    ret = (*status == FuriHalPkaStatusError) ? MBEDTLS_ERR_ECP_VERIFY_FAILED : 0;
+
+cleanup:
+    (void)grp;
+    return ret;
+}
+
+static int ecdsa_alt_verify_software(
+    mbedtls_ecp_group* grp,
+    const mbedtls_mpi* e,
+    const mbedtls_ecp_point* Q,
+    const mbedtls_mpi* r,
+    const mbedtls_mpi* s) {
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_mpi s_inv, u1, u2;
+    mbedtls_ecp_point R;
+
+    mbedtls_ecp_point_init(&R);
+    mbedtls_mpi_init(&s_inv);
+    mbedtls_mpi_init(&u1);
+    mbedtls_mpi_init(&u2);
+
+    // u1 = e / s mod n, u2 = r / s mod n
+    MBEDTLS_MPI_CHK(mbedtls_mpi_inv_mod(&s_inv, s, &grp->N));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&u1, e, &s_inv));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(&u1, &u1, &grp->N));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_mul_mpi(&u2, r, &s_inv));
+    MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(&u2, &u2, &grp->N));
+
+    // R = u1 G + u2 Q, signature is valid if R.x mod n equals r
+    MBEDTLS_MPI_CHK(mbedtls_ecp_muladd(grp, &R, &u1, &grp->G, &u2, Q));
+    if(mbedtls_ecp_is_zero(&R)) {
+        ret = MBEDTLS_ERR_ECP_VERIFY_FAILED;
+        goto cleanup;
+    }
+    MBEDTLS_MPI_CHK(mbedtls_mpi_mod_mpi(&R.X, &R.X, &grp->N));
+    if(mbedtls_mpi_cmp_mpi(&R.X, r) != 0) {
+        ret = MBEDTLS_ERR_ECP_VERIFY_FAILED;
+    }
+
+cleanup:
+    mbedtls_ecp_point_free(&R);
+    mbedtls_mpi_free(&s_inv);
+    mbedtls_mpi_free(&u1);
+    mbedtls_mpi_free(&u2);
+    return ret;
+}
+
+int mbedtls_ecdsa_verify(
+    mbedtls_ecp_group* grp,
+    const unsigned char* buf,
+    size_t blen,
+    const mbedtls_ecp_point* Q,
+    const mbedtls_mpi* r,
+    const mbedtls_mpi* s) {
+    int ret = MBEDTLS_ERR_ERROR_CORRUPTION_DETECTED;
+    mbedtls_mpi e;
+
+    if(!mbedtls_ecdsa_can_do(grp->id) || grp->N.p == NULL) {
+        return MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+
+    // Step 1: make sure r and s are in range 1..n-1
+    if(mbedtls_mpi_cmp_int(r, 1) < 0 || mbedtls_mpi_cmp_mpi(r, &grp->N) >= 0 ||
+       mbedtls_mpi_cmp_int(s, 1) < 0 || mbedtls_mpi_cmp_mpi(s, &grp->N) >= 0) {
+        return MBEDTLS_ERR_ECP_VERIFY_FAILED;
+    }
+
+    mbedtls_mpi_init(&e);
+    MBEDTLS_MPI_CHK(ecdsa_alt_derive_mpi(grp, &e, buf, blen));
+
+    FuriHalPkaStatus status = FuriHalPkaStatusBusy;
+    if(grp->id == MBEDTLS_ECP_DP_SECP256R1) {
+        MBEDTLS_MPI_CHK(ecdsa_alt_verify_pka(grp, &e, Q, r, s, &status));
+    }
+    if(status == FuriHalPkaStatusBusy) {
+        MBEDTLS_MPI_CHK(ecdsa_alt_verify_software(grp, &e, Q, r, s));
+    }
+
+cleanup:
+    mbedtls_mpi_free(&e);
+    return ret;
+}
+
+#endif /* MBEDTLS_ECDSA_VERIFY_ALT */
@@ -49,6 +49,9 @@
 
 #define MBEDTLS_ECP_NIST_OPTIM
 
+/* ECDSA verification on P-256 is done by PKA, see mbedtls_alt/ecdsa_alt.c */
+#define MBEDTLS_ECDSA_VERIFY_ALT
+
 #define MBEDTLS_GENPRIME
 // #define MBEDTLS_PKCS1_V15
 // #define MBEDTLS_PKCS1_V21
@@ -13,6 +13,21 @@
 #define MJS_ARRAY_BUF_RESERVE 100
 #endif
 
+/*
+ * Each buffer in mjs->array_buffers is a varint byte length, a kind byte and
+ * either the data itself or a struct mjs_array_buf_external.
+ */
+enum mjs_array_buf_kind {
+    MJS_ARRAY_BUF_INLINE,
+    MJS_ARRAY_BUF_EXTERNAL,
+};
+
+struct mjs_array_buf_external {
+    char* data;
+    mjs_array_buf_free_t free_cb;
+    void* context;
+};
+
 #define IS_SIGNED(type) \
     (type == MJS_DATAVIEW_I8 || type == MJS_DATAVIEW_I16 || type == MJS_DATAVIEW_I32)
 
@@ -40,12 +55,27 @@ char* mjs_array_buf_get_ptr(struct mjs* mjs, mjs_val_t buf, size_t* bytelen) {
         if(bytelen) {
             *bytelen = len;
         }
-        return ptr + header_len;
+        if(ptr[header_len] == MJS_ARRAY_BUF_EXTERNAL) {
+            struct mjs_array_buf_external ext;
+            memcpy(&ext, ptr + header_len + 1, sizeof(ext));
+            return ext.data;
+        }
+        return ptr + header_len + 1;
     }
 
     return NULL;
 }
 
+char* mjs_typed_array_get_ptr(struct mjs* mjs, mjs_val_t v, size_t* bytelen) {
+    if(mjs_is_data_view(v)) {
+        v = mjs_dataview_get_buf(mjs, v);
+    }
+    if(!mjs_is_array_buf(v)) {
+        return NULL;
+    }
+    return mjs_array_buf_get_ptr(mjs, v, bytelen);
+}
+
 static size_t mjs_dataview_get_element_len(mjs_dataview_type_t type) {
     size_t len = 1;
     switch(type) {
@@ -202,13 +232,14 @@ mjs_val_t mjs_mk_array_buf(struct mjs* mjs, char* data, size_t buf_len) {
     size_t offset = m->len;
     char* prev_buf = m->buf;
 
-    size_t header_len = cs_varint_llen(buf_len);
+    size_t header_len = cs_varint_llen(buf_len) + 1;
     mbuf_insert(m, offset, NULL, header_len + buf_len);
     if(data >= prev_buf && data < (prev_buf + m->len)) {
         data += m->buf - prev_buf;
     }
 
-    cs_varint_encode(buf_len, (unsigned char*)m->buf + offset, header_len);
+    cs_varint_encode(buf_len, (unsigned char*)m->buf + offset, header_len - 1);
+    m->buf[offset + header_len - 1] = MJS_ARRAY_BUF_INLINE;
 
     if(data != NULL) {
         memcpy(m->buf + offset + header_len, data, buf_len);
@@ -219,6 +250,53 @@ mjs_val_t mjs_mk_array_buf(struct mjs* mjs, char* data, size_t buf_len) {
     return (offset & ~MJS_TAG_MASK) | MJS_TAG_ARRAY_BUF;
 }
 
+mjs_val_t mjs_mk_array_buf_external(
+    struct mjs* mjs,
+    char* data,
+    size_t buf_len,
+    mjs_array_buf_free_t free_cb,
+    void* context) {
+    struct mbuf* m = &mjs->array_buffers;
+    const struct mjs_array_buf_external ext = {
+        .data = data,
+        .free_cb = free_cb,
+        .context = context,
+    };
+
+    size_t offset = m->len;
+    size_t varint_len = cs_varint_llen(buf_len);
+    mbuf_insert(m, offset, NULL, varint_len + 1 + sizeof(ext));
+
+    cs_varint_encode(buf_len, (unsigned char*)m->buf + offset, varint_len);
+    m->buf[offset + varint_len] = MJS_ARRAY_BUF_EXTERNAL;
+    memcpy(m->buf + offset + varint_len + 1, &ext, sizeof(ext));
+
+    return (offset & ~MJS_TAG_MASK) | MJS_TAG_ARRAY_BUF;
+}
+
+void mjs_array_buf_release_all(struct mjs* mjs) {
+    struct mbuf* m = &mjs->array_buffers;
+    size_t offset = 0;
+
+    while(offset < m->len) {
+        uint64_t len = 0;
+        size_t varint_len = 0;
+        if(!cs_varint_decode((uint8_t*)m->buf + offset, m->len - offset, &len, &varint_len)) {
+            break;
+        }
+        offset += varint_len;
+
+        if(m->buf[offset] == MJS_ARRAY_BUF_EXTERNAL) {
+            struct mjs_array_buf_external ext;
+            memcpy(&ext, m->buf + offset + 1, sizeof(ext));
+            if(ext.free_cb) ext.free_cb(mjs, ext.data, ext.context);
+            offset += 1 + sizeof(ext);
+        } else {
+            offset += 1 + len;
+        }
+    }
+}
+
 void mjs_array_buf_slice(struct mjs* mjs) {
     size_t nargs = mjs_nargs(mjs);
     mjs_val_t src = mjs_get_this(mjs);
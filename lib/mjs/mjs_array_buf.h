@@ -22,6 +22,11 @@ mjs_val_t mjs_dataview_get_len(struct mjs* mjs, mjs_val_t obj);
 
 void mjs_array_buf_slice(struct mjs* mjs);
 
+/*
+ * Call free callbacks of all external ArrayBuffers, on interpreter destroy
+ */
+void mjs_array_buf_release_all(struct mjs* mjs);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
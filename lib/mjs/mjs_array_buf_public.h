@@ -28,10 +28,34 @@ int mjs_is_typed_array(mjs_val_t v);
 
 mjs_val_t mjs_mk_array_buf(struct mjs* mjs, char* data, size_t buf_len);
 
+/*
+ * Called when memory of an external ArrayBuffer is no longer referenced by
+ * the interpreter.
+ */
+typedef void (*mjs_array_buf_free_t)(struct mjs* mjs, char* data, void* context);
+
+/*
+ * Make an ArrayBuffer backed by native memory, without copying it. `data`
+ * must stay valid until `free_cb` is called, which happens when the
+ * interpreter is destroyed. `free_cb` can be NULL.
+ */
+mjs_val_t mjs_mk_array_buf_external(
+    struct mjs* mjs,
+    char* data,
+    size_t buf_len,
+    mjs_array_buf_free_t free_cb,
+    void* context);
+
 char* mjs_array_buf_get_ptr(struct mjs* mjs, mjs_val_t buf, size_t* bytelen);
 
 mjs_val_t mjs_dataview_get_buf(struct mjs* mjs, mjs_val_t obj);
 
+/*
+ * Get data pointer and byte length of an ArrayBuffer or of the buffer behind
+ * a typed array. Returns NULL if `v` is neither.
+ */
+char* mjs_typed_array_get_ptr(struct mjs* mjs, mjs_val_t v, size_t* bytelen);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
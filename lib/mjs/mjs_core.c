@@ -6,6 +6,7 @@
 #include "common/cs_varint.h"
 #include "common/str_util.h"
 
+#include "mjs_array_buf.h"
 #include "mjs_bcode.h"
 #include "mjs_builtin.h"
 #include "mjs_core.h"
@@ -60,6 +61,7 @@ void mjs_destroy(struct mjs* mjs) {
     mbuf_free(&mjs->scopes);
     mbuf_free(&mjs->loop_addresses);
     mbuf_free(&mjs->json_visited_stack);
+    mjs_array_buf_release_all(mjs);
     mbuf_free(&mjs->array_buffers);
     free(mjs->error_msg);
     free(mjs->stack_trace);
@@ -60,6 +60,21 @@ struct mjs_bcode_part {
     unsigned in_rom : 1;
 };
 
+#ifndef MJS_PROP_CACHE_BITS
+#define MJS_PROP_CACHE_BITS 5
+#endif
+#define MJS_PROP_CACHE_SIZE (1 << MJS_PROP_CACHE_BITS)
+
+/*
+ * Entry of the property lookup cache: a direct-mapped table of recently found
+ * own properties, indexed by hash of object and property name. It doesn't hold
+ * references, so it is flushed whenever a property may go away.
+ */
+struct mjs_prop_cache_entry {
+    struct mjs_object* obj;
+    struct mjs_property* prop;
+};
+
 struct mjs {
     struct mbuf bcode_gen;
     struct mbuf bcode_parts;
@@ -89,6 +104,16 @@ struct mjs {
     struct gc_arena property_arena;
     struct gc_arena ffi_sig_arena;
 
+    struct mjs_prop_cache_entry prop_cache[MJS_PROP_CACHE_SIZE];
+
+    /* GC counters, see struct mjs_gc_stats */
+    uint32_t gc_count;
+    uint32_t gc_last_pause_us;
+    uint32_t gc_max_pause_us;
+    uint64_t gc_total_pause_us;
+    /* Cells and owned strings allocated since last GC */
+    size_t gc_allocs;
+
     unsigned inhibit_gc : 1;
     unsigned need_gc : 1;
     unsigned generate_jsc : 1;
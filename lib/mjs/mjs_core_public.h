@@ -257,8 +257,9 @@ const char* mjs_get_stack_trace(struct mjs* mjs);
  * Sets whether *.jsc files are generated when *.js file is executed. By
  * default it's 0.
  *
- * If either `MJS_GENERATE_JSC` or `CS_MMAP` is off, then this function has no
- * effect.
+ * With `MJS_JSC_CACHE` on, *.jsc files are used as a bcode cache instead, see
+ * mjs_features.h. If neither `MJS_JSC_CACHE` nor `MJS_GENERATE_JSC` with
+ * `CS_MMAP` is on, then this function has no effect.
  */
 void mjs_set_generate_jsc(struct mjs* mjs, int generate_jsc);
 
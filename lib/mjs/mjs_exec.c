@@ -200,6 +200,7 @@ static void op_assign(struct mjs* mjs, int op) {
     mjs_val_t obj = mjs_pop(mjs);
     mjs_val_t key = mjs_pop(mjs);
     if(mjs_is_object(obj) && mjs_is_string(key)) {
+        mjs_lazy_object_load(mjs, obj);
         mjs_val_t v = mjs_get_v(mjs, obj, key);
         mjs_set_v(mjs, obj, key, do_op(mjs, v, val, op));
         mjs_push(mjs, v);
@@ -316,6 +317,7 @@ static void exec_expr(struct mjs* mjs, int op) {
         mjs_val_t obj = mjs_pop(mjs);
         mjs_val_t key = mjs_pop(mjs);
         if(mjs_is_object(obj)) {
+            mjs_lazy_object_load(mjs, obj);
             mjs_set_v(mjs, obj, key, val);
         } else if(mjs_is_data_view(obj)) {
             mjs_err_t err = mjs_dataview_set_prop(mjs, obj, key, val);
@@ -768,6 +770,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
 
             if(!getprop_builtin(mjs, obj, key, &val)) {
                 if(mjs_is_object(obj)) {
+                    mjs_lazy_object_load(mjs, obj);
                     val = mjs_get_v_proto(mjs, obj, key);
                 } else if((mjs_is_data_view(obj) && (mjs_is_number(key)))) {
                     val = mjs_dataview_get_prop(mjs, obj, key);
@@ -1169,6 +1172,139 @@ MJS_PRIVATE mjs_err_t mjs_exec_internal(
     return mjs->error;
 }
 
+#if MJS_JSC_CACHE
+/* "MJSC" */
+#define MJS_JSC_MAGIC 0x43534a4dUL
+/* Bump on any bcode layout change not covered by MJS_JSC_VERSION */
+#define MJS_JSC_FORMAT 1
+#define MJS_JSC_VERSION \
+    ((MJS_JSC_FORMAT << 16) | ((uint32_t)OP_MAX << 8) | sizeof(mjs_header_item_t))
+
+struct mjs_jsc_header {
+    uint32_t magic;
+    uint32_t version;
+    /* Hash of the script path and source, bcode embeds the path as well */
+    uint32_t key;
+    uint32_t bcode_len;
+};
+
+/* FNV-1a */
+static uint32_t mjs_jsc_hash(uint32_t hash, const char* data, size_t len) {
+    for(size_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)data[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+/*
+ * Returns allocated .jsc file name for a .js file, or NULL for anything else
+ */
+static char* mjs_jsc_path(const char* path) {
+    const char* jsext = ".js";
+    const size_t path_len = strlen(path);
+    if(path_len <= strlen(jsext) || strcmp(path + path_len - strlen(jsext), jsext) != 0) {
+        return NULL;
+    }
+
+    char* jsc_path = malloc(path_len + 2);
+    memcpy(jsc_path, path, path_len);
+    strcpy(jsc_path + path_len, "c");
+    return jsc_path;
+}
+
+/*
+ * Adds bcode from .jsc file as a next bcode part. Returns 1 on success, 0 if
+ * there's no usable .jsc file.
+ */
+static int mjs_jsc_load(struct mjs* mjs, const char* jsc_path, uint32_t key) {
+    struct mjs_jsc_header header;
+    size_t size = 0;
+    char* data = cs_read_file(jsc_path, &size);
+    if(data == NULL) return 0;
+
+    int valid = 0;
+    if(size > sizeof(header)) {
+        memcpy(&header, data, sizeof(header));
+        valid = header.magic == MJS_JSC_MAGIC && header.version == MJS_JSC_VERSION &&
+                header.key == key && header.bcode_len == size - sizeof(header) &&
+                data[sizeof(header)] == OP_BCODE_HEADER;
+    }
+
+    if(!valid) {
+        LOG(LL_DEBUG, ("Stale %s", jsc_path));
+        free(data);
+        return 0;
+    }
+
+    /* Reuse the file buffer for bcode, it is freed along with the bcode part */
+    memmove(data, data + sizeof(header), header.bcode_len);
+
+    struct mjs_bcode_part bp;
+    memset(&bp, 0, sizeof(bp));
+    bp.data.p = data;
+    bp.data.len = header.bcode_len;
+    bp.start_idx = mjs->bcode_len;
+    bp.exec_res = MJS_ERRS_CNT;
+    mjs_bcode_part_add(mjs, &bp);
+    mjs->bcode_len += bp.data.len;
+
+    return 1;
+}
+
+/*
+ * Writes last bcode part to .jsc file
+ */
+static void mjs_jsc_save(struct mjs* mjs, const char* jsc_path, uint32_t key) {
+    const struct mjs_bcode_part* bp = mjs_bcode_part_get(mjs, mjs_bcode_parts_cnt(mjs) - 1);
+    const struct mjs_jsc_header header = {
+        .magic = MJS_JSC_MAGIC,
+        .version = MJS_JSC_VERSION,
+        .key = key,
+        .bcode_len = bp->data.len,
+    };
+
+    char* data = malloc(sizeof(header) + bp->data.len);
+    memcpy(data, &header, sizeof(header));
+    memcpy(data + sizeof(header), bp->data.p, bp->data.len);
+    if(cs_write_file(jsc_path, data, sizeof(header) + bp->data.len) != 0) {
+        LOG(LL_WARN, ("Failed to write %s", jsc_path));
+    }
+    free(data);
+}
+
+static mjs_err_t mjs_exec_cached(
+    struct mjs* mjs,
+    const char* path,
+    const char* src,
+    size_t src_len,
+    mjs_val_t* res) {
+    char* jsc_path = mjs_jsc_path(path);
+    if(jsc_path == NULL) {
+        return mjs_exec_internal(mjs, path, src, 0 /* generate_jsc */, res);
+    }
+
+    size_t off = mjs->bcode_len;
+    mjs_val_t r = MJS_UNDEFINED;
+    uint32_t key = mjs_jsc_hash(2166136261UL, path, strlen(path) + 1);
+    key = mjs_jsc_hash(key, src, src_len);
+
+    if(mjs_jsc_load(mjs, jsc_path, key)) {
+        mjs->error = MJS_OK;
+    } else {
+        mjs->error = mjs_parse(path, src, mjs);
+        if(mjs->error == MJS_OK) mjs_jsc_save(mjs, jsc_path, key);
+    }
+    free(jsc_path);
+
+    if(mjs->error == MJS_OK) {
+        mjs_execute(mjs, off, &r);
+    }
+    if(res != NULL) *res = r;
+    return mjs->error;
+}
+#endif
+
 mjs_err_t mjs_exec(struct mjs* mjs, const char* src, mjs_val_t* res) {
     return mjs_exec_internal(mjs, "<stdin>", src, 0 /* generate_jsc */, res);
 }
@@ -1186,7 +1322,14 @@ mjs_err_t mjs_exec_file(struct mjs* mjs, const char* path, mjs_val_t* res) {
     }
 
     r = MJS_UNDEFINED;
-    error = mjs_exec_internal(mjs, path, source_code, -1, &r);
+#if MJS_JSC_CACHE
+    if(mjs->generate_jsc) {
+        error = mjs_exec_cached(mjs, path, source_code, size, &r);
+    } else
+#endif
+    {
+        error = mjs_exec_internal(mjs, path, source_code, -1, &r);
+    }
     free(source_code);
 
 clean:
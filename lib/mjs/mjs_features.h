@@ -30,4 +30,21 @@
 #endif
 #endif
 
+/*
+ * MJS_JSC_CACHE: if enabled, and if generate_jsc is set with
+ * mjs_set_generate_jsc(), then execution of any .js file will store its bcode
+ * in a .jsc file next to it. On later runs the bcode is read from that file
+ * instead of parsing the source, as long as the source and the bcode format
+ * are unchanged. Unlike MJS_GENERATE_JSC, bcode is kept in RAM.
+ *
+ * By default it's enabled when MJS_GENERATE_JSC is not available
+ */
+#if !defined(MJS_JSC_CACHE)
+#if MJS_GENERATE_JSC
+#define MJS_JSC_CACHE 0
+#else
+#define MJS_JSC_CACHE 1
+#endif
+#endif
+
 #endif /* MJS_FEATURES_H_ */
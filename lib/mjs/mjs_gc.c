@@ -16,6 +16,8 @@
 #include "mjs_primitive.h"
 #include "mjs_string.h"
 
+#include <furi_hal_cortex.h>
+
 /*
  * Macros for marking reachable things: use bit 0.
  */
@@ -37,6 +39,11 @@
  */
 #define GC_ARENA_CELLS_RESERVE 2
 
+/*
+ * Idle GC is performed after that many allocations since the last GC
+ */
+#define GC_IDLE_ALLOCS 64
+
 static struct gc_block* gc_new_block(struct gc_arena* a, size_t size);
 static void gc_free_block(struct gc_block* b);
 static void gc_mark_mbuf_pt(struct mjs* mjs, const struct mbuf* mbuf);
@@ -141,6 +148,7 @@ MJS_PRIVATE void* gc_alloc_cell(struct mjs* mjs, struct gc_arena* a) {
     UNMARK(r);
 
     a->free = r->head.link;
+    mjs->gc_allocs++;
 
 #if MJS_MEMORY_STATS
     a->allocations++;
@@ -485,6 +493,10 @@ static void gc_mark_ffi_cbargs_list(struct mjs* mjs, ffi_cb_args_t* cbargs) {
 
 /* Perform garbage collection */
 void mjs_gc(struct mjs* mjs, int full) {
+    const uint32_t start = furi_hal_cortex_timer_get(0).start;
+
+    mjs_prop_cache_flush(mjs);
+
     gc_mark_val_array(mjs, (mjs_val_t*)&mjs->vals, sizeof(mjs->vals) / sizeof(mjs_val_t));
 
     gc_mark_mbuf_pt(mjs, &mjs->owned_values);
@@ -511,6 +523,45 @@ void mjs_gc(struct mjs* mjs, int full) {
             mbuf_resize(&mjs->owned_strings, trimmed_size);
         }
     }
+
+    const uint32_t pause_us = (furi_hal_cortex_timer_get(0).start - start) /
+                              furi_hal_cortex_instructions_per_microsecond();
+    mjs->gc_count++;
+    mjs->gc_last_pause_us = pause_us;
+    if(pause_us > mjs->gc_max_pause_us) mjs->gc_max_pause_us = pause_us;
+    mjs->gc_total_pause_us += pause_us;
+    mjs->gc_allocs = 0;
+}
+
+int mjs_gc_idle(struct mjs* mjs) {
+    if(!mjs->need_gc && mjs->gc_allocs < GC_IDLE_ALLOCS) return 0;
+    if(!maybe_gc(mjs)) return 0;
+    mjs->need_gc = 0;
+    return 1;
+}
+
+static void gc_arena_usage(const struct gc_arena* a, size_t* used, size_t* total) {
+    size_t free_cells = 0;
+    *total = 0;
+    for(const struct gc_block* b = a->blocks; b != NULL; b = b->next) {
+        *total += b->size;
+    }
+    for(const struct gc_cell* c = a->free; c != NULL; c = c->head.link) {
+        free_cells++;
+    }
+    *used = *total - free_cells;
+}
+
+void mjs_get_gc_stats(struct mjs* mjs, struct mjs_gc_stats* stats) {
+    stats->count = mjs->gc_count;
+    stats->last_pause_us = mjs->gc_last_pause_us;
+    stats->max_pause_us = mjs->gc_max_pause_us;
+    stats->total_pause_us = mjs->gc_total_pause_us;
+
+    gc_arena_usage(&mjs->object_arena, &stats->objects_used, &stats->objects_total);
+    gc_arena_usage(&mjs->property_arena, &stats->properties_used, &stats->properties_total);
+    stats->strings_used = mjs->owned_strings.len;
+    stats->strings_size = mjs->owned_strings.size;
 }
 
 MJS_PRIVATE int gc_check_val(struct mjs* mjs, mjs_val_t v) {
@@ -18,6 +18,37 @@ extern "C" {
  */
 void mjs_gc(struct mjs* mjs, int full);
 
+/*
+ * Perform garbage collection if it is due or enough allocations were made
+ * since the last one. Meant to be called while the script is idle, e.g. from
+ * an event loop, so that collection doesn't happen later amid event handling.
+ * Returns 1 if collection was performed.
+ */
+int mjs_gc_idle(struct mjs* mjs);
+
+/*
+ * Garbage collector statistics: pause times are measured in microseconds,
+ * arena usage is counted in cells.
+ */
+struct mjs_gc_stats {
+    uint32_t count; /* Number of collections performed */
+    uint32_t last_pause_us;
+    uint32_t max_pause_us;
+    uint64_t total_pause_us;
+
+    size_t objects_used;
+    size_t objects_total;
+    size_t properties_used;
+    size_t properties_total;
+    size_t strings_used; /* Bytes of owned strings buffer in use */
+    size_t strings_size; /* Bytes allocated for owned strings buffer */
+};
+
+/*
+ * Fill `stats` with current garbage collector statistics.
+ */
+void mjs_get_gc_stats(struct mjs* mjs, struct mjs_gc_stats* stats);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
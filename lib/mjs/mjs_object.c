@@ -64,10 +64,27 @@ int mjs_is_object_based(mjs_val_t v) {
            ((v & MJS_TAG_MASK) == MJS_TAG_ARRAY_BUF_VIEW);
 }
 
+MJS_PRIVATE void mjs_prop_cache_flush(struct mjs* mjs) {
+    memset(mjs->prop_cache, 0, sizeof(mjs->prop_cache));
+}
+
+static struct mjs_prop_cache_entry*
+    mjs_prop_cache_get(struct mjs* mjs, struct mjs_object* o, const char* name, size_t len) {
+    /* FNV-1a over the name, seeded with the object address */
+    uint32_t hash = 2166136261UL ^ (uint32_t)(uintptr_t)o;
+    for(size_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619UL;
+    }
+    hash ^= hash >> 16;
+    return &mjs->prop_cache[hash & (MJS_PROP_CACHE_SIZE - 1)];
+}
+
 MJS_PRIVATE struct mjs_property*
     mjs_get_own_property(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
     struct mjs_property* p;
     struct mjs_object* o;
+    struct mjs_prop_cache_entry* entry;
 
     if(!mjs_is_object_based(obj)) {
         return NULL;
@@ -75,19 +92,68 @@ MJS_PRIVATE struct mjs_property*
 
     o = get_object_struct(obj);
 
+    /* Hot properties and scope variables take a single compare */
+    entry = mjs_prop_cache_get(mjs, o, name, len);
+    if(entry->obj == o && mjs_strcmp(mjs, &entry->prop->name, name, len) == 0) {
+        return entry->prop;
+    }
+
     if(len <= 5) {
         mjs_val_t ss = mjs_mk_string(mjs, name, len, 1);
         for(p = o->properties; p != NULL; p = p->next) {
-            if(p->name == ss) return p;
+            if(p->name == ss) break;
         }
     } else {
         for(p = o->properties; p != NULL; p = p->next) {
-            if(mjs_strcmp(mjs, &p->name, name, len) == 0) return p;
+            if(mjs_strcmp(mjs, &p->name, name, len) == 0) break;
         }
-        return p;
     }
 
-    return NULL;
+    if(p != NULL) {
+        entry->obj = o;
+        entry->prop = p;
+    }
+
+    return p;
+}
+
+/* Hidden properties of a lazy object, always the first two in its list */
+#define MJS_LAZY_LOADER_PROP_NAME  "__l"
+#define MJS_LAZY_CONTEXT_PROP_NAME "__lc"
+
+mjs_val_t mjs_mk_lazy_object(struct mjs* mjs, mjs_lazy_object_loader_t loader, void* context) {
+    mjs_val_t obj = mjs_mk_object(mjs);
+    mjs_set(mjs, obj, MJS_LAZY_CONTEXT_PROP_NAME, ~0, mjs_mk_foreign(mjs, context));
+    mjs_set(
+        mjs, obj, MJS_LAZY_LOADER_PROP_NAME, ~0, mjs_mk_foreign_func(mjs, (mjs_func_ptr_t)loader));
+    return obj;
+}
+
+MJS_PRIVATE void mjs_lazy_object_load(struct mjs* mjs, mjs_val_t obj) {
+    struct mjs_object* o = get_object_struct(obj);
+    struct mjs_property* loader_prop = o->properties;
+
+    /* Short names are inlined into the value, so this is a single compare */
+    if(loader_prop == NULL ||
+       loader_prop->name != mjs_mk_string(mjs, MJS_LAZY_LOADER_PROP_NAME, ~0, 1)) {
+        return;
+    }
+
+    struct mjs_property* context_prop = loader_prop->next;
+    mjs_lazy_object_loader_t loader = mjs_get_ptr(mjs, loader_prop->value);
+    void* context = mjs_get_ptr(mjs, context_prop->value);
+
+    /* Unlink hidden properties first, so the loader can't be entered twice */
+    o->properties = context_prop->next;
+    mjs_prop_cache_flush(mjs);
+
+    mjs_val_t loaded = loader(mjs, context);
+    if(mjs_is_object(loaded)) {
+        struct mjs_object* src = get_object_struct(loaded);
+        o->properties = src->properties;
+        src->properties = NULL;
+        mjs_prop_cache_flush(mjs);
+    }
 }
 
 MJS_PRIVATE struct mjs_property*
@@ -252,6 +318,7 @@ int mjs_del(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
                 get_object_struct(obj)->properties = prop->next;
             }
             mjs_destroy_property(&prop);
+            mjs_prop_cache_flush(mjs);
             return 0;
         }
     }
@@ -32,6 +32,18 @@ MJS_PRIVATE struct mjs_property*
 MJS_PRIVATE struct mjs_property*
     mjs_get_own_property_v(struct mjs* mjs, mjs_val_t obj, mjs_val_t key);
 
+/*
+ * Drops all entries of the property lookup cache. Must be called when any
+ * property is unlinked from its object, and before GC frees anything.
+ */
+MJS_PRIVATE void mjs_prop_cache_flush(struct mjs* mjs);
+
+/*
+ * Runs the loader of a lazy object made by `mjs_mk_lazy_object()`, does
+ * nothing for other objects
+ */
+MJS_PRIVATE void mjs_lazy_object_load(struct mjs* mjs, mjs_val_t obj);
+
 /*
  * A worker function for `mjs_set()` and `mjs_set_v()`: it takes name as both
  * ptr+len and mjs_val_t. If `name` pointer is not NULL, it takes precedence
@@ -127,6 +127,20 @@ typedef void (*mjs_custom_obj_destructor_t)(struct mjs* mjs, mjs_val_t object);
  */
 #define MJS_DESTRUCTOR_PROP_NAME "__d"
 
+/*
+ * Lazy object loader. Returns the object whose properties the lazy object
+ * takes over, or sets an error and returns MJS_UNDEFINED.
+ */
+typedef mjs_val_t (*mjs_lazy_object_loader_t)(struct mjs* mjs, void* context);
+
+/*
+ * Make an empty object which calls `loader` on the first property read or
+ * write done by the script, and takes over properties of the object it
+ * returns. Property access from native code with `mjs_get()`/`mjs_set()`
+ * doesn't trigger loading.
+ */
+mjs_val_t mjs_mk_lazy_object(struct mjs* mjs, mjs_lazy_object_loader_t loader, void* context);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
@@ -86,6 +86,7 @@ mjs_val_t mjs_mk_string(struct mjs* mjs, const char* p, size_t len, int copy) {
             if(gc_strings_is_gc_needed(mjs)) {
                 mjs->need_gc = 1;
             }
+            mjs->gc_allocs++;
 
             /*
        * Before embedding new string, check if the reallocation is needed.  If
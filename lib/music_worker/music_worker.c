@@ -5,14 +5,18 @@
 
 #include <storage/storage.h>
 #include <lib/flipper_format/flipper_format.h>
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/stream/string_stream.h>
 
 #include <math.h>
-#include <m-array.h>
+#include <ctype.h>
+#include <string.h>
 
 #define TAG "MusicWorker"
 
 #define MUSIC_PLAYER_FILETYPE "Flipper Music Format"
 #define MUSIC_PLAYER_VERSION  0
+#define MUSIC_PLAYER_NOTES    "Notes:"
 
 #define SEMITONE_PAUSE 0xFF
 
@@ -20,14 +24,21 @@
 #define NOTE_C4_SEMITONE    (4.0f * 12.0f)
 #define TWO_POW_TWELTH_ROOT 1.059463094359f
 
+// Volume of a note decays by this factor every 2 ms
+#define NOTE_DECAY 0.9945679f
+
+// Notes parsed ahead of the playing one
+#define MUSIC_WORKER_LOOKAHEAD   (8U)
+#define MUSIC_WORKER_READ_SIZE   (64U)
+#define MUSIC_WORKER_TOKEN_SIZE  (16U)
+#define MUSIC_WORKER_HEADER_SIZE (256U)
+
 typedef struct {
     uint8_t semitone;
     uint8_t duration;
     uint8_t dots;
 } NoteBlock;
 
-ARRAY_DEF(NoteBlockArray, NoteBlock, M_POD_OPLIST);
-
 struct MusicWorker {
     FuriThread* thread;
     bool should_work;
@@ -39,52 +50,157 @@ struct MusicWorker {
     uint32_t bpm;
     uint32_t duration;
     uint32_t octave;
-    NoteBlockArray_t notes;
+
+    // Notes are parsed from the source as they are played
+    Storage* storage;
+    Stream* stream;
+    size_t notes_offset;
+    bool notes_end;
+
+    char read_buffer[MUSIC_WORKER_READ_SIZE];
+    size_t read_size;
+    size_t read_position;
+
+    NoteBlock lookahead[MUSIC_WORKER_LOOKAHEAD];
+    size_t lookahead_start;
+    size_t lookahead_count;
 };
 
+static bool music_worker_parse_note(MusicWorker* instance, const char* token, NoteBlock* note);
+
+static void music_worker_rewind(MusicWorker* instance) {
+    stream_seek(instance->stream, instance->notes_offset, StreamOffsetFromStart);
+    instance->read_size = 0;
+    instance->read_position = 0;
+    instance->notes_end = false;
+}
+
+static bool music_worker_read_char(MusicWorker* instance, char* symbol) {
+    if(instance->read_position == instance->read_size) {
+        instance->read_size = stream_read(
+            instance->stream, (uint8_t*)instance->read_buffer, sizeof(instance->read_buffer));
+        instance->read_position = 0;
+        if(instance->read_size == 0) return false;
+    }
+
+    *symbol = instance->read_buffer[instance->read_position++];
+    return true;
+}
+
+/** Read next comma separated note, notes end with the line
+ *
+ * Leading spaces are skipped, characters past the token size are dropped.
+ *
+ * @return     false if there are no notes left
+ */
+static bool music_worker_read_token(MusicWorker* instance, char* token) {
+    size_t length = 0;
+    bool separator = false;
+    char symbol;
+
+    while(!instance->notes_end) {
+        if(!music_worker_read_char(instance, &symbol) || symbol == '\0' || symbol == '\r' ||
+           symbol == '\n') {
+            instance->notes_end = true;
+        } else if(symbol == ',') {
+            separator = true;
+            break;
+        } else if(length == 0 && (symbol == ' ' || symbol == '\t')) {
+            continue;
+        } else if(length < MUSIC_WORKER_TOKEN_SIZE - 1) {
+            token[length++] = symbol;
+        }
+    }
+
+    token[length] = '\0';
+    // Trailing separator is fine, empty note in the middle is not
+    return separator || length > 0;
+}
+
+/** Parse notes into the look-ahead ring until it is full or notes end */
+static void music_worker_fill_lookahead(MusicWorker* instance) {
+    char token[MUSIC_WORKER_TOKEN_SIZE];
+
+    while(instance->lookahead_count < MUSIC_WORKER_LOOKAHEAD) {
+        if(!music_worker_read_token(instance, token)) break;
+
+        const size_t index = (instance->lookahead_start + instance->lookahead_count) %
+                             MUSIC_WORKER_LOOKAHEAD;
+        if(!music_worker_parse_note(instance, token, &instance->lookahead[index])) {
+            instance->notes_end = true;
+            break;
+        }
+        instance->lookahead_count++;
+    }
+}
+
 static int32_t music_worker_thread_callback(void* context) {
     furi_assert(context);
     MusicWorker* instance = context;
 
-    NoteBlockArray_it_t it;
-    NoteBlockArray_it(it, instance->notes);
+    if(!instance->stream) {
+        FURI_LOG_E(TAG, "Nothing to play");
+        return 0;
+    }
+
     if(furi_hal_speaker_acquire(1000)) {
+        // Notes are timed from the song start, so late wakeups don't add up
+        uint32_t song_start = furi_get_tick();
+        float song_position = 0;
+
+        instance->lookahead_start = 0;
+        instance->lookahead_count = 0;
+        music_worker_rewind(instance);
+        music_worker_fill_lookahead(instance);
+
         while(instance->should_work) {
-            if(NoteBlockArray_end_p(it)) {
-                NoteBlockArray_it(it, instance->notes);
+            if(instance->lookahead_count == 0) {
                 furi_delay_ms(10);
-            } else {
-                NoteBlock* note_block = NoteBlockArray_ref(it);
-
-                float note_from_a4 = (float)note_block->semitone - NOTE_C4_SEMITONE;
-                float frequency = NOTE_C4 * powf(TWO_POW_TWELTH_ROOT, note_from_a4);
-                float duration = 60.0 * furi_kernel_get_tick_frequency() * 4 / instance->bpm /
-                                 note_block->duration;
-                uint32_t dots = note_block->dots;
-                while(dots > 0) {
-                    duration += duration / 2;
-                    dots--;
-                }
-                uint32_t next_tick = furi_get_tick() + duration;
-                float volume = instance->volume;
-
-                if(instance->callback) {
-                    instance->callback(
-                        note_block->semitone,
-                        note_block->dots,
-                        note_block->duration,
-                        0.0,
-                        instance->callback_context);
-                }
-
-                furi_hal_speaker_stop();
-                furi_hal_speaker_start(frequency, volume);
-                while(instance->should_work && furi_get_tick() < next_tick) {
-                    volume *= 0.9945679;
-                    furi_hal_speaker_set_volume(volume);
-                    furi_delay_ms(2);
-                }
-                NoteBlockArray_next(it);
+                music_worker_rewind(instance);
+                music_worker_fill_lookahead(instance);
+                song_start = furi_get_tick();
+                song_position = 0;
+                continue;
+            }
+
+            NoteBlock note_block = instance->lookahead[instance->lookahead_start];
+            instance->lookahead_start = (instance->lookahead_start + 1) % MUSIC_WORKER_LOOKAHEAD;
+            instance->lookahead_count--;
+
+            float note_from_a4 = (float)note_block.semitone - NOTE_C4_SEMITONE;
+            float frequency = NOTE_C4 * powf(TWO_POW_TWELTH_ROOT, note_from_a4);
+            float duration =
+                60.0 * furi_kernel_get_tick_frequency() * 4 / instance->bpm / note_block.duration;
+            uint32_t dots = note_block.dots;
+            while(dots > 0) {
+                duration += duration / 2;
+                dots--;
+            }
+            const uint32_t note_start = song_start + (uint32_t)song_position;
+            song_position += duration;
+            const uint32_t next_tick = song_start + (uint32_t)song_position;
+            const float volume = instance->volume;
+
+            if(instance->callback) {
+                instance->callback(
+                    note_block.semitone,
+                    note_block.dots,
+                    note_block.duration,
+                    0.0,
+                    instance->callback_context);
+            }
+
+            furi_hal_speaker_stop();
+            furi_hal_speaker_start(frequency, volume);
+
+            // Parse ahead while the note plays
+            music_worker_fill_lookahead(instance);
+
+            while(instance->should_work && (int32_t)(next_tick - furi_get_tick()) > 0) {
+                const float elapsed_ms =
+                    (furi_get_tick() - note_start) * 1000.0f / furi_kernel_get_tick_frequency();
+                furi_hal_speaker_set_volume(volume * powf(NOTE_DECAY, elapsed_ms / 2.0f));
+                furi_delay_ms(2);
             }
         }
 
@@ -100,8 +216,6 @@ static int32_t music_worker_thread_callback(void* context) {
 MusicWorker* music_worker_alloc(void) {
     MusicWorker* instance = malloc(sizeof(MusicWorker));
 
-    NoteBlockArray_init(instance->notes);
-
     instance->thread =
         furi_thread_alloc_ex("MusicWorker", 1024, music_worker_thread_callback, instance);
 
@@ -111,13 +225,22 @@ MusicWorker* music_worker_alloc(void) {
 }
 
 void music_worker_clear(MusicWorker* instance) {
-    NoteBlockArray_reset(instance->notes);
+    furi_assert(instance);
+
+    if(instance->stream) {
+        stream_free(instance->stream);
+        instance->stream = NULL;
+    }
+    if(instance->storage) {
+        furi_record_close(RECORD_STORAGE);
+        instance->storage = NULL;
+    }
 }
 
 void music_worker_free(MusicWorker* instance) {
     furi_assert(instance);
     furi_thread_free(instance->thread);
-    NoteBlockArray_clear(instance->notes);
+    music_worker_clear(instance);
     free(instance);
 }
 
@@ -186,19 +309,6 @@ static size_t skip_till(const char* string, const char symbol) {
     return ret;
 }
 
-static bool
-    music_worker_add_note(MusicWorker* instance, uint8_t semitone, uint8_t duration, uint8_t dots) {
-    NoteBlock note_block;
-
-    note_block.semitone = semitone;
-    note_block.duration = duration;
-    note_block.dots = dots;
-
-    NoteBlockArray_push_back(instance->notes, note_block);
-
-    return true;
-}
-
 static int8_t note_to_semitone(const char note) {
     switch(note) {
     case 'C':
@@ -225,92 +335,116 @@ static int8_t note_to_semitone(const char note) {
     }
 }
 
-static bool music_worker_parse_notes(MusicWorker* instance, const char* string) {
-    const char* cursor = string;
-    bool result = true;
-
-    while(*cursor != '\0') {
-        if(!is_space(*cursor)) {
-            uint32_t duration = 0;
-            char note_char = '\0';
-            char sharp_char = '\0';
-            uint32_t octave = 0;
-            uint32_t dots = 0;
-
-            // Parsing
-            cursor += extract_number(cursor, &duration);
-            cursor += extract_char(cursor, &note_char);
-            cursor += extract_sharp(cursor, &sharp_char);
-            cursor += extract_number(cursor, &octave);
-            cursor += extract_dots(cursor, &dots);
-
-            // Post processing
-            note_char = toupper(note_char);
-            if(!duration) {
-                duration = instance->duration;
-            }
-            if(!octave) {
-                octave = instance->octave;
-            }
 
-            // Validation
-            bool is_valid = true;
-            is_valid &= (duration >= 1 && duration <= 128);
-            is_valid &= ((note_char >= 'A' && note_char <= 'G') || note_char == 'P');
-            is_valid &= (sharp_char == '#' || sharp_char == '\0');
-            is_valid &= (octave <= 16);
-            is_valid &= (dots <= 16);
-            if(!is_valid) {
-                FURI_LOG_E(
-                    TAG,
-                    "Invalid note: %lu%c%c%lu.%lu",
-                    duration,
-                    note_char == '\0' ? '_' : note_char,
-                    sharp_char == '\0' ? '_' : sharp_char,
-                    octave,
-                    dots);
-                result = false;
-                break;
-            }
+static bool music_worker_parse_note(MusicWorker* instance, const char* token, NoteBlock* note) {
+    const char* cursor = token;
+    uint32_t duration = 0;
+    char note_char = '\0';
+    char sharp_char = '\0';
+    uint32_t octave = 0;
+    uint32_t dots = 0;
+
+    // Parsing
+    cursor += extract_number(cursor, &duration);
+    cursor += extract_char(cursor, &note_char);
+    cursor += extract_sharp(cursor, &sharp_char);
+    cursor += extract_number(cursor, &octave);
+    cursor += extract_dots(cursor, &dots);
+
+    // Post processing
+    note_char = toupper(note_char);
+    if(!duration) {
+        duration = instance->duration;
+    }
+    if(!octave) {
+        octave = instance->octave;
+    }
 
-            // Note to semitones
-            uint8_t semitone = 0;
-            if(note_char == 'P') {
-                semitone = SEMITONE_PAUSE;
-            } else {
-                semitone += octave * 12;
-                semitone += note_to_semitone(note_char);
-                semitone += sharp_char == '#' ? 1 : 0;
-            }
+    // Validation
+    bool is_valid = true;
+    is_valid &= (duration >= 1 && duration <= 128);
+    is_valid &= ((note_char >= 'A' && note_char <= 'G') || note_char == 'P');
+    is_valid &= (sharp_char == '#' || sharp_char == '\0');
+    is_valid &= (octave <= 16);
+    is_valid &= (dots <= 16);
+    if(!is_valid) {
+        FURI_LOG_E(
+            TAG,
+            "Invalid note: %lu%c%c%lu.%lu",
+            duration,
+            note_char == '\0' ? '_' : note_char,
+            sharp_char == '\0' ? '_' : sharp_char,
+            octave,
+            dots);
+        return false;
+    }
 
-            if(music_worker_add_note(instance, semitone, duration, dots)) {
-                FURI_LOG_D(
-                    TAG,
-                    "Added note: %c%c%lu.%lu = %u %lu",
-                    note_char == '\0' ? '_' : note_char,
-                    sharp_char == '\0' ? '_' : sharp_char,
-                    octave,
-                    dots,
-                    semitone,
-                    duration);
-            } else {
-                FURI_LOG_E(
-                    TAG,
-                    "Invalid note: %c%c%lu.%lu = %u %lu",
-                    note_char == '\0' ? '_' : note_char,
-                    sharp_char == '\0' ? '_' : sharp_char,
-                    octave,
-                    dots,
-                    semitone,
-                    duration);
-            }
-            cursor += skip_till(cursor, ',');
+    // Note to semitones
+    uint8_t semitone = 0;
+    if(note_char == 'P') {
+        semitone = SEMITONE_PAUSE;
+    } else {
+        semitone += octave * 12;
+        semitone += note_to_semitone(note_char);
+        semitone += sharp_char == '#' ? 1 : 0;
+    }
+
+    note->semitone = semitone;
+    note->duration = duration;
+    note->dots = dots;
+
+    return true;
+}
+
+/** Check every note of the source once, nothing is kept in memory */
+static bool music_worker_validate_notes(MusicWorker* instance) {
+    char token[MUSIC_WORKER_TOKEN_SIZE];
+    NoteBlock note;
+    size_t count = 0;
+
+    music_worker_rewind(instance);
+    while(music_worker_read_token(instance, token)) {
+        if(!music_worker_parse_note(instance, token, &note)) {
+            return false;
         }
+        count++;
+    }
+
+    FURI_LOG_D(TAG, "Notes: %zu", count);
+    return true;
+}
+
+static bool music_worker_open_file(MusicWorker* instance, const char* file_path) {
+    music_worker_clear(instance);
 
-        if(*cursor != '\0') cursor++;
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->stream = file_stream_alloc(instance->storage);
+    if(!file_stream_open(instance->stream, file_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        FURI_LOG_E(TAG, "Unable to open file");
+        music_worker_clear(instance);
+        return false;
     }
 
-    return result;
+    return true;
+}
+
+// Notes key is at the start of a line
+static bool music_worker_seek_fmf_notes(Stream* stream) {
+    const size_t key_size = strlen(MUSIC_PLAYER_NOTES);
+    char key[sizeof(MUSIC_PLAYER_NOTES)];
+
+    stream_rewind(stream);
+    while(true) {
+        const size_t ret = stream_read(stream, (uint8_t*)key, key_size);
+        if(ret == key_size && memcmp(key, MUSIC_PLAYER_NOTES, key_size) == 0) {
+            return true;
+        }
+        stream_seek(stream, -(int32_t)ret, StreamOffsetFromCurrent);
+        if(!stream_seek_to_char(stream, '\n', StreamDirectionForward)) {
+            return false;
+        }
+        stream_seek(stream, 1, StreamOffsetFromCurrent);
+    }
 }
 
 bool music_worker_load(MusicWorker* instance, const char* file_path) {
@@ -361,15 +495,6 @@ bool music_worker_load_fmf_from_file(MusicWorker* instance, const char* file_pat
             break;
         }
 
-        if(!flipper_format_read_string(file, "Notes", temp_str)) {
-            FURI_LOG_E(TAG, "Notes is missing");
-            break;
-        }
-
-        if(!music_worker_parse_notes(instance, furi_string_get_cstr(temp_str))) {
-            break;
-        }
-
         result = true;
     } while(false);
 
@@ -377,70 +502,43 @@ bool music_worker_load_fmf_from_file(MusicWorker* instance, const char* file_pat
     flipper_format_free(file);
     furi_string_free(temp_str);
 
-    return result;
-}
-
-bool music_worker_load_rtttl_from_file(MusicWorker* instance, const char* file_path) {
-    furi_assert(instance);
-    furi_assert(file_path);
-
-    bool result = false;
-    FuriString* content;
-    content = furi_string_alloc();
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(storage);
-
-    do {
-        if(!storage_file_open(file, file_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
-            FURI_LOG_E(TAG, "Unable to open file");
-            break;
-        };
-
-        size_t ret = 0;
-        do {
-            uint8_t buffer[65] = {0};
-            ret = storage_file_read(file, buffer, sizeof(buffer) - 1);
-            for(size_t i = 0; i < ret; i++) {
-                furi_string_push_back(content, buffer[i]);
-            }
-        } while(ret > 0);
-
-        furi_string_trim(content);
-        if(!furi_string_size(content)) {
-            FURI_LOG_E(TAG, "Empty file");
-            break;
-        }
-
-        if(!music_worker_load_rtttl_from_string(instance, furi_string_get_cstr(content))) {
-            FURI_LOG_E(TAG, "Invalid file content");
-            break;
-        }
+    if(!result || !music_worker_open_file(instance, file_path)) {
+        return false;
+    }
 
-        result = true;
-    } while(0);
+    // Notes value is read straight from the file as the song plays
+    if(!music_worker_seek_fmf_notes(instance->stream)) {
+        FURI_LOG_E(TAG, "Notes is missing");
+        music_worker_clear(instance);
+        return false;
+    }
+    instance->notes_offset = stream_tell(instance->stream);
 
-    storage_file_free(file);
-    furi_record_close(RECORD_STORAGE);
-    furi_string_free(content);
+    if(!music_worker_validate_notes(instance)) {
+        music_worker_clear(instance);
+        return false;
+    }
 
-    return result;
+    return true;
 }
 
-bool music_worker_load_rtttl_from_string(MusicWorker* instance, const char* string) {
-    furi_assert(instance);
-
+/** Parse RTTTL name, defaults and BPM
+ *
+ * @return     Offset of the notes in the string, 0 on error
+ */
+static size_t music_worker_parse_rtttl_header(MusicWorker* instance, const char* string) {
     const char* cursor = string;
 
     // Skip name
     cursor += skip_till(cursor, ':');
     if(*cursor != ':') {
-        return false;
+        return 0;
     }
 
     // Duration
     cursor += skip_till(cursor, '=');
     if(*cursor != '=') {
-        return false;
+        return 0;
     }
     cursor++;
     cursor += extract_number(cursor, &instance->duration);
@@ -448,7 +546,7 @@ bool music_worker_load_rtttl_from_string(MusicWorker* instance, const char* stri
     // Octave
     cursor += skip_till(cursor, '=');
     if(*cursor != '=') {
-        return false;
+        return 0;
     }
     cursor++;
     cursor += extract_number(cursor, &instance->octave);
@@ -456,7 +554,7 @@ bool music_worker_load_rtttl_from_string(MusicWorker* instance, const char* stri
     // BPM
     cursor += skip_till(cursor, '=');
     if(*cursor != '=') {
-        return false;
+        return 0;
     }
     cursor++;
     cursor += extract_number(cursor, &instance->bpm);
@@ -464,10 +562,83 @@ bool music_worker_load_rtttl_from_string(MusicWorker* instance, const char* stri
     // Notes
     cursor += skip_till(cursor, ':');
     if(*cursor != ':') {
-        return false;
+        return 0;
     }
     cursor++;
-    if(!music_worker_parse_notes(instance, cursor)) {
+
+    return cursor - string;
+}
+
+bool music_worker_load_rtttl_from_file(MusicWorker* instance, const char* file_path) {
+    furi_assert(instance);
+    furi_assert(file_path);
+
+    if(!music_worker_open_file(instance, file_path)) {
+        return false;
+    }
+
+    bool result = false;
+    FuriString* header;
+    header = furi_string_alloc();
+
+    do {
+        // Header ends with the second colon, notes follow
+        size_t colons = 0;
+        size_t header_size = 0;
+        char symbol;
+        while(colons < 2 && header_size < MUSIC_WORKER_HEADER_SIZE &&
+              music_worker_read_char(instance, &symbol)) {
+            furi_string_push_back(header, symbol);
+            header_size++;
+            if(symbol == ':') colons++;
+        }
+
+        furi_string_trim(header);
+        if(!furi_string_size(header)) {
+            FURI_LOG_E(TAG, "Empty file");
+            break;
+        }
+
+        if(colons < 2 ||
+           !music_worker_parse_rtttl_header(instance, furi_string_get_cstr(header))) {
+            FURI_LOG_E(TAG, "Invalid file content");
+            break;
+        }
+        instance->notes_offset = header_size;
+
+        if(!music_worker_validate_notes(instance)) {
+            FURI_LOG_E(TAG, "Invalid file content");
+            break;
+        }
+
+        result = true;
+    } while(0);
+
+    furi_string_free(header);
+
+    if(!result) {
+        music_worker_clear(instance);
+    }
+
+    return result;
+}
+
+bool music_worker_load_rtttl_from_string(MusicWorker* instance, const char* string) {
+    furi_assert(instance);
+
+    music_worker_clear(instance);
+
+    const size_t notes_offset = music_worker_parse_rtttl_header(instance, string);
+    if(!notes_offset) {
+        return false;
+    }
+
+    instance->stream = string_stream_alloc();
+    stream_write_cstring(instance->stream, string);
+    instance->notes_offset = notes_offset;
+
+    if(!music_worker_validate_notes(instance)) {
+        music_worker_clear(instance);
         return false;
     }
 
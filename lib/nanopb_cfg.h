@@ -0,0 +1,16 @@
+#pragma once
+
+/* System header for nanopb library build, see PB_SYSTEM_HEADER in pb.h */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <stdlib.h>
+
+#include <core/memmgr_slab.h>
+
+/* Decoded strings, bytes and repeated fields are small and short lived */
+#define pb_realloc(ptr, size) memmgr_slab_realloc(ptr, size)
+#define pb_free(ptr)          memmgr_slab_free(ptr)
@@ -1,30 +1,29 @@
 #include "felica_crc.h"
+#include "nfc_crc16_i.h"
 
 #include <furi/furi.h>
 
-#define FELICA_CRC_POLY (0x1021U) // Polynomial: x^16 + x^12 + x^5 + 1
 #define FELICA_CRC_INIT (0x0000U)
 
-uint16_t felica_crc_calculate(const uint8_t* data, size_t length) {
-    furi_check(data);
-
-    uint16_t crc = FELICA_CRC_INIT;
+uint16_t felica_crc_start(void) {
+    return FELICA_CRC_INIT;
+}
 
-    for(size_t i = 0; i < length; i++) {
-        crc ^= ((uint16_t)data[i] << 8);
-        for(size_t j = 0; j < 8; j++) {
-            if(crc & 0x8000) {
-                crc <<= 1;
-                crc ^= FELICA_CRC_POLY;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
+uint16_t felica_crc_update(uint16_t crc, const uint8_t* data, size_t data_size) {
+    furi_check(data || !data_size);
+    return nfc_crc16_msb_update(crc, data, data_size);
+}
 
+uint16_t felica_crc_finish(uint16_t crc) {
+    // Transmitted MSB first
     return (crc << 8) | (crc >> 8);
 }
 
+uint16_t felica_crc_calculate(const uint8_t* data, size_t data_size) {
+    furi_check(data);
+    return felica_crc_finish(felica_crc_update(felica_crc_start(), data, data_size));
+}
+
 void felica_crc_append(BitBuffer* buf) {
     furi_check(buf);
     const uint8_t* data = bit_buffer_get_data(buf);
@@ -11,6 +11,18 @@ extern "C" {
 
 #define FELICA_CRC_SIZE sizeof(uint16_t)
 
+/* Incremental calculation: start, update with each part of the frame, finish.
+ * Unfinished value of a static prefix can be kept and updated later. */
+
+uint16_t felica_crc_start(void);
+
+uint16_t felica_crc_update(uint16_t crc, const uint8_t* data, size_t data_size);
+
+uint16_t felica_crc_finish(uint16_t crc);
+
+/* Finished CRC in transmission byte order when stored little endian */
+uint16_t felica_crc_calculate(const uint8_t* data, size_t data_size);
+
 void felica_crc_append(BitBuffer* buf);
 
 bool felica_crc_check(const BitBuffer* buf);
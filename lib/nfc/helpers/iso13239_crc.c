@@ -1,13 +1,12 @@
 #include "iso13239_crc.h"
+#include "nfc_crc16_i.h"
 
 #include <core/check.h>
 
 #define ISO13239_CRC_INIT_DEFAULT  (0xFFFFU)
 #define ISO13239_CRC_INIT_PICOPASS (0xE012U)
-#define ISO13239_CRC_POLY          (0x8408U)
 
-static uint16_t
-    iso13239_crc_calculate(Iso13239CrcType type, const uint8_t* data, size_t data_size) {
+uint16_t iso13239_crc_start(Iso13239CrcType type) {
     uint16_t crc;
 
     if(type == Iso13239CrcTypeDefault) {
@@ -18,20 +17,23 @@ static uint16_t
         furi_crash("Wrong ISO13239 CRC type");
     }
 
-    for(size_t i = 0; i < data_size; ++i) {
-        crc ^= (uint16_t)data[i];
-        for(size_t j = 0; j < 8; ++j) {
-            if(crc & 1U) {
-                crc = (crc >> 1) ^ ISO13239_CRC_POLY;
-            } else {
-                crc >>= 1;
-            }
-        }
-    }
+    return crc;
+}
+
+uint16_t iso13239_crc_update(uint16_t crc, const uint8_t* data, size_t data_size) {
+    furi_check(data || !data_size);
+    return nfc_crc16_reflected_update(crc, data, data_size);
+}
 
+uint16_t iso13239_crc_finish(Iso13239CrcType type, uint16_t crc) {
     return type == Iso13239CrcTypePicopass ? crc : ~crc;
 }
 
+uint16_t iso13239_crc_calculate(Iso13239CrcType type, const uint8_t* data, size_t data_size) {
+    const uint16_t crc = iso13239_crc_update(iso13239_crc_start(type), data, data_size);
+    return iso13239_crc_finish(type, crc);
+}
+
 void iso13239_crc_append(Iso13239CrcType type, BitBuffer* buf) {
     furi_check(buf);
 
@@ -16,6 +16,18 @@ typedef enum {
     Iso13239CrcTypePicopass,
 } Iso13239CrcType;
 
+/* Incremental calculation: start, update with each part of the frame, finish.
+ * Unfinished value of a static prefix can be kept and updated later. */
+
+uint16_t iso13239_crc_start(Iso13239CrcType type);
+
+uint16_t iso13239_crc_update(uint16_t crc, const uint8_t* data, size_t data_size);
+
+uint16_t iso13239_crc_finish(Iso13239CrcType type, uint16_t crc);
+
+/* Finished CRC in transmission byte order when stored little endian */
+uint16_t iso13239_crc_calculate(Iso13239CrcType type, const uint8_t* data, size_t data_size);
+
 void iso13239_crc_append(Iso13239CrcType type, BitBuffer* buf);
 
 bool iso13239_crc_check(Iso13239CrcType type, const BitBuffer* buf);
@@ -1,12 +1,12 @@
 #include "iso14443_crc.h"
+#include "nfc_crc16_i.h"
 
 #include <core/check.h>
 
 #define ISO14443_3A_CRC_INIT (0x6363U)
 #define ISO14443_3B_CRC_INIT (0xFFFFU)
 
-static uint16_t
-    iso14443_crc_calculate(Iso14443CrcType type, const uint8_t* data, size_t data_size) {
+uint16_t iso14443_crc_start(Iso14443CrcType type) {
     uint16_t crc;
 
     if(type == Iso14443CrcTypeA) {
@@ -17,16 +17,23 @@ static uint16_t
         furi_crash("Wrong ISO14443 CRC type");
     }
 
-    for(size_t i = 0; i < data_size; i++) {
-        uint8_t byte = data[i];
-        byte ^= (uint8_t)(crc & 0xff);
-        byte ^= byte << 4;
-        crc = (crc >> 8) ^ (((uint16_t)byte) << 8) ^ (((uint16_t)byte) << 3) ^ (byte >> 4);
-    }
+    return crc;
+}
+
+uint16_t iso14443_crc_update(uint16_t crc, const uint8_t* data, size_t data_size) {
+    furi_check(data || !data_size);
+    return nfc_crc16_reflected_update(crc, data, data_size);
+}
 
+uint16_t iso14443_crc_finish(Iso14443CrcType type, uint16_t crc) {
     return type == Iso14443CrcTypeA ? crc : ~crc;
 }
 
+uint16_t iso14443_crc_calculate(Iso14443CrcType type, const uint8_t* data, size_t data_size) {
+    const uint16_t crc = iso14443_crc_update(iso14443_crc_start(type), data, data_size);
+    return iso14443_crc_finish(type, crc);
+}
+
 void iso14443_crc_append(Iso14443CrcType type, BitBuffer* buf) {
     furi_check(buf);
 
@@ -16,6 +16,18 @@ typedef enum {
     Iso14443CrcTypeB,
 } Iso14443CrcType;
 
+/* Incremental calculation: start, update with each part of the frame, finish.
+ * Unfinished value of a static prefix can be kept and updated later. */
+
+uint16_t iso14443_crc_start(Iso14443CrcType type);
+
+uint16_t iso14443_crc_update(uint16_t crc, const uint8_t* data, size_t data_size);
+
+uint16_t iso14443_crc_finish(Iso14443CrcType type, uint16_t crc);
+
+/* Finished CRC in transmission byte order when stored little endian */
+uint16_t iso14443_crc_calculate(Iso14443CrcType type, const uint8_t* data, size_t data_size);
+
 void iso14443_crc_append(Iso14443CrcType type, BitBuffer* buf);
 
 bool iso14443_crc_check(Iso14443CrcType type, const BitBuffer* buf);
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Table driven CRC-16 kernels shared by the protocol CRC helpers, no init or final xor */
+
+uint16_t nfc_crc16_reflected_update(uint16_t crc, const uint8_t* data, size_t data_size);
+
+uint16_t nfc_crc16_msb_update(uint16_t crc, const uint8_t* data, size_t data_size);
+
+#ifdef __cplusplus
+}
+#endif
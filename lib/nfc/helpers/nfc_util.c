@@ -18,10 +18,10 @@ uint8_t nfc_util_even_parity8(uint8_t data) {
 }
 
 uint8_t nfc_util_even_parity32(uint32_t data) {
-    // data ^= data >> 16;
-    // data ^= data >> 8;
-    // return !nfc_util_odd_byte_parity[data];
-    return __builtin_parity(data) & 0xFF;
+    // __builtin_parity is a libgcc call on Cortex-M, fold the word into the table instead
+    data ^= data >> 16;
+    data ^= data >> 8;
+    return !nfc_util_odd_byte_parity[data & 0xFF];
 }
 
 uint8_t nfc_util_odd_parity8(uint8_t data) {
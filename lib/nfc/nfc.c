@@ -3,12 +3,22 @@
 #include "nfc.h"
 
 #include <furi_hal_nfc.h>
+#include <furi_hal_cortex.h>
 #include <furi/furi.h>
+#include <toolbox/profiler.h>
 
 #define TAG "Nfc"
 
 #define NFC_MAX_BUFFER_SIZE (256)
 
+#define NFC_CARRIER_FREQUENCY_KHZ (13560U)
+
+#define NFC_FWT_CLASS_COUNT           (4U)
+#define NFC_FWT_ADAPTIVE_SAMPLES_MIN  (8U)
+#define NFC_FWT_ADAPTIVE_FACTOR       (2U)
+#define NFC_FWT_ADAPTIVE_MARGIN_FC    (4096U)
+#define NFC_TIMING_STATS_AVG_SHIFT    (3U)
+
 typedef enum {
     NfcStateIdle,
     NfcStateRunning,
@@ -38,6 +48,13 @@ typedef enum {
     NfcConfigurationStateDone,
 } NfcConfigurationState;
 
+// Exchanges of different kinds are told apart by the frame wait time protocols request
+typedef struct {
+    uint32_t fwt_fc;
+    uint32_t response_max_fc;
+    uint32_t samples;
+} NfcFwtClass;
+
 struct Nfc {
     NfcState state;
     NfcPollerState poller_state;
@@ -58,6 +75,17 @@ struct Nfc {
     uint8_t rx_buffer[NFC_MAX_BUFFER_SIZE];
     size_t rx_bits;
 
+    BitBuffer* scratch_buffers[NFC_SCRATCH_BUFFER_COUNT];
+    uint8_t scratch_used;
+
+    NfcListenerFastPathCallback fast_path_callback;
+    void* fast_path_context;
+
+    bool adaptive_fwt;
+    NfcFwtClass fwt_classes[NFC_FWT_CLASS_COUNT];
+    uint32_t tx_end_cycles;
+    NfcTimingStats timing_stats;
+
     FuriThread* worker_thread;
 };
 
@@ -116,6 +144,7 @@ static int32_t nfc_worker_listener(void* context) {
     event_data.buffer = bit_buffer_alloc(NFC_MAX_BUFFER_SIZE);
     NfcEvent nfc_event = {.data = event_data};
     NfcCommand command = NfcCommandContinue;
+    BitBuffer* fast_path_buffer = bit_buffer_alloc(NFC_MAX_BUFFER_SIZE);
 
     while(true) {
         FuriHalNfcEvent event = furi_hal_nfc_listener_wait_event(FURI_HAL_NFC_EVENT_WAIT_FOREVER);
@@ -138,13 +167,22 @@ static int32_t nfc_worker_listener(void* context) {
             instance->callback(nfc_event, instance->context);
         }
         if(event & FuriHalNfcEventRxEnd) {
+            profiler_probe_enter(ProfilerProbeNfcListenerRx);
             furi_hal_nfc_timer_block_tx_start(instance->fdt_listen_fc);
 
             nfc_event.type = NfcEventTypeRxEnd;
             furi_hal_nfc_listener_rx(
                 instance->rx_buffer, sizeof(instance->rx_buffer), &instance->rx_bits);
             bit_buffer_copy_bits(event_data.buffer, instance->rx_buffer, instance->rx_bits);
-            command = instance->callback(nfc_event, instance->context);
+            if(instance->fast_path_callback &&
+               instance->fast_path_callback(
+                   event_data.buffer, fast_path_buffer, instance->fast_path_context)) {
+                nfc_listener_tx(instance, fast_path_buffer);
+                command = NfcCommandContinue;
+            } else {
+                command = instance->callback(nfc_event, instance->context);
+            }
+            profiler_probe_exit(ProfilerProbeNfcListenerRx);
             if(command == NfcCommandStop) {
                 break;
             } else if(command == NfcCommandReset) {
@@ -158,6 +196,7 @@ static int32_t nfc_worker_listener(void* context) {
     furi_hal_nfc_reset_mode();
     instance->config_state = NfcConfigurationStateIdle;
 
+    bit_buffer_free(fast_path_buffer);
     bit_buffer_free(event_data.buffer);
     furi_hal_nfc_low_power_mode_start();
     return 0;
@@ -179,7 +218,9 @@ bool nfc_worker_poller_ready_handler(Nfc* instance) {
     NfcCommand command = NfcCommandContinue;
 
     NfcEvent event = {.type = NfcEventTypePollerReady};
+    profiler_probe_enter(ProfilerProbeNfcPollerReady);
     command = instance->callback(event, instance->context);
+    profiler_probe_exit(ProfilerProbeNfcPollerReady);
     if(command == NfcCommandReset) {
         instance->poller_state = NfcPollerStateReset;
     } else if(command == NfcCommandStop) {
@@ -249,12 +290,21 @@ Nfc* nfc_alloc(void) {
     furi_thread_set_priority(instance->worker_thread, FuriThreadPriorityHighest);
     furi_thread_set_stack_size(instance->worker_thread, 8 * 1024);
 
+    for(size_t i = 0; i < NFC_SCRATCH_BUFFER_COUNT; i++) {
+        instance->scratch_buffers[i] = bit_buffer_alloc(NFC_SCRATCH_BUFFER_SIZE);
+    }
+
     return instance;
 }
 
 void nfc_free(Nfc* instance) {
     furi_check(instance);
     furi_check(instance->state == NfcStateIdle);
+    furi_check(instance->scratch_used == 0);
+
+    for(size_t i = 0; i < NFC_SCRATCH_BUFFER_COUNT; i++) {
+        bit_buffer_free(instance->scratch_buffers[i]);
+    }
 
     furi_thread_free(instance->worker_thread);
     free(instance);
@@ -262,6 +312,35 @@ void nfc_free(Nfc* instance) {
     furi_hal_nfc_release();
 }
 
+BitBuffer* nfc_scratch_buffer_acquire(Nfc* instance) {
+    furi_check(instance);
+
+    size_t index = 0;
+    for(; index < NFC_SCRATCH_BUFFER_COUNT; index++) {
+        if(!(instance->scratch_used & (1U << index))) break;
+    }
+    furi_check(index < NFC_SCRATCH_BUFFER_COUNT, "Out of scratch buffers");
+
+    instance->scratch_used |= 1U << index;
+    bit_buffer_reset(instance->scratch_buffers[index]);
+
+    return instance->scratch_buffers[index];
+}
+
+void nfc_scratch_buffer_release(Nfc* instance, BitBuffer* buffer) {
+    furi_check(instance);
+    furi_check(buffer);
+
+    size_t index = 0;
+    for(; index < NFC_SCRATCH_BUFFER_COUNT; index++) {
+        if(instance->scratch_buffers[index] == buffer) break;
+    }
+    furi_check(index < NFC_SCRATCH_BUFFER_COUNT);
+    furi_check(instance->scratch_used & (1U << index));
+
+    instance->scratch_used &= ~(1U << index);
+}
+
 void nfc_config(Nfc* instance, NfcMode mode, NfcTech tech) {
     furi_check(instance);
     furi_check(mode < NfcModeNum);
@@ -306,6 +385,28 @@ void nfc_set_mask_receive_time_fc(Nfc* instance, uint32_t mask_rx_time_fc) {
     instance->mask_rx_time_fc = mask_rx_time_fc;
 }
 
+void nfc_set_adaptive_fwt(Nfc* instance, bool enable) {
+    furi_check(instance);
+    instance->adaptive_fwt = enable;
+}
+
+void nfc_set_listener_fast_path(
+    Nfc* instance,
+    NfcListenerFastPathCallback callback,
+    void* context) {
+    furi_check(instance);
+
+    instance->fast_path_callback = callback;
+    instance->fast_path_context = context;
+}
+
+void nfc_get_timing_stats(const Nfc* instance, NfcTimingStats* stats) {
+    furi_check(instance);
+    furi_check(stats);
+
+    *stats = instance->timing_stats;
+}
+
 void nfc_start(Nfc* instance, NfcEventCallback callback, void* context) {
     furi_check(instance);
     furi_check(instance->worker_thread);
@@ -320,6 +421,8 @@ void nfc_start(Nfc* instance, NfcEventCallback callback, void* context) {
         furi_thread_set_callback(instance->worker_thread, nfc_worker_listener);
     }
     instance->comm_state = NfcCommStateIdle;
+    memset(instance->fwt_classes, 0, sizeof(instance->fwt_classes));
+    memset(&instance->timing_stats, 0, sizeof(NfcTimingStats));
     furi_thread_start(instance->worker_thread);
 }
 
@@ -354,10 +457,74 @@ NfcError nfc_listener_tx(Nfc* instance, const BitBuffer* tx_buffer) {
     return ret;
 }
 
+static NfcFwtClass* nfc_get_fwt_class(Nfc* instance, uint32_t fwt_fc) {
+    NfcFwtClass* fwt_class = NULL;
+
+    for(size_t i = 0; i < NFC_FWT_CLASS_COUNT; i++) {
+        NfcFwtClass* it = &instance->fwt_classes[i];
+        if(it->fwt_fc == fwt_fc) return it;
+        if(!fwt_class && it->fwt_fc == 0) fwt_class = it;
+    }
+
+    // New timing takes a free class, if none is left it is neither learned nor adapted
+    if(fwt_class) fwt_class->fwt_fc = fwt_fc;
+
+    return fwt_class;
+}
+
+static uint32_t nfc_get_adapted_fwt(Nfc* instance, const NfcFwtClass* fwt_class) {
+    uint32_t fwt_fc = fwt_class->fwt_fc;
+
+    if(instance->adaptive_fwt && fwt_class->samples >= NFC_FWT_ADAPTIVE_SAMPLES_MIN) {
+        // Never wait longer than protocol asked for
+        const uint32_t adapted_fwt_fc = fwt_class->response_max_fc * NFC_FWT_ADAPTIVE_FACTOR +
+                                        NFC_FWT_ADAPTIVE_MARGIN_FC;
+        fwt_fc = MIN(adapted_fwt_fc, fwt_class->fwt_fc);
+    }
+
+    return fwt_fc;
+}
+
+static void nfc_update_timing_stats(Nfc* instance, NfcFwtClass* fwt_class) {
+    const uint32_t cycles = furi_hal_cortex_timer_get(0).start - instance->tx_end_cycles;
+    const uint32_t response_fc = (uint64_t)cycles * NFC_CARRIER_FREQUENCY_KHZ /
+                                 (furi_hal_cortex_instructions_per_microsecond() * 1000U);
+
+    NfcTimingStats* stats = &instance->timing_stats;
+    stats->response_count++;
+    if(stats->response_count == 1) {
+        stats->response_min_fc = response_fc;
+        stats->response_max_fc = response_fc;
+        stats->response_avg_fc = response_fc;
+    } else {
+        stats->response_min_fc = MIN(stats->response_min_fc, response_fc);
+        stats->response_max_fc = MAX(stats->response_max_fc, response_fc);
+        stats->response_avg_fc += ((int32_t)response_fc - (int32_t)stats->response_avg_fc) >>
+                                  NFC_TIMING_STATS_AVG_SHIFT;
+    }
+
+    if(fwt_class) {
+        fwt_class->response_max_fc = MAX(fwt_class->response_max_fc, response_fc);
+        fwt_class->samples++;
+    }
+}
+
 static NfcError nfc_poller_trx_state_machine(Nfc* instance, uint32_t fwt_fc) {
     FuriHalNfcEvent event = 0;
     NfcError error = NfcErrorNone;
 
+    NfcFwtClass* fwt_class = NULL;
+    if(fwt_fc) {
+        instance->timing_stats.trx_count++;
+        fwt_class = nfc_get_fwt_class(instance, fwt_fc);
+        if(fwt_class) {
+            const uint32_t adapted_fwt_fc = nfc_get_adapted_fwt(instance, fwt_class);
+            if(adapted_fwt_fc < fwt_fc) instance->timing_stats.adapted_count++;
+            fwt_fc = adapted_fwt_fc;
+        }
+    }
+
+    profiler_probe_enter(ProfilerProbeNfcPollerTrx);
     while(true) {
         event = furi_hal_nfc_poller_wait_event(FURI_HAL_NFC_EVENT_WAIT_FOREVER);
         if(event & FuriHalNfcEventTimerBlockTxExpired) {
@@ -369,6 +536,7 @@ static NfcError nfc_poller_trx_state_machine(Nfc* instance, uint32_t fwt_fc) {
             if(instance->comm_state == NfcCommStateWaitTxEnd) {
                 if(fwt_fc) {
                     furi_hal_nfc_timer_fwt_start(fwt_fc);
+                    instance->tx_end_cycles = furi_hal_cortex_timer_get(0).start;
                 }
                 furi_hal_nfc_timer_block_tx_start_us(instance->fdt_poll_poll_us);
                 instance->comm_state = NfcCommStateWaitRxStart;
@@ -378,6 +546,9 @@ static NfcError nfc_poller_trx_state_machine(Nfc* instance, uint32_t fwt_fc) {
             if(instance->comm_state == NfcCommStateWaitRxStart) {
                 furi_hal_nfc_timer_block_tx_stop();
                 furi_hal_nfc_timer_fwt_stop();
+                if(fwt_fc) {
+                    nfc_update_timing_stats(instance, fwt_class);
+                }
                 instance->comm_state = NfcCommStateWaitRxEnd;
             }
         }
@@ -390,6 +561,7 @@ static NfcError nfc_poller_trx_state_machine(Nfc* instance, uint32_t fwt_fc) {
         if(event & FuriHalNfcEventTimerFwtExpired) {
             if(instance->comm_state == NfcCommStateWaitRxStart) {
                 error = NfcErrorTimeout;
+                instance->timing_stats.timeout_count++;
                 FURI_LOG_D(TAG, "FWT Timeout");
                 if(furi_hal_nfc_timer_block_tx_is_running()) {
                     instance->comm_state = NfcCommStateWaitBlockTxTimer;
@@ -400,6 +572,7 @@ static NfcError nfc_poller_trx_state_machine(Nfc* instance, uint32_t fwt_fc) {
             }
         }
     }
+    profiler_probe_exit(ProfilerProbeNfcPollerTrx);
 
     return error;
 }
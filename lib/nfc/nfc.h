@@ -23,6 +23,9 @@
 extern "C" {
 #endif
 
+#define NFC_SCRATCH_BUFFER_SIZE  (256U)
+#define NFC_SCRATCH_BUFFER_COUNT (4U)
+
 /**
  * @brief Nfc opaque type definition.
  */
@@ -86,6 +89,22 @@ typedef enum {
  */
 typedef NfcCommand (*NfcEventCallback)(NfcEvent event, void* context);
 
+/**
+ * @brief Listener fast path callback type.
+ *
+ * Called by the Nfc worker for every received frame before the frame is passed to the event
+ * callback, so the response can be sent without going through the protocol stack.
+ *
+ * @param [in] rx_buffer received frame, CRC included.
+ * @param [out] tx_buffer response to be transmitted as is, CRC included.
+ * @param [in,out] context pointer to the user-specific context.
+ * @returns true if tx_buffer holds the response and the frame is handled, false otherwise.
+ */
+typedef bool (*NfcListenerFastPathCallback)(
+    const BitBuffer* rx_buffer,
+    BitBuffer* tx_buffer,
+    void* context);
+
 /**
  * @brief Enumeration of possible operating modes.
  *
@@ -121,6 +140,22 @@ typedef enum {
     NfcErrorDataFormat, /**< Data has not been parsed due to wrong/unknown format. */
 } NfcError;
 
+/**
+ * @brief Poller exchange timing statistics.
+ *
+ * Collected from the start of the Nfc instance. Response time is measured from
+ * the end of transmission to the start of the card response.
+ */
+typedef struct {
+    uint32_t trx_count; /**< Number of exchanges with a frame wait time set. */
+    uint32_t response_count; /**< Number of exchanges with measured response time. */
+    uint32_t timeout_count; /**< Number of exchanges ended with a frame wait timeout. */
+    uint32_t adapted_count; /**< Number of exchanges done with a shortened frame wait time. */
+    uint32_t response_min_fc; /**< Fastest response time, in carrier cycles. */
+    uint32_t response_max_fc; /**< Slowest response time, in carrier cycles. */
+    uint32_t response_avg_fc; /**< Running average response time, in carrier cycles. */
+} NfcTimingStats;
+
 /**
  * @brief Allocate an Nfc instance.
  *
@@ -192,6 +227,43 @@ void nfc_set_fdt_poll_poll_us(Nfc* instance, uint32_t fdt_poll_poll_us);
  */
 void nfc_set_guard_time_us(Nfc* instance, uint32_t guard_time_us);
 
+/**
+ * @brief Enable adaptive frame wait time.
+ *
+ * Once enough responses were measured for a given frame wait time, exchanges requesting it
+ * wait only for a safe multiple of the slowest response seen, so silent cards time out early.
+ * Learned timings are per exchange fwt and are reset on each nfc_start().
+ *
+ * Must only be enabled for exchanges with steady response time, e.g. authentication attempts.
+ *
+ * @param[in,out] instance pointer to the instance to be modified.
+ * @param[in] enable true to enable, false to always wait for the requested time.
+ */
+void nfc_set_adaptive_fwt(Nfc* instance, bool enable);
+
+/**
+ * @brief Set listener fast path callback.
+ *
+ * The callback is run in the Nfc worker thread and must answer only the commands
+ * that don't change the state of the protocol stack, e.g. plain memory reads.
+ *
+ * @param[in,out] instance pointer to the instance to be modified.
+ * @param[in] callback pointer to the fast path callback, NULL to disable fast path.
+ * @param[in] context pointer to a user-specific context (will be passed to the callback).
+ */
+void nfc_set_listener_fast_path(
+    Nfc* instance,
+    NfcListenerFastPathCallback callback,
+    void* context);
+
+/**
+ * @brief Get poller exchange timing statistics.
+ *
+ * @param[in] instance pointer to the instance to be queried.
+ * @param[out] stats pointer to the structure to be filled.
+ */
+void nfc_get_timing_stats(const Nfc* instance, NfcTimingStats* stats);
+
 /**
  * @brief Start the Nfc instance.
  *
@@ -216,6 +288,26 @@ void nfc_start(Nfc* instance, NfcEventCallback callback, void* context);
  */
 void nfc_stop(Nfc* instance);
 
+/**
+ * @brief Acquire scratch buffer.
+ *
+ * Scratch buffers are allocated together with the Nfc instance, protocols can
+ * use them instead of allocating temporary buffers in the middle of an exchange.
+ * Must only be called from the Nfc worker thread, i.e. from event callbacks.
+ *
+ * @param[in,out] instance pointer to the instance to take the buffer from.
+ * @returns pointer to the empty buffer of NFC_SCRATCH_BUFFER_SIZE bytes.
+ */
+BitBuffer* nfc_scratch_buffer_acquire(Nfc* instance);
+
+/**
+ * @brief Release scratch buffer.
+ *
+ * @param[in,out] instance pointer to the instance the buffer was taken from.
+ * @param[in] buffer pointer to the buffer returned by nfc_scratch_buffer_acquire().
+ */
+void nfc_scratch_buffer_release(Nfc* instance, BitBuffer* buffer);
+
 /**
  * @brief Transmit and receive a data frame in poller mode.
  *
@@ -2,6 +2,8 @@
 
 #include <storage/storage.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/crc32_calc.h>
 
 #include "nfc_common.h"
 #include "protocols/nfc_device_defs.h"
@@ -12,11 +14,10 @@
 #define NFC_DEVICE_UID_KEY  "UID"
 #define NFC_DEVICE_TYPE_KEY "Device type"
 
-#define NFC_DEVICE_UID_MAX_LEN (10U)
-
 NfcDevice* nfc_device_alloc(void) {
     NfcDevice* instance = malloc(sizeof(NfcDevice));
     instance->protocol = NfcProtocolInvalid;
+    instance->synced_path = furi_string_alloc();
 
     return instance;
 }
@@ -25,12 +26,34 @@ void nfc_device_free(NfcDevice* instance) {
     furi_check(instance);
 
     nfc_device_clear(instance);
+    furi_string_free(instance->synced_path);
     free(instance);
 }
 
+static void nfc_device_set_synced(NfcDevice* instance, Storage* storage, const char* path) {
+    FileInfo file_info;
+    if(storage_common_stat(storage, path, &file_info) == FSE_OK) {
+        furi_string_set(instance->synced_path, path);
+        instance->synced_size = file_info.size;
+    } else {
+        furi_string_reset(instance->synced_path);
+    }
+}
+
+static bool nfc_device_is_synced(NfcDevice* instance, Storage* storage, const char* path) {
+    if(!furi_string_equal_str(instance->synced_path, path)) return false;
+
+    // File could have been changed or removed by someone else
+    FileInfo file_info;
+    return storage_common_stat(storage, path, &file_info) == FSE_OK &&
+           file_info.size == instance->synced_size;
+}
+
 void nfc_device_clear(NfcDevice* instance) {
     furi_check(instance);
 
+    furi_string_reset(instance->synced_path);
+
     if(instance->protocol == NfcProtocolInvalid) {
         furi_assert(instance->protocol_data == NULL);
     } else if(instance->protocol < NfcProtocolNum) {
@@ -46,6 +69,8 @@ void nfc_device_reset(NfcDevice* instance) {
     furi_check(instance);
     furi_check(instance->protocol < NfcProtocolNum);
 
+    furi_string_reset(instance->synced_path);
+
     if(instance->protocol_data) {
         nfc_devices[instance->protocol]->reset(instance->protocol_data);
     }
@@ -87,6 +112,8 @@ bool nfc_device_set_uid(NfcDevice* instance, const uint8_t* uid, size_t uid_len)
     furi_check(uid);
     furi_check(instance->protocol < NfcProtocolNum);
 
+    furi_string_reset(instance->synced_path);
+
     return nfc_devices[instance->protocol]->set_uid(instance->protocol_data, uid, uid_len);
 }
 
@@ -98,6 +125,12 @@ void nfc_device_set_data(
     furi_check(protocol_data);
     furi_check(protocol < NfcProtocolNum);
 
+    // Setting the same data again keeps the file in sync
+    if(!furi_string_empty(instance->synced_path) &&
+       nfc_device_is_equal_data(instance, protocol, protocol_data)) {
+        return;
+    }
+
     nfc_device_clear(instance);
 
     instance->protocol = protocol;
@@ -151,13 +184,47 @@ void nfc_device_set_loading_callback(
     instance->loading_callback_context = context;
 }
 
+bool nfc_device_get_data_hash(const NfcDevice* instance, uint32_t* hash) {
+    furi_check(instance);
+    furi_check(hash);
+
+    if(instance->protocol >= NfcProtocolNum) return false;
+
+    // Serialized form covers each protocol's data without knowing its layout
+    FlipperFormat* ff = flipper_format_string_alloc();
+    bool success = nfc_devices[instance->protocol]->save(instance->protocol_data, ff);
+
+    if(success) {
+        Stream* stream = flipper_format_get_raw_stream(ff);
+        stream_rewind(stream);
+
+        uint8_t buffer[256];
+        uint32_t crc = 0;
+        size_t read_size;
+        while((read_size = stream_read(stream, buffer, sizeof(buffer))) > 0) {
+            crc = crc32_calc_buffer(crc, buffer, read_size);
+        }
+        *hash = crc;
+    }
+
+    flipper_format_free(ff);
+
+    return success;
+}
+
 bool nfc_device_save(NfcDevice* instance, const char* path) {
     furi_check(instance);
     furi_check(instance->protocol < NfcProtocolNum);
     furi_check(path);
 
-    bool saved = false;
     Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    if(nfc_device_is_synced(instance, storage, path)) {
+        furi_record_close(RECORD_STORAGE);
+        return true;
+    }
+
+    bool saved = false;
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
     FuriString* temp_str = furi_string_alloc();
 
@@ -209,6 +276,13 @@ bool nfc_device_save(NfcDevice* instance, const char* path) {
 
     furi_string_free(temp_str);
     flipper_format_free(ff);
+
+    if(saved) {
+        nfc_device_set_synced(instance, storage, path);
+    } else {
+        furi_string_reset(instance->synced_path);
+    }
+
     furi_record_close(RECORD_STORAGE);
 
     return saved;
@@ -323,6 +397,8 @@ bool nfc_device_load(NfcDevice* instance, const char* path) {
     bool loaded = false;
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    // Protocol loaders look up optional keys, which would otherwise scan the whole file
+    flipper_format_set_key_index(ff, true);
 
     FuriString* temp_str;
     temp_str = furi_string_alloc();
@@ -352,6 +428,73 @@ bool nfc_device_load(NfcDevice* instance, const char* path) {
         instance->loading_callback(instance->loading_callback_context, false);
     }
 
+    furi_string_free(temp_str);
+    flipper_format_free(ff);
+
+    if(loaded) {
+        nfc_device_set_synced(instance, storage, path);
+    }
+
+    furi_record_close(RECORD_STORAGE);
+
+    return loaded;
+}
+
+static bool nfc_device_load_info_protocol(
+    FlipperFormat* ff,
+    uint32_t version,
+    FuriString* temp_str,
+    NfcProtocol* protocol) {
+    if(!flipper_format_read_string(ff, NFC_DEVICE_TYPE_KEY, temp_str)) return false;
+
+    for(NfcProtocol i = 0; i < NfcProtocolNum; i++) {
+        bool match;
+        if(version < NFC_UNIFIED_FORMAT_VERSION) {
+            NfcDeviceData* data = nfc_devices[i]->alloc();
+            match = nfc_devices[i]->verify(data, temp_str);
+            nfc_devices[i]->free(data);
+        } else {
+            match = furi_string_equal(temp_str, nfc_devices[i]->protocol_name);
+        }
+
+        if(match) {
+            *protocol = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool nfc_device_load_info(const char* path, NfcProtocol* protocol, uint8_t* uid, size_t* uid_len) {
+    furi_check(path);
+    furi_check(protocol);
+    furi_check(uid);
+    furi_check(uid_len);
+
+    bool loaded = false;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, path)) break;
+
+        uint32_t version = 0;
+        if(!flipper_format_read_header(ff, temp_str, &version)) break;
+        if(furi_string_cmp_str(temp_str, NFC_FILE_HEADER)) break;
+        if(version < NFC_MINIMUM_SUPPORTED_FORMAT_VERSION) break;
+
+        if(!nfc_device_load_info_protocol(ff, version, temp_str, protocol)) break;
+
+        // UID is the first protocol independent key, block data is never reached
+        uint32_t uid_len_loaded;
+        if(!nfc_device_load_uid(ff, uid, &uid_len_loaded, NFC_DEVICE_UID_MAX_LEN)) break;
+
+        *uid_len = uid_len_loaded;
+        loaded = true;
+    } while(false);
+
     furi_string_free(temp_str);
     flipper_format_free(ff);
     furi_record_close(RECORD_STORAGE);
@@ -21,6 +21,8 @@
 extern "C" {
 #endif
 
+#define NFC_DEVICE_UID_MAX_LEN (10U) /**< Longest UID supported by any protocol. */
+
 /**
  * @brief NfcDevice opaque type definition.
  */
@@ -243,9 +245,24 @@ void nfc_device_set_loading_callback(
     NfcLoadingCallback callback,
     void* context);
 
+/**
+ * @brief Calculate a hash of the NFC device data.
+ *
+ * The hash covers the data as it would be saved to a file, so equal data gives
+ * equal hashes regardless of the protocol. Intended for cache lookups.
+ *
+ * @param[in] instance pointer to the instance to be hashed.
+ * @param[out] hash pointer to the variable to hold the hash value.
+ * @returns true if the hash was calculated, false otherwise.
+ */
+bool nfc_device_get_data_hash(const NfcDevice* instance, uint32_t* hash);
+
 /**
  * @brief Save NFC device data form an NfcDevice instance to a file.
  *
+ * Nothing is written if the instance was loaded from or saved to the same file,
+ * has not been modified since and the file size did not change.
+ *
  * @param[in] instance pointer to the instance to be saved.
  * @param[in] path pointer to a character string with a full file path.
  * @returns true if the data was successfully saved, false otherwise.
@@ -261,6 +278,20 @@ bool nfc_device_save(NfcDevice* instance, const char* path);
  */
 bool nfc_device_load(NfcDevice* instance, const char* path);
 
+/**
+ * @brief Load only the protocol and the UID from a file.
+ *
+ * Parsing stops right after the UID, which makes it much faster than nfc_device_load()
+ * for big dumps. Useful for file lists and other places where the full data is not needed.
+ *
+ * @param[in] path pointer to a character string with a full file path.
+ * @param[out] protocol pointer to the protocol identifier to be filled.
+ * @param[out] uid pointer to a buffer of at least NFC_DEVICE_UID_MAX_LEN bytes.
+ * @param[out] uid_len pointer to the UID length to be filled.
+ * @returns true if the information was successfully loaded, false otherwise.
+ */
+bool nfc_device_load_info(const char* path, NfcProtocol* protocol, uint8_t* uid, size_t* uid_len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,8 @@
 
 #include "nfc_device.h"
 
+#include <furi.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -23,6 +25,9 @@ struct NfcDevice {
     NfcLoadingCallback
         loading_callback; /**< Pointer to the function to be called upon loading completion. */
     void* loading_callback_context; /**< Pointer to the context to be passed to the loading callback. */
+
+    FuriString* synced_path; /**< Last loaded or saved file, empty once data is modified. */
+    uint64_t synced_size; /**< Size of the synced file. */
 };
 
 /**
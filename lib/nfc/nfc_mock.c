@@ -85,6 +85,12 @@ struct Nfc {
 
     NfcMode mode;
 
+    BitBuffer* scratch_buffers[NFC_SCRATCH_BUFFER_COUNT];
+    uint8_t scratch_used;
+
+    NfcListenerFastPathCallback fast_path_callback;
+    void* fast_path_context;
+
     FuriThread* worker_thread;
 };
 
@@ -142,15 +148,53 @@ static void nfc_prepare_col_res_data(
 Nfc* nfc_alloc(void) {
     Nfc* instance = malloc(sizeof(Nfc));
 
+    for(size_t i = 0; i < NFC_SCRATCH_BUFFER_COUNT; i++) {
+        instance->scratch_buffers[i] = bit_buffer_alloc(NFC_SCRATCH_BUFFER_SIZE);
+    }
+
     return instance;
 }
 
 void nfc_free(Nfc* instance) {
     furi_check(instance);
+    furi_check(instance->scratch_used == 0);
+
+    for(size_t i = 0; i < NFC_SCRATCH_BUFFER_COUNT; i++) {
+        bit_buffer_free(instance->scratch_buffers[i]);
+    }
 
     free(instance);
 }
 
+BitBuffer* nfc_scratch_buffer_acquire(Nfc* instance) {
+    furi_check(instance);
+
+    size_t index = 0;
+    for(; index < NFC_SCRATCH_BUFFER_COUNT; index++) {
+        if(!(instance->scratch_used & (1U << index))) break;
+    }
+    furi_check(index < NFC_SCRATCH_BUFFER_COUNT, "Out of scratch buffers");
+
+    instance->scratch_used |= 1U << index;
+    bit_buffer_reset(instance->scratch_buffers[index]);
+
+    return instance->scratch_buffers[index];
+}
+
+void nfc_scratch_buffer_release(Nfc* instance, BitBuffer* buffer) {
+    furi_check(instance);
+    furi_check(buffer);
+
+    size_t index = 0;
+    for(; index < NFC_SCRATCH_BUFFER_COUNT; index++) {
+        if(instance->scratch_buffers[index] == buffer) break;
+    }
+    furi_check(index < NFC_SCRATCH_BUFFER_COUNT);
+    furi_check(instance->scratch_used & (1U << index));
+
+    instance->scratch_used &= ~(1U << index);
+}
+
 void nfc_config(Nfc* instance, NfcMode mode, NfcTech tech) {
     UNUSED(instance);
     UNUSED(tech);
@@ -173,6 +217,28 @@ void nfc_set_mask_receive_time_fc(Nfc* instance, uint32_t mask_rx_time_fc) {
     UNUSED(mask_rx_time_fc);
 }
 
+void nfc_set_adaptive_fwt(Nfc* instance, bool enable) {
+    UNUSED(instance);
+    UNUSED(enable);
+}
+
+void nfc_set_listener_fast_path(
+    Nfc* instance,
+    NfcListenerFastPathCallback callback,
+    void* context) {
+    furi_check(instance);
+
+    instance->fast_path_callback = callback;
+    instance->fast_path_context = context;
+}
+
+void nfc_get_timing_stats(const Nfc* instance, NfcTimingStats* stats) {
+    UNUSED(instance);
+    furi_check(stats);
+
+    memset(stats, 0, sizeof(NfcTimingStats));
+}
+
 void nfc_set_fdt_poll_poll_us(Nfc* instance, uint32_t fdt_poll_poll_us) {
     UNUSED(instance);
     UNUSED(fdt_poll_poll_us);
@@ -303,6 +369,7 @@ static int32_t nfc_worker_listener(void* context) {
     NfcEventData event_data = {};
     event_data.buffer = bit_buffer_alloc(NFC_MAX_BUFFER_SIZE);
     NfcEvent nfc_event = {.data = event_data};
+    BitBuffer* fast_path_buffer = bit_buffer_alloc(NFC_MAX_BUFFER_SIZE);
 
     while(true) {
         furi_message_queue_get(listener_queue, &message, FuriWaitForever);
@@ -322,8 +389,14 @@ static int32_t nfc_worker_listener(void* context) {
                     instance, message.data.data, message.data.data_bits);
             } else {
                 instance->state = NfcStateReady;
-                nfc_event.type = NfcEventTypeRxEnd;
-                instance->callback(nfc_event, instance->context);
+                if(instance->fast_path_callback &&
+                   instance->fast_path_callback(
+                       event_data.buffer, fast_path_buffer, instance->fast_path_context)) {
+                    nfc_listener_tx(instance, fast_path_buffer);
+                } else {
+                    nfc_event.type = NfcEventTypeRxEnd;
+                    instance->callback(nfc_event, instance->context);
+                }
             }
         }
     }
@@ -331,6 +404,7 @@ static int32_t nfc_worker_listener(void* context) {
     instance->state = NfcStateIdle;
     instance->col_res_status = Iso14443_3aColResStatusIdle;
     memset(&instance->col_res_data, 0, sizeof(instance->col_res_data));
+    bit_buffer_free(fast_path_buffer);
     bit_buffer_free(nfc_event.data.buffer);
 
     return 0;
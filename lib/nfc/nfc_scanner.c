@@ -2,11 +2,16 @@
 #include "nfc_poller.h"
 
 #include <nfc/protocols/nfc_poller_defs.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
 
 #include <furi/furi.h>
 
 #define TAG "NfcScanner"
 
+#define NFC_SCANNER_PROTOCOL_BIT(protocol) (1UL << (protocol))
+
+_Static_assert(NfcProtocolNum <= 32, "Protocol masks must be extended");
+
 typedef enum {
     NfcScannerStateIdle,
     NfcScannerStateTryBasePollers,
@@ -27,6 +32,7 @@ struct NfcScanner {
     Nfc* nfc;
     NfcScannerState state;
     NfcScannerSessionState session_state;
+    NfcScannerMode mode;
 
     NfcScannerCallback callback;
     void* context;
@@ -51,9 +57,104 @@ struct NfcScanner {
 
     NfcProtocol current_protocol;
 
+    uint32_t tested_mask;
+    uint32_t detected_mask;
+    // Kept from base poller, so children detectors that only look at it don't poll again
+    Iso14443_3aData* iso14443_3a_data;
+
     FuriThread* scan_worker;
 };
 
+// Shared by all instances: scanner is recreated for every card, statistics must outlive it
+static uint8_t nfc_scanner_protocol_hits[NfcProtocolNum] = {};
+
+static size_t nfc_scanner_get_depth(NfcProtocol protocol) {
+    size_t depth = 0;
+    while((protocol = nfc_protocol_get_parent(protocol)) != NfcProtocolInvalid) {
+        depth++;
+    }
+    return depth;
+}
+
+static bool nfc_scanner_is_leaf(NfcProtocol protocol) {
+    bool is_leaf = true;
+    for(size_t i = 0; i < NfcProtocolNum; i++) {
+        if(nfc_protocol_get_parent(i) == protocol) {
+            is_leaf = false;
+            break;
+        }
+    }
+    return is_leaf;
+}
+
+static bool nfc_scanner_protocol_before(NfcProtocol a, NfcProtocol b) {
+    // Parents go first, then protocols that were seen more often
+    const size_t depth_a = nfc_scanner_get_depth(a);
+    const size_t depth_b = nfc_scanner_get_depth(b);
+    if(depth_a != depth_b) return depth_a < depth_b;
+    return nfc_scanner_protocol_hits[a] > nfc_scanner_protocol_hits[b];
+}
+
+static void nfc_scanner_sort_protocols(NfcProtocol* protocols, size_t protocols_num) {
+    // Stable, keeps protocol order for equal statistics
+    for(size_t i = 1; i < protocols_num; i++) {
+        const NfcProtocol protocol = protocols[i];
+        size_t j = i;
+        for(; j > 0 && nfc_scanner_protocol_before(protocol, protocols[j - 1]); j--) {
+            protocols[j] = protocols[j - 1];
+        }
+        protocols[j] = protocol;
+    }
+}
+
+static void nfc_scanner_update_hits(NfcScanner* instance) {
+    for(size_t i = 0; i < instance->detected_protocols_num; i++) {
+        NfcProtocol protocol = instance->detected_protocols[i];
+        do {
+            if(nfc_scanner_protocol_hits[protocol] == UINT8_MAX) {
+                // Age all statistics, recent cards matter more
+                for(size_t j = 0; j < NfcProtocolNum; j++) {
+                    nfc_scanner_protocol_hits[j] /= 2;
+                }
+            }
+            nfc_scanner_protocol_hits[protocol]++;
+            protocol = nfc_protocol_get_parent(protocol);
+        } while(protocol != NfcProtocolInvalid);
+    }
+}
+
+static void nfc_scanner_add_detected(NfcScanner* instance, NfcProtocol protocol) {
+    instance->detected_protocols[instance->detected_protocols_num] = protocol;
+    instance->detected_protocols_num++;
+    instance->detected_mask |= NFC_SCANNER_PROTOCOL_BIT(protocol);
+}
+
+static bool nfc_scanner_is_ruled_out(NfcScanner* instance, NfcProtocol protocol) {
+    // Child detection goes through the parent one, it can't succeed if any parent failed
+    bool ruled_out = false;
+    while((protocol = nfc_protocol_get_parent(protocol)) != NfcProtocolInvalid) {
+        const uint32_t protocol_bit = NFC_SCANNER_PROTOCOL_BIT(protocol);
+        if((instance->tested_mask & protocol_bit) && !(instance->detected_mask & protocol_bit)) {
+            ruled_out = true;
+            break;
+        }
+    }
+    return ruled_out;
+}
+
+static bool nfc_scanner_infer(NfcScanner* instance, NfcProtocol protocol, bool* detected) {
+    bool inferred = false;
+
+    // ISO14443-4A poller only checks SAK, base poller has already received it
+    if(protocol == NfcProtocolIso14443_4a &&
+       (instance->detected_mask & NFC_SCANNER_PROTOCOL_BIT(NfcProtocolIso14443_3a))) {
+        *detected = iso14443_3a_supports_iso14443_4(instance->iso14443_3a_data);
+        inferred = true;
+    }
+
+    return inferred;
+}
+
 static void nfc_scanner_reset(NfcScanner* instance) {
     instance->base_protocols_idx = 0;
     instance->base_protocols_num = 0;
@@ -65,6 +166,9 @@ static void nfc_scanner_reset(NfcScanner* instance) {
     instance->detected_base_protocols_num = 0;
 
     instance->current_protocol = 0;
+
+    instance->tested_mask = 0;
+    instance->detected_mask = 0;
 }
 
 typedef void (*NfcScannerStateHandler)(NfcScanner* instance);
@@ -77,6 +181,7 @@ void nfc_scanner_state_handler_idle(NfcScanner* instance) {
             instance->base_protocols_num++;
         }
     }
+    nfc_scanner_sort_protocols(instance->base_protocols, instance->base_protocols_num);
     FURI_LOG_D(TAG, "Found %zu base protocols", instance->base_protocols_num);
 
     instance->first_detected_protocol = NfcProtocolInvalid;
@@ -94,17 +199,23 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
 
         NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
         bool protocol_detected = nfc_poller_detect(poller);
+        if(protocol_detected && instance->current_protocol == NfcProtocolIso14443_3a) {
+            iso14443_3a_copy(instance->iso14443_3a_data, nfc_poller_get_data(poller));
+        }
         nfc_poller_free(poller);
 
         if(protocol_detected) {
-            instance->detected_protocols[instance->detected_protocols_num] =
-                instance->current_protocol;
-            instance->detected_protocols_num++;
+            nfc_scanner_add_detected(instance, instance->current_protocol);
 
             instance->detected_base_protocols[instance->detected_base_protocols_num] =
                 instance->current_protocol;
             instance->detected_base_protocols_num++;
 
+            if(instance->mode == NfcScannerModeFast) {
+                instance->state = NfcScannerStateFindChildrenProtocols;
+                break;
+            }
+
             if(instance->first_detected_protocol == NfcProtocolInvalid) {
                 instance->first_detected_protocol = instance->current_protocol;
                 instance->current_protocol = NfcProtocolInvalid;
@@ -116,6 +227,8 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
     } while(false);
 }
 
+static void nfc_scanner_finish(NfcScanner* instance);
+
 void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
     for(size_t i = 0; i < NfcProtocolNum; i++) {
         for(size_t j = 0; j < instance->detected_base_protocols_num; j++) {
@@ -127,9 +240,11 @@ void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
     }
 
     if(instance->children_protocols_num > 0) {
+        nfc_scanner_sort_protocols(
+            instance->children_protocols, instance->children_protocols_num);
         instance->state = NfcScannerStateDetectChildrenProtocols;
     } else {
-        instance->state = NfcScannerStateComplete;
+        nfc_scanner_finish(instance);
     }
     FURI_LOG_D(TAG, "Found %zu children", instance->children_protocols_num);
 }
@@ -138,20 +253,26 @@ void nfc_scanner_state_handler_detect_children_protocols(NfcScanner* instance) {
     furi_assert(instance->children_protocols_num);
 
     instance->current_protocol = instance->children_protocols[instance->children_protocols_idx];
+    instance->children_protocols_idx++;
 
-    NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
-    bool protocol_detected = nfc_poller_detect(poller);
-    nfc_poller_free(poller);
+    bool protocol_detected = false;
+    if(nfc_scanner_is_ruled_out(instance, instance->current_protocol)) {
+        FURI_LOG_D(TAG, "Skip %d, parent not detected", instance->current_protocol);
+    } else if(!nfc_scanner_infer(instance, instance->current_protocol, &protocol_detected)) {
+        NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
+        protocol_detected = nfc_poller_detect(poller);
+        nfc_poller_free(poller);
+    }
+    instance->tested_mask |= NFC_SCANNER_PROTOCOL_BIT(instance->current_protocol);
 
     if(protocol_detected) {
-        instance->detected_protocols[instance->detected_protocols_num] =
-            instance->current_protocol;
-        instance->detected_protocols_num++;
+        nfc_scanner_add_detected(instance, instance->current_protocol);
     }
 
-    instance->children_protocols_idx++;
-    if(instance->children_protocols_idx == instance->children_protocols_num) {
-        instance->state = NfcScannerStateComplete;
+    if((instance->children_protocols_idx == instance->children_protocols_num) ||
+       (protocol_detected && instance->mode == NfcScannerModeFast &&
+        nfc_scanner_is_leaf(instance->current_protocol))) {
+        nfc_scanner_finish(instance);
     }
 }
 
@@ -173,15 +294,23 @@ static void nfc_scanner_filter_detected_protocols(NfcScanner* instance) {
     }
 
     instance->detected_protocols_num = filtered_protocols_num;
-    memcpy(instance->detected_protocols, filtered_protocols, filtered_protocols_num);
+    memcpy(
+        instance->detected_protocols,
+        filtered_protocols,
+        filtered_protocols_num * sizeof(NfcProtocol));
 }
 
-void nfc_scanner_state_handler_complete(NfcScanner* instance) {
+static void nfc_scanner_finish(NfcScanner* instance) {
     if(instance->detected_protocols_num > 1) {
         nfc_scanner_filter_detected_protocols(instance);
     }
+    nfc_scanner_update_hits(instance);
     FURI_LOG_I(TAG, "Detected %zu protocols", instance->detected_protocols_num);
 
+    instance->state = NfcScannerStateComplete;
+}
+
+void nfc_scanner_state_handler_complete(NfcScanner* instance) {
     NfcScannerEvent event = {
         .type = NfcScannerEventTypeDetected,
         .data =
@@ -222,6 +351,8 @@ NfcScanner* nfc_scanner_alloc(Nfc* nfc) {
 
     NfcScanner* instance = malloc(sizeof(NfcScanner));
     instance->nfc = nfc;
+    instance->mode = NfcScannerModeFull;
+    instance->iso14443_3a_data = iso14443_3a_alloc();
 
     return instance;
 }
@@ -230,9 +361,17 @@ void nfc_scanner_free(NfcScanner* instance) {
     furi_check(instance);
     furi_check(instance->state == NfcScannerStateIdle);
 
+    iso14443_3a_free(instance->iso14443_3a_data);
     free(instance);
 }
 
+void nfc_scanner_set_mode(NfcScanner* instance, NfcScannerMode mode) {
+    furi_check(instance);
+    furi_check(instance->scan_worker == NULL);
+
+    instance->mode = mode;
+}
+
 void nfc_scanner_start(NfcScanner* instance, NfcScannerCallback callback, void* context) {
     furi_check(instance);
     furi_check(callback);
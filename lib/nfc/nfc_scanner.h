@@ -11,6 +11,10 @@
  *
  * If no supported cards are in the vicinity, the scanning process will continue
  * until stopped explicitly.
+ *
+ * Protocols that were detected recently are tried first. In NfcScannerModeFast
+ * the scanner stops as soon as a protocol without children is confirmed, which
+ * is useful when many cards of the same kind are scanned in a row.
  */
 #pragma once
 
@@ -26,6 +30,14 @@ extern "C" {
  */
 typedef struct NfcScanner NfcScanner;
 
+/**
+ * @brief Scanning mode.
+ */
+typedef enum {
+    NfcScannerModeFull, /**< Try all protocols, default. */
+    NfcScannerModeFast, /**< Stop at the first detected leaf protocol. */
+} NfcScannerMode;
+
 /**
  * @brief Event type passed to the user callback.
  */
@@ -76,6 +88,16 @@ NfcScanner* nfc_scanner_alloc(Nfc* nfc);
  */
 void nfc_scanner_free(NfcScanner* instance);
 
+/**
+ * @brief Set NfcScanner mode.
+ *
+ * Must be called while the scanner is stopped.
+ *
+ * @param[in,out] instance pointer to the instance to be configured.
+ * @param[in] mode scanning mode to be used on next start.
+ */
+void nfc_scanner_set_mode(NfcScanner* instance, NfcScannerMode mode);
+
 /**
  * @brief Start an NfcScanner.
  *
@@ -112,11 +112,32 @@ Iso15693_3Error iso15693_3_poller_read_block(
     uint8_t block_number,
     uint8_t block_size);
 
+/**
+ * @brief Read a range of Iso15693_3 blocks with a single READ MULTIPLE BLOCKS command.
+ *
+ * Must ONLY be used inside the callback function.
+ *
+ * @param[in, out] instance pointer to the instance to be used in the transaction.
+ * @param[out] data pointer to the buffer to be filled with the block data.
+ * @param[in] first_block_number number of the first block to be read.
+ * @param[in] block_count number of blocks to be read, response must fit the poller buffer.
+ * @param[in] block_size size of the blocks to be read.
+ * @return Iso15693_3ErrorNone on success, an error code on failure.
+ */
+Iso15693_3Error iso15693_3_poller_read_multiple_blocks(
+    Iso15693_3Poller* instance,
+    uint8_t* data,
+    uint8_t first_block_number,
+    uint8_t block_count,
+    uint8_t block_size);
+
 /**
  * @brief Read multiple Iso15693_3 blocks.
  *
  * Must ONLY be used inside the callback function.
  *
+ * Uses READ MULTIPLE BLOCKS where the card supports it, single block reads otherwise.
+ *
  * @param[in, out] instance pointer to the instance to be used in the transaction.
  * @param[out] data pointer to the buffer to be filled with the block data.
  * @param[in] block_count number of blocks to be read.
@@ -214,6 +214,50 @@ Iso15693_3Error iso15693_3_poller_read_block(
     return ret;
 }
 
+Iso15693_3Error iso15693_3_poller_read_multiple_blocks(
+    Iso15693_3Poller* instance,
+    uint8_t* data,
+    uint8_t first_block_number,
+    uint8_t block_count,
+    uint8_t block_size) {
+    furi_assert(instance);
+    furi_assert(data);
+    furi_assert(block_count);
+    furi_check(first_block_number + block_count <= UINT8_MAX + 1);
+
+    Iso15693_3Error ret;
+
+    do {
+        // Response holds flags, data and CRC
+        if(sizeof(uint8_t) + block_count * block_size >
+           bit_buffer_get_capacity_bytes(instance->rx_buffer) - ISO13239_CRC_SIZE) {
+            ret = Iso15693_3ErrorBufferOverflow;
+            break;
+        }
+
+        bit_buffer_reset(instance->tx_buffer);
+        bit_buffer_reset(instance->rx_buffer);
+
+        bit_buffer_append_byte(
+            instance->tx_buffer,
+            ISO15693_3_REQ_FLAG_SUBCARRIER_1 | ISO15693_3_REQ_FLAG_DATA_RATE_HI);
+        bit_buffer_append_byte(instance->tx_buffer, ISO15693_3_CMD_READ_MULTI_BLOCKS);
+        bit_buffer_append_byte(instance->tx_buffer, first_block_number);
+        // Block count byte must be 1 less than the desired count
+        bit_buffer_append_byte(instance->tx_buffer, block_count - 1);
+
+        ret = iso15693_3_poller_send_frame(
+            instance, instance->tx_buffer, instance->rx_buffer, ISO15693_3_FDT_POLL_FC);
+        if(ret != Iso15693_3ErrorNone) break;
+
+        // Same layout as READ SINGLE BLOCK response, only longer
+        ret = iso15693_3_read_block_response_parse(
+            data, block_count * block_size, instance->rx_buffer);
+    } while(false);
+
+    return ret;
+}
+
 Iso15693_3Error iso15693_3_poller_read_blocks(
     Iso15693_3Poller* instance,
     uint8_t* data,
@@ -226,9 +270,31 @@ Iso15693_3Error iso15693_3_poller_read_blocks(
 
     Iso15693_3Error ret = Iso15693_3ErrorNone;
 
-    for(uint32_t i = 0; i < block_count; ++i) {
-        ret = iso15693_3_poller_read_block(instance, &data[block_size * i], i, block_size);
-        if(ret != Iso15693_3ErrorNone) break;
+    // As many blocks per query as the buffers can hold
+    const size_t payload_size_max = ISO15693_3_POLLER_MAX_BUFFER_SIZE - ISO13239_CRC_SIZE - 1;
+    uint32_t blocks_per_query =
+        MIN(payload_size_max / block_size, ISO15693_3_POLLER_NUM_BLOCKS_PER_QUERY);
+    bool multiple_read_success = false;
+
+    for(uint32_t i = 0; i < block_count;) {
+        if(blocks_per_query > 1) {
+            const uint8_t query_block_count = MIN(block_count - i, blocks_per_query);
+            ret = iso15693_3_poller_read_multiple_blocks(
+                instance, &data[block_size * i], i, query_block_count, block_size);
+            if(ret == Iso15693_3ErrorNone) {
+                multiple_read_success = true;
+                i += query_block_count;
+            } else {
+                // Optional command: no support at all means single block reads,
+                // otherwise some card limit was hit and smaller queries are tried
+                FURI_LOG_D(TAG, "Read %u blocks from %lu failed", query_block_count, i);
+                blocks_per_query = multiple_read_success ? blocks_per_query / 2 : 1;
+            }
+        } else {
+            ret = iso15693_3_poller_read_block(instance, &data[block_size * i], i, block_size);
+            if(ret != Iso15693_3ErrorNone) break;
+            i++;
+        }
     }
 
     return ret;
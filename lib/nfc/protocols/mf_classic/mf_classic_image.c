@@ -0,0 +1,117 @@
+#include "mf_classic_image.h"
+
+#include <furi/furi.h>
+
+#define MF_CLASSIC_IMAGE_SECTOR_ABSENT (UINT8_MAX)
+
+struct MfClassicImage {
+    Iso14443_3aData* iso14443_3a_data;
+    MfClassicType type;
+    uint32_t block_read_mask[MF_CLASSIC_READ_MASK_SIZE];
+    uint64_t key_a_mask;
+    uint64_t key_b_mask;
+    // Index of the sector's first block in blocks, never above 240 so the marker is unambiguous
+    uint8_t sector_offset[MF_CLASSIC_TOTAL_SECTORS_MAX];
+    uint16_t blocks_num;
+    MfClassicBlock* blocks;
+};
+
+static bool mf_classic_image_is_sector_empty(const MfClassicData* data, uint8_t sector_num) {
+    const size_t first_block = mf_classic_get_first_block_num_of_sector(sector_num);
+    const size_t blocks_num = mf_classic_get_blocks_num_in_sector(sector_num);
+    const uint8_t* bytes = data->block[first_block].data;
+
+    for(size_t i = 0; i < blocks_num * MF_CLASSIC_BLOCK_SIZE; i++) {
+        if(bytes[i]) return false;
+    }
+
+    return true;
+}
+
+MfClassicImage* mf_classic_image_alloc(const MfClassicData* data) {
+    furi_check(data);
+
+    MfClassicImage* image = malloc(sizeof(MfClassicImage));
+    image->iso14443_3a_data = iso14443_3a_alloc();
+    iso14443_3a_copy(image->iso14443_3a_data, data->iso14443_3a_data);
+    image->type = data->type;
+    memcpy(image->block_read_mask, data->block_read_mask, sizeof(data->block_read_mask));
+    image->key_a_mask = data->key_a_mask;
+    image->key_b_mask = data->key_b_mask;
+
+    // All sectors are visited, data beyond the card type survives the round trip too
+    uint16_t blocks_num = 0;
+    for(size_t i = 0; i < MF_CLASSIC_TOTAL_SECTORS_MAX; i++) {
+        if(mf_classic_image_is_sector_empty(data, i)) {
+            image->sector_offset[i] = MF_CLASSIC_IMAGE_SECTOR_ABSENT;
+        } else {
+            blocks_num += mf_classic_get_blocks_num_in_sector(i);
+        }
+    }
+
+    image->blocks_num = blocks_num;
+    image->blocks = blocks_num ? malloc(blocks_num * sizeof(MfClassicBlock)) : NULL;
+
+    uint16_t offset = 0;
+    for(size_t i = 0; i < MF_CLASSIC_TOTAL_SECTORS_MAX; i++) {
+        if(image->sector_offset[i] == MF_CLASSIC_IMAGE_SECTOR_ABSENT) continue;
+
+        const uint8_t sector_blocks_num = mf_classic_get_blocks_num_in_sector(i);
+        const uint8_t first_block = mf_classic_get_first_block_num_of_sector(i);
+        memcpy(
+            &image->blocks[offset],
+            &data->block[first_block],
+            sector_blocks_num * sizeof(MfClassicBlock));
+        image->sector_offset[i] = offset;
+        offset += sector_blocks_num;
+    }
+
+    return image;
+}
+
+void mf_classic_image_free(MfClassicImage* image) {
+    furi_check(image);
+
+    iso14443_3a_free(image->iso14443_3a_data);
+    free(image->blocks);
+    free(image);
+}
+
+void mf_classic_image_restore(const MfClassicImage* image, MfClassicData* data) {
+    furi_check(image);
+    furi_check(data);
+
+    iso14443_3a_copy(data->iso14443_3a_data, image->iso14443_3a_data);
+    data->type = image->type;
+    memcpy(data->block_read_mask, image->block_read_mask, sizeof(data->block_read_mask));
+    data->key_a_mask = image->key_a_mask;
+    data->key_b_mask = image->key_b_mask;
+
+    for(size_t i = 0; i < MF_CLASSIC_TOTAL_SECTORS_MAX; i++) {
+        const uint8_t sector_blocks_num = mf_classic_get_blocks_num_in_sector(i);
+        const uint8_t first_block = mf_classic_get_first_block_num_of_sector(i);
+        const size_t sector_size = sector_blocks_num * sizeof(MfClassicBlock);
+
+        if(image->sector_offset[i] == MF_CLASSIC_IMAGE_SECTOR_ABSENT) {
+            memset(&data->block[first_block], 0, sector_size);
+        } else {
+            memcpy(
+                &data->block[first_block],
+                &image->blocks[image->sector_offset[i]],
+                sector_size);
+        }
+    }
+}
+
+MfClassicType mf_classic_image_get_type(const MfClassicImage* image) {
+    furi_check(image);
+
+    return image->type;
+}
+
+size_t mf_classic_image_get_size(const MfClassicImage* image) {
+    furi_check(image);
+
+    return sizeof(MfClassicImage) + sizeof(Iso14443_3aData) +
+           image->blocks_num * sizeof(MfClassicBlock);
+}
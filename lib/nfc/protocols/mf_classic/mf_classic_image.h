@@ -0,0 +1,65 @@
+/**
+ * @file mf_classic_image.h
+ * @brief Compact Mifare Classic card image.
+ *
+ * MfClassicData always reserves room for the 4K layout. Image keeps only sectors
+ * holding non-zero blocks, which makes it suitable for keeping several cards in memory.
+ * Image is immutable and restores into MfClassicData bit for bit.
+ */
+#pragma once
+
+#include "mf_classic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief MfClassicImage opaque type definition.
+ */
+typedef struct MfClassicImage MfClassicImage;
+
+/**
+ * @brief Allocate an MfClassicImage holding a copy of the card data.
+ *
+ * @param[in] data pointer to the card data to be packed.
+ * @returns pointer to the allocated MfClassicImage instance.
+ */
+MfClassicImage* mf_classic_image_alloc(const MfClassicData* data);
+
+/**
+ * @brief Delete an MfClassicImage instance.
+ *
+ * @param[in,out] image pointer to the instance to be deleted.
+ */
+void mf_classic_image_free(MfClassicImage* image);
+
+/**
+ * @brief Unpack the image into card data.
+ *
+ * Sectors missing from the image are zeroed.
+ *
+ * @param[in] image pointer to the image to be unpacked.
+ * @param[out] data pointer to the card data to be filled.
+ */
+void mf_classic_image_restore(const MfClassicImage* image, MfClassicData* data);
+
+/**
+ * @brief Get the card type stored in the image.
+ *
+ * @param[in] image pointer to the image to be queried.
+ * @returns card type.
+ */
+MfClassicType mf_classic_image_get_type(const MfClassicImage* image);
+
+/**
+ * @brief Get the amount of heap taken by the image.
+ *
+ * @param[in] image pointer to the image to be queried.
+ * @returns image size in bytes.
+ */
+size_t mf_classic_image_get_size(const MfClassicImage* image);
+
+#ifdef __cplusplus
+}
+#endif
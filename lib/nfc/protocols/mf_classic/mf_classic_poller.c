@@ -58,6 +58,8 @@ void mf_classic_poller_free(MfClassicPoller* instance) {
     furi_assert(instance->tx_encrypted_buffer);
     furi_assert(instance->rx_encrypted_buffer);
 
+    nfc_set_adaptive_fwt(instance->iso14443_3a_poller->nfc, false);
+
     mf_classic_free(instance->data);
     crypto1_free(instance->crypto);
     bit_buffer_free(instance->tx_plain_buffer);
@@ -83,6 +85,7 @@ void mf_classic_poller_free(MfClassicPoller* instance) {
         free(dict_attack_ctx->nested_nonce.nonces);
         dict_attack_ctx->nested_nonce.nonces = NULL;
         dict_attack_ctx->nested_nonce.count = 0;
+        dict_attack_ctx->nested_nonce.capacity = 0;
     }
 
     free(instance);
@@ -161,13 +164,18 @@ NfcCommand mf_classic_poller_handler_start(MfClassicPoller* instance) {
     memset(&instance->mode_ctx, 0, sizeof(MfClassicPollerModeContext));
 
     instance->mfc_event.type = MfClassicPollerEventTypeRequestMode;
+    instance->mfc_event_data.poller_mode.key_batch = false;
     command = instance->callback(instance->general_event, instance->context);
 
     if(instance->mfc_event_data.poller_mode.mode == MfClassicPollerModeDictAttackStandard) {
         mf_classic_copy(instance->data, instance->mfc_event_data.poller_mode.data);
+        instance->mode_ctx.dict_attack_ctx.key_batch_enabled =
+            instance->mfc_event_data.poller_mode.key_batch;
         instance->state = MfClassicPollerStateRequestKey;
     } else if(instance->mfc_event_data.poller_mode.mode == MfClassicPollerModeDictAttackEnhanced) {
         mf_classic_copy(instance->data, instance->mfc_event_data.poller_mode.data);
+        instance->mode_ctx.dict_attack_ctx.key_batch_enabled =
+            instance->mfc_event_data.poller_mode.key_batch;
         instance->state = MfClassicPollerStateAnalyzeBackdoor;
     } else if(instance->mfc_event_data.poller_mode.mode == MfClassicPollerModeRead) {
         instance->state = MfClassicPollerStateRequestReadSector;
@@ -177,6 +185,12 @@ NfcCommand mf_classic_poller_handler_start(MfClassicPoller* instance) {
         furi_crash("Invalid mode selected");
     }
 
+    // Wrong keys are answered with silence, there is no point to wait full FWT for each of them
+    const bool is_dict_attack =
+        instance->mfc_event_data.poller_mode.mode == MfClassicPollerModeDictAttackStandard ||
+        instance->mfc_event_data.poller_mode.mode == MfClassicPollerModeDictAttackEnhanced;
+    nfc_set_adaptive_fwt(instance->iso14443_3a_poller->nfc, is_dict_attack);
+
     return command;
 }
 
@@ -679,14 +693,109 @@ NfcCommand mf_classic_poller_handler_backdoor_read_sector(MfClassicPoller* insta
     return command;
 }
 
+static void mf_classic_poller_key_batch_reset(MfClassicPollerDictAttackContext* dict_attack_ctx) {
+    dict_attack_ctx->key_batch_num = 0;
+    dict_attack_ctx->key_batch_pos = 0;
+    dict_attack_ctx->key_batch_last = false;
+}
+
+static void mf_classic_poller_key_reuse_log(MfClassicPoller* instance) {
+    MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
+
+    if(dict_attack_ctx->reuse_key_start_sector >= instance->sectors_total) return;
+    if(dict_attack_ctx->reused_keys_num == MF_CLASSIC_KEY_REUSE_LOG_SIZE) return;
+
+    uint8_t index = dict_attack_ctx->reused_keys_num++;
+    dict_attack_ctx->reused_keys[index] = dict_attack_ctx->current_key;
+    dict_attack_ctx->reused_keys_sector[index] = dict_attack_ctx->reuse_key_start_sector;
+}
+
+static bool mf_classic_poller_key_batch_is_tried(
+    MfClassicPollerDictAttackContext* dict_attack_ctx,
+    uint8_t index) {
+    const MfClassicKey* key = &dict_attack_ctx->key_batch[index];
+
+    // Duplicate of a key earlier in the batch
+    for(uint8_t i = 0; i < index; i++) {
+        if(memcmp(dict_attack_ctx->key_batch[i].data, key->data, sizeof(MfClassicKey)) == 0) {
+            return true;
+        }
+    }
+
+    // Key reuse already tried it for both key types on this sector
+    for(uint8_t i = 0; i < dict_attack_ctx->reused_keys_num; i++) {
+        if((dict_attack_ctx->reused_keys_sector[i] <= dict_attack_ctx->current_sector) &&
+           (memcmp(dict_attack_ctx->reused_keys[i].data, key->data, sizeof(MfClassicKey)) == 0)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static NfcCommand mf_classic_poller_key_batch_request(MfClassicPoller* instance) {
+    MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
+    MfClassicPollerEventDataKeyBatchRequest* request =
+        &instance->mfc_event_data.key_batch_request_data;
+
+    instance->mfc_event.type = MfClassicPollerEventTypeRequestKeyBatch;
+    request->keys = dict_attack_ctx->key_batch;
+    request->keys_max = MF_CLASSIC_KEY_BATCH_SIZE;
+    request->keys_num = 0;
+    NfcCommand command = instance->callback(instance->general_event, instance->context);
+
+    dict_attack_ctx->key_batch_num = MIN(request->keys_num, (size_t)MF_CLASSIC_KEY_BATCH_SIZE);
+    dict_attack_ctx->key_batch_pos = 0;
+    dict_attack_ctx->key_batch_last = dict_attack_ctx->key_batch_num < MF_CLASSIC_KEY_BATCH_SIZE;
+
+    dict_attack_ctx->key_batch_tried = 0;
+    for(uint8_t i = 0; i < dict_attack_ctx->key_batch_num; i++) {
+        if(mf_classic_poller_key_batch_is_tried(dict_attack_ctx, i)) {
+            dict_attack_ctx->key_batch_tried |= 1UL << i;
+        }
+    }
+
+    return command;
+}
+
+static bool mf_classic_poller_key_batch_get_next(MfClassicPoller* instance, NfcCommand* command) {
+    MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
+
+    while(true) {
+        if(dict_attack_ctx->key_batch_pos == dict_attack_ctx->key_batch_num) {
+            if(dict_attack_ctx->key_batch_last) break;
+            *command = mf_classic_poller_key_batch_request(instance);
+            if(*command != NfcCommandContinue) break;
+            continue;
+        }
+
+        uint8_t index = dict_attack_ctx->key_batch_pos++;
+        if(!(dict_attack_ctx->key_batch_tried & (1UL << index))) {
+            dict_attack_ctx->current_key = dict_attack_ctx->key_batch[index];
+            return true;
+        }
+    }
+
+    return false;
+}
+
 NfcCommand mf_classic_poller_handler_request_key(MfClassicPoller* instance) {
     NfcCommand command = NfcCommandContinue;
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
 
-    instance->mfc_event.type = MfClassicPollerEventTypeRequestKey;
-    command = instance->callback(instance->general_event, instance->context);
-    if(instance->mfc_event_data.key_request_data.key_provided) {
-        dict_attack_ctx->current_key = instance->mfc_event_data.key_request_data.key;
+    bool key_provided = false;
+    if(dict_attack_ctx->key_batch_enabled) {
+        key_provided = mf_classic_poller_key_batch_get_next(instance, &command);
+    } else {
+        instance->mfc_event.type = MfClassicPollerEventTypeRequestKey;
+        command = instance->callback(instance->general_event, instance->context);
+        key_provided = instance->mfc_event_data.key_request_data.key_provided;
+        if(key_provided) {
+            dict_attack_ctx->current_key = instance->mfc_event_data.key_request_data.key;
+        }
+    }
+
+    if(key_provided) {
         instance->state = MfClassicPollerStateAuthKeyA;
     } else {
         instance->state = MfClassicPollerStateNextSector;
@@ -780,6 +889,7 @@ NfcCommand mf_classic_poller_handler_next_sector(MfClassicPoller* instance) {
         instance->mfc_event.type = MfClassicPollerEventTypeNextSector;
         instance->mfc_event_data.next_sector_data.current_sector = dict_attack_ctx->current_sector;
         command = instance->callback(instance->general_event, instance->context);
+        mf_classic_poller_key_batch_reset(dict_attack_ctx);
         instance->state = MfClassicPollerStateRequestKey;
     }
 
@@ -840,6 +950,7 @@ NfcCommand mf_classic_poller_handler_read_sector(MfClassicPoller* instance) {
             instance->state = MfClassicPollerStateNextSector;
         } else {
             dict_attack_ctx->reuse_key_sector = dict_attack_ctx->current_sector;
+            dict_attack_ctx->reuse_key_start_sector = dict_attack_ctx->current_sector;
             instance->mfc_event.type = MfClassicPollerEventTypeKeyAttackStart;
             instance->mfc_event_data.key_attack_data.current_sector =
                 dict_attack_ctx->reuse_key_sector;
@@ -864,6 +975,8 @@ NfcCommand mf_classic_poller_handler_key_reuse_start(MfClassicPoller* instance)
             if(dict_attack_ctx->reuse_key_sector == instance->sectors_total) {
                 instance->mfc_event.type = MfClassicPollerEventTypeKeyAttackStop;
                 command = instance->callback(instance->general_event, instance->context);
+                mf_classic_poller_key_reuse_log(instance);
+                mf_classic_poller_key_batch_reset(dict_attack_ctx);
                 // Nested entrypoint
                 bool nested_active = dict_attack_ctx->nested_phase != MfClassicNestedPhaseNone;
                 if((dict_attack_ctx->enhanced_dict) &&
@@ -893,6 +1006,8 @@ NfcCommand mf_classic_poller_handler_key_reuse_start_no_offset(MfClassicPoller*
     NfcCommand command = NfcCommandContinue;
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
 
+    // Only one key type is tried on the first sector, don't treat this key as reused
+    dict_attack_ctx->reuse_key_start_sector = instance->sectors_total;
     instance->mfc_event.type = MfClassicPollerEventTypeKeyAttackStart;
     instance->mfc_event_data.key_attack_data.current_sector = dict_attack_ctx->reuse_key_sector;
     command = instance->callback(instance->general_event, instance->context);
@@ -1041,15 +1156,17 @@ static bool add_nested_nonce(
     uint32_t nt_enc,
     uint8_t par,
     uint16_t dist) {
-    MfClassicNestedNonce* new_nonces;
-    if(array->count == 0) {
-        new_nonces = malloc(sizeof(MfClassicNestedNonce));
-    } else {
-        new_nonces = realloc(array->nonces, (array->count + 1) * sizeof(MfClassicNestedNonce));
+    if(array->count == array->capacity) {
+        // Grow geometrically, nonces are collected one by one for the whole attack
+        const size_t capacity = array->capacity ? array->capacity * 2 : 4;
+        MfClassicNestedNonce* new_nonces =
+            realloc(array->nonces, capacity * sizeof(MfClassicNestedNonce));
+        if(new_nonces == NULL) return false;
+
+        array->nonces = new_nonces;
+        array->capacity = capacity;
     }
-    if(new_nonces == NULL) return false;
 
-    array->nonces = new_nonces;
     array->nonces[array->count].cuid = cuid;
     array->nonces[array->count].key_idx = key_idx;
     array->nonces[array->count].nt = nt;
@@ -1669,6 +1786,7 @@ NfcCommand mf_classic_poller_handler_nested_dict_attack(MfClassicPoller* instanc
                 free(dict_attack_ctx->nested_nonce.nonces);
                 dict_attack_ctx->nested_nonce.nonces = NULL;
                 dict_attack_ctx->nested_nonce.count = 0;
+                dict_attack_ctx->nested_nonce.capacity = 0;
             }
         }
 
@@ -1767,6 +1885,7 @@ NfcCommand mf_classic_poller_handler_nested_log(MfClassicPoller* instance) {
     free(dict_attack_ctx->nested_nonce.nonces);
     dict_attack_ctx->nested_nonce.nonces = NULL;
     dict_attack_ctx->nested_nonce.count = 0;
+    dict_attack_ctx->nested_nonce.capacity = 0;
     furi_string_free(temp_str);
     buffered_file_stream_close(stream);
     stream_free(stream);
@@ -1860,6 +1979,7 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
                 free(dict_attack_ctx->nested_nonce.nonces);
                 dict_attack_ctx->nested_nonce.nonces = NULL;
                 dict_attack_ctx->nested_nonce.count = 0;
+                dict_attack_ctx->nested_nonce.capacity = 0;
             }
             instance->state = MfClassicPollerStateFail;
             return command;
@@ -1870,6 +1990,7 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
             free(dict_attack_ctx->nested_nonce.nonces);
             dict_attack_ctx->nested_nonce.nonces = NULL;
             dict_attack_ctx->nested_nonce.count = 0;
+            dict_attack_ctx->nested_nonce.capacity = 0;
         }
         dict_attack_ctx->nested_phase = MfClassicNestedPhaseDictAttack;
         initial_dict_attack_iter = true;
@@ -1893,6 +2014,7 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
                 free(dict_attack_ctx->nested_nonce.nonces);
                 dict_attack_ctx->nested_nonce.nonces = NULL;
                 dict_attack_ctx->nested_nonce.count = 0;
+                dict_attack_ctx->nested_nonce.capacity = 0;
             }
             dict_attack_ctx->nested_phase = MfClassicNestedPhaseDictAttack;
         }
@@ -2061,6 +2183,7 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
                     free(dict_attack_ctx->nested_nonce.nonces);
                     dict_attack_ctx->nested_nonce.nonces = NULL;
                     dict_attack_ctx->nested_nonce.count = 0;
+                    dict_attack_ctx->nested_nonce.capacity = 0;
                 }
                 if(is_weak) {
                     dict_attack_ctx->nested_target_key += 2;
@@ -2216,11 +2339,12 @@ bool mf_classic_poller_detect(NfcGenericEvent event, void* context) {
     Iso14443_3aPollerEvent* iso14443_3a_event = event.event_data;
     bool detected = false;
     const uint8_t auth_cmd[] = {MF_CLASSIC_CMD_AUTH_KEY_A, 0};
-    BitBuffer* tx_buffer = bit_buffer_alloc(COUNT_OF(auth_cmd));
-    bit_buffer_copy_bytes(tx_buffer, auth_cmd, COUNT_OF(auth_cmd));
-    BitBuffer* rx_buffer = bit_buffer_alloc(sizeof(MfClassicNt));
 
     if(iso14443_3a_event->type == Iso14443_3aPollerEventTypeReady) {
+        BitBuffer* tx_buffer = nfc_scratch_buffer_acquire(iso3_poller->nfc);
+        BitBuffer* rx_buffer = nfc_scratch_buffer_acquire(iso3_poller->nfc);
+        bit_buffer_copy_bytes(tx_buffer, auth_cmd, COUNT_OF(auth_cmd));
+
         Iso14443_3aError error = iso14443_3a_poller_send_standard_frame(
             iso3_poller, tx_buffer, rx_buffer, MF_CLASSIC_FWT_FC);
         if(error == Iso14443_3aErrorWrongCrc) {
@@ -2228,10 +2352,10 @@ bool mf_classic_poller_detect(NfcGenericEvent event, void* context) {
                 detected = true;
             }
         }
-    }
 
-    bit_buffer_free(tx_buffer);
-    bit_buffer_free(rx_buffer);
+        nfc_scratch_buffer_release(iso3_poller->nfc, rx_buffer);
+        nfc_scratch_buffer_release(iso3_poller->nfc, tx_buffer);
+    }
 
     return detected;
 }
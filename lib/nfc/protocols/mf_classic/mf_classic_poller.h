@@ -36,6 +36,8 @@ typedef enum {
     MfClassicPollerEventTypeCardLost, /**< Poller lost card. */
     MfClassicPollerEventTypeSuccess, /**< Poller succeeded. */
     MfClassicPollerEventTypeFail, /**< Poller failed. */
+
+    MfClassicPollerEventTypeRequestKeyBatch, /**< Poller requests batch of keys for sector authentication. */
 } MfClassicPollerEventType;
 
 /**
@@ -92,6 +94,7 @@ typedef enum {
 typedef struct {
     MfClassicPollerMode mode; /**< Mode to be used by poller. */
     const MfClassicData* data; /**< Data to be used by poller. */
+    bool key_batch; /**< Request dictionary attack keys with MfClassicPollerEventTypeRequestKeyBatch. */
 } MfClassicPollerEventDataRequestMode;
 
 /**
@@ -132,6 +135,17 @@ typedef struct {
     bool key_provided; /**< Flag indicating if key is provided. */
 } MfClassicPollerEventDataKeyRequest;
 
+/**
+ * @brief MfClassic poller key batch request event data.
+ *
+ * The instance of this structure must be filled on MfClassicPollerEventTypeRequestKeyBatch event.
+ */
+typedef struct {
+    MfClassicKey* keys; /**< Buffer to be filled with keys. */
+    size_t keys_max; /**< Buffer size in keys. */
+    size_t keys_num; /**< Number of provided keys, less than keys_max if no more keys left. */
+} MfClassicPollerEventDataKeyBatchRequest;
+
 /**
  * @brief MfClassic poller read sector request event data.
  *
@@ -184,6 +198,7 @@ typedef union {
     MfClassicPollerEventDataRequestMode poller_mode; /**< Poller mode context. */
     MfClassicPollerEventDataDictAttackNextSector next_sector_data; /**< Next sector context. */
     MfClassicPollerEventDataKeyRequest key_request_data; /**< Key request context. */
+    MfClassicPollerEventDataKeyBatchRequest key_batch_request_data; /**< Key batch request context. */
     MfClassicPollerEventDataUpdate data_update; /**< Data update context. */
     MfClassicPollerEventDataReadSectorRequest
         read_sector_request_data; /**< Read sector request context. */
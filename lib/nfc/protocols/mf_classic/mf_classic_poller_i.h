@@ -22,6 +22,8 @@ extern "C" {
 #define MF_CLASSIC_NESTED_RETRY_MAXIMUM         (60)
 #define MF_CLASSIC_NESTED_HARD_RETRY_MAXIMUM    (3)
 #define MF_CLASSIC_NESTED_CALIBRATION_COUNT     (21)
+#define MF_CLASSIC_KEY_BATCH_SIZE               (32)
+#define MF_CLASSIC_KEY_REUSE_LOG_SIZE           (16)
 #define MF_CLASSIC_NESTED_LOGS_FILE_NAME        ".nested.log"
 #define MF_CLASSIC_NESTED_SYSTEM_DICT_FILE_NAME "mf_classic_dict_nested.nfc"
 #define MF_CLASSIC_NESTED_USER_DICT_FILE_NAME   "mf_classic_dict_user_nested.nfc"
@@ -68,6 +70,7 @@ typedef struct {
 typedef struct {
     MfClassicNestedNonce* nonces;
     size_t count;
+    size_t capacity;
 } MfClassicNestedNonceArray;
 
 typedef enum {
@@ -155,6 +158,18 @@ typedef struct {
         [32]; // Bit-packed array to track which unique most significant bytes have been seen (256 bits = 32 bytes)
     uint16_t msb_par_sum; // Sum of parity bits for each unique most significant byte
     uint16_t msb_count; // Number of unique most significant bytes seen
+    // Batched key requests
+    bool key_batch_enabled;
+    MfClassicKey key_batch[MF_CLASSIC_KEY_BATCH_SIZE];
+    uint8_t key_batch_num;
+    uint8_t key_batch_pos;
+    bool key_batch_last; // App has no more keys until the dictionary is rewound
+    uint32_t key_batch_tried; // Bitmap of batch keys already tried on current sector
+    // Keys tried on every sector starting from reused_keys_sector by key reuse
+    MfClassicKey reused_keys[MF_CLASSIC_KEY_REUSE_LOG_SIZE];
+    uint8_t reused_keys_sector[MF_CLASSIC_KEY_REUSE_LOG_SIZE];
+    uint8_t reused_keys_num;
+    uint8_t reuse_key_start_sector;
 } MfClassicPollerDictAttackContext;
 
 typedef struct {
@@ -327,34 +327,46 @@ MfDesfireError mf_desfire_poller_read_file_settings_multi(
     return error;
 }
 
+// Offset and size are given in units: bytes for data files, records for record files
 static MfDesfireError mf_desfire_poller_read_file(
     MfDesfirePoller* instance,
     MfDesfireFileId id,
     uint8_t read_cmd,
     uint32_t offset,
     size_t size,
+    size_t unit_size,
     MfDesfireFileData* data) {
     furi_check(instance);
     furi_check(data);
+    furi_check(unit_size > 0);
 
     MfDesfireError error = MfDesfireErrorNone;
-    simple_array_init(data->data, size);
+    simple_array_init(data->data, size * unit_size);
 
-    size_t buffer_capacity = bit_buffer_get_capacity_bytes(instance->result_buffer);
+    // Read as much as the result buffer can take at once, card chains the frames itself
+    const size_t units_per_read =
+        bit_buffer_get_capacity_bytes(instance->result_buffer) / unit_size;
     uint32_t current_offset = offset;
-    uint32_t bytes_read = 0;
+    uint32_t units_read = 0;
 
-    while(bytes_read < size) {
-        size_t bytes_to_read = MIN(buffer_capacity, size - bytes_read);
+    while(units_read < size) {
+        if(units_per_read == 0) {
+            FURI_LOG_W(TAG, "Record size %zu is too big", unit_size);
+            error = MfDesfireErrorProtocol;
+            break;
+        }
+
+        size_t units_to_read = MIN(units_per_read, size - units_read);
         bit_buffer_reset(instance->input_buffer);
         bit_buffer_append_byte(instance->input_buffer, read_cmd);
         bit_buffer_append_byte(instance->input_buffer, id);
         bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&current_offset, 3);
-        bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&bytes_to_read, 3);
+        bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&units_to_read, 3);
 
         error = mf_desfire_send_chunks(instance, instance->input_buffer, instance->result_buffer);
         if(error != MfDesfireErrorNone) break;
 
+        const size_t bytes_to_read = units_to_read * unit_size;
         size_t bytes_received = bit_buffer_get_size_bytes(instance->result_buffer);
         if(bytes_received != bytes_to_read) {
             FURI_LOG_W(TAG, "Read %zu out of %zu bytes", bytes_received, bytes_to_read);
@@ -363,9 +375,10 @@ static MfDesfireError mf_desfire_poller_read_file(
         }
 
         uint8_t* file_data = simple_array_get_data(data->data);
-        bit_buffer_write_bytes(instance->result_buffer, &file_data[current_offset], bytes_to_read);
-        bytes_read += bytes_to_read;
-        current_offset += bytes_to_read;
+        bit_buffer_write_bytes(
+            instance->result_buffer, &file_data[units_read * unit_size], bytes_to_read);
+        units_read += units_to_read;
+        current_offset += units_to_read;
     }
 
     if(error != MfDesfireErrorNone) {
@@ -381,7 +394,8 @@ MfDesfireError mf_desfire_poller_read_file_data(
     uint32_t offset,
     size_t size,
     MfDesfireFileData* data) {
-    return mf_desfire_poller_read_file(instance, id, MF_DESFIRE_CMD_READ_DATA, offset, size, data);
+    return mf_desfire_poller_read_file(
+        instance, id, MF_DESFIRE_CMD_READ_DATA, offset, size, 1, data);
 }
 
 MfDesfireError mf_desfire_poller_read_file_value(
@@ -417,7 +431,7 @@ MfDesfireError mf_desfire_poller_read_file_records(
     size_t size,
     MfDesfireFileData* data) {
     return mf_desfire_poller_read_file(
-        instance, id, MF_DESFIRE_CMD_READ_RECORDS, offset, size, data);
+        instance, id, MF_DESFIRE_CMD_READ_RECORDS, offset, size, 1, data);
 }
 
 MfDesfireError mf_desfire_poller_read_file_data_multi(
@@ -448,8 +462,11 @@ MfDesfireError mf_desfire_poller_read_file_data_multi(
         bool can_read_data = false;
         for(size_t j = 0; j < file_settings_cur->access_rights_len; j++) {
             uint8_t read_access = (file_settings_cur->access_rights[j] >> 12) & 0x0f;
+            uint8_t write_access = (file_settings_cur->access_rights[j] >> 8) & 0x0f;
             uint8_t read_write_access = (file_settings_cur->access_rights[j] >> 4) & 0x0f;
             can_read_data = (read_access == 0x0e) || (read_write_access == 0x0e);
+            // GetValue is also granted by write access
+            if(file_type == MfDesfireFileTypeValue) can_read_data |= (write_access == 0x0e);
             if(can_read_data) break;
         }
         if(!can_read_data) {
@@ -465,8 +482,18 @@ MfDesfireError mf_desfire_poller_read_file_data_multi(
         } else if(
             file_type == MfDesfireFileTypeLinearRecord ||
             file_type == MfDesfireFileTypeCyclicRecord) {
-            error = mf_desfire_poller_read_file_records(
-                instance, file_id, 0, file_settings_cur->data.size, file_data);
+            // Empty record file answers with an error, don't waste a round trip on it
+            if(file_settings_cur->record.cur == 0 || file_settings_cur->record.size == 0) {
+                continue;
+            }
+            error = mf_desfire_poller_read_file(
+                instance,
+                file_id,
+                MF_DESFIRE_CMD_READ_RECORDS,
+                0,
+                file_settings_cur->record.cur,
+                file_settings_cur->record.size,
+                file_data);
         }
     }
 
@@ -2,6 +2,7 @@
 #include "mf_ultralight_listener_defs.h"
 
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a_listener_i.h>
+#include <lib/nfc/helpers/iso14443_crc.h>
 
 #include <furi.h>
 #include <furi_hal.h>
@@ -736,6 +737,46 @@ static NfcCommand mf_ultralight_reset_listener_state(
     return NfcCommandSleep;
 }
 
+// Plain READ answered by Nfc worker directly, everything with side effects goes the usual way
+static bool mf_ultralight_listener_read_fast_path(
+    const BitBuffer* rx_buffer,
+    BitBuffer* tx_buffer,
+    void* context) {
+    MfUltralightListener* instance = context;
+    bool handled = false;
+
+    do {
+        if(bit_buffer_get_size(rx_buffer) != 4 * 8) break;
+        if(bit_buffer_get_byte(rx_buffer, 0) != MF_ULTRALIGHT_CMD_READ_PAGE) break;
+        if(!iso14443_crc_check(Iso14443CrcTypeA, rx_buffer)) break;
+
+        if(mf_ultralight_composite_command_in_progress(instance)) break;
+        if(mf_ultralight_is_i2c_tag(instance->data->type)) break;
+        if(instance->mirror.enabled) break;
+        if(mf_ultralight_support_feature(
+               instance->features, MfUltralightFeatureSupportSingleCounter) &&
+           instance->config->access.nfc_cnt_en && !instance->single_counter_increased) {
+            break;
+        }
+
+        uint16_t start_page = bit_buffer_get_byte(rx_buffer, 1);
+        if(start_page + 4 > instance->data->pages_total) break;
+        if(!mf_ultralight_listener_check_access(
+               instance, start_page, MfUltralightListenerAccessTypeRead)) {
+            break;
+        }
+
+        MfUltralightPage pages[4] = {};
+        mf_ultralight_listener_perform_read(pages, instance, start_page, 4, false);
+
+        bit_buffer_copy_bytes(tx_buffer, (uint8_t*)pages, sizeof(pages));
+        iso14443_crc_append(Iso14443CrcTypeA, tx_buffer);
+        handled = true;
+    } while(false);
+
+    return handled;
+}
+
 MfUltralightListener* mf_ultralight_listener_alloc(
     Iso14443_3aListener* iso14443_3a_listener,
     MfUltralightData* data) {
@@ -757,6 +798,9 @@ MfUltralightListener* mf_ultralight_listener_alloc(
     instance->generic_event.event_data = &instance->mfu_event;
     mbedtls_des3_init(&instance->des_context);
 
+    nfc_set_listener_fast_path(
+        iso14443_3a_listener->nfc, mf_ultralight_listener_read_fast_path, instance);
+
     return instance;
 }
 
@@ -765,6 +809,8 @@ void mf_ultralight_listener_free(MfUltralightListener* instance) {
     furi_assert(instance->data);
     furi_assert(instance->tx_buffer);
 
+    nfc_set_listener_fast_path(instance->iso14443_3a_listener->nfc, NULL, NULL);
+
     bit_buffer_free(instance->tx_buffer);
     furi_string_free(instance->mirror.ascii_mirror_data);
     mbedtls_des3_free(&instance->des_context);
@@ -173,7 +173,7 @@ MfUltralightPoller* mf_ultralight_poller_alloc(Iso14443_3aPoller* iso14443_3a_po
     MfUltralightPoller* instance = malloc(sizeof(MfUltralightPoller));
     instance->iso14443_3a_poller = iso14443_3a_poller;
     instance->tx_buffer = bit_buffer_alloc(MF_ULTRALIGHT_MAX_BUFF_SIZE);
-    instance->rx_buffer = bit_buffer_alloc(MF_ULTRALIGHT_MAX_BUFF_SIZE);
+    instance->rx_buffer = bit_buffer_alloc(MF_ULTRALIGHT_POLLER_RX_BUFF_SIZE);
     instance->data = mf_ultralight_alloc();
 
     instance->mfu_event.data = &instance->mfu_event_data;
@@ -226,6 +226,8 @@ static NfcCommand mf_ultralight_poller_handler_idle(MfUltralightPoller* instance
     instance->tearing_flag_read = 0;
     instance->tearing_flag_total = 3;
     instance->pages_read = 0;
+    instance->fast_read_failed = false;
+    instance->fast_read_reauth = false;
     instance->state = MfUltralightPollerStateRequestMode;
     instance->current_page = 0;
     return NfcCommandContinue;
@@ -486,7 +488,48 @@ static NfcCommand mf_ultralight_poller_handler_auth_ultralight_c(MfUltralightPol
     return command;
 }
 
+static bool mf_ultralight_poller_read_pages_fast(MfUltralightPoller* instance) {
+    // Card was halted after a failed FAST_READ, password auth is lost with it
+    if(instance->fast_read_reauth) {
+        instance->fast_read_reauth = false;
+        if(instance->auth_context.auth_success) {
+            mf_ultralight_poller_auth_pwd(instance, &instance->auth_context);
+        }
+    }
+
+    if(instance->fast_read_failed || MF_ULTRALIGHT_IS_NTAG_I2C(instance->data->type) ||
+       !mf_ultralight_support_feature(instance->feature_set, MfUltralightFeatureSupportFastRead))
+        return false;
+
+    const uint16_t start_page = instance->pages_read;
+    const uint16_t pages =
+        MIN(instance->pages_total - start_page, MF_ULTRALIGHT_POLLER_FAST_READ_PAGES_MAX);
+    if(pages == 0) return false;
+
+    instance->error = mf_ultralight_poller_fast_read_pages(
+        instance, start_page, start_page + pages - 1, &instance->data->page[start_page]);
+
+    if(instance->error == MfUltralightErrorNone) {
+        FURI_LOG_D(TAG, "Fast read pages %d-%d success", start_page, start_page + pages - 1);
+        instance->pages_read += pages;
+        instance->data->pages_read = instance->pages_read;
+        if(instance->pages_read == instance->pages_total) {
+            instance->state = MfUltralightPollerStateReadCounters;
+        }
+    } else {
+        // Whole range is NAK'd if any page is protected, continue page by page
+        FURI_LOG_D(TAG, "Fast read from page %d failed, falling back to read", start_page);
+        instance->fast_read_failed = true;
+        instance->fast_read_reauth = true;
+        iso14443_3a_poller_halt(instance->iso14443_3a_poller);
+    }
+
+    return true;
+}
+
 static NfcCommand mf_ultralight_poller_handler_read_pages(MfUltralightPoller* instance) {
+    if(mf_ultralight_poller_read_pages_fast(instance)) return NfcCommandContinue;
+
     MfUltralightPageReadCommandData data = {};
     uint16_t start_page = instance->pages_read;
     if(MF_ULTRALIGHT_IS_NTAG_I2C(instance->data->type)) {
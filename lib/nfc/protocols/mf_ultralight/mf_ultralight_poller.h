@@ -132,6 +132,27 @@ MfUltralightError mf_ultralight_poller_read_page(
     uint8_t start_page,
     MfUltralightPageReadCommandData* data);
 
+/**
+ * @brief Read a range of pages with one command.
+ *
+ * Must ONLY be used inside the callback function.
+ *
+ * Send FAST_READ command and parse response. Only for cards supporting
+ * MfUltralightFeatureSupportFastRead. The whole range fails if any page in it
+ * is not readable, the card has to be reactivated after that.
+ *
+ * @param[in, out] instance pointer to the instance to be used in the transaction.
+ * @param[in] start_page first page to be read.
+ * @param[in] end_page last page to be read, at most 32 pages after start_page.
+ * @param[out] data pointer to the array of (end_page - start_page + 1) pages to be filled.
+ * @return MfUltralightErrorNone on success, an error code on failure.
+ */
+MfUltralightError mf_ultralight_poller_fast_read_pages(
+    MfUltralightPoller* instance,
+    uint8_t start_page,
+    uint8_t end_page,
+    MfUltralightPage* data);
+
 /**
  * @brief Read page from sector.
  *
@@ -11,6 +11,11 @@ extern "C" {
 #define MF_ULTRALIGHT_POLLER_STANDARD_FWT_FC (60000)
 #define MF_ULTRALIGHT_MAX_BUFF_SIZE          (64)
 
+// FAST_READ response is kept well below NFC_MAX_BUFFER_SIZE
+#define MF_ULTRALIGHT_POLLER_FAST_READ_PAGES_MAX (32U)
+#define MF_ULTRALIGHT_POLLER_RX_BUFF_SIZE \
+    (MF_ULTRALIGHT_POLLER_FAST_READ_PAGES_MAX * MF_ULTRALIGHT_PAGE_SIZE + 2)
+
 #define MF_ULTRALIGHT_DEFAULT_PASSWORD (0xffffffffUL)
 
 #define MF_ULTRALIGHT_IS_NTAG_I2C(type)                                                \
@@ -83,6 +88,8 @@ struct MfUltralightPoller {
     uint32_t feature_set;
     uint16_t pages_read;
     uint16_t pages_total;
+    bool fast_read_failed;
+    bool fast_read_reauth;
     uint8_t counters_read;
     uint8_t counters_total;
     uint8_t tearing_flag_read;
@@ -91,6 +91,8 @@ bool onewire_host_reset(OneWireHost* host) {
     // pre delay
     furi_delay_us(timings->g);
 
+    FURI_CRITICAL_ENTER();
+
     // drive low
     furi_hal_gpio_write(host->gpio_pin, false);
     furi_delay_us(timings->h);
@@ -99,8 +101,12 @@ bool onewire_host_reset(OneWireHost* host) {
     furi_hal_gpio_write(host->gpio_pin, true);
     furi_delay_us(timings->i);
 
-    // read and post delay
+    // read
     r = !furi_hal_gpio_read(host->gpio_pin);
+
+    FURI_CRITICAL_EXIT();
+
+    // post delay, can be stretched
     furi_delay_us(timings->j);
 
     return r;
@@ -113,6 +119,8 @@ bool onewire_host_read_bit(OneWireHost* host) {
 
     const OneWireHostTimings* timings = host->timings;
 
+    FURI_CRITICAL_ENTER();
+
     // drive low
     furi_hal_gpio_write(host->gpio_pin, false);
     furi_delay_us(timings->a);
@@ -121,8 +129,12 @@ bool onewire_host_read_bit(OneWireHost* host) {
     furi_hal_gpio_write(host->gpio_pin, true);
     furi_delay_us(timings->e);
 
-    // read and post delay
+    // read
     result = furi_hal_gpio_read(host->gpio_pin);
+
+    FURI_CRITICAL_EXIT();
+
+    // post delay, can be stretched
     furi_delay_us(timings->f);
 
     return result;
@@ -156,21 +168,26 @@ void onewire_host_write_bit(OneWireHost* host, bool value) {
 
     const OneWireHostTimings* timings = host->timings;
 
+    // only low time is critical, recovery can be stretched
     if(value) {
+        FURI_CRITICAL_ENTER();
         // drive low
         furi_hal_gpio_write(host->gpio_pin, false);
         furi_delay_us(timings->a);
 
         // release
         furi_hal_gpio_write(host->gpio_pin, true);
+        FURI_CRITICAL_EXIT();
         furi_delay_us(timings->b);
     } else {
+        FURI_CRITICAL_ENTER();
         // drive low
         furi_hal_gpio_write(host->gpio_pin, false);
         furi_delay_us(timings->c);
 
         // release
         furi_hal_gpio_write(host->gpio_pin, true);
+        FURI_CRITICAL_EXIT();
         furi_delay_us(timings->d);
     }
 }
@@ -2,6 +2,9 @@
  * @file one_wire_host.h
  * 
  * 1-Wire host (master) library
+ *
+ * Interrupts are disabled only within a single time slot, so long transfers
+ * and searches don't need to be wrapped in a critical section.
  */
 
 #pragma once
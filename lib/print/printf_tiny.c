@@ -32,6 +32,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <limits.h>
 
 #include "printf_tiny.h"
 
@@ -276,6 +277,64 @@ static size_t _ntoa_format(
     return _out_rev(out, buffer, idx, maxlen, buf, len, width, flags);
 }
 
+// "00".."99" for the decimal conversion, two digits per division
+static const char _digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// append digits of value to buf in reverse order, at least one while there is room
+static size_t _ntoa_digits(
+    char* buf,
+    size_t len,
+    unsigned long value,
+    unsigned long base,
+    unsigned int flags) {
+    const char* digits = (flags & FLAGS_UPPERCASE) ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    if(len >= PRINTF_NTOA_BUFFER_SIZE) {
+        return len;
+    }
+
+    if(base == 10U) {
+        // constant divisor, compiled to a multiplication
+        while((value >= 100U) && (len + 2U <= PRINTF_NTOA_BUFFER_SIZE)) {
+            const unsigned long pair = (value % 100U) * 2U;
+            value /= 100U;
+            buf[len++] = _digit_pairs[pair + 1U];
+            buf[len++] = _digit_pairs[pair];
+        }
+        if((value >= 10U) && (len + 2U <= PRINTF_NTOA_BUFFER_SIZE)) {
+            buf[len++] = _digit_pairs[value * 2U + 1U];
+            buf[len++] = _digit_pairs[value * 2U];
+        } else if((value < 10U) && (len < PRINTF_NTOA_BUFFER_SIZE)) {
+            buf[len++] = digits[value];
+        }
+    } else if(base == 16U || base == 8U || base == 2U) {
+        const unsigned int shift = (base == 16U) ? 4U : (base == 8U) ? 3U : 1U;
+        do {
+            buf[len++] = digits[value & (base - 1U)];
+            value >>= shift;
+        } while(value && (len < PRINTF_NTOA_BUFFER_SIZE));
+    } else {
+        do {
+            const char digit = (char)(value % base);
+            buf[len++] = digit < 10 ? '0' + digit :
+                                      (flags & FLAGS_UPPERCASE ? 'A' : 'a') + digit - 10;
+            value /= base;
+        } while(value && (len < PRINTF_NTOA_BUFFER_SIZE));
+    }
+
+    return len;
+}
+
 // internal itoa for 'long' type
 static size_t _ntoa_long(
     out_fct_type out,
@@ -298,12 +357,7 @@ static size_t _ntoa_long(
 
     // write if precision != 0 and value is != 0
     if(!(flags & FLAGS_PRECISION) || value) {
-        do {
-            const char digit = (char)(value % base);
-            buf[len++] = digit < 10 ? '0' + digit :
-                                      (flags & FLAGS_UPPERCASE ? 'A' : 'a') + digit - 10;
-            value /= base;
-        } while(value && (len < PRINTF_NTOA_BUFFER_SIZE));
+        len = _ntoa_digits(buf, len, value, base, flags);
     }
 
     return _ntoa_format(
@@ -333,12 +387,14 @@ static size_t _ntoa_long_long(
 
     // write if precision != 0 and value is != 0
     if(!(flags & FLAGS_PRECISION) || value) {
-        do {
+        // 64-bit division is a library call, only use it while the value needs it
+        while((value > ULONG_MAX) && (len < PRINTF_NTOA_BUFFER_SIZE)) {
             const char digit = (char)(value % base);
             buf[len++] = digit < 10 ? '0' + digit :
                                       (flags & FLAGS_UPPERCASE ? 'A' : 'a') + digit - 10;
             value /= base;
-        } while(value && (len < PRINTF_NTOA_BUFFER_SIZE));
+        }
+        len = _ntoa_digits(buf, len, (unsigned long)value, base, flags);
     }
 
     return _ntoa_format(
@@ -21,6 +21,7 @@ struct PulseReader {
     uint32_t unit_divider;
     uint32_t bit_time;
     uint32_t dma_channel;
+    bool dma_owned;
     const GpioPin* gpio;
     GpioPull pull;
     LL_DMA_InitTypeDef dma_config_timer;
@@ -47,11 +48,15 @@ struct PulseReader {
 
 #define GET_DMAMUX_EXTI_LINE(pin) GPIO_PIN_MAP(pin, LL_DMAMUX_REQ_GEN_EXTI_LINE)
 
+/* AES and serial DMA TX hold the shared channels for one transfer at most */
+#define PULSE_READER_DMA_WAIT_MS (100U)
+
 PulseReader* pulse_reader_alloc(const GpioPin* gpio, uint32_t size) {
     PulseReader* signal = malloc(sizeof(PulseReader));
     signal->timer_buffer = malloc(size * sizeof(uint32_t));
     signal->gpio_buffer = malloc(size * sizeof(uint32_t));
     signal->dma_channel = LL_DMA_CHANNEL_4;
+    signal->dma_owned = false;
     signal->gpio = gpio;
     signal->pull = GpioPullNo;
     signal->size = size;
@@ -129,9 +134,23 @@ uint32_t pulse_reader_samples(PulseReader* signal) {
     return ((signal->pos + signal->size) - dma_pos) % signal->size;
 }
 
+static bool pulse_reader_dma_acquire(PulseReader* signal) {
+    if(!furi_hal_dma_channel_acquire(DMA1, signal->dma_channel)) return false;
+    if(!furi_hal_dma_channel_acquire(DMA1, signal->dma_channel + 1)) {
+        furi_hal_dma_channel_release(DMA1, signal->dma_channel);
+        return false;
+    }
+    return true;
+}
+
 void pulse_reader_stop(PulseReader* signal) {
-    LL_DMA_DisableChannel(DMA1, signal->dma_channel);
-    LL_DMA_DisableChannel(DMA1, signal->dma_channel + 1);
+    if(signal->dma_owned) {
+        LL_DMA_DisableChannel(DMA1, signal->dma_channel);
+        LL_DMA_DisableChannel(DMA1, signal->dma_channel + 1);
+        furi_hal_dma_channel_release(DMA1, signal->dma_channel + 1);
+        furi_hal_dma_channel_release(DMA1, signal->dma_channel);
+        signal->dma_owned = false;
+    }
     LL_DMAMUX_DisableRequestGen(NULL, LL_DMAMUX_REQ_GEN_0);
     LL_TIM_DisableCounter(TIM2);
     furi_hal_bus_disable(FuriHalBusTIM2);
@@ -139,6 +158,18 @@ void pulse_reader_stop(PulseReader* signal) {
 }
 
 void pulse_reader_start(PulseReader* signal) {
+    furi_check(!signal->dma_owned);
+
+    /* channels are shared, let a running transfer of the other owner end */
+    const uint32_t wait_start = furi_get_tick();
+    while(!pulse_reader_dma_acquire(signal)) {
+        furi_check(
+            furi_get_tick() - wait_start < furi_ms_to_ticks(PULSE_READER_DMA_WAIT_MS),
+            "DMA channels are busy");
+        furi_delay_tick(1);
+    }
+    signal->dma_owned = true;
+
     /* configure DMA to read from a timer peripheral */
     signal->dma_config_timer.NbData = signal->size;
 
@@ -48,6 +48,8 @@ void pulse_reader_free(PulseReader* signal);
  *
  * Initializes DMA1, TIM2 and DMAMUX_REQ_GEN_0 to automatically capture timer values.
  * Ensure that interrupts are always enabled, as the used EXTI line is handled as one.
+ * DMA1 channels 4 and 5 are taken with furi_hal_dma_channel_acquire, a running
+ * AES or serial DMA TX transfer is waited for, crashes if they stay busy.
  *
  * @param[in]  signal      previously allocated PulseReader object.
  */
@@ -0,0 +1,454 @@
+#include "gpio_capture.h"
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <furi_hal_bus.h>
+
+#include <stm32wbxx_ll_dma.h>
+#include <stm32wbxx_ll_dmamux.h>
+#include <stm32wbxx_ll_tim.h>
+
+#define TAG "GpioCapture"
+
+#define GPIO_CAPTURE_DMA         DMA2
+#define GPIO_CAPTURE_DMA_CHANNEL LL_DMA_CHANNEL_2
+#define GPIO_CAPTURE_DMA_IRQ     FuriHalInterruptIdDma2Ch2
+#define GPIO_CAPTURE_DMA_DEF     GPIO_CAPTURE_DMA, GPIO_CAPTURE_DMA_CHANNEL
+
+#define GPIO_CAPTURE_TIM       (TIM16)
+#define GPIO_CAPTURE_TIM_BUS   (FuriHalBusTIM16)
+#define GPIO_CAPTURE_TIM_CLOCK (64000000UL)
+
+#define GPIO_CAPTURE_RUNS_MAX (256U)
+
+#define GPIO_CAPTURE_FILE_MAGIC   (0x50414347UL) // "GCAP"
+#define GPIO_CAPTURE_FILE_VERSION (1U)
+
+typedef enum {
+    GpioCaptureFlagHalf = (1 << 0),
+    GpioCaptureFlagStop = (1 << 1),
+} GpioCaptureFlag;
+
+#pragma pack(push, 1)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t pins_count;
+    uint8_t trigger_type;
+    uint32_t sample_rate;
+    uint32_t pretrigger;
+} GpioCaptureFileHeader;
+
+#pragma pack(pop)
+
+struct GpioCapture {
+    const GpioPin* pins[GPIO_CAPTURE_PINS_MAX];
+    size_t pins_count;
+    GPIO_TypeDef* port;
+    uint16_t port_mask;
+    GpioPull pull;
+
+    uint32_t tim_psc;
+    uint32_t tim_arr;
+    uint32_t sample_rate;
+
+    GpioCaptureTrigger trigger;
+    uint16_t trigger_mask; // Port bits
+    uint16_t trigger_value; // Port bits
+    size_t pretrigger;
+
+    uint16_t* dma_buffer;
+    size_t buffer_size;
+    volatile uint32_t dma_halves;
+    uint32_t halves_done;
+    uint32_t overruns;
+
+    // Last samples of the previous half, the DMA writes over it meanwhile
+    uint16_t* history;
+    size_t history_len;
+
+    volatile bool triggered;
+    bool prev_valid;
+    uint16_t prev;
+
+    uint16_t run_value;
+    uint32_t run_length;
+    GpioCaptureRun* runs;
+    size_t runs_count;
+
+    FuriThread* thread;
+    GpioCaptureCallback callback;
+    void* context;
+};
+
+static int32_t gpio_capture_worker(void* context);
+
+GpioCapture*
+    gpio_capture_alloc(const GpioPin* const* pins, size_t pins_count, size_t buffer_size) {
+    furi_check(pins);
+    furi_check(pins_count > 0 && pins_count <= GPIO_CAPTURE_PINS_MAX);
+    furi_check(buffer_size >= 2 && buffer_size % 2 == 0 && buffer_size <= UINT16_MAX);
+
+    GpioCapture* instance = malloc(sizeof(GpioCapture));
+
+    instance->port = pins[0]->port;
+    for(size_t i = 0; i < pins_count; i++) {
+        // One DMA channel reads one input register
+        furi_check(pins[i]->port == instance->port);
+        instance->pins[i] = pins[i];
+        instance->port_mask |= pins[i]->pin;
+    }
+    instance->pins_count = pins_count;
+    instance->pull = GpioPullNo;
+
+    instance->buffer_size = buffer_size;
+    instance->dma_buffer = malloc(sizeof(uint16_t) * buffer_size);
+    instance->history = malloc(sizeof(uint16_t) * buffer_size / 2);
+    instance->runs = malloc(sizeof(GpioCaptureRun) * GPIO_CAPTURE_RUNS_MAX);
+
+    instance->thread = furi_thread_alloc_ex(TAG, 1024, gpio_capture_worker, instance);
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityHigh);
+
+    gpio_capture_set_sample_rate(instance, 1000000);
+
+    return instance;
+}
+
+void gpio_capture_free(GpioCapture* instance) {
+    furi_check(instance);
+    furi_check(furi_thread_get_state(instance->thread) == FuriThreadStateStopped);
+
+    furi_thread_free(instance->thread);
+    free(instance->runs);
+    free(instance->history);
+    free(instance->dma_buffer);
+    free(instance);
+}
+
+void gpio_capture_set_pull(GpioCapture* instance, GpioPull pull) {
+    furi_check(instance);
+
+    instance->pull = pull;
+}
+
+uint32_t gpio_capture_set_sample_rate(GpioCapture* instance, uint32_t frequency) {
+    furi_check(instance);
+    furi_check(frequency > 0 && frequency <= GPIO_CAPTURE_TIM_CLOCK);
+
+    const uint32_t period = GPIO_CAPTURE_TIM_CLOCK / frequency;
+    instance->tim_psc = (period - 1) / (UINT16_MAX + 1);
+    instance->tim_arr = period / (instance->tim_psc + 1) - 1;
+    instance->sample_rate =
+        GPIO_CAPTURE_TIM_CLOCK / ((instance->tim_psc + 1) * (instance->tim_arr + 1));
+
+    return instance->sample_rate;
+}
+
+void gpio_capture_set_trigger(
+    GpioCapture* instance,
+    const GpioCaptureTrigger* trigger,
+    size_t pretrigger) {
+    furi_check(instance);
+    furi_check(trigger);
+    furi_check(trigger->type <= GpioCaptureTriggerTypeEdge);
+    furi_check(pretrigger <= instance->buffer_size / 2);
+
+    instance->trigger = *trigger;
+    instance->pretrigger = pretrigger;
+}
+
+static uint16_t gpio_capture_to_port(GpioCapture* instance, uint16_t value) {
+    uint16_t port_value = 0;
+    for(size_t i = 0; i < instance->pins_count; i++) {
+        if(value & (1U << i)) port_value |= instance->pins[i]->pin;
+    }
+    return port_value;
+}
+
+static uint16_t gpio_capture_from_port(GpioCapture* instance, uint16_t port_value) {
+    uint16_t value = 0;
+    for(size_t i = 0; i < instance->pins_count; i++) {
+        if(port_value & instance->pins[i]->pin) value |= 1U << i;
+    }
+    return value;
+}
+
+static void gpio_capture_flush(GpioCapture* instance) {
+    if(instance->runs_count) {
+        instance->callback(instance->runs, instance->runs_count, instance->context);
+        instance->runs_count = 0;
+    }
+}
+
+static void gpio_capture_emit(GpioCapture* instance, uint16_t port_value, uint16_t length) {
+    GpioCaptureRun* run = &instance->runs[instance->runs_count++];
+    run->value = gpio_capture_from_port(instance, port_value);
+    run->length = length;
+    if(instance->runs_count == GPIO_CAPTURE_RUNS_MAX) gpio_capture_flush(instance);
+}
+
+static void gpio_capture_encode(GpioCapture* instance, const uint16_t* samples, size_t count) {
+    const uint16_t mask = instance->port_mask;
+    uint16_t value = instance->run_value;
+    uint32_t length = instance->run_length;
+
+    for(size_t i = 0; i < count; i++) {
+        const uint16_t sample = samples[i] & mask;
+        if(length && sample == value && length < UINT16_MAX) {
+            length++;
+        } else {
+            if(length) gpio_capture_emit(instance, value, length);
+            value = sample;
+            length = 1;
+        }
+    }
+
+    instance->run_value = value;
+    instance->run_length = length;
+}
+
+// Index of the first sample matching the trigger, count if none does
+static size_t
+    gpio_capture_find_trigger(GpioCapture* instance, const uint16_t* samples, size_t count) {
+    const uint16_t mask = instance->trigger_mask;
+    const uint16_t value = instance->trigger_value;
+    uint16_t prev = instance->prev_valid ? instance->prev : samples[0];
+    size_t index = 0;
+
+    switch(instance->trigger.type) {
+    case GpioCaptureTriggerTypeLevel:
+        while(index < count && (samples[index] & mask) != value) {
+            index++;
+        }
+        break;
+    case GpioCaptureTriggerTypeRising:
+        while(index < count && !(samples[index] & ~prev & mask)) {
+            prev = samples[index++];
+        }
+        break;
+    case GpioCaptureTriggerTypeFalling:
+        while(index < count && !(~samples[index] & prev & mask)) {
+            prev = samples[index++];
+        }
+        break;
+    case GpioCaptureTriggerTypeEdge:
+        while(index < count && !((samples[index] ^ prev) & mask)) {
+            prev = samples[index++];
+        }
+        break;
+    default:
+        break;
+    }
+
+    instance->prev = samples[count - 1];
+    instance->prev_valid = true;
+
+    return index;
+}
+
+static void gpio_capture_process(GpioCapture* instance, const uint16_t* samples, size_t count) {
+    size_t start = 0;
+
+    if(!instance->triggered) {
+        const size_t index = gpio_capture_find_trigger(instance, samples, count);
+        if(index == count) {
+            const size_t keep = MIN(instance->pretrigger, count);
+            memcpy(instance->history, &samples[count - keep], keep * sizeof(uint16_t));
+            instance->history_len = keep;
+            return;
+        }
+
+        instance->triggered = true;
+
+        // Pre-trigger samples come from this half first, then from the previous one
+        const size_t from_current = MIN(instance->pretrigger, index);
+        const size_t from_history =
+            MIN(instance->pretrigger - from_current, instance->history_len);
+        gpio_capture_encode(
+            instance, &instance->history[instance->history_len - from_history], from_history);
+        start = index - from_current;
+    }
+
+    gpio_capture_encode(instance, &samples[start], count - start);
+}
+
+static int32_t gpio_capture_worker(void* context) {
+    GpioCapture* instance = context;
+    const size_t half_size = instance->buffer_size / 2;
+
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            GpioCaptureFlagHalf | GpioCaptureFlagStop, FuriFlagWaitAny, FuriWaitForever);
+        furi_check(!(flags & FuriFlagError));
+        if(flags & GpioCaptureFlagStop) break;
+
+        while(instance->halves_done != instance->dma_halves) {
+            const uint32_t pending = instance->dma_halves - instance->halves_done;
+            if(pending > 1) {
+                // Oldest halves are already overwritten, mark the gap
+                instance->overruns += pending - 1;
+                instance->halves_done += pending - 1;
+                if(instance->triggered) {
+                    if(instance->run_length) {
+                        gpio_capture_emit(instance, instance->run_value, instance->run_length);
+                    }
+                    gpio_capture_emit(instance, instance->run_value, 0);
+                }
+                instance->run_length = 0;
+                instance->prev_valid = false;
+                instance->history_len = 0;
+            }
+
+            const size_t offset = (instance->halves_done % 2) * half_size;
+            gpio_capture_process(instance, &instance->dma_buffer[offset], half_size);
+            instance->halves_done++;
+        }
+    }
+
+    if(instance->run_length) {
+        gpio_capture_emit(instance, instance->run_value, instance->run_length);
+        instance->run_length = 0;
+    }
+    gpio_capture_flush(instance);
+
+    return 0;
+}
+
+static void gpio_capture_dma_isr(void* context) {
+    GpioCapture* instance = context;
+
+#if GPIO_CAPTURE_DMA_CHANNEL == LL_DMA_CHANNEL_2
+    if(LL_DMA_IsActiveFlag_TE2(GPIO_CAPTURE_DMA)) {
+        LL_DMA_ClearFlag_TE2(GPIO_CAPTURE_DMA);
+    }
+    if(LL_DMA_IsActiveFlag_HT2(GPIO_CAPTURE_DMA)) {
+        LL_DMA_ClearFlag_HT2(GPIO_CAPTURE_DMA);
+        instance->dma_halves++;
+    }
+    if(LL_DMA_IsActiveFlag_TC2(GPIO_CAPTURE_DMA)) {
+        LL_DMA_ClearFlag_TC2(GPIO_CAPTURE_DMA);
+        instance->dma_halves++;
+    }
+#else
+#error Update this code. Would you kindly?
+#endif
+
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), GpioCaptureFlagHalf);
+}
+
+void gpio_capture_start(GpioCapture* instance, GpioCaptureCallback callback, void* context) {
+    furi_check(instance);
+    furi_check(callback);
+    furi_check(furi_thread_get_state(instance->thread) == FuriThreadStateStopped);
+
+    instance->callback = callback;
+    instance->context = context;
+
+    instance->trigger_mask = gpio_capture_to_port(instance, instance->trigger.mask);
+    instance->trigger_value =
+        gpio_capture_to_port(instance, instance->trigger.value & instance->trigger.mask);
+    instance->triggered = (instance->trigger.type == GpioCaptureTriggerTypeNone);
+    instance->prev_valid = false;
+    instance->history_len = 0;
+    instance->run_length = 0;
+    instance->runs_count = 0;
+    instance->dma_halves = 0;
+    instance->halves_done = 0;
+    instance->overruns = 0;
+
+    for(size_t i = 0; i < instance->pins_count; i++) {
+        furi_hal_gpio_init(instance->pins[i], GpioModeInput, instance->pull, GpioSpeedVeryHigh);
+    }
+
+    furi_thread_start(instance->thread);
+
+    // Sample timer, every update event requests one DMA transfer
+    furi_hal_bus_enable(GPIO_CAPTURE_TIM_BUS);
+    LL_TIM_SetPrescaler(GPIO_CAPTURE_TIM, instance->tim_psc);
+    LL_TIM_SetCounterMode(GPIO_CAPTURE_TIM, LL_TIM_COUNTERMODE_UP);
+    LL_TIM_SetAutoReload(GPIO_CAPTURE_TIM, instance->tim_arr);
+    LL_TIM_SetClockDivision(GPIO_CAPTURE_TIM, LL_TIM_CLOCKDIVISION_DIV1);
+    LL_TIM_SetClockSource(GPIO_CAPTURE_TIM, LL_TIM_CLOCKSOURCE_INTERNAL);
+    LL_TIM_GenerateEvent_UPDATE(GPIO_CAPTURE_TIM);
+
+    LL_DMA_SetMemoryAddress(GPIO_CAPTURE_DMA_DEF, (uint32_t)instance->dma_buffer);
+    LL_DMA_SetPeriphAddress(GPIO_CAPTURE_DMA_DEF, (uint32_t) & (instance->port->IDR));
+    LL_DMA_ConfigTransfer(
+        GPIO_CAPTURE_DMA_DEF,
+        LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_MODE_CIRCULAR | LL_DMA_PERIPH_NOINCREMENT |
+            LL_DMA_MEMORY_INCREMENT | LL_DMA_PDATAALIGN_HALFWORD | LL_DMA_MDATAALIGN_HALFWORD |
+            LL_DMA_PRIORITY_HIGH);
+    LL_DMA_SetDataLength(GPIO_CAPTURE_DMA_DEF, instance->buffer_size);
+    LL_DMA_SetPeriphRequest(GPIO_CAPTURE_DMA_DEF, LL_DMAMUX_REQ_TIM16_UP);
+
+    furi_hal_interrupt_set_isr_ex(
+        GPIO_CAPTURE_DMA_IRQ, FuriHalInterruptPriorityHighest, gpio_capture_dma_isr, instance);
+    LL_DMA_ClearFlag_HT2(GPIO_CAPTURE_DMA);
+    LL_DMA_ClearFlag_TC2(GPIO_CAPTURE_DMA);
+    LL_DMA_ClearFlag_TE2(GPIO_CAPTURE_DMA);
+    LL_DMA_EnableIT_TC(GPIO_CAPTURE_DMA_DEF);
+    LL_DMA_EnableIT_HT(GPIO_CAPTURE_DMA_DEF);
+    LL_DMA_EnableChannel(GPIO_CAPTURE_DMA_DEF);
+
+    LL_TIM_EnableDMAReq_UPDATE(GPIO_CAPTURE_TIM);
+    LL_TIM_SetCounter(GPIO_CAPTURE_TIM, 0);
+    LL_TIM_EnableCounter(GPIO_CAPTURE_TIM);
+}
+
+void gpio_capture_stop(GpioCapture* instance) {
+    furi_check(instance);
+
+    LL_TIM_DisableCounter(GPIO_CAPTURE_TIM);
+    furi_hal_interrupt_set_isr(GPIO_CAPTURE_DMA_IRQ, NULL, NULL);
+    LL_DMA_DeInit(GPIO_CAPTURE_DMA_DEF);
+    furi_hal_bus_disable(GPIO_CAPTURE_TIM_BUS);
+
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), GpioCaptureFlagStop);
+    furi_thread_join(instance->thread);
+
+    for(size_t i = 0; i < instance->pins_count; i++) {
+        furi_hal_gpio_init(instance->pins[i], GpioModeAnalog, GpioPullNo, GpioSpeedLow);
+    }
+
+    if(instance->overruns) {
+        FURI_LOG_W(TAG, "%lu half buffers lost", instance->overruns);
+    }
+}
+
+bool gpio_capture_is_triggered(GpioCapture* instance) {
+    furi_check(instance);
+
+    return instance->triggered;
+}
+
+uint32_t gpio_capture_get_overrun_count(GpioCapture* instance) {
+    furi_check(instance);
+
+    return instance->overruns;
+}
+
+bool gpio_capture_file_write_header(GpioCapture* instance, File* file) {
+    furi_check(instance);
+    furi_check(file);
+
+    const GpioCaptureFileHeader header = {
+        .magic = GPIO_CAPTURE_FILE_MAGIC,
+        .version = GPIO_CAPTURE_FILE_VERSION,
+        .pins_count = instance->pins_count,
+        .trigger_type = instance->trigger.type,
+        .sample_rate = instance->sample_rate,
+        .pretrigger = instance->pretrigger,
+    };
+
+    return storage_file_write(file, &header, sizeof(header)) == sizeof(header);
+}
+
+void gpio_capture_file_callback(const GpioCaptureRun* runs, size_t count, void* context) {
+    File* file = context;
+
+    const size_t size = count * sizeof(GpioCaptureRun);
+    if(storage_file_write(file, runs, size) != size) {
+        FURI_LOG_E(TAG, "Write failed");
+    }
+}
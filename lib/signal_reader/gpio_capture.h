@@ -0,0 +1,119 @@
+/**
+ * @file gpio_capture.h
+ * Logic analyzer style capture of several GPIO pins
+ *
+ * Samples the input register of one GPIO port with DMA on every timer tick.
+ * Samples are run-length encoded in a worker thread and handed to the callback
+ * once the trigger condition has been met, together with pre-trigger history.
+ *
+ * Uses TIM16 and DMA2 channel 2, same as signal_reader: only one of them
+ * can run at a time.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <furi_hal_gpio.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GPIO_CAPTURE_PINS_MAX (16U)
+
+typedef enum {
+    GpioCaptureTriggerTypeNone, /**< Start right away */
+    GpioCaptureTriggerTypeLevel, /**< Masked sample equals the value */
+    GpioCaptureTriggerTypeRising, /**< Any masked pin goes high */
+    GpioCaptureTriggerTypeFalling, /**< Any masked pin goes low */
+    GpioCaptureTriggerTypeEdge, /**< Any masked pin changes */
+} GpioCaptureTriggerType;
+
+typedef struct {
+    GpioCaptureTriggerType type;
+    uint16_t mask; /**< Pins taking part in the trigger, bit N is pins[N] */
+    uint16_t value; /**< Pin levels for GpioCaptureTriggerTypeLevel */
+} GpioCaptureTrigger;
+
+/** Run of equal samples
+ *
+ * Bit N of value is the level of pins[N]. Run of zero length marks a gap:
+ * samples were lost because the callback was too slow.
+ */
+typedef struct {
+    uint16_t value;
+    uint16_t length;
+} GpioCaptureRun;
+
+/** Capture data callback, called from the capture worker thread
+ *
+ * @param[in]  runs     The runs
+ * @param      count    The runs count
+ * @param      context  The context
+ */
+typedef void (*GpioCaptureCallback)(const GpioCaptureRun* runs, size_t count, void* context);
+
+typedef struct GpioCapture GpioCapture;
+
+/** Allocate capture
+ *
+ * @param[in]  pins         The pins, all on the same GPIO port
+ * @param      pins_count   The pins count, up to GPIO_CAPTURE_PINS_MAX
+ * @param      buffer_size  The DMA ring buffer size in samples, even
+ *
+ * @return     GpioCapture instance
+ */
+GpioCapture*
+    gpio_capture_alloc(const GpioPin* const* pins, size_t pins_count, size_t buffer_size);
+
+void gpio_capture_free(GpioCapture* instance);
+
+void gpio_capture_set_pull(GpioCapture* instance, GpioPull pull);
+
+/** Set sample rate
+ *
+ * @param      instance   The instance
+ * @param      frequency  Samples per second
+ *
+ * @return     Actual samples per second
+ */
+uint32_t gpio_capture_set_sample_rate(GpioCapture* instance, uint32_t frequency);
+
+/** Set trigger condition
+ *
+ * @param      instance    The instance
+ * @param[in]  trigger     The trigger
+ * @param      pretrigger  Samples before the trigger to keep, up to half of the buffer
+ */
+void gpio_capture_set_trigger(
+    GpioCapture* instance,
+    const GpioCaptureTrigger* trigger,
+    size_t pretrigger);
+
+void gpio_capture_start(GpioCapture* instance, GpioCaptureCallback callback, void* context);
+
+/** Stop capture, pending runs are passed to the callback before it returns */
+void gpio_capture_stop(GpioCapture* instance);
+
+bool gpio_capture_is_triggered(GpioCapture* instance);
+
+/** Get number of DMA half buffers dropped since start */
+uint32_t gpio_capture_get_overrun_count(GpioCapture* instance);
+
+/** Write capture file header
+ *
+ * Header is followed by GpioCaptureRun records as they come: pass
+ * gpio_capture_file_callback with the same file as context to gpio_capture_start.
+ *
+ * @return     true on success
+ */
+bool gpio_capture_file_write_header(GpioCapture* instance, File* file);
+
+void gpio_capture_file_callback(const GpioCaptureRun* runs, size_t count, void* context);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,6 +4,39 @@
 
 #define TAG "SubGhzBlockEncoder"
 
+LevelDuration
+    subghz_protocol_blocks_encoder_yield(SubGhzProtocolBlockEncoder* encoder, void* context) {
+    furi_check(encoder);
+
+    if(encoder->repeat == 0 || !encoder->is_running) {
+        encoder->is_running = false;
+        return level_duration_reset();
+    }
+
+    if(encoder->upload) {
+        LevelDuration ret = encoder->upload[encoder->front];
+        if(++encoder->front == encoder->size_upload) {
+            encoder->repeat--;
+            encoder->front = 0;
+        }
+        return ret;
+    }
+
+    furi_check(encoder->generator);
+    LevelDuration ret = encoder->generator(context, encoder->front++);
+    if(level_duration_is_reset(ret)) {
+        const bool is_empty = (encoder->front == 1);
+        encoder->front = 0;
+        if(is_empty || --encoder->repeat == 0) {
+            encoder->is_running = false;
+            return ret;
+        }
+        ret = encoder->generator(context, encoder->front++);
+    }
+
+    return ret;
+}
+
 void subghz_protocol_blocks_set_bit_array(
     bool bit_value,
     uint8_t data_array[],
@@ -10,15 +10,39 @@
 extern "C" {
 #endif
 
+/** Frame generator, used by encoders that have no upload buffer
+ *
+ * Called with index going up from 0 on every repeat of the frame: generator
+ * may keep its own state between calls and restart it on index 0.
+ *
+ * @param      context  Encoder instance
+ * @param      index    Position in the frame
+ *
+ * @return     LevelDuration, level_duration_reset() past the end of the frame
+ */
+typedef LevelDuration (*SubGhzProtocolBlockEncoderGenerator)(void* context, size_t index);
+
 typedef struct {
     bool is_running;
     size_t repeat;
     size_t front;
     size_t size_upload;
     LevelDuration* upload;
-
+    SubGhzProtocolBlockEncoderGenerator generator; /**< Used when upload is NULL */
 } SubGhzProtocolBlockEncoder;
 
+/** Get the next LevelDuration of the encoder
+ *
+ * Plays the upload buffer, or the generator if there is none, repeat times.
+ *
+ * @param      encoder  Pointer to a SubGhzProtocolBlockEncoder instance
+ * @param      context  Encoder instance, passed to the generator
+ *
+ * @return     LevelDuration, level_duration_reset() when done
+ */
+LevelDuration
+    subghz_protocol_blocks_encoder_yield(SubGhzProtocolBlockEncoder* encoder, void* context);
+
 typedef enum {
     SubGhzProtocolBlockAlignBitLeft,
     SubGhzProtocolBlockAlignBitRight,
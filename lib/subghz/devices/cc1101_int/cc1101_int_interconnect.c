@@ -25,6 +25,11 @@ static void subghz_device_cc1101_int_interconnect_start_async_rx(void* callback,
     furi_hal_subghz_start_async_rx((FuriHalSubGhzCaptureCallback)callback, context);
 }
 
+static void
+    subghz_device_cc1101_int_interconnect_start_async_rx_batch(void* callback, void* context) {
+    furi_hal_subghz_start_async_rx_dma((FuriHalSubGhzCaptureBatchCallback)callback, context);
+}
+
 static void subghz_device_cc1101_int_interconnect_load_preset(
     FuriHalSubGhzPreset preset,
     uint8_t* preset_data) {
@@ -88,6 +93,8 @@ const SubGhzDeviceInterconnect subghz_device_cc1101_int_interconnect = {
     .is_rx_data_crc_valid = furi_hal_subghz_is_rx_data_crc_valid,
     .read_packet = furi_hal_subghz_read_packet,
     .write_packet = furi_hal_subghz_write_packet,
+
+    .start_async_rx_batch = subghz_device_cc1101_int_interconnect_start_async_rx_batch,
 };
 
 const SubGhzDevice subghz_device_cc1101_int = {
@@ -178,6 +178,19 @@ void subghz_devices_start_async_rx(const SubGhzDevice* device, void* callback, v
     }
 }
 
+bool subghz_devices_start_async_rx_batch(
+    const SubGhzDevice* device,
+    void* callback,
+    void* context) {
+    furi_check(device);
+    bool ret = false;
+    if(device->interconnect->start_async_rx_batch) {
+        device->interconnect->start_async_rx_batch(callback, context);
+        ret = true;
+    }
+    return ret;
+}
+
 void subghz_devices_stop_async_rx(const SubGhzDevice* device) {
     furi_check(device);
     if(device->interconnect->stop_async_rx) {
@@ -39,6 +39,15 @@ void subghz_devices_flush_rx(const SubGhzDevice* device);
 void subghz_devices_start_async_rx(const SubGhzDevice* device, void* callback, void* context);
 void subghz_devices_stop_async_rx(const SubGhzDevice* device);
 
+/** Start async RX delivering pulses in batches, stop with subghz_devices_stop_async_rx
+ *
+ * @return     false if the device has no batch capture, nothing is started then
+ */
+bool subghz_devices_start_async_rx_batch(
+    const SubGhzDevice* device,
+    void* callback,
+    void* context);
+
 float subghz_devices_get_rssi(const SubGhzDevice* device);
 uint8_t subghz_devices_get_lqi(const SubGhzDevice* device);
 
@@ -40,6 +40,7 @@ typedef void (*SubGhzSetRx)(void);
 typedef void (*SubGhzFlushRx)(void);
 typedef void (*SubGhzStartAsyncRx)(void* callback, void* context);
 typedef void (*SubGhzStopAsyncRx)(void);
+typedef void (*SubGhzStartAsyncRxBatch)(void* callback, void* context);
 
 typedef float (*SubGhzGetRSSI)(void);
 typedef uint8_t (*SubGhzGetLQI)(void);
@@ -83,6 +84,7 @@ typedef struct {
     SubGhzReadPacket read_packet;
     SubGhzWritePacket write_packet;
 
+    SubGhzStartAsyncRxBatch start_async_rx_batch; ///< Optional, stopped with stop_async_rx
 } SubGhzDeviceInterconnect;
 
 struct SubGhzDevice {
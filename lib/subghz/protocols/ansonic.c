@@ -53,6 +53,7 @@ const SubGhzProtocolDecoder subghz_protocol_ansonic_decoder = {
     .serialize = subghz_protocol_decoder_ansonic_serialize,
     .deserialize = subghz_protocol_decoder_ansonic_deserialize,
     .get_string = subghz_protocol_decoder_ansonic_get_string,
+    .get_idle_filter = subghz_protocol_decoder_ansonic_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_ansonic_encoder = {
@@ -279,6 +280,17 @@ void subghz_protocol_decoder_ansonic_feed(void* context, bool level, uint32_t du
     }
 }
 
+void subghz_protocol_decoder_ansonic_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderAnsonic* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_ansonic_const.te_short * 35;
+    filter->delta = subghz_protocol_ansonic_const.te_delta * 35;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
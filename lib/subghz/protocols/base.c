@@ -60,6 +60,26 @@ SubGhzProtocolStatus subghz_protocol_decoder_base_deserialize(
     return status;
 }
 
+void subghz_protocol_decoder_base_feed_batch(
+    SubGhzProtocolDecoderBase* decoder_base,
+    const LevelDuration* pulses,
+    size_t count) {
+    furi_check(decoder_base);
+    furi_check(pulses || !count);
+
+    const SubGhzProtocolDecoder* decoder = decoder_base->protocol->decoder;
+    if(decoder->feed_batch) {
+        decoder->feed_batch(decoder_base, pulses, count);
+    } else {
+        for(size_t i = 0; i < count; i++) {
+            decoder->feed(
+                decoder_base,
+                level_duration_get_level(pulses[i]),
+                level_duration_get_duration(pulses[i]));
+        }
+    }
+}
+
 uint8_t subghz_protocol_decoder_base_get_hash_data(SubGhzProtocolDecoderBase* decoder_base) {
     furi_check(decoder_base);
 
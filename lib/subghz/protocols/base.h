@@ -66,6 +66,18 @@ SubGhzProtocolStatus subghz_protocol_decoder_base_deserialize(
     SubGhzProtocolDecoderBase* decoder_base,
     FlipperFormat* flipper_format);
 
+/**
+ * Parse a batch of levels and durations received from the air.
+ * Uses the decoder batch feed if it has one, otherwise feeds the pulses one by one.
+ * @param decoder_base Pointer to a SubGhzProtocolDecoderBase instance
+ * @param pulses Pointer to an array of LevelDuration, reset and wait entries are not allowed
+ * @param count Number of pulses in the array
+ */
+void subghz_protocol_decoder_base_feed_batch(
+    SubGhzProtocolDecoderBase* decoder_base,
+    const LevelDuration* pulses,
+    size_t count);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param decoder_base Pointer to a SubGhzProtocolDecoderBase instance
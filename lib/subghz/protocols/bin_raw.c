@@ -24,6 +24,12 @@
 #define BIN_RAW_BUF_MIN_DATA_COUNT 128
 #define BIN_RAW_MAX_MARKUP_COUNT   20
 
+//duration histogram, 4 buckets per octave from 16us, longer durations share the last one
+#define BIN_RAW_HISTOGRAM_OCTAVE_MIN   4
+#define BIN_RAW_HISTOGRAM_OCTAVE_STEPS 4
+#define BIN_RAW_HISTOGRAM_SIZE         (12 * BIN_RAW_HISTOGRAM_OCTAVE_STEPS)
+#define BIN_RAW_DURATION_MAX           1000000UL
+
 //#define BIN_RAW_DEBUG
 
 #ifdef BIN_RAW_DEBUG
@@ -135,6 +141,38 @@ static uint16_t subghz_protocol_bin_raw_get_full_byte(uint16_t bit_count) {
     }
 }
 
+static size_t subghz_protocol_bin_raw_get_histogram_bucket(uint32_t duration) {
+    duration = MAX(duration, 1UL << BIN_RAW_HISTOGRAM_OCTAVE_MIN);
+    size_t octave = 31 - __builtin_clz(duration);
+    //two bits after the leading one select a quarter of the octave
+    size_t step = (duration >> (octave - 2)) & (BIN_RAW_HISTOGRAM_OCTAVE_STEPS - 1);
+    size_t bucket =
+        (octave - BIN_RAW_HISTOGRAM_OCTAVE_MIN) * BIN_RAW_HISTOGRAM_OCTAVE_STEPS + step;
+    return MIN(bucket, (size_t)BIN_RAW_HISTOGRAM_SIZE - 1);
+}
+
+static void subghz_protocol_bin_raw_set_bits(
+    uint8_t* data,
+    size_t position,
+    size_t count,
+    bool level) {
+    //whole bytes of a long level are written at once
+    const uint8_t fill = level ? 0xFF : 0x00;
+    while(count && (position & 0x7)) {
+        subghz_protocol_blocks_set_bit_array(level, data, position++, BIN_RAW_BUF_DATA_SIZE);
+        count--;
+    }
+    if(count >= 8) {
+        furi_check(((position + (count & ~0x7)) >> 3) <= BIN_RAW_BUF_DATA_SIZE);
+        memset(&data[position >> 3], fill, count >> 3);
+        position += count & ~0x7;
+        count &= 0x7;
+    }
+    while(count--) {
+        subghz_protocol_blocks_set_bit_array(level, data, position++, BIN_RAW_BUF_DATA_SIZE);
+    }
+}
+
 void* subghz_protocol_encoder_bin_raw_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderBinRAW* instance = malloc(sizeof(SubGhzProtocolEncoderBinRAW));
@@ -420,21 +458,33 @@ static bool
     }
 
     //sort the durations to find the shortest correlated interval
+    //one counting pass over log scale buckets, then the peaks become classes
+    uint16_t histogram_count[BIN_RAW_HISTOGRAM_SIZE] = {0};
+    uint32_t histogram_sum[BIN_RAW_HISTOGRAM_SIZE] = {0};
     for(size_t i = 0; i < ind; i++) {
-        for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
-            if(classes[k].count == 0) {
-                classes[k].data = (float)(abs(instance->data_raw[i]));
-                classes[k].count++;
-                break;
-            } else if(
-                DURATION_DIFF((float)(abs(instance->data_raw[i])), (classes[k].data)) <
-                (classes[k].data / 4)) { //if the test value does not differ by more than 25%
-                classes[k].data += ((float)(abs(instance->data_raw[i])) - classes[k].data) *
-                                   0.05f; //running average k=0.05
-                classes[k].count++;
-                break;
-            }
+        uint32_t duration = MIN((uint32_t)abs(instance->data_raw[i]), BIN_RAW_DURATION_MAX);
+        size_t bucket = subghz_protocol_bin_raw_get_histogram_bucket(duration);
+        histogram_count[bucket]++;
+        histogram_sum[bucket] += duration;
+    }
+
+    for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
+        size_t peak = 0;
+        for(size_t i = 1; i < BIN_RAW_HISTOGRAM_SIZE; i++) {
+            if(histogram_count[i] > histogram_count[peak]) peak = i;
         }
+        if(histogram_count[peak] == 0) break;
+
+        //the peak takes both neighbors, close to the former 25% class window
+        uint32_t sum = 0;
+        size_t first = (peak > 0) ? (peak - 1) : peak;
+        size_t last = MIN(peak + 1, BIN_RAW_HISTOGRAM_SIZE - 1);
+        for(size_t i = first; i <= last; i++) {
+            classes[k].count += histogram_count[i];
+            sum += histogram_sum[i];
+            histogram_count[i] = 0;
+        }
+        classes[k].data = (float)sum / classes[k].count;
     }
 
     // if(classes[BIN_RAW_SEARCH_CLASSES - 1].count != 0) {
@@ -548,21 +598,12 @@ static bool
             data_temp = (int)(roundf((float)(instance->data_raw[gap_ind]) / instance->te));
             bin_raw_debug("%d ", data_temp);
             if(data_temp == 0) bit_count++; //there is noise in the package
-            for(size_t i = 0; i < (size_t)abs(data_temp); i++) {
-                bit_count++;
-                if(ind) {
-                    ind--;
-                } else {
-                    break;
-                }
-                if(data_temp > 0) {
-                    subghz_protocol_blocks_set_bit_array(
-                        true, instance->data, ind, BIN_RAW_BUF_DATA_SIZE);
-                } else {
-                    subghz_protocol_blocks_set_bit_array(
-                        false, instance->data, ind, BIN_RAW_BUF_DATA_SIZE);
-                }
-            }
+            size_t bits = abs(data_temp);
+            //a level that does not fit counts one extra bit, then the buffer is full
+            bit_count += (bits > ind) ? (ind + 1) : bits;
+            bits = MIN(bits, ind);
+            ind -= bits;
+            subghz_protocol_bin_raw_set_bits(instance->data, ind, bits, data_temp > 0);
             //split into full bytes if gap is caught
             if(DURATION_DIFF(abs(instance->data_raw[gap_ind]), (int32_t)gap) < gap_delta) {
                 instance->data_markup[data_markup_ind].byte_bias = ind >> 3;
@@ -812,19 +853,10 @@ static bool
             if(data_temp == 0) break; //found an interval 2 times shorter than TE, this is noise
             bin_raw_debug("%d  ", data_temp);
 
-            for(size_t k = 0; k < (size_t)abs(data_temp); k++) {
-                if(data_temp > 0) {
-                    subghz_protocol_blocks_set_bit_array(
-                        true, instance->data, ind++, BIN_RAW_BUF_DATA_SIZE);
-                } else {
-                    subghz_protocol_blocks_set_bit_array(
-                        false, instance->data, ind++, BIN_RAW_BUF_DATA_SIZE);
-                }
-                if(ind == BIN_RAW_BUF_DATA_SIZE * 8) {
-                    i = instance->data_raw_ind;
-                    break;
-                }
-            }
+            size_t bits = MIN((size_t)abs(data_temp), (BIN_RAW_BUF_DATA_SIZE * 8) - ind);
+            subghz_protocol_bin_raw_set_bits(instance->data, ind, bits, data_temp > 0);
+            ind += bits;
+            if(ind == BIN_RAW_BUF_DATA_SIZE * 8) break;
         }
 
         if(ind != 0) {
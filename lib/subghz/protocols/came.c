@@ -60,6 +60,7 @@ const SubGhzProtocolDecoder subghz_protocol_came_decoder = {
     .serialize = subghz_protocol_decoder_came_serialize,
     .deserialize = subghz_protocol_decoder_came_deserialize,
     .get_string = subghz_protocol_decoder_came_get_string,
+    .get_idle_filter = subghz_protocol_decoder_came_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_encoder = {
@@ -311,6 +312,17 @@ void subghz_protocol_decoder_came_feed(void* context, bool level, uint32_t durat
     }
 }
 
+void subghz_protocol_decoder_came_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderCame* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_came_const.te_short * 56;
+    filter->delta = subghz_protocol_came_const.te_delta * 47;
+}
+
 uint8_t subghz_protocol_decoder_came_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderCame* instance = context;
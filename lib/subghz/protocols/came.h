@@ -73,6 +73,15 @@ void subghz_protocol_decoder_came_reset(void* context);
  */
 void subghz_protocol_decoder_came_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Get the pulse window that takes the decoder out of the reset step.
+ * @param context Pointer to a SubGhzProtocolDecoderCame instance
+ * @param filter Pointer to a SubGhzProtocolDecoderIdleFilter to fill
+ */
+void subghz_protocol_decoder_came_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderCame instance
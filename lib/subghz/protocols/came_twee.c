@@ -63,6 +63,15 @@ struct SubGhzProtocolEncoderCameTwee {
 
     SubGhzProtocolBlockEncoder encoder;
     SubGhzBlockGeneric generic;
+
+    // Frame generator state
+    ManchesterEncoderState enc_state;
+    uint64_t parcel;
+    int8_t parcel_index;
+    uint8_t bit_index;
+    LevelDuration pending[2];
+    uint8_t pending_front;
+    uint8_t pending_count;
 };
 
 typedef enum {
@@ -102,6 +111,8 @@ const SubGhzProtocol subghz_protocol_came_twee = {
     .encoder = &subghz_protocol_came_twee_encoder,
 };
 
+static LevelDuration subghz_protocol_encoder_came_twee_generate(void* context, size_t index);
+
 void* subghz_protocol_encoder_came_twee_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderCameTwee* instance = malloc(sizeof(SubGhzProtocolEncoderCameTwee));
@@ -110,8 +121,7 @@ void* subghz_protocol_encoder_came_twee_alloc(SubGhzEnvironment* environment) {
     instance->generic.protocol_name = instance->base.protocol->name;
 
     instance->encoder.repeat = 10;
-    instance->encoder.size_upload = 1536; //max upload 92*14 = 1288 !!!!
-    instance->encoder.upload = malloc(instance->encoder.size_upload * sizeof(LevelDuration));
+    instance->encoder.generator = subghz_protocol_encoder_came_twee_generate;
     instance->encoder.is_running = false;
     return instance;
 }
@@ -119,7 +129,6 @@ void* subghz_protocol_encoder_came_twee_alloc(SubGhzEnvironment* environment) {
 void subghz_protocol_encoder_came_twee_free(void* context) {
     furi_assert(context);
     SubGhzProtocolEncoderCameTwee* instance = context;
-    free(instance->encoder.upload);
     free(instance);
 }
 
@@ -151,42 +160,75 @@ static LevelDuration
     return level_duration_make(data.level, data.duration);
 }
 
+static void subghz_protocol_encoder_came_twee_push(
+    SubGhzProtocolEncoderCameTwee* instance,
+    LevelDuration level_duration) {
+    furi_assert(instance->pending_count < COUNT_OF(instance->pending));
+    instance->pending[instance->pending_count++] = level_duration;
+}
+
+static void
+    subghz_protocol_encoder_came_twee_load_parcel(SubGhzProtocolEncoderCameTwee* instance) {
+    instance->parcel = 0x003FFF7200000000 | //parcel mask
+                       (instance->generic.serial ^
+                        came_twee_magic_numbers_xor[instance->parcel_index]);
+    instance->bit_index = instance->generic.data_count_bit;
+}
+
 /**
- * Generating an upload from data.
- * @param instance Pointer to a SubGhzProtocolEncoderCameTwee instance
+ * Generating a frame from data, one LevelDuration at a time.
+ * Frame is 15 parcels, from the last counter value down to 0.
+ * Every step encodes one bit or closes a parcel, giving up to 2 LevelDuration.
+ * @param context Pointer to a SubGhzProtocolEncoderCameTwee instance
+ * @param index Position in the frame
+ * @return LevelDuration, reset past the end of the frame
  */
-static void subghz_protocol_encoder_came_twee_get_upload(SubGhzProtocolEncoderCameTwee* instance) {
-    furi_assert(instance);
-    size_t index = 0;
-
-    ManchesterEncoderState enc_state;
-    manchester_encoder_reset(&enc_state);
-    ManchesterEncoderResult result;
+static LevelDuration subghz_protocol_encoder_came_twee_generate(void* context, size_t index) {
+    SubGhzProtocolEncoderCameTwee* instance = context;
 
-    uint64_t temp_parcel = 0x003FFF7200000000; //parcel mask
+    if(index == 0) {
+        manchester_encoder_reset(&instance->enc_state);
+        instance->parcel_index = 14;
+        instance->pending_front = 0;
+        instance->pending_count = 0;
+        subghz_protocol_encoder_came_twee_load_parcel(instance);
+    }
 
-    for(int i = 14; i >= 0; i--) {
-        temp_parcel = (temp_parcel & 0xFFFFFFFF00000000) |
-                      (instance->generic.serial ^ came_twee_magic_numbers_xor[i]);
+    if(instance->pending_front == instance->pending_count) {
+        instance->pending_front = 0;
+        instance->pending_count = 0;
+        if(instance->parcel_index < 0) {
+            return level_duration_reset();
+        }
 
-        for(uint8_t i = instance->generic.data_count_bit; i > 0; i--) {
-            if(!manchester_encoder_advance(&enc_state, !bit_read(temp_parcel, i - 1), &result)) {
-                instance->encoder.upload[index++] =
-                    subghz_protocol_encoder_came_twee_add_duration_to_upload(result);
-                manchester_encoder_advance(&enc_state, !bit_read(temp_parcel, i - 1), &result);
+        ManchesterEncoderResult result;
+        if(instance->bit_index > 0) {
+            const bool bit = !bit_read(instance->parcel, instance->bit_index - 1);
+            if(!manchester_encoder_advance(&instance->enc_state, bit, &result)) {
+                subghz_protocol_encoder_came_twee_push(
+                    instance, subghz_protocol_encoder_came_twee_add_duration_to_upload(result));
+                manchester_encoder_advance(&instance->enc_state, bit, &result);
+            }
+            subghz_protocol_encoder_came_twee_push(
+                instance, subghz_protocol_encoder_came_twee_add_duration_to_upload(result));
+            instance->bit_index--;
+        } else {
+            LevelDuration last = subghz_protocol_encoder_came_twee_add_duration_to_upload(
+                manchester_encoder_finish(&instance->enc_state));
+            if(level_duration_get_level(last)) {
+                subghz_protocol_encoder_came_twee_push(instance, last);
+            }
+            subghz_protocol_encoder_came_twee_push(
+                instance,
+                level_duration_make(
+                    false, (uint32_t)subghz_protocol_came_twee_const.te_long * 51));
+            if(--instance->parcel_index >= 0) {
+                subghz_protocol_encoder_came_twee_load_parcel(instance);
             }
-            instance->encoder.upload[index++] =
-                subghz_protocol_encoder_came_twee_add_duration_to_upload(result);
-        }
-        instance->encoder.upload[index] = subghz_protocol_encoder_came_twee_add_duration_to_upload(
-            manchester_encoder_finish(&enc_state));
-        if(level_duration_get_level(instance->encoder.upload[index])) {
-            index++;
         }
-        instance->encoder.upload[index++] =
-            level_duration_make(false, (uint32_t)subghz_protocol_came_twee_const.te_long * 51);
     }
-    instance->encoder.size_upload = index;
+
+    return instance->pending[instance->pending_front++];
 }
 
 /** 
@@ -259,7 +301,7 @@ SubGhzProtocolStatus
             flipper_format, "Repeat", (uint32_t*)&instance->encoder.repeat, 1);
 
         subghz_protocol_came_twee_remote_controller(&instance->generic);
-        subghz_protocol_encoder_came_twee_get_upload(instance);
+        instance->encoder.front = 0;
         instance->encoder.is_running = true;
     } while(false);
 
@@ -273,20 +315,7 @@ void subghz_protocol_encoder_came_twee_stop(void* context) {
 
 LevelDuration subghz_protocol_encoder_came_twee_yield(void* context) {
     SubGhzProtocolEncoderCameTwee* instance = context;
-
-    if(instance->encoder.repeat == 0 || !instance->encoder.is_running) {
-        instance->encoder.is_running = false;
-        return level_duration_reset();
-    }
-
-    LevelDuration ret = instance->encoder.upload[instance->encoder.front];
-
-    if(++instance->encoder.front == instance->encoder.size_upload) {
-        instance->encoder.repeat--;
-        instance->encoder.front = 0;
-    }
-
-    return ret;
+    return subghz_protocol_blocks_encoder_yield(&instance->encoder, instance);
 }
 
 void* subghz_protocol_decoder_came_twee_alloc(SubGhzEnvironment* environment) {
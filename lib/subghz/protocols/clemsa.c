@@ -62,6 +62,7 @@ const SubGhzProtocolDecoder subghz_protocol_clemsa_decoder = {
     .serialize = subghz_protocol_decoder_clemsa_serialize,
     .deserialize = subghz_protocol_decoder_clemsa_deserialize,
     .get_string = subghz_protocol_decoder_clemsa_get_string,
+    .get_idle_filter = subghz_protocol_decoder_clemsa_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_clemsa_encoder = {
@@ -300,6 +301,17 @@ void subghz_protocol_decoder_clemsa_feed(void* context, bool level, uint32_t dur
     }
 }
 
+void subghz_protocol_decoder_clemsa_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderClemsa* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_clemsa_const.te_short * 51;
+    filter->delta = subghz_protocol_clemsa_const.te_delta * 25;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -54,6 +54,7 @@ const SubGhzProtocolDecoder subghz_protocol_doitrand_decoder = {
     .serialize = subghz_protocol_decoder_doitrand_serialize,
     .deserialize = subghz_protocol_decoder_doitrand_deserialize,
     .get_string = subghz_protocol_decoder_doitrand_get_string,
+    .get_idle_filter = subghz_protocol_decoder_doitrand_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_doitrand_encoder = {
@@ -276,6 +277,17 @@ void subghz_protocol_decoder_doitrand_feed(void* context, bool level, uint32_t d
     }
 }
 
+void subghz_protocol_decoder_doitrand_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderDoitrand* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_doitrand_const.te_short * 62;
+    filter->delta = subghz_protocol_doitrand_const.te_delta * 30;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -47,6 +47,7 @@ const SubGhzProtocolDecoder subghz_protocol_gate_tx_decoder = {
     .serialize = subghz_protocol_decoder_gate_tx_serialize,
     .deserialize = subghz_protocol_decoder_gate_tx_deserialize,
     .get_string = subghz_protocol_decoder_gate_tx_get_string,
+    .get_idle_filter = subghz_protocol_decoder_gate_tx_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_gate_tx_encoder = {
@@ -269,6 +270,17 @@ void subghz_protocol_decoder_gate_tx_feed(void* context, bool level, uint32_t du
     }
 }
 
+void subghz_protocol_decoder_gate_tx_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderGateTx* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_gate_tx_const.te_short * 47;
+    filter->delta = subghz_protocol_gate_tx_const.te_delta * 47;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -57,6 +57,7 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_decoder = {
     .serialize = subghz_protocol_decoder_holtek_serialize,
     .deserialize = subghz_protocol_decoder_holtek_deserialize,
     .get_string = subghz_protocol_decoder_holtek_get_string,
+    .get_idle_filter = subghz_protocol_decoder_holtek_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_holtek_encoder = {
@@ -288,6 +289,17 @@ void subghz_protocol_decoder_holtek_feed(void* context, bool level, uint32_t dur
     }
 }
 
+void subghz_protocol_decoder_holtek_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHoltek* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_holtek_const.te_short * 36;
+    filter->delta = subghz_protocol_holtek_const.te_delta * 36;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -64,6 +64,7 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_th12x_decoder = {
     .serialize = subghz_protocol_decoder_holtek_th12x_serialize,
     .deserialize = subghz_protocol_decoder_holtek_th12x_deserialize,
     .get_string = subghz_protocol_decoder_holtek_th12x_get_string,
+    .get_idle_filter = subghz_protocol_decoder_holtek_th12x_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_holtek_th12x_encoder = {
@@ -313,6 +314,17 @@ void subghz_protocol_decoder_holtek_th12x_feed(void* context, bool level, uint32
     }
 }
 
+void subghz_protocol_decoder_holtek_th12x_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHoltek_HT12X* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_holtek_th12x_const.te_short * 36;
+    filter->delta = subghz_protocol_holtek_th12x_const.te_delta * 36;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
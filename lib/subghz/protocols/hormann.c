@@ -51,6 +51,7 @@ const SubGhzProtocolDecoder subghz_protocol_hormann_decoder = {
     .serialize = subghz_protocol_decoder_hormann_serialize,
     .deserialize = subghz_protocol_decoder_hormann_deserialize,
     .get_string = subghz_protocol_decoder_hormann_get_string,
+    .get_idle_filter = subghz_protocol_decoder_hormann_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_hormann_encoder = {
@@ -73,6 +74,38 @@ const SubGhzProtocol subghz_protocol_hormann = {
     .encoder = &subghz_protocol_hormann_encoder,
 };
 
+/**
+ * Generating a frame from data, one LevelDuration at a time.
+ * Frame is 20 parcels and a closing start bit.
+ * @param context Pointer to a SubGhzProtocolEncoderHormann instance
+ * @param index Position in the frame
+ * @return LevelDuration, reset past the end of the frame
+ */
+static LevelDuration subghz_protocol_encoder_hormann_generate(void* context, size_t index) {
+    SubGhzProtocolEncoderHormann* instance = context;
+    const uint32_t te_short = subghz_protocol_hormann_const.te_short;
+    const uint32_t te_long = subghz_protocol_hormann_const.te_long;
+    const size_t size_parcel = instance->generic.data_count_bit * 2 + 2;
+
+    if(index > size_parcel * 20) {
+        return level_duration_reset();
+    }
+
+    const size_t position = index % size_parcel;
+    if(position == 0) {
+        //Send start bit
+        return level_duration_make(true, te_short * 24);
+    } else if(position == 1) {
+        return level_duration_make(false, te_short);
+    }
+
+    //Send key data: bit 1 is te_long high and te_short low, bit 0 is the other way round
+    const bool bit =
+        bit_read(instance->generic.data, instance->generic.data_count_bit - position / 2);
+    const bool level = !(position & 1);
+    return level_duration_make(level, (bit == level) ? te_long : te_short);
+}
+
 void* subghz_protocol_encoder_hormann_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderHormann* instance = malloc(sizeof(SubGhzProtocolEncoderHormann));
@@ -81,8 +114,7 @@ void* subghz_protocol_encoder_hormann_alloc(SubGhzEnvironment* environment) {
     instance->generic.protocol_name = instance->base.protocol->name;
 
     instance->encoder.repeat = 10;
-    instance->encoder.size_upload = 2048;
-    instance->encoder.upload = malloc(instance->encoder.size_upload * sizeof(LevelDuration));
+    instance->encoder.generator = subghz_protocol_encoder_hormann_generate;
     instance->encoder.is_running = false;
     return instance;
 }
@@ -90,56 +122,9 @@ void* subghz_protocol_encoder_hormann_alloc(SubGhzEnvironment* environment) {
 void subghz_protocol_encoder_hormann_free(void* context) {
     furi_assert(context);
     SubGhzProtocolEncoderHormann* instance = context;
-    free(instance->encoder.upload);
     free(instance);
 }
 
-/**
- * Generating an upload from data.
- * @param instance Pointer to a SubGhzProtocolEncoderHormann instance
- * @return true On success
- */
-static bool subghz_protocol_encoder_hormann_get_upload(SubGhzProtocolEncoderHormann* instance) {
-    furi_assert(instance);
-
-    size_t index = 0;
-    size_t size_upload = (instance->generic.data_count_bit * 2 + 2) * 20 + 1;
-    if(size_upload > instance->encoder.size_upload) {
-        FURI_LOG_E(TAG, "Size upload exceeds allocated encoder buffer.");
-        return false;
-    } else {
-        instance->encoder.size_upload = size_upload;
-    }
-    instance->encoder.repeat = 10; //original remote does 10 repeats
-
-    for(size_t repeat = 0; repeat < 20; repeat++) {
-        //Send start bit
-        instance->encoder.upload[index++] =
-            level_duration_make(true, (uint32_t)subghz_protocol_hormann_const.te_short * 24);
-        instance->encoder.upload[index++] =
-            level_duration_make(false, (uint32_t)subghz_protocol_hormann_const.te_short);
-        //Send key data
-        for(uint8_t i = instance->generic.data_count_bit; i > 0; i--) {
-            if(bit_read(instance->generic.data, i - 1)) {
-                //send bit 1
-                instance->encoder.upload[index++] =
-                    level_duration_make(true, (uint32_t)subghz_protocol_hormann_const.te_long);
-                instance->encoder.upload[index++] =
-                    level_duration_make(false, (uint32_t)subghz_protocol_hormann_const.te_short);
-            } else {
-                //send bit 0
-                instance->encoder.upload[index++] =
-                    level_duration_make(true, (uint32_t)subghz_protocol_hormann_const.te_short);
-                instance->encoder.upload[index++] =
-                    level_duration_make(false, (uint32_t)subghz_protocol_hormann_const.te_long);
-            }
-        }
-    }
-    instance->encoder.upload[index++] =
-        level_duration_make(true, (uint32_t)subghz_protocol_hormann_const.te_short * 24);
-    return true;
-}
-
 SubGhzProtocolStatus
     subghz_protocol_encoder_hormann_deserialize(void* context, FlipperFormat* flipper_format) {
     furi_assert(context);
@@ -157,10 +142,8 @@ SubGhzProtocolStatus
         flipper_format_read_uint32(
             flipper_format, "Repeat", (uint32_t*)&instance->encoder.repeat, 1);
 
-        if(!subghz_protocol_encoder_hormann_get_upload(instance)) {
-            ret = SubGhzProtocolStatusErrorEncoderGetUpload;
-            break;
-        }
+        instance->encoder.repeat = 10; //original remote does 10 repeats
+        instance->encoder.front = 0;
         instance->encoder.is_running = true;
     } while(false);
 
@@ -174,20 +157,7 @@ void subghz_protocol_encoder_hormann_stop(void* context) {
 
 LevelDuration subghz_protocol_encoder_hormann_yield(void* context) {
     SubGhzProtocolEncoderHormann* instance = context;
-
-    if(instance->encoder.repeat == 0 || !instance->encoder.is_running) {
-        instance->encoder.is_running = false;
-        return level_duration_reset();
-    }
-
-    LevelDuration ret = instance->encoder.upload[instance->encoder.front];
-
-    if(++instance->encoder.front == instance->encoder.size_upload) {
-        instance->encoder.repeat--;
-        instance->encoder.front = 0;
-    }
-
-    return ret;
+    return subghz_protocol_blocks_encoder_yield(&instance->encoder, instance);
 }
 
 void* subghz_protocol_decoder_hormann_alloc(SubGhzEnvironment* environment) {
@@ -280,6 +250,17 @@ void subghz_protocol_decoder_hormann_feed(void* context, bool level, uint32_t du
     }
 }
 
+void subghz_protocol_decoder_hormann_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHormann* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = true;
+    filter->duration = subghz_protocol_hormann_const.te_short * 24;
+    filter->delta = subghz_protocol_hormann_const.te_delta * 24;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -56,6 +56,7 @@ const SubGhzProtocolDecoder subghz_protocol_intertechno_v3_decoder = {
     .serialize = subghz_protocol_decoder_intertechno_v3_serialize,
     .deserialize = subghz_protocol_decoder_intertechno_v3_deserialize,
     .get_string = subghz_protocol_decoder_intertechno_v3_get_string,
+    .get_idle_filter = subghz_protocol_decoder_intertechno_v3_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_intertechno_v3_encoder = {
@@ -346,6 +347,17 @@ void subghz_protocol_decoder_intertechno_v3_feed(void* context, bool level, uint
     }
 }
 
+void subghz_protocol_decoder_intertechno_v3_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderIntertechno_V3* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_intertechno_v3_const.te_short * 37;
+    filter->delta = subghz_protocol_intertechno_v3_const.te_delta * 15;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
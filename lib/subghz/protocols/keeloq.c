@@ -58,6 +58,7 @@ const SubGhzProtocolDecoder subghz_protocol_keeloq_decoder = {
     .serialize = subghz_protocol_decoder_keeloq_serialize,
     .deserialize = subghz_protocol_decoder_keeloq_deserialize,
     .get_string = subghz_protocol_decoder_keeloq_get_string,
+    .get_idle_filter = subghz_protocol_decoder_keeloq_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_keeloq_encoder = {
@@ -126,36 +127,31 @@ static bool subghz_protocol_keeloq_gen_data(SubGhzProtocolEncoderKeeloq* instanc
                        instance->generic.cnt;
     uint32_t hop = 0;
     uint64_t man = 0;
-    int res = 0;
 
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            res = strcmp(furi_string_get_cstr(manufacture_code->name), instance->manufacture_name);
-            if(res == 0) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    //Simple Learning
-                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    //Simple Learning
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        instance->generic.serial, manufacture_code->key);
-                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    //Invalid or missing encoding type in keeloq_mfcodes
-                    hop = 0;
-                    break;
-                }
-                break;
-            }
+    const SubGhzKey* manufacture_code =
+        subghz_keystore_find(instance->keystore, instance->manufacture_name);
+    if(manufacture_code) {
+        switch(manufacture_code->type) {
+        case KEELOQ_LEARNING_SIMPLE:
+            //Simple Learning
+            hop = subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
+            break;
+        case KEELOQ_LEARNING_NORMAL:
+            //Simple Learning
+            man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+            break;
+        case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+            man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
+                instance->generic.serial, manufacture_code->key);
+            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+            break;
+        case KEELOQ_LEARNING_UNKNOWN:
+            //Invalid or missing encoding type in keeloq_mfcodes
+            hop = 0;
+            break;
         }
+    }
     if(hop) {
         uint64_t yek = (uint64_t)fix << 32 | hop;
         instance->generic.data =
@@ -445,6 +441,17 @@ void subghz_protocol_decoder_keeloq_feed(void* context, bool level, uint32_t dur
     }
 }
 
+void subghz_protocol_decoder_keeloq_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderKeeloq* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = true;
+    filter->duration = subghz_protocol_keeloq_const.te_short;
+    filter->delta = subghz_protocol_keeloq_const.te_delta;
+}
+
 /**
  * Validation of decrypt data.
  * @param instance Pointer to a SubGhzBlockGeneric instance
@@ -480,6 +487,54 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
+/* Candidate keys are decrypted KEELOQ_BATCH_SIZE at a time and checked in order */
+typedef struct {
+    SubGhzBlockGeneric* instance;
+    uint32_t hop;
+    uint8_t btn;
+    uint16_t end_serial;
+    size_t count;
+    uint64_t man[KEELOQ_BATCH_SIZE];
+    uint32_t decrypt[KEELOQ_BATCH_SIZE];
+    const SubGhzKey* manufacture_code[KEELOQ_BATCH_SIZE];
+    bool centurion[KEELOQ_BATCH_SIZE];
+} SubGhzProtocolKeeloqBatch;
+
+static const SubGhzKey* subghz_protocol_keeloq_batch_flush(SubGhzProtocolKeeloqBatch* batch) {
+    const size_t count = batch->count;
+    batch->count = 0;
+    if(!count) return NULL;
+
+    subghz_protocol_keeloq_common_decrypt_batch(batch->hop, batch->man, batch->decrypt, count);
+
+    for(size_t i = 0; i < count; i++) {
+        bool valid;
+        if(batch->centurion[i]) {
+            valid = subghz_protocol_keeloq_check_decrypt_centurion(
+                batch->instance, batch->decrypt[i], batch->btn);
+        } else {
+            valid = subghz_protocol_keeloq_check_decrypt(
+                batch->instance, batch->decrypt[i], batch->btn, batch->end_serial);
+        }
+        if(valid) return batch->manufacture_code[i];
+    }
+
+    return NULL;
+}
+
+static const SubGhzKey* subghz_protocol_keeloq_batch_add(
+    SubGhzProtocolKeeloqBatch* batch,
+    const SubGhzKey* manufacture_code,
+    uint64_t man,
+    bool centurion) {
+    batch->man[batch->count] = man;
+    batch->manufacture_code[batch->count] = manufacture_code;
+    batch->centurion[batch->count] = centurion;
+    batch->count++;
+
+    return batch->count == KEELOQ_BATCH_SIZE ? subghz_protocol_keeloq_batch_flush(batch) : NULL;
+}
+
 /** 
  * Checking the accepted code against the database manafacture key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -499,162 +554,111 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
     // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
 
-    uint16_t end_serial = (uint16_t)(fix & 0xFF);
-    uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man;
+    SubGhzProtocolKeeloqBatch* batch = malloc(sizeof(SubGhzProtocolKeeloqBatch));
+    batch->instance = instance;
+    batch->hop = hop;
+    batch->end_serial = (uint16_t)(fix & 0xFF);
+    batch->btn = (uint8_t)(fix >> 28);
+
+    const SubGhzKey* found = NULL;
     uint32_t seed = 0;
 
     for
         M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
+            const uint64_t key = manufacture_code->key;
             switch(manufacture_code->type) {
             case KEELOQ_LEARNING_SIMPLE:
                 // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_batch_add(batch, manufacture_code, key, false);
                 break;
             case KEELOQ_LEARNING_NORMAL:
                 // Normal Learning
                 // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0) {
-                    if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        return 1;
-                    }
-                } else {
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        return 1;
-                    }
-                }
+                found = subghz_protocol_keeloq_batch_add(
+                    batch,
+                    manufacture_code,
+                    subghz_protocol_keeloq_common_normal_learning(fix, key),
+                    strcmp(manufacture_code->name, "Centurion") == 0);
                 break;
             case KEELOQ_LEARNING_SECURE:
-                man = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_batch_add(
+                    batch,
+                    manufacture_code,
+                    subghz_protocol_keeloq_common_secure_learning(fix, seed, key),
+                    false);
                 break;
             case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_batch_add(
+                    batch,
+                    manufacture_code,
+                    subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key),
+                    false);
                 break;
             case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_batch_add(
+                    batch,
+                    manufacture_code,
+                    subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key),
+                    false);
                 break;
             case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_batch_add(
+                    batch,
+                    manufacture_code,
+                    subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key),
+                    false);
                 break;
             case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                found = subghz_protocol_keeloq_batch_add(
+                    batch,
+                    manufacture_code,
+                    subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key),
+                    false);
                 break;
-            case KEELOQ_LEARNING_UNKNOWN:
-                // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
+            case KEELOQ_LEARNING_UNKNOWN: {
+                // Try everything, each with mirrored man too
                 uint64_t man_rev = 0;
                 uint64_t man_rev_byte = 0;
                 for(uint8_t i = 0; i < 64; i += 8) {
-                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
+                    man_rev_byte = (uint8_t)(key >> i);
                     man_rev = man_rev | man_rev_byte << (56 - i);
                 }
 
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                //###########################
-                // Normal Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Secure Learning
-                man = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_secure_learning(fix, seed, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Magic xor type1 learning
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
+                const uint64_t man[] = {
+                    // Simple Learning
+                    key,
+                    man_rev,
+                    // Normal Learning
+                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+                    subghz_protocol_keeloq_common_normal_learning(fix, key),
+                    subghz_protocol_keeloq_common_normal_learning(fix, man_rev),
+                    // Secure Learning
+                    subghz_protocol_keeloq_common_secure_learning(fix, seed, key),
+                    subghz_protocol_keeloq_common_secure_learning(fix, seed, man_rev),
+                    // Magic xor type1 learning
+                    subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key),
+                    subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev),
+                };
+
+                for(size_t i = 0; i < COUNT_OF(man) && !found; i++) {
+                    found =
+                        subghz_protocol_keeloq_batch_add(batch, manufacture_code, man[i], false);
                 }
                 break;
             }
+            }
+
+            if(found) break;
         }
 
+    if(!found) found = subghz_protocol_keeloq_batch_flush(batch);
+    free(batch);
+
+    if(found) {
+        *manufacture_name = found->name;
+        return 1;
+    }
+
     *manufacture_name = "Unknown";
     instance->cnt = 0;
 
@@ -4,9 +4,25 @@
 
 #include <m-array.h>
 
-#define bit(x, n) (((x) >> (n)) & 1)
-#define g5(x, a, b, c, d, e) \
-    (bit(x, a) + bit(x, b) * 2 + bit(x, c) * 4 + bit(x, d) * 8 + bit(x, e) * 16)
+#define KEELOQ_ROUNDS (528U)
+
+/* NLF inputs are taken from bits 0, 8, 19, 25, 30 of the decrypt state */
+static inline uint32_t subghz_protocol_keeloq_common_nlf_index(uint32_t x) {
+    return (x & 1U) | ((x >> 7) & 2U) | ((x >> 17) & 4U) | ((x >> 22) & 8U) | ((x >> 26) & 16U);
+}
+
+/* Key bits are consumed from a 32 bit word, no 64 bit shifts in the loop */
+#define KEELOQ_ENCRYPT_ROUNDS(x, k, n)                                                        \
+    for(uint32_t i = 0, w = (k); i < (n); i++, w >>= 1) {                                     \
+        const uint32_t nlf = KEELOQ_NLF >> subghz_protocol_keeloq_common_nlf_index((x) >> 1); \
+        (x) = ((x) >> 1) ^ ((((x) ^ ((x) >> 16) ^ w ^ nlf) & 1U) << 31);                      \
+    }
+
+#define KEELOQ_DECRYPT_ROUNDS(x, k, n)                                                 \
+    for(uint32_t i = 0, w = (k); i < (n); i++, w <<= 1) {                              \
+        const uint32_t nlf = KEELOQ_NLF >> subghz_protocol_keeloq_common_nlf_index(x); \
+        (x) = ((x) << 1) ^ ((((x) >> 31) ^ ((x) >> 15) ^ (w >> 31) ^ nlf) & 1U);       \
+    }
 
 /** Simple Learning Encrypt
  * @param data - 0xBSSSCCCC, B(4bit) key, S(10bit) serial&0x3FF, C(16bit) counter
@@ -14,11 +30,15 @@
  * @return keeloq encrypt data
  */
 inline uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const uint64_t key) {
-    uint32_t x = data, r;
-    for(r = 0; r < 528; r++)
-        x = (x >> 1) ^ ((bit(x, 0) ^ bit(x, 16) ^ (uint32_t)bit(key, r & 63) ^
-                         bit(KEELOQ_NLF, g5(x, 1, 9, 20, 26, 31)))
-                        << 31);
+    const uint32_t key_lo = key;
+    const uint32_t key_hi = key >> 32;
+    uint32_t x = data;
+    // 8 passes over key bits 0..63, then bits 0..15
+    for(size_t pass = 0; pass < KEELOQ_ROUNDS / 64; pass++) {
+        KEELOQ_ENCRYPT_ROUNDS(x, key_lo, 32);
+        KEELOQ_ENCRYPT_ROUNDS(x, key_hi, 32);
+    }
+    KEELOQ_ENCRYPT_ROUNDS(x, key_lo, 16);
     return x;
 }
 
@@ -28,13 +48,80 @@ inline uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const
  * @return 0xBSSSCCCC, B(4bit) key, S(10bit) serial&0x3FF, C(16bit) counter
  */
 inline uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64_t key) {
-    uint32_t x = data, r;
-    for(r = 0; r < 528; r++)
-        x = (x << 1) ^ bit(x, 31) ^ bit(x, 15) ^ (uint32_t)bit(key, (15 - r) & 63) ^
-            bit(KEELOQ_NLF, g5(x, 0, 8, 19, 25, 30));
+    const uint32_t key_lo = key;
+    const uint32_t key_hi = key >> 32;
+    uint32_t x = data;
+    // Backwards: key bits 15..0, then 8 passes over bits 63..0
+    KEELOQ_DECRYPT_ROUNDS(x, key_lo << 16, 16);
+    for(size_t pass = 0; pass < KEELOQ_ROUNDS / 64; pass++) {
+        KEELOQ_DECRYPT_ROUNDS(x, key_hi, 32);
+        KEELOQ_DECRYPT_ROUNDS(x, key_lo, 32);
+    }
     return x;
 }
 
+/* 32x32 bit matrix transpose, Hacker's Delight 7-3 */
+static void subghz_protocol_keeloq_common_transpose(uint32_t* a) {
+    uint32_t m = 0x0000FFFFU;
+    for(uint32_t j = 16; j != 0; j >>= 1, m ^= (m << j)) {
+        for(uint32_t k = 0; k < 32; k = (k + j + 1) & ~j) {
+            const uint32_t t = (a[k] ^ (a[k + j] >> j)) & m;
+            a[k] ^= t;
+            a[k + j] ^= t << j;
+        }
+    }
+}
+
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t data,
+    const uint64_t* keys,
+    uint32_t* output,
+    size_t count) {
+    furi_check(count <= KEELOQ_BATCH_SIZE);
+
+    // Bit sliced: word i holds bit i of every lane, lane l is bit 31 - l
+    uint32_t key[64];
+    uint32_t state[KEELOQ_BATCH_SIZE];
+
+    for(size_t half = 0; half < 2; half++) {
+        memset(state, 0, sizeof(state));
+        for(size_t l = 0; l < count; l++) {
+            state[l] = keys[l] >> (half * 32);
+        }
+        subghz_protocol_keeloq_common_transpose(state);
+        for(size_t i = 0; i < 32; i++) {
+            key[half * 32 + i] = state[31 - i];
+        }
+    }
+
+    for(size_t i = 0; i < 32; i++) {
+        state[i] = 0U - ((data >> i) & 1U);
+    }
+
+    // Shift is done by moving the origin, logical bit i lives in state[(origin + i) % 32]
+    uint32_t origin = 0;
+    for(uint32_t r = 0; r < KEELOQ_ROUNDS; r++) {
+        const uint32_t a = state[origin];
+        const uint32_t b = state[(origin + 8) & 31];
+        const uint32_t c = state[(origin + 19) & 31];
+        const uint32_t d = state[(origin + 25) & 31];
+        const uint32_t e = state[(origin + 30) & 31];
+        // KEELOQ_NLF in algebraic normal form
+        const uint32_t nlf = a ^ b ^ (a & b) ^ (b & c) ^ (d & (a ^ c)) ^
+                             (e & ((a & ~b) ^ (c & ~a) ^ (d & (b ^ c))));
+
+        origin = (origin + 31) & 31;
+        state[origin] ^= state[(origin + 16) & 31] ^ key[(15 - r) & 63] ^ nlf;
+    }
+
+    uint32_t result[KEELOQ_BATCH_SIZE];
+    for(size_t i = 0; i < 32; i++) {
+        result[31 - i] = state[(origin + i) & 31];
+    }
+    subghz_protocol_keeloq_common_transpose(result);
+    memcpy(output, result, count * sizeof(uint32_t));
+}
+
 /** Normal Learning
  * @param data - serial number (28bit)
  * @param key - manufacture (64bit)
@@ -10,7 +10,8 @@
  * https://phreakerclub.com/forum/showthread.php?t=1094
  *
  */
-#define KEELOQ_NLF 0x3A5C742E
+#define KEELOQ_NLF        0x3A5C742E
+#define KEELOQ_BATCH_SIZE 32
 
 /*
  * KeeLoq learning types
@@ -41,6 +42,20 @@ uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const uint64
  */
 uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64_t key);
 
+/** 
+ * Simple Learning Decrypt with several keys at once
+ * Bit sliced, 32 keys take about as long as two single decryptions
+ * @param data - keeloq encrypt data
+ * @param keys - manufacture keys (64bit), up to KEELOQ_BATCH_SIZE
+ * @param output - decrypted data for every key, same order
+ * @param count - number of keys
+ */
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t data,
+    const uint64_t* keys,
+    uint32_t* output,
+    size_t count);
+
 /** 
  * Normal Learning
  * @param data - serial number (28bit)
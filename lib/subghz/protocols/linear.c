@@ -53,6 +53,7 @@ const SubGhzProtocolDecoder subghz_protocol_linear_decoder = {
     .serialize = subghz_protocol_decoder_linear_serialize,
     .deserialize = subghz_protocol_decoder_linear_deserialize,
     .get_string = subghz_protocol_decoder_linear_get_string,
+    .get_idle_filter = subghz_protocol_decoder_linear_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_linear_encoder = {
@@ -293,6 +294,17 @@ void subghz_protocol_decoder_linear_feed(void* context, bool level, uint32_t dur
     }
 }
 
+void subghz_protocol_decoder_linear_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderLinear* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_linear_const.te_short * 42;
+    filter->delta = subghz_protocol_linear_const.te_delta * 20;
+}
+
 uint8_t subghz_protocol_decoder_linear_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderLinear* instance = context;
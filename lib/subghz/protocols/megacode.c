@@ -59,6 +59,7 @@ const SubGhzProtocolDecoder subghz_protocol_megacode_decoder = {
     .serialize = subghz_protocol_decoder_megacode_serialize,
     .deserialize = subghz_protocol_decoder_megacode_deserialize,
     .get_string = subghz_protocol_decoder_megacode_get_string,
+    .get_idle_filter = subghz_protocol_decoder_megacode_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_megacode_encoder = {
@@ -323,6 +324,17 @@ void subghz_protocol_decoder_megacode_feed(void* context, bool level, uint32_t d
     }
 }
 
+void subghz_protocol_decoder_megacode_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderMegaCode* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_megacode_const.te_short * 13;
+    filter->delta = subghz_protocol_megacode_const.te_delta * 17;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -48,6 +48,7 @@ const SubGhzProtocolDecoder subghz_protocol_nero_sketch_decoder = {
     .serialize = subghz_protocol_decoder_nero_sketch_serialize,
     .deserialize = subghz_protocol_decoder_nero_sketch_deserialize,
     .get_string = subghz_protocol_decoder_nero_sketch_get_string,
+    .get_idle_filter = subghz_protocol_decoder_nero_sketch_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nero_sketch_encoder = {
@@ -321,6 +322,17 @@ void subghz_protocol_decoder_nero_sketch_feed(void* context, bool level, uint32_
     }
 }
 
+void subghz_protocol_decoder_nero_sketch_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderNeroSketch* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = true;
+    filter->duration = subghz_protocol_nero_sketch_const.te_short;
+    filter->delta = subghz_protocol_nero_sketch_const.te_delta;
+}
+
 uint8_t subghz_protocol_decoder_nero_sketch_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderNeroSketch* instance = context;
@@ -46,6 +46,7 @@ const SubGhzProtocolDecoder subghz_protocol_nice_flo_decoder = {
     .serialize = subghz_protocol_decoder_nice_flo_serialize,
     .deserialize = subghz_protocol_decoder_nice_flo_deserialize,
     .get_string = subghz_protocol_decoder_nice_flo_get_string,
+    .get_idle_filter = subghz_protocol_decoder_nice_flo_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nice_flo_encoder = {
@@ -276,6 +277,17 @@ void subghz_protocol_decoder_nice_flo_feed(void* context, bool level, uint32_t d
     }
 }
 
+void subghz_protocol_decoder_nice_flo_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderNiceFlo* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_nice_flo_const.te_short * 36;
+    filter->delta = subghz_protocol_nice_flo_const.te_delta * 36;
+}
+
 uint8_t subghz_protocol_decoder_nice_flo_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderNiceFlo* instance = context;
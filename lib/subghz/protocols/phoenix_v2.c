@@ -49,6 +49,7 @@ const SubGhzProtocolDecoder subghz_protocol_phoenix_v2_decoder = {
     .serialize = subghz_protocol_decoder_phoenix_v2_serialize,
     .deserialize = subghz_protocol_decoder_phoenix_v2_deserialize,
     .get_string = subghz_protocol_decoder_phoenix_v2_get_string,
+    .get_idle_filter = subghz_protocol_decoder_phoenix_v2_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_phoenix_v2_encoder = {
@@ -274,6 +275,17 @@ void subghz_protocol_decoder_phoenix_v2_feed(void* context, bool level, uint32_t
     }
 }
 
+void subghz_protocol_decoder_phoenix_v2_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderPhoenix_V2* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_phoenix_v2_const.te_short * 60;
+    filter->delta = subghz_protocol_phoenix_v2_const.te_delta * 30;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
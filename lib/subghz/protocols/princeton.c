@@ -62,6 +62,7 @@ const SubGhzProtocolDecoder subghz_protocol_princeton_decoder = {
     .serialize = subghz_protocol_decoder_princeton_serialize,
     .deserialize = subghz_protocol_decoder_princeton_deserialize,
     .get_string = subghz_protocol_decoder_princeton_get_string,
+    .get_idle_filter = subghz_protocol_decoder_princeton_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_princeton_encoder = {
@@ -84,6 +85,33 @@ const SubGhzProtocol subghz_protocol_princeton = {
     .encoder = &subghz_protocol_princeton_encoder,
 };
 
+/**
+ * Generating a frame from data, one LevelDuration at a time.
+ * @param context Pointer to a SubGhzProtocolEncoderPrinceton instance
+ * @param index Position in the frame
+ * @return LevelDuration, reset past the end of the frame
+ */
+static LevelDuration subghz_protocol_encoder_princeton_generate(void* context, size_t index) {
+    SubGhzProtocolEncoderPrinceton* instance = context;
+    const size_t size_data = instance->generic.data_count_bit * 2;
+
+    if(index < size_data) {
+        //Send key data: bit 1 is 3*te high and te low, bit 0 is the other way round
+        const bool bit =
+            bit_read(instance->generic.data, instance->generic.data_count_bit - 1 - index / 2);
+        const bool level = !(index & 1);
+        return level_duration_make(level, (uint32_t)instance->te * ((bit == level) ? 3 : 1));
+    } else if(index == size_data) {
+        //Send Stop bit
+        return level_duration_make(true, (uint32_t)instance->te);
+    } else if(index == size_data + 1) {
+        //Send PT_GUARD_TIME
+        return level_duration_make(false, (uint32_t)instance->te * instance->guard_time);
+    }
+
+    return level_duration_reset();
+}
+
 void* subghz_protocol_encoder_princeton_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolEncoderPrinceton* instance = malloc(sizeof(SubGhzProtocolEncoderPrinceton));
@@ -92,8 +120,7 @@ void* subghz_protocol_encoder_princeton_alloc(SubGhzEnvironment* environment) {
     instance->generic.protocol_name = instance->base.protocol->name;
 
     instance->encoder.repeat = 10;
-    instance->encoder.size_upload = 52; //max 24bit*2 + 2 (start, stop)
-    instance->encoder.upload = malloc(instance->encoder.size_upload * sizeof(LevelDuration));
+    instance->encoder.generator = subghz_protocol_encoder_princeton_generate;
     instance->encoder.is_running = false;
     return instance;
 }
@@ -101,52 +128,9 @@ void* subghz_protocol_encoder_princeton_alloc(SubGhzEnvironment* environment) {
 void subghz_protocol_encoder_princeton_free(void* context) {
     furi_assert(context);
     SubGhzProtocolEncoderPrinceton* instance = context;
-    free(instance->encoder.upload);
     free(instance);
 }
 
-/**
- * Generating an upload from data.
- * @param instance Pointer to a SubGhzProtocolEncoderPrinceton instance
- * @return true On success
- */
-static bool
-    subghz_protocol_encoder_princeton_get_upload(SubGhzProtocolEncoderPrinceton* instance) {
-    furi_assert(instance);
-
-    size_t index = 0;
-    size_t size_upload = (instance->generic.data_count_bit * 2) + 2;
-    if(size_upload > instance->encoder.size_upload) {
-        FURI_LOG_E(TAG, "Size upload exceeds allocated encoder buffer.");
-        return false;
-    } else {
-        instance->encoder.size_upload = size_upload;
-    }
-
-    //Send key data
-    for(uint8_t i = instance->generic.data_count_bit; i > 0; i--) {
-        if(bit_read(instance->generic.data, i - 1)) {
-            //send bit 1
-            instance->encoder.upload[index++] =
-                level_duration_make(true, (uint32_t)instance->te * 3);
-            instance->encoder.upload[index++] = level_duration_make(false, (uint32_t)instance->te);
-        } else {
-            //send bit 0
-            instance->encoder.upload[index++] = level_duration_make(true, (uint32_t)instance->te);
-            instance->encoder.upload[index++] =
-                level_duration_make(false, (uint32_t)instance->te * 3);
-        }
-    }
-
-    //Send Stop bit
-    instance->encoder.upload[index++] = level_duration_make(true, (uint32_t)instance->te);
-    //Send PT_GUARD_TIME
-    instance->encoder.upload[index++] =
-        level_duration_make(false, (uint32_t)instance->te * instance->guard_time);
-
-    return true;
-}
-
 SubGhzProtocolStatus
     subghz_protocol_encoder_princeton_deserialize(void* context, FlipperFormat* flipper_format) {
     furi_assert(context);
@@ -184,10 +168,7 @@ SubGhzProtocolStatus
         flipper_format_read_uint32(
             flipper_format, "Repeat", (uint32_t*)&instance->encoder.repeat, 1);
 
-        if(!subghz_protocol_encoder_princeton_get_upload(instance)) {
-            ret = SubGhzProtocolStatusErrorEncoderGetUpload;
-            break;
-        }
+        instance->encoder.front = 0;
         instance->encoder.is_running = true;
     } while(false);
 
@@ -201,20 +182,7 @@ void subghz_protocol_encoder_princeton_stop(void* context) {
 
 LevelDuration subghz_protocol_encoder_princeton_yield(void* context) {
     SubGhzProtocolEncoderPrinceton* instance = context;
-
-    if(instance->encoder.repeat == 0 || !instance->encoder.is_running) {
-        instance->encoder.is_running = false;
-        return level_duration_reset();
-    }
-
-    LevelDuration ret = instance->encoder.upload[instance->encoder.front];
-
-    if(++instance->encoder.front == instance->encoder.size_upload) {
-        instance->encoder.repeat--;
-        instance->encoder.front = 0;
-    }
-
-    return ret;
+    return subghz_protocol_blocks_encoder_yield(&instance->encoder, instance);
 }
 
 void* subghz_protocol_decoder_princeton_alloc(SubGhzEnvironment* environment) {
@@ -316,6 +284,17 @@ void subghz_protocol_decoder_princeton_feed(void* context, bool level, uint32_t
     }
 }
 
+void subghz_protocol_decoder_princeton_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderPrinceton* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_princeton_const.te_short * 36;
+    filter->delta = subghz_protocol_princeton_const.te_delta * 36;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
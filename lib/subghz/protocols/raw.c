@@ -7,11 +7,15 @@
 
 #include <flipper_format/flipper_format_i.h>
 #include <lib/toolbox/stream/stream.h>
+#include <lib/toolbox/stream/file_stream.h>
 
 #define TAG "SubGhzProtocolRaw"
 
 #define SUBGHZ_DOWNLOAD_MAX_SIZE 512
 
+// Contiguous space reserved for a recording, FAT isn't updated while it's filled
+#define SUBGHZ_RAW_FILE_PREALLOCATE_SIZE (64 * 1024)
+
 static const SubGhzBlockConst subghz_protocol_raw_const = {
     .te_short = 50,
     .te_long = 32700,
@@ -120,6 +124,11 @@ bool subghz_protocol_raw_save_to_file_init(
             break;
         }
 
+        // Optional, recording can be written without it
+        file_stream_preallocate(
+            flipper_format_get_raw_stream(instance->flipper_file),
+            SUBGHZ_RAW_FILE_PREALLOCATE_SIZE);
+
         if(!flipper_format_write_header_cstr(
                instance->flipper_file, SUBGHZ_RAW_FILE_TYPE, SUBGHZ_RAW_FILE_VERSION)) {
             FURI_LOG_E(TAG, "Unable to add header");
@@ -156,7 +165,8 @@ bool subghz_protocol_raw_save_to_file_init(
             break;
         }
 
-        instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
+        // Capture buffers live for the whole recording, keep them off the main heap
+        instance->upload_raw = memmgr_alloc_from_pool(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
         instance->file_is_open = RAWFileIsOpenWrite;
         instance->sample_write = 0;
         instance->last_level = false;
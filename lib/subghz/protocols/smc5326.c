@@ -72,6 +72,7 @@ const SubGhzProtocolDecoder subghz_protocol_smc5326_decoder = {
     .serialize = subghz_protocol_decoder_smc5326_serialize,
     .deserialize = subghz_protocol_decoder_smc5326_deserialize,
     .get_string = subghz_protocol_decoder_smc5326_get_string,
+    .get_idle_filter = subghz_protocol_decoder_smc5326_get_idle_filter,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_smc5326_encoder = {
@@ -308,6 +309,17 @@ void subghz_protocol_decoder_smc5326_feed(void* context, bool level, uint32_t du
     }
 }
 
+void subghz_protocol_decoder_smc5326_get_idle_filter(
+    void* context,
+    SubGhzProtocolDecoderIdleFilter* filter) {
+    furi_assert(context);
+    SubGhzProtocolDecoderSMC5326* instance = context;
+    filter->parser_step = &instance->decoder.parser_step;
+    filter->level = false;
+    filter->duration = subghz_protocol_smc5326_const.te_short * 24;
+    filter->delta = subghz_protocol_smc5326_const.te_delta * 12;
+}
+
 uint8_t subghz_protocol_decoder_smc5326_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderSMC5326* instance = context;
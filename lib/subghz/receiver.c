@@ -1,11 +1,14 @@
 #include "receiver.h"
 
 #include "registry.h"
+#include "blocks/math.h"
 
 #include <m-array.h>
 
 typedef struct {
     SubGhzProtocolEncoderBase* base;
+    bool enabled;
+    SubGhzProtocolDecoderIdleFilter idle;
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
@@ -32,6 +35,11 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
         if(protocol->decoder && protocol->decoder->alloc) {
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
             slot->base = protocol->decoder->alloc(environment);
+            slot->enabled = false;
+            slot->idle.parser_step = NULL;
+            if(protocol->decoder->get_idle_filter) {
+                protocol->decoder->get_idle_filter(slot->base, &slot->idle);
+            }
         }
     }
 
@@ -63,8 +71,43 @@ void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t durat
 
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
+            if(!slot->enabled) continue;
+            // Idle decoder can't leave reset step on this pulse, don't bother calling it
+            if(slot->idle.parser_step && *slot->idle.parser_step == 0 &&
+               (level != slot->idle.level ||
+                DURATION_DIFF(duration, slot->idle.duration) >= slot->idle.delta)) {
+                continue;
+            }
+            slot->base->protocol->decoder->feed(slot->base, level, duration);
+        }
+}
+
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* pulses,
+    size_t count) {
+    furi_check(instance);
+    furi_check(pulses || !count);
+
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if(!slot->enabled) continue;
+            if(!slot->idle.parser_step) {
+                subghz_protocol_decoder_base_feed_batch(
+                    (SubGhzProtocolDecoderBase*)slot->base, pulses, count);
+                continue;
+            }
+            // Per pulse, so the idle window check follows decoder state
+            SubGhzDecoderFeed feed = slot->base->protocol->decoder->feed;
+            for(size_t i = 0; i < count; i++) {
+                bool level = level_duration_get_level(pulses[i]);
+                uint32_t duration = level_duration_get_duration(pulses[i]);
+                if(*slot->idle.parser_step == 0 &&
+                   (level != slot->idle.level ||
+                    DURATION_DIFF(duration, slot->idle.duration) >= slot->idle.delta)) {
+                    continue;
+                }
+                feed(slot->base, level, duration);
             }
         }
 }
@@ -105,6 +148,11 @@ void subghz_receiver_set_rx_callback(
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter) {
     furi_check(instance);
     instance->filter = filter;
+
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            slot->enabled = (slot->base->protocol->flag & filter) != 0;
+        }
 }
 
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
@@ -35,6 +35,19 @@ void subghz_receiver_free(SubGhzReceiver* instance);
  */
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration);
 
+/**
+ * Parse a batch of levels and durations received from the air.
+ * Each decoder gets the whole batch in one go, so decoding callbacks of
+ * different protocols may come in a different order than with subghz_receiver_decode.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param pulses Pointer to an array of LevelDuration, reset and wait entries are not allowed
+ * @param count Number of pulses in the array
+ */
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* pulses,
+    size_t count);
+
 /**
  * Reset decoder SubGhzReceiver.
  * @param instance Pointer to a SubGhzReceiver instance
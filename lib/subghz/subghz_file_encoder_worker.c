@@ -4,24 +4,43 @@
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
-#include <lib/toolbox/strint.h>
 
 #define TAG "SubGhzFileEncoderWorker"
 
-#define SUBGHZ_FILE_ENCODER_LOAD 512
+#define SUBGHZ_FILE_ENCODER_BUFFER_SIZE 1024 ///< Samples per playback buffer
+
+#define SUBGHZ_FILE_ENCODER_BLOCK_SIZE 512 ///< Samples parsed from a RAW_Data line at once
+
+#define SUBGHZ_FILE_ENCODER_CACHE_SIZE 4096 ///< Read-ahead for sequential playback
+
+#define SUBGHZ_FILE_ENCODER_WORKER_FLAG_REFILL (1UL << 0)
+
+typedef struct {
+    int32_t* data;
+    size_t size;
+    bool ready; ///< Owned by reader if true, by worker thread otherwise
+} SubGhzFileEncoderWorkerBuffer;
 
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
-    FuriStreamBuffer* stream;
+
+    // Ping-pong playback buffers, filled ahead by the worker thread
+    SubGhzFileEncoderWorkerBuffer buffer[2];
+    volatile uint8_t read_index;
+    size_t read_pos;
+    volatile uint32_t underrun_count;
 
     Storage* storage;
     FlipperFormat* flipper_format;
 
     volatile bool worker_running;
     volatile bool worker_stoping;
-    bool is_storage_slow;
     FuriString* str_data;
     FuriString* file_path;
+    bool line_started;
+    int32_t* block_samples;
+    size_t block_count;
+    size_t block_pos;
     const SubGhzDevice* device;
 
     SubGhzFileEncoderWorkerCallbackEnd callback_end;
@@ -38,43 +57,78 @@ void subghz_file_encoder_worker_callback_end(
     instance->context_end = context_end;
 }
 
-void subghz_file_encoder_worker_add_level_duration(
-    SubGhzFileEncoderWorker* instance,
-    int32_t duration) {
-    size_t ret = furi_stream_buffer_send(instance->stream, &duration, sizeof(int32_t), 100);
-    if(sizeof(int32_t) != ret) FURI_LOG_E(TAG, "Invalid add duration in the stream");
-}
-
-bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
-    // Line sample: "RAW_Data: -1, 2, -2..."
-
-    // Look for the key in the line
-    char* str = strstr(strStart, "RAW_Data: ");
-    bool res = false;
+static bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance) {
+    // Line sample: "RAW_Data: -1 2 -2...", long lines are read over several calls
+    instance->block_count = 0;
+    instance->block_pos = 0;
+    while(instance->block_count == 0) {
+        if(!instance->line_started) {
+            if(!flipper_format_read_array_start(instance->flipper_format, "RAW_Data")) {
+                return false;
+            }
+            instance->line_started = true;
+        }
+        if(!flipper_format_read_array_int32(
+               instance->flipper_format,
+               instance->block_samples,
+               SUBGHZ_FILE_ENCODER_BLOCK_SIZE,
+               &instance->block_count)) {
+            return false;
+        }
+        // Line is over, continue with the next one
+        if(instance->block_count == 0) instance->line_started = false;
+    }
 
-    if(str) {
-        // Skip key
-        str = strchr(str, ' ');
+    return true;
+}
 
-        // Parse next element
-        int32_t duration;
-        while(strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
-            subghz_file_encoder_worker_add_level_duration(instance, duration);
-            if(*str == ',') str++; // could also be `\0`
+/** Fill playback buffer from the file
+ * 
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @param buffer Buffer to fill
+ * @return true if there is more data, false if the end mark was added
+ */
+static bool subghz_file_encoder_worker_buffer_fill(
+    SubGhzFileEncoderWorker* instance,
+    SubGhzFileEncoderWorkerBuffer* buffer) {
+    buffer->size = 0;
+    while(buffer->size < SUBGHZ_FILE_ENCODER_BUFFER_SIZE) {
+        if(instance->block_pos == instance->block_count) {
+            if(!subghz_file_encoder_worker_data_parse(instance)) {
+                buffer->data[buffer->size++] = LEVEL_DURATION_RESET;
+                return false;
+            }
+            continue;
         }
-
-        res = true;
+        size_t count = MIN(
+            instance->block_count - instance->block_pos,
+            SUBGHZ_FILE_ENCODER_BUFFER_SIZE - buffer->size);
+        memcpy(
+            &buffer->data[buffer->size],
+            &instance->block_samples[instance->block_pos],
+            count * sizeof(int32_t));
+        buffer->size += count;
+        instance->block_pos += count;
     }
-
-    return res;
+    return true;
 }
 
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
     furi_assert(context);
     SubGhzFileEncoderWorker* instance = context;
-    int32_t duration;
-    int ret = furi_stream_buffer_receive(instance->stream, &duration, sizeof(int32_t), 0);
-    if(ret == sizeof(int32_t)) {
+    SubGhzFileEncoderWorkerBuffer* buffer = &instance->buffer[instance->read_index];
+    // Acquire pairs with worker release, buffer content is visible once ready is
+    if(__atomic_load_n(&buffer->ready, __ATOMIC_ACQUIRE)) {
+        int32_t duration = buffer->data[instance->read_pos++];
+        if(instance->read_pos == buffer->size) {
+            // Hand the buffer back to the worker and switch to the other one
+            instance->read_pos = 0;
+            __atomic_store_n(&buffer->ready, false, __ATOMIC_RELEASE);
+            instance->read_index ^= 1;
+            furi_thread_flags_set(
+                furi_thread_get_id(instance->thread), SUBGHZ_FILE_ENCODER_WORKER_FLAG_REFILL);
+        }
+
         LevelDuration level_duration = {.level = LEVEL_DURATION_RESET};
         if(duration < 0) {
             level_duration = level_duration_make(false, -duration);
@@ -87,11 +141,16 @@ LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
         }
         return level_duration;
     } else {
-        instance->is_storage_slow = true;
+        if(!instance->worker_stoping) instance->underrun_count++;
         return level_duration_wait();
     }
 }
 
+uint32_t subghz_file_encoder_worker_get_underrun_count(SubGhzFileEncoderWorker* instance) {
+    furi_assert(instance);
+    return instance->underrun_count;
+}
+
 /** Worker thread
  * 
  * @param context 
@@ -101,10 +160,9 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     SubGhzFileEncoderWorker* instance = context;
     FURI_LOG_I(TAG, "Worker start");
     bool res = false;
-    instance->is_storage_slow = false;
     Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
     do {
-        if(!flipper_format_file_open_existing(
+        if(!flipper_format_buffered_file_open_existing(
                instance->flipper_format, furi_string_get_cstr(instance->file_path))) {
             FURI_LOG_E(
                 TAG,
@@ -119,32 +177,27 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
 
         //skip the end of the previous line "\n"
         stream_seek(stream, 1, StreamOffsetFromCurrent);
+        instance->block_samples = malloc(SUBGHZ_FILE_ENCODER_BLOCK_SIZE * sizeof(int32_t));
         res = true;
         instance->worker_stoping = false;
         FURI_LOG_I(TAG, "Start transmission");
     } while(0);
 
+    uint8_t fill_index = 0;
     while(res && instance->worker_running) {
-        size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
-        if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
-                furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
-                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                    break;
-                }
-            } else {
-                subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                break;
-            }
-        } else {
-            furi_delay_ms(1);
+        SubGhzFileEncoderWorkerBuffer* buffer = &instance->buffer[fill_index];
+        if(__atomic_load_n(&buffer->ready, __ATOMIC_ACQUIRE)) {
+            furi_thread_flags_wait(SUBGHZ_FILE_ENCODER_WORKER_FLAG_REFILL, FuriFlagWaitAny, 10);
+            continue;
         }
+        bool is_more = subghz_file_encoder_worker_buffer_fill(instance, buffer);
+        __atomic_store_n(&buffer->ready, true, __ATOMIC_RELEASE);
+        fill_index ^= 1;
+        if(!is_more) break;
     }
     //waiting for the end of the transfer
-    if(instance->is_storage_slow) {
-        FURI_LOG_E(TAG, "Storage is slow");
+    if(instance->underrun_count) {
+        FURI_LOG_E(TAG, "Storage is slow, %lu underruns", instance->underrun_count);
     }
 
     FURI_LOG_I(TAG, "End read file");
@@ -160,7 +213,11 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
         }
         furi_delay_ms(50);
     }
-    flipper_format_file_close(instance->flipper_format);
+    flipper_format_buffered_file_close(instance->flipper_format);
+    if(instance->block_samples) {
+        free(instance->block_samples);
+        instance->block_samples = NULL;
+    }
 
     FURI_LOG_I(TAG, "Worker stop");
     return 0;
@@ -171,10 +228,13 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
 
     instance->thread =
         furi_thread_alloc_ex("SubGhzFEWorker", 2048, subghz_file_encoder_worker_thread, instance);
-    instance->stream = furi_stream_buffer_alloc(sizeof(int32_t) * 2048, sizeof(int32_t));
+    for(size_t i = 0; i < COUNT_OF(instance->buffer); i++) {
+        instance->buffer[i].data = malloc(sizeof(int32_t) * SUBGHZ_FILE_ENCODER_BUFFER_SIZE);
+    }
 
     instance->storage = furi_record_open(RECORD_STORAGE);
-    instance->flipper_format = flipper_format_file_alloc(instance->storage);
+    instance->flipper_format =
+        flipper_format_buffered_file_alloc_ex(instance->storage, SUBGHZ_FILE_ENCODER_CACHE_SIZE);
 
     instance->str_data = furi_string_alloc();
     instance->file_path = furi_string_alloc();
@@ -186,7 +246,9 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
 void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
     furi_assert(instance);
 
-    furi_stream_buffer_free(instance->stream);
+    for(size_t i = 0; i < COUNT_OF(instance->buffer); i++) {
+        free(instance->buffer[i].data);
+    }
     furi_thread_free(instance->thread);
 
     furi_string_free(instance->str_data);
@@ -205,7 +267,16 @@ bool subghz_file_encoder_worker_start(
     furi_assert(instance);
     furi_assert(!instance->worker_running);
 
-    furi_stream_buffer_reset(instance->stream);
+    for(size_t i = 0; i < COUNT_OF(instance->buffer); i++) {
+        instance->buffer[i].size = 0;
+        instance->buffer[i].ready = false;
+    }
+    instance->read_index = 0;
+    instance->read_pos = 0;
+    instance->underrun_count = 0;
+    instance->line_started = false;
+    instance->block_count = 0;
+    instance->block_pos = 0;
     furi_string_set(instance->file_path, file_path);
     if(radio_device_name) {
         instance->device = subghz_devices_get_by_name(radio_device_name);
@@ -39,6 +39,14 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance);
  */
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context);
 
+/**
+ * Get the number of times playback data was requested before the worker had it ready.
+ * Reset on start.
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @return uint32_t underrun count
+ */
+uint32_t subghz_file_encoder_worker_get_underrun_count(SubGhzFileEncoderWorker* instance);
+
 /** 
  * Start SubGhzFileEncoderWorker.
  * @param instance Pointer to a SubGhzFileEncoderWorker instance
@@ -12,6 +12,9 @@
 #define TAG "SubGhzKeystore"
 
 #define FILE_BUFFER_SIZE 64
+#define FILE_READ_SIZE   512
+
+#define SUBGHZ_KEYSTORE_NAMES_CHUNK_SIZE 512
 
 #define SUBGHZ_KEYSTORE_FILE_TYPE     "Flipper SubGhz Keystore File"
 #define SUBGHZ_KEYSTORE_FILE_RAW_TYPE "Flipper SubGhz Keystore RAW File"
@@ -26,8 +29,17 @@ typedef enum {
     SubGhzKeystoreEncryptionAES256,
 } SubGhzKeystoreEncryption;
 
+// Names are packed back to back, chunks are never moved so pointers stay valid
+typedef struct SubGhzKeystoreNames {
+    struct SubGhzKeystoreNames* next;
+    size_t used;
+    char data[SUBGHZ_KEYSTORE_NAMES_CHUNK_SIZE];
+} SubGhzKeystoreNames;
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
+    SubGhzKeystoreNames* names;
+    const SubGhzKey** index; // Keys ordered by name, built on first lookup
 };
 
 SubGhzKeystore* subghz_keystore_alloc(void) {
@@ -43,21 +55,58 @@ void subghz_keystore_free(SubGhzKeystore* instance) {
 
     for
         M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
-            furi_string_free(manufacture_code->name);
             manufacture_code->key = 0;
         }
     SubGhzKeyArray_clear(instance->data);
 
+    while(instance->names) {
+        SubGhzKeystoreNames* next = instance->names->next;
+        free(instance->names);
+        instance->names = next;
+    }
+    free(instance->index);
+
     free(instance);
 }
 
+static const char* subghz_keystore_add_name(SubGhzKeystore* instance, const char* name) {
+    // Vendors with several keys usually come in a row
+    const size_t count = SubGhzKeyArray_size(instance->data);
+    if(count) {
+        const char* last = SubGhzKeyArray_cget(instance->data, count - 1)->name;
+        if(strcmp(last, name) == 0) return last;
+    }
+
+    const size_t size = strlen(name) + 1;
+    furi_check(size <= SUBGHZ_KEYSTORE_NAMES_CHUNK_SIZE);
+
+    SubGhzKeystoreNames* names = instance->names;
+    if(!names || names->used + size > SUBGHZ_KEYSTORE_NAMES_CHUNK_SIZE) {
+        names = malloc(sizeof(SubGhzKeystoreNames));
+        names->next = instance->names;
+        instance->names = names;
+    }
+
+    char* name_copy = &names->data[names->used];
+    memcpy(name_copy, name, size);
+    names->used += size;
+
+    return name_copy;
+}
+
 static void subghz_keystore_add_key(
     SubGhzKeystore* instance,
     const char* name,
     uint64_t key,
     uint16_t type) {
+    // Array may move, index gets rebuilt on next lookup
+    free(instance->index);
+    instance->index = NULL;
+
+    const char* name_copy = subghz_keystore_add_name(instance, name);
+
     SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
-    manufacture_code->name = furi_string_alloc_set(name);
+    manufacture_code->name = name_copy;
     manufacture_code->key = key;
     manufacture_code->type = type;
 }
@@ -106,13 +155,99 @@ static void subghz_keystore_mess_with_iv(uint8_t* iv) {
                  : "r0", "r1", "r2", "r3", "memory");
 }
 
+typedef struct {
+    FuriSemaphore* done;
+    bool success;
+    bool pending;
+    size_t index; // Decrypted line buffer in use by the engine
+    uint8_t* encrypted;
+    char* decrypted[2];
+} SubGhzKeystoreDecryptor;
+
+static SubGhzKeystoreDecryptor* subghz_keystore_decryptor_alloc(void) {
+    SubGhzKeystoreDecryptor* decryptor = malloc(sizeof(SubGhzKeystoreDecryptor));
+    decryptor->done = furi_semaphore_alloc(1, 0);
+    decryptor->encrypted = malloc(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
+    for(size_t i = 0; i < COUNT_OF(decryptor->decrypted); i++) {
+        decryptor->decrypted[i] = malloc(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE + 1);
+    }
+    return decryptor;
+}
+
+static void subghz_keystore_decryptor_free(SubGhzKeystoreDecryptor* decryptor) {
+    for(size_t i = 0; i < COUNT_OF(decryptor->decrypted); i++) {
+        free(decryptor->decrypted[i]);
+    }
+    free(decryptor->encrypted);
+    furi_semaphore_free(decryptor->done);
+    free(decryptor);
+}
+
+static void subghz_keystore_decryptor_callback(bool success, void* context) {
+    SubGhzKeystoreDecryptor* decryptor = context;
+    decryptor->success = success;
+    furi_semaphore_release(decryptor->done);
+}
+
+static bool subghz_keystore_decryptor_wait(SubGhzKeystoreDecryptor* decryptor) {
+    if(!decryptor->pending) return true;
+
+    furi_check(furi_semaphore_acquire(decryptor->done, FuriWaitForever) == FuriStatusOk);
+    decryptor->pending = false;
+
+    if(!decryptor->success) FURI_LOG_E(TAG, "Decryption failed");
+    return decryptor->success;
+}
+
+static bool subghz_keystore_decryptor_push(
+    SubGhzKeystoreDecryptor* decryptor,
+    SubGhzKeystore* instance,
+    const uint8_t* data,
+    size_t len) {
+    const bool ready = decryptor->pending;
+    if(!subghz_keystore_decryptor_wait(decryptor)) return false;
+
+    decryptor->index ^= 1;
+    char* decrypted_line = decryptor->decrypted[decryptor->index];
+    decrypted_line[len] = '\0';
+    memcpy(decryptor->encrypted, data, len);
+
+    decryptor->pending = true;
+    if(!furi_hal_crypto_decrypt_async(
+           decryptor->encrypted,
+           (uint8_t*)decrypted_line,
+           len,
+           subghz_keystore_decryptor_callback,
+           decryptor)) {
+        // DMA is taken, fall back to CPU
+        subghz_keystore_decryptor_callback(
+            furi_hal_crypto_decrypt(decryptor->encrypted, (uint8_t*)decrypted_line, len),
+            decryptor);
+    }
+
+    // Previous line is parsed while this one is being decrypted
+    if(ready) subghz_keystore_process_line(instance, decryptor->decrypted[decryptor->index ^ 1]);
+
+    return true;
+}
+
+static bool
+    subghz_keystore_decryptor_flush(SubGhzKeystoreDecryptor* decryptor, SubGhzKeystore* instance) {
+    const bool ready = decryptor->pending;
+    if(!subghz_keystore_decryptor_wait(decryptor)) return false;
+
+    if(ready) subghz_keystore_process_line(instance, decryptor->decrypted[decryptor->index]);
+
+    return true;
+}
+
 static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream, uint8_t* iv) {
     bool result = true;
-    uint8_t buffer[FILE_BUFFER_SIZE];
+    uint8_t* buffer = malloc(FILE_READ_SIZE);
 
-    char* decrypted_line = malloc(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
     char* encrypted_line = malloc(SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE);
     size_t encrypted_line_cursor = 0;
+    SubGhzKeystoreDecryptor* decryptor = iv ? subghz_keystore_decryptor_alloc() : NULL;
 
     do {
         if(iv) {
@@ -124,7 +259,7 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
 
         size_t ret = 0;
         do {
-            ret = stream_read(stream, buffer, FILE_BUFFER_SIZE);
+            ret = stream_read(stream, buffer, FILE_READ_SIZE);
             for(uint16_t i = 0; i < ret; i++) {
                 if(buffer[i] == '\n' && encrypted_line_cursor > 0) {
                     // Process line
@@ -142,11 +277,8 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
                             }
                             len /= 2;
 
-                            if(furi_hal_crypto_decrypt(
-                                   (uint8_t*)encrypted_line, (uint8_t*)decrypted_line, len)) {
-                                subghz_keystore_process_line(instance, decrypted_line);
-                            } else {
-                                FURI_LOG_E(TAG, "Decryption failed");
+                            if(!subghz_keystore_decryptor_push(
+                                   decryptor, instance, (uint8_t*)encrypted_line, len)) {
                                 result = false;
                                 break;
                             }
@@ -157,7 +289,6 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
                         subghz_keystore_process_line(instance, encrypted_line);
                     }
                     // reset line buffer
-                    memset(decrypted_line, 0, SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
                     memset(encrypted_line, 0, SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE);
                     encrypted_line_cursor = 0;
                 } else if(buffer[i] == '\r' || buffer[i] == '\n') {
@@ -175,11 +306,20 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
             }
         } while(ret > 0 && result);
 
-        if(iv) furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+        if(iv) {
+            // Engine must be done with the last line before the key goes away
+            if(result) {
+                result = subghz_keystore_decryptor_flush(decryptor, instance);
+            } else {
+                subghz_keystore_decryptor_wait(decryptor);
+            }
+            furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+        }
     } while(false);
 
+    if(decryptor) subghz_keystore_decryptor_free(decryptor);
     free(encrypted_line);
-    free(decrypted_line);
+    free(buffer);
 
     return result;
 }
@@ -294,7 +434,7 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
                     (uint32_t)(key->key >> 32),
                     (uint32_t)key->key,
                     key->type,
-                    furi_string_get_cstr(key->name));
+                    key->name);
                 // Verify length and align
                 furi_assert(len > 0);
                 if(len % 16 != 0) {
@@ -343,6 +483,50 @@ SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
     return &instance->data;
 }
 
+static int subghz_keystore_index_cmp(const void* a, const void* b) {
+    const SubGhzKey* key_a = *(const SubGhzKey**)a;
+    const SubGhzKey* key_b = *(const SubGhzKey**)b;
+    const int ret = strcmp(key_a->name, key_b->name);
+    if(ret) return ret;
+
+    // Same name, keep file order
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+const SubGhzKey* subghz_keystore_find(SubGhzKeystore* instance, const char* name) {
+    furi_assert(instance);
+    furi_assert(name);
+
+    const size_t count = SubGhzKeyArray_size(instance->data);
+    if(!count) return NULL;
+
+    if(!instance->index) {
+        instance->index = malloc(count * sizeof(const SubGhzKey*));
+        for(size_t i = 0; i < count; i++) {
+            instance->index[i] = SubGhzKeyArray_cget(instance->data, i);
+        }
+        qsort(instance->index, count, sizeof(const SubGhzKey*), subghz_keystore_index_cmp);
+    }
+
+    // Lower bound, so the first key in file order wins
+    size_t low = 0;
+    size_t high = count;
+    while(low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if(strcmp(instance->index[mid]->name, name) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if(low < count && strcmp(instance->index[low]->name, name) == 0) {
+        return instance->index[low];
+    }
+
+    return NULL;
+}
+
 bool subghz_keystore_raw_encrypted_save(
     const char* input_file_name,
     const char* output_file_name,
@@ -9,8 +9,8 @@ extern "C" {
 #endif
 
 typedef struct {
-    FuriString* name;
     uint64_t key;
+    const char* name; /**< Owned by keystore, valid until it is freed */
     uint16_t type;
 } SubGhzKey;
 
@@ -54,6 +54,14 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_
  */
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance);
 
+/** 
+ * Find manufacture key by name
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param name Manufacture name
+ * @return const SubGhzKey* first key with this name in file order, NULL if not found
+ */
+const SubGhzKey* subghz_keystore_find(SubGhzKeystore* instance, const char* name);
+
 /** 
  * Save RAW encrypted to file
  * @param input_file_name Full path to the input file
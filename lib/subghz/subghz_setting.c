@@ -3,6 +3,8 @@
 
 #include <furi.h>
 #include <m-list.h>
+#include <storage/storage.h>
+#include <toolbox/crc32_calc.h>
 #include <lib/subghz/devices/cc1101_configs.h>
 
 #define TAG "SubGhzSetting"
@@ -13,6 +15,41 @@
 #define FREQUENCY_FLAG_DEFAULT (1 << 31)
 #define FREQUENCY_MASK         (0xFFFFFFFF ^ FREQUENCY_FLAG_DEFAULT)
 
+/* Parsed setting file: header, frequencies, hopper frequencies, then presets,
+ * each as name size, data size, name and data. Stored next to the source. */
+#define SUBGHZ_SETTING_CACHE_EXTENSION ".cache"
+#define SUBGHZ_SETTING_CACHE_MAGIC     (0x31534753UL) // "SGS1"
+#define SUBGHZ_SETTING_CACHE_VERSION   (1)
+#define SUBGHZ_SETTING_CACHE_SIZE_MAX  (16 * 1024)
+
+#define SUBGHZ_SETTING_CACHE_FLAG_STANDARD_FREQUENCIES (1 << 0)
+#define SUBGHZ_SETTING_CACHE_FLAG_DEFAULT_FREQUENCY    (1 << 1)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t flags;
+    uint16_t preset_count;
+    uint16_t frequency_count;
+    uint16_t hopper_frequency_count;
+    uint32_t default_frequency;
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t payload_size;
+    uint32_t crc;
+} FURI_PACKED SubGhzSettingCacheHeader;
+
+typedef struct {
+    uint16_t name_size;
+    uint16_t data_size;
+} FURI_PACKED SubGhzSettingCachePreset;
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+} SubGhzSettingCacheBuffer;
+
 /* Default */
 static const uint32_t subghz_frequency_list[] = {
     /* 300 - 348 */
@@ -293,113 +330,357 @@ void subghz_setting_load_default(SubGhzSetting* instance) {
     }
 }
 
-void subghz_setting_load(SubGhzSetting* instance, const char* file_path) {
-    furi_check(instance);
+static void* subghz_setting_cache_buffer_push(SubGhzSettingCacheBuffer* buffer, size_t size) {
+    if(buffer->size + size > buffer->capacity) {
+        buffer->capacity = MAX(buffer->capacity * 2, buffer->size + size);
+        buffer->data = realloc(buffer->data, buffer->capacity); //-V701
+    }
+    void* data = &buffer->data[buffer->size];
+    buffer->size += size;
+    return data;
+}
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
+static bool subghz_setting_parse_frequencies(
+    FlipperFormat* fff_data_file,
+    const char* key,
+    SubGhzSettingCacheBuffer* buffer,
+    uint16_t* count) {
+    uint32_t temp_data32;
 
-    FuriString* temp_str;
-    temp_str = furi_string_alloc();
+    if(!flipper_format_rewind(fff_data_file)) {
+        FURI_LOG_E(TAG, "Rewind error");
+        return false;
+    }
+    while(flipper_format_read_uint32(fff_data_file, key, &temp_data32, 1)) {
+        if(*count == UINT16_MAX) return false;
+        memcpy(
+            subghz_setting_cache_buffer_push(buffer, sizeof(temp_data32)),
+            &temp_data32,
+            sizeof(temp_data32));
+        (*count)++;
+    }
+    return true;
+}
+
+static bool subghz_setting_parse_preset(
+    FlipperFormat* fff_data_file,
+    const FuriString* name,
+    SubGhzSettingCacheBuffer* buffer) {
+    uint32_t temp_data32;
+
+    if(!flipper_format_get_value_count(fff_data_file, "Custom_preset_data", &temp_data32))
+        return false;
+    if(!temp_data32 || (temp_data32 % 2) || temp_data32 > UINT16_MAX ||
+       furi_string_size(name) > UINT16_MAX) {
+        FURI_LOG_E(TAG, "Integrity error Custom_preset_data");
+        return false;
+    }
+
+    const size_t offset = buffer->size;
+    SubGhzSettingCachePreset preset = {
+        .name_size = furi_string_size(name),
+        .data_size = temp_data32,
+    };
+    memcpy(subghz_setting_cache_buffer_push(buffer, sizeof(preset)), &preset, sizeof(preset));
+    memcpy(
+        subghz_setting_cache_buffer_push(buffer, preset.name_size),
+        furi_string_get_cstr(name),
+        preset.name_size);
+    uint8_t* data = subghz_setting_cache_buffer_push(buffer, preset.data_size);
+    if(!flipper_format_read_hex(fff_data_file, "Custom_preset_data", data, preset.data_size)) {
+        FURI_LOG_E(TAG, "Missing Custom_preset_data");
+        buffer->size = offset;
+        return false;
+    }
+
+    return true;
+}
+
+// Parses setting file into cache layout, complete is cleared if the result must not be cached
+static bool subghz_setting_parse(
+    Storage* storage,
+    const char* file_path,
+    SubGhzSettingCacheHeader* header,
+    SubGhzSettingCacheBuffer* buffer,
+    bool* complete) {
+    FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
     uint32_t temp_data32;
     bool temp_bool;
+    bool success = false;
 
-    subghz_setting_load_default(instance);
+    *complete = false;
 
-    if(file_path) {
-        do {
-            if(!flipper_format_file_open_existing(fff_data_file, file_path)) {
-                FURI_LOG_I(TAG, "File is not used %s", file_path);
-                break;
-            }
+    do {
+        if(!flipper_format_file_open_existing(fff_data_file, file_path)) {
+            FURI_LOG_I(TAG, "File is not used %s", file_path);
+            break;
+        }
 
-            if(!flipper_format_read_header(fff_data_file, temp_str, &temp_data32)) {
-                FURI_LOG_E(TAG, "Missing or incorrect header");
-                break;
-            }
+        if(!flipper_format_read_header(fff_data_file, temp_str, &temp_data32)) {
+            FURI_LOG_E(TAG, "Missing or incorrect header");
+            break;
+        }
 
-            if((!strcmp(furi_string_get_cstr(temp_str), SUBGHZ_SETTING_FILE_TYPE)) &&
-               temp_data32 == SUBGHZ_SETTING_FILE_VERSION) {
-            } else {
-                FURI_LOG_E(TAG, "Type or version mismatch");
-                break;
-            }
+        if((!strcmp(furi_string_get_cstr(temp_str), SUBGHZ_SETTING_FILE_TYPE)) &&
+           temp_data32 == SUBGHZ_SETTING_FILE_VERSION) {
+        } else {
+            FURI_LOG_E(TAG, "Type or version mismatch");
+            break;
+        }
 
-            // Standard frequencies (optional)
-            temp_bool = true;
-            flipper_format_read_bool(fff_data_file, "Add_standard_frequencies", &temp_bool, 1);
-            if(!temp_bool) {
-                FURI_LOG_I(TAG, "Removing standard frequencies");
-                FrequencyList_reset(instance->frequencies);
-                FrequencyList_reset(instance->hopper_frequencies);
-            } else {
-                FURI_LOG_I(TAG, "Keeping standard frequencies");
-            }
+        // Anything parsed from here on is applied, even if parsing stops halfway
+        success = true;
+
+        // Standard frequencies (optional)
+        temp_bool = true;
+        flipper_format_read_bool(fff_data_file, "Add_standard_frequencies", &temp_bool, 1);
+        if(temp_bool) header->flags |= SUBGHZ_SETTING_CACHE_FLAG_STANDARD_FREQUENCIES;
+
+        // Frequencies and hopper frequencies, header is packed so counted separately
+        uint16_t count = 0;
+        bool parsed = subghz_setting_parse_frequencies(fff_data_file, "Frequency", buffer, &count);
+        header->frequency_count = count;
+        if(!parsed) break;
+        count = 0;
+        parsed =
+            subghz_setting_parse_frequencies(fff_data_file, "Hopper_frequency", buffer, &count);
+        header->hopper_frequency_count = count;
+        if(!parsed) break;
+
+        // Default frequency (optional)
+        if(!flipper_format_rewind(fff_data_file)) {
+            FURI_LOG_E(TAG, "Rewind error");
+            break;
+        }
+        if(flipper_format_read_uint32(fff_data_file, "Default_frequency", &temp_data32, 1)) {
+            header->flags |= SUBGHZ_SETTING_CACHE_FLAG_DEFAULT_FREQUENCY;
+            header->default_frequency = temp_data32;
+        }
 
-            // Load frequencies
-            if(!flipper_format_rewind(fff_data_file)) {
-                FURI_LOG_E(TAG, "Rewind error");
+        // custom preset (optional)
+        if(!flipper_format_rewind(fff_data_file)) {
+            FURI_LOG_E(TAG, "Rewind error");
+            break;
+        }
+        bool preset_error = false;
+        while(flipper_format_read_string(fff_data_file, "Custom_preset_name", temp_str)) {
+            FURI_LOG_I(TAG, "Custom preset loaded %s", furi_string_get_cstr(temp_str));
+            if(header->preset_count == UINT16_MAX) {
+                preset_error = true;
                 break;
             }
-            while(flipper_format_read_uint32(
-                fff_data_file, "Frequency", (uint32_t*)&temp_data32, 1)) {
-                //Todo FL-3535: add a frequency support check depending on the selected radio device
-                if(furi_hal_subghz_is_frequency_valid(temp_data32)) {
-                    FURI_LOG_I(TAG, "Frequency loaded %lu", temp_data32);
-                    FrequencyList_push_back(instance->frequencies, temp_data32);
-                } else {
-                    FURI_LOG_E(TAG, "Frequency not supported %lu", temp_data32);
-                }
+            if(subghz_setting_parse_preset(fff_data_file, temp_str, buffer)) {
+                header->preset_count++;
+            } else {
+                // Broken preset is skipped, file is parsed again next time to report it
+                preset_error = true;
             }
+        }
 
-            // Load hopper frequencies
-            if(!flipper_format_rewind(fff_data_file)) {
-                FURI_LOG_E(TAG, "Rewind error");
-                break;
+        *complete = !preset_error;
+    } while(false);
+
+    furi_string_free(temp_str);
+    flipper_format_free(fff_data_file);
+
+    return success;
+}
+
+static bool subghz_setting_cache_check(
+    const uint8_t* cache,
+    size_t size,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    SubGhzSettingCacheHeader header;
+    if(size < sizeof(header)) return false;
+    memcpy(&header, cache, sizeof(header));
+
+    if(header.magic != SUBGHZ_SETTING_CACHE_MAGIC ||
+       header.version != SUBGHZ_SETTING_CACHE_VERSION ||
+       header.payload_size != size - sizeof(header) || header.source_size != source_size ||
+       header.source_timestamp != source_timestamp) {
+        return false;
+    }
+
+    const uint8_t* payload = &cache[sizeof(header)];
+    if(crc32_calc_buffer(0, payload, header.payload_size) != header.crc) return false;
+
+    size_t offset =
+        ((size_t)header.frequency_count + header.hopper_frequency_count) * sizeof(uint32_t);
+    for(size_t i = 0; i < header.preset_count; i++) {
+        SubGhzSettingCachePreset preset;
+        if(offset + sizeof(preset) > header.payload_size) return false;
+        memcpy(&preset, &payload[offset], sizeof(preset));
+        offset += sizeof(preset) + preset.name_size + preset.data_size;
+    }
+
+    return offset == header.payload_size;
+}
+
+static uint8_t* subghz_setting_cache_read(
+    Storage* storage,
+    const char* cache_path,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* cache = NULL;
+
+    if(storage_file_open(file, cache_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        const size_t size = storage_file_size(file);
+        if(size >= sizeof(SubGhzSettingCacheHeader) && size <= SUBGHZ_SETTING_CACHE_SIZE_MAX) {
+            cache = malloc(size);
+            if(storage_file_read(file, cache, size) != size ||
+               !subghz_setting_cache_check(cache, size, source_size, source_timestamp)) {
+                free(cache);
+                cache = NULL;
             }
-            while(flipper_format_read_uint32(
-                fff_data_file, "Hopper_frequency", (uint32_t*)&temp_data32, 1)) {
-                if(furi_hal_subghz_is_frequency_valid(temp_data32)) {
-                    FURI_LOG_I(TAG, "Hopper frequency loaded %lu", temp_data32);
-                    FrequencyList_push_back(instance->hopper_frequencies, temp_data32);
-                } else {
-                    FURI_LOG_E(TAG, "Hopper frequency not supported %lu", temp_data32);
+        }
+    }
+
+    storage_file_free(file);
+    return cache;
+}
+
+static void subghz_setting_cache_write(
+    Storage* storage,
+    const char* cache_path,
+    const SubGhzSettingCacheBuffer* buffer) {
+    File* file = storage_file_alloc(storage);
+
+    bool success = buffer->size <= SUBGHZ_SETTING_CACHE_SIZE_MAX &&
+                   storage_file_open(file, cache_path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(file, buffer->data, buffer->size) == buffer->size;
+    storage_file_close(file);
+
+    if(!success) {
+        FURI_LOG_W(TAG, "Failed to write %s", cache_path);
+        storage_common_remove(storage, cache_path);
+    }
+
+    storage_file_free(file);
+}
+
+// Applies parsed setting file on top of the defaults, cache must be checked
+static void subghz_setting_apply(SubGhzSetting* instance, const uint8_t* cache) {
+    SubGhzSettingCacheHeader header;
+    memcpy(&header, cache, sizeof(header));
+    const uint8_t* payload = &cache[sizeof(header)];
+    uint32_t temp_data32;
+
+    if(!(header.flags & SUBGHZ_SETTING_CACHE_FLAG_STANDARD_FREQUENCIES)) {
+        FURI_LOG_I(TAG, "Removing standard frequencies");
+        FrequencyList_reset(instance->frequencies);
+        FrequencyList_reset(instance->hopper_frequencies);
+    } else {
+        FURI_LOG_I(TAG, "Keeping standard frequencies");
+    }
+
+    for(size_t i = 0; i < header.frequency_count; i++) {
+        memcpy(&temp_data32, payload, sizeof(uint32_t));
+        payload += sizeof(uint32_t);
+        //Todo FL-3535: add a frequency support check depending on the selected radio device
+        if(furi_hal_subghz_is_frequency_valid(temp_data32)) {
+            FURI_LOG_I(TAG, "Frequency loaded %lu", temp_data32);
+            FrequencyList_push_back(instance->frequencies, temp_data32);
+        } else {
+            FURI_LOG_E(TAG, "Frequency not supported %lu", temp_data32);
+        }
+    }
+
+    for(size_t i = 0; i < header.hopper_frequency_count; i++) {
+        memcpy(&temp_data32, payload, sizeof(uint32_t));
+        payload += sizeof(uint32_t);
+        if(furi_hal_subghz_is_frequency_valid(temp_data32)) {
+            FURI_LOG_I(TAG, "Hopper frequency loaded %lu", temp_data32);
+            FrequencyList_push_back(instance->hopper_frequencies, temp_data32);
+        } else {
+            FURI_LOG_E(TAG, "Hopper frequency not supported %lu", temp_data32);
+        }
+    }
+
+    if(header.flags & SUBGHZ_SETTING_CACHE_FLAG_DEFAULT_FREQUENCY) {
+        for
+            M_EACH(frequency, instance->frequencies, FrequencyList_t) {
+                *frequency &= FREQUENCY_MASK;
+                if(*frequency == header.default_frequency) {
+                    *frequency |= FREQUENCY_FLAG_DEFAULT;
                 }
             }
+    }
 
-            // Default frequency (optional)
-            if(!flipper_format_rewind(fff_data_file)) {
-                FURI_LOG_E(TAG, "Rewind error");
-                break;
-            }
-            if(flipper_format_read_uint32(fff_data_file, "Default_frequency", &temp_data32, 1)) {
-                for
-                    M_EACH(frequency, instance->frequencies, FrequencyList_t) {
-                        *frequency &= FREQUENCY_MASK;
-                        if(*frequency == temp_data32) {
-                            *frequency |= FREQUENCY_FLAG_DEFAULT;
-                        }
-                    }
-            }
+    for(size_t i = 0; i < header.preset_count; i++) {
+        SubGhzSettingCachePreset preset;
+        memcpy(&preset, payload, sizeof(preset));
+        payload += sizeof(preset);
+
+        SubGhzSettingCustomPresetItem* item =
+            SubGhzSettingCustomPresetItemArray_push_raw(instance->preset->data);
+        item->custom_preset_name = furi_string_alloc();
+        furi_string_set_strn(item->custom_preset_name, (const char*)payload, preset.name_size);
+        payload += preset.name_size;
+        item->custom_preset_data_size = preset.data_size;
+        item->custom_preset_data = malloc(preset.data_size);
+        memcpy(item->custom_preset_data, payload, preset.data_size);
+        payload += preset.data_size;
+    }
+}
 
-            // custom preset (optional)
-            if(!flipper_format_rewind(fff_data_file)) {
-                FURI_LOG_E(TAG, "Rewind error");
-                break;
-            }
-            while(flipper_format_read_string(fff_data_file, "Custom_preset_name", temp_str)) {
-                FURI_LOG_I(TAG, "Custom preset loaded %s", furi_string_get_cstr(temp_str));
-                subghz_setting_load_custom_preset(
-                    instance, furi_string_get_cstr(temp_str), fff_data_file);
+void subghz_setting_load(SubGhzSetting* instance, const char* file_path) {
+    furi_check(instance);
+
+    subghz_setting_load_default(instance);
+
+    if(file_path) {
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        FuriString* cache_path =
+            furi_string_alloc_printf("%s%s", file_path, SUBGHZ_SETTING_CACHE_EXTENSION);
+        FileInfo file_info;
+        uint32_t source_timestamp = 0;
+
+        if(storage_common_stat(storage, file_path, &file_info) != FSE_OK ||
+           storage_common_timestamp(storage, file_path, &source_timestamp) != FSE_OK) {
+            FURI_LOG_I(TAG, "File is not used %s", file_path);
+        } else {
+            const uint32_t source_size = (uint32_t)file_info.size;
+            uint8_t* cache = subghz_setting_cache_read(
+                storage, furi_string_get_cstr(cache_path), source_size, source_timestamp);
+
+            if(cache) {
+                FURI_LOG_I(TAG, "Loaded from cache");
+                subghz_setting_apply(instance, cache);
+                free(cache);
+            } else {
+                SubGhzSettingCacheHeader header = {
+                    .magic = SUBGHZ_SETTING_CACHE_MAGIC,
+                    .version = SUBGHZ_SETTING_CACHE_VERSION,
+                    .source_size = source_size,
+                    .source_timestamp = source_timestamp,
+                };
+                SubGhzSettingCacheBuffer buffer = {0};
+                // Header is filled in once everything is parsed
+                subghz_setting_cache_buffer_push(&buffer, sizeof(header));
+
+                bool complete = false;
+                if(subghz_setting_parse(storage, file_path, &header, &buffer, &complete)) {
+                    header.payload_size = buffer.size - sizeof(header);
+                    header.crc = crc32_calc_buffer(
+                        0, &buffer.data[sizeof(header)], header.payload_size);
+                    memcpy(buffer.data, &header, sizeof(header));
+                    subghz_setting_apply(instance, buffer.data);
+                    if(complete) {
+                        subghz_setting_cache_write(
+                            storage, furi_string_get_cstr(cache_path), &buffer);
+                    }
+                }
+                free(buffer.data);
             }
+        }
 
-        } while(false);
+        furi_string_free(cache_path);
+        furi_record_close(RECORD_STORAGE);
     }
 
-    furi_string_free(temp_str);
-    flipper_format_free(fff_data_file);
-    furi_record_close(RECORD_STORAGE);
-
     if(!FrequencyList_size(instance->frequencies) ||
        !FrequencyList_size(instance->hopper_frequencies)) {
         FURI_LOG_E(TAG, "Error loading user settings, loading default settings");
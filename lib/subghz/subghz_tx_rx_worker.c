@@ -10,6 +10,20 @@
 
 #define SUBGHZ_TXRX_WORKER_TIMEOUT_READ_WRITE_BUF 40
 
+#define SUBGHZ_TXRX_WORKER_TIMEOUT_RX 100 // ticks from sync word to end of packet
+#define SUBGHZ_TXRX_WORKER_TIMEOUT_TX 200
+// Queued packets go out back to back, then the other side gets a window to answer
+#define SUBGHZ_TXRX_WORKER_TX_BURST   4
+#define SUBGHZ_TXRX_WORKER_TX_HOLDOFF 10
+
+typedef enum {
+    SubGhzTxRxWorkerFlagGdo = (1 << 0),
+    SubGhzTxRxWorkerFlagTx = (1 << 1),
+    SubGhzTxRxWorkerFlagStop = (1 << 2),
+    SubGhzTxRxWorkerFlagAll =
+        (SubGhzTxRxWorkerFlagGdo | SubGhzTxRxWorkerFlagTx | SubGhzTxRxWorkerFlagStop),
+} SubGhzTxRxWorkerFlag;
+
 struct SubGhzTxRxWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream_tx;
@@ -21,6 +35,8 @@ struct SubGhzTxRxWorker {
     SubGhzTxRxWorkerStatus status;
 
     uint32_t frequency;
+    FuriHalSubGhzPreset preset;
+    uint8_t* preset_data;
     const SubGhzDevice* device;
     const GpioPin* device_data_gpio;
 
@@ -39,6 +55,9 @@ bool subghz_tx_rx_worker_write(SubGhzTxRxWorker* instance, uint8_t* data, size_t
             ret = true;
         }
     }
+    if(ret && furi_thread_get_state(instance->thread) == FuriThreadStateRunning) {
+        furi_thread_flags_set(furi_thread_get_id(instance->thread), SubGhzTxRxWorkerFlagTx);
+    }
     return ret;
 }
 
@@ -63,23 +82,40 @@ void subghz_tx_rx_worker_set_callback_have_read(
     instance->context_have_read = context;
 }
 
+static void subghz_tx_rx_worker_gdo_isr(void* context) {
+    SubGhzTxRxWorker* instance = context;
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), SubGhzTxRxWorkerFlagGdo);
+}
+
+/** Wait for GDO0 level, edge interrupt wakes the thread up
+ *
+ * @param instance SubGhzTxRxWorker instance
+ * @param level level to wait for
+ * @param timeout timeout in ticks
+ * @return true if level was reached in time
+ */
+static bool
+    subghz_tx_rx_worker_wait_gdo(SubGhzTxRxWorker* instance, bool level, uint32_t timeout) {
+    const uint32_t start = furi_get_tick();
+    while(furi_hal_gpio_read(instance->device_data_gpio) != level) {
+        const uint32_t elapsed = furi_get_tick() - start;
+        if(elapsed >= timeout) return false;
+        furi_thread_flags_wait(SubGhzTxRxWorkerFlagGdo, FuriFlagWaitAny, timeout - elapsed);
+    }
+    return true;
+}
+
 bool subghz_tx_rx_worker_rx(SubGhzTxRxWorker* instance, uint8_t* data, uint8_t* size) {
-    uint8_t timeout = 100;
     bool ret = false;
     if(instance->status != SubGhzTxRxWorkerStatusRx) {
         subghz_devices_set_rx(instance->device);
         instance->status = SubGhzTxRxWorkerStatusRx;
-        furi_delay_tick(1);
     }
     //waiting for reception to complete
-    while(furi_hal_gpio_read(instance->device_data_gpio)) {
-        furi_delay_tick(1);
-        if(!--timeout) {
-            FURI_LOG_W(TAG, "RX cc1101_g0 timeout");
-            subghz_devices_flush_rx(instance->device);
-            subghz_devices_set_rx(instance->device);
-            break;
-        }
+    if(!subghz_tx_rx_worker_wait_gdo(instance, false, SUBGHZ_TXRX_WORKER_TIMEOUT_RX)) {
+        FURI_LOG_W(TAG, "RX cc1101_g0 timeout");
+        subghz_devices_flush_rx(instance->device);
+        subghz_devices_set_rx(instance->device);
     }
 
     if(subghz_devices_rx_pipe_not_empty(instance->device)) {
@@ -99,28 +135,19 @@ bool subghz_tx_rx_worker_rx(SubGhzTxRxWorker* instance, uint8_t* data, uint8_t*
 }
 
 void subghz_tx_rx_worker_tx(SubGhzTxRxWorker* instance, uint8_t* data, size_t size) {
-    uint8_t timeout = 200;
     if(instance->status != SubGhzTxRxWorkerStatusIDLE) {
         subghz_devices_idle(instance->device);
     }
     subghz_devices_write_packet(instance->device, data, size);
     subghz_devices_set_tx(instance->device); //start send
     instance->status = SubGhzTxRxWorkerStatusTx;
-    while(!furi_hal_gpio_read(
-        instance->device_data_gpio)) { // Wait for GDO0 to be set -> sync transmitted
-        furi_delay_tick(1);
-        if(!--timeout) {
-            FURI_LOG_W(TAG, "TX !cc1101_g0 timeout");
-            break;
-        }
+    // Wait for GDO0 to be set -> sync transmitted
+    if(!subghz_tx_rx_worker_wait_gdo(instance, true, SUBGHZ_TXRX_WORKER_TIMEOUT_TX)) {
+        FURI_LOG_W(TAG, "TX !cc1101_g0 timeout");
     }
-    while(furi_hal_gpio_read(
-        instance->device_data_gpio)) { // Wait for GDO0 to be cleared -> end of packet
-        furi_delay_tick(1);
-        if(!--timeout) {
-            FURI_LOG_W(TAG, "TX cc1101_g0 timeout");
-            break;
-        }
+    // Wait for GDO0 to be cleared -> end of packet
+    if(!subghz_tx_rx_worker_wait_gdo(instance, false, SUBGHZ_TXRX_WORKER_TIMEOUT_TX)) {
+        FURI_LOG_W(TAG, "TX cc1101_g0 timeout");
     }
     subghz_devices_idle(instance->device);
     instance->status = SubGhzTxRxWorkerStatusIDLE;
@@ -139,9 +166,13 @@ static int32_t subghz_tx_rx_worker_thread(void* context) {
     instance->device_data_gpio = subghz_devices_get_data_gpio(instance->device);
     subghz_devices_reset(instance->device);
     subghz_devices_idle(instance->device);
-    subghz_devices_load_preset(instance->device, FuriHalSubGhzPresetGFSK9_99KbAsync, NULL);
+    subghz_devices_load_preset(instance->device, instance->preset, instance->preset_data);
 
-    furi_hal_gpio_init(instance->device_data_gpio, GpioModeInput, GpioPullNo, GpioSpeedLow);
+    furi_hal_gpio_init(
+        instance->device_data_gpio, GpioModeInterruptRiseFall, GpioPullNo, GpioSpeedLow);
+    furi_hal_gpio_remove_int_callback(instance->device_data_gpio);
+    furi_hal_gpio_add_int_callback(
+        instance->device_data_gpio, subghz_tx_rx_worker_gdo_isr, instance);
 
     subghz_devices_set_frequency(instance->device, instance->frequency);
     subghz_devices_flush_rx(instance->device);
@@ -149,26 +180,24 @@ static int32_t subghz_tx_rx_worker_thread(void* context) {
     uint8_t data[SUBGHZ_TXRX_WORKER_MAX_TXRX_SIZE + 1] = {0};
     size_t size_tx = 0;
     uint8_t size_rx[1] = {0};
-    uint8_t timeout_tx = 0;
+    uint32_t tx_holdoff = furi_get_tick();
     bool callback_rx = false;
 
     while(instance->worker_running) {
         //transmit
         size_tx = furi_stream_buffer_bytes_available(instance->stream_tx);
-        if(size_tx > 0 && !timeout_tx) {
-            timeout_tx = 10; //20ms
-            if(size_tx > SUBGHZ_TXRX_WORKER_MAX_TXRX_SIZE) {
+        if(size_tx > 0 && (int32_t)(furi_get_tick() - tx_holdoff) >= 0) {
+            for(size_t i = 0; i < SUBGHZ_TXRX_WORKER_TX_BURST && size_tx > 0; i++) {
+                size_tx = MIN(size_tx, (size_t)SUBGHZ_TXRX_WORKER_MAX_TXRX_SIZE);
                 furi_stream_buffer_receive(
                     instance->stream_tx,
                     &data,
-                    SUBGHZ_TXRX_WORKER_MAX_TXRX_SIZE,
+                    size_tx,
                     SUBGHZ_TXRX_WORKER_TIMEOUT_READ_WRITE_BUF);
-                subghz_tx_rx_worker_tx(instance, data, SUBGHZ_TXRX_WORKER_MAX_TXRX_SIZE);
-            } else {
-                furi_stream_buffer_receive(
-                    instance->stream_tx, &data, size_tx, SUBGHZ_TXRX_WORKER_TIMEOUT_READ_WRITE_BUF);
                 subghz_tx_rx_worker_tx(instance, data, size_tx);
+                size_tx = furi_stream_buffer_bytes_available(instance->stream_tx);
             }
+            tx_holdoff = furi_get_tick() + SUBGHZ_TXRX_WORKER_TX_HOLDOFF;
         } else {
             //recive
             if(subghz_tx_rx_worker_rx(instance, data, size_rx)) {
@@ -192,10 +221,20 @@ static int32_t subghz_tx_rx_worker_thread(void* context) {
             }
         }
 
-        if(timeout_tx) timeout_tx--;
-        furi_delay_tick(1);
+        // Sleep until packet edge, new data to send or stop
+        uint32_t timeout = SUBGHZ_TXRX_WORKER_TIMEOUT_RX;
+        if(furi_stream_buffer_bytes_available(instance->stream_tx)) {
+            const int32_t holdoff = tx_holdoff - furi_get_tick();
+            timeout = MAX(holdoff, 0);
+        }
+        if(timeout) {
+            furi_thread_flags_wait(SubGhzTxRxWorkerFlagAll, FuriFlagWaitAny, timeout);
+        }
     }
 
+    furi_hal_gpio_remove_int_callback(instance->device_data_gpio);
+    furi_hal_gpio_init(instance->device_data_gpio, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
+
     subghz_devices_sleep(instance->device);
     subghz_devices_end(instance->device);
 
@@ -215,6 +254,8 @@ SubGhzTxRxWorker* subghz_tx_rx_worker_alloc(void) {
 
     instance->status = SubGhzTxRxWorkerStatusIDLE;
     instance->worker_stoping = true;
+    instance->preset = FuriHalSubGhzPresetGFSK9_99KbAsync;
+    instance->preset_data = NULL;
 
     return instance;
 }
@@ -229,6 +270,17 @@ void subghz_tx_rx_worker_free(SubGhzTxRxWorker* instance) {
     free(instance);
 }
 
+void subghz_tx_rx_worker_set_preset(
+    SubGhzTxRxWorker* instance,
+    FuriHalSubGhzPreset preset,
+    uint8_t* preset_data) {
+    furi_check(instance);
+    furi_check(!instance->worker_running);
+    furi_check((preset == FuriHalSubGhzPresetCustom) == (preset_data != NULL));
+    instance->preset = preset;
+    instance->preset_data = preset_data;
+}
+
 bool subghz_tx_rx_worker_start(
     SubGhzTxRxWorker* instance,
     const SubGhzDevice* device,
@@ -257,6 +309,7 @@ void subghz_tx_rx_worker_stop(SubGhzTxRxWorker* instance) {
     furi_check(instance->worker_running);
 
     instance->worker_running = false;
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), SubGhzTxRxWorkerFlagStop);
 
     furi_thread_join(instance->thread);
 }
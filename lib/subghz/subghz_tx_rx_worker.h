@@ -65,6 +65,17 @@ SubGhzTxRxWorker* subghz_tx_rx_worker_alloc(void);
  */
 void subghz_tx_rx_worker_free(SubGhzTxRxWorker* instance);
 
+/** 
+ * Set radio preset, GFSK 9.99 kBaud is used by default. Must be called before start
+ * @param instance    Pointer to a SubGhzTxRxWorker instance
+ * @param preset      packet mode preset, FuriHalSubGhzPresetCustom to use preset_data
+ * @param preset_data custom preset registers, must stay valid while worker is running
+ */
+void subghz_tx_rx_worker_set_preset(
+    SubGhzTxRxWorker* instance,
+    FuriHalSubGhzPreset preset,
+    uint8_t* preset_data);
+
 /** 
  * Start SubGhzTxRxWorker
  * @param instance Pointer to a SubGhzTxRxWorker instance
@@ -1,12 +1,18 @@
 #include "subghz_worker.h"
 
 #include <furi.h>
+#include <toolbox/profiler.h>
 
 #define TAG "SubGhzWorker"
 
+#define SUBGHZ_WORKER_BATCH_SIZE 64
+#define SUBGHZ_WORKER_RING_SIZE  4096
+
+#define SUBGHZ_WORKER_FLAG_RX (1UL << 0)
+
 struct SubGhzWorker {
     FuriThread* thread;
-    FuriStreamBuffer* stream;
+    FuriSpscRing* ring;
 
     volatile bool running;
     volatile bool overrun;
@@ -16,7 +22,12 @@ struct SubGhzWorker {
 
     SubGhzWorkerOverrunCallback overrun_callback;
     SubGhzWorkerPairCallback pair_callback;
+    SubGhzWorkerPairBatchCallback pair_batch_callback;
     void* context;
+
+    LevelDuration rx_buffer[SUBGHZ_WORKER_BATCH_SIZE];
+    LevelDuration pair_buffer[SUBGHZ_WORKER_BATCH_SIZE];
+    size_t pair_count;
 };
 
 /** Rx callback timer
@@ -27,15 +38,62 @@ struct SubGhzWorker {
  */
 void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     SubGhzWorker* instance = context;
+    profiler_probe_enter(ProfilerProbeSubGhzWorkerRx);
 
     LevelDuration level_duration = level_duration_make(level, duration);
     if(instance->overrun) {
         instance->overrun = false;
         level_duration = level_duration_reset();
     }
-    size_t ret =
-        furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
+    // Only wake the thread when it may be waiting for data
+    bool was_empty = !furi_spsc_ring_get_count(instance->ring);
+    if(furi_spsc_ring_push(instance->ring, &level_duration, 1) != 1) {
+        instance->overrun = true;
+    } else if(was_empty && furi_thread_get_state(instance->thread) == FuriThreadStateRunning) {
+        // Async RX may run before the thread starts and after it stops
+        furi_thread_flags_set(furi_thread_get_id(instance->thread), SUBGHZ_WORKER_FLAG_RX);
+    }
+
+    profiler_probe_exit(ProfilerProbeSubGhzWorkerRx);
+}
+
+void subghz_worker_rx_batch_callback(const LevelDuration* pulses, size_t count, void* context) {
+    SubGhzWorker* instance = context;
+    profiler_probe_enter(ProfilerProbeSubGhzWorkerRx);
+
+    // Only wake the thread when it may be waiting for data
+    bool was_empty = !furi_spsc_ring_get_count(instance->ring);
+    if(instance->overrun) {
+        LevelDuration level_duration = level_duration_reset();
+        if(furi_spsc_ring_push(instance->ring, &level_duration, 1) == 1) {
+            instance->overrun = false;
+        }
+    }
+    if(instance->overrun || furi_spsc_ring_push(instance->ring, pulses, count) != count) {
+        instance->overrun = true;
+    }
+    if(was_empty && furi_thread_get_state(instance->thread) == FuriThreadStateRunning) {
+        furi_thread_flags_set(furi_thread_get_id(instance->thread), SUBGHZ_WORKER_FLAG_RX);
+    }
+
+    profiler_probe_exit(ProfilerProbeSubGhzWorkerRx);
+}
+
+static void subghz_worker_pair_flush(SubGhzWorker* instance) {
+    if(instance->pair_count) {
+        instance->pair_batch_callback(
+            instance->context, instance->pair_buffer, instance->pair_count);
+        instance->pair_count = 0;
+    }
+}
+
+static void subghz_worker_pair_push(SubGhzWorker* instance, bool level, uint32_t duration) {
+    if(instance->pair_batch_callback) {
+        instance->pair_buffer[instance->pair_count++] = level_duration_make(level, duration);
+        if(instance->pair_count == SUBGHZ_WORKER_BATCH_SIZE) subghz_worker_pair_flush(instance);
+    } else if(instance->pair_callback) {
+        instance->pair_callback(instance->context, level, duration);
+    }
 }
 
 /** Worker callback thread
@@ -46,13 +104,19 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
     while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
+        size_t count =
+            furi_spsc_ring_pop(instance->ring, instance->rx_buffer, SUBGHZ_WORKER_BATCH_SIZE);
+        if(!count) {
+            furi_thread_flags_wait(SUBGHZ_WORKER_FLAG_RX, FuriFlagWaitAny, 10);
+            continue;
+        }
+        profiler_probe_enter(ProfilerProbeSubGhzWorkerBatch);
+        for(size_t i = 0; i < count; i++) {
+            LevelDuration level_duration = instance->rx_buffer[i];
             if(level_duration_is_reset(level_duration)) {
                 FURI_LOG_E(TAG, "Overrun buffer");
+                subghz_worker_pair_flush(instance);
                 if(instance->overrun_callback) instance->overrun_callback(instance->context);
             } else {
                 bool level = level_duration_get_level(level_duration);
@@ -63,17 +127,18 @@ static int32_t subghz_worker_thread_callback(void* context) {
                     instance->filter_level_duration.duration += duration;
 
                 } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
-                        instance->pair_callback(
-                            instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
+                    subghz_worker_pair_push(
+                        instance,
+                        instance->filter_level_duration.level,
+                        instance->filter_level_duration.duration);
 
                     instance->filter_level_duration.duration = duration;
                     instance->filter_level_duration.level = level;
                 }
             }
         }
+        subghz_worker_pair_flush(instance);
+        profiler_probe_exit(ProfilerProbeSubGhzWorkerBatch);
     }
 
     return 0;
@@ -85,8 +150,7 @@ SubGhzWorker* subghz_worker_alloc(void) {
     instance->thread =
         furi_thread_alloc_ex("SubGhzWorker", 2048, subghz_worker_thread_callback, instance);
 
-    instance->stream =
-        furi_stream_buffer_alloc(sizeof(LevelDuration) * 4096, sizeof(LevelDuration));
+    instance->ring = furi_spsc_ring_alloc(SUBGHZ_WORKER_RING_SIZE, sizeof(LevelDuration));
 
     //setting default filter in us
     instance->filter_duration = 30;
@@ -97,7 +161,7 @@ SubGhzWorker* subghz_worker_alloc(void) {
 void subghz_worker_free(SubGhzWorker* instance) {
     furi_check(instance);
 
-    furi_stream_buffer_free(instance->stream);
+    furi_spsc_ring_free(instance->ring);
     furi_thread_free(instance->thread);
 
     free(instance);
@@ -115,6 +179,13 @@ void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCal
     instance->pair_callback = callback;
 }
 
+void subghz_worker_set_pair_batch_callback(
+    SubGhzWorker* instance,
+    SubGhzWorkerPairBatchCallback callback) {
+    furi_check(instance);
+    instance->pair_batch_callback = callback;
+}
+
 void subghz_worker_set_context(SubGhzWorker* instance, void* context) {
     furi_check(instance);
     instance->context = context;
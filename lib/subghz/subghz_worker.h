@@ -12,8 +12,18 @@ typedef void (*SubGhzWorkerOverrunCallback)(void* context);
 
 typedef void (*SubGhzWorkerPairCallback)(void* context, bool level, uint32_t duration);
 
+typedef void (
+    *SubGhzWorkerPairBatchCallback)(void* context, const LevelDuration* pulses, size_t count);
+
 void subghz_worker_rx_callback(bool level, uint32_t duration, void* context);
 
+/** Rx batch callback, for subghz_devices_start_async_rx_batch
+ * @param pulses received levels and durations
+ * @param count pulses count
+ * @param context Pointer to a SubGhzWorker instance
+ */
+void subghz_worker_rx_batch_callback(const LevelDuration* pulses, size_t count, void* context);
+
 /** 
  * Allocate SubGhzWorker.
  * @return SubGhzWorker* Pointer to a SubGhzWorker instance
@@ -42,6 +52,17 @@ void subghz_worker_set_overrun_callback(
  */
 void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCallback callback);
 
+/** 
+ * Pair batch callback SubGhzWorker.
+ * If set, it is used instead of the pair callback and gets all pairs
+ * that are ready after each read from the stream.
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param callback SubGhzWorkerPairBatchCallback callback
+ */
+void subghz_worker_set_pair_batch_callback(
+    SubGhzWorker* instance,
+    SubGhzWorkerPairBatchCallback callback);
+
 /** 
  * Context callback SubGhzWorker.
  * @param instance Pointer to a SubGhzWorker instance
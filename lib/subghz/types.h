@@ -74,9 +74,24 @@ typedef SubGhzProtocolStatus (*SubGhzDeserialize)(void* context, FlipperFormat*
 // Decoder specific
 typedef void (*SubGhzDecoderFeed)(void* decoder, bool level, uint32_t duration);
 typedef void (*SubGhzDecoderReset)(void* decoder);
+typedef void (
+    *SubGhzDecoderFeedBatch)(void* decoder, const LevelDuration* pulses, size_t count);
 typedef uint8_t (*SubGhzGetHashData)(void* decoder);
 typedef void (*SubGhzGetString)(void* decoder, FuriString* output);
 
+/** Pulse accepted by a decoder while it waits for a preamble.
+ * Decoders in the reset step (parser_step 0) that ignore any other pulse
+ * may report this window, so the receiver can skip calling them.
+ */
+typedef struct {
+    const uint32_t* parser_step; ///< Decoder parser step, 0 is reset step
+    bool level; ///< Level of the pulse that leaves the reset step
+    uint32_t duration; ///< Expected duration of that pulse, us
+    uint32_t delta; ///< Exclusive tolerance around duration, us
+} SubGhzProtocolDecoderIdleFilter;
+
+typedef void (*SubGhzDecoderGetIdleFilter)(void* decoder, SubGhzProtocolDecoderIdleFilter* filter);
+
 // Encoder specific
 typedef void (*SubGhzEncoderStop)(void* encoder);
 typedef LevelDuration (*SubGhzEncoderYield)(void* context);
@@ -92,6 +107,9 @@ typedef struct {
     SubGhzGetString get_string;
     SubGhzSerialize serialize;
     SubGhzDeserialize deserialize;
+
+    SubGhzDecoderGetIdleFilter get_idle_filter; ///< Optional
+    SubGhzDecoderFeedBatch feed_batch; ///< Optional, feed is used for each pulse if not set
 } SubGhzProtocolDecoder;
 
 typedef struct {
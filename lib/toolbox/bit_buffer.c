@@ -14,11 +14,12 @@ struct BitBuffer {
 BitBuffer* bit_buffer_alloc(size_t capacity_bytes) {
     furi_check(capacity_bytes);
 
-    BitBuffer* buf = malloc(sizeof(BitBuffer));
+    // Buffers are allocated per transaction, keep them out of the general heap
+    BitBuffer* buf = memmgr_slab_alloc(sizeof(BitBuffer));
 
-    buf->data = malloc(capacity_bytes);
+    buf->data = memmgr_slab_alloc(capacity_bytes);
     size_t parity_buf_size = (capacity_bytes + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
-    buf->parity = malloc(parity_buf_size);
+    buf->parity = memmgr_slab_alloc(parity_buf_size);
     buf->capacity_bytes = capacity_bytes;
     buf->size_bits = 0;
 
@@ -28,9 +29,9 @@ BitBuffer* bit_buffer_alloc(size_t capacity_bytes) {
 void bit_buffer_free(BitBuffer* buf) {
     furi_check(buf);
 
-    free(buf->data);
-    free(buf->parity);
-    free(buf);
+    memmgr_slab_free(buf->data);
+    memmgr_slab_free(buf->parity);
+    memmgr_slab_free(buf);
 }
 
 void bit_buffer_reset(BitBuffer* buf) {
@@ -97,31 +98,37 @@ void bit_buffer_copy_bytes_with_parity(BitBuffer* buf, const uint8_t* data, size
     furi_check(buf);
     furi_check(data);
 
-    size_t bits_processed = 0;
-    size_t curr_byte = 0;
-
     if(size_bits < BITS_IN_BYTE + 1) {
         buf->size_bits = size_bits;
         buf->data[0] = data[0];
     } else {
         furi_check(size_bits % (BITS_IN_BYTE + 1) == 0);
-        while(bits_processed < size_bits) {
-            buf->data[curr_byte] = data[bits_processed / BITS_IN_BYTE] >>
-                                   (bits_processed % BITS_IN_BYTE);
-            buf->data[curr_byte] |= data[bits_processed / BITS_IN_BYTE + 1]
-                                    << (BITS_IN_BYTE - bits_processed % BITS_IN_BYTE);
-            uint8_t bit =
-                FURI_BIT(data[bits_processed / BITS_IN_BYTE + 1], bits_processed % BITS_IN_BYTE);
-
-            if((bits_processed % BITS_IN_BYTE) == 0) {
-                buf->parity[curr_byte / BITS_IN_BYTE] = bit;
-            } else {
-                buf->parity[curr_byte / BITS_IN_BYTE] |= bit << (bits_processed % BITS_IN_BYTE);
+        const size_t size_bytes = size_bits / (BITS_IN_BYTE + 1);
+        furi_check(buf->capacity_bytes >= size_bytes);
+
+        // Frames are shifted out of a word, no per bit work
+        uint32_t acc = 0;
+        size_t acc_bits = 0;
+        uint8_t parity = 0;
+
+        for(size_t i = 0; i < size_bytes; i++) {
+            while(acc_bits < BITS_IN_BYTE + 1) {
+                acc |= (uint32_t)(*data++) << acc_bits;
+                acc_bits += BITS_IN_BYTE;
+            }
+
+            buf->data[i] = acc;
+            parity |= ((acc >> BITS_IN_BYTE) & 1U) << (i % BITS_IN_BYTE);
+            acc >>= BITS_IN_BYTE + 1;
+            acc_bits -= BITS_IN_BYTE + 1;
+
+            if((i % BITS_IN_BYTE) == BITS_IN_BYTE - 1 || i == size_bytes - 1) {
+                buf->parity[i / BITS_IN_BYTE] = parity;
+                parity = 0;
             }
-            bits_processed += BITS_IN_BYTE + 1;
-            curr_byte++;
         }
-        buf->size_bits = curr_byte * BITS_IN_BYTE;
+
+        buf->size_bits = size_bytes * BITS_IN_BYTE;
     }
 }
 
@@ -147,29 +154,25 @@ void bit_buffer_write_bytes_with_parity(
         (buf_size_bytes * (BITS_IN_BYTE + 1) + BITS_IN_BYTE) / BITS_IN_BYTE;
     furi_check(buf_size_with_parity_bytes <= size_bytes);
 
-    uint8_t next_par_bit = 0;
-    uint16_t curr_bit_pos = 0;
     uint8_t* bitstream = dest;
+    uint32_t acc = 0;
+    size_t acc_bits = 0;
 
     for(size_t i = 0; i < buf_size_bytes; i++) {
-        next_par_bit = FURI_BIT(buf->parity[i / BITS_IN_BYTE], i % BITS_IN_BYTE);
-        if(curr_bit_pos % BITS_IN_BYTE == 0) {
-            bitstream[curr_bit_pos / BITS_IN_BYTE] = buf->data[i];
-            curr_bit_pos += BITS_IN_BYTE;
-            bitstream[curr_bit_pos / BITS_IN_BYTE] = next_par_bit;
-            curr_bit_pos++;
-        } else {
-            bitstream[curr_bit_pos / BITS_IN_BYTE] |= buf->data[i]
-                                                      << (curr_bit_pos % BITS_IN_BYTE);
-            bitstream[curr_bit_pos / BITS_IN_BYTE + 1] =
-                buf->data[i] >> (BITS_IN_BYTE - curr_bit_pos % BITS_IN_BYTE);
-            bitstream[curr_bit_pos / BITS_IN_BYTE + 1] |= next_par_bit
-                                                          << (curr_bit_pos % BITS_IN_BYTE);
-            curr_bit_pos += BITS_IN_BYTE + 1;
+        const uint32_t parity_bit = FURI_BIT(buf->parity[i / BITS_IN_BYTE], i % BITS_IN_BYTE);
+        acc |= (buf->data[i] | parity_bit << BITS_IN_BYTE) << acc_bits;
+        acc_bits += BITS_IN_BYTE + 1;
+
+        while(acc_bits >= BITS_IN_BYTE) {
+            *bitstream++ = acc;
+            acc >>= BITS_IN_BYTE;
+            acc_bits -= BITS_IN_BYTE;
         }
     }
 
-    *bits_written = curr_bit_pos;
+    if(acc_bits) *bitstream = acc;
+
+    *bits_written = buf_size_bytes * (BITS_IN_BYTE + 1);
 }
 
 void bit_buffer_write_bytes_mid(
@@ -184,6 +187,51 @@ void bit_buffer_write_bytes_mid(
     memcpy(dest, buf->data + start_index, size_bytes);
 }
 
+static void bit_buffer_clear_tail(uint8_t* data, size_t size_bits) {
+    // Bits past the end are kept zero, bit_buffer_append_bit() relies on it
+    if(size_bits % BITS_IN_BYTE) {
+        data[size_bits / BITS_IN_BYTE] &= (1U << (size_bits % BITS_IN_BYTE)) - 1;
+    }
+}
+
+void bit_buffer_write_bits_mid(
+    const BitBuffer* buf,
+    void* dest,
+    size_t start_index_bits,
+    size_t size_bits) {
+    furi_check(buf);
+    furi_check(dest);
+    furi_check(start_index_bits + size_bits <= buf->size_bits);
+
+    const uint8_t* src = &buf->data[start_index_bits / BITS_IN_BYTE];
+    const size_t offset = start_index_bits % BITS_IN_BYTE;
+    const size_t size_bytes = (size_bits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+    uint8_t* out = dest;
+
+    if(!size_bits) return;
+
+    if(offset == 0) {
+        memcpy(out, src, size_bytes);
+    } else {
+        const size_t src_size_bytes = (offset + size_bits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+        uint32_t acc = src[0] >> offset;
+        size_t acc_bits = BITS_IN_BYTE - offset;
+        size_t next = 1;
+
+        for(size_t i = 0; i < size_bytes; i++) {
+            if(acc_bits < BITS_IN_BYTE && next < src_size_bytes) {
+                acc |= (uint32_t)src[next++] << acc_bits;
+                acc_bits += BITS_IN_BYTE;
+            }
+            out[i] = acc;
+            acc >>= BITS_IN_BYTE;
+            acc_bits -= MIN(acc_bits, (size_t)BITS_IN_BYTE);
+        }
+    }
+
+    bit_buffer_clear_tail(out, size_bits);
+}
+
 bool bit_buffer_has_partial_byte(const BitBuffer* buf) {
     furi_check(buf);
 
@@ -334,3 +382,43 @@ void bit_buffer_append_bit(BitBuffer* buf, bool bit) {
 
     buf->size_bits++;
 }
+
+void bit_buffer_append_bits(BitBuffer* buf, const uint8_t* data, size_t size_bits) {
+    furi_check(buf);
+    furi_check(data);
+    furi_check(buf->capacity_bytes * BITS_IN_BYTE >= buf->size_bits + size_bits);
+
+    uint8_t* dst = &buf->data[buf->size_bits / BITS_IN_BYTE];
+    const size_t offset = buf->size_bits % BITS_IN_BYTE;
+    const size_t size_bytes = (size_bits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+
+    if(offset == 0) {
+        memcpy(dst, data, size_bytes);
+    } else {
+        // Whole words are shifted into place, little endian like the bit order
+        const size_t word_bits = sizeof(uint32_t) * BITS_IN_BYTE;
+        uint32_t carry = dst[0] & ((1U << offset) - 1);
+        size_t i = 0;
+
+        for(; i + sizeof(uint32_t) <= size_bytes; i += sizeof(uint32_t)) {
+            uint32_t word;
+            memcpy(&word, &data[i], sizeof(uint32_t));
+            const uint32_t shifted = (word << offset) | carry;
+            carry = word >> (word_bits - offset);
+            memcpy(&dst[i], &shifted, sizeof(uint32_t));
+        }
+
+        for(; i < size_bytes; i++) {
+            const uint32_t shifted = ((uint32_t)data[i] << offset) | carry;
+            dst[i] = shifted;
+            carry = shifted >> BITS_IN_BYTE;
+        }
+
+        if((offset + size_bits + BITS_IN_BYTE - 1) / BITS_IN_BYTE > size_bytes) {
+            dst[size_bytes] = carry;
+        }
+    }
+
+    buf->size_bits += size_bits;
+    bit_buffer_clear_tail(buf->data, buf->size_bits);
+}
@@ -165,6 +165,27 @@ void bit_buffer_write_bytes_mid(
 
 // Checks
 
+/** Write a slice of BitBuffer instance's contents starting at an arbitrary
+ * bit to an arbitrary memory location.
+ *
+ * The slice is aligned to the first destination byte, unused bits of the last
+ * byte are set to zero.
+ *
+ * @warning    The destination memory must be allocated. Additionally, the
+ *             destination capacity must be no less than the requested slice
+ *             size, rounded up to bytes.
+ *
+ * @param[in]  buf               pointer to a BitBuffer instance to write from
+ * @param[out] dest              pointer to the destination memory location
+ * @param[in]  start_index_bits  index of the first bit to copy
+ * @param[in]  size_bits         data slice size, in bits
+ */
+void bit_buffer_write_bits_mid(
+    const BitBuffer* buf,
+    void* dest,
+    size_t start_index_bits,
+    size_t size_bits);
+
 /** Check whether a BitBuffer instance contains a partial byte (i.e.\ the bit
  * count is not divisible by 8).
  *
@@ -358,6 +379,20 @@ void bit_buffer_append_bytes(BitBuffer* buf, const uint8_t* data, size_t size_by
  */
 void bit_buffer_append_bit(BitBuffer* buf, bool bit);
 
+/** Append bits from a byte array to a BitBuffer instance.
+ *
+ * Bits are taken LSB first, as bit_buffer_append_bit() does, and may start at
+ * any bit position in the destination.
+ *
+ * @warning       The destination capacity must be sufficient to accommodate the
+ *                additional data.
+ *
+ * @param[in,out] buf        pointer to a BitBuffer instance to be appended to
+ * @param[in]     data       pointer to the byte array to be appended
+ * @param[in]     size_bits  size of the data to be appended, in bits
+ */
+void bit_buffer_append_bits(BitBuffer* buf, const uint8_t* data, size_t size_bits);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,6 +15,9 @@
 
 #define COMPRESS_ICON_ENCODED_BUFF_SIZE (256u)
 
+/** Decoded icon cache slots, limits cache lookup time */
+#define COMPRESS_ICON_CACHE_SLOTS (16u)
+
 const CompressConfigHeatshrink compress_config_heatshrink_default = {
     .window_sz2 = COMPRESS_EXP_BUFF_SIZE_LOG,
     .lookahead_sz2 = COMPRESS_LOOKAHEAD_BUFF_SIZE_LOG,
@@ -38,10 +41,21 @@ typedef struct {
 
 _Static_assert(sizeof(CompressHeader) == 4, "Incorrect CompressHeader size");
 
+typedef struct {
+    const uint8_t* icon_data;
+    uint8_t* data;
+    size_t size;
+    uint32_t last_used;
+} CompressIconCacheEntry;
+
 struct CompressIcon {
     heatshrink_decoder* decoder;
     uint8_t* buffer;
     size_t buffer_size;
+    CompressIconCacheEntry cache[COMPRESS_ICON_CACHE_SLOTS];
+    size_t cache_size;
+    size_t cache_used;
+    uint32_t cache_counter;
 };
 
 CompressIcon* compress_icon_alloc(size_t decode_buf_size) {
@@ -58,8 +72,32 @@ CompressIcon* compress_icon_alloc(size_t decode_buf_size) {
     return instance;
 }
 
+static void compress_icon_cache_evict(CompressIcon* instance, CompressIconCacheEntry* entry) {
+    instance->cache_used -= entry->size;
+    free(entry->data);
+    memset(entry, 0, sizeof(CompressIconCacheEntry));
+}
+
+static void compress_icon_cache_trim(CompressIcon* instance, size_t cache_size) {
+    while(instance->cache_used > cache_size) {
+        CompressIconCacheEntry* lru = NULL;
+        for(size_t i = 0; i < COMPRESS_ICON_CACHE_SLOTS; i++) {
+            CompressIconCacheEntry* entry = &instance->cache[i];
+            if(entry->data && (!lru || entry->last_used < lru->last_used)) lru = entry;
+        }
+        compress_icon_cache_evict(instance, lru);
+    }
+}
+
+void compress_icon_set_cache_size(CompressIcon* instance, size_t cache_size) {
+    furi_check(instance);
+    compress_icon_cache_trim(instance, cache_size);
+    instance->cache_size = cache_size;
+}
+
 void compress_icon_free(CompressIcon* instance) {
     furi_check(instance);
+    compress_icon_cache_trim(instance, 0);
     free(instance->buffer);
     heatshrink_decoder_free(instance->decoder);
     free(instance);
@@ -88,6 +126,61 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
     }
 }
 
+void compress_icon_decode_cached(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    uint8_t** output) {
+    furi_check(instance);
+    furi_check(icon_data);
+    furi_check(output);
+
+    const CompressHeader* header = (const CompressHeader*)icon_data;
+    if(!header->is_compressed || !instance->cache_size) {
+        compress_icon_decode(instance, icon_data, output);
+        return;
+    }
+
+    CompressIconCacheEntry* free_entry = NULL;
+    for(size_t i = 0; i < COMPRESS_ICON_CACHE_SLOTS; i++) {
+        CompressIconCacheEntry* entry = &instance->cache[i];
+        if(entry->icon_data == icon_data) {
+            entry->last_used = ++instance->cache_counter;
+            *output = entry->data;
+            return;
+        } else if(!entry->data && !free_entry) {
+            free_entry = entry;
+        }
+    }
+
+    size_t decoded_size = 0;
+    furi_check(compress_decode_internal(
+        instance->decoder,
+        icon_data,
+        sizeof(CompressHeader) + header->compressed_buff_size,
+        instance->buffer,
+        instance->buffer_size,
+        &decoded_size));
+    *output = instance->buffer;
+
+    if(!decoded_size || decoded_size > instance->cache_size) return;
+
+    // Make room: slot first, then space
+    if(!free_entry) {
+        compress_icon_cache_trim(instance, instance->cache_used - 1);
+        for(size_t i = 0; !free_entry && i < COMPRESS_ICON_CACHE_SLOTS; i++) {
+            if(!instance->cache[i].data) free_entry = &instance->cache[i];
+        }
+    }
+    compress_icon_cache_trim(instance, instance->cache_size - decoded_size);
+
+    free_entry->icon_data = icon_data;
+    free_entry->data = malloc(decoded_size);
+    free_entry->size = decoded_size;
+    free_entry->last_used = ++instance->cache_counter;
+    memcpy(free_entry->data, instance->buffer, decoded_size);
+    instance->cache_used += decoded_size;
+}
+
 struct Compress {
     const void* config;
     heatshrink_encoder* encoder;
@@ -404,6 +497,130 @@ bool compress_decode_streamed(
         write_context);
 }
 
+_Static_assert(sizeof(CompressBlockFooter) == 16, "Incorrect CompressBlockFooter size");
+
+static bool compress_encoder_drain(
+    heatshrink_encoder* encoder,
+    uint8_t* work_buffer,
+    size_t work_buffer_size,
+    CompressIoCallback write_cb,
+    void* write_context,
+    size_t* written) {
+    HSE_poll_res poll_res;
+    size_t poll_size;
+
+    do {
+        poll_res = heatshrink_encoder_poll(encoder, work_buffer, work_buffer_size, &poll_size);
+        if(poll_res < 0) {
+            return false;
+        }
+        if(poll_size) {
+            if(write_cb(write_context, work_buffer, poll_size) != (int32_t)poll_size) {
+                return false;
+            }
+            *written += poll_size;
+        }
+    } while(poll_res == HSER_POLL_MORE);
+
+    return true;
+}
+
+static bool compress_encode_block(
+    heatshrink_encoder* encoder,
+    const uint8_t* data_in,
+    size_t data_in_size,
+    uint8_t* work_buffer,
+    size_t work_buffer_size,
+    CompressIoCallback write_cb,
+    void* write_context,
+    size_t* written) {
+    size_t sunk = 0;
+
+    heatshrink_encoder_reset(encoder);
+    while(sunk < data_in_size) {
+        size_t sink_size = 0;
+        if(heatshrink_encoder_sink(
+               encoder, (uint8_t*)&data_in[sunk], data_in_size - sunk, &sink_size) !=
+           HSER_SINK_OK) {
+            return false;
+        }
+        sunk += sink_size;
+        if(!compress_encoder_drain(
+               encoder, work_buffer, work_buffer_size, write_cb, write_context, written)) {
+            return false;
+        }
+    }
+
+    HSE_finish_res finish_res;
+    while((finish_res = heatshrink_encoder_finish(encoder)) == HSER_FINISH_MORE) {
+        if(!compress_encoder_drain(
+               encoder, work_buffer, work_buffer_size, write_cb, write_context, written)) {
+            return false;
+        }
+    }
+
+    return finish_res == HSER_FINISH_DONE;
+}
+
+bool compress_encode_blocks(
+    Compress* compress,
+    size_t block_size,
+    const uint8_t* data_in,
+    size_t data_in_size,
+    CompressIoCallback write_cb,
+    void* write_context) {
+    furi_check(compress);
+    furi_check(block_size);
+    furi_check(data_in || !data_in_size);
+    furi_check(write_cb);
+
+    const CompressConfigHeatshrink* hs_config = compress->config;
+    if(!compress->encoder) {
+        compress->encoder =
+            heatshrink_encoder_alloc(hs_config->window_sz2, hs_config->lookahead_sz2);
+    }
+
+    const size_t block_count = (data_in_size + block_size - 1) / block_size;
+    uint32_t* offsets = malloc(block_count * sizeof(uint32_t));
+    uint8_t* work_buffer = malloc(hs_config->input_buffer_sz);
+    size_t written = 0;
+    bool success = true;
+
+    for(size_t i = 0; success && i < block_count; i++) {
+        const size_t offset = i * block_size;
+        offsets[i] = written;
+        success = compress_encode_block(
+            compress->encoder,
+            &data_in[offset],
+            MIN(block_size, data_in_size - offset),
+            work_buffer,
+            hs_config->input_buffer_sz,
+            write_cb,
+            write_context,
+            &written);
+    }
+
+    const CompressBlockFooter footer = {
+        .magic = COMPRESS_BLOCK_FOOTER_MAGIC,
+        .block_size = block_size,
+        .block_count = block_count,
+        .data_size = data_in_size,
+    };
+    const int32_t index_size = block_count * sizeof(uint32_t);
+
+    if(success && index_size) {
+        success = write_cb(write_context, (uint8_t*)offsets, index_size) == index_size;
+    }
+    if(success) {
+        success = write_cb(write_context, (uint8_t*)&footer, sizeof(footer)) == sizeof(footer);
+    }
+
+    free(work_buffer);
+    free(offsets);
+
+    return success;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 struct CompressStreamDecoder {
@@ -414,8 +631,18 @@ struct CompressStreamDecoder {
     uint8_t* decode_buffer;
     CompressIoCallback read_cb;
     void* read_context;
+    /* Block index, only present for block framed streams */
+    CompressSeekCallback seek_cb;
+    uint32_t* block_offsets;
+    size_t block_count;
+    size_t block_size;
+    size_t data_size;
+    size_t current_block;
+    size_t block_input_left;
 };
 
+#define COMPRESS_BLOCK_NONE SIZE_MAX
+
 CompressStreamDecoder* compress_stream_decoder_alloc(
     CompressType type,
     const void* config,
@@ -434,6 +661,9 @@ CompressStreamDecoder* compress_stream_decoder_alloc(
     instance->decode_buffer = malloc(hs_config->input_buffer_sz);
     instance->read_cb = read_cb;
     instance->read_context = read_context;
+    instance->seek_cb = NULL;
+    instance->block_offsets = NULL;
+    instance->current_block = COMPRESS_BLOCK_NONE;
 
     return instance;
 }
@@ -441,10 +671,112 @@ CompressStreamDecoder* compress_stream_decoder_alloc(
 void compress_stream_decoder_free(CompressStreamDecoder* instance) {
     furi_check(instance);
     heatshrink_decoder_free(instance->decoder);
+    free(instance->block_offsets);
     free(instance->decode_buffer);
     free(instance);
 }
 
+static bool compress_stream_decoder_read_exact(
+    CompressStreamDecoder* instance,
+    size_t offset,
+    void* data,
+    size_t size) {
+    if(!instance->seek_cb(instance->read_context, offset)) return false;
+
+    uint8_t* data_ptr = data;
+    while(size) {
+        int32_t read_size = instance->read_cb(instance->read_context, data_ptr, size);
+        if(read_size <= 0) return false;
+        data_ptr += read_size;
+        size -= read_size;
+    }
+
+    return true;
+}
+
+bool compress_stream_decoder_load_index(
+    CompressStreamDecoder* instance,
+    CompressSeekCallback seek_cb,
+    size_t stream_size) {
+    furi_check(instance);
+    furi_check(seek_cb);
+
+    free(instance->block_offsets);
+    instance->block_offsets = NULL;
+    instance->seek_cb = seek_cb;
+
+    CompressBlockFooter footer;
+    if(stream_size < sizeof(footer) ||
+       !compress_stream_decoder_read_exact(
+           instance, stream_size - sizeof(footer), &footer, sizeof(footer))) {
+        return false;
+    }
+
+    const size_t index_size = footer.block_count * sizeof(uint32_t);
+    if(footer.magic != COMPRESS_BLOCK_FOOTER_MAGIC || !footer.block_size ||
+       footer.block_count != (footer.data_size + footer.block_size - 1) / footer.block_size ||
+       index_size > stream_size - sizeof(footer)) {
+        FURI_LOG_E(TAG, "Invalid block footer");
+        return false;
+    }
+
+    // Extra entry marks the end of the last block
+    const size_t index_offset = stream_size - sizeof(footer) - index_size;
+    uint32_t* offsets = malloc(index_size + sizeof(uint32_t));
+    offsets[footer.block_count] = index_offset;
+
+    bool success = !index_size ||
+                   compress_stream_decoder_read_exact(instance, index_offset, offsets, index_size);
+    for(size_t i = 0; success && i < footer.block_count; i++) {
+        success = offsets[i] <= offsets[i + 1];
+    }
+
+    if(success) {
+        instance->block_offsets = offsets;
+        instance->block_count = footer.block_count;
+        instance->block_size = footer.block_size;
+        instance->data_size = footer.data_size;
+        compress_stream_decoder_rewind(instance);
+    } else {
+        FURI_LOG_E(TAG, "Invalid block index");
+        free(offsets);
+    }
+
+    return success;
+}
+
+static int32_t compress_stream_decoder_block_read_cb(void* context, uint8_t* buffer, size_t size) {
+    CompressStreamDecoder* instance = context;
+
+    /* Next block is a separate heatshrink stream, don't feed it to the decoder */
+    size = MIN(size, instance->block_input_left);
+    if(!size) return 0;
+
+    int32_t read_size = instance->read_cb(instance->read_context, buffer, size);
+    if(read_size <= 0) {
+        /* Truncated block fails decoding just like a read error */
+        return 0;
+    }
+    instance->block_input_left -= read_size;
+    return read_size;
+}
+
+static bool compress_stream_decoder_load_block(CompressStreamDecoder* instance, size_t block) {
+    instance->current_block = COMPRESS_BLOCK_NONE;
+    if(!instance->seek_cb(instance->read_context, instance->block_offsets[block])) {
+        return false;
+    }
+
+    heatshrink_decoder_reset(instance->decoder);
+    instance->decode_buffer_position = 0;
+    instance->block_input_left =
+        instance->block_offsets[block + 1] - instance->block_offsets[block];
+    instance->stream_position = block * instance->block_size;
+    instance->current_block = block;
+
+    return true;
+}
+
 static bool compress_decode_stream_chunk(
     CompressStreamDecoder* sd,
     CompressIoCallback read_cb,
@@ -493,6 +825,11 @@ static bool compress_decode_stream_chunk(
             can_read_more = read_size > 0;
         }
 
+        /* Input is exhausted and everything sunk was polled out already */
+        if(!can_read_more && !sd->decode_buffer_position) {
+            break;
+        }
+
         while(sd->decode_buffer_position && can_sink_more) {
             size_t sink_size = 0;
             sink_res = heatshrink_decoder_sink(
@@ -522,6 +859,38 @@ bool compress_stream_decoder_read(
     furi_check(instance);
     furi_check(data_out);
 
+    if(instance->block_offsets) {
+        if(data_out_size > instance->data_size - instance->stream_position) {
+            return false;
+        }
+
+        while(data_out_size) {
+            const size_t block = instance->stream_position / instance->block_size;
+            if(block != instance->current_block &&
+               !compress_stream_decoder_load_block(instance, block)) {
+                return false;
+            }
+
+            const size_t chunk_size = MIN(
+                data_out_size, (block + 1) * instance->block_size - instance->stream_position);
+            if(!compress_decode_stream_chunk(
+                   instance,
+                   compress_stream_decoder_block_read_cb,
+                   instance,
+                   data_out,
+                   chunk_size)) {
+                instance->current_block = COMPRESS_BLOCK_NONE;
+                return false;
+            }
+
+            instance->stream_position += chunk_size;
+            data_out += chunk_size;
+            data_out_size -= chunk_size;
+        }
+
+        return true;
+    }
+
     if(compress_decode_stream_chunk(
            instance, instance->read_cb, instance->read_context, data_out, data_out_size)) {
         instance->stream_position += data_out_size;
@@ -533,6 +902,20 @@ bool compress_stream_decoder_read(
 bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t position) {
     furi_check(instance);
 
+    if(instance->block_offsets) {
+        if(position > instance->data_size) {
+            return false;
+        }
+
+        /* Restart from the block holding the position, unless it is just ahead */
+        const size_t block = position / instance->block_size;
+        if(block < instance->block_count &&
+           (block != instance->current_block || position < instance->stream_position) &&
+           !compress_stream_decoder_load_block(instance, block)) {
+            return false;
+        }
+    }
+
     /* Check if requested position is ahead of current position 
        we can't rewind the input stream */
     furi_check(position >= instance->stream_position);
@@ -568,6 +951,8 @@ bool compress_stream_decoder_rewind(CompressStreamDecoder* instance) {
     heatshrink_decoder_reset(instance->decoder);
     instance->stream_position = 0;
     instance->decode_buffer_position = 0;
+    /* Block framed stream repositions input on the next read */
+    instance->current_block = COMPRESS_BLOCK_NONE;
 
     return true;
 }
@@ -44,6 +44,34 @@ void compress_icon_free(CompressIcon* instance);
  */
 void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint8_t** output);
 
+/** Set size of decoded icon cache
+ *
+ * Cache is used by `compress_icon_decode_cached` only, least recently used
+ * icons are evicted first. Icons bigger than the cache are never cached.
+ *
+ * @param      instance    The Compress Icon instance
+ * @param[in]  cache_size  The cache size in bytes, 0 to disable and free cache
+ */
+void compress_icon_set_cache_size(CompressIcon* instance, size_t cache_size);
+
+/** Decompress icon, reusing previously decoded data if possible
+ *
+ * Cache is keyed by icon_data pointer, so data behind it must never change
+ * or be freed: use it for icons placed in firmware flash only.
+ *
+ * @warning    output pointer set by this function is valid till next
+ *             `compress_icon_decode`, `compress_icon_decode_cached` or
+ *             `compress_icon_free` call
+ *
+ * @param      instance   The Compress Icon instance
+ * @param      icon_data  pointer to immutable icon data
+ * @param[in]  output     pointer to decoded buffer pointer
+ */
+void compress_icon_decode_cached(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    uint8_t** output);
+
 //////////////////////////////////////////////////////////////////////////
 
 /** Compress control structure */
@@ -130,6 +158,15 @@ bool compress_decode(
  */
 typedef int32_t (*CompressIoCallback)(void* context, uint8_t* buffer, size_t size);
 
+/** Seek callback for block framed streams
+ *
+ * @param context user context
+ * @param offset absolute offset in the block framed stream
+ *
+ * @return true on success
+ */
+typedef bool (*CompressSeekCallback)(void* context, size_t offset);
+
 /** Decompress streamed data
  *
  * @param      compress       Compress instance
@@ -148,6 +185,46 @@ bool compress_decode_streamed(
     CompressIoCallback write_cb,
     void* write_context);
 
+/** Encode data into block framed stream
+ *
+ * Block framed stream is a sequence of independently compressed heatshrink
+ * streams, each one decoding to `block_size` bytes (the last one may be
+ * shorter), followed by an index of block offsets and a footer:
+ *
+ *     block[0] ... block[n-1] | uint32_t offset[n] | CompressBlockFooter
+ *
+ * All values are little endian, offsets count from the start of the first
+ * block. Seeking in such stream costs at most one block of decoding.
+ *
+ * @param      compress       Compress instance
+ * @param[in]  block_size     uncompressed block size, bigger blocks compress better
+ * @param      data_in        pointer to input data
+ * @param      data_in_size   size of input data
+ * @param      write_cb       write callback
+ * @param      write_context  write callback context
+ *
+ * @note       Does not write a header, just compressed data stream.
+ * @return     true on success
+ */
+bool compress_encode_blocks(
+    Compress* compress,
+    size_t block_size,
+    const uint8_t* data_in,
+    size_t data_in_size,
+    CompressIoCallback write_cb,
+    void* write_context);
+
+/** Block framed stream footer magic: "HSBF" */
+#define COMPRESS_BLOCK_FOOTER_MAGIC (0x46425348UL)
+
+/** Block framed stream footer, placed at the very end of the stream */
+typedef struct {
+    uint32_t magic;
+    uint32_t block_size; /**< Uncompressed size of every block but the last one */
+    uint32_t block_count;
+    uint32_t data_size; /**< Uncompressed size of the whole stream */
+} CompressBlockFooter;
+
 //////////////////////////////////////////////////////////////////////////
 
 /** CompressStreamDecoder control structure */
@@ -174,6 +251,23 @@ CompressStreamDecoder* compress_stream_decoder_alloc(
  */
 void compress_stream_decoder_free(CompressStreamDecoder* instance);
 
+/** Load block index of a block framed stream
+ *
+ * Reads footer and block index from the end of the stream. Once loaded,
+ * decoder repositions read callback on its own: seeking works in both
+ * directions and costs at most one block of decoding.
+ *
+ * @param      instance     The CompressStreamDecoder instance
+ * @param      seek_cb      The seek callback for input data, gets read context
+ * @param[in]  stream_size  The size of the whole block framed stream
+ *
+ * @return     true if stream is block framed and has a valid index
+ */
+bool compress_stream_decoder_load_index(
+    CompressStreamDecoder* instance,
+    CompressSeekCallback seek_cb,
+    size_t stream_size);
+
 /** Read uncompressed data chunk from stream decoder
  *
  * @param      instance       The CompressStreamDecoder instance
@@ -193,7 +287,8 @@ bool compress_stream_decoder_read(
  * @param[in]  position   The position
  * 
  * @return     true on success
- * @warning    Backward seeking is not supported
+ * @warning    Backward seeking is only supported for block framed streams
+ *             with loaded index
  */
 bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t position);
 
@@ -206,7 +301,8 @@ bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t positi
 size_t compress_stream_decoder_tell(CompressStreamDecoder* instance);
 
 /** Reset stream decoder to the beginning
- * @warning    Read callback must be repositioned by caller separately
+ * @warning    Read callback must be repositioned by caller separately, unless
+ *             block index is loaded
  *
  * @param      instance  The CompressStreamDecoder instance
  *
@@ -1,6 +1,8 @@
 #include "dir_walk.h"
 #include <m-list.h>
 
+#define DIR_WALK_READ_BATCH_SIZE 8
+
 LIST_DEF(DirIndexList, uint32_t);
 
 struct DirWalk {
@@ -11,6 +13,12 @@ struct DirWalk {
     bool recursive;
     DirWalkFilterCb filter_cb;
     void* filter_context;
+
+    // Read ahead of the open directory, one storage request per batch
+    StorageDirItem* items;
+    size_t item_count;
+    size_t item_pos;
+    bool items_last;
 };
 
 DirWalk* dir_walk_alloc(Storage* storage) {
@@ -22,6 +30,10 @@ DirWalk* dir_walk_alloc(Storage* storage) {
     DirIndexList_init(dir_walk->index_list);
     dir_walk->recursive = true;
     dir_walk->filter_cb = NULL;
+    dir_walk->items = malloc(sizeof(StorageDirItem) * DIR_WALK_READ_BATCH_SIZE);
+    dir_walk->item_count = 0;
+    dir_walk->item_pos = 0;
+    dir_walk->items_last = false;
     return dir_walk;
 }
 
@@ -31,6 +43,7 @@ void dir_walk_free(DirWalk* dir_walk) {
     storage_file_free(dir_walk->file);
     furi_string_free(dir_walk->path);
     DirIndexList_clear(dir_walk->index_list);
+    free(dir_walk->items);
     free(dir_walk);
 }
 
@@ -45,10 +58,17 @@ void dir_walk_set_filter_cb(DirWalk* dir_walk, DirWalkFilterCb cb, void* context
     dir_walk->filter_context = context;
 }
 
+static void dir_walk_items_reset(DirWalk* dir_walk) {
+    dir_walk->item_count = 0;
+    dir_walk->item_pos = 0;
+    dir_walk->items_last = false;
+}
+
 bool dir_walk_open(DirWalk* dir_walk, const char* path) {
     furi_check(dir_walk);
     furi_string_set(dir_walk->path, path);
     dir_walk->current_index = 0;
+    dir_walk_items_reset(dir_walk);
     return storage_dir_open(dir_walk->file, path);
 }
 
@@ -60,46 +80,74 @@ static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* filei
     }
 }
 
+static void dir_walk_reopen(DirWalk* dir_walk) {
+    storage_dir_close(dir_walk->file);
+    dir_walk_items_reset(dir_walk);
+    storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+}
+
+// Skip directory items, in a single storage request
+static bool dir_walk_skip(DirWalk* dir_walk, uint32_t count) {
+    const size_t done = storage_dir_read_many(dir_walk->file, NULL, count, NULL);
+    dir_walk->current_index += done;
+    return done == count;
+}
+
+// Next item of the open directory, file error is returned when there is none
+static FS_Error dir_walk_next_item(DirWalk* dir_walk, StorageDirItem** item) {
+    if(dir_walk->item_pos == dir_walk->item_count) {
+        if(dir_walk->items_last) return storage_file_get_error(dir_walk->file);
+
+        dir_walk->item_count = storage_dir_read_many(
+            dir_walk->file, dir_walk->items, DIR_WALK_READ_BATCH_SIZE, NULL);
+        dir_walk->item_pos = 0;
+        dir_walk->items_last = dir_walk->item_count < DIR_WALK_READ_BATCH_SIZE;
+
+        if(dir_walk->item_count == 0) return storage_file_get_error(dir_walk->file);
+    }
+
+    *item = &dir_walk->items[dir_walk->item_pos++];
+    return FSE_OK;
+}
+
 static DirWalkResult
     dir_walk_iter(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
     DirWalkResult result = DirWalkError;
-    char* name = malloc(256); // FIXME: remove magic number
-    FileInfo info;
+    StorageDirItem* item = NULL;
     bool end = false;
 
     while(!end) {
-        storage_dir_read(dir_walk->file, &info, name, 255);
+        const FS_Error error = dir_walk_next_item(dir_walk, &item);
 
-        if(storage_file_get_error(dir_walk->file) == FSE_OK) {
+        if(error == FSE_OK) {
             result = DirWalkOK;
             dir_walk->current_index++;
 
-            if(dir_walk_filter(dir_walk, name, &info)) {
+            if(dir_walk_filter(dir_walk, item->name, &item->fileinfo)) {
                 if(return_path != NULL) {
                     furi_string_printf( //-V576
                         return_path,
                         "%s/%s",
                         furi_string_get_cstr(dir_walk->path),
-                        name);
+                        item->name);
                 }
 
                 if(fileinfo != NULL) {
-                    memcpy(fileinfo, &info, sizeof(FileInfo));
+                    memcpy(fileinfo, &item->fileinfo, sizeof(FileInfo));
                 }
 
                 end = true;
             }
 
-            if(file_info_is_dir(&info) && dir_walk->recursive) {
+            if(file_info_is_dir(&item->fileinfo) && dir_walk->recursive) {
                 // step into
                 DirIndexList_push_back(dir_walk->index_list, dir_walk->current_index);
                 dir_walk->current_index = 0;
-                storage_dir_close(dir_walk->file);
 
-                furi_string_cat_printf(dir_walk->path, "/%s", name);
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+                furi_string_cat_printf(dir_walk->path, "/%s", item->name);
+                dir_walk_reopen(dir_walk);
             }
-        } else if(storage_file_get_error(dir_walk->file) == FSE_NOT_EXIST) {
+        } else if(error == FSE_NOT_EXIST) {
             if(DirIndexList_size(dir_walk->index_list) == 0) {
                 // last
                 result = DirWalkLast;
@@ -110,29 +158,19 @@ static DirWalkResult
                 DirIndexList_pop_back(&index, dir_walk->index_list);
                 dir_walk->current_index = 0;
 
-                storage_dir_close(dir_walk->file);
-
                 size_t last_char = furi_string_search_rchar(dir_walk->path, '/');
                 if(last_char != FURI_STRING_FAILURE) {
                     furi_string_left(dir_walk->path, last_char);
                 }
 
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+                dir_walk_reopen(dir_walk);
 
                 // rewind
-                while(true) {
-                    if(index == dir_walk->current_index) {
-                        result = DirWalkOK;
-                        break;
-                    }
-
-                    if(!storage_dir_read(dir_walk->file, &info, name, 255)) {
-                        result = DirWalkError;
-                        end = true;
-                        break;
-                    }
-
-                    dir_walk->current_index++;
+                if(dir_walk_skip(dir_walk, index)) {
+                    result = DirWalkOK;
+                } else {
+                    result = DirWalkError;
+                    end = true;
                 }
             }
         } else {
@@ -141,7 +179,6 @@ static DirWalkResult
         }
     }
 
-    free(name);
     return result;
 }
 
@@ -164,4 +201,5 @@ void dir_walk_close(DirWalk* dir_walk) {
     DirIndexList_reset(dir_walk->index_list);
     furi_string_reset(dir_walk->path);
     dir_walk->current_index = 0;
+    dir_walk_items_reset(dir_walk);
 }
@@ -0,0 +1,491 @@
+#include "flash_kv.h"
+
+#include <furi.h>
+#include <furi_hal_flash.h>
+#include <furi_hal_rtc.h>
+
+#include "crc32_calc.h"
+
+#define TAG "FlashKv"
+
+#define FLASH_KV_PAGES      (3U)
+#define FLASH_KV_INDEX_SIZE (32U)
+
+#define FLASH_KV_PAGE_MAGIC   (0x564B4C46UL)
+#define FLASH_KV_RECORD_MAGIC (0x4B56U)
+
+#define FLASH_KV_RECORD_FLAG_REMOVED (1U << 0)
+
+#define FLASH_KV_DWORD_SIZE (sizeof(uint64_t))
+#define FLASH_KV_ERASED_DWORD (UINT64_MAX)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+} FlashKvPageHeader;
+
+/* Record in flash: header, key, data, padded to dword. First dword is written first,
+ * crc is written last and commits the record. */
+typedef struct {
+    uint16_t magic;
+    uint8_t key_size;
+    uint8_t flags;
+    uint16_t data_size;
+    uint16_t reserved;
+    uint32_t crc;
+    uint32_t reserved2;
+} FlashKvRecordHeader;
+
+_Static_assert(sizeof(FlashKvPageHeader) == FLASH_KV_DWORD_SIZE, "Invalid FlashKvPageHeader size");
+_Static_assert(
+    sizeof(FlashKvRecordHeader) == FLASH_KV_DWORD_SIZE * 2,
+    "Invalid FlashKvRecordHeader size");
+
+typedef enum {
+    FlashKvPageStateErased,
+    FlashKvPageStateDirty,
+    FlashKvPageStateUsed,
+} FlashKvPageState;
+
+typedef struct {
+    size_t address;
+    uint32_t key_hash;
+} FlashKvIndexEntry;
+
+typedef struct {
+    bool initialized;
+    bool available;
+    size_t base;
+    size_t page_size;
+    FlashKvPageState state[FLASH_KV_PAGES];
+    uint32_t sequence[FLASH_KV_PAGES];
+    uint32_t last_sequence;
+    size_t head;
+    size_t offset;
+    FlashKvIndexEntry index[FLASH_KV_INDEX_SIZE];
+    size_t index_count;
+} FlashKv;
+
+static FlashKv flash_kv = {0};
+static FuriMutex* flash_kv_mutex = NULL;
+
+static size_t flash_kv_record_size(size_t key_size, size_t data_size) {
+    return ROUND_UP_TO(sizeof(FlashKvRecordHeader) + key_size + data_size, FLASH_KV_DWORD_SIZE) *
+           FLASH_KV_DWORD_SIZE;
+}
+
+static inline const FlashKvRecordHeader* flash_kv_record(size_t address) {
+    return (const FlashKvRecordHeader*)address;
+}
+
+static inline const uint8_t* flash_kv_record_key(const FlashKvRecordHeader* record) {
+    return (const uint8_t*)record + sizeof(FlashKvRecordHeader);
+}
+
+static inline const uint8_t* flash_kv_record_data(const FlashKvRecordHeader* record) {
+    return flash_kv_record_key(record) + record->key_size;
+}
+
+static uint32_t flash_kv_record_crc(const FlashKvRecordHeader* record) {
+    // First dword, key and data, so that a torn header is caught too
+    uint32_t crc = crc32_calc_buffer(0, record, FLASH_KV_DWORD_SIZE);
+    return crc32_calc_buffer(
+        crc, flash_kv_record_key(record), record->key_size + record->data_size);
+}
+
+static uint32_t flash_kv_hash(const char* key, size_t key_size) {
+    // FNV-1a
+    uint32_t hash = 0x811C9DC5UL;
+    for(size_t i = 0; i < key_size; i++) {
+        hash = (hash ^ (uint8_t)key[i]) * 0x01000193UL;
+    }
+    return hash;
+}
+
+static inline size_t flash_kv_page_address(size_t page) {
+    return flash_kv.base + page * flash_kv.page_size;
+}
+
+static bool flash_kv_is_erased(size_t address, size_t size) {
+    const uint64_t* dword = (const uint64_t*)address;
+    for(size_t i = 0; i < size / FLASH_KV_DWORD_SIZE; i++) {
+        if(dword[i] != FLASH_KV_ERASED_DWORD) return false;
+    }
+    return true;
+}
+
+static void flash_kv_page_erase(size_t page) {
+    const size_t address = flash_kv_page_address(page);
+    if(!flash_kv_is_erased(address, flash_kv.page_size)) {
+        furi_hal_flash_erase(furi_hal_flash_get_page_number(address));
+    }
+    flash_kv.state[page] = FlashKvPageStateErased;
+    flash_kv.sequence[page] = 0;
+}
+
+static FlashKvIndexEntry* flash_kv_index_find(const char* key, size_t key_size, uint32_t hash) {
+    for(size_t i = 0; i < flash_kv.index_count; i++) {
+        FlashKvIndexEntry* entry = &flash_kv.index[i];
+        if(entry->key_hash != hash) continue;
+
+        const FlashKvRecordHeader* record = flash_kv_record(entry->address);
+        if(record->key_size == key_size &&
+           memcmp(flash_kv_record_key(record), key, key_size) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static inline FlashKvIndexEntry* flash_kv_find(const char* key, size_t key_size) {
+    return flash_kv_index_find(key, key_size, flash_kv_hash(key, key_size));
+}
+
+static void flash_kv_index_apply(size_t address) {
+    const FlashKvRecordHeader* record = flash_kv_record(address);
+    const char* key = (const char*)flash_kv_record_key(record);
+    const uint32_t hash = flash_kv_hash(key, record->key_size);
+    FlashKvIndexEntry* entry = flash_kv_index_find(key, record->key_size, hash);
+
+    if(record->flags & FLASH_KV_RECORD_FLAG_REMOVED) {
+        if(entry) {
+            *entry = flash_kv.index[--flash_kv.index_count];
+        }
+    } else if(entry) {
+        entry->address = address;
+    } else if(flash_kv.index_count < FLASH_KV_INDEX_SIZE) {
+        entry = &flash_kv.index[flash_kv.index_count++];
+        entry->address = address;
+        entry->key_hash = hash;
+    } else {
+        FURI_LOG_E(TAG, "Index is full");
+    }
+}
+
+static size_t flash_kv_page_scan(size_t page) {
+    const size_t page_address = flash_kv_page_address(page);
+    size_t offset = sizeof(FlashKvPageHeader);
+
+    while(offset + sizeof(FlashKvRecordHeader) <= flash_kv.page_size) {
+        const FlashKvRecordHeader* record = flash_kv_record(page_address + offset);
+        // End of log
+        if(*(const uint64_t*)record == FLASH_KV_ERASED_DWORD) break;
+
+        const size_t size = flash_kv_record_size(record->key_size, record->data_size);
+        // Torn header, nothing after it can be trusted
+        if(record->magic != FLASH_KV_RECORD_MAGIC || record->key_size == 0 ||
+           record->key_size > FLASH_KV_KEY_SIZE_MAX ||
+           record->data_size > FLASH_KV_DATA_SIZE_MAX || offset + size > flash_kv.page_size) {
+            FURI_LOG_W(TAG, "Page %zu is damaged at %zu", page, offset);
+            return flash_kv.page_size;
+        }
+
+        // Records without valid crc were interrupted, skip them
+        if(record->crc == flash_kv_record_crc(record)) {
+            flash_kv_index_apply(page_address + offset);
+        }
+
+        offset += size;
+    }
+
+    return offset;
+}
+
+static void flash_kv_scan(void) {
+    size_t order[FLASH_KV_PAGES];
+    size_t used = 0;
+
+    for(size_t page = 0; page < FLASH_KV_PAGES; page++) {
+        const FlashKvPageHeader* header = (const FlashKvPageHeader*)flash_kv_page_address(page);
+        if(header->magic == FLASH_KV_PAGE_MAGIC && header->sequence != 0 &&
+           header->sequence != UINT32_MAX) {
+            flash_kv.state[page] = FlashKvPageStateUsed;
+            flash_kv.sequence[page] = header->sequence;
+
+            // Insert sorted by sequence, oldest first
+            size_t i = used++;
+            for(; i > 0 && flash_kv.sequence[order[i - 1]] > header->sequence; i--) {
+                order[i] = order[i - 1];
+            }
+            order[i] = page;
+        } else {
+            flash_kv.state[page] = (*(const uint64_t*)header == FLASH_KV_ERASED_DWORD) ?
+                                       FlashKvPageStateErased :
+                                       FlashKvPageStateDirty;
+            flash_kv.sequence[page] = 0;
+        }
+    }
+
+    flash_kv.head = FLASH_KV_PAGES;
+    flash_kv.offset = flash_kv.page_size;
+    flash_kv.last_sequence = 0;
+
+    // Replay oldest to newest, so the newest record of every key ends up in the index
+    for(size_t i = 0; i < used; i++) {
+        flash_kv.head = order[i];
+        flash_kv.offset = flash_kv_page_scan(order[i]);
+        flash_kv.last_sequence = flash_kv.sequence[order[i]];
+    }
+
+    FURI_LOG_I(TAG, "%zu values in %zu pages", flash_kv.index_count, used);
+}
+
+static void flash_kv_format_internal(void) {
+    for(size_t page = 0; page < FLASH_KV_PAGES; page++) {
+        flash_kv_page_erase(page);
+    }
+    flash_kv.index_count = 0;
+    flash_kv.head = FLASH_KV_PAGES;
+    flash_kv.offset = flash_kv.page_size;
+    flash_kv.last_sequence = 0;
+}
+
+static void flash_kv_lock(void) {
+    if(!flash_kv_mutex) {
+        FuriMutex* mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+        FuriMutex* expected = NULL;
+        if(!__atomic_compare_exchange_n(
+               &flash_kv_mutex, &expected, mutex, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            furi_mutex_free(mutex);
+        }
+    }
+    furi_check(furi_mutex_acquire(flash_kv_mutex, FuriWaitForever) == FuriStatusOk);
+
+    if(flash_kv.initialized) return;
+    flash_kv.initialized = true;
+
+#ifndef FURI_RAM_EXEC
+    flash_kv.page_size = furi_hal_flash_get_page_size();
+    // Only take pages that are free and not used by the radio stack
+    if(furi_hal_flash_get_free_page_count() >= FLASH_KV_PAGES) {
+        flash_kv.base = (size_t)furi_hal_flash_get_free_end_address() -
+                        FLASH_KV_PAGES * flash_kv.page_size;
+        flash_kv.available = true;
+    }
+#endif
+
+    if(!flash_kv.available) {
+        FURI_LOG_W(TAG, "No room in flash");
+    } else if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagStorageFormatInternal)) {
+        flash_kv_format_internal();
+    } else {
+        flash_kv_scan();
+    }
+}
+
+static void flash_kv_unlock(void) {
+    furi_check(furi_mutex_release(flash_kv_mutex) == FuriStatusOk);
+}
+
+static void flash_kv_program(size_t address, const uint8_t* record, size_t size) {
+    uint64_t dword;
+    // Payload and first dword go first, crc last
+    for(size_t offset = FLASH_KV_DWORD_SIZE * 2; offset < size; offset += FLASH_KV_DWORD_SIZE) {
+        memcpy(&dword, record + offset, FLASH_KV_DWORD_SIZE);
+        furi_hal_flash_write_dword(address + offset, dword);
+    }
+    memcpy(&dword, record, FLASH_KV_DWORD_SIZE);
+    furi_hal_flash_write_dword(address, dword);
+    memcpy(&dword, record + FLASH_KV_DWORD_SIZE, FLASH_KV_DWORD_SIZE);
+    furi_hal_flash_write_dword(address + FLASH_KV_DWORD_SIZE, dword);
+}
+
+static size_t flash_kv_pick_victim(void) {
+    size_t victim = FLASH_KV_PAGES;
+    for(size_t page = 0; page < FLASH_KV_PAGES; page++) {
+        if(flash_kv.state[page] != FlashKvPageStateUsed) return page;
+        if(victim == FLASH_KV_PAGES || flash_kv.sequence[page] < flash_kv.sequence[victim]) {
+            victim = page;
+        }
+    }
+    return victim;
+}
+
+/* Start a new head page with at least `size` bytes of room. The oldest page is
+ * reused, its live records are moved along. */
+static bool flash_kv_advance(size_t size) {
+    for(size_t attempt = 0; attempt < FLASH_KV_PAGES; attempt++) {
+        const size_t victim = flash_kv_pick_victim();
+        const size_t victim_address = flash_kv_page_address(victim);
+
+        // Take live records out before the page is erased
+        size_t moved[FLASH_KV_INDEX_SIZE];
+        size_t moved_count = 0;
+        size_t live_size = 0;
+        for(size_t i = 0; i < flash_kv.index_count; i++) {
+            const FlashKvIndexEntry* entry = &flash_kv.index[i];
+            if(entry->address < victim_address ||
+               entry->address >= victim_address + flash_kv.page_size)
+                continue;
+            const FlashKvRecordHeader* record = flash_kv_record(entry->address);
+            live_size += flash_kv_record_size(record->key_size, record->data_size);
+            moved[moved_count++] = i;
+        }
+
+        uint8_t* live = live_size ? malloc(live_size) : NULL;
+        size_t live_offset = 0;
+        for(size_t i = 0; i < moved_count; i++) {
+            const FlashKvRecordHeader* record =
+                flash_kv_record(flash_kv.index[moved[i]].address);
+            const size_t record_size = flash_kv_record_size(record->key_size, record->data_size);
+            memcpy(live + live_offset, record, record_size);
+            live_offset += record_size;
+        }
+
+        flash_kv_page_erase(victim);
+        const FlashKvPageHeader header = {
+            .magic = FLASH_KV_PAGE_MAGIC,
+            .sequence = ++flash_kv.last_sequence,
+        };
+        uint64_t dword;
+        memcpy(&dword, &header, sizeof(dword));
+        furi_hal_flash_write_dword(victim_address, dword);
+        flash_kv.state[victim] = FlashKvPageStateUsed;
+        flash_kv.sequence[victim] = header.sequence;
+        flash_kv.head = victim;
+        flash_kv.offset = sizeof(FlashKvPageHeader);
+
+        // Moved records are whole, crc included, and keep their index entries
+        live_offset = 0;
+        for(size_t i = 0; i < moved_count; i++) {
+            const uint8_t* record = live + live_offset;
+            const size_t record_size = flash_kv_record_size(
+                ((const FlashKvRecordHeader*)record)->key_size,
+                ((const FlashKvRecordHeader*)record)->data_size);
+            flash_kv_program(victim_address + flash_kv.offset, record, record_size);
+            flash_kv.index[moved[i]].address = victim_address + flash_kv.offset;
+            flash_kv.offset += record_size;
+            live_offset += record_size;
+        }
+        free(live);
+
+        if(flash_kv.offset + size <= flash_kv.page_size) return true;
+    }
+
+    FURI_LOG_E(TAG, "Out of space");
+    return false;
+}
+
+static bool flash_kv_append(
+    const char* key,
+    size_t key_size,
+    FlashKvIndexEntry* replaced,
+    uint8_t flags,
+    const void* data,
+    size_t data_size) {
+    const size_t size = flash_kv_record_size(key_size, data_size);
+
+    if(flash_kv.head >= FLASH_KV_PAGES || flash_kv.offset + size > flash_kv.page_size) {
+        if(!flash_kv_advance(size)) return false;
+    }
+
+    uint8_t* buffer = malloc(size);
+    memset(buffer, 0xFF, size);
+    FlashKvRecordHeader* record = (FlashKvRecordHeader*)buffer;
+    record->magic = FLASH_KV_RECORD_MAGIC;
+    record->key_size = key_size;
+    record->flags = flags;
+    record->data_size = data_size;
+    record->reserved = UINT16_MAX;
+    memcpy(buffer + sizeof(FlashKvRecordHeader), key, key_size);
+    if(data_size) memcpy(buffer + sizeof(FlashKvRecordHeader) + key_size, data, data_size);
+    record->crc = flash_kv_record_crc(record);
+    record->reserved2 = 0;
+
+    const size_t address = flash_kv_page_address(flash_kv.head) + flash_kv.offset;
+    flash_kv_program(address, buffer, size);
+    free(buffer);
+    flash_kv.offset += size;
+
+    // Moving records keeps index order, so replaced entry is still valid
+    if(!replaced) {
+        flash_kv_index_apply(address);
+    } else if(flags & FLASH_KV_RECORD_FLAG_REMOVED) {
+        *replaced = flash_kv.index[--flash_kv.index_count];
+    } else {
+        replaced->address = address;
+    }
+
+    return true;
+}
+
+size_t flash_kv_read(const char* key, void* data, size_t size) {
+    furi_check(key);
+    furi_check(data || !size);
+
+    const size_t key_size = strlen(key);
+    size_t result = 0;
+
+    flash_kv_lock();
+    FlashKvIndexEntry* entry = flash_kv.available ? flash_kv_find(key, key_size) : NULL;
+    if(entry) {
+        const FlashKvRecordHeader* record = flash_kv_record(entry->address);
+        result = record->data_size;
+        memcpy(data, flash_kv_record_data(record), MIN(size, result));
+    }
+    flash_kv_unlock();
+
+    return result;
+}
+
+bool flash_kv_write(const char* key, const void* data, size_t size) {
+    furi_check(key);
+    furi_check(data);
+
+    const size_t key_size = strlen(key);
+    furi_check(key_size > 0 && key_size <= FLASH_KV_KEY_SIZE_MAX);
+    furi_check(size > 0 && size <= FLASH_KV_DATA_SIZE_MAX);
+
+    bool result = false;
+
+    flash_kv_lock();
+    do {
+        if(!flash_kv.available) break;
+
+        FlashKvIndexEntry* entry = flash_kv_find(key, key_size);
+        if(entry) {
+            const FlashKvRecordHeader* record = flash_kv_record(entry->address);
+            // Same value, spare the flash
+            if(record->data_size == size &&
+               memcmp(flash_kv_record_data(record), data, size) == 0) {
+                result = true;
+                break;
+            }
+        } else if(flash_kv.index_count >= FLASH_KV_INDEX_SIZE) {
+            FURI_LOG_E(TAG, "Index is full");
+            break;
+        }
+
+        result = flash_kv_append(key, key_size, entry, 0, data, size);
+    } while(false);
+    flash_kv_unlock();
+
+    return result;
+}
+
+bool flash_kv_remove(const char* key) {
+    furi_check(key);
+
+    const size_t key_size = strlen(key);
+    bool result = true;
+
+    flash_kv_lock();
+    if(flash_kv.available && key_size > 0 && key_size <= FLASH_KV_KEY_SIZE_MAX) {
+        FlashKvIndexEntry* entry = flash_kv_find(key, key_size);
+        if(entry) {
+            result = flash_kv_append(key, key_size, entry, FLASH_KV_RECORD_FLAG_REMOVED, NULL, 0);
+        }
+    }
+    flash_kv_unlock();
+
+    return result;
+}
+
+void flash_kv_format(void) {
+    flash_kv_lock();
+    if(flash_kv.available) {
+        FURI_LOG_I(TAG, "Formatting");
+        flash_kv_format_internal();
+    }
+    flash_kv_unlock();
+}
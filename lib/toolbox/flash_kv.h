@@ -0,0 +1,65 @@
+/**
+ * @file flash_kv.h
+ * @brief FlashKv - small key/value store in internal flash
+ *
+ * Log structured store in the last free pages of internal flash, right below
+ * the radio stack. Records are appended, the pages are used as a ring so that
+ * wear is spread evenly, and live records of the oldest page are moved forward
+ * when it has to be erased. Value locations are kept in a RAM index, built
+ * once on first use, so reads are plain memory copies from flash.
+ *
+ * Meant for small hot settings. Content is lost if the radio stack grows over
+ * the store, so every value must have a copy elsewhere to fall back to.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum key length, without terminating zero */
+#define FLASH_KV_KEY_SIZE_MAX (63U)
+
+/** Maximum value size */
+#define FLASH_KV_DATA_SIZE_MAX (256U)
+
+/** Read value
+ *
+ * @param[in]  key   The key
+ * @param[out] data  Pointer to store value to, can be NULL if size is 0
+ * @param[in]  size  Maximum number of bytes to copy
+ *
+ * @return     stored value size, 0 if key is missing or store is unavailable
+ */
+size_t flash_kv_read(const char* key, void* data, size_t size);
+
+/** Write value
+ *
+ * Nothing is written if the stored value is the same.
+ *
+ * @param[in]  key   The key, up to FLASH_KV_KEY_SIZE_MAX characters
+ * @param[in]  data  Pointer to the value
+ * @param[in]  size  Value size, 1 to FLASH_KV_DATA_SIZE_MAX bytes
+ *
+ * @return     true on success, false if store is full or unavailable
+ */
+bool flash_kv_write(const char* key, const void* data, size_t size);
+
+/** Remove value
+ *
+ * @param[in]  key   The key
+ *
+ * @return     true if value is gone, false if it could not be removed
+ */
+bool flash_kv_remove(const char* key);
+
+/** Erase all values */
+void flash_kv_format(void);
+
+#ifdef __cplusplus
+}
+#endif
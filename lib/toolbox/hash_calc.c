@@ -0,0 +1,339 @@
+#include "hash_calc.h"
+#include "crc32_calc.h"
+
+#include <furi.h>
+#include <furi_hal_rtc.h>
+#include <mbedtls/md5.h>
+#include <mbedtls/sha256.h>
+
+#define TAG "HashCalc"
+
+#define HASH_CALC_BUFFER_SIZE  (4096U)
+#define HASH_CALC_BUFFER_COUNT (2U)
+#define HASH_CALC_BUFFER_NONE  (HASH_CALC_BUFFER_COUNT)
+
+#define HASH_CALC_CACHE_SIZE (32U)
+
+typedef struct {
+    uint8_t index; // HASH_CALC_BUFFER_NONE if file was not opened
+    size_t size; // 0 marks end of file
+    FS_Error error;
+} HashCalcChunk;
+
+typedef struct {
+    // Paths are not kept, CRC with length, size and timestamp make a false match improbable
+    uint32_t path_crc;
+    uint16_t path_length;
+    uint8_t type;
+    bool valid;
+    uint32_t timestamp;
+    uint64_t size;
+    uint8_t digest[HASH_CALC_SIZE_MAX];
+} HashCalcCacheEntry;
+
+typedef struct {
+    HashCalcCacheEntry entries[HASH_CALC_CACHE_SIZE];
+    size_t next; // Replaced on insert, round robin
+} HashCalcCache;
+
+struct HashCalc {
+    Storage* storage;
+    FuriThread* thread;
+    FuriMessageQueue* request_queue; // const char*, NULL stops the reader
+    FuriMessageQueue* free_queue; // uint8_t, buffers owned by reader
+    FuriMessageQueue* chunk_queue; // HashCalcChunk, buffers owned by hasher
+    uint8_t* buffers[HASH_CALC_BUFFER_COUNT];
+
+    union {
+        mbedtls_md5_context md5;
+        mbedtls_sha256_context sha256;
+    } context;
+};
+
+static const size_t hash_calc_size[HashCalcTypeNum] = {
+    [HashCalcTypeMd5] = HASH_CALC_MD5_SIZE,
+    [HashCalcTypeSha256] = HASH_CALC_SHA256_SIZE,
+};
+
+static HashCalcCache* hash_calc_cache = NULL;
+
+static void hash_calc_cache_init(void) {
+    if(hash_calc_cache) return;
+
+    // Allocated once and kept for the lifetime of the system
+    HashCalcCache* cache = malloc(sizeof(HashCalcCache));
+
+    FURI_CRITICAL_ENTER();
+    if(!hash_calc_cache) {
+        hash_calc_cache = cache;
+        cache = NULL;
+    }
+    FURI_CRITICAL_EXIT();
+
+    free(cache);
+}
+
+static bool hash_calc_cache_get(const HashCalcCacheEntry* key, uint8_t* digest) {
+    bool found = false;
+
+    FURI_CRITICAL_ENTER();
+    for(size_t i = 0; i < HASH_CALC_CACHE_SIZE; i++) {
+        const HashCalcCacheEntry* entry = &hash_calc_cache->entries[i];
+        if(entry->valid && entry->path_crc == key->path_crc &&
+           entry->path_length == key->path_length && entry->type == key->type &&
+           entry->timestamp == key->timestamp && entry->size == key->size) {
+            memcpy(digest, entry->digest, hash_calc_size[entry->type]);
+            found = true;
+            break;
+        }
+    }
+    FURI_CRITICAL_EXIT();
+
+    return found;
+}
+
+static void hash_calc_cache_put(const HashCalcCacheEntry* entry) {
+    FURI_CRITICAL_ENTER();
+
+    // Replace stale digest of the same file if there is one
+    size_t index = hash_calc_cache->next;
+    for(size_t i = 0; i < HASH_CALC_CACHE_SIZE; i++) {
+        const HashCalcCacheEntry* it = &hash_calc_cache->entries[i];
+        if(it->valid && it->path_crc == entry->path_crc &&
+           it->path_length == entry->path_length && it->type == entry->type) {
+            index = i;
+            break;
+        }
+    }
+
+    if(index == hash_calc_cache->next) {
+        hash_calc_cache->next = (hash_calc_cache->next + 1U) % HASH_CALC_CACHE_SIZE;
+    }
+
+    hash_calc_cache->entries[index] = *entry;
+    hash_calc_cache->entries[index].valid = true;
+
+    FURI_CRITICAL_EXIT();
+}
+
+static int32_t hash_calc_reader_thread(void* context) {
+    HashCalc* instance = context;
+    File* file = storage_file_alloc(instance->storage);
+
+    const char* path;
+    while(furi_message_queue_get(instance->request_queue, &path, FuriWaitForever) ==
+              FuriStatusOk &&
+          path) {
+        HashCalcChunk chunk = {.index = HASH_CALC_BUFFER_NONE};
+
+        if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            chunk.error = storage_file_get_error(file);
+            furi_check(
+                furi_message_queue_put(instance->chunk_queue, &chunk, FuriWaitForever) ==
+                FuriStatusOk);
+            continue;
+        }
+
+        do {
+            furi_check(
+                furi_message_queue_get(instance->free_queue, &chunk.index, FuriWaitForever) ==
+                FuriStatusOk);
+            chunk.size =
+                storage_file_read(file, instance->buffers[chunk.index], HASH_CALC_BUFFER_SIZE);
+            chunk.error = storage_file_get_error(file);
+            furi_check(
+                furi_message_queue_put(instance->chunk_queue, &chunk, FuriWaitForever) ==
+                FuriStatusOk);
+        } while(chunk.size && chunk.error == FSE_OK);
+
+        storage_file_close(file);
+    }
+
+    storage_file_free(file);
+
+    return 0;
+}
+
+HashCalc* hash_calc_alloc(Storage* storage) {
+    furi_check(storage);
+
+    hash_calc_cache_init();
+
+    HashCalc* instance = malloc(sizeof(HashCalc));
+    instance->storage = storage;
+
+    instance->request_queue = furi_message_queue_alloc(1, sizeof(const char*));
+    instance->free_queue = furi_message_queue_alloc(HASH_CALC_BUFFER_COUNT, sizeof(uint8_t));
+    instance->chunk_queue =
+        furi_message_queue_alloc(HASH_CALC_BUFFER_COUNT, sizeof(HashCalcChunk));
+
+    for(uint8_t i = 0; i < HASH_CALC_BUFFER_COUNT; i++) {
+        instance->buffers[i] = malloc(HASH_CALC_BUFFER_SIZE);
+        furi_check(furi_message_queue_put(instance->free_queue, &i, 0) == FuriStatusOk);
+    }
+
+    instance->thread = furi_thread_alloc_ex(TAG, 1024, hash_calc_reader_thread, instance);
+    furi_thread_start(instance->thread);
+
+    return instance;
+}
+
+void hash_calc_free(HashCalc* instance) {
+    furi_check(instance);
+
+    const char* stop = NULL;
+    furi_check(
+        furi_message_queue_put(instance->request_queue, &stop, FuriWaitForever) == FuriStatusOk);
+    furi_thread_join(instance->thread);
+    furi_thread_free(instance->thread);
+
+    for(size_t i = 0; i < HASH_CALC_BUFFER_COUNT; i++) {
+        free(instance->buffers[i]);
+    }
+
+    furi_message_queue_free(instance->chunk_queue);
+    furi_message_queue_free(instance->free_queue);
+    furi_message_queue_free(instance->request_queue);
+
+    free(instance);
+}
+
+size_t hash_calc_get_size(HashCalcType type) {
+    furi_check(type < HashCalcTypeNum);
+    return hash_calc_size[type];
+}
+
+static void hash_calc_start(HashCalc* instance, HashCalcType type) {
+    if(type == HashCalcTypeMd5) {
+        mbedtls_md5_init(&instance->context.md5);
+        mbedtls_md5_starts(&instance->context.md5);
+    } else {
+        mbedtls_sha256_init(&instance->context.sha256);
+        mbedtls_sha256_starts(&instance->context.sha256, 0);
+    }
+}
+
+static void
+    hash_calc_update(HashCalc* instance, HashCalcType type, const uint8_t* data, size_t size) {
+    if(type == HashCalcTypeMd5) {
+        mbedtls_md5_update(&instance->context.md5, data, size);
+    } else {
+        mbedtls_sha256_update(&instance->context.sha256, data, size);
+    }
+}
+
+static void hash_calc_finish(HashCalc* instance, HashCalcType type, uint8_t* output) {
+    if(type == HashCalcTypeMd5) {
+        mbedtls_md5_finish(&instance->context.md5, output);
+        mbedtls_md5_free(&instance->context.md5);
+    } else {
+        mbedtls_sha256_finish(&instance->context.sha256, output);
+        mbedtls_sha256_free(&instance->context.sha256);
+    }
+}
+
+bool hash_calc_file(
+    HashCalc* instance,
+    const char* path,
+    HashCalcType type,
+    uint8_t* output,
+    FS_Error* file_error) {
+    furi_check(instance);
+    furi_check(path);
+    furi_check(output);
+    furi_check(type < HashCalcTypeNum);
+
+    const size_t path_length = strlen(path);
+    HashCalcCacheEntry key = {
+        .path_crc = crc32_calc_buffer(0, path, path_length),
+        .path_length = MIN(path_length, UINT16_MAX),
+        .type = type,
+    };
+
+    // Storages without timestamps are not cached, neither are ones modified within current
+    // second: next write may not change the timestamp
+    FileInfo file_info = {0};
+    const bool stat_ok = storage_common_stat(instance->storage, path, &file_info) == FSE_OK;
+    const bool cacheable =
+        stat_ok && storage_common_timestamp(instance->storage, path, &key.timestamp) == FSE_OK &&
+        key.timestamp != furi_hal_rtc_get_timestamp();
+    key.size = file_info.size;
+
+    if(cacheable && hash_calc_cache_get(&key, output)) {
+        if(file_error) *file_error = FSE_OK;
+        return true;
+    }
+
+    // Index validates records on its own
+    if(stat_ok && type == HashCalcTypeMd5 &&
+       storage_index_get_md5(instance->storage, path, output) == FSE_OK) {
+        if(cacheable) {
+            memcpy(key.digest, output, HASH_CALC_MD5_SIZE);
+            hash_calc_cache_put(&key);
+        }
+        if(file_error) *file_error = FSE_OK;
+        return true;
+    }
+
+    hash_calc_start(instance, type);
+    furi_check(
+        furi_message_queue_put(instance->request_queue, &path, FuriWaitForever) == FuriStatusOk);
+
+    FS_Error error = FSE_OK;
+    while(true) {
+        HashCalcChunk chunk;
+        furi_check(
+            furi_message_queue_get(instance->chunk_queue, &chunk, FuriWaitForever) ==
+            FuriStatusOk);
+
+        if(chunk.index != HASH_CALC_BUFFER_NONE) {
+            // Reader fills the other buffer meanwhile
+            if(chunk.size && chunk.error == FSE_OK) {
+                hash_calc_update(instance, type, instance->buffers[chunk.index], chunk.size);
+            }
+            furi_check(
+                furi_message_queue_put(instance->free_queue, &chunk.index, FuriWaitForever) ==
+                FuriStatusOk);
+        }
+
+        if(chunk.error != FSE_OK) error = chunk.error;
+        if(!chunk.size || chunk.error != FSE_OK) break;
+    }
+
+    hash_calc_finish(instance, type, output);
+
+    if(error == FSE_OK && cacheable) {
+        memcpy(key.digest, output, hash_calc_size[type]);
+        hash_calc_cache_put(&key);
+
+        // Refused if anything was written meanwhile, fails for storages without index
+        if(type == HashCalcTypeMd5) {
+            storage_index_set_md5(instance->storage, path, output, key.timestamp);
+        }
+    }
+
+    if(file_error) *file_error = error;
+
+    return error == FSE_OK;
+}
+
+bool hash_calc_file_string(
+    HashCalc* instance,
+    const char* path,
+    HashCalcType type,
+    FuriString* output,
+    FS_Error* file_error) {
+    furi_check(output);
+
+    uint8_t digest[HASH_CALC_SIZE_MAX];
+    bool result = hash_calc_file(instance, path, type, digest, file_error);
+
+    if(result) {
+        furi_string_reset(output);
+        for(size_t i = 0; i < hash_calc_size[type]; i++) {
+            furi_string_cat_printf(output, "%02x", digest[i]);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file hash_calc.h
+ * File digest calculation
+ *
+ * File is read by a helper thread into two buffers, so hashing of one buffer
+ * overlaps with storage reading into the other.
+ *
+ * Digests are cached in RAM by path, size and storage modification timestamp,
+ * so any write to the storage drops the whole cache. Cache is shared by all
+ * HashCalc instances and survives them, so repeated requests for unchanged
+ * files skip hashing. MD5 digests of SD card files are also kept in the
+ * persistent storage index, see storage_index_get_md5.
+ */
+#pragma once
+
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HASH_CALC_MD5_SIZE    (16U)
+#define HASH_CALC_SHA256_SIZE (32U)
+#define HASH_CALC_SIZE_MAX    HASH_CALC_SHA256_SIZE
+
+typedef enum {
+    HashCalcTypeMd5,
+    HashCalcTypeSha256,
+
+    HashCalcTypeNum,
+} HashCalcType;
+
+typedef struct HashCalc HashCalc;
+
+/** Allocate HashCalc instance
+ *
+ * Allocates reader thread and buffers, keep the instance for a batch of files.
+ *
+ * @param      storage  pointer to Storage instance
+ *
+ * @return     pointer to HashCalc instance
+ */
+HashCalc* hash_calc_alloc(Storage* storage);
+
+/** Free HashCalc instance
+ *
+ * @param      instance  pointer to HashCalc instance
+ */
+void hash_calc_free(HashCalc* instance);
+
+/** Get digest size
+ *
+ * @param[in]  type  digest type
+ *
+ * @return     digest size in bytes
+ */
+size_t hash_calc_get_size(HashCalcType type);
+
+/** Calculate file digest
+ *
+ * @param      instance    pointer to HashCalc instance
+ * @param[in]  path        file path
+ * @param[in]  type        digest type
+ * @param[out] output      digest, hash_calc_get_size bytes
+ * @param[out] file_error  file error, may be NULL
+ *
+ * @return     true on success
+ */
+bool hash_calc_file(
+    HashCalc* instance,
+    const char* path,
+    HashCalcType type,
+    uint8_t* output,
+    FS_Error* file_error);
+
+/** Calculate file digest as lowercase hex string
+ *
+ * @param      instance    pointer to HashCalc instance
+ * @param[in]  path        file path
+ * @param[in]  type        digest type
+ * @param[out] output      digest string
+ * @param[out] file_error  file error, may be NULL
+ *
+ * @return     true on success
+ */
+bool hash_calc_file_string(
+    HashCalc* instance,
+    const char* path,
+    HashCalcType type,
+    FuriString* output,
+    FS_Error* file_error);
+
+#ifdef __cplusplus
+}
+#endif
@@ -5,14 +5,47 @@
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/stream/buffered_file_stream.h>
 #include <toolbox/args.h>
+#include <toolbox/crc32_calc.h>
 
 #define TAG "KeysDict"
 
+/* Keys are additionally kept in RAM as sorted integers, so presence checks
+ * don't rescan the file. Index is dropped and lookups fall back to file scan
+ * if it doesn't fit in these limits. */
+#define KEYS_DICT_INDEX_SIZE_MAX         (16 * 1024)
+#define KEYS_DICT_INDEX_CAPACITY_INITIAL (64)
+
+/* Binary dictionary: header followed by packed keys, read in blocks */
+#define KEYS_DICT_BINARY_MAGIC      (0x3142444BUL) // "KDB1"
+#define KEYS_DICT_BINARY_VERSION    (1)
+#define KEYS_DICT_BINARY_BLOCK_KEYS (128)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t key_size;
+    uint16_t reserved;
+    uint32_t total_keys;
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t crc;
+} FURI_PACKED KeysDictBinaryHeader;
+
 struct KeysDict {
     Stream* stream;
     size_t key_size;
     size_t key_size_symbols;
     size_t total_keys;
+
+    uint64_t* index;
+    size_t index_count;
+    size_t index_capacity;
+
+    bool is_binary;
+    uint8_t* block;
+    size_t block_keys;
+    size_t block_pos;
+    size_t keys_left;
 };
 
 static inline void keys_dict_add_ending_new_line(KeysDict* instance) {
@@ -52,6 +85,237 @@ static bool keys_dict_read_key_line(KeysDict* instance, FuriString* line, bool*
     return false;
 }
 
+static void keys_dict_int_to_str(KeysDict* instance, const uint8_t* key_int, FuriString* key_str) {
+    furi_assert(instance);
+    furi_assert(key_str);
+    furi_assert(key_int);
+
+    furi_string_reset(key_str);
+
+    for(size_t i = 0; i < instance->key_size; i++)
+        furi_string_cat_printf(key_str, "%02X", key_int[i]);
+}
+
+static void keys_dict_str_to_int(KeysDict* instance, FuriString* key_str, uint64_t* key_int) {
+    furi_assert(instance);
+    furi_assert(key_str);
+    furi_assert(key_int);
+
+    uint8_t key_byte_tmp;
+    char h, l;
+
+    *key_int = 0ULL;
+
+    for(size_t i = 0; i < instance->key_size_symbols - 1; i += 2) {
+        h = furi_string_get_char(key_str, i);
+        l = furi_string_get_char(key_str, i + 1);
+
+        args_char_to_hex(h, l, &key_byte_tmp);
+        *key_int |= (uint64_t)key_byte_tmp << (8 * (instance->key_size - 1 - i / 2));
+    }
+}
+
+static uint64_t keys_dict_key_to_int(KeysDict* instance, const uint8_t* key) {
+    uint64_t key_int = 0;
+    for(size_t i = 0; i < instance->key_size; i++) {
+        key_int = (key_int << 8) | key[i];
+    }
+    return key_int;
+}
+
+static void keys_dict_index_free(KeysDict* instance) {
+    if(instance->index) {
+        FURI_LOG_W(TAG, "Index disabled, using file scan");
+        free(instance->index);
+        instance->index = NULL;
+    }
+    instance->index_count = 0;
+    instance->index_capacity = 0;
+}
+
+static bool keys_dict_index_reserve(KeysDict* instance, size_t count) {
+    if(count <= instance->index_capacity) return true;
+
+    size_t capacity = MAX(instance->index_capacity * 2, (size_t)KEYS_DICT_INDEX_CAPACITY_INITIAL);
+    while(capacity < count) {
+        capacity *= 2;
+    }
+    capacity = MIN(capacity, KEYS_DICT_INDEX_SIZE_MAX / sizeof(uint64_t));
+
+    size_t size = capacity * sizeof(uint64_t);
+    // Leave heap to the rest of the application
+    if(capacity < count || size > memmgr_heap_get_max_free_block() / 2) return false;
+
+    instance->index = realloc(instance->index, size); //-V701
+    instance->index_capacity = capacity;
+
+    return true;
+}
+
+/* Returns position of the first element that is not less than key */
+static size_t keys_dict_index_lower_bound(KeysDict* instance, uint64_t key_int) {
+    size_t low = 0;
+    size_t high = instance->index_count;
+
+    while(low < high) {
+        size_t mid = low + (high - low) / 2;
+        if(instance->index[mid] < key_int) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+static void keys_dict_index_insert(KeysDict* instance, uint64_t key_int) {
+    if(!instance->index) return;
+
+    if(!keys_dict_index_reserve(instance, instance->index_count + 1)) {
+        keys_dict_index_free(instance);
+        return;
+    }
+
+    size_t pos = keys_dict_index_lower_bound(instance, key_int);
+    memmove(
+        &instance->index[pos + 1],
+        &instance->index[pos],
+        (instance->index_count - pos) * sizeof(uint64_t));
+    instance->index[pos] = key_int;
+    instance->index_count++;
+}
+
+static void keys_dict_index_remove(KeysDict* instance, uint64_t key_int) {
+    if(!instance->index) return;
+
+    size_t pos = keys_dict_index_lower_bound(instance, key_int);
+    if(pos < instance->index_count && instance->index[pos] == key_int) {
+        memmove(
+            &instance->index[pos],
+            &instance->index[pos + 1],
+            (instance->index_count - pos - 1) * sizeof(uint64_t));
+        instance->index_count--;
+    }
+}
+
+static void keys_dict_index_append(KeysDict* instance, uint64_t key_int) {
+    if(!instance->index) return;
+
+    if(keys_dict_index_reserve(instance, instance->index_count + 1)) {
+        instance->index[instance->index_count++] = key_int;
+    } else {
+        keys_dict_index_free(instance);
+    }
+}
+
+static int keys_dict_index_compare(const void* a, const void* b) {
+    uint64_t key_a = *(const uint64_t*)a;
+    uint64_t key_b = *(const uint64_t*)b;
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+static bool keys_dict_binary_read_header(KeysDict* instance, KeysDictBinaryHeader* header) {
+    bool is_binary = stream_read(instance->stream, (uint8_t*)header, sizeof(*header)) ==
+                         sizeof(*header) &&
+                     header->magic == KEYS_DICT_BINARY_MAGIC;
+
+    if(!is_binary) {
+        stream_rewind(instance->stream);
+    }
+
+    return is_binary;
+}
+
+static bool keys_dict_binary_load(KeysDict* instance, const KeysDictBinaryHeader* header) {
+    if(header->version != KEYS_DICT_BINARY_VERSION || header->key_size != instance->key_size) {
+        FURI_LOG_E(TAG, "Unsupported binary dictionary");
+        return false;
+    }
+
+    size_t data_size = header->total_keys * instance->key_size;
+    if(stream_size(instance->stream) != sizeof(KeysDictBinaryHeader) + data_size) {
+        FURI_LOG_E(TAG, "Binary dictionary size mismatch");
+        return false;
+    }
+
+    // Single pass over the keys: verify checksum and fill the index
+    uint32_t crc = 0;
+    size_t keys_left = header->total_keys;
+
+    while(keys_left) {
+        size_t keys = MIN(keys_left, (size_t)KEYS_DICT_BINARY_BLOCK_KEYS);
+        size_t bytes = keys * instance->key_size;
+
+        if(stream_read(instance->stream, instance->block, bytes) != bytes) break;
+        crc = crc32_calc_buffer(crc, instance->block, bytes);
+
+        for(size_t i = 0; i < keys; i++) {
+            keys_dict_index_append(
+                instance, keys_dict_key_to_int(instance, &instance->block[i * instance->key_size]));
+        }
+
+        keys_left -= keys;
+    }
+
+    if(keys_left || crc != header->crc) {
+        FURI_LOG_E(TAG, "Binary dictionary checksum mismatch");
+        instance->index_count = 0;
+        return false;
+    }
+
+    instance->total_keys = header->total_keys;
+
+    return true;
+}
+
+static bool keys_dict_binary_rewind(KeysDict* instance) {
+    instance->block_keys = 0;
+    instance->block_pos = 0;
+    instance->keys_left = instance->total_keys;
+
+    return stream_seek(instance->stream, sizeof(KeysDictBinaryHeader), StreamOffsetFromStart);
+}
+
+static bool keys_dict_binary_get_next_key(KeysDict* instance, uint8_t* key) {
+    if(instance->block_pos == instance->block_keys) {
+        size_t keys = MIN(instance->keys_left, (size_t)KEYS_DICT_BINARY_BLOCK_KEYS);
+        size_t bytes = stream_read(instance->stream, instance->block, keys * instance->key_size);
+
+        instance->block_keys = bytes / instance->key_size;
+        instance->block_pos = 0;
+        instance->keys_left -= instance->block_keys;
+
+        if(instance->block_keys == 0) return false;
+    }
+
+    memcpy(key, &instance->block[instance->block_pos * instance->key_size], instance->key_size);
+    instance->block_pos++;
+
+    return true;
+}
+
+static bool keys_dict_binary_is_key_present(KeysDict* instance, const uint8_t* key) {
+    uint8_t* temp_key = malloc(instance->key_size);
+    bool key_found = false;
+
+    uint32_t actual_pos = stream_tell(instance->stream);
+    stream_seek(instance->stream, sizeof(KeysDictBinaryHeader), StreamOffsetFromStart);
+
+    for(size_t i = 0; i < instance->total_keys && !key_found; i++) {
+        if(stream_read(instance->stream, temp_key, instance->key_size) != instance->key_size) {
+            break;
+        }
+        key_found = memcmp(temp_key, key, instance->key_size) == 0;
+    }
+
+    // Restore the position of the stream
+    stream_seek(instance->stream, actual_pos, StreamOffsetFromStart);
+    free(temp_key);
+
+    return key_found;
+}
+
 bool keys_dict_check_presence(const char* path) {
     furi_check(path);
 
@@ -81,12 +345,35 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
     instance->key_size_symbols = key_size * 2 + 1;
 
     instance->total_keys = 0;
+    instance->is_binary = false;
+    instance->block = NULL;
+
+    // Index only works for keys that fit in uint64_t
+    bool build_index = key_size <= sizeof(uint64_t);
+    instance->index = NULL;
+    instance->index_count = 0;
+    instance->index_capacity = 0;
+    if(build_index) {
+        build_index = keys_dict_index_reserve(instance, KEYS_DICT_INDEX_CAPACITY_INITIAL);
+    }
 
     bool file_exists =
         buffered_file_stream_open(instance->stream, path, FSAM_READ_WRITE, open_mode);
 
+    KeysDictBinaryHeader header;
+
     if(!file_exists) {
         buffered_file_stream_close(instance->stream);
+    } else if(keys_dict_binary_read_header(instance, &header)) {
+        instance->block = malloc(KEYS_DICT_BINARY_BLOCK_KEYS * key_size);
+        if(keys_dict_binary_load(instance, &header)) {
+            instance->is_binary = true;
+            keys_dict_binary_rewind(instance);
+        } else {
+            // Damaged binary list is not valid text either, open it as a missing list
+            buffered_file_stream_close(instance->stream);
+            file_exists = false;
+        }
     } else {
         // Eventually add new line character in the last line to avoid skipping keys
         keys_dict_add_ending_new_line(instance);
@@ -96,16 +383,35 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
 
     bool is_endfile = false;
 
-    // In this loop we only count the entries in the file
-    // We prefer not to load the whole file in memory for space reasons
-    while(file_exists && !is_endfile) {
+    // In this loop we count the entries in the file and collect them into index
+    // Whole file is never loaded in memory, only compact integer keys
+    while(file_exists && !instance->is_binary && !is_endfile) {
         bool read_key = keys_dict_read_key_line(instance, line, &is_endfile);
         if(read_key) {
             instance->total_keys++;
+
+            if(instance->index) {
+                uint64_t key_int = 0;
+                keys_dict_str_to_int(instance, line, &key_int);
+                keys_dict_index_append(instance, key_int);
+            }
         }
     }
-    stream_rewind(instance->stream);
-    FURI_LOG_I(TAG, "Loaded dictionary with %zu keys", instance->total_keys);
+    if(!instance->is_binary) {
+        stream_rewind(instance->stream);
+    }
+
+    if(instance->index) {
+        qsort(
+            instance->index, instance->index_count, sizeof(uint64_t), keys_dict_index_compare);
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "Loaded %s dictionary with %zu keys%s",
+        instance->is_binary ? "binary" : "text",
+        instance->total_keys,
+        instance->index ? ", indexed" : "");
 
     furi_string_free(line);
 
@@ -118,41 +424,13 @@ void keys_dict_free(KeysDict* instance) {
 
     buffered_file_stream_close(instance->stream);
     stream_free(instance->stream);
+    free(instance->index);
+    free(instance->block);
     free(instance);
 
     furi_record_close(RECORD_STORAGE);
 }
 
-static void keys_dict_int_to_str(KeysDict* instance, const uint8_t* key_int, FuriString* key_str) {
-    furi_assert(instance);
-    furi_assert(key_str);
-    furi_assert(key_int);
-
-    furi_string_reset(key_str);
-
-    for(size_t i = 0; i < instance->key_size; i++)
-        furi_string_cat_printf(key_str, "%02X", key_int[i]);
-}
-
-static void keys_dict_str_to_int(KeysDict* instance, FuriString* key_str, uint64_t* key_int) {
-    furi_assert(instance);
-    furi_assert(key_str);
-    furi_assert(key_int);
-
-    uint8_t key_byte_tmp;
-    char h, l;
-
-    *key_int = 0ULL;
-
-    for(size_t i = 0; i < instance->key_size_symbols - 1; i += 2) {
-        h = furi_string_get_char(key_str, i);
-        l = furi_string_get_char(key_str, i + 1);
-
-        args_char_to_hex(h, l, &key_byte_tmp);
-        *key_int |= (uint64_t)key_byte_tmp << (8 * (instance->key_size - 1 - i / 2));
-    }
-}
-
 size_t keys_dict_get_total_keys(KeysDict* instance) {
     furi_check(instance);
 
@@ -163,6 +441,10 @@ bool keys_dict_rewind(KeysDict* instance) {
     furi_check(instance);
     furi_check(instance->stream);
 
+    if(instance->is_binary) {
+        return keys_dict_binary_rewind(instance);
+    }
+
     return stream_rewind(instance->stream);
 }
 
@@ -188,7 +470,11 @@ bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
-    FuriString* temp_key = furi_string_alloc();
+    if(instance->is_binary) {
+        return keys_dict_binary_get_next_key(instance, key);
+    }
+
+    FURI_STRING_DECLARE(temp_key);
 
     bool key_read = keys_dict_get_next_key_str(instance, temp_key);
 
@@ -204,7 +490,7 @@ bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
         }
     }
 
-    furi_string_free(temp_key);
+    furi_string_deinit(temp_key);
     return key_read;
 }
 
@@ -240,11 +526,21 @@ bool keys_dict_is_key_present(KeysDict* instance, const uint8_t* key, size_t key
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
-    FuriString* temp_key = furi_string_alloc();
+    if(instance->index) {
+        uint64_t key_int = keys_dict_key_to_int(instance, key);
+        size_t pos = keys_dict_index_lower_bound(instance, key_int);
+        return pos < instance->index_count && instance->index[pos] == key_int;
+    }
+
+    if(instance->is_binary) {
+        return keys_dict_binary_is_key_present(instance, key);
+    }
+
+    FURI_STRING_DECLARE(temp_key);
 
     keys_dict_int_to_str(instance, key, temp_key);
     bool key_found = keys_dict_is_key_present_str(instance, temp_key);
-    furi_string_free(temp_key);
+    furi_string_deinit(temp_key);
 
     return key_found;
 }
@@ -277,11 +573,20 @@ bool keys_dict_add_key(KeysDict* instance, const uint8_t* key, size_t key_size)
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(instance->is_binary) {
+        FURI_LOG_E(TAG, "Binary dictionary is read only");
+        return false;
+    }
+
     FuriString* temp_key = furi_string_alloc();
 
     keys_dict_int_to_str(instance, key, temp_key);
     bool key_added = keys_dict_add_key_str(instance, temp_key);
 
+    if(key_added) {
+        keys_dict_index_insert(instance, keys_dict_key_to_int(instance, key));
+    }
+
     FURI_LOG_I(TAG, "Added key %s", furi_string_get_cstr(temp_key));
 
     furi_string_free(temp_key);
@@ -295,6 +600,11 @@ bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_siz
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(instance->is_binary) {
+        FURI_LOG_E(TAG, "Binary dictionary is read only");
+        return false;
+    }
+
     bool key_removed = false;
 
     uint8_t* temp_key = malloc(key_size);
@@ -312,6 +622,7 @@ bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_siz
                 break;
             }
             instance->total_keys--;
+            keys_dict_index_remove(instance, keys_dict_key_to_int(instance, key));
             key_removed = true;
         }
     }
@@ -329,3 +640,134 @@ bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_siz
 
     return key_removed;
 }
+
+static bool keys_dict_binary_get_source_info(
+    Storage* storage,
+    const char* path,
+    uint32_t* source_size,
+    uint32_t* source_timestamp) {
+    FileInfo file_info;
+
+    if(storage_common_stat(storage, path, &file_info) != FSE_OK) return false;
+    if(storage_common_timestamp(storage, path, source_timestamp) != FSE_OK) return false;
+    *source_size = (uint32_t)file_info.size;
+
+    return true;
+}
+
+static bool keys_dict_binary_is_current(
+    Storage* storage,
+    const char* binary_path,
+    size_t key_size,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    File* file = storage_file_alloc(storage);
+    KeysDictBinaryHeader header;
+
+    bool is_current =
+        storage_file_open(file, binary_path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+        storage_file_read(file, &header, sizeof(header)) == sizeof(header) &&
+        header.magic == KEYS_DICT_BINARY_MAGIC && header.version == KEYS_DICT_BINARY_VERSION &&
+        header.key_size == key_size && header.source_size == source_size &&
+        header.source_timestamp == source_timestamp;
+
+    storage_file_free(file);
+
+    return is_current;
+}
+
+static bool keys_dict_binary_build(
+    Storage* storage,
+    const char* path,
+    const char* binary_path,
+    size_t key_size) {
+    KeysDict* dict = keys_dict_alloc(path, KeysDictModeOpenExisting, key_size);
+    File* file = storage_file_alloc(storage);
+    uint8_t* block = malloc(KEYS_DICT_BINARY_BLOCK_KEYS * key_size);
+
+    KeysDictBinaryHeader header = {
+        .magic = KEYS_DICT_BINARY_MAGIC,
+        .version = KEYS_DICT_BINARY_VERSION,
+        .key_size = key_size,
+    };
+
+    bool success = false;
+
+    do {
+        if(dict->is_binary) break;
+        // Opening text dictionary may append a line ending, so query it afterwards
+        uint32_t source_size = 0;
+        uint32_t source_timestamp = 0;
+        if(!keys_dict_binary_get_source_info(storage, path, &source_size, &source_timestamp))
+            break;
+        header.source_size = source_size;
+        header.source_timestamp = source_timestamp;
+        if(!storage_file_open(file, binary_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+        // Placeholder, rewritten once keys are counted
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        bool is_endfile = false;
+        while(!is_endfile) {
+            size_t keys = 0;
+            while(keys < KEYS_DICT_BINARY_BLOCK_KEYS) {
+                if(!keys_dict_get_next_key(dict, &block[keys * key_size], key_size)) {
+                    is_endfile = true;
+                    break;
+                }
+                keys++;
+            }
+
+            size_t bytes = keys * key_size;
+            if(storage_file_write(file, block, bytes) != bytes) break;
+            header.crc = crc32_calc_buffer(header.crc, block, bytes);
+            header.total_keys += keys;
+        }
+        if(!is_endfile) break;
+
+        if(!storage_file_seek(file, 0, true)) break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        success = true;
+    } while(false);
+
+    storage_file_close(file);
+    if(!success) {
+        storage_common_remove(storage, binary_path);
+    }
+
+    FURI_LOG_I(
+        TAG, "Binary dictionary %s, %lu keys", success ? "built" : "failed", header.total_keys);
+
+    free(block);
+    storage_file_free(file);
+    keys_dict_free(dict);
+
+    return success;
+}
+
+bool keys_dict_binary_update(const char* path, const char* binary_path, size_t key_size) {
+    furi_check(path);
+    furi_check(binary_path);
+    furi_check(key_size > 0 && key_size <= UINT8_MAX);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    uint32_t source_size = 0;
+    uint32_t source_timestamp = 0;
+    bool success = false;
+
+    do {
+        if(!keys_dict_binary_get_source_info(storage, path, &source_size, &source_timestamp))
+            break;
+
+        success = keys_dict_binary_is_current(
+            storage, binary_path, key_size, source_size, source_timestamp);
+        if(success) break;
+
+        success = keys_dict_binary_build(storage, path, binary_path, key_size);
+    } while(false);
+
+    furi_record_close(RECORD_STORAGE);
+
+    return success;
+}
@@ -98,6 +98,20 @@ bool keys_dict_add_key(KeysDict* instance, const uint8_t* key, size_t key_size);
 */
 bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_size);
 
+/** Create or refresh binary copy of the list
+ * Binary list contains packed keys with a checksum and is streamed in large
+ * blocks, so iterating it doesn't parse text. It's rebuilt only when the
+ * source list size or timestamp changes. Open it with keys_dict_alloc(),
+ * binary lists are read only.
+ *
+ * @param path          - Path of the text list
+ * @param binary_path   - Path of the binary list to create
+ * @param key_size      - Size of each key in bytes
+ *
+ * @return Returns true if binary list is up to date, false otherwise
+*/
+bool keys_dict_binary_update(const char* path, const char* binary_path, size_t key_size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,6 +4,44 @@
 static const uint8_t transitions[] = {0b00000001, 0b10010001, 0b10011011, 0b11111011};
 static const ManchesterState manchester_reset_state = ManchesterStateMid1;
 
+// Two steps of transitions[] per entry, indexed by state and both events:
+// bits 0-1 next state, bits 2-3 decoded bit count, bits 4-5 decoded bits
+#define MANCHESTER_PAIR_EVENTS       (ManchesterEventReset / 2 + 1)
+#define MANCHESTER_PAIR_STATE(entry) ((ManchesterState)((entry) & 0x3))
+#define MANCHESTER_PAIR_COUNT(entry) (((entry) >> 2) & 0x3)
+#define MANCHESTER_PAIR_BITS(entry)  (((entry) >> 4) & 0x3)
+
+static const uint8_t pair_transitions[] = {
+    // Start1
+    0x15, 0x14, 0x15, 0x2A, 0x15,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    // Mid1
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    0x15, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    0x07, 0x05, 0x19, 0x05, 0x05,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    // Mid0
+    0x01, 0x06, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    0x15, 0x14, 0x15, 0x2A, 0x15,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    // Start0
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    0x07, 0x05, 0x19, 0x05, 0x05,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+    0x01, 0x00, 0x01, 0x06, 0x01,
+};
+
+_Static_assert(
+    sizeof(pair_transitions) == 4 * MANCHESTER_PAIR_EVENTS * MANCHESTER_PAIR_EVENTS,
+    "pair table size mismatch");
+
 bool manchester_advance(
     ManchesterState state,
     ManchesterEvent event,
@@ -32,3 +70,52 @@ bool manchester_advance(
     *next_state = new_state;
     return result;
 }
+
+static inline void manchester_put_bit(uint8_t* data, size_t position, bool bit) {
+    const uint8_t mask = 1U << (7 - (position % 8));
+    if(bit) {
+        data[position / 8] |= mask;
+    } else {
+        data[position / 8] &= ~mask;
+    }
+}
+
+size_t manchester_advance_batch(
+    ManchesterState* state,
+    const ManchesterEvent* events,
+    size_t events_count,
+    uint8_t* data,
+    size_t bit_position) {
+    ManchesterState current_state = *state;
+    size_t position = bit_position;
+    size_t index = 0;
+
+    for(; index + 1 < events_count; index += 2) {
+        const size_t entry_index =
+            (current_state * MANCHESTER_PAIR_EVENTS + events[index] / 2) *
+                MANCHESTER_PAIR_EVENTS +
+            events[index + 1] / 2;
+        const uint8_t entry = pair_transitions[entry_index];
+        const uint8_t count = MANCHESTER_PAIR_COUNT(entry);
+        const uint8_t bits = MANCHESTER_PAIR_BITS(entry);
+
+        if(count == 2) {
+            manchester_put_bit(data, position++, bits & 0x2);
+            manchester_put_bit(data, position++, bits & 0x1);
+        } else if(count == 1) {
+            manchester_put_bit(data, position++, bits & 0x1);
+        }
+
+        current_state = MANCHESTER_PAIR_STATE(entry);
+    }
+
+    if(index < events_count) {
+        bool bit;
+        if(manchester_advance(current_state, events[index], &current_state, &bit)) {
+            manchester_put_bit(data, position++, bit);
+        }
+    }
+
+    *state = current_state;
+    return position - bit_position;
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,6 +28,29 @@ bool manchester_advance(
     ManchesterState* next_state,
     bool* data);
 
+/** Decode a sequence of events in one call
+ *
+ * Equivalent to calling manchester_advance for every event, but walks the
+ * events in pairs through a precomputed table.
+ * Decoded bits are appended MSB first, in bit_lib order, starting from
+ * bit_position. Each event yields at most one bit, so data must have room
+ * for bit_position + events_count bits.
+ *
+ * @param      state         decoder state, updated in place
+ * @param      events        events to decode
+ * @param      events_count  events count
+ * @param      data          output buffer
+ * @param      bit_position  first bit to write in data
+ *
+ * @return     decoded bits count
+ */
+size_t manchester_advance_batch(
+    ManchesterState* state,
+    const ManchesterEvent* events,
+    size_t events_count,
+    uint8_t* data,
+    size_t bit_position);
+
 #ifdef __cplusplus
 }
 #endif
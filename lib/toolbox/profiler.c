@@ -1,8 +1,10 @@
 #include "profiler.h"
+#include "varint.h"
 #include <stdlib.h>
 #include <m-dict.h>
 #include <furi.h>
 #include <furi_hal_gpio.h>
+#include <furi_hal_cortex.h>
 
 typedef struct {
     uint32_t start;
@@ -85,3 +87,182 @@ void profiler_dump(Profiler* profiler) {
         }
     }
 }
+
+#define PROFILER_STREAM_MAGIC           "FZPF"
+#define PROFILER_STREAM_RECORD_SIZE_MAX (2U + 5U)
+
+typedef struct {
+    uint32_t cycles;
+    uint8_t probe;
+    uint8_t context;
+} ProfilerEvent;
+
+typedef struct {
+    ProfilerEvent* events;
+    size_t mask;
+    size_t head; // Written by producers with interrupts masked
+    size_t tail; // Written by reader
+    uint32_t dropped;
+    uint32_t dropped_reported;
+    uint32_t start_cycles;
+    uint32_t last_cycles;
+    bool header_sent;
+} ProfilerStream;
+
+static const char* const profiler_probe_names[ProfilerProbeNum] = {
+#define PROFILER_PROBE_NAME(name) #name,
+    PROFILER_PROBE_LIST(PROFILER_PROBE_NAME)
+#undef PROFILER_PROBE_NAME
+};
+
+static_assert(ProfilerProbeNum < PROFILER_STREAM_DROP, "Too many profiler probes");
+
+static ProfilerStream* volatile profiler_stream = NULL;
+
+static inline void profiler_probe_record(uint8_t probe) {
+    // Fast path, nothing to do when stream is not running
+    if(!profiler_stream) return;
+
+    // Single core: masking interrupts for a few instructions is the cheapest way to
+    // serialize producers from threads and ISRs, it also keeps the ring alive until we are done
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    ProfilerStream* stream = profiler_stream;
+    if(stream) {
+        const size_t head = stream->head;
+        if(head - __atomic_load_n(&stream->tail, __ATOMIC_ACQUIRE) <= stream->mask) {
+            ProfilerEvent* event = &stream->events[head & stream->mask];
+            event->cycles = DWT->CYCCNT;
+            event->probe = probe;
+            event->context = __get_IPSR();
+            __atomic_store_n(&stream->head, head + 1, __ATOMIC_RELEASE);
+        } else {
+            stream->dropped++;
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+void profiler_probe_enter(ProfilerProbe probe) {
+    furi_assert(probe < ProfilerProbeNum);
+    profiler_probe_record(probe);
+}
+
+void profiler_probe_exit(ProfilerProbe probe) {
+    furi_assert(probe < ProfilerProbeNum);
+    profiler_probe_record(probe | PROFILER_STREAM_EXIT);
+}
+
+const char* profiler_probe_get_name(ProfilerProbe probe) {
+    furi_check(probe < ProfilerProbeNum);
+    return profiler_probe_names[probe];
+}
+
+bool profiler_stream_start(size_t capacity) {
+    furi_check(capacity && !(capacity & (capacity - 1)));
+
+    if(profiler_stream) return false;
+
+    ProfilerStream* stream = malloc(sizeof(ProfilerStream));
+    stream->events = malloc(sizeof(ProfilerEvent) * capacity);
+    stream->mask = capacity - 1;
+    stream->start_cycles = DWT->CYCCNT;
+    stream->last_cycles = stream->start_cycles;
+
+    profiler_stream = stream;
+
+    return true;
+}
+
+void profiler_stream_stop(void) {
+    furi_check(profiler_stream);
+
+    ProfilerStream* stream = profiler_stream;
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    profiler_stream = NULL;
+    __set_PRIMASK(primask);
+
+    free(stream->events);
+    free(stream);
+}
+
+bool profiler_stream_is_running(void) {
+    return profiler_stream != NULL;
+}
+
+static size_t profiler_stream_write_u32(uint8_t* buffer, uint32_t value) {
+    for(size_t i = 0; i < sizeof(uint32_t); i++) {
+        buffer[i] = value >> (i * 8U);
+    }
+    return sizeof(uint32_t);
+}
+
+static size_t profiler_stream_write_header(ProfilerStream* stream, uint8_t* buffer, size_t size) {
+    size_t length = strlen(PROFILER_STREAM_MAGIC);
+    memcpy(buffer, PROFILER_STREAM_MAGIC, length);
+    buffer[length++] = PROFILER_STREAM_VERSION;
+    length += profiler_stream_write_u32(
+        &buffer[length], furi_hal_cortex_instructions_per_microsecond() * 1000000UL);
+    length += profiler_stream_write_u32(&buffer[length], stream->start_cycles);
+    buffer[length++] = ProfilerProbeNum;
+
+    for(size_t i = 0; i < ProfilerProbeNum; i++) {
+        const size_t name_length = strlen(profiler_probe_names[i]);
+        furi_check(name_length <= UINT8_MAX);
+        furi_check(size - length > name_length);
+        buffer[length++] = name_length;
+        memcpy(&buffer[length], profiler_probe_names[i], name_length);
+        length += name_length;
+    }
+
+    return length;
+}
+
+size_t profiler_stream_read(uint8_t* buffer, size_t size) {
+    furi_check(buffer);
+    furi_check(size >= PROFILER_STREAM_READ_SIZE_MIN);
+
+    ProfilerStream* stream = profiler_stream;
+    furi_check(stream);
+
+    size_t length = 0;
+    if(!stream->header_sent) {
+        length = profiler_stream_write_header(stream, buffer, size);
+        stream->header_sent = true;
+    }
+
+    const size_t head = __atomic_load_n(&stream->head, __ATOMIC_ACQUIRE);
+    size_t tail = stream->tail;
+
+    while(tail != head && size - length >= PROFILER_STREAM_RECORD_SIZE_MAX) {
+        const ProfilerEvent* event = &stream->events[tail & stream->mask];
+        buffer[length++] = event->probe;
+        buffer[length++] = event->context;
+        length += varint_uint32_pack(event->cycles - stream->last_cycles, &buffer[length]);
+        stream->last_cycles = event->cycles;
+        tail++;
+    }
+
+    __atomic_store_n(&stream->tail, tail, __ATOMIC_RELEASE);
+
+    // Report drops once the ring is drained, they happened after the last event we've seen
+    const uint32_t dropped = __atomic_load_n(&stream->dropped, __ATOMIC_RELAXED);
+    if(tail == head && dropped != stream->dropped_reported &&
+       size - length >= PROFILER_STREAM_RECORD_SIZE_MAX) {
+        buffer[length++] = PROFILER_STREAM_DROP;
+        buffer[length++] = 0;
+        length += varint_uint32_pack(dropped - stream->dropped_reported, &buffer[length]);
+        stream->dropped_reported = dropped;
+    }
+
+    return length;
+}
+
+uint32_t profiler_stream_get_dropped(void) {
+    ProfilerStream* stream = profiler_stream;
+    return stream ? stream->dropped : 0;
+}
@@ -1,5 +1,33 @@
+/**
+ * @file profiler.h
+ * Cycle counter based profiler
+ *
+ * Two flavours are provided:
+ * - Dictionary profiler: named timers accumulated in a Profiler instance and
+ *   printed with profiler_dump. Convenient for ad-hoc measurements in thread
+ *   context.
+ * - Probes: statically registered probe ids (see profiler_probes.h) that are
+ *   cheap enough for interrupt handlers. Enter and exit events are recorded
+ *   into a global ring while a stream is running and read out in a compact
+ *   binary format for host side analysis, e.g. flame graphs.
+ *
+ * Stream format, all integers are little endian:
+ * - Header, once per stream: "FZPF" magic, u8 format version, u32 core clock
+ *   in Hz, u32 cycle counter at stream start, u8 probe count, then u8 name
+ *   length and name characters for every probe in id order.
+ * - Event record: u8 probe id with PROFILER_STREAM_EXIT bit set for exit
+ *   events, u8 exception number (0 for thread mode), varint cycle count
+ *   delta from the previous record or stream start.
+ * - Drop record: u8 PROFILER_STREAM_DROP, u8 0, varint dropped event count.
+ */
 #pragma once
 
+#include "profiler_probes.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -18,6 +46,83 @@ void profiler_stop(Profiler* profiler, const char* key);
 
 void profiler_dump(Profiler* profiler);
 
+/** Profiler probe ids, generated from PROFILER_PROBE_LIST */
+typedef enum {
+#define PROFILER_PROBE_ID(name) ProfilerProbe##name,
+    PROFILER_PROBE_LIST(PROFILER_PROBE_ID)
+#undef PROFILER_PROBE_ID
+    ProfilerProbeNum,
+} ProfilerProbe;
+
+#define PROFILER_STREAM_VERSION (1U)
+#define PROFILER_STREAM_EXIT    (0x80U)
+#define PROFILER_STREAM_DROP    (0x7FU)
+
+/** Smallest buffer accepted by profiler_stream_read */
+#define PROFILER_STREAM_READ_SIZE_MIN (256U)
+
+/** Record probe enter event
+ *
+ * Does nothing if stream is not running. Safe to call from ISR.
+ *
+ * @param[in]  probe  probe id
+ */
+void profiler_probe_enter(ProfilerProbe probe);
+
+/** Record probe exit event
+ *
+ * Does nothing if stream is not running. Safe to call from ISR.
+ *
+ * @param[in]  probe  probe id
+ */
+void profiler_probe_exit(ProfilerProbe probe);
+
+/** Get probe name
+ *
+ * @param[in]  probe  probe id
+ *
+ * @return     probe name
+ */
+const char* profiler_probe_get_name(ProfilerProbe probe);
+
+/** Start probe event stream
+ *
+ * @param[in]  capacity  event ring capacity, power of two
+ *
+ * @return     true on success, false if stream is already running
+ */
+bool profiler_stream_start(size_t capacity);
+
+/** Stop probe event stream
+ *
+ * MUST be called from the thread that started the stream.
+ */
+void profiler_stream_stop(void);
+
+/** Check if probe event stream is running
+ *
+ * @return     true if running
+ */
+bool profiler_stream_is_running(void);
+
+/** Read and encode pending stream data
+ *
+ * Header is emitted by the first read. MUST be called from the thread that
+ * started the stream.
+ *
+ * @param      buffer  output buffer
+ * @param[in]  size    output buffer size, at least PROFILER_STREAM_READ_SIZE_MIN
+ *
+ * @return     encoded data length, 0 if no data is pending
+ */
+size_t profiler_stream_read(uint8_t* buffer, size_t size);
+
+/** Get count of events dropped because the ring was full
+ *
+ * @return     dropped event count since stream start
+ */
+uint32_t profiler_stream_get_dropped(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,14 @@
+#pragma once
+
+/** Static profiler probe list
+ *
+ * Probe id is the position in the list and ends up in stream records, so new
+ * probes are appended to the end. Names are sent to the host in the stream
+ * header.
+ */
+#define PROFILER_PROBE_LIST(X) \
+    X(SubGhzWorkerRx)          \
+    X(SubGhzWorkerBatch)       \
+    X(NfcListenerRx)           \
+    X(NfcPollerReady)          \
+    X(NfcPollerTrx)
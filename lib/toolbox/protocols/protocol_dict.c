@@ -4,20 +4,55 @@
 struct ProtocolDict {
     const ProtocolBase** base;
     size_t count;
+    // Decoders to feed for feed_feature, rebuilt when feature changes
+    uint32_t feed_feature;
+    size_t feed_count;
+    size_t* feed_list;
     void* data[];
 };
 
+static void protocol_dict_feed_list_update(ProtocolDict* dict, uint32_t feature) {
+    if(dict->feed_feature == feature) return;
+
+    dict->feed_feature = feature;
+    dict->feed_count = 0;
+    for(size_t i = 0; i < dict->count; i++) {
+        if((dict->base[i]->features & feature) && dict->base[i]->decoder.feed) {
+            dict->feed_list[dict->feed_count++] = i;
+        }
+    }
+}
+
+static ProtocolId protocol_dict_feed_list(ProtocolDict* dict, bool level, uint32_t duration) {
+    ProtocolId ready_protocol_id = PROTOCOL_NO;
+
+    for(size_t i = 0; i < dict->feed_count; i++) {
+        const size_t index = dict->feed_list[i];
+        if(dict->base[index]->decoder.feed(dict->data[index], level, duration)) {
+            if(ready_protocol_id == PROTOCOL_NO) {
+                ready_protocol_id = index;
+            }
+        }
+    }
+
+    return ready_protocol_id;
+}
+
 ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t count) {
     furi_check(protocols);
 
     ProtocolDict* dict = malloc(sizeof(ProtocolDict) + (sizeof(void*) * count));
     dict->base = protocols;
     dict->count = count;
+    dict->feed_list = malloc(sizeof(size_t) * count);
 
     for(size_t i = 0; i < dict->count; i++) {
         dict->data[i] = dict->base[i]->alloc();
     }
 
+    // Built on first feed
+    dict->feed_feature = 0;
+
     return dict;
 }
 
@@ -28,6 +63,7 @@ void protocol_dict_free(ProtocolDict* dict) {
         dict->base[i]->free(dict->data[i]);
     }
 
+    free(dict->feed_list);
     free(dict);
 }
 
@@ -133,25 +169,34 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
     uint32_t duration) {
     furi_check(dict);
 
-    bool done = false;
-    ProtocolId ready_protocol_id = PROTOCOL_NO;
+    protocol_dict_feed_list_update(dict, feature);
+    return protocol_dict_feed_list(dict, level, duration);
+}
 
-    for(size_t i = 0; i < dict->count; i++) {
-        uint32_t features = dict->base[i]->features;
-        if(features & feature) {
-            ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
-
-            if(fn) {
-                if(fn(dict->data[i], level, duration)) {
-                    if(!done) {
-                        ready_protocol_id = i;
-                        done = true;
-                    }
-                }
-            }
-        }
+ProtocolId protocol_dict_decoders_feed_by_feature_batch(
+    ProtocolDict* dict,
+    uint32_t feature,
+    const LevelDuration* level_durations,
+    size_t count,
+    size_t* consumed) {
+    furi_check(dict);
+    furi_check(level_durations);
+    furi_check(consumed);
+
+    protocol_dict_feed_list_update(dict, feature);
+
+    ProtocolId ready_protocol_id = PROTOCOL_NO;
+    size_t i = 0;
+
+    while((i < count) && (ready_protocol_id == PROTOCOL_NO)) {
+        const LevelDuration level_duration = level_durations[i++];
+        ready_protocol_id = protocol_dict_feed_list(
+            dict,
+            level_duration_get_level(level_duration),
+            level_duration_get_duration(level_duration));
     }
 
+    *consumed = i;
     return ready_protocol_id;
 }
 
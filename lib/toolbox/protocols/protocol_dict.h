@@ -48,6 +48,26 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
     bool level,
     uint32_t duration);
 
+/** Feed decoders with given features by a batch of level durations
+ *
+ * Stops on the first level duration a decoder got ready on, so the caller
+ * can take the result and continue with the rest of the batch.
+ *
+ * @param      dict             protocol dictionary
+ * @param      feature          features mask of decoders to feed
+ * @param      level_durations  level durations to feed
+ * @param      count            level durations count
+ * @param      consumed         level durations fed, including the one the decoder got ready on
+ *
+ * @return     ready protocol id or PROTOCOL_NO
+ */
+ProtocolId protocol_dict_decoders_feed_by_feature_batch(
+    ProtocolDict* dict,
+    uint32_t feature,
+    const LevelDuration* level_durations,
+    size_t count,
+    size_t* consumed);
+
 ProtocolId protocol_dict_decoders_feed_by_id(
     ProtocolDict* dict,
     size_t protocol_index,
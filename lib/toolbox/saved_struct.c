@@ -1,4 +1,5 @@
 #include "saved_struct.h"
+#include "flash_kv.h"
 #include <furi.h>
 #include <stdint.h>
 #include <storage/storage.h>
@@ -13,60 +14,296 @@ typedef struct {
     uint32_t timestamp;
 } SavedStructHeader;
 
-bool saved_struct_save(
+#define SAVED_STRUCT_QUIET_PERIOD_MS (2000UL)
+
+/* Files are written behind: saves are queued in RAM, a newer save of the same
+ * file replaces the queued one, and the queue is written in one go once saves
+ * stop for SAVED_STRUCT_QUIET_PERIOD_MS or on saved_struct_flush(). Loads look
+ * at the queue first. Small structs in /int are also kept in FlashKv, which
+ * makes them durable right away and serves loads without the SD card. */
+typedef struct SavedStructPending {
+    struct SavedStructPending* next;
+    char* path;
+    size_t size;
+    uint8_t data[]; // header and payload
+} SavedStructPending;
+
+typedef struct {
+    FuriMutex* mutex; // guards the queue
+    FuriMutex* file_mutex; // held while a file is written or read
+    FuriTimer* timer;
+    FuriWorkQueue* work_queue;
+    SavedStructPending* pending;
+    bool busy;
+} SavedStructWriteBehind;
+
+static SavedStructWriteBehind* saved_struct_write_behind = NULL;
+
+static void saved_struct_timer_callback(void* context);
+
+static SavedStructWriteBehind* saved_struct_write_behind_get(void) {
+    SavedStructWriteBehind* instance =
+        __atomic_load_n(&saved_struct_write_behind, __ATOMIC_ACQUIRE);
+    if(instance) return instance;
+
+    instance = malloc(sizeof(SavedStructWriteBehind));
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->file_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->timer = furi_timer_alloc(saved_struct_timer_callback, FuriTimerTypeOnce, instance);
+    instance->work_queue = furi_work_queue_alloc(NULL);
+
+    SavedStructWriteBehind* expected = NULL;
+    if(!__atomic_compare_exchange_n(
+           &saved_struct_write_behind,
+           &expected,
+           instance,
+           false,
+           __ATOMIC_ACQ_REL,
+           __ATOMIC_ACQUIRE)) {
+        furi_work_queue_free(instance->work_queue);
+        furi_timer_free(instance->timer);
+        furi_mutex_free(instance->file_mutex);
+        furi_mutex_free(instance->mutex);
+        free(instance);
+        instance = expected;
+    }
+
+    return instance;
+}
+
+static void saved_struct_lock(FuriMutex* mutex) {
+    furi_check(furi_mutex_acquire(mutex, FuriWaitForever) == FuriStatusOk);
+}
+
+static void saved_struct_unlock(FuriMutex* mutex) {
+    furi_check(furi_mutex_release(mutex) == FuriStatusOk);
+}
+
+static bool saved_struct_uses_kv(const char* path, size_t size) {
+    return strncmp(path, STORAGE_INT_PATH_PREFIX "/", strlen(STORAGE_INT_PATH_PREFIX "/")) == 0 &&
+           strlen(path) <= FLASH_KV_KEY_SIZE_MAX &&
+           sizeof(SavedStructHeader) + size <= FLASH_KV_DATA_SIZE_MAX;
+}
+
+static uint8_t saved_struct_checksum(const void* data, size_t size) {
+    uint8_t checksum = 0;
+    const uint8_t* source = data;
+    for(size_t i = 0; i < size; i++) {
+        checksum += source[i];
+    }
+    return checksum;
+}
+
+static bool saved_struct_check(
     const char* path,
+    const SavedStructHeader* header,
     const void* data,
     size_t size,
     uint8_t magic,
     uint8_t version) {
-    furi_check(path);
-    furi_check(data);
-    furi_check(size);
-    SavedStructHeader header;
+    if(header->magic != magic || header->version != version) {
+        FURI_LOG_E(
+            TAG,
+            "Magic(%d != %d) or Version(%d != %d) mismatch of file \"%s\"",
+            header->magic,
+            magic,
+            header->version,
+            version,
+            path);
+        return false;
+    }
 
-    FURI_LOG_I(TAG, "Saving \"%s\"", path);
+    const uint8_t checksum = saved_struct_checksum(data, size);
+    if(header->checksum != checksum) {
+        FURI_LOG_E(
+            TAG, "Checksum(%d != %d) mismatch of file \"%s\"", header->checksum, checksum, path);
+        return false;
+    }
+
+    return true;
+}
 
-    // Store
+static bool saved_struct_file_save(const char* path, const void* data, size_t size) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* file = storage_file_alloc(storage);
-    bool result = true;
-    bool saved = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
-    if(!saved) {
+    bool result = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    if(!result) {
         FURI_LOG_E(
             TAG, "Open failed \"%s\". Error: \'%s\'", path, storage_file_get_error_desc(file));
+    } else if(storage_file_write(file, data, size) != size) {
+        FURI_LOG_E(
+            TAG, "Write failed \"%s\". Error: \'%s\'", path, storage_file_get_error_desc(file));
         result = false;
     }
 
-    if(result) {
-        // Calculate checksum
-        uint8_t checksum = 0;
-        const uint8_t* source = data;
-        for(size_t i = 0; i < size; i++) {
-            checksum += source[i];
-        }
-        // Set header
-        header.magic = magic;
-        header.version = version;
-        header.checksum = checksum;
-        header.flags = 0;
-        header.timestamp = 0;
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return result;
+}
 
-        size_t bytes_count = storage_file_write(file, &header, sizeof(header));
-        bytes_count += storage_file_write(file, data, size);
+static void saved_struct_pending_free(SavedStructPending* pending) {
+    free(pending->path);
+    free(pending);
+}
 
-        if(bytes_count != (size + sizeof(header))) {
-            FURI_LOG_E(
-                TAG, "Write failed \"%s\". Error: \'%s\'", path, storage_file_get_error_desc(file));
-            result = false;
+static void saved_struct_drain(SavedStructWriteBehind* instance) {
+    // Queue is taken under file_mutex, so two drains can't reorder saves of a file
+    saved_struct_lock(instance->file_mutex);
+    while(true) {
+        saved_struct_lock(instance->mutex);
+        SavedStructPending* pending = instance->pending;
+        if(pending) instance->pending = pending->next;
+        saved_struct_unlock(instance->mutex);
+
+        if(!pending) break;
+
+        saved_struct_file_save(pending->path, pending->data, pending->size);
+        saved_struct_pending_free(pending);
+    }
+    saved_struct_unlock(instance->file_mutex);
+}
+
+static void saved_struct_drain_job(FuriWorkQueueJobId job_id, void* context) {
+    UNUSED(job_id);
+    SavedStructWriteBehind* instance = context;
+
+    saved_struct_drain(instance);
+}
+
+static void saved_struct_drain_done(FuriWorkQueueJobId job_id, bool cancelled, void* context) {
+    UNUSED(job_id);
+    UNUSED(cancelled);
+    SavedStructWriteBehind* instance = context;
+
+    saved_struct_lock(instance->mutex);
+    instance->busy = false;
+    const bool restart = instance->pending != NULL;
+    saved_struct_unlock(instance->mutex);
+
+    // Saves that came during the drain start a new quiet period.
+    // Timer is started outside of the lock, its callback takes the lock too.
+    if(restart) furi_timer_start(instance->timer, SAVED_STRUCT_QUIET_PERIOD_MS);
+}
+
+static void saved_struct_timer_callback(void* context) {
+    SavedStructWriteBehind* instance = context;
+
+    saved_struct_lock(instance->mutex);
+    if(!instance->busy && instance->pending) {
+        instance->busy = true;
+        furi_work_queue_submit(
+            instance->work_queue,
+            FuriWorkQueuePriorityLow,
+            saved_struct_drain_job,
+            saved_struct_drain_done,
+            instance);
+    }
+    saved_struct_unlock(instance->mutex);
+}
+
+static void saved_struct_enqueue(const char* path, const void* data, size_t size) {
+    SavedStructWriteBehind* instance = saved_struct_write_behind_get();
+
+    SavedStructPending* pending = malloc(sizeof(SavedStructPending) + size);
+    pending->next = NULL;
+    pending->path = strdup(path);
+    pending->size = size;
+    memcpy(pending->data, data, size);
+
+    saved_struct_lock(instance->mutex);
+    // Newer save of the same file replaces the queued one
+    SavedStructPending** link = &instance->pending;
+    while(*link && strcmp((*link)->path, path) != 0) {
+        link = &(*link)->next;
+    }
+    if(*link) {
+        SavedStructPending* replaced = *link;
+        pending->next = replaced->next;
+        saved_struct_pending_free(replaced);
+    }
+    *link = pending;
+
+    const bool restart = !instance->busy;
+    saved_struct_unlock(instance->mutex);
+
+    // Every save pushes the write further, until saves stop
+    if(restart) furi_timer_start(instance->timer, SAVED_STRUCT_QUIET_PERIOD_MS);
+}
+
+/* Copy up to `size` bytes of the queued save of `path`, returns queued size or 0 */
+static size_t saved_struct_pending_read(const char* path, void* data, size_t size) {
+    SavedStructWriteBehind* instance =
+        __atomic_load_n(&saved_struct_write_behind, __ATOMIC_ACQUIRE);
+    if(!instance) return 0;
+
+    size_t result = 0;
+    saved_struct_lock(instance->mutex);
+    for(SavedStructPending* pending = instance->pending; pending; pending = pending->next) {
+        if(strcmp(pending->path, path) == 0) {
+            result = pending->size;
+            memcpy(data, pending->data, MIN(size, result));
+            break;
         }
     }
+    saved_struct_unlock(instance->mutex);
 
-    storage_file_close(file);
-    storage_file_free(file);
-    furi_record_close(RECORD_STORAGE);
     return result;
 }
 
+static void saved_struct_file_lock(void) {
+    SavedStructWriteBehind* instance =
+        __atomic_load_n(&saved_struct_write_behind, __ATOMIC_ACQUIRE);
+    if(instance) saved_struct_lock(instance->file_mutex);
+}
+
+static void saved_struct_file_unlock(void) {
+    SavedStructWriteBehind* instance =
+        __atomic_load_n(&saved_struct_write_behind, __ATOMIC_ACQUIRE);
+    if(instance) saved_struct_unlock(instance->file_mutex);
+}
+
+bool saved_struct_save(
+    const char* path,
+    const void* data,
+    size_t size,
+    uint8_t magic,
+    uint8_t version) {
+    furi_check(path);
+    furi_check(data);
+    furi_check(size);
+
+    FURI_LOG_I(TAG, "Saving \"%s\"", path);
+
+    const size_t total = sizeof(SavedStructHeader) + size;
+    uint8_t* buffer = malloc(total);
+    SavedStructHeader* header = (SavedStructHeader*)buffer;
+    header->magic = magic;
+    header->version = version;
+    header->checksum = saved_struct_checksum(data, size);
+    header->flags = 0;
+    header->timestamp = 0;
+    memcpy(buffer + sizeof(SavedStructHeader), data, size);
+
+    if(!saved_struct_uses_kv(path, size) || !flash_kv_write(path, buffer, total)) {
+        // Stale value must not shadow the file
+        flash_kv_remove(path);
+    }
+    saved_struct_enqueue(path, buffer, total);
+
+    free(buffer);
+    return true;
+}
+
+void saved_struct_flush(void) {
+    SavedStructWriteBehind* instance =
+        __atomic_load_n(&saved_struct_write_behind, __ATOMIC_ACQUIRE);
+    if(!instance) return;
+
+    FURI_LOG_I(TAG, "Flushing");
+    saved_struct_drain(instance);
+}
+
 bool saved_struct_load(const char* path, void* data, size_t size, uint8_t magic, uint8_t version) {
     furi_check(path);
     furi_check(data);
@@ -74,52 +311,55 @@ bool saved_struct_load(const char* path, void* data, size_t size, uint8_t magic,
 
     FURI_LOG_I(TAG, "Loading \"%s\"", path);
 
-    SavedStructHeader header;
+    const size_t total = sizeof(SavedStructHeader) + size;
+    uint8_t* buffer = malloc(total);
+    const SavedStructHeader* header = (const SavedStructHeader*)buffer;
+    const uint8_t* data_read = buffer + sizeof(SavedStructHeader);
 
-    uint8_t* data_read = malloc(size);
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(storage);
-    bool result = true;
-    bool loaded = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
-    if(!loaded) {
-        FURI_LOG_E(
-            TAG, "Failed to read \"%s\". Error: %s", path, storage_file_get_error_desc(file));
-        result = false;
+    const bool uses_kv = saved_struct_uses_kv(path, size);
+    bool cached = false;
+    bool result = false;
+
+    if(saved_struct_pending_read(path, buffer, total) == total) {
+        // Not written yet, newer than anything else
+        result = saved_struct_check(path, header, data_read, size, magic, version);
+        cached = true;
+    } else if(uses_kv && flash_kv_read(path, buffer, total) == total) {
+        cached = true;
+        result = saved_struct_check(path, header, data_read, size, magic, version);
     }
 
-    if(result) {
-        size_t bytes_count = storage_file_read(file, &header, sizeof(SavedStructHeader));
-        bytes_count += storage_file_read(file, data_read, size);
+    if(!result) {
+        saved_struct_file_lock();
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        File* file = storage_file_alloc(storage);
 
-        if(bytes_count != (sizeof(SavedStructHeader) + size)) {
-            FURI_LOG_E(TAG, "Size mismatch of file \"%s\"", path);
-            result = false;
-        }
-    }
+        do {
+            if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+                FURI_LOG_E(
+                    TAG,
+                    "Failed to read \"%s\". Error: %s",
+                    path,
+                    storage_file_get_error_desc(file));
+                break;
+            }
 
-    if(result && (header.magic != magic || header.version != version)) {
-        FURI_LOG_E(
-            TAG,
-            "Magic(%d != %d) or Version(%d != %d) mismatch of file \"%s\"",
-            header.magic,
-            magic,
-            header.version,
-            version,
-            path);
-        result = false;
-    }
+            if(storage_file_read(file, buffer, total) != total) {
+                FURI_LOG_E(TAG, "Size mismatch of file \"%s\"", path);
+                break;
+            }
 
-    if(result) {
-        uint8_t checksum = 0;
-        const uint8_t* source = (const uint8_t*)data_read;
-        for(size_t i = 0; i < size; i++) {
-            checksum += source[i];
-        }
+            result = saved_struct_check(path, header, data_read, size, magic, version);
+        } while(false);
 
-        if(header.checksum != checksum) {
-            FURI_LOG_E(
-                TAG, "Checksum(%d != %d) mismatch of file \"%s\"", header.checksum, checksum, path);
-            result = false;
+        storage_file_close(file);
+        storage_file_free(file);
+        furi_record_close(RECORD_STORAGE);
+        saved_struct_file_unlock();
+
+        // First load after update or format, next boots read from flash
+        if(result && uses_kv && !cached) {
+            flash_kv_write(path, buffer, total);
         }
     }
 
@@ -127,10 +367,7 @@ bool saved_struct_load(const char* path, void* data, size_t size, uint8_t magic,
         memcpy(data, data_read, size);
     }
 
-    storage_file_close(file);
-    storage_file_free(file);
-    furi_record_close(RECORD_STORAGE);
-    free(data_read);
+    free(buffer);
 
     return result;
 }
@@ -143,6 +380,23 @@ bool saved_struct_get_metadata(
     furi_check(path);
 
     SavedStructHeader header;
+
+    size_t cached_size = saved_struct_pending_read(path, &header, sizeof(SavedStructHeader));
+    if(!cached_size) cached_size = flash_kv_read(path, &header, sizeof(SavedStructHeader));
+    if(cached_size >= sizeof(SavedStructHeader)) {
+        if(magic) {
+            *magic = header.magic;
+        }
+        if(version) {
+            *version = header.version;
+        }
+        if(payload_size) {
+            *payload_size = cached_size - sizeof(SavedStructHeader);
+        }
+        return true;
+    }
+
+    saved_struct_file_lock();
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* file = storage_file_alloc(storage);
 
@@ -177,6 +431,7 @@ bool saved_struct_get_metadata(
     storage_file_close(file);
     storage_file_free(file);
     furi_record_close(RECORD_STORAGE);
+    saved_struct_file_unlock();
 
     return result;
 }
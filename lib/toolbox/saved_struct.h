@@ -26,6 +26,9 @@ extern "C" {
 bool saved_struct_load(const char* path, void* data, size_t size, uint8_t magic, uint8_t version);
 
 /** Save data in saved structure format
+ *
+ * File is written behind: saves are queued and written together once they
+ * stop coming for a while, loads see queued data right away.
  *
  * @param[in]  path     The path to the file
  * @param[in]  data     Pointer to the memory where data
@@ -33,7 +36,7 @@ bool saved_struct_load(const char* path, void* data, size_t size, uint8_t magic,
  * @param[in]  magic    The magic to embed into metadata
  * @param[in]  version  The version to embed into metadata
  *
- * @return     true on success, false otherwise
+ * @return     true if data was accepted, write errors are only logged
  */
 bool saved_struct_save(
     const char* path,
@@ -42,6 +45,12 @@ bool saved_struct_save(
     uint8_t magic,
     uint8_t version);
 
+/** Write all queued saves now
+ *
+ * Blocks until files are written. Call it before power off or reboot.
+ */
+void saved_struct_flush(void);
+
 /** Get SavedStructure file metadata
  *
  * @param[in]  path          The path to the file
@@ -4,6 +4,8 @@
 #include "file_stream.h"
 #include "stream_cache.h"
 
+#define BUFFERED_FILE_STREAM_CACHE_SIZE_DEFAULT 1024U
+
 typedef struct {
     Stream stream_base;
     Stream* file_stream;
@@ -27,6 +29,9 @@ static bool buffered_file_stream_delete_and_insert(
     StreamWriteCB write_callback,
     const void* ctx);
 
+static bool
+    buffered_file_stream_read_line(BufferedFileStream* stream, FuriString* str_result);
+
 static bool buffered_file_stream_flush(BufferedFileStream* stream);
 static bool buffered_file_stream_unread(BufferedFileStream* stream);
 
@@ -40,13 +45,18 @@ const StreamVTable buffered_file_stream_vtable = {
     .write = (StreamWriteFn)buffered_file_stream_write,
     .read = (StreamReadFn)buffered_file_stream_read,
     .delete_and_insert = (StreamDeleteAndInsertFn)buffered_file_stream_delete_and_insert,
+    .read_line = (StreamReadLineFn)buffered_file_stream_read_line,
 };
 
 Stream* buffered_file_stream_alloc(Storage* storage) {
+    return buffered_file_stream_alloc_ex(storage, BUFFERED_FILE_STREAM_CACHE_SIZE_DEFAULT);
+}
+
+Stream* buffered_file_stream_alloc_ex(Storage* storage, size_t cache_size) {
     BufferedFileStream* stream = malloc(sizeof(BufferedFileStream));
 
     stream->file_stream = file_stream_alloc(storage);
-    stream->cache = stream_cache_alloc();
+    stream->cache = stream_cache_alloc_ex(cache_size);
     stream->sync_pending = false;
 
     stream->stream_base.vtable = &buffered_file_stream_vtable;
@@ -222,6 +232,31 @@ static bool buffered_file_stream_delete_and_insert(
     return success;
 }
 
+static bool buffered_file_stream_read_line(BufferedFileStream* stream, FuriString* str_result) {
+    bool found = false;
+    while(!found) {
+        const uint8_t* data;
+        const size_t size = stream_cache_peek(stream->cache, &data);
+        if(size == 0) {
+            if(stream->sync_pending) {
+                if(!buffered_file_stream_flush(stream)) break;
+            }
+            if(!stream_cache_fill(stream->cache, stream->file_stream)) break;
+            continue;
+        }
+
+        // Take the line out of the cache as is, no need to read it and seek back
+        const uint8_t* eol = memchr(data, '\n', size);
+        const size_t line_size = eol ? (size_t)(eol - data) + 1 : size;
+        for(size_t i = 0; i < line_size; i++) {
+            if(data[i] != '\r') furi_string_push_back(str_result, data[i]);
+        }
+        stream_cache_seek(stream->cache, line_size);
+        found = (eol != NULL);
+    }
+    return furi_string_size(str_result) != 0;
+}
+
 // Write the cache into the underlying stream and adjust seek position
 static bool buffered_file_stream_flush(BufferedFileStream* stream) {
     bool success = false;
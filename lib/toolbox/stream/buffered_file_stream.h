@@ -13,6 +13,16 @@ extern "C" {
  */
 Stream* buffered_file_stream_alloc(Storage* storage);
 
+/**
+ * Allocate a file stream with buffered read operations and a custom cache size
+ * Cache starts at 1 KB and grows up to the given size while the file is read sequentially,
+ * so large files are read in fewer storage requests.
+ * @param storage pointer to a Storage instance
+ * @param cache_size maximum cache size in bytes
+ * @return Stream*
+ */
+Stream* buffered_file_stream_alloc_ex(Storage* storage, size_t cache_size);
+
 /**
  * Opens an existing file or creates a new one.
  * @param stream pointer to file stream object.
@@ -70,6 +70,13 @@ FS_Error file_stream_get_error(Stream* _stream) {
     return storage_file_get_error(stream->file);
 }
 
+bool file_stream_preallocate(Stream* _stream, size_t size) {
+    furi_check(_stream);
+    FileStream* stream = (FileStream*)_stream;
+    furi_check(stream->stream_base.vtable == &file_stream_vtable);
+    return storage_file_preallocate(stream->file, size);
+}
+
 static void file_stream_free(FileStream* stream) {
     storage_file_free(stream->file);
     free(stream);
@@ -87,8 +94,14 @@ static void file_stream_clean(FileStream* stream) {
 static bool file_stream_seek(FileStream* stream, int32_t offset, StreamOffset offset_type) {
     bool result = false;
     size_t seek_position = 0;
-    size_t current_position = file_stream_tell(stream);
-    size_t size = file_stream_size(stream);
+    // Get both in one storage request
+    StorageFileOp ops[] = {
+        {.type = StorageFileOpTell},
+        {.type = StorageFileOpSize},
+    };
+    storage_file_batch(stream->file, ops, COUNT_OF(ops));
+    size_t current_position = ops[0].result;
+    size_t size = ops[1].result;
 
     // calc offset and limit to bottom
     switch(offset_type) {
@@ -42,6 +42,14 @@ bool file_stream_close(Stream* stream);
  */
 FS_Error file_stream_get_error(Stream* stream);
 
+/**
+ * Allocates contiguous space for the file, see storage_file_preallocate()
+ * @param stream pointer to stream object, the file must be empty
+ * @param size space size, in bytes
+ * @return true if the space was allocated
+ */
+bool file_stream_preallocate(Stream* stream, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -152,6 +152,10 @@ bool stream_read_line(Stream* stream, FuriString* str_result) {
     furi_check(str_result);
 
     furi_string_reset(str_result);
+    if(stream->vtable->read_line) {
+        return stream->vtable->read_line(stream, str_result);
+    }
+
     uint8_t buffer[STREAM_BUFFER_SIZE];
 
     do {
@@ -1,29 +1,46 @@
 #include "stream_cache.h"
 
-#define STREAM_CACHE_MAX_SIZE 1024U
+#define STREAM_CACHE_DEFAULT_SIZE 1024U
 
 struct StreamCache {
-    uint8_t data[STREAM_CACHE_MAX_SIZE];
+    uint8_t* data;
     size_t data_size;
     size_t position;
+    // Allocated size, grows up to max_size with read-ahead
+    size_t capacity;
+    size_t max_size;
+    size_t fill_size;
 };
 
 StreamCache* stream_cache_alloc(void) {
+    return stream_cache_alloc_ex(STREAM_CACHE_DEFAULT_SIZE);
+}
+
+StreamCache* stream_cache_alloc_ex(size_t max_size) {
+    furi_check(max_size);
     StreamCache* cache = malloc(sizeof(StreamCache));
+    cache->max_size = max_size;
+    cache->fill_size = MIN(max_size, STREAM_CACHE_DEFAULT_SIZE);
+    cache->capacity = cache->fill_size;
+    cache->data = malloc(cache->capacity);
     cache->data_size = 0;
     cache->position = 0;
     return cache;
 }
+
 void stream_cache_free(StreamCache* cache) {
     furi_assert(cache);
     cache->data_size = 0;
     cache->position = 0;
+    free(cache->data);
     free(cache);
 }
 
 void stream_cache_drop(StreamCache* cache) {
     cache->data_size = 0;
     cache->position = 0;
+    // Access is not sequential anymore
+    cache->fill_size = MIN(cache->max_size, STREAM_CACHE_DEFAULT_SIZE);
 }
 
 bool stream_cache_at_end(StreamCache* cache) {
@@ -40,7 +57,18 @@ size_t stream_cache_pos(StreamCache* cache) {
 }
 
 size_t stream_cache_fill(StreamCache* cache, Stream* stream) {
-    const size_t size_read = stream_read(stream, cache->data, STREAM_CACHE_MAX_SIZE);
+    // Whole cache was read through, read further ahead this time
+    if(cache->data_size == cache->fill_size && cache->position == cache->data_size &&
+       cache->fill_size < cache->max_size) {
+        cache->fill_size = MIN(cache->fill_size * 2, cache->max_size);
+        if(cache->fill_size > cache->capacity) {
+            cache->capacity = cache->fill_size;
+            free(cache->data);
+            cache->data = malloc(cache->capacity);
+        }
+    }
+
+    const size_t size_read = stream_read(stream, cache->data, cache->fill_size);
     cache->data_size = size_read;
     cache->position = 0;
     return size_read;
@@ -66,7 +94,7 @@ size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size) {
 
 size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size) {
     furi_assert(cache->data_size >= cache->position);
-    const size_t size_written = MIN(size, STREAM_CACHE_MAX_SIZE - cache->position);
+    const size_t size_written = MIN(size, cache->capacity - cache->position);
     if(size_written > 0) {
         memcpy(cache->data + cache->position, data, size_written);
         cache->position += size_written;
@@ -77,6 +105,12 @@ size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size)
     return size_written;
 }
 
+size_t stream_cache_peek(StreamCache* cache, const uint8_t** data) {
+    furi_assert(cache->data_size >= cache->position);
+    *data = cache->data + cache->position;
+    return cache->data_size - cache->position;
+}
+
 int32_t stream_cache_seek(StreamCache* cache, int32_t offset) {
     furi_assert(cache->data_size >= cache->position);
     int32_t actual_offset = 0;
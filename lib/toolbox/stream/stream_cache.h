@@ -14,6 +14,14 @@ typedef struct StreamCache StreamCache;
  */
 StreamCache* stream_cache_alloc(void);
 
+/**
+ * Allocate stream cache with read-ahead.
+ * Cache starts at the default size and doubles on sequential reads, up to the maximum size.
+ * @param max_size Maximum cache size in bytes
+ * @return StreamCache* pointer to a StreamCache instance
+ */
+StreamCache* stream_cache_alloc_ex(size_t max_size);
+
 /**
  * Free stream cache.
  * @param cache Pointer to a StreamCache instance
@@ -81,6 +89,14 @@ size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size);
  */
 size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size);
 
+/**
+ * Get cached data after the internal cursor without advancing it.
+ * @param cache Pointer to a StreamCache instance.
+ * @param data Pointer to the data, valid until the cache is modified.
+ * @return Size of data after the cursor.
+ */
+size_t stream_cache_peek(StreamCache* cache, const uint8_t** data);
+
 /**
  * Move the internal cursor relatively to its current position.
  * @param cache Pointer to a StreamCache instance.
@@ -24,6 +24,7 @@ typedef bool (*StreamDeleteAndInsertFn)(
     size_t delete_size,
     StreamWriteCB write_cb,
     const void* ctx);
+typedef bool (*StreamReadLineFn)(Stream* stream, FuriString* str_result);
 
 struct StreamVTable {
     const StreamFreeFn free;
@@ -35,6 +36,8 @@ struct StreamVTable {
     const StreamWriteFn write;
     const StreamReadFn read;
     const StreamDeleteAndInsertFn delete_and_insert;
+    // Optional, streams with own buffering can scan it directly
+    const StreamReadLineFn read_line;
 };
 
 struct Stream {
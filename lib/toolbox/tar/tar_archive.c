@@ -11,6 +11,10 @@
 #define MAX_NAME_LEN    255
 #define FILE_BLOCK_SIZE 512
 
+// Whole sectors per storage request when unpacking, two of them are in flight for write-behind
+#define EXTRACT_BLOCK_SIZE  (8 * FILE_BLOCK_SIZE)
+#define EXTRACT_BLOCK_COUNT 2
+
 #define FILE_OPEN_NTRIES      10
 #define FILE_OPEN_RETRY_DELAY 25
 
@@ -31,6 +35,7 @@ TarOpenMode tar_archive_get_mode_for_path(const char* path) {
 typedef struct TarArchive {
     Storage* storage;
     File* stream;
+    bool is_stream; // Archive is not a file, see tar_archive_open_stream
     mtar_t tar;
     tar_unpack_file_cb unpack_cb;
     void* unpack_cb_context;
@@ -76,6 +81,10 @@ typedef struct {
 
 /* HSDS 'heatshrink data stream' header magic */
 static const uint32_t HEATSHRINK_MAGIC = 0x53445348;
+/* Plain heatshrink stream follows the header */
+#define HEATSHRINK_VERSION_STREAM (1u)
+/* Block framed stream with block index follows the header, see compress_encode_blocks */
+#define HEATSHRINK_VERSION_BLOCKS (2u)
 
 typedef struct {
     uint32_t magic;
@@ -122,6 +131,99 @@ const struct mtar_ops heatshrink_ops = {
     .close = mtar_heatshrink_file_close,
 };
 
+/* Callback stream backend - forward only, heatshrink is optional on read */
+
+typedef struct {
+    TarArchiveStreamCallback callback;
+    void* context;
+    size_t position;
+    CompressConfigHeatshrink heatshrink_config;
+    CompressStreamDecoder* decoder;
+    uint8_t lookahead[sizeof(HeatshrinkStreamHeader)]; // Read while detecting compression
+    size_t lookahead_size;
+    size_t lookahead_front;
+} TarCallbackStream;
+
+static int32_t tar_callback_stream_read_raw(void* context, uint8_t* buffer, size_t size) {
+    TarCallbackStream* cb_stream = context;
+    size_t done = 0;
+
+    while(done < size && cb_stream->lookahead_front < cb_stream->lookahead_size) {
+        buffer[done++] = cb_stream->lookahead[cb_stream->lookahead_front++];
+    }
+
+    while(done < size) {
+        int32_t result = cb_stream->callback(cb_stream->context, buffer + done, size - done);
+        if(result <= 0) break;
+        done += result;
+    }
+
+    return done;
+}
+
+static int mtar_callback_stream_read(void* stream, void* data, unsigned size) {
+    TarCallbackStream* cb_stream = stream;
+    bool success;
+    if(cb_stream->decoder) {
+        success = compress_stream_decoder_read(cb_stream->decoder, data, size);
+    } else {
+        success = tar_callback_stream_read_raw(cb_stream, data, size) == (int32_t)size;
+    }
+    if(!success) return MTAR_EREADFAIL;
+
+    cb_stream->position += size;
+    return size;
+}
+
+static int mtar_callback_stream_write(void* stream, const void* data, unsigned size) {
+    TarCallbackStream* cb_stream = stream;
+    size_t done = 0;
+    while(done < size) {
+        int32_t result =
+            cb_stream->callback(cb_stream->context, (uint8_t*)data + done, size - done);
+        if(result <= 0) return MTAR_EWRITEFAIL;
+        done += result;
+    }
+
+    cb_stream->position += size;
+    return size;
+}
+
+static int mtar_callback_stream_seek(void* stream, unsigned offset) {
+    TarCallbackStream* cb_stream = stream;
+    if(offset < cb_stream->position) {
+        return MTAR_ESEEKFAIL;
+    }
+
+    // Skip data of entries that are not extracted
+    uint8_t skip_buffer[64];
+    while(cb_stream->position < offset) {
+        const size_t size = MIN(offset - cb_stream->position, sizeof(skip_buffer));
+        if(mtar_callback_stream_read(cb_stream, skip_buffer, size) != (int)size) {
+            return MTAR_ESEEKFAIL;
+        }
+    }
+    return MTAR_ESUCCESS;
+}
+
+static int mtar_callback_stream_close(void* stream) {
+    TarCallbackStream* cb_stream = stream;
+    if(cb_stream) {
+        if(cb_stream->decoder) {
+            compress_stream_decoder_free(cb_stream->decoder);
+        }
+        free(cb_stream);
+    }
+    return MTAR_ESUCCESS;
+}
+
+const struct mtar_ops callback_stream_ops = {
+    .read = mtar_callback_stream_read,
+    .write = mtar_callback_stream_write,
+    .seek = mtar_callback_stream_seek,
+    .close = mtar_callback_stream_close,
+};
+
 //////////////////////////////////////////////////////////////////////////
 
 TarArchive* tar_archive_alloc(Storage* storage) {
@@ -138,6 +240,12 @@ static int32_t file_read_cb(void* context, uint8_t* buffer, size_t buffer_size)
     return storage_file_read(file, buffer, buffer_size);
 }
 
+static bool heatshrink_file_seek_cb(void* context, size_t offset) {
+    File* file = context;
+    // Block offsets count from the end of the stream header
+    return storage_file_seek(file, sizeof(HeatshrinkStreamHeader) + offset, true);
+}
+
 bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
     furi_check(archive);
     FS_AccessMode access_mode;
@@ -176,7 +284,9 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         HeatshrinkStreamHeader header;
         if(storage_file_read(stream, &header, sizeof(HeatshrinkStreamHeader)) !=
                sizeof(HeatshrinkStreamHeader) ||
-           header.magic != HEATSHRINK_MAGIC) {
+           header.magic != HEATSHRINK_MAGIC ||
+           (header.version != HEATSHRINK_VERSION_STREAM &&
+            header.version != HEATSHRINK_VERSION_BLOCKS)) {
             storage_file_close(stream);
             return false;
         }
@@ -185,9 +295,18 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         hs_stream->stream = stream;
         hs_stream->heatshrink_config.window_sz2 = header.window_sz2;
         hs_stream->heatshrink_config.lookahead_sz2 = header.lookahead_sz2;
-        hs_stream->heatshrink_config.input_buffer_sz = FILE_BLOCK_SIZE;
+        hs_stream->heatshrink_config.input_buffer_sz = EXTRACT_BLOCK_SIZE;
         hs_stream->decoder = compress_stream_decoder_alloc(
             CompressTypeHeatshrink, &hs_stream->heatshrink_config, file_read_cb, stream);
+
+        if(header.version == HEATSHRINK_VERSION_BLOCKS &&
+           !compress_stream_decoder_load_index(
+               hs_stream->decoder,
+               heatshrink_file_seek_cb,
+               storage_file_size(stream) - sizeof(HeatshrinkStreamHeader))) {
+            mtar_heatshrink_file_close(hs_stream);
+            return false;
+        }
         mtar_init(&archive->tar, mtar_access, &heatshrink_ops, hs_stream);
     } else {
         mtar_init(&archive->tar, mtar_access, &filesystem_ops, stream);
@@ -196,6 +315,55 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
     return true;
 }
 
+bool tar_archive_open_stream(
+    TarArchive* archive,
+    TarOpenMode mode,
+    TarArchiveStreamCallback callback,
+    void* context) {
+    furi_check(archive);
+    furi_check(callback);
+
+    TarCallbackStream* cb_stream = malloc(sizeof(TarCallbackStream));
+    cb_stream->callback = callback;
+    cb_stream->context = context;
+
+    if(mode == TarOpenModeWrite) {
+        mtar_init(&archive->tar, MTAR_WRITE, &callback_stream_ops, cb_stream);
+        archive->is_stream = true;
+        return true;
+    } else if(mode != TarOpenModeRead && mode != TarOpenModeReadHeatshrink) {
+        free(cb_stream);
+        return false;
+    }
+
+    HeatshrinkStreamHeader header;
+    cb_stream->lookahead_size =
+        tar_callback_stream_read_raw(cb_stream, cb_stream->lookahead, sizeof(header));
+    memcpy(&header, cb_stream->lookahead, sizeof(header));
+
+    const bool compressed = cb_stream->lookahead_size == sizeof(header) &&
+                            header.magic == HEATSHRINK_MAGIC &&
+                            header.version == HEATSHRINK_VERSION_STREAM;
+    if(compressed) {
+        cb_stream->lookahead_size = 0;
+        cb_stream->heatshrink_config.window_sz2 = header.window_sz2;
+        cb_stream->heatshrink_config.lookahead_sz2 = header.lookahead_sz2;
+        cb_stream->heatshrink_config.input_buffer_sz = FILE_BLOCK_SIZE;
+        cb_stream->decoder = compress_stream_decoder_alloc(
+            CompressTypeHeatshrink,
+            &cb_stream->heatshrink_config,
+            tar_callback_stream_read_raw,
+            cb_stream);
+    } else if(mode == TarOpenModeReadHeatshrink) {
+        free(cb_stream);
+        return false;
+    }
+
+    mtar_init(&archive->tar, MTAR_READ, &callback_stream_ops, cb_stream);
+    archive->is_stream = true;
+    return true;
+}
+
 void tar_archive_free(TarArchive* archive) {
     furi_check(archive);
     if(mtar_is_open(&archive->tar)) {
@@ -231,7 +399,7 @@ int32_t tar_archive_get_entries_count(TarArchive* archive) {
 
 bool tar_archive_get_read_progress(TarArchive* archive, int32_t* processed, int32_t* total) {
     furi_check(archive);
-    if(mtar_access_mode(&archive->tar) != MTAR_READ) {
+    if(mtar_access_mode(&archive->tar) != MTAR_READ || archive->is_stream) {
         return false;
     }
 
@@ -292,10 +460,20 @@ typedef struct {
     TarArchiveNameConverter converter;
 } TarArchiveDirectoryOpParams;
 
-static bool archive_extract_current_file(TarArchive* archive, const char* dst_path) {
+static bool archive_extract_wait_write(FuriMessageQueue* completions) {
+    StorageAsyncCompletion completion;
+    furi_check(furi_message_queue_get(completions, &completion, FuriWaitForever) == FuriStatusOk);
+    return completion.error == FSE_OK && completion.size == (size_t)completion.context;
+}
+
+static bool
+    archive_extract_current_file(TarArchive* archive, const char* dst_path, size_t size) {
     mtar_t* tar = &archive->tar;
     File* out_file = storage_file_alloc(archive->storage);
-    uint8_t* readbuf = malloc(FILE_BLOCK_SIZE);
+    uint8_t* readbuf = malloc(EXTRACT_BLOCK_SIZE * EXTRACT_BLOCK_COUNT);
+    FuriMessageQueue* completions =
+        furi_message_queue_alloc(EXTRACT_BLOCK_COUNT, sizeof(StorageAsyncCompletion));
+    size_t pending = 0;
 
     bool success = true;
     uint8_t n_tries = FILE_OPEN_NTRIES;
@@ -314,15 +492,40 @@ static bool archive_extract_current_file(TarArchive* archive, const char* dst_pa
             break;
         }
 
-        while(!mtar_eof_data(tar)) {
-            int32_t readcnt = mtar_read_data(tar, readbuf, FILE_BLOCK_SIZE);
-            if(!readcnt || !storage_file_write(out_file, readbuf, readcnt)) {
+        if(size > EXTRACT_BLOCK_SIZE) {
+            storage_file_preallocate(out_file, size);
+        }
+
+        // Storage thread writes one block while the next one is read and decompressed
+        for(size_t block = 0; !mtar_eof_data(tar); block = (block + 1) % EXTRACT_BLOCK_COUNT) {
+            if(pending == EXTRACT_BLOCK_COUNT) {
+                pending--;
+                if(!archive_extract_wait_write(completions)) {
+                    success = false;
+                    break;
+                }
+            }
+
+            uint8_t* block_buf = readbuf + block * EXTRACT_BLOCK_SIZE;
+            int32_t readcnt = mtar_read_data(tar, block_buf, EXTRACT_BLOCK_SIZE);
+            if(readcnt <= 0) {
                 success = false;
                 break;
             }
+
+            storage_file_write_async(
+                out_file, block_buf, readcnt, completions, (void*)(size_t)readcnt);
+            pending++;
+        }
+
+        for(; pending; pending--) {
+            if(!archive_extract_wait_write(completions)) {
+                success = false;
+            }
         }
     } while(false);
     storage_file_free(out_file);
+    furi_message_queue_free(completions);
     free(readbuf);
 
     return success;
@@ -340,7 +543,7 @@ static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header,
     }
 
     if(skip_entry) {
-        FURI_LOG_W(TAG, "filter: skipping entry \"%s\"", header->name);
+        FURI_LOG_D(TAG, "filter: skipping entry \"%s\"", header->name);
         return 0;
     }
 
@@ -375,8 +578,8 @@ static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header,
     full_extracted_fname = furi_string_alloc();
     path_concat(op_params->work_dir, furi_string_get_cstr(converted_fname), full_extracted_fname);
 
-    bool success =
-        archive_extract_current_file(archive, furi_string_get_cstr(full_extracted_fname));
+    bool success = archive_extract_current_file(
+        archive, furi_string_get_cstr(full_extracted_fname), header->size);
 
     furi_string_free(converted_fname);
     furi_string_free(full_extracted_fname);
@@ -511,5 +714,6 @@ bool tar_archive_unpack_file(
     if(mtar_find(&archive->tar, archive_fname) != MTAR_ESUCCESS) {
         return false;
     }
-    return archive_extract_current_file(archive, destination);
+    // Size is not known in advance here, so the file is not preallocated
+    return archive_extract_current_file(archive, destination, 0);
 }
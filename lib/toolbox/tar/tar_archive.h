@@ -48,6 +48,38 @@ TarArchive* tar_archive_alloc(Storage* storage);
  */
 bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode);
 
+/** Stream callback for tar_archive_open_stream
+ *
+ * Reads or writes (depending on the open mode) up to size bytes.
+ *
+ * @param      context  Callback context
+ * @param      buffer   Data buffer
+ * @param      size     Bytes to read or write
+ *
+ * @return     Bytes processed, less than size at the end of the stream or on error
+ */
+typedef int32_t (*TarArchiveStreamCallback)(void* context, uint8_t* buffer, size_t size);
+
+/** Open tar archive over a byte stream
+ *
+ * Stream can only go forward: archive is processed in a single pass, so
+ * tar_archive_get_entries_count and tar_archive_unpack_file are not usable.
+ * In TarOpenModeRead a heatshrink compressed stream is detected by its
+ * header, compressed streams with a block index are not supported.
+ *
+ * @param       archive       Tar archive object
+ * @param       mode          Open mode
+ * @param       callback      Stream callback
+ * @param       context       Callback context
+ *
+ * @return true if successful
+ */
+bool tar_archive_open_stream(
+    TarArchive* archive,
+    TarOpenMode mode,
+    TarArchiveStreamCallback callback,
+    void* context);
+
 /** Tar archive destructor
  *
  * @param archive Tar archive object
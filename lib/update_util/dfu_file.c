@@ -7,6 +7,8 @@
 #define DFU_SUFFIX_VERSION   0x011A
 #define DFU_SIGNATURE        "DfuSe"
 
+#define DFU_READ_BUFFER_COUNT 2
+
 bool dfu_file_validate_crc(File* dfuf, const DfuPageTaskProgressCb progress_cb, void* context) {
     uint32_t file_crc = crc32_calc_file(dfuf, progress_cb, context);
 
@@ -89,18 +91,37 @@ static DfuUpdateBlockResult dfu_file_perform_task_for_update_pages(
         return UpdateBlockResult_Skipped;
     }
 
-    uint8_t* fw_block = malloc(FLASH_PAGE_SIZE);
-    size_t bytes_read = 0;
+    /* Next page is read from SD while current one is being processed */
+    uint8_t* fw_blocks = malloc(FLASH_PAGE_SIZE * DFU_READ_BUFFER_COUNT);
+    FuriMessageQueue* completions =
+        furi_message_queue_alloc(DFU_READ_BUFFER_COUNT, sizeof(StorageAsyncCompletion));
+    size_t pending = 0;
+    uint8_t block = 0;
     uint32_t element_offs = 0;
+    uint32_t read_offs = 0;
 
     while(element_offs < header->dwElementSize) {
-        uint32_t n_bytes_to_read = FLASH_PAGE_SIZE;
-        if((element_offs + n_bytes_to_read) > header->dwElementSize) {
-            n_bytes_to_read = header->dwElementSize - element_offs;
+        while((pending < DFU_READ_BUFFER_COUNT) && (read_offs < header->dwElementSize)) {
+            size_t n_bytes_to_read = FLASH_PAGE_SIZE;
+            if((read_offs + n_bytes_to_read) > header->dwElementSize) {
+                n_bytes_to_read = header->dwElementSize - read_offs;
+            }
+
+            uint8_t* read_block =
+                fw_blocks + ((block + pending) % DFU_READ_BUFFER_COUNT) * FLASH_PAGE_SIZE;
+            storage_file_read_async(
+                dfuf, read_block, n_bytes_to_read, completions, (void*)n_bytes_to_read);
+            read_offs += n_bytes_to_read;
+            pending++;
         }
 
-        bytes_read = storage_file_read(dfuf, fw_block, n_bytes_to_read);
-        if(bytes_read == 0) {
+        StorageAsyncCompletion completion;
+        furi_check(
+            furi_message_queue_get(completions, &completion, FuriWaitForever) == FuriStatusOk);
+        pending--;
+
+        const size_t bytes_read = completion.size;
+        if((completion.error != FSE_OK) || (bytes_read != (size_t)completion.context)) {
             break;
         }
 
@@ -109,15 +130,26 @@ static DfuUpdateBlockResult dfu_file_perform_task_for_update_pages(
             break;
         }
 
-        if(!task->task_cb(i_page, fw_block, bytes_read)) {
+        if(!task->task_cb(
+               i_page, fw_blocks + block * FLASH_PAGE_SIZE, bytes_read, task->context)) {
             break;
         }
+        block = (block + 1) % DFU_READ_BUFFER_COUNT;
 
         element_offs += bytes_read;
         task->progress_cb(element_offs * 100 / header->dwElementSize, task->context);
     }
 
-    free(fw_block);
+    /* Buffers must not be released while reads into them are in flight */
+    while(pending > 0) {
+        StorageAsyncCompletion completion;
+        furi_check(
+            furi_message_queue_get(completions, &completion, FuriWaitForever) == FuriStatusOk);
+        pending--;
+    }
+
+    furi_message_queue_free(completions);
+    free(fw_blocks);
     return (element_offs == header->dwElementSize) ? UpdateBlockResult_OK :
                                                      UpdateBlockResult_Failed;
 }
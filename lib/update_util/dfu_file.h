@@ -12,8 +12,11 @@ typedef enum {
     UpdateBlockResult_Failed
 } DfuUpdateBlockResult;
 
-typedef bool (
-    *DfuPageTaskCb)(const uint8_t i_page, const uint8_t* update_block, uint16_t update_block_len);
+typedef bool (*DfuPageTaskCb)(
+    const uint8_t i_page,
+    const uint8_t* update_block,
+    uint16_t update_block_len,
+    void* context);
 typedef void (*DfuPageTaskProgressCb)(const uint8_t progress, void* context);
 typedef bool (*DfuAddressValidationCb)(const size_t address);
 
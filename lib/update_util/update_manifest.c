@@ -14,6 +14,7 @@
 #define MANIFEST_KEY_RADIO_VERSION "Radio version"
 #define MANIFEST_KEY_RADIO_CRC     "Radio CRC"
 #define MANIFEST_KEY_ASSETS_FILE   "Resources"
+#define MANIFEST_KEY_ASSETS_LIST   "Resources manifest"
 #define MANIFEST_KEY_OB_REFERENCE  "OB reference"
 #define MANIFEST_KEY_OB_MASK       "OB mask"
 #define MANIFEST_KEY_OB_WRITE_MASK "OB write mask"
@@ -26,6 +27,7 @@ UpdateManifest* update_manifest_alloc(void) {
     update_manifest->radio_image = furi_string_alloc();
     update_manifest->staged_loader_file = furi_string_alloc();
     update_manifest->resource_bundle = furi_string_alloc();
+    update_manifest->resource_manifest = furi_string_alloc();
     update_manifest->splash_file = furi_string_alloc();
     update_manifest->target = 0;
     update_manifest->manifest_version = 0;
@@ -43,6 +45,7 @@ void update_manifest_free(UpdateManifest* update_manifest) {
     furi_string_free(update_manifest->radio_image);
     furi_string_free(update_manifest->staged_loader_file);
     furi_string_free(update_manifest->resource_bundle);
+    furi_string_free(update_manifest->resource_manifest);
     furi_string_free(update_manifest->splash_file);
     free(update_manifest);
 }
@@ -93,6 +96,8 @@ static bool
             sizeof(uint32_t));
         flipper_format_read_string(
             flipper_file, MANIFEST_KEY_ASSETS_FILE, update_manifest->resource_bundle);
+        flipper_format_read_string(
+            flipper_file, MANIFEST_KEY_ASSETS_LIST, update_manifest->resource_manifest);
 
         flipper_format_read_hex(
             flipper_file,
@@ -38,6 +38,7 @@ typedef struct {
     UpdateManifestRadioVersion radio_version;
     uint32_t radio_crc;
     FuriString* resource_bundle;
+    FuriString* resource_manifest; /**< Per-file digests of resource_bundle, in archive order */
     FuriHalFlashRawOptionByteData ob_reference;
     FuriHalFlashRawOptionByteData ob_compare_mask;
     FuriHalFlashRawOptionByteData ob_write_mask;
@@ -1,5 +1,6 @@
 #!/usr/bin/env python3
 
+import fnmatch
 import os
 import shutil
 
@@ -43,6 +44,12 @@ class Main(App):
             required=False,
             default="assets_icons",
         )
+        self.parser_icons.add_argument(
+            "--uncompressed",
+            help="Store icons matching name pattern (like A_Loading_24) uncompressed",
+            action="append",
+            default=[],
+        )
 
         self.parser_icons.set_defaults(func=self.icons)
 
@@ -103,8 +110,12 @@ class Main(App):
         )
         self.parser_dolphin.set_defaults(func=self.dolphin)
 
-    def _icon2header(self, file):
-        image = file2image(file)
+    def _icon2header(self, file, icon_name):
+        compress = not any(
+            fnmatch.fnmatchcase(icon_name, pattern)
+            for pattern in self.args.uncompressed
+        )
+        image = file2image(file, compress)
         if image.width > MAX_IMAGE_WIDTH or image.height > MAX_IMAGE_HEIGHT:
             raise Exception(
                 f"Image {file} is too big ({image.width}x{image.height} vs. {MAX_IMAGE_WIDTH}x{MAX_IMAGE_HEIGHT})"
@@ -148,7 +159,9 @@ class Main(App):
                     elif not self._iconIsSupported(filename):
                         continue
                     self.logger.debug(f"Processing animation frame {filename}")
-                    temp_width, temp_height, data = self._icon2header(fullfilename)
+                    temp_width, temp_height, data = self._icon2header(
+                        fullfilename, icon_name
+                    )
                     if width is None:
                         width = temp_width
                     if height is None:
@@ -180,7 +193,7 @@ class Main(App):
                         "-", "_"
                     )
                     fullfilename = os.path.join(dirpath, filename)
-                    width, height, data = self._icon2header(fullfilename)
+                    width, height, data = self._icon2header(fullfilename, icon_name)
                     frame_name = f"_{icon_name}_0"
                     icons_c.write(
                         ICONS_TEMPLATE_C_FRAME.format(name=frame_name, data=data)
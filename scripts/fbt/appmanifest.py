@@ -158,6 +158,12 @@ class AppManager:
                     f"App {kw.get('appid')} cannot have fal_embedded set"
                 )
 
+        if "StaticAllocation" in kw.get("flags", ()):
+            if apptype != FlipperAppType.SERVICE:
+                raise FlipperManifestException(
+                    f"App {kw.get('appid')}: only services can have 'StaticAllocation' flag"
+                )
+
         if apptype in AppBuildset.dist_app_types:
             # For distributing .fap's resources, there's "fap_file_assets"
             for app_property in ("resources",):
@@ -445,7 +451,7 @@ class AppBuildset:
     def get_apps_of_type(self, apptype: FlipperAppType, all_known: bool = False):
         """Looks up apps of given type in current app set. If all_known is true,
         ignores app set and checks all loaded apps' manifests."""
-        return sorted(
+        apps = sorted(
             filter(
                 lambda app: app.apptype == apptype,
                 (
@@ -456,6 +462,34 @@ class AppBuildset:
             ),
             key=lambda app: app.order,
         )
+        if apptype == FlipperAppType.SERVICE and not all_known:
+            apps = self._sort_by_start_wave(apps)
+        return apps
+
+    @staticmethod
+    def _sort_by_start_wave(apps: List[FlipperApplication]):
+        """Groups apps into start waves: each app goes after every app from
+        the list it requires. Apps within a wave keep manifest order."""
+        apps_by_id = {app.appid: app for app in apps}
+        waves = {}
+
+        def get_wave(app: FlipperApplication, chain: List[str]):
+            if app.appid in chain:
+                raise AppBuilderException(
+                    f"Dependency cycle: {' -> '.join(chain + [app.appid])}"
+                )
+            if app.appid not in waves:
+                waves[app.appid] = 1 + max(
+                    (
+                        get_wave(apps_by_id[dep_name], chain + [app.appid])
+                        for dep_name in app.requires
+                        if dep_name in apps_by_id
+                    ),
+                    default=-1,
+                )
+            return waves[app.appid]
+
+        return sorted(apps, key=lambda app: (get_wave(app, []), app.order))
 
     def get_builtin_apps(self):
         return list(
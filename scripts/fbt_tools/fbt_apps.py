@@ -47,16 +47,29 @@ class ApplicationsCGenerator:
             return f"extern void {app.entry_point}(void);"
         return f"extern int32_t {app.entry_point}(void* p);"
 
+    def get_app_static_storage(self, app: FlipperApplication):
+        if "StaticAllocation" not in app.flags:
+            return []
+        return [
+            f"static FuriThreadStatic {app.appid}_thread_storage;",
+            f"static uint8_t {app.appid}_stack[{app.stack_size}] __attribute__((aligned(8)));",
+        ]
+
     def get_app_descr(self, app: FlipperApplication):
         if app.apptype == FlipperAppType.STARTUP:
             return app.entry_point
+        static_storage = ""
+        if "StaticAllocation" in app.flags:
+            static_storage = f""",
+     .thread_storage = &{app.appid}_thread_storage,
+     .stack = {app.appid}_stack"""
         return f"""
     {{.app = {app.entry_point},
      .name = "{app.name}",
      .appid = "{app.appid}", 
      .stack_size = {app.stack_size},
      .icon = {f"&{app.icon}" if app.icon else "NULL"},
-     .flags = {'|'.join(f"FlipperInternalApplicationFlag{flag}" for flag in app.flags)} }}"""
+     .flags = {'|'.join(f"FlipperInternalApplicationFlag{flag}" for flag in app.flags)}{static_storage} }}"""
 
     def get_external_app_descr(self, app: FlipperApplication):
         app_path = "/ext/apps"
@@ -79,6 +92,8 @@ class ApplicationsCGenerator:
             contents.extend(
                 map(self.get_app_ep_forward, self.buildset.get_apps_of_type(apptype))
             )
+            for app in self.buildset.get_apps_of_type(apptype):
+                contents.extend(self.get_app_static_storage(app))
             entry_type, entry_block = self.APP_TYPE_MAP[apptype]
             contents.append(f"const {entry_type} {entry_block}[] = {{")
             contents.append(
@@ -121,12 +121,15 @@ def _proto_ver_generator(target, source, env):
         file.write("\n".join(version_file_data))
 
 
-def CompileIcons(env, target_dir, source_dir, *, icon_bundle_name="assets_icons"):
+def CompileIcons(
+    env, target_dir, source_dir, *, icon_bundle_name="assets_icons", uncompressed=()
+):
     return env.IconBuilder(
         target_dir,
         None,
         ICON_SRC_DIR=source_dir,
         ICON_FILE_NAME=icon_bundle_name,
+        ICON_UNCOMPRESSED=list(uncompressed),
     )
 
 
@@ -158,6 +161,7 @@ def generate(env):
                             "${TARGET.dir}",
                             "--filename",
                             "${ICON_FILE_NAME}",
+                            "${_concat('--uncompressed=', ICON_UNCOMPRESSED, '', __env__)}",
                         ],
                     ],
                     "${ICONSCOMSTR}",
@@ -1,6 +1,7 @@
 import os
 import shutil
 
+from flipper.assets.emv import EmvResourceIndex
 from SCons.Action import Action
 from SCons.Builder import Builder
 from SCons.Errors import StopError
@@ -69,6 +70,11 @@ def _resources_dist_action(target, source, env):
         if isinstance(src, File):
             os.makedirs(os.path.dirname(target.path), exist_ok=True)
             shutil.copy(src.path, target.path)
+            # EMV lookup tables get a sorted index, see nfc_emv_parser.c
+            if target.name.endswith(".nfc") and EmvResourceIndex.is_resource_file(
+                target.path
+            ):
+                EmvResourceIndex.build_file(target.path)
         elif isinstance(src, Dir):
             shutil.copytree(src.path, target.path)
         else:
@@ -0,0 +1,74 @@
+import re
+import struct
+
+EMV_RESOURCES_HEADER = b"Filetype: Flipper EMV resources"
+
+
+class EmvResourceIndex:
+    """Sorted binary index of a Flipper EMV resource file
+
+    Fixed size records sorted by hex decoded key, followed by the value
+    pool. Read by nfc_emv_parser.c with binary search, keep in sync.
+    """
+
+    MAGIC = 0x49564D45  # "EMVI"
+    VERSION = 1
+    KEY_SIZE_MAX = 16
+    SUFFIX = ".idx"
+
+    # magic, version, key size, record count, source file size
+    HEADER = struct.Struct("<IBBHI")
+    # key, key length, value size, value offset in pool
+    RECORD_TAIL = struct.Struct("<BBH")
+
+    _KEY_RE = re.compile(rb"^(?:[0-9A-F]{2})+$")
+
+    @staticmethod
+    def is_resource_file(path):
+        with open(path, "rb") as file:
+            return file.readline().rstrip(b"\r\n") == EMV_RESOURCES_HEADER
+
+    @classmethod
+    def _parse(cls, data):
+        records = {}
+        for line in data.split(b"\n")[2:]:
+            key, separator, _ = line.partition(b":")
+            if not separator or key.startswith(b"#"):
+                continue
+            # Lookups only ever ask for upper case hex keys
+            if not cls._KEY_RE.match(key) or len(key) > cls.KEY_SIZE_MAX * 2:
+                continue
+            # Same as flipper_format: delimiter and one space skipped, CR dropped
+            value = line[len(key) + 2 :].replace(b"\r", b"")
+            if len(value) > 0xFF:
+                raise ValueError(f"Value of {key.decode()} is too long")
+            # First occurrence wins, same as flipper_format lookup
+            records.setdefault(bytes.fromhex(key.decode()), value)
+        return records
+
+    @classmethod
+    def build(cls, data):
+        records = cls._parse(data)
+        key_size = max(map(len, records), default=1)
+
+        index = bytearray(
+            cls.HEADER.pack(cls.MAGIC, cls.VERSION, key_size, len(records), len(data))
+        )
+        pool = bytearray()
+        # Same order as nfc_emv_parser.c compare: zero padded key, then length
+        keys = sorted(records, key=lambda key: (key.ljust(key_size, b"\0"), len(key)))
+        for key in keys:
+            value = records[key]
+            index += key.ljust(key_size, b"\0")
+            index += cls.RECORD_TAIL.pack(len(key), len(value), len(pool))
+            pool += value
+            if len(pool) > 0xFFFF:
+                raise ValueError("Value pool is too large")
+        return bytes(index + pool)
+
+    @classmethod
+    def build_file(cls, path):
+        with open(path, "rb") as file:
+            data = file.read()
+        with open(path + cls.SUFFIX, "wb") as file:
+            file.write(cls.build(data))
@@ -4,14 +4,18 @@ import struct
 class HeatshrinkDataStreamHeader:
     MAGIC = 0x53445348
     VERSION = 1
+    # Block framed stream, see compress_encode_blocks
+    VERSION_BLOCKS = 2
+    VERSIONS = (VERSION, VERSION_BLOCKS)
 
-    def __init__(self, window_size, lookahead_size):
+    def __init__(self, window_size, lookahead_size, version=VERSION):
         self.window_size = window_size
         self.lookahead_size = lookahead_size
+        self.version = version
 
     def pack(self):
         return struct.pack(
-            "<IBBB", self.MAGIC, self.VERSION, self.window_size, self.lookahead_size
+            "<IBBB", self.MAGIC, self.version, self.window_size, self.lookahead_size
         )
 
     @staticmethod
@@ -21,6 +25,66 @@ class HeatshrinkDataStreamHeader:
         magic, version, window_size, lookahead_size = struct.unpack("<IBBB", data)
         if magic != HeatshrinkDataStreamHeader.MAGIC:
             raise ValueError("Invalid magic number")
-        if version != HeatshrinkDataStreamHeader.VERSION:
+        if version not in HeatshrinkDataStreamHeader.VERSIONS:
             raise ValueError("Invalid version")
-        return HeatshrinkDataStreamHeader(window_size, lookahead_size)
+        return HeatshrinkDataStreamHeader(window_size, lookahead_size, version)
+
+
+class HeatshrinkBlockStream:
+    FOOTER_MAGIC = 0x46425348
+    FOOTER_FORMAT = "<IIII"
+
+    @staticmethod
+    def compress(data, block_size, window_sz2, lookahead_sz2):
+        import heatshrink2
+
+        blocks = []
+        offsets = []
+        offset = 0
+        for start in range(0, len(data), block_size):
+            block = heatshrink2.compress(
+                data[start : start + block_size],
+                window_sz2=window_sz2,
+                lookahead_sz2=lookahead_sz2,
+            )
+            offsets.append(offset)
+            offset += len(block)
+            blocks.append(block)
+
+        footer = struct.pack(
+            HeatshrinkBlockStream.FOOTER_FORMAT,
+            HeatshrinkBlockStream.FOOTER_MAGIC,
+            block_size,
+            len(offsets),
+            len(data),
+        )
+        index = struct.pack(f"<{len(offsets)}I", *offsets)
+        return b"".join(blocks) + index + footer
+
+    @staticmethod
+    def decompress(stream, window_sz2, lookahead_sz2):
+        import heatshrink2
+
+        footer_size = struct.calcsize(HeatshrinkBlockStream.FOOTER_FORMAT)
+        magic, block_size, block_count, data_size = struct.unpack(
+            HeatshrinkBlockStream.FOOTER_FORMAT, stream[-footer_size:]
+        )
+        if magic != HeatshrinkBlockStream.FOOTER_MAGIC:
+            raise ValueError("Invalid block footer")
+        index_offset = len(stream) - footer_size - block_count * 4
+        offsets = list(
+            struct.unpack(f"<{block_count}I", stream[index_offset:-footer_size])
+        )
+        offsets.append(index_offset)
+
+        data = b"".join(
+            heatshrink2.decompress(
+                stream[offsets[i] : offsets[i + 1]],
+                window_sz2=window_sz2,
+                lookahead_sz2=lookahead_sz2,
+            )
+            for i in range(block_count)
+        )
+        if len(data) != data_size:
+            raise ValueError("Invalid block stream size")
+        return data
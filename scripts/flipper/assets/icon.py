@@ -77,7 +77,7 @@ class ImageTools:
 __tools = ImageTools()
 
 
-def file2image(file):
+def file2image(file, compress=True):
     output = __tools.png2xbm(file)
     assert output
 
@@ -90,6 +90,10 @@ def file2image(file):
 
     data_bin = bytearray.fromhex(data_str)
 
+    # Uncompressed icons are drawn straight from flash
+    if not compress:
+        return Image(width, height, b"\x00" + data_bin)
+
     # Encode icon data with LZSS
     data_encoded_str = __tools.xbm2hs(data_bin)
 
@@ -3,7 +3,7 @@ import tarfile
 
 import heatshrink2
 
-from .heatshrink_stream import HeatshrinkDataStreamHeader
+from .heatshrink_stream import HeatshrinkBlockStream, HeatshrinkDataStreamHeader
 
 FLIPPER_TAR_FORMAT = tarfile.USTAR_FORMAT
 TAR_HEATSRINK_EXTENSION = ".ths"
@@ -17,7 +17,12 @@ def tar_sanitizer_filter(tarinfo: tarfile.TarInfo):
 
 
 def compress_tree_tarball(
-    src_dir, output_name, filter=tar_sanitizer_filter, hs_window=13, hs_lookahead=6
+    src_dir,
+    output_name,
+    filter=tar_sanitizer_filter,
+    hs_window=13,
+    hs_lookahead=6,
+    hs_block_size=0,
 ):
     plain_tar = io.BytesIO()
     with tarfile.open(
@@ -29,11 +34,18 @@ def compress_tree_tarball(
     plain_tar.seek(0)
 
     src_data = plain_tar.read()
-    compressed = heatshrink2.compress(
-        src_data, window_sz2=hs_window, lookahead_sz2=hs_lookahead
-    )
-
-    header = HeatshrinkDataStreamHeader(hs_window, hs_lookahead)
+    if hs_block_size:
+        compressed = HeatshrinkBlockStream.compress(
+            src_data, hs_block_size, hs_window, hs_lookahead
+        )
+        version = HeatshrinkDataStreamHeader.VERSION_BLOCKS
+    else:
+        compressed = heatshrink2.compress(
+            src_data, window_sz2=hs_window, lookahead_sz2=hs_lookahead
+        )
+        version = HeatshrinkDataStreamHeader.VERSION
+
+    header = HeatshrinkDataStreamHeader(hs_window, hs_lookahead, version)
     with open(output_name, "wb") as f:
         f.write(header.pack())
         f.write(compressed)
@@ -16,6 +16,12 @@ class Main(App):
         self.parser_elfsize.add_argument("elfname", action="store")
         self.parser_elfsize.set_defaults(func=self.process_elf)
 
+        self.parser_ramfunc = self.subparsers.add_parser(
+            "ramfunc", help="Dump functions placed in RAM with FURI_RAMFUNC"
+        )
+        self.parser_ramfunc.add_argument("elfname", action="store")
+        self.parser_ramfunc.set_defaults(func=self.process_ramfunc)
+
         self.parser_binsize = self.subparsers.add_parser("bin", help="Dump bin stats")
         self.parser_binsize.add_argument("binname", action="store")
         self.parser_binsize.set_defaults(func=self.process_bin)
@@ -39,6 +45,38 @@ class Main(App):
 
         return 0
 
+    def process_ramfunc(self):
+        symbols = subprocess.check_output(
+            ["arm-none-eabi-nm", "-S", "--size-sort", "-r", self.args.elfname],
+            shell=False,
+        )
+        markers = subprocess.check_output(
+            ["arm-none-eabi-nm", self.args.elfname], shell=False
+        )
+
+        bounds = {}
+        for line in markers.decode("utf-8").splitlines():
+            parts = line.split()
+            if len(parts) == 3 and parts[2] in ("__ramfunc_start__", "__ramfunc_end__"):
+                bounds[parts[2]] = int(parts[0], 16)
+        if len(bounds) != 2:
+            self.logger.error("No RAM function section in this firmware")
+            return 1
+        start, end = bounds["__ramfunc_start__"], bounds["__ramfunc_end__"]
+
+        for line in symbols.decode("utf-8").splitlines():
+            parts = line.split()
+            if len(parts) != 4 or parts[2] not in "tT":
+                continue
+            # Thumb functions have the lowest address bit set
+            address = int(parts[0], 16) & ~1
+            if start <= address < end:
+                print(f"{parts[3]:<48} {int(parts[1], 16):>6}")
+
+        size = end - start
+        print(f"{'.ramfunc':<48} {size:>6} ({(size/1024):6.2f} K of RAM)")
+        return 0
+
     def process_bin(self):
         PAGE_SIZE = 4096
         binsize = os.path.getsize(self.args.binname)
@@ -2,7 +2,10 @@
 
 import heatshrink2 as hs
 from flipper.app import App
-from flipper.assets.heatshrink_stream import HeatshrinkDataStreamHeader
+from flipper.assets.heatshrink_stream import (
+    HeatshrinkBlockStream,
+    HeatshrinkDataStreamHeader,
+)
 from flipper.assets.tarball import compress_tree_tarball
 
 
@@ -28,6 +31,13 @@ class HSWrapper(App):
             type=int,
             default=self.DEFAULT_LOOKAHEAD,
         )
+        self.parser_compress.add_argument(
+            "-b",
+            "--block-size",
+            help="block size for random access, 0 for plain stream",
+            type=int,
+            default=0,
+        )
         self.parser_compress.add_argument("file", help="file to compress")
         self.parser_compress.add_argument(
             "-o", "--output", help="output file", required=True
@@ -64,6 +74,13 @@ class HSWrapper(App):
             type=int,
             default=self.DEFAULT_LOOKAHEAD,
         )
+        self.parser_tar.add_argument(
+            "-b",
+            "--block-size",
+            help="block size for random access, 0 for plain stream",
+            type=int,
+            default=0,
+        )
         self.parser_tar.set_defaults(func=self.tar)
 
     def compress(self):
@@ -72,12 +89,19 @@ class HSWrapper(App):
         with open(args.file, "rb") as f:
             data = f.read()
 
-        compressed = hs.compress(
-            data, window_sz2=args.window, lookahead_sz2=args.lookahead
-        )
+        if args.block_size:
+            compressed = HeatshrinkBlockStream.compress(
+                data, args.block_size, args.window, args.lookahead
+            )
+            version = HeatshrinkDataStreamHeader.VERSION_BLOCKS
+        else:
+            compressed = hs.compress(
+                data, window_sz2=args.window, lookahead_sz2=args.lookahead
+            )
+            version = HeatshrinkDataStreamHeader.VERSION
 
         with open(args.output, "wb") as f:
-            header = HeatshrinkDataStreamHeader(args.window, args.lookahead)
+            header = HeatshrinkDataStreamHeader(args.window, args.lookahead, version)
             f.write(header.pack())
             f.write(compressed)
 
@@ -98,11 +122,16 @@ class HSWrapper(App):
             f"Decompressing with window size {header.window_size} and lookahead size {header.lookahead_size}"
         )
 
-        data = hs.decompress(
-            compressed,
-            window_sz2=header.window_size,
-            lookahead_sz2=header.lookahead_size,
-        )
+        if header.version == HeatshrinkDataStreamHeader.VERSION_BLOCKS:
+            data = HeatshrinkBlockStream.decompress(
+                compressed, header.window_size, header.lookahead_size
+            )
+        else:
+            data = hs.decompress(
+                compressed,
+                window_sz2=header.window_size,
+                lookahead_sz2=header.lookahead_size,
+            )
 
         with open(args.output, "wb") as f:
             f.write(data)
@@ -130,7 +159,11 @@ class HSWrapper(App):
         args = self.args
 
         orig_size, compressed_size = compress_tree_tarball(
-            args.dir, args.output, hs_window=args.window, hs_lookahead=args.lookahead
+            args.dir,
+            args.output,
+            hs_window=args.window,
+            hs_lookahead=args.lookahead,
+            hs_block_size=args.block_size,
         )
 
         self.logger.info(
@@ -0,0 +1,234 @@
+#!/usr/bin/env python3
+
+import re
+import struct
+
+import serial
+from elftools.elf.constants import SH_FLAGS
+from elftools.elf.elffile import ELFFile
+from flipper.app import App
+from flipper.utils.cdc import resolve_port
+
+# Must match FuriLogBinaryHeader in furi/core/log.h
+RECORD_SYNC = 0xA5
+RECORD_HEADER = struct.Struct("<BBBBIIII")
+RECORD_FLAG_FORMAT_INLINE = 1 << 0
+RECORD_FLAG_TRUNCATED = 1 << 1
+
+LEVEL_LETTERS = {2: "E", 3: "W", 4: "I", 5: "D", 6: "T"}
+TAG_LENGTH_MAX = 32
+
+CONVERSION_RE = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d+))?"
+    r"(?P<length>hh|h|ll|l|L|q|j|z|t)?(?P<conversion>[diouxXcfFeEgGaAspn%])"
+)
+
+
+def fnv1a(data: bytes) -> int:
+    value = 2166136261
+    for byte in data:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+class FirmwareStrings:
+    """Format and tag strings from firmware ELF"""
+
+    def __init__(self, elf_path: str):
+        self.sections = []
+        self.tags = {}
+        with open(elf_path, "rb") as file:
+            elf = ELFFile(file)
+            for section in elf.iter_sections():
+                if section["sh_type"] != "SHT_PROGBITS":
+                    continue
+                if not section["sh_flags"] & SH_FLAGS.SHF_ALLOC:
+                    continue
+                self.sections.append((section["sh_addr"], section.data()))
+
+        # Tags are not sent, only their hashes. Linker merges string tails, so suffixes count too
+        for _, data in self.sections:
+            for chunk in data.split(b"\0"):
+                for start in range(max(0, len(chunk) - TAG_LENGTH_MAX), len(chunk)):
+                    tag = chunk[start:]
+                    if tag.isascii() and tag.isprintable():
+                        self.tags.setdefault(fnv1a(tag), tag.decode("ascii"))
+
+    def get_string(self, address: int) -> str | None:
+        for base, data in self.sections:
+            if base <= address < base + len(data):
+                end = data.find(b"\0", address - base)
+                return data[address - base : end].decode("utf-8", "replace")
+        return None
+
+    def get_tag(self, tag_hash: int) -> str:
+        return self.tags.get(tag_hash, f"#{tag_hash:08x}")
+
+
+class ArgumentReader:
+    def __init__(self, data: bytes):
+        self.data = data
+        self.position = 0
+
+    def unpack(self, fmt: str):
+        size = struct.calcsize(fmt)
+        if self.position + size > len(self.data):
+            raise IndexError
+        (value,) = struct.unpack_from(fmt, self.data, self.position)
+        self.position += size
+        return value
+
+    def string(self) -> str:
+        end = self.data.find(b"\0", self.position)
+        if end < 0:
+            raise IndexError
+        value = self.data[self.position : end].decode("utf-8", "replace")
+        self.position = end + 1
+        return value
+
+
+def format_record(fmt: str, reader: ArgumentReader) -> str:
+    """Apply arguments to C format string, the way target printf does"""
+
+    def replace(match):
+        groups = match.groupdict()
+        conversion = groups["conversion"]
+        if conversion == "%":
+            return "%"
+
+        width = groups["width"] or ""
+        if width == "*":
+            width = str(reader.unpack("<i"))
+        precision = groups["precision"]
+        if precision == "*":
+            precision = str(reader.unpack("<i"))
+        spec = "%" + groups["flags"] + width + (f".{precision}" if precision else "")
+
+        length = groups["length"] or ""
+        wide = length in ("ll", "q", "j", "L")
+        if conversion in "di":
+            return (spec + "d") % reader.unpack("<q" if wide else "<i")
+        elif conversion in "ouxX":
+            return (spec + conversion.replace("u", "d")) % reader.unpack(
+                "<Q" if wide else "<I"
+            )
+        elif conversion == "c":
+            return (spec + "c") % chr(reader.unpack("<I") & 0xFF)
+        elif conversion in "aA":
+            return float.hex(reader.unpack("<d"))
+        elif conversion in "fFeEgG":
+            return (spec + conversion) % reader.unpack("<d")
+        elif conversion == "s":
+            return (spec + "s") % reader.string()
+        elif conversion == "p":
+            return f"0x{reader.unpack('<I'):x}"
+        return ""
+
+    try:
+        return CONVERSION_RE.sub(replace, fmt)
+    except IndexError:
+        return fmt + " <arguments missing>"
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser.add_argument("-e", "--elf", help="Firmware ELF", required=True)
+        self.parser.add_argument(
+            "-i", "--input", help="Decode captured binary log instead of device"
+        )
+        self.parser.add_argument("-l", "--level", help="Log level", default="")
+        self.parser.add_argument(
+            "-f",
+            "--frequency",
+            help="CPU frequency, for timestamps",
+            type=int,
+            default=64000000,
+        )
+        self.parser.set_defaults(func=self.decode)
+
+    def print_record(self, header, payload):
+        _, size, level, flags, timestamp, thread_id, tag_hash, fmt_address = header
+        reader = ArgumentReader(payload)
+
+        if flags & RECORD_FLAG_FORMAT_INLINE:
+            fmt = reader.string()
+        else:
+            fmt = self.strings.get_string(fmt_address)
+            if fmt is None:
+                fmt = f"<unknown format 0x{fmt_address:08x}>"
+
+        text = format_record(fmt, reader)
+        if flags & RECORD_FLAG_TRUNCATED:
+            text += " <truncated>"
+
+        # DWT counter is 32 bit, keep time running over its overflows
+        if timestamp < self.last_timestamp:
+            self.timestamp_base += 1 << 32
+        self.last_timestamp = timestamp
+        time_ms = (self.timestamp_base + timestamp) * 1000 / self.args.frequency
+
+        print(
+            f"{time_ms:12.3f} "
+            f"[{LEVEL_LETTERS.get(level, ' ')}][{self.strings.get_tag(tag_hash)}]"
+            f"[0x{thread_id:08x}] {text}"
+        )
+
+    def process(self, buffer: bytearray):
+        while True:
+            start = buffer.find(bytes([RECORD_SYNC]))
+            if start < 0:
+                buffer.clear()
+                return
+            del buffer[:start]
+            if len(buffer) < RECORD_HEADER.size:
+                return
+
+            header = RECORD_HEADER.unpack_from(buffer)
+            size, level = header[1], header[2]
+            if size < RECORD_HEADER.size or level not in LEVEL_LETTERS:
+                # Not a record, resync on next byte
+                del buffer[:1]
+                continue
+            if len(buffer) < size:
+                return
+
+            self.print_record(header, bytes(buffer[RECORD_HEADER.size : size]))
+            del buffer[:size]
+
+    def decode(self):
+        self.strings = FirmwareStrings(self.args.elf)
+        self.logger.info(f"Loaded {len(self.strings.tags)} tag candidates")
+        self.timestamp_base = 0
+        self.last_timestamp = 0
+        buffer = bytearray()
+
+        if self.args.input:
+            with open(self.args.input, "rb") as file:
+                buffer.extend(file.read())
+            self.process(buffer)
+            return 0
+
+        if not (port := resolve_port(self.logger, self.args.port)):
+            self.logger.error("Is Flipper connected via USB and not in DFU mode?")
+            return 1
+
+        flipper = serial.Serial(port, timeout=0.1)
+        flipper.reset_input_buffer()
+        flipper.write(f"log binary {self.args.level}\r".encode("ascii"))
+        flipper.read_until(b"Press CTRL+C to stop...\r\n")
+
+        try:
+            while True:
+                buffer.extend(flipper.read(flipper.in_waiting or 1))
+                self.process(buffer)
+        except KeyboardInterrupt:
+            flipper.write(b"\x03")
+        finally:
+            flipper.close()
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+
+import json
+from dataclasses import dataclass
+
+from flipper.app import App
+from flipper.storage import FlipperStorage
+from flipper.utils.cdc import resolve_port
+
+STACK_WATERMARK_PATH = "/int/.stack_watermark"
+STACK_WATERMARK_FILE_TYPE = "Flipper stack watermarks"
+STACK_WATERMARK_FILE_VERSION = 1
+
+
+@dataclass
+class StackRecord:
+    name: str
+    stack_size: int
+    min_free: int
+    devices: int = 1
+
+    @property
+    def used(self):
+        return self.stack_size - self.min_free
+
+    def recommend(self, margin: int, headroom: int, align: int):
+        target = max(self.used * (100 + margin) // 100, self.used + headroom)
+        return (target + align - 1) // align * align
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser.add_argument(
+            "files",
+            nargs="*",
+            help=f"Local copies of {STACK_WATERMARK_PATH} collected from several devices, "
+            "read from the connected device if none given",
+        )
+        self.parser.add_argument(
+            "--margin",
+            help="Headroom over the deepest recorded use, percent",
+            type=int,
+            default=25,
+        )
+        self.parser.add_argument(
+            "--headroom",
+            help="Minimal headroom over the deepest recorded use, bytes",
+            type=int,
+            default=256,
+        )
+        self.parser.add_argument(
+            "--align", help="Round recommended sizes up to", type=int, default=256
+        )
+        self.parser.add_argument("-o", "--output", help="Save report as JSON")
+        self.parser.set_defaults(func=self.report)
+
+    def _parse(self, text: str):
+        lines = [line.strip() for line in text.splitlines()]
+        fields = [
+            tuple(part.strip() for part in line.split(":", 1))
+            for line in lines
+            if line and not line.startswith("#")
+        ]
+        header = dict(fields[:2])
+        if header.get("Filetype") != STACK_WATERMARK_FILE_TYPE:
+            raise Exception("Not a stack watermark file")
+        if int(header.get("Version", 0)) != STACK_WATERMARK_FILE_VERSION:
+            raise Exception(f"Unsupported version {header.get('Version')}")
+
+        records = []
+        record = {}
+        for key, value in fields[2:]:
+            record[key] = value
+            if key == "Free":
+                records.append(
+                    StackRecord(
+                        record["Thread"], int(record["Stack"]), int(record["Free"])
+                    )
+                )
+                record = {}
+        return records
+
+    def _read_device(self):
+        if not (port := resolve_port(self.logger, self.args.port)):
+            raise Exception("Failed to resolve port")
+        with FlipperStorage(port) as storage:
+            return storage.read_file(STACK_WATERMARK_PATH).decode()
+
+    def report(self):
+        try:
+            if self.args.files:
+                sources = []
+                for path in self.args.files:
+                    with open(path, "r") as file:
+                        sources.append(file.read())
+            else:
+                sources = [self._read_device()]
+            reports = [self._parse(source) for source in sources]
+        except Exception as e:
+            self.logger.error(f"Failed to load watermarks: {e}")
+            return 1
+
+        # Deepest use across all devices wins
+        merged = {}
+        for records in reports:
+            for record in records:
+                key = (record.name, record.stack_size)
+                if known := merged.get(key):
+                    known.min_free = min(known.min_free, record.min_free)
+                    known.devices += 1
+                else:
+                    merged[key] = record
+
+        rows = []
+        for record in sorted(merged.values(), key=lambda r: (r.name, r.stack_size)):
+            recommended = record.recommend(
+                self.args.margin, self.args.headroom, self.args.align
+            )
+            rows.append(
+                {
+                    "thread": record.name,
+                    "stack_size": record.stack_size,
+                    "min_free": record.min_free,
+                    "used": record.used,
+                    "devices": record.devices,
+                    "recommended": recommended,
+                    "saving": record.stack_size - recommended,
+                }
+            )
+
+        print(
+            f"{'thread':24} {'stack':>7} {'used':>7} {'min free':>9} "
+            f"{'devices':>8} {'recommend':>10} {'saving':>7}"
+        )
+        for row in rows:
+            print(
+                f"{row['thread']:24} {row['stack_size']:7} {row['used']:7} "
+                f"{row['min_free']:9} {row['devices']:8} {row['recommended']:10} "
+                f"{row['saving']:7}"
+            )
+        # Negative saving means the stack is too tight and should grow
+        total = sum(max(row["saving"], 0) for row in rows)
+        print(f"Reclaimable: {total} bytes over {len(rows)} threads")
+        if tight := [row["thread"] for row in rows if row["saving"] < 0]:
+            self.logger.warning(f"Stacks to grow: {', '.join(tight)}")
+
+        if self.args.output:
+            with open(self.args.output, "w") as file:
+                json.dump(
+                    {"devices": len(reports), "reclaimable": total, "threads": rows},
+                    file,
+                    indent=2,
+                )
+            self.logger.info(f"Report saved to {self.args.output}")
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
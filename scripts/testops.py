@@ -1,5 +1,6 @@
 #!/usr/bin/env python3
 
+import json
 import re
 import sys
 import time
@@ -30,6 +31,23 @@ class Main(App):
         )
         self.parser_run_units.set_defaults(func=self.run_units)
 
+        self.parser_run_benchmark = self.subparsers.add_parser(
+            "run_benchmark", help="Run decoder benchmark and save results as JSON"
+        )
+        self.parser_run_benchmark.add_argument(
+            "-o", "--output", help="Output JSON file", default="benchmark.json"
+        )
+        self.parser_run_benchmark.add_argument(
+            "-b", "--baseline", help="Baseline JSON file to compare against"
+        )
+        self.parser_run_benchmark.add_argument(
+            "--threshold",
+            help="Allowed cycles per edge increase over baseline, percent",
+            type=int,
+            default=10,
+        )
+        self.parser_run_benchmark.set_defaults(func=self.run_benchmark)
+
     def _get_flipper(self, retry_count: Optional[int] = 1):
         port = None
         self.logger.info(f"Attempting to find flipper with {retry_count} attempts.")
@@ -126,6 +144,71 @@ class Main(App):
         flipper.stop()
         return 0
 
+    def _check_benchmark_baseline(self, results):
+        with open(self.args.baseline, "r") as f:
+            baseline = {
+                (row["suite"], row["decoder"]): row for row in json.load(f)["results"]
+            }
+
+        regressions = 0
+        for row in results:
+            if not (base := baseline.get((row["suite"], row["decoder"]))):
+                continue
+            limit = base["cycles_per_edge"] * (100 + self.args.threshold) / 100
+            if row["cycles_per_edge"] > limit:
+                self.logger.error(
+                    f"{row['suite']}/{row['decoder']}: {row['cycles_per_edge']} cycles per edge, "
+                    f"baseline {base['cycles_per_edge']}"
+                )
+                regressions += 1
+            if row["decoded"] < base["decoded"]:
+                self.logger.error(
+                    f"{row['suite']}/{row['decoder']}: {row['decoded']} decoded, "
+                    f"baseline {base['decoded']}"
+                )
+                regressions += 1
+
+        return regressions
+
+    def run_benchmark(self):
+        if not (flipper := self._get_flipper(retry_count=10)):
+            return 1
+
+        self.logger.info("Running benchmark")
+        flipper.send("unit_tests test_benchmark" + "\r")
+        self.logger.info("Waiting for benchmark to complete")
+        data = flipper.read.until(">: ")
+        flipper.stop()
+
+        columns = None
+        results = []
+        status = None
+        for line in data.decode().split("\r\n"):
+            if line.startswith("BENCH,"):
+                fields = line.split(",")[1:]
+                if columns is None:
+                    columns = fields
+                    continue
+                row = dict(zip(columns, fields))
+                for key in columns[2:]:
+                    row[key] = int(row[key])
+                results.append(row)
+            elif match := re.match(r"Status: (\w+)", line):
+                status = match.group(1)
+
+        if not results or status != "PASSED":
+            self.logger.error(f"Benchmark failed, status {status}")
+            return 1
+
+        with open(self.args.output, "w") as f:
+            json.dump({"version": 1, "results": results}, f, indent=2)
+        self.logger.info(f"Saved {len(results)} results to {self.args.output}")
+
+        if self.args.baseline and self._check_benchmark_baseline(results):
+            return 1
+
+        return 0
+
 
 if __name__ == "__main__":
     Main()()
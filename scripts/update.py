@@ -10,8 +10,10 @@ from os.path import exists, join
 from flipper.app import App
 from flipper.assets.coprobin import CoproBinary, get_stack_type
 from flipper.assets.heatshrink_stream import HeatshrinkDataStreamHeader
+from flipper.assets.manifest import Manifest
 from flipper.assets.obdata import ObReferenceValues, OptionBytesData
 from flipper.assets.tarball import compress_tree_tarball, tar_sanitizer_filter
+from flipper.utils import file_md5
 from flipper.utils.fff import FlipperFormatFile
 from slideshow import Main as SlideshowMain
 
@@ -23,6 +25,7 @@ class Main(App):
     #  No compression, plain tar
     RESOURCE_TAR_MODE = "w:"
     RESOURCE_FILE_NAME = "resources.ths"  # .Tar.HeatShrink
+    RESOURCE_MANIFEST_FILE_NAME = "resources.manifest"
     RESOURCE_ENTRY_NAME_MAX_LENGTH = 100
 
     WHITELISTED_STACK_TYPES = set(
@@ -97,6 +100,7 @@ class Main(App):
             "radio.bin" if self.args.radiobin else ""
         )  # used to be basename(self.args.radiobin)
         resources_basename = ""
+        resources_manifest_basename = ""
 
         radio_version = 0
         radio_meta = None
@@ -150,6 +154,11 @@ class Main(App):
                 self.args.resources, join(self.args.directory, resources_basename)
             ):
                 return 3
+            resources_manifest_basename = self.RESOURCE_MANIFEST_FILE_NAME
+            self.package_resources_manifest(
+                self.args.resources,
+                join(self.args.directory, resources_manifest_basename),
+            )
 
         if not self.layout_check(updater_stage_size, dfu_size, radio_addr):
             self.logger.warning("Memory layout looks suspicious")
@@ -188,6 +197,7 @@ class Main(App):
         else:
             file.writeKey("Radio CRC", self.int2ffhex(0))
         file.writeKey("Resources", resources_basename)
+        file.writeKey("Resources manifest", resources_manifest_basename)
         obvalues = ObReferenceValues((), (), ())
         if self.args.obdata:
             obd = OptionBytesData(self.args.obdata)
@@ -259,6 +269,26 @@ class Main(App):
             self.logger.error(f"Cannot package resources: {e}")
             return False
 
+    def package_resources_manifest(self, srcdir: str, dst_name: str):
+        # Records follow the archive order, so the updater can walk both in lockstep
+        # and skip files that are already on the card
+        manifest = Manifest()
+
+        def add_tree(relative_root: str):
+            for name in sorted(os.listdir(join(srcdir, relative_root))):
+                relative_path = f"{relative_root}/{name}" if relative_root else name
+                full_path = join(srcdir, relative_path)
+                if os.path.isdir(full_path):
+                    manifest.addDirectory(relative_path)
+                    add_tree(relative_path)
+                else:
+                    manifest.addFile(
+                        relative_path, file_md5(full_path), os.path.getsize(full_path)
+                    )
+
+        add_tree("")
+        manifest.save(dst_name)
+
     @staticmethod
     def copro_version_as_int(coprometa, stacktype):
         major = coprometa.img_sig.version_major
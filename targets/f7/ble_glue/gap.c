@@ -16,6 +16,10 @@
 
 #define GAP_INTERVAL_TO_MS(x) (uint16_t)((x) * 1.25)
 
+// Longest link layer payload and its air time on 1M PHY, fits a whole ATT packet
+#define GAP_DATA_LENGTH_TX_OCTETS (251)
+#define GAP_DATA_LENGTH_TX_TIME   (2120)
+
 typedef struct {
     uint16_t gap_svc_handle;
     uint16_t dev_name_char_handle;
@@ -39,6 +43,7 @@ typedef struct {
     FuriMessageQueue* command_queue;
     bool enable_adv;
     bool is_secure;
+    bool high_throughput;
     uint8_t negotiation_round;
 } Gap;
 
@@ -46,6 +51,8 @@ typedef enum {
     GapCommandAdvFast,
     GapCommandAdvLowPower,
     GapCommandAdvStop,
+    GapCommandThroughputHigh,
+    GapCommandThroughputLow,
     GapCommandKillThread,
 } GapCommand;
 
@@ -75,18 +82,31 @@ static void gap_verify_connection_parameters(Gap* gap) {
     // Send connection parameters request update if necessary
     GapConnectionParamsRequest* params = &gap->config->conn_param;
 
-    // Desired max connection interval depends on how many negotiation rounds we had in the past
-    // In the first negotiation round we want connection interval to be minimum
-    // If platform disagree then we request wider range
-    uint16_t connection_interval_max = gap->negotiation_round ? params->conn_int_max :
-                                                                params->conn_int_min;
+    uint16_t connection_interval_min;
+    uint16_t connection_interval_max;
+    bool negotiation_failed;
+
+    if(gap->high_throughput) {
+        // Desired max connection interval depends on how many negotiation rounds we had in the past
+        // In the first negotiation round we want connection interval to be minimum
+        // If platform disagree then we request wider range
+        connection_interval_min = params->conn_int_min;
+        connection_interval_max = gap->negotiation_round ? params->conn_int_max :
+                                                           params->conn_int_min;
 
-    // We do care about lower connection interval bound a lot: if it's lower than 30ms 2nd core will not allow us to use flash controller
-    bool negotiation_failed = params->conn_int_min > gap->connection_params.conn_interval;
+        // We do care about lower connection interval bound a lot: if it's lower than 30ms 2nd core will not allow us to use flash controller
+        negotiation_failed = params->conn_int_min > gap->connection_params.conn_interval;
 
-    // We don't care about upper bound till connection become secure
-    if(gap->is_secure) {
-        negotiation_failed |= connection_interval_max < gap->connection_params.conn_interval;
+        // We don't care about upper bound till connection become secure
+        if(gap->is_secure) {
+            negotiation_failed |= connection_interval_max < gap->connection_params.conn_interval;
+        }
+    } else {
+        // Idle link: anything at or above the top of the range saves power, ask only once
+        connection_interval_min = params->conn_int_max;
+        connection_interval_max = params->conn_int_max * 2;
+        negotiation_failed = (gap->negotiation_round == 0) &&
+                             (connection_interval_min > gap->connection_params.conn_interval);
     }
 
     if(negotiation_failed) {
@@ -96,7 +116,7 @@ static void gap_verify_connection_parameters(Gap* gap) {
             gap->negotiation_round + 1);
         if(aci_l2cap_connection_parameter_update_req(
                gap->service.connection_handle,
-               params->conn_int_min,
+               connection_interval_min,
                connection_interval_max,
                gap->connection_params.slave_latency,
                gap->connection_params.supervisor_timeout)) {
@@ -117,6 +137,32 @@ static void gap_verify_connection_parameters(Gap* gap) {
     }
 }
 
+static void gap_request_link_extensions(Gap* gap) {
+    tBleStatus ret = hci_le_set_data_length(
+        gap->service.connection_handle, GAP_DATA_LENGTH_TX_OCTETS, GAP_DATA_LENGTH_TX_TIME);
+    if(ret) {
+        FURI_LOG_W(TAG, "Set data length failed, status: %d", ret);
+    }
+    ret = hci_le_set_phy(
+        gap->service.connection_handle, ALL_PHYS_PREFERENCE, TX_2M_PREFERRED, RX_2M_PREFERRED, 0);
+    if(ret) {
+        FURI_LOG_W(TAG, "Set PHY failed, status: %d", ret);
+    }
+}
+
+static void gap_set_throughput_mode(Gap* gap, bool high_throughput) {
+    if(gap->high_throughput == high_throughput) {
+        return;
+    }
+    gap->high_throughput = high_throughput;
+    FURI_LOG_I(TAG, "Throughput mode: %s", high_throughput ? "high" : "low power");
+
+    if(gap->state == GapStateConnected) {
+        gap->negotiation_round = 0;
+        gap_verify_connection_parameters(gap);
+    }
+}
+
 BleEventFlowStatus ble_event_app_notification(void* pckt) {
     hci_event_pckt* event_pckt;
     evt_le_meta_event* meta_evt;
@@ -167,6 +213,14 @@ BleEventFlowStatus ble_event_app_notification(void* pckt) {
             break;
         }
 
+        case HCI_LE_DATA_LENGTH_CHANGE_SUBEVT_CODE: {
+            hci_le_data_length_change_event_rp0* event =
+                (hci_le_data_length_change_event_rp0*)meta_evt->data;
+            FURI_LOG_I(
+                TAG, "Data length TX = %d, RX = %d", event->MaxTxOctets, event->MaxRxOctets);
+            break;
+        }
+
         case HCI_LE_PHY_UPDATE_COMPLETE_SUBEVT_CODE:
             evt_le_phy_update_complete = (hci_le_phy_update_complete_event_rp0*)meta_evt->data;
             if(evt_le_phy_update_complete->Status) {
@@ -197,6 +251,9 @@ BleEventFlowStatus ble_event_app_notification(void* pckt) {
             gap->state = GapStateConnected;
             gap->service.connection_handle = event->Connection_Handle;
 
+            // Every connection starts fast, bulk transfers usually follow
+            gap->high_throughput = true;
+            gap_request_link_extensions(gap);
             gap_verify_connection_parameters(gap);
             // Start pairing by sending security request
             aci_gap_slave_security_req(event->Connection_Handle);
@@ -548,6 +605,7 @@ bool gap_init(GapConfig* config, GapEventCallback on_event_cb, void* context) {
 
     // Set initial state
     gap->is_secure = false;
+    gap->high_throughput = true;
     gap->negotiation_round = 0;
 
     uint8_t adv_service_uid[2];
@@ -618,6 +676,10 @@ static int32_t gap_app(void* context) {
             gap_advertise_start(GapStateAdvLowPower);
         } else if(command == GapCommandAdvStop) {
             gap_advertise_stop();
+        } else if(command == GapCommandThroughputHigh) {
+            gap_set_throughput_mode(gap, true);
+        } else if(command == GapCommandThroughputLow) {
+            gap_set_throughput_mode(gap, false);
         }
         furi_check(furi_mutex_release(gap->state_mutex) == FuriStatusOk);
     }
@@ -625,6 +687,14 @@ static int32_t gap_app(void* context) {
     return 0;
 }
 
+bool gap_set_high_throughput(bool enable) {
+    if(!gap) {
+        return false;
+    }
+    GapCommand command = enable ? GapCommandThroughputHigh : GapCommandThroughputLow;
+    return furi_message_queue_put(gap->command_queue, &command, 0) == FuriStatusOk;
+}
+
 void gap_emit_ble_beacon_status_event(bool active) {
     GapEvent event = {.type = active ? GapEventTypeBeaconStart : GapEventTypeBeaconStop};
     gap->on_event_cb(event, gap->context);
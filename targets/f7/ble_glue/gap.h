@@ -87,6 +87,17 @@ GapState gap_get_state(void);
 
 void gap_thread_stop(void);
 
+/** Switch connection between throughput and low power parameters
+ *
+ * High throughput asks for the shortest connection interval, low power for
+ * the longest one. Every new connection starts in high throughput mode.
+ *
+ * @param      enable  true for high throughput, false for low power
+ *
+ * @return     true if request was queued
+ */
+bool gap_set_high_throughput(bool enable);
+
 void gap_emit_ble_beacon_status_event(bool active);
 
 #ifdef __cplusplus
@@ -22,12 +22,15 @@ typedef SerialServiceEventCallback FuriHalBtSerialCallback;
 extern const FuriHalBleProfileTemplate* ble_profile_serial;
 
 /** Send data through BLE
+ *
+ * Data is queued and sent as one indication. Each confirmed indication frees
+ * space in the queue and is reported with SerialServiceEventTypeDataSent.
  *
  * @param profile       Profile instance
  * @param data          data buffer
  * @param size          data buffer size
  *
- * @return      true on success
+ * @return      true if data was queued, false if queue is full
  */
 bool ble_profile_serial_tx(FuriHalBleProfileBase* profile, uint8_t* data, uint16_t size);
 
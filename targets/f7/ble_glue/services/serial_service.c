@@ -11,6 +11,9 @@
 
 #define TAG "BtSerialSvc"
 
+// Packets waiting for the indication in flight to be confirmed, each one is prefixed with length
+#define SERIAL_SVC_TX_QUEUE_SIZE ((sizeof(uint16_t) + BLE_SVC_SERIAL_DATA_LEN_MAX) * 3)
+
 typedef enum {
     SerialSvcGattCharacteristicRx = 0,
     SerialSvcGattCharacteristicTx,
@@ -70,8 +73,74 @@ struct BleServiceSerial {
     SerialServiceEventCallback callback;
     void* context;
     GapSvcEventHandler* event_handler;
+    FuriMutex* tx_mtx;
+    FuriStreamBuffer* tx_queue;
+    bool tx_in_flight;
+    bool tx_pending;
+    uint16_t tx_packet_len;
+    uint8_t tx_packet[BLE_SVC_SERIAL_DATA_LEN_MAX];
 };
 
+static tBleStatus ble_svc_serial_send_packet(BleServiceSerial* serial_svc) {
+    uint16_t data_len = serial_svc->tx_packet_len;
+    tBleStatus result = BLE_STATUS_SUCCESS;
+
+    for(uint16_t remained = data_len; remained > 0;) {
+        uint8_t value_len = MIN(BLE_SVC_SERIAL_CHAR_VALUE_LEN_MAX, remained);
+        uint16_t value_offset = data_len - remained;
+        remained -= value_len;
+
+        result = aci_gatt_update_char_value_ext(
+            0,
+            serial_svc->svc_handle,
+            serial_svc->chars[SerialSvcGattCharacteristicTx].handle,
+            remained ? 0x00 : 0x02,
+            data_len,
+            value_offset,
+            value_len,
+            serial_svc->tx_packet + value_offset);
+
+        if(result) {
+            break;
+        }
+    }
+
+    return result;
+}
+
+// Must be called with tx_mtx taken
+static void ble_svc_serial_tx_next(BleServiceSerial* serial_svc) {
+    while(!serial_svc->tx_in_flight) {
+        if(!serial_svc->tx_pending) {
+            if(furi_stream_buffer_bytes_available(serial_svc->tx_queue) == 0) {
+                break;
+            }
+            furi_stream_buffer_receive(
+                serial_svc->tx_queue,
+                &serial_svc->tx_packet_len,
+                sizeof(serial_svc->tx_packet_len),
+                0);
+            furi_stream_buffer_receive(
+                serial_svc->tx_queue, serial_svc->tx_packet, serial_svc->tx_packet_len, 0);
+            serial_svc->tx_pending = true;
+        }
+
+        tBleStatus result = ble_svc_serial_send_packet(serial_svc);
+        if(result == BLE_STATUS_INSUFFICIENT_RESOURCES) {
+            // Stack TX pool is exhausted, retry when it reports free buffers
+            FURI_LOG_D(TAG, "TX pool is full");
+            break;
+        }
+
+        serial_svc->tx_pending = false;
+        if(result) {
+            FURI_LOG_E(TAG, "Failed updating TX characteristic: %d", result);
+        } else {
+            serial_svc->tx_in_flight = true;
+        }
+    }
+}
+
 static BleEventAckStatus ble_svc_serial_event_handler(void* event, void* context) {
     BleServiceSerial* serial_svc = (BleServiceSerial*)context;
     BleEventAckStatus ret = BleEventNotAck;
@@ -129,6 +198,10 @@ static BleEventAckStatus ble_svc_serial_event_handler(void* event, void* context
             }
         } else if(blecore_evt->ecode == ACI_GATT_SERVER_CONFIRMATION_VSEVT_CODE) {
             FURI_LOG_T(TAG, "Ack received");
+            furi_check(furi_mutex_acquire(serial_svc->tx_mtx, FuriWaitForever) == FuriStatusOk);
+            serial_svc->tx_in_flight = false;
+            ble_svc_serial_tx_next(serial_svc);
+            furi_check(furi_mutex_release(serial_svc->tx_mtx) == FuriStatusOk);
             if(serial_svc->callback) {
                 SerialServiceEvent event = {
                     .event = SerialServiceEventTypeDataSent,
@@ -136,6 +209,11 @@ static BleEventAckStatus ble_svc_serial_event_handler(void* event, void* context
                 serial_svc->callback(event, serial_svc->context);
             }
             ret = BleEventAckFlowEnable;
+        } else if(blecore_evt->ecode == ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE) {
+            // Other services may wait for the pool too, so don't ack
+            furi_check(furi_mutex_acquire(serial_svc->tx_mtx, FuriWaitForever) == FuriStatusOk);
+            ble_svc_serial_tx_next(serial_svc);
+            furi_check(furi_mutex_release(serial_svc->tx_mtx) == FuriStatusOk);
         }
     }
     return ret;
@@ -170,6 +248,8 @@ BleServiceSerial* ble_svc_serial_start(void) {
 
     ble_svc_serial_update_rpc_char(serial_svc, SerialServiceRpcStatusNotActive);
     serial_svc->buff_size_mtx = furi_mutex_alloc(FuriMutexTypeNormal);
+    serial_svc->tx_mtx = furi_mutex_alloc(FuriMutexTypeNormal);
+    serial_svc->tx_queue = furi_stream_buffer_alloc(SERIAL_SVC_TX_QUEUE_SIZE, 1);
 
     return serial_svc;
 }
@@ -185,6 +265,13 @@ void ble_svc_serial_set_callbacks(
     serial_svc->buff_size = buff_size;
     serial_svc->bytes_ready_to_receive = buff_size;
 
+    // Session changed: confirmation for the old indication will never come
+    furi_check(furi_mutex_acquire(serial_svc->tx_mtx, FuriWaitForever) == FuriStatusOk);
+    furi_stream_buffer_reset(serial_svc->tx_queue);
+    serial_svc->tx_in_flight = false;
+    serial_svc->tx_pending = false;
+    furi_check(furi_mutex_release(serial_svc->tx_mtx) == FuriStatusOk);
+
     uint32_t buff_size_reversed = REVERSE_BYTES_U32(serial_svc->buff_size);
     ble_gatt_characteristic_update(
         serial_svc->svc_handle,
@@ -220,6 +307,8 @@ void ble_svc_serial_stop(BleServiceSerial* serial_svc) {
     }
     ble_gatt_service_delete(serial_svc->svc_handle);
     furi_mutex_free(serial_svc->buff_size_mtx);
+    furi_mutex_free(serial_svc->tx_mtx);
+    furi_stream_buffer_free(serial_svc->tx_queue);
     free(serial_svc);
 }
 
@@ -228,28 +317,17 @@ bool ble_svc_serial_update_tx(BleServiceSerial* serial_svc, uint8_t* data, uint1
         return false;
     }
 
-    for(uint16_t remained = data_len; remained > 0;) {
-        uint8_t value_len = MIN(BLE_SVC_SERIAL_CHAR_VALUE_LEN_MAX, remained);
-        uint16_t value_offset = data_len - remained;
-        remained -= value_len;
-
-        tBleStatus result = aci_gatt_update_char_value_ext(
-            0,
-            serial_svc->svc_handle,
-            serial_svc->chars[SerialSvcGattCharacteristicTx].handle,
-            remained ? 0x00 : 0x02,
-            data_len,
-            value_offset,
-            value_len,
-            data + value_offset);
-
-        if(result) {
-            FURI_LOG_E(TAG, "Failed updating TX characteristic: %d", result);
-            return false;
-        }
+    bool queued = false;
+    furi_check(furi_mutex_acquire(serial_svc->tx_mtx, FuriWaitForever) == FuriStatusOk);
+    if(furi_stream_buffer_spaces_available(serial_svc->tx_queue) >= sizeof(data_len) + data_len) {
+        furi_stream_buffer_send(serial_svc->tx_queue, &data_len, sizeof(data_len), 0);
+        furi_stream_buffer_send(serial_svc->tx_queue, data, data_len, 0);
+        ble_svc_serial_tx_next(serial_svc);
+        queued = true;
     }
+    furi_check(furi_mutex_release(serial_svc->tx_mtx) == FuriStatusOk);
 
-    return true;
+    return queued;
 }
 
 void ble_svc_serial_set_rpc_active(BleServiceSerial* serial_svc, bool active) {
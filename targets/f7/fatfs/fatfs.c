@@ -1,5 +1,6 @@
 #include "fatfs.h"
 #include "furi_hal_rtc.h"
+#include <furi.h>
 
 /** logical drive path */
 char fatfs_path[4];
@@ -10,6 +11,30 @@ void fatfs_init(void) {
     FATFS_LinkDriver(&sd_fatfs_driver, fatfs_path);
 }
 
+#if _FS_REENTRANT
+int ff_cre_syncobj(BYTE vol, _SYNC_t* sobj) {
+    UNUSED(vol);
+    *sobj = furi_mutex_alloc(FuriMutexTypeNormal);
+    return *sobj != NULL;
+}
+
+// Updater stage accesses the card before the kernel is started, no locking is needed there
+int ff_req_grant(_SYNC_t sobj) {
+    if(!furi_kernel_is_running()) return 1;
+    return furi_mutex_acquire(sobj, _FS_TIMEOUT) == FuriStatusOk;
+}
+
+void ff_rel_grant(_SYNC_t sobj) {
+    if(!furi_kernel_is_running()) return;
+    furi_check(furi_mutex_release(sobj) == FuriStatusOk);
+}
+
+int ff_del_syncobj(_SYNC_t sobj) {
+    furi_mutex_free(sobj);
+    return 1;
+}
+#endif
+
 /** Gets Time from RTC
   *
   * @return     Time in DWORD (toasters per square washing machine)
@@ -68,7 +68,7 @@
 #define _USE_FASTSEEK 1
 /* This option switches fast seek feature. (0:Disable or 1:Enable) */
 
-#define _USE_EXPAND 0
+#define _USE_EXPAND 1
 /* This option switches f_expand function. (0:Disable or 1:Enable) */
 
 #define _USE_CHMOD 0
@@ -219,6 +219,13 @@
 /  When enable exFAT, also LFN needs to be enabled. (_USE_LFN >= 1)
 /  Note that enabling exFAT discards C89 compatibility. */
 
+#define _FS_EXFAT_BM_SUMMARY 256
+/* This option sets number of groups in the RAM-resident summary of the exFAT
+/  allocation bitmap (0:Disable). Each group keeps the number of free clusters in
+/  its part of the bitmap, so that cluster allocation skips fully used parts
+/  without reading them from the card. The summary is built by f_getfree() and
+/  costs 4 bytes per group in the file system object. */
+
 #define _FS_NORTC 0
 /* The option _FS_NORTC switches timestamp functiton. If the system does not have
 /  any RTC function or valid timestamp is not needed, set _FS_NORTC = 1 to disable
@@ -240,8 +247,11 @@
 /      can be opened simultaneously under file lock control. Note that the file
 /      lock control is independent of re-entrancy. */
 
-#define _FS_REENTRANT 0 /* 0:Disable or 1:Enable */
-#define _FS_TIMEOUT   1000 /* Timeout period in unit of time ticks */
+#include <core/mutex.h>
+
+/* Leased files are accessed from their owner threads alongside the storage thread */
+#define _FS_REENTRANT 1 /* 0:Disable or 1:Enable */
+#define _FS_TIMEOUT   FuriWaitForever /* Timeout period in unit of time ticks */
 #define _SYNC_t       FuriMutex*
 /* The option _FS_REENTRANT switches the re-entrancy (thread safe) of the FatFs
 /  module itself. Note that regardless of this option, file access to different
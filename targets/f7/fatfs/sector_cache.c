@@ -7,50 +7,274 @@
 #include <furi_hal_memory.h>
 
 #define SECTOR_SIZE 512
-#define N_SECTORS   8
+
+#define SECTOR_CACHE_PINNED_WAYS_MAX (SECTOR_CACHE_WAYS - 1)
+
+_Static_assert(
+    (SECTOR_CACHE_SETS & (SECTOR_CACHE_SETS - 1)) == 0,
+    "SECTOR_CACHE_SETS must be power of 2");
+_Static_assert(SECTOR_CACHE_WAYS > 1, "SECTOR_CACHE_WAYS must be at least 2");
 
 typedef struct {
-    uint32_t itr;
-    uint32_t sectors[N_SECTORS];
-    uint8_t sector_data[N_SECTORS][SECTOR_SIZE];
+    uint32_t sector; // 0 means empty, sector 0 is never cached
+    uint32_t last_used;
+    bool pinned;
+    bool dirty;
+} SectorCacheEntry;
+
+typedef struct {
+    uint32_t clock;
+    uint32_t pin_start;
+    uint32_t pin_end;
+    SectorCacheWriteCallback write_callback;
+    void* write_context;
+    SectorCacheStats stats;
+    SectorCacheEntry entries[SECTOR_CACHE_SETS][SECTOR_CACHE_WAYS];
+    uint8_t sector_data[SECTOR_CACHE_SETS][SECTOR_CACHE_WAYS][SECTOR_SIZE];
 } SectorCache;
 
 static SectorCache* cache = NULL;
 
+static inline uint32_t sector_cache_set_index(uint32_t n_sector) {
+    // Adjacent sectors land in different sets
+    return n_sector & (SECTOR_CACHE_SETS - 1);
+}
+
+static inline bool sector_cache_is_pinned(uint32_t n_sector) {
+    return (cache->pin_end != 0) && (n_sector >= cache->pin_start) &&
+           (n_sector <= cache->pin_end);
+}
+
+static void sector_cache_drop_entry(SectorCacheEntry* entry) {
+    if(entry->pinned) {
+        cache->stats.pinned--;
+    }
+    if(entry->dirty) {
+        cache->stats.dirty--;
+    }
+    entry->sector = 0;
+    entry->pinned = false;
+    entry->dirty = false;
+}
+
+static inline uint8_t* sector_cache_entry_data(SectorCacheEntry* entry) {
+    size_t index = entry - &cache->entries[0][0];
+    return cache->sector_data[index / SECTOR_CACHE_WAYS][index % SECTOR_CACHE_WAYS];
+}
+
+static bool sector_cache_write_back_entry(SectorCacheEntry* entry) {
+    furi_assert(cache->write_callback);
+
+    if(!cache->write_callback(
+           entry->sector, sector_cache_entry_data(entry), cache->write_context)) {
+        return false;
+    }
+
+    entry->dirty = false;
+    cache->stats.dirty--;
+    return true;
+}
+
 void sector_cache_init(void) {
     if(cache == NULL) {
         cache = memmgr_alloc_from_pool(sizeof(SectorCache));
+        if(cache != NULL) {
+            memset(cache, 0, sizeof(SectorCache));
+        }
     }
 
     if(cache != NULL) {
-        memset(cache, 0, sizeof(SectorCache));
+        for(size_t set = 0; set < SECTOR_CACHE_SETS; ++set) {
+            for(size_t way = 0; way < SECTOR_CACHE_WAYS; ++way) {
+                SectorCacheEntry* entry = &cache->entries[set][way];
+                if(!entry->dirty) {
+                    sector_cache_drop_entry(entry);
+                }
+            }
+        }
     }
 }
 
 uint8_t* sector_cache_get(uint32_t n_sector) {
     if(cache != NULL && n_sector != 0) {
-        for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-            if(cache->sectors[sector_i] == n_sector) {
-                return cache->sector_data[sector_i];
+        uint32_t set = sector_cache_set_index(n_sector);
+        for(size_t way = 0; way < SECTOR_CACHE_WAYS; ++way) {
+            SectorCacheEntry* entry = &cache->entries[set][way];
+            if(entry->sector == n_sector) {
+                entry->last_used = ++cache->clock;
+                cache->stats.hits++;
+                return cache->sector_data[set][way];
             }
         }
+        cache->stats.misses++;
     }
     return NULL;
 }
 
+static bool sector_cache_store(uint32_t n_sector, const uint8_t* data, bool dirty) {
+    uint32_t set = sector_cache_set_index(n_sector);
+    SectorCacheEntry* entries = cache->entries[set];
+    bool pinned = sector_cache_is_pinned(n_sector);
+
+    size_t pinned_count = 0;
+    SectorCacheEntry* cached_entry = NULL;
+    SectorCacheEntry* free_entry = NULL;
+    SectorCacheEntry* lru_entry = NULL;
+    SectorCacheEntry* lru_pinned_entry = NULL;
+
+    for(size_t way = 0; way < SECTOR_CACHE_WAYS; ++way) {
+        SectorCacheEntry* entry = &entries[way];
+        if(entry->sector == n_sector) {
+            cached_entry = entry;
+            break;
+        } else if(entry->sector == 0) {
+            if(!free_entry) free_entry = entry;
+        } else if(entry->pinned) {
+            pinned_count++;
+            if(!lru_pinned_entry || entry->last_used < lru_pinned_entry->last_used) {
+                lru_pinned_entry = entry;
+            }
+        } else {
+            if(!lru_entry || entry->last_used < lru_entry->last_used) {
+                lru_entry = entry;
+            }
+        }
+    }
+
+    // Card data is older than pending write
+    if(cached_entry && cached_entry->dirty && !dirty) return true;
+
+    SectorCacheEntry* victim = cached_entry;
+    if(!victim) {
+        if(pinned && pinned_count >= SECTOR_CACHE_PINNED_WAYS_MAX) {
+            // Pinned quota is used, pinned sectors replace each other
+            victim = lru_pinned_entry;
+        } else if(free_entry) {
+            victim = free_entry;
+        } else {
+            victim = lru_entry;
+        }
+
+        // Regular sector and whole set is pinned: don't cache it
+        if(!victim) return false;
+
+        // Dirty sector must reach the card before its slot is reused
+        if(victim->dirty && !sector_cache_write_back_entry(victim)) return false;
+
+        if(victim->sector != 0) {
+            cache->stats.evictions++;
+        }
+    }
+
+    if(victim->sector != n_sector) {
+        sector_cache_drop_entry(victim);
+        victim->sector = n_sector;
+        victim->pinned = pinned;
+        if(pinned) {
+            cache->stats.pinned++;
+        }
+    }
+    if(dirty && !victim->dirty) {
+        victim->dirty = true;
+        cache->stats.dirty++;
+    }
+    victim->last_used = ++cache->clock;
+    memcpy(cache->sector_data[set][victim - entries], data, SECTOR_SIZE);
+
+    return true;
+}
+
 void sector_cache_put(uint32_t n_sector, uint8_t* data) {
+    if(cache == NULL || n_sector == 0) return;
+    sector_cache_store(n_sector, data, false);
+}
+
+bool sector_cache_write(uint32_t n_sector, const uint8_t* data) {
+    if(cache == NULL || n_sector == 0 || cache->write_callback == NULL) return false;
+    return sector_cache_store(n_sector, data, true);
+}
+
+bool sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
+    if(cache == NULL) return true;
+    bool success = true;
+    for(size_t set = 0; set < SECTOR_CACHE_SETS; ++set) {
+        for(size_t way = 0; way < SECTOR_CACHE_WAYS; ++way) {
+            SectorCacheEntry* entry = &cache->entries[set][way];
+            if((entry->sector >= start_sector) && (entry->sector <= end_sector)) {
+                // Pending write is never lost, entry stays if it can't be stored
+                if(entry->dirty && !sector_cache_write_back_entry(entry)) {
+                    success = false;
+                    continue;
+                }
+                sector_cache_drop_entry(entry);
+            }
+        }
+    }
+    return success;
+}
+
+void sector_cache_pin_range(uint32_t start_sector, uint32_t end_sector) {
     if(cache == NULL) return;
-    cache->sectors[cache->itr % N_SECTORS] = n_sector;
-    memcpy(cache->sector_data[cache->itr % N_SECTORS], data, SECTOR_SIZE);
-    cache->itr++;
+    cache->pin_start = start_sector;
+    cache->pin_end = end_sector;
+
+    // Reclassify sectors that are already cached
+    cache->stats.pinned = 0;
+    for(size_t set = 0; set < SECTOR_CACHE_SETS; ++set) {
+        for(size_t way = 0; way < SECTOR_CACHE_WAYS; ++way) {
+            SectorCacheEntry* entry = &cache->entries[set][way];
+            entry->pinned = (entry->sector != 0) && sector_cache_is_pinned(entry->sector);
+            if(entry->pinned) {
+                cache->stats.pinned++;
+            }
+        }
+    }
 }
 
-void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
+void sector_cache_set_write_back(SectorCacheWriteCallback callback, void* context) {
     if(cache == NULL) return;
-    for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-        if((cache->sectors[sector_i] >= start_sector) &&
-           (cache->sectors[sector_i] <= end_sector)) {
-            cache->sectors[sector_i] = 0;
+    cache->write_callback = callback;
+    cache->write_context = context;
+}
+
+bool sector_cache_flush_range(uint32_t start_sector, uint32_t end_sector) {
+    if(cache == NULL || cache->stats.dirty == 0) return true;
+    furi_check(cache->write_callback);
+
+    while(true) {
+        // Lowest dirty sector first, so the card sees sequential writes
+        SectorCacheEntry* next = NULL;
+        for(size_t set = 0; set < SECTOR_CACHE_SETS; ++set) {
+            for(size_t way = 0; way < SECTOR_CACHE_WAYS; ++way) {
+                SectorCacheEntry* entry = &cache->entries[set][way];
+                if(entry->dirty && (entry->sector >= start_sector) &&
+                   (entry->sector <= end_sector) && (!next || entry->sector < next->sector)) {
+                    next = entry;
+                }
+            }
         }
+
+        if(!next) break;
+        if(!sector_cache_write_back_entry(next)) return false;
+    }
+
+    return true;
+}
+
+void sector_cache_discard(void) {
+    if(cache == NULL) return;
+    for(size_t set = 0; set < SECTOR_CACHE_SETS; ++set) {
+        for(size_t way = 0; way < SECTOR_CACHE_WAYS; ++way) {
+            sector_cache_drop_entry(&cache->entries[set][way]);
+        }
+    }
+}
+
+void sector_cache_get_stats(SectorCacheStats* stats) {
+    furi_check(stats);
+    if(cache == NULL) {
+        memset(stats, 0, sizeof(SectorCacheStats));
+    } else {
+        *stats = cache->stats;
     }
 }
@@ -1,12 +1,42 @@
 #pragma once
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Number of cache sets, must be power of 2 */
+#ifndef SECTOR_CACHE_SETS
+#define SECTOR_CACHE_SETS 4
+#endif
+
+/** Number of sectors in one cache set */
+#ifndef SECTOR_CACHE_WAYS
+#define SECTOR_CACHE_WAYS 4
+#endif
+
+typedef struct {
+    uint32_t hits; /**< Lookups served from cache */
+    uint32_t misses; /**< Lookups that went to the card */
+    uint32_t evictions; /**< Valid sectors replaced by new ones */
+    uint32_t pinned; /**< Sectors currently held as pinned */
+    uint32_t dirty; /**< Sectors waiting to be written back */
+} SectorCacheStats;
+
+/**
+ * @brief Write back callback, used to store dirty sectors on the card
+ * @param n_sector Sector number
+ * @param data Pointer to sector data
+ * @param context Callback context
+ * @return true if sector was written
+ */
+typedef bool (*SectorCacheWriteCallback)(uint32_t n_sector, const uint8_t* data, void* context);
+
 /**
  * @brief Init sector cache system
+ * Drops all clean cached sectors. Dirty sectors, pinned range and statistics
+ * are preserved, so card re-init doesn't lose pending writes.
  */
 void sector_cache_init(void);
 
@@ -26,10 +56,65 @@ void sector_cache_put(uint32_t n_sector, uint8_t* data);
 
 /**
  * @brief Invalidate sector cache for given range
+ *
+ * Dirty sectors in range are written back before they are dropped.
+ *
+ * @param start_sector Start sector number
+ * @param end_sector End sector number, inclusive
+ * @return true if range is invalidated, false if a dirty sector failed to write back
+ */
+bool sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector);
+
+/**
+ * @brief Set range of sectors that must stay in cache preferentially
+ *
+ * Pinned sectors (FAT, fixed root directory) are never evicted by regular
+ * sectors, so streaming data reads can't push filesystem metadata out.
+ * Pinned sectors can occupy at most SECTOR_CACHE_WAYS - 1 ways of a set.
+ *
+ * @param start_sector Start sector number
+ * @param end_sector End sector number, inclusive. Pass 0 to disable pinning.
+ */
+void sector_cache_pin_range(uint32_t start_sector, uint32_t end_sector);
+
+/**
+ * @brief Enable or disable write back mode
+ *
+ * In write back mode sector_cache_write keeps sectors in cache as dirty,
+ * they are stored with callback on eviction or sector_cache_flush_range.
+ * Flush all dirty sectors before disabling write back.
+ *
+ * @param callback Write back callback, NULL to disable write back
+ * @param context Callback context
+ */
+void sector_cache_set_write_back(SectorCacheWriteCallback callback, void* context);
+
+/**
+ * @brief Put sector data to cache as dirty
+ * @param n_sector Sector number
+ * @param data Pointer to sector data
+ * @return true if sector is held by cache, false if it must be written to the card
+ */
+bool sector_cache_write(uint32_t n_sector, const uint8_t* data);
+
+/**
+ * @brief Write back dirty sectors in given range, in ascending order
  * @param start_sector Start sector number
- * @param end_sector End sector number
+ * @param end_sector End sector number, inclusive
+ * @return true if all dirty sectors in range were written
+ */
+bool sector_cache_flush_range(uint32_t start_sector, uint32_t end_sector);
+
+/**
+ * @brief Drop all sectors including dirty ones
+ */
+void sector_cache_discard(void);
+
+/**
+ * @brief Get sector cache statistics
+ * @param stats Pointer to stats structure to fill
  */
-void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector);
+void sector_cache_get_stats(SectorCacheStats* stats);
 
 #ifdef __cplusplus
 }
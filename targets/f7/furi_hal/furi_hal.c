@@ -11,6 +11,7 @@ void furi_hal_init_early(void) {
     furi_hal_clock_init_early();
     furi_hal_bus_init_early();
     furi_hal_dma_init_early();
+    furi_hal_crc_init_early();
     furi_hal_resources_init_early();
     furi_hal_os_init();
     furi_hal_spi_config_init_early();
@@ -18,6 +19,7 @@ void furi_hal_init_early(void) {
     furi_hal_light_init();
     furi_hal_rtc_init_early();
     furi_hal_version_init();
+    furi_boot_trace_mark("hal_early");
 }
 
 void furi_hal_deinit_early(void) {
@@ -25,6 +27,7 @@ void furi_hal_deinit_early(void) {
     furi_hal_i2c_deinit_early();
     furi_hal_spi_config_deinit_early();
     furi_hal_resources_deinit_early();
+    furi_hal_crc_deinit_early();
     furi_hal_dma_deinit_early();
     furi_hal_bus_deinit_early();
     furi_hal_clock_deinit_early();
@@ -34,11 +37,13 @@ void furi_hal_init(void) {
     furi_hal_mpu_init();
     furi_hal_adc_init();
     furi_hal_clock_init();
+    furi_boot_trace_mark("hal_clock");
     furi_hal_random_init();
     furi_hal_serial_control_init();
     furi_hal_rtc_init();
     furi_hal_interrupt_init();
     furi_hal_flash_init();
+    furi_boot_trace_mark("hal_flash");
     furi_hal_resources_init();
     furi_hal_region_init();
     furi_hal_spi_config_init();
@@ -46,19 +51,24 @@ void furi_hal_init(void) {
     furi_hal_ibutton_init();
     furi_hal_speaker_init();
     furi_hal_crypto_init();
+    furi_boot_trace_mark("hal_crypto");
     furi_hal_i2c_init();
     furi_hal_power_init();
+    furi_boot_trace_mark("hal_power");
     furi_hal_light_init();
     furi_hal_bt_init();
+    furi_boot_trace_mark("hal_bt");
     furi_hal_memory_init();
 
 #ifndef FURI_RAM_EXEC
     furi_hal_usb_init();
     furi_hal_vibro_init();
     furi_hal_subghz_init();
+    furi_boot_trace_mark("hal_subghz");
     furi_hal_nfc_init();
     furi_hal_rfid_init();
 #endif
+    furi_boot_trace_mark("hal");
 }
 
 void furi_hal_switch(void* address) {
@@ -1,17 +1,36 @@
 #include <furi_hal_adc.h>
 #include <furi_hal_bus.h>
 #include <furi_hal_cortex.h>
+#include <furi_hal_interrupt.h>
 #include <furi_hal_power.h>
 
 #include <furi.h>
 
 #include <stm32wbxx_ll_adc.h>
+#include <stm32wbxx_ll_dma.h>
 #include <stm32wbxx_ll_system.h>
+#include <stm32wbxx_ll_tim.h>
+
+#define FURI_HAL_ADC_STREAM_DMA         (DMA2)
+#define FURI_HAL_ADC_STREAM_DMA_CHANNEL (LL_DMA_CHANNEL_3)
+#define FURI_HAL_ADC_STREAM_DMA_IRQ     (FuriHalInterruptIdDma2Ch3)
+#define FURI_HAL_ADC_STREAM_DMA_DEF     FURI_HAL_ADC_STREAM_DMA, FURI_HAL_ADC_STREAM_DMA_CHANNEL
+
+#define FURI_HAL_ADC_STREAM_TIMER         (TIM1)
+#define FURI_HAL_ADC_STREAM_TIMER_BUS     (FuriHalBusTIM1)
+#define FURI_HAL_ADC_STREAM_TIMER_TRIGGER (LL_ADC_REG_TRIG_EXT_TIM1_TRGO)
+#define FURI_HAL_ADC_STREAM_TIMER_CLOCK   (64000000UL)
 
 struct FuriHalAdcHandle {
     ADC_TypeDef* adc;
     FuriMutex* mutex;
     uint32_t full_scale;
+
+    bool stream_active;
+    uint16_t* stream_buffer;
+    size_t stream_buffer_size;
+    FuriHalAdcStreamCallback stream_callback;
+    void* stream_context;
 };
 
 static const uint32_t furi_hal_adc_clock[] = {
@@ -84,6 +103,25 @@ static const uint32_t furi_hal_adc_channel_map[] = {
     [FuriHalAdcChannelVBAT] = LL_ADC_CHANNEL_VBAT,
 };
 
+static const uint32_t furi_hal_adc_rank_map[FURI_HAL_ADC_STREAM_CHANNELS_MAX] = {
+    LL_ADC_REG_RANK_1,
+    LL_ADC_REG_RANK_2,
+    LL_ADC_REG_RANK_3,
+    LL_ADC_REG_RANK_4,
+    LL_ADC_REG_RANK_5,
+    LL_ADC_REG_RANK_6,
+    LL_ADC_REG_RANK_7,
+    LL_ADC_REG_RANK_8,
+    LL_ADC_REG_RANK_9,
+    LL_ADC_REG_RANK_10,
+    LL_ADC_REG_RANK_11,
+    LL_ADC_REG_RANK_12,
+    LL_ADC_REG_RANK_13,
+    LL_ADC_REG_RANK_14,
+    LL_ADC_REG_RANK_15,
+    LL_ADC_REG_RANK_16,
+};
+
 static FuriHalAdcHandle* furi_hal_adc_handle = NULL;
 
 void furi_hal_adc_init(void) {
@@ -104,6 +142,7 @@ FuriHalAdcHandle* furi_hal_adc_acquire(void) {
 
 void furi_hal_adc_release(FuriHalAdcHandle* handle) {
     furi_check(handle);
+    furi_check(!handle->stream_active);
 
     if(furi_hal_bus_is_enabled(FuriHalBusADC)) furi_hal_bus_disable(FuriHalBusADC);
 
@@ -131,6 +170,7 @@ void furi_hal_adc_configure_ex(
     FuriHalAdcOversample oversample,
     FuriHalAdcSamplingTime sampling_time) {
     furi_check(handle);
+    furi_check(!handle->stream_active);
     furi_check(scale == FuriHalAdcScale2048 || scale == FuriHalAdcScale2500);
     furi_check(clock <= FuriHalAdcClockSync64);
     furi_check(oversample <= FuriHalAdcOversampleNone);
@@ -247,6 +287,7 @@ void furi_hal_adc_configure_ex(
 uint16_t furi_hal_adc_read(FuriHalAdcHandle* handle, FuriHalAdcChannel channel) {
     furi_check(handle);
     furi_check(channel <= FuriHalAdcChannelVBAT);
+    furi_check(!handle->stream_active);
     furi_check(LL_ADC_IsEnabled(handle->adc) == 1);
     furi_check(LL_ADC_IsDisableOngoing(handle->adc) == 0);
     furi_check(LL_ADC_REG_IsConversionOngoing(handle->adc) == 0);
@@ -263,6 +304,140 @@ uint16_t furi_hal_adc_read(FuriHalAdcHandle* handle, FuriHalAdcChannel channel)
     return value;
 }
 
+static void furi_hal_adc_stream_dma_isr(void* context) {
+    FuriHalAdcHandle* handle = context;
+    const size_t half_size = handle->stream_buffer_size / 2;
+
+#if FURI_HAL_ADC_STREAM_DMA_CHANNEL == LL_DMA_CHANNEL_3
+    if(LL_DMA_IsActiveFlag_TE3(FURI_HAL_ADC_STREAM_DMA)) {
+        LL_DMA_ClearFlag_TE3(FURI_HAL_ADC_STREAM_DMA);
+        furi_crash();
+    }
+    if(LL_DMA_IsActiveFlag_HT3(FURI_HAL_ADC_STREAM_DMA)) {
+        LL_DMA_ClearFlag_HT3(FURI_HAL_ADC_STREAM_DMA);
+        handle->stream_callback(handle->stream_buffer, half_size, handle->stream_context);
+    }
+    if(LL_DMA_IsActiveFlag_TC3(FURI_HAL_ADC_STREAM_DMA)) {
+        LL_DMA_ClearFlag_TC3(FURI_HAL_ADC_STREAM_DMA);
+        handle->stream_callback(
+            handle->stream_buffer + half_size, half_size, handle->stream_context);
+    }
+#else
+#error Update this code. Would you kindly?
+#endif
+}
+
+uint32_t furi_hal_adc_stream_start(
+    FuriHalAdcHandle* handle,
+    const FuriHalAdcChannel* channels,
+    size_t channels_count,
+    uint32_t frequency,
+    uint16_t* buffer,
+    size_t buffer_size,
+    FuriHalAdcStreamCallback callback,
+    void* context) {
+    furi_check(handle);
+    furi_check(!handle->stream_active);
+    furi_check(channels);
+    furi_check(channels_count > 0 && channels_count <= FURI_HAL_ADC_STREAM_CHANNELS_MAX);
+    furi_check(frequency > 0 && frequency <= FURI_HAL_ADC_STREAM_TIMER_CLOCK);
+    furi_check(buffer);
+    // Every half of the buffer must hold whole scans
+    furi_check(buffer_size > 0 && buffer_size <= UINT16_MAX);
+    furi_check(buffer_size % (channels_count * 2) == 0);
+    furi_check(callback);
+    furi_check(LL_ADC_IsEnabled(handle->adc) == 1);
+    furi_check(LL_ADC_REG_IsConversionOngoing(handle->adc) == 0);
+
+    handle->stream_buffer = buffer;
+    handle->stream_buffer_size = buffer_size;
+    handle->stream_callback = callback;
+    handle->stream_context = context;
+    handle->stream_active = true;
+
+    // Sequencer: one rank per channel, every trigger converts the whole sequence
+    for(size_t i = 0; i < channels_count; i++) {
+        furi_check(channels[i] <= FuriHalAdcChannelVBAT);
+        LL_ADC_REG_SetSequencerRanks(
+            handle->adc, furi_hal_adc_rank_map[i], furi_hal_adc_channel_map[channels[i]]);
+    }
+    LL_ADC_REG_SetSequencerLength(handle->adc, (channels_count - 1) << ADC_SQR1_L_Pos);
+    LL_ADC_REG_SetTriggerSource(handle->adc, FURI_HAL_ADC_STREAM_TIMER_TRIGGER);
+    LL_ADC_REG_SetTriggerEdge(handle->adc, LL_ADC_REG_TRIG_EXT_RISING);
+    LL_ADC_REG_SetDMATransfer(handle->adc, LL_ADC_REG_DMA_TRANSFER_UNLIMITED);
+
+    // DMA: circular, interrupts on both halves
+    LL_DMA_InitTypeDef dma_config = {0};
+    dma_config.PeriphOrM2MSrcAddress =
+        LL_ADC_DMA_GetRegAddr(handle->adc, LL_ADC_DMA_REG_REGULAR_DATA);
+    dma_config.MemoryOrM2MDstAddress = (uint32_t)buffer;
+    dma_config.Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
+    dma_config.Mode = LL_DMA_MODE_CIRCULAR;
+    dma_config.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    dma_config.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    dma_config.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_HALFWORD;
+    dma_config.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_HALFWORD;
+    dma_config.NbData = buffer_size;
+    dma_config.PeriphRequest = LL_DMAMUX_REQ_ADC1;
+    dma_config.Priority = LL_DMA_PRIORITY_HIGH;
+    LL_DMA_Init(FURI_HAL_ADC_STREAM_DMA_DEF, &dma_config);
+
+    furi_hal_interrupt_set_isr(FURI_HAL_ADC_STREAM_DMA_IRQ, furi_hal_adc_stream_dma_isr, handle);
+    LL_DMA_EnableIT_TE(FURI_HAL_ADC_STREAM_DMA_DEF);
+    LL_DMA_EnableIT_HT(FURI_HAL_ADC_STREAM_DMA_DEF);
+    LL_DMA_EnableIT_TC(FURI_HAL_ADC_STREAM_DMA_DEF);
+    LL_DMA_EnableChannel(FURI_HAL_ADC_STREAM_DMA_DEF);
+
+    // Timer: update event on TRGO paces the scans
+    const uint32_t period = FURI_HAL_ADC_STREAM_TIMER_CLOCK / frequency;
+    const uint32_t prescaler = (period - 1) / (UINT16_MAX + 1);
+    const uint32_t autoreload = period / (prescaler + 1) - 1;
+
+    furi_hal_bus_enable(FURI_HAL_ADC_STREAM_TIMER_BUS);
+    LL_TIM_InitTypeDef tim_config = {0};
+    tim_config.Prescaler = prescaler;
+    tim_config.CounterMode = LL_TIM_COUNTERMODE_UP;
+    tim_config.Autoreload = autoreload;
+    tim_config.ClockDivision = LL_TIM_CLOCKDIVISION_DIV1;
+    LL_TIM_Init(FURI_HAL_ADC_STREAM_TIMER, &tim_config);
+    LL_TIM_SetTriggerOutput(FURI_HAL_ADC_STREAM_TIMER, LL_TIM_TRGO_UPDATE);
+
+    // ADC waits for the first trigger, then the timer starts
+    LL_ADC_REG_StartConversion(handle->adc);
+    LL_TIM_SetCounter(FURI_HAL_ADC_STREAM_TIMER, 0);
+    LL_TIM_EnableCounter(FURI_HAL_ADC_STREAM_TIMER);
+
+    return FURI_HAL_ADC_STREAM_TIMER_CLOCK / ((prescaler + 1) * (autoreload + 1));
+}
+
+void furi_hal_adc_stream_stop(FuriHalAdcHandle* handle) {
+    furi_check(handle);
+    furi_check(handle->stream_active);
+
+    LL_TIM_DisableCounter(FURI_HAL_ADC_STREAM_TIMER);
+    furi_hal_bus_disable(FURI_HAL_ADC_STREAM_TIMER_BUS);
+
+    LL_ADC_REG_StopConversion(handle->adc);
+    while(LL_ADC_REG_IsStopConversionOngoing(handle->adc))
+        ;
+
+    LL_DMA_DisableIT_TE(FURI_HAL_ADC_STREAM_DMA_DEF);
+    LL_DMA_DisableIT_HT(FURI_HAL_ADC_STREAM_DMA_DEF);
+    LL_DMA_DisableIT_TC(FURI_HAL_ADC_STREAM_DMA_DEF);
+    LL_DMA_DisableChannel(FURI_HAL_ADC_STREAM_DMA_DEF);
+    furi_hal_interrupt_set_isr(FURI_HAL_ADC_STREAM_DMA_IRQ, NULL, NULL);
+
+    // Back to single software triggered conversions for furi_hal_adc_read
+    LL_ADC_REG_SetDMATransfer(handle->adc, LL_ADC_REG_DMA_TRANSFER_NONE);
+    LL_ADC_REG_SetTriggerSource(handle->adc, LL_ADC_REG_TRIG_SOFTWARE);
+    LL_ADC_REG_SetSequencerLength(handle->adc, LL_ADC_REG_SEQ_SCAN_DISABLE);
+    LL_ADC_ClearFlag_EOC(handle->adc);
+    LL_ADC_ClearFlag_EOS(handle->adc);
+    LL_ADC_ClearFlag_OVR(handle->adc);
+
+    handle->stream_active = false;
+}
+
 float furi_hal_adc_convert_to_voltage(FuriHalAdcHandle* handle, uint16_t value) {
     return (float)__LL_ADC_CALC_DATA_TO_VOLTAGE(handle->full_scale, value, LL_ADC_RESOLUTION_12B);
 }
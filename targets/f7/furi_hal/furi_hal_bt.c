@@ -29,11 +29,13 @@
 typedef struct {
     FuriMutex* core2_mtx;
     FuriHalBtStack stack;
+    bool boot_traced;
 } FuriHalBt;
 
 static FuriHalBt furi_hal_bt = {
     .core2_mtx = NULL,
     .stack = FuriHalBtStackUnknown,
+    .boot_traced = false,
 };
 
 void furi_hal_bt_init(void) {
@@ -42,7 +44,7 @@ void furi_hal_bt_init(void) {
     furi_hal_bus_enable(FuriHalBusIPCC);
     furi_hal_bus_enable(FuriHalBusAES2);
     furi_hal_bus_enable(FuriHalBusPKA);
-    furi_hal_bus_enable(FuriHalBusCRC);
+    // CRC bus is owned by furi_hal_crc, the unit may be in use by another thread
 
     if(!furi_hal_bt.core2_mtx) {
         furi_hal_bt.core2_mtx = furi_mutex_alloc(FuriMutexTypeNormal);
@@ -100,6 +102,9 @@ bool furi_hal_bt_start_radio_stack(void) {
             FURI_LOG_E(TAG, "Core2 start failed");
             break;
         }
+        if(!furi_hal_bt.boot_traced) {
+            furi_boot_trace_mark("ble_c2");
+        }
 
         // If C2 is running, start radio stack fw
         if(!furi_hal_bt_ensure_c2_mode(BleGlueC2ModeStack)) {
@@ -120,6 +125,10 @@ bool furi_hal_bt_start_radio_stack(void) {
             ble_glue_stop();
             break;
         }
+        if(!furi_hal_bt.boot_traced) {
+            furi_boot_trace_mark("ble_stack");
+            furi_hal_bt.boot_traced = true;
+        }
         res = true;
     } while(false);
 
@@ -228,7 +237,6 @@ void furi_hal_bt_reinit(void) {
     furi_hal_bus_disable(FuriHalBusIPCC);
     furi_hal_bus_disable(FuriHalBusAES2);
     furi_hal_bus_disable(FuriHalBusPKA);
-    furi_hal_bus_disable(FuriHalBusCRC);
 
     furi_hal_bt_init();
     furi_hal_bt_unlock_core2();
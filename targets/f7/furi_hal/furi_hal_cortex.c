@@ -46,6 +46,19 @@ void furi_hal_cortex_timer_wait(FuriHalCortexTimer cortex_timer) {
         ;
 }
 
+uint32_t furi_hal_cortex_get_timestamp_us(void) {
+    FURI_CRITICAL_ENTER();
+    uint32_t tick = furi_get_tick();
+    const uint32_t load = SysTick->LOAD + 1;
+    const uint32_t value = SysTick->VAL;
+    // Counter reloaded, but tick interrupt is not serviced yet
+    if((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && value > load / 2) tick++;
+    FURI_CRITICAL_EXIT();
+
+    const uint32_t us_per_tick = 1000000U / furi_kernel_get_tick_frequency();
+    return tick * us_per_tick + (load - 1 - value) * us_per_tick / load;
+}
+
 // Duck ST
 #undef COMP0
 #undef COMP1
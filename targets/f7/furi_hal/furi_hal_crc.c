@@ -0,0 +1,50 @@
+#include <furi_hal_crc.h>
+#include <furi_hal_bus.h>
+#include <furi.h>
+
+#include <stm32wbxx_ll_crc.h>
+
+static bool furi_hal_crc_busy = false;
+
+void furi_hal_crc_init_early(void) {
+    furi_hal_bus_enable(FuriHalBusCRC);
+}
+
+void furi_hal_crc_deinit_early(void) {
+    furi_hal_bus_disable(FuriHalBusCRC);
+}
+
+bool furi_hal_crc_acquire(void) {
+    return !__atomic_exchange_n(&furi_hal_crc_busy, true, __ATOMIC_ACQUIRE);
+}
+
+void furi_hal_crc_release(void) {
+    furi_check(furi_hal_crc_busy);
+    __atomic_store_n(&furi_hal_crc_busy, false, __ATOMIC_RELEASE);
+}
+
+uint32_t furi_hal_crc_calc_crc32(uint32_t crc, const void* buffer, size_t size) {
+    furi_check(furi_hal_crc_busy);
+    furi_check(buffer || !size);
+
+    // Reflected CRC-32: bytes are fed MSB first with per-byte bit reversal and the result is
+    // bit reversed on output. Reflected state of the preceding data goes into the register as is.
+    LL_CRC_SetPolynomialCoef(CRC, LL_CRC_DEFAULT_CRC32_POLY);
+    LL_CRC_SetPolynomialSize(CRC, LL_CRC_POLYLENGTH_32B);
+    LL_CRC_SetInputDataReverseMode(CRC, LL_CRC_INDATA_REVERSE_BYTE);
+    LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_BIT);
+    LL_CRC_SetInitialData(CRC, __RBIT(~crc));
+    LL_CRC_ResetCRCCalculationUnit(CRC);
+
+    const uint8_t* data = buffer;
+
+    for(; size >= sizeof(uint32_t); size -= sizeof(uint32_t), data += sizeof(uint32_t)) {
+        LL_CRC_FeedData32(CRC, __REV(__UNALIGNED_UINT32_READ(data)));
+    }
+
+    for(; size > 0; size--, data++) {
+        LL_CRC_FeedData8(CRC, *data);
+    }
+
+    return ~LL_CRC_ReadData32(CRC);
+}
@@ -0,0 +1,46 @@
+/**
+ * @file furi_hal_crc.h
+ * CRC calculation unit HAL API
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Early initialization */
+void furi_hal_crc_init_early(void);
+
+/** Early de-initialization */
+void furi_hal_crc_deinit_early(void);
+
+/** Acquire CRC unit
+ *
+ * Never blocks, safe to call from ISR and before kernel start.
+ *
+ * @return     true if acquired, false if CRC unit is in use
+ */
+bool furi_hal_crc_acquire(void);
+
+/** Release CRC unit */
+void furi_hal_crc_release(void);
+
+/** Calculate CRC-32 (ISO-HDLC, same as zlib) over buffer
+ *
+ * CRC unit MUST be acquired.
+ *
+ * @param[in]  crc     CRC of preceding data, 0 to start new calculation
+ * @param[in]  buffer  pointer to data
+ * @param[in]  size    data size in bytes
+ *
+ * @return     CRC-32 of preceding data and buffer
+ */
+uint32_t furi_hal_crc_calc_crc32(uint32_t crc, const void* buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,8 +3,10 @@
 #include <furi_hal_bt.h>
 #include <furi_hal_random.h>
 #include <furi_hal_bus.h>
+#include <furi_hal_dma.h>
 
 #include <stm32wbxx_ll_cortex.h>
+#include <stm32wbxx_ll_dma.h>
 #include <furi.h>
 #include <interface/patterns/ble_thread/shci/shci.h>
 
@@ -22,6 +24,7 @@
 #define CRYPTO_MODE_DECRYPT_INIT (AES_CR_MODE_0 | AES_CR_MODE_1)
 
 #define CRYPTO_DATATYPE_32B 0U
+#define CRYPTO_DATATYPE_8B  (AES_CR_DATATYPE_1)
 #define CRYPTO_KEYSIZE_256B (AES_CR_KEYSIZE)
 #define CRYPTO_AES_CBC      (AES_CR_CHMOD_0)
 
@@ -38,8 +41,29 @@
 #define CRYPTO_GCM_PH_PAYLOAD (AES_CR_GCMPH_1)
 #define CRYPTO_GCM_PH_FINAL   (AES_CR_GCMPH_1 | AES_CR_GCMPH_0)
 
+/* DMA1 channel 4 is shared with pulse_reader, blocks are fed by CPU while it is taken */
+#define CRYPTO_DMA             (DMA1)
+#define CRYPTO_DMA_IN_CHANNEL  (LL_DMA_CHANNEL_3)
+#define CRYPTO_DMA_OUT_CHANNEL (LL_DMA_CHANNEL_4)
+#define CRYPTO_DMA_IN_IRQ      (FuriHalInterruptIdDma1Ch3)
+#define CRYPTO_DMA_OUT_IRQ     (FuriHalInterruptIdDma1Ch4)
+#define CRYPTO_DMA_IN_DEF      CRYPTO_DMA, CRYPTO_DMA_IN_CHANNEL
+#define CRYPTO_DMA_OUT_DEF     CRYPTO_DMA, CRYPTO_DMA_OUT_CHANNEL
+
+/* DMA setup costs about as much as feeding a few blocks by CPU */
+#define CRYPTO_DMA_SIZE_MIN (4U * CRYPTO_BLK_LEN)
+
+typedef struct {
+    FuriHalCryptoCallback callback; // Called from ISR, NULL when idle
+    void* context;
+    bool disable; // Disable AES on completion, async CBC only
+} FuriHalCryptoDma;
+
 static FuriMutex* furi_hal_crypto_mutex = NULL;
 static bool furi_hal_crypto_mode_init_done = false;
+static FuriSemaphore* furi_hal_crypto_dma_completed = NULL;
+static bool furi_hal_crypto_dma_success = false;
+static FuriHalCryptoDma furi_hal_crypto_dma = {0};
 
 static const uint8_t enclave_signature_iv[ENCLAVE_FACTORY_KEY_SLOTS][16] = {
     {0xac, 0x5d, 0x68, 0xb8, 0x79, 0x74, 0xfc, 0x7f, 0x45, 0x02, 0x82, 0xf1, 0x48, 0x7e, 0x75, 0x8a},
@@ -82,6 +106,7 @@ static const uint8_t enclave_signature_expected[ENCLAVE_FACTORY_KEY_SLOTS][ENCLA
 
 void furi_hal_crypto_init(void) {
     furi_hal_crypto_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    furi_hal_crypto_dma_completed = furi_semaphore_alloc(1, 0);
     FURI_LOG_I(TAG, "Init OK");
 }
 
@@ -255,6 +280,159 @@ static bool crypto_process_block(uint32_t* in, uint32_t* out, uint8_t blk_len) {
     return true;
 }
 
+static void furi_hal_crypto_dma_stop(void) {
+    CLEAR_BIT(AES1->CR, AES_CR_DMAINEN | AES_CR_DMAOUTEN);
+
+    LL_DMA_DisableIT_TC(CRYPTO_DMA_OUT_DEF);
+    LL_DMA_DisableIT_TE(CRYPTO_DMA_OUT_DEF);
+    LL_DMA_DisableIT_TE(CRYPTO_DMA_IN_DEF);
+    LL_DMA_DisableChannel(CRYPTO_DMA_IN_DEF);
+    LL_DMA_DisableChannel(CRYPTO_DMA_OUT_DEF);
+
+    furi_hal_interrupt_set_isr(CRYPTO_DMA_IN_IRQ, NULL, NULL);
+    furi_hal_interrupt_set_isr(CRYPTO_DMA_OUT_IRQ, NULL, NULL);
+
+    furi_hal_dma_channel_release(CRYPTO_DMA_OUT_DEF);
+    furi_hal_dma_channel_release(CRYPTO_DMA_IN_DEF);
+}
+
+static void furi_hal_crypto_dma_isr(void* context) {
+    UNUSED(context);
+
+    bool success;
+#if CRYPTO_DMA_IN_CHANNEL == LL_DMA_CHANNEL_3 && CRYPTO_DMA_OUT_CHANNEL == LL_DMA_CHANNEL_4
+    if(LL_DMA_IsActiveFlag_TE3(CRYPTO_DMA) || LL_DMA_IsActiveFlag_TE4(CRYPTO_DMA)) {
+        success = false;
+    } else if(LL_DMA_IsActiveFlag_TC4(CRYPTO_DMA)) {
+        success = true;
+    } else {
+        return;
+    }
+    LL_DMA_ClearFlag_GI3(CRYPTO_DMA);
+    LL_DMA_ClearFlag_GI4(CRYPTO_DMA);
+#else
+#error Update this code. Would you kindly?
+#endif
+
+    furi_hal_crypto_dma_stop();
+
+    if(furi_hal_crypto_dma.disable) CLEAR_BIT(AES1->CR, AES_CR_EN);
+
+    FuriHalCryptoCallback callback = furi_hal_crypto_dma.callback;
+    furi_hal_crypto_dma.callback = NULL;
+    if(callback) callback(success, furi_hal_crypto_dma.context);
+}
+
+/* AES must be configured and enabled, size is a multiple of block size */
+static bool furi_hal_crypto_dma_start(
+    const uint8_t* input,
+    uint8_t* output,
+    size_t size,
+    FuriHalCryptoCallback callback,
+    void* context,
+    bool disable) {
+    if(((uintptr_t)input | (uintptr_t)output) & 3U) return false;
+
+    bool busy;
+    FURI_CRITICAL_ENTER();
+    busy = furi_hal_crypto_dma.callback || !furi_hal_dma_channel_acquire(CRYPTO_DMA_IN_DEF);
+    if(!busy && !furi_hal_dma_channel_acquire(CRYPTO_DMA_OUT_DEF)) {
+        furi_hal_dma_channel_release(CRYPTO_DMA_IN_DEF);
+        busy = true;
+    }
+    if(!busy) {
+        furi_hal_crypto_dma.callback = callback;
+        furi_hal_crypto_dma.context = context;
+        furi_hal_crypto_dma.disable = disable;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(busy) return false;
+
+    LL_DMA_InitTypeDef dma_config = {0};
+    dma_config.PeriphOrM2MSrcAddress = (uint32_t)&AES1->DINR;
+    dma_config.MemoryOrM2MDstAddress = (uint32_t)input;
+    dma_config.Direction = LL_DMA_DIRECTION_MEMORY_TO_PERIPH;
+    dma_config.Mode = LL_DMA_MODE_NORMAL;
+    dma_config.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    dma_config.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    dma_config.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_WORD;
+    dma_config.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_WORD;
+    dma_config.NbData = size / sizeof(uint32_t);
+    dma_config.PeriphRequest = LL_DMAMUX_REQ_AES1_IN;
+    dma_config.Priority = LL_DMA_PRIORITY_HIGH;
+    LL_DMA_Init(CRYPTO_DMA_IN_DEF, &dma_config);
+
+    dma_config.PeriphOrM2MSrcAddress = (uint32_t)&AES1->DOUTR;
+    dma_config.MemoryOrM2MDstAddress = (uint32_t)output;
+    dma_config.Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
+    dma_config.PeriphRequest = LL_DMAMUX_REQ_AES1_OUT;
+    LL_DMA_Init(CRYPTO_DMA_OUT_DEF, &dma_config);
+
+#if CRYPTO_DMA_IN_CHANNEL == LL_DMA_CHANNEL_3 && CRYPTO_DMA_OUT_CHANNEL == LL_DMA_CHANNEL_4
+    LL_DMA_ClearFlag_GI3(CRYPTO_DMA);
+    LL_DMA_ClearFlag_GI4(CRYPTO_DMA);
+#else
+#error Update this code. Would you kindly?
+#endif
+
+    furi_hal_interrupt_set_isr(CRYPTO_DMA_IN_IRQ, furi_hal_crypto_dma_isr, NULL);
+    furi_hal_interrupt_set_isr(CRYPTO_DMA_OUT_IRQ, furi_hal_crypto_dma_isr, NULL);
+
+    LL_DMA_EnableIT_TE(CRYPTO_DMA_IN_DEF);
+    LL_DMA_EnableIT_TE(CRYPTO_DMA_OUT_DEF);
+    LL_DMA_EnableIT_TC(CRYPTO_DMA_OUT_DEF);
+    LL_DMA_EnableChannel(CRYPTO_DMA_OUT_DEF);
+    LL_DMA_EnableChannel(CRYPTO_DMA_IN_DEF);
+
+    SET_BIT(AES1->CR, AES_CR_DMAINEN | AES_CR_DMAOUTEN);
+
+    return true;
+}
+
+static void furi_hal_crypto_dma_wait_callback(bool success, void* context) {
+    UNUSED(context);
+    furi_hal_crypto_dma_success = success;
+    furi_semaphore_release(furi_hal_crypto_dma_completed);
+}
+
+/* AES must be configured and enabled, size is a multiple of block size */
+static bool furi_hal_crypto_process_blocks(const uint8_t* input, uint8_t* output, size_t size) {
+    // Thread waits for DMA, CPU is free for others meanwhile
+    if(size >= CRYPTO_DMA_SIZE_MIN && !FURI_IS_IRQ_MODE() && furi_kernel_is_running() &&
+       furi_hal_crypto_dma_start(
+           input, output, size, furi_hal_crypto_dma_wait_callback, NULL, false)) {
+        if(furi_semaphore_acquire(
+               furi_hal_crypto_dma_completed, furi_ms_to_ticks(CRYPTO_TIMEOUT_US / 1000)) ==
+           FuriStatusOk) {
+            return furi_hal_crypto_dma_success;
+        }
+
+        FURI_CRITICAL_ENTER();
+        const bool pending = furi_hal_crypto_dma.callback;
+        if(pending) {
+            furi_hal_crypto_dma.callback = NULL;
+            furi_hal_crypto_dma_stop();
+        }
+        FURI_CRITICAL_EXIT();
+
+        if(pending) return false;
+
+        // Completed right after the timeout
+        furi_semaphore_acquire(furi_hal_crypto_dma_completed, 0);
+        return furi_hal_crypto_dma_success;
+    }
+
+    for(size_t i = 0; i < size; i += CRYPTO_BLK_LEN) {
+        if(!crypto_process_block(
+               (uint32_t*)&input[i], (uint32_t*)&output[i], CRYPTO_BLK_LEN / sizeof(uint32_t))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool furi_hal_crypto_enclave_load_key(uint8_t slot, const uint8_t* iv) {
     furi_check(slot > 0 && slot <= 100);
     furi_check(furi_hal_crypto_mutex);
@@ -333,6 +511,24 @@ bool furi_hal_crypto_unload_key(void) {
     return true;
 }
 
+/* Whole blocks go in bulk, trailing words are processed as a short block */
+static bool furi_hal_crypto_process(const uint8_t* input, uint8_t* output, size_t size) {
+    const size_t blocks_size = size - size % CRYPTO_BLK_LEN;
+
+    if(!size || !furi_hal_crypto_process_blocks(input, output, blocks_size)) {
+        return false;
+    }
+
+    if(size - blocks_size >= sizeof(uint32_t)) {
+        return crypto_process_block(
+            (uint32_t*)&input[blocks_size],
+            (uint32_t*)&output[blocks_size],
+            (size - blocks_size) / sizeof(uint32_t));
+    }
+
+    return true;
+}
+
 bool furi_hal_crypto_encrypt(const uint8_t* input, uint8_t* output, size_t size) {
     bool state = false;
 
@@ -340,25 +536,14 @@ bool furi_hal_crypto_encrypt(const uint8_t* input, uint8_t* output, size_t size)
 
     MODIFY_REG(AES1->CR, AES_CR_MODE, CRYPTO_MODE_ENCRYPT);
 
-    for(size_t i = 0; i < size; i += CRYPTO_BLK_LEN) {
-        size_t blk_len = size - i;
-        if(blk_len > CRYPTO_BLK_LEN) {
-            blk_len = CRYPTO_BLK_LEN;
-        }
-        state = crypto_process_block((uint32_t*)&input[i], (uint32_t*)&output[i], blk_len / 4);
-        if(state == false) {
-            break;
-        }
-    }
+    state = furi_hal_crypto_process(input, output, size);
 
     CLEAR_BIT(AES1->CR, AES_CR_EN);
 
     return state;
 }
 
-bool furi_hal_crypto_decrypt(const uint8_t* input, uint8_t* output, size_t size) {
-    bool state = false;
-
+static bool furi_hal_crypto_decrypt_init(void) {
     if(!furi_hal_crypto_mode_init_done) {
         MODIFY_REG(AES1->CR, AES_CR_MODE, CRYPTO_MODE_INIT);
 
@@ -373,31 +558,76 @@ bool furi_hal_crypto_decrypt(const uint8_t* input, uint8_t* output, size_t size)
         furi_hal_crypto_mode_init_done = true;
     }
 
+    return true;
+}
+
+bool furi_hal_crypto_decrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    bool state = false;
+
+    if(!furi_hal_crypto_decrypt_init()) {
+        return false;
+    }
+
     MODIFY_REG(AES1->CR, AES_CR_MODE, CRYPTO_MODE_DECRYPT);
     SET_BIT(AES1->CR, AES_CR_EN);
 
-    for(size_t i = 0; i < size; i += CRYPTO_BLK_LEN) {
-        size_t blk_len = size - i;
-        if(blk_len > CRYPTO_BLK_LEN) {
-            blk_len = CRYPTO_BLK_LEN;
-        }
-        state = crypto_process_block((uint32_t*)&input[i], (uint32_t*)&output[i], blk_len / 4);
-        if(state == false) {
-            break;
-        }
-    }
+    state = furi_hal_crypto_process(input, output, size);
 
     CLEAR_BIT(AES1->CR, AES_CR_EN);
 
     return state;
 }
 
+static bool furi_hal_crypto_process_async(
+    const uint8_t* input,
+    uint8_t* output,
+    size_t size,
+    FuriHalCryptoCallback callback,
+    void* context) {
+    furi_check(callback);
+    furi_check(size && size % CRYPTO_BLK_LEN == 0);
+    furi_check(!FURI_IS_IRQ_MODE());
+
+    SET_BIT(AES1->CR, AES_CR_EN);
+
+    if(!furi_hal_crypto_dma_start(input, output, size, callback, context, true)) {
+        CLEAR_BIT(AES1->CR, AES_CR_EN);
+        return false;
+    }
+
+    return true;
+}
+
+bool furi_hal_crypto_encrypt_async(
+    const uint8_t* input,
+    uint8_t* output,
+    size_t size,
+    FuriHalCryptoCallback callback,
+    void* context) {
+    MODIFY_REG(AES1->CR, AES_CR_MODE, CRYPTO_MODE_ENCRYPT);
+    return furi_hal_crypto_process_async(input, output, size, callback, context);
+}
+
+bool furi_hal_crypto_decrypt_async(
+    const uint8_t* input,
+    uint8_t* output,
+    size_t size,
+    FuriHalCryptoCallback callback,
+    void* context) {
+    if(!furi_hal_crypto_decrypt_init()) {
+        return false;
+    }
+
+    MODIFY_REG(AES1->CR, AES_CR_MODE, CRYPTO_MODE_DECRYPT);
+    return furi_hal_crypto_process_async(input, output, size, callback, context);
+}
+
 static void crypto_key_init_bswap(uint32_t* key, uint32_t* iv, uint32_t chaining_mode) {
     CLEAR_BIT(AES1->CR, AES_CR_EN);
     MODIFY_REG(
         AES1->CR,
         AES_CR_DATATYPE | AES_CR_KEYSIZE | AES_CR_CHMOD,
-        CRYPTO_DATATYPE_32B | CRYPTO_KEYSIZE_256B | chaining_mode);
+        CRYPTO_DATATYPE_8B | CRYPTO_KEYSIZE_256B | chaining_mode);
 
     if(key != NULL) {
         AES1->KEYR7 = __builtin_bswap32(key[0]);
@@ -438,41 +668,32 @@ static bool wait_for_crypto(void) {
     return true;
 }
 
-static bool furi_hal_crypto_process_block_bswap(const uint8_t* in, uint8_t* out, size_t bytes) {
+/* CTR and GCM run with hardware byte swapping, data goes to the engine as is */
+static bool furi_hal_crypto_process_block_bytes(const uint8_t* in, uint8_t* out, size_t bytes) {
     uint32_t block[CRYPTO_BLK_LEN / 4];
     memset(block, 0, sizeof(block));
 
     memcpy(block, in, bytes);
 
-    block[0] = __builtin_bswap32(block[0]);
-    block[1] = __builtin_bswap32(block[1]);
-    block[2] = __builtin_bswap32(block[2]);
-    block[3] = __builtin_bswap32(block[3]);
-
     if(!crypto_process_block(block, block, CRYPTO_BLK_LEN / 4)) {
         return false;
     }
 
-    block[0] = __builtin_bswap32(block[0]);
-    block[1] = __builtin_bswap32(block[1]);
-    block[2] = __builtin_bswap32(block[2]);
-    block[3] = __builtin_bswap32(block[3]);
-
     memcpy(out, block, bytes);
 
     return true;
 }
 
-static bool furi_hal_crypto_process_block_no_read_bswap(const uint8_t* in, size_t bytes) {
+static bool furi_hal_crypto_process_block_no_read_bytes(const uint8_t* in, size_t bytes) {
     uint32_t block[CRYPTO_BLK_LEN / 4];
     memset(block, 0, sizeof(block));
 
     memcpy(block, in, bytes);
 
-    AES1->DINR = __builtin_bswap32(block[0]);
-    AES1->DINR = __builtin_bswap32(block[1]);
-    AES1->DINR = __builtin_bswap32(block[2]);
-    AES1->DINR = __builtin_bswap32(block[3]);
+    AES1->DINR = block[0];
+    AES1->DINR = block[1];
+    AES1->DINR = block[2];
+    AES1->DINR = block[3];
 
     return wait_for_crypto();
 }
@@ -491,16 +712,14 @@ static bool furi_hal_crypto_ctr_payload(const uint8_t* input, uint8_t* output, s
 
     size_t last_block_bytes = length % CRYPTO_BLK_LEN;
 
-    size_t i;
-    for(i = 0; i < length - last_block_bytes; i += CRYPTO_BLK_LEN) {
-        if(!furi_hal_crypto_process_block_bswap(&input[i], &output[i], CRYPTO_BLK_LEN)) {
-            CLEAR_BIT(AES1->CR, AES_CR_EN);
-            return false;
-        }
+    size_t i = length - last_block_bytes;
+    if(!furi_hal_crypto_process_blocks(input, output, i)) {
+        CLEAR_BIT(AES1->CR, AES_CR_EN);
+        return false;
     }
 
     if(last_block_bytes > 0) {
-        if(!furi_hal_crypto_process_block_bswap(&input[i], &output[i], last_block_bytes)) {
+        if(!furi_hal_crypto_process_block_bytes(&input[i], &output[i], last_block_bytes)) {
             CLEAR_BIT(AES1->CR, AES_CR_EN);
             return false;
         }
@@ -573,14 +792,14 @@ static bool furi_hal_crypto_gcm_header(const uint8_t* aad, size_t aad_length) {
 
     size_t i;
     for(i = 0; i < aad_length - last_block_bytes; i += CRYPTO_BLK_LEN) {
-        if(!furi_hal_crypto_process_block_no_read_bswap(&aad[i], CRYPTO_BLK_LEN)) {
+        if(!furi_hal_crypto_process_block_no_read_bytes(&aad[i], CRYPTO_BLK_LEN)) {
             CLEAR_BIT(AES1->CR, AES_CR_EN);
             return false;
         }
     }
 
     if(last_block_bytes > 0) {
-        if(!furi_hal_crypto_process_block_no_read_bswap(&aad[i], last_block_bytes)) {
+        if(!furi_hal_crypto_process_block_no_read_bytes(&aad[i], last_block_bytes)) {
             CLEAR_BIT(AES1->CR, AES_CR_EN);
             return false;
         }
@@ -601,12 +820,10 @@ static bool furi_hal_crypto_gcm_payload(
 
     size_t last_block_bytes = length % CRYPTO_BLK_LEN;
 
-    size_t i;
-    for(i = 0; i < length - last_block_bytes; i += CRYPTO_BLK_LEN) {
-        if(!furi_hal_crypto_process_block_bswap(&input[i], &output[i], CRYPTO_BLK_LEN)) {
-            CLEAR_BIT(AES1->CR, AES_CR_EN);
-            return false;
-        }
+    size_t i = length - last_block_bytes;
+    if(!furi_hal_crypto_process_blocks(input, output, i)) {
+        CLEAR_BIT(AES1->CR, AES_CR_EN);
+        return false;
     }
 
     if(last_block_bytes > 0) {
@@ -614,7 +831,7 @@ static bool furi_hal_crypto_gcm_payload(
             MODIFY_REG(
                 AES1->CR, AES_CR_NPBLB, (CRYPTO_BLK_LEN - last_block_bytes) << AES_CR_NPBLB_Pos);
         }
-        if(!furi_hal_crypto_process_block_bswap(&input[i], &output[i], last_block_bytes)) {
+        if(!furi_hal_crypto_process_block_bytes(&input[i], &output[i], last_block_bytes)) {
             CLEAR_BIT(AES1->CR, AES_CR_EN);
             return false;
         }
@@ -633,7 +850,7 @@ static bool furi_hal_crypto_gcm_finish(size_t aad_length, size_t payload_length,
     last_block[1] = __builtin_bswap32((uint32_t)(aad_length * 8));
     last_block[3] = __builtin_bswap32((uint32_t)(payload_length * 8));
 
-    if(!furi_hal_crypto_process_block_bswap((uint8_t*)&last_block[0], tag, CRYPTO_BLK_LEN)) {
+    if(!furi_hal_crypto_process_block_bytes((uint8_t*)&last_block[0], tag, CRYPTO_BLK_LEN)) {
         CLEAR_BIT(AES1->CR, AES_CR_EN);
         return false;
     }
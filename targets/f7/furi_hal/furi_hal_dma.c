@@ -1,6 +1,19 @@
 #include <furi_hal_dma.h>
 #include <furi_hal_bus.h>
 
+#include <furi.h>
+
+#define FURI_HAL_DMA_CHANNEL_COUNT (7U)
+
+static uint32_t furi_hal_dma_channel_owned = 0;
+
+static uint32_t furi_hal_dma_channel_get_mask(DMA_TypeDef* dma, uint32_t channel) {
+    furi_check(dma == DMA1 || dma == DMA2);
+    furi_check(channel < FURI_HAL_DMA_CHANNEL_COUNT);
+
+    return 1UL << ((dma == DMA2 ? FURI_HAL_DMA_CHANNEL_COUNT : 0U) + channel);
+}
+
 void furi_hal_dma_init_early(void) {
     furi_hal_bus_enable(FuriHalBusDMA1);
     furi_hal_bus_enable(FuriHalBusDMA2);
@@ -12,3 +25,26 @@ void furi_hal_dma_deinit_early(void) {
     furi_hal_bus_disable(FuriHalBusDMA2);
     furi_hal_bus_disable(FuriHalBusDMAMUX1);
 }
+
+bool furi_hal_dma_channel_acquire(DMA_TypeDef* dma, uint32_t channel) {
+    const uint32_t mask = furi_hal_dma_channel_get_mask(dma, channel);
+    bool acquired = false;
+
+    FURI_CRITICAL_ENTER();
+    if(!(furi_hal_dma_channel_owned & mask)) {
+        furi_hal_dma_channel_owned |= mask;
+        acquired = true;
+    }
+    FURI_CRITICAL_EXIT();
+
+    return acquired;
+}
+
+void furi_hal_dma_channel_release(DMA_TypeDef* dma, uint32_t channel) {
+    const uint32_t mask = furi_hal_dma_channel_get_mask(dma, channel);
+
+    FURI_CRITICAL_ENTER();
+    furi_check(furi_hal_dma_channel_owned & mask);
+    furi_hal_dma_channel_owned &= ~mask;
+    FURI_CRITICAL_EXIT();
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <stm32wbxx.h>
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -10,6 +13,27 @@ void furi_hal_dma_init_early(void);
 /** Early de-initialization */
 void furi_hal_dma_deinit_early(void);
 
+/** Take ownership of DMA channel
+ *
+ * Some channels are shared by several drivers, a driver must own the channel
+ * for as long as it is configured. Can be called from ISR.
+ *
+ * @param      dma      DMA1 or DMA2
+ * @param      channel  LL_DMA_CHANNEL_1 .. LL_DMA_CHANNEL_7
+ *
+ * @return     true if channel was free and is owned by the caller now
+ */
+bool furi_hal_dma_channel_acquire(DMA_TypeDef* dma, uint32_t channel);
+
+/** Release DMA channel taken with furi_hal_dma_channel_acquire
+ *
+ * Can be called from ISR.
+ *
+ * @param      dma      DMA1 or DMA2
+ * @param      channel  LL_DMA_CHANNEL_1 .. LL_DMA_CHANNEL_7
+ */
+void furi_hal_dma_channel_release(DMA_TypeDef* dma, uint32_t channel);
+
 #ifdef __cplusplus
 }
 #endif
@@ -291,7 +291,7 @@ void EXTI4_IRQHandler(void) {
     }
 }
 
-void EXTI9_5_IRQHandler(void) {
+FURI_RAMFUNC void EXTI9_5_IRQHandler(void) {
     if(LL_EXTI_IsActiveFlag_0_31(LL_EXTI_LINE_5)) {
         furi_hal_gpio_int_call(5);
         LL_EXTI_ClearFlag_0_31(LL_EXTI_LINE_5);
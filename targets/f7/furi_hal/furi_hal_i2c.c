@@ -9,6 +9,18 @@
 
 #define TAG "FuriHalI2c"
 
+/* Longest time release waits for queued asynchronous transfers, ms */
+#define FURI_HAL_I2C_RELEASE_TIMEOUT 100
+
+#define FURI_HAL_I2C_MAX_CHUNK 255
+
+typedef struct {
+    FuriSemaphore* done;
+    bool success;
+} FuriHalI2cTransferSync;
+
+static void furi_hal_i2c_async_abort(FuriHalI2cBus* bus);
+
 void furi_hal_i2c_init_early(void) {
     furi_hal_i2c_bus_power.callback(&furi_hal_i2c_bus_power, FuriHalI2cBusEventInit);
 }
@@ -39,6 +51,10 @@ void furi_hal_i2c_acquire(FuriHalI2cBusHandle* handle) {
 void furi_hal_i2c_release(FuriHalI2cBusHandle* handle) {
     // Ensure that current handle is our handle
     furi_check(handle->bus->current_handle == handle);
+    // Finish asynchronous transfers while the bus is still powered
+    if(handle->bus->isr_set) {
+        furi_hal_i2c_async_abort(handle->bus);
+    }
     // Deactivate handle
     handle->callback(handle, FuriHalI2cBusHandleEventDeactivate);
     // Deactivate bus
@@ -113,7 +129,7 @@ static bool furi_hal_i2c_transfer_is_aborted(I2C_TypeDef* i2c) {
            !(LL_I2C_IsActiveFlag_TC(i2c) || LL_I2C_IsActiveFlag_TCR(i2c));
 }
 
-static bool furi_hal_i2c_transfer(
+static bool furi_hal_i2c_transfer_bytes(
     I2C_TypeDef* i2c,
     uint8_t* data,
     uint32_t size,
@@ -183,7 +199,7 @@ static bool furi_hal_i2c_transaction(
 
         LL_I2C_HandleTransfer(i2c, address, addr_size, transfer_size, end_signal, start_signal);
 
-        if(!furi_hal_i2c_transfer(i2c, data, transfer_size, transfer_end, read, timer)) {
+        if(!furi_hal_i2c_transfer_bytes(i2c, data, transfer_size, transfer_end, read, timer)) {
             return false;
         }
 
@@ -195,6 +211,310 @@ static bool furi_hal_i2c_transaction(
     return true;
 }
 
+static void furi_hal_i2c_async_load(FuriHalI2cBus* bus, uint32_t start_signal) {
+    I2C_TypeDef* i2c = bus->i2c;
+    const FuriHalI2cTransfer* transfer = bus->queue_head;
+    const bool read = bus->transfer_read;
+    const size_t left = (read ? transfer->rx_size : transfer->tx_size) - bus->transfer_index;
+
+    uint32_t chunk = left;
+    FuriHalI2cEnd end = FuriHalI2cEndStop;
+    if(left > FURI_HAL_I2C_MAX_CHUNK) {
+        chunk = FURI_HAL_I2C_MAX_CHUNK;
+        end = FuriHalI2cEndPause;
+    } else if(!read && transfer->rx_size > 0) {
+        end = FuriHalI2cEndAwaitRestart;
+    }
+
+    if(read) {
+        LL_I2C_DisableIT_TX(i2c);
+        LL_I2C_EnableIT_RX(i2c);
+    } else {
+        LL_I2C_DisableIT_RX(i2c);
+        LL_I2C_EnableIT_TX(i2c);
+    }
+
+    LL_I2C_HandleTransfer(
+        i2c,
+        transfer->address,
+        transfer->ten_bit ? LL_I2C_ADDRSLAVE_10BIT : LL_I2C_ADDRSLAVE_7BIT,
+        chunk,
+        furi_hal_i2c_get_end_signal(end),
+        start_signal);
+}
+
+static void furi_hal_i2c_async_start(FuriHalI2cBus* bus) {
+    I2C_TypeDef* i2c = bus->i2c;
+    const FuriHalI2cTransfer* transfer = bus->queue_head;
+
+    bus->transfer_index = 0;
+    bus->transfer_failed = false;
+    bus->transfer_read = transfer->tx_size == 0 && transfer->rx_size > 0;
+
+    LL_I2C_ClearFlag_STOP(i2c);
+    LL_I2C_ClearFlag_NACK(i2c);
+    LL_I2C_EnableIT_TC(i2c);
+    LL_I2C_EnableIT_STOP(i2c);
+    LL_I2C_EnableIT_NACK(i2c);
+    LL_I2C_EnableIT_ERR(i2c);
+
+    furi_hal_i2c_async_load(
+        bus,
+        furi_hal_i2c_get_start_signal(
+            FuriHalI2cBeginStart, transfer->ten_bit, bus->transfer_read));
+}
+
+static void furi_hal_i2c_async_disable_it(I2C_TypeDef* i2c) {
+    LL_I2C_DisableIT_TX(i2c);
+    LL_I2C_DisableIT_RX(i2c);
+    LL_I2C_DisableIT_TC(i2c);
+    LL_I2C_DisableIT_STOP(i2c);
+    LL_I2C_DisableIT_NACK(i2c);
+    LL_I2C_DisableIT_ERR(i2c);
+}
+
+static void furi_hal_i2c_async_reset(I2C_TypeDef* i2c) {
+    // Clearing PE resets the state machine, it must stay low for 3 APB cycles
+    LL_I2C_Disable(i2c);
+    while(LL_I2C_IsEnabled(i2c))
+        ;
+    __NOP();
+    __NOP();
+    __NOP();
+    LL_I2C_Enable(i2c);
+}
+
+// Caller holds the bus: in interrupt or in critical section
+static void furi_hal_i2c_async_complete(FuriHalI2cBus* bus, bool success) {
+    FuriHalI2cTransfer* transfer = bus->queue_head;
+
+    bus->queue_head = transfer->next;
+    if(bus->queue_head == NULL) bus->queue_tail = NULL;
+    transfer->next = NULL;
+
+    furi_hal_i2c_async_disable_it(bus->i2c);
+    // Next transfer goes first, callback may queue more
+    if(bus->queue_head) furi_hal_i2c_async_start(bus);
+
+    if(transfer->callback) transfer->callback(success, transfer->context);
+}
+
+static void furi_hal_i2c_async_isr(void* context) {
+    FuriHalI2cBus* bus = context;
+    I2C_TypeDef* i2c = bus->i2c;
+    const FuriHalI2cTransfer* transfer = bus->queue_head;
+    const uint32_t isr = i2c->ISR;
+
+    if(transfer == NULL) {
+        furi_hal_i2c_async_disable_it(i2c);
+        return;
+    }
+
+    if(isr & (I2C_ISR_BERR | I2C_ISR_ARLO | I2C_ISR_OVR)) {
+        LL_I2C_ClearFlag_BERR(i2c);
+        LL_I2C_ClearFlag_ARLO(i2c);
+        LL_I2C_ClearFlag_OVR(i2c);
+        furi_hal_i2c_async_reset(i2c);
+        furi_hal_i2c_async_complete(bus, false);
+        return;
+    }
+
+    if(isr & I2C_ISR_NACKF) {
+        // STOP condition follows automatically, transfer ends on it
+        LL_I2C_ClearFlag_NACK(i2c);
+        bus->transfer_failed = true;
+    }
+
+    const size_t size = bus->transfer_read ? transfer->rx_size : transfer->tx_size;
+    if(bus->transfer_read && (isr & I2C_ISR_RXNE)) {
+        const uint8_t data = LL_I2C_ReceiveData8(i2c);
+        if(bus->transfer_index < size) transfer->rx_data[bus->transfer_index++] = data;
+    } else if(!bus->transfer_read && (isr & I2C_ISR_TXIS)) {
+        LL_I2C_TransmitData8(
+            i2c, bus->transfer_index < size ? transfer->tx_data[bus->transfer_index++] : 0);
+    }
+
+    if(isr & I2C_ISR_TCR) {
+        furi_hal_i2c_async_load(bus, LL_I2C_GENERATE_NOSTARTSTOP);
+    } else if((isr & I2C_ISR_TC) && !bus->transfer_read) {
+        // Write part is over, bus is held by clock stretching until RESTART
+        bus->transfer_read = true;
+        bus->transfer_index = 0;
+        furi_hal_i2c_async_load(
+            bus, furi_hal_i2c_get_start_signal(FuriHalI2cBeginRestart, transfer->ten_bit, true));
+    }
+
+    if(isr & I2C_ISR_STOPF) {
+        LL_I2C_ClearFlag_STOP(i2c);
+        const bool success = !bus->transfer_failed && bus->transfer_index == size &&
+                             (bus->transfer_read || transfer->rx_size == 0);
+        furi_hal_i2c_async_complete(bus, success);
+    }
+}
+
+void furi_hal_i2c_transfer_async(FuriHalI2cBusHandle* handle, FuriHalI2cTransfer* transfer) {
+    furi_check(handle);
+    furi_check(transfer);
+    furi_check(transfer->tx_size == 0 || transfer->tx_data);
+    furi_check(transfer->rx_size == 0 || transfer->rx_data);
+
+    FuriHalI2cBus* bus = handle->bus;
+    furi_check(bus->current_handle == handle);
+
+    // Interrupts are claimed on first use and given back on release
+    if(!bus->isr_set) {
+        furi_check(!FURI_IS_IRQ_MODE());
+        furi_hal_interrupt_set_isr(bus->event_irq, furi_hal_i2c_async_isr, bus);
+        furi_hal_interrupt_set_isr(bus->error_irq, furi_hal_i2c_async_isr, bus);
+        bus->isr_set = true;
+    }
+
+    transfer->next = NULL;
+
+    FURI_CRITICAL_ENTER();
+    if(bus->queue_tail) {
+        bus->queue_tail->next = transfer;
+        bus->queue_tail = transfer;
+    } else {
+        bus->queue_head = transfer;
+        bus->queue_tail = transfer;
+        furi_hal_i2c_async_start(bus);
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+// Removes transfer from the queue, false if it is already completed
+static bool furi_hal_i2c_async_cancel(FuriHalI2cBus* bus, FuriHalI2cTransfer* transfer) {
+    bool found = false;
+
+    FURI_CRITICAL_ENTER();
+    if(bus->queue_head == transfer) {
+        furi_hal_i2c_async_disable_it(bus->i2c);
+        furi_hal_i2c_async_reset(bus->i2c);
+        transfer->callback = NULL;
+        furi_hal_i2c_async_complete(bus, false);
+        found = true;
+    } else {
+        for(FuriHalI2cTransfer* item = bus->queue_head; item; item = item->next) {
+            if(item->next != transfer) continue;
+            item->next = transfer->next;
+            if(bus->queue_tail == transfer) bus->queue_tail = item;
+            transfer->next = NULL;
+            found = true;
+            break;
+        }
+    }
+    FURI_CRITICAL_EXIT();
+
+    return found;
+}
+
+static void furi_hal_i2c_async_abort(FuriHalI2cBus* bus) {
+    const uint32_t start = furi_get_tick();
+    while(bus->queue_head &&
+          furi_get_tick() - start < furi_ms_to_ticks(FURI_HAL_I2C_RELEASE_TIMEOUT)) {
+        furi_delay_tick(1);
+    }
+
+    FURI_CRITICAL_ENTER();
+    if(bus->queue_head) {
+        FURI_LOG_W(TAG, "Aborting transfers");
+        furi_hal_i2c_async_disable_it(bus->i2c);
+        furi_hal_i2c_async_reset(bus->i2c);
+        while(bus->queue_head) {
+            FuriHalI2cTransfer* transfer = bus->queue_head;
+            bus->queue_head = transfer->next;
+            transfer->next = NULL;
+            if(transfer->callback) transfer->callback(false, transfer->context);
+        }
+        bus->queue_tail = NULL;
+    }
+    FURI_CRITICAL_EXIT();
+
+    furi_hal_interrupt_set_isr(bus->event_irq, NULL, NULL);
+    furi_hal_interrupt_set_isr(bus->error_irq, NULL, NULL);
+    bus->isr_set = false;
+}
+
+static void furi_hal_i2c_transfer_sync_callback(bool success, void* context) {
+    FuriHalI2cTransferSync* sync = context;
+    sync->success = success;
+    furi_semaphore_release(sync->done);
+}
+
+static bool furi_hal_i2c_transfer_poll(
+    FuriHalI2cBusHandle* handle,
+    FuriHalI2cTransfer* transfer,
+    uint32_t timeout) {
+    FuriHalCortexTimer timer = furi_hal_cortex_timer_get(timeout * 1000);
+    I2C_TypeDef* i2c = handle->bus->i2c;
+
+    if(transfer->tx_size > 0 || transfer->rx_size == 0) {
+        const FuriHalI2cEnd end =
+            transfer->rx_size > 0 ? FuriHalI2cEndAwaitRestart : FuriHalI2cEndStop;
+        if(!furi_hal_i2c_transaction(
+               i2c,
+               transfer->address,
+               transfer->ten_bit,
+               (uint8_t*)transfer->tx_data,
+               transfer->tx_size,
+               FuriHalI2cBeginStart,
+               end,
+               false,
+               timer)) {
+            return false;
+        }
+    }
+
+    if(transfer->rx_size > 0) {
+        const FuriHalI2cBegin begin =
+            transfer->tx_size > 0 ? FuriHalI2cBeginRestart : FuriHalI2cBeginStart;
+        return furi_hal_i2c_transaction(
+            i2c,
+            transfer->address,
+            transfer->ten_bit,
+            transfer->rx_data,
+            transfer->rx_size,
+            begin,
+            FuriHalI2cEndStop,
+            true,
+            timer);
+    }
+
+    return true;
+}
+
+bool furi_hal_i2c_transfer(
+    FuriHalI2cBusHandle* handle,
+    FuriHalI2cTransfer* transfer,
+    uint32_t timeout) {
+    furi_check(handle);
+    furi_check(transfer);
+    furi_check(handle->bus->current_handle == handle);
+    furi_check(timeout > 0);
+
+    if(!furi_kernel_is_running() || furi_kernel_is_irq_or_masked()) {
+        return furi_hal_i2c_transfer_poll(handle, transfer, timeout);
+    }
+
+    FuriHalI2cBus* bus = handle->bus;
+    FuriHalI2cTransferSync sync = {.done = bus->transfer_done, .success = false};
+    transfer->callback = furi_hal_i2c_transfer_sync_callback;
+    transfer->context = &sync;
+
+    furi_hal_i2c_transfer_async(handle, transfer);
+
+    if(furi_semaphore_acquire(sync.done, timeout) != FuriStatusOk) {
+        if(furi_hal_i2c_async_cancel(bus, transfer)) {
+            return false;
+        }
+        // Completed right after the timeout
+        furi_check(furi_semaphore_acquire(sync.done, 0) == FuriStatusOk);
+    }
+
+    return sync.success;
+}
+
 bool furi_hal_i2c_rx_ext(
     FuriHalI2cBusHandle* handle,
     uint16_t address,
@@ -237,8 +557,13 @@ bool furi_hal_i2c_tx(
     uint32_t timeout) {
     furi_check(timeout > 0);
 
-    return furi_hal_i2c_tx_ext(
-        handle, address, false, data, size, FuriHalI2cBeginStart, FuriHalI2cEndStop, timeout);
+    FuriHalI2cTransfer transfer = {
+        .address = address,
+        .tx_data = data,
+        .tx_size = size,
+    };
+
+    return furi_hal_i2c_transfer(handle, &transfer, timeout);
 }
 
 bool furi_hal_i2c_rx(
@@ -249,8 +574,13 @@ bool furi_hal_i2c_rx(
     uint32_t timeout) {
     furi_check(timeout > 0);
 
-    return furi_hal_i2c_rx_ext(
-        handle, address, false, data, size, FuriHalI2cBeginStart, FuriHalI2cEndStop, timeout);
+    FuriHalI2cTransfer transfer = {
+        .address = address,
+        .rx_data = data,
+        .rx_size = size,
+    };
+
+    return furi_hal_i2c_transfer(handle, &transfer, timeout);
 }
 
 bool furi_hal_i2c_trx(
@@ -261,24 +591,9 @@ bool furi_hal_i2c_trx(
     uint8_t* rx_data,
     size_t rx_size,
     uint32_t timeout) {
-    return furi_hal_i2c_tx_ext(
-               handle,
-               address,
-               false,
-               tx_data,
-               tx_size,
-               FuriHalI2cBeginStart,
-               FuriHalI2cEndStop,
-               timeout) &&
-           furi_hal_i2c_rx_ext(
-               handle,
-               address,
-               false,
-               rx_data,
-               rx_size,
-               FuriHalI2cBeginStart,
-               FuriHalI2cEndStop,
-               timeout);
+    // STOP between the parts, as before asynchronous transfers were added
+    return furi_hal_i2c_tx(handle, address, tx_data, tx_size, timeout) &&
+           furi_hal_i2c_rx(handle, address, rx_data, rx_size, timeout);
 }
 
 bool furi_hal_i2c_is_device_ready(FuriHalI2cBusHandle* handle, uint8_t i2c_addr, uint32_t timeout) {
@@ -22,8 +22,10 @@ FuriMutex* furi_hal_i2c_bus_power_mutex = NULL;
 static void furi_hal_i2c_bus_power_event(FuriHalI2cBus* bus, FuriHalI2cBusEvent event) {
     if(event == FuriHalI2cBusEventInit) {
         furi_hal_i2c_bus_power_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+        bus->transfer_done = furi_semaphore_alloc(1, 0);
         bus->current_handle = NULL;
     } else if(event == FuriHalI2cBusEventDeinit) {
+        furi_semaphore_free(bus->transfer_done);
         furi_mutex_free(furi_hal_i2c_bus_power_mutex);
     } else if(event == FuriHalI2cBusEventLock) {
         furi_check(
@@ -43,6 +45,8 @@ static void furi_hal_i2c_bus_power_event(FuriHalI2cBus* bus, FuriHalI2cBusEvent
 FuriHalI2cBus furi_hal_i2c_bus_power = {
     .i2c = I2C1,
     .callback = furi_hal_i2c_bus_power_event,
+    .event_irq = FuriHalInterruptIdI2c1Ev,
+    .error_irq = FuriHalInterruptIdI2c1Er,
 };
 
 FuriMutex* furi_hal_i2c_bus_external_mutex = NULL;
@@ -50,8 +54,10 @@ FuriMutex* furi_hal_i2c_bus_external_mutex = NULL;
 static void furi_hal_i2c_bus_external_event(FuriHalI2cBus* bus, FuriHalI2cBusEvent event) {
     if(event == FuriHalI2cBusEventInit) {
         furi_hal_i2c_bus_external_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+        bus->transfer_done = furi_semaphore_alloc(1, 0);
         bus->current_handle = NULL;
     } else if(event == FuriHalI2cBusEventDeinit) {
+        furi_semaphore_free(bus->transfer_done);
         furi_mutex_free(furi_hal_i2c_bus_external_mutex);
     } else if(event == FuriHalI2cBusEventLock) {
         furi_check(
@@ -71,6 +77,8 @@ static void furi_hal_i2c_bus_external_event(FuriHalI2cBus* bus, FuriHalI2cBusEve
 FuriHalI2cBus furi_hal_i2c_bus_external = {
     .i2c = I2C3,
     .callback = furi_hal_i2c_bus_external_event,
+    .event_irq = FuriHalInterruptIdI2c3Ev,
+    .error_irq = FuriHalInterruptIdI2c3Er,
 };
 
 void furi_hal_i2c_bus_handle_power_event(
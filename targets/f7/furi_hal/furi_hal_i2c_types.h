@@ -1,5 +1,8 @@
 #pragma once
 
+#include <furi.h>
+#include <furi_hal_interrupt.h>
+
 #include <stm32wbxx_ll_i2c.h>
 
 #ifdef __cplusplus
@@ -8,6 +11,7 @@ extern "C" {
 
 typedef struct FuriHalI2cBus FuriHalI2cBus;
 typedef struct FuriHalI2cBusHandle FuriHalI2cBusHandle;
+typedef struct FuriHalI2cTransfer FuriHalI2cTransfer;
 
 /** FuriHal i2c bus states */
 typedef enum {
@@ -27,6 +31,17 @@ struct FuriHalI2cBus {
     I2C_TypeDef* i2c;
     FuriHalI2cBusHandle* current_handle;
     FuriHalI2cBusEventCallback callback;
+    FuriHalInterruptId event_irq;
+    FuriHalInterruptId error_irq;
+
+    // Asynchronous transfers, head of the queue is on the wire
+    FuriHalI2cTransfer* queue_head;
+    FuriHalI2cTransfer* queue_tail;
+    FuriSemaphore* transfer_done;
+    size_t transfer_index;
+    bool transfer_read;
+    bool transfer_failed;
+    bool isr_set;
 };
 
 /** FuriHal i2c handle states */
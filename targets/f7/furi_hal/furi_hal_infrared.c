@@ -11,6 +11,8 @@
 #include <math.h>
 
 #define INFRARED_TIM_TX_DMA_BUFFER_SIZE 200
+#define INFRARED_TIM_RX_DMA_BUFFER_SIZE 256 /* (period, space) pairs */
+#define INFRARED_TIM_RX_DMA_BATCH_SIZE  32
 #define INFRARED_POLARITY_SHIFT         1
 
 #define INFRARED_TX_CCMR_HIGH \
@@ -42,6 +44,10 @@ typedef struct {
     void* capture_context;
     FuriHalInfraredRxTimeoutCallback timeout_callback;
     void* timeout_context;
+    FuriHalInfraredRxCaptureBatchCallback capture_batch_callback;
+    void* capture_batch_context;
+    uint32_t* dma_buffer; /** DMA capture ring, NULL in per edge mode */
+    size_t dma_read;
 } InfraredTimRx;
 
 typedef struct {
@@ -96,6 +102,84 @@ static uint8_t furi_hal_infrared_get_current_dma_tx_buffer(void);
 static void furi_hal_infrared_tx_dma_polarity_isr(void*);
 static void furi_hal_infrared_tx_dma_isr(void*);
 
+/* Pass every complete (period, space) pair written by DMA to the batch callback */
+static void furi_hal_infrared_rx_dma_drain(void) {
+    const size_t size = INFRARED_TIM_RX_DMA_BUFFER_SIZE * 2;
+    /* Whole pairs only, a burst may be half way through */
+    const size_t write = ((size - LL_DMA_GetDataLength(INFRARED_DMA_CH1_DEF)) & ~1U) % size;
+
+    LevelDuration pulses[INFRARED_TIM_RX_DMA_BATCH_SIZE];
+    size_t count = 0;
+
+    while(infrared_tim_rx.dma_read != write) {
+        const uint32_t period = infrared_tim_rx.dma_buffer[infrared_tim_rx.dma_read];
+        const uint32_t space = infrared_tim_rx.dma_buffer[infrared_tim_rx.dma_read + 1];
+        infrared_tim_rx.dma_read = (infrared_tim_rx.dma_read + 2) % size;
+
+        /* High pin level is a Space, low is a Mark: levels are inverted */
+        if(space) pulses[count++] = level_duration_make(false, space);
+        if(period > space) pulses[count++] = level_duration_make(true, period - space);
+
+        if(count >= INFRARED_TIM_RX_DMA_BATCH_SIZE - 1) {
+            if(infrared_tim_rx.capture_batch_callback)
+                infrared_tim_rx.capture_batch_callback(
+                    infrared_tim_rx.capture_batch_context, pulses, count);
+            count = 0;
+        }
+    }
+
+    if(count && infrared_tim_rx.capture_batch_callback) {
+        infrared_tim_rx.capture_batch_callback(
+            infrared_tim_rx.capture_batch_context, pulses, count);
+    }
+}
+
+static void furi_hal_infrared_rx_dma_isr(void* context) {
+    UNUSED(context);
+
+#if INFRARED_DMA_CH1_CHANNEL == LL_DMA_CHANNEL_1
+    if(LL_DMA_IsActiveFlag_HT1(INFRARED_DMA)) {
+        LL_DMA_ClearFlag_HT1(INFRARED_DMA);
+    }
+    if(LL_DMA_IsActiveFlag_TC1(INFRARED_DMA)) {
+        LL_DMA_ClearFlag_TC1(INFRARED_DMA);
+    }
+#else
+#error Update this code. Would you kindly?
+#endif
+
+    furi_hal_infrared_rx_dma_drain();
+}
+
+static void furi_hal_infrared_rx_dma_start(void) {
+    infrared_tim_rx.dma_buffer = malloc(INFRARED_TIM_RX_DMA_BUFFER_SIZE * 2 * sizeof(uint32_t));
+    infrared_tim_rx.dma_read = 0;
+
+    /* Every rising edge reads CCR1 (period) and CCR2 (space) in one burst */
+    LL_TIM_ConfigDMABurst(
+        INFRARED_RX_TIMER, LL_TIM_DMABURST_BASEADDR_CCR1, LL_TIM_DMABURST_LENGTH_2TRANSFERS);
+    LL_TIM_EnableDMAReq_CC1(INFRARED_RX_TIMER);
+
+    LL_DMA_InitTypeDef dma_config = {0};
+    dma_config.PeriphOrM2MSrcAddress = (uint32_t) & (INFRARED_RX_TIMER->DMAR);
+    dma_config.MemoryOrM2MDstAddress = (uint32_t)infrared_tim_rx.dma_buffer;
+    dma_config.Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
+    dma_config.Mode = LL_DMA_MODE_CIRCULAR;
+    dma_config.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    dma_config.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    dma_config.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_WORD;
+    dma_config.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_WORD;
+    dma_config.NbData = INFRARED_TIM_RX_DMA_BUFFER_SIZE * 2;
+    dma_config.PeriphRequest = LL_DMAMUX_REQ_TIM2_CH1;
+    dma_config.Priority = LL_DMA_PRIORITY_VERYHIGH;
+    LL_DMA_Init(INFRARED_DMA_CH1_DEF, &dma_config);
+
+    furi_hal_interrupt_set_isr(INFRARED_DMA_CH1_IRQ, furi_hal_infrared_rx_dma_isr, NULL);
+    LL_DMA_EnableIT_TC(INFRARED_DMA_CH1_DEF);
+    LL_DMA_EnableIT_HT(INFRARED_DMA_CH1_DEF);
+    LL_DMA_EnableChannel(INFRARED_DMA_CH1_DEF);
+}
+
 static void furi_hal_infrared_tim_rx_isr(void* context) {
     UNUSED(context);
 
@@ -113,11 +197,16 @@ static void furi_hal_infrared_tim_rx_isr(void* context) {
          * receiving new signal few microseconds ago, because CNT register
          * is reseted once per period, not per sample. */
         if(LL_GPIO_IsInputPinSet(gpio_infrared_rx.port, gpio_infrared_rx.pin) != 0) {
+            /* Edges still in the DMA ring go before the timeout */
+            if(infrared_tim_rx.dma_buffer) furi_hal_infrared_rx_dma_drain();
             if(infrared_tim_rx.timeout_callback)
                 infrared_tim_rx.timeout_callback(infrared_tim_rx.timeout_context);
         }
     }
 
+    /* Edges are read by DMA in batch mode */
+    if(infrared_tim_rx.dma_buffer) return;
+
     /* Rising Edge */
     if(LL_TIM_IsActiveFlag_CC1(INFRARED_RX_TIMER)) {
         LL_TIM_ClearFlag_CC1(INFRARED_RX_TIMER);
@@ -190,8 +279,12 @@ void furi_hal_infrared_async_rx_start(void) {
     furi_hal_interrupt_set_isr(INFRARED_RX_IRQ, furi_hal_infrared_tim_rx_isr, NULL);
     furi_hal_infrared_state = InfraredStateAsyncRx;
 
-    LL_TIM_EnableIT_CC1(INFRARED_RX_TIMER);
-    LL_TIM_EnableIT_CC2(INFRARED_RX_TIMER);
+    if(infrared_tim_rx.capture_batch_callback) {
+        furi_hal_infrared_rx_dma_start();
+    } else {
+        LL_TIM_EnableIT_CC1(INFRARED_RX_TIMER);
+        LL_TIM_EnableIT_CC2(INFRARED_RX_TIMER);
+    }
     LL_TIM_CC_EnableChannel(INFRARED_RX_TIMER, LL_TIM_CHANNEL_CH1);
     LL_TIM_CC_EnableChannel(INFRARED_RX_TIMER, LL_TIM_CHANNEL_CH2);
 
@@ -205,8 +298,15 @@ void furi_hal_infrared_async_rx_stop(void) {
     FURI_CRITICAL_ENTER();
     furi_hal_bus_disable(INFRARED_RX_TIMER_BUS);
     furi_hal_interrupt_set_isr(INFRARED_RX_IRQ, NULL, NULL);
+    if(infrared_tim_rx.dma_buffer) {
+        LL_DMA_DeInit(INFRARED_DMA_CH1_DEF);
+        furi_hal_interrupt_set_isr(INFRARED_DMA_CH1_IRQ, NULL, NULL);
+    }
     furi_hal_infrared_state = InfraredStateIdle;
     FURI_CRITICAL_EXIT();
+
+    free(infrared_tim_rx.dma_buffer);
+    infrared_tim_rx.dma_buffer = NULL;
 }
 
 void furi_hal_infrared_async_rx_set_timeout(uint32_t timeout_us) {
@@ -227,6 +327,13 @@ void furi_hal_infrared_async_rx_set_capture_isr_callback(
     infrared_tim_rx.capture_context = ctx;
 }
 
+void furi_hal_infrared_async_rx_set_capture_batch_isr_callback(
+    FuriHalInfraredRxCaptureBatchCallback callback,
+    void* ctx) {
+    infrared_tim_rx.capture_batch_callback = callback;
+    infrared_tim_rx.capture_batch_context = ctx;
+}
+
 void furi_hal_infrared_async_rx_set_timeout_isr_callback(
     FuriHalInfraredRxTimeoutCallback callback,
     void* ctx) {
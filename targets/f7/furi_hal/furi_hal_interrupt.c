@@ -16,11 +16,17 @@
 #ifdef FURI_RAM_EXEC
 #define FURI_HAL_INTERRUPT_ACCOUNT_START()
 #define FURI_HAL_INTERRUPT_ACCOUNT_END()
+#define FURI_HAL_INTERRUPT_ACCOUNT_ID(index)
 #else
-#define FURI_HAL_INTERRUPT_ACCOUNT_START() const uint32_t _isr_start = DWT->CYCCNT;
-#define FURI_HAL_INTERRUPT_ACCOUNT_END()                    \
-    const uint32_t _time_in_isr = DWT->CYCCNT - _isr_start; \
-    furi_hal_interrupt.counter_time_in_isr_total += _time_in_isr;
+#define FURI_HAL_INTERRUPT_ACCOUNT_START()   \
+    const uint32_t _isr_start = DWT->CYCCNT; \
+    furi_hal_interrupt.depth++;
+#define FURI_HAL_INTERRUPT_ACCOUNT_END()                          \
+    const uint32_t _time_in_isr = DWT->CYCCNT - _isr_start;       \
+    furi_hal_interrupt.counter_time_in_isr_total += _time_in_isr; \
+    furi_hal_interrupt.depth--;
+#define FURI_HAL_INTERRUPT_ACCOUNT_ID(index)                     \
+    furi_hal_interrupt_account(index, _isr_start, _time_in_isr);
 #endif
 
 typedef struct {
@@ -30,11 +36,22 @@ typedef struct {
 
 typedef struct {
     FuriHalInterruptISRPair isr[FuriHalInterruptIdMax];
+    FuriHalInterruptStats stats[FuriHalInterruptStatsIdMax];
     uint32_t counter_time_in_isr_total;
+    // Accounted interrupts currently running
+    volatile uint32_t depth;
 } FuriHalIterrupt;
 
 static FuriHalIterrupt furi_hal_interrupt = {};
 
+static const IRQn_Type furi_hal_interrupt_stats_irqn[] = {
+    [FuriHalInterruptStatsIdSysTick - FuriHalInterruptIdMax] = SysTick_IRQn,
+    [FuriHalInterruptStatsIdUsbLp - FuriHalInterruptIdMax] = USB_LP_IRQn,
+    [FuriHalInterruptStatsIdUsbHp - FuriHalInterruptIdMax] = USB_HP_IRQn,
+    [FuriHalInterruptStatsIdIpccTx - FuriHalInterruptIdMax] = IPCC_C1_TX_IRQn,
+    [FuriHalInterruptStatsIdIpccRx - FuriHalInterruptIdMax] = IPCC_C1_RX_IRQn,
+};
+
 const IRQn_Type furi_hal_interrupt_irqn[FuriHalInterruptIdMax] = {
     // TIM1, TIM16, TIM17
     [FuriHalInterruptIdTim1TrgComTim17] = TIM1_TRG_COM_TIM17_IRQn,
@@ -83,8 +100,24 @@ const IRQn_Type furi_hal_interrupt_irqn[FuriHalInterruptIdMax] = {
 
     // LPUARTx
     [FuriHalInterruptIdLpUart1] = LPUART1_IRQn,
+
+    // I2Cx
+    [FuriHalInterruptIdI2c1Ev] = I2C1_EV_IRQn,
+    [FuriHalInterruptIdI2c1Er] = I2C1_ER_IRQn,
+    [FuriHalInterruptIdI2c3Ev] = I2C3_EV_IRQn,
+    [FuriHalInterruptIdI2c3Er] = I2C3_ER_IRQn,
 };
 
+FURI_ALWAYS_INLINE static void
+    furi_hal_interrupt_account(uint32_t index, uint32_t start, uint32_t time) {
+    FuriHalInterruptStats* stats = &furi_hal_interrupt.stats[index];
+    stats->time += time;
+    stats->count++;
+    stats->last = start;
+    if(time > stats->max) stats->max = time;
+    if(furi_hal_interrupt.depth) stats->nested++;
+}
+
 FURI_ALWAYS_INLINE static void furi_hal_interrupt_call(FuriHalInterruptId index) {
     const FuriHalInterruptISRPair* isr_descr = &furi_hal_interrupt.isr[index];
     furi_check(isr_descr->isr);
@@ -92,6 +125,7 @@ FURI_ALWAYS_INLINE static void furi_hal_interrupt_call(FuriHalInterruptId index)
     FURI_HAL_INTERRUPT_ACCOUNT_START();
     isr_descr->isr(isr_descr->context);
     FURI_HAL_INTERRUPT_ACCOUNT_END();
+    FURI_HAL_INTERRUPT_ACCOUNT_ID(index);
 }
 
 FURI_ALWAYS_INLINE static void
@@ -184,12 +218,12 @@ void furi_hal_interrupt_set_isr_ex(
 }
 
 /* Timer 2 */
-void TIM2_IRQHandler(void) {
+FURI_RAMFUNC void TIM2_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdTIM2);
 }
 
 /* Timer 1 Update */
-void TIM1_UP_TIM16_IRQHandler(void) {
+FURI_RAMFUNC void TIM1_UP_TIM16_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdTim1UpTim16);
 }
 
@@ -202,60 +236,60 @@ void TIM1_CC_IRQHandler(void) {
 }
 
 /* DMA 1 */
-void DMA1_Channel1_IRQHandler(void) {
+FURI_RAMFUNC void DMA1_Channel1_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma1Ch1);
 }
 
-void DMA1_Channel2_IRQHandler(void) {
+FURI_RAMFUNC void DMA1_Channel2_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma1Ch2);
 }
 
-void DMA1_Channel3_IRQHandler(void) {
+FURI_RAMFUNC void DMA1_Channel3_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma1Ch3);
 }
 
-void DMA1_Channel4_IRQHandler(void) {
+FURI_RAMFUNC void DMA1_Channel4_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma1Ch4);
 }
 
-void DMA1_Channel5_IRQHandler(void) {
+FURI_RAMFUNC void DMA1_Channel5_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma1Ch5);
 }
 
-void DMA1_Channel6_IRQHandler(void) {
+FURI_RAMFUNC void DMA1_Channel6_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma1Ch6);
 }
 
-void DMA1_Channel7_IRQHandler(void) {
+FURI_RAMFUNC void DMA1_Channel7_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma1Ch7);
 }
 
 /* DMA 2 */
-void DMA2_Channel1_IRQHandler(void) {
+FURI_RAMFUNC void DMA2_Channel1_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma2Ch1);
 }
 
-void DMA2_Channel2_IRQHandler(void) {
+FURI_RAMFUNC void DMA2_Channel2_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma2Ch2);
 }
 
-void DMA2_Channel3_IRQHandler(void) {
+FURI_RAMFUNC void DMA2_Channel3_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma2Ch3);
 }
 
-void DMA2_Channel4_IRQHandler(void) {
+FURI_RAMFUNC void DMA2_Channel4_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma2Ch4);
 }
 
-void DMA2_Channel5_IRQHandler(void) {
+FURI_RAMFUNC void DMA2_Channel5_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma2Ch5);
 }
 
-void DMA2_Channel6_IRQHandler(void) {
+FURI_RAMFUNC void DMA2_Channel6_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma2Ch6);
 }
 
-void DMA2_Channel7_IRQHandler(void) {
+FURI_RAMFUNC void DMA2_Channel7_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdDma2Ch7);
 }
 
@@ -335,6 +369,7 @@ void SysTick_Handler(void) {
     FURI_HAL_INTERRUPT_ACCOUNT_START();
     furi_hal_os_tick();
     FURI_HAL_INTERRUPT_ACCOUNT_END();
+    FURI_HAL_INTERRUPT_ACCOUNT_ID(FuriHalInterruptStatsIdSysTick);
 }
 
 void USB_LP_IRQHandler(void) {
@@ -342,6 +377,7 @@ void USB_LP_IRQHandler(void) {
     FURI_HAL_INTERRUPT_ACCOUNT_START();
     usbd_poll(&udev);
     FURI_HAL_INTERRUPT_ACCOUNT_END();
+    FURI_HAL_INTERRUPT_ACCOUNT_ID(FuriHalInterruptStatsIdUsbLp);
 #endif
 }
 
@@ -350,6 +386,7 @@ void USB_HP_IRQHandler(void) { //-V524
     FURI_HAL_INTERRUPT_ACCOUNT_START();
     usbd_poll(&udev);
     FURI_HAL_INTERRUPT_ACCOUNT_END();
+    FURI_HAL_INTERRUPT_ACCOUNT_ID(FuriHalInterruptStatsIdUsbHp);
 #endif
 }
 
@@ -357,12 +394,14 @@ void IPCC_C1_TX_IRQHandler(void) {
     FURI_HAL_INTERRUPT_ACCOUNT_START();
     HW_IPCC_Tx_Handler();
     FURI_HAL_INTERRUPT_ACCOUNT_END();
+    FURI_HAL_INTERRUPT_ACCOUNT_ID(FuriHalInterruptStatsIdIpccTx);
 }
 
 void IPCC_C1_RX_IRQHandler(void) {
     FURI_HAL_INTERRUPT_ACCOUNT_START();
     HW_IPCC_Rx_Handler();
     FURI_HAL_INTERRUPT_ACCOUNT_END();
+    FURI_HAL_INTERRUPT_ACCOUNT_ID(FuriHalInterruptStatsIdIpccRx);
 }
 
 void FPU_IRQHandler(void) {
@@ -385,6 +424,22 @@ void LPUART1_IRQHandler(void) {
     furi_hal_interrupt_call(FuriHalInterruptIdLpUart1);
 }
 
+void I2C1_EV_IRQHandler(void) {
+    furi_hal_interrupt_call(FuriHalInterruptIdI2c1Ev);
+}
+
+void I2C1_ER_IRQHandler(void) {
+    furi_hal_interrupt_call(FuriHalInterruptIdI2c1Er);
+}
+
+void I2C3_EV_IRQHandler(void) {
+    furi_hal_interrupt_call(FuriHalInterruptIdI2c3Ev);
+}
+
+void I2C3_ER_IRQHandler(void) {
+    furi_hal_interrupt_call(FuriHalInterruptIdI2c3Er);
+}
+
 // Potential space-saver for updater build
 const char* furi_hal_interrupt_get_name(uint8_t exception_number) {
     int32_t id = (int32_t)exception_number - 16;
@@ -542,3 +597,27 @@ const char* furi_hal_interrupt_get_name(uint8_t exception_number) {
 uint32_t furi_hal_interrupt_get_time_in_isr_total(void) {
     return furi_hal_interrupt.counter_time_in_isr_total;
 }
+
+void furi_hal_interrupt_get_stats(uint32_t index, FuriHalInterruptStats* stats) {
+    furi_check(index < FuriHalInterruptStatsIdMax);
+    furi_check(stats);
+
+    FURI_CRITICAL_ENTER();
+    *stats = furi_hal_interrupt.stats[index];
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_hal_interrupt_reset_stats(void) {
+    FURI_CRITICAL_ENTER();
+    memset(furi_hal_interrupt.stats, 0, sizeof(furi_hal_interrupt.stats));
+    FURI_CRITICAL_EXIT();
+}
+
+const char* furi_hal_interrupt_get_id_name(uint32_t index) {
+    furi_check(index < FuriHalInterruptStatsIdMax);
+
+    const IRQn_Type irqn = index < FuriHalInterruptIdMax ?
+                               furi_hal_interrupt_irqn[index] :
+                               furi_hal_interrupt_stats_irqn[index - FuriHalInterruptIdMax];
+    return furi_hal_interrupt_get_name(irqn + 16);
+}
@@ -58,10 +58,37 @@ typedef enum {
     //LPUARTx
     FuriHalInterruptIdLpUart1,
 
+    // I2Cx
+    FuriHalInterruptIdI2c1Ev,
+    FuriHalInterruptIdI2c1Er,
+    FuriHalInterruptIdI2c3Ev,
+    FuriHalInterruptIdI2c3Er,
+
     // Service value
     FuriHalInterruptIdMax,
 } FuriHalInterruptId;
 
+/** Accounting slots: every FuriHalInterruptId, then vectors with fixed handlers */
+typedef enum {
+    FuriHalInterruptStatsIdSysTick = FuriHalInterruptIdMax,
+    FuriHalInterruptStatsIdUsbLp,
+    FuriHalInterruptStatsIdUsbHp,
+    FuriHalInterruptStatsIdIpccTx,
+    FuriHalInterruptStatsIdIpccRx,
+
+    // Service value
+    FuriHalInterruptStatsIdMax,
+} FuriHalInterruptStatsId;
+
+/** Per interrupt accounting */
+typedef struct {
+    uint32_t time; /**< Total time in CPU clocks */
+    uint32_t count; /**< Number of calls */
+    uint32_t max; /**< Longest call in CPU clocks, including nested interrupts */
+    uint32_t last; /**< Cycle counter value at last call entry */
+    uint32_t nested; /**< Calls that preempted another accounted interrupt */
+} FuriHalInterruptStats;
+
 typedef enum {
     FuriHalInterruptPriorityLowest =
         -3, /**< Lowest priority level, you can use ISR-safe OS primitives */
@@ -127,6 +154,26 @@ const char* furi_hal_interrupt_get_name(uint8_t exception_number);
  */
 uint32_t furi_hal_interrupt_get_time_in_isr_total(void);
 
+/** Get interrupt accounting
+ *
+ * Counters are free running and wrap around, subtract two snapshots to get
+ * values for interval. Maximum is kept until furi_hal_interrupt_reset_stats.
+ *
+ * @param      index  - FuriHalInterruptId or FuriHalInterruptStatsId
+ * @param[out] stats  - accounting snapshot
+ */
+void furi_hal_interrupt_get_stats(uint32_t index, FuriHalInterruptStats* stats);
+
+/** Reset accounting of all interrupts */
+void furi_hal_interrupt_reset_stats(void);
+
+/** Get interrupt name by accounting slot
+ *
+ * @param      index  - FuriHalInterruptId or FuriHalInterruptStatsId
+ * @return     const char* or NULL if interrupt name is not found
+ */
+const char* furi_hal_interrupt_get_id_name(uint32_t index);
+
 #ifdef __cplusplus
 }
 #endif
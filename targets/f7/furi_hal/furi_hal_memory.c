@@ -15,8 +15,22 @@ typedef struct {
     uint32_t size;
 } FuriHalMemoryRegion;
 
+/* Header of every pool block, allocated or free. Size includes the header. */
+typedef struct FuriHalMemoryBlock {
+    size_t size;
+    struct FuriHalMemoryBlock* next; // valid for free blocks only
+} FuriHalMemoryBlock;
+
+#define FURI_HAL_MEMORY_ALIGN       (8U)
+#define FURI_HAL_MEMORY_HEADER_SIZE FURI_HAL_MEMORY_ALIGN
+/* Smaller remainders are left in the allocated block */
+#define FURI_HAL_MEMORY_MIN_BLOCK   (sizeof(FuriHalMemoryBlock) + FURI_HAL_MEMORY_ALIGN)
+
 typedef struct {
     FuriHalMemoryRegion region[SRAM_MAX];
+    // Free blocks of both regions, sorted by address
+    FuriHalMemoryBlock* free_list;
+    size_t free;
 } FuriHalMemory;
 
 static FuriHalMemory* furi_hal_memory = NULL;
@@ -25,6 +39,37 @@ extern const void __sram2a_start__;
 extern const void __sram2a_free__;
 extern const void __sram2b_start__;
 
+static void furi_hal_memory_region_align(FuriHalMemoryRegion* region) {
+    uintptr_t start = (uintptr_t)region->start;
+    uintptr_t end = start + region->size;
+    start = (start + FURI_HAL_MEMORY_ALIGN - 1) & ~(uintptr_t)(FURI_HAL_MEMORY_ALIGN - 1);
+    end &= ~(uintptr_t)(FURI_HAL_MEMORY_ALIGN - 1);
+
+    if(end > start && end - start >= FURI_HAL_MEMORY_MIN_BLOCK) {
+        region->start = (void*)start;
+        region->size = end - start;
+    } else {
+        region->size = 0;
+    }
+}
+
+static void furi_hal_memory_build_free_list(FuriHalMemory* memory) {
+    FuriHalMemoryBlock** tail = &memory->free_list;
+    memory->free_list = NULL;
+    memory->free = 0;
+
+    // Region A is placed below region B
+    for(int i = 0; i < SRAM_MAX; i++) {
+        if(memory->region[i].size == 0) continue;
+        FuriHalMemoryBlock* block = memory->region[i].start;
+        block->size = memory->region[i].size;
+        block->next = NULL;
+        *tail = block;
+        tail = &block->next;
+        memory->free += block->size;
+    }
+}
+
 void furi_hal_memory_init(void) {
     if(furi_hal_rtc_get_boot_mode() != FuriHalRtcBootModeNormal) {
         return;
@@ -59,6 +104,10 @@ void furi_hal_memory_init(void) {
     }
     memory->region[SRAM_B].size = sram2b_unprotected_size;
 
+    for(int i = 0; i < SRAM_MAX; i++) {
+        furi_hal_memory_region_align(&memory->region[i]);
+    }
+
     FURI_LOG_I(
         TAG, "SRAM2A: 0x%p, %lu", memory->region[SRAM_A].start, memory->region[SRAM_A].size);
     FURI_LOG_I(
@@ -73,6 +122,7 @@ void furi_hal_memory_init(void) {
             FURI_LOG_I(TAG, "SRAM2B clear");
             memset(memory->region[SRAM_B].start, 0, memory->region[SRAM_B].size);
         }
+        furi_hal_memory_build_free_list(memory);
         furi_hal_memory = memory;
         FURI_LOG_I(TAG, "Enabled");
     } else {
@@ -81,49 +131,125 @@ void furi_hal_memory_init(void) {
     }
 }
 
+static bool furi_hal_memory_owns(const void* ptr) {
+    for(int i = 0; i < SRAM_MAX; i++) {
+        const uint8_t* start = furi_hal_memory->region[i].start;
+        if((const uint8_t*)ptr >= start &&
+           (const uint8_t*)ptr < start + furi_hal_memory->region[i].size) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void* furi_hal_memory_alloc(size_t size) {
     if(FURI_IS_IRQ_MODE()) {
         furi_crash("memmgt in ISR");
     }
 
-    if(furi_hal_memory == NULL) {
+    if(furi_hal_memory == NULL || size == 0) {
         return NULL;
     }
 
-    void* allocated_memory = NULL;
+    size_t block_size = size + FURI_HAL_MEMORY_HEADER_SIZE;
+    if(block_size < size) return NULL;
+    block_size = (block_size + FURI_HAL_MEMORY_ALIGN - 1) & ~(size_t)(FURI_HAL_MEMORY_ALIGN - 1);
+    if(block_size < sizeof(FuriHalMemoryBlock)) block_size = sizeof(FuriHalMemoryBlock);
+
+    FuriHalMemoryBlock* block = NULL;
     FURI_CRITICAL_ENTER();
-    for(int i = 0; i < SRAM_MAX; i++) {
-        if(furi_hal_memory->region[i].size >= size) {
-            void* ptr = furi_hal_memory->region[i].start;
-            furi_hal_memory->region[i].start += size;
-            furi_hal_memory->region[i].size -= size;
-            allocated_memory = ptr;
-            break;
+    // First fit: long-lived buffers end up low, large holes stay at the top
+    for(FuriHalMemoryBlock** link = &furi_hal_memory->free_list; *link; link = &(*link)->next) {
+        FuriHalMemoryBlock* candidate = *link;
+        if(candidate->size < block_size) continue;
+
+        if(candidate->size - block_size >= FURI_HAL_MEMORY_MIN_BLOCK) {
+            FuriHalMemoryBlock* rest = (FuriHalMemoryBlock*)((uint8_t*)candidate + block_size);
+            rest->size = candidate->size - block_size;
+            rest->next = candidate->next;
+            candidate->size = block_size;
+            *link = rest;
+        } else {
+            *link = candidate->next;
         }
+
+        furi_hal_memory->free -= candidate->size;
+        block = candidate;
+        break;
     }
     FURI_CRITICAL_EXIT();
 
-    return allocated_memory;
+    if(block == NULL) return NULL;
+
+    // Same contract as the main heap: memory is returned zeroed
+    void* ptr = (uint8_t*)block + FURI_HAL_MEMORY_HEADER_SIZE;
+    memset(ptr, 0, block->size - FURI_HAL_MEMORY_HEADER_SIZE);
+    return ptr;
 }
 
-size_t furi_hal_memory_get_free(void) {
-    if(furi_hal_memory == NULL) return 0;
+bool furi_hal_memory_free(void* ptr) {
+    if(furi_hal_memory == NULL || ptr == NULL || !furi_hal_memory_owns(ptr)) {
+        return false;
+    }
 
-    size_t free = 0;
-    for(int i = 0; i < SRAM_MAX; i++) {
-        free += furi_hal_memory->region[i].size;
+    if(FURI_IS_IRQ_MODE()) {
+        furi_crash("memmgt in ISR");
+    }
+
+    FuriHalMemoryBlock* block = (FuriHalMemoryBlock*)((uint8_t*)ptr - FURI_HAL_MEMORY_HEADER_SIZE);
+    furi_check(((uintptr_t)block & (FURI_HAL_MEMORY_ALIGN - 1)) == 0);
+
+    FURI_CRITICAL_ENTER();
+    FuriHalMemoryBlock* prev = NULL;
+    FuriHalMemoryBlock* next = furi_hal_memory->free_list;
+    while(next && next < block) {
+        prev = next;
+        next = next->next;
+    }
+
+    // Double free or corrupted header
+    furi_check(next != block);
+    furi_check(!prev || (uint8_t*)prev + prev->size <= (uint8_t*)block);
+    furi_check(!next || (uint8_t*)block + block->size <= (uint8_t*)next);
+
+    furi_hal_memory->free += block->size;
+
+    if(next && (uint8_t*)block + block->size == (uint8_t*)next) {
+        block->size += next->size;
+        block->next = next->next;
+    } else {
+        block->next = next;
     }
-    return free;
+
+    if(prev && (uint8_t*)prev + prev->size == (uint8_t*)block) {
+        prev->size += block->size;
+        prev->next = block->next;
+    } else if(prev) {
+        prev->next = block;
+    } else {
+        furi_hal_memory->free_list = block;
+    }
+    FURI_CRITICAL_EXIT();
+
+    return true;
+}
+
+size_t furi_hal_memory_get_free(void) {
+    if(furi_hal_memory == NULL) return 0;
+    return furi_hal_memory->free;
 }
 
 size_t furi_hal_memory_max_pool_block(void) {
     if(furi_hal_memory == NULL) return 0;
 
     size_t max = 0;
-    for(int i = 0; i < SRAM_MAX; i++) {
-        if(furi_hal_memory->region[i].size > max) {
-            max = furi_hal_memory->region[i].size;
+    FURI_CRITICAL_ENTER();
+    for(FuriHalMemoryBlock* block = furi_hal_memory->free_list; block; block = block->next) {
+        if(block->size > max) {
+            max = block->size;
         }
     }
-    return max;
+    FURI_CRITICAL_EXIT();
+
+    return max > FURI_HAL_MEMORY_HEADER_SIZE ? max - FURI_HAL_MEMORY_HEADER_SIZE : 0;
 }
@@ -0,0 +1,231 @@
+#include <furi_hal_pka.h>
+#include <furi_hal_bus.h>
+#include <furi_hal_cortex.h>
+#include <furi_hal_random.h>
+#include <furi.h>
+
+#include <stm32wbxx_ll_pka.h>
+#include <stm32wbxx_ll_hsem.h>
+
+#include <hsem_map.h>
+
+#define TAG "FuriHalPka"
+
+#define PKA_TIMEOUT_US (500000UL)
+
+#define PKA_P256_BITS  (256UL)
+#define PKA_P256_WORDS (FURI_HAL_PKA_P256_SIZE / sizeof(uint32_t))
+
+// RAM word offsets of ECDSA sign operands, RM0434 25.5
+#define PKA_RAM_OFFSET                   (0x400U)
+#define PKA_RAM_WORD(address)            (((address) - PKA_RAM_OFFSET) / sizeof(uint32_t))
+#define PKA_ECDSA_SIGN_IN_ORDER_NB_BITS  PKA_RAM_WORD(0x400U)
+#define PKA_ECDSA_SIGN_IN_MOD_NB_BITS    PKA_RAM_WORD(0x404U)
+#define PKA_ECDSA_SIGN_IN_A_COEFF_SIGN   PKA_RAM_WORD(0x408U)
+#define PKA_ECDSA_SIGN_IN_A_COEFF        PKA_RAM_WORD(0x40CU)
+#define PKA_ECDSA_SIGN_IN_MOD_GF         PKA_RAM_WORD(0x460U)
+#define PKA_ECDSA_SIGN_IN_K              PKA_RAM_WORD(0x12A0U)
+#define PKA_ECDSA_SIGN_IN_POINT_X        PKA_RAM_WORD(0x55CU)
+#define PKA_ECDSA_SIGN_IN_POINT_Y        PKA_RAM_WORD(0x5B0U)
+#define PKA_ECDSA_SIGN_IN_HASH_E         PKA_RAM_WORD(0xDE8U)
+#define PKA_ECDSA_SIGN_IN_PRIVATE_KEY_D  PKA_RAM_WORD(0xE3CU)
+#define PKA_ECDSA_SIGN_IN_ORDER_N        PKA_RAM_WORD(0xE94U)
+#define PKA_ECDSA_SIGN_OUT_ERROR         PKA_RAM_WORD(0xEE8U)
+#define PKA_ECDSA_SIGN_OUT_SIGNATURE_R   PKA_RAM_WORD(0x700U)
+#define PKA_ECDSA_SIGN_OUT_SIGNATURE_S   PKA_RAM_WORD(0x754U)
+
+// RAM word offsets of ECDSA verification operands
+#define PKA_ECDSA_VERIF_IN_ORDER_NB_BITS PKA_RAM_WORD(0x404U)
+#define PKA_ECDSA_VERIF_IN_MOD_NB_BITS   PKA_RAM_WORD(0x4B4U)
+#define PKA_ECDSA_VERIF_IN_A_COEFF_SIGN  PKA_RAM_WORD(0x45CU)
+#define PKA_ECDSA_VERIF_IN_A_COEFF       PKA_RAM_WORD(0x460U)
+#define PKA_ECDSA_VERIF_IN_MOD_GF        PKA_RAM_WORD(0x4B8U)
+#define PKA_ECDSA_VERIF_IN_POINT_X       PKA_RAM_WORD(0x5E8U)
+#define PKA_ECDSA_VERIF_IN_POINT_Y       PKA_RAM_WORD(0x63CU)
+#define PKA_ECDSA_VERIF_IN_PUBLIC_KEY_X  PKA_RAM_WORD(0xF40U)
+#define PKA_ECDSA_VERIF_IN_PUBLIC_KEY_Y  PKA_RAM_WORD(0xF94U)
+#define PKA_ECDSA_VERIF_IN_SIGNATURE_R   PKA_RAM_WORD(0x1098U)
+#define PKA_ECDSA_VERIF_IN_SIGNATURE_S   PKA_RAM_WORD(0xA44U)
+#define PKA_ECDSA_VERIF_IN_HASH_E        PKA_RAM_WORD(0xFE8U)
+#define PKA_ECDSA_VERIF_IN_ORDER_N       PKA_RAM_WORD(0xD5CU)
+#define PKA_ECDSA_VERIF_OUT_RESULT       PKA_RAM_WORD(0x5B0U)
+
+// NIST P-256 domain parameters, big endian
+static const uint8_t pka_p256_p[FURI_HAL_PKA_P256_SIZE] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+static const uint8_t pka_p256_n[FURI_HAL_PKA_P256_SIZE] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51,
+};
+
+static const uint8_t pka_p256_gx[FURI_HAL_PKA_P256_SIZE] = {
+    0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40, 0xF2,
+    0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96,
+};
+
+static const uint8_t pka_p256_gy[FURI_HAL_PKA_P256_SIZE] = {
+    0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16,
+    0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5,
+};
+
+// a = -3, stored as sign and absolute value
+static const uint8_t pka_p256_a_abs[FURI_HAL_PKA_P256_SIZE] = {[FURI_HAL_PKA_P256_SIZE - 1] = 3};
+
+/* Operands are little endian words followed by a zero word */
+static void furi_hal_pka_write_operand(size_t offset, const uint8_t* data) {
+    for(size_t i = 0; i < PKA_P256_WORDS; i++) {
+        const uint8_t* word = &data[FURI_HAL_PKA_P256_SIZE - (i + 1) * sizeof(uint32_t)];
+        PKA->RAM[offset + i] = ((uint32_t)word[0] << 24) | ((uint32_t)word[1] << 16) |
+                               ((uint32_t)word[2] << 8) | word[3];
+    }
+    PKA->RAM[offset + PKA_P256_WORDS] = 0;
+}
+
+static void furi_hal_pka_read_operand(size_t offset, uint8_t* data) {
+    for(size_t i = 0; i < PKA_P256_WORDS; i++) {
+        const uint32_t value = PKA->RAM[offset + i];
+        uint8_t* word = &data[FURI_HAL_PKA_P256_SIZE - (i + 1) * sizeof(uint32_t)];
+        word[0] = value >> 24;
+        word[1] = value >> 16;
+        word[2] = value >> 8;
+        word[3] = value;
+    }
+}
+
+/* Ephemeral key in [1, n - 1], rejection sampling */
+static void furi_hal_pka_random_k(uint8_t* k) {
+    while(true) {
+        furi_hal_random_fill_buf(k, FURI_HAL_PKA_P256_SIZE);
+
+        int compare = 0;
+        bool zero = true;
+        for(size_t i = 0; i < FURI_HAL_PKA_P256_SIZE; i++) {
+            if(compare == 0) compare = (k[i] > pka_p256_n[i]) - (k[i] < pka_p256_n[i]);
+            zero &= (k[i] == 0);
+        }
+        if(compare < 0 && !zero) break;
+    }
+}
+
+static bool furi_hal_pka_run(uint32_t mode) {
+    LL_PKA_SetMode(PKA, mode);
+    LL_PKA_Start(PKA);
+
+    FuriHalCortexTimer timer = furi_hal_cortex_timer_get(PKA_TIMEOUT_US);
+    while(!LL_PKA_IsActiveFlag_PROCEND(PKA)) {
+        if(furi_hal_cortex_timer_is_expired(timer)) {
+            FURI_LOG_E(TAG, "Timeout");
+            return false;
+        }
+    }
+
+    const bool error = LL_PKA_IsActiveFlag_RAMERR(PKA) || LL_PKA_IsActiveFlag_ADDRERR(PKA);
+    LL_PKA_ClearFlag_PROCEND(PKA);
+    LL_PKA_ClearFlag_RAMERR(PKA);
+    LL_PKA_ClearFlag_ADDRERR(PKA);
+
+    return !error;
+}
+
+static bool furi_hal_pka_acquire(void) {
+    // Clock is owned by furi_hal_bt, together with the radio stack
+    if(!furi_hal_bus_is_enabled(FuriHalBusPKA)) {
+        return false;
+    }
+    if(LL_HSEM_1StepLock(HSEM, CFG_HW_PKA_SEMID)) {
+        return false;
+    }
+
+    LL_PKA_Enable(PKA);
+    return true;
+}
+
+static void furi_hal_pka_release(void) {
+    // Do not leave key material behind for core2
+    for(size_t i = 0; i < COUNT_OF(PKA->RAM); i++) {
+        PKA->RAM[i] = 0;
+    }
+    LL_PKA_Disable(PKA);
+
+    LL_HSEM_ReleaseLock(HSEM, CFG_HW_PKA_SEMID, 0);
+}
+
+bool furi_hal_pka_ecdsa_sign_p256(const uint8_t* key, const uint8_t* hash, uint8_t* signature) {
+    furi_check(key);
+    furi_check(hash);
+    furi_check(signature);
+
+    if(!furi_hal_pka_acquire()) {
+        return false;
+    }
+
+    uint8_t k[FURI_HAL_PKA_P256_SIZE];
+    furi_hal_pka_random_k(k);
+
+    PKA->RAM[PKA_ECDSA_SIGN_IN_ORDER_NB_BITS] = PKA_P256_BITS;
+    PKA->RAM[PKA_ECDSA_SIGN_IN_MOD_NB_BITS] = PKA_P256_BITS;
+    PKA->RAM[PKA_ECDSA_SIGN_IN_A_COEFF_SIGN] = 1;
+    furi_hal_pka_write_operand(PKA_ECDSA_SIGN_IN_A_COEFF, pka_p256_a_abs);
+    furi_hal_pka_write_operand(PKA_ECDSA_SIGN_IN_MOD_GF, pka_p256_p);
+    furi_hal_pka_write_operand(PKA_ECDSA_SIGN_IN_K, k);
+    furi_hal_pka_write_operand(PKA_ECDSA_SIGN_IN_POINT_X, pka_p256_gx);
+    furi_hal_pka_write_operand(PKA_ECDSA_SIGN_IN_POINT_Y, pka_p256_gy);
+    furi_hal_pka_write_operand(PKA_ECDSA_SIGN_IN_HASH_E, hash);
+    furi_hal_pka_write_operand(PKA_ECDSA_SIGN_IN_PRIVATE_KEY_D, key);
+    furi_hal_pka_write_operand(PKA_ECDSA_SIGN_IN_ORDER_N, pka_p256_n);
+
+    bool success = furi_hal_pka_run(LL_PKA_MODE_ECDSA_SIGNATURE) &&
+                   (PKA->RAM[PKA_ECDSA_SIGN_OUT_ERROR] == 0);
+    if(success) {
+        furi_hal_pka_read_operand(PKA_ECDSA_SIGN_OUT_SIGNATURE_R, signature);
+        furi_hal_pka_read_operand(
+            PKA_ECDSA_SIGN_OUT_SIGNATURE_S, signature + FURI_HAL_PKA_P256_SIZE);
+    }
+
+    furi_hal_pka_release();
+    memset(k, 0, sizeof(k));
+
+    return success;
+}
+
+FuriHalPkaStatus furi_hal_pka_ecdsa_verify_p256(
+    const uint8_t* public_key,
+    const uint8_t* hash,
+    const uint8_t* signature) {
+    furi_check(public_key);
+    furi_check(hash);
+    furi_check(signature);
+
+    if(!furi_hal_pka_acquire()) {
+        return FuriHalPkaStatusBusy;
+    }
+
+    PKA->RAM[PKA_ECDSA_VERIF_IN_ORDER_NB_BITS] = PKA_P256_BITS;
+    PKA->RAM[PKA_ECDSA_VERIF_IN_MOD_NB_BITS] = PKA_P256_BITS;
+    PKA->RAM[PKA_ECDSA_VERIF_IN_A_COEFF_SIGN] = 1;
+    furi_hal_pka_write_operand(PKA_ECDSA_VERIF_IN_A_COEFF, pka_p256_a_abs);
+    furi_hal_pka_write_operand(PKA_ECDSA_VERIF_IN_MOD_GF, pka_p256_p);
+    furi_hal_pka_write_operand(PKA_ECDSA_VERIF_IN_POINT_X, pka_p256_gx);
+    furi_hal_pka_write_operand(PKA_ECDSA_VERIF_IN_POINT_Y, pka_p256_gy);
+    furi_hal_pka_write_operand(PKA_ECDSA_VERIF_IN_PUBLIC_KEY_X, public_key);
+    furi_hal_pka_write_operand(
+        PKA_ECDSA_VERIF_IN_PUBLIC_KEY_Y, public_key + FURI_HAL_PKA_P256_SIZE);
+    furi_hal_pka_write_operand(PKA_ECDSA_VERIF_IN_SIGNATURE_R, signature);
+    furi_hal_pka_write_operand(
+        PKA_ECDSA_VERIF_IN_SIGNATURE_S, signature + FURI_HAL_PKA_P256_SIZE);
+    furi_hal_pka_write_operand(PKA_ECDSA_VERIF_IN_HASH_E, hash);
+    furi_hal_pka_write_operand(PKA_ECDSA_VERIF_IN_ORDER_N, pka_p256_n);
+
+    FuriHalPkaStatus status = FuriHalPkaStatusError;
+    if(furi_hal_pka_run(LL_PKA_MODE_ECDSA_VERIFICATION) &&
+       (PKA->RAM[PKA_ECDSA_VERIF_OUT_RESULT] == 0)) {
+        status = FuriHalPkaStatusOk;
+    }
+
+    furi_hal_pka_release();
+
+    return status;
+}
@@ -6,6 +6,7 @@
 #include <furi_hal_serial_control.h>
 #include <furi_hal_rtc.h>
 #include <furi_hal_debug.h>
+#include <furi_hal_sd.h>
 
 #include <stm32wbxx_ll_rcc.h>
 #include <stm32wbxx_ll_pwr.h>
@@ -49,6 +50,20 @@ static volatile FuriHalPower furi_hal_power = {
     .charger_ok = false,
 };
 
+/* Gauge readings shared by all consumers for this long, ms */
+#define FURI_HAL_POWER_GAUGE_CACHE_INTERVAL_DEFAULT (500U)
+
+typedef struct {
+    Bq27220Snapshot snapshot;
+    uint32_t timestamp;
+    uint32_t interval;
+    bool valid;
+} FuriHalPowerGaugeCache;
+
+static FuriHalPowerGaugeCache furi_hal_power_gauge_cache = {
+    .interval = FURI_HAL_POWER_GAUGE_CACHE_INTERVAL_DEFAULT,
+};
+
 extern const BQ27220DMData furi_hal_power_gauge_data_memory[];
 
 void furi_hal_power_init(void) {
@@ -103,42 +118,67 @@ void furi_hal_power_init(void) {
     FURI_LOG_I(TAG, "Init OK");
 }
 
-bool furi_hal_power_gauge_is_ok(void) {
-    bool ret = true;
+void furi_hal_power_set_gauge_cache_interval(uint32_t interval_ms) {
+    FURI_CRITICAL_ENTER();
+    furi_hal_power_gauge_cache.interval = interval_ms;
+    furi_hal_power_gauge_cache.valid = false;
+    FURI_CRITICAL_EXIT();
+}
 
-    Bq27220BatteryStatus battery_status;
-    Bq27220OperationStatus operation_status;
+static bool furi_hal_power_gauge_get_snapshot(Bq27220Snapshot* snapshot) {
+    FuriHalPowerGaugeCache* cache = &furi_hal_power_gauge_cache;
+    // Tick does not run before the scheduler, cache would never expire
+    const bool kernel_running = furi_kernel_is_running();
+    bool fresh = false;
+
+    FURI_CRITICAL_ENTER();
+    if(kernel_running && cache->valid &&
+       furi_get_tick() - cache->timestamp < furi_ms_to_ticks(cache->interval)) {
+        *snapshot = cache->snapshot;
+        fresh = true;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(fresh) return true;
 
     furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
+    const bool success = bq27220_get_snapshot(&furi_hal_i2c_handle_power, snapshot);
+    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
 
-    if(!bq27220_get_battery_status(&furi_hal_i2c_handle_power, &battery_status) ||
-       !bq27220_get_operation_status(&furi_hal_i2c_handle_power, &operation_status)) {
-        ret = false;
-    } else {
-        ret &= battery_status.BATTPRES;
-        ret &= operation_status.INITCOMP;
-        ret &= furi_hal_power.gauge_ok;
+    if(success && kernel_running) {
+        FURI_CRITICAL_ENTER();
+        cache->snapshot = *snapshot;
+        cache->timestamp = furi_get_tick();
+        cache->valid = true;
+        FURI_CRITICAL_EXIT();
     }
 
-    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
+    return success;
+}
 
-    return ret;
+static inline float furi_hal_power_gauge_get_temperature(uint16_t temperature) {
+    return ((float)temperature - 2731.0f) / 10.0f;
 }
 
-bool furi_hal_power_is_shutdown_requested(void) {
-    bool ret = false;
+bool furi_hal_power_gauge_is_ok(void) {
+    Bq27220Snapshot snapshot;
 
-    Bq27220BatteryStatus battery_status;
+    if(!furi_hal_power_gauge_get_snapshot(&snapshot)) {
+        return false;
+    }
 
-    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
+    return snapshot.battery_status.BATTPRES && snapshot.operation_status.INITCOMP &&
+           furi_hal_power.gauge_ok;
+}
 
-    if(bq27220_get_battery_status(&furi_hal_i2c_handle_power, &battery_status) != BQ27220_ERROR) {
-        ret = battery_status.SYSDWN;
-    }
+bool furi_hal_power_is_shutdown_requested(void) {
+    Bq27220Snapshot snapshot;
 
-    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
+    if(!furi_hal_power_gauge_get_snapshot(&snapshot)) {
+        return false;
+    }
 
-    return ret;
+    return snapshot.battery_status.SYSDWN;
 }
 
 uint16_t furi_hal_power_insomnia_level(void) {
@@ -265,17 +305,15 @@ void furi_hal_power_sleep(void) {
 }
 
 uint8_t furi_hal_power_get_pct(void) {
-    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
-    uint8_t ret = bq27220_get_state_of_charge(&furi_hal_i2c_handle_power);
-    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
-    return ret;
+    Bq27220Snapshot snapshot;
+    furi_hal_power_gauge_get_snapshot(&snapshot);
+    return snapshot.state_of_charge;
 }
 
 uint8_t furi_hal_power_get_bat_health_pct(void) {
-    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
-    uint8_t ret = bq27220_get_state_of_health(&furi_hal_i2c_handle_power);
-    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
-    return ret;
+    Bq27220Snapshot snapshot;
+    furi_hal_power_gauge_get_snapshot(&snapshot);
+    return snapshot.state_of_health;
 }
 
 bool furi_hal_power_is_charging(void) {
@@ -325,6 +363,8 @@ void furi_hal_power_shutdown(void) {
 }
 
 void furi_hal_power_off(void) {
+    // Don't lose data held by SD write back cache
+    furi_hal_sd_flush();
     // Crutch: shutting down with ext 3V3 off is causing LSE to stop
     furi_hal_rtc_prepare_for_shutdown();
     furi_hal_power_enable_external_3_3v();
@@ -394,38 +434,37 @@ void furi_hal_power_check_otg_status(void) {
 }
 
 uint32_t furi_hal_power_get_battery_remaining_capacity(void) {
-    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
-    uint32_t ret = bq27220_get_remaining_capacity(&furi_hal_i2c_handle_power);
-    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
-    return ret;
+    Bq27220Snapshot snapshot;
+    furi_hal_power_gauge_get_snapshot(&snapshot);
+    return snapshot.remaining_capacity;
 }
 
 uint32_t furi_hal_power_get_battery_full_capacity(void) {
-    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
-    uint32_t ret = bq27220_get_full_charge_capacity(&furi_hal_i2c_handle_power);
-    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
-    return ret;
+    Bq27220Snapshot snapshot;
+    furi_hal_power_gauge_get_snapshot(&snapshot);
+    return snapshot.full_charge_capacity;
 }
 
 uint32_t furi_hal_power_get_battery_design_capacity(void) {
-    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
-    uint32_t ret = bq27220_get_design_capacity(&furi_hal_i2c_handle_power);
-    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
-    return ret;
+    Bq27220Snapshot snapshot;
+    furi_hal_power_gauge_get_snapshot(&snapshot);
+    return snapshot.design_capacity;
 }
 
 float furi_hal_power_get_battery_voltage(FuriHalPowerIC ic) {
     float ret = 0.0f;
 
-    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
     if(ic == FuriHalPowerICCharger) {
+        furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
         ret = (float)bq25896_get_vbat_voltage(&furi_hal_i2c_handle_power) / 1000.0f;
+        furi_hal_i2c_release(&furi_hal_i2c_handle_power);
     } else if(ic == FuriHalPowerICFuelGauge) {
-        ret = (float)bq27220_get_voltage(&furi_hal_i2c_handle_power) / 1000.0f;
+        Bq27220Snapshot snapshot;
+        furi_hal_power_gauge_get_snapshot(&snapshot);
+        ret = (float)snapshot.voltage / 1000.0f;
     } else {
         furi_crash();
     }
-    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
 
     return ret;
 }
@@ -433,40 +472,38 @@ float furi_hal_power_get_battery_voltage(FuriHalPowerIC ic) {
 float furi_hal_power_get_battery_current(FuriHalPowerIC ic) {
     float ret = 0.0f;
 
-    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
     if(ic == FuriHalPowerICCharger) {
+        furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
         ret = (float)bq25896_get_vbat_current(&furi_hal_i2c_handle_power) / 1000.0f;
+        furi_hal_i2c_release(&furi_hal_i2c_handle_power);
     } else if(ic == FuriHalPowerICFuelGauge) {
-        ret = (float)bq27220_get_current(&furi_hal_i2c_handle_power) / 1000.0f;
+        Bq27220Snapshot snapshot;
+        furi_hal_power_gauge_get_snapshot(&snapshot);
+        ret = (float)snapshot.current / 1000.0f;
     } else {
         furi_crash();
     }
-    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
 
     return ret;
 }
 
-static float furi_hal_power_get_battery_temperature_internal(FuriHalPowerIC ic) {
+float furi_hal_power_get_battery_temperature(FuriHalPowerIC ic) {
     float ret = 0.0f;
 
     if(ic == FuriHalPowerICCharger) {
+        furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
         // Linear approximation, +/- 5 C
         ret = (71.0f - (float)bq25896_get_ntc_mpct(&furi_hal_i2c_handle_power) / 1000) / 0.6f;
+        furi_hal_i2c_release(&furi_hal_i2c_handle_power);
     } else if(ic == FuriHalPowerICFuelGauge) {
-        ret = ((float)bq27220_get_temperature(&furi_hal_i2c_handle_power) - 2731.0f) / 10.0f;
+        Bq27220Snapshot snapshot;
+        furi_hal_power_gauge_get_snapshot(&snapshot);
+        ret = furi_hal_power_gauge_get_temperature(snapshot.temperature);
     }
 
     return ret;
 }
 
-float furi_hal_power_get_battery_temperature(FuriHalPowerIC ic) {
-    furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
-    float ret = furi_hal_power_get_battery_temperature_internal(ic);
-    furi_hal_i2c_release(&furi_hal_i2c_handle_power);
-
-    return ret;
-}
-
 float furi_hal_power_get_usb_voltage(void) {
     furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
     float ret = (float)bq25896_get_vbus_voltage(&furi_hal_i2c_handle_power) / 1000.0f;
@@ -590,8 +627,7 @@ void furi_hal_power_debug_get(PropertyValueCallback out, void* context) {
     PropertyValueContext property_context = {
         .key = key, .value = value, .out = out, .sep = '.', .last = false, .context = context};
 
-    Bq27220BatteryStatus battery_status;
-    Bq27220OperationStatus operation_status;
+    Bq27220Snapshot snapshot;
 
     furi_hal_i2c_acquire(&furi_hal_i2c_handle_power);
 
@@ -637,8 +673,11 @@ void furi_hal_power_debug_get(PropertyValueCallback out, void* context) {
 
     const uint32_t ntc_mpct = bq25896_get_ntc_mpct(&furi_hal_i2c_handle_power);
 
-    if(bq27220_get_battery_status(&furi_hal_i2c_handle_power, &battery_status) &&
-       bq27220_get_operation_status(&furi_hal_i2c_handle_power, &operation_status)) {
+    // Debug output is always read fresh, bypassing the cache
+    if(bq27220_get_snapshot(&furi_hal_i2c_handle_power, &snapshot)) {
+        const Bq27220BatteryStatus battery_status = snapshot.battery_status;
+        const Bq27220OperationStatus operation_status = snapshot.operation_status;
+
         property_value_out(&property_context, "%lu", 2, "charger", "ntc", ntc_mpct);
         property_value_out(&property_context, "%d", 2, "gauge", "calmd", operation_status.CALMD);
         property_value_out(&property_context, "%d", 2, "gauge", "sec", operation_status.SEC);
@@ -680,7 +719,7 @@ void furi_hal_power_debug_get(PropertyValueCallback out, void* context) {
             "gauge",
             "capacity",
             "full",
-            bq27220_get_full_charge_capacity(&furi_hal_i2c_handle_power));
+            snapshot.full_charge_capacity);
         property_value_out(
             &property_context,
             "%d",
@@ -688,7 +727,7 @@ void furi_hal_power_debug_get(PropertyValueCallback out, void* context) {
             "gauge",
             "capacity",
             "design",
-            bq27220_get_design_capacity(&furi_hal_i2c_handle_power));
+            snapshot.design_capacity);
         property_value_out(
             &property_context,
             "%d",
@@ -696,7 +735,7 @@ void furi_hal_power_debug_get(PropertyValueCallback out, void* context) {
             "gauge",
             "capacity",
             "remain",
-            bq27220_get_remaining_capacity(&furi_hal_i2c_handle_power));
+            snapshot.remaining_capacity);
         property_value_out(
             &property_context,
             "%d",
@@ -704,7 +743,7 @@ void furi_hal_power_debug_get(PropertyValueCallback out, void* context) {
             "gauge",
             "state",
             "charge",
-            bq27220_get_state_of_charge(&furi_hal_i2c_handle_power));
+            snapshot.state_of_charge);
         property_value_out(
             &property_context,
             "%d",
@@ -712,25 +751,24 @@ void furi_hal_power_debug_get(PropertyValueCallback out, void* context) {
             "gauge",
             "state",
             "health",
-            bq27220_get_state_of_health(&furi_hal_i2c_handle_power));
+            snapshot.state_of_health);
         property_value_out(
             &property_context,
             "%d",
             2,
             "gauge",
             "voltage",
-            bq27220_get_voltage(&furi_hal_i2c_handle_power));
+            snapshot.voltage);
         property_value_out(
             &property_context,
             "%d",
             2,
             "gauge",
             "current",
-            bq27220_get_current(&furi_hal_i2c_handle_power));
+            snapshot.current);
 
         property_context.last = true;
-        const int battery_temp =
-            (int)furi_hal_power_get_battery_temperature_internal(FuriHalPowerICFuelGauge);
+        const int battery_temp = (int)furi_hal_power_gauge_get_temperature(snapshot.temperature);
         property_value_out(&property_context, "%d", 2, "gauge", "temperature", battery_temp);
     } else {
         property_context.last = true;
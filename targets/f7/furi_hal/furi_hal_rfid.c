@@ -201,6 +201,18 @@ void furi_hal_rfid_tim_read_start(float freq, float duty_cycle) {
     furi_hal_rfid_tim_read_continue();
 }
 
+void furi_hal_rfid_tim_read_set_carrier(float freq, float duty_cycle) {
+    uint32_t period = (SystemCoreClock / freq) - 1;
+    uint32_t pulse = period * duty_cycle;
+
+    FURI_CRITICAL_ENTER();
+    // No ARR preload: keep counter below both values while they change
+    LL_TIM_SetCounter(FURI_HAL_RFID_READ_TIMER, 0);
+    furi_hal_rfid_set_read_period(period);
+    furi_hal_rfid_set_read_pulse(pulse);
+    FURI_CRITICAL_EXIT();
+}
+
 void furi_hal_rfid_tim_read_continue(void) {
     LL_TIM_EnableAllOutputs(FURI_HAL_RFID_READ_TIMER);
 }
@@ -35,6 +35,15 @@ void furi_hal_rfid_pin_pull_pulldown(void);
  */
 void furi_hal_rfid_tim_read_start(float freq, float duty_cycle);
 
+/** Change running read timer frequency, without restarting read
+ *
+ * Capture keeps running, edges captured around the change are not reliable.
+ *
+ * @param      freq        timer frequency
+ * @param      duty_cycle  timer duty cycle, 0.0-1.0
+ */
+void furi_hal_rfid_tim_read_set_carrier(float freq, float duty_cycle);
+
 /** Pause read timer, to be able to continue later
  */
 void furi_hal_rfid_tim_read_pause(void);
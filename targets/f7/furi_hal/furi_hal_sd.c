@@ -18,10 +18,17 @@
 #define SD_TIMEOUT_MS         (1000)
 #define SD_BLOCK_SIZE         (512)
 
+/* Blocks in one multi-block command, bus can be yielded between those */
+#define SD_BURST_BLOCKS (8)
+
 #define FLAG_SET(x, y) (((x) & (y)) == (y))
 
 static bool sd_high_capacity = false;
 
+/* Created on first write back enable, guards sector cache against concurrent flush */
+static FuriMutex* sd_cache_mutex = NULL;
+static bool sd_cache_write_back = false;
+
 typedef enum {
     SdSpiDataResponceOK = 0x05,
     SdSpiDataResponceCRCError = 0x0B,
@@ -67,6 +74,7 @@ typedef enum {
     SD_CMD17_READ_SINGLE_BLOCK = 17,
     SD_CMD18_READ_MULT_BLOCK = 18,
     SD_CMD23_SET_BLOCK_COUNT = 23,
+    SD_ACMD23_SET_WR_BLK_ERASE_COUNT = 23,
     SD_CMD24_WRITE_SINGLE_BLOCK = 24,
     SD_CMD25_WRITE_MULT_BLOCK = 25,
     SD_CMD27_PROG_CSD = 27,
@@ -685,11 +693,7 @@ static FuriStatus sd_spi_get_cid(SD_CID* Cid) {
     return ret;
 }
 
-static FuriStatus
-    sd_spi_cmd_read_blocks(uint32_t* data, uint32_t address, uint32_t blocks, uint32_t timeout_ms) {
-    uint32_t block_address = address;
-    uint32_t offset = 0;
-
+static FuriStatus sd_spi_set_block_len(void) {
     // CMD16 (SET_BLOCKLEN): R1 response (0x00: no errors)
     SdSpiCmdAnswer response =
         sd_spi_send_cmd(SD_CMD16_SET_BLOCKLEN, SD_BLOCK_SIZE, 0xFF, SdSpiCmdAnswerTypeR1);
@@ -699,10 +703,55 @@ static FuriStatus
         return FuriStatusError;
     }
 
-    if(!sd_high_capacity) {
-        block_address = address * SD_BLOCK_SIZE;
+    return FuriStatusOk;
+}
+
+static inline uint32_t sd_spi_get_block_address(uint32_t address) {
+    // SDSC cards use byte addressing, SDHC and SDXC cards use block addressing
+    return sd_high_capacity ? address : address * SD_BLOCK_SIZE;
+}
+
+static inline uint32_t sd_spi_get_next_block_address(uint32_t block_address) {
+    return sd_high_capacity ? block_address + 1 : block_address + SD_BLOCK_SIZE;
+}
+
+static FuriStatus sd_spi_stop_transmission(uint32_t timeout_ms) {
+    uint8_t frame[SD_CMD_LENGTH] = {
+        ((uint8_t)SD_CMD12_STOP_TRANSMISSION | 0x40),
+        0x00,
+        0x00,
+        0x00,
+        0x00,
+        0xFF,
+    };
+
+    // Card is still selected and streaming data, so send CMD12 right away
+    sd_spi_write_bytes(frame, sizeof(frame));
+
+    // Skip stuff byte which follows CMD12
+    sd_spi_read_byte();
+
+    // CMD12 (STOP_TRANSMISSION): R1b response (0x00: no errors)
+    uint8_t r1 = sd_spi_wait_for_data_and_read();
+
+    // Wait while card is busy
+    FuriStatus status = sd_spi_wait_for_data(SD_DUMMY_BYTE, timeout_ms);
+
+    if(r1 != SdSpi_R1_NO_ERROR) {
+        status = FuriStatusError;
     }
 
+    return status;
+}
+
+static FuriStatus sd_spi_cmd_read_single_blocks(
+    uint32_t* data,
+    uint32_t block_address,
+    uint32_t blocks,
+    uint32_t timeout_ms) {
+    SdSpiCmdAnswer response;
+    uint32_t offset = 0;
+
     while(blocks--) {
         // CMD17 (READ_SINGLE_BLOCK): R1 response (0x00: no errors)
         response =
@@ -723,11 +772,7 @@ static FuriStatus
             offset += SD_BLOCK_SIZE;
 
             // increase block address
-            if(sd_high_capacity) {
-                block_address += 1;
-            } else {
-                block_address += SD_BLOCK_SIZE;
-            }
+            block_address = sd_spi_get_next_block_address(block_address);
         } else {
             sd_spi_deselect_card_and_purge();
             return FuriStatusError;
@@ -739,26 +784,70 @@ static FuriStatus
     return FuriStatusOk;
 }
 
-static FuriStatus sd_spi_cmd_write_blocks(
-    const uint32_t* data,
-    uint32_t address,
+static FuriStatus sd_spi_cmd_read_multiple_blocks(
+    uint32_t* data,
+    uint32_t block_address,
     uint32_t blocks,
     uint32_t timeout_ms) {
-    uint32_t block_address = address;
+    FuriStatus status = FuriStatusOk;
     uint32_t offset = 0;
 
-    // CMD16 (SET_BLOCKLEN): R1 response (0x00: no errors)
+    // CMD18 (READ_MULT_BLOCK): R1 response (0x00: no errors)
     SdSpiCmdAnswer response =
-        sd_spi_send_cmd(SD_CMD16_SET_BLOCKLEN, SD_BLOCK_SIZE, 0xFF, SdSpiCmdAnswerTypeR1);
+        sd_spi_send_cmd(SD_CMD18_READ_MULT_BLOCK, block_address, 0xFF, SdSpiCmdAnswerTypeR1);
+    if(response.r1 != SdSpi_R1_NO_ERROR) {
+        sd_spi_deselect_card_and_purge();
+        return FuriStatusError;
+    }
+
+    while(blocks--) {
+        // Wait for the data start token, card sends it before every block
+        if(sd_spi_wait_for_data(SD_TOKEN_START_DATA_MULTIPLE_BLOCK_READ, timeout_ms) !=
+           FuriStatusOk) {
+            status = FuriStatusError;
+            break;
+        }
+
+        // Read the data block
+        sd_spi_read_bytes_dma((uint8_t*)data + offset, SD_BLOCK_SIZE);
+        sd_spi_purge_crc();
+
+        // increase offset
+        offset += SD_BLOCK_SIZE;
+    }
+
+    // Always terminate transmission, even on error
+    if(sd_spi_stop_transmission(timeout_ms) != FuriStatusOk) {
+        status = FuriStatusError;
+    }
+
     sd_spi_deselect_card_and_purge();
 
-    if(response.r1 != SdSpi_R1_NO_ERROR) {
+    return status;
+}
+
+static FuriStatus
+    sd_spi_cmd_read_blocks(uint32_t* data, uint32_t address, uint32_t blocks, uint32_t timeout_ms) {
+    if(sd_spi_set_block_len() != FuriStatusOk) {
         return FuriStatusError;
     }
 
-    if(!sd_high_capacity) {
-        block_address = address * SD_BLOCK_SIZE;
+    uint32_t block_address = sd_spi_get_block_address(address);
+
+    if(blocks > 1) {
+        return sd_spi_cmd_read_multiple_blocks(data, block_address, blocks, timeout_ms);
+    } else {
+        return sd_spi_cmd_read_single_blocks(data, block_address, blocks, timeout_ms);
     }
+}
+
+static FuriStatus sd_spi_cmd_write_single_blocks(
+    const uint32_t* data,
+    uint32_t block_address,
+    uint32_t blocks,
+    uint32_t timeout_ms) {
+    SdSpiCmdAnswer response;
+    uint32_t offset = 0;
 
     while(blocks--) {
         // CMD24 (WRITE_SINGLE_BLOCK): R1 response (0x00: no errors)
@@ -791,16 +880,94 @@ static FuriStatus sd_spi_cmd_write_blocks(
         offset += SD_BLOCK_SIZE;
 
         // increase block address
-        if(sd_high_capacity) {
-            block_address += 1;
-        } else {
-            block_address += SD_BLOCK_SIZE;
-        }
+        block_address = sd_spi_get_next_block_address(block_address);
     }
 
     return FuriStatusOk;
 }
 
+static FuriStatus sd_spi_cmd_write_multiple_blocks(
+    const uint32_t* data,
+    uint32_t block_address,
+    uint32_t blocks,
+    uint32_t timeout_ms) {
+    FuriStatus status = FuriStatusOk;
+    uint32_t offset = 0;
+
+    // CMD55 (APP_CMD) before any ACMD command: R1 response (0x00: no errors)
+    sd_spi_send_cmd(SD_CMD55_APP_CMD, 0, 0xFF, SdSpiCmdAnswerTypeR1);
+    sd_spi_deselect_card_and_purge();
+
+    // ACMD23 (SET_WR_BLK_ERASE_COUNT): pre-erase hint, R1 response (0x00: no errors)
+    // Failure is not fatal, card will just erase blocks one by one
+    SdSpiCmdAnswer response = sd_spi_send_cmd(
+        SD_ACMD23_SET_WR_BLK_ERASE_COUNT, blocks & 0x7FFFFF, 0xFF, SdSpiCmdAnswerTypeR1);
+    sd_spi_deselect_card_and_purge();
+
+    if(response.r1 != SdSpi_R1_NO_ERROR) {
+        sd_spi_debug("ACMD23 failed");
+    }
+
+    // CMD25 (WRITE_MULT_BLOCK): R1 response (0x00: no errors)
+    response =
+        sd_spi_send_cmd(SD_CMD25_WRITE_MULT_BLOCK, block_address, 0xFF, SdSpiCmdAnswerTypeR1);
+    if(response.r1 != SdSpi_R1_NO_ERROR) {
+        sd_spi_deselect_card_and_purge();
+        return FuriStatusError;
+    }
+
+    // Send dummy byte for NWR timing : one byte between CMD_WRITE and TOKEN
+    sd_spi_write_byte(SD_DUMMY_BYTE);
+    sd_spi_write_byte(SD_DUMMY_BYTE);
+
+    while(blocks--) {
+        // Send the data start token, one per block
+        sd_spi_write_byte(SD_TOKEN_START_DATA_MULTIPLE_BLOCK_WRITE);
+        sd_spi_write_bytes_dma((uint8_t*)data + offset, SD_BLOCK_SIZE);
+        sd_spi_purge_crc();
+
+        // Read data response and wait while card is busy programming the block
+        if(sd_spi_get_data_response(timeout_ms) != SdSpiDataResponceOK) {
+            status = FuriStatusError;
+            break;
+        }
+
+        // increase offset
+        offset += SD_BLOCK_SIZE;
+    }
+
+    // Always terminate transmission with stop token, even on error
+    sd_spi_write_byte(SD_TOKEN_STOP_DATA_MULTIPLE_BLOCK_WRITE);
+
+    // Skip one byte before busy signal and wait while card is busy
+    sd_spi_read_byte();
+    if(sd_spi_wait_for_data(SD_DUMMY_BYTE, timeout_ms) != FuriStatusOk) {
+        status = FuriStatusError;
+    }
+
+    sd_spi_deselect_card_and_purge();
+
+    return status;
+}
+
+static FuriStatus sd_spi_cmd_write_blocks(
+    const uint32_t* data,
+    uint32_t address,
+    uint32_t blocks,
+    uint32_t timeout_ms) {
+    if(sd_spi_set_block_len() != FuriStatusOk) {
+        return FuriStatusError;
+    }
+
+    uint32_t block_address = sd_spi_get_block_address(address);
+
+    if(blocks > 1) {
+        return sd_spi_cmd_write_multiple_blocks(data, block_address, blocks, timeout_ms);
+    } else {
+        return sd_spi_cmd_write_single_blocks(data, block_address, blocks, timeout_ms);
+    }
+}
+
 static FuriStatus sd_spi_get_card_state(void) {
     SdSpiCmdAnswer response;
 
@@ -816,6 +983,18 @@ static FuriStatus sd_spi_get_card_state(void) {
     return FuriStatusError;
 }
 
+static inline void sd_cache_lock(void) {
+    if(sd_cache_mutex) {
+        furi_check(furi_mutex_acquire(sd_cache_mutex, FuriWaitForever) == FuriStatusOk);
+    }
+}
+
+static inline void sd_cache_unlock(void) {
+    if(sd_cache_mutex) {
+        furi_check(furi_mutex_release(sd_cache_mutex) == FuriStatusOk);
+    }
+}
+
 static inline bool sd_cache_get(uint32_t address, uint32_t* data) {
     uint8_t* cached_data = sector_cache_get(address);
     if(cached_data) {
@@ -829,19 +1008,31 @@ static inline void sd_cache_put(uint32_t address, uint32_t* data) {
     sector_cache_put(address, (uint8_t*)data);
 }
 
-static inline void sd_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
-    sector_cache_invalidate_range(start_sector, end_sector);
+static inline bool sd_cache_write(uint32_t address, const uint32_t* data) {
+    return sector_cache_write(address, (const uint8_t*)data);
+}
+
+static inline bool sd_cache_flush_range(uint32_t start_sector, uint32_t end_sector) {
+    return sector_cache_flush_range(start_sector, end_sector);
+}
+
+static inline bool sd_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
+    return sector_cache_invalidate_range(start_sector, end_sector);
 }
 
 static inline void sd_cache_invalidate_all(void) {
     sector_cache_init();
 }
 
-static FuriStatus sd_device_read(uint32_t* buff, uint32_t sector, uint32_t count) {
-    FuriStatus status = FuriStatusError;
+static void sd_device_yield(void) {
+    // Display shares the bus, it should not wait for the whole transfer
+    if(furi_hal_spi_yield(&furi_hal_spi_bus_handle_sd_fast)) {
+        furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_fast;
+    }
+}
 
-    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_fast);
-    furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_fast;
+static FuriStatus sd_device_read_burst(uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = FuriStatusError;
 
     if(sd_spi_cmd_read_blocks(buff, sector, count, SD_TIMEOUT_MS) == FuriStatusOk) {
         FuriHalCortexTimer timer = furi_hal_cortex_timer_get(SD_TIMEOUT_MS * 1000);
@@ -857,18 +1048,37 @@ static FuriStatus sd_device_read(uint32_t* buff, uint32_t sector, uint32_t count
         } while(status != FuriStatusOk);
     }
 
-    furi_hal_sd_spi_handle = NULL;
-    furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_fast);
-
     return status;
 }
 
-static FuriStatus sd_device_write(const uint32_t* buff, uint32_t sector, uint32_t count) {
+static FuriStatus sd_device_read(uint32_t* buff, uint32_t sector, uint32_t count) {
     FuriStatus status = FuriStatusError;
 
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_fast);
     furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_fast;
 
+    while(count > 0) {
+        const uint32_t burst = MIN(count, (uint32_t)SD_BURST_BLOCKS);
+        status = sd_device_read_burst(buff, sector, burst);
+        if(status != FuriStatusOk) break;
+
+        buff += burst * SD_BLOCK_SIZE / sizeof(uint32_t);
+        sector += burst;
+        count -= burst;
+
+        if(count > 0) sd_device_yield();
+    }
+
+    furi_hal_sd_spi_handle = NULL;
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_fast);
+
+    return status;
+}
+
+static FuriStatus
+    sd_device_write_burst(const uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = FuriStatusError;
+
     if(sd_spi_cmd_write_blocks(buff, sector, count, SD_TIMEOUT_MS) == FuriStatusOk) {
         FuriHalCortexTimer timer = furi_hal_cortex_timer_get(SD_TIMEOUT_MS * 1000);
 
@@ -885,12 +1095,87 @@ static FuriStatus sd_device_write(const uint32_t* buff, uint32_t sector, uint32_
         } while(status != FuriStatusOk);
     }
 
+    return status;
+}
+
+static FuriStatus sd_device_write(const uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = FuriStatusError;
+
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_sd_fast);
+    furi_hal_sd_spi_handle = &furi_hal_spi_bus_handle_sd_fast;
+
+    while(count > 0) {
+        const uint32_t burst = MIN(count, (uint32_t)SD_BURST_BLOCKS);
+        status = sd_device_write_burst(buff, sector, burst);
+        if(status != FuriStatusOk) break;
+
+        buff += burst * SD_BLOCK_SIZE / sizeof(uint32_t);
+        sector += burst;
+        count -= burst;
+
+        if(count > 0) sd_device_yield();
+    }
+
     furi_hal_sd_spi_handle = NULL;
     furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_fast);
 
     return status;
 }
 
+static FuriStatus sd_device_read_with_retry(uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = sd_device_read(buff, sector, count);
+
+    if(status != FuriStatusOk) {
+        uint8_t counter = furi_hal_sd_max_mount_retry_count();
+
+        while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
+            if((counter % 2) == 0) {
+                // power reset sd card
+                status = furi_hal_sd_init(true);
+            } else {
+                status = furi_hal_sd_init(false);
+            }
+
+            if(status == FuriStatusOk) {
+                status = sd_device_read(buff, sector, count);
+            }
+            counter--;
+        }
+    }
+
+    return status;
+}
+
+static FuriStatus
+    sd_device_write_with_retry(const uint32_t* buff, uint32_t sector, uint32_t count) {
+    FuriStatus status = sd_device_write(buff, sector, count);
+
+    if(status != FuriStatusOk) {
+        uint8_t counter = furi_hal_sd_max_mount_retry_count();
+
+        while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
+            if((counter % 2) == 0) {
+                // power reset sd card
+                status = furi_hal_sd_init(true);
+            } else {
+                status = furi_hal_sd_init(false);
+            }
+
+            if(status == FuriStatusOk) {
+                status = sd_device_write(buff, sector, count);
+            }
+            counter--;
+        }
+    }
+
+    return status;
+}
+
+static bool sd_cache_write_back_callback(uint32_t n_sector, const uint8_t* data, void* context) {
+    UNUSED(context);
+    return sd_device_write_with_retry((const uint32_t*)data, n_sector, 1) == FuriStatusOk;
+}
+
 void furi_hal_sd_presence_init(void) {
     // low speed input with pullup
     furi_hal_gpio_init(&gpio_sdcard_cd, GpioModeInput, GpioPullUp, GpioSpeedLow);
@@ -955,6 +1240,9 @@ FuriStatus furi_hal_sd_init(bool power_reset) {
 
     // Init sector cache
     sector_cache_init();
+    if(sd_cache_write_back) {
+        sector_cache_set_write_back(sd_cache_write_back_callback, NULL);
+    }
 
     return status;
 }
@@ -977,35 +1265,28 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
     FuriStatus status;
     bool single_sector = count == 1;
 
-    if(single_sector) {
-        if(sd_cache_get(sector, buff)) {
-            return FuriStatusOk;
-        }
-    }
-
-    status = sd_device_read(buff, sector, count);
+    sd_cache_lock();
 
-    if(status != FuriStatusOk) {
-        uint8_t counter = furi_hal_sd_max_mount_retry_count();
-
-        while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
-            if((counter % 2) == 0) {
-                // power reset sd card
-                status = furi_hal_sd_init(true);
-            } else {
-                status = furi_hal_sd_init(false);
+    do {
+        if(single_sector) {
+            if(sd_cache_get(sector, buff)) {
+                status = FuriStatusOk;
+                break;
             }
+        } else if(!sd_cache_flush_range(sector, sector + count - 1)) {
+            // Card must not return data older than pending writes
+            status = FuriStatusError;
+            break;
+        }
 
-            if(status == FuriStatusOk) {
-                status = sd_device_read(buff, sector, count);
-            }
-            counter--;
+        status = sd_device_read_with_retry(buff, sector, count);
+
+        if(single_sector && status == FuriStatusOk) {
+            sd_cache_put(sector, buff);
         }
-    }
+    } while(false);
 
-    if(single_sector && status == FuriStatusOk) {
-        sd_cache_put(sector, buff);
-    }
+    sd_cache_unlock();
 
     return status;
 }
@@ -1015,31 +1296,69 @@ FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint3
 
     FuriStatus status;
 
-    sd_cache_invalidate_range(sector, sector + count);
+    sd_cache_lock();
 
-    status = sd_device_write(buff, sector, count);
+    if(count == 1 && sd_cache_write(sector, buff)) {
+        status = FuriStatusOk;
+    } else if(!sd_cache_invalidate_range(sector, sector + count - 1)) {
+        status = FuriStatusError;
+    } else {
+        status = sd_device_write_with_retry(buff, sector, count);
+    }
 
-    if(status != FuriStatusOk) {
-        uint8_t counter = furi_hal_sd_max_mount_retry_count();
+    sd_cache_unlock();
 
-        while(status != FuriStatusOk && counter > 0 && furi_hal_sd_is_present()) {
-            if((counter % 2) == 0) {
-                // power reset sd card
-                status = furi_hal_sd_init(true);
-            } else {
-                status = furi_hal_sd_init(false);
-            }
+    return status;
+}
 
-            if(status == FuriStatusOk) {
-                status = sd_device_write(buff, sector, count);
-            }
-            counter--;
+FuriStatus furi_hal_sd_flush(void) {
+    FuriStatus status = FuriStatusOk;
+
+    sd_cache_lock();
+
+    if(!sd_cache_flush_range(0, UINT32_MAX)) {
+        status = FuriStatusError;
+        if(!furi_hal_sd_is_present()) {
+            // Card is gone, pending data must not end up on the next one
+            sector_cache_discard();
         }
     }
 
+    sd_cache_unlock();
+
     return status;
 }
 
+FuriStatus furi_hal_sd_set_write_back(bool enable) {
+    FuriStatus status = FuriStatusOk;
+
+    if(enable && !sd_cache_mutex) {
+        sd_cache_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    }
+
+    sd_cache_lock();
+
+    if(enable) {
+        sector_cache_set_write_back(sd_cache_write_back_callback, NULL);
+        sd_cache_write_back = true;
+    } else if(sd_cache_write_back) {
+        if(sd_cache_flush_range(0, UINT32_MAX)) {
+            sector_cache_set_write_back(NULL, NULL);
+            sd_cache_write_back = false;
+        } else {
+            status = FuriStatusError;
+        }
+    }
+
+    sd_cache_unlock();
+
+    return status;
+}
+
+bool furi_hal_sd_is_write_back_enabled(void) {
+    return sd_cache_write_back;
+}
+
 FuriStatus furi_hal_sd_info(FuriHalSdInfo* info) {
     furi_check(info);
 
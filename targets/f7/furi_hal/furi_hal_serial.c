@@ -9,6 +9,7 @@
 #include <furi_hal_resources.h>
 #include <furi_hal_interrupt.h>
 #include <furi_hal_bus.h>
+#include <furi_hal_dma.h>
 
 #include <furi.h>
 
@@ -20,6 +21,10 @@
 #define FURI_HAL_SERIAL_LPUART_DMA_INSTANCE (DMA1)
 #define FURI_HAL_SERIAL_LPUART_DMA_CHANNEL  (LL_DMA_CHANNEL_7)
 
+// Single TX channel is shared by both serials and pulse_reader, owned through furi_hal_dma
+#define FURI_HAL_SERIAL_TX_DMA_INSTANCE (DMA1)
+#define FURI_HAL_SERIAL_TX_DMA_CHANNEL  (LL_DMA_CHANNEL_5)
+
 typedef struct {
     uint8_t* buffer_rx_ptr;
     size_t buffer_rx_index_write;
@@ -86,6 +91,25 @@ static const FuriHalSerialConfig furi_hal_serial_config[FuriHalSerialIdMax] = {
 
 static FuriHalSerial furi_hal_serial[FuriHalSerialIdMax] = {0};
 
+typedef struct {
+    const uint8_t* buffer;
+    size_t size;
+    FuriHalSerialDmaTxCallback callback;
+    void* context;
+} FuriHalSerialDmaTxItem;
+
+typedef struct {
+    FuriHalSerialHandle* handle; // Channel owner, NULL if channel is not configured
+    FuriHalSerialDmaTxItem queue[FURI_HAL_SERIAL_DMA_TX_QUEUE_SIZE];
+    volatile size_t head;
+    volatile size_t count; // Queued buffers, including the one being transferred
+} FuriHalSerialDmaTx;
+
+static FuriHalSerialDmaTx furi_hal_serial_dma_tx_state = {0};
+
+static void furi_hal_serial_dma_tx_release(FuriHalSerialHandle* handle);
+static void furi_hal_serial_dma_tx_wait(FuriHalSerialHandle* handle);
+
 static size_t furi_hal_serial_dma_bytes_available(FuriHalSerialId ch);
 
 static void furi_hal_serial_async_rx_configure(
@@ -581,6 +605,7 @@ void furi_hal_serial_set_br(FuriHalSerialHandle* handle, uint32_t baud) {
     uint32_t prescaler = furi_hal_serial_get_prescaler(handle, baud);
     if(handle->id == FuriHalSerialIdUsart) {
         if(LL_USART_IsEnabled(USART1)) {
+            furi_hal_serial_dma_tx_wait(handle);
             // Wait for transfer complete flag
             while(!LL_USART_IsActiveFlag_TC(USART1))
                 ;
@@ -593,6 +618,7 @@ void furi_hal_serial_set_br(FuriHalSerialHandle* handle, uint32_t baud) {
         }
     } else if(handle->id == FuriHalSerialIdLpuart) {
         if(LL_LPUART_IsEnabled(LPUART1)) {
+            furi_hal_serial_dma_tx_wait(handle);
             // Wait for transfer complete flag
             while(!LL_LPUART_IsActiveFlag_TC(LPUART1))
                 ;
@@ -608,6 +634,7 @@ void furi_hal_serial_set_br(FuriHalSerialHandle* handle, uint32_t baud) {
 void furi_hal_serial_deinit(FuriHalSerialHandle* handle) {
     furi_check(handle);
     furi_hal_serial_async_rx_configure(handle, NULL, NULL);
+    furi_hal_serial_dma_tx_release(handle);
     if(handle->id == FuriHalSerialIdUsart) {
         if(furi_hal_bus_is_enabled(FuriHalBusUSART1)) {
             furi_hal_bus_disable(FuriHalBusUSART1);
@@ -661,6 +688,7 @@ void furi_hal_serial_tx(FuriHalSerialHandle* handle, const uint8_t* buffer, size
 
     if(handle->id == FuriHalSerialIdUsart) {
         if(LL_USART_IsEnabled(USART1) == 0) return;
+        furi_hal_serial_dma_tx_wait(handle);
 
         while(buffer_size > 0) {
             while(!LL_USART_IsActiveFlag_TXE(USART1))
@@ -673,6 +701,7 @@ void furi_hal_serial_tx(FuriHalSerialHandle* handle, const uint8_t* buffer, size
 
     } else if(handle->id == FuriHalSerialIdLpuart) {
         if(LL_LPUART_IsEnabled(LPUART1) == 0) return;
+        furi_hal_serial_dma_tx_wait(handle);
 
         while(buffer_size > 0) {
             while(!LL_LPUART_IsActiveFlag_TXE(LPUART1))
@@ -690,11 +719,13 @@ void furi_hal_serial_tx_wait_complete(FuriHalSerialHandle* handle) {
     furi_check(handle);
     if(handle->id == FuriHalSerialIdUsart) {
         if(LL_USART_IsEnabled(USART1) == 0) return;
+        furi_hal_serial_dma_tx_wait(handle);
 
         while(!LL_USART_IsActiveFlag_TC(USART1))
             ;
     } else if(handle->id == FuriHalSerialIdLpuart) {
         if(LL_LPUART_IsEnabled(LPUART1) == 0) return;
+        furi_hal_serial_dma_tx_wait(handle);
 
         while(!LL_LPUART_IsActiveFlag_TC(LPUART1))
             ;
@@ -910,6 +941,189 @@ void furi_hal_serial_dma_rx_stop(FuriHalSerialHandle* handle) {
     furi_hal_serial_dma_configure(handle, NULL, NULL);
 }
 
+static void furi_hal_serial_dma_tx_start(void) {
+    const FuriHalSerialDmaTxItem* item =
+        &furi_hal_serial_dma_tx_state.queue[furi_hal_serial_dma_tx_state.head];
+
+    LL_DMA_SetMemoryAddress(
+        FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL, (uint32_t)item->buffer);
+    LL_DMA_SetDataLength(FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL, item->size);
+    LL_DMA_EnableChannel(FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL);
+}
+
+static void furi_hal_serial_dma_tx_isr(void* context) {
+    UNUSED(context);
+#if FURI_HAL_SERIAL_TX_DMA_CHANNEL == LL_DMA_CHANNEL_5
+    if(!LL_DMA_IsActiveFlag_TC5(FURI_HAL_SERIAL_TX_DMA_INSTANCE) &&
+       !LL_DMA_IsActiveFlag_TE5(FURI_HAL_SERIAL_TX_DMA_INSTANCE)) {
+        return;
+    }
+    LL_DMA_ClearFlag_GI5(FURI_HAL_SERIAL_TX_DMA_INSTANCE);
+#else
+#error Update this code. Would you kindly?
+#endif
+
+    LL_DMA_DisableChannel(FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL);
+
+    FuriHalSerialDmaTx* state = &furi_hal_serial_dma_tx_state;
+    const FuriHalSerialDmaTxItem item = state->queue[state->head];
+    state->head = (state->head + 1) % FURI_HAL_SERIAL_DMA_TX_QUEUE_SIZE;
+    state->count--;
+
+    // Keep the line busy, refill the queue from the callback
+    if(state->count) {
+        furi_hal_serial_dma_tx_start();
+    } else {
+        furi_hal_dma_channel_release(
+            FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL);
+    }
+
+    if(item.callback) {
+        item.callback(state->handle, item.context);
+    }
+}
+
+static void furi_hal_serial_dma_tx_set_request(FuriHalSerialHandle* handle, bool enable) {
+    if(handle->id == FuriHalSerialIdUsart) {
+        if(enable) {
+            LL_USART_EnableDMAReq_TX(USART1);
+        } else {
+            LL_USART_DisableDMAReq_TX(USART1);
+        }
+    } else if(handle->id == FuriHalSerialIdLpuart) {
+        if(enable) {
+            LL_LPUART_EnableDMAReq_TX(LPUART1);
+        } else {
+            LL_LPUART_DisableDMAReq_TX(LPUART1);
+        }
+    }
+}
+
+// Called in critical section with empty queue
+static void furi_hal_serial_dma_tx_setup(FuriHalSerialHandle* handle) {
+    FuriHalSerialDmaTx* state = &furi_hal_serial_dma_tx_state;
+
+    if(state->handle) {
+        furi_hal_serial_dma_tx_set_request(state->handle, false);
+    } else {
+        furi_hal_interrupt_set_isr(FuriHalInterruptIdDma1Ch5, furi_hal_serial_dma_tx_isr, NULL);
+    }
+
+    LL_DMA_ConfigTransfer(
+        FURI_HAL_SERIAL_TX_DMA_INSTANCE,
+        FURI_HAL_SERIAL_TX_DMA_CHANNEL,
+        LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_MODE_NORMAL | LL_DMA_PERIPH_NOINCREMENT |
+            LL_DMA_MEMORY_INCREMENT | LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE |
+            LL_DMA_PRIORITY_MEDIUM);
+    LL_DMA_SetPeriphAddress(
+        FURI_HAL_SERIAL_TX_DMA_INSTANCE,
+        FURI_HAL_SERIAL_TX_DMA_CHANNEL,
+        (uint32_t) & (furi_hal_serial_config[handle->id].periph->TDR));
+    LL_DMA_SetPeriphRequest(
+        FURI_HAL_SERIAL_TX_DMA_INSTANCE,
+        FURI_HAL_SERIAL_TX_DMA_CHANNEL,
+        handle->id == FuriHalSerialIdUsart ? LL_DMAMUX_REQ_USART1_TX : LL_DMAMUX_REQ_LPUART1_TX);
+
+#if FURI_HAL_SERIAL_TX_DMA_CHANNEL == LL_DMA_CHANNEL_5
+    LL_DMA_ClearFlag_GI5(FURI_HAL_SERIAL_TX_DMA_INSTANCE);
+#else
+#error Update this code. Would you kindly?
+#endif
+
+    LL_DMA_EnableIT_TC(FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL);
+    LL_DMA_EnableIT_TE(FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL);
+
+    furi_hal_serial_dma_tx_set_request(handle, true);
+    state->handle = handle;
+}
+
+static void furi_hal_serial_dma_tx_release(FuriHalSerialHandle* handle) {
+    FuriHalSerialDmaTx* state = &furi_hal_serial_dma_tx_state;
+    if(state->handle != handle) return;
+
+    // Pending buffers are dropped, their callbacks are never called
+    FURI_CRITICAL_ENTER();
+    if(state->count) {
+        // Channel is still ours, it is released as soon as the queue drains
+        LL_DMA_DisableChannel(FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL);
+        LL_DMA_DisableIT_TC(FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL);
+        LL_DMA_DisableIT_TE(FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL);
+#if FURI_HAL_SERIAL_TX_DMA_CHANNEL == LL_DMA_CHANNEL_5
+        LL_DMA_ClearFlag_GI5(FURI_HAL_SERIAL_TX_DMA_INSTANCE);
+#else
+#error Update this code. Would you kindly?
+#endif
+        LL_DMA_DeInit(FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL);
+        furi_hal_dma_channel_release(
+            FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL);
+    }
+    furi_hal_serial_dma_tx_set_request(handle, false);
+
+    state->handle = NULL;
+    state->head = 0;
+    state->count = 0;
+    FURI_CRITICAL_EXIT();
+
+    furi_hal_interrupt_set_isr(FuriHalInterruptIdDma1Ch5, NULL, NULL);
+}
+
+static void furi_hal_serial_dma_tx_wait(FuriHalSerialHandle* handle) {
+    while(furi_hal_serial_dma_tx_state.handle == handle && furi_hal_serial_dma_tx_state.count)
+        ;
+}
+
+bool furi_hal_serial_dma_tx(
+    FuriHalSerialHandle* handle,
+    const uint8_t* buffer,
+    size_t buffer_size,
+    FuriHalSerialDmaTxCallback callback,
+    void* context) {
+    furi_check(handle);
+    furi_check(handle->id < FuriHalSerialIdMax);
+    furi_check(buffer);
+    furi_check(buffer_size > 0 && buffer_size <= UINT16_MAX);
+
+    // Disabled serial would never drain the queue
+    if(!LL_USART_IsEnabled(furi_hal_serial_config[handle->id].periph)) return false;
+
+    FuriHalSerialDmaTx* state = &furi_hal_serial_dma_tx_state;
+    bool result = false;
+
+    FURI_CRITICAL_ENTER();
+    do {
+        if(state->count == FURI_HAL_SERIAL_DMA_TX_QUEUE_SIZE) break;
+
+        if(!state->count) {
+            // Channel is shared with pulse_reader, it is owned only while the queue is not empty
+            if(!furi_hal_dma_channel_acquire(
+                   FURI_HAL_SERIAL_TX_DMA_INSTANCE, FURI_HAL_SERIAL_TX_DMA_CHANNEL)) {
+                break;
+            }
+            // Previous owner may have reconfigured the channel
+            furi_hal_serial_dma_tx_setup(handle);
+        } else if(state->handle != handle) {
+            // Channel is still serving the other serial
+            break;
+        }
+
+        const size_t index = (state->head + state->count) % FURI_HAL_SERIAL_DMA_TX_QUEUE_SIZE;
+        state->queue[index] = (FuriHalSerialDmaTxItem){
+            .buffer = buffer,
+            .size = buffer_size,
+            .callback = callback,
+            .context = context,
+        };
+        state->count++;
+
+        if(state->count == 1) furi_hal_serial_dma_tx_start();
+
+        result = true;
+    } while(false);
+    FURI_CRITICAL_EXIT();
+
+    return result;
+}
+
 void furi_hal_serial_enable_direction(
     FuriHalSerialHandle* handle,
     FuriHalSerialDirection direction) {
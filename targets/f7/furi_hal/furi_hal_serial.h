@@ -239,6 +239,46 @@ void furi_hal_serial_dma_rx_stop(FuriHalSerialHandle* handle);
  */
 size_t furi_hal_serial_dma_rx(FuriHalSerialHandle* handle, uint8_t* data, size_t len);
 
+#define FURI_HAL_SERIAL_DMA_TX_QUEUE_SIZE (4u)
+
+/** Transmit DMA callback
+ *
+ * @warning    DMA Callback will be called in interrupt context, ensure thread
+ *             safety on your side.
+ *
+ * @param      handle   Serial handle
+ * @param      context  Callback context provided earlier
+ */
+typedef void (*FuriHalSerialDmaTxCallback)(FuriHalSerialHandle* handle, void* context);
+
+/** Queue buffer for DMA transmission
+ *
+ * Returns immediately, buffers are transmitted one after another in the order
+ * they were queued. Buffer must stay valid until its callback is called.
+ * `furi_hal_serial_tx` and `furi_hal_serial_tx_wait_complete` wait for the
+ * queue to drain first. Pending buffers are dropped on de-initialization.
+ *
+ * Both serials share one DMA channel with pulse_reader, it is taken by the
+ * serial that queues data first and released once its queue is empty. Fall
+ * back to `furi_hal_serial_tx` when buffer is refused.
+ *
+ * @param      handle       Serial handle
+ * @param      buffer       data
+ * @param      buffer_size  data size (in bytes), up to 65535
+ * @param      callback     called when buffer is transmitted, can be NULL
+ * @param      context      callback context
+ *
+ * @return     true if buffer is queued, false if queue is full, channel is
+ *             busy with the other serial or pulse_reader, or serial is not
+ *             enabled
+ */
+bool furi_hal_serial_dma_tx(
+    FuriHalSerialHandle* handle,
+    const uint8_t* buffer,
+    size_t buffer_size,
+    FuriHalSerialDmaTxCallback callback,
+    void* context);
+
 #ifdef __cplusplus
 }
 #endif
@@ -53,7 +53,10 @@ void furi_hal_spi_acquire(FuriHalSpiBusHandle* handle) {
 
     furi_hal_power_insomnia_enter();
 
+    // Counted before blocking, so the owner knows it should yield
+    __atomic_fetch_add(&handle->bus->waiting, 1, __ATOMIC_RELAXED);
     handle->bus->callback(handle->bus, FuriHalSpiBusEventLock);
+    __atomic_fetch_sub(&handle->bus->waiting, 1, __ATOMIC_RELAXED);
     handle->bus->callback(handle->bus, FuriHalSpiBusEventActivate);
 
     furi_check(handle->bus->current_handle == NULL);
@@ -77,6 +80,22 @@ void furi_hal_spi_release(FuriHalSpiBusHandle* handle) {
     furi_hal_power_insomnia_exit();
 }
 
+bool furi_hal_spi_yield(FuriHalSpiBusHandle* handle) {
+    furi_check(handle);
+    furi_check(handle->bus->current_handle == handle);
+
+    if(__atomic_load_n(&handle->bus->waiting, __ATOMIC_RELAXED) == 0) {
+        return false;
+    }
+
+    // Bus mutex wakes the highest priority waiter, equal priority one needs a yield to run
+    furi_hal_spi_release(handle);
+    furi_thread_yield();
+    furi_hal_spi_acquire(handle);
+
+    return true;
+}
+
 static void furi_hal_spi_bus_end_txrx(FuriHalSpiBusHandle* handle, uint32_t timeout) {
     UNUSED(timeout); // FIXME
     while(LL_SPI_GetTxFIFOLevel(handle->bus->spi) != LL_SPI_TX_FIFO_EMPTY)
@@ -32,6 +32,7 @@ struct FuriHalSpiBus {
     SPI_TypeDef* spi;
     FuriHalSpiBusEventCallback callback;
     FuriHalSpiBusHandle* current_handle;
+    uint32_t waiting; /**< Handles blocked in furi_hal_spi_acquire, used for yield decisions */
 };
 
 /** FuriHal spi handle states */
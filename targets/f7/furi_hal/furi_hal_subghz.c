@@ -58,6 +58,8 @@ volatile FuriHalSubGhz furi_hal_subghz = {
     .async_mirror_pin = NULL,
 };
 
+static CC1101CalibrationCache furi_hal_subghz_calibration_cache = {0};
+
 void furi_hal_subghz_set_async_mirror_pin(const GpioPin* pin) {
     furi_hal_subghz.async_mirror_pin = pin;
 }
@@ -367,10 +369,9 @@ uint32_t furi_hal_subghz_set_frequency(uint32_t value) {
     }
 
     furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
-    uint32_t real_frequency = cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, value);
-    cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
-
-    furi_check(cc1101_wait_status_state(&furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
+    uint32_t real_frequency = cc1101_set_frequency_calibrated(
+        &furi_hal_spi_bus_handle_subghz, &furi_hal_subghz_calibration_cache, value);
+    furi_check(real_frequency);
 
     furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
     return real_frequency;
@@ -426,7 +427,7 @@ volatile uint32_t furi_hal_subghz_capture_delta_duration = 0;
 volatile FuriHalSubGhzCaptureCallback furi_hal_subghz_capture_callback = NULL;
 volatile void* furi_hal_subghz_capture_callback_context = NULL;
 
-static void furi_hal_subghz_capture_ISR(void* context) {
+FURI_RAMFUNC static void furi_hal_subghz_capture_ISR(void* context) {
     UNUSED(context);
     // Channel 1
     if(LL_TIM_IsActiveFlag_CC1(TIM2)) {
@@ -457,15 +458,18 @@ static void furi_hal_subghz_capture_ISR(void* context) {
     }
 }
 
-void furi_hal_subghz_start_async_rx(FuriHalSubGhzCaptureCallback callback, void* context) {
-    furi_check(furi_hal_subghz.state == SubGhzStateIdle);
-    furi_check(callback);
+typedef struct {
+    uint32_t* buffer;
+    size_t read;
+    bool skip_high;
+    FuriHalSubGhzCaptureBatchCallback callback;
+    void* callback_context;
+} FuriHalSubGhzAsyncRxDma;
 
-    furi_hal_subghz.state = SubGhzStateAsyncRx;
-
-    furi_hal_subghz_capture_callback = callback;
-    furi_hal_subghz_capture_callback_context = context;
+static FuriHalSubGhzAsyncRxDma furi_hal_subghz_async_rx_dma = {0};
 
+// Configures TIM2 to capture the high level on CH1 and the period on CH2
+static void furi_hal_subghz_async_rx_timer_init(void) {
     furi_hal_gpio_init_ex(
         &gpio_cc1101_g0, GpioModeAltFunctionPushPull, GpioPullNo, GpioSpeedLow, GpioAltFn1TIM2);
 
@@ -502,6 +506,18 @@ void furi_hal_subghz_start_async_rx(FuriHalSubGhzCaptureCallback callback, void*
         TIM2,
         LL_TIM_CHANNEL_CH2,
         LL_TIM_IC_FILTER_FDIV32_N8); // Capture filter: 1/(64000000/64/4/32*8) = 16us
+}
+
+void furi_hal_subghz_start_async_rx(FuriHalSubGhzCaptureCallback callback, void* context) {
+    furi_check(furi_hal_subghz.state == SubGhzStateIdle);
+    furi_check(callback);
+
+    furi_hal_subghz.state = SubGhzStateAsyncRx;
+
+    furi_hal_subghz_capture_callback = callback;
+    furi_hal_subghz_capture_callback_context = context;
+
+    furi_hal_subghz_async_rx_timer_init();
 
     // ISR setup
     furi_hal_interrupt_set_isr(FuriHalInterruptIdTIM2, furi_hal_subghz_capture_ISR, NULL);
@@ -526,6 +542,131 @@ void furi_hal_subghz_start_async_rx(FuriHalSubGhzCaptureCallback callback, void*
     furi_hal_subghz_capture_delta_duration = 0;
 }
 
+// Hands every complete (high, period) pair written by DMA to the callback
+FURI_RAMFUNC static void furi_hal_subghz_async_rx_dma_drain(void) {
+    FuriHalSubGhzAsyncRxDma* rx = &furi_hal_subghz_async_rx_dma;
+    const size_t size = FURI_HAL_SUBGHZ_ASYNC_RX_BUFFER_FULL * 2;
+    // Whole pairs only, a burst may be half way through
+    const size_t write = (size - LL_DMA_GetDataLength(SUBGHZ_DMA_CH1_DEF)) & ~1U;
+
+    LevelDuration pulses[FURI_HAL_SUBGHZ_ASYNC_RX_BATCH_SIZE];
+    size_t count = 0;
+
+    while(rx->read != write % size) {
+        const uint32_t high = rx->buffer[rx->read];
+        const uint32_t period = rx->buffer[rx->read + 1];
+        rx->read = (rx->read + 2) % size;
+
+        if(!rx->skip_high) {
+            pulses[count++] = level_duration_make(true, high);
+        }
+        rx->skip_high = false;
+        pulses[count++] = level_duration_make(false, period - high);
+
+        if(count >= FURI_HAL_SUBGHZ_ASYNC_RX_BATCH_SIZE - 1) {
+            rx->callback(pulses, count, rx->callback_context);
+            count = 0;
+        }
+    }
+
+    if(count) {
+        rx->callback(pulses, count, rx->callback_context);
+    }
+}
+
+FURI_RAMFUNC static void furi_hal_subghz_async_rx_dma_isr(void* context) {
+    UNUSED(context);
+
+#if SUBGHZ_DMA_CH1_CHANNEL == LL_DMA_CHANNEL_1
+    if(LL_DMA_IsActiveFlag_HT1(SUBGHZ_DMA)) {
+        LL_DMA_ClearFlag_HT1(SUBGHZ_DMA);
+    }
+    if(LL_DMA_IsActiveFlag_TC1(SUBGHZ_DMA)) {
+        LL_DMA_ClearFlag_TC1(SUBGHZ_DMA);
+    }
+#else
+#error Update this code. Would you kindly?
+#endif
+
+    furi_hal_subghz_async_rx_dma_drain();
+}
+
+// No rising edge for a while: flush the pairs the DMA has not reported yet
+static void furi_hal_subghz_async_rx_timeout_isr(void* context) {
+    UNUSED(context);
+    FuriHalSubGhzAsyncRxDma* rx = &furi_hal_subghz_async_rx_dma;
+
+    if(LL_TIM_IsActiveFlag_CC3(TIM2)) {
+        LL_TIM_ClearFlag_CC3(TIM2);
+        furi_hal_subghz_async_rx_dma_drain();
+
+        // Falling edge after the last pair, its burst comes with the next rising edge
+        if(LL_TIM_IsActiveFlag_CC1(TIM2) && !rx->skip_high) {
+            LevelDuration pulse = level_duration_make(true, LL_TIM_IC_GetCaptureCH1(TIM2));
+            rx->skip_high = true;
+            rx->callback(&pulse, 1, rx->callback_context);
+        }
+    }
+}
+
+void furi_hal_subghz_start_async_rx_dma(
+    FuriHalSubGhzCaptureBatchCallback callback,
+    void* context) {
+    furi_check(furi_hal_subghz.state == SubGhzStateIdle);
+    furi_check(callback);
+
+    furi_hal_subghz.state = SubGhzStateAsyncRx;
+
+    FuriHalSubGhzAsyncRxDma* rx = &furi_hal_subghz_async_rx_dma;
+    rx->callback = callback;
+    rx->callback_context = context;
+    rx->read = 0;
+    rx->skip_high = false;
+    rx->buffer = malloc(FURI_HAL_SUBGHZ_ASYNC_RX_BUFFER_FULL * 2 * sizeof(uint32_t));
+
+    furi_hal_subghz_async_rx_timer_init();
+
+    // Every rising edge reads CCR1 (high level) and CCR2 (period) in one burst
+    LL_TIM_ConfigDMABurst(TIM2, LL_TIM_DMABURST_BASEADDR_CCR1, LL_TIM_DMABURST_LENGTH_2TRANSFERS);
+    LL_TIM_EnableDMAReq_CC2(TIM2);
+
+    // Configure DMA
+    LL_DMA_InitTypeDef dma_config = {0};
+    dma_config.PeriphOrM2MSrcAddress = (uint32_t) & (TIM2->DMAR);
+    dma_config.MemoryOrM2MDstAddress = (uint32_t)rx->buffer;
+    dma_config.Direction = LL_DMA_DIRECTION_PERIPH_TO_MEMORY;
+    dma_config.Mode = LL_DMA_MODE_CIRCULAR;
+    dma_config.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    dma_config.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    dma_config.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_WORD;
+    dma_config.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_WORD;
+    dma_config.NbData = FURI_HAL_SUBGHZ_ASYNC_RX_BUFFER_FULL * 2;
+    dma_config.PeriphRequest = LL_DMAMUX_REQ_TIM2_CH2;
+    dma_config.Priority = LL_DMA_PRIORITY_VERYHIGH;
+    LL_DMA_Init(SUBGHZ_DMA_CH1_DEF, &dma_config);
+    furi_hal_interrupt_set_isr(SUBGHZ_DMA_CH1_IRQ, furi_hal_subghz_async_rx_dma_isr, NULL);
+    LL_DMA_EnableIT_TC(SUBGHZ_DMA_CH1_DEF);
+    LL_DMA_EnableIT_HT(SUBGHZ_DMA_CH1_DEF);
+    LL_DMA_EnableChannel(SUBGHZ_DMA_CH1_DEF);
+
+    // Timer: channel 3 compare flushes partial batches after a quiet period
+    LL_TIM_OC_SetMode(TIM2, LL_TIM_CHANNEL_CH3, LL_TIM_OCMODE_FROZEN);
+    LL_TIM_OC_SetCompareCH3(TIM2, FURI_HAL_SUBGHZ_ASYNC_RX_TIMEOUT);
+    furi_hal_interrupt_set_isr(FuriHalInterruptIdTIM2, furi_hal_subghz_async_rx_timeout_isr, NULL);
+    LL_TIM_EnableIT_CC3(TIM2);
+
+    // Channels
+    LL_TIM_CC_EnableChannel(TIM2, LL_TIM_CHANNEL_CH1);
+    LL_TIM_CC_EnableChannel(TIM2, LL_TIM_CHANNEL_CH2);
+
+    // Start timer
+    LL_TIM_SetCounter(TIM2, 0);
+    LL_TIM_EnableCounter(TIM2);
+
+    // Switch to RX
+    furi_hal_subghz_rx();
+}
+
 void furi_hal_subghz_stop_async_rx(void) {
     furi_check(furi_hal_subghz.state == SubGhzStateAsyncRx);
     furi_hal_subghz.state = SubGhzStateIdle;
@@ -542,6 +683,14 @@ void furi_hal_subghz_stop_async_rx(void) {
     FURI_CRITICAL_EXIT();
     furi_hal_interrupt_set_isr(FuriHalInterruptIdTIM2, NULL, NULL);
 
+    // Deinitialize DMA, pairs not reported yet are dropped
+    if(furi_hal_subghz_async_rx_dma.buffer) {
+        LL_DMA_DeInit(SUBGHZ_DMA_CH1_DEF);
+        furi_hal_interrupt_set_isr(SUBGHZ_DMA_CH1_IRQ, NULL, NULL);
+        free(furi_hal_subghz_async_rx_dma.buffer);
+        furi_hal_subghz_async_rx_dma.buffer = NULL;
+    }
+
     furi_hal_gpio_init(&gpio_cc1101_g0, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
 }
 
@@ -21,6 +21,9 @@ extern "C" {
 #define FURI_HAL_SUBGHZ_ASYNC_TX_BUFFER_FULL (256u)
 #define FURI_HAL_SUBGHZ_ASYNC_TX_BUFFER_HALF (FURI_HAL_SUBGHZ_ASYNC_TX_BUFFER_FULL / 2)
 #define FURI_HAL_SUBGHZ_ASYNC_TX_GUARD_TIME  (999u)
+#define FURI_HAL_SUBGHZ_ASYNC_RX_BUFFER_FULL (256u) /**< DMA capture ring, in pulse pairs */
+#define FURI_HAL_SUBGHZ_ASYNC_RX_BATCH_SIZE  (32u) /**< Pulses per batch callback, at most */
+#define FURI_HAL_SUBGHZ_ASYNC_RX_TIMEOUT     (20000u) /**< Quiet time before flush, us */
 
 /** Switchable Radio Paths */
 typedef enum {
@@ -190,6 +193,28 @@ typedef void (*FuriHalSubGhzCaptureCallback)(bool level, uint32_t duration, void
  */
 void furi_hal_subghz_start_async_rx(FuriHalSubGhzCaptureCallback callback, void* context);
 
+/** Signal Timings Capture batch callback, called from interrupt
+ *
+ * Pulses alternate between high and low levels, starting with high.
+ */
+typedef void (*FuriHalSubGhzCaptureBatchCallback)(
+    const LevelDuration* pulses,
+    size_t count,
+    void* context);
+
+/** Enable signal timings capture with DMA Initializes GPIO, TIM2 and DMA2
+ *
+ * The timer writes captures straight into a ring buffer: there is no
+ * interrupt per edge. Pulses are delivered in batches at half and full
+ * transfer, and after FURI_HAL_SUBGHZ_ASYNC_RX_TIMEOUT without edges. The
+ * async mirror pin is not driven in this mode. Stop with
+ * furi_hal_subghz_stop_async_rx.
+ *
+ * @param      callback  FuriHalSubGhzCaptureBatchCallback
+ * @param      context   callback context
+ */
+void furi_hal_subghz_start_async_rx_dma(FuriHalSubGhzCaptureBatchCallback callback, void* context);
+
 /** Disable signal timings capture Resets GPIO and TIM2
  */
 void furi_hal_subghz_stop_async_rx(void);
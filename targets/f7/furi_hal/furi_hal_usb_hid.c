@@ -10,8 +10,12 @@
 #define HID_EP_IN 0x81
 #define HID_EP_SZ 0x10
 
+// Default endpoint polling interval, ms
 #define HID_INTERVAL 2
 
+// Reports waiting for endpoint, sent back to back from tx callback
+#define HID_REPORT_QUEUE_SIZE 8
+
 #define HID_VID_DEFAULT 0x046D
 #define HID_PID_DEFAULT 0xC529
 
@@ -30,8 +34,49 @@ enum HidReportId {
     ReportIdKeyboard = 1,
     ReportIdMouse = 2,
     ReportIdConsumer = 3,
+    ReportIdGamepad = 4,
 };
 
+/* Gamepad report descriptor, appended to hid_report_desc if enabled in config */
+// clang-format off
+#define HID_REPORT_DESC_GAMEPAD \
+    HID_USAGE_PAGE(HID_PAGE_DESKTOP), \
+    HID_USAGE(HID_DESKTOP_GAMEPAD), \
+    HID_COLLECTION(HID_APPLICATION_COLLECTION), \
+        HID_REPORT_ID(ReportIdGamepad), \
+        /* Input - Buttons */ \
+        HID_USAGE_PAGE(HID_PAGE_BUTTON), \
+        HID_USAGE_MINIMUM(1), \
+        HID_USAGE_MAXIMUM(16), \
+        HID_LOGICAL_MINIMUM(0), \
+        HID_LOGICAL_MAXIMUM(1), \
+        HID_REPORT_COUNT(16), \
+        HID_REPORT_SIZE(1), \
+        HID_INPUT(HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE), \
+        /* Input - Hat switch and padding */ \
+        HID_USAGE_PAGE(HID_PAGE_DESKTOP), \
+        HID_USAGE(HID_DESKTOP_HAT_SWITCH), \
+        HID_LOGICAL_MINIMUM(0), \
+        HID_LOGICAL_MAXIMUM(7), \
+        HID_REPORT_COUNT(1), \
+        HID_REPORT_SIZE(4), \
+        HID_INPUT(HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_NULLSTATE), \
+        HID_INPUT(HID_IOF_CONSTANT | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE), \
+        /* Input - Axes */ \
+        HID_USAGE(HID_DESKTOP_X), \
+        HID_USAGE(HID_DESKTOP_Y), \
+        HID_USAGE(HID_DESKTOP_Z), \
+        HID_USAGE(HID_DESKTOP_RZ), \
+        HID_LOGICAL_MINIMUM(-127), \
+        HID_LOGICAL_MAXIMUM(127), \
+        HID_REPORT_SIZE(8), \
+        HID_REPORT_COUNT(4), \
+        HID_INPUT(HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE), \
+    HID_END_COLLECTION
+// clang-format on
+
+#define HID_REPORT_DESC_GAMEPAD_SIZE (sizeof((const uint8_t[]){HID_REPORT_DESC_GAMEPAD}))
+
 /* HID report descriptor: keyboard + mouse + consumer control */
 static const uint8_t hid_report_desc[] = {
     // clang-format off
@@ -123,6 +168,8 @@ static const uint8_t hid_report_desc[] = {
         // Input - Consumer control keys
         HID_INPUT(HID_IOF_DATA | HID_IOF_ARRAY | HID_IOF_ABSOLUTE),
     HID_END_COLLECTION,
+
+    HID_REPORT_DESC_GAMEPAD,
     // clang-format on
 };
 
@@ -144,8 +191,8 @@ static struct usb_device_descriptor hid_device_desc = {
     .bNumConfigurations = 1,
 };
 
-/* Device configuration descriptor */
-static const struct HidConfigDescriptor hid_cfg_desc = {
+/* Device configuration descriptor, polling interval and report descriptor length set on init */
+static struct HidConfigDescriptor hid_cfg_desc = {
     .config =
         {
             .bLength = sizeof(struct usb_config_descriptor),
@@ -215,6 +262,16 @@ struct HidReportConsumer {
     uint16_t btn[HID_CONSUMER_MAX_KEYS];
 } FURI_PACKED;
 
+struct HidReportGamepad {
+    uint8_t report_id;
+    uint16_t buttons;
+    uint8_t hat;
+    int8_t x;
+    int8_t y;
+    int8_t z;
+    int8_t rz;
+} FURI_PACKED;
+
 struct HidReportLED {
     uint8_t report_id;
     uint8_t led_state;
@@ -226,6 +283,8 @@ static struct HidReport {
     struct HidReportConsumer consumer;
 } FURI_PACKED hid_report;
 
+static struct HidReportGamepad hid_report_gamepad;
+
 static void hid_init(usbd_device* dev, FuriHalUsbInterface* intf, void* ctx);
 static void hid_deinit(usbd_device* dev);
 static void hid_on_wakeup(usbd_device* dev);
@@ -256,6 +315,18 @@ static HidStateCallback callback;
 static void* cb_ctx;
 static uint8_t led_state;
 static bool boot_protocol = false;
+static uint8_t hid_interval = HID_INTERVAL;
+static bool hid_gamepad = false;
+
+typedef struct {
+    uint8_t len;
+    uint8_t data[HID_EP_SZ];
+} HidQueuedReport;
+
+static HidQueuedReport hid_queue[HID_REPORT_QUEUE_SIZE];
+static volatile uint8_t hid_queue_head = 0;
+static volatile uint8_t hid_queue_count = 0;
+static volatile bool hid_ep_busy = false;
 
 bool furi_hal_hid_is_connected(void) {
     return hid_connected;
@@ -308,7 +379,79 @@ bool furi_hal_hid_kb_release_all(void) {
     return hid_send_report(ReportIdKeyboard);
 }
 
+bool furi_hal_hid_kb_type(const uint16_t* buttons, size_t count) {
+    furi_check(buttons || (count == 0));
+
+    uint8_t held_btn[HID_KB_MAX_KEYS];
+    memcpy(held_btn, hid_report.keyboard.boot.btn, sizeof(held_btn));
+    const uint8_t held_mods = hid_report.keyboard.boot.mods;
+
+    bool state = true;
+    size_t button_nb = 0;
+    while((button_nb < count) && state) {
+        const uint8_t mods = buttons[button_nb] >> 8;
+        size_t group_size = 0;
+
+        for(; button_nb < count; button_nb++) {
+            const uint8_t key = buttons[button_nb] & 0xFF;
+            if((buttons[button_nb] >> 8) != mods) break;
+
+            uint8_t free_nb = HID_KB_MAX_KEYS;
+            bool conflict = false;
+            for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
+                uint8_t btn = hid_report.keyboard.boot.btn[key_nb];
+                if((key != 0) && (btn == key)) conflict = true;
+                if((btn == 0) && (free_nb == HID_KB_MAX_KEYS)) free_nb = key_nb;
+            }
+            // First key of group is always sent, like furi_hal_hid_kb_press() does
+            if((group_size > 0) && (conflict || ((key != 0) && (free_nb == HID_KB_MAX_KEYS))))
+                break;
+            if((key != 0) && (free_nb < HID_KB_MAX_KEYS)) {
+                hid_report.keyboard.boot.btn[free_nb] = key;
+            }
+            group_size++;
+        }
+
+        hid_report.keyboard.boot.mods = held_mods | mods;
+        state &= hid_send_report(ReportIdKeyboard);
+
+        memcpy(hid_report.keyboard.boot.btn, held_btn, sizeof(held_btn));
+        hid_report.keyboard.boot.mods = held_mods;
+        state &= hid_send_report(ReportIdKeyboard);
+    }
+
+    return state;
+}
+
+// Add movement to the mouse report that still waits for the endpoint
+static bool hid_mouse_move_coalesce(int8_t dx, int8_t dy) {
+    bool merged = false;
+
+    FURI_CRITICAL_ENTER();
+    if(hid_connected && hid_queue_count > 0) {
+        HidQueuedReport* report =
+            &hid_queue[(hid_queue_head + hid_queue_count - 1) % HID_REPORT_QUEUE_SIZE];
+        struct HidReportMouse* mouse = (struct HidReportMouse*)report->data;
+        if((report->len == sizeof(struct HidReportMouse)) &&
+           (mouse->report_id == ReportIdMouse) && (mouse->btn == hid_report.mouse.btn) &&
+           (mouse->wheel == 0)) {
+            const int16_t x = mouse->x + dx;
+            const int16_t y = mouse->y + dy;
+            if((x >= -127) && (x <= 127) && (y >= -127) && (y <= 127)) {
+                mouse->x = x;
+                mouse->y = y;
+                merged = true;
+            }
+        }
+    }
+    FURI_CRITICAL_EXIT();
+
+    return merged;
+}
+
 bool furi_hal_hid_mouse_move(int8_t dx, int8_t dy) {
+    if(hid_mouse_move_coalesce(dx, dy)) return true;
+
     hid_report.mouse.x = dx;
     hid_report.mouse.y = dy;
     bool state = hid_send_report(ReportIdMouse);
@@ -361,6 +504,53 @@ bool furi_hal_hid_consumer_key_release_all(void) {
     return hid_send_report(ReportIdConsumer);
 }
 
+// Replace the gamepad report that still waits for the endpoint if only axes differ
+static bool hid_gamepad_coalesce(void) {
+    bool replaced = false;
+
+    FURI_CRITICAL_ENTER();
+    if(hid_connected && hid_queue_count > 0) {
+        HidQueuedReport* report =
+            &hid_queue[(hid_queue_head + hid_queue_count - 1) % HID_REPORT_QUEUE_SIZE];
+        struct HidReportGamepad* gamepad = (struct HidReportGamepad*)report->data;
+        if((report->len == sizeof(struct HidReportGamepad)) &&
+           (gamepad->report_id == ReportIdGamepad) &&
+           (gamepad->buttons == hid_report_gamepad.buttons) &&
+           (gamepad->hat == hid_report_gamepad.hat)) {
+            memcpy(gamepad, &hid_report_gamepad, sizeof(struct HidReportGamepad));
+            replaced = true;
+        }
+    }
+    FURI_CRITICAL_EXIT();
+
+    return replaced;
+}
+
+bool furi_hal_hid_gamepad_press(uint16_t buttons) {
+    hid_report_gamepad.buttons |= buttons;
+    return hid_send_report(ReportIdGamepad);
+}
+
+bool furi_hal_hid_gamepad_release(uint16_t buttons) {
+    hid_report_gamepad.buttons &= ~buttons;
+    return hid_send_report(ReportIdGamepad);
+}
+
+bool furi_hal_hid_gamepad_set_hat(uint8_t hat) {
+    furi_check(hat <= HID_GAMEPAD_HAT_CENTERED);
+    hid_report_gamepad.hat = hat;
+    return hid_send_report(ReportIdGamepad);
+}
+
+bool furi_hal_hid_gamepad_set_axes(int8_t x, int8_t y, int8_t z, int8_t rz) {
+    hid_report_gamepad.x = x;
+    hid_report_gamepad.y = y;
+    hid_report_gamepad.z = z;
+    hid_report_gamepad.rz = rz;
+    if(hid_gamepad_coalesce()) return true;
+    return hid_send_report(ReportIdGamepad);
+}
+
 static void* hid_set_string_descr(char* str) {
     furi_assert(str);
 
@@ -377,11 +567,15 @@ static void* hid_set_string_descr(char* str) {
 static void hid_init(usbd_device* dev, FuriHalUsbInterface* intf, void* ctx) {
     UNUSED(intf);
     FuriHalUsbHidConfig* cfg = (FuriHalUsbHidConfig*)ctx;
-    if(hid_semaphore == NULL) hid_semaphore = furi_semaphore_alloc(1, 1);
+    if(hid_semaphore == NULL)
+        hid_semaphore = furi_semaphore_alloc(HID_REPORT_QUEUE_SIZE, HID_REPORT_QUEUE_SIZE);
     usb_dev = dev;
     hid_report.keyboard.report_id = ReportIdKeyboard;
     hid_report.mouse.report_id = ReportIdMouse;
     hid_report.consumer.report_id = ReportIdConsumer;
+    memset(&hid_report_gamepad, 0, sizeof(hid_report_gamepad));
+    hid_report_gamepad.report_id = ReportIdGamepad;
+    hid_report_gamepad.hat = HID_GAMEPAD_HAT_CENTERED;
 
     usb_hid.dev_descr->iManufacturer = 0;
     usb_hid.dev_descr->iProduct = 0;
@@ -389,10 +583,16 @@ static void hid_init(usbd_device* dev, FuriHalUsbInterface* intf, void* ctx) {
     usb_hid.str_prod_descr = NULL;
     usb_hid.dev_descr->idVendor = HID_VID_DEFAULT;
     usb_hid.dev_descr->idProduct = HID_PID_DEFAULT;
+    hid_interval = HID_INTERVAL;
+    hid_gamepad = false;
 
     if(cfg != NULL) {
-        usb_hid.dev_descr->idVendor = cfg->vid;
-        usb_hid.dev_descr->idProduct = cfg->pid;
+        if(cfg->vid || cfg->pid) {
+            usb_hid.dev_descr->idVendor = cfg->vid;
+            usb_hid.dev_descr->idProduct = cfg->pid;
+        }
+        if(cfg->interval) hid_interval = cfg->interval;
+        hid_gamepad = cfg->gamepad;
 
         if(cfg->manuf[0] != '\0') {
             usb_hid.str_manuf_descr = hid_set_string_descr(cfg->manuf);
@@ -405,6 +605,10 @@ static void hid_init(usbd_device* dev, FuriHalUsbInterface* intf, void* ctx) {
         }
     }
 
+    hid_cfg_desc.intf_0.hid_ep_in.bInterval = hid_interval;
+    hid_cfg_desc.intf_0.hid_desc.wDescriptorLength0 =
+        sizeof(hid_report_desc) - (hid_gamepad ? 0 : HID_REPORT_DESC_GAMEPAD_SIZE);
+
     usbd_reg_config(dev, hid_ep_config);
     usbd_reg_control(dev, hid_control);
 
@@ -433,7 +637,16 @@ static void hid_on_suspend(usbd_device* dev) {
     UNUSED(dev);
     if(hid_connected) {
         hid_connected = false;
-        furi_semaphore_release(hid_semaphore);
+
+        // Drop queued reports and give their slots back to waiting senders
+        FURI_CRITICAL_ENTER();
+        uint8_t dropped = hid_queue_count;
+        hid_queue_count = 0;
+        hid_ep_busy = false;
+        FURI_CRITICAL_EXIT();
+        for(uint8_t i = 0; i < dropped; i++) {
+            furi_semaphore_release(hid_semaphore);
+        }
         if(callback != NULL) {
             callback(false, cb_ctx);
         }
@@ -444,32 +657,72 @@ static bool hid_send_report(uint8_t report_id) {
     if((hid_semaphore == NULL) || (hid_connected == false)) return false;
     if((boot_protocol == true) && (report_id != ReportIdKeyboard)) return false;
 
-    FuriStatus status = furi_semaphore_acquire(hid_semaphore, HID_INTERVAL * 2);
+    const void* data = NULL;
+    uint8_t len = 0;
+    if(boot_protocol == true) {
+        data = &hid_report.keyboard.boot;
+        len = sizeof(hid_report.keyboard.boot);
+    } else if(report_id == ReportIdKeyboard) {
+        data = &hid_report.keyboard;
+        len = sizeof(hid_report.keyboard);
+    } else if(report_id == ReportIdMouse) {
+        data = &hid_report.mouse;
+        len = sizeof(hid_report.mouse);
+    } else if(report_id == ReportIdConsumer) {
+        data = &hid_report.consumer;
+        len = sizeof(hid_report.consumer);
+    } else if(report_id == ReportIdGamepad) {
+        if(!hid_gamepad) return false;
+        data = &hid_report_gamepad;
+        len = sizeof(hid_report_gamepad);
+    } else {
+        return true;
+    }
+
+    // Wait for free queue slot, host polls endpoint every hid_interval
+    FuriStatus status = furi_semaphore_acquire(hid_semaphore, hid_interval * 2);
     if(status == FuriStatusErrorTimeout) {
         return false;
     }
     furi_check(status == FuriStatusOk);
-    if(hid_connected == false) {
-        return false;
-    }
-    if(boot_protocol == true) {
-        usbd_ep_write(
-            usb_dev, HID_EP_IN, &hid_report.keyboard.boot, sizeof(hid_report.keyboard.boot));
-    } else {
-        if(report_id == ReportIdKeyboard)
-            usbd_ep_write(usb_dev, HID_EP_IN, &hid_report.keyboard, sizeof(hid_report.keyboard));
-        else if(report_id == ReportIdMouse)
-            usbd_ep_write(usb_dev, HID_EP_IN, &hid_report.mouse, sizeof(hid_report.mouse));
-        else if(report_id == ReportIdConsumer)
-            usbd_ep_write(usb_dev, HID_EP_IN, &hid_report.consumer, sizeof(hid_report.consumer));
+
+    bool queued = false;
+    bool sent = false;
+    FURI_CRITICAL_ENTER();
+    if(hid_connected) {
+        if(!hid_ep_busy) {
+            hid_ep_busy = true;
+            usbd_ep_write(usb_dev, HID_EP_IN, (void*)data, len);
+        } else {
+            HidQueuedReport* report =
+                &hid_queue[(hid_queue_head + hid_queue_count) % HID_REPORT_QUEUE_SIZE];
+            memcpy(report->data, data, len);
+            report->len = len;
+            hid_queue_count++;
+            queued = true;
+        }
+        sent = true;
     }
-    return true;
+    FURI_CRITICAL_EXIT();
+
+    // Slot is released by tx callback for queued reports
+    if(!queued) furi_semaphore_release(hid_semaphore);
+
+    return sent;
 }
 
 static void hid_txrx_ep_callback(usbd_device* dev, uint8_t event, uint8_t ep) {
     UNUSED(dev);
     if(event == usbd_evt_eptx) {
-        furi_semaphore_release(hid_semaphore);
+        if(hid_queue_count > 0) {
+            HidQueuedReport* report = &hid_queue[hid_queue_head];
+            usbd_ep_write(usb_dev, HID_EP_IN, report->data, report->len);
+            hid_queue_head = (hid_queue_head + 1) % HID_REPORT_QUEUE_SIZE;
+            hid_queue_count--;
+            furi_semaphore_release(hid_semaphore);
+        } else {
+            hid_ep_busy = false;
+        }
     } else if(boot_protocol == true) {
         usbd_ep_read(usb_dev, ep, &led_state, sizeof(led_state));
     } else {
@@ -541,7 +794,7 @@ static usbd_respond hid_control(usbd_device* dev, usbd_ctlreq* req, usbd_rqc_cal
         case USB_DTYPE_HID_REPORT:
             boot_protocol = false; /* BIOS does not read this */
             dev->status.data_ptr = (uint8_t*)hid_report_desc;
-            dev->status.data_count = sizeof(hid_report_desc);
+            dev->status.data_count = hid_cfg_desc.intf_0.hid_desc.wDescriptorLength0;
             return usbd_ack;
         default:
             return usbd_fail;
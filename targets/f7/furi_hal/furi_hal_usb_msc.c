@@ -0,0 +1,609 @@
+#include <furi_hal_version.h>
+#include <furi_hal_usb_i.h>
+#include <furi_hal_usb.h>
+#include <furi_hal_usb_msc.h>
+#include <furi.h>
+
+#include "usb.h"
+
+#define TAG "UsbMsc"
+
+#define MSC_VID_DEFAULT (0x0483)
+#define MSC_PID_DEFAULT (0x5720)
+
+#define MSC_CLASS_MASS_STORAGE (0x08)
+#define MSC_SUBCLASS_SCSI      (0x06)
+#define MSC_PROTOCOL_BBB       (0x50)
+
+#define MSC_REQ_RESET   (0xFF)
+#define MSC_REQ_GET_LUN (0xFE)
+
+#define ENDPOINT_DIR_IN  (0x80)
+#define ENDPOINT_DIR_OUT (0x00)
+
+#define MSC_IN_EPADDR  (ENDPOINT_DIR_IN | 1)
+#define MSC_OUT_EPADDR (ENDPOINT_DIR_OUT | 2)
+#define MSC_EPSIZE     64
+
+/* Blocks transferred to/from the medium at once */
+#define MSC_BUFFER_BLOCKS (8U)
+#define MSC_BUFFER_SIZE   (MSC_BUFFER_BLOCKS * FURI_HAL_USB_MSC_BLOCK_SIZE)
+
+#define MSC_CBW_SIGNATURE (0x43425355)
+#define MSC_CSW_SIGNATURE (0x53425355)
+#define MSC_CBW_DIR_IN    (0x80)
+
+#define MSC_CSW_STATUS_OK     (0x00)
+#define MSC_CSW_STATUS_FAILED (0x01)
+
+/* SCSI operation codes */
+#define SCSI_TEST_UNIT_READY        (0x00)
+#define SCSI_REQUEST_SENSE          (0x03)
+#define SCSI_INQUIRY                (0x12)
+#define SCSI_MODE_SENSE_6           (0x1A)
+#define SCSI_START_STOP_UNIT        (0x1B)
+#define SCSI_PREVENT_ALLOW_REMOVAL  (0x1E)
+#define SCSI_READ_FORMAT_CAPACITIES (0x23)
+#define SCSI_READ_CAPACITY_10       (0x25)
+#define SCSI_READ_10                (0x28)
+#define SCSI_WRITE_10               (0x2A)
+#define SCSI_VERIFY_10              (0x2F)
+#define SCSI_SYNCHRONIZE_CACHE_10   (0x35)
+
+/* SCSI sense keys */
+#define SCSI_SENSE_NONE            (0x00)
+#define SCSI_SENSE_NOT_READY       (0x02)
+#define SCSI_SENSE_MEDIUM_ERROR    (0x03)
+#define SCSI_SENSE_ILLEGAL_REQUEST (0x05)
+
+/* SCSI additional sense codes */
+#define SCSI_ASC_NONE               (0x00)
+#define SCSI_ASC_WRITE_FAULT        (0x03)
+#define SCSI_ASC_UNRECOVERED_READ   (0x11)
+#define SCSI_ASC_INVALID_COMMAND    (0x20)
+#define SCSI_ASC_LBA_OUT_OF_RANGE   (0x21)
+#define SCSI_ASC_MEDIUM_NOT_PRESENT (0x3A)
+
+typedef enum {
+    MscEvtStop = (1 << 0),
+    MscEvtReset = (1 << 1),
+    MscEvtRx = (1 << 2),
+    MscEvtTx = (1 << 3),
+} MscEvtFlags;
+
+typedef struct {
+    uint32_t signature;
+    uint32_t tag;
+    uint32_t data_length;
+    uint8_t flags;
+    uint8_t lun;
+    uint8_t cb_length;
+    uint8_t cb[16];
+} FURI_PACKED MscCbw;
+
+typedef struct {
+    uint32_t signature;
+    uint32_t tag;
+    uint32_t residue;
+    uint8_t status;
+} FURI_PACKED MscCsw;
+
+struct MscConfigDescriptor {
+    struct usb_config_descriptor config;
+    struct usb_interface_descriptor intf;
+    struct usb_endpoint_descriptor ep_in;
+    struct usb_endpoint_descriptor ep_out;
+} FURI_PACKED;
+
+static const struct usb_string_descriptor dev_manuf_desc = USB_STRING_DESC("Flipper Devices Inc.");
+
+/* Device descriptor */
+static struct usb_device_descriptor msc_device_desc = {
+    .bLength = sizeof(struct usb_device_descriptor),
+    .bDescriptorType = USB_DTYPE_DEVICE,
+    .bcdUSB = VERSION_BCD(2, 0, 0),
+    .bDeviceClass = USB_CLASS_PER_INTERFACE,
+    .bDeviceSubClass = USB_SUBCLASS_NONE,
+    .bDeviceProtocol = USB_PROTO_NONE,
+    .bMaxPacketSize0 = USB_EP0_SIZE,
+    .idVendor = MSC_VID_DEFAULT,
+    .idProduct = MSC_PID_DEFAULT,
+    .bcdDevice = VERSION_BCD(1, 0, 0),
+    .iManufacturer = UsbDevManuf,
+    .iProduct = UsbDevProduct,
+    .iSerialNumber = UsbDevSerial,
+    .bNumConfigurations = 1,
+};
+
+/* Device configuration descriptor */
+static const struct MscConfigDescriptor msc_cfg_desc = {
+    .config =
+        {
+            .bLength = sizeof(struct usb_config_descriptor),
+            .bDescriptorType = USB_DTYPE_CONFIGURATION,
+            .wTotalLength = sizeof(struct MscConfigDescriptor),
+            .bNumInterfaces = 1,
+            .bConfigurationValue = 1,
+            .iConfiguration = NO_DESCRIPTOR,
+            .bmAttributes = USB_CFG_ATTR_RESERVED | USB_CFG_ATTR_SELFPOWERED,
+            .bMaxPower = USB_CFG_POWER_MA(100),
+        },
+    .intf =
+        {
+            .bLength = sizeof(struct usb_interface_descriptor),
+            .bDescriptorType = USB_DTYPE_INTERFACE,
+            .bInterfaceNumber = 0,
+            .bAlternateSetting = 0,
+            .bNumEndpoints = 2,
+            .bInterfaceClass = MSC_CLASS_MASS_STORAGE,
+            .bInterfaceSubClass = MSC_SUBCLASS_SCSI,
+            .bInterfaceProtocol = MSC_PROTOCOL_BBB,
+            .iInterface = NO_DESCRIPTOR,
+        },
+    .ep_in =
+        {
+            .bLength = sizeof(struct usb_endpoint_descriptor),
+            .bDescriptorType = USB_DTYPE_ENDPOINT,
+            .bEndpointAddress = MSC_IN_EPADDR,
+            .bmAttributes = USB_EPTYPE_BULK,
+            .wMaxPacketSize = MSC_EPSIZE,
+            .bInterval = 0,
+        },
+    .ep_out =
+        {
+            .bLength = sizeof(struct usb_endpoint_descriptor),
+            .bDescriptorType = USB_DTYPE_ENDPOINT,
+            .bEndpointAddress = MSC_OUT_EPADDR,
+            .bmAttributes = USB_EPTYPE_BULK,
+            .wMaxPacketSize = MSC_EPSIZE,
+            .bInterval = 0,
+        },
+};
+
+static void msc_init(usbd_device* dev, FuriHalUsbInterface* intf, void* ctx);
+static void msc_deinit(usbd_device* dev);
+static void msc_on_wakeup(usbd_device* dev);
+static void msc_on_suspend(usbd_device* dev);
+static int32_t msc_worker(void* context);
+
+FuriHalUsbInterface usb_msc = {
+    .init = msc_init,
+    .deinit = msc_deinit,
+    .wakeup = msc_on_wakeup,
+    .suspend = msc_on_suspend,
+
+    .dev_descr = (struct usb_device_descriptor*)&msc_device_desc,
+
+    .str_manuf_descr = (void*)&dev_manuf_desc,
+    .str_prod_descr = NULL,
+    .str_serial_descr = NULL,
+
+    .cfg_descr = (void*)&msc_cfg_desc,
+};
+
+static usbd_respond msc_ep_config(usbd_device* dev, uint8_t cfg);
+static usbd_respond msc_control(usbd_device* dev, usbd_ctlreq* req, usbd_rqc_callback* callback);
+
+typedef struct {
+    usbd_device* usb_dev;
+    FuriThread* thread;
+    volatile bool connected;
+    volatile bool stop;
+    bool ejected;
+
+    MscCallbacks* callbacks;
+    void* cb_ctx;
+
+    uint8_t sense_key;
+    uint8_t sense_asc;
+
+    MscCbw cbw;
+    uint32_t data_left; /* Bytes of the data phase the host still expects */
+    uint8_t* buffer;
+} FuriHalUsbMsc;
+
+static FuriHalUsbMsc* furi_hal_usb_msc = NULL;
+
+static uint8_t msc_lun = 0;
+
+static void* msc_set_string_descr(const char* prefix, const char* str) {
+    size_t prefix_len = strlen(prefix);
+    size_t len = (str == NULL) ? (0) : (strlen(str));
+    struct usb_string_descriptor* dev_str_desc = malloc((prefix_len + len) * 2 + 2);
+    dev_str_desc->bLength = (prefix_len + len) * 2 + 2;
+    dev_str_desc->bDescriptorType = USB_DTYPE_STRING;
+    for(size_t i = 0; i < prefix_len; i++)
+        dev_str_desc->wString[i] = prefix[i];
+    for(size_t i = 0; i < len; i++)
+        dev_str_desc->wString[prefix_len + i] = str[i];
+
+    return dev_str_desc;
+}
+
+static void msc_init(usbd_device* dev, FuriHalUsbInterface* intf, void* ctx) {
+    UNUSED(intf);
+    UNUSED(ctx);
+
+    furi_check(furi_hal_usb_msc == NULL);
+    furi_hal_usb_msc = malloc(sizeof(FuriHalUsbMsc));
+    furi_hal_usb_msc->usb_dev = dev;
+    furi_hal_usb_msc->buffer = malloc(MSC_BUFFER_SIZE);
+
+    /* Hosts tell mass storage devices apart by serial number */
+    usb_msc.str_prod_descr = msc_set_string_descr("", furi_hal_version_get_device_name_ptr());
+    usb_msc.str_serial_descr = msc_set_string_descr("flip_", furi_hal_version_get_name_ptr());
+
+    furi_hal_usb_msc->thread = furi_thread_alloc_ex("UsbMscWorker", 1024, msc_worker, NULL);
+    furi_thread_start(furi_hal_usb_msc->thread);
+
+    usbd_reg_config(dev, msc_ep_config);
+    usbd_reg_control(dev, msc_control);
+
+    usbd_connect(dev, true);
+}
+
+static void msc_deinit(usbd_device* dev) {
+    /* Nothing may signal the worker once it is gone */
+    usbd_reg_config(dev, NULL);
+    usbd_reg_control(dev, NULL);
+    usbd_reg_endpoint(dev, MSC_IN_EPADDR, 0);
+    usbd_reg_endpoint(dev, MSC_OUT_EPADDR, 0);
+
+    furi_hal_usb_msc->stop = true;
+    furi_thread_flags_set(furi_thread_get_id(furi_hal_usb_msc->thread), MscEvtStop);
+    furi_thread_join(furi_hal_usb_msc->thread);
+    furi_thread_free(furi_hal_usb_msc->thread);
+
+    free(usb_msc.str_prod_descr);
+    free(usb_msc.str_serial_descr);
+    usb_msc.str_prod_descr = NULL;
+    usb_msc.str_serial_descr = NULL;
+
+    free(furi_hal_usb_msc->buffer);
+    free(furi_hal_usb_msc);
+    furi_hal_usb_msc = NULL;
+}
+
+static void msc_on_wakeup(usbd_device* dev) {
+    UNUSED(dev);
+    furi_check(furi_hal_usb_msc);
+
+    furi_hal_usb_msc->connected = true;
+}
+
+static void msc_on_suspend(usbd_device* dev) {
+    UNUSED(dev);
+    furi_check(furi_hal_usb_msc);
+
+    furi_hal_usb_msc->connected = false;
+}
+
+void furi_hal_usb_msc_set_callbacks(MscCallbacks* cb, void* context) {
+    furi_check(furi_hal_usb_msc);
+
+    furi_hal_usb_msc->callbacks = cb;
+    furi_hal_usb_msc->cb_ctx = context;
+    furi_hal_usb_msc->ejected = false;
+}
+
+static void msc_in_ep_callback(usbd_device* dev, uint8_t event, uint8_t ep) {
+    UNUSED(dev);
+    UNUSED(ep);
+    if(event == usbd_evt_eptx) {
+        furi_thread_flags_set(furi_thread_get_id(furi_hal_usb_msc->thread), MscEvtTx);
+    }
+}
+
+static void msc_out_ep_callback(usbd_device* dev, uint8_t event, uint8_t ep) {
+    UNUSED(dev);
+    UNUSED(ep);
+    if(event == usbd_evt_eprx) {
+        furi_thread_flags_set(furi_thread_get_id(furi_hal_usb_msc->thread), MscEvtRx);
+    }
+}
+
+/* Waits for an endpoint event, fails if the interface is stopped or reset meanwhile */
+static bool msc_wait(MscEvtFlags event) {
+    uint32_t flags = furi_thread_flags_wait(
+        event | MscEvtStop | MscEvtReset, FuriFlagWaitAny, FuriWaitForever);
+    furi_check(!(flags & FuriFlagError));
+    if(flags & MscEvtReset) {
+        /* Events of the aborted transfer are stale now */
+        furi_thread_flags_clear(MscEvtRx | MscEvtTx);
+    }
+    return !(flags & (MscEvtStop | MscEvtReset)) && !furi_hal_usb_msc->stop;
+}
+
+static bool msc_send(const uint8_t* data, size_t size) {
+    do {
+        size_t len = MIN(size, (size_t)MSC_EPSIZE);
+        usbd_ep_write(furi_hal_usb_msc->usb_dev, MSC_IN_EPADDR, (void*)data, len);
+        if(!msc_wait(MscEvtTx)) return false;
+        data += len;
+        size -= len;
+    } while(size > 0);
+    return true;
+}
+
+static bool msc_receive(uint8_t* data, size_t size) {
+    while(size > 0) {
+        if(!msc_wait(MscEvtRx)) return false;
+        int32_t len =
+            usbd_ep_read(furi_hal_usb_msc->usb_dev, MSC_OUT_EPADDR, data, MIN(size, MSC_EPSIZE));
+        if(len <= 0) return false;
+        data += len;
+        size -= len;
+    }
+    return true;
+}
+
+/* Sends reply data, trimmed to what the host asked for */
+static bool msc_send_data(const uint8_t* data, size_t size) {
+    size = MIN(size, furi_hal_usb_msc->data_left);
+    if(size == 0) return true;
+    furi_hal_usb_msc->data_left -= size;
+    return msc_send(data, size);
+}
+
+/* Finishes the data phase the host expects: pads IN transfers with zeroes, drains OUT ones */
+static bool msc_complete_data(void) {
+    uint8_t* buffer = furi_hal_usb_msc->buffer;
+    while(furi_hal_usb_msc->data_left > 0) {
+        size_t len = MIN(furi_hal_usb_msc->data_left, (size_t)MSC_BUFFER_SIZE);
+        if(furi_hal_usb_msc->cbw.flags & MSC_CBW_DIR_IN) {
+            memset(buffer, 0, len);
+            if(!msc_send(buffer, len)) return false;
+        } else {
+            if(!msc_receive(buffer, len)) return false;
+        }
+        furi_hal_usb_msc->data_left -= len;
+    }
+    return true;
+}
+
+static void msc_set_sense(uint8_t key, uint8_t asc) {
+    furi_hal_usb_msc->sense_key = key;
+    furi_hal_usb_msc->sense_asc = asc;
+}
+
+static uint32_t msc_block_count(void) {
+    MscCallbacks* callbacks = furi_hal_usb_msc->callbacks;
+    if(callbacks == NULL || furi_hal_usb_msc->ejected) return 0;
+    return callbacks->block_count(furi_hal_usb_msc->cb_ctx);
+}
+
+static void msc_put_be32(uint8_t* data, uint32_t value) {
+    data[0] = value >> 24;
+    data[1] = value >> 16;
+    data[2] = value >> 8;
+    data[3] = value;
+}
+
+static uint32_t msc_get_be32(const uint8_t* data) {
+    return (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+}
+
+/* Checks that medium is present and the range is on it, sets sense data on failure */
+static bool msc_check_range(uint32_t lba, uint32_t count) {
+    uint32_t block_count = msc_block_count();
+    if(block_count == 0) {
+        msc_set_sense(SCSI_SENSE_NOT_READY, SCSI_ASC_MEDIUM_NOT_PRESENT);
+        return false;
+    }
+    if(lba >= block_count || count > block_count - lba) {
+        msc_set_sense(SCSI_SENSE_ILLEGAL_REQUEST, SCSI_ASC_LBA_OUT_OF_RANGE);
+        return false;
+    }
+    return true;
+}
+
+static bool msc_scsi_read(uint32_t lba, uint32_t count, bool* result) {
+    *result = msc_check_range(lba, count);
+    while(*result && count > 0 && furi_hal_usb_msc->data_left > 0) {
+        uint32_t n_blocks = MIN(count, MSC_BUFFER_BLOCKS);
+        if(!furi_hal_usb_msc->callbacks->read(
+               furi_hal_usb_msc->buffer, lba, n_blocks, furi_hal_usb_msc->cb_ctx)) {
+            msc_set_sense(SCSI_SENSE_MEDIUM_ERROR, SCSI_ASC_UNRECOVERED_READ);
+            *result = false;
+            break;
+        }
+        if(!msc_send_data(furi_hal_usb_msc->buffer, n_blocks * FURI_HAL_USB_MSC_BLOCK_SIZE)) {
+            return false;
+        }
+        lba += n_blocks;
+        count -= n_blocks;
+    }
+    return true;
+}
+
+static bool msc_scsi_write(uint32_t lba, uint32_t count, bool* result) {
+    *result = msc_check_range(lba, count);
+    while(*result && count > 0 && furi_hal_usb_msc->data_left > 0) {
+        uint32_t n_blocks = MIN(count, MSC_BUFFER_BLOCKS);
+        size_t size = n_blocks * FURI_HAL_USB_MSC_BLOCK_SIZE;
+        if(size > furi_hal_usb_msc->data_left) {
+            /* Host sends less than the command says, leave the rest to be drained */
+            msc_set_sense(SCSI_SENSE_ILLEGAL_REQUEST, SCSI_ASC_INVALID_COMMAND);
+            *result = false;
+            break;
+        }
+        if(!msc_receive(furi_hal_usb_msc->buffer, size)) {
+            return false;
+        }
+        furi_hal_usb_msc->data_left -= size;
+        if(!furi_hal_usb_msc->callbacks->write(
+               furi_hal_usb_msc->buffer, lba, n_blocks, furi_hal_usb_msc->cb_ctx)) {
+            msc_set_sense(SCSI_SENSE_MEDIUM_ERROR, SCSI_ASC_WRITE_FAULT);
+            *result = false;
+            break;
+        }
+        lba += n_blocks;
+        count -= n_blocks;
+    }
+    return true;
+}
+
+/* Executes SCSI command from the current CBW, returns false if the transfer was aborted */
+static bool msc_scsi_process(bool* result) {
+    const uint8_t* cb = furi_hal_usb_msc->cbw.cb;
+    uint8_t* reply = furi_hal_usb_msc->buffer;
+    *result = true;
+
+    switch(cb[0]) {
+    case SCSI_TEST_UNIT_READY:
+        if(msc_block_count() == 0) {
+            msc_set_sense(SCSI_SENSE_NOT_READY, SCSI_ASC_MEDIUM_NOT_PRESENT);
+            *result = false;
+        }
+        return true;
+
+    case SCSI_REQUEST_SENSE:
+        memset(reply, 0, 18);
+        reply[0] = 0x70; /* Current error, fixed format */
+        reply[2] = furi_hal_usb_msc->sense_key;
+        reply[7] = 10; /* Additional sense length */
+        reply[12] = furi_hal_usb_msc->sense_asc;
+        msc_set_sense(SCSI_SENSE_NONE, SCSI_ASC_NONE);
+        return msc_send_data(reply, 18);
+
+    case SCSI_INQUIRY:
+        memset(reply, 0, 36);
+        reply[1] = 0x80; /* Removable medium */
+        reply[2] = 0x04; /* SPC-2 */
+        reply[3] = 0x02; /* Response data format */
+        reply[4] = 36 - 5; /* Additional length */
+        memcpy(&reply[8], "Flipper ", 8);
+        memcpy(&reply[16], "SD Card Reader  ", 16);
+        memcpy(&reply[32], "0001", 4);
+        return msc_send_data(reply, 36);
+
+    case SCSI_MODE_SENSE_6:
+        memset(reply, 0, 4);
+        reply[0] = 3; /* Mode data length, no block descriptors or pages */
+        return msc_send_data(reply, 4);
+
+    case SCSI_START_STOP_UNIT:
+        /* LoEj set and Start cleared: eject */
+        if((cb[4] & 0x03) == 0x02 && !furi_hal_usb_msc->ejected &&
+           furi_hal_usb_msc->callbacks) {
+            furi_hal_usb_msc->ejected = true;
+            furi_hal_usb_msc->callbacks->eject(furi_hal_usb_msc->cb_ctx);
+        }
+        return true;
+
+    case SCSI_PREVENT_ALLOW_REMOVAL:
+    case SCSI_VERIFY_10:
+    case SCSI_SYNCHRONIZE_CACHE_10:
+        /* Writes are not cached on our side */
+        return true;
+
+    case SCSI_READ_FORMAT_CAPACITIES: {
+        uint32_t block_count = msc_block_count();
+        memset(reply, 0, 12);
+        reply[3] = 8; /* Capacity list length */
+        msc_put_be32(&reply[4], block_count);
+        msc_put_be32(&reply[8], FURI_HAL_USB_MSC_BLOCK_SIZE);
+        reply[8] = (block_count > 0) ? 0x02 : 0x03; /* Formatted or no medium */
+        return msc_send_data(reply, 12);
+    }
+
+    case SCSI_READ_CAPACITY_10: {
+        uint32_t block_count = msc_block_count();
+        if(block_count == 0) {
+            msc_set_sense(SCSI_SENSE_NOT_READY, SCSI_ASC_MEDIUM_NOT_PRESENT);
+            *result = false;
+            return true;
+        }
+        msc_put_be32(&reply[0], block_count - 1);
+        msc_put_be32(&reply[4], FURI_HAL_USB_MSC_BLOCK_SIZE);
+        return msc_send_data(reply, 8);
+    }
+
+    case SCSI_READ_10:
+        return msc_scsi_read(msc_get_be32(&cb[2]), (cb[7] << 8) | cb[8], result);
+
+    case SCSI_WRITE_10:
+        return msc_scsi_write(msc_get_be32(&cb[2]), (cb[7] << 8) | cb[8], result);
+
+    default:
+        FURI_LOG_D(TAG, "Unsupported command %02X", cb[0]);
+        msc_set_sense(SCSI_SENSE_ILLEGAL_REQUEST, SCSI_ASC_INVALID_COMMAND);
+        *result = false;
+        return true;
+    }
+}
+
+static int32_t msc_worker(void* context) {
+    UNUSED(context);
+    MscCbw* cbw = &furi_hal_usb_msc->cbw;
+
+    while(!furi_hal_usb_msc->stop) {
+        if(!msc_receive((uint8_t*)cbw, sizeof(MscCbw))) continue;
+        if(cbw->signature != MSC_CBW_SIGNATURE) {
+            FURI_LOG_W(TAG, "Invalid CBW");
+            continue;
+        }
+
+        furi_hal_usb_msc->data_left = cbw->data_length;
+
+        bool result;
+        if(!msc_scsi_process(&result)) continue;
+        const uint32_t residue = furi_hal_usb_msc->data_left;
+        if(!msc_complete_data()) continue;
+
+        MscCsw csw = {
+            .signature = MSC_CSW_SIGNATURE,
+            .tag = cbw->tag,
+            .residue = residue,
+            .status = result ? MSC_CSW_STATUS_OK : MSC_CSW_STATUS_FAILED,
+        };
+        msc_send((uint8_t*)&csw, sizeof(MscCsw));
+    }
+
+    return 0;
+}
+
+/* Configure endpoints */
+static usbd_respond msc_ep_config(usbd_device* dev, uint8_t cfg) {
+    switch(cfg) {
+    case 0:
+        /* deconfiguring device */
+        usbd_ep_deconfig(dev, MSC_IN_EPADDR);
+        usbd_ep_deconfig(dev, MSC_OUT_EPADDR);
+        usbd_reg_endpoint(dev, MSC_IN_EPADDR, 0);
+        usbd_reg_endpoint(dev, MSC_OUT_EPADDR, 0);
+        furi_thread_flags_set(furi_thread_get_id(furi_hal_usb_msc->thread), MscEvtReset);
+        return usbd_ack;
+    case 1:
+        /* configuring device */
+        usbd_ep_config(dev, MSC_IN_EPADDR, USB_EPTYPE_BULK, MSC_EPSIZE);
+        usbd_ep_config(dev, MSC_OUT_EPADDR, USB_EPTYPE_BULK, MSC_EPSIZE);
+        usbd_reg_endpoint(dev, MSC_IN_EPADDR, msc_in_ep_callback);
+        usbd_reg_endpoint(dev, MSC_OUT_EPADDR, msc_out_ep_callback);
+        furi_thread_flags_set(furi_thread_get_id(furi_hal_usb_msc->thread), MscEvtReset);
+        return usbd_ack;
+    default:
+        return usbd_fail;
+    }
+}
+
+/* Control requests handler */
+static usbd_respond msc_control(usbd_device* dev, usbd_ctlreq* req, usbd_rqc_callback* callback) {
+    UNUSED(callback);
+    if(((USB_REQ_RECIPIENT | USB_REQ_TYPE) & req->bmRequestType) ==
+           (USB_REQ_INTERFACE | USB_REQ_CLASS) &&
+       req->wIndex == 0) {
+        switch(req->bRequest) {
+        case MSC_REQ_GET_LUN:
+            dev->status.data_ptr = &msc_lun;
+            dev->status.data_count = sizeof(msc_lun);
+            return usbd_ack;
+        case MSC_REQ_RESET:
+            furi_thread_flags_set(furi_thread_get_id(furi_hal_usb_msc->thread), MscEvtReset);
+            return usbd_ack;
+        default:
+            return usbd_fail;
+        }
+    }
+    return usbd_fail;
+}
@@ -14,7 +14,9 @@ struct STOP_EXTERNING_ME {};
 #include <furi_hal_clock.h>
 #include <furi_hal_adc.h>
 #include <furi_hal_bus.h>
+#include <furi_hal_crc.h>
 #include <furi_hal_crypto.h>
+#include <furi_hal_pka.h>
 #include <furi_hal_debug.h>
 #include <furi_hal_dma.h>
 #include <furi_hal_os.h>
@@ -36,6 +38,7 @@ struct STOP_EXTERNING_ME {};
 #include <furi_hal_usb.h>
 #include <furi_hal_usb_hid.h>
 #include <furi_hal_usb_ccid.h>
+#include <furi_hal_usb_msc.h>
 #include <furi_hal_serial_control.h>
 #include <furi_hal_serial.h>
 #include <furi_hal_info.h>
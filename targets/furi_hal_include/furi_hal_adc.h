@@ -17,8 +17,9 @@
  *   for your signal.
  * - Only single ended mode is available. But you can implement differential one
  *   by using low level controls directly.
- * - No DMA or interrupt API available at this point. But can be implemented
- *   with low level controls.
+ * - Continuous sampling uses TIM1 and DMA2 channel 3. Those are shared with
+ *   other subsystems, so don't stream while iButton, Infrared, NFC or
+ *   external CC1101 are in use.
  *
  *
  * How to use:
@@ -28,6 +29,13 @@
  * - furi_hal_adc_configure - configure ADC block
  * - furi_hal_adc_read - read value
  * - furi_hal_adc_release - release ADC handle
+ *
+ * Or for continuous sampling:
+ *
+ * - furi_hal_adc_stream_start - start timer triggered scans of channels
+ * - get samples in the callback, i.e. with `furi_stream_buffer_send` to
+ *   a stream buffer subscribed in the event loop
+ * - furi_hal_adc_stream_stop - stop sampling
  */
 
 #pragma once
@@ -40,6 +48,8 @@
 extern "C" {
 #endif
 
+#define FURI_HAL_ADC_STREAM_CHANNELS_MAX (16U)
+
 typedef struct FuriHalAdcHandle FuriHalAdcHandle;
 
 typedef enum {
@@ -185,6 +195,54 @@ void furi_hal_adc_configure_ex(
  */
 uint16_t furi_hal_adc_read(FuriHalAdcHandle* handle, FuriHalAdcChannel channel);
 
+/** ADC stream callback
+ *
+ * @warning    Called from interrupt context, copy samples out and return.
+ *
+ * @param[in]  samples  Half of the stream buffer: whole scans, channel values
+ *                      in the order they were given to `furi_hal_adc_stream_start`
+ * @param      count    Number of values
+ * @param      context  The context
+ */
+typedef void (*FuriHalAdcStreamCallback)(const uint16_t* samples, size_t count, void* context);
+
+/** Start continuous sampling of channels
+ *
+ * Every timer tick scans all channels once, converted values are stored into
+ * circular buffer with DMA. Callback is called when either half of the buffer
+ * is filled, the other half is being filled meanwhile.
+ *
+ * Resolution, oversampling and sampling time come from `furi_hal_adc_configure_ex`.
+ * Scan must be shorter than the tick period, otherwise ticks are skipped.
+ * `furi_hal_adc_read` can't be used while streaming.
+ *
+ * @param      handle          The ADC handle
+ * @param[in]  channels        The channels to scan, up to FURI_HAL_ADC_STREAM_CHANNELS_MAX
+ * @param      channels_count  The channels count
+ * @param      frequency       Scans per second
+ * @param      buffer          The buffer, must be valid until the stream is stopped
+ * @param      buffer_size     Buffer size in values, multiple of 2 * channels_count
+ * @param[in]  callback        The callback
+ * @param      context         The callback context
+ *
+ * @return     Actual scans per second
+ */
+uint32_t furi_hal_adc_stream_start(
+    FuriHalAdcHandle* handle,
+    const FuriHalAdcChannel* channels,
+    size_t channels_count,
+    uint32_t frequency,
+    uint16_t* buffer,
+    size_t buffer_size,
+    FuriHalAdcStreamCallback callback,
+    void* context);
+
+/** Stop continuous sampling
+ *
+ * @param      handle  The ADC handle
+ */
+void furi_hal_adc_stream_stop(FuriHalAdcHandle* handle);
+
 /** Convert sampled value to voltage
  *
  * @param      handle  The ADC handle
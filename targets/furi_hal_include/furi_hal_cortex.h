@@ -56,6 +56,16 @@ bool furi_hal_cortex_timer_is_expired(FuriHalCortexTimer cortex_timer);
  */
 void furi_hal_cortex_timer_wait(FuriHalCortexTimer cortex_timer);
 
+/** Get microseconds timestamp
+ *
+ * Kernel tick count extended with the system tick timer fraction: keeps
+ * counting across low power sleep and wraps around every 2^32 microseconds.
+ * Safe to call from interrupts.
+ *
+ * @return     timestamp in microseconds
+ */
+uint32_t furi_hal_cortex_get_timestamp_us(void);
+
 typedef enum {
     FuriHalCortexComp0,
     FuriHalCortexComp1,
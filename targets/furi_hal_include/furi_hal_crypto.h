@@ -90,6 +90,15 @@ typedef enum {
     FuriHalCryptoGCMStateAuthFailure, /**< tags do not match, auth failed */
 } FuriHalCryptoGCMState;
 
+/** Asynchronous operation completion callback
+ *
+ * Called from interrupt context
+ *
+ * @param      success  true if operation completed without errors
+ * @param      context  callback context
+ */
+typedef void (*FuriHalCryptoCallback)(bool success, void* context);
+
 /** Initialize cryptography layer(includes AES engines, PKA and RNG) */
 void furi_hal_crypto_init(void);
 
@@ -187,10 +196,50 @@ bool furi_hal_crypto_encrypt(const uint8_t* input, uint8_t* output, size_t size)
  */
 bool furi_hal_crypto_decrypt(const uint8_t* input, uint8_t* output, size_t size);
 
+/** Start asynchronous data encryption
+ *
+ * Data is transferred by DMA, callback is called from interrupt context when
+ * done. Key must stay loaded until then. Subsequent calls continue the chain.
+ *
+ * @param      input     pointer to input data, word aligned
+ * @param      output    pointer to output data, word aligned
+ * @param      size      input/output buffer size in bytes, multiple of 16
+ * @param      callback  completion callback
+ * @param      context   callback context
+ *
+ * @return     true if started, false if DMA is busy or buffers are not aligned
+ */
+bool furi_hal_crypto_encrypt_async(
+    const uint8_t* input,
+    uint8_t* output,
+    size_t size,
+    FuriHalCryptoCallback callback,
+    void* context);
+
+/** Start asynchronous data decryption
+ *
+ * Same rules as for furi_hal_crypto_encrypt_async apply.
+ *
+ * @param      input     pointer to input data, word aligned
+ * @param      output    pointer to output data, word aligned
+ * @param      size      input/output buffer size in bytes, multiple of 16
+ * @param      callback  completion callback
+ * @param      context   callback context
+ *
+ * @return     true if started, false if DMA is busy or buffers are not aligned
+ */
+bool furi_hal_crypto_decrypt_async(
+    const uint8_t* input,
+    uint8_t* output,
+    size_t size,
+    FuriHalCryptoCallback callback,
+    void* context);
+
 /** Encrypt the input using AES-CTR
  *
  * Decryption can be performed by supplying the ciphertext as input. Inits and
- * deinits the AES engine internally.
+ * deinits the AES engine internally. Large word aligned buffers are processed
+ * by DMA.
  *
  * @param[in]  key     pointer to 32 bytes key data
  * @param[in]  iv      pointer to 12 bytes Initialization Vector data
@@ -42,6 +42,34 @@ typedef enum {
     FuriHalI2cEndPause,
 } FuriHalI2cEnd;
 
+/** Asynchronous transfer completion callback
+ *
+ * @warning    called from interrupt context, or from furi_hal_i2c_release
+ *             for aborted transfers
+ *
+ * @param      success  true if all data was transferred and acknowledged
+ * @param      context  context pointer set in FuriHalI2cTransfer
+ */
+typedef void (*FuriHalI2cTransferCallback)(bool success, void* context);
+
+/** I2C transfer: optional write followed by optional read
+ *
+ * When both parts are present the read part follows the write part after a
+ * RESTART condition. Transfer ends with a STOP condition. Transfer with no
+ * data only addresses the slave.
+ */
+struct FuriHalI2cTransfer {
+    uint16_t address; /**< I2C slave address, same format as in furi_hal_i2c_tx */
+    bool ten_bit; /**< Whether the address is 10 bits wide */
+    const uint8_t* tx_data; /**< Data to write */
+    size_t tx_size; /**< Size of data to write */
+    uint8_t* rx_data; /**< Buffer for read data */
+    size_t rx_size; /**< Size of data to read */
+    FuriHalI2cTransferCallback callback; /**< Completion callback, may be NULL */
+    void* context; /**< Completion callback context */
+    FuriHalI2cTransfer* next; /**< Private: transfer queue link */
+};
+
 /** Early Init I2C */
 void furi_hal_i2c_init_early(void);
 
@@ -58,12 +86,43 @@ void furi_hal_i2c_init(void);
 void furi_hal_i2c_acquire(FuriHalI2cBusHandle* handle);
 
 /** Release I2C bus handle
+ *
+ * Waits for queued asynchronous transfers, transfers that do not finish in
+ * time are aborted and completed with failure.
  * 
  * @param      handle  Pointer to FuriHalI2cBusHandle instance acquired in
  *                     `furi_hal_i2c_acquire`
  */
 void furi_hal_i2c_release(FuriHalI2cBusHandle* handle);
 
+/** Queue asynchronous I2C transfer
+ *
+ * Transfers of a bus are performed one after another in interrupts, caller is
+ * not blocked. Transfer and its buffers must stay valid until the callback.
+ * Can be called from a transfer callback to chain transfers.
+ *
+ * @param      handle    Pointer to FuriHalI2cBusHandle instance, acquired
+ * @param      transfer  Pointer to FuriHalI2cTransfer instance
+ */
+void furi_hal_i2c_transfer_async(FuriHalI2cBusHandle* handle, FuriHalI2cTransfer* transfer);
+
+/** Perform I2C transfer and wait for completion
+ *
+ * Calling thread sleeps while the transfer is running. Before the scheduler
+ * is started and in interrupt context the transfer is polled instead.
+ * Transfer callback is not used.
+ *
+ * @param      handle    Pointer to FuriHalI2cBusHandle instance, acquired
+ * @param      transfer  Pointer to FuriHalI2cTransfer instance
+ * @param      timeout   Timeout in milliseconds
+ *
+ * @return     true on successful transfer, false otherwise
+ */
+bool furi_hal_i2c_transfer(
+    FuriHalI2cBusHandle* handle,
+    FuriHalI2cTransfer* transfer,
+    uint32_t timeout);
+
 /** Perform I2C TX transfer
  *
  * @param      handle   Pointer to FuriHalI2cBusHandle instance
@@ -84,6 +143,8 @@ bool furi_hal_i2c_tx(
 /**
  * Perform I2C TX transfer, with additional settings.
  *
+ * Transfer is polled, it is meant for transactions split across calls.
+ *
  * @param      handle   Pointer to FuriHalI2cBusHandle instance
  * @param      address  I2C slave address
  * @param      ten_bit  Whether the address is 10 bits wide
@@ -123,6 +184,8 @@ bool furi_hal_i2c_rx(
     uint32_t timeout);
 
 /** Perform I2C RX transfer, with additional settings.
+ *
+ * Transfer is polled, it is meant for transactions split across calls.
  *
  * @param      handle   Pointer to FuriHalI2cBusHandle instance
  * @param      address  I2C slave address
@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <toolbox/level_duration.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +49,17 @@ typedef void (*FuriHalInfraredTxSignalSentISRCallback)(void* context);
  */
 typedef void (*FuriHalInfraredRxCaptureCallback)(void* ctx, bool level, uint32_t duration);
 
+/** Signature of callback function for receiving INFRARED rx signal in batches.
+ *
+ * @param[in] ctx     context to pass to callback
+ * @param[in] pulses  levels and durations in us, in the order received
+ * @param[in] count   pulses count
+ */
+typedef void (*FuriHalInfraredRxCaptureBatchCallback)(
+    void* ctx,
+    const LevelDuration* pulses,
+    size_t count);
+
 /** Signature of callback function for reaching silence timeout on INFRARED port.
  *
  * @param[in] ctx  context to pass to callback
@@ -82,6 +94,20 @@ void furi_hal_infrared_async_rx_set_capture_isr_callback(
     FuriHalInfraredRxCaptureCallback callback,
     void* ctx);
 
+/** Setup batch callback for INFRARED RX.
+ *
+ * If set when furi_hal_infrared_async_rx_start() is called, capture registers
+ * are written into a ring buffer with DMA instead of an interrupt per edge.
+ * Pulses come at half and full transfer, and are flushed before the silence
+ * timeout callback. The per edge callback is not called in this mode.
+ *
+ * @param[in]  callback  callback for received pulses
+ * @param[in]  ctx       context for callback
+ */
+void furi_hal_infrared_async_rx_set_capture_batch_isr_callback(
+    FuriHalInfraredRxCaptureBatchCallback callback,
+    void* ctx);
+
 /** Setup callback for reaching silence timeout on INFRARED port.
  *
  * Should setup hal with 'furi_hal_infrared_setup_rx_timeout_irq()' first.
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -18,13 +19,24 @@ extern "C" {
 void furi_hal_memory_init(void);
 
 /**
- * @brief Allocate memory from separate memory pool. That memory can't be freed.
+ * @brief Allocate memory from separate memory pool.
+ *
+ * Memory is zeroed and 8 byte aligned. Release it with furi_hal_memory_free
+ * or free().
  * 
  * @param size 
- * @return void* 
+ * @return void* pointer to memory or NULL if pool is exhausted
  */
 void* furi_hal_memory_alloc(size_t size);
 
+/**
+ * @brief Return memory to separate memory pool
+ *
+ * @param ptr pointer to memory, may be outside of the pool
+ * @return true if memory belonged to the pool and was released
+ */
+bool furi_hal_memory_free(void* ptr);
+
 /**
  * @brief Get free memory pool size
  * 
@@ -0,0 +1,56 @@
+/**
+ * @file furi_hal_pka.h
+ * Public key accelerator HAL API
+ *
+ * PKA is shared with the radio stack on core2, which uses it for pairing.
+ * Functions fail right away instead of waiting while it is busy: be ready to
+ * fall back to a software implementation.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** NIST P-256 private key and hash size */
+#define FURI_HAL_PKA_P256_SIZE (32U)
+
+typedef enum {
+    FuriHalPkaStatusOk, /**< Operation succeeded */
+    FuriHalPkaStatusBusy, /**< PKA is used by core2 or not clocked, nothing was done */
+    FuriHalPkaStatusError, /**< Operation failed or verification did not pass */
+} FuriHalPkaStatus;
+
+/** Sign hash with ECDSA on NIST P-256 curve
+ *
+ * Ephemeral key is taken from the hardware RNG.
+ *
+ * @param[in]  key        The private key, FURI_HAL_PKA_P256_SIZE bytes, big endian
+ * @param[in]  hash       The hash, FURI_HAL_PKA_P256_SIZE bytes
+ * @param[out] signature  The r and s signature parts, 2 * FURI_HAL_PKA_P256_SIZE bytes,
+ *                        big endian
+ *
+ * @return     true on success, false if PKA is busy or operation failed
+ */
+bool furi_hal_pka_ecdsa_sign_p256(const uint8_t* key, const uint8_t* hash, uint8_t* signature);
+
+/** Verify ECDSA signature on NIST P-256 curve
+ *
+ * @param[in]  public_key  The public key point x and y coordinates,
+ *                         2 * FURI_HAL_PKA_P256_SIZE bytes, big endian
+ * @param[in]  hash        The hash, FURI_HAL_PKA_P256_SIZE bytes, reduced to curve order
+ * @param[in]  signature   The r and s signature parts, both in [1, n - 1]
+ *
+ * @return     FuriHalPkaStatusOk if signature is valid
+ */
+FuriHalPkaStatus furi_hal_pka_ecdsa_verify_p256(
+    const uint8_t* public_key,
+    const uint8_t* hash,
+    const uint8_t* signature);
+
+#ifdef __cplusplus
+}
+#endif
@@ -158,6 +158,15 @@ uint32_t furi_hal_power_get_battery_full_capacity(void);
  */
 uint32_t furi_hal_power_get_battery_design_capacity(void);
 
+/** Set how long fuel gauge readings are shared between callers
+ *
+ * Fuel gauge getters are served from one snapshot of gauge registers, read
+ * again once it is older than the interval.
+ *
+ * @param      interval_ms  cache interval in milliseconds, 0 to always read
+ */
+void furi_hal_power_set_gauge_cache_interval(uint32_t interval_ms);
+
 /** Get battery voltage in V
  *
  * @param[in]      ic    FuriHalPowerIc to get measurment
@@ -68,6 +68,31 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
  */
 FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint32_t count);
 
+/**
+ * @brief Write all dirty sectors from write back cache to SD card
+ * Dirty sectors are discarded if card is not present anymore.
+ * @return FuriStatus 
+ */
+FuriStatus furi_hal_sd_flush(void);
+
+/**
+ * @brief Enable or disable write back cache mode
+ *
+ * In write back mode single sector writes are kept in sector cache and
+ * stored on the card on eviction, on furi_hal_sd_flush (FatFs sync and
+ * file close) or when storage is idle. Disabled by default.
+ *
+ * @param enable true to enable, false to flush and disable
+ * @return FuriStatus, error if pending data can't be flushed on disable
+ */
+FuriStatus furi_hal_sd_set_write_back(bool enable);
+
+/**
+ * @brief Check if write back cache mode is enabled
+ * @return true if enabled
+ */
+bool furi_hal_sd_is_write_back_enabled(void);
+
 /**
  * @brief Get SD card info
  * @param info 
@@ -59,6 +59,21 @@ void furi_hal_spi_acquire(FuriHalSpiBusHandle* handle);
  */
 void furi_hal_spi_release(FuriHalSpiBusHandle* handle);
 
+/** Let other handles waiting for the bus run
+ *
+ * Preemption point for long transactions: bus is released and acquired again
+ * only if some other handle is blocked in furi_hal_spi_acquire. Waiters are
+ * served in thread priority order. Handle is reactivated on return, so bus
+ * configuration and CS state must be restored by the caller.
+ *
+ * @warning blocking, must not be called between CS assertion and deassertion
+ *
+ * @param      handle  pointer to currently acquired FuriHalSpiBusHandle instance
+ *
+ * @return     true if bus was handed over to other handles
+ */
+bool furi_hal_spi_yield(FuriHalSpiBusHandle* handle);
+
 /** SPI Receive
  *
  * @param      handle   pointer to FuriHalSpiBusHandle instance
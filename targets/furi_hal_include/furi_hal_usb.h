@@ -29,6 +29,7 @@ extern FuriHalUsbInterface usb_cdc_dual;
 extern FuriHalUsbInterface usb_hid;
 extern FuriHalUsbInterface usb_hid_u2f;
 extern FuriHalUsbInterface usb_ccid;
+extern FuriHalUsbInterface usb_msc;
 
 typedef enum {
     FuriHalUsbStateEventReset,
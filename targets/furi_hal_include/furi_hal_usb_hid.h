@@ -166,10 +166,12 @@ static const uint16_t hid_asciimap[] = {
 };
 
 typedef struct {
-    uint32_t vid;
-    uint32_t pid;
+    uint32_t vid; /**< Vendor ID, default is used if both vid and pid are 0 */
+    uint32_t pid; /**< Product ID */
     char manuf[32];
     char product[32];
+    uint8_t interval; /**< Endpoint polling interval in ms, 1 is the fastest, 0 for default */
+    bool gamepad; /**< Add gamepad report to the descriptor */
 } FuriHalUsbHidConfig;
 
 typedef void (*HidStateCallback)(bool state, void* context);
@@ -191,6 +193,19 @@ enum HidMouseButtons {
     HID_MOUSE_BTN_WHEEL = (1 << 2),
 };
 
+/** HID gamepad hat switch directions */
+enum HidGamepadHat {
+    HID_GAMEPAD_HAT_UP = 0,
+    HID_GAMEPAD_HAT_UP_RIGHT = 1,
+    HID_GAMEPAD_HAT_RIGHT = 2,
+    HID_GAMEPAD_HAT_DOWN_RIGHT = 3,
+    HID_GAMEPAD_HAT_DOWN = 4,
+    HID_GAMEPAD_HAT_DOWN_LEFT = 5,
+    HID_GAMEPAD_HAT_LEFT = 6,
+    HID_GAMEPAD_HAT_UP_LEFT = 7,
+    HID_GAMEPAD_HAT_CENTERED = 8,
+};
+
 /** Get USB HID connection state
  *
  * @return      true / false
@@ -227,7 +242,22 @@ bool furi_hal_hid_kb_release(uint16_t button);
  */
 bool furi_hal_hid_kb_release_all(void);
 
+/** Type key sequence: press and release every key in order
+ *
+ * Consecutive keys with the same modifiers are pressed together, up to
+ * HID_KB_MAX_KEYS per report, so a group takes two reports instead of two
+ * per key. A key repeated within a group starts the next one. Keys already
+ * held with furi_hal_hid_kb_press() stay pressed.
+ *
+ * @param      buttons  key codes
+ * @param      count    key codes count
+ */
+bool furi_hal_hid_kb_type(const uint16_t* buttons, size_t count);
+
 /** Set mouse movement and send HID report
+ *
+ * Movement is added to the previous report if that one still waits for the
+ * host to poll the endpoint, so fast moves are not throttled by the queue.
  *
  * @param      dx  x coordinate delta
  * @param      dy  y coordinate delta
@@ -269,6 +299,38 @@ bool furi_hal_hid_consumer_key_release(uint16_t button);
  */
 bool furi_hal_hid_consumer_key_release_all(void);
 
+/** Set gamepad buttons to pressed state and send HID report
+ *
+ * Gamepad must be enabled in FuriHalUsbHidConfig, otherwise false is returned.
+ *
+ * @param      buttons  buttons mask, bit 0 is button 1
+ */
+bool furi_hal_hid_gamepad_press(uint16_t buttons);
+
+/** Set gamepad buttons to released state and send HID report
+ *
+ * @param      buttons  buttons mask, bit 0 is button 1
+ */
+bool furi_hal_hid_gamepad_release(uint16_t buttons);
+
+/** Set gamepad hat switch direction and send HID report
+ *
+ * @param      hat  HidGamepadHat direction
+ */
+bool furi_hal_hid_gamepad_set_hat(uint8_t hat);
+
+/** Set gamepad axes and send HID report
+ *
+ * Replaces the previous report if that one still waits for the host and
+ * differs in axes only.
+ *
+ * @param      x   X axis
+ * @param      y   Y axis
+ * @param      z   Z axis
+ * @param      rz  Z rotation axis
+ */
+bool furi_hal_hid_gamepad_set_axes(int8_t x, int8_t y, int8_t z, int8_t rz);
+
 #ifdef __cplusplus
 }
 #endif
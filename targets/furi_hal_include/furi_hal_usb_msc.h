@@ -0,0 +1,40 @@
+/**
+ * @file furi_hal_usb_msc.h
+ * USB Mass Storage interface (Bulk-Only Transport, SCSI transparent command set)
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of a block exposed to the host, in bytes */
+#define FURI_HAL_USB_MSC_BLOCK_SIZE (512U)
+
+/** Mass storage callbacks, called from the interface worker thread */
+typedef struct {
+    /** Read count blocks starting from lba into buffer */
+    bool (*read)(uint8_t* buffer, uint32_t lba, uint32_t count, void* context);
+    /** Write count blocks starting from lba from buffer */
+    bool (*write)(const uint8_t* buffer, uint32_t lba, uint32_t count, void* context);
+    /** Number of blocks on the medium, 0 if there is no medium */
+    uint32_t (*block_count)(void* context);
+    /** Host has ejected the medium, it reads as not present from now on */
+    void (*eject)(void* context);
+} MscCallbacks;
+
+/** Set Mass Storage callbacks
+ *
+ * Medium is reported as not present to the host until callbacks are set.
+ *
+ * @param      cb       MscCallbacks instance or NULL
+ * @param      context  The context for callbacks
+ */
+void furi_hal_usb_msc_set_callbacks(MscCallbacks* cb, void* context);
+
+#ifdef __cplusplus
+}
+#endif